@@ -19,6 +19,7 @@ bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_front(std::move(resolver));
+  ClearResolverCache();
   return true;
 }
 
@@ -28,6 +29,7 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_back(std::move(resolver));
+  ClearResolverCache();
   return true;
 }
 
@@ -53,12 +55,19 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  ClearResolverCache();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  ClearResolverCache();
   return std::move(resolvers_);
 }
 
+void AssetManager::ClearResolverCache() {
+  std::scoped_lock lock(resolver_cache_mutex_);
+  resolver_cache_.clear();
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,14 +76,40 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  {
+    std::unique_lock lock(resolver_cache_mutex_);
+    auto found = resolver_cache_.find(asset_name);
+    if (found != resolver_cache_.end()) {
+      const AssetResolver* cached_resolver = found->second;
+      lock.unlock();
+      if (cached_resolver == nullptr) {
+        return nullptr;
+      }
+      auto mapping = cached_resolver->GetAsMapping(asset_name);
+      if (mapping != nullptr) {
+        return mapping;
+      }
+      // The asset is gone from its resolver, look for it again.
+    }
+  }
+
+  const AssetResolver* found_resolver = nullptr;
+  std::unique_ptr<fml::Mapping> mapping;
   for (const auto& resolver : resolvers_) {
-    auto mapping = resolver->GetAsMapping(asset_name);
+    mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
-      return mapping;
+      found_resolver = resolver.get();
+      break;
     }
   }
-  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
-  return nullptr;
+  {
+    std::scoped_lock lock(resolver_cache_mutex_);
+    resolver_cache_[asset_name] = found_resolver;
+  }
+  if (mapping == nullptr) {
+    FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+  }
+  return mapping;
 }
 
 // |AssetResolver|
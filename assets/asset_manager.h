@@ -7,7 +7,9 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
@@ -68,6 +70,9 @@ class AssetManager final : public AssetResolver {
       std::unique_ptr<AssetResolver> updated_asset_resolver,
       AssetResolver::AssetResolverType type);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Removes all the resolvers from the manager.
+  ///
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
   // |AssetResolver|
@@ -90,6 +95,15 @@ class AssetManager final : public AssetResolver {
 
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
+  // Maps the names of the assets looked up so far to the resolver that
+  // provides them, or to null if none of the resolvers does, so that looking
+  // an asset up again doesn't ask each resolver in turn. Cleared whenever the
+  // resolvers change. Assets are looked up from several threads.
+  mutable std::mutex resolver_cache_mutex_;
+  mutable std::unordered_map<std::string, const AssetResolver*>
+      resolver_cache_;
+
+  void ClearResolverCache();
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
@@ -9,6 +9,7 @@
 
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/file_mapping_batch.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 
@@ -16,8 +17,10 @@ namespace flutter {
 
 DirectoryAssetBundle::DirectoryAssetBundle(
     fml::UniqueFD descriptor,
-    bool is_valid_after_asset_manager_change)
-    : descriptor_(std::move(descriptor)) {
+    bool is_valid_after_asset_manager_change,
+    std::shared_ptr<fml::BasicTaskRunner> mapping_task_runner)
+    : descriptor_(std::move(descriptor)),
+      mapping_task_runner_(std::move(mapping_task_runner)) {
   if (!fml::IsDirectory(descriptor_)) {
     return;
   }
@@ -69,42 +72,55 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     return mappings;
   }
 
+  std::string root;
+  fml::UniqueFD subdir_fd;
+  if (subdir) {
+    subdir_fd = fml::OpenFileReadOnly(descriptor_, subdir.value().c_str());
+    if (!fml::IsDirectory(subdir_fd)) {
+      FML_LOG(ERROR) << "Subdirectory path " << subdir.value()
+                     << " is not a directory";
+      return mappings;
+    }
+    root = subdir.value() + "/";
+  }
+
+  // Collect the matching paths first so that the files can be opened and
+  // mapped as one batch instead of one at a time during the directory walk.
   std::regex asset_regex(asset_pattern);
+  std::vector<std::string> matched_paths;
+  std::string prefix = root;
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     TRACE_EVENT0("flutter", "DirectoryAssetBundle::GetAsMappings FileVisitor");
 
-    if (std::regex_match(filename, asset_regex)) {
-      TRACE_EVENT0("flutter", "Matched File");
-
-      fml::UniqueFD fd = fml::OpenFile(directory, filename.c_str(), false,
-                                       fml::FilePermission::kRead);
-
-      if (fml::IsDirectory(fd)) {
-        return true;
+    fml::UniqueFD fd = fml::OpenFileReadOnly(directory, filename.c_str());
+    if (fml::IsDirectory(fd)) {
+      // The subdirectory variant only considers its immediate children.
+      if (!subdir) {
+        const auto saved_prefix_size = prefix.size();
+        prefix += filename + "/";
+        fml::VisitFiles(fd, visitor);
+        prefix.resize(saved_prefix_size);
       }
+      return true;
+    }
 
-      auto mapping = std::make_unique<fml::FileMapping>(fd);
-
-      if (mapping && mapping->IsValid()) {
-        mappings.push_back(std::move(mapping));
-      } else {
-        FML_LOG(ERROR) << "Mapping " << filename << " failed";
-      }
+    if (std::regex_match(filename, asset_regex)) {
+      TRACE_EVENT0("flutter", "Matched File");
+      matched_paths.push_back(prefix + filename);
     }
     return true;
   };
-  if (!subdir) {
-    fml::VisitFilesRecursively(descriptor_, visitor);
-  } else {
-    fml::UniqueFD subdir_fd =
-        fml::OpenFileReadOnly(descriptor_, subdir.value().c_str());
-    if (!fml::IsDirectory(subdir_fd)) {
-      FML_LOG(ERROR) << "Subdirectory path " << subdir.value()
-                     << " is not a directory";
-      return mappings;
+  fml::VisitFiles(subdir ? subdir_fd : descriptor_, visitor);
+
+  fml::FileMappings file_mappings = fml::MapFilesInParallel(
+      descriptor_, matched_paths, mapping_task_runner_);
+  for (size_t i = 0; i < file_mappings.size(); i++) {
+    if (!file_mappings[i]) {
+      FML_LOG(ERROR) << "Mapping " << matched_paths[i] << " failed";
+      continue;
     }
-    fml::VisitFiles(subdir_fd, visitor);
+    mappings.push_back(std::move(file_mappings[i]));
   }
 
   return mappings;
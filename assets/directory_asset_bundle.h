@@ -9,19 +9,29 @@
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
 class DirectoryAssetBundle : public AssetResolver {
  public:
-  DirectoryAssetBundle(fml::UniqueFD descriptor,
-                       bool is_valid_after_asset_manager_change);
+  //----------------------------------------------------------------------------
+  /// @param[in]  mapping_task_runner  An optional concurrent task runner used
+  ///                                  to map the files matched by
+  ///                                  |GetAsMappings| in parallel. If null,
+  ///                                  the files are mapped serially.
+  ///
+  DirectoryAssetBundle(
+      fml::UniqueFD descriptor,
+      bool is_valid_after_asset_manager_change,
+      std::shared_ptr<fml::BasicTaskRunner> mapping_task_runner = nullptr);
 
   ~DirectoryAssetBundle() override;
 
  private:
   const fml::UniqueFD descriptor_;
+  const std::shared_ptr<fml::BasicTaskRunner> mapping_task_runner_;
   bool is_valid_ = false;
   bool is_valid_after_asset_manager_change_ = false;
 
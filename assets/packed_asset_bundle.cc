@@ -0,0 +1,325 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// The entries follow the displacements, 8 byte aligned.
+uint64_t EntriesOffset(uint32_t entry_count) {
+  return AlignUp(sizeof(PackedAssetBundle::Header) +
+                     uint64_t{entry_count} * sizeof(int32_t),
+                 alignof(PackedAssetBundle::Entry));
+}
+
+// Fills `displacements` and `slots`, so that the asset `slots[i]` is at slot
+// `i` when looked up as described in |PackedAssetBundle|.
+void BuildPerfectHash(const std::vector<PackedAssetBundle::Asset>& assets,
+                      std::vector<int32_t>& displacements,
+                      std::vector<size_t>& slots) {
+  const uint32_t count = assets.size();
+  std::vector<std::vector<size_t>> buckets(count);
+  for (size_t i = 0; i < count; i++) {
+    buckets[PackedAssetBundle::Hash(assets[i].name, 0) % count].push_back(i);
+  }
+  std::vector<uint32_t> order(count);
+  for (uint32_t i = 0; i < count; i++) {
+    order[i] = i;
+  }
+  // Place the largest buckets first, while most slots are still free.
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  constexpr size_t kFree = static_cast<size_t>(-1);
+  displacements.assign(count, 0);
+  slots.assign(count, kFree);
+  std::vector<uint32_t> bucket_slots;
+  size_t next_free_slot = 0;
+  for (uint32_t bucket : order) {
+    const std::vector<size_t>& keys = buckets[bucket];
+    if (keys.empty()) {
+      break;
+    }
+    if (keys.size() == 1) {
+      // Buckets of one asset point at any free slot directly.
+      while (slots[next_free_slot] != kFree) {
+        next_free_slot++;
+      }
+      slots[next_free_slot] = keys[0];
+      displacements[bucket] = -static_cast<int32_t>(next_free_slot) - 1;
+      continue;
+    }
+    for (int32_t seed = 1;; seed++) {
+      bucket_slots.clear();
+      for (size_t key : keys) {
+        const uint32_t slot =
+            PackedAssetBundle::Hash(assets[key].name, seed) % count;
+        if (slots[slot] != kFree ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                bucket_slots.end()) {
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() == keys.size()) {
+        for (size_t i = 0; i < keys.size(); i++) {
+          slots[bucket_slots[i]] = keys[i];
+        }
+        displacements[bucket] = seed;
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::Create(
+    const fml::UniqueFD& directory,
+    const std::string& file_name,
+    bool is_valid_after_asset_manager_change) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Create");
+  if (!directory.is_valid() ||
+      !fml::FileExists(directory, file_name.c_str())) {
+    return nullptr;
+  }
+  std::shared_ptr<const fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(directory, file_name);
+  if (!mapping) {
+    return nullptr;
+  }
+  return Create(std::move(mapping), is_valid_after_asset_manager_change);
+}
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::Create(
+    std::shared_ptr<const fml::Mapping> mapping,
+    bool is_valid_after_asset_manager_change) {
+  if (!mapping) {
+    return nullptr;
+  }
+  std::unique_ptr<PackedAssetBundle> bundle(new PackedAssetBundle(
+      std::move(mapping), is_valid_after_asset_manager_change));
+  if (!bundle->ValidateLayout()) {
+    FML_LOG(ERROR) << "Invalid packed asset bundle.";
+    return nullptr;
+  }
+  return bundle;
+}
+
+PackedAssetBundle::PackedAssetBundle(
+    std::shared_ptr<const fml::Mapping> mapping,
+    bool is_valid_after_asset_manager_change)
+    : mapping_(std::move(mapping)),
+      is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+bool PackedAssetBundle::ValidateLayout() {
+  const uint8_t* base = mapping_->GetMapping();
+  const uint64_t size = mapping_->GetSize();
+  if (base == nullptr || size < sizeof(Header) ||
+      reinterpret_cast<uintptr_t>(base) % alignof(Entry) != 0) {
+    return false;
+  }
+  Header header;
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion) {
+    return false;
+  }
+  const uint64_t entries_offset = EntriesOffset(header.entry_count);
+  if (entries_offset + uint64_t{header.entry_count} * sizeof(Entry) > size) {
+    return false;
+  }
+  const auto* entries = reinterpret_cast<const Entry*>(base + entries_offset);
+  // Check the bounds once here, rather than on every lookup.
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    const Entry& entry = entries[i];
+    if (uint64_t{entry.name_offset} + entry.name_size > size ||
+        entry.data_offset + entry.stored_size > size ||
+        entry.data_offset + entry.stored_size < entry.data_offset) {
+      return false;
+    }
+  }
+  entry_count_ = header.entry_count;
+  displacements_ = reinterpret_cast<const int32_t*>(base + sizeof(Header));
+  entries_ = entries;
+  return true;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return entries_ != nullptr;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+uint32_t PackedAssetBundle::Hash(const std::string& name, uint32_t seed) {
+  // FNV-1a.
+  uint32_t hash = 2166136261u ^ (seed * 16777619u);
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const PackedAssetBundle::Entry* PackedAssetBundle::FindEntry(
+    const std::string& asset_name) const {
+  if (entry_count_ == 0) {
+    return nullptr;
+  }
+  const int32_t displacement =
+      displacements_[Hash(asset_name, 0) % entry_count_];
+  const uint32_t slot =
+      displacement < 0
+          ? static_cast<uint32_t>(-(displacement + 1))
+          : Hash(asset_name, static_cast<uint32_t>(displacement)) %
+                entry_count_;
+  if (slot >= entry_count_) {
+    return nullptr;
+  }
+  // Names that aren't in the bundle hash to some entry too.
+  const Entry& entry = entries_[slot];
+  if (entry.name_size != asset_name.size() ||
+      std::memcmp(mapping_->GetMapping() + entry.name_offset,
+                  asset_name.data(), asset_name.size()) != 0) {
+    return nullptr;
+  }
+  return &entry;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  const Entry* entry = FindEntry(asset_name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  const uint8_t* data = mapping_->GetMapping() + entry->data_offset;
+
+  if ((entry->flags & kCompressed) == 0) {
+    // The mapping keeps the file mapped, even past the lifetime of the
+    // bundle.
+    return std::make_unique<fml::NonOwnedMapping>(
+        data, entry->stored_size,
+        [mapping = mapping_](const uint8_t*, size_t) {},
+        mapping_->IsDontNeedSafe());
+  }
+
+  TRACE_EVENT1("flutter", "PackedAssetBundle::Inflate", "name",
+               asset_name.c_str());
+  std::vector<uint8_t> inflated(entry->size);
+  uLongf inflated_size = inflated.size();
+  if (uncompress(inflated.data(), &inflated_size, data, entry->stored_size) !=
+          Z_OK ||
+      inflated_size != inflated.size()) {
+    FML_LOG(ERROR) << "Could not inflate asset " << asset_name;
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(std::move(inflated));
+}
+
+std::vector<uint8_t> PackedAssetBundle::Pack(
+    const std::vector<Asset>& assets) {
+  const uint32_t count = assets.size();
+  std::unordered_set<std::string_view> names;
+  for (const Asset& asset : assets) {
+    if (!names.insert(asset.name).second) {
+      FML_LOG(ERROR) << "Duplicate asset " << asset.name;
+      return {};
+    }
+  }
+  std::vector<int32_t> displacements;
+  std::vector<size_t> slots;
+  if (count > 0) {
+    BuildPerfectHash(assets, displacements, slots);
+  }
+
+  std::vector<Entry> entries(count);
+  std::vector<std::vector<uint8_t>> stored_data(count);
+  uint64_t offset = EntriesOffset(count) + uint64_t{count} * sizeof(Entry);
+  for (uint32_t slot = 0; slot < count; slot++) {
+    const Asset& asset = assets[slots[slot]];
+    Entry& entry = entries[slot];
+    entry = {};
+    entry.name_offset = static_cast<uint32_t>(offset);
+    entry.name_size = static_cast<uint32_t>(asset.name.size());
+    offset += asset.name.size();
+  }
+  for (uint32_t slot = 0; slot < count; slot++) {
+    const Asset& asset = assets[slots[slot]];
+    Entry& entry = entries[slot];
+    entry.size = asset.data.size();
+    std::vector<uint8_t>& data = stored_data[slot];
+    if (asset.compress) {
+      uLongf compressed_size = compressBound(asset.data.size());
+      data.resize(compressed_size);
+      if (compress2(data.data(), &compressed_size, asset.data.data(),
+                    asset.data.size(), Z_BEST_COMPRESSION) == Z_OK &&
+          compressed_size < asset.data.size()) {
+        data.resize(compressed_size);
+        entry.flags |= kCompressed;
+      } else {
+        data = asset.data;
+      }
+    } else {
+      data = asset.data;
+    }
+    entry.stored_size = data.size();
+    // Page aligning small assets would mostly pad the file.
+    offset = AlignUp(offset, entry.stored_size >= kPageSize ? kPageSize
+                                                            : kEntryAlignment);
+    entry.data_offset = offset;
+    offset += entry.stored_size;
+  }
+
+  std::vector<uint8_t> packed(offset);
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entry_count = count;
+  std::memcpy(packed.data(), &header, sizeof(header));
+  std::memcpy(packed.data() + sizeof(header), displacements.data(),
+              displacements.size() * sizeof(int32_t));
+  std::memcpy(packed.data() + EntriesOffset(count), entries.data(),
+              entries.size() * sizeof(Entry));
+  for (uint32_t slot = 0; slot < count; slot++) {
+    const Entry& entry = entries[slot];
+    const std::string& name = assets[slots[slot]].name;
+    std::memcpy(packed.data() + entry.name_offset, name.data(), name.size());
+    std::memcpy(packed.data() + entry.data_offset, stored_data[slot].data(),
+                stored_data[slot].size());
+  }
+  return packed;
+}
+
+}  // namespace flutter
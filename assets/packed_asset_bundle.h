@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from a single file that packs all of them,
+///             instead of one file per asset.
+///
+///             The file is mapped once. Its header holds a minimal perfect
+///             hash of the asset names, so that each lookup reads one entry
+///             and compares one name. Entries are stored either as is, and
+///             returned as views of the mapped file without being copied,
+///             or deflated with zlib and inflated on lookup. Entries at
+///             least a page long start on a page boundary.
+///
+///             All integers are little endian. The layout is:
+///
+///             - |Header|
+///             - `int32_t displacements[entry_count]`
+///             - `Entry entries[entry_count]`, in hash slot order
+///             - the asset names, not null terminated
+///             - the asset data
+///
+///             An asset name is looked up by hashing it with a seed of 0,
+///             picking the displacement at that hash modulo the entry count,
+///             and then:
+///
+///             - for a negative displacement `d`, using entry `-d - 1`;
+///             - otherwise, using the entry at the hash of the name seeded
+///               with `d`, modulo the entry count.
+///
+///             Lookups are thread safe.
+///
+class PackedAssetBundle final : public AssetResolver {
+ public:
+  // The name the bundle has among the other assets of the application.
+  static constexpr char kFileName[] = "assets.pack";
+  static constexpr char kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '\0'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kPageSize = 4096;
+  static constexpr uint32_t kEntryAlignment = 16;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+  };
+
+  enum EntryFlags : uint32_t {
+    kCompressed = 1 << 0,
+  };
+
+  struct Entry {
+    uint64_t data_offset;
+    // The size of the data as stored in the file.
+    uint64_t stored_size;
+    // The size of the asset, after inflating it if it is compressed.
+    uint64_t size;
+    uint32_t name_offset;
+    uint32_t name_size;
+    uint32_t flags;
+    uint32_t reserved;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      An asset to pack with |Pack|.
+  ///
+  struct Asset {
+    std::string name;
+    std::vector<uint8_t> data;
+    // Whether to deflate the data. It is stored as is anyway if deflating
+    // does not make it smaller.
+    bool compress = false;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the packed bundle at `file_name` in `directory`.
+  ///
+  /// @return     The resolver, or nullptr if the file is missing or is not a
+  ///             valid packed bundle.
+  ///
+  static std::unique_ptr<PackedAssetBundle> Create(
+      const fml::UniqueFD& directory,
+      const std::string& file_name,
+      bool is_valid_after_asset_manager_change);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a resolver for a packed bundle already in memory.
+  ///
+  /// @return     The resolver, or nullptr if the mapping is not a valid
+  ///             packed bundle.
+  ///
+  static std::unique_ptr<PackedAssetBundle> Create(
+      std::shared_ptr<const fml::Mapping> mapping,
+      bool is_valid_after_asset_manager_change);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes assets into the packed bundle format.
+  ///
+  /// @return     The bundle, or an empty vector if two assets have the same
+  ///             name.
+  ///
+  static std::vector<uint8_t> Pack(const std::vector<Asset>& assets);
+
+  static uint32_t Hash(const std::string& name, uint32_t seed);
+
+  ~PackedAssetBundle() override;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+ private:
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  const bool is_valid_after_asset_manager_change_;
+  uint32_t entry_count_ = 0;
+  const int32_t* displacements_ = nullptr;
+  const Entry* entries_ = nullptr;
+
+  PackedAssetBundle(std::shared_ptr<const fml::Mapping> mapping,
+                    bool is_valid_after_asset_manager_change);
+
+  bool ValidateLayout();
+
+  const Entry* FindEntry(const std::string& asset_name) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
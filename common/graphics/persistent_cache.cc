@@ -4,8 +4,10 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -156,6 +158,41 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     return std::make_shared<fml::UniqueFD>();
   }
 }
+
+static std::map<std::string, uint32_t> ReadSkSLUsage(
+    const fml::UniqueFD& sksl_dir) {
+  std::map<std::string, uint32_t> counts;
+  if (!sksl_dir.is_valid()) {
+    return counts;
+  }
+  fml::UniqueFD file =
+      fml::OpenFileReadOnly(sksl_dir, PersistentCache::kSkSLUsageFileName);
+  if (!file.is_valid()) {
+    return counts;
+  }
+  fml::FileMapping mapping(file);
+  if (mapping.GetMapping() == nullptr) {
+    return counts;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                  mapping.GetSize()));
+  std::string file_name;
+  uint32_t count;
+  while (stream >> file_name >> count) {
+    counts[file_name] = count;
+  }
+  return counts;
+}
+
+static std::string SerializeSkSLUsage(
+    const std::map<std::string, uint32_t>& counts) {
+  std::ostringstream stream;
+  for (const auto& [file_name, count] : counts) {
+    stream << file_name << " " << count << "\n";
+  }
+  return stream.str();
+}
 }  // namespace
 
 sk_sp<SkData> ParseBase32(const std::string& input) {
@@ -204,6 +241,23 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
     return 0;
   }
 
+  {
+    std::vector<std::pair<uint32_t, size_t>> order;
+    order.reserve(known_sksls.size());
+    for (size_t i = 0; i < known_sksls.size(); i++) {
+      order.emplace_back(GetSkSLUsageCount(*known_sksls[i].key), i);
+    }
+    std::stable_sort(
+        order.begin(), order.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<SkSLCache> sorted_sksls;
+    sorted_sksls.reserve(known_sksls.size());
+    for (const auto& [count, index] : order) {
+      sorted_sksls.push_back(std::move(known_sksls[index]));
+    }
+    known_sksls = std::move(sorted_sksls);
+  }
+
   size_t precompiled_count = 0;
   for (const auto& sksl : known_sksls) {
     TRACE_EVENT0("flutter", "PrecompilingSkSL");
@@ -223,6 +277,9 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   std::vector<PersistentCache::SkSLCache> result;
   fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
                                        const std::string& filename) {
+    if (filename == kSkSLUsageFileName) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
       result.push_back(cache);
@@ -279,7 +336,9 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      sksl_usage_(std::make_shared<SkSLUsage>()) {
+  sksl_usage_->counts = ReadSkSLUsage(*sksl_cache_directory_);
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -336,6 +395,9 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (file_name.empty()) {
     return nullptr;
   }
+  if (cache_sksl_) {
+    RecordSkSLUsage(file_name);
+  }
   auto result =
       PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
@@ -423,6 +485,51 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+uint32_t PersistentCache::GetSkSLUsageCount(const SkData& key) const {
+  std::scoped_lock lock(sksl_usage_->mutex);
+  auto found = sksl_usage_->counts.find(SkKeyToFilePath(key));
+  return found == sksl_usage_->counts.end() ? 0u : found->second;
+}
+
+void PersistentCache::RecordSkSLUsage(const std::string& file_name) {
+  {
+    std::scoped_lock lock(sksl_usage_->mutex);
+    sksl_usage_->counts[file_name]++;
+    if (is_read_only_ || !sksl_cache_directory_->is_valid() ||
+        sksl_usage_->write_pending) {
+      return;
+    }
+    sksl_usage_->write_pending = true;
+  }
+
+  auto worker = GetWorkerTaskRunner();
+  if (!worker) {
+    // Unlike the shaders themselves, the counts are not worth writing on the
+    // frame workload. They are written with the next count once there is a
+    // worker.
+    std::scoped_lock lock(sksl_usage_->mutex);
+    sksl_usage_->write_pending = false;
+    return;
+  }
+
+  // Counts recorded before the task runs are written by it too.
+  worker->PostTask([usage = sksl_usage_,
+                    sksl_cache_directory = sksl_cache_directory_]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStoreSkSLUsage");
+    std::string serialized;
+    {
+      std::scoped_lock lock(usage->mutex);
+      serialized = SerializeSkSLUsage(usage->counts);
+      usage->write_pending = false;
+    }
+    fml::DataMapping mapping(std::move(serialized));
+    if (!fml::WriteAtomically(*sksl_cache_directory, kSkSLUsageFileName,
+                              mapping)) {
+      FML_LOG(WARNING) << "Could not write the SkSL usage counts.";
+    }
+  });
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -98,9 +99,16 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   /// Load all the SkSL shader caches in the right directory.
   std::vector<SkSLCache> LoadSkSLs() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      How many times Skia asked for the shader with the given key
+  ///             while caching SkSLs, in this and previous runs.
+  ///
+  uint32_t GetSkSLUsageCount(const SkData& key) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Precompile SkSLs packaged with the application and gathered
-  ///             during previous runs in the given context.
+  ///             during previous runs in the given context. The most used
+  ///             SkSLs are compiled first.
   ///
   /// @warning    The context must be the rendering context. This context may be
   ///             destroyed during application suspension and subsequently
@@ -131,6 +139,9 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  // Stored in the SkSL directory next to the SkSLs. Each line holds the file
+  // name of an SkSL and its usage count.
+  static constexpr char kSkSLUsageFileName[] = "sksl_usage";
 
  private:
   static std::string cache_base_path_;
@@ -159,6 +170,17 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
 
+  // Shared with the tasks that write it to the SkSL directory.
+  struct SkSLUsage {
+    std::mutex mutex;
+    // By the file name of the SkSL.
+    std::map<std::string, uint32_t> counts;
+    bool write_pending = false;
+  };
+  const std::shared_ptr<SkSLUsage> sksl_usage_;
+
+  void RecordSkSLUsage(const std::string& file_name);
+
   static SkSLCache LoadFile(const fml::UniqueFD& dir,
                             const std::string& file_name,
                             bool need_key);
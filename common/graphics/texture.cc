@@ -4,13 +4,26 @@
 
 #include "flutter/common/graphics/texture.h"
 
+#include <atomic>
+
 namespace flutter {
 
+namespace {
+
+std::atomic<uint64_t> next_frame_generation = 1;
+
+uint64_t NextFrameGeneration() {
+  return next_frame_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
 ContextListener::ContextListener() = default;
 
 ContextListener::~ContextListener() = default;
 
-Texture::Texture(int64_t id) : id_(id) {}
+Texture::Texture(int64_t id)
+    : id_(id), frame_generation_(NextFrameGeneration()) {}
 
 Texture::~Texture() = default;
 
@@ -51,6 +64,8 @@ void TextureRegistry::UnregisterContextListener(uintptr_t id) {
 
 void TextureRegistry::OnGrContextCreated() {
   for (auto& it : mapping_) {
+    // The frames are imported again into the new context.
+    it.second->frame_generation_ = NextFrameGeneration();
     it.second->OnGrContextCreated();
   }
 
@@ -95,4 +110,13 @@ std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
   return it != mapping_.end() ? it->second : nullptr;
 }
 
+void TextureRegistry::MarkTextureFrameAvailable(int64_t id) {
+  auto it = mapping_.find(id);
+  if (it == mapping_.end()) {
+    return;
+  }
+  it->second->frame_generation_ = NextFrameGeneration();
+  it->second->MarkNewFrameAvailable();
+}
+
 }  // namespace flutter
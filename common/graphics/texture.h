@@ -5,6 +5,7 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 #define FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 
+#include <cstdint>
 #include <map>
 
 #include "flutter/display_list/dl_canvas.h"
@@ -62,8 +63,17 @@ class Texture : public ContextListener {
 
   int64_t Id() { return id_; }
 
+  // The generation of the frame the texture paints. It changes whenever the
+  // texture may paint a different frame, and is never shared with another
+  // texture, so layers can tell whether they need to be repainted.
+  uint64_t frame_generation() const { return frame_generation_; }
+
  private:
   int64_t id_;
+  uint64_t frame_generation_;
+
+  friend class TextureRegistry;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
@@ -87,6 +97,10 @@ class TextureRegistry {
   // Called from raster thread.
   std::shared_ptr<Texture> GetTexture(int64_t id);
 
+  // Called from raster thread. Starts a new frame generation for the texture
+  // and tells it that a new frame is available.
+  void MarkTextureFrameAvailable(int64_t id);
+
   // Called from raster thread.
   void OnGrContextCreated();
 
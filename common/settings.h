@@ -146,6 +146,10 @@ struct Settings {
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Record the most recent trace events of each thread in an in-memory ring
+  // buffer that can be dumped via the service protocol, even when no timeline
+  // recorder is attached.
+  bool trace_flight_recorder = false;
   std::string trace_to_file;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
@@ -218,6 +222,12 @@ struct Settings {
   bool enable_impeller = false;
 #endif
 
+  // Pin the UI and raster threads to the performance cores, and the IO and
+  // concurrent worker threads to the efficiency cores, on devices with
+  // heterogeneous cores. Only honored where fml::RequestAffinity is
+  // supported.
+  bool pin_threads_to_core_classes = false;
+
   // Requests a particular backend to be used (ex "opengles" or "vulkan")
   std::optional<std::string> impeller_backend;
 
@@ -225,6 +235,11 @@ struct Settings {
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // The number of frames the raster thread may submit to the GPU before it
+  // waits for the oldest of them to finish. 0 keeps the default of the
+  // backend. Only honored by the Vulkan swapchain of Impeller.
+  uint32_t max_frames_in_flight = 0;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -323,6 +338,52 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // Max bytes of the images held by the raster cache, or 0 for unlimited.
+  // With a limit, images that go unused are kept until they no longer fit.
+  size_t raster_cache_max_bytes = 0;
+
+  // Rasterize new display list raster cache entries after the frame that
+  // decides to cache them, drawing them directly until they are ready.
+  bool enable_async_raster_cache = false;
+
+  // Share the preroll of wide layer trees with the concurrent worker pool.
+  bool enable_concurrent_preroll = false;
+
+  // Diff retained layer subtrees without copying their paint regions to
+  // every frame, which makes partial repaint of mostly static trees cheaper.
+  // Frames rasterized without the raster cache also skip the preroll of
+  // retained subtrees whose transform and clip didn't change.
+  bool enable_incremental_diff = false;
+
+  // Keep a single frame in flight while a pointer is down or the raster thread
+  // keeps up, and only let the UI thread work ahead during sustained raster
+  // bound periods.
+  bool enable_adaptive_pipeline_depth = false;
+
+  // Begin the UI work of each frame as late after vsync as recent frame build
+  // times allow, so that frames sample the latest input.
+  bool enable_vsync_phase_offset = false;
+
+  // Engines spawned from a shell with `Shell::Spawn` share its image decoder
+  // and the Impeller resources its rasterizer uses without a surface, instead
+  // of creating their own. The font collection and the IO manager are always
+  // shared.
+  bool share_resources_with_spawned_engines = false;
+
+  // Diff every frame against the one on screen, and don't acquire or submit a
+  // surface frame at all when nothing changed.
+  bool enable_unchanged_frame_skipping = false;
+
+  // Let the OS drop the resident pages of the isolate snapshot while the app
+  // is paused, and read them ahead again when it resumes. Only has an effect
+  // on snapshots that are mapped from files.
+  bool release_snapshot_pages_in_background = false;
+
+  // The number of embedder objects for isolates spawned from Dart code, such
+  // as with `Isolate.run`, that each isolate group makes ahead of time on a
+  // concurrent worker. 0 makes them when the isolates are spawned.
+  size_t child_isolate_pool_size = 0;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
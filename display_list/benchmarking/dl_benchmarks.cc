@@ -5,16 +5,14 @@
 #include "flutter/display_list/benchmarking/dl_benchmarks.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_op_flags.h"
-#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
-#include "third_party/skia/include/gpu/GrDirectContext.h"
-#include "third_party/skia/include/gpu/GrRecordingContext.h"
-#include "third_party/skia/include/gpu/GrTypes.h"
 
 namespace flutter {
 namespace testing {
@@ -42,14 +40,27 @@ DlPaint GetPaintForRun(unsigned attributes) {
   return paint;
 }
 
-static void FlushSubmitCpuSync(const sk_sp<SkSurface>& surface) {
-  if (!surface) {
-    return;
-  }
-  if (GrDirectContext* dContext =
-          GrAsDirectContext(surface->recordingContext())) {
-    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+// Renders |display_list| into |surface| once per iteration, and reports the
+// time spent encoding it on the CPU separately from the time spent waiting
+// for the backend to execute it.
+static void RenderForEachIteration(benchmark::State& state,
+                                   DlSurfaceInstance& surface,
+                                   const sk_sp<DisplayList>& display_list) {
+  fml::TimeDelta encode_time;
+  fml::TimeDelta flush_time;
+  for ([[maybe_unused]] auto _ : state) {
+    auto start = fml::TimePoint::Now();
+    surface.RenderDisplayList(display_list);
+    auto encoded = fml::TimePoint::Now();
+    surface.FlushSubmitCpuSync();
+    auto flushed = fml::TimePoint::Now();
+    encode_time = encode_time + (encoded - start);
+    flush_time = flush_time + (flushed - encoded);
   }
+  state.counters["EncodeTimeMs"] = benchmark::Counter(
+      encode_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["FlushTimeMs"] = benchmark::Counter(
+      flush_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
 }
 
 void AnnotateAttributes(unsigned attributes,
@@ -99,8 +110,7 @@ void BM_DrawLine(benchmark::State& state,
   size_t length = state.range(0);
 
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   state.counters["DrawCallCount"] = kLinesToDraw;
   for (size_t i = 0; i < kLinesToDraw; i++) {
@@ -111,10 +121,7 @@ void BM_DrawLine(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawLine-" +
                   std::to_string(state.range(0)) + ".png";
@@ -137,8 +144,7 @@ void BM_DrawRect(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   // As rects have SkScalar dimensions, we want to ensure that we also
   // draw rects with non-integer position and size
@@ -160,10 +166,7 @@ void BM_DrawRect(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawRect-" +
                   std::to_string(state.range(0)) + ".png";
@@ -186,8 +189,7 @@ void BM_DrawOval(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkRect rect = SkRect::MakeXYWH(0, 0, length * 1.5f, length);
   const SkScalar offset = 0.5f;
@@ -206,10 +208,7 @@ void BM_DrawOval(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawOval-" +
                   std::to_string(state.range(0)) + ".png";
@@ -232,8 +231,7 @@ void BM_DrawCircle(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkScalar radius = length / 2.0f;
   const SkScalar offset = 0.5f;
@@ -254,10 +252,7 @@ void BM_DrawCircle(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawCircle-" +
                   std::to_string(state.range(0)) + ".png";
@@ -281,8 +276,7 @@ void BM_DrawRRect(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkVector radii[4] = {};
   switch (type) {
@@ -332,10 +326,7 @@ void BM_DrawRRect(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawRRect-" +
                   std::to_string(state.range(0)) + ".png";
@@ -362,8 +353,7 @@ void BM_DrawDRRect(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkVector radii[4] = {};
   switch (type) {
@@ -414,10 +404,7 @@ void BM_DrawDRRect(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawDRRect-" +
                   std::to_string(state.range(0)) + ".png";
@@ -437,8 +424,7 @@ void BM_DrawArc(benchmark::State& state,
   size_t length = state.range(0);
   size_t canvas_size = length * 2;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkScalar starting_angle = 0.0f;
   SkScalar offset = 0.5f;
@@ -467,10 +453,7 @@ void BM_DrawArc(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawArc-" +
                   std::to_string(state.range(0)) + ".png";
@@ -651,8 +634,7 @@ void BM_DrawPath(benchmark::State& state,
 
   size_t length = kFixedCanvasSize;
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkPath path;
 
@@ -670,10 +652,7 @@ void BM_DrawPath(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawPath-" + label +
                   "-" + std::to_string(state.range(0)) + ".png";
@@ -789,8 +768,7 @@ void BM_DrawVertices(benchmark::State& state,
 
   size_t length = kFixedCanvasSize;
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkPoint center = SkPoint::Make(length / 2.0f, length / 2.0f);
 
@@ -816,10 +794,7 @@ void BM_DrawVertices(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawVertices-" +
                   std::to_string(disc_count) + "-" + VertexModeToString(mode) +
@@ -898,8 +873,7 @@ void BM_DrawPoints(benchmark::State& state,
 
   size_t length = kFixedCanvasSize;
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   size_t point_count = state.range(0);
   state.SetComplexityN(point_count);
@@ -912,10 +886,7 @@ void BM_DrawPoints(benchmark::State& state,
 
   auto display_list = builder.Build();
 
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawPoints-" +
                   PointModeToString(mode) + "-" + std::to_string(point_count) +
@@ -949,8 +920,7 @@ void BM_DrawImage(benchmark::State& state,
   size_t bitmap_size = state.range(0);
   size_t canvas_size = 2 * bitmap_size;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   sk_sp<SkImage> image;
   std::shared_ptr<DlSurfaceInstance> offscreen_instance;
@@ -990,10 +960,7 @@ void BM_DrawImage(benchmark::State& state,
 
   auto display_list = builder.Build();
 
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawImage-" +
                   (upload_bitmap ? "Upload-" : "Texture-") +
@@ -1032,8 +999,7 @@ void BM_DrawImageRect(benchmark::State& state,
   size_t bitmap_size = state.range(0);
   size_t canvas_size = 2 * bitmap_size;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   sk_sp<SkImage> image;
   std::shared_ptr<DlSurfaceInstance> offscreen_instance;
@@ -1076,10 +1042,7 @@ void BM_DrawImageRect(benchmark::State& state,
 
   auto display_list = builder.Build();
 
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawImageRect-" +
                   (upload_bitmap ? "Upload-" : "Texture-") +
@@ -1119,8 +1082,7 @@ void BM_DrawImageNine(benchmark::State& state,
   size_t bitmap_size = state.range(0);
   size_t canvas_size = 2 * bitmap_size;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkIRect center = SkIRect::MakeXYWH(bitmap_size / 4, bitmap_size / 4,
                                      bitmap_size / 2, bitmap_size / 2);
@@ -1163,10 +1125,7 @@ void BM_DrawImageNine(benchmark::State& state,
 
   auto display_list = builder.Build();
 
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawImageNine-" +
                   (upload_bitmap ? "Upload-" : "Texture-") +
@@ -1194,8 +1153,7 @@ void BM_DrawTextBlob(benchmark::State& state,
   size_t draw_calls = state.range(0);
   size_t canvas_size = kFixedCanvasSize;
   surface_provider->InitializeSurface(canvas_size, canvas_size);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   state.counters["DrawCallCount_Varies"] = draw_calls;
   state.counters["GlyphCount"] = draw_calls;
@@ -1209,10 +1167,7 @@ void BM_DrawTextBlob(benchmark::State& state,
 
   auto display_list = builder.Build();
 
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawTextBlob-" +
                   std::to_string(draw_calls) + ".png";
@@ -1240,8 +1195,7 @@ void BM_DrawShadow(benchmark::State& state,
 
   size_t length = kFixedCanvasSize;
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   SkPath path;
 
@@ -1275,10 +1229,7 @@ void BM_DrawShadow(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-DrawShadow-" +
                   VerbToString(type) + "-" +
@@ -1305,8 +1256,7 @@ void BM_SaveLayer(benchmark::State& state,
 
   size_t length = kFixedCanvasSize;
   surface_provider->InitializeSurface(length, length);
-  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
-  auto canvas = DlSkCanvasAdapter(surface->getCanvas());
+  auto surface = surface_provider->GetPrimarySurface();
 
   size_t save_layer_calls = state.range(0);
 
@@ -1329,10 +1279,7 @@ void BM_SaveLayer(benchmark::State& state,
   auto display_list = builder.Build();
 
   // We only want to time the actual rasterization.
-  for ([[maybe_unused]] auto _ : state) {
-    canvas.DrawDisplayList(display_list);
-    FlushSubmitCpuSync(surface);
-  }
+  RenderForEachIteration(state, *surface, display_list);
 
   auto filename = surface_provider->backend_name() + "-SaveLayer-" +
                   std::to_string(save_depth) + "-" +
@@ -1352,5 +1299,17 @@ RUN_DISPLAYLIST_BENCHMARKS(OpenGL)
 RUN_DISPLAYLIST_BENCHMARKS(Metal)
 #endif
 
+#ifdef ENABLE_IMPELLER_METAL_BENCHMARKS
+RUN_IMPELLER_DISPLAYLIST_BENCHMARKS(ImpellerMetal)
+#endif
+
+#ifdef ENABLE_IMPELLER_OPENGLES_BENCHMARKS
+RUN_IMPELLER_DISPLAYLIST_BENCHMARKS(ImpellerOpenGLES)
+#endif
+
+#ifdef ENABLE_IMPELLER_VULKAN_BENCHMARKS
+RUN_IMPELLER_DISPLAYLIST_BENCHMARKS(ImpellerVulkan)
+#endif
+
 }  // namespace testing
 }  // namespace flutter
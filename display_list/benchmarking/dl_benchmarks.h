@@ -582,6 +582,19 @@ void BM_SaveLayer(benchmark::State& state,
   ANTI_ALIASING_BENCHMARKS(BACKEND, kAntiAliasing_Flag)                  \
   OTHER_BENCHMARKS(BACKEND, kEmpty_Flag)
 
+// The image benchmarks draw Skia images, which Impeller can't draw.
+#define RUN_IMPELLER_DISPLAYLIST_BENCHMARKS(BACKEND)                     \
+  STROKE_BENCHMARKS(BACKEND, kStrokedStyle_Flag)                         \
+  STROKE_BENCHMARKS(BACKEND, kStrokedStyle_Flag | kAntiAliasing_Flag)    \
+  STROKE_BENCHMARKS(BACKEND, kStrokedStyle_Flag | kHairlineStroke_Flag)  \
+  STROKE_BENCHMARKS(BACKEND, kStrokedStyle_Flag | kHairlineStroke_Flag | \
+                             kAntiAliasing_Flag)                         \
+  FILL_BENCHMARKS(BACKEND, kFilledStyle_Flag)                            \
+  FILL_BENCHMARKS(BACKEND, kFilledStyle_Flag | kAntiAliasing_Flag)       \
+  DRAW_VERTICES_BENCHMARKS(BACKEND, kEmpty_Flag)                         \
+  DRAW_SHADOW_BENCHMARKS(BACKEND, kEmpty_Flag)                           \
+  SAVE_LAYER_BENCHMARKS(BACKEND, kEmpty_Flag)
+
 // clang-format on
 
 }  // namespace testing
@@ -149,6 +149,47 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+// Records one list with |state.range(0)| rect ops, like a chart with many
+// data points.
+static void BM_DisplayListBuilderLargeList(benchmark::State& state) {
+  DlPaint paint;
+  const int op_count = state.range(0);
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(true);
+    for (int i = 0; i < op_count; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i % 256, i / 256, 1, 1), paint);
+    }
+    Complete(builder, DisplayListBuilderBenchmarkType::kDefault);
+  }
+  state.SetItemsProcessed(state.iterations() * op_count);
+}
+
+// Same as above, but reuses one builder for every list, as a long lived
+// recorder would from frame to frame.
+static void BM_DisplayListBuilderLargeListReused(benchmark::State& state) {
+  DlPaint paint;
+  const int op_count = state.range(0);
+  DisplayListBuilder builder(true);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < op_count; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i % 256, i / 256, 1, 1), paint);
+    }
+    Complete(builder, DisplayListBuilderBenchmarkType::kDefault);
+  }
+  state.SetItemsProcessed(state.iterations() * op_count);
+}
+
+BENCHMARK(BM_DisplayListBuilderLargeList)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DisplayListBuilderLargeListReused)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
+#include "flutter/display_list/benchmarking/dl_complexity_calibrated.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
@@ -22,6 +23,11 @@ DisplayListNaiveComplexityCalculator::GetInstance() {
 
 DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
     GrBackendApi backend) {
+  DisplayListComplexityCalculator* calibrated =
+      DisplayListCalibratedComplexityCalculator::GetInstance();
+  if (calibrated) {
+    return calibrated;
+  }
   switch (backend) {
     case GrBackendApi::kMetal:
       return DisplayListMetalComplexityCalculator::GetInstance();
@@ -0,0 +1,519 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_calibrated.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+namespace {
+
+// Complexity scores are normalised so that 100 is 0.0005ms, see the comments
+// in dl_complexity_helper.h.
+constexpr double kNanosecondsPerScore = 5.0;
+
+constexpr char kSerializationTag[] = "dl_complexity_coefficients";
+constexpr int kSerializationVersion = 1;
+
+// Returns the size metric of an op drawn by a probe of |size|.
+double ProbeUnits(DlComplexityOpKind kind, unsigned int size) {
+  switch (kind) {
+    case DlComplexityOpKind::kFilledShape:
+    case DlComplexityOpKind::kImage:
+    case DlComplexityOpKind::kShadow:
+      return static_cast<double>(size) * size;
+    case DlComplexityOpKind::kPath:
+      // The probe path starts with a move followed by |size| lines.
+      return size + 1.0;
+    case DlComplexityOpKind::kText:
+    case DlComplexityOpKind::kSaveLayer:
+      return 0.0;
+    case DlComplexityOpKind::kLine:
+    case DlComplexityOpKind::kStrokedShape:
+    case DlComplexityOpKind::kPoints:
+    case DlComplexityOpKind::kVertices:
+      return size;
+  }
+  FML_UNREACHABLE();
+}
+
+std::vector<unsigned int> ProbeSizes(DlComplexityOpKind kind) {
+  switch (kind) {
+    case DlComplexityOpKind::kPath:
+    case DlComplexityOpKind::kPoints:
+      return {16, 64, 256, 1024};
+    case DlComplexityOpKind::kVertices:
+      // Multiples of 3 so that every vertex belongs to a triangle.
+      return {48, 192, 768, 3072};
+    case DlComplexityOpKind::kText:
+    case DlComplexityOpKind::kSaveLayer:
+      return {1};
+    case DlComplexityOpKind::kLine:
+    case DlComplexityOpKind::kFilledShape:
+    case DlComplexityOpKind::kStrokedShape:
+    case DlComplexityOpKind::kImage:
+    case DlComplexityOpKind::kShadow:
+      return {16, 64, 256, 512};
+  }
+  FML_UNREACHABLE();
+}
+
+struct Sample {
+  double units;
+  double ns;
+};
+
+// Fits cost = per_op + per_unit * units by least squares. Neither term may
+// be negative, since no op renders in less than no time.
+DlComplexityCoefficients::Cost FitCost(const std::vector<Sample>& samples) {
+  DlComplexityCoefficients::Cost cost;
+  if (samples.empty()) {
+    return cost;
+  }
+  double mean_units = 0.0;
+  double mean_ns = 0.0;
+  for (const Sample& sample : samples) {
+    mean_units += sample.units;
+    mean_ns += sample.ns;
+  }
+  mean_units /= samples.size();
+  mean_ns /= samples.size();
+
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (const Sample& sample : samples) {
+    covariance += (sample.units - mean_units) * (sample.ns - mean_ns);
+    variance += (sample.units - mean_units) * (sample.units - mean_units);
+  }
+  if (variance > 0.0 && covariance > 0.0) {
+    cost.per_unit_ns = covariance / variance;
+    cost.per_op_ns = mean_ns - cost.per_unit_ns * mean_units;
+    if (cost.per_op_ns < 0.0) {
+      // Fit a line through the origin instead.
+      double units_ns = 0.0;
+      double units_squared = 0.0;
+      for (const Sample& sample : samples) {
+        units_ns += sample.units * sample.ns;
+        units_squared += sample.units * sample.units;
+      }
+      cost.per_op_ns = 0.0;
+      cost.per_unit_ns = units_ns / units_squared;
+    }
+  } else {
+    cost.per_op_ns = std::max(mean_ns, 0.0);
+  }
+  return cost;
+}
+
+}  // namespace
+
+std::string DlComplexityCoefficients::Serialize() const {
+  std::ostringstream stream;
+  stream.precision(17);
+  stream << kSerializationTag << ' ' << kSerializationVersion << ' '
+         << kDlComplexityOpKindCount;
+  for (const auto& kind_costs : costs) {
+    for (const Cost& cost : kind_costs) {
+      stream << ' ' << cost.per_op_ns << ' ' << cost.per_unit_ns;
+    }
+  }
+  return stream.str();
+}
+
+std::optional<DlComplexityCoefficients> DlComplexityCoefficients::Deserialize(
+    std::string_view serialized) {
+  std::istringstream stream{std::string(serialized)};
+  std::string tag;
+  int version = 0;
+  size_t kind_count = 0;
+  stream >> tag >> version >> kind_count;
+  if (!stream || tag != kSerializationTag ||
+      version != kSerializationVersion ||
+      kind_count != kDlComplexityOpKindCount) {
+    return std::nullopt;
+  }
+  DlComplexityCoefficients coefficients;
+  for (auto& kind_costs : coefficients.costs) {
+    for (Cost& cost : kind_costs) {
+      stream >> cost.per_op_ns >> cost.per_unit_ns;
+      if (!stream || !std::isfinite(cost.per_op_ns) ||
+          !std::isfinite(cost.per_unit_ns) || cost.per_op_ns < 0.0 ||
+          cost.per_unit_ns < 0.0) {
+        return std::nullopt;
+      }
+    }
+  }
+  stream >> std::ws;
+  if (!stream.eof()) {
+    return std::nullopt;
+  }
+  return coefficients;
+}
+
+bool DlComplexityCoefficients::operator==(
+    const DlComplexityCoefficients& other) const {
+  for (size_t i = 0; i < kDlComplexityOpKindCount; i++) {
+    if (!(costs[i][0] == other.costs[i][0]) ||
+        !(costs[i][1] == other.costs[i][1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class DisplayListCalibratedComplexityCalculator::CalibratedHelper
+    : public ComplexityCalculatorHelper {
+ public:
+  CalibratedHelper(const DlComplexityCoefficients& coefficients,
+                   unsigned int ceiling)
+      : ComplexityCalculatorHelper(ceiling), coefficients_(coefficients) {}
+
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    if (IsComplex()) {
+      return;
+    }
+    if (backdrop) {
+      // As with the GL and Metal calculators, a backdrop filter only ever
+      // appears in frame-wide builders which are not evaluated for
+      // complexity.
+      AccumulateComplexity(Ceiling());
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kSaveLayer, 0.0);
+  }
+
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kLine,
+               std::abs(p0.x() - p1.x()) + std::abs(p0.y() - p1.y()));
+  }
+
+  void drawRect(const SkRect& rect) override { Shape(rect); }
+
+  void drawOval(const SkRect& bounds) override { Shape(bounds); }
+
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Shape(SkRect::MakeLTRB(center.x() - radius, center.y() - radius,
+                           center.x() + radius, center.y() + radius));
+  }
+
+  void drawRRect(const SkRRect& rrect) override { Shape(rrect.rect()); }
+
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Shape(outer.rect());
+  }
+
+  void drawPath(const SkPath& path) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kPath, path.countVerbs());
+  }
+
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Shape(oval_bounds);
+  }
+
+  void drawPoints(DlCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kPoints, count);
+  }
+
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kVertices, vertices->vertex_count());
+  }
+
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (IsComplex()) {
+      return;
+    }
+    ImageRect(image->dimensions(), image->isTextureBacked(),
+              render_with_attributes, false);
+  }
+
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    if (IsComplex()) {
+      return;
+    }
+    ImageRect(image->dimensions(), image->isTextureBacked(),
+              render_with_attributes, false);
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    if (IsComplex()) {
+      return;
+    }
+    CalibratedHelper helper(coefficients_,
+                            Ceiling() - CurrentComplexityScore());
+    if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+      helper.saveLayer(nullptr, SaveLayerOptions::kWithAttributes, nullptr);
+    }
+    display_list->Dispatch(helper);
+    AccumulateComplexity(helper.ComplexityScore());
+  }
+
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kText, 0.0);
+  }
+
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    if (IsComplex()) {
+      return;
+    }
+    Accumulate(DlComplexityOpKind::kText, 0.0);
+  }
+
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    if (IsComplex()) {
+      return;
+    }
+    const SkRect& bounds = path.getBounds();
+    Accumulate(DlComplexityOpKind::kShadow, bounds.width() * bounds.height());
+  }
+
+ protected:
+  void ImageRect(const SkISize& size,
+                 bool texture_backed,
+                 bool render_with_attributes,
+                 bool enforce_src_edges) override {
+    Accumulate(DlComplexityOpKind::kImage,
+               static_cast<double>(size.width()) * size.height());
+  }
+
+  unsigned int BatchedComplexity() override { return 0; }
+
+ private:
+  void Shape(const SkRect& bounds) {
+    if (IsComplex()) {
+      return;
+    }
+    if (DrawStyle() == DlDrawStyle::kFill) {
+      Accumulate(DlComplexityOpKind::kFilledShape,
+                 bounds.width() * bounds.height());
+    } else {
+      Accumulate(DlComplexityOpKind::kStrokedShape,
+                 (bounds.width() + bounds.height()) / 2);
+    }
+  }
+
+  void Accumulate(DlComplexityOpKind kind, double units) {
+    const DlComplexityCoefficients::Cost& cost =
+        coefficients_.Get(kind, IsAntiAliased());
+    double score =
+        (cost.per_op_ns + cost.per_unit_ns * units) / kNanosecondsPerScore;
+    AccumulateComplexity(score < Ceiling() ? static_cast<unsigned int>(score)
+                                           : Ceiling());
+  }
+
+  const DlComplexityCoefficients& coefficients_;
+};
+
+DisplayListCalibratedComplexityCalculator*
+    DisplayListCalibratedComplexityCalculator::instance_ = nullptr;
+
+DisplayListCalibratedComplexityCalculator*
+DisplayListCalibratedComplexityCalculator::GetInstance() {
+  return instance_;
+}
+
+void DisplayListCalibratedComplexityCalculator::Install(
+    std::optional<DlComplexityCoefficients> coefficients) {
+  delete instance_;
+  instance_ = coefficients.has_value()
+                  ? new DisplayListCalibratedComplexityCalculator(
+                        coefficients.value())
+                  : nullptr;
+}
+
+unsigned int DisplayListCalibratedComplexityCalculator::Compute(
+    const DisplayList* display_list) {
+  CalibratedHelper helper(coefficients_, ceiling_);
+  display_list->Dispatch(helper);
+  return helper.ComplexityScore();
+}
+
+DlComplexityCoefficients DlComplexityCalibrator::Calibrate() const {
+  DlComplexityCoefficients coefficients;
+  for (size_t i = 0; i < kDlComplexityOpKindCount; i++) {
+    auto kind = static_cast<DlComplexityOpKind>(i);
+    for (bool anti_alias : {false, true}) {
+      std::vector<Sample> samples;
+      for (unsigned int size : ProbeSizes(kind)) {
+        sk_sp<DisplayList> single = BuildProbe(kind, anti_alias, size,
+                                               op_count_);
+        sk_sp<DisplayList> twice = BuildProbe(kind, anti_alias, size,
+                                              op_count_ * 2);
+        if (!single || !twice) {
+          break;
+        }
+        double ns = render_timer_(twice) - render_timer_(single);
+        samples.push_back({ProbeUnits(kind, size), ns / op_count_});
+      }
+      coefficients.Get(kind, anti_alias) = FitCost(samples);
+    }
+  }
+  return coefficients;
+}
+
+sk_sp<DisplayList> DlComplexityCalibrator::BuildProbe(DlComplexityOpKind kind,
+                                                       bool anti_alias,
+                                                       unsigned int size,
+                                                       unsigned int count) {
+  DlPaint paint;
+  paint.setAntiAlias(anti_alias);
+  paint.setColor(DlColor::kBlue());
+  DisplayListBuilder builder;
+  SkScalar extent = static_cast<SkScalar>(size);
+  switch (kind) {
+    case DlComplexityOpKind::kLine: {
+      paint.setStrokeWidth(1.0f);
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawLine(SkPoint::Make(0, 0), SkPoint::Make(extent, 0), paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kFilledShape:
+    case DlComplexityOpKind::kStrokedShape: {
+      if (kind == DlComplexityOpKind::kStrokedShape) {
+        paint.setDrawStyle(DlDrawStyle::kStroke);
+        paint.setStrokeWidth(1.0f);
+      }
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawRect(SkRect::MakeWH(extent, extent), paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kPath: {
+      SkPath path;
+      path.moveTo(0, 0);
+      for (unsigned int i = 1; i <= size; i++) {
+        path.lineTo(i * 1000.0f / size, (i % 2) * 20.0f);
+      }
+      paint.setDrawStyle(DlDrawStyle::kStroke);
+      paint.setStrokeWidth(1.0f);
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawPath(path, paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kPoints: {
+      std::vector<SkPoint> points;
+      points.reserve(size);
+      for (unsigned int i = 0; i < size; i++) {
+        points.push_back(SkPoint::Make(i % 32 * 10.0f, i / 32 * 10.0f));
+      }
+      paint.setStrokeWidth(1.0f);
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawPoints(DlCanvas::PointMode::kPoints, size, points.data(),
+                           paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kVertices: {
+      std::vector<SkPoint> points;
+      points.reserve(size);
+      for (unsigned int i = 0; i < size; i++) {
+        SkScalar x = i / 3 % 32 * 10.0f;
+        SkScalar y = i / 3 / 32 * 10.0f;
+        points.push_back(i % 3 == 0   ? SkPoint::Make(x, y)
+                         : i % 3 == 1 ? SkPoint::Make(x + 10, y)
+                                      : SkPoint::Make(x, y + 10));
+      }
+      auto vertices = DlVertices::Make(DlVertexMode::kTriangles, size,
+                                       points.data(), nullptr, nullptr);
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawVertices(vertices.get(), DlBlendMode::kSrcOver, paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kImage: {
+      SkBitmap bitmap;
+      bitmap.allocN32Pixels(size, size);
+      bitmap.eraseColor(SK_ColorBLUE);
+      auto image = DlImage::Make(SkImages::RasterFromBitmap(bitmap));
+      if (!image) {
+        return nullptr;
+      }
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawImage(image, SkPoint::Make(0, 0),
+                          DlImageSampling::kLinear, &paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kText: {
+      auto blob = SkTextBlob::MakeFromString("A", SkFont());
+      if (!blob) {
+        return nullptr;
+      }
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawTextBlob(blob, 0, 20, paint);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kShadow: {
+      SkPath path = SkPath::Rect(SkRect::MakeWH(extent, extent));
+      for (unsigned int i = 0; i < count; i++) {
+        builder.DrawShadow(path, DlColor::kBlack(), 4.0f, false, 1.0f);
+      }
+      break;
+    }
+    case DlComplexityOpKind::kSaveLayer: {
+      for (unsigned int i = 0; i < count; i++) {
+        builder.SaveLayer(nullptr, &paint);
+        builder.DrawRect(SkRect::MakeWH(1, 1), paint);
+        builder.Restore();
+      }
+      break;
+    }
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
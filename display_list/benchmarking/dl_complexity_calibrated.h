@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_CALIBRATED_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_CALIBRATED_H_
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+// The kinds of operation for which DlComplexityCoefficients hold a cost.
+// Each kind has a size metric, noted below, that its cost scales with.
+enum class DlComplexityOpKind {
+  kLine,          // The length of the line.
+  kFilledShape,   // The area of the shape's bounds.
+  kStrokedShape,  // The average of the shape's width and height.
+  kPath,          // The number of verbs in the path.
+  kPoints,        // The number of points.
+  kVertices,      // The number of vertices.
+  kImage,         // The number of pixels in the image.
+  kText,          // None, text costs the same per op.
+  kShadow,        // The area of the path's bounds.
+  kSaveLayer,     // None, layers cost the same per op.
+};
+
+constexpr size_t kDlComplexityOpKindCount =
+    static_cast<size_t>(DlComplexityOpKind::kSaveLayer) + 1;
+
+// The cost of each kind of operation on one particular device, as measured
+// by DlComplexityCalibrator.
+struct DlComplexityCoefficients {
+  struct Cost {
+    double per_op_ns = 0.0;
+    double per_unit_ns = 0.0;
+
+    bool operator==(const Cost& other) const {
+      return per_op_ns == other.per_op_ns && per_unit_ns == other.per_unit_ns;
+    }
+  };
+
+  Cost& Get(DlComplexityOpKind kind, bool anti_alias) {
+    return costs[static_cast<size_t>(kind)][anti_alias ? 1 : 0];
+  }
+  const Cost& Get(DlComplexityOpKind kind, bool anti_alias) const {
+    return costs[static_cast<size_t>(kind)][anti_alias ? 1 : 0];
+  }
+
+  // Returns the coefficients as text that Deserialize() accepts, so that they
+  // can be stored and the calibration need only run once per device.
+  std::string Serialize() const;
+
+  // Returns the coefficients stored by Serialize(), or std::nullopt if
+  // |serialized| is malformed or was written by an incompatible version.
+  static std::optional<DlComplexityCoefficients> Deserialize(
+      std::string_view serialized);
+
+  bool operator==(const DlComplexityCoefficients& other) const;
+
+  Cost costs[kDlComplexityOpKindCount][2];
+};
+
+// A complexity calculator that scores operations with the costs measured on
+// the current device instead of the fixed estimates of the GL and Metal
+// calculators. Scores use the same scale as those calculators, where 100 is
+// roughly 0.0005ms.
+class DisplayListCalibratedComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  // Returns the calculator installed with Install(), or nullptr if there is
+  // none.
+  static DisplayListCalibratedComplexityCalculator* GetInstance();
+
+  // Makes GetForBackend() return a calculator that uses |coefficients| for
+  // all GPU backends, or restores the fixed estimates if |coefficients| is
+  // std::nullopt. This must be called on the raster thread.
+  static void Install(std::optional<DlComplexityCoefficients> coefficients);
+
+  explicit DisplayListCalibratedComplexityCalculator(
+      const DlComplexityCoefficients& coefficients)
+      : coefficients_(coefficients),
+        ceiling_(std::numeric_limits<unsigned int>::max()) {}
+
+  const DlComplexityCoefficients& coefficients() const {
+    return coefficients_;
+  }
+
+  unsigned int Compute(const DisplayList* display_list) override;
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Set cache threshold at 1ms
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class CalibratedHelper;
+
+  static DisplayListCalibratedComplexityCalculator* instance_;
+
+  const DlComplexityCoefficients coefficients_;
+  unsigned int ceiling_;
+};
+
+// Measures the cost of each kind of operation on the current device.
+//
+// The calibrator builds probe DisplayLists that repeat a single operation,
+// similar to those of the display_list_benchmarks suite, at a range of
+// sizes. It renders each probe with |op_count| operations and with twice as
+// many, so that the fixed cost of rendering a frame cancels out, and fits a
+// straight line through the per op times of each kind of operation.
+class DlComplexityCalibrator {
+ public:
+  // Renders |display_list| to the device's surface and returns the time it
+  // took in nanoseconds. The time must include the GPU work, for example by
+  // flushing the surface and waiting for it to finish.
+  using RenderTimer =
+      std::function<double(const sk_sp<DisplayList>& display_list)>;
+
+  explicit DlComplexityCalibrator(RenderTimer render_timer,
+                                  unsigned int op_count = 100u)
+      : render_timer_(std::move(render_timer)), op_count_(op_count) {}
+
+  DlComplexityCoefficients Calibrate() const;
+
+  // Returns a DisplayList that draws |count| operations of |kind|, or nullptr
+  // if this platform cannot draw |kind|. |size| is the length of lines, the
+  // width and height of shapes, images and shadows, or the number of verbs,
+  // points or vertices.
+  static sk_sp<DisplayList> BuildProbe(DlComplexityOpKind kind,
+                                       bool anti_alias,
+                                       unsigned int size,
+                                       unsigned int count);
+
+ private:
+  const RenderTimer render_timer_;
+  const unsigned int op_count_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_CALIBRATED_H_
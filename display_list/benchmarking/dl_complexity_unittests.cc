@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
+#include "flutter/display_list/benchmarking/dl_complexity_calibrated.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
@@ -31,6 +32,33 @@ std::vector<DisplayListComplexityCalculator*> AccumulatorCalculators() {
           DisplayListGLComplexityCalculator::GetInstance()};
 }
 
+// Coefficients that differ for every kind of op and for anti-aliasing.
+DlComplexityCoefficients GetTestCoefficients() {
+  DlComplexityCoefficients coefficients;
+  for (size_t i = 0; i < kDlComplexityOpKindCount; i++) {
+    auto kind = static_cast<DlComplexityOpKind>(i);
+    for (bool anti_alias : {false, true}) {
+      DlComplexityCoefficients::Cost& cost = coefficients.Get(kind, anti_alias);
+      cost.per_op_ns = 100.0 * (i + 1) + (anti_alias ? 50.0 : 0.0);
+      cost.per_unit_ns = (i + 1) * (anti_alias ? 2.0 : 1.0);
+    }
+  }
+  // Text and layers cost the same per op whatever their size.
+  for (bool anti_alias : {false, true}) {
+    coefficients.Get(DlComplexityOpKind::kText, anti_alias).per_unit_ns = 0.0;
+    coefficients.Get(DlComplexityOpKind::kSaveLayer, anti_alias).per_unit_ns =
+        0.0;
+  }
+  // These ops ignore anti-aliasing, so their probes are always measured with
+  // it turned off.
+  for (auto kind : {DlComplexityOpKind::kVertices, DlComplexityOpKind::kText,
+                    DlComplexityOpKind::kShadow,
+                    DlComplexityOpKind::kSaveLayer}) {
+    coefficients.Get(kind, true) = coefficients.Get(kind, false);
+  }
+  return coefficients;
+}
+
 std::vector<SkPoint> GetTestPoints() {
   std::vector<SkPoint> points;
   points.push_back(SkPoint::Make(0, 0));
@@ -440,5 +468,105 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, CalibratedCalculatorUsesCoefficients) {
+  DlComplexityCoefficients coefficients;
+  coefficients.Get(DlComplexityOpKind::kFilledShape, false) = {
+      .per_op_ns = 1000.0, .per_unit_ns = 1.0};
+  coefficients.Get(DlComplexityOpKind::kFilledShape, true) = {
+      .per_op_ns = 2000.0, .per_unit_ns = 2.0};
+  DisplayListCalibratedComplexityCalculator calculator(coefficients);
+
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint().setAntiAlias(true));
+  auto display_list = builder.Build();
+
+  // (1000 + 100) / 5 + (2000 + 200) / 5
+  ASSERT_EQ(calculator.Compute(display_list.get()), 660u);
+
+  calculator.SetComplexityCeiling(10u);
+  ASSERT_EQ(calculator.Compute(display_list.get()), 10u);
+}
+
+TEST(DisplayListComplexity, CalibrationRecoversCosts) {
+  const DlComplexityCoefficients expected = GetTestCoefficients();
+  DisplayListCalibratedComplexityCalculator device(expected);
+  DlComplexityCalibrator calibrator(
+      [&device](const sk_sp<DisplayList>& display_list) {
+        // Include a fixed cost per frame, which calibration cancels out.
+        return device.Compute(display_list.get()) * 5.0 + 100000.0;
+      });
+  DlComplexityCoefficients calibrated = calibrator.Calibrate();
+
+  for (size_t i = 0; i < kDlComplexityOpKindCount; i++) {
+    auto kind = static_cast<DlComplexityOpKind>(i);
+    if (!DlComplexityCalibrator::BuildProbe(kind, false, 1, 1)) {
+      continue;
+    }
+    for (bool anti_alias : {false, true}) {
+      DlComplexityCoefficients::Cost cost = expected.Get(kind, anti_alias);
+      if (kind == DlComplexityOpKind::kSaveLayer) {
+        // Each layer probe also draws a 1x1 rect.
+        const DlComplexityCoefficients::Cost& rect_cost =
+            expected.Get(DlComplexityOpKind::kFilledShape, anti_alias);
+        cost.per_op_ns += rect_cost.per_op_ns + rect_cost.per_unit_ns;
+      }
+      const DlComplexityCoefficients::Cost& actual =
+          calibrated.Get(kind, anti_alias);
+      // Scores are whole numbers, so each op may be up to 5ns off.
+      EXPECT_NEAR(actual.per_op_ns, cost.per_op_ns, 15.0)
+          << "kind " << i << " anti_alias " << anti_alias;
+      EXPECT_NEAR(actual.per_unit_ns, cost.per_unit_ns,
+                  cost.per_unit_ns * 0.05 + 0.001)
+          << "kind " << i << " anti_alias " << anti_alias;
+    }
+  }
+}
+
+TEST(DisplayListComplexity, CoefficientsSerialization) {
+  const DlComplexityCoefficients coefficients = GetTestCoefficients();
+  std::string serialized = coefficients.Serialize();
+
+  auto deserialized = DlComplexityCoefficients::Deserialize(serialized);
+  ASSERT_TRUE(deserialized.has_value());
+  ASSERT_TRUE(deserialized.value() == coefficients);
+
+  ASSERT_FALSE(DlComplexityCoefficients::Deserialize("").has_value());
+  ASSERT_FALSE(DlComplexityCoefficients::Deserialize(
+                   serialized.substr(0, serialized.size() / 2))
+                   .has_value());
+  ASSERT_FALSE(
+      DlComplexityCoefficients::Deserialize(serialized + " 1").has_value());
+  std::string other_version = serialized;
+  other_version.replace(other_version.find(" 1 "), 3, " 2 ");
+  ASSERT_FALSE(
+      DlComplexityCoefficients::Deserialize(other_version).has_value());
+}
+
+TEST(DisplayListComplexity, InstalledCoefficientsAreUsedForGPUBackends) {
+  ASSERT_EQ(DisplayListCalibratedComplexityCalculator::GetInstance(), nullptr);
+  DisplayListComplexityCalculator* gl =
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL);
+
+  DisplayListCalibratedComplexityCalculator::Install(GetTestCoefficients());
+  auto calibrated = DisplayListCalibratedComplexityCalculator::GetInstance();
+  ASSERT_NE(calibrated, nullptr);
+  ASSERT_TRUE(calibrated->coefficients() == GetTestCoefficients());
+  ASSERT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL),
+      calibrated);
+  ASSERT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kMetal),
+      calibrated);
+  ASSERT_EQ(DisplayListComplexityCalculator::GetForSoftware(),
+            DisplayListNaiveComplexityCalculator::GetInstance());
+
+  DisplayListCalibratedComplexityCalculator::Install(std::nullopt);
+  ASSERT_EQ(DisplayListCalibratedComplexityCalculator::GetInstance(), nullptr);
+  ASSERT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL),
+      gl);
+}
+
 }  // namespace testing
 }  // namespace flutter
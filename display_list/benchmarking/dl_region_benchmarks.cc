@@ -253,6 +253,49 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+// Runs region operations on |state.range(0)| rects of up to 100 pixels spread
+// over a 20000 pixel square, giving lines of tens to hundreds of spans.
+template <typename Region>
+void RunManyRectsOpBenchmark(benchmark::State& state, RegionOp op) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  const int count = state.range(0);
+  SkIRect bounds1 = SkIRect::MakeWH(20000, 20000);
+  SkIRect bounds2 = SkIRect::MakeXYWH(3000, 3000, 14000, 14000);
+  Region region1(GenerateRects(rng, bounds1, count, 100));
+  Region region2(GenerateRects(rng, bounds2, count / 2, 100));
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(region1, region2);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(region1, region2);
+      }
+      break;
+  }
+}
+
+template <typename Region>
+void RunManyRectsIntersectsSingleRectBenchmark(benchmark::State& state) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  SkIRect bounds = SkIRect::MakeWH(20000, 20000);
+  Region region(GenerateRects(rng, bounds, state.range(0), 100));
+  auto rects = GenerateRects(rng, bounds, 100, 100);
+
+  while (state.KeepRunning()) {
+    for (auto& rect : rects) {
+      region.intersects(rect);
+    }
+  }
+}
+
 }  // namespace
 
 namespace flutter {
@@ -313,6 +356,26 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRegion_ManyRectsOperation(benchmark::State& state,
+                                           RegionOp op) {
+  RunManyRectsOpBenchmark<DlRegionAdapter>(state, op);
+}
+
+static void BM_SkRegion_ManyRectsOperation(benchmark::State& state,
+                                           RegionOp op) {
+  RunManyRectsOpBenchmark<SkRegionAdapter>(state, op);
+}
+
+static void BM_DlRegion_ManyRectsIntersectsSingleRect(
+    benchmark::State& state) {
+  RunManyRectsIntersectsSingleRectBenchmark<DlRegionAdapter>(state);
+}
+
+static void BM_SkRegion_ManyRectsIntersectsSingleRect(
+    benchmark::State& state) {
+  RunManyRectsIntersectsSingleRectBenchmark<SkRegionAdapter>(state);
+}
+
 const double kSizeFactorSmall = 0.3;
 
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
@@ -709,4 +772,41 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
+
+BENCHMARK(BM_DlRegion_ManyRectsIntersectsSingleRect)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_SkRegion_ManyRectsIntersectsSingleRect)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kNanosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_ManyRectsOperation, Union, RegionOp::kUnion)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_ManyRectsOperation, Union, RegionOp::kUnion)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_ManyRectsOperation,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_ManyRectsOperation,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <random>
+
+namespace {
+
+// Rows of word sized rects laid out top to bottom, like a long document.
+std::vector<SkRect> GenerateDocumentRects(int count) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> word_width(10, 60);
+
+  std::vector<SkRect> rects;
+  rects.reserve(count);
+  float x = 0;
+  float y = 0;
+  while (static_cast<int>(rects.size()) < count) {
+    float width = word_width(rng);
+    if (x + width > 1000) {
+      x = 0;
+      y += 20;
+    }
+    rects.push_back(SkRect::MakeXYWH(x, y, width, 16));
+    x += width + 5;
+  }
+  return rects;
+}
+
+// Randomly placed rects of varied sizes, like the features of a map.
+std::vector<SkRect> GenerateMapRects(int count) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> pos(0, 20000);
+  std::uniform_real_distribution<float> size(1, 200);
+
+  std::vector<SkRect> rects;
+  rects.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    rects.push_back(SkRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+  }
+  return rects;
+}
+
+using RectGenerator = std::vector<SkRect> (*)(int count);
+
+}  // namespace
+
+namespace flutter {
+
+static void BM_DlRTree_Build(benchmark::State& state,
+                             RectGenerator generator) {
+  auto rects = generator(state.range(0));
+
+  while (state.KeepRunning()) {
+    DlRTree rtree(rects.data(), rects.size());
+    benchmark::DoNotOptimize(rtree.leaf_count());
+  }
+}
+
+// Searches with screen sized queries scattered over the tree's bounds.
+static void BM_DlRTree_Search(benchmark::State& state,
+                              RectGenerator generator) {
+  auto rects = generator(state.range(0));
+  DlRTree rtree(rects.data(), rects.size());
+
+  const SkRect& bounds = rtree.bounds();
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos_x(
+      bounds.fLeft, std::max(bounds.fLeft, bounds.fRight - 1000));
+  std::uniform_real_distribution<float> pos_y(
+      bounds.fTop, std::max(bounds.fTop, bounds.fBottom - 2000));
+  std::vector<SkRect> queries;
+  for (int i = 0; i < 256; ++i) {
+    queries.push_back(SkRect::MakeXYWH(pos_x(rng), pos_y(rng), 1000, 2000));
+  }
+
+  std::vector<int> results;
+  size_t query_index = 0;
+  while (state.KeepRunning()) {
+    results.clear();
+    rtree.search(queries[query_index++ % queries.size()], &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Document, GenerateDocumentRects)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Map, GenerateMapRects)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Document, GenerateDocumentRects)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Map, GenerateMapRects)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kNanosecond);
+
+}  // namespace flutter
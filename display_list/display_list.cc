@@ -5,7 +5,9 @@
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_culler.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -20,6 +22,7 @@ DisplayList::DisplayList()
       nested_byte_count_(0),
       nested_op_count_(0),
       unique_id_(0),
+      content_hash_(0),
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
@@ -41,6 +44,9 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
       unique_id_(next_unique_id()),
+      content_hash_(HashOps(fml::HashBytes(&bounds, sizeof(bounds)),
+                            storage_.get(),
+                            storage_.get() + byte_count_)),
       bounds_(bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
@@ -52,6 +58,22 @@ DisplayList::~DisplayList() {
   DisposeOps(ptr, ptr + byte_count_);
 }
 
+void DisplayList::ComputeOpaqueBounds() const {
+  std::call_once(opaque_bounds_once_, [this]() {
+    opaque_bounds_ = GetDisplayListOpaqueBounds(*this, &may_read_backdrop_);
+  });
+}
+
+const SkRect& DisplayList::opaque_bounds() const {
+  ComputeOpaqueBounds();
+  return opaque_bounds_;
+}
+
+bool DisplayList::may_read_backdrop() const {
+  ComputeOpaqueBounds();
+  return may_read_backdrop_;
+}
+
 uint32_t DisplayList::next_unique_id() {
   static std::atomic<uint32_t> next_id{1};
   uint32_t id;
@@ -171,6 +193,67 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   Dispatch(receiver, ptr, ptr + byte_count_, culler);
 }
 
+std::vector<DisplayList::Partition> DisplayList::PartitionAtTopLevelSaveLayers()
+    const {
+  std::vector<Partition> partitions;
+  uint8_t* start = storage_.get();
+  uint8_t* ptr = start;
+  uint8_t* end = start + byte_count_;
+  size_t partition_begin = 0;
+  int depth = 0;
+  bool in_layer = false;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    size_t op_offset = ptr - start;
+    ptr += op->size;
+    size_t next_offset = ptr - start;
+    FML_DCHECK(ptr <= end);
+    switch (op->type) {
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+      case DisplayListOpType::kSaveLayerBackdrop:
+      case DisplayListOpType::kSaveLayerBackdropBounds:
+        if (depth == 0) {
+          if (op_offset > partition_begin) {
+            partitions.push_back({partition_begin, op_offset, false});
+          }
+          partition_begin = op_offset;
+          in_layer = true;
+        }
+        depth++;
+        break;
+      case DisplayListOpType::kSave:
+        depth++;
+        break;
+      case DisplayListOpType::kRestore:
+        FML_DCHECK(depth > 0);
+        depth--;
+        if (depth == 0 && in_layer) {
+          partitions.push_back({partition_begin, next_offset, true});
+          partition_begin = next_offset;
+          in_layer = false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  FML_DCHECK(depth == 0);
+  if (byte_count_ > partition_begin) {
+    partitions.push_back({partition_begin, byte_count_, in_layer});
+  }
+  return partitions;
+}
+
+void DisplayList::Dispatch(DlOpReceiver& receiver,
+                           const Partition& partition) const {
+  FML_DCHECK(partition.begin_offset <= partition.end_offset);
+  FML_DCHECK(partition.end_offset <= byte_count_);
+  uint8_t* ptr = storage_.get();
+  Dispatch(receiver, ptr + partition.begin_offset, ptr + partition.end_offset,
+           NopCuller::instance);
+}
+
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            uint8_t* ptr,
                            uint8_t* end,
@@ -236,6 +319,33 @@ void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
   }
 }
 
+uint64_t DisplayList::HashOps(uint64_t seed, uint8_t* ptr, uint8_t* end) {
+  uint64_t hash = seed;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    switch (op->type) {
+#define DL_OP_HASH(name)                                            \
+  case DisplayListOpType::k##name:                                  \
+    hash = static_cast<const name##Op*>(op)->hash(hash + op->size); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASH)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_HASH(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_HASH
+
+      default:
+        FML_DCHECK(false);
+        return hash;
+    }
+  }
+  return hash;
+}
+
 static bool CompareOps(uint8_t* ptrA,
                        uint8_t* endA,
                        uint8_t* ptrB,
@@ -6,7 +6,9 @@
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
@@ -114,6 +116,7 @@ namespace flutter {
                                     \
   V(DrawLine)                       \
   V(DrawRect)                       \
+  V(DrawRects)                      \
   V(DrawOval)                       \
   V(DrawCircle)                     \
   V(DrawRRect)                      \
@@ -239,6 +242,33 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx, const SkRect& cull_rect) const;
   void Dispatch(DlOpReceiver& ctx, const SkIRect& cull_rect) const;
 
+  /// @brief     A contiguous range of the top level operations of a
+  ///            DisplayList, as returned by PartitionAtTopLevelSaveLayers().
+  struct Partition {
+    size_t begin_offset;
+    size_t end_offset;
+    bool is_save_layer;
+  };
+
+  /// @brief     Splits the operations of this DisplayList at the boundaries
+  ///            of its top level save layers.
+  ///
+  /// Each save layer that is not nested inside another save or save layer
+  /// forms one partition together with the operations up to its matching
+  /// restore. The operations in between such layers form the remaining
+  /// partitions. Dispatching every partition in order to one receiver is
+  /// equivalent to dispatching the whole DisplayList.
+  ///
+  /// Attributes are not affected by save and restore, so a layer partition
+  /// can only be dispatched on its own to a receiver that starts with the
+  /// attributes, transform and clip left behind by the partitions before it.
+  std::vector<Partition> PartitionAtTopLevelSaveLayers() const;
+
+  /// @brief     Dispatches only the operations of |partition|, which must
+  ///            have been returned by PartitionAtTopLevelSaveLayers() on
+  ///            this DisplayList.
+  void Dispatch(DlOpReceiver& ctx, const Partition& partition) const;
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -253,6 +283,14 @@ class DisplayList : public SkRefCnt {
 
   uint32_t unique_id() const { return unique_id_; }
 
+  /// @brief     A hash of the bounds and operations of this DisplayList.
+  ///
+  /// Two live DisplayLists with the same content hash, op count and byte
+  /// count are treated as having the same contents. Images and effects
+  /// are hashed by identity, so lists that are Equal() only because they
+  /// reference distinct but equivalent objects may hash differently.
+  uint64_t content_hash() const { return content_hash_; }
+
   const SkRect& bounds() const { return bounds_; }
 
   bool has_rtree() const { return rtree_ != nullptr; }
@@ -280,6 +318,23 @@ class DisplayList : public SkRefCnt {
     return modifies_transparent_black_;
   }
 
+  /// @brief     A rect, in the coordinates of this DisplayList, that its
+  ///            operations are known to fill entirely with opaque pixels,
+  ///            or an empty rect.
+  ///
+  /// Content drawn under the rect before this DisplayList is hidden by it.
+  /// The rect is found by an analysis of the operations on the first call,
+  /// as described by |GetDisplayListOpaqueBounds|, and then cached.
+  const SkRect& opaque_bounds() const;
+
+  /// @brief     Whether any operation may read the content drawn before this
+  ///            DisplayList, as a backdrop filter does, or make it
+  ///            translucent, as a clearing blend mode does, rather than only
+  ///            draw over it.
+  ///
+  /// Found by the same analysis as |opaque_bounds|.
+  bool may_read_backdrop() const;
+
  private:
   DisplayList(DisplayListStorage&& ptr,
               size_t byte_count,
@@ -295,6 +350,7 @@ class DisplayList : public SkRefCnt {
   static uint32_t next_unique_id();
 
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
+  static uint64_t HashOps(uint64_t seed, uint8_t* ptr, uint8_t* end);
 
   const DisplayListStorage storage_;
   const size_t byte_count_;
@@ -304,6 +360,7 @@ class DisplayList : public SkRefCnt {
   const unsigned int nested_op_count_;
 
   const uint32_t unique_id_;
+  const uint64_t content_hash_;
   const SkRect bounds_;
 
   const bool can_apply_group_opacity_;
@@ -312,6 +369,12 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  mutable std::once_flag opaque_bounds_once_;
+  mutable SkRect opaque_bounds_ = SkRect::MakeEmpty();
+  mutable bool may_read_backdrop_ = true;
+
+  void ComputeOpaqueBounds() const;
+
   void Dispatch(DlOpReceiver& ctx,
                 uint8_t* ptr,
                 uint8_t* end,
@@ -251,6 +251,22 @@ TEST_F(DisplayListTest, BuilderCanBeReused) {
   ASSERT_TRUE(dl->Equals(dl2));
 }
 
+TEST_F(DisplayListTest, LargeListsCanBeRebuilt) {
+  DisplayListBuilder builder(kTestBounds);
+  auto record = [&builder]() {
+    for (int i = 0; i < 20000; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i % 100, i / 100, 1, 1), DlPaint());
+    }
+    return builder.Build();
+  };
+  auto dl = record();
+  // The second recording starts with the capacity of the first.
+  auto dl2 = record();
+  EXPECT_EQ(dl->op_count(), 20000u);
+  EXPECT_EQ(dl->bytes(), dl2->bytes());
+  ASSERT_TRUE(dl->Equals(dl2));
+}
+
 TEST_F(DisplayListTest, SaveRestoreRestoresTransform) {
   SkRect cull_rect = SkRect::MakeLTRB(-10.0f, -10.0f, 500.0f, 500.0f);
   DisplayListBuilder builder(cull_rect);
@@ -658,6 +674,136 @@ TEST_F(DisplayListTest, SingleOpDisplayListsCompareToEachOther) {
   }
 }
 
+TEST_F(DisplayListTest, SingleOpDisplayListsWithEqualHashesAreEqual) {
+  for (auto& group : allGroups) {
+    std::vector<sk_sp<DisplayList>> lists_a;
+    std::vector<sk_sp<DisplayList>> lists_b;
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      lists_a.push_back(Build(group.variants[i]));
+      lists_b.push_back(Build(group.variants[i]));
+    }
+
+    for (size_t i = 0; i < lists_a.size(); i++) {
+      sk_sp<DisplayList> listA = lists_a[i];
+      for (size_t j = 0; j < lists_b.size(); j++) {
+        sk_sp<DisplayList> listB = lists_b[j];
+        auto desc = group.op_name + "(variant " + std::to_string(i + 1) +
+                    " ==? variant " + std::to_string(j + 1) + ")";
+        // Effects are hashed by identity so equal lists may hash
+        // differently, but lists with equal hashes must be equal.
+        if (listA->content_hash() == listB->content_hash()) {
+          ASSERT_TRUE(listA->Equals(*listB)) << desc;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(DisplayListTest, ContentHashMatchesForRebuiltContent) {
+  auto build = [](SkColor color) {
+    DisplayListBuilder nested_builder;
+    nested_builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10),
+                            DlPaint(DlColor(color)));
+    DisplayListBuilder builder;
+    builder.ClipPath(SkPath().addCircle(20, 20, 15),
+                     DlCanvas::ClipOp::kIntersect, true);
+    builder.DrawPath(SkPath().addOval(SkRect::MakeLTRB(5, 5, 40, 25)),
+                     DlPaint());
+    builder.DrawShadow(SkPath().addRect(SkRect::MakeLTRB(10, 10, 30, 30)),
+                       DlColor::kBlack(), 4.0f, false, 1.0f);
+    builder.DrawDisplayList(nested_builder.Build(), 0.5f);
+    return builder.Build();
+  };
+
+  sk_sp<DisplayList> list1 = build(SK_ColorRED);
+  sk_sp<DisplayList> list2 = build(SK_ColorRED);
+  sk_sp<DisplayList> list3 = build(SK_ColorBLUE);
+  ASSERT_TRUE(list1->Equals(list2));
+  ASSERT_NE(list1->unique_id(), list2->unique_id());
+  ASSERT_EQ(list1->content_hash(), list2->content_hash());
+  ASSERT_FALSE(list1->Equals(list3));
+  ASSERT_NE(list1->content_hash(), list3->content_hash());
+
+  // Paths with the same bounds are told apart by their contents.
+  const SkRect path_bounds = SkRect::MakeLTRB(5, 5, 40, 25);
+  DisplayListBuilder builder;
+  builder.DrawPath(SkPath().addOval(path_bounds), DlPaint());
+  sk_sp<DisplayList> path_list1 = builder.Build();
+  builder.DrawPath(SkPath().addRect(path_bounds), DlPaint());
+  sk_sp<DisplayList> path_list2 = builder.Build();
+  ASSERT_EQ(path_list1->bounds(), path_list2->bounds());
+  ASSERT_FALSE(path_list1->Equals(path_list2));
+  ASSERT_NE(path_list1->content_hash(), path_list2->content_hash());
+}
+
+TEST_F(DisplayListTest, PartitionAtTopLevelSaveLayers) {
+  DisplayListBuilder builder;
+  DlPaint paint;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), paint);
+  builder.SaveLayer(nullptr, nullptr);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), paint);
+  builder.Save();
+  builder.SaveLayer(nullptr, &paint);
+  builder.DrawOval(SkRect::MakeLTRB(10, 10, 20, 20), paint);
+  builder.Restore();
+  builder.Restore();
+  builder.Restore();
+  builder.Translate(5, 5);
+  // A save is not a layer, so it and its contents are not split off.
+  builder.Save();
+  builder.Scale(2, 2);
+  builder.SaveLayer(nullptr, nullptr);
+  builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), paint);
+  builder.Restore();
+  builder.Restore();
+  paint.setColor(DlColor::kBlue());
+  SkRect layer_bounds = SkRect::MakeLTRB(30, 30, 40, 40);
+  builder.SaveLayer(&layer_bounds, &paint);
+  builder.DrawRect(layer_bounds, paint);
+  builder.Restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  std::vector<DisplayList::Partition> partitions =
+      display_list->PartitionAtTopLevelSaveLayers();
+  ASSERT_EQ(partitions.size(), 4u);
+  EXPECT_FALSE(partitions[0].is_save_layer);
+  EXPECT_TRUE(partitions[1].is_save_layer);
+  EXPECT_FALSE(partitions[2].is_save_layer);
+  EXPECT_TRUE(partitions[3].is_save_layer);
+  EXPECT_EQ(partitions[0].begin_offset, 0u);
+  for (size_t i = 1; i < partitions.size(); i++) {
+    EXPECT_EQ(partitions[i].begin_offset, partitions[i - 1].end_offset);
+  }
+  EXPECT_EQ(partitions.back().end_offset, display_list->bytes(false) -
+                                              sizeof(DisplayList));
+
+  // Dispatching the partitions in order replays the whole list.
+  DisplayListBuilder copy_builder;
+  DlOpReceiver& receiver = ToReceiver(copy_builder);
+  for (const DisplayList::Partition& partition : partitions) {
+    display_list->Dispatch(receiver, partition);
+  }
+  ASSERT_TRUE(DisplayListsEQ_Verbose(copy_builder.Build(), display_list));
+}
+
+TEST_F(DisplayListTest, PartitionWithoutSaveLayersIsWholeList) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.Save();
+  builder.DrawOval(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.Restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  std::vector<DisplayList::Partition> partitions =
+      display_list->PartitionAtTopLevelSaveLayers();
+  ASSERT_EQ(partitions.size(), 1u);
+  EXPECT_FALSE(partitions[0].is_save_layer);
+  EXPECT_EQ(partitions[0].begin_offset, 0u);
+
+  EXPECT_TRUE(
+      sk_make_sp<DisplayList>()->PartitionAtTopLevelSaveLayers().empty());
+}
+
 TEST_F(DisplayListTest, SingleOpDisplayListsAreEqualWithOrWithoutRtree) {
   for (auto& group : allGroups) {
     for (size_t i = 0; i < group.variants.size(); i++) {
@@ -1140,6 +1286,28 @@ TEST_F(DisplayListTest, OverlappingOpsDoNotSupportGroupOpacity) {
   EXPECT_FALSE(display_list->can_apply_group_opacity());
 }
 
+TEST_F(DisplayListTest, SeparateOpsSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  for (int i = 0; i < 10; i++) {
+    receiver.drawRect(SkRect::MakeXYWH(i * 40, 0, 30, 30));
+  }
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST_F(DisplayListTest, OpsOverlappingAfterTransformDoNotSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.drawRect(SkRect::MakeXYWH(0, 0, 30, 30));
+  receiver.save();
+  receiver.translate(-20, 0);
+  receiver.drawRect(SkRect::MakeXYWH(40, 0, 30, 30));
+  receiver.restore();
+  auto display_list = builder.Build();
+  EXPECT_FALSE(display_list->can_apply_group_opacity());
+}
+
 TEST_F(DisplayListTest, SaveLayerFalseSupportsGroupOpacityOverlappingChidren) {
   DisplayListBuilder builder;
   DlOpReceiver& receiver = ToReceiver(builder);
@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -46,8 +48,17 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   if (used_ + size > allocated_) {
     static_assert(is_power_of_two(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
+    // Grow geometrically so that recording a large list copies each op only
+    // a constant number of times on average. The first allocation of a reused
+    // builder starts out at the size of the last list it built.
+    size_t target = used_ + size;
+    if (allocated_ == 0) {
+      target = std::max(target, last_build_bytes_);
+    } else {
+      target = std::max(target, allocated_ * 2);
+    }
     // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    allocated_ = (target + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
     storage_.realloc(allocated_);
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
@@ -76,6 +87,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   bool is_safe = is_ui_thread_safe_;
   bool affects_transparency = current_layer_->affects_transparent_layer();
 
+  last_build_bytes_ = bytes;
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   is_ui_thread_safe_ = true;
@@ -85,9 +97,14 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   tracker_.reset();
   current_ = DlPaint();
 
-  return sk_sp<DisplayList>(new DisplayList(
+  sk_sp<DisplayList> display_list(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
       compatible, is_safe, affects_transparency, rtree()));
+  if (cull_ops_on_build_) {
+    return CullDisplayListOps(display_list, &last_build_culling_stats_);
+  }
+  last_build_culling_stats_ = DlOpCullingStats();
+  return display_list;
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
@@ -469,7 +486,7 @@ void DisplayListBuilder::Restore() {
       if (layer_info.cannot_inherit_opacity()) {
         current_layer_->mark_incompatible();
       } else if (layer_info.has_compatible_op()) {
-        current_layer_->add_compatible_op();
+        current_layer_->add_compatible_op(layer_info.compatible_bounds());
       }
     }
   }
@@ -494,6 +511,9 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     return;
   }
   size_t save_layer_offset = used_;
+  // The content of the layer is not known yet, so it is assumed to cover
+  // everything inside the clip.
+  op_bounds_ = tracker_.device_cull_rect();
   if (options.renders_with_attributes()) {
     // The actual flood of the outer layer clip will occur after the
     // (eventual) corresponding restore is called, but rather than
@@ -820,6 +840,36 @@ void DisplayListBuilder::DrawRect(const SkRect& rect, const DlPaint& paint) {
   SetAttributesFromPaint(paint, DisplayListOpFlags::kDrawRectFlags);
   drawRect(rect);
 }
+void DisplayListBuilder::drawRects(const SkRect rects[], uint32_t count) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1) {
+    drawRect(rects[0]);
+    return;
+  }
+  DisplayListAttributeFlags flags = kDrawRectFlags;
+  OpResult result = PaintResult(current_, flags);
+  if (result == OpResult::kNoEffect) {
+    return;
+  }
+
+  RectBoundsAccumulator rects_bounds;
+  for (uint32_t i = 0; i < count; i++) {
+    rects_bounds.accumulate(rects[i].fLeft, rects[i].fTop);
+    rects_bounds.accumulate(rects[i].fRight, rects[i].fBottom);
+  }
+  if (!AccumulateOpBounds(rects_bounds.bounds(), flags)) {
+    return;
+  }
+
+  void* data_ptr = Push<DrawRectsOp>(count * sizeof(SkRect), 1, count);
+  CopyV(data_ptr, rects, count);
+  // The rects may overlap so, like drawPoints, we cannot distribute a
+  // group opacity to them without analyzing their bounds.
+  UpdateLayerOpacityCompatibility(false);
+  UpdateLayerResult(result);
+}
 void DisplayListBuilder::drawOval(const SkRect& bounds) {
   DisplayListAttributeFlags flags = kDrawOvalFlags;
   OpResult result = PaintResult(current_, flags);
@@ -1227,13 +1277,16 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
         std::list<SkRect> rects =
             rtree->searchAndConsolidateRects(GetLocalClipBounds(), false);
         accumulated = false;
+        SkRect list_bounds = SkRect::MakeEmpty();
         for (const SkRect& rect : rects) {
           // TODO (https://github.com/flutter/flutter/issues/114919): Attributes
           // are not necessarily `kDrawDisplayListFlags`.
           if (AccumulateOpBounds(rect, kDrawDisplayListFlags)) {
             accumulated = true;
+            list_bounds.join(op_bounds_);
           }
         }
+        op_bounds_ = list_bounds;
       } else {
         accumulated = AccumulateOpBounds(bounds, kDrawDisplayListFlags);
       }
@@ -1437,6 +1490,7 @@ bool DisplayListBuilder::AccumulateUnbounded() {
     return false;
   }
   accumulator()->accumulate(clip, op_index_);
+  op_bounds_ = clip;
   return true;
 }
 
@@ -1453,6 +1507,7 @@ bool DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
     tracker_.mapRect(&bounds);
     if (bounds.intersect(tracker_.device_cull_rect())) {
       accumulator()->accumulate(bounds, op_index_);
+      op_bounds_ = bounds;
       return true;
     }
   }
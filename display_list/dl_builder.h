@@ -8,6 +8,7 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/display_list/dl_op_culler.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/dl_paint.h"
@@ -246,11 +247,27 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  // Enables a pass at the end of |Build()| that removes the ops hidden by
+  // later opaque ops, the saves and clips left with nothing to render, and
+  // redundant rect clips, as described by |CullDisplayListOps|. The pass
+  // replays the list into a new builder, so it is disabled by default.
+  void SetCullOpsOnBuild(bool cull) { cull_ops_on_build_ = cull; }
+
+  // The amount removed by the culling pass from the list returned by the
+  // last call to |Build()|.
+  const DlOpCullingStats& last_build_culling_stats() const {
+    return last_build_culling_stats_;
+  }
+
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
   // is obsolete and forbidden in every other case and is only shared to a
-  // pair of "friend" accessors in the benchmark/unittest files.
+  // pair of "friend" accessors in the benchmark/unittest files, to the
+  // deserializer in dl_serialization.cc, which replays serialized ops, to
+  // the op batcher in dl_op_batcher.cc, which replays batched ops, to the
+  // op culler in dl_op_culler.cc, which replays the ops it keeps, and to the
+  // op folder in dl_op_folder.cc, which replays ops under a color filter.
   DlOpReceiver& asReceiver() { return *this; }
 
   friend DlOpReceiver& DisplayListBuilderBenchmarkAccessor(
@@ -259,6 +276,14 @@ class DisplayListBuilder final : public virtual DlCanvas,
       DisplayListBuilder& builder);
   friend DlPaint DisplayListBuilderTestingAttributes(
       DisplayListBuilder& builder);
+  friend DlOpReceiver& DisplayListBuilderSerializationAccessor(
+      DisplayListBuilder& builder);
+  friend DlOpReceiver& DisplayListBuilderBatchingAccessor(
+      DisplayListBuilder& builder);
+  friend DlOpReceiver& DisplayListBuilderCullingAccessor(
+      DisplayListBuilder& builder);
+  friend DlOpReceiver& DisplayListBuilderFoldingAccessor(
+      DisplayListBuilder& builder);
 
   void SetAttributesFromPaint(const DlPaint& paint,
                               const DisplayListAttributeFlags flags);
@@ -422,6 +447,8 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // |DlOpReceiver|
   void drawRect(const SkRect& rect) override;
   // |DlOpReceiver|
+  void drawRects(const SkRect rects[], uint32_t count) override;
+  // |DlOpReceiver|
   void drawOval(const SkRect& bounds) override;
   // |DlOpReceiver|
   void drawCircle(const SkPoint& center, SkScalar radius) override;
@@ -494,6 +521,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
+  // The number of bytes used by the last list built by this builder. Lists
+  // recorded by the same builder tend to be of similar size, so the next
+  // recording reserves this much up front.
+  size_t last_build_bytes_ = 0;
+  bool cull_ops_on_build_ = false;
+  DlOpCullingStats last_build_culling_stats_;
   int render_op_count_ = 0;
   int op_index_ = 0;
 
@@ -545,21 +578,26 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
     void mark_incompatible() { cannot_inherit_opacity_ = true; }
 
-    // For now this only allows a single compatible op to mark the
-    // layer as being compatible with group opacity. If we start
-    // computing bounds of ops in the Builder methods then we
-    // can upgrade this to checking for overlapping ops.
+    // Compatible ops can share an inherited opacity as long as none of
+    // them draws over another one. The device |bounds| of each op are
+    // checked against the union of the bounds of the ops before it, which
+    // allows a linear sequence of separate ops, but not a grid or other
+    // arbitrary 2D layout.
     // See https://github.com/flutter/flutter/issues/93899
-    void add_compatible_op() {
+    void add_compatible_op(const SkRect& bounds) {
       if (!cannot_inherit_opacity_) {
-        if (has_compatible_op_) {
+        if (has_compatible_op_ && compatible_bounds_.intersects(bounds)) {
           cannot_inherit_opacity_ = true;
         } else {
           has_compatible_op_ = true;
+          compatible_bounds_.join(bounds);
         }
       }
     }
 
+    // The union of the device bounds of the compatible ops in this layer.
+    const SkRect& compatible_bounds() const { return compatible_bounds_; }
+
     // Records that the current layer contains an op that produces visible
     // output on a transparent surface.
     void add_visible_op() {
@@ -602,6 +640,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
     bool has_layer_;
     bool cannot_inherit_opacity_ = false;
     bool has_compatible_op_ = false;
+    SkRect compatible_bounds_ = SkRect::MakeEmpty();
     std::shared_ptr<const DlImageFilter> filter_;
     bool is_unbounded_ = false;
     bool has_deferred_save_op_ = false;
@@ -638,11 +677,16 @@ class DisplayListBuilder final : public virtual DlCanvas,
         IsOpacityCompatible(current_.getBlendMode());
   }
 
+  // The device bounds of the op being recorded, as last accumulated by
+  // |AccumulateBounds| or |AccumulateUnbounded|.
+  SkRect op_bounds_ = SkRect::MakeEmpty();
+
   // Update the opacity compatibility flags of the current layer for an op
-  // that has determined its compatibility as indicated by |compatible|.
+  // that has determined its compatibility as indicated by |compatible|, and
+  // whose device bounds are |op_bounds_|.
   void UpdateLayerOpacityCompatibility(bool compatible) {
     if (compatible) {
-      current_layer_->add_compatible_op();
+      current_layer_->add_compatible_op(op_bounds_);
     } else {
       current_layer_->mark_incompatible();
     }
@@ -0,0 +1,410 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_batcher.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+// The batcher replays the ops of a DisplayList directly into the
+// DlOpReceiver interface of a new DisplayListBuilder.
+DlOpReceiver& DisplayListBuilderBatchingAccessor(DisplayListBuilder& builder) {
+  return builder.asReceiver();
+}
+
+namespace {
+
+// Forwards every op to |receiver| except for the ops that can be batched,
+// which it holds back until an op that ends the current run arrives.
+class DlOpBatcher final : public DlOpReceiver {
+ public:
+  explicit DlOpBatcher(DlOpReceiver& receiver) : receiver_(receiver) {}
+
+  // Returns true if any ops were merged into a batch.
+  bool Finish() {
+    Flush();
+    return batched_ops_;
+  }
+
+  void setAntiAlias(bool aa) override {
+    Flush();
+    anti_alias_ = aa;
+    receiver_.setAntiAlias(aa);
+  }
+  void setDither(bool dither) override {
+    Flush();
+    receiver_.setDither(dither);
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    Flush();
+    receiver_.setDrawStyle(style);
+  }
+  void setColor(DlColor color) override {
+    Flush();
+    receiver_.setColor(color);
+  }
+  void setStrokeWidth(float width) override {
+    Flush();
+    receiver_.setStrokeWidth(width);
+  }
+  void setStrokeMiter(float limit) override {
+    Flush();
+    receiver_.setStrokeMiter(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    Flush();
+    receiver_.setStrokeCap(cap);
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    Flush();
+    receiver_.setStrokeJoin(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    Flush();
+    receiver_.setColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Flush();
+    has_color_filter_ = filter != nullptr;
+    receiver_.setColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    Flush();
+    invert_colors_ = invert;
+    receiver_.setInvertColors(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    Flush();
+    blend_mode_ = mode;
+    receiver_.setBlendMode(mode);
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    Flush();
+    receiver_.setPathEffect(effect);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Flush();
+    has_mask_filter_ = filter != nullptr;
+    receiver_.setMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Flush();
+    has_image_filter_ = filter != nullptr;
+    receiver_.setImageFilter(filter);
+  }
+
+  void save() override {
+    Flush();
+    receiver_.save();
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    Flush();
+    receiver_.saveLayer(bounds, options, backdrop);
+  }
+  void restore() override {
+    Flush();
+    receiver_.restore();
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    Flush();
+    receiver_.translate(tx, ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    Flush();
+    receiver_.scale(sx, sy);
+  }
+  void rotate(SkScalar degrees) override {
+    Flush();
+    receiver_.rotate(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    Flush();
+    receiver_.skew(sx, sy);
+  }
+  void transform2DAffine(SkScalar mxx,
+                         SkScalar mxy,
+                         SkScalar mxt,
+                         SkScalar myx,
+                         SkScalar myy,
+                         SkScalar myt) override {
+    Flush();
+    receiver_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  // clang-format off
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Flush();
+    receiver_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                       myx, myy, myz, myt,
+                                       mzx, mzy, mzz, mzt,
+                                       mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override {
+    Flush();
+    receiver_.transformReset();
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    Flush();
+    receiver_.clipRect(rect, clip_op, is_aa);
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    Flush();
+    receiver_.clipRRect(rrect, clip_op, is_aa);
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    Flush();
+    receiver_.clipPath(path, clip_op, is_aa);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    Flush();
+    receiver_.drawColor(color, mode);
+  }
+  void drawPaint() override {
+    Flush();
+    receiver_.drawPaint();
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    Flush();
+    receiver_.drawLine(p0, p1);
+  }
+  void drawRect(const SkRect& rect) override {
+    FlushImageRects();
+    rects_.push_back(rect);
+  }
+  void drawRects(const SkRect rects[], uint32_t count) override {
+    FlushImageRects();
+    rects_.insert(rects_.end(), rects, rects + count);
+  }
+  void drawOval(const SkRect& bounds) override {
+    Flush();
+    receiver_.drawOval(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Flush();
+    receiver_.drawCircle(center, radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    Flush();
+    receiver_.drawRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Flush();
+    receiver_.drawDRRect(outer, inner);
+  }
+  void drawPath(const SkPath& path) override {
+    Flush();
+    receiver_.drawPath(path);
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Flush();
+    receiver_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    Flush();
+    receiver_.drawPoints(mode, count, points);
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    Flush();
+    receiver_.drawVertices(vertices, mode);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    Flush();
+    receiver_.drawImage(image, point, sampling, render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    FlushRects();
+    if (!CanBatchImageRect(image, src, dst, render_with_attributes,
+                           constraint)) {
+      FlushImageRects();
+      receiver_.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                              constraint);
+      return;
+    }
+    if (image != image_ || sampling != sampling_ ||
+        render_with_attributes != image_with_attributes_) {
+      FlushImageRects();
+      image_ = image;
+      sampling_ = sampling;
+      image_with_attributes_ = render_with_attributes;
+    }
+    image_srcs_.push_back(src);
+    image_dsts_.push_back(dst);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Flush();
+    receiver_.drawImageNine(image, center, dst, filter, render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    Flush();
+    receiver_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                        cull_rect, render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    Flush();
+    sk_sp<DisplayList> batched = BatchDisplayListOps(display_list);
+    batched_ops_ |= batched != display_list;
+    receiver_.drawDisplayList(batched, opacity);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Flush();
+    receiver_.drawTextBlob(blob, x, y);
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    Flush();
+    receiver_.drawTextFrame(text_frame, x, y);
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Flush();
+    receiver_.drawShadow(path, color, elevation, transparent_occluder, dpr);
+  }
+
+ private:
+  DlOpReceiver& receiver_;
+  bool batched_ops_ = false;
+
+  // The attributes that decide whether a run of images may become an atlas.
+  // An atlas is filtered and blended as a whole by some backends and does
+  // not antialias the edges of its sprites.
+  bool anti_alias_ = false;
+  bool has_color_filter_ = false;
+  bool invert_colors_ = false;
+  bool has_mask_filter_ = false;
+  bool has_image_filter_ = false;
+  DlBlendMode blend_mode_ = DlBlendMode::kSrcOver;
+
+  std::vector<SkRect> rects_;
+
+  sk_sp<DlImage> image_;
+  DlImageSampling sampling_ = DlImageSampling::kNearestNeighbor;
+  bool image_with_attributes_ = false;
+  std::vector<SkRect> image_srcs_;
+  std::vector<SkRect> image_dsts_;
+
+  bool CanBatchImageRect(const sk_sp<DlImage>& image,
+                         const SkRect& src,
+                         const SkRect& dst,
+                         bool render_with_attributes,
+                         SrcRectConstraint constraint) const {
+    if (!image || constraint != SrcRectConstraint::kFast ||
+        src.isEmpty() || dst.isEmpty()) {
+      return false;
+    }
+    if (render_with_attributes &&
+        (anti_alias_ || has_color_filter_ || invert_colors_ ||
+         has_mask_filter_ || has_image_filter_ ||
+         blend_mode_ != DlBlendMode::kSrcOver)) {
+      return false;
+    }
+    // An atlas sprite can only be scaled uniformly.
+    return dst.width() * src.height() == dst.height() * src.width();
+  }
+
+  void Flush() {
+    FlushRects();
+    FlushImageRects();
+  }
+
+  void FlushRects() {
+    if (rects_.size() == 1) {
+      receiver_.drawRect(rects_[0]);
+    } else if (rects_.size() > 1) {
+      receiver_.drawRects(rects_.data(), static_cast<uint32_t>(rects_.size()));
+      batched_ops_ = true;
+    }
+    rects_.clear();
+  }
+
+  void FlushImageRects() {
+    const size_t count = image_dsts_.size();
+    if (count == 1) {
+      receiver_.drawImageRect(image_, image_srcs_[0], image_dsts_[0],
+                              sampling_, image_with_attributes_,
+                              SrcRectConstraint::kFast);
+    } else if (count > 1) {
+      std::vector<SkRSXform> xforms;
+      xforms.reserve(count);
+      SkRect bounds = image_dsts_[0];
+      for (size_t i = 0; i < count; i++) {
+        const SkRect& dst = image_dsts_[i];
+        const SkScalar scale = dst.width() / image_srcs_[i].width();
+        xforms.push_back(SkRSXform::Make(scale, 0, dst.fLeft, dst.fTop));
+        bounds.join(dst);
+      }
+      // Without colors the blend mode of an atlas is not used.
+      receiver_.drawAtlas(image_, xforms.data(), image_srcs_.data(), nullptr,
+                          static_cast<int>(count), DlBlendMode::kSrcOver,
+                          sampling_, &bounds, image_with_attributes_);
+      batched_ops_ = true;
+    }
+    image_ = nullptr;
+    image_srcs_.clear();
+    image_dsts_.clear();
+  }
+};
+
+}  // namespace
+
+sk_sp<DisplayList> BatchDisplayListOps(const sk_sp<DisplayList>& display_list) {
+  if (!display_list) {
+    return display_list;
+  }
+  DisplayListBuilder builder(display_list->bounds(),
+                             display_list->has_rtree());
+  DlOpBatcher batcher(DisplayListBuilderBatchingAccessor(builder));
+  display_list->Dispatch(batcher);
+  if (!batcher.Finish()) {
+    return display_list;
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OP_BATCHER_H_
+#define FLUTTER_DISPLAY_LIST_DL_OP_BATCHER_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Returns a copy of |display_list| in which runs of adjacent
+///             |drawRect| ops, and runs of adjacent |drawImageRect| ops of a
+///             single image, are merged into single |drawRects| and
+///             |drawAtlas| ops.
+///
+///             Ops are only adjacent if no attribute, transform, clip or
+///             save operation separates them, so every op of a run shares
+///             the same paint and transform. Runs of images are also only
+///             merged when each image is drawn at a uniform scale with the
+///             fast source rect constraint and without any filters or
+///             blend modes that would process the run as a whole.
+///
+///             The result renders the same as |display_list|. Backends that
+///             understand the batched ops, like Impeller, render each run
+///             with one draw instead of one draw per op.
+///
+///             Nested display lists are batched as well. If nothing could
+///             be batched then |display_list| itself is returned.
+///
+/// @see        DlOpReceiver::drawRects
+sk_sp<DisplayList> BatchDisplayListOps(const sk_sp<DisplayList>& display_list);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OP_BATCHER_H_
@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_batcher.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+TEST(DisplayListOpBatcher, AdjacentRectsAreBatched) {
+  const SkRect rects[] = {
+      SkRect::MakeLTRB(0, 0, 10, 10),
+      SkRect::MakeLTRB(0, 20, 10, 30),
+      SkRect::MakeLTRB(0, 40, 10, 50),
+  };
+  DisplayListBuilder builder;
+  for (const SkRect& rect : rects) {
+    builder.DrawRect(rect, DlPaint(DlColor::kRed()));
+  }
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& receiver = DisplayListBuilderTestingAccessor(expected_builder);
+  receiver.setColor(DlColor::kRed());
+  receiver.drawRects(rects, 3);
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> batched = BatchDisplayListOps(display_list);
+  EXPECT_EQ(display_list->op_count(), 3u);
+  EXPECT_EQ(batched->op_count(), 1u);
+  EXPECT_EQ(batched->bounds(), display_list->bounds());
+  EXPECT_TRUE(batched->Equals(expected));
+}
+
+TEST(DisplayListOpBatcher, AttributeAndTransformChangesEndRuns) {
+  DisplayListBuilder builder;
+  DlPaint red(DlColor::kRed());
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), red);
+  builder.DrawRect(SkRect::MakeLTRB(0, 20, 10, 30), red);
+  builder.DrawRect(SkRect::MakeLTRB(0, 40, 10, 50), DlPaint(DlColor::kBlue()));
+  builder.Translate(5, 5);
+  builder.DrawRect(SkRect::MakeLTRB(0, 40, 10, 50), DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  sk_sp<DisplayList> batched = BatchDisplayListOps(display_list);
+  // The first two rects are merged, the others are kept as they were.
+  EXPECT_EQ(display_list->op_count(), 5u);
+  EXPECT_EQ(batched->op_count(), 4u);
+}
+
+TEST(DisplayListOpBatcher, ListsWithNothingToBatchAreReturned) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.DrawOval(SkRect::MakeLTRB(0, 20, 10, 30), DlPaint());
+  builder.DrawRect(SkRect::MakeLTRB(0, 40, 10, 50), DlPaint());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(BatchDisplayListOps(display_list), display_list);
+}
+
+TEST(DisplayListOpBatcher, ImageRectsAreBatchedIntoAnAtlas) {
+  const SkRect src1 = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect src2 = SkRect::MakeLTRB(10, 0, 20, 10);
+  const SkRect dst1 = SkRect::MakeLTRB(100, 100, 120, 120);
+  const SkRect dst2 = SkRect::MakeLTRB(50, 150, 60, 160);
+  DisplayListBuilder builder;
+  builder.DrawImageRect(TestImage1, src1, dst1, DlImageSampling::kLinear);
+  builder.DrawImageRect(TestImage1, src2, dst2, DlImageSampling::kLinear);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  const SkRSXform xforms[] = {
+      SkRSXform::Make(2, 0, 100, 100),
+      SkRSXform::Make(1, 0, 50, 150),
+  };
+  const SkRect tex[] = {src1, src2};
+  const SkRect cull_rect = SkRect::MakeLTRB(50, 100, 120, 160);
+  DisplayListBuilder expected_builder;
+  DisplayListBuilderTestingAccessor(expected_builder)
+      .drawAtlas(TestImage1, xforms, tex, nullptr, 2, DlBlendMode::kSrcOver,
+                 DlImageSampling::kLinear, &cull_rect, false);
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> batched = BatchDisplayListOps(display_list);
+  EXPECT_EQ(batched->op_count(), 1u);
+  EXPECT_TRUE(batched->Equals(expected));
+}
+
+TEST(DisplayListOpBatcher, ImageRectsThatAtlasesCannotDrawAreNotBatched) {
+  const SkRect src = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect dst1 = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect dst2 = SkRect::MakeLTRB(20, 0, 30, 10);
+  const SkRect stretched_dst = SkRect::MakeLTRB(40, 0, 60, 10);
+  DlPaint blurred;
+  blurred.setImageFilter(&kTestBlurImageFilter1);
+
+  auto build = [&](auto draw_second) {
+    DisplayListBuilder builder;
+    builder.DrawImageRect(TestImage1, src, dst1, DlImageSampling::kLinear);
+    draw_second(builder);
+    return builder.Build();
+  };
+  const sk_sp<DisplayList> lists[] = {
+      // A different image.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawImageRect(TestImage2, src, dst2, DlImageSampling::kLinear);
+      }),
+      // A different sampling.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawImageRect(TestImage1, src, dst2,
+                              DlImageSampling::kNearestNeighbor);
+      }),
+      // A non-uniform scale.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawImageRect(TestImage1, src, stretched_dst,
+                              DlImageSampling::kLinear);
+      }),
+      // A strict source rect.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawImageRect(TestImage1, src, dst2, DlImageSampling::kLinear,
+                              nullptr, DlCanvas::SrcRectConstraint::kStrict);
+      }),
+      // A filter that would apply to the whole atlas.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawImageRect(TestImage1, src, dst2, DlImageSampling::kLinear,
+                              &blurred);
+        builder.DrawImageRect(TestImage1, src, dst2, DlImageSampling::kLinear,
+                              &blurred);
+      }),
+  };
+  for (size_t i = 0; i < std::size(lists); i++) {
+    EXPECT_EQ(BatchDisplayListOps(lists[i]), lists[i]) << "list " << i;
+  }
+}
+
+TEST(DisplayListOpBatcher, NestedListsAreBatched) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  nested_builder.DrawRect(SkRect::MakeLTRB(0, 20, 10, 30), DlPaint());
+  DisplayListBuilder builder;
+  builder.DrawDisplayList(nested_builder.Build());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  sk_sp<DisplayList> batched = BatchDisplayListOps(display_list);
+  EXPECT_NE(batched, display_list);
+  EXPECT_EQ(display_list->op_count(true), 2u);
+  EXPECT_EQ(batched->op_count(true), 1u);
+}
+
+TEST(DisplayListOpBatcher, BatchedRectsDispatchAsRectsByDefault) {
+  class RectCollector final : public IgnoreAttributeDispatchHelper,
+                              public IgnoreClipDispatchHelper,
+                              public IgnoreTransformDispatchHelper,
+                              public IgnoreDrawDispatchHelper {
+   public:
+    void drawRect(const SkRect& rect) override { rects.push_back(rect); }
+
+    std::vector<SkRect> rects;
+  };
+
+  const SkRect rects[] = {
+      SkRect::MakeLTRB(0, 0, 10, 10),
+      SkRect::MakeLTRB(0, 20, 10, 30),
+  };
+  DisplayListBuilder builder;
+  for (const SkRect& rect : rects) {
+    builder.DrawRect(rect, DlPaint());
+  }
+  sk_sp<DisplayList> batched = BatchDisplayListOps(builder.Build());
+  ASSERT_EQ(batched->op_count(), 1u);
+
+  RectCollector collector;
+  batched->Dispatch(collector);
+  ASSERT_EQ(collector.rects.size(), 2u);
+  EXPECT_EQ(collector.rects[0], rects[0]);
+  EXPECT_EQ(collector.rects[1], rects[1]);
+}
+
+}  // namespace testing
+}  // namespace flutter
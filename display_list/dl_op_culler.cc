@@ -0,0 +1,1029 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_culler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/geometry/dl_rtree.h"
+#include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
+
+namespace flutter {
+
+// The culler replays the surviving ops of a DisplayList directly into the
+// DlOpReceiver interface of a new DisplayListBuilder.
+DlOpReceiver& DisplayListBuilderCullingAccessor(DisplayListBuilder& builder) {
+  return builder.asReceiver();
+}
+
+namespace {
+
+enum class OpKind {
+  kAttribute,
+  kTransform,
+  kClip,
+  kSave,
+  kSaveLayer,
+  kRestore,
+  kRender,
+};
+
+struct OpInfo {
+  OpKind kind;
+  // For render ops, whether the op may be removed if it is hidden.
+  bool removable = false;
+  // Whether the op may read the pixels rendered before it from anywhere
+  // inside its bounds, as a backdrop filter does.
+  bool reads_backdrop = false;
+  // The device pixels that a render op is known to cover with opaque
+  // pixels, or an empty rect.
+  SkRect occluder = SkRect::MakeEmpty();
+  // Whether the op may make opaque pixels of the destination translucent.
+  bool erases = false;
+};
+
+// The maximum number of occluders that are tracked at once while looking
+// for hidden ops. Hidden ops are usually covered by one of the few most
+// recent large ops, so a small number keeps the pass linear in practice.
+constexpr size_t kMaxOccluders = 8;
+
+// Returns the pixels that are covered entirely by |rect|.
+SkRect InnerPixels(const SkRect& rect) {
+  return SkRect::MakeLTRB(std::ceil(rect.fLeft), std::ceil(rect.fTop),
+                          std::floor(rect.fRight), std::floor(rect.fBottom));
+}
+
+// Returns the larger of the two rects that span the full width or the full
+// height of |rrect| inside its corners.
+SkRect InnerRect(const SkRRect& rrect) {
+  if (rrect.isRect()) {
+    return rrect.rect();
+  }
+  const SkRect& rect = rrect.rect();
+  const SkVector ul = rrect.radii(SkRRect::kUpperLeft_Corner);
+  const SkVector ur = rrect.radii(SkRRect::kUpperRight_Corner);
+  const SkVector lr = rrect.radii(SkRRect::kLowerRight_Corner);
+  const SkVector ll = rrect.radii(SkRRect::kLowerLeft_Corner);
+  SkRect wide = SkRect::MakeLTRB(rect.fLeft, rect.fTop + std::max(ul.fY, ur.fY),
+                                 rect.fRight,
+                                 rect.fBottom - std::max(ll.fY, lr.fY));
+  SkRect tall = SkRect::MakeLTRB(rect.fLeft + std::max(ul.fX, ll.fX),
+                                 rect.fTop,
+                                 rect.fRight - std::max(ur.fX, lr.fX),
+                                 rect.fBottom);
+  if (wide.isEmpty()) {
+    return tall;
+  }
+  if (tall.isEmpty()) {
+    return wide;
+  }
+  return wide.width() * wide.height() >= tall.width() * tall.height() ? wide
+                                                                      : tall;
+}
+
+// Records the state under which each op of a DisplayList is rendered and
+// decides which of them can be removed.
+class DlOpAnalyzer final : public DlOpReceiver {
+ public:
+  DlOpAnalyzer()
+      : tracker_(DisplayListBuilder::kMaxCullRect, SkMatrix::I()) {
+    levels_.push_back({});
+  }
+
+  // Returns, for each op, whether it can be removed. |rtree| must hold the
+  // bounds of the ops of the dispatched DisplayList.
+  std::vector<bool> FindRemovableOps(const DlRTree& rtree) const {
+    std::vector<SkRect> bounds(ops_.size(), SkRect::MakeEmpty());
+    for (int i = 0; i < rtree.leaf_count(); i++) {
+      int id = rtree.id(i);
+      if (id >= 0 && static_cast<size_t>(id) < bounds.size()) {
+        bounds[id].join(rtree.bounds(i));
+      }
+    }
+
+    std::vector<bool> removed(ops_.size(), false);
+    FindHiddenOps(bounds, removed);
+    FindEmptyGroups(bounds, removed);
+    return removed;
+  }
+
+  // Returns the largest occluder that no later op can erase, in device
+  // pixels.
+  SkRect FindOpaqueBounds() const {
+    SkRect opaque = SkRect::MakeEmpty();
+    for (const OpInfo& info : ops_) {
+      if (info.erases) {
+        opaque.setEmpty();
+      }
+      if (Area(info.occluder) > Area(opaque)) {
+        opaque = info.occluder;
+      }
+    }
+    return opaque;
+  }
+
+  // Returns whether any op may read the pixels rendered before it, or
+  // make them translucent.
+  bool ReadsBackdrop() const {
+    for (const OpInfo& info : ops_) {
+      if (info.reads_backdrop || info.erases) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void setAntiAlias(bool aa) override { Attribute(); }
+  void setDither(bool dither) override { Attribute(); }
+  void setDrawStyle(DlDrawStyle style) override {
+    Attribute();
+    style_ = style;
+  }
+  void setColor(DlColor color) override {
+    Attribute();
+    color_ = color;
+  }
+  void setStrokeWidth(float width) override { Attribute(); }
+  void setStrokeMiter(float limit) override { Attribute(); }
+  void setStrokeCap(DlStrokeCap cap) override { Attribute(); }
+  void setStrokeJoin(DlStrokeJoin join) override { Attribute(); }
+  void setColorSource(const DlColorSource* source) override {
+    Attribute();
+    color_source_is_opaque_ = source == nullptr || source->is_opaque();
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Attribute();
+    has_color_filter_ = filter != nullptr;
+  }
+  void setInvertColors(bool invert) override { Attribute(); }
+  void setBlendMode(DlBlendMode mode) override {
+    Attribute();
+    blend_mode_ = mode;
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    Attribute();
+    has_path_effect_ = effect != nullptr;
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Attribute();
+    has_mask_filter_ = filter != nullptr;
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Attribute();
+    has_image_filter_ = filter != nullptr;
+  }
+
+  void save() override {
+    ops_.push_back({OpKind::kSave});
+    levels_.push_back(levels_.back());
+    tracker_.save();
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    OpInfo info{OpKind::kSaveLayer};
+    info.reads_backdrop = backdrop != nullptr;
+    // The layer may be translucent, so only the modes that keep the
+    // destination opaque under any source are safe.
+    info.erases = levels_.back().layer_depth == 0 &&
+                  options.renders_with_attributes() &&
+                  MayErase(blend_mode_, false);
+    ops_.push_back(info);
+    Level level = levels_.back();
+    level.layer_depth++;
+    if (options.renders_with_attributes() && has_image_filter_) {
+      level.filtered = true;
+    }
+    levels_.push_back(level);
+    tracker_.save();
+  }
+  void restore() override {
+    ops_.push_back({OpKind::kRestore});
+    if (levels_.size() > 1) {
+      levels_.pop_back();
+    }
+    tracker_.restore();
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    Transform();
+    tracker_.translate(tx, ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    Transform();
+    tracker_.scale(sx, sy);
+  }
+  void rotate(SkScalar degrees) override {
+    Transform();
+    tracker_.rotate(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    Transform();
+    tracker_.skew(sx, sy);
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    Transform();
+    tracker_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Transform();
+    tracker_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                      myx, myy, myz, myt,
+                                      mzx, mzy, mzz, mzt,
+                                      mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override {
+    Transform();
+    tracker_.setIdentity();
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    ops_.push_back({OpKind::kClip});
+    if (clip_op == ClipOp::kIntersect) {
+      IntersectOcclusionClip(rect);
+    } else {
+      levels_.back().occlusion_clip.setEmpty();
+    }
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    ops_.push_back({OpKind::kClip});
+    if (clip_op == ClipOp::kIntersect) {
+      IntersectOcclusionClip(InnerRect(rrect));
+    } else {
+      levels_.back().occlusion_clip.setEmpty();
+    }
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    ops_.push_back({OpKind::kClip});
+    SkRect rect;
+    if (clip_op == ClipOp::kIntersect && !path.isInverseFillType() &&
+        path.isRect(&rect)) {
+      IntersectOcclusionClip(rect);
+    } else {
+      levels_.back().occlusion_clip.setEmpty();
+    }
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    bool opaque = color.isOpaque() && IsOpaqueBlendMode(mode);
+    Render(opaque ? &levels_.back().occlusion_clip : nullptr, false);
+    if (levels_.back().layer_depth == 0) {
+      ops_.back().erases = MayErase(mode, color.isOpaque());
+    }
+  }
+  void drawPaint() override {
+    bool opaque = PaintIsOpaque();
+    Render(opaque ? &levels_.back().occlusion_clip : nullptr, false);
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override { Render(); }
+  void drawRect(const SkRect& rect) override {
+    RenderShape(rect);
+  }
+  void drawRects(const SkRect rects[], uint32_t count) override {
+    // Only the largest of the rects is used as an occluder.
+    SkRect largest = SkRect::MakeEmpty();
+    for (uint32_t i = 0; i < count; i++) {
+      if (rects[i].width() * rects[i].height() >
+          largest.width() * largest.height()) {
+        largest = rects[i];
+      }
+    }
+    RenderShape(largest);
+  }
+  void drawOval(const SkRect& bounds) override { Render(); }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Render();
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    RenderShape(InnerRect(rrect));
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Render();
+  }
+  void drawPath(const SkPath& path) override { Render(); }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Render();
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    Render();
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    Render();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (ImageIsOpaque(image, render_with_attributes)) {
+      RenderOpaque(SkRect::MakeXYWH(point.fX, point.fY, image->width(),
+                                    image->height()));
+    } else {
+      Render();
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    if (ImageIsOpaque(image, render_with_attributes) &&
+        SkRect::Make(image->bounds()).contains(src)) {
+      RenderOpaque(dst);
+    } else {
+      Render();
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Render();
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    Render();
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    const bool reads_backdrop = display_list->may_read_backdrop();
+    Render(nullptr, reads_backdrop);
+    ops_.back().erases = levels_.back().layer_depth == 0 && reads_backdrop;
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Render();
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    Render();
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Render();
+  }
+
+ private:
+  // The state that save and restore scope.
+  struct Level {
+    // The number of saveLayers that enclose the ops.
+    int layer_depth = 0;
+    // Whether any enclosing saveLayer applies an image filter.
+    bool filtered = false;
+    // The device pixels that are known to be inside the clip.
+    SkRect occlusion_clip = DisplayListBuilder::kMaxCullRect;
+  };
+
+  std::vector<OpInfo> ops_;
+  std::vector<Level> levels_;
+  DisplayListMatrixClipTracker tracker_;
+
+  DlDrawStyle style_ = DlDrawStyle::kFill;
+  DlColor color_ = DlColor::kBlack();
+  DlBlendMode blend_mode_ = DlBlendMode::kSrcOver;
+  bool color_source_is_opaque_ = true;
+  bool has_color_filter_ = false;
+  bool has_path_effect_ = false;
+  bool has_mask_filter_ = false;
+  bool has_image_filter_ = false;
+
+  static bool IsOpaqueBlendMode(DlBlendMode mode) {
+    return mode == DlBlendMode::kSrcOver || mode == DlBlendMode::kSrc;
+  }
+
+  // Whether rendering with |mode| may lower the alpha of an opaque
+  // destination, given whether the source is known to be opaque.
+  static bool MayErase(DlBlendMode mode, bool source_is_opaque) {
+    switch (mode) {
+      case DlBlendMode::kSrc:
+        return !source_is_opaque;
+      case DlBlendMode::kClear:
+      case DlBlendMode::kSrcIn:
+      case DlBlendMode::kDstIn:
+      case DlBlendMode::kSrcOut:
+      case DlBlendMode::kDstOut:
+      case DlBlendMode::kDstATop:
+      case DlBlendMode::kXor:
+      case DlBlendMode::kModulate:
+        return true;
+      default:
+        // The remaining modes all produce an alpha of at least that of the
+        // destination.
+        return false;
+    }
+  }
+
+  static SkScalar Area(const SkRect& rect) {
+    return rect.isEmpty() ? 0 : rect.width() * rect.height();
+  }
+
+  bool PaintIsOpaque() const {
+    return color_.isOpaque() && IsOpaqueBlendMode(blend_mode_) &&
+           color_source_is_opaque_ && !has_color_filter_ &&
+           !has_mask_filter_ && !has_image_filter_;
+  }
+
+  bool ImageIsOpaque(const sk_sp<DlImage>& image,
+                     bool render_with_attributes) const {
+    return image && image->isOpaque() &&
+           (!render_with_attributes || PaintIsOpaque());
+  }
+
+  void Attribute() { ops_.push_back({OpKind::kAttribute}); }
+  void Transform() { ops_.push_back({OpKind::kTransform}); }
+
+  // Maps |rect| to the device pixels that it covers entirely, or returns
+  // false if the transform does not keep it a rect.
+  bool MapToInnerPixels(const SkRect& rect, SkRect* mapped) const {
+    if (tracker_.using_4x4_matrix()) {
+      return false;
+    }
+    SkMatrix matrix = tracker_.matrix_3x3();
+    if (!matrix.rectStaysRect()) {
+      return false;
+    }
+    *mapped = InnerPixels(matrix.mapRect(rect));
+    return true;
+  }
+
+  void IntersectOcclusionClip(const SkRect& rect) {
+    SkRect& clip = levels_.back().occlusion_clip;
+    SkRect mapped;
+    if (!MapToInnerPixels(rect, &mapped) || !clip.intersect(mapped)) {
+      clip.setEmpty();
+    }
+  }
+
+  void Render(const SkRect* occluder = nullptr, bool reads_backdrop = false) {
+    const Level& level = levels_.back();
+    OpInfo info{OpKind::kRender};
+    info.removable = !level.filtered;
+    info.reads_backdrop = reads_backdrop;
+    if (occluder && level.layer_depth == 0) {
+      info.occluder = *occluder;
+    }
+    info.erases =
+        level.layer_depth == 0 && MayErase(blend_mode_, PaintIsOpaque());
+    ops_.push_back(info);
+  }
+
+  // Renders an op that covers |rect| with opaque pixels in local
+  // coordinates.
+  void RenderOpaque(const SkRect& rect) {
+    SkRect occluder;
+    if (MapToInnerPixels(rect, &occluder) &&
+        occluder.intersect(levels_.back().occlusion_clip)) {
+      Render(&occluder);
+    } else {
+      Render();
+    }
+  }
+
+  // Renders a shape that covers |rect| when filled with the current
+  // attributes.
+  void RenderShape(const SkRect& rect) {
+    if (style_ == DlDrawStyle::kFill && !has_path_effect_ &&
+        PaintIsOpaque()) {
+      RenderOpaque(rect);
+    } else {
+      Render();
+    }
+  }
+
+  void FindHiddenOps(const std::vector<SkRect>& bounds,
+                     std::vector<bool>& removed) const {
+    std::vector<SkRect> occluders;
+    for (size_t i = ops_.size(); i-- > 0;) {
+      const OpInfo& info = ops_[i];
+      if (info.kind == OpKind::kRender) {
+        if (info.removable && !bounds[i].isEmpty()) {
+          for (const SkRect& occluder : occluders) {
+            if (occluder.contains(bounds[i])) {
+              removed[i] = true;
+              break;
+            }
+          }
+          if (removed[i]) {
+            continue;
+          }
+        }
+        if (!info.occluder.isEmpty()) {
+          AddOccluder(occluders, info.occluder);
+        }
+      }
+      if (info.reads_backdrop) {
+        occluders.clear();
+      }
+    }
+  }
+
+  static void AddOccluder(std::vector<SkRect>& occluders,
+                          const SkRect& occluder) {
+    if (occluders.size() < kMaxOccluders) {
+      occluders.push_back(occluder);
+      return;
+    }
+    SkRect* smallest = &occluders[0];
+    for (SkRect& rect : occluders) {
+      if (Area(rect) < Area(*smallest)) {
+        smallest = &rect;
+      }
+    }
+    if (Area(occluder) > Area(*smallest)) {
+      *smallest = occluder;
+    }
+  }
+
+  // Removes the saves and saveLayers, and the transforms and clips inside
+  // them, that are left without anything to render. Attributes are not
+  // scoped by save and restore and so are kept.
+  void FindEmptyGroups(const std::vector<SkRect>& bounds,
+                       std::vector<bool>& removed) const {
+    struct Group {
+      size_t start;
+      bool has_output;
+    };
+    std::vector<Group> groups;
+    for (size_t i = 0; i < ops_.size(); i++) {
+      const OpInfo& info = ops_[i];
+      switch (info.kind) {
+        case OpKind::kSave:
+          groups.push_back({i, false});
+          break;
+        case OpKind::kSaveLayer:
+          // A layer whose paint affects transparent pixels is accounted for
+          // in the bounds of the saveLayer op itself.
+          groups.push_back({i, info.reads_backdrop || !bounds[i].isEmpty()});
+          break;
+        case OpKind::kRestore: {
+          if (groups.empty()) {
+            break;
+          }
+          Group group = groups.back();
+          groups.pop_back();
+          if (group.has_output) {
+            if (!groups.empty()) {
+              groups.back().has_output = true;
+            }
+            break;
+          }
+          for (size_t j = group.start; j <= i; j++) {
+            if (ops_[j].kind != OpKind::kAttribute) {
+              removed[j] = true;
+            }
+          }
+          break;
+        }
+        case OpKind::kRender:
+          if (!removed[i] && !groups.empty()) {
+            groups.back().has_output = true;
+          }
+          break;
+        case OpKind::kAttribute:
+        case OpKind::kTransform:
+        case OpKind::kClip:
+          break;
+      }
+    }
+  }
+};
+
+// Forwards the ops that were not removed to |receiver| and folds runs of
+// rect intersect clips.
+class DlOpFilter final : public DlOpReceiver {
+ public:
+  DlOpFilter(DlOpReceiver& receiver, const std::vector<bool>& removed)
+      : receiver_(receiver), removed_(removed) {}
+
+  void Finish() { FlushClip(); }
+
+  void setAntiAlias(bool aa) override {
+    if (Next()) {
+      receiver_.setAntiAlias(aa);
+    }
+  }
+  void setDither(bool dither) override {
+    if (Next()) {
+      receiver_.setDither(dither);
+    }
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    if (Next()) {
+      receiver_.setDrawStyle(style);
+    }
+  }
+  void setColor(DlColor color) override {
+    if (Next()) {
+      receiver_.setColor(color);
+    }
+  }
+  void setStrokeWidth(float width) override {
+    if (Next()) {
+      receiver_.setStrokeWidth(width);
+    }
+  }
+  void setStrokeMiter(float limit) override {
+    if (Next()) {
+      receiver_.setStrokeMiter(limit);
+    }
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    if (Next()) {
+      receiver_.setStrokeCap(cap);
+    }
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    if (Next()) {
+      receiver_.setStrokeJoin(join);
+    }
+  }
+  void setColorSource(const DlColorSource* source) override {
+    if (Next()) {
+      receiver_.setColorSource(source);
+    }
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    if (Next()) {
+      receiver_.setColorFilter(filter);
+    }
+  }
+  void setInvertColors(bool invert) override {
+    if (Next()) {
+      receiver_.setInvertColors(invert);
+    }
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    if (Next()) {
+      receiver_.setBlendMode(mode);
+    }
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    if (Next()) {
+      receiver_.setPathEffect(effect);
+    }
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    if (Next()) {
+      receiver_.setMaskFilter(filter);
+    }
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    if (Next()) {
+      receiver_.setImageFilter(filter);
+    }
+  }
+
+  void save() override {
+    if (Next()) {
+      receiver_.save();
+    }
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    if (Next()) {
+      receiver_.saveLayer(bounds, options, backdrop);
+    }
+  }
+  void restore() override {
+    if (Next()) {
+      receiver_.restore();
+    }
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    if (Next()) {
+      receiver_.translate(tx, ty);
+    }
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    if (Next()) {
+      receiver_.scale(sx, sy);
+    }
+  }
+  void rotate(SkScalar degrees) override {
+    if (Next()) {
+      receiver_.rotate(degrees);
+    }
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    if (Next()) {
+      receiver_.skew(sx, sy);
+    }
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    if (Next()) {
+      receiver_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+    }
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    if (Next()) {
+      receiver_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                         myx, myy, myz, myt,
+                                         mzx, mzy, mzz, mzt,
+                                         mwx, mwy, mwz, mwt);
+    }
+  }
+  // clang-format on
+  void transformReset() override {
+    if (Next()) {
+      receiver_.transformReset();
+    }
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    if (removed_[index_++]) {
+      return;
+    }
+    if (clip_op != ClipOp::kIntersect) {
+      FlushClip();
+      receiver_.clipRect(rect, clip_op, is_aa);
+      return;
+    }
+    if (pending_clip_.has_value() && pending_clip_is_aa_ == is_aa) {
+      if (!pending_clip_->intersect(rect)) {
+        pending_clip_->setEmpty();
+      }
+      return;
+    }
+    FlushClip();
+    pending_clip_ = rect;
+    pending_clip_is_aa_ = is_aa;
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    if (Next()) {
+      receiver_.clipRRect(rrect, clip_op, is_aa);
+    }
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    if (Next()) {
+      receiver_.clipPath(path, clip_op, is_aa);
+    }
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    if (Next()) {
+      receiver_.drawColor(color, mode);
+    }
+  }
+  void drawPaint() override {
+    if (Next()) {
+      receiver_.drawPaint();
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    if (Next()) {
+      receiver_.drawLine(p0, p1);
+    }
+  }
+  void drawRect(const SkRect& rect) override {
+    if (Next()) {
+      receiver_.drawRect(rect);
+    }
+  }
+  void drawRects(const SkRect rects[], uint32_t count) override {
+    if (Next()) {
+      receiver_.drawRects(rects, count);
+    }
+  }
+  void drawOval(const SkRect& bounds) override {
+    if (Next()) {
+      receiver_.drawOval(bounds);
+    }
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    if (Next()) {
+      receiver_.drawCircle(center, radius);
+    }
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    if (Next()) {
+      receiver_.drawRRect(rrect);
+    }
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    if (Next()) {
+      receiver_.drawDRRect(outer, inner);
+    }
+  }
+  void drawPath(const SkPath& path) override {
+    if (Next()) {
+      receiver_.drawPath(path);
+    }
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    if (Next()) {
+      receiver_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+    }
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    if (Next()) {
+      receiver_.drawPoints(mode, count, points);
+    }
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    if (Next()) {
+      receiver_.drawVertices(vertices, mode);
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (Next()) {
+      receiver_.drawImage(image, point, sampling, render_with_attributes);
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    if (Next()) {
+      receiver_.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                              constraint);
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    if (Next()) {
+      receiver_.drawImageNine(image, center, dst, filter,
+                              render_with_attributes);
+    }
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    if (Next()) {
+      receiver_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                          cull_rect, render_with_attributes);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    if (Next()) {
+      receiver_.drawDisplayList(display_list, opacity);
+    }
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    if (Next()) {
+      receiver_.drawTextBlob(blob, x, y);
+    }
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    if (Next()) {
+      receiver_.drawTextFrame(text_frame, x, y);
+    }
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    if (Next()) {
+      receiver_.drawShadow(path, color, elevation, transparent_occluder, dpr);
+    }
+  }
+
+ private:
+  DlOpReceiver& receiver_;
+  const std::vector<bool>& removed_;
+  size_t index_ = 0;
+
+  std::optional<SkRect> pending_clip_;
+  bool pending_clip_is_aa_ = false;
+
+  // Returns true if the next op should be forwarded, after forwarding any
+  // clip that it ends the run of.
+  bool Next() {
+    if (removed_[index_++]) {
+      return false;
+    }
+    FlushClip();
+    return true;
+  }
+
+  void FlushClip() {
+    if (pending_clip_.has_value()) {
+      receiver_.clipRect(*pending_clip_, ClipOp::kIntersect,
+                         pending_clip_is_aa_);
+      pending_clip_.reset();
+    }
+  }
+};
+
+}  // namespace
+
+sk_sp<DisplayList> CullDisplayListOps(const sk_sp<DisplayList>& display_list,
+                                      DlOpCullingStats* stats) {
+  if (stats) {
+    *stats = DlOpCullingStats();
+  }
+  if (!display_list) {
+    return display_list;
+  }
+
+  // The analysis needs the bounds of each op, which a copy of the list
+  // recorded with an R-Tree provides.
+  sk_sp<DisplayList> source = display_list;
+  if (!source->has_rtree()) {
+    DisplayListBuilder builder(source->bounds(), true);
+    source->Dispatch(DisplayListBuilderCullingAccessor(builder));
+    source = builder.Build();
+  }
+
+  DlOpAnalyzer analyzer;
+  source->Dispatch(analyzer);
+  std::vector<bool> removed = analyzer.FindRemovableOps(*source->rtree());
+
+  DisplayListBuilder builder(display_list->bounds(),
+                             display_list->has_rtree());
+  DlOpFilter filter(DisplayListBuilderCullingAccessor(builder), removed);
+  source->Dispatch(filter);
+  filter.Finish();
+  sk_sp<DisplayList> culled = builder.Build();
+
+  if (culled->op_count() >= display_list->op_count()) {
+    return display_list;
+  }
+  if (stats) {
+    stats->removed_op_count = display_list->op_count() - culled->op_count();
+    size_t bytes = display_list->bytes(false);
+    size_t culled_bytes = culled->bytes(false);
+    stats->removed_bytes = bytes > culled_bytes ? bytes - culled_bytes : 0;
+  }
+  return culled;
+}
+
+SkRect GetDisplayListOpaqueBounds(const DisplayList& display_list,
+                                  bool* reads_backdrop) {
+  DlOpAnalyzer analyzer;
+  display_list.Dispatch(analyzer);
+  if (reads_backdrop) {
+    *reads_backdrop = analyzer.ReadsBackdrop();
+  }
+  SkRect opaque = analyzer.FindOpaqueBounds();
+  if (!opaque.intersect(display_list.bounds())) {
+    return SkRect::MakeEmpty();
+  }
+  return opaque;
+}
+
+}  // namespace flutter
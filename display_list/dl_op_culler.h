@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OP_CULLER_H_
+#define FLUTTER_DISPLAY_LIST_DL_OP_CULLER_H_
+
+#include "flutter/display_list/display_list.h"
+
+namespace flutter {
+
+// The amount by which |CullDisplayListOps| reduced a DisplayList.
+struct DlOpCullingStats {
+  // The difference in |DisplayList::op_count|.
+  unsigned int removed_op_count = 0;
+  // The difference in |DisplayList::bytes|, not counting nested lists.
+  size_t removed_bytes = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Returns a copy of |display_list| without the ops that cannot
+///             affect its rendering.
+///
+///             - Rendering ops whose device bounds are covered entirely by
+///               an opaque rect, rrect, image, |drawColor| or |drawPaint|
+///               drawn later outside of any saveLayer are removed. An op
+///               only covers the part of its bounds that is inside a rect
+///               clip, and only if it is drawn with a transform that keeps
+///               rects as rects.
+///             - Ops inside a saveLayer with an image filter are kept, as
+///               the filter may move their output, and nothing is hidden by
+///               an op drawn after a backdrop filter, or a nested display
+///               list which contains one, that could read it.
+///             - Save and restore pairs, and saveLayer and restore pairs
+///               that cannot produce output, are removed along with the
+///               transform and clip ops between them once nothing is left
+///               for them to render.
+///             - Runs of rect intersect clips with no op between them are
+///               folded into a single clip.
+///
+///             If nothing could be removed then |display_list| itself is
+///             returned. The amount removed is stored in |stats| if it is
+///             not null.
+///
+/// @see        DisplayListBuilder::SetCullOpsOnBuild
+sk_sp<DisplayList> CullDisplayListOps(const sk_sp<DisplayList>& display_list,
+                                      DlOpCullingStats* stats = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      Returns a rect that |display_list| fills entirely with opaque
+///             pixels, or an empty rect if none is known.
+///
+///             The rect is the largest of the occluders described by
+///             |CullDisplayListOps| that is drawn after the last op that
+///             could make opaque pixels translucent again. Such ops are
+///             those drawn outside of any saveLayer with a blend mode that
+///             can lower the alpha of the destination, saveLayers restored
+///             with such a blend mode, and nested display lists containing
+///             such ops. The rect is limited to the bounds of
+///             |display_list|.
+///
+///             Whether any op of |display_list| may read the content drawn
+///             before it, as a backdrop filter does, or make it translucent
+///             is stored in |reads_backdrop| if it is not null.
+///
+/// @see        DisplayList::opaque_bounds
+SkRect GetDisplayListOpaqueBounds(const DisplayList& display_list,
+                                  bool* reads_backdrop = nullptr);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OP_CULLER_H_
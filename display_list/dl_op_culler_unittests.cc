@@ -0,0 +1,237 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_culler.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayListOpCuller, OpsHiddenByLaterOpaqueRectAreRemoved) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawOval(SkRect::MakeLTRB(2, 2, 8, 8), DlPaint(DlColor::kGreen()));
+  builder.DrawRect(SkRect::MakeLTRB(-5, -5, 20, 20),
+                   DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DlOpCullingStats stats;
+  sk_sp<DisplayList> culled = CullDisplayListOps(display_list, &stats);
+  EXPECT_EQ(display_list->op_count(), 3u);
+  EXPECT_EQ(culled->op_count(), 1u);
+  EXPECT_EQ(stats.removed_op_count, 2u);
+  EXPECT_EQ(stats.removed_bytes,
+            display_list->bytes(false) - culled->bytes(false));
+  EXPECT_GT(stats.removed_bytes, 0u);
+  EXPECT_EQ(culled->bounds(), display_list->bounds());
+}
+
+TEST(DisplayListOpCuller, StackedOpaqueCardsAreRemoved) {
+  DisplayListBuilder builder;
+  // Each card is drawn over the last one, and the last card is drawn over
+  // all of the others.
+  const SkRect card = SkRect::MakeLTRB(0, 0, 100, 100);
+  for (SkScalar inset : {10, 8, 6, 4, 0}) {
+    builder.DrawRRect(SkRRect::MakeRectXY(card.makeInset(inset, inset), 4, 4),
+                      DlPaint(DlColor::kWhite()));
+  }
+  sk_sp<DisplayList> culled = CullDisplayListOps(builder.Build());
+  EXPECT_EQ(culled->op_count(), 1u);
+}
+
+TEST(DisplayListOpCuller, OpsNotFullyHiddenAreKept) {
+  const DlPaint translucent(DlColor::kBlue().withAlpha(0x80));
+  const DlPaint opaque(DlColor::kBlue());
+  DlPaint stroked(DlColor::kBlue());
+  stroked.setDrawStyle(DlDrawStyle::kStroke);
+  const SkRect rect = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect cover = SkRect::MakeLTRB(-5, -5, 20, 20);
+
+  auto build = [&](auto draw_cover) {
+    DisplayListBuilder builder;
+    builder.DrawRect(rect, DlPaint(DlColor::kRed()));
+    draw_cover(builder);
+    return builder.Build();
+  };
+  const sk_sp<DisplayList> lists[] = {
+      // A translucent cover.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawRect(cover, translucent);
+      }),
+      // A stroked cover.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawRect(cover, stroked);
+      }),
+      // A cover that misses part of the rect.
+      build([&](DisplayListBuilder& builder) {
+        builder.DrawRect(SkRect::MakeLTRB(1, 0, 20, 20), opaque);
+      }),
+      // A cover under a rotation.
+      build([&](DisplayListBuilder& builder) {
+        builder.Rotate(45);
+        builder.DrawRect(SkRect::MakeLTRB(-100, -100, 100, 100), opaque);
+      }),
+      // A cover inside a layer.
+      build([&](DisplayListBuilder& builder) {
+        builder.SaveLayer(nullptr, nullptr);
+        builder.DrawRect(cover, opaque);
+        builder.Restore();
+      }),
+      // A cover clipped by a path.
+      build([&](DisplayListBuilder& builder) {
+        builder.ClipPath(SkPath().addCircle(5, 5, 30));
+        builder.DrawRect(cover, opaque);
+      }),
+  };
+  for (size_t i = 0; i < std::size(lists); i++) {
+    EXPECT_EQ(CullDisplayListOps(lists[i]), lists[i]) << "list " << i;
+  }
+}
+
+TEST(DisplayListOpCuller, BackdropFilterKeepsHiddenOps) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.SaveLayer(nullptr, nullptr, &kTestBlurImageFilter1);
+  builder.Restore();
+  builder.DrawRect(SkRect::MakeLTRB(-5, -5, 20, 20),
+                   DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(CullDisplayListOps(display_list), display_list);
+}
+
+TEST(DisplayListOpCuller, SavesLeftEmptyAreRemoved) {
+  DisplayListBuilder builder;
+  builder.Save();
+  builder.Translate(2, 2);
+  builder.ClipRect(SkRect::MakeLTRB(0, 0, 8, 8));
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.Restore();
+  builder.DrawRect(SkRect::MakeLTRB(-5, -5, 20, 20),
+                   DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DlOpCullingStats stats;
+  sk_sp<DisplayList> culled = CullDisplayListOps(display_list, &stats);
+  EXPECT_EQ(display_list->op_count(), 6u);
+  EXPECT_EQ(culled->op_count(), 1u);
+  EXPECT_EQ(stats.removed_op_count, 5u);
+}
+
+TEST(DisplayListOpCuller, AdjacentRectClipsAreFolded) {
+  const SkRect rect = SkRect::MakeLTRB(0, 0, 100, 100);
+  DisplayListBuilder builder;
+  builder.ClipRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  builder.ClipRect(SkRect::MakeLTRB(10, 10, 100, 100));
+  builder.DrawRect(rect, DlPaint());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.ClipRect(SkRect::MakeLTRB(10, 10, 50, 50));
+  expected_builder.DrawRect(rect, DlPaint());
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> culled = CullDisplayListOps(display_list);
+  EXPECT_EQ(culled->op_count(), 2u);
+  EXPECT_TRUE(culled->Equals(expected));
+}
+
+TEST(DisplayListOpCuller, BuilderCullsOnBuildWhenEnabled) {
+  DisplayListBuilder builder;
+  builder.SetCullOpsOnBuild(true);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_EQ(display_list->op_count(), 1u);
+  EXPECT_EQ(builder.last_build_culling_stats().removed_op_count, 1u);
+
+  builder.SetCullOpsOnBuild(false);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  display_list = builder.Build();
+
+  EXPECT_EQ(display_list->op_count(), 2u);
+  EXPECT_EQ(builder.last_build_culling_stats().removed_op_count, 0u);
+}
+
+TEST(DisplayListOpCuller, OpaqueBoundsAreTheLargestOpaqueOp) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 50, 40.5), DlPaint(DlColor::kRed()));
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 100, 100),
+                   DlPaint(DlColor::kRed().withAlpha(0x80)));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  // The edge that covers half of a pixel is left out.
+  EXPECT_EQ(display_list->opaque_bounds(), SkRect::MakeLTRB(0, 0, 50, 40));
+  EXPECT_EQ(GetDisplayListOpaqueBounds(*display_list),
+            display_list->opaque_bounds());
+  EXPECT_FALSE(display_list->may_read_backdrop());
+}
+
+TEST(DisplayListOpCuller, BackdropFiltersReadTheBackdrop) {
+  DisplayListBuilder builder;
+  builder.SaveLayer(nullptr, nullptr, &kTestBlurImageFilter1);
+  builder.Restore();
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  EXPECT_TRUE(display_list->may_read_backdrop());
+  EXPECT_EQ(display_list->opaque_bounds(), SkRect::MakeLTRB(0, 0, 10, 10));
+
+  DisplayListBuilder nesting_builder;
+  nesting_builder.DrawDisplayList(display_list);
+  EXPECT_TRUE(nesting_builder.Build()->may_read_backdrop());
+}
+
+TEST(DisplayListOpCuller, OpaqueBoundsAreLostToErasingOps) {
+  const SkRect rect = SkRect::MakeLTRB(0, 0, 10, 10);
+  auto opaque_bounds = [&](auto draw_after) {
+    DisplayListBuilder builder;
+    builder.DrawRect(rect, DlPaint(DlColor::kRed()));
+    draw_after(builder);
+    return builder.Build()->opaque_bounds();
+  };
+
+  EXPECT_EQ(opaque_bounds([](DisplayListBuilder& builder) {
+              builder.DrawCircle({5, 5}, 2, DlPaint(DlColor::kBlue()));
+            }),
+            rect);
+  EXPECT_EQ(opaque_bounds([](DisplayListBuilder& builder) {
+              DisplayListBuilder nested_builder;
+              nested_builder.DrawCircle({5, 5}, 2, DlPaint());
+              builder.DrawDisplayList(nested_builder.Build());
+            }),
+            rect);
+  EXPECT_TRUE(opaque_bounds([](DisplayListBuilder& builder) {
+                builder.DrawColor(DlColor::kTransparent(), DlBlendMode::kSrc);
+              }).isEmpty());
+  EXPECT_TRUE(opaque_bounds([](DisplayListBuilder& builder) {
+                DlPaint paint;
+                paint.setBlendMode(DlBlendMode::kDstOut);
+                builder.DrawCircle({5, 5}, 2, paint);
+              }).isEmpty());
+  EXPECT_TRUE(opaque_bounds([](DisplayListBuilder& builder) {
+                DlPaint paint;
+                paint.setBlendMode(DlBlendMode::kDstOut);
+                DisplayListBuilder nested_builder;
+                nested_builder.DrawCircle({5, 5}, 2, paint);
+                builder.DrawDisplayList(nested_builder.Build());
+              }).isEmpty());
+  EXPECT_TRUE(opaque_bounds([](DisplayListBuilder& builder) {
+                DlPaint paint;
+                paint.setBlendMode(DlBlendMode::kClear);
+                builder.SaveLayer(nullptr, &paint);
+                builder.DrawCircle({5, 5}, 2, DlPaint());
+                builder.Restore();
+              }).isEmpty());
+  EXPECT_TRUE(DisplayListBuilder().Build()->opaque_bounds().isEmpty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,356 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_folder.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+
+namespace flutter {
+
+// The folder replays the ops of a DisplayList directly into the
+// DlOpReceiver interface of a new DisplayListBuilder.
+DlOpReceiver& DisplayListBuilderFoldingAccessor(DisplayListBuilder& builder) {
+  return builder.asReceiver();
+}
+
+namespace {
+
+// Forwards ops to |receiver|, which has the folded color filter set before
+// the first op, and fails on any op that would not be drawn with it.
+class DlColorFilterFolder final : public DlOpReceiver {
+ public:
+  explicit DlColorFilterFolder(DlOpReceiver& receiver) : receiver_(receiver) {}
+
+  bool failed() const { return failed_; }
+
+  void setAntiAlias(bool aa) override {
+    if (!failed_) {
+      receiver_.setAntiAlias(aa);
+    }
+  }
+  void setDither(bool dither) override {
+    if (!failed_) {
+      receiver_.setDither(dither);
+    }
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    if (!failed_) {
+      receiver_.setDrawStyle(style);
+    }
+  }
+  void setColor(DlColor color) override {
+    if (!failed_) {
+      receiver_.setColor(color);
+    }
+  }
+  void setStrokeWidth(float width) override {
+    if (!failed_) {
+      receiver_.setStrokeWidth(width);
+    }
+  }
+  void setStrokeMiter(float limit) override {
+    if (!failed_) {
+      receiver_.setStrokeMiter(limit);
+    }
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    if (!failed_) {
+      receiver_.setStrokeCap(cap);
+    }
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    if (!failed_) {
+      receiver_.setStrokeJoin(join);
+    }
+  }
+  void setColorSource(const DlColorSource* source) override {
+    if (!failed_) {
+      receiver_.setColorSource(source);
+    }
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    // There is no way to compose two color filters, so the folded filter
+    // stays in place and a list which sets one of its own is not folded.
+    if (filter) {
+      failed_ = true;
+    }
+  }
+  void setInvertColors(bool invert) override {
+    if (!failed_) {
+      receiver_.setInvertColors(invert);
+    }
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    if (!failed_) {
+      receiver_.setBlendMode(mode);
+    }
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    if (!failed_) {
+      receiver_.setPathEffect(effect);
+    }
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    if (!failed_) {
+      receiver_.setMaskFilter(filter);
+    }
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    if (!failed_) {
+      receiver_.setImageFilter(filter);
+    }
+  }
+
+  void save() override {
+    if (!failed_) {
+      receiver_.save();
+    }
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    // The content of a layer drawn with attributes would be filtered twice
+    // and the content of other layers could blend with each other.
+    failed_ = true;
+  }
+  void restore() override {
+    if (!failed_) {
+      receiver_.restore();
+    }
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    if (!failed_) {
+      receiver_.translate(tx, ty);
+    }
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    if (!failed_) {
+      receiver_.scale(sx, sy);
+    }
+  }
+  void rotate(SkScalar degrees) override {
+    if (!failed_) {
+      receiver_.rotate(degrees);
+    }
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    if (!failed_) {
+      receiver_.skew(sx, sy);
+    }
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    if (!failed_) {
+      receiver_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+    }
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    if (!failed_) {
+      receiver_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                         myx, myy, myz, myt,
+                                         mzx, mzy, mzz, mzt,
+                                         mwx, mwy, mwz, mwt);
+    }
+  }
+  // clang-format on
+  void transformReset() override {
+    if (!failed_) {
+      receiver_.transformReset();
+    }
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    if (!failed_) {
+      receiver_.clipRect(rect, clip_op, is_aa);
+    }
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    if (!failed_) {
+      receiver_.clipRRect(rrect, clip_op, is_aa);
+    }
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    if (!failed_) {
+      receiver_.clipPath(path, clip_op, is_aa);
+    }
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override { failed_ = true; }
+  void drawPaint() override {
+    if (!failed_) {
+      receiver_.drawPaint();
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    if (!failed_) {
+      receiver_.drawLine(p0, p1);
+    }
+  }
+  void drawRect(const SkRect& rect) override {
+    if (!failed_) {
+      receiver_.drawRect(rect);
+    }
+  }
+  void drawRects(const SkRect rects[], uint32_t count) override {
+    if (!failed_) {
+      receiver_.drawRects(rects, count);
+    }
+  }
+  void drawOval(const SkRect& bounds) override {
+    if (!failed_) {
+      receiver_.drawOval(bounds);
+    }
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    if (!failed_) {
+      receiver_.drawCircle(center, radius);
+    }
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    if (!failed_) {
+      receiver_.drawRRect(rrect);
+    }
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    if (!failed_) {
+      receiver_.drawDRRect(outer, inner);
+    }
+  }
+  void drawPath(const SkPath& path) override {
+    if (!failed_) {
+      receiver_.drawPath(path);
+    }
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    if (!failed_) {
+      receiver_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+    }
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    if (!failed_) {
+      receiver_.drawPoints(mode, count, points);
+    }
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    if (!failed_) {
+      receiver_.drawVertices(vertices, mode);
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (!failed_ && Uses(render_with_attributes)) {
+      receiver_.drawImage(image, point, sampling, render_with_attributes);
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    if (!failed_ && Uses(render_with_attributes)) {
+      receiver_.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                              constraint);
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    if (!failed_ && Uses(render_with_attributes)) {
+      receiver_.drawImageNine(image, center, dst, filter,
+                              render_with_attributes);
+    }
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    if (!failed_ && Uses(render_with_attributes)) {
+      receiver_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                          cull_rect, render_with_attributes);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    failed_ = true;
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    if (!failed_) {
+      receiver_.drawTextBlob(blob, x, y);
+    }
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    if (!failed_) {
+      receiver_.drawTextFrame(text_frame, x, y);
+    }
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    failed_ = true;
+  }
+
+ private:
+  DlOpReceiver& receiver_;
+  bool failed_ = false;
+
+  // Returns true if an op that may ignore the paint uses it.
+  bool Uses(bool render_with_attributes) {
+    if (!render_with_attributes) {
+      failed_ = true;
+    }
+    return render_with_attributes;
+  }
+};
+
+}  // namespace
+
+sk_sp<DisplayList> FoldColorFilterIntoOps(
+    const sk_sp<DisplayList>& display_list,
+    const std::shared_ptr<const DlColorFilter>& filter) {
+  if (!display_list || !filter || filter->modifies_transparent_black() ||
+      !display_list->can_apply_group_opacity()) {
+    return nullptr;
+  }
+
+  DisplayListBuilder builder(display_list->bounds(),
+                             display_list->has_rtree());
+  DlOpReceiver& receiver = DisplayListBuilderFoldingAccessor(builder);
+  receiver.setColorFilter(filter.get());
+  DlColorFilterFolder folder(receiver);
+  display_list->Dispatch(folder);
+  if (folder.failed()) {
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_OP_FOLDER_H_
+#define FLUTTER_DISPLAY_LIST_DL_OP_FOLDER_H_
+
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Returns a copy of |display_list| that draws each of its ops
+///             with |filter|, or null if that would not render the same as
+///             drawing |display_list| into a layer that applies |filter|.
+///
+///             Filtering each op separately is only equivalent if no op
+///             draws over another one, every op draws with the SrcOver blend
+///             mode and its paint has no color filter of its own, which is
+///             what |DisplayList::can_apply_group_opacity| reports, and if
+///             |filter| leaves transparent black unchanged, so that the
+///             pixels around the ops stay untouched.
+///
+///             Lists containing ops that ignore the paint, such as
+///             |drawColor|, |drawShadow| and images drawn without
+///             attributes, as well as saveLayers and nested display lists,
+///             are not folded.
+sk_sp<DisplayList> FoldColorFilterIntoOps(
+    const sk_sp<DisplayList>& display_list,
+    const std::shared_ptr<const DlColorFilter>& filter);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_OP_FOLDER_H_
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_op_folder.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+TEST(DisplayListOpFolder, FilterIsFoldedIntoSeparateOps) {
+  const SkRect rect1 = SkRect::MakeLTRB(0, 0, 10, 10);
+  const SkRect rect2 = SkRect::MakeLTRB(20, 0, 30, 10);
+  DisplayListBuilder builder;
+  builder.DrawRect(rect1, DlPaint(DlColor::kRed()));
+  builder.DrawOval(rect2, DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(display_list->can_apply_group_opacity());
+
+  auto filter = DlMatrixColorFilter::Make(kRotateColorMatrix);
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& receiver = DisplayListBuilderTestingAccessor(expected_builder);
+  receiver.setColorFilter(filter.get());
+  receiver.setColor(DlColor::kRed());
+  receiver.drawRect(rect1);
+  receiver.setColor(DlColor::kBlue());
+  receiver.drawOval(rect2);
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> folded = FoldColorFilterIntoOps(display_list, filter);
+  ASSERT_NE(folded, nullptr);
+  EXPECT_EQ(folded->bounds(), display_list->bounds());
+  EXPECT_TRUE(folded->Equals(expected));
+}
+
+TEST(DisplayListOpFolder, OverlappingOpsAreNotFolded) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawRect(SkRect::MakeLTRB(5, 5, 15, 15), DlPaint(DlColor::kBlue()));
+  auto filter = DlMatrixColorFilter::Make(kRotateColorMatrix);
+  EXPECT_EQ(FoldColorFilterIntoOps(builder.Build(), filter), nullptr);
+}
+
+TEST(DisplayListOpFolder, FilterThatModifiesTransparentBlackIsNotFolded) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(DlColor::kRed()));
+  auto filter = DlBlendColorFilter::Make(DlColor::kGreen(), DlBlendMode::kSrc);
+  ASSERT_TRUE(filter->modifies_transparent_black());
+  EXPECT_EQ(FoldColorFilterIntoOps(builder.Build(), filter), nullptr);
+}
+
+TEST(DisplayListOpFolder, OpsThatIgnoreThePaintAreNotFolded) {
+  DisplayListBuilder builder;
+  builder.DrawColor(DlColor::kRed(), DlBlendMode::kSrcOver);
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(display_list->can_apply_group_opacity());
+  auto filter = DlMatrixColorFilter::Make(kRotateColorMatrix);
+  EXPECT_EQ(FoldColorFilterIntoOps(display_list, filter), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -214,6 +214,14 @@ class DlOpReceiver {
   virtual void drawPaint() = 0;
   virtual void drawLine(const SkPoint& p0, const SkPoint& p1) = 0;
   virtual void drawRect(const SkRect& rect) = 0;
+  // Renders each of the |count| rects as if by |drawRect|, in order. The
+  // default implementation does exactly that and receivers that can render
+  // a batch of rects more efficiently may override it.
+  virtual void drawRects(const SkRect rects[], uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+      drawRect(rects[i]);
+    }
+  }
   virtual void drawOval(const SkRect& bounds) = 0;
   virtual void drawCircle(const SkPoint& center, SkScalar radius) = 0;
   virtual void drawRRect(const SkRRect& rrect) = 0;
@@ -10,6 +10,7 @@
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/macros.h"
 
 #include "impeller/typographer/text_frame.h"
@@ -80,6 +81,28 @@ enum class DisplayListCompare {
   kEqual,
 };
 
+// Hashes the fill type, verbs, points and conic weights of a path, which
+// are what SkPath::operator== compares. The bytes of an SkPath are only a
+// reference to shared point data and some lazily computed attributes.
+inline uint64_t HashPath(const SkPath& path, uint64_t seed) {
+  // The number of points returned by SkPath::Iter::next for each verb.
+  static constexpr size_t kPointCounts[] = {1, 2, 3, 3, 4, 0};
+  const SkPathFillType fill_type = path.getFillType();
+  uint64_t hash = fml::HashBytes(&fill_type, sizeof(fill_type), seed);
+  SkPath::Iter iterator(path, false);
+  SkPoint points[4];
+  for (auto verb = iterator.next(points); verb != SkPath::kDone_Verb;
+       verb = iterator.next(points)) {
+    hash = fml::HashBytes(points, kPointCounts[verb] * sizeof(SkPoint),
+                          hash + verb);
+    if (verb == SkPath::kConic_Verb) {
+      const SkScalar weight = iterator.conicWeight();
+      hash = fml::HashBytes(&weight, sizeof(weight), hash);
+    }
+  }
+  return hash;
+}
+
 // "DLOpPackLabel" is just a label for the pack pragma so it can be popped
 // later.
 #pragma pack(push, DLOpPackLabel, 8)
@@ -101,6 +124,13 @@ struct DLOp {
   DisplayListCompare equals(const DLOp* other) const {
     return DisplayListCompare::kUseBulkCompare;
   }
+
+  // Most Ops hash the same bytes that they bulk compare, including the
+  // addresses of any images or effects they reference. An Op that compares
+  // paths or nested display lists by content hashes that content instead.
+  uint64_t hash(uint64_t seed) const {
+    return fml::HashBytes(this, size, seed);
+  }
 };
 
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
@@ -621,6 +651,11 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
       return is_aa == other->is_aa && path == other->path                \
                  ? DisplayListCompare::kEqual                            \
                  : DisplayListCompare::kNotEqual;                        \
+    }                                                                    \
+                                                                         \
+    uint64_t hash(uint64_t seed) const {                                 \
+      seed = fml::HashBytes(&is_aa, sizeof(is_aa), seed);                \
+      return HashPath(path, seed);                                       \
     }                                                                    \
   };
 DEFINE_CLIP_PATH_OP(Intersect)
@@ -705,6 +740,8 @@ struct DrawPathOp final : DrawOpBase {
     return path == other->path ? DisplayListCompare::kEqual
                                : DisplayListCompare::kNotEqual;
   }
+
+  uint64_t hash(uint64_t seed) const { return HashPath(path, seed); }
 };
 
 // The common data is a 4 byte header with an unused 4 bytes
@@ -779,6 +816,23 @@ DEFINE_DRAW_POINTS_OP(Lines, kLines);
 DEFINE_DRAW_POINTS_OP(Polygon, kPolygon);
 #undef DEFINE_DRAW_POINTS_OP
 
+// 4 byte header + 4 byte payload packs efficiently into 8 bytes
+// The rects are pod-allocated after this structure
+struct DrawRectsOp final : DrawOpBase {
+  static const auto kType = DisplayListOpType::kDrawRects;
+
+  explicit DrawRectsOp(uint32_t count) : count(count) {}
+
+  const uint32_t count;
+
+  void dispatch(DispatchContext& ctx) const {
+    if (op_needed(ctx)) {
+      const SkRect* rects = reinterpret_cast<const SkRect*>(this + 1);
+      ctx.receiver.drawRects(rects, count);
+    }
+  }
+};
+
 // 4 byte header + 4 byte payload packs efficiently into 8 bytes
 // The DlVertices object will be pod-allocated after this structure
 // and can take any number of bytes so the final efficiency will
@@ -1065,6 +1119,11 @@ struct DrawDisplayListOp final : DrawOpBase {
                ? DisplayListCompare::kEqual
                : DisplayListCompare::kNotEqual;
   }
+
+  uint64_t hash(uint64_t seed) const {
+    return fml::HashBytes(&opacity, sizeof(opacity),
+                          seed ^ display_list->content_hash());
+  }
 };
 
 // 4 byte header + 8 payload bytes + an aligned pointer take 24 bytes
@@ -1126,6 +1185,19 @@ struct DrawTextFrameOp final : DrawOpBase {
         ctx.receiver.drawShadow(path, color, elevation, transparent_occluder, \
                                 dpr);                                         \
       }                                                                       \
+    }                                                                         \
+                                                                              \
+    DisplayListCompare equals(const Draw##name##Op* other) const {            \
+      return color == other->color && elevation == other->elevation &&        \
+                     dpr == other->dpr && path == other->path                 \
+                 ? DisplayListCompare::kEqual                                 \
+                 : DisplayListCompare::kNotEqual;                             \
+    }                                                                         \
+                                                                              \
+    uint64_t hash(uint64_t seed) const {                                      \
+      const SkScalar values[] = {elevation, dpr};                             \
+      seed = fml::HashBytes(&color, sizeof(color), seed);                     \
+      return HashPath(path, fml::HashBytes(values, sizeof(values), seed));    \
     }                                                                         \
   };
 DEFINE_DRAW_SHADOW_OP(Shadow, false)
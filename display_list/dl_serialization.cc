@@ -0,0 +1,1647 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderSerializationAccessor(
+    DisplayListBuilder& builder) {
+  return builder.asReceiver();
+}
+
+namespace {
+
+// The format is a header followed by a sequence of records, each of which is
+// a |SerializedOp| tag followed by its arguments. Every field is a multiple of
+// 4 bytes wide and variable sized data is padded to a multiple of 4 bytes, so
+// that arrays of points, rects and colors can be handed to the builder in
+// place as long as the data starts on a 4 byte boundary.
+//
+// The tag values and the layout of each record are part of the format.
+// Changing either requires bumping |kFormatVersion|.
+
+// "FLDL" in memory on a little endian host.
+constexpr uint32_t kFormatMagic = 0x4c444c46u;
+constexpr uint32_t kFormatVersion = 3u;
+
+constexpr uint32_t kHeaderFlagHasRTree = 1u << 0;
+
+// Bounds the recursion of nested display lists and filters in malformed data.
+constexpr int kMaxNestingDepth = 64;
+
+enum class SerializedOp : uint32_t {
+  kEnd = 0,
+
+  kSetAntiAlias = 1,
+  kSetDither = 2,
+  kSetDrawStyle = 3,
+  kSetColor = 4,
+  kSetStrokeWidth = 5,
+  kSetStrokeMiter = 6,
+  kSetStrokeCap = 7,
+  kSetStrokeJoin = 8,
+  kSetColorSource = 9,
+  kSetColorFilter = 10,
+  kSetInvertColors = 11,
+  kSetBlendMode = 12,
+  kSetPathEffect = 13,
+  kSetMaskFilter = 14,
+  kSetImageFilter = 15,
+
+  kSave = 16,
+  kSaveLayer = 17,
+  kRestore = 18,
+
+  kTranslate = 19,
+  kScale = 20,
+  kRotate = 21,
+  kSkew = 22,
+  kTransform2DAffine = 23,
+  kTransformFullPerspective = 24,
+  kTransformReset = 25,
+
+  kClipRect = 26,
+  kClipRRect = 27,
+  kClipPath = 28,
+
+  kDrawColor = 29,
+  kDrawPaint = 30,
+  kDrawLine = 31,
+  kDrawRect = 32,
+  kDrawOval = 33,
+  kDrawCircle = 34,
+  kDrawRRect = 35,
+  kDrawDRRect = 36,
+  kDrawPath = 37,
+  kDrawArc = 38,
+  kDrawPoints = 39,
+  kDrawVertices = 40,
+  kDrawImage = 41,
+  kDrawImageRect = 42,
+  kDrawImageNine = 43,
+  kDrawAtlas = 44,
+  kDrawDisplayList = 45,
+  kDrawShadow = 46,
+  kDrawRects = 47,
+  kDrawTextBlob = 48,
+};
+
+// Writer ----------------------------------------------------------------------
+
+class Writer {
+ public:
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % 4 == 0, "Fields must keep 4 byte alignment.");
+    Append(&value, sizeof(T));
+  }
+
+  void WriteBool(bool value) { Write<uint32_t>(value ? 1u : 0u); }
+
+  template <typename E>
+  void WriteEnum(E value) {
+    static_assert(std::is_enum_v<E>);
+    Write<uint32_t>(static_cast<uint32_t>(value));
+  }
+
+  void WriteOp(SerializedOp op) { WriteEnum(op); }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % 4 == 0, "Fields must keep 4 byte alignment.");
+    Append(values, count * sizeof(T));
+  }
+
+  // Writes a size prefixed run of bytes padded to keep 4 byte alignment.
+  void WriteBlob(const void* data, size_t size) {
+    Write<uint32_t>(static_cast<uint32_t>(size));
+    Append(data, size);
+    data_.resize((data_.size() + 3u) & ~size_t{3u}, 0u);
+  }
+
+  void WriteMatrix(const SkMatrix& matrix) {
+    SkScalar values[9];
+    matrix.get9(values);
+    WriteArray(values, 9);
+  }
+
+  void WriteOptionalMatrix(const SkMatrix* matrix) {
+    WriteBool(matrix != nullptr);
+    if (matrix) {
+      WriteMatrix(*matrix);
+    }
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t buffer[SkRRect::kSizeInMemory];
+    static_assert(sizeof(buffer) % 4 == 0);
+    rrect.writeToMemory(buffer);
+    Append(buffer, sizeof(buffer));
+  }
+
+  void WritePath(const SkPath& path) {
+    std::vector<uint8_t> buffer(path.writeToMemory(nullptr));
+    path.writeToMemory(buffer.data());
+    WriteBlob(buffer.data(), buffer.size());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+
+  void Append(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+  }
+};
+
+// Reader ----------------------------------------------------------------------
+
+// Reads fields in place. Every accessor reports failure through |ok()| rather
+// than individually, so that records can be decoded without checking each
+// field and validated once before they are replayed.
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : cursor_(data), end_(data + size) {
+    FML_DCHECK(reinterpret_cast<uintptr_t>(data) % 4 == 0);
+  }
+
+  bool ok() const { return error_.empty(); }
+
+  bool at_end() const { return cursor_ == end_; }
+
+  const std::string& error() const { return error_; }
+
+  void Fail(const std::string& error) {
+    if (error_.empty()) {
+      error_ = error;
+    }
+    cursor_ = end_;
+  }
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (const void* data = Consume(sizeof(T))) {
+      memcpy(&value, data, sizeof(T));
+    }
+    return value;
+  }
+
+  bool ReadBool() { return Read<uint32_t>() != 0u; }
+
+  template <typename E>
+  E ReadEnum(E last) {
+    static_assert(std::is_enum_v<E>);
+    const uint32_t value = Read<uint32_t>();
+    if (value > static_cast<uint32_t>(last)) {
+      Fail("Invalid enum value.");
+      return static_cast<E>(0);
+    }
+    return static_cast<E>(value);
+  }
+
+  // Returns |count| values in place, or nullptr if there are not enough left.
+  template <typename T>
+  const T* ReadArray(size_t count) {
+    static_assert(alignof(T) <= 4);
+    if (count > static_cast<size_t>(end_ - cursor_) / sizeof(T)) {
+      Fail("Array extends past the end of the data.");
+      return nullptr;
+    }
+    return reinterpret_cast<const T*>(Consume(count * sizeof(T)));
+  }
+
+  const uint8_t* ReadBlob(size_t* size) {
+    *size = Read<uint32_t>();
+    const uint8_t* data = ReadArray<uint8_t>(*size);
+    // Skip the padding.
+    Consume(((*size + 3u) & ~size_t{3u}) - *size);
+    return data;
+  }
+
+  SkMatrix ReadMatrix() {
+    const SkScalar* values = ReadArray<SkScalar>(9);
+    SkMatrix matrix;
+    if (values) {
+      matrix.set9(values);
+    }
+    return matrix;
+  }
+
+  std::optional<SkMatrix> ReadOptionalMatrix() {
+    if (!ReadBool()) {
+      return std::nullopt;
+    }
+    return ReadMatrix();
+  }
+
+  SkRRect ReadRRect() {
+    SkRRect rrect;
+    const uint8_t* data = ReadArray<uint8_t>(SkRRect::kSizeInMemory);
+    if (data && rrect.readFromMemory(data, SkRRect::kSizeInMemory) == 0) {
+      Fail("Invalid round rect.");
+    }
+    return rrect;
+  }
+
+  SkPath ReadPath() {
+    SkPath path;
+    size_t size = 0;
+    const uint8_t* data = ReadBlob(&size);
+    if (data && path.readFromMemory(data, size) != size) {
+      Fail("Invalid path.");
+    }
+    return path;
+  }
+
+ private:
+  const uint8_t* cursor_;
+  const uint8_t* end_;
+  std::string error_;
+
+  const void* Consume(size_t size) {
+    if (!ok()) {
+      return nullptr;
+    }
+    if (size > static_cast<size_t>(end_ - cursor_)) {
+      Fail("Unexpected end of data.");
+      return nullptr;
+    }
+    const uint8_t* data = cursor_;
+    cursor_ += size;
+    return data;
+  }
+};
+
+// Attributes ------------------------------------------------------------------
+
+void WriteGradient(Writer& writer, const DlGradientColorSourceBase* gradient) {
+  writer.Write<uint32_t>(gradient->stop_count());
+  writer.WriteArray(gradient->colors(), gradient->stop_count());
+  writer.WriteArray(gradient->stops(), gradient->stop_count());
+  writer.WriteEnum(gradient->tile_mode());
+  writer.WriteOptionalMatrix(gradient->matrix_ptr());
+}
+
+void WriteColorFilter(Writer& writer, const DlColorFilter* filter) {
+  writer.WriteBool(filter != nullptr);
+  if (!filter) {
+    return;
+  }
+  writer.WriteEnum(filter->type());
+  switch (filter->type()) {
+    case DlColorFilterType::kBlend: {
+      const DlBlendColorFilter* blend = filter->asBlend();
+      writer.Write(blend->color());
+      writer.WriteEnum(blend->mode());
+      break;
+    }
+    case DlColorFilterType::kMatrix: {
+      float matrix[20];
+      filter->asMatrix()->get_matrix(matrix);
+      writer.WriteArray(matrix, 20);
+      break;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+    case DlColorFilterType::kLinearToSrgbGamma:
+      break;
+  }
+}
+
+void WriteImageFilter(Writer& writer, const DlImageFilter* filter) {
+  writer.WriteBool(filter != nullptr);
+  if (!filter) {
+    return;
+  }
+  writer.WriteEnum(filter->type());
+  switch (filter->type()) {
+    case DlImageFilterType::kBlur: {
+      const DlBlurImageFilter* blur = filter->asBlur();
+      writer.Write(blur->sigma_x());
+      writer.Write(blur->sigma_y());
+      writer.WriteEnum(blur->tile_mode());
+      break;
+    }
+    case DlImageFilterType::kDilate: {
+      const DlDilateImageFilter* dilate = filter->asDilate();
+      writer.Write(dilate->radius_x());
+      writer.Write(dilate->radius_y());
+      break;
+    }
+    case DlImageFilterType::kErode: {
+      const DlErodeImageFilter* erode = filter->asErode();
+      writer.Write(erode->radius_x());
+      writer.Write(erode->radius_y());
+      break;
+    }
+    case DlImageFilterType::kMatrix: {
+      const DlMatrixImageFilter* matrix = filter->asMatrix();
+      writer.WriteMatrix(matrix->matrix());
+      writer.WriteEnum(matrix->sampling());
+      break;
+    }
+    case DlImageFilterType::kCompose: {
+      const DlComposeImageFilter* compose = filter->asCompose();
+      WriteImageFilter(writer, compose->outer().get());
+      WriteImageFilter(writer, compose->inner().get());
+      break;
+    }
+    case DlImageFilterType::kColorFilter:
+      WriteColorFilter(writer, filter->asColorFilter()->color_filter().get());
+      break;
+    case DlImageFilterType::kLocalMatrix: {
+      const DlLocalMatrixImageFilter* local = filter->asLocalMatrix();
+      writer.WriteMatrix(local->matrix());
+      WriteImageFilter(writer, local->image_filter().get());
+      break;
+    }
+  }
+}
+
+std::shared_ptr<DlColorFilter> ReadColorFilter(Reader& reader) {
+  if (!reader.ReadBool()) {
+    return nullptr;
+  }
+  switch (reader.ReadEnum(DlColorFilterType::kLinearToSrgbGamma)) {
+    case DlColorFilterType::kBlend: {
+      const DlColor color = reader.Read<DlColor>();
+      const DlBlendMode mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      return std::make_shared<DlBlendColorFilter>(color, mode);
+    }
+    case DlColorFilterType::kMatrix: {
+      const float* matrix = reader.ReadArray<float>(20);
+      if (!matrix) {
+        return nullptr;
+      }
+      return std::make_shared<DlMatrixColorFilter>(matrix);
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+      return DlSrgbToLinearGammaColorFilter::kInstance;
+    case DlColorFilterType::kLinearToSrgbGamma:
+      return DlLinearToSrgbGammaColorFilter::kInstance;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<DlImageFilter> ReadImageFilter(Reader& reader, int depth) {
+  if (!reader.ReadBool()) {
+    return nullptr;
+  }
+  if (depth > kMaxNestingDepth) {
+    reader.Fail("Image filters are nested too deeply.");
+    return nullptr;
+  }
+  switch (reader.ReadEnum(DlImageFilterType::kLocalMatrix)) {
+    case DlImageFilterType::kBlur: {
+      const SkScalar sigma_x = reader.Read<SkScalar>();
+      const SkScalar sigma_y = reader.Read<SkScalar>();
+      const DlTileMode tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+      return std::make_shared<DlBlurImageFilter>(sigma_x, sigma_y, tile_mode);
+    }
+    case DlImageFilterType::kDilate: {
+      const SkScalar radius_x = reader.Read<SkScalar>();
+      const SkScalar radius_y = reader.Read<SkScalar>();
+      return std::make_shared<DlDilateImageFilter>(radius_x, radius_y);
+    }
+    case DlImageFilterType::kErode: {
+      const SkScalar radius_x = reader.Read<SkScalar>();
+      const SkScalar radius_y = reader.Read<SkScalar>();
+      return std::make_shared<DlErodeImageFilter>(radius_x, radius_y);
+    }
+    case DlImageFilterType::kMatrix: {
+      const SkMatrix matrix = reader.ReadMatrix();
+      const DlImageSampling sampling =
+          reader.ReadEnum(DlImageSampling::kCubic);
+      return std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+    }
+    case DlImageFilterType::kCompose: {
+      auto outer = ReadImageFilter(reader, depth + 1);
+      auto inner = ReadImageFilter(reader, depth + 1);
+      if (!outer || !inner) {
+        reader.Fail("Compose image filters need two filters.");
+        return nullptr;
+      }
+      return std::make_shared<DlComposeImageFilter>(std::move(outer),
+                                                    std::move(inner));
+    }
+    case DlImageFilterType::kColorFilter:
+      return DlColorFilterImageFilter::Make(ReadColorFilter(reader));
+    case DlImageFilterType::kLocalMatrix: {
+      const SkMatrix matrix = reader.ReadMatrix();
+      auto filter = ReadImageFilter(reader, depth + 1);
+      return std::make_shared<DlLocalMatrixImageFilter>(matrix,
+                                                        std::move(filter));
+    }
+  }
+  return nullptr;
+}
+
+// Serialization ---------------------------------------------------------------
+
+bool SerializeInto(Writer& writer,
+                   const DisplayList& display_list,
+                   const DlImageEncoder& image_encoder,
+                   int depth,
+                   std::string* error);
+
+class SerializingReceiver final : public DlOpReceiver {
+ public:
+  SerializingReceiver(Writer& writer,
+                      const DlImageEncoder& image_encoder,
+                      int depth)
+      : writer_(writer), image_encoder_(image_encoder), depth_(depth) {}
+
+  bool ok() const { return error_.empty(); }
+
+  const std::string& error() const { return error_; }
+
+  // |DlOpReceiver|
+  void setAntiAlias(bool aa) override {
+    writer_.WriteOp(SerializedOp::kSetAntiAlias);
+    writer_.WriteBool(aa);
+  }
+
+  // |DlOpReceiver|
+  void setDither(bool dither) override {
+    writer_.WriteOp(SerializedOp::kSetDither);
+    writer_.WriteBool(dither);
+  }
+
+  // |DlOpReceiver|
+  void setDrawStyle(DlDrawStyle style) override {
+    writer_.WriteOp(SerializedOp::kSetDrawStyle);
+    writer_.WriteEnum(style);
+  }
+
+  // |DlOpReceiver|
+  void setColor(DlColor color) override {
+    writer_.WriteOp(SerializedOp::kSetColor);
+    writer_.Write(color);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeWidth(float width) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeWidth);
+    writer_.Write(width);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeMiter(float limit) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeMiter);
+    writer_.Write(limit);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeCap(DlStrokeCap cap) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeCap);
+    writer_.WriteEnum(cap);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeJoin(DlStrokeJoin join) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeJoin);
+    writer_.WriteEnum(join);
+  }
+
+  // |DlOpReceiver|
+  void setColorSource(const DlColorSource* source) override {
+    writer_.WriteOp(SerializedOp::kSetColorSource);
+    writer_.WriteBool(source != nullptr);
+    if (!source) {
+      return;
+    }
+    writer_.WriteEnum(source->type());
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        writer_.Write(source->asColor()->color());
+        break;
+      case DlColorSourceType::kImage: {
+        const DlImageColorSource* image = source->asImage();
+        WriteImage(sk_ref_sp(const_cast<DlImage*>(image->image().get())));
+        writer_.WriteEnum(image->horizontal_tile_mode());
+        writer_.WriteEnum(image->vertical_tile_mode());
+        writer_.WriteEnum(image->sampling());
+        writer_.WriteOptionalMatrix(image->matrix_ptr());
+        break;
+      }
+      case DlColorSourceType::kLinearGradient: {
+        const DlLinearGradientColorSource* linear = source->asLinearGradient();
+        writer_.Write(linear->start_point());
+        writer_.Write(linear->end_point());
+        WriteGradient(writer_, linear);
+        break;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        const DlRadialGradientColorSource* radial = source->asRadialGradient();
+        writer_.Write(radial->center());
+        writer_.Write(radial->radius());
+        WriteGradient(writer_, radial);
+        break;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        const DlConicalGradientColorSource* conical =
+            source->asConicalGradient();
+        writer_.Write(conical->start_center());
+        writer_.Write(conical->start_radius());
+        writer_.Write(conical->end_center());
+        writer_.Write(conical->end_radius());
+        WriteGradient(writer_, conical);
+        break;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        const DlSweepGradientColorSource* sweep = source->asSweepGradient();
+        writer_.Write(sweep->center());
+        writer_.Write(sweep->start());
+        writer_.Write(sweep->end());
+        WriteGradient(writer_, sweep);
+        break;
+      }
+      case DlColorSourceType::kRuntimeEffect:
+        Fail("Runtime effect color sources cannot be serialized.");
+        break;
+#ifdef IMPELLER_ENABLE_3D
+      case DlColorSourceType::kScene:
+        Fail("Scene color sources cannot be serialized.");
+        break;
+#endif  // IMPELLER_ENABLE_3D
+    }
+  }
+
+  // |DlOpReceiver|
+  void setColorFilter(const DlColorFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetColorFilter);
+    WriteColorFilter(writer_, filter);
+  }
+
+  // |DlOpReceiver|
+  void setInvertColors(bool invert) override {
+    writer_.WriteOp(SerializedOp::kSetInvertColors);
+    writer_.WriteBool(invert);
+  }
+
+  // |DlOpReceiver|
+  void setBlendMode(DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kSetBlendMode);
+    writer_.WriteEnum(mode);
+  }
+
+  // |DlOpReceiver|
+  void setPathEffect(const DlPathEffect* effect) override {
+    writer_.WriteOp(SerializedOp::kSetPathEffect);
+    writer_.WriteBool(effect != nullptr);
+    if (!effect) {
+      return;
+    }
+    const DlDashPathEffect* dash = effect->asDash();
+    FML_DCHECK(dash);
+    writer_.Write<uint32_t>(dash->count());
+    writer_.WriteArray(dash->intervals(), dash->count());
+    writer_.Write(dash->phase());
+  }
+
+  // |DlOpReceiver|
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetMaskFilter);
+    writer_.WriteBool(filter != nullptr);
+    if (!filter) {
+      return;
+    }
+    const DlBlurMaskFilter* blur = filter->asBlur();
+    FML_DCHECK(blur);
+    writer_.WriteEnum(blur->style());
+    writer_.Write(blur->sigma());
+    writer_.WriteBool(blur->respectCTM());
+  }
+
+  // |DlOpReceiver|
+  void setImageFilter(const DlImageFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetImageFilter);
+    WriteImageFilter(writer_, filter);
+  }
+
+  // |DlOpReceiver|
+  void save() override { writer_.WriteOp(SerializedOp::kSave); }
+
+  // |DlOpReceiver|
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    writer_.WriteOp(SerializedOp::kSaveLayer);
+    writer_.WriteBool(bounds != nullptr);
+    if (bounds) {
+      writer_.Write(*bounds);
+    }
+    // The other options are optimizations the builder recomputes.
+    writer_.WriteBool(options.renders_with_attributes());
+    WriteImageFilter(writer_, backdrop);
+  }
+
+  // |DlOpReceiver|
+  void restore() override { writer_.WriteOp(SerializedOp::kRestore); }
+
+  // |DlOpReceiver|
+  void translate(SkScalar tx, SkScalar ty) override {
+    writer_.WriteOp(SerializedOp::kTranslate);
+    writer_.Write(tx);
+    writer_.Write(ty);
+  }
+
+  // |DlOpReceiver|
+  void scale(SkScalar sx, SkScalar sy) override {
+    writer_.WriteOp(SerializedOp::kScale);
+    writer_.Write(sx);
+    writer_.Write(sy);
+  }
+
+  // |DlOpReceiver|
+  void rotate(SkScalar degrees) override {
+    writer_.WriteOp(SerializedOp::kRotate);
+    writer_.Write(degrees);
+  }
+
+  // |DlOpReceiver|
+  void skew(SkScalar sx, SkScalar sy) override {
+    writer_.WriteOp(SerializedOp::kSkew);
+    writer_.Write(sx);
+    writer_.Write(sy);
+  }
+
+  // clang-format off
+  // |DlOpReceiver|
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    const SkScalar values[] = {mxx, mxy, mxt,
+                               myx, myy, myt};
+    writer_.WriteOp(SerializedOp::kTransform2DAffine);
+    writer_.WriteArray(values, 6);
+  }
+
+  // |DlOpReceiver|
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    const SkScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    writer_.WriteOp(SerializedOp::kTransformFullPerspective);
+    writer_.WriteArray(values, 16);
+  }
+  // clang-format on
+
+  // |DlOpReceiver|
+  void transformReset() override {
+    writer_.WriteOp(SerializedOp::kTransformReset);
+  }
+
+  // |DlOpReceiver|
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipRect);
+    writer_.Write(rect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+
+  // |DlOpReceiver|
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipRRect);
+    writer_.WriteRRect(rrect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+
+  // |DlOpReceiver|
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipPath);
+    writer_.WritePath(path);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+
+  // |DlOpReceiver|
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kDrawColor);
+    writer_.Write(color);
+    writer_.WriteEnum(mode);
+  }
+
+  // |DlOpReceiver|
+  void drawPaint() override { writer_.WriteOp(SerializedOp::kDrawPaint); }
+
+  // |DlOpReceiver|
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    writer_.WriteOp(SerializedOp::kDrawLine);
+    writer_.Write(p0);
+    writer_.Write(p1);
+  }
+
+  // |DlOpReceiver|
+  void drawRect(const SkRect& rect) override {
+    writer_.WriteOp(SerializedOp::kDrawRect);
+    writer_.Write(rect);
+  }
+
+  // |DlOpReceiver|
+  void drawRects(const SkRect rects[], uint32_t count) override {
+    writer_.WriteOp(SerializedOp::kDrawRects);
+    writer_.Write(count);
+    writer_.WriteArray(rects, count);
+  }
+
+  // |DlOpReceiver|
+  void drawOval(const SkRect& bounds) override {
+    writer_.WriteOp(SerializedOp::kDrawOval);
+    writer_.Write(bounds);
+  }
+
+  // |DlOpReceiver|
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    writer_.WriteOp(SerializedOp::kDrawCircle);
+    writer_.Write(center);
+    writer_.Write(radius);
+  }
+
+  // |DlOpReceiver|
+  void drawRRect(const SkRRect& rrect) override {
+    writer_.WriteOp(SerializedOp::kDrawRRect);
+    writer_.WriteRRect(rrect);
+  }
+
+  // |DlOpReceiver|
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    writer_.WriteOp(SerializedOp::kDrawDRRect);
+    writer_.WriteRRect(outer);
+    writer_.WriteRRect(inner);
+  }
+
+  // |DlOpReceiver|
+  void drawPath(const SkPath& path) override {
+    writer_.WriteOp(SerializedOp::kDrawPath);
+    writer_.WritePath(path);
+  }
+
+  // |DlOpReceiver|
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    writer_.WriteOp(SerializedOp::kDrawArc);
+    writer_.Write(oval_bounds);
+    writer_.Write(start_degrees);
+    writer_.Write(sweep_degrees);
+    writer_.WriteBool(use_center);
+  }
+
+  // |DlOpReceiver|
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    writer_.WriteOp(SerializedOp::kDrawPoints);
+    writer_.WriteEnum(mode);
+    writer_.Write(count);
+    writer_.WriteArray(points, count);
+  }
+
+  // |DlOpReceiver|
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kDrawVertices);
+    writer_.WriteEnum(vertices->mode());
+    writer_.Write<uint32_t>(vertices->vertex_count());
+    writer_.WriteArray(vertices->vertices(), vertices->vertex_count());
+    writer_.WriteBool(vertices->texture_coordinates() != nullptr);
+    if (vertices->texture_coordinates()) {
+      writer_.WriteArray(vertices->texture_coordinates(),
+                         vertices->vertex_count());
+    }
+    writer_.WriteBool(vertices->colors() != nullptr);
+    if (vertices->colors()) {
+      writer_.WriteArray(vertices->colors(), vertices->vertex_count());
+    }
+    const int index_count = vertices->indices() ? vertices->index_count() : 0;
+    writer_.WriteBlob(vertices->indices(), index_count * sizeof(uint16_t));
+    writer_.WriteEnum(mode);
+  }
+
+  // |DlOpReceiver|
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawImage);
+    WriteImage(image);
+    writer_.Write(point);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    writer_.WriteOp(SerializedOp::kDrawImageRect);
+    WriteImage(image);
+    writer_.Write(src);
+    writer_.Write(dst);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+    writer_.WriteEnum(constraint);
+  }
+
+  // |DlOpReceiver|
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawImageNine);
+    WriteImage(image);
+    writer_.Write(center);
+    writer_.Write(dst);
+    writer_.WriteEnum(filter);
+    writer_.WriteBool(render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawAtlas);
+    WriteImage(atlas);
+    writer_.Write<uint32_t>(count);
+    writer_.WriteArray(xform, count);
+    writer_.WriteArray(tex, count);
+    writer_.WriteBool(colors != nullptr);
+    if (colors) {
+      writer_.WriteArray(colors, count);
+    }
+    writer_.WriteEnum(mode);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(cull_rect != nullptr);
+    if (cull_rect) {
+      writer_.Write(*cull_rect);
+    }
+    writer_.WriteBool(render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    writer_.WriteOp(SerializedOp::kDrawDisplayList);
+    writer_.Write(opacity);
+    if (depth_ >= kMaxNestingDepth) {
+      Fail("Display lists are nested too deeply.");
+      return;
+    }
+    Writer nested;
+    std::string error;
+    if (!SerializeInto(nested, *display_list, image_encoder_, depth_ + 1,
+                       &error)) {
+      Fail(error);
+      return;
+    }
+    const std::vector<uint8_t> data = nested.TakeData();
+    writer_.WriteBlob(data.data(), data.size());
+  }
+
+  // |DlOpReceiver|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    writer_.WriteOp(SerializedOp::kDrawTextBlob);
+    writer_.Write(x);
+    writer_.Write(y);
+    sk_sp<SkData> data = blob->serialize(SkSerialProcs());
+    if (!data) {
+      Fail("A text blob could not be serialized.");
+      writer_.WriteBlob(nullptr, 0);
+      return;
+    }
+    writer_.WriteBlob(data->data(), data->size());
+  }
+
+  // |DlOpReceiver|
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    Fail("Text frames cannot be serialized.");
+  }
+
+  // |DlOpReceiver|
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    writer_.WriteOp(SerializedOp::kDrawShadow);
+    writer_.WritePath(path);
+    writer_.Write(color);
+    writer_.Write(elevation);
+    writer_.WriteBool(transparent_occluder);
+    writer_.Write(dpr);
+  }
+
+ private:
+  Writer& writer_;
+  const DlImageEncoder& image_encoder_;
+  const int depth_;
+  std::string error_;
+
+  void Fail(const std::string& error) {
+    if (error_.empty()) {
+      error_ = error;
+    }
+  }
+
+  void WriteImage(const sk_sp<DlImage>& image) {
+    std::optional<uint64_t> id;
+    if (image && image_encoder_) {
+      id = image_encoder_(image);
+    }
+    if (!id.has_value()) {
+      Fail("An image could not be encoded.");
+    }
+    writer_.Write(id.value_or(0u));
+  }
+};
+
+bool SerializeInto(Writer& writer,
+                   const DisplayList& display_list,
+                   const DlImageEncoder& image_encoder,
+                   int depth,
+                   std::string* error) {
+  writer.Write(kFormatMagic);
+  writer.Write(kFormatVersion);
+  writer.Write<uint32_t>(display_list.has_rtree() ? kHeaderFlagHasRTree : 0u);
+
+  SerializingReceiver receiver(writer, image_encoder, depth);
+  display_list.Dispatch(receiver);
+  writer.WriteOp(SerializedOp::kEnd);
+
+  if (!receiver.ok()) {
+    if (error) {
+      *error = receiver.error();
+    }
+    return false;
+  }
+  return true;
+}
+
+// Deserialization -------------------------------------------------------------
+
+sk_sp<DisplayList> DeserializeFrom(Reader& reader,
+                                   const DlImageResolver& image_resolver,
+                                   int depth);
+
+sk_sp<DlImage> ReadImage(Reader& reader,
+                         const DlImageResolver& image_resolver) {
+  const uint64_t id = reader.Read<uint64_t>();
+  if (!reader.ok()) {
+    return nullptr;
+  }
+  sk_sp<DlImage> image = image_resolver ? image_resolver(id) : nullptr;
+  if (!image) {
+    reader.Fail("An image could not be resolved.");
+  }
+  return image;
+}
+
+std::shared_ptr<DlColorSource> ReadColorSource(
+    Reader& reader,
+    const DlImageResolver& image_resolver) {
+  if (!reader.ReadBool()) {
+    return nullptr;
+  }
+  const auto type = reader.ReadEnum(DlColorSourceType::kSweepGradient);
+  if (type == DlColorSourceType::kColor) {
+    return std::make_shared<DlColorColorSource>(reader.Read<DlColor>());
+  }
+  if (type == DlColorSourceType::kImage) {
+    sk_sp<DlImage> image = ReadImage(reader, image_resolver);
+    const DlTileMode horizontal = reader.ReadEnum(DlTileMode::kDecal);
+    const DlTileMode vertical = reader.ReadEnum(DlTileMode::kDecal);
+    const DlImageSampling sampling = reader.ReadEnum(DlImageSampling::kCubic);
+    const std::optional<SkMatrix> matrix = reader.ReadOptionalMatrix();
+    if (!reader.ok()) {
+      return nullptr;
+    }
+    return std::make_shared<DlImageColorSource>(
+        std::move(image), horizontal, vertical, sampling,
+        matrix ? &matrix.value() : nullptr);
+  }
+
+  // The geometry precedes the parameters shared by all gradients.
+  SkPoint points[2] = {};
+  SkScalar scalars[2] = {};
+  switch (type) {
+    case DlColorSourceType::kLinearGradient:
+      points[0] = reader.Read<SkPoint>();
+      points[1] = reader.Read<SkPoint>();
+      break;
+    case DlColorSourceType::kRadialGradient:
+      points[0] = reader.Read<SkPoint>();
+      scalars[0] = reader.Read<SkScalar>();
+      break;
+    case DlColorSourceType::kConicalGradient:
+      points[0] = reader.Read<SkPoint>();
+      scalars[0] = reader.Read<SkScalar>();
+      points[1] = reader.Read<SkPoint>();
+      scalars[1] = reader.Read<SkScalar>();
+      break;
+    case DlColorSourceType::kSweepGradient:
+      points[0] = reader.Read<SkPoint>();
+      scalars[0] = reader.Read<SkScalar>();
+      scalars[1] = reader.Read<SkScalar>();
+      break;
+    default:
+      reader.Fail("Invalid color source.");
+      return nullptr;
+  }
+  const uint32_t stop_count = reader.Read<uint32_t>();
+  const DlColor* colors = reader.ReadArray<DlColor>(stop_count);
+  const float* stops = reader.ReadArray<float>(stop_count);
+  const DlTileMode tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+  const std::optional<SkMatrix> matrix = reader.ReadOptionalMatrix();
+  if (!reader.ok()) {
+    return nullptr;
+  }
+  const SkMatrix* matrix_ptr = matrix ? &matrix.value() : nullptr;
+  switch (type) {
+    case DlColorSourceType::kLinearGradient:
+      return DlColorSource::MakeLinear(points[0], points[1], stop_count,
+                                       colors, stops, tile_mode, matrix_ptr);
+    case DlColorSourceType::kRadialGradient:
+      return DlColorSource::MakeRadial(points[0], scalars[0], stop_count,
+                                       colors, stops, tile_mode, matrix_ptr);
+    case DlColorSourceType::kConicalGradient:
+      return DlColorSource::MakeConical(points[0], scalars[0], points[1],
+                                        scalars[1], stop_count, colors, stops,
+                                        tile_mode, matrix_ptr);
+    case DlColorSourceType::kSweepGradient:
+      return DlColorSource::MakeSweep(points[0], scalars[0], scalars[1],
+                                      stop_count, colors, stops, tile_mode,
+                                      matrix_ptr);
+    default:
+      return nullptr;
+  }
+}
+
+std::optional<SkRect> ReadOptionalRect(Reader& reader) {
+  if (!reader.ReadBool()) {
+    return std::nullopt;
+  }
+  return reader.Read<SkRect>();
+}
+
+// Decodes and replays a single record. Returns false at the end of the list
+// or on error.
+bool ReplayOp(Reader& reader,
+              DlOpReceiver& receiver,
+              const DlImageResolver& image_resolver,
+              int depth) {
+  using ClipOp = DlCanvas::ClipOp;
+  using PointMode = DlCanvas::PointMode;
+  using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+  const auto op = reader.ReadEnum(SerializedOp::kDrawTextBlob);
+  if (!reader.ok() || op == SerializedOp::kEnd) {
+    return false;
+  }
+  switch (op) {
+    case SerializedOp::kEnd:
+      return false;
+    case SerializedOp::kSetAntiAlias: {
+      const bool aa = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.setAntiAlias(aa);
+      }
+      break;
+    }
+    case SerializedOp::kSetDither: {
+      const bool dither = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.setDither(dither);
+      }
+      break;
+    }
+    case SerializedOp::kSetDrawStyle: {
+      const auto style = reader.ReadEnum(DlDrawStyle::kLastStyle);
+      if (reader.ok()) {
+        receiver.setDrawStyle(style);
+      }
+      break;
+    }
+    case SerializedOp::kSetColor: {
+      const auto color = reader.Read<DlColor>();
+      if (reader.ok()) {
+        receiver.setColor(color);
+      }
+      break;
+    }
+    case SerializedOp::kSetStrokeWidth: {
+      const auto width = reader.Read<float>();
+      if (reader.ok()) {
+        receiver.setStrokeWidth(width);
+      }
+      break;
+    }
+    case SerializedOp::kSetStrokeMiter: {
+      const auto limit = reader.Read<float>();
+      if (reader.ok()) {
+        receiver.setStrokeMiter(limit);
+      }
+      break;
+    }
+    case SerializedOp::kSetStrokeCap: {
+      const auto cap = reader.ReadEnum(DlStrokeCap::kLastCap);
+      if (reader.ok()) {
+        receiver.setStrokeCap(cap);
+      }
+      break;
+    }
+    case SerializedOp::kSetStrokeJoin: {
+      const auto join = reader.ReadEnum(DlStrokeJoin::kLastJoin);
+      if (reader.ok()) {
+        receiver.setStrokeJoin(join);
+      }
+      break;
+    }
+    case SerializedOp::kSetColorSource: {
+      const auto source = ReadColorSource(reader, image_resolver);
+      if (reader.ok()) {
+        receiver.setColorSource(source.get());
+      }
+      break;
+    }
+    case SerializedOp::kSetColorFilter: {
+      const auto filter = ReadColorFilter(reader);
+      if (reader.ok()) {
+        receiver.setColorFilter(filter.get());
+      }
+      break;
+    }
+    case SerializedOp::kSetInvertColors: {
+      const bool invert = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.setInvertColors(invert);
+      }
+      break;
+    }
+    case SerializedOp::kSetBlendMode: {
+      const auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      if (reader.ok()) {
+        receiver.setBlendMode(mode);
+      }
+      break;
+    }
+    case SerializedOp::kSetPathEffect: {
+      std::shared_ptr<DlPathEffect> effect;
+      if (reader.ReadBool()) {
+        const uint32_t count = reader.Read<uint32_t>();
+        const SkScalar* intervals = reader.ReadArray<SkScalar>(count);
+        const SkScalar phase = reader.Read<SkScalar>();
+        if (reader.ok()) {
+          effect = DlDashPathEffect::Make(intervals, count, phase);
+        }
+      }
+      if (reader.ok()) {
+        receiver.setPathEffect(effect.get());
+      }
+      break;
+    }
+    case SerializedOp::kSetMaskFilter: {
+      std::shared_ptr<DlMaskFilter> filter;
+      if (reader.ReadBool()) {
+        const auto style = reader.ReadEnum(DlBlurStyle::kInner);
+        const auto sigma = reader.Read<SkScalar>();
+        const bool respect_ctm = reader.ReadBool();
+        filter = DlBlurMaskFilter::Make(style, sigma, respect_ctm);
+      }
+      if (reader.ok()) {
+        receiver.setMaskFilter(filter.get());
+      }
+      break;
+    }
+    case SerializedOp::kSetImageFilter: {
+      const auto filter = ReadImageFilter(reader, 0);
+      if (reader.ok()) {
+        receiver.setImageFilter(filter.get());
+      }
+      break;
+    }
+    case SerializedOp::kSave:
+      receiver.save();
+      break;
+    case SerializedOp::kSaveLayer: {
+      const std::optional<SkRect> bounds = ReadOptionalRect(reader);
+      const bool renders_with_attributes = reader.ReadBool();
+      const auto backdrop = ReadImageFilter(reader, 0);
+      if (reader.ok()) {
+        const SaveLayerOptions options =
+            renders_with_attributes ? SaveLayerOptions::kWithAttributes
+                                    : SaveLayerOptions::kNoAttributes;
+        receiver.saveLayer(bounds ? &bounds.value() : nullptr, options,
+                           backdrop.get());
+      }
+      break;
+    }
+    case SerializedOp::kRestore:
+      receiver.restore();
+      break;
+    case SerializedOp::kTranslate: {
+      const auto tx = reader.Read<SkScalar>();
+      const auto ty = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.translate(tx, ty);
+      }
+      break;
+    }
+    case SerializedOp::kScale: {
+      const auto sx = reader.Read<SkScalar>();
+      const auto sy = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.scale(sx, sy);
+      }
+      break;
+    }
+    case SerializedOp::kRotate: {
+      const auto degrees = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.rotate(degrees);
+      }
+      break;
+    }
+    case SerializedOp::kSkew: {
+      const auto sx = reader.Read<SkScalar>();
+      const auto sy = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.skew(sx, sy);
+      }
+      break;
+    }
+    case SerializedOp::kTransform2DAffine: {
+      const SkScalar* m = reader.ReadArray<SkScalar>(6);
+      if (reader.ok()) {
+        receiver.transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+      }
+      break;
+    }
+    case SerializedOp::kTransformFullPerspective: {
+      const SkScalar* m = reader.ReadArray<SkScalar>(16);
+      if (reader.ok()) {
+        receiver.transformFullPerspective(m[0], m[1], m[2], m[3],    //
+                                          m[4], m[5], m[6], m[7],    //
+                                          m[8], m[9], m[10], m[11],  //
+                                          m[12], m[13], m[14], m[15]);
+      }
+      break;
+    }
+    case SerializedOp::kTransformReset:
+      receiver.transformReset();
+      break;
+    case SerializedOp::kClipRect: {
+      const auto rect = reader.Read<SkRect>();
+      const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+      const bool is_aa = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.clipRect(rect, clip_op, is_aa);
+      }
+      break;
+    }
+    case SerializedOp::kClipRRect: {
+      const SkRRect rrect = reader.ReadRRect();
+      const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+      const bool is_aa = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.clipRRect(rrect, clip_op, is_aa);
+      }
+      break;
+    }
+    case SerializedOp::kClipPath: {
+      const SkPath path = reader.ReadPath();
+      const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+      const bool is_aa = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.clipPath(path, clip_op, is_aa);
+      }
+      break;
+    }
+    case SerializedOp::kDrawColor: {
+      const auto color = reader.Read<DlColor>();
+      const auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      if (reader.ok()) {
+        receiver.drawColor(color, mode);
+      }
+      break;
+    }
+    case SerializedOp::kDrawPaint:
+      receiver.drawPaint();
+      break;
+    case SerializedOp::kDrawLine: {
+      const auto p0 = reader.Read<SkPoint>();
+      const auto p1 = reader.Read<SkPoint>();
+      if (reader.ok()) {
+        receiver.drawLine(p0, p1);
+      }
+      break;
+    }
+    case SerializedOp::kDrawRect: {
+      const auto rect = reader.Read<SkRect>();
+      if (reader.ok()) {
+        receiver.drawRect(rect);
+      }
+      break;
+    }
+    case SerializedOp::kDrawRects: {
+      const uint32_t count = reader.Read<uint32_t>();
+      const SkRect* rects = reader.ReadArray<SkRect>(count);
+      if (reader.ok()) {
+        receiver.drawRects(rects, count);
+      }
+      break;
+    }
+    case SerializedOp::kDrawOval: {
+      const auto bounds = reader.Read<SkRect>();
+      if (reader.ok()) {
+        receiver.drawOval(bounds);
+      }
+      break;
+    }
+    case SerializedOp::kDrawCircle: {
+      const auto center = reader.Read<SkPoint>();
+      const auto radius = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.drawCircle(center, radius);
+      }
+      break;
+    }
+    case SerializedOp::kDrawRRect: {
+      const SkRRect rrect = reader.ReadRRect();
+      if (reader.ok()) {
+        receiver.drawRRect(rrect);
+      }
+      break;
+    }
+    case SerializedOp::kDrawDRRect: {
+      const SkRRect outer = reader.ReadRRect();
+      const SkRRect inner = reader.ReadRRect();
+      if (reader.ok()) {
+        receiver.drawDRRect(outer, inner);
+      }
+      break;
+    }
+    case SerializedOp::kDrawPath: {
+      const SkPath path = reader.ReadPath();
+      if (reader.ok()) {
+        receiver.drawPath(path);
+      }
+      break;
+    }
+    case SerializedOp::kDrawArc: {
+      const auto bounds = reader.Read<SkRect>();
+      const auto start = reader.Read<SkScalar>();
+      const auto sweep = reader.Read<SkScalar>();
+      const bool use_center = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.drawArc(bounds, start, sweep, use_center);
+      }
+      break;
+    }
+    case SerializedOp::kDrawPoints: {
+      const auto mode = reader.ReadEnum(PointMode::kPolygon);
+      const uint32_t count = reader.Read<uint32_t>();
+      const SkPoint* points = reader.ReadArray<SkPoint>(count);
+      if (reader.ok()) {
+        receiver.drawPoints(mode, count, points);
+      }
+      break;
+    }
+    case SerializedOp::kDrawVertices: {
+      const auto mode = reader.ReadEnum(DlVertexMode::kTriangleFan);
+      const uint32_t count = reader.Read<uint32_t>();
+      const SkPoint* vertices = reader.ReadArray<SkPoint>(count);
+      const SkPoint* texture_coordinates =
+          reader.ReadBool() ? reader.ReadArray<SkPoint>(count) : nullptr;
+      const DlColor* colors =
+          reader.ReadBool() ? reader.ReadArray<DlColor>(count) : nullptr;
+      size_t index_bytes = 0;
+      const uint8_t* indices = reader.ReadBlob(&index_bytes);
+      const auto blend_mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      if (reader.ok() && index_bytes % sizeof(uint16_t) != 0) {
+        reader.Fail("Invalid vertex indices.");
+      }
+      if (reader.ok()) {
+        const int index_count = index_bytes / sizeof(uint16_t);
+        auto dl_vertices = DlVertices::Make(
+            mode, count, vertices, texture_coordinates, colors, index_count,
+            index_count > 0 ? reinterpret_cast<const uint16_t*>(indices)
+                            : nullptr);
+        receiver.drawVertices(dl_vertices.get(), blend_mode);
+      }
+      break;
+    }
+    case SerializedOp::kDrawImage: {
+      auto image = ReadImage(reader, image_resolver);
+      const auto point = reader.Read<SkPoint>();
+      const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+      const bool with_attributes = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.drawImage(std::move(image), point, sampling, with_attributes);
+      }
+      break;
+    }
+    case SerializedOp::kDrawImageRect: {
+      auto image = ReadImage(reader, image_resolver);
+      const auto src = reader.Read<SkRect>();
+      const auto dst = reader.Read<SkRect>();
+      const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+      const bool with_attributes = reader.ReadBool();
+      const auto constraint = reader.ReadEnum(SrcRectConstraint::kFast);
+      if (reader.ok()) {
+        receiver.drawImageRect(std::move(image), src, dst, sampling,
+                               with_attributes, constraint);
+      }
+      break;
+    }
+    case SerializedOp::kDrawImageNine: {
+      auto image = ReadImage(reader, image_resolver);
+      const auto center = reader.Read<SkIRect>();
+      const auto dst = reader.Read<SkRect>();
+      const auto filter = reader.ReadEnum(DlFilterMode::kLast);
+      const bool with_attributes = reader.ReadBool();
+      if (reader.ok()) {
+        receiver.drawImageNine(std::move(image), center, dst, filter,
+                               with_attributes);
+      }
+      break;
+    }
+    case SerializedOp::kDrawAtlas: {
+      auto atlas = ReadImage(reader, image_resolver);
+      const uint32_t count = reader.Read<uint32_t>();
+      const SkRSXform* xform = reader.ReadArray<SkRSXform>(count);
+      const SkRect* tex = reader.ReadArray<SkRect>(count);
+      const DlColor* colors =
+          reader.ReadBool() ? reader.ReadArray<DlColor>(count) : nullptr;
+      const auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+      const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+      const std::optional<SkRect> cull_rect = ReadOptionalRect(reader);
+      const bool with_attributes = reader.ReadBool();
+      if (reader.ok() && count > static_cast<uint32_t>(INT32_MAX)) {
+        reader.Fail("Too many atlas sprites.");
+      }
+      if (reader.ok()) {
+        receiver.drawAtlas(std::move(atlas), xform, tex, colors, count, mode,
+                           sampling, cull_rect ? &cull_rect.value() : nullptr,
+                           with_attributes);
+      }
+      break;
+    }
+    case SerializedOp::kDrawDisplayList: {
+      const auto opacity = reader.Read<SkScalar>();
+      size_t size = 0;
+      const uint8_t* data = reader.ReadBlob(&size);
+      if (!reader.ok()) {
+        break;
+      }
+      if (depth >= kMaxNestingDepth) {
+        reader.Fail("Display lists are nested too deeply.");
+        break;
+      }
+      Reader nested_reader(data, size);
+      auto nested = DeserializeFrom(nested_reader, image_resolver, depth + 1);
+      if (!nested) {
+        reader.Fail(nested_reader.error());
+        break;
+      }
+      receiver.drawDisplayList(std::move(nested), opacity);
+      break;
+    }
+    case SerializedOp::kDrawTextBlob: {
+      const auto x = reader.Read<SkScalar>();
+      const auto y = reader.Read<SkScalar>();
+      size_t size = 0;
+      const uint8_t* data = reader.ReadBlob(&size);
+      if (!reader.ok()) {
+        break;
+      }
+      sk_sp<SkTextBlob> blob =
+          SkTextBlob::Deserialize(data, size, SkDeserialProcs());
+      if (!blob) {
+        reader.Fail("Invalid text blob.");
+        break;
+      }
+      receiver.drawTextBlob(std::move(blob), x, y);
+      break;
+    }
+    case SerializedOp::kDrawShadow: {
+      const SkPath path = reader.ReadPath();
+      const auto color = reader.Read<DlColor>();
+      const auto elevation = reader.Read<SkScalar>();
+      const bool transparent_occluder = reader.ReadBool();
+      const auto dpr = reader.Read<SkScalar>();
+      if (reader.ok()) {
+        receiver.drawShadow(path, color, elevation, transparent_occluder, dpr);
+      }
+      break;
+    }
+  }
+  return reader.ok();
+}
+
+sk_sp<DisplayList> DeserializeFrom(Reader& reader,
+                                   const DlImageResolver& image_resolver,
+                                   int depth) {
+  if (reader.Read<uint32_t>() != kFormatMagic) {
+    reader.Fail("Not a serialized display list.");
+    return nullptr;
+  }
+  if (reader.Read<uint32_t>() != kFormatVersion) {
+    reader.Fail("Unsupported serialized display list version.");
+    return nullptr;
+  }
+  const uint32_t flags = reader.Read<uint32_t>();
+  if (!reader.ok()) {
+    return nullptr;
+  }
+
+  DisplayListBuilder builder((flags & kHeaderFlagHasRTree) != 0);
+  DlOpReceiver& receiver = DisplayListBuilderSerializationAccessor(builder);
+  while (ReplayOp(reader, receiver, image_resolver, depth)) {
+  }
+  if (!reader.ok()) {
+    return nullptr;
+  }
+  if (!reader.at_end()) {
+    reader.Fail("Unexpected data after the end of the display list.");
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> SerializeDisplayList(
+    const DisplayList& display_list,
+    const DlImageEncoder& image_encoder,
+    std::string* error) {
+  Writer writer;
+  if (!SerializeInto(writer, display_list, image_encoder, 0, error)) {
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(writer.TakeData());
+}
+
+sk_sp<DisplayList> DeserializeDisplayList(const fml::Mapping& mapping,
+                                          const DlImageResolver& image_resolver,
+                                          std::string* error) {
+  const uint8_t* data = mapping.GetMapping();
+  const size_t size = mapping.GetSize();
+
+  // File mappings are page aligned and heap buffers are 8 byte aligned, so
+  // this copy is only made for data that was sliced out of a larger buffer.
+  std::vector<uint8_t> aligned_copy;
+  if (reinterpret_cast<uintptr_t>(data) % 4 != 0) {
+    aligned_copy.assign(data, data + size);
+    data = aligned_copy.data();
+  }
+
+  Reader reader(data, size);
+  sk_sp<DisplayList> display_list =
+      DeserializeFrom(reader, image_resolver, 0);
+  if (!display_list && error) {
+    *error = reader.error();
+  }
+  return display_list;
+}
+
+}  // namespace flutter
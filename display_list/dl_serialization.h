@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+/// Maps an image referenced by a display list to an id that the
+/// |DlImageResolver| given to |DeserializeDisplayList| understands, such as
+/// the hash of the encoded asset it was decoded from. Returning std::nullopt
+/// fails the serialization.
+using DlImageEncoder =
+    std::function<std::optional<uint64_t>(const sk_sp<DlImage>& image)>;
+
+/// Maps an id produced by a |DlImageEncoder| back to an image. Returning
+/// nullptr fails the deserialization.
+using DlImageResolver = std::function<sk_sp<DlImage>(uint64_t id)>;
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes |display_list| into a versioned binary format that
+///             can be persisted and later loaded with |DeserializeDisplayList|
+///             without rerunning the code that recorded it.
+///
+///             The format contains no pointers and can be read straight out
+///             of a file mapping. It uses the byte order of the host, which
+///             is little endian on every platform Flutter supports, and is
+///             rejected by hosts of the other byte order.
+///
+///             Paths, round rects, vertices, gradients and all of the
+///             built-in filters and effects are supported, as are nested
+///             display lists. Images are written as ids obtained from
+///             |image_encoder|. Text blobs are written with Skia's own
+///             serialization, which refers to their typefaces by name, so
+///             they are only reproduced faithfully where the same fonts are
+///             installed. Impeller text frames, runtime effects and 3D scenes
+///             have no stable serialized form and fail the serialization.
+///
+/// @param[in]  display_list   The display list to serialize.
+/// @param[in]  image_encoder  Assigns ids to referenced images. May be null
+///                            if the list references no images.
+/// @param[out] error          If not null, receives a description of the
+///                            first unsupported operation on failure.
+///
+/// @return     The serialized display list, or nullptr on failure.
+///
+std::unique_ptr<fml::Mapping> SerializeDisplayList(
+    const DisplayList& display_list,
+    const DlImageEncoder& image_encoder = nullptr,
+    std::string* error = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      Recreates a display list serialized with
+///             |SerializeDisplayList|.
+///
+///             The operations are read in place from |mapping| and replayed
+///             into a |DisplayListBuilder|, which also rebuilds the RTree if
+///             the serialized list had one. Malformed or truncated data and
+///             data written by a different version of the format are
+///             rejected.
+///
+/// @param[in]  mapping         The serialized display list.
+/// @param[in]  image_resolver  Resolves image ids to images. May be null if
+///                             the list references no images.
+/// @param[out] error           If not null, receives a description of the
+///                             problem on failure.
+///
+/// @return     The display list, or nullptr on failure.
+///
+sk_sp<DisplayList> DeserializeDisplayList(
+    const fml::Mapping& mapping,
+    const DlImageResolver& image_resolver = nullptr,
+    std::string* error = nullptr);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+namespace {
+
+// Assigns each distinct image its index in |images_|.
+class TestImageRegistry {
+ public:
+  DlImageEncoder encoder() {
+    return [this](const sk_sp<DlImage>& image) -> std::optional<uint64_t> {
+      for (size_t i = 0; i < images_.size(); i++) {
+        if (images_[i] == image) {
+          return i;
+        }
+      }
+      images_.push_back(image);
+      return images_.size() - 1;
+    };
+  }
+
+  DlImageResolver resolver() {
+    return [this](uint64_t id) -> sk_sp<DlImage> {
+      return id < images_.size() ? images_[id] : nullptr;
+    };
+  }
+
+ private:
+  std::vector<sk_sp<DlImage>> images_;
+};
+
+sk_sp<DisplayList> MakeSampleList(bool prepare_rtree) {
+  DisplayListBuilder builder(prepare_rtree);
+  DlPaint paint;
+  paint.setColor(DlColor::kRed());
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), paint);
+  builder.Save();
+  builder.Translate(5, 5);
+  builder.ClipPath(SkPath().addCircle(30, 30, 10), DlCanvas::ClipOp::kIntersect,
+                   true);
+  paint.setColorSource(kTestSource2);
+  paint.setImageFilter(&kTestBlurImageFilter1);
+  builder.DrawPath(SkPath().addOval(SkRect::MakeLTRB(20, 20, 60, 40)), paint);
+  builder.Restore();
+  builder.DrawDisplayList(TestDisplayList1, 0.5f);
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(DisplayListSerialization, SampleListRoundTrips) {
+  for (bool prepare_rtree : {false, true}) {
+    sk_sp<DisplayList> display_list = MakeSampleList(prepare_rtree);
+    std::string error;
+    auto serialized = SerializeDisplayList(*display_list, nullptr, &error);
+    ASSERT_NE(serialized, nullptr) << error;
+
+    sk_sp<DisplayList> copy =
+        DeserializeDisplayList(*serialized, nullptr, &error);
+    ASSERT_NE(copy, nullptr) << error;
+    EXPECT_TRUE(copy->Equals(*display_list));
+    EXPECT_EQ(copy->bounds(), display_list->bounds());
+    EXPECT_EQ(copy->has_rtree(), prepare_rtree);
+  }
+}
+
+TEST(DisplayListSerialization, SingleOpListsRoundTrip) {
+  for (auto& group : CreateAllGroups()) {
+    if (group.op_name == "DrawTextBlob") {
+      continue;
+    }
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+      DisplayListBuilder builder;
+      group.variants[i].Invoke(DisplayListBuilderTestingAccessor(builder));
+      sk_sp<DisplayList> display_list = builder.Build();
+
+      TestImageRegistry images;
+      std::string error;
+      auto serialized =
+          SerializeDisplayList(*display_list, images.encoder(), &error);
+      ASSERT_NE(serialized, nullptr) << desc << ": " << error;
+      sk_sp<DisplayList> copy =
+          DeserializeDisplayList(*serialized, images.resolver(), &error);
+      ASSERT_NE(copy, nullptr) << desc << ": " << error;
+      EXPECT_TRUE(copy->Equals(*display_list)) << desc;
+    }
+  }
+}
+
+TEST(DisplayListSerialization, UnalignedMappingsAreCopied) {
+  sk_sp<DisplayList> display_list = MakeSampleList(false);
+  auto serialized = SerializeDisplayList(*display_list);
+  ASSERT_NE(serialized, nullptr);
+
+  std::vector<uint8_t> buffer(serialized->GetSize() + 1);
+  memcpy(buffer.data() + 1, serialized->GetMapping(), serialized->GetSize());
+  fml::NonOwnedMapping unaligned(buffer.data() + 1, serialized->GetSize());
+  sk_sp<DisplayList> copy = DeserializeDisplayList(unaligned);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_TRUE(copy->Equals(*display_list));
+}
+
+TEST(DisplayListSerialization, TextBlobsRoundTrip) {
+  DisplayListBuilder builder;
+  builder.DrawTextBlob(TestBlob1, 10, 10, DlPaint());
+  sk_sp<DisplayList> display_list = builder.Build();
+  std::string error;
+  auto serialized = SerializeDisplayList(*display_list, nullptr, &error);
+  ASSERT_NE(serialized, nullptr) << error;
+
+  // The blob is recreated, so the lists can't be compared with |Equals|.
+  sk_sp<DisplayList> copy =
+      DeserializeDisplayList(*serialized, nullptr, &error);
+  ASSERT_NE(copy, nullptr) << error;
+  EXPECT_EQ(copy->op_count(), display_list->op_count());
+  EXPECT_EQ(copy->bounds(), display_list->bounds());
+}
+
+TEST(DisplayListSerialization, ImagesNeedAnEncoder) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, SkPoint::Make(10, 10),
+                    DlImageSampling::kLinear);
+  sk_sp<DisplayList> display_list = builder.Build();
+  EXPECT_EQ(SerializeDisplayList(*display_list), nullptr);
+
+  TestImageRegistry images;
+  auto serialized = SerializeDisplayList(*display_list, images.encoder());
+  ASSERT_NE(serialized, nullptr);
+  EXPECT_EQ(DeserializeDisplayList(*serialized), nullptr);
+  EXPECT_NE(DeserializeDisplayList(*serialized, images.resolver()), nullptr);
+}
+
+TEST(DisplayListSerialization, MalformedDataIsRejected) {
+  auto serialized = SerializeDisplayList(*MakeSampleList(false));
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> data(serialized->GetMapping(),
+                            serialized->GetMapping() + serialized->GetSize());
+
+  // Every truncation of the data is rejected.
+  for (size_t size = 0; size < data.size(); size += 4) {
+    fml::NonOwnedMapping truncated(data.data(), size);
+    std::string error;
+    EXPECT_EQ(DeserializeDisplayList(truncated, nullptr, &error), nullptr)
+        << size;
+    EXPECT_FALSE(error.empty());
+  }
+
+  // So is trailing data.
+  std::vector<uint8_t> extended = data;
+  extended.resize(extended.size() + 4, 0);
+  EXPECT_EQ(DeserializeDisplayList(fml::DataMapping(extended)), nullptr);
+
+  // And data from other versions of the format.
+  std::vector<uint8_t> other_version = data;
+  other_version[4] ^= 0xff;
+  EXPECT_EQ(DeserializeDisplayList(fml::DataMapping(other_version)), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,12 +6,97 @@
 
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_REGION_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DL_REGION_USE_NEON
+#endif
+
 namespace flutter {
 
 // Threshold for switching from linear search through span lines to binary
 // search.
 const int kBinarySearchThreshold = 10;
 
+namespace {
+
+// Counts the leading spans in |spans|, an array of |count| interleaved left
+// and right edges, whose |kEdge| edge (0 for left, 1 for right) is at or
+// before |x|. Both edges of the spans in a line increase, so these spans are
+// always a prefix of the line and can be counted 4 at a time.
+template <int kEdge>
+size_t CountSpansUpTo(const int32_t* spans, size_t count, int32_t x) {
+  size_t i = 0;
+#if defined(DL_REGION_USE_SSE2)
+  const __m128i threshold = _mm_set1_epi32(x);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 lo = _mm_castsi128_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(spans + 2 * i)));
+    const __m128 hi = _mm_castsi128_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(spans + 2 * i + 4)));
+    const __m128i edges = _mm_castps_si128(
+        kEdge == 0 ? _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))
+                   : _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    const int past = _mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpgt_epi32(edges, threshold)));
+    if (past != 0) {
+      return i + __builtin_ctz(past);
+    }
+  }
+#elif defined(DL_REGION_USE_NEON)
+  const int32x4_t threshold = vdupq_n_s32(x);
+  for (; i + 4 <= count; i += 4) {
+    const int32x4_t edges = vld2q_s32(spans + 2 * i).val[kEdge];
+    const uint32x4_t up_to = vcleq_s32(edges, threshold);
+    if (vminvq_u32(up_to) == 0) {
+      return i + vaddvq_u32(vshrq_n_u32(up_to, 31));
+    }
+  }
+#endif
+  while (i < count && spans[2 * i + kEdge] <= x) {
+    i++;
+  }
+  return i;
+}
+
+// Returns the first span in [begin, end) whose |kEdge| edge is past |x|.
+template <int kEdge, typename Span>
+inline const Span* SkipSpansUpTo(const Span* begin,
+                                 const Span* end,
+                                 int32_t x) {
+  static_assert(sizeof(Span) == 2 * sizeof(int32_t));
+  const auto* spans = reinterpret_cast<const int32_t*>(begin);
+  // Most skips are over a span or two, which aren't worth a vector search.
+  if (begin == end || spans[kEdge] > x) {
+    return begin;
+  }
+  if (begin + 1 == end || spans[2 + kEdge] > x) {
+    return begin + 1;
+  }
+  return begin + 2 + CountSpansUpTo<kEdge>(spans + 4, end - begin - 2, x);
+}
+
+// Returns the first span in [begin, end) whose right edge is past |x|.
+template <typename Span>
+inline const Span* FirstSpanEndingAfter(const Span* begin,
+                                        const Span* end,
+                                        int32_t x) {
+  return SkipSpansUpTo<1>(begin, end, x);
+}
+
+// Returns the first span in [begin, end) whose left edge is past |x|.
+template <typename Span>
+inline const Span* FirstSpanStartingAfter(const Span* begin,
+                                          const Span* end,
+                                          int32_t x) {
+  return SkipSpansUpTo<0>(begin, end, x);
+}
+
+}  // namespace
+
 DlRegion::SpanBuffer::SpanBuffer(DlRegion::SpanBuffer&& m)
     : capacity_(m.capacity_), size_(m.size_), spans_(m.spans_) {
   m.size_ = 0;
@@ -153,6 +238,21 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
       }
     }
 
+    // Accumulates the rest of a line after the other line has run out. The
+    // spans of a line are disjoint, so only those starting within the last
+    // accumulated span are combined with it and the rest are copied.
+    void accumulateRest(const Span* begin, const Span* end) {
+      const Span* rest = FirstSpanStartingAfter(begin, end, last_);
+      while (begin < rest) {
+        accumulate(*begin++);
+      }
+      if (rest != end) {
+        memcpy(res.data() + len, rest, (end - rest) * sizeof(Span));
+        len += end - rest;
+        last_ = end[-1].right;
+      }
+    }
+
     size_t len = 0;
     std::vector<Span>& res;
 
@@ -191,14 +291,8 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
 
   FML_DCHECK(begin1 == end1 || begin2 == end2);
 
-  while (begin1 < end1) {
-    accumulator.accumulate(*begin1++);
-  }
-  while (begin2 < end2) {
-    accumulator.accumulate(*begin2++);
-  }
-
-  FML_DCHECK(begin1 == end1 && begin2 == end2);
+  accumulator.accumulateRest(begin1, end1);
+  accumulator.accumulateRest(begin2, end2);
 
   return accumulator.len;
 }
@@ -227,9 +321,9 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
 
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      begin1 = FirstSpanEndingAfter(begin1 + 1, end1, begin2->left);
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      begin2 = FirstSpanEndingAfter(begin2 + 1, end2, begin1->left);
     } else {
       int32_t left = std::max(begin1->left, begin2->left);
       int32_t right = std::min(begin1->right, begin2->right);
@@ -646,11 +740,11 @@ bool DlRegion::intersects(const SkIRect& rect) const {
     FML_DCHECK(rect.fTop < it->bottom && it->top < rect.fBottom);
     const Span *begin, *end;
     span_buffer_.getSpans(it->chunk_handle, begin, end);
-    while (begin != end && begin->left < rect.fRight) {
-      if (begin->right > rect.fLeft) {
-        return true;
-      }
-      ++begin;
+    // Spans past the first one that ends after rect's left edge also start
+    // after its left edge.
+    begin = FirstSpanEndingAfter(begin, end, rect.fLeft);
+    if (begin != end && begin->left < rect.fRight) {
+      return true;
     }
     ++it;
   }
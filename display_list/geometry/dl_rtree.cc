@@ -5,10 +5,152 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_RTREE_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DL_RTREE_USE_NEON
+#endif
+
 namespace flutter {
 
+namespace {
+
+// The position of a rect in the current level of the tree under
+// construction along with its center, quantized to 16 bits across the range
+// of all of the centers. That is plenty to order the rects and keeps the
+// keys small and the radix sort short.
+struct SortKey {
+  uint16_t x;
+  uint16_t y;
+  uint32_t position;
+};
+
+// Sorts |keys| by the coordinate |axis| selects. A least significant digit
+// radix sort is several times faster than std::sort for the tens of
+// thousands of rects of a large display list.
+void SortKeys(SortKey* keys,
+              size_t count,
+              SortKey* scratch,
+              uint16_t SortKey::*axis) {
+  if (count < 256) {
+    std::sort(keys, keys + count, [axis](const SortKey& a, const SortKey& b) {
+      return a.*axis < b.*axis;
+    });
+    return;
+  }
+  size_t low_offsets[256] = {};
+  size_t high_offsets[256] = {};
+  for (size_t i = 0; i < count; i++) {
+    low_offsets[keys[i].*axis & 0xff]++;
+    high_offsets[keys[i].*axis >> 8]++;
+  }
+  size_t low_total = 0;
+  size_t high_total = 0;
+  for (int i = 0; i < 256; i++) {
+    const size_t low_count = low_offsets[i];
+    const size_t high_count = high_offsets[i];
+    low_offsets[i] = low_total;
+    high_offsets[i] = high_total;
+    low_total += low_count;
+    high_total += high_count;
+  }
+  for (size_t i = 0; i < count; i++) {
+    scratch[low_offsets[keys[i].*axis & 0xff]++] = keys[i];
+  }
+  for (size_t i = 0; i < count; i++) {
+    keys[high_offsets[scratch[i].*axis >> 8]++] = scratch[i];
+  }
+}
+
+// Maps the sum of two edges of a rect, which compares the same as its
+// center, to 16 bits across the range of the sums it has seen.
+class CenterQuantizer {
+ public:
+  void Add(SkScalar sum) {
+    min_ = std::min(min_, sum);
+    max_ = std::max(max_, sum);
+  }
+
+  void Prepare() {
+    const SkScalar range = max_ - min_;
+    range_ = std::isfinite(range) ? range : 0.0f;
+    scale_ = range_ > 0 ? 65535.0f / range_ : 0.0f;
+  }
+
+  SkScalar range() const { return range_; }
+
+  uint16_t Quantize(SkScalar sum) const {
+    return static_cast<uint16_t>(
+        std::clamp((sum - min_) * scale_, 0.0f, 65535.0f));
+  }
+
+ private:
+  SkScalar min_ = std::numeric_limits<SkScalar>::infinity();
+  SkScalar max_ = -std::numeric_limits<SkScalar>::infinity();
+  SkScalar range_ = 0.0f;
+  SkScalar scale_ = 0.0f;
+};
+
+// Fills |keys| with the positions of the |count| rects in |bounds| in the
+// order of the Sort-Tile-Recursive algorithm, so that each run of |width|
+// consecutive rects covers a compact region. The rects are sorted into
+// vertical slices by their horizontal center and each slice is then sorted
+// by vertical center.
+//
+// Unlike the original algorithm, which assumes square data, the number of
+// slices follows the aspect ratio of the rects so that the tiles stay
+// roughly square for tall content such as a long document.
+void SortTileRecursive(const SkRect bounds[],
+                       size_t count,
+                       size_t width,
+                       SortKey* keys,
+                       SortKey* scratch) {
+  CenterQuantizer x_quantizer;
+  CenterQuantizer y_quantizer;
+  for (size_t i = 0; i < count; i++) {
+    x_quantizer.Add(bounds[i].fLeft + bounds[i].fRight);
+    y_quantizer.Add(bounds[i].fTop + bounds[i].fBottom);
+  }
+  x_quantizer.Prepare();
+  y_quantizer.Prepare();
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = {x_quantizer.Quantize(bounds[i].fLeft + bounds[i].fRight),
+               y_quantizer.Quantize(bounds[i].fTop + bounds[i].fBottom),
+               static_cast<uint32_t>(i)};
+  }
+
+  const size_t parent_count = (count + width - 1) / width;
+  if (parent_count <= 1) {
+    return;
+  }
+  size_t slice_count = parent_count;
+  if (y_quantizer.range() > 0) {
+    const double aspect_ratio = x_quantizer.range() / y_quantizer.range();
+    slice_count = std::clamp<size_t>(
+        std::ceil(std::sqrt(parent_count * aspect_ratio)), 1, parent_count);
+  }
+  const size_t slice_size =
+      ((parent_count + slice_count - 1) / slice_count) * width;
+
+  SortKeys(keys, count, scratch, &SortKey::x);
+  for (size_t start = 0; start < count; start += slice_size) {
+    const size_t end = std::min(start + slice_size, count);
+    SortKeys(keys + start, end - start, scratch, &SortKey::y);
+  }
+}
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -21,142 +163,183 @@ DlRTree::DlRTree(const SkRect rects[],
   }
   FML_DCHECK(rects != nullptr);
 
-  // Count the number of rectangles we actually want to track,
-  // which includes only non-empty rectangles whose optional
-  // ID is not filtered by the predicate.
-  int leaf_count = 0;
+  // Place only the tracked rectangles, which includes only non-empty
+  // rectangles whose optional ID is not filtered by the predicate, into
+  // the leaves. The leaves keep the order of the rectangles so that the
+  // results of a search can be reported in that order.
+  leaf_bounds_.reserve(N);
+  leaf_ids_.reserve(N);
+  int id = invalid_id;
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
-      if (ids == nullptr || p(ids[i])) {
-        leaf_count++;
+      if (ids == nullptr || p(id = ids[i])) {
+        leaf_bounds_.push_back(rects[i]);
+        leaf_ids_.push_back(id);
       }
     }
   }
-  leaf_count_ = leaf_count;
-
-  // Count the total number of nodes (leaf and internal) up front
-  // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
-  uint32_t gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
-    gen_count = family_count;
+  leaf_count_ = leaf_bounds_.size();
+  if (leaf_count_ == 0) {
+    return;
   }
 
-  nodes_.resize(total_node_count);
+  // Count the branches up front so we can reserve the vector just once.
+  size_t total_branch_count = 0;
+  size_t gen_count = leaf_count_;
+  do {
+    gen_count = (gen_count + kBranchWidth - 1) / kBranchWidth;
+    total_branch_count += gen_count;
+  } while (gen_count > 1);
+  branches_.reserve(total_branch_count);
 
-  // Now place only the tracked rectangles into the nodes array
-  // in the first leaf_count_ entries.
-  int leaf_index = 0;
-  int id = invalid_id;
-  for (int i = 0; i < N; i++) {
-    if (!rects[i].isEmpty()) {
-      if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
-        node.bounds = rects[i];
-        node.id = id;
+  // Continually process the previous level (generation) of the tree,
+  // grouping each run of |kBranchWidth| rects into a new parent branch
+  // after ordering them with Sort-Tile-Recursive. Grouping nearby rects
+  // keeps the parent bounds tight, so that a search only descends into
+  // the branches that overlap the query. Each generation is reduced by a
+  // factor of |kBranchWidth| until there is just one branch left, which is
+  // the root of the R-Tree.
+  //
+  // The first generation are the leaves, later ones the branches appended
+  // to |branches_| by the previous iteration, starting at |gen_start|.
+  std::vector<SortKey> keys(leaf_count_);
+  std::vector<SortKey> scratch(leaf_count_);
+  std::vector<SkRect> gen_bounds;
+  std::vector<SkRect> parent_bounds;
+  const SkRect* bounds = leaf_bounds_.data();
+  uint32_t gen_start = 0;
+  gen_count = leaf_count_;
+  do {
+    SortTileRecursive(bounds, gen_count, kBranchWidth, keys.data(),
+                      scratch.data());
+    const uint32_t parent_start = branches_.size();
+    parent_bounds.clear();
+    for (size_t start = 0; start < gen_count; start += kBranchWidth) {
+      Branch& branch = branches_.emplace_back();
+      SkRect& joined = parent_bounds.emplace_back(SkRect::MakeEmpty());
+      const size_t count = std::min(gen_count - start, size_t{kBranchWidth});
+      for (size_t i = 0; i < kBranchWidth; i++) {
+        if (i < count) {
+          const uint32_t position = keys[start + i].position;
+          const SkRect& child = bounds[position];
+          branch.left[i] = child.fLeft;
+          branch.top[i] = child.fTop;
+          branch.right[i] = child.fRight;
+          branch.bottom[i] = child.fBottom;
+          branch.child[i] = gen_start + position;
+          joined.join(child);
+        } else {
+          branch.left[i] = branch.top[i] =
+              std::numeric_limits<SkScalar>::infinity();
+          branch.right[i] = branch.bottom[i] =
+              -std::numeric_limits<SkScalar>::infinity();
+          branch.child[i] = 0;
+        }
       }
     }
+    if (leaf_branch_count_ == 0) {
+      leaf_branch_count_ = branches_.size();
+    }
+    gen_bounds.swap(parent_bounds);
+    bounds = gen_bounds.data();
+    gen_start = parent_start;
+    gen_count = gen_bounds.size();
+  } while (gen_count > 1);
+  FML_DCHECK(branches_.size() == total_branch_count);
+  bounds_ = gen_bounds[0];
+}
+
+namespace {
+
+// Returns a mask with bit i set if child i of |branch| intersects |query|.
+// This is the same strict overlap test as |SkRect::intersects|, which both
+// the non-empty query and the non-empty children satisfy.
+template <typename Branch>
+inline uint32_t IntersectingChildren(const Branch& branch,
+                                     const SkRect& query,
+                                     int width) {
+  uint32_t mask = 0;
+#if defined(DL_RTREE_USE_SSE2)
+  const __m128 query_left = _mm_set1_ps(query.fLeft);
+  const __m128 query_top = _mm_set1_ps(query.fTop);
+  const __m128 query_right = _mm_set1_ps(query.fRight);
+  const __m128 query_bottom = _mm_set1_ps(query.fBottom);
+  for (int i = 0; i < width; i += 4) {
+    const __m128 x_overlap =
+        _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(branch.left + i), query_right),
+                   _mm_cmplt_ps(query_left, _mm_load_ps(branch.right + i)));
+    const __m128 y_overlap =
+        _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(branch.top + i), query_bottom),
+                   _mm_cmplt_ps(query_top, _mm_load_ps(branch.bottom + i)));
+    mask |= static_cast<uint32_t>(
+                _mm_movemask_ps(_mm_and_ps(x_overlap, y_overlap)))
+            << i;
+  }
+#elif defined(DL_RTREE_USE_NEON)
+  const float32x4_t query_left = vdupq_n_f32(query.fLeft);
+  const float32x4_t query_top = vdupq_n_f32(query.fTop);
+  const float32x4_t query_right = vdupq_n_f32(query.fRight);
+  const float32x4_t query_bottom = vdupq_n_f32(query.fBottom);
+  const uint32x4_t lane_bits = {1u, 2u, 4u, 8u};
+  for (int i = 0; i < width; i += 4) {
+    const uint32x4_t x_overlap =
+        vandq_u32(vcltq_f32(vld1q_f32(branch.left + i), query_right),
+                  vcltq_f32(query_left, vld1q_f32(branch.right + i)));
+    const uint32x4_t y_overlap =
+        vandq_u32(vcltq_f32(vld1q_f32(branch.top + i), query_bottom),
+                  vcltq_f32(query_top, vld1q_f32(branch.bottom + i)));
+    mask |= vaddvq_u32(vandq_u32(vandq_u32(x_overlap, y_overlap), lane_bits))
+            << i;
+  }
+#else
+  for (int i = 0; i < width; i++) {
+    const bool overlaps =
+        (branch.left[i] < query.fRight) & (query.fLeft < branch.right[i]) &
+        (branch.top[i] < query.fBottom) & (query.fTop < branch.bottom[i]);
+    mask |= static_cast<uint32_t>(overlaps) << i;
   }
-  FML_DCHECK(leaf_index == leaf_count);
+#endif
+  return mask;
+}
 
-  // --- Implementation note ---
-  // Many R-Tree algorithms attempt to consolidate nearby rectangles
-  // into branches of the tree in order to maximize the benefit of
-  // bounds testing against whole sub-trees. The Skia code from which
-  // this was based, though, indicated that empirical tests against a
-  // browser client showed little gains in rendering performance while
-  // costing 17% performance in bulk loading the rects into the R-Tree:
-  // https://github.com/google/skia/blob/12b6bd042f7cdffb9012c90c3b4885601fc7be95/src/core/SkRTree.cpp#L96
-  //
-  // Given that this class will most often be used to track rendering
-  // operations that were drawn in an app that performs a type of
-  // "page layout" with rendering proceeding in a linear fashion from
-  // top to bottom (and left to right or right to left), the rectangles
-  // are likely nearly sorted when they are delivered to this constructor
-  // so leaving them in their original order should show similar results
-  // to what Skia found in their empirical browser tests.
-  // ---
-
-  // Continually process the previous level (generation) of nodes,
-  // combining them into a new generation of parent groups each grouping
-  // at most |kMaxChildren| children and joining their bounds into its
-  // parent bounds.
-  // Each generation will end up reduced by a factor of up to kMaxChildren
-  // until there is just one node left, which is the root node of
-  // the R-Tree.
-  uint32_t gen_start = 0;
-  gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t gen_end = gen_start + gen_count;
-
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    FML_DCHECK(gen_end + family_count <= total_node_count);
-
-    // D here is similar to the variable in a Bresenham line algorithm where
-    // we want to slowly move |family_count| steps along the minor axis as
-    // we move |gen_count| steps along the major axis.
-    //
-    // Each inner loop increments D by family_count.
-    // The inner loop executes a total of gen_count times.
-    // Every time D exceeds 0 we subtract gen_count and move to a new parent.
-    // All told we will increment D by family_count a total of gen_count times.
-    // All told we will decrement D by gen_count a total of family_count times.
-    // This leaves D back at its starting value.
-    //
-    // We could bias/balance where the extra children are placed by varying
-    // the initial count of D from 0 to (1 - family_count), but we aren't
-    // looking at this process aesthetically so we just use 0 as an initial
-    // value. Using 0 provides a "greedy" allocation of the extra children.
-    // Bresenham also uses double the size of the steps we use here also to
-    // have better rounding of when the minor axis steps occur, but again we
-    // don't care about the distribution of the extra children.
-    int D = 0;
-
-    uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
-    while (sibling_index < gen_end) {
-      if ((D += family_count) > 0) {
-        D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
-      }
-      FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
+// Sorts the |count| leaf indices found by a search. The bulk loading groups
+// the leaves by position rather than by index, so they are found out of
+// order. The results of large queries, such as those that cover most of the
+// screen, are sorted much faster by marking them in a bitmap.
+void SortLeafIndices(int* indices, size_t count, int leaf_count) {
+  if (count < 32 || count * 256 < static_cast<size_t>(leaf_count)) {
+    std::sort(indices, indices + count);
+    return;
+  }
+  std::vector<uint64_t> bits((leaf_count + 63) / 64);
+  for (size_t i = 0; i < count; i++) {
+    bits[indices[i] >> 6] |= uint64_t{1} << (indices[i] & 63);
+  }
+  int* sorted = indices;
+  for (size_t word_index = 0; word_index < bits.size(); word_index++) {
+    for (uint64_t word = bits[word_index]; word != 0; word &= word - 1) {
+      *sorted++ = word_index * 64 + __builtin_ctzll(word);
     }
-    FML_DCHECK(D == 0);
-    FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
-    gen_start = gen_end;
-    gen_count = family_count;
   }
-  FML_DCHECK(gen_start + gen_count == total_node_count);
+  FML_DCHECK(sorted == indices + count);
 }
 
+}  // namespace
+
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   FML_DCHECK(results != nullptr);
   if (query.isEmpty()) {
     return;
   }
-  if (nodes_.size() <= 0) {
+  if (branches_.empty()) {
     FML_DCHECK(leaf_count_ == 0);
     return;
   }
-  const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
-    if (nodes_.size() == 1) {
-      FML_DCHECK(leaf_count_ == 1);
-      // The root node is the only node and it is a leaf node
-      results->push_back(0);
-    } else {
-      search(root, query, results);
-    }
+  if (bounds_.intersects(query)) {
+    const size_t first_result = results->size();
+    search(branches_.size() - 1, query, results);
+    SortLeafIndices(results->data() + first_result,
+                    results->size() - first_result, leaf_count_);
   }
 }
 
@@ -183,19 +366,19 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
-void DlRTree::search(const Node& parent,
+void DlRTree::search(uint32_t branch_index,
                      const SkRect& query,
                      std::vector<int>* results) const {
   // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
+  const Branch& branch = branches_[branch_index];
+  const bool children_are_leaves = branch_index < leaf_branch_count_;
+  uint32_t mask = IntersectingChildren(branch, query, kBranchWidth);
+  for (int i = 0; mask != 0; i++, mask >>= 1) {
+    if (mask & 1) {
+      if (children_are_leaves) {
+        results->push_back(branch.child[i]);
       } else {
-        search(node, query, results);
+        search(branch.child[i], query, results);
       }
     }
   }
@@ -206,7 +389,7 @@ const DlRegion& DlRTree::region() const {
     std::vector<SkIRect> rects;
     rects.resize(leaf_count_);
     for (int i = 0; i < leaf_count_; i++) {
-      nodes_[i].bounds.roundOut(&rects[i]);
+      leaf_bounds_[i].roundOut(&rects[i]);
     }
     region_.emplace(rects);
   }
@@ -214,11 +397,7 @@ const DlRegion& DlRTree::region() const {
 }
 
 const SkRect& DlRTree::bounds() const {
-  if (!nodes_.empty()) {
-    return nodes_.back().bounds;
-  } else {
-    return kEmpty;
-  }
+  return bounds_;
 }
 
 }  // namespace flutter
@@ -27,19 +27,20 @@ namespace flutter {
 ///   @see |searchAndConsolidateRects|
 class DlRTree : public SkRefCnt {
  private:
-  static constexpr int kMaxChildren = 11;
-
-  // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
-  struct Node {
-    SkRect bounds;
-    union {
-      struct {
-        uint32_t index;
-        uint32_t count;
-      } child;
-      int id;
-    };
+  // The number of children of each branch, which |search| tests together.
+  static constexpr int kBranchWidth = 8;
+
+  // The bounds of the children of a branch are stored as a structure of
+  // arrays so that they can be tested against a query with a few vector
+  // instructions. Unused slots hold inverted bounds that never intersect.
+  struct alignas(16) Branch {
+    SkScalar left[kBranchWidth];
+    SkScalar top[kBranchWidth];
+    SkScalar right[kBranchWidth];
+    SkScalar bottom[kBranchWidth];
+    // The branches whose children are leaves come first in |branches_|.
+    // Their children are leaf indices, those of the others branch indices.
+    uint32_t child[kBranchWidth];
   };
 
  public:
@@ -72,18 +73,17 @@ class DlRTree : public SkRefCnt {
   ///
   /// Note that the indices are internal indices of the stored data
   /// and not the index of the rectangles or ids in the constructor.
-  /// The returned indices may not themselves be in numerical order,
-  /// but they will represent the rectangles and IDs in the order in
-  /// which they were passed into the constructor. The actual rectangle
-  /// and ID associated with each index can be retrieved using the
-  /// |DlRTree::id| and |DlRTree::bounds| methods.
+  /// The returned indices are in ascending order, which is the order
+  /// in which the rectangles and IDs were passed into the constructor.
+  /// The actual rectangle and ID associated with each index can be
+  /// retrieved using the |DlRTree::id| and |DlRTree::bounds| methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].id
+               ? leaf_ids_[result_index]
                : invalid_id_;
   }
 
@@ -95,13 +95,15 @@ class DlRTree : public SkRefCnt {
   /// or an empty rect if the index is not a valid leaf node index.
   const SkRect& bounds(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].bounds
+               ? leaf_bounds_[result_index]
                : kEmpty;
   }
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) +
+           (sizeof(SkRect) + sizeof(int)) * leaf_bounds_.size() +
+           sizeof(Branch) * branches_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -111,7 +113,7 @@ class DlRTree : public SkRefCnt {
 
   /// Return the total number of nodes used in the R-Tree, both leaf
   /// and internal consolidation nodes.
-  int node_count() const { return nodes_.size(); }
+  int node_count() const { return leaf_count_ + branches_.size(); }
 
   /// Finds the rects in the tree that intersect with the query rect.
   ///
@@ -138,11 +140,15 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect kEmpty = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
+  void search(uint32_t branch_index,
               const SkRect& query,
               std::vector<int>* results) const;
 
-  std::vector<Node> nodes_;
+  std::vector<SkRect> leaf_bounds_;
+  std::vector<int> leaf_ids_;
+  std::vector<Branch> branches_;
+  uint32_t leaf_branch_count_ = 0;
+  SkRect bounds_ = kEmpty;
   int leaf_count_;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
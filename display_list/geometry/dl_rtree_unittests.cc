@@ -5,6 +5,8 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "gtest/gtest.h"
 
+#include <random>
+
 #include "third_party/skia/include/core/SkRect.h"
 
 namespace flutter {
@@ -301,6 +303,44 @@ TEST(DisplayListRTree, OverlappingRects) {
   EXPECT_EQ(list.front(), SkRect::MakeLTRB(0, 0, 70, 70));
 }
 
+TEST(DisplayListRTree, RandomRectsMatchBruteForceSearch) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> pos(0, 1000);
+  std::uniform_real_distribution<float> size(0, 100);
+  for (int count : {1, 7, 8, 9, 63, 64, 65, 511, 512, 513, 3000}) {
+    std::vector<SkRect> rects;
+    std::vector<int> rect_ids;
+    for (int i = 0; i < count; i++) {
+      rects.push_back(
+          SkRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+      rect_ids.push_back(i);
+    }
+    // An empty rect, which is never returned.
+    rects[count / 2] = SkRect::MakeXYWH(pos(rng), pos(rng), 0, 10);
+    DlRTree tree(rects.data(), count, rect_ids.data());
+
+    for (int q = 0; q < 50; q++) {
+      float extent = q < 25 ? 50 : 800;
+      auto query = SkRect::MakeXYWH(pos(rng), pos(rng), extent, extent);
+      std::vector<int> expected;
+      for (int i = 0; i < count; i++) {
+        if (!rects[i].isEmpty() && rects[i].intersects(query)) {
+          expected.push_back(i);
+        }
+      }
+      std::vector<int> results;
+      tree.search(query, &results);
+      // Leaf indices come back in ascending order, matching the order of the
+      // ids they were constructed with.
+      std::vector<int> ids;
+      for (int index : results) {
+        ids.push_back(tree.id(index));
+      }
+      ASSERT_EQ(ids, expected) << "count: " << count << ", query: " << q;
+    }
+  }
+}
+
 TEST(DisplayListRTree, Region) {
   SkRect rect[9];
   for (int i = 0; i < 9; i++) {
@@ -54,6 +54,16 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this is an Impeller image that keeps its luma and
+  ///             chroma planes in separate textures, which are only converted
+  ///             to RGB as the image is drawn. Such images are always
+  ///             `impeller::DlImageImpeller`s.
+  ///
+  /// @return     True if the image is made up of YUV planes.
+  ///
+  virtual bool isImpellerYUV() const { return false; }
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
@@ -125,6 +135,10 @@ class DlImage : public SkRefCnt {
     if (this == other) {
       return true;
     }
+    // Asking a YUV image for its texture would convert it to RGB.
+    if (isImpellerYUV() || other->isImpellerYUV()) {
+      return false;
+    }
     return skia_image() == other->skia_image() &&
            impeller_texture() == other->impeller_texture();
   }
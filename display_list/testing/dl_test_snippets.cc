@@ -566,6 +566,25 @@ std::vector<DisplayListInvocationGroup> CreateAllRenderingOps() {
               r.drawRect({0, 0, 10, 20});
             }},
        }},
+      {"DrawRects",
+       {
+           {1, 8 + 2 * 16, 2, 2 * 24,
+            [](DlOpReceiver& r) {
+              const SkRect rects[] = {{0, 0, 10, 10}, {20, 0, 30, 10}};
+              r.drawRects(rects, 2);
+            }},
+           {1, 8 + 2 * 16, 2, 2 * 24,
+            [](DlOpReceiver& r) {
+              const SkRect rects[] = {{0, 0, 10, 10}, {20, 0, 30, 20}};
+              r.drawRects(rects, 2);
+            }},
+           {1, 8 + 3 * 16, 3, 3 * 24,
+            [](DlOpReceiver& r) {
+              const SkRect rects[] = {
+                  {0, 0, 10, 10}, {20, 0, 30, 10}, {5, 5, 25, 25}};
+              r.drawRects(rects, 3);
+            }},
+       }},
       {"DrawOval",
        {
            {1, 24, 1, 24,
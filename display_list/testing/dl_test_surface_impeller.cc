@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/testing/dl_test_surface_impeller.h"
+
+#include <mutex>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/playground/switches.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "third_party/glfw/include/GLFW/glfw3.h"
+
+namespace flutter {
+namespace testing {
+
+using PixelFormat = DlSurfaceProvider::PixelFormat;
+
+static impeller::PlaygroundBackend ToPlaygroundBackend(
+    DlSurfaceProvider::BackendType backend_type) {
+  switch (backend_type) {
+    case DlSurfaceProvider::kImpellerMetalBackend:
+      return impeller::PlaygroundBackend::kMetal;
+    case DlSurfaceProvider::kImpellerOpenGLESBackend:
+      return impeller::PlaygroundBackend::kOpenGLES;
+    case DlSurfaceProvider::kImpellerVulkanBackend:
+      return impeller::PlaygroundBackend::kVulkan;
+    default:
+      FML_CHECK(false) << "Not an Impeller backend: " << backend_type;
+  }
+  FML_UNREACHABLE();
+}
+
+DlImpellerSurfaceInstance::DlImpellerSurfaceInstance(
+    std::shared_ptr<impeller::AiksContext> context,
+    impeller::RenderTarget render_target)
+    : context_(std::move(context)), render_target_(std::move(render_target)) {}
+
+DlImpellerSurfaceInstance::~DlImpellerSurfaceInstance() = default;
+
+int DlImpellerSurfaceInstance::width() const {
+  return render_target_.GetRenderTargetSize().width;
+}
+
+int DlImpellerSurfaceInstance::height() const {
+  return render_target_.GetRenderTargetSize().height;
+}
+
+// |DlSurfaceInstance|
+void DlImpellerSurfaceInstance::RenderDisplayList(
+    const sk_sp<DisplayList>& display_list) {
+  impeller::DlDispatcher dispatcher(
+      impeller::IRect::MakeSize(render_target_.GetRenderTargetSize()));
+  display_list->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+  // Encodes the entity pass into command buffers and submits them.
+  if (!context_->Render(picture, render_target_)) {
+    FML_LOG(ERROR) << "Could not render the display list with Impeller.";
+  }
+}
+
+// |DlSurfaceInstance|
+void DlImpellerSurfaceInstance::FlushSubmitCpuSync() {
+  // Command buffers complete in submission order, so once an empty one
+  // completes, so has everything rendered before it.
+  auto command_buffer = context_->GetContext()->CreateCommandBuffer();
+  if (!command_buffer) {
+    return;
+  }
+  fml::AutoResetWaitableEvent latch;
+  if (!command_buffer->SubmitCommands(
+          [&latch](impeller::CommandBuffer::Status) { latch.Signal(); })) {
+    return;
+  }
+  latch.Wait();
+}
+
+DlImpellerSurfaceProvider::DlImpellerSurfaceProvider(BackendType backend_type)
+    : backend_type_(backend_type) {}
+
+DlImpellerSurfaceProvider::~DlImpellerSurfaceProvider() {
+  primary_.reset();
+  aiks_context_.reset();
+  if (playground_ && playground_->GetContext()) {
+    playground_->GetContext()->Shutdown();
+  }
+}
+
+const std::string DlImpellerSurfaceProvider::backend_name() const {
+  auto backend = ToPlaygroundBackend(backend_type_);
+  return "Impeller" + impeller::PlaygroundBackendToString(backend);
+}
+
+bool DlImpellerSurfaceProvider::InitializeSurface(size_t width,
+                                                  size_t height,
+                                                  PixelFormat format) {
+  if (!playground_) {
+    // The contexts are made with the hidden windows of the playgrounds.
+    static std::once_flag glfw_once;
+    std::call_once(glfw_once, []() { FML_CHECK(::glfwInit() == GLFW_TRUE); });
+    playground_ = impeller::PlaygroundImpl::Create(
+        ToPlaygroundBackend(backend_type_), impeller::PlaygroundSwitches{});
+    auto context = playground_->GetContext();
+    if (!context || !context->IsValid()) {
+      FML_LOG(ERROR) << "Could not create the " << backend_name()
+                     << " context.";
+      return false;
+    }
+    aiks_context_ = std::make_shared<impeller::AiksContext>(
+        context, impeller::TypographerContextSkia::Make());
+  }
+
+  primary_ = MakeOffscreenSurface(width, height, format);
+  return primary_ != nullptr;
+}
+
+std::shared_ptr<DlSurfaceInstance>
+DlImpellerSurfaceProvider::GetPrimarySurface() const {
+  return primary_;
+}
+
+std::shared_ptr<DlSurfaceInstance>
+DlImpellerSurfaceProvider::MakeOffscreenSurface(size_t width,
+                                                size_t height,
+                                                PixelFormat format) const {
+  if (!aiks_context_ || !supports(format)) {
+    return nullptr;
+  }
+  auto context = aiks_context_->GetContext();
+  impeller::RenderTargetAllocator allocator(context->GetResourceAllocator());
+  auto render_target = impeller::RenderTarget::CreateOffscreen(
+      *context, allocator,
+      impeller::ISize(static_cast<int64_t>(width),
+                      static_cast<int64_t>(height)),
+      "Benchmark Surface");
+  if (!render_target.IsValid()) {
+    return nullptr;
+  }
+  return std::make_shared<DlImpellerSurfaceInstance>(aiks_context_,
+                                                     std::move(render_target));
+}
+
+}  // namespace testing
+}  // namespace flutter
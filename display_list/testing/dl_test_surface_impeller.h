@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_IMPELLER_H_
+#define FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_IMPELLER_H_
+
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/playground/playground_impl.h"
+#include "impeller/renderer/render_target.h"
+
+namespace flutter {
+namespace testing {
+
+//------------------------------------------------------------------------------
+/// @brief      An offscreen Impeller render target. Display lists are
+///             dispatched into an |impeller::DlDispatcher| and the resulting
+///             picture is rendered by its |impeller::EntityPass|.
+///
+///             There is no |SkSurface| behind it, so |sk_surface| returns
+///             nullptr.
+///
+class DlImpellerSurfaceInstance : public DlSurfaceInstance {
+ public:
+  DlImpellerSurfaceInstance(std::shared_ptr<impeller::AiksContext> context,
+                            impeller::RenderTarget render_target);
+
+  ~DlImpellerSurfaceInstance() override;
+
+  sk_sp<SkSurface> sk_surface() const override { return nullptr; }
+
+  int width() const override;
+
+  int height() const override;
+
+  // |DlSurfaceInstance|
+  void RenderDisplayList(const sk_sp<DisplayList>& display_list) override;
+
+  // |DlSurfaceInstance|
+  void FlushSubmitCpuSync() override;
+
+ private:
+  std::shared_ptr<impeller::AiksContext> context_;
+  impeller::RenderTarget render_target_;
+};
+
+class DlImpellerSurfaceProvider : public DlSurfaceProvider {
+ public:
+  explicit DlImpellerSurfaceProvider(BackendType backend_type);
+  virtual ~DlImpellerSurfaceProvider();
+
+  bool InitializeSurface(size_t width,
+                         size_t height,
+                         PixelFormat format) override;
+  std::shared_ptr<DlSurfaceInstance> GetPrimarySurface() const override;
+  std::shared_ptr<DlSurfaceInstance> MakeOffscreenSurface(
+      size_t width,
+      size_t height,
+      PixelFormat format) const override;
+  const std::string backend_name() const override;
+  BackendType backend_type() const override { return backend_type_; }
+  bool supports(PixelFormat format) const override {
+    return format == kN32PremulPixelFormat;
+  }
+
+  // Reading back Impeller textures isn't supported.
+  bool Snapshot(std::string& filename) const override { return false; }
+
+ private:
+  const BackendType backend_type_;
+  // Owns the context, and the hidden window some backends need for it.
+  std::unique_ptr<impeller::PlaygroundImpl> playground_;
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<DlSurfaceInstance> primary_;
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_IMPELLER_H_
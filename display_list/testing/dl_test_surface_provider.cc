@@ -4,11 +4,14 @@
 
 #include "flutter/display_list/testing/dl_test_surface_provider.h"
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
 
 #ifdef ENABLE_SOFTWARE_BENCHMARKS
 #include "flutter/display_list/testing/dl_test_surface_software.h"
@@ -19,10 +22,29 @@
 #ifdef ENABLE_METAL_BENCHMARKS
 #include "flutter/display_list/testing/dl_test_surface_metal.h"
 #endif
+#ifdef ENABLE_IMPELLER_BENCHMARKS
+#include "flutter/display_list/testing/dl_test_surface_impeller.h"
+#endif
 
 namespace flutter {
 namespace testing {
 
+void DlSurfaceInstance::RenderDisplayList(
+    const sk_sp<DisplayList>& display_list) {
+  DlSkCanvasAdapter(sk_surface()->getCanvas()).DrawDisplayList(display_list);
+}
+
+void DlSurfaceInstance::FlushSubmitCpuSync() {
+  auto surface = sk_surface();
+  if (!surface) {
+    return;
+  }
+  if (GrDirectContext* dContext =
+          GrAsDirectContext(surface->recordingContext())) {
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+  }
+}
+
 std::unique_ptr<DlSurfaceProvider> DlSurfaceProvider::Create(
     BackendType backend_type) {
   switch (backend_type) {
@@ -37,6 +59,21 @@ std::unique_ptr<DlSurfaceProvider> DlSurfaceProvider::Create(
 #ifdef ENABLE_METAL_BENCHMARKS
     case kMetalBackend:
       return std::make_unique<DlMetalSurfaceProvider>();
+#endif
+#ifdef ENABLE_IMPELLER_METAL_BENCHMARKS
+    case kImpellerMetalBackend:
+      return std::make_unique<DlImpellerSurfaceProvider>(
+          kImpellerMetalBackend);
+#endif
+#ifdef ENABLE_IMPELLER_OPENGLES_BENCHMARKS
+    case kImpellerOpenGLESBackend:
+      return std::make_unique<DlImpellerSurfaceProvider>(
+          kImpellerOpenGLESBackend);
+#endif
+#ifdef ENABLE_IMPELLER_VULKAN_BENCHMARKS
+    case kImpellerVulkanBackend:
+      return std::make_unique<DlImpellerSurfaceProvider>(
+          kImpellerVulkanBackend);
 #endif
     default:
       return nullptr;
@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
 
@@ -21,8 +22,20 @@ class DlSurfaceInstance {
 
   virtual sk_sp<SkSurface> sk_surface() const = 0;
 
-  int width() const { return sk_surface()->width(); }
-  int height() const { return sk_surface()->height(); }
+  virtual int width() const { return sk_surface()->width(); }
+  virtual int height() const { return sk_surface()->height(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the drawing of |display_list| into the surface,
+  ///             without waiting for the backend to execute it.
+  ///
+  virtual void RenderDisplayList(const sk_sp<DisplayList>& display_list);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the work encoded so far and waits until the backend
+  ///             has executed it.
+  ///
+  virtual void FlushSubmitCpuSync();
 };
 
 class DlSurfaceInstanceBase : public DlSurfaceInstance {
@@ -40,7 +53,14 @@ class DlSurfaceInstanceBase : public DlSurfaceInstance {
 class DlSurfaceProvider {
  public:
   typedef enum { kN32PremulPixelFormat, k565PixelFormat } PixelFormat;
-  typedef enum { kSoftwareBackend, kOpenGlBackend, kMetalBackend } BackendType;
+  typedef enum {
+    kSoftwareBackend,
+    kOpenGlBackend,
+    kMetalBackend,
+    kImpellerMetalBackend,
+    kImpellerOpenGLESBackend,
+    kImpellerVulkanBackend,
+  } BackendType;
 
   static SkImageInfo MakeInfo(PixelFormat format, int w, int h) {
     switch (format) {
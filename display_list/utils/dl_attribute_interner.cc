@@ -0,0 +1,14 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_attribute_interner.h"
+
+namespace flutter {
+
+size_t DlAttributeInterner::size() const {
+  return color_sources_.size() + image_filters_.size() +
+         color_filters_.size() + mask_filters_.size();
+}
+
+}  // namespace flutter
@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_INTERNER_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_INTERNER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/utils/dl_comparable.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Gives structurally equal attributes a single canonical
+///             instance.
+///
+///             Attributes created by the framework every frame, such as the
+///             gradients and filters of a widget that rebuilds, are new
+///             objects even when nothing changed. Interning them lets the
+///             caches and |Equals| checks downstream succeed on pointer
+///             equality instead of comparing contents or missing entirely.
+///
+///             The table only holds weak references, so interned attributes
+///             are freed as soon as nothing else refers to them, and it is
+///             safe to use from any thread.
+///
+class DlAttributeInterner {
+ public:
+  DlAttributeInterner() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the live attribute that is equal to |attribute|, or
+  ///             records and returns |attribute| itself if there is none.
+  ///             Null attributes are returned as is.
+  ///
+  ///             The canonical attribute has the same type as |attribute|,
+  ///             so any subclass of the attribute classes can be interned.
+  ///
+  template <class T>
+  std::shared_ptr<T> Intern(std::shared_ptr<T> attribute) {
+    if (!attribute) {
+      return attribute;
+    }
+    auto& table = TableFor<std::remove_const_t<T>>();
+    using Base = typename std::remove_reference_t<decltype(table)>::Attribute;
+    std::shared_ptr<const Base> canonical = table.Intern(attribute);
+    // Attributes are immutable, so handing out a non-const pointer to the
+    // canonical instance is no different from handing out |attribute|.
+    return std::static_pointer_cast<T>(
+        std::const_pointer_cast<Base>(canonical));
+  }
+
+  /// The number of live interned attributes, for tests and diagnostics.
+  size_t size() const;
+
+ private:
+  // Expired entries keep the memory of attributes made by make_shared, so
+  // they are swept once in this many insertions.
+  static constexpr size_t kSweepInterval = 256;
+
+  template <class D>
+  class Table {
+   public:
+    using Attribute = D;
+
+    std::shared_ptr<const D> Intern(std::shared_ptr<const D> attribute) {
+      std::scoped_lock lock(mutex_);
+      if (++insertions_ % kSweepInterval == 0) {
+        Sweep();
+      }
+      // Attributes of different types or sizes can't be equal, so they are
+      // only compared with the attributes in the same bucket.
+      auto& bucket = buckets_[Key(*attribute)];
+      for (auto it = bucket.begin(); it != bucket.end();) {
+        std::shared_ptr<const D> candidate = it->lock();
+        if (!candidate) {
+          it = bucket.erase(it);
+          continue;
+        }
+        if (Equals(candidate.get(), attribute.get())) {
+          return candidate;
+        }
+        ++it;
+      }
+      bucket.push_back(attribute);
+      return attribute;
+    }
+
+    size_t size() const {
+      std::scoped_lock lock(mutex_);
+      size_t count = 0;
+      for (const auto& [key, bucket] : buckets_) {
+        for (const auto& entry : bucket) {
+          count += entry.expired() ? 0 : 1;
+        }
+      }
+      return count;
+    }
+
+   private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::vector<std::weak_ptr<const D>>> buckets_;
+    size_t insertions_ = 0;
+
+    void Sweep() {
+      for (auto it = buckets_.begin(); it != buckets_.end();) {
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [](const std::weak_ptr<const D>& entry) {
+                                      return entry.expired();
+                                    }),
+                     bucket.end());
+        it = bucket.empty() ? buckets_.erase(it) : std::next(it);
+      }
+    }
+
+    static uint64_t Key(const D& attribute) {
+      return static_cast<uint64_t>(attribute.type()) << 32 |
+             static_cast<uint32_t>(attribute.size());
+    }
+  };
+
+  Table<DlColorSource> color_sources_;
+  Table<DlImageFilter> image_filters_;
+  Table<DlColorFilter> color_filters_;
+  Table<DlMaskFilter> mask_filters_;
+
+  template <class T>
+  auto& TableFor() {
+    if constexpr (std::is_base_of_v<DlColorSource, T>) {
+      return color_sources_;
+    } else if constexpr (std::is_base_of_v<DlImageFilter, T>) {
+      return image_filters_;
+    } else if constexpr (std::is_base_of_v<DlColorFilter, T>) {
+      return color_filters_;
+    } else {
+      static_assert(std::is_base_of_v<DlMaskFilter, T>,
+                    "Only color sources, image and color filters and mask "
+                    "filters can be interned.");
+      return mask_filters_;
+    }
+  }
+
+  DlAttributeInterner(const DlAttributeInterner&) = delete;
+  DlAttributeInterner& operator=(const DlAttributeInterner&) = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_INTERNER_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_attribute_interner.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::shared_ptr<DlColorSource> MakeGradient(DlColor end_color) {
+  const DlColor colors[] = {DlColor::kRed(), end_color};
+  const float stops[] = {0.0f, 1.0f};
+  return DlColorSource::MakeLinear(SkPoint::Make(0, 0), SkPoint::Make(10, 10),
+                                   2, colors, stops, DlTileMode::kClamp);
+}
+
+TEST(DisplayListAttributeInterner, EqualAttributesShareOneInstance) {
+  DlAttributeInterner interner;
+  auto first = interner.Intern(MakeGradient(DlColor::kBlue()));
+  auto second = interner.Intern(MakeGradient(DlColor::kBlue()));
+  EXPECT_EQ(first.get(), second.get());
+
+  auto blur =
+      interner.Intern(DlBlurImageFilter::Make(5, 5, DlTileMode::kClamp));
+  auto same_blur =
+      interner.Intern(DlBlurImageFilter::Make(5, 5, DlTileMode::kClamp));
+  EXPECT_EQ(blur.get(), same_blur.get());
+
+  auto mask = interner.Intern(DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 3));
+  auto same_mask =
+      interner.Intern(DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 3));
+  EXPECT_EQ(mask.get(), same_mask.get());
+
+  EXPECT_EQ(interner.size(), 3u);
+}
+
+TEST(DisplayListAttributeInterner, DifferentAttributesStayDistinct) {
+  DlAttributeInterner interner;
+  auto blue = interner.Intern(MakeGradient(DlColor::kBlue()));
+  auto green = interner.Intern(MakeGradient(DlColor::kGreen()));
+  EXPECT_NE(blue.get(), green.get());
+  EXPECT_EQ(*blue, *MakeGradient(DlColor::kBlue()));
+  EXPECT_EQ(*green, *MakeGradient(DlColor::kGreen()));
+
+  auto blend = interner.Intern(
+      DlBlendColorFilter::Make(DlColor::kRed(), DlBlendMode::kSrcOver));
+  auto other_blend = interner.Intern(
+      DlBlendColorFilter::Make(DlColor::kRed(), DlBlendMode::kMultiply));
+  EXPECT_NE(blend.get(), other_blend.get());
+
+  EXPECT_EQ(interner.size(), 4u);
+}
+
+TEST(DisplayListAttributeInterner, KeepsSubclassTypes) {
+  DlAttributeInterner interner;
+  std::shared_ptr<DlBlurImageFilter> blur =
+      std::make_shared<DlBlurImageFilter>(2, 2, DlTileMode::kDecal);
+  std::shared_ptr<DlBlurImageFilter> canonical = interner.Intern(blur);
+  EXPECT_EQ(canonical.get(), blur.get());
+
+  std::shared_ptr<const DlImageFilter> same_blur =
+      interner.Intern(DlBlurImageFilter::Make(2, 2, DlTileMode::kDecal));
+  EXPECT_EQ(same_blur.get(), blur.get());
+}
+
+TEST(DisplayListAttributeInterner, ReleasedAttributesAreForgotten) {
+  DlAttributeInterner interner;
+  auto blue = interner.Intern(MakeGradient(DlColor::kBlue()));
+  EXPECT_EQ(interner.size(), 1u);
+  blue.reset();
+  EXPECT_EQ(interner.size(), 0u);
+
+  // Many short lived attributes don't accumulate in the table.
+  for (int i = 0; i < 1000; i++) {
+    interner.Intern(DlBlurMaskFilter::Make(DlBlurStyle::kNormal, i + 1));
+  }
+  EXPECT_EQ(interner.size(), 0u);
+}
+
+TEST(DisplayListAttributeInterner, NullAttributesPassThrough) {
+  DlAttributeInterner interner;
+  EXPECT_EQ(interner.Intern(std::shared_ptr<DlColorSource>()), nullptr);
+  EXPECT_EQ(interner.Intern(std::shared_ptr<const DlImageFilter>()), nullptr);
+  EXPECT_EQ(interner.size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
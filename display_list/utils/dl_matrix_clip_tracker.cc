@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/fml/logging.h"
 
@@ -18,6 +20,7 @@ class Data4x4 : public DisplayListMatrixClipTracker::Data {
   ~Data4x4() override = default;
 
   bool is_4x4() const override { return true; }
+  bool is_scale_translate() const override { return false; }
 
   SkMatrix matrix_3x3() const override { return m44_.asM33(); }
   SkM44 matrix_4x4() const override { return m44_; }
@@ -60,6 +63,7 @@ class Data3x3 : public DisplayListMatrixClipTracker::Data {
   ~Data3x3() override = default;
 
   bool is_4x4() const override { return false; }
+  bool is_scale_translate() const override { return false; }
 
   SkMatrix matrix_3x3() const override { return matrix_; }
   SkM44 matrix_4x4() const override { return SkM44(matrix_); }
@@ -92,6 +96,108 @@ class Data3x3 : public DisplayListMatrixClipTracker::Data {
   SkMatrix matrix_;
 };
 
+// Holds a matrix that only scales and translates, which is by far the most
+// common kind of transform seen while recording, as 4 scalars so that the
+// transform and cull operations can skip the general matrix math. The
+// tracker replaces it with a Data3x3 or a Data4x4 as soon as any other
+// kind of transform is applied.
+class DataScaleTranslate : public DisplayListMatrixClipTracker::Data {
+ public:
+  DataScaleTranslate(const SkMatrix& matrix, const SkRect& rect)
+      : Data(rect),
+        sx_(matrix.getScaleX()),
+        sy_(matrix.getScaleY()),
+        tx_(matrix.getTranslateX()),
+        ty_(matrix.getTranslateY()) {
+    FML_DCHECK(matrix.isScaleTranslate());
+  }
+  DataScaleTranslate(const DataScaleTranslate& copy) = default;
+
+  ~DataScaleTranslate() override = default;
+
+  bool is_4x4() const override { return false; }
+  bool is_scale_translate() const override { return true; }
+
+  SkMatrix matrix_3x3() const override {
+    // clang-format off
+    return SkMatrix::MakeAll(sx_, 0,   tx_,
+                             0,   sy_, ty_,
+                             0,   0,   1);
+    // clang-format on
+  }
+  SkM44 matrix_4x4() const override {
+    // clang-format off
+    return SkM44(sx_, 0,   0, tx_,
+                 0,   sy_, 0, ty_,
+                 0,   0,   1, 0,
+                 0,   0,   0, 1);
+    // clang-format on
+  }
+  SkRect local_cull_rect() const override;
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    tx_ += sx_ * tx;
+    ty_ += sy_ * ty;
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    sx_ *= sx;
+    sy_ *= sy;
+  }
+  void skew(SkScalar skx, SkScalar sky) override {
+    FML_CHECK(false) << "Skew was applied without upgrading Data";
+  }
+  void rotate(SkScalar degrees) override {
+    FML_CHECK(false) << "Rotation was applied without upgrading Data";
+  }
+  void transform(const SkMatrix& matrix) override {
+    FML_DCHECK(matrix.isScaleTranslate());
+    tx_ += sx_ * matrix.getTranslateX();
+    ty_ += sy_ * matrix.getTranslateY();
+    sx_ *= matrix.getScaleX();
+    sy_ *= matrix.getScaleY();
+  }
+  void transform(const SkM44& m44) override {
+    FML_CHECK(false) << "SkM44 was concatenated without upgrading Data";
+  }
+  void setTransform(const SkMatrix& matrix) override {
+    FML_DCHECK(matrix.isScaleTranslate());
+    sx_ = matrix.getScaleX();
+    sy_ = matrix.getScaleY();
+    tx_ = matrix.getTranslateX();
+    ty_ = matrix.getTranslateY();
+  }
+  void setTransform(const SkM44& m44) override {
+    FML_CHECK(false) << "SkM44 was set without upgrading Data";
+  }
+  void setIdentity() override {
+    sx_ = sy_ = 1;
+    tx_ = ty_ = 0;
+  }
+  bool mapRect(const SkRect& rect, SkRect* mapped) const override {
+    SkScalar x0 = rect.fLeft * sx_ + tx_;
+    SkScalar x1 = rect.fRight * sx_ + tx_;
+    SkScalar y0 = rect.fTop * sy_ + ty_;
+    SkScalar y1 = rect.fBottom * sy_ + ty_;
+    mapped->setLTRB(std::min(x0, x1), std::min(y0, y1),  //
+                    std::max(x0, x1), std::max(y0, y1));
+    return sx_ != 0 && sy_ != 0;
+  }
+  bool canBeInverted() const override {
+    return sx_ != 0 && sy_ != 0 &&  //
+           SkScalarsAreFinite(1 / sx_, 1 / sy_) &&
+           SkScalarsAreFinite(tx_, ty_);
+  }
+
+ protected:
+  bool has_perspective() const override { return false; }
+
+ private:
+  SkScalar sx_;
+  SkScalar sy_;
+  SkScalar tx_;
+  SkScalar ty_;
+};
+
 bool DisplayListMatrixClipTracker::is_3x3(const SkM44& m) {
   // clang-format off
   return (                                      m.rc(0, 2) == 0 &&
@@ -107,7 +213,11 @@ DisplayListMatrixClipTracker::DisplayListMatrixClipTracker(
     : original_cull_rect_(cull_rect) {
   // isEmpty protects us against NaN as we normalize any empty cull rects
   SkRect cull = cull_rect.isEmpty() ? SkRect::MakeEmpty() : cull_rect;
-  saved_.emplace_back(std::make_unique<Data3x3>(matrix, cull));
+  if (matrix.isScaleTranslate()) {
+    saved_.emplace_back(std::make_unique<DataScaleTranslate>(matrix, cull));
+  } else {
+    saved_.emplace_back(std::make_unique<Data3x3>(matrix, cull));
+  }
   current_ = saved_.back().get();
   save();  // saved_[0] will always be the initial settings
 }
@@ -119,7 +229,12 @@ DisplayListMatrixClipTracker::DisplayListMatrixClipTracker(
   // isEmpty protects us against NaN as we normalize any empty cull rects
   SkRect cull = cull_rect.isEmpty() ? SkRect::MakeEmpty() : cull_rect;
   if (is_3x3(m44)) {
-    saved_.emplace_back(std::make_unique<Data3x3>(m44.asM33(), cull));
+    SkMatrix matrix = m44.asM33();
+    if (matrix.isScaleTranslate()) {
+      saved_.emplace_back(std::make_unique<DataScaleTranslate>(matrix, cull));
+    } else {
+      saved_.emplace_back(std::make_unique<Data3x3>(matrix, cull));
+    }
   } else {
     saved_.emplace_back(std::make_unique<Data4x4>(m44, cull));
   }
@@ -169,6 +284,9 @@ void DisplayListMatrixClipTracker::transformFullPerspective(
 void DisplayListMatrixClipTracker::save() {
   if (current_->is_4x4()) {
     saved_.emplace_back(std::make_unique<Data4x4>(current_));
+  } else if (current_->is_scale_translate()) {
+    saved_.emplace_back(std::make_unique<DataScaleTranslate>(
+        *static_cast<DataScaleTranslate*>(current_)));
   } else {
     saved_.emplace_back(std::make_unique<Data3x3>(current_));
   }
@@ -200,10 +318,65 @@ void DisplayListMatrixClipTracker::restoreToCount(int restore_count) {
   }
 }
 
+void DisplayListMatrixClipTracker::promoteTo3x3() {
+  saved_.back() = std::make_unique<Data3x3>(current_);
+  current_ = saved_.back().get();
+}
+
+void DisplayListMatrixClipTracker::skew(SkScalar skx, SkScalar sky) {
+  if (current_->is_scale_translate()) {
+    promoteTo3x3();
+  }
+  current_->skew(skx, sky);
+}
+
+void DisplayListMatrixClipTracker::rotate(SkScalar degrees) {
+  if (current_->is_scale_translate()) {
+    promoteTo3x3();
+  }
+  current_->rotate(degrees);
+}
+
+void DisplayListMatrixClipTracker::transform(const SkMatrix& matrix) {
+  if (current_->is_scale_translate() && !matrix.isScaleTranslate()) {
+    promoteTo3x3();
+  }
+  current_->transform(matrix);
+}
+
+void DisplayListMatrixClipTracker::setTransform(const SkMatrix& matrix) {
+  if (current_->is_4x4()) {
+    current_->setTransform(matrix);
+  } else if (matrix.isScaleTranslate()) {
+    // Return to the fast representation if the entry was promoted by an
+    // earlier transform that this one replaces.
+    if (!current_->is_scale_translate()) {
+      saved_.back() = std::make_unique<DataScaleTranslate>(
+          matrix, current_->device_cull_rect());
+      current_ = saved_.back().get();
+    } else {
+      current_->setTransform(matrix);
+    }
+  } else {
+    if (current_->is_scale_translate()) {
+      promoteTo3x3();
+    }
+    current_->setTransform(matrix);
+  }
+}
+
+void DisplayListMatrixClipTracker::setIdentity() {
+  if (current_->is_4x4()) {
+    current_->setIdentity();
+  } else {
+    setTransform(SkMatrix::I());
+  }
+}
+
 void DisplayListMatrixClipTracker::transform(const SkM44& m44) {
   if (!current_->is_4x4()) {
     if (is_3x3(m44)) {
-      current_->transform(m44.asM33());
+      transform(m44.asM33());
       return;
     }
     saved_.back() = std::make_unique<Data4x4>(current_);
@@ -215,7 +388,7 @@ void DisplayListMatrixClipTracker::transform(const SkM44& m44) {
 void DisplayListMatrixClipTracker::setTransform(const SkM44& m44) {
   if (!current_->is_4x4()) {
     if (is_3x3(m44)) {
-      current_->setTransform(m44.asM33());
+      setTransform(m44.asM33());
       return;
     }
     saved_.back() = std::make_unique<Data4x4>(current_);
@@ -427,4 +600,25 @@ SkRect Data3x3::local_cull_rect() const {
   return inverse.mapRect(cull_rect_);
 }
 
+SkRect DataScaleTranslate::local_cull_rect() const {
+  if (cull_rect_.isEmpty()) {
+    return cull_rect_;
+  }
+  if (!canBeInverted()) {
+    return SkRect::MakeEmpty();
+  }
+  // Invert the same way that SkMatrix::invert does for this kind of matrix
+  // so that the results match those of the other representations exactly.
+  SkScalar inv_sx = 1 / sx_;
+  SkScalar inv_sy = 1 / sy_;
+  SkScalar inv_tx = -tx_ * inv_sx;
+  SkScalar inv_ty = -ty_ * inv_sy;
+  SkScalar x0 = cull_rect_.fLeft * inv_sx + inv_tx;
+  SkScalar x1 = cull_rect_.fRight * inv_sx + inv_tx;
+  SkScalar y0 = cull_rect_.fTop * inv_sy + inv_ty;
+  SkScalar y1 = cull_rect_.fBottom * inv_sy + inv_ty;
+  return SkRect::MakeLTRB(std::min(x0, x1), std::min(y0, y1),  //
+                          std::max(x0, x1), std::max(y0, y1));
+}
+
 }  // namespace flutter
@@ -45,6 +45,9 @@ class DisplayListMatrixClipTracker {
   SkRect base_device_cull_rect() const { return saved_[0]->device_cull_rect(); }
 
   bool using_4x4_matrix() const { return current_->is_4x4(); }
+  bool using_scale_translate_matrix() const {
+    return current_->is_scale_translate();
+  }
 
   SkM44 matrix_4x4() const { return current_->matrix_4x4(); }
   SkMatrix matrix_3x3() const { return current_->matrix_3x3(); }
@@ -67,10 +70,10 @@ class DisplayListMatrixClipTracker {
 
   void translate(SkScalar tx, SkScalar ty) { current_->translate(tx, ty); }
   void scale(SkScalar sx, SkScalar sy) { current_->scale(sx, sy); }
-  void skew(SkScalar skx, SkScalar sky) { current_->skew(skx, sky); }
-  void rotate(SkScalar degrees) { current_->rotate(degrees); }
+  void skew(SkScalar skx, SkScalar sky);
+  void rotate(SkScalar degrees);
   void transform(const SkM44& m44);
-  void transform(const SkMatrix& matrix) { current_->transform(matrix); }
+  void transform(const SkMatrix& matrix);
   // clang-format off
   void transform2DAffine(
       SkScalar mxx, SkScalar mxy, SkScalar mxt,
@@ -81,9 +84,9 @@ class DisplayListMatrixClipTracker {
       SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
       SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt);
   // clang-format on
-  void setTransform(const SkMatrix& matrix) { current_->setTransform(matrix); }
+  void setTransform(const SkMatrix& matrix);
   void setTransform(const SkM44& m44);
-  void setIdentity() { current_->setIdentity(); }
+  void setIdentity();
   bool mapRect(SkRect* rect) const { return current_->mapRect(*rect, rect); }
 
   void clipRect(const SkRect& rect, ClipOp op, bool is_aa) {
@@ -98,6 +101,7 @@ class DisplayListMatrixClipTracker {
     virtual ~Data() = default;
 
     virtual bool is_4x4() const = 0;
+    virtual bool is_scale_translate() const = 0;
 
     virtual SkMatrix matrix_3x3() const = 0;
     virtual SkM44 matrix_4x4() const = 0;
@@ -130,9 +134,14 @@ class DisplayListMatrixClipTracker {
 
     SkRect cull_rect_;
   };
+  friend class DataScaleTranslate;
   friend class Data3x3;
   friend class Data4x4;
 
+  // Replaces the current entry with a Data3x3 holding the same state so
+  // that it can take on transforms that are not a scale and translate.
+  void promoteTo3x3();
+
   SkRect original_cull_rect_;
   Data* current_;
   std::vector<std::unique_ptr<Data>> saved_;
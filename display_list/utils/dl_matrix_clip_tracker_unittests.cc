@@ -448,5 +448,107 @@ TEST(DisplayListMatrixClipTracker, DiffClipPathWithInvertFillType) {
   ASSERT_EQ(tracker.device_cull_rect(), clip_bounds);
 }
 
+TEST(DisplayListMatrixClipTracker, ScaleTranslateMatchesGeneralMatrix) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  const SkRect clip = SkRect::MakeLTRB(3.3, -7.1, 12.7, 9.9);
+  const SkRect content = SkRect::MakeLTRB(-2.5, 1.25, 4.75, 8.5);
+
+  DisplayListMatrixClipTracker tracker(cull_rect, SkMatrix::I());
+  SkMatrix expected_matrix;
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+
+  tracker.translate(10.5, 7.25);
+  expected_matrix.preTranslate(10.5, 7.25);
+  tracker.scale(2.5, -1.5);
+  expected_matrix.preScale(2.5, -1.5);
+  tracker.transform(SkMatrix::Translate(-3.125, 4.5));
+  expected_matrix.preConcat(SkMatrix::Translate(-3.125, 4.5));
+  tracker.clipRect(clip, DlCanvas::ClipOp::kIntersect, false);
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+
+  SkRect expected_device_cull_rect = expected_matrix.mapRect(clip);
+  ASSERT_TRUE(expected_device_cull_rect.intersect(cull_rect));
+  SkMatrix inverse;
+  ASSERT_TRUE(expected_matrix.invert(&inverse));
+
+  ASSERT_EQ(tracker.matrix_3x3(), expected_matrix);
+  ASSERT_EQ(tracker.matrix_4x4(), SkM44(expected_matrix));
+  ASSERT_EQ(tracker.device_cull_rect(), expected_device_cull_rect);
+  ASSERT_EQ(tracker.local_cull_rect(),
+            inverse.mapRect(expected_device_cull_rect));
+  SkRect mapped = content;
+  ASSERT_TRUE(tracker.mapRect(&mapped));
+  ASSERT_EQ(mapped, expected_matrix.mapRect(content));
+}
+
+TEST(DisplayListMatrixClipTracker, ScaleTranslatePromotesTo3x3) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  const SkMatrix matrix = SkMatrix::Scale(4, 4);
+
+  DisplayListMatrixClipTracker tracker(cull_rect, matrix);
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+
+  tracker.save();
+  tracker.translate(5, 1);
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+  tracker.rotate(90);
+  ASSERT_FALSE(tracker.using_scale_translate_matrix());
+  ASSERT_FALSE(tracker.using_4x4_matrix());
+  const SkMatrix translated =
+      SkMatrix::Concat(matrix, SkMatrix::Translate(5, 1));
+  ASSERT_EQ(tracker.matrix_3x3(),
+            SkMatrix::Concat(translated, SkMatrix::RotateDeg(90)));
+
+  tracker.restore();
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+  ASSERT_EQ(tracker.matrix_3x3(), matrix);
+
+  tracker.save();
+  tracker.skew(.25, 0);
+  ASSERT_FALSE(tracker.using_scale_translate_matrix());
+  ASSERT_EQ(tracker.matrix_3x3(),
+            SkMatrix::Concat(matrix, SkMatrix::Skew(.25, 0)));
+
+  // Setting a scale and translate again returns to the fast path.
+  tracker.setTransform(SkMatrix::Translate(3, 4));
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+  ASSERT_EQ(tracker.matrix_3x3(), SkMatrix::Translate(3, 4));
+  tracker.restore();
+
+  // A 3x3 SkM44 can still be concatenated without going to 4x4.
+  tracker.transform(SkM44(SkMatrix::RotateDeg(45)));
+  ASSERT_FALSE(tracker.using_scale_translate_matrix());
+  ASSERT_FALSE(tracker.using_4x4_matrix());
+  ASSERT_EQ(tracker.matrix_3x3(),
+            SkMatrix::Concat(matrix, SkMatrix::RotateDeg(45)));
+}
+
+TEST(DisplayListMatrixClipTracker, ScaleTranslatePromotesTo4x4) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  // clang-format off
+  const SkM44 m44 = SkM44(4, 0, 0.5, 0,
+                          0, 4, 0.5, 0,
+                          0, 0, 4.0, 0,
+                          0, 0, 0.0, 1);
+  // clang-format on
+
+  DisplayListMatrixClipTracker tracker(cull_rect, SkMatrix::Translate(5, 5));
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+
+  tracker.transform(m44);
+  ASSERT_FALSE(tracker.using_scale_translate_matrix());
+  ASSERT_TRUE(tracker.using_4x4_matrix());
+  ASSERT_EQ(tracker.matrix_4x4(), SkM44::Translate(5, 5) * m44);
+}
+
+TEST(DisplayListMatrixClipTracker, ScaleTranslateWithZeroScaleCullsContent) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+
+  DisplayListMatrixClipTracker tracker(cull_rect, SkMatrix::Scale(0, 1));
+  ASSERT_TRUE(tracker.using_scale_translate_matrix());
+  ASSERT_TRUE(tracker.local_cull_rect().isEmpty());
+  ASSERT_TRUE(tracker.content_culled(SkRect::MakeLTRB(0, 0, 100, 100)));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -7,10 +7,15 @@
 #include <optional>
 #include <utility>
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
 
+// The most paint region maps of earlier frames that incremental diffing lets
+// a layer tree depend on before it copies the regions to its own map again.
+static constexpr size_t kMaxRetainedPaintRegionMaps = 16;
+
 std::optional<SkRect> FrameDamage::ComputeClipRect(
     flutter::LayerTree& layer_tree,
     bool has_raster_cache,
@@ -21,8 +26,10 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
                         has_raster_cache, impeller_enabled);
+    context.SetTextureRegistry(texture_registry_);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
+    RetainedPaintRegionMaps retained_maps;
     {
       DiffContext::AutoSubtreeRestore subtree(&context);
       const Layer* prev_root_layer = nullptr;
@@ -34,6 +41,22 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
             layer_tree.frame_size().width(), layer_tree.frame_size().height()));
       } else {
         prev_root_layer = prev_layer_tree_->root_layer();
+        const RetainedPaintRegionMaps& prev_retained_maps =
+            prev_layer_tree_->retained_paint_region_maps();
+        context.SetLastFrameRetainedPaintRegionMaps(&prev_retained_maps);
+        if (prev_layer_tree_ == &layer_tree) {
+          // The regions are updated in place, so the maps that hold the
+          // retained subtrees stay the same.
+          retained_maps = prev_retained_maps;
+          context.SetIncremental(incremental_diff_);
+        } else if (incremental_diff_ && prev_retained_maps.size() <
+                                            kMaxRetainedPaintRegionMaps) {
+          retained_maps.reserve(prev_retained_maps.size() + 1);
+          retained_maps.push_back(prev_layer_tree_->shared_paint_region_map());
+          retained_maps.insert(retained_maps.end(), prev_retained_maps.begin(),
+                               prev_retained_maps.end());
+          context.SetIncremental(true);
+        }
       }
       layer_tree.root_layer()->Diff(&context, prev_root_layer);
     }
@@ -41,6 +64,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
                               vertical_clip_alignment_);
+    layer_tree.set_retained_paint_region_maps(std::move(retained_maps));
     return SkRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
@@ -49,12 +73,14 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
 CompositorContext::CompositorContext()
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(fixed_refresh_rate_updater_),
-      ui_time_(fixed_refresh_rate_updater_) {}
+      ui_time_(fixed_refresh_rate_updater_),
+      gpu_time_(fixed_refresh_rate_updater_) {}
 
 CompositorContext::CompositorContext(Stopwatch::RefreshRateUpdater& updater)
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(updater),
-      ui_time_(updater) {}
+      ui_time_(updater),
+      gpu_time_(updater) {}
 
 CompositorContext::~CompositorContext() = default;
 
@@ -63,6 +89,7 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
   if (enable_instrumentation) {
     raster_time_.Start();
   }
+  active_frame_count_++;
 }
 
 void CompositorContext::EndFrame(ScopedFrame& frame,
@@ -70,6 +97,20 @@ void CompositorContext::EndFrame(ScopedFrame& frame,
   if (enable_instrumentation) {
     raster_time_.Stop();
   }
+  FML_DCHECK(active_frame_count_ > 0);
+  if (--active_frame_count_ == 0) {
+#if !FLUTTER_RELEASE
+    const auto& stats = frame_arena_.GetStats();
+    FML_TRACE_COUNTER("flutter",                                    //
+                      "FrameArena", reinterpret_cast<int64_t>(this),  //
+                      "Allocations", stats.allocation_count,          //
+                      "BytesAllocated", stats.bytes_allocated,        //
+                      "BytesReserved", stats.bytes_reserved,          //
+                      "SystemAllocations", stats.block_allocation_count);
+#endif  // !FLUTTER_RELEASE
+    frame_arena_.Reset();
+    offscreen_surface_pool_.EndFrame();
+  }
 }
 
 std::unique_ptr<CompositorContext::ScopedFrame> CompositorContext::AcquireFrame(
@@ -122,6 +163,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
   std::optional<SkRect> clip_rect;
   if (frame_damage) {
+    frame_damage->SetTextureRegistry(context_.texture_registry().get());
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
 
@@ -225,11 +267,13 @@ bool CompositorContext::ShouldPerformPartialRepaint(
 void CompositorContext::OnGrContextCreated() {
   texture_registry_->OnGrContextCreated();
   raster_cache_.Clear();
+  offscreen_surface_pool_.Clear();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_->OnGrContextDestroyed();
   raster_cache_.Clear();
+  offscreen_surface_pool_.Clear();
 }
 
 }  // namespace flutter
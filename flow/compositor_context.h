@@ -12,8 +12,11 @@
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/layer_snapshot_store.h"
+#include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
+#include "flutter/fml/arena.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -72,6 +75,18 @@ class FrameDamage {
     additional_damage_.join(damage);
   }
 
+  // Makes the diff skip retained subtrees without copying their paint regions
+  // to the paint region map of the new layer tree. The layer tree instead
+  // shares the maps of earlier frames that hold them, and a full copy is
+  // only made once every few frames to drop the maps that piled up.
+  void SetIncrementalDiff(bool incremental) { incremental_diff_ = incremental; }
+
+  // Lets texture layers whose texture has no new frame stay undamaged. The
+  // registry must outlive the calls to |ComputeClipRect|.
+  void SetTextureRegistry(TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
   // Specifies clip rect alignment.
   void SetClipAlignment(int horizontal, int vertical) {
     horizontal_clip_alignment_ = horizontal;
@@ -112,6 +127,8 @@ class FrameDamage {
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
   bool ignore_damage_ = false;
+  bool incremental_diff_ = false;
+  TextureRegistry* texture_registry_ = nullptr;
 };
 
 class CompositorContext {
@@ -203,14 +220,67 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  /// The time the GPU spent on recent frames. Its laps are set as the GPU
+  /// timestamps of the frames come back, which is a few frames late.
+  const Stopwatch& gpu_time() const { return gpu_time_; }
+
+  /// Whether |gpu_time| has been set for any frame.
+  bool has_gpu_time() const { return has_gpu_time_; }
+
+  void SetGpuTime(fml::TimeDelta gpu_time) {
+    gpu_time_.SetLapTime(gpu_time);
+    has_gpu_time_ = true;
+  }
+
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  /// Recycles the offscreen surfaces that layers create while painting a
+  /// frame. Unused surfaces are released a few frames after they are
+  /// returned.
+  OffscreenSurfacePool& offscreen_surface_pool() {
+    return offscreen_surface_pool_;
+  }
+
+  /// An arena for transient allocations made while rasterizing a frame. It is
+  /// reset when the outermost |ScopedFrame| is destroyed, so anything
+  /// allocated in it must not outlive the frame.
+  fml::Arena& frame_arena() { return frame_arena_; }
+
+  /// The worker pool that |LayerTree::Preroll| uses to prepare the raster
+  /// cache decisions of wide layer trees concurrently, or null, which is the
+  /// default, to preroll entirely on the raster thread.
+  const std::shared_ptr<fml::ConcurrentTaskRunner>& preroll_task_runner()
+      const {
+    return preroll_task_runner_;
+  }
+
+  void SetPrerollTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+    preroll_task_runner_ = std::move(task_runner);
+  }
+
+  /// Whether frames rasterized without the raster cache skip the preroll of
+  /// subtrees that were prerolled in the same state before, see
+  /// |PrerollContext::reuse_retained_prerolls|. Off by default.
+  bool reuse_retained_prerolls() const { return reuse_retained_prerolls_; }
+
+  void SetReuseRetainedPrerolls(bool reuse) {
+    reuse_retained_prerolls_ = reuse;
+  }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  Stopwatch gpu_time_;
+  bool has_gpu_time_ = false;
   LayerSnapshotStore layer_snapshot_store_;
+  OffscreenSurfacePool offscreen_surface_pool_;
+  fml::Arena frame_arena_;
+  size_t active_frame_count_ = 0;
+  std::shared_ptr<fml::ConcurrentTaskRunner> preroll_task_runner_;
+  bool reuse_retained_prerolls_ = false;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -248,6 +248,10 @@ void DiffContext::AddDamage(const SkRect& rect) {
   damage_.join(rect);
 }
 
+bool DiffContext::IsDamaged(const SkIRect& rect) const {
+  return damage_.intersects(SkRect::Make(rect));
+}
+
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
                                       const PaintRegion& region) {
   this_frame_paint_region_map_[layer->unique_id()] = region;
@@ -257,11 +261,18 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   auto i = last_frame_paint_region_map_.find(layer->unique_id());
   if (i != last_frame_paint_region_map_.end()) {
     return i->second;
-  } else {
-    // This is valid when Layer::PreservePaintRegion is called for retained
-    // layer with zero sized parent clip (these layers are not diffed)
-    return PaintRegion();
   }
+  if (last_frame_retained_maps_) {
+    for (const auto& map : *last_frame_retained_maps_) {
+      auto retained = map->find(layer->unique_id());
+      if (retained != map->end()) {
+        return retained->second;
+      }
+    }
+  }
+  // This is valid when Layer::PreservePaintRegion is called for retained
+  // layer with zero sized parent clip (these layers are not diffed)
+  return PaintRegion();
 }
 
 void DiffContext::Statistics::LogStatistics() {
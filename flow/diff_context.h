@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include "display_list/utils/dl_matrix_clip_tracker.h"
@@ -19,6 +20,7 @@
 namespace flutter {
 
 class Layer;
+class TextureRegistry;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
 // area that is going to be painted to in back buffer (buffer_damage).
@@ -40,6 +42,12 @@ struct Damage {
 // Layer Unique Id to PaintRegion
 using PaintRegionMap = std::map<uint64_t, PaintRegion>;
 
+// The paint region maps of earlier frames that hold the paint regions of
+// retained subtrees which have not been diffed since, newest first. See
+// DiffContext::SetIncremental.
+using RetainedPaintRegionMaps =
+    std::vector<std::shared_ptr<const PaintRegionMap>>;
+
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
  public:
@@ -147,6 +155,11 @@ class DiffContext {
   // of diffing the layer its paint region is direcly added to damage.
   void AddDamage(const PaintRegion& damage);
 
+  // Whether the damage added so far intersects the rect, which is in screen
+  // coordinates. As layers are diffed in paint order, this tells whether
+  // anything painted before the current layer changed within the rect.
+  bool IsDamaged(const SkIRect& rect) const;
+
   // Associates the paint region with specified layer and current layer tree.
   // The paint region can not be stored directly in layer itself, because same
   // retained layer instance can possibly paint in different locations depending
@@ -157,6 +170,23 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Specifies the maps in which the previous frame layer tree keeps the paint
+  // regions of its retained subtrees. |GetOldLayerPaintRegion| looks for
+  // layers that are not in the last frame paint region map in these. The
+  // maps must outlive the diff.
+  void SetLastFrameRetainedPaintRegionMaps(
+      const RetainedPaintRegionMaps* retained_maps) {
+    last_frame_retained_maps_ = retained_maps;
+  }
+
+  // In incremental mode the paint regions of retained subtrees are not copied
+  // to the paint region map of this frame. The layer tree must instead keep
+  // the last frame paint region map and its retained maps so that later
+  // frames can find them, which makes skipping a retained subtree O(1).
+  void SetIncremental(bool incremental) { incremental_ = incremental; }
+
+  bool is_incremental() const { return incremental_; }
+
   // Whether or not a raster cache is being used. If so, we must snap
   // all transformations to physical pixels if the layer may be raster
   // cached.
@@ -164,6 +194,15 @@ class DiffContext {
 
   bool impeller_enabled() const { return impeller_enabled_; }
 
+  // The registry of the textures painted by the layer tree, which lets
+  // texture layers find out whether their texture has a new frame. Without
+  // it every texture layer is considered dirty.
+  void SetTextureRegistry(TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
+  TextureRegistry* texture_registry() const { return texture_registry_; }
+
   class Statistics {
    public:
     // Picture replaced by different picture
@@ -247,8 +286,11 @@ class DiffContext {
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
+  const RetainedPaintRegionMaps* last_frame_retained_maps_ = nullptr;
+  bool incremental_ = false;
   bool has_raster_cache_;
   bool impeller_enabled_;
+  TextureRegistry* texture_registry_ = nullptr;
 
   void AddDamage(const SkRect& rect);
 
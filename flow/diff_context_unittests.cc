@@ -4,6 +4,10 @@
 
 #include "flutter/flow/testing/diff_context_test.h"
 
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
+
 namespace flutter {
 namespace testing {
 
@@ -32,5 +36,60 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, IncrementalDiffMatchesFullDiff) {
+  auto retained = CreateContainerLayer({
+      CreateDisplayListLayer(
+          CreateDisplayList(SkRect::MakeLTRB(0, 0, 10, 10))),
+      CreateDisplayListLayer(
+          CreateDisplayList(SkRect::MakeLTRB(20, 0, 30, 10))),
+  });
+  auto build_layer_tree = [&](int frame) {
+    auto moving = CreateDisplayListLayer(
+        CreateDisplayList(SkRect::MakeXYWH(frame * 10 % 200, 50, 10, 10)));
+    std::shared_ptr<Layer> subtree = retained;
+    if (frame % 7 == 6) {
+      // Every so often the retained subtree paints somewhere else.
+      auto transform =
+          std::make_shared<TransformLayer>(SkMatrix::Translate(5, 5));
+      transform->Add(retained);
+      subtree = transform;
+    }
+    return std::make_unique<LayerTree>(
+        LayerTree::Config{
+            .root_layer = CreateContainerLayer({subtree, moving}),
+        },
+        SkISize::Make(1000, 1000));
+  };
+
+  std::unique_ptr<LayerTree> full_prev;
+  std::unique_ptr<LayerTree> incremental_prev;
+  int smaller_map_count = 0;
+  for (int frame = 0; frame < 40; frame++) {
+    auto full = build_layer_tree(frame);
+    FrameDamage full_damage;
+    full_damage.SetPreviousLayerTree(full_prev.get());
+    full_damage.ComputeClipRect(*full, false, false);
+
+    auto incremental = build_layer_tree(frame);
+    FrameDamage incremental_damage;
+    incremental_damage.SetPreviousLayerTree(incremental_prev.get());
+    incremental_damage.SetIncrementalDiff(true);
+    incremental_damage.ComputeClipRect(*incremental, false, false);
+
+    EXPECT_EQ(incremental_damage.GetFrameDamage().value(),
+              full_damage.GetFrameDamage().value())
+        << "frame " << frame;
+    EXPECT_LE(incremental->retained_paint_region_maps().size(), 16u);
+    if (incremental->paint_region_map().size() <
+        full->paint_region_map().size()) {
+      smaller_map_count++;
+    }
+
+    full_prev = std::move(full);
+    incremental_prev = std::move(incremental);
+  }
+  EXPECT_GT(smaller_map_count, 0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -355,6 +355,7 @@ class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
   void dispatch(DlOpReceiver& receiver);
   bool is_empty();
   bool recording_ended();
+  sk_sp<DisplayList> display_list() const;
 
  private:
   std::unique_ptr<DisplayListBuilder> builder_;
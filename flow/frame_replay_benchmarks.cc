@@ -0,0 +1,247 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays layer trees captured from running applications, either with the
+// `_flutter.screenshotLayerTree` service protocol extension or with
+// `Rasterizer::ScreenshotType::LayerTree`, to measure every phase of
+// rasterizing real frames.
+//
+// The recordings are read from the directory named by the
+// FLUTTER_LAYER_TREE_RECORDINGS environment variable. Each of its
+// subdirectories is one recording, and each `.layertree` file in it one
+// frame, replayed in the order of the file names. Every frame is a benchmark
+// named `BM_ReplayFrame/<recording>/<backend>/<frame index>`, which is the
+// layout `displaylist_benchmark_parser.py` expects.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layer_tree_serialization.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr char kRecordingsVariable[] = "FLUTTER_LAYER_TREE_RECORDINGS";
+constexpr char kFrameExtension[] = ".layertree";
+
+using BackendType = DlSurfaceProvider::BackendType;
+
+struct Recording {
+  std::string name;
+  std::vector<std::string> frame_paths;
+};
+
+bool HasFrameExtension(const std::string& filename) {
+  const size_t length = sizeof(kFrameExtension) - 1;
+  return filename.size() > length &&
+         filename.compare(filename.size() - length, length, kFrameExtension) ==
+             0;
+}
+
+std::vector<Recording> FindRecordings(const std::string& directory_path) {
+  std::vector<Recording> recordings;
+  auto directory = fml::OpenDirectory(directory_path.c_str(), false,
+                                      fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the recordings in " << directory_path;
+    return recordings;
+  }
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& parent,
+                                 const std::string& name) {
+    if (!fml::IsDirectory(parent, name.c_str())) {
+      return true;
+    }
+    Recording recording{name, {}};
+    auto recording_directory = fml::OpenDirectoryReadOnly(parent, name.c_str());
+    fml::VisitFiles(recording_directory,
+                    [&](const fml::UniqueFD&, const std::string& filename) {
+                      if (HasFrameExtension(filename)) {
+                        recording.frame_paths.push_back(fml::paths::JoinPaths(
+                            {directory_path, name, filename}));
+                      }
+                      return true;
+                    });
+    if (!recording.frame_paths.empty()) {
+      std::sort(recording.frame_paths.begin(), recording.frame_paths.end());
+      recordings.push_back(std::move(recording));
+    }
+    return true;
+  });
+  std::sort(recordings.begin(), recordings.end(),
+            [](const Recording& a, const Recording& b) {
+              return a.name < b.name;
+            });
+  return recordings;
+}
+
+// The pixels of images aren't recorded, so every image is replaced by an
+// opaque raster image of the recorded size. Impeller backends skip drawing
+// them, as they can only draw images backed by Impeller textures.
+sk_sp<DlImage> MakePlaceholderImage(uint64_t id, const SkISize& size) {
+  auto surface = SkSurfaces::Raster(
+      SkImageInfo::MakeN32Premul(std::max(size.width(), 1),
+                                 std::max(size.height(), 1)));
+  if (!surface) {
+    return nullptr;
+  }
+  surface->getCanvas()->clear(SK_ColorGRAY);
+  return DlImage::Make(surface->makeImageSnapshot());
+}
+
+// Replays one recorded frame per iteration the way the rasterizer draws it:
+// the tree is deserialized, prerolled and painted into a display list, which
+// is then rendered and flushed. Each phase is reported as its own counter.
+//
+// There is no |Rasterizer| or platform surface here, so the frame is drawn
+// through the |CompositorContext| directly and the raster cache is not used.
+void BM_ReplayFrame(benchmark::State& state,
+                    BackendType backend_type,
+                    const std::string& frame_path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(frame_path);
+  if (!mapping) {
+    state.SkipWithError("Could not read the frame.");
+    return;
+  }
+  std::string error;
+  auto layer_tree =
+      DeserializeLayerTree(*mapping, MakePlaceholderImage, &error);
+  if (!layer_tree || !layer_tree->root_layer()) {
+    FML_LOG(ERROR) << "Could not load " << frame_path << ": " << error;
+    state.SkipWithError("Could not load the frame.");
+    return;
+  }
+  const SkISize frame_size = layer_tree->frame_size();
+
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  if (!surface_provider ||
+      !surface_provider->InitializeSurface(frame_size.width(),
+                                           frame_size.height())) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  auto surface = surface_provider->GetPrimarySurface();
+  CompositorContext compositor_context;
+
+  fml::TimeDelta build_time;
+  fml::TimeDelta preroll_time;
+  fml::TimeDelta paint_time;
+  fml::TimeDelta encode_time;
+  fml::TimeDelta flush_time;
+  for ([[maybe_unused]] auto _ : state) {
+    auto start = fml::TimePoint::Now();
+    layer_tree = DeserializeLayerTree(*mapping, MakePlaceholderImage);
+    auto built = fml::TimePoint::Now();
+
+    DisplayListBuilder builder(SkRect::Make(frame_size));
+    auto frame = compositor_context.AcquireFrame(
+        nullptr,        // skia context
+        &builder,       // canvas
+        nullptr,        // view embedder
+        SkMatrix::I(),  // root surface transformation
+        false,          // instrumentation enabled
+        true,           // render buffer readback supported
+        nullptr,        // thread merger
+        nullptr         // aiks context
+    );
+    auto frame_start = fml::TimePoint::Now();
+    layer_tree->Preroll(*frame, true);
+    auto prerolled = fml::TimePoint::Now();
+    layer_tree->Paint(*frame, true);
+    auto display_list = builder.Build();
+    auto painted = fml::TimePoint::Now();
+
+    surface->RenderDisplayList(display_list);
+    auto encoded = fml::TimePoint::Now();
+    surface->FlushSubmitCpuSync();
+    auto flushed = fml::TimePoint::Now();
+
+    build_time = build_time + (built - start);
+    preroll_time = preroll_time + (prerolled - frame_start);
+    paint_time = paint_time + (painted - prerolled);
+    encode_time = encode_time + (encoded - painted);
+    flush_time = flush_time + (flushed - encoded);
+  }
+  state.counters["BuildTimeMs"] = benchmark::Counter(
+      build_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["PrerollTimeMs"] = benchmark::Counter(
+      preroll_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["PaintTimeMs"] = benchmark::Counter(
+      paint_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["EncodeTimeMs"] = benchmark::Counter(
+      encode_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["FlushTimeMs"] = benchmark::Counter(
+      flush_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+}
+
+void RegisterReplayBenchmarks(const std::string& backend_name,
+                              BackendType backend_type,
+                              const std::vector<Recording>& recordings) {
+  for (const Recording& recording : recordings) {
+    const std::string name =
+        "BM_ReplayFrame/" + recording.name + "/" + backend_name;
+    for (size_t i = 0; i < recording.frame_paths.size(); i++) {
+      benchmark::RegisterBenchmark(name.c_str(), BM_ReplayFrame, backend_type,
+                                   recording.frame_paths[i])
+          ->Arg(i)
+          ->UseRealTime()
+          ->Unit(benchmark::kMillisecond);
+    }
+  }
+}
+
+// The benchmark main is shared with the other benchmarks, so the recordings
+// are registered during static initialization.
+bool RegisterAllReplayBenchmarks() {
+  const char* directory = std::getenv(kRecordingsVariable);
+  if (directory == nullptr) {
+    FML_LOG(ERROR) << kRecordingsVariable
+                   << " does not name a directory of recordings.";
+    return false;
+  }
+  const std::vector<Recording> recordings = FindRecordings(directory);
+#ifdef ENABLE_SOFTWARE_BENCHMARKS
+  RegisterReplayBenchmarks("Software", BackendType::kSoftwareBackend,
+                           recordings);
+#endif
+#ifdef ENABLE_OPENGL_BENCHMARKS
+  RegisterReplayBenchmarks("OpenGL", BackendType::kOpenGlBackend, recordings);
+#endif
+#ifdef ENABLE_METAL_BENCHMARKS
+  RegisterReplayBenchmarks("Metal", BackendType::kMetalBackend, recordings);
+#endif
+#ifdef ENABLE_IMPELLER_METAL_BENCHMARKS
+  RegisterReplayBenchmarks("ImpellerMetal", BackendType::kImpellerMetalBackend,
+                           recordings);
+#endif
+#ifdef ENABLE_IMPELLER_OPENGLES_BENCHMARKS
+  RegisterReplayBenchmarks("ImpellerOpenGLES",
+                           BackendType::kImpellerOpenGLESBackend, recordings);
+#endif
+#ifdef ENABLE_IMPELLER_VULKAN_BENCHMARKS
+  RegisterReplayBenchmarks("ImpellerVulkan",
+                           BackendType::kImpellerVulkanBackend, recordings);
+#endif
+  return !recordings.empty();
+}
+
+[[maybe_unused]] const bool kRegistered = RegisterAllReplayBenchmarks();
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histogram.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+FrameTimingHistogram::FrameTimingHistogram() {
+  Reset();
+}
+
+void FrameTimingHistogram::Record(fml::TimeDelta duration) {
+  const uint64_t micros = std::max<int64_t>(duration.ToMicroseconds(), 0);
+  // There is a single writer, so the counts don't need to be incremented
+  // atomically, only stored atomically for the readers.
+  auto& count = counts_[BucketIndex(micros)];
+  count.store(count.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+  if (micros > max_micros_.load(std::memory_order_relaxed)) {
+    max_micros_.store(micros, std::memory_order_relaxed);
+  }
+}
+
+void FrameTimingHistogram::Reset() {
+  for (auto& count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  max_micros_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t FrameTimingHistogram::AccumulateInto(
+    std::array<uint64_t, kBucketCount>& counts) const {
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] += counts_[i].load(std::memory_order_relaxed);
+  }
+  return max_micros_.load(std::memory_order_relaxed);
+}
+
+FrameTimingPercentiles FrameTimingHistogram::GetPercentiles() const {
+  std::array<uint64_t, kBucketCount> counts = {};
+  uint64_t max_micros = AccumulateInto(counts);
+  return GetPercentiles(counts, max_micros);
+}
+
+FrameTimingPercentiles FrameTimingHistogram::GetPercentiles(
+    const std::array<uint64_t, kBucketCount>& counts,
+    uint64_t max_micros) {
+  FrameTimingPercentiles percentiles;
+  for (uint64_t count : counts) {
+    percentiles.count += count;
+  }
+  if (percentiles.count == 0) {
+    return percentiles;
+  }
+
+  struct {
+    int percent;
+    fml::TimeDelta* value;
+  } targets[] = {
+      {50, &percentiles.p50},
+      {90, &percentiles.p90},
+      {99, &percentiles.p99},
+  };
+  uint64_t seen = 0;
+  size_t target = 0;
+  for (size_t i = 0; i < kBucketCount && target < std::size(targets); i++) {
+    seen += counts[i];
+    // The value at a percentile is that of the frame at its rank, rounding
+    // the rank up so that the p99 of 10 frames is the slowest of them.
+    while (target < std::size(targets) &&
+           seen * 100 >= percentiles.count * targets[target].percent) {
+      // The maximum may have been read before a concurrent write of the
+      // counts, so it is only used to bound the values of the buckets.
+      uint64_t value = BucketMaxValue(i);
+      const uint64_t bucket_min = i == 0 ? 0 : BucketMaxValue(i - 1) + 1;
+      if (max_micros >= bucket_min) {
+        value = std::min(value, max_micros);
+      }
+      *targets[target].value = fml::TimeDelta::FromMicroseconds(value);
+      target++;
+    }
+  }
+  percentiles.max = fml::TimeDelta::FromMicroseconds(
+      std::max<uint64_t>(max_micros, percentiles.p99.ToMicroseconds()));
+  return percentiles;
+}
+
+size_t FrameTimingHistogram::BucketIndex(uint64_t micros) {
+  micros = std::min(micros, kMaxValueMicros - 1);
+  if (micros < kSubBucketCount) {
+    return micros;
+  }
+  int shift = 0;
+  while ((micros >> shift) >= 2 * kSubBucketCount) {
+    shift++;
+  }
+  return (shift + 1) * kSubBucketCount +
+         ((micros >> shift) - kSubBucketCount);
+}
+
+uint64_t FrameTimingHistogram::BucketMaxValue(size_t index) {
+  FML_DCHECK(index < kBucketCount);
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const int shift = index / kSubBucketCount - 1;
+  const uint64_t sub_bucket = index % kSubBucketCount;
+  return ((kSubBucketCount + sub_bucket + 1) << shift) - 1;
+}
+
+FrameTimingStatsRecorder::FrameTimingStatsRecorder(fml::TimeDelta window)
+    : window_(window), slot_duration_(window / kSlotCount) {
+  FML_DCHECK(slot_duration_ > fml::TimeDelta::Zero());
+}
+
+int64_t FrameTimingStatsRecorder::PeriodAt(fml::TimePoint time) const {
+  return time.ToEpochDelta().ToMicroseconds() /
+         slot_duration_.ToMicroseconds();
+}
+
+FrameTimingStatsRecorder::Slot& FrameTimingStatsRecorder::SlotAt(
+    fml::TimePoint time) {
+  const int64_t period = PeriodAt(time);
+  Slot& slot = slots_[period % kSlotCount];
+  if (slot.period.load(std::memory_order_relaxed) != period) {
+    for (auto& histogram : slot.histograms) {
+      histogram.Reset();
+    }
+    slot.period.store(period, std::memory_order_release);
+  }
+  return slot;
+}
+
+void FrameTimingStatsRecorder::RecordFrame(const FrameTiming& timing) {
+  const fml::TimePoint vsync_start = timing.Get(FrameTiming::kVsyncStart);
+  const fml::TimePoint build_start = timing.Get(FrameTiming::kBuildStart);
+  const fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+
+  Slot& slot = SlotAt(raster_finish);
+  slot.histograms[kVsyncOverhead].Record(build_start - vsync_start);
+  slot.histograms[kBuild].Record(timing.Get(FrameTiming::kBuildFinish) -
+                                 build_start);
+  slot.histograms[kRaster].Record(raster_finish -
+                                  timing.Get(FrameTiming::kRasterStart));
+  slot.histograms[kTotal].Record(raster_finish - vsync_start);
+}
+
+void FrameTimingStatsRecorder::RecordGpuTime(fml::TimePoint now,
+                                             fml::TimeDelta gpu_time) {
+  SlotAt(now).histograms[kGpu].Record(gpu_time);
+}
+
+FrameTimingStats FrameTimingStatsRecorder::GetStats(fml::TimePoint now) const {
+  const int64_t current_period = PeriodAt(now);
+  std::array<uint64_t, FrameTimingHistogram::kBucketCount>
+      counts[kHistogramCount] = {};
+  uint64_t max_micros[kHistogramCount] = {};
+  for (const Slot& slot : slots_) {
+    const int64_t period = slot.period.load(std::memory_order_acquire);
+    if (period < 0 || period > current_period ||
+        period <= current_period - static_cast<int64_t>(kSlotCount)) {
+      continue;
+    }
+    for (int i = 0; i < kHistogramCount; i++) {
+      max_micros[i] = std::max(max_micros[i],
+                               slot.histograms[i].AccumulateInto(counts[i]));
+    }
+  }
+
+  FrameTimingStats stats;
+  stats.window = window_;
+  stats.vsync_overhead = FrameTimingHistogram::GetPercentiles(
+      counts[kVsyncOverhead], max_micros[kVsyncOverhead]);
+  stats.build = FrameTimingHistogram::GetPercentiles(counts[kBuild],
+                                                     max_micros[kBuild]);
+  stats.raster = FrameTimingHistogram::GetPercentiles(counts[kRaster],
+                                                      max_micros[kRaster]);
+  stats.total = FrameTimingHistogram::GetPercentiles(counts[kTotal],
+                                                     max_micros[kTotal]);
+  stats.gpu =
+      FrameTimingHistogram::GetPercentiles(counts[kGpu], max_micros[kGpu]);
+  return stats;
+}
+
+}  // namespace flutter
@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_TIMING_HISTOGRAM_H_
+#define FLUTTER_FLOW_FRAME_TIMING_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// The percentiles of the durations recorded by a |FrameTimingHistogram|.
+struct FrameTimingPercentiles {
+  uint64_t count = 0;
+  fml::TimeDelta p50;
+  fml::TimeDelta p90;
+  fml::TimeDelta p99;
+  fml::TimeDelta max;
+};
+
+/// A histogram of durations with logarithmic buckets that are each split
+/// into |kSubBucketCount| linear sub-buckets, in the manner of an HDR
+/// histogram. Durations are recorded in microseconds, and a percentile is
+/// accurate to within 1/|kSubBucketCount| of its value.
+///
+/// Recording takes no locks and does not allocate. There may be a single
+/// recording thread, while any thread may read the histogram at the same
+/// time. A reader may see a frame that is partly recorded, which only
+/// affects the result by that one frame.
+class FrameTimingHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr uint64_t kSubBucketCount = 1u << kSubBucketBits;
+
+  /// Durations of this many microseconds or more, about 16.7 seconds, are
+  /// counted in the highest bucket. The maximum is still tracked exactly.
+  static constexpr int kMaxValueBits = 24;
+  static constexpr uint64_t kMaxValueMicros = (uint64_t{1} << kMaxValueBits);
+
+  static constexpr size_t kBucketCount =
+      kSubBucketCount * (kMaxValueBits - kSubBucketBits + 1);
+
+  FrameTimingHistogram();
+
+  void Record(fml::TimeDelta duration);
+
+  void Reset();
+
+  /// Adds the counts of this histogram to |counts|, and returns the largest
+  /// duration recorded in microseconds.
+  uint64_t AccumulateInto(std::array<uint64_t, kBucketCount>& counts) const;
+
+  FrameTimingPercentiles GetPercentiles() const;
+
+  /// Returns the percentiles of the bucket |counts| accumulated from one or
+  /// more histograms.
+  static FrameTimingPercentiles GetPercentiles(
+      const std::array<uint64_t, kBucketCount>& counts,
+      uint64_t max_micros);
+
+  static size_t BucketIndex(uint64_t micros);
+
+  /// The largest value in microseconds that is counted in the bucket at
+  /// |index|.
+  static uint64_t BucketMaxValue(size_t index);
+
+ private:
+  std::array<std::atomic<uint32_t>, kBucketCount> counts_;
+  std::atomic<uint64_t> max_micros_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingHistogram);
+};
+
+/// The percentiles of the phases of the frames rasterized within a window.
+struct FrameTimingStats {
+  /// The span of time that the stats cover.
+  fml::TimeDelta window;
+  /// From the vsync signal to the start of the build.
+  FrameTimingPercentiles vsync_overhead;
+  /// From the start to the end of the build on the UI thread.
+  FrameTimingPercentiles build;
+  /// From the start to the end of rasterization on the raster thread.
+  FrameTimingPercentiles raster;
+  /// From the vsync signal to the end of rasterization.
+  FrameTimingPercentiles total;
+  /// The time the GPU spent on the frame, for the backends that measure it.
+  FrameTimingPercentiles gpu;
+};
+
+/// Aggregates the durations of the phases of each rasterized frame over a
+/// rolling window, so that the tail latency of the frames can be monitored
+/// without keeping the timings of every frame.
+///
+/// The window is made of |kSlotCount| slots of histograms that each cover
+/// 1/|kSlotCount| of it. A frame is recorded in the slot of the time its
+/// rasterization finished, and a slot is cleared when it is reused. The
+/// stats therefore cover between |window| minus one slot and |window|.
+///
+/// Frames must be recorded on one thread, normally the raster thread. The
+/// stats may be read on any thread.
+class FrameTimingStatsRecorder {
+ public:
+  static constexpr size_t kSlotCount = 6;
+
+  explicit FrameTimingStatsRecorder(
+      fml::TimeDelta window = fml::TimeDelta::FromSeconds(60));
+
+  fml::TimeDelta window() const { return window_; }
+
+  void RecordFrame(const FrameTiming& timing);
+
+  /// Records the GPU time of a frame, which is measured after the frame's
+  /// timing was recorded. |now| is the time the measurement came back.
+  void RecordGpuTime(fml::TimePoint now, fml::TimeDelta gpu_time);
+
+  /// Returns the stats of the frames whose rasterization finished within the
+  /// window that ends at |now|.
+  FrameTimingStats GetStats(fml::TimePoint now = fml::TimePoint::Now()) const;
+
+ private:
+  enum Histogram {
+    kVsyncOverhead,
+    kBuild,
+    kRaster,
+    kTotal,
+    kGpu,
+    kHistogramCount,
+  };
+
+  struct Slot {
+    // The index of the period of the window's length divided by
+    // |kSlotCount| that the slot holds, or -1 if it is unused.
+    std::atomic<int64_t> period{-1};
+    FrameTimingHistogram histograms[kHistogramCount];
+  };
+
+  int64_t PeriodAt(fml::TimePoint time) const;
+
+  // Returns the slot for |time|, clearing it if it held an older period.
+  Slot& SlotAt(fml::TimePoint time);
+
+  const fml::TimeDelta window_;
+  const fml::TimeDelta slot_duration_;
+  Slot slots_[kSlotCount];
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStatsRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_TIMING_HISTOGRAM_H_
@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histogram.h"
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming MakeFrameTiming(fml::TimePoint vsync_start,
+                            fml::TimeDelta build,
+                            fml::TimeDelta raster) {
+  FrameTiming timing;
+  const auto vsync_overhead = fml::TimeDelta::FromMicroseconds(500);
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart, vsync_start + vsync_overhead);
+  timing.Set(FrameTiming::kBuildFinish, vsync_start + vsync_overhead + build);
+  timing.Set(FrameTiming::kRasterStart, vsync_start + vsync_overhead + build);
+  timing.Set(FrameTiming::kRasterFinish,
+             vsync_start + vsync_overhead + build + raster);
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameTimingHistogramTest, BucketsCoverEveryValue) {
+  for (uint64_t micros = 0; micros < 100000; micros++) {
+    size_t index = FrameTimingHistogram::BucketIndex(micros);
+    ASSERT_LT(index, FrameTimingHistogram::kBucketCount);
+    ASSERT_LE(micros, FrameTimingHistogram::BucketMaxValue(index));
+    if (index > 0) {
+      ASSERT_GT(micros, FrameTimingHistogram::BucketMaxValue(index - 1));
+    }
+  }
+  EXPECT_EQ(FrameTimingHistogram::BucketIndex(uint64_t{1} << 40),
+            FrameTimingHistogram::kBucketCount - 1);
+}
+
+TEST(FrameTimingHistogramTest, PercentilesAreWithinBucketPrecision) {
+  FrameTimingHistogram histogram;
+  for (int ms = 1; ms <= 100; ms++) {
+    histogram.Record(fml::TimeDelta::FromMilliseconds(ms));
+  }
+  FrameTimingPercentiles percentiles = histogram.GetPercentiles();
+  EXPECT_EQ(percentiles.count, 100u);
+  const double precision = 1.0 / FrameTimingHistogram::kSubBucketCount;
+  EXPECT_NEAR(percentiles.p50.ToMillisecondsF(), 50, 50 * precision);
+  EXPECT_NEAR(percentiles.p90.ToMillisecondsF(), 90, 90 * precision);
+  EXPECT_NEAR(percentiles.p99.ToMillisecondsF(), 99, 99 * precision);
+  EXPECT_EQ(percentiles.max, fml::TimeDelta::FromMilliseconds(100));
+
+  histogram.Reset();
+  percentiles = histogram.GetPercentiles();
+  EXPECT_EQ(percentiles.count, 0u);
+  EXPECT_EQ(percentiles.max, fml::TimeDelta::Zero());
+}
+
+TEST(FrameTimingHistogramTest, SlowestFrameIsTheTailOfFewFrames) {
+  FrameTimingHistogram histogram;
+  for (int i = 0; i < 9; i++) {
+    histogram.Record(fml::TimeDelta::FromMilliseconds(4));
+  }
+  histogram.Record(fml::TimeDelta::FromMilliseconds(40));
+  FrameTimingPercentiles percentiles = histogram.GetPercentiles();
+  EXPECT_LT(percentiles.p90, fml::TimeDelta::FromMilliseconds(5));
+  EXPECT_EQ(percentiles.p99, fml::TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(percentiles.max, fml::TimeDelta::FromMilliseconds(40));
+}
+
+TEST(FrameTimingStatsRecorderTest, RecordsEachPhase) {
+  FrameTimingStatsRecorder recorder(fml::TimeDelta::FromSeconds(60));
+  const auto start =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1000));
+  recorder.RecordFrame(MakeFrameTiming(start,
+                                       fml::TimeDelta::FromMilliseconds(4),
+                                       fml::TimeDelta::FromMilliseconds(8)));
+
+  FrameTimingStats stats = recorder.GetStats(start);
+  EXPECT_EQ(stats.window, fml::TimeDelta::FromSeconds(60));
+  EXPECT_EQ(stats.vsync_overhead.count, 1u);
+  EXPECT_EQ(stats.vsync_overhead.max, fml::TimeDelta::FromMicroseconds(500));
+  EXPECT_EQ(stats.build.max, fml::TimeDelta::FromMilliseconds(4));
+  EXPECT_EQ(stats.raster.max, fml::TimeDelta::FromMilliseconds(8));
+  EXPECT_EQ(stats.total.max, fml::TimeDelta::FromMicroseconds(12500));
+  EXPECT_EQ(stats.gpu.count, 0u);
+
+  recorder.RecordGpuTime(start + fml::TimeDelta::FromMilliseconds(20),
+                         fml::TimeDelta::FromMilliseconds(6));
+  stats = recorder.GetStats(start);
+  EXPECT_EQ(stats.gpu.count, 1u);
+  EXPECT_EQ(stats.gpu.max, fml::TimeDelta::FromMilliseconds(6));
+  EXPECT_EQ(stats.build.count, 1u);
+}
+
+TEST(FrameTimingStatsRecorderTest, FramesLeaveTheWindow) {
+  const auto window = fml::TimeDelta::FromSeconds(60);
+  const auto slot = window / FrameTimingStatsRecorder::kSlotCount;
+  FrameTimingStatsRecorder recorder(window);
+  const auto start =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1200));
+  recorder.RecordFrame(MakeFrameTiming(start,
+                                       fml::TimeDelta::FromMilliseconds(30),
+                                       fml::TimeDelta::FromMilliseconds(1)));
+  recorder.RecordFrame(MakeFrameTiming(start + slot,
+                                       fml::TimeDelta::FromMilliseconds(2),
+                                       fml::TimeDelta::FromMilliseconds(1)));
+
+  FrameTimingStats stats = recorder.GetStats(start + slot);
+  EXPECT_EQ(stats.build.count, 2u);
+  EXPECT_EQ(stats.build.max, fml::TimeDelta::FromMilliseconds(30));
+
+  // The first frame's slot falls out of the window.
+  stats = recorder.GetStats(start + window);
+  EXPECT_EQ(stats.build.count, 1u);
+  EXPECT_EQ(stats.build.max, fml::TimeDelta::FromMilliseconds(2));
+
+  // Reusing the first frame's slot clears it.
+  recorder.RecordFrame(MakeFrameTiming(start + window,
+                                       fml::TimeDelta::FromMilliseconds(3),
+                                       fml::TimeDelta::FromMilliseconds(1)));
+  stats = recorder.GetStats(start + window);
+  EXPECT_EQ(stats.build.count, 2u);
+  EXPECT_EQ(stats.build.max, fml::TimeDelta::FromMilliseconds(3));
+
+  stats = recorder.GetStats(start + window * 3);
+  EXPECT_EQ(stats.build.count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -37,6 +37,13 @@ fml::TimePoint FrameTimingsRecorder::GetVsyncTargetTime() const {
   return vsync_target_;
 }
 
+std::optional<fml::TimePoint> FrameTimingsRecorder::GetExpectedPresentTime()
+    const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kVsync);
+  return expected_present_;
+}
+
 fml::TimePoint FrameTimingsRecorder::GetBuildStartTime() const {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ >= State::kBuildStart);
@@ -73,6 +80,19 @@ fml::TimeDelta FrameTimingsRecorder::GetBuildDuration() const {
   return build_end_ - build_start_;
 }
 
+std::optional<size_t> FrameTimingsRecorder::GetGpuQueueDepth() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterStart);
+  return gpu_queue_depth_;
+}
+
+std::optional<fml::TimeDelta> FrameTimingsRecorder::GetGpuThrottleDuration()
+    const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterStart);
+  return gpu_throttle_duration_;
+}
+
 /// Count of the layer cache entries
 size_t FrameTimingsRecorder::GetLayerCacheCount() const {
   std::scoped_lock state_lock(state_mutex_);
@@ -108,6 +128,13 @@ void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
   (void)status;
 }
 
+void FrameTimingsRecorder::RecordExpectedPresentTime(
+    fml::TimePoint expected_present) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kVsync);
+  expected_present_ = expected_present;
+}
+
 void FrameTimingsRecorder::RecordBuildStart(fml::TimePoint build_start) {
   fml::Status status = RecordBuildStartImpl(build_start);
   FML_DCHECK(status.ok());
@@ -126,6 +153,14 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   (void)status;
 }
 
+void FrameTimingsRecorder::RecordGpuQueue(size_t queue_depth,
+                                          fml::TimeDelta throttle_duration) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  gpu_queue_depth_ = queue_depth;
+  gpu_throttle_duration_ = throttle_duration;
+}
+
 fml::Status FrameTimingsRecorder::RecordVsyncImpl(fml::TimePoint vsync_start,
                                                   fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -220,6 +255,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
   if (state >= State::kVsync) {
     recorder->vsync_start_ = vsync_start_;
     recorder->vsync_target_ = vsync_target_;
+    recorder->expected_present_ = expected_present_;
   }
 
   if (state >= State::kBuildStart) {
@@ -232,6 +268,8 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    recorder->gpu_queue_depth_ = gpu_queue_depth_;
+    recorder->gpu_throttle_duration_ = gpu_throttle_duration_;
   }
 
   if (state >= State::kRasterEnd) {
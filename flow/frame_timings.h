@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
 #include <mutex>
+#include <optional>
 
 #include "flutter/common/settings.h"
 #include "flutter/flow/raster_cache.h"
@@ -56,6 +57,13 @@ class FrameTimingsRecorder {
   /// This is typically the next vsync signal timestamp.
   fml::TimePoint GetVsyncTargetTime() const;
 
+  /// Timestamp of when the platform expects the frame to be shown, if it
+  /// reported one.
+  ///
+  /// This may be later than the target time, which is the deadline for the
+  /// frame, on platforms that pipeline frames.
+  std::optional<fml::TimePoint> GetExpectedPresentTime() const;
+
   /// Timestamp of when the frame building started.
   fml::TimePoint GetBuildStartTime() const;
 
@@ -74,6 +82,14 @@ class FrameTimingsRecorder {
   /// Duration of the frame build time.
   fml::TimeDelta GetBuildDuration() const;
 
+  /// The number of frames the GPU hadn't finished when the surface for this
+  /// frame was acquired, if the surface reported it.
+  std::optional<size_t> GetGpuQueueDepth() const;
+
+  /// How long acquiring the surface for this frame waited for the GPU to
+  /// finish earlier frames, if the surface reported it.
+  std::optional<fml::TimeDelta> GetGpuThrottleDuration() const;
+
   /// Count of the layer cache entries
   size_t GetLayerCacheCount() const;
 
@@ -89,6 +105,10 @@ class FrameTimingsRecorder {
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
+  /// Records when the platform expects the frame started by the vsync to be
+  /// shown. Must be called after `RecordVsync`.
+  void RecordExpectedPresentTime(fml::TimePoint expected_present);
+
   /// Records a build start event.
   void RecordBuildStart(fml::TimePoint build_start);
 
@@ -98,6 +118,10 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records how far the GPU was behind when the surface for the frame was
+  /// acquired. Must be called after `RecordRasterStart`.
+  void RecordGpuQueue(size_t queue_depth, fml::TimeDelta throttle_duration);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -137,11 +161,14 @@ class FrameTimingsRecorder {
 
   fml::TimePoint vsync_start_;
   fml::TimePoint vsync_target_;
+  std::optional<fml::TimePoint> expected_present_;
   fml::TimePoint build_start_;
   fml::TimePoint build_end_;
   fml::TimePoint raster_start_;
   fml::TimePoint raster_end_;
   fml::TimePoint raster_end_wall_time_;
+  std::optional<size_t> gpu_queue_depth_;
+  std::optional<fml::TimeDelta> gpu_throttle_duration_;
 
   size_t layer_cache_count_;
   size_t layer_cache_bytes_;
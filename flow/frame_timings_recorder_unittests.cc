@@ -27,6 +27,21 @@ TEST(FrameTimingsRecorderTest, RecordVsync) {
   ASSERT_EQ(en, recorder->GetVsyncTargetTime());
 }
 
+TEST(FrameTimingsRecorderTest, RecordExpectedPresentTime) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(8);
+  recorder->RecordVsync(st, en);
+  ASSERT_FALSE(recorder->GetExpectedPresentTime().has_value());
+
+  const auto present = en + fml::TimeDelta::FromMillisecondsF(8);
+  recorder->RecordExpectedPresentTime(present);
+  ASSERT_EQ(present, recorder->GetExpectedPresentTime());
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kVsync);
+  ASSERT_EQ(present, cloned->GetExpectedPresentTime());
+}
+
 TEST(FrameTimingsRecorderTest, RecordBuildTimes) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -75,6 +90,27 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimes) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), 0u);
 }
 
+TEST(FrameTimingsRecorderTest, RecordGpuQueue) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  ASSERT_FALSE(recorder->GetGpuQueueDepth().has_value());
+  ASSERT_FALSE(recorder->GetGpuThrottleDuration().has_value());
+
+  const auto throttle = fml::TimeDelta::FromMilliseconds(4);
+  recorder->RecordGpuQueue(3, throttle);
+  ASSERT_EQ(3u, recorder->GetGpuQueueDepth());
+  ASSERT_EQ(throttle, recorder->GetGpuThrottleDuration());
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kRasterStart);
+  ASSERT_EQ(3u, cloned->GetGpuQueueDepth());
+  ASSERT_EQ(throttle, cloned->GetGpuThrottleDuration());
+}
+
 TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -4,8 +4,22 @@
 
 #include "flutter/flow/layer_snapshot_store.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 namespace flutter {
 
@@ -18,6 +32,33 @@ LayerSnapshotData::LayerSnapshotData(int64_t layer_unique_id,
       snapshot_(snapshot),
       bounds_(bounds) {}
 
+struct LayerSnapshotStore::SampleState {
+  Snapshots samples;
+  // The ids of the layers whose thumbnails are being read back.
+  std::vector<int64_t> readback_ids;
+  // The bytes of the encoded samples plus the uncompressed bytes of the
+  // thumbnails that are pending or being read back.
+  size_t used_bytes = 0;
+};
+
+struct LayerSnapshotStore::Readback {
+  std::weak_ptr<SampleState> state;
+  int64_t layer_unique_id;
+  fml::TimeDelta duration;
+  SkRect device_bounds;
+  SkISize size;
+  size_t reserved_bytes;
+};
+
+static size_t ThumbnailBytes(const SkISize& size) {
+  return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+LayerSnapshotStore::LayerSnapshotStore()
+    : sample_state_(std::make_shared<SampleState>()) {}
+
+LayerSnapshotStore::~LayerSnapshotStore() = default;
+
 void LayerSnapshotStore::Clear() {
   layer_snapshots_.clear();
 }
@@ -26,4 +67,159 @@ void LayerSnapshotStore::Add(const LayerSnapshotData& data) {
   layer_snapshots_.push_back(data);
 }
 
+void LayerSnapshotStore::SetSamplingOptions(const SamplingOptions& options) {
+  options_ = options;
+  pending_samples_.clear();
+  // Readbacks in flight report to the old state, which is then dropped.
+  sample_state_ = std::make_shared<SampleState>();
+}
+
+const LayerSnapshotStore::Snapshots& LayerSnapshotStore::samples() const {
+  return sample_state_->samples;
+}
+
+void LayerSnapshotStore::Sample(int64_t layer_unique_id,
+                                fml::TimeDelta duration,
+                                const sk_sp<DisplayList>& display_list,
+                                const SkM44& matrix,
+                                const SkRect& device_bounds) {
+  if (duration < options_.min_duration || device_bounds.isEmpty() ||
+      options_.max_dimension <= 0) {
+    return;
+  }
+  SampleState& state = *sample_state_;
+  auto has_id = [layer_unique_id](const auto& sample) {
+    return sample.layer_unique_id == layer_unique_id;
+  };
+  if (std::any_of(pending_samples_.begin(), pending_samples_.end(), has_id) ||
+      std::find(state.readback_ids.begin(), state.readback_ids.end(),
+                layer_unique_id) != state.readback_ids.end() ||
+      std::any_of(state.samples.begin(), state.samples.end(),
+                  [layer_unique_id](const LayerSnapshotData& sample) {
+                    return sample.GetLayerUniqueId() == layer_unique_id;
+                  })) {
+    return;
+  }
+
+  const SkScalar longest_side =
+      std::max(device_bounds.width(), device_bounds.height());
+  const SkScalar scale = std::min(1.0f, options_.max_dimension / longest_side);
+  const SkISize size = SkISize::Make(
+      std::max(1, static_cast<int>(std::ceil(device_bounds.width() * scale))),
+      std::max(1, static_cast<int>(std::ceil(device_bounds.height() * scale))));
+  const size_t bytes = ThumbnailBytes(size);
+  if (!MakeRoom(bytes, duration)) {
+    return;
+  }
+  state.used_bytes += bytes;
+  pending_samples_.push_back({
+      .layer_unique_id = layer_unique_id,
+      .duration = duration,
+      .display_list = display_list,
+      .matrix = matrix,
+      .device_bounds = device_bounds,
+      .size = size,
+  });
+}
+
+bool LayerSnapshotStore::MakeRoom(size_t bytes, fml::TimeDelta duration) {
+  SampleState& state = *sample_state_;
+  while (state.used_bytes + bytes > options_.memory_budget) {
+    auto fastest = std::min_element(
+        state.samples.begin(), state.samples.end(),
+        [](const LayerSnapshotData& a, const LayerSnapshotData& b) {
+          return a.GetDuration() < b.GetDuration();
+        });
+    if (fastest == state.samples.end() || fastest->GetDuration() >= duration) {
+      return false;
+    }
+    state.used_bytes -= fastest->GetSnapshot()->size();
+    state.samples.erase(fastest);
+  }
+  return true;
+}
+
+void LayerSnapshotStore::CaptureSamples(GrDirectContext* gr_context) {
+  if (gr_context) {
+    // Delivers the readbacks of earlier frames that have finished.
+    gr_context->checkAsyncWorkCompletion();
+  }
+  if (pending_samples_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "LayerSnapshotStore::CaptureSamples");
+
+  for (const PendingSample& sample : pending_samples_) {
+    const size_t bytes = ThumbnailBytes(sample.size);
+    const SkImageInfo image_info =
+        SkImageInfo::MakeN32Premul(sample.size, SkColorSpace::MakeSRGB());
+    sk_sp<SkSurface> surface =
+        gr_context ? SkSurfaces::RenderTarget(gr_context, skgpu::Budgeted::kNo,
+                                              image_info)
+                   : SkSurfaces::Raster(image_info);
+    if (!surface) {
+      sample_state_->used_bytes -= bytes;
+      continue;
+    }
+
+    DlSkCanvasAdapter canvas(surface->getCanvas());
+    canvas.Clear(DlColor::kTransparent());
+    canvas.Scale(sample.size.width() / sample.device_bounds.width(),
+                 sample.size.height() / sample.device_bounds.height());
+    canvas.Translate(-sample.device_bounds.left(),
+                     -sample.device_bounds.top());
+    canvas.Transform(sample.matrix);
+    canvas.DrawDisplayList(sample.display_list);
+
+    sample_state_->readback_ids.push_back(sample.layer_unique_id);
+    auto* readback = new Readback{
+        .state = sample_state_,
+        .layer_unique_id = sample.layer_unique_id,
+        .duration = sample.duration,
+        .device_bounds = sample.device_bounds,
+        .size = sample.size,
+        .reserved_bytes = bytes,
+    };
+    // The thumbnail is already at its final size, so nothing is rescaled.
+    surface->asyncRescaleAndReadPixels(
+        image_info, SkIRect::MakeSize(sample.size),
+        SkImage::RescaleGamma::kSrc, SkImage::RescaleMode::kNearest,
+        &LayerSnapshotStore::OnReadback, readback);
+  }
+  pending_samples_.clear();
+
+  if (gr_context) {
+    // Submits the readbacks without waiting for them.
+    gr_context->flushAndSubmit();
+  }
+}
+
+void LayerSnapshotStore::OnReadback(
+    void* context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<Readback> readback(static_cast<Readback*>(context));
+  std::shared_ptr<SampleState> state = readback->state.lock();
+  if (!state) {
+    return;
+  }
+  auto& ids = state->readback_ids;
+  ids.erase(std::find(ids.begin(), ids.end(), readback->layer_unique_id));
+  state->used_bytes -= readback->reserved_bytes;
+  if (!result || result->count() != 1) {
+    return;
+  }
+
+  SkPixmap pixmap(
+      SkImageInfo::MakeN32Premul(readback->size, SkColorSpace::MakeSRGB()),
+      result->data(0), result->rowBytes(0));
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, pixmap, {})) {
+    return;
+  }
+  sk_sp<SkData> png = stream.detachAsData();
+  state->used_bytes += png->size();
+  state->samples.emplace_back(readback->layer_unique_id, readback->duration,
+                              png, readback->device_bounds);
+}
+
 }  // namespace flutter
@@ -5,14 +5,21 @@
 #ifndef FLUTTER_FLOW_LAYER_SNAPSHOT_STORE_H_
 #define FLUTTER_FLOW_LAYER_SNAPSHOT_STORE_H_
 
+#include <memory>
 #include <vector>
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/time/time_delta.h"
 
 #include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkM44.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+class GrDirectContext;
 
 namespace flutter {
 
@@ -43,13 +50,41 @@ class LayerSnapshotData {
 };
 
 /// Collects snapshots of layers during frame rasterization.
+///
+/// Besides the full resolution snapshots that are taken while leaf layer
+/// tracing renders a frame for DevTools, the store can sample thumbnails of
+/// the slowest layers of regular frames. Sampling only records what is
+/// needed to render a layer while the frame is painted. The thumbnails are
+/// rendered by |CaptureSamples| once the frame has been submitted and are
+/// read back asynchronously, so no frame waits for the GPU. Frames rendered
+/// with Impeller are not sampled.
 class LayerSnapshotStore {
  public:
   typedef std::vector<LayerSnapshotData> Snapshots;
 
-  LayerSnapshotStore() = default;
+  /// The types of layers that can be sampled, as a bit mask.
+  static constexpr uint32_t kDisplayListLayers = 1 << 0;
+
+  struct SamplingOptions {
+    /// The |kDisplayListLayers| style bits of the layer types to sample, or
+    /// 0 to disable sampling.
+    uint32_t layer_types = 0;
+
+    /// Layers that took less time to paint are not sampled.
+    fml::TimeDelta min_duration = fml::TimeDelta::FromMilliseconds(1);
+
+    /// The size in pixels of the longer side of the thumbnails.
+    int max_dimension = 128;
 
-  ~LayerSnapshotStore() = default;
+    /// The uncompressed size of the thumbnails that are held or being
+    /// captured is kept below this many bytes. Samples of faster layers are
+    /// dropped to make room for those of slower ones.
+    size_t memory_budget = 1 << 20;
+  };
+
+  LayerSnapshotStore();
+
+  ~LayerSnapshotStore();
 
   /// Clears all the stored snapshots.
   void Clear();
@@ -65,8 +100,69 @@ class LayerSnapshotStore {
   Snapshots::iterator begin() { return layer_snapshots_.begin(); }
   Snapshots::iterator end() { return layer_snapshots_.end(); }
 
+  /// Sets the sampling options and drops the samples taken so far.
+  void SetSamplingOptions(const SamplingOptions& options);
+
+  const SamplingOptions& sampling_options() const { return options_; }
+
+  /// Whether layers of any type are sampled.
+  bool IsSampling() const { return options_.layer_types != 0; }
+
+  /// Whether layers of the given |kDisplayListLayers| style type are
+  /// sampled.
+  bool IsSampling(uint32_t layer_type) const {
+    return (options_.layer_types & layer_type) != 0;
+  }
+
+  /// Records a layer that took |duration| to paint |display_list| with
+  /// |matrix| into |device_bounds| so that a thumbnail of it is captured by
+  /// the next call to |CaptureSamples|. The layer is skipped if it was fast,
+  /// if it has already been sampled or if there is no room left in the
+  /// memory budget.
+  void Sample(int64_t layer_unique_id,
+              fml::TimeDelta duration,
+              const sk_sp<DisplayList>& display_list,
+              const SkM44& matrix,
+              const SkRect& device_bounds);
+
+  /// Renders the thumbnails of the layers sampled since the last call and
+  /// starts reading them back. The PNG encoded thumbnails are added to
+  /// |samples| as the readbacks finish, during later calls or right away if
+  /// |gr_context| is null and the thumbnails are rendered in software. Must
+  /// be called on the raster thread after the frame has been submitted.
+  void CaptureSamples(GrDirectContext* gr_context);
+
+  /// The captured samples. Their bounds are in device pixels.
+  const Snapshots& samples() const;
+
+  /// The number of samples recorded that have not been captured yet.
+  size_t pending_sample_count() const { return pending_samples_.size(); }
+
  private:
+  struct PendingSample {
+    int64_t layer_unique_id;
+    fml::TimeDelta duration;
+    sk_sp<DisplayList> display_list;
+    SkM44 matrix;
+    SkRect device_bounds;
+    SkISize size;
+  };
+  struct SampleState;
+  struct Readback;
+
+  // Drops captured samples that are faster than |duration| until |bytes|
+  // fit in the memory budget, and returns whether they do.
+  bool MakeRoom(size_t bytes, fml::TimeDelta duration);
+
+  static void OnReadback(
+      void* context,
+      std::unique_ptr<const SkImage::AsyncReadResult> result);
+
   Snapshots layer_snapshots_;
+  SamplingOptions options_;
+  std::vector<PendingSample> pending_samples_;
+  // Shared with the readbacks in flight, which may outlive the store.
+  std::shared_ptr<SampleState> sample_state_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerSnapshotStore);
 };
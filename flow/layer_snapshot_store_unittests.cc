@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_snapshot_store.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeDisplayList() {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(64, 64), DlPaint(DlColor::kRed()));
+  return builder.Build();
+}
+
+LayerSnapshotStore::SamplingOptions MakeSamplingOptions() {
+  LayerSnapshotStore::SamplingOptions options;
+  options.layer_types = LayerSnapshotStore::kDisplayListLayers;
+  options.min_duration = fml::TimeDelta::FromMilliseconds(1);
+  options.max_dimension = 64;
+  // Room for a single uncompressed 64x64 thumbnail.
+  options.memory_budget = 64 * 64 * 4;
+  return options;
+}
+
+}  // namespace
+
+TEST(LayerSnapshotStoreTest, SamplingIsDisabledByDefault) {
+  LayerSnapshotStore store;
+  EXPECT_FALSE(store.IsSampling());
+  EXPECT_FALSE(store.IsSampling(LayerSnapshotStore::kDisplayListLayers));
+}
+
+TEST(LayerSnapshotStoreTest, SamplesSlowLayersAsThumbnails) {
+  LayerSnapshotStore store;
+  store.SetSamplingOptions(MakeSamplingOptions());
+  ASSERT_TRUE(store.IsSampling(LayerSnapshotStore::kDisplayListLayers));
+
+  const SkRect bounds = SkRect::MakeXYWH(10, 20, 256, 128);
+  const auto slow = fml::TimeDelta::FromMilliseconds(2);
+  store.Sample(1, slow, MakeDisplayList(), SkM44(), bounds);
+  // Layers are only sampled once.
+  store.Sample(1, slow, MakeDisplayList(), SkM44(), bounds);
+  // Fast layers are not sampled.
+  store.Sample(2, fml::TimeDelta::FromMicroseconds(500), MakeDisplayList(),
+               SkM44(), bounds);
+  EXPECT_EQ(store.pending_sample_count(), 1u);
+  EXPECT_TRUE(store.samples().empty());
+
+  // Without a GrDirectContext the thumbnails are read back right away.
+  store.CaptureSamples(nullptr);
+  EXPECT_EQ(store.pending_sample_count(), 0u);
+  ASSERT_EQ(store.samples().size(), 1u);
+  const LayerSnapshotData& sample = store.samples()[0];
+  EXPECT_EQ(sample.GetLayerUniqueId(), 1);
+  EXPECT_EQ(sample.GetDuration(), slow);
+  EXPECT_EQ(sample.GetBounds(), bounds);
+  ASSERT_NE(sample.GetSnapshot(), nullptr);
+  EXPECT_GT(sample.GetSnapshot()->size(), 0u);
+
+  store.Sample(1, slow, MakeDisplayList(), SkM44(), bounds);
+  EXPECT_EQ(store.pending_sample_count(), 0u);
+}
+
+TEST(LayerSnapshotStoreTest, SlowerLayersReplaceFasterSamples) {
+  LayerSnapshotStore store;
+  store.SetSamplingOptions(MakeSamplingOptions());
+  const SkRect bounds = SkRect::MakeWH(64, 64);
+
+  store.Sample(1, fml::TimeDelta::FromMilliseconds(2), MakeDisplayList(),
+               SkM44(), bounds);
+  store.CaptureSamples(nullptr);
+  ASSERT_EQ(store.samples().size(), 1u);
+
+  // There is no room for a faster layer.
+  store.Sample(2, fml::TimeDelta::FromMilliseconds(1), MakeDisplayList(),
+               SkM44(), bounds);
+  EXPECT_EQ(store.pending_sample_count(), 0u);
+  EXPECT_EQ(store.samples().size(), 1u);
+
+  // A slower layer takes the place of the faster one.
+  store.Sample(3, fml::TimeDelta::FromMilliseconds(3), MakeDisplayList(),
+               SkM44(), bounds);
+  EXPECT_EQ(store.pending_sample_count(), 1u);
+  EXPECT_TRUE(store.samples().empty());
+
+  store.CaptureSamples(nullptr);
+  ASSERT_EQ(store.samples().size(), 1u);
+  EXPECT_EQ(store.samples()[0].GetLayerUniqueId(), 3);
+
+  store.SetSamplingOptions({});
+  EXPECT_FALSE(store.IsSampling());
+  EXPECT_TRUE(store.samples().empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
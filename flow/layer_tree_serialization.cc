@@ -0,0 +1,466 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_tree_serialization.h"
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// The format is a header, a table of the sizes of the images drawn by the
+// tree, and the layers in depth first order. Each layer is a |LayerKind| tag
+// followed by its properties and, for containers, the number of children and
+// the children. Like the display list format, every field is a multiple of 4
+// bytes wide so that the nested display lists stay 4 byte aligned.
+//
+// Changing the layout of a layer requires bumping |kFormatVersion|.
+
+// "FLLT" in memory on a little endian host.
+constexpr uint32_t kFormatMagic = 0x544c4c46u;
+constexpr uint32_t kFormatVersion = 1u;
+
+// Bounds the recursion of malformed data.
+constexpr int kMaxDepth = 1024;
+
+enum class LayerKind : uint32_t {
+  kContainer = 0,
+  kTransform = 1,
+  kOpacity = 2,
+  kClipRect = 3,
+  kClipRRect = 4,
+  kClipPath = 5,
+  kDisplayList = 6,
+};
+
+struct ImageEntry {
+  uint64_t id;
+  int32_t width;
+  int32_t height;
+};
+
+class Writer {
+ public:
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % 4 == 0, "Fields must keep 4 byte alignment.");
+    Append(&value, sizeof(T));
+  }
+
+  void WriteBool(bool value) { Write<uint32_t>(value ? 1u : 0u); }
+
+  template <typename E>
+  void WriteEnum(E value) {
+    static_assert(std::is_enum_v<E>);
+    Write<uint32_t>(static_cast<uint32_t>(value));
+  }
+
+  // Writes a size prefixed run of bytes padded to keep 4 byte alignment.
+  void WriteBlob(const void* data, size_t size) {
+    Write<uint32_t>(static_cast<uint32_t>(size));
+    Append(data, size);
+    data_.resize((data_.size() + 3u) & ~size_t{3u}, 0u);
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+
+  void Append(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+  }
+};
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : cursor_(data), end_(data + size) {
+    FML_DCHECK(reinterpret_cast<uintptr_t>(data) % 4 == 0);
+  }
+
+  bool ok() const { return error_.empty(); }
+
+  bool at_end() const { return cursor_ == end_; }
+
+  const std::string& error() const { return error_; }
+
+  void Fail(const std::string& error) {
+    if (error_.empty()) {
+      error_ = error;
+    }
+    cursor_ = end_;
+  }
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (const void* data = Consume(sizeof(T))) {
+      memcpy(&value, data, sizeof(T));
+    }
+    return value;
+  }
+
+  bool ReadBool() { return Read<uint32_t>() != 0u; }
+
+  template <typename E>
+  E ReadEnum(E last) {
+    static_assert(std::is_enum_v<E>);
+    const uint32_t value = Read<uint32_t>();
+    if (value > static_cast<uint32_t>(last)) {
+      Fail("Invalid enum value.");
+      return static_cast<E>(0);
+    }
+    return static_cast<E>(value);
+  }
+
+  const uint8_t* ReadBlob(size_t* size) {
+    *size = Read<uint32_t>();
+    if (*size > static_cast<size_t>(end_ - cursor_)) {
+      Fail("Data extends past the end of the layer tree.");
+      return nullptr;
+    }
+    const auto* data = static_cast<const uint8_t*>(Consume(*size));
+    // Skip the padding.
+    Consume(((*size + 3u) & ~size_t{3u}) - *size);
+    return data;
+  }
+
+ private:
+  const uint8_t* cursor_;
+  const uint8_t* end_;
+  std::string error_;
+
+  const void* Consume(size_t size) {
+    if (!ok()) {
+      return nullptr;
+    }
+    if (size > static_cast<size_t>(end_ - cursor_)) {
+      Fail("Unexpected end of data.");
+      return nullptr;
+    }
+    const uint8_t* data = cursor_;
+    cursor_ += size;
+    return data;
+  }
+};
+
+class LayerTreeSerializer {
+ public:
+  bool ok() const { return error_.empty(); }
+
+  const std::string& error() const { return error_; }
+
+  void WriteLayer(const Layer* layer, bool is_root) {
+    if (!ok()) {
+      return;
+    }
+    if (auto* transform = layer->as_transform_layer()) {
+      writer_.WriteEnum(LayerKind::kTransform);
+      SkScalar values[16];
+      transform->transform().getColMajor(values);
+      for (SkScalar value : values) {
+        writer_.Write(value);
+      }
+    } else if (auto* opacity = layer->as_opacity_layer()) {
+      writer_.WriteEnum(LayerKind::kOpacity);
+      writer_.Write<uint32_t>(opacity->alpha());
+      writer_.Write(opacity->offset());
+    } else if (auto* clip_rect = layer->as_clip_rect_layer()) {
+      writer_.WriteEnum(LayerKind::kClipRect);
+      writer_.Write(clip_rect->clip_shape());
+      writer_.WriteEnum(clip_rect->clip_behavior());
+    } else if (auto* clip_rrect = layer->as_clip_rrect_layer()) {
+      writer_.WriteEnum(LayerKind::kClipRRect);
+      uint8_t rrect[SkRRect::kSizeInMemory];
+      clip_rrect->clip_shape().writeToMemory(rrect);
+      writer_.WriteBlob(rrect, sizeof(rrect));
+      writer_.WriteEnum(clip_rrect->clip_behavior());
+    } else if (auto* clip_path = layer->as_clip_path_layer()) {
+      writer_.WriteEnum(LayerKind::kClipPath);
+      const SkPath& path = clip_path->clip_shape();
+      std::vector<uint8_t> buffer(path.writeToMemory(nullptr));
+      path.writeToMemory(buffer.data());
+      writer_.WriteBlob(buffer.data(), buffer.size());
+      writer_.WriteEnum(clip_path->clip_behavior());
+    } else if (auto* display_list = layer->as_display_list_layer()) {
+      WriteDisplayListLayer(display_list);
+      return;
+    } else if (layer->as_container_layer() && is_root) {
+      // The scene builder always roots the tree in a plain container. Other
+      // containers can't be told apart from the unsupported container layers.
+      writer_.WriteEnum(LayerKind::kContainer);
+    } else {
+      Fail("Only container, transform, opacity, clip and display list layers "
+           "can be serialized.");
+      return;
+    }
+
+    const auto& children = layer->as_container_layer()->layers();
+    writer_.Write<uint32_t>(children.size());
+    for (const auto& child : children) {
+      WriteLayer(child.get(), false);
+    }
+  }
+
+  void WriteImageTable(Writer& writer) const {
+    writer.Write<uint32_t>(images_.size());
+    for (const auto& image : images_) {
+      writer.Write(image);
+    }
+  }
+
+  std::vector<uint8_t> TakeLayers() { return writer_.TakeData(); }
+
+ private:
+  Writer writer_;
+  std::unordered_map<const DlImage*, uint64_t> image_ids_;
+  std::vector<ImageEntry> images_;
+  std::string error_;
+
+  void Fail(const std::string& error) {
+    if (error_.empty()) {
+      error_ = error;
+    }
+  }
+
+  void WriteDisplayListLayer(const DisplayListLayer* layer) {
+    writer_.WriteEnum(LayerKind::kDisplayList);
+    writer_.Write(layer->offset());
+    writer_.WriteBool(layer->raster_cache_item()->is_complex());
+    writer_.WriteBool(layer->raster_cache_item()->will_change());
+    std::string error;
+    auto serialized = SerializeDisplayList(
+        *layer->display_list(),
+        [this](const sk_sp<DlImage>& image) -> std::optional<uint64_t> {
+          auto [found, inserted] =
+              image_ids_.try_emplace(image.get(), images_.size());
+          if (inserted) {
+            const SkISize size = image->dimensions();
+            images_.push_back({found->second, size.width(), size.height()});
+          }
+          return found->second;
+        },
+        &error);
+    if (!serialized) {
+      Fail(error);
+      return;
+    }
+    writer_.WriteBlob(serialized->GetMapping(), serialized->GetSize());
+  }
+};
+
+class LayerTreeDeserializer {
+ public:
+  LayerTreeDeserializer(Reader& reader,
+                        const LayerTreeImageResolver& image_resolver)
+      : reader_(reader), image_resolver_(image_resolver) {}
+
+  bool ReadImageTable() {
+    const uint32_t count = reader_.Read<uint32_t>();
+    for (uint32_t i = 0; i < count && reader_.ok(); i++) {
+      const auto entry = reader_.Read<ImageEntry>();
+      image_sizes_[entry.id] = SkISize::Make(entry.width, entry.height);
+    }
+    return reader_.ok();
+  }
+
+  std::shared_ptr<Layer> ReadLayer(int depth) {
+    if (depth >= kMaxDepth) {
+      reader_.Fail("Layers are nested too deeply.");
+      return nullptr;
+    }
+    std::shared_ptr<ContainerLayer> container;
+    switch (reader_.ReadEnum(LayerKind::kDisplayList)) {
+      case LayerKind::kContainer:
+        container = std::make_shared<ContainerLayer>();
+        break;
+      case LayerKind::kTransform: {
+        SkScalar values[16];
+        for (SkScalar& value : values) {
+          value = reader_.Read<SkScalar>();
+        }
+        container =
+            std::make_shared<TransformLayer>(SkM44::ColMajor(values));
+        break;
+      }
+      case LayerKind::kOpacity: {
+        const auto alpha = reader_.Read<uint32_t>();
+        const auto offset = reader_.Read<SkPoint>();
+        if (alpha > SK_AlphaOPAQUE) {
+          reader_.Fail("Invalid opacity.");
+          return nullptr;
+        }
+        container = std::make_shared<OpacityLayer>(alpha, offset);
+        break;
+      }
+      case LayerKind::kClipRect: {
+        const auto rect = reader_.Read<SkRect>();
+        const auto clip = ReadClip();
+        container = std::make_shared<ClipRectLayer>(rect, clip);
+        break;
+      }
+      case LayerKind::kClipRRect: {
+        size_t size = 0;
+        const uint8_t* data = reader_.ReadBlob(&size);
+        const auto clip = ReadClip();
+        SkRRect rrect;
+        if (data && rrect.readFromMemory(data, size) == 0) {
+          reader_.Fail("Invalid round rect.");
+        }
+        container = std::make_shared<ClipRRectLayer>(rrect, clip);
+        break;
+      }
+      case LayerKind::kClipPath: {
+        size_t size = 0;
+        const uint8_t* data = reader_.ReadBlob(&size);
+        const auto clip = ReadClip();
+        SkPath path;
+        if (data && path.readFromMemory(data, size) != size) {
+          reader_.Fail("Invalid path.");
+        }
+        container = std::make_shared<ClipPathLayer>(path, clip);
+        break;
+      }
+      case LayerKind::kDisplayList:
+        return ReadDisplayListLayer();
+    }
+    const uint32_t child_count = reader_.Read<uint32_t>();
+    for (uint32_t i = 0; i < child_count && reader_.ok(); i++) {
+      if (auto child = ReadLayer(depth + 1)) {
+        container->Add(child);
+      }
+    }
+    return reader_.ok() ? container : nullptr;
+  }
+
+ private:
+  Reader& reader_;
+  const LayerTreeImageResolver& image_resolver_;
+  std::unordered_map<uint64_t, SkISize> image_sizes_;
+
+  Clip ReadClip() { return reader_.ReadEnum(Clip::antiAliasWithSaveLayer); }
+
+  std::shared_ptr<Layer> ReadDisplayListLayer() {
+    const auto offset = reader_.Read<SkPoint>();
+    const bool is_complex = reader_.ReadBool();
+    const bool will_change = reader_.ReadBool();
+    size_t size = 0;
+    const uint8_t* data = reader_.ReadBlob(&size);
+    if (!reader_.ok()) {
+      return nullptr;
+    }
+    std::string error;
+    auto display_list = DeserializeDisplayList(
+        fml::NonOwnedMapping(data, size),
+        [this](uint64_t id) -> sk_sp<DlImage> {
+          auto found = image_sizes_.find(id);
+          if (found == image_sizes_.end() || !image_resolver_) {
+            return nullptr;
+          }
+          return image_resolver_(id, found->second);
+        },
+        &error);
+    if (!display_list) {
+      reader_.Fail(error);
+      return nullptr;
+    }
+    return std::make_shared<DisplayListLayer>(offset, std::move(display_list),
+                                              is_complex, will_change);
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> SerializeLayerTree(const LayerTree& layer_tree,
+                                                 std::string* error) {
+  LayerTreeSerializer serializer;
+  if (layer_tree.root_layer()) {
+    serializer.WriteLayer(layer_tree.root_layer(), true);
+  }
+  if (!serializer.ok()) {
+    if (error) {
+      *error = serializer.error();
+    }
+    return nullptr;
+  }
+
+  Writer writer;
+  writer.Write(kFormatMagic);
+  writer.Write(kFormatVersion);
+  writer.Write<int32_t>(layer_tree.frame_size().width());
+  writer.Write<int32_t>(layer_tree.frame_size().height());
+  writer.WriteBool(layer_tree.root_layer() != nullptr);
+  serializer.WriteImageTable(writer);
+  std::vector<uint8_t> data = writer.TakeData();
+  std::vector<uint8_t> layers = serializer.TakeLayers();
+  data.insert(data.end(), layers.begin(), layers.end());
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+std::unique_ptr<LayerTree> DeserializeLayerTree(
+    const fml::Mapping& mapping,
+    const LayerTreeImageResolver& image_resolver,
+    std::string* error) {
+  const uint8_t* data = mapping.GetMapping();
+  const size_t size = mapping.GetSize();
+
+  std::vector<uint8_t> aligned_copy;
+  if (reinterpret_cast<uintptr_t>(data) % 4 != 0) {
+    aligned_copy.assign(data, data + size);
+    data = aligned_copy.data();
+  }
+
+  Reader reader(data, size);
+  auto fail = [&](const std::string& message) {
+    reader.Fail(message);
+    if (error) {
+      *error = reader.error();
+    }
+    return nullptr;
+  };
+
+  if (reader.Read<uint32_t>() != kFormatMagic) {
+    return fail("Not a serialized layer tree.");
+  }
+  if (reader.Read<uint32_t>() != kFormatVersion) {
+    return fail("Unsupported serialized layer tree version.");
+  }
+  const auto width = reader.Read<int32_t>();
+  const auto height = reader.Read<int32_t>();
+  const bool has_root = reader.ReadBool();
+
+  LayerTreeDeserializer deserializer(reader, image_resolver);
+  std::shared_ptr<Layer> root;
+  if (deserializer.ReadImageTable() && has_root) {
+    root = deserializer.ReadLayer(0);
+  }
+  if (!reader.ok()) {
+    return fail(reader.error());
+  }
+  if (!reader.at_end()) {
+    return fail("Unexpected data after the end of the layer tree.");
+  }
+  LayerTree::Config config;
+  config.root_layer = std::move(root);
+  return std::make_unique<LayerTree>(config, SkISize::Make(width, height));
+}
+
+}  // namespace flutter
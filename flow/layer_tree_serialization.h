@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_TREE_SERIALIZATION_H_
+#define FLUTTER_FLOW_LAYER_TREE_SERIALIZATION_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+/// Recreates an image of a serialized layer tree from its id and size. The
+/// ids are assigned by |SerializeLayerTree| and only identify images within
+/// one tree, so resolvers typically return a placeholder of the same size.
+/// Returning nullptr fails the deserialization.
+using LayerTreeImageResolver =
+    std::function<sk_sp<DlImage>(uint64_t id, const SkISize& size)>;
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes the structure of |layer_tree| and the display lists
+///             of its leaves, so that the frame can be replayed later, for
+///             example to benchmark the rasterization of frames captured from
+///             a running application.
+///
+///             Container, transform, opacity, clip and display list layers
+///             are supported. Filter, shader mask, texture, platform view
+///             and performance overlay layers, and display lists that can't
+///             be serialized by |SerializeDisplayList|, fail the
+///             serialization.
+///
+///             The pixels of images are not written, only their sizes.
+///
+/// @param[in]  layer_tree  The layer tree to serialize.
+/// @param[out] error       If not null, receives a description of the first
+///                         unsupported layer or operation on failure.
+///
+/// @return     The serialized layer tree, or nullptr on failure.
+///
+std::unique_ptr<fml::Mapping> SerializeLayerTree(const LayerTree& layer_tree,
+                                                 std::string* error = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      Recreates a layer tree serialized with |SerializeLayerTree|.
+///
+/// @param[in]  mapping         The serialized layer tree.
+/// @param[in]  image_resolver  Recreates the images drawn by the tree. May be
+///                             null if the tree draws no images.
+/// @param[out] error           If not null, receives a description of the
+///                             problem on failure.
+///
+/// @return     The layer tree, or nullptr on failure.
+///
+std::unique_ptr<LayerTree> DeserializeLayerTree(
+    const fml::Mapping& mapping,
+    const LayerTreeImageResolver& image_resolver = nullptr,
+    std::string* error = nullptr);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_TREE_SERIALIZATION_H_
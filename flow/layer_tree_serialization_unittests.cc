@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_tree_serialization.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeDisplayList(const SkRect& rect) {
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, DlPaint(DlColor::kBlue()));
+  return builder.Build();
+}
+
+std::unique_ptr<LayerTree> MakeLayerTree(std::shared_ptr<Layer> root) {
+  LayerTree::Config config;
+  config.root_layer = std::move(root);
+  return std::make_unique<LayerTree>(config, SkISize::Make(400, 300));
+}
+
+std::unique_ptr<LayerTree> MakeSampleLayerTree() {
+  auto root = std::make_shared<ContainerLayer>();
+  auto transform =
+      std::make_shared<TransformLayer>(SkM44::Translate(10, 20).preScale(2, 3));
+  auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(5, 6));
+  auto clip_rect = std::make_shared<ClipRectLayer>(
+      SkRect::MakeLTRB(0, 0, 100, 100), Clip::hardEdge);
+  auto clip_rrect = std::make_shared<ClipRRectLayer>(
+      SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 80, 80), 4, 4),
+      Clip::antiAlias);
+  auto clip_path = std::make_shared<ClipPathLayer>(
+      SkPath().addCircle(40, 40, 30), Clip::antiAliasWithSaveLayer);
+  clip_path->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(1, 2), MakeDisplayList(SkRect::MakeLTRB(0, 0, 50, 50)),
+      true, false));
+  clip_rrect->Add(clip_path);
+  clip_rect->Add(clip_rrect);
+  opacity->Add(clip_rect);
+  transform->Add(opacity);
+  root->Add(transform);
+  root->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10)),
+      false, true));
+  return MakeLayerTree(root);
+}
+
+}  // namespace
+
+TEST(LayerTreeSerialization, SampleTreeRoundTrips) {
+  auto layer_tree = MakeSampleLayerTree();
+  std::string error;
+  auto serialized = SerializeLayerTree(*layer_tree, &error);
+  ASSERT_NE(serialized, nullptr) << error;
+  auto result = DeserializeLayerTree(*serialized, nullptr, &error);
+  ASSERT_NE(result, nullptr) << error;
+  EXPECT_EQ(result->frame_size(), layer_tree->frame_size());
+
+  auto* root = result->root_layer()->as_container_layer();
+  ASSERT_NE(root, nullptr);
+  ASSERT_EQ(root->layers().size(), 2u);
+
+  auto* transform = root->layers()[0]->as_transform_layer();
+  ASSERT_NE(transform, nullptr);
+  EXPECT_EQ(transform->transform(), SkM44::Translate(10, 20).preScale(2, 3));
+  ASSERT_EQ(transform->layers().size(), 1u);
+
+  auto* opacity = transform->layers()[0]->as_opacity_layer();
+  ASSERT_NE(opacity, nullptr);
+  EXPECT_EQ(opacity->alpha(), 128);
+  EXPECT_EQ(opacity->offset(), SkPoint::Make(5, 6));
+  ASSERT_EQ(opacity->layers().size(), 1u);
+
+  auto* clip_rect = opacity->layers()[0]->as_clip_rect_layer();
+  ASSERT_NE(clip_rect, nullptr);
+  EXPECT_EQ(clip_rect->clip_shape(), SkRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(clip_rect->clip_behavior(), Clip::hardEdge);
+  ASSERT_EQ(clip_rect->layers().size(), 1u);
+
+  auto* clip_rrect = clip_rect->layers()[0]->as_clip_rrect_layer();
+  ASSERT_NE(clip_rrect, nullptr);
+  EXPECT_EQ(clip_rrect->clip_shape(),
+            SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 80, 80), 4, 4));
+  EXPECT_EQ(clip_rrect->clip_behavior(), Clip::antiAlias);
+  ASSERT_EQ(clip_rrect->layers().size(), 1u);
+
+  auto* clip_path = clip_rrect->layers()[0]->as_clip_path_layer();
+  ASSERT_NE(clip_path, nullptr);
+  EXPECT_EQ(clip_path->clip_shape(), SkPath().addCircle(40, 40, 30));
+  EXPECT_EQ(clip_path->clip_behavior(), Clip::antiAliasWithSaveLayer);
+  ASSERT_EQ(clip_path->layers().size(), 1u);
+
+  auto* leaf = clip_path->layers()[0]->as_display_list_layer();
+  ASSERT_NE(leaf, nullptr);
+  EXPECT_EQ(leaf->offset(), SkPoint::Make(1, 2));
+  EXPECT_TRUE(leaf->raster_cache_item()->is_complex());
+  EXPECT_FALSE(leaf->raster_cache_item()->will_change());
+  EXPECT_EQ(leaf->display_list()->bounds(), SkRect::MakeLTRB(0, 0, 50, 50));
+
+  auto* sibling = root->layers()[1]->as_display_list_layer();
+  ASSERT_NE(sibling, nullptr);
+  EXPECT_FALSE(sibling->raster_cache_item()->is_complex());
+  EXPECT_TRUE(sibling->raster_cache_item()->will_change());
+}
+
+TEST(LayerTreeSerialization, EmptyTreeRoundTrips) {
+  auto serialized = SerializeLayerTree(*MakeLayerTree(nullptr));
+  ASSERT_NE(serialized, nullptr);
+  auto result = DeserializeLayerTree(*serialized);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(result->root_layer(), nullptr);
+  EXPECT_EQ(result->frame_size(), SkISize::Make(400, 300));
+}
+
+TEST(LayerTreeSerialization, UnsupportedLayersFail) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<ColorFilterLayer>(nullptr));
+  std::string error;
+  EXPECT_EQ(SerializeLayerTree(*MakeLayerTree(root), &error), nullptr);
+  EXPECT_FALSE(error.empty());
+
+  // Only the root can be a plain container.
+  root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<ContainerLayer>());
+  EXPECT_EQ(SerializeLayerTree(*MakeLayerTree(root)), nullptr);
+}
+
+TEST(LayerTreeSerialization, ImagesAreResolvedBySize) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, SkPoint::Make(0, 0), DlImageSampling::kLinear);
+  builder.DrawImage(TestImage1, SkPoint::Make(10, 10),
+                    DlImageSampling::kLinear);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), builder.Build(), false, false));
+  auto serialized = SerializeLayerTree(*MakeLayerTree(root));
+  ASSERT_NE(serialized, nullptr);
+
+  EXPECT_EQ(DeserializeLayerTree(*serialized), nullptr);
+
+  std::vector<SkISize> sizes;
+  auto result = DeserializeLayerTree(
+      *serialized,
+      [&sizes](uint64_t id, const SkISize& size) -> sk_sp<DlImage> {
+        sizes.push_back(size);
+        return TestImage1;
+      });
+  ASSERT_NE(result, nullptr);
+  ASSERT_FALSE(sizes.empty());
+  for (const SkISize& size : sizes) {
+    EXPECT_EQ(size, TestImage1->dimensions());
+  }
+}
+
+TEST(LayerTreeSerialization, MalformedDataIsRejected) {
+  auto serialized = SerializeLayerTree(*MakeSampleLayerTree());
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> data(serialized->GetMapping(),
+                            serialized->GetMapping() + serialized->GetSize());
+
+  for (size_t size = 0; size < data.size(); size += 4) {
+    fml::NonOwnedMapping truncated(data.data(), size);
+    std::string error;
+    EXPECT_EQ(DeserializeLayerTree(truncated, nullptr, &error), nullptr)
+        << size;
+    EXPECT_FALSE(error.empty());
+  }
+
+  std::vector<uint8_t> other_version = data;
+  other_version[4] ^= 0xff;
+  EXPECT_EQ(DeserializeLayerTree(fml::DataMapping(other_version)), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
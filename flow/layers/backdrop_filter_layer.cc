@@ -6,6 +6,8 @@
 
 namespace flutter {
 
+static const auto* flow_type = "RasterCacheFlow::BackdropFilter";
+
 BackdropFilterLayer::BackdropFilterLayer(
     std::shared_ptr<const DlImageFilter> filter,
     DlBlendMode blend_mode)
@@ -32,6 +34,18 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     filter_->get_input_device_bounds(
         filter_target_bounds, context->GetTransform3x3(), filter_input_bounds);
     context->AddReadbackRegion(filter_input_bounds);
+
+    // The layers diffed so far are the ones painted behind this layer, so the
+    // filtered backdrop of the previous frame can still be used if none of
+    // them changed within the pixels that the filter reads.
+    bool backdrop_unchanged = !context->IsSubtreeDirty() &&
+                              prev->backdrop_cache_id_ != 0 &&
+                              !context->IsDamaged(filter_input_bounds);
+    backdrop_cache_id_ =
+        backdrop_unchanged ? prev->backdrop_cache_id_ : NextUniqueID();
+    backdrop_bounds_ = filter_target_bounds;
+    backdrop_input_bounds_ = filter_input_bounds;
+    backdrop_diffed_ = true;
   }
 
   DiffChildren(context, prev);
@@ -40,6 +54,23 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 }
 
 void BackdropFilterLayer::Preroll(PrerollContext* context) {
+  // Without a diff of this frame there is no telling whether the backdrop
+  // changed, which also breaks the chain of unchanged frames.
+  if (!backdrop_diffed_) {
+    backdrop_cache_id_ = 0;
+  }
+  backdrop_diffed_ = false;
+  paint_cached_backdrop_ = false;
+  if (backdrop_cache_id_ != 0 && context->raster_cache &&
+      context->raster_cache->access_threshold() != 0) {
+    // The entry is new whenever the backdrop changes, so its access count
+    // is the number of frames that the backdrop has been unchanged.
+    auto cache_info = context->raster_cache->MarkSeen(backdrop_cache_key_id(),
+                                                      SkMatrix::I(), true);
+    paint_cached_backdrop_ = cache_info.accesses_since_visible >
+                             context->raster_cache->access_threshold();
+  }
+
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
   if (filter_ && context->view_embedder != nullptr) {
@@ -57,9 +88,113 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   auto mutator = context.state_stack.save();
-  mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  if (!PaintCachedBackdrop(context, mutator)) {
+    mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  }
 
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::PaintCachedBackdrop(
+    PaintContext& context,
+    LayerStateStack::MutatorContext& mutator) const {
+  // The backdrop is drawn again by painting the tree up to this layer, which
+  // only gives the pixels that the filter reads if they are on the frame
+  // canvas rather than in a save layer or in an overlay of a platform view.
+  if (!paint_cached_backdrop_ || !context.raster_cache ||
+      !context.root_layer || context.paint_stop_layer ||
+      context.rendering_above_platform_view ||
+      context.state_stack.has_save_layer()) {
+    return false;
+  }
+
+  // The diff bounds are relative to the root of the canvas, and the filter
+  // reads no further than the edges of the frame.
+  const SkMatrix root_transform = context.root_transform.asM33();
+  const SkIRect frame_bounds =
+      SkIRect::MakeSize(context.canvas->GetBaseLayerSize());
+  SkIRect input_bounds =
+      root_transform.mapRect(SkRect::Make(backdrop_input_bounds_)).roundOut();
+  SkIRect bounds =
+      root_transform.mapRect(SkRect::Make(backdrop_bounds_)).roundOut();
+  if (!input_bounds.intersect(frame_bounds) ||
+      !bounds.intersect(frame_bounds)) {
+    return false;
+  }
+
+  const SkRect logical_rect = SkRect::Make(input_bounds);
+  RasterCache::Context cache_context = {
+      // clang-format off
+      .gr_context         = context.gr_context,
+      .dst_color_space    = context.dst_color_space,
+      .matrix             = SkMatrix::I(),
+      .logical_rect       = logical_rect,
+      .flow_type          = flow_type,
+      // clang-format on
+  };
+  const SkM44 transform = context.state_stack.transform_4x4();
+  if (!context.raster_cache->UpdateCacheEntry(
+          backdrop_cache_key_id(), cache_context,
+          [this, &context, &transform](DlCanvas* canvas) {
+            DrawFilteredBackdrop(context, transform, canvas);
+          })) {
+    return false;
+  }
+
+  // A save layer with a backdrop filter starts out with the filtered
+  // backdrop, so the cached one is drawn into a plain save layer instead.
+  mutator.applyBackdropFilter(paint_bounds(), nullptr, blend_mode_);
+  DlAutoCanvasRestore restore(context.canvas, true);
+  context.canvas->TransformReset();
+  context.canvas->ClipRect(SkRect::Make(bounds));
+  context.raster_cache->Draw(backdrop_cache_key_id(), *context.canvas, nullptr);
+  return true;
+}
+
+void BackdropFilterLayer::DrawFilteredBackdrop(const PaintContext& context,
+                                               const SkM44& transform,
+                                               DlCanvas* canvas) const {
+  {
+    DlAutoCanvasRestore restore(canvas, true);
+    canvas->Transform(context.root_transform);
+    LayerStateStack state_stack;
+    state_stack.set_delegate(canvas);
+    PaintContext backdrop_context = {
+        // clang-format off
+        .state_stack                   = state_stack,
+        .canvas                        = canvas,
+        .gr_context                    = context.gr_context,
+        .dst_color_space               = context.dst_color_space,
+        .view_embedder                 = nullptr,
+        .raster_time                   = context.raster_time,
+        .ui_time                       = context.ui_time,
+        .texture_registry              = context.texture_registry,
+        .raster_cache                  = context.raster_cache,
+        .layer_snapshot_store          = nullptr,
+        .enable_leaf_layer_tracing     = false,
+        .offscreen_surface_pool        = context.offscreen_surface_pool,
+        .impeller_enabled              = false,
+        .aiks_context                  = nullptr,
+        .gpu_time                      = context.gpu_time,
+        .root_layer                    = context.root_layer,
+        .root_transform                = context.root_transform,
+        .paint_stop_layer              = this,
+        // clang-format on
+    };
+    if (context.root_layer != this &&
+        context.root_layer->needs_painting(backdrop_context)) {
+      context.root_layer->Paint(backdrop_context);
+    }
+  }
+
+  // Restoring an empty save layer with kSrc replaces the backdrop with the
+  // result of the filter.
+  DlAutoCanvasRestore restore(canvas, true);
+  canvas->Transform(transform);
+  DlPaint paint;
+  paint.setBlendMode(DlBlendMode::kSrc);
+  canvas->SaveLayer(nullptr, &paint, filter_.get());
+  canvas->Restore();
+}
+
 }  // namespace flutter
@@ -10,6 +10,14 @@
 
 namespace flutter {
 
+// Applies a filter to the content painted behind the layer before its
+// children are painted on top.
+//
+// When the frame has been diffed, the layer knows whether the content behind
+// it changed within the filter input bounds. Once that content has stayed the
+// same for as many frames as the raster cache needs to see an item, the
+// filtered backdrop is kept in the raster cache, where it counts against the
+// cache's byte budget, and drawn from there rather than filtered again.
 class BackdropFilterLayer : public ContainerLayer {
  public:
   BackdropFilterLayer(std::shared_ptr<const DlImageFilter> filter,
@@ -21,10 +29,36 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // The id of the raster cache entry for the filtered backdrop, which is
+  // kept from the previous frame for as long as the backdrop is unchanged,
+  // or 0 if the backdrop can't be cached in this frame.
+  uint64_t backdrop_cache_id() const { return backdrop_cache_id_; }
+
  private:
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
 
+  // The device bounds of the layer and of the pixels its filter reads, as
+  // computed by the last |Diff|.
+  SkIRect backdrop_bounds_ = SkIRect::MakeEmpty();
+  SkIRect backdrop_input_bounds_ = SkIRect::MakeEmpty();
+  uint64_t backdrop_cache_id_ = 0;
+  bool backdrop_diffed_ = false;
+  bool paint_cached_backdrop_ = false;
+
+  RasterCacheKeyID backdrop_cache_key_id() const {
+    return RasterCacheKeyID(backdrop_cache_id_,
+                            RasterCacheKeyType::kBackdropFilter);
+  }
+
+  bool PaintCachedBackdrop(PaintContext& context,
+                           LayerStateStack::MutatorContext& mutator) const;
+
+  void DrawFilteredBackdrop(const PaintContext& context,
+                            const SkIRect& input_bounds,
+                            const SkM44& transform,
+                            DlCanvas* canvas) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
 
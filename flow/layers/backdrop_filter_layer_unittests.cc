@@ -508,5 +508,95 @@ TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeWH(100, 100));
 }
 
+TEST_F(BackdropLayerDiffTest, BackdropCacheIdFollowsDamageBehindLayer) {
+  auto filter = DlBlurImageFilter(10, 10, DlTileMode::kClamp);
+  auto background =
+      std::make_shared<MockLayer>(SkPath().addRect(SkRect::MakeWH(100, 100)));
+  auto backdrop = std::make_shared<BackdropFilterLayer>(filter.shared(),
+                                                        DlBlendMode::kSrcOver);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(40, 40, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(backdrop);
+
+  MockLayerTree l1;
+  l1.root()->Add(background);
+  l1.root()->Add(clip);
+  DiffLayerTree(l1, MockLayerTree());
+  uint64_t cache_id = backdrop->backdrop_cache_id();
+  EXPECT_NE(cache_id, 0u);
+
+  // Nothing changed.
+  MockLayerTree l2;
+  l2.root()->Add(background);
+  l2.root()->Add(clip);
+  DiffLayerTree(l2, l1);
+  EXPECT_EQ(backdrop->backdrop_cache_id(), cache_id);
+
+  // Content painted on top of the layer doesn't change its backdrop.
+  MockLayerTree l3;
+  l3.root()->Add(background);
+  l3.root()->Add(clip);
+  l3.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(45, 45, 55, 55))));
+  DiffLayerTree(l3, l2);
+  EXPECT_EQ(backdrop->backdrop_cache_id(), cache_id);
+
+  // Content behind the layer outside of the readback region doesn't either.
+  MockLayerTree l4;
+  l4.root()->Add(background);
+  l4.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(200, 200, 210, 210))));
+  l4.root()->Add(clip);
+  DiffLayerTree(l4, l3);
+  EXPECT_EQ(backdrop->backdrop_cache_id(), cache_id);
+
+  // Content behind the layer inside of the readback region does.
+  MockLayerTree l5;
+  l5.root()->Add(background);
+  l5.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(80, 80, 90, 90))));
+  l5.root()->Add(clip);
+  DiffLayerTree(l5, l4);
+  EXPECT_NE(backdrop->backdrop_cache_id(), cache_id);
+  EXPECT_NE(backdrop->backdrop_cache_id(), 0u);
+}
+
+TEST_F(BackdropLayerDiffTest, UnchangedBackdropIsPaintedFromRasterCache) {
+  use_skia_raster_cache();
+  auto filter = DlBlurImageFilter(5, 5, DlTileMode::kClamp);
+  auto background = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(100, 100)), DlPaint(DlColor::kRed()));
+  auto backdrop = std::make_shared<BackdropFilterLayer>(filter.shared(),
+                                                        DlBlendMode::kSrcOver);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(backdrop);
+
+  const SkISize frame_size = SkISize::Make(500, 500);
+  auto old_tree = std::make_unique<MockLayerTree>(frame_size);
+  const size_t frames = raster_cache()->access_threshold() + 1;
+  for (size_t i = 1; i <= frames; i++) {
+    auto tree = std::make_unique<MockLayerTree>(frame_size);
+    tree->root()->Add(background);
+    tree->root()->Add(clip);
+    DiffLayerTree(*tree, *old_tree);
+
+    raster_cache()->BeginFrame();
+    tree->root()->Preroll(preroll_context());
+    raster_cache()->EvictUnusedCacheEntries();
+    reset_display_list();
+    display_list_paint_context().root_layer = tree->root();
+    tree->root()->Paint(display_list_paint_context());
+
+    // The backdrop is filtered as usual until it has been unchanged for
+    // more frames than the access threshold of the raster cache.
+    EXPECT_EQ(raster_cache()->layer_metrics().hit_count, i == frames ? 1u : 0u)
+        << "frame " << i;
+    raster_cache()->EndFrame();
+    old_tree = std::move(tree);
+  }
+  display_list_paint_context().root_layer = nullptr;
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -13,6 +13,10 @@ const SkRect& ClipPathLayer::clip_shape_bounds() const {
   return clip_shape().getBounds();
 }
 
+bool ClipPathLayer::clip_shape_is_rect() const {
+  return !clip_shape().isInverseFillType() && clip_shape().isRect(nullptr);
+}
+
 void ClipPathLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipPath(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
@@ -14,8 +14,15 @@ class ClipPathLayer : public ClipShapeLayer<SkPath> {
   explicit ClipPathLayer(const SkPath& clip_path,
                          Clip clip_behavior = Clip::antiAlias);
 
+  const ClipPathLayer* as_clip_path_layer() const override { return this; }
+
+  bool IsEquivalentTo(const Layer* other) const override {
+    return HasSameClip(other->as_clip_path_layer());
+  }
+
  protected:
   const SkRect& clip_shape_bounds() const override;
+  bool clip_shape_is_rect() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
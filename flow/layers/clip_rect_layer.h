@@ -13,8 +13,15 @@ class ClipRectLayer : public ClipShapeLayer<SkRect> {
  public:
   ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior);
 
+  const ClipRectLayer* as_clip_rect_layer() const override { return this; }
+
+  bool IsEquivalentTo(const Layer* other) const override {
+    return HasSameClip(other->as_clip_rect_layer());
+  }
+
  protected:
   const SkRect& clip_shape_bounds() const override;
+  bool clip_shape_is_rect() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
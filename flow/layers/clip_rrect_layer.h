@@ -13,8 +13,15 @@ class ClipRRectLayer : public ClipShapeLayer<SkRRect> {
  public:
   ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior);
 
+  const ClipRRectLayer* as_clip_rrect_layer() const override { return this; }
+
+  bool IsEquivalentTo(const Layer* other) const override {
+    return HasSameClip(other->as_clip_rrect_layer());
+  }
+
  protected:
   const SkRect& clip_shape_bounds() const override;
+  bool clip_shape_is_rect() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
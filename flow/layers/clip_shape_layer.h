@@ -65,6 +65,14 @@ class ClipShapeLayer : public CacheableContainerLayer {
       set_paint_bounds(SkRect::MakeEmpty());
     }
 
+    // Only a rect clip keeps the part of the opaque bounds of the children
+    // that it contains a rect.
+    SkRect child_opaque_bounds = this->child_opaque_bounds();
+    if (clip_shape_is_rect() &&
+        child_opaque_bounds.intersect(clip_shape_bounds())) {
+      set_opaque_bounds(child_opaque_bounds);
+    }
+
     // If we use a SaveLayer then we can accept opacity on behalf
     // of our children and apply it in the saveLayer.
     if (uses_save_layer) {
@@ -103,14 +111,23 @@ class ClipShapeLayer : public CacheableContainerLayer {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  const ClipShape& clip_shape() const { return clip_shape_; }
+  Clip clip_behavior() const { return clip_behavior_; }
+
  protected:
   virtual const SkRect& clip_shape_bounds() const = 0;
+  virtual bool clip_shape_is_rect() const = 0;
+
+  // For |IsEquivalentTo| of the subclasses, which check the type of the
+  // other layer.
+  bool HasSameClip(const ClipShapeLayer<ClipShape>* other) const {
+    return other != nullptr && clip_behavior_ == other->clip_behavior_ &&
+           clip_shape_ == other->clip_shape_;
+  }
+
   virtual void ApplyClip(LayerStateStack::MutatorContext& mutator) const = 0;
   virtual ~ClipShapeLayer() = default;
 
-  const ClipShape& clip_shape() const { return clip_shape_; }
-  Clip clip_behavior() const { return clip_behavior_; }
-
  private:
   const ClipShape clip_shape_;
   Clip clip_behavior_;
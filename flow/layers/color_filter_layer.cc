@@ -37,6 +37,11 @@ void ColorFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 }
 
 void ColorFilterLayer::Preroll(PrerollContext* context) {
+  // The filter is applied during preroll as well, so that our children can
+  // tell whether they are able to fold it into their own rendering.
+  auto mutator = context->state_stack.save();
+  mutator.applyColorFilter(SkRect(), filter_);
+
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   AutoCache cache = AutoCache(layer_raster_cache_item_.get(), context,
@@ -57,6 +62,8 @@ void ColorFilterLayer::Preroll(PrerollContext* context) {
         filter_->can_commute_with_opacity()
             ? LayerStateStack::kCallerCanApplyOpacity
             : 0;
+    // The filter may make the opaque pixels of our children translucent.
+    set_opaque_bounds(SkRect::MakeEmpty());
   }
   // else - we can apply whatever our children can apply.
 }
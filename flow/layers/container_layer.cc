@@ -4,11 +4,14 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <cmath>
 #include <optional>
 
 namespace flutter {
 
-ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
+ContainerLayer::ContainerLayer()
+    : child_paint_bounds_(SkRect::MakeEmpty()),
+      child_opaque_bounds_(SkRect::MakeEmpty()) {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto old_container = static_cast<const ContainerLayer*>(old_layer);
@@ -89,8 +92,11 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
         // While we don't need to diff retained layers, we still need to
         // associate their paint region with current layer tree so that we can
-        // retrieve it in next frame diff
-        layer->PreservePaintRegion(context);
+        // retrieve it in next frame diff. In incremental mode the layer tree
+        // keeps the maps that already hold them instead.
+        if (!context->is_incremental()) {
+          layer->PreservePaintRegion(context);
+        }
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -107,10 +113,16 @@ void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
 }
 
+void ContainerLayer::ReplaceLayer(size_t index, std::shared_ptr<Layer> layer) {
+  FML_DCHECK(index < layers_.size());
+  layers_[index] = std::move(layer);
+}
+
 void ContainerLayer::Preroll(PrerollContext* context) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(child_opaque_bounds());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -126,6 +138,130 @@ static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   return rect1->intersects(rect2);
 }
 
+static SkScalar Area(const SkRect& rect) {
+  return rect.isEmpty() ? 0 : rect.width() * rect.height();
+}
+
+namespace {
+
+// What a child covers in device pixels, recorded during PrerollChildren to
+// find the children hidden by the siblings painted after them.
+struct ChildCoverage {
+  // The range of the raster cache entries added by the subtree of the child.
+  size_t first_cache_entry;
+  size_t end_cache_entry;
+  // The device pixels that the child may touch.
+  SkRect device_bounds;
+  // The device pixels that the child fills with opaque pixels.
+  SkRect device_opaque_bounds;
+  bool reads_backdrop;
+  bool has_platform_view;
+};
+
+}  // namespace
+
+// Raster cached layers are painted at integral translations, which may move
+// them by half of a pixel, so a pixel is added around the bounds of a child
+// and removed inside of its opaque bounds.
+static SkRect DeviceBounds(const SkRect& bounds, const SkMatrix& matrix) {
+  return SkRect::Make(matrix.mapRect(bounds).roundOut()).makeOutset(1, 1);
+}
+
+static SkRect DeviceOpaqueBounds(const SkRect& opaque_bounds,
+                                 const SkMatrix& matrix) {
+  if (opaque_bounds.isEmpty()) {
+    return SkRect::MakeEmpty();
+  }
+  const SkRect mapped = matrix.mapRect(opaque_bounds);
+  SkRect inner = SkRect::MakeLTRB(
+      std::ceil(mapped.fLeft) + 1, std::ceil(mapped.fTop) + 1,
+      std::floor(mapped.fRight) - 1, std::floor(mapped.fBottom) - 1);
+  return inner.isEmpty() ? SkRect::MakeEmpty() : inner;
+}
+
+// Marks the children whose device bounds are covered by the opaque bounds of
+// a sibling painted after them as occluded, and removes the raster cache
+// entries of their subtrees so that nothing is prepared for them.
+static void MarkOccludedChildren(
+    const std::vector<std::shared_ptr<Layer>>& layers,
+    const std::vector<ChildCoverage>& coverage,
+    std::vector<RasterCacheItem*>* raster_cached_entries) {
+  SkRect occluder = SkRect::MakeEmpty();
+  for (size_t i = layers.size(); i-- > 0;) {
+    const ChildCoverage& child = coverage[i];
+    if (child.has_platform_view) {
+      // The content around a platform view may be composited into separate
+      // surfaces by the embedder, and the view itself must be painted.
+      occluder.setEmpty();
+      continue;
+    }
+    if (occluder.contains(child.device_bounds)) {
+      layers[i]->set_occluded(true);
+      if (raster_cached_entries) {
+        // Only the entries of later siblings have been removed so far, so
+        // the range of this child is still valid.
+        raster_cached_entries->erase(
+            raster_cached_entries->begin() + child.first_cache_entry,
+            raster_cached_entries->begin() + child.end_cache_entry);
+      }
+      continue;
+    }
+    if (child.reads_backdrop) {
+      // The child may show the content painted before it.
+      occluder.setEmpty();
+      continue;
+    }
+    if (Area(child.device_opaque_bounds) > Area(occluder)) {
+      occluder = child.device_opaque_bounds;
+    }
+  }
+}
+
+void ContainerLayer::PrerollChild(Layer* layer, PrerollContext* context) {
+  if (!context->reuse_retained_prerolls || !layer->as_container_layer()) {
+    layer->Preroll(context);
+    return;
+  }
+  // Layers don't change once they are built, so the preroll of a subtree
+  // only depends on the state it runs in.
+  auto container = static_cast<ContainerLayer*>(layer);
+  const SkM44 transform = context->state_stack.transform_4x4();
+  const SkRect device_cull_rect = context->state_stack.device_cull_rect();
+  const bool surface_needs_readback = context->surface_needs_readback;
+  const auto& record = container->last_preroll_;
+  // Backdrop filters tell the view embedder about themselves while they are
+  // prerolled, so those must run again when there is one.
+  if (record.has_value() && record->transform == transform &&
+      record->device_cull_rect == device_cull_rect &&
+      record->surface_needs_readback == surface_needs_readback &&
+      !(record->reads_backdrop && context->view_embedder)) {
+    container->set_opaque_bounds(record->opaque_bounds);
+    context->surface_needs_readback = record->surface_needs_readback_after;
+    context->has_texture_layer = record->has_texture_layer;
+    context->reads_backdrop = record->reads_backdrop;
+    context->renderable_state_flags = record->renderable_state_flags;
+    return;
+  }
+
+  container->Preroll(context);
+
+  // Platform views are prerolled into the view embedder every frame.
+  if (context->has_platform_view) {
+    container->last_preroll_.reset();
+    return;
+  }
+  container->last_preroll_ = PrerollRecord{
+      .transform = transform,
+      .device_cull_rect = device_cull_rect,
+      .surface_needs_readback = surface_needs_readback,
+      .opaque_bounds = container->opaque_bounds(),
+      .surface_needs_readback_after = context->surface_needs_readback,
+      .has_texture_layer = context->has_texture_layer,
+      .reads_backdrop = context->reads_backdrop,
+      .renderable_state_flags = context->renderable_state_flags,
+  };
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      SkRect* child_paint_bounds) {
   // Platform views have no children, so context->has_platform_view should
@@ -135,7 +271,21 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
+  bool child_reads_backdrop = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  SkRect child_opaque_bounds = SkRect::MakeEmpty();
+  const bool parent_reads_backdrop = context->reads_backdrop;
+
+  // The children are prerolled under the same transform. Children can only
+  // hide each other while it keeps rects as rects.
+  const SkMatrix matrix = context->state_stack.transform_3x3();
+  const bool find_occluded_children =
+      layers_.size() > 1 && matrix.rectStaysRect();
+  std::vector<RasterCacheItem*>* cache_entries = context->raster_cached_entries;
+  std::vector<ChildCoverage> coverage;
+  if (find_occluded_children) {
+    coverage.reserve(layers_.size());
+  }
 
   for (auto& layer : layers_) {
     // Reset context->has_platform_view and context->has_texture_layer to false
@@ -143,12 +293,20 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // layer based on one being previously found in a sibling tree.
     context->has_platform_view = false;
     context->has_texture_layer = false;
+    context->reads_backdrop = false;
 
     // Initialize the renderable state flags to false to force the layer to
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    // The opaque bounds and occlusion of the layer are only known once it
+    // and its siblings have been prerolled.
+    layer->set_opaque_bounds(SkRect::MakeEmpty());
+    layer->set_occluded(false);
+
+    const size_t first_cache_entry = cache_entries ? cache_entries->size() : 0;
+
+    PrerollChild(layer.get(), context);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -159,18 +317,44 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     }
     child_paint_bounds->join(layer->paint_bounds());
 
+    if (context->reads_backdrop || context->has_platform_view) {
+      child_opaque_bounds.setEmpty();
+    }
+    if (Area(layer->opaque_bounds()) > Area(child_opaque_bounds)) {
+      child_opaque_bounds = layer->opaque_bounds();
+    }
+
+    if (find_occluded_children) {
+      coverage.push_back({
+          .first_cache_entry = first_cache_entry,
+          .end_cache_entry = cache_entries ? cache_entries->size() : 0,
+          .device_bounds = DeviceBounds(layer->paint_bounds(), matrix),
+          .device_opaque_bounds =
+              DeviceOpaqueBounds(layer->opaque_bounds(), matrix),
+          .reads_backdrop = context->reads_backdrop,
+          .has_platform_view = context->has_platform_view,
+      });
+    }
+
     child_has_platform_view =
         child_has_platform_view || context->has_platform_view;
     child_has_texture_layer =
         child_has_texture_layer || context->has_texture_layer;
+    child_reads_backdrop = child_reads_backdrop || context->reads_backdrop;
+  }
+
+  if (find_occluded_children) {
+    MarkOccludedChildren(layers_, coverage, cache_entries);
   }
 
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
+  context->reads_backdrop = parent_reads_backdrop || child_reads_backdrop;
   context->renderable_state_flags = all_renderable_state_flags;
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
+  child_opaque_bounds_ = child_opaque_bounds;
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -188,6 +372,12 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
+    if (layer.get() == context.paint_stop_layer) {
+      context.paint_stopped = true;
+    }
+    if (context.paint_stopped) {
+      return;
+    }
     if (layer->needs_painting(context)) {
       layer->Paint(context);
     }
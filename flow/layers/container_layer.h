@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
@@ -20,6 +21,9 @@ class ContainerLayer : public Layer {
 
   virtual void Add(std::shared_ptr<Layer> layer);
 
+  // Replaces the child at |index|, for use while the tree is being built.
+  void ReplaceLayer(size_t index, std::shared_ptr<Layer> layer);
+
   void Preroll(PrerollContext* context) override;
   void Paint(PaintContext& context) const override;
 
@@ -37,6 +41,10 @@ class ContainerLayer : public Layer {
     child_paint_bounds_ = bounds;
   }
 
+  // The largest of the opaque bounds of the children that no later child
+  // can read or erase, as determined during PrerollChildren().
+  const SkRect& child_opaque_bounds() const { return child_opaque_bounds_; }
+
   int children_renderable_state_flags() const {
     return children_renderable_state_flags_;
   }
@@ -48,9 +56,28 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  // The state that the last |Preroll| of this layer ran in and the results
+  // it reported to its parent, see |PrerollContext::reuse_retained_prerolls|.
+  struct PrerollRecord {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    bool surface_needs_readback;
+    SkRect opaque_bounds;
+    bool surface_needs_readback_after;
+    bool has_texture_layer;
+    bool reads_backdrop;
+    int renderable_state_flags;
+  };
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
+  SkRect child_opaque_bounds_;
   int children_renderable_state_flags_ = 0;
+  std::optional<PrerollRecord> last_preroll_;
+
+  // Prerolls |layer|, or restores the results of its last preroll if it is a
+  // container that was prerolled in the same state.
+  static void PrerollChild(Layer* layer, PrerollContext* context);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -4,8 +4,12 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -560,6 +564,141 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+static std::shared_ptr<DisplayListLayer> MakeOpaqueRectLayer(
+    const SkRect& rect) {
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, DlPaint(DlColor::kBlue()));
+  return std::make_shared<DisplayListLayer>(SkPoint::Make(0, 0),
+                                            builder.Build(), false, false);
+}
+
+TEST_F(ContainerLayerTest, ChildrenHiddenByLaterOpaqueChildAreNotPainted) {
+  DlPaint child_paint = DlPaint(DlColor::kGreen());
+  auto hidden_layer = std::make_shared<MockLayer>(
+      SkPath().addRect(10, 10, 20, 20), child_paint);
+  auto hidden_cacheable_layer = std::make_shared<MockCacheableLayer>(
+      SkPath().addRect(30, 30, 40, 40), child_paint);
+  auto visible_layer = std::make_shared<MockLayer>(
+      SkPath().addRect(90, 90, 110, 110), child_paint);
+  auto opaque_layer = MakeOpaqueRectLayer(SkRect::MakeLTRB(0, 0, 100, 100));
+
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(hidden_layer);
+  layer->Add(hidden_cacheable_layer);
+  layer->Add(visible_layer);
+  layer->Add(opaque_layer);
+
+  use_mock_raster_cache();
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(hidden_layer->is_occluded());
+  EXPECT_TRUE(hidden_cacheable_layer->is_occluded());
+  EXPECT_FALSE(visible_layer->is_occluded());
+  EXPECT_FALSE(opaque_layer->is_occluded());
+  EXPECT_FALSE(hidden_layer->needs_painting(paint_context()));
+  EXPECT_TRUE(visible_layer->needs_painting(paint_context()));
+  EXPECT_EQ(layer->opaque_bounds(), SkRect::MakeLTRB(0, 0, 100, 100));
+  // The cacheable layer is not prepared for the raster cache.
+  EXPECT_TRUE(preroll_context()->raster_cached_entries->empty());
+
+  // Nothing is hidden once the opaque layer is translucent or rotated.
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  opacity_layer->Add(MakeOpaqueRectLayer(SkRect::MakeLTRB(0, 0, 100, 100)));
+  auto transform_layer =
+      std::make_shared<TransformLayer>(SkMatrix::RotateDeg(30));
+  transform_layer->Add(
+      MakeOpaqueRectLayer(SkRect::MakeLTRB(-500, -500, 500, 500)));
+  for (auto& occluder : std::vector<std::shared_ptr<Layer>>{
+           opacity_layer, transform_layer}) {
+    auto container = std::make_shared<ContainerLayer>();
+    container->Add(hidden_layer);
+    container->Add(occluder);
+    container->Preroll(preroll_context());
+    EXPECT_FALSE(hidden_layer->is_occluded());
+    EXPECT_TRUE(container->opaque_bounds().isEmpty());
+  }
+}
+
+TEST_F(ContainerLayerTest, ChildrenReadByLaterChildrenAreNotHidden) {
+  DlPaint child_paint = DlPaint(DlColor::kGreen());
+  auto hidden_layer = std::make_shared<MockLayer>(
+      SkPath().addRect(10, 10, 20, 20), child_paint);
+  auto reading_layer = std::make_shared<MockLayer>(
+      SkPath().addRect(200, 200, 210, 210), child_paint);
+  reading_layer->set_fake_reads_surface(true);
+  auto platform_view_layer = std::make_shared<MockLayer>(
+      SkPath().addRect(200, 200, 210, 210), child_paint);
+  platform_view_layer->set_fake_has_platform_view(true);
+
+  for (auto& child : std::vector<std::shared_ptr<MockLayer>>{
+           reading_layer, platform_view_layer}) {
+    auto layer = std::make_shared<ContainerLayer>();
+    layer->Add(hidden_layer);
+    layer->Add(child);
+    layer->Add(MakeOpaqueRectLayer(SkRect::MakeLTRB(0, 0, 100, 100)));
+    layer->Preroll(preroll_context());
+    EXPECT_FALSE(hidden_layer->is_occluded());
+    preroll_context()->has_platform_view = false;
+  }
+
+  // Platform views are painted even when they are covered.
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(platform_view_layer);
+  layer->Add(MakeOpaqueRectLayer(SkRect::MakeLTRB(0, 0, 500, 500)));
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(platform_view_layer->is_occluded());
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeReusesPrerollInSameState) {
+  const SkPath child_path = SkPath().addRect(5, 6, 20, 21);
+  auto mock_layer = MockLayer::Make(child_path);
+  mock_layer->set_fake_has_texture_layer(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  preroll_context()->state_stack.set_preroll_delegate(
+      SkMatrix::Translate(1, 1));
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(1, 1));
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+
+  // A mock layer that is prerolled again reports its bounds again.
+  mock_layer->set_paint_bounds(SkRect::MakeEmpty());
+  preroll_context()->has_texture_layer = false;
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->paint_bounds(), SkRect::MakeEmpty());
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+
+  preroll_context()->has_texture_layer = false;
+  preroll_context()->state_stack.set_preroll_delegate(
+      SkMatrix::Translate(2, 2));
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(2, 2));
+  EXPECT_EQ(mock_layer->paint_bounds(), child_path.getBounds());
+}
+
+TEST_F(ContainerLayerTest, SubtreeWithPlatformViewIsAlwaysPrerolled) {
+  const SkPath child_path = SkPath().addRect(5, 6, 20, 21);
+  auto mock_layer = MockLayer::Make(child_path);
+  mock_layer->set_fake_has_platform_view(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+
+  preroll_context()->reuse_retained_prerolls = true;
+  root->Preroll(preroll_context());
+  preroll_context()->has_platform_view = false;
+
+  mock_layer->set_paint_bounds(SkRect::MakeEmpty());
+  root->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->paint_bounds(), child_path.getBounds());
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_folder.h"
+#include "flutter/display_list/utils/dl_comparable.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
@@ -37,6 +39,16 @@ bool DisplayListLayer::IsReplacing(DiffContext* context,
          Compare(context->statistics(), this, old_layer);
 }
 
+bool DisplayListLayer::IsEquivalentTo(const Layer* other) const {
+  auto other_layer = other->as_display_list_layer();
+  return other_layer != nullptr && offset_ == other_layer->offset_ &&
+         display_list_ == other_layer->display_list_ &&
+         display_list_raster_cache_item_->is_complex() ==
+             other_layer->display_list_raster_cache_item_->is_complex() &&
+         display_list_raster_cache_item_->will_change() ==
+             other_layer->display_list_raster_cache_item_->will_change();
+}
+
 void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
   if (!context->IsSubtreeDirty()) {
@@ -76,6 +88,13 @@ bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
     return false;
   }
 
+  // The content hash is computed when a list is built, so a match lets even
+  // lists too large to compare below be treated as unchanged.
+  if (dl1->content_hash() == dl2->content_hash()) {
+    statistics.AddDifferentInstanceButEqualPicture();
+    return true;
+  }
+
   if (op_bytes_1 > kMaxBytesToCompare) {
     statistics.AddPictureTooComplexToCompare();
     return false;
@@ -99,8 +118,29 @@ void DisplayListLayer::Preroll(PrerollContext* context) {
                               context->state_stack.transform_3x3());
   if (disp_list->can_apply_group_opacity()) {
     context->renderable_state_flags = LayerStateStack::kCallerCanApplyOpacity;
+    if (FoldColorFilter(context->state_stack.outstanding_color_filter())) {
+      context->renderable_state_flags |=
+          LayerStateStack::kCallerCanApplyColorFilter;
+    }
+  }
+  if (disp_list->may_read_backdrop()) {
+    context->reads_backdrop = true;
   }
   set_paint_bounds(bounds_);
+  set_opaque_bounds(
+      disp_list->opaque_bounds().makeOffset(offset_.x(), offset_.y()));
+}
+
+bool DisplayListLayer::FoldColorFilter(
+    const std::shared_ptr<const DlColorFilter>& filter) {
+  if (!filter) {
+    return false;
+  }
+  if (NotEquals(filter, folded_color_filter_)) {
+    folded_color_filter_ = filter;
+    folded_display_list_ = FoldColorFilterIntoOps(display_list_, filter);
+  }
+  return folded_display_list_ != nullptr;
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
@@ -126,11 +166,28 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   }
 
   SkScalar opacity = context.state_stack.outstanding_opacity();
+  context.state_stack.flush();
+
+  // An inherited color filter is drawn with the copy that has it folded
+  // into its ops, and only applied to a layer if it isn't the filter that
+  // was folded in |Preroll|.
+  sk_sp<DisplayList> display_list = display_list_;
+  DlAutoCanvasRestore filter_restore(context.canvas, false);
+  auto color_filter = context.state_stack.outstanding_color_filter();
+  if (color_filter) {
+    if (folded_display_list_ && Equals(color_filter, folded_color_filter_)) {
+      display_list = folded_display_list_;
+    } else {
+      DlPaint filter_paint;
+      filter_paint.setColorFilter(color_filter);
+      context.canvas->SaveLayer(&display_list_->bounds(), &filter_paint);
+    }
+  }
 
   if (context.enable_leaf_layer_tracing) {
     const auto canvas_size = context.canvas->GetBaseLayerSize();
-    auto offscreen_surface =
-        std::make_unique<OffscreenSurface>(context.gr_context, canvas_size);
+    auto offscreen_surface = std::make_unique<OffscreenSurface>(
+        context.gr_context, canvas_size, context.offscreen_surface_pool);
 
     const auto& ctm = context.canvas->GetTransform();
 
@@ -142,7 +199,7 @@ void DisplayListLayer::Paint(PaintContext& context) const {
         DlAutoCanvasRestore save(canvas, true);
         canvas->Clear(DlColor::kTransparent());
         canvas->SetTransform(ctm);
-        canvas->DrawDisplayList(display_list_, opacity);
+        canvas->DrawDisplayList(display_list, opacity);
       }
       canvas->Flush();
     }
@@ -157,7 +214,25 @@ void DisplayListLayer::Paint(PaintContext& context) const {
     context.layer_snapshot_store->Add(snapshot_data);
   }
 
-  context.canvas->DrawDisplayList(display_list_, opacity);
+  // Sampling times the layer as it is drawn into the frame, and the
+  // thumbnail is only rendered once the frame has been submitted.
+  const bool sample = !context.enable_leaf_layer_tracing &&
+                      context.layer_snapshot_store &&
+                      context.layer_snapshot_store->IsSampling(
+                          LayerSnapshotStore::kDisplayListLayers);
+  const auto start_time = sample ? fml::TimePoint::Now() : fml::TimePoint();
+  context.canvas->DrawDisplayList(display_list, opacity);
+  if (sample) {
+    const fml::TimeDelta duration = fml::TimePoint::Now() - start_time;
+    SkRect device_bounds =
+        context.state_stack.transform_3x3().mapRect(display_list_->bounds());
+    if (device_bounds.intersect(context.state_stack.device_cull_rect())) {
+      context.layer_snapshot_store->Sample(unique_id(), duration,
+                                           display_list_,
+                                           context.state_stack.transform_4x4(),
+                                           device_bounds);
+    }
+  }
 }
 
 }  // namespace flutter
@@ -25,10 +25,14 @@ class DisplayListLayer : public Layer {
 
   DisplayList* display_list() const { return display_list_.get(); }
 
+  const SkPoint& offset() const { return offset_; }
+
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool IsEquivalentTo(const Layer* other) const override;
+
   const DisplayListLayer* as_display_list_layer() const override {
     return this;
   }
@@ -42,7 +46,7 @@ class DisplayListLayer : public Layer {
   }
 
   RasterCacheKeyID caching_key_id() const override {
-    return RasterCacheKeyID(display_list()->unique_id(),
+    return RasterCacheKeyID(display_list()->content_hash(),
                             RasterCacheKeyType::kDisplayList);
   }
 
@@ -54,6 +58,15 @@ class DisplayListLayer : public Layer {
 
   sk_sp<DisplayList> display_list_;
 
+  // A copy of |display_list_| that draws each op with the color filter
+  // inherited in the last |Preroll|, if it could be folded into the ops.
+  std::shared_ptr<const DlColorFilter> folded_color_filter_;
+  sk_sp<DisplayList> folded_display_list_;
+
+  // Updates the folded copy for the inherited |filter| and returns true if
+  // the layer can apply the filter itself.
+  bool FoldColorFilter(const std::shared_ptr<const DlColorFilter>& filter);
+
   static bool Compare(DiffContext::Statistics& statistics,
                       const DisplayListLayer* l1,
                       const DisplayListLayer* l2);
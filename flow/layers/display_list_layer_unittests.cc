@@ -7,6 +7,9 @@
 #include "flutter/flow/layers/display_list_layer.h"
 
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_folder.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/fml/macros.h"
@@ -113,6 +116,36 @@ TEST_F(DisplayListLayerTest, CachingDoesNotChangeCullRect) {
             original_cull_rect);
 }
 
+TEST_F(DisplayListLayerTest, IsEquivalentToLayerOfSameDisplayList) {
+  const SkPoint layer_offset = SkPoint::Make(10, 10);
+  DisplayListBuilder builder;
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  auto display_list = builder.Build();
+  auto layer = std::make_shared<DisplayListLayer>(layer_offset, display_list,
+                                                  true, false);
+
+  EXPECT_TRUE(layer->IsEquivalentTo(
+      std::make_shared<DisplayListLayer>(layer_offset, display_list, true,
+                                         false)
+          .get()));
+  EXPECT_FALSE(layer->IsEquivalentTo(
+      std::make_shared<DisplayListLayer>(SkPoint::Make(0, 0), display_list,
+                                         true, false)
+          .get()));
+  EXPECT_FALSE(layer->IsEquivalentTo(
+      std::make_shared<DisplayListLayer>(layer_offset, display_list, true,
+                                         true)
+          .get()));
+  // Equal display lists may still be different instances that aren't
+  // compared.
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  EXPECT_FALSE(layer->IsEquivalentTo(
+      std::make_shared<DisplayListLayer>(layer_offset, builder.Build(), true,
+                                         false)
+          .get()));
+  EXPECT_FALSE(layer->IsEquivalentTo(std::make_shared<ContainerLayer>().get()));
+}
+
 TEST_F(DisplayListLayerTest, SimpleDisplayListOpacityInheritance) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -163,6 +196,41 @@ TEST_F(DisplayListLayerTest, SimpleDisplayListOpacityInheritance) {
       DisplayListsEQ_Verbose(this->display_list(), expected_builder.Build()));
 }
 
+TEST_F(DisplayListLayerTest, ColorFilterIsFoldedIntoCompatibleDisplayList) {
+  const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
+  const SkRect picture1_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkRect picture2_bounds = SkRect::MakeLTRB(25.0f, 6.0f, 40.5f, 21.5f);
+  DisplayListBuilder builder;
+  builder.DrawRect(picture1_bounds, DlPaint(DlColor::kYellow()));
+  builder.DrawOval(picture2_bounds, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+  auto display_list_layer = std::make_shared<DisplayListLayer>(
+      layer_offset, display_list, false, false);
+  auto dl_color_filter = DlLinearToSrgbGammaColorFilter::kInstance;
+  auto color_filter_layer = std::make_shared<ColorFilterLayer>(dl_color_filter);
+  color_filter_layer->Add(display_list_layer);
+
+  auto context = preroll_context();
+  color_filter_layer->Preroll(context);
+
+  DisplayListBuilder expected_builder;
+  /* ColorFilterLayer::Paint() */ {
+    /* display_list_layer::Paint() */ {
+      expected_builder.Save();
+      {
+        expected_builder.Translate(layer_offset.fX, layer_offset.fY);
+        expected_builder.DrawDisplayList(
+            FoldColorFilterIntoOps(display_list, dl_color_filter));
+      }
+      expected_builder.Restore();
+    }
+  }
+
+  color_filter_layer->Paint(display_list_paint_context());
+  EXPECT_TRUE(
+      DisplayListsEQ_Verbose(this->display_list(), expected_builder.Build()));
+}
+
 TEST_F(DisplayListLayerTest, IncompatibleDisplayListOpacityInheritance) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture1_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -18,11 +18,19 @@
 
 namespace flutter {
 
+static DisplayListComplexityCalculator* GetComplexityCalculator(
+    GrDirectContext* gr_context) {
+  return gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                          gr_context->backend())
+                    : DisplayListComplexityCalculator::GetForSoftware();
+}
+
 static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
-    DisplayListComplexityCalculator* complexity_calculator) {
+    DisplayListComplexityCalculator* complexity_calculator,
+    std::optional<unsigned int> complexity_score) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -42,8 +50,10 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
-  unsigned int complexity_score = complexity_calculator->Compute(display_list);
-  return complexity_calculator->ShouldBeCached(complexity_score);
+  if (!complexity_score.has_value()) {
+    complexity_score = complexity_calculator->Compute(display_list);
+  }
+  return complexity_calculator->ShouldBeCached(complexity_score.value());
 }
 
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
@@ -51,7 +61,7 @@ DisplayListRasterCacheItem::DisplayListRasterCacheItem(
     const SkPoint& offset,
     bool is_complex,
     bool will_change)
-    : RasterCacheItem(RasterCacheKeyID(display_list->unique_id(),
+    : RasterCacheItem(RasterCacheKeyID(display_list->content_hash(),
                                        RasterCacheKeyType::kDisplayList),
                       CacheState::kCurrent),
       display_list_(display_list),
@@ -72,12 +82,12 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
   DisplayListComplexityCalculator* complexity_calculator =
-      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
-                                context->gr_context->backend())
-                          : DisplayListComplexityCalculator::GetForSoftware();
+      GetComplexityCalculator(context->gr_context);
+  std::optional<unsigned int> complexity_score = complexity_score_;
+  complexity_score_.reset();
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     complexity_calculator, complexity_score)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -97,6 +107,17 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
   return;
 }
 
+bool DisplayListRasterCacheItem::NeedsComplexityScore() const {
+  return !will_change_ && !is_complex_ && display_list_ &&
+         RasterCacheUtil::CanRasterizeRect(display_list_->bounds());
+}
+
+void DisplayListRasterCacheItem::PrepareComplexityScore(
+    GrDirectContext* gr_context) const {
+  complexity_score_ =
+      GetComplexityCalculator(gr_context)->Compute(display_list_.get());
+}
+
 void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
                                                  const SkMatrix& matrix) {
   if (cache_state_ == CacheState::kNone || !context->raster_cache ||
@@ -123,6 +144,7 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
 
 bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
                                       const DlPaint* paint) const {
+  context.state_stack.flush();
   return Draw(context, context.canvas, paint);
 }
 
@@ -166,7 +188,7 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .flow_type          = flow_type,
       // clang-format on
   };
-  return context.raster_cache->UpdateCacheEntry(
+  return context.raster_cache->UpdateCacheEntryAsync(
       id.value(), r_context,
       [display_list = display_list_](DlCanvas* canvas) {
         canvas->DrawDisplayList(display_list);
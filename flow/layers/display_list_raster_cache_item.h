@@ -49,12 +49,26 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
 
   const DisplayList* display_list() const { return display_list_.get(); }
 
+  bool is_complex() const { return is_complex_; }
+
+  bool will_change() const { return will_change_; }
+
+  // Whether |PrerollSetup| needs the complexity score of the display list to
+  // decide whether it is worth caching.
+  bool NeedsComplexityScore() const;
+
+  // Computes the complexity score used by the next |PrerollSetup| ahead of
+  // time, with the calculator for |gr_context|. This may be called on any
+  // thread, but not while the item is being prerolled.
+  void PrepareComplexityScore(GrDirectContext* gr_context) const;
+
  private:
   SkMatrix transformation_matrix_;
   sk_sp<DisplayList> display_list_;
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  mutable std::optional<unsigned int> complexity_score_;
 };
 
 }  // namespace flutter
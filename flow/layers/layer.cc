@@ -10,9 +10,11 @@ namespace flutter {
 
 Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
+      opaque_bounds_(SkRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
-      subtree_has_platform_view_(false) {}
+      subtree_has_platform_view_(false),
+      occluded_(false) {}
 
 Layer::~Layer() = default;
 
@@ -35,6 +37,8 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
     preroll_context_->surface_needs_readback = false;
+    prev_reads_backdrop_ = preroll_context_->reads_backdrop;
+    preroll_context_->reads_backdrop = false;
   }
 }
 
@@ -50,6 +54,8 @@ Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
+    preroll_context_->reads_backdrop =
+        (prev_reads_backdrop_ || layer_itself_performs_readback_);
   }
 }
 
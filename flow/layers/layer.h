@@ -40,10 +40,17 @@ namespace testing {
 class MockLayer;
 }  // namespace testing
 
+class ClipPathLayer;
+class ClipRectLayer;
+class ClipRRectLayer;
 class ContainerLayer;
 class DisplayListLayer;
+class Layer;
+class OffscreenSurfacePool;
+class OpacityLayer;
 class PerformanceOverlayLayer;
 class TextureLayer;
+class TransformLayer;
 class RasterCacheItem;
 
 static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
@@ -71,6 +78,12 @@ struct PrerollContext {
   // presence of a texture layer during Preroll.
   bool has_texture_layer = false;
 
+  // Whether the layers prerolled since the last saveLayer may read the
+  // content painted before them, as a backdrop filter does, or make it
+  // translucent, rather than only paint over it. Such layers keep the
+  // layers painted before them from being hidden by later opaque layers.
+  bool reads_backdrop = false;
+
   // The list of flags that describe which rendering state attributes
   // (such as opacity, ColorFilter, ImageFilter) a given layer can
   // render itself without requiring the parent to perform a protective
@@ -82,6 +95,12 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // Whether container layers that are prerolled again in the state of their
+  // last preroll, such as the retained subtrees of a static UI, restore its
+  // results instead of prerolling their children. Only valid without a raster
+  // cache, whose entries need to be visited every frame.
+  bool reuse_retained_prerolls = false;
 };
 
 struct PaintContext {
@@ -117,8 +136,20 @@ struct PaintContext {
   // only when leaf layer tracing is enabled.
   LayerSnapshotStore* layer_snapshot_store = nullptr;
   bool enable_leaf_layer_tracing = false;
+  // Recycles the offscreen surfaces created while painting, if not null.
+  OffscreenSurfacePool* offscreen_surface_pool = nullptr;
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+  // The GPU time of recent frames, or null if the backend can't measure it.
+  const Stopwatch* gpu_time = nullptr;
+  // The root of the layer tree and the transform of the canvas it is painted
+  // on, which layers use to draw the content behind them again.
+  const Layer* root_layer = nullptr;
+  SkM44 root_transform;
+  // If not null, painting stops for the rest of the tree when this layer is
+  // reached, so that only the content behind it is drawn.
+  const Layer* paint_stop_layer = nullptr;
+  bool paint_stopped = false;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -156,6 +187,14 @@ class Layer {
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Whether this layer paints exactly like |other|, not counting any
+  // children, so that |other| can be used in its place. SceneBuilder uses
+  // this to keep the layers of the last frame that were built again without
+  // changes, which lets the diff and preroll skip them. Only properties set
+  // when the layer is built may be compared, as |other| may be in a tree
+  // that is being rasterized.
+  virtual bool IsEquivalentTo(const Layer* other) const { return false; }
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -191,6 +230,7 @@ class Layer {
     bool layer_itself_performs_readback_;
 
     bool prev_surface_needs_readback_;
+    bool prev_reads_backdrop_;
   };
 
   virtual void Paint(PaintContext& context) const = 0;
@@ -226,6 +266,21 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
+  // Returns a rect in the same coordinate system as the paint bounds that
+  // the layer is known to fill entirely with opaque pixels, or an empty
+  // rect. Layers that can tell set it during Preroll(), after their parent
+  // has reset it. Content painted under it by earlier siblings is hidden.
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+  void set_opaque_bounds(const SkRect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
+  // Whether the parent found during Preroll() that the layer is hidden
+  // entirely by the opaque bounds of the siblings painted after it, in
+  // which case the layer is not painted.
+  bool is_occluded() const { return occluded_; }
+  void set_occluded(bool occluded) { occluded_ = occluded; }
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -239,7 +294,7 @@ class Layer {
       // See https://github.com/flutter/flutter/issues/81419
       return true;
     }
-    return !context.state_stack.painting_is_nop() &&
+    return !occluded_ && !context.state_stack.painting_is_nop() &&
            !context.state_stack.content_culled(paint_bounds_);
   }
 
@@ -253,6 +308,11 @@ class Layer {
     return RasterCacheKeyID(unique_id_, RasterCacheKeyType::kLayer);
   }
   virtual const ContainerLayer* as_container_layer() const { return nullptr; }
+  virtual const TransformLayer* as_transform_layer() const { return nullptr; }
+  virtual const OpacityLayer* as_opacity_layer() const { return nullptr; }
+  virtual const ClipRectLayer* as_clip_rect_layer() const { return nullptr; }
+  virtual const ClipRRectLayer* as_clip_rrect_layer() const { return nullptr; }
+  virtual const ClipPathLayer* as_clip_path_layer() const { return nullptr; }
   virtual const DisplayListLayer* as_display_list_layer() const {
     return nullptr;
   }
@@ -262,13 +322,16 @@ class Layer {
   }
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
+ protected:
+  static uint64_t NextUniqueID();
+
  private:
   SkRect paint_bounds_;
+  SkRect opaque_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
-
-  static uint64_t NextUniqueID();
+  bool occluded_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Layer);
 };
@@ -169,6 +169,7 @@ bool LayerRasterCacheItem::TryToPrepareRasterCache(const PaintContext& context,
 
 bool LayerRasterCacheItem::Draw(const PaintContext& context,
                                 const DlPaint* paint) const {
+  context.state_stack.flush();
   return Draw(context, context.canvas, paint);
 }
 
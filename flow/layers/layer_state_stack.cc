@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -72,65 +74,165 @@ class DummyDelegate : public LayerStateStack::Delegate {
 const std::shared_ptr<DummyDelegate> DummyDelegate::kInstance =
     std::make_shared<DummyDelegate>();
 
+// The DlCanvasDelegate tracks the transform and clip itself and holds back
+// the save, transform and clip calls it receives until |flush| is called
+// before content is rendered. A save that is restored before anything is
+// rendered cancels out along with the calls recorded after it, so layers
+// which only modify the state of subtrees that render nothing never reach
+// the canvas. saveLayer calls are never held back as the layer content is
+// delimited by them.
 class DlCanvasDelegate : public LayerStateStack::Delegate {
  public:
-  explicit DlCanvasDelegate(DlCanvas* canvas)
-      : canvas_(canvas), initial_save_level_(canvas->GetSaveCount()) {}
+  DlCanvasDelegate(DlCanvas* canvas, fml::Arena* arena)
+      : canvas_(canvas),
+        initial_save_level_(canvas->GetSaveCount()),
+        tracker_(canvas->GetDestinationClipBounds(),
+                 canvas->GetTransformFullPerspective()),
+        pending_(fml::ArenaAllocator<PendingOp>(arena)) {}
 
-  void decommission() override { canvas_->RestoreToCount(initial_save_level_); }
+  void decommission() override {
+    pending_.clear();
+    canvas_->RestoreToCount(initial_save_level_);
+  }
 
   DlCanvas* canvas() const override { return canvas_; }
 
-  SkRect local_cull_rect() const override {
-    return canvas_->GetLocalClipBounds();
-  }
+  SkRect local_cull_rect() const override { return tracker_.local_cull_rect(); }
   SkRect device_cull_rect() const override {
-    return canvas_->GetDestinationClipBounds();
-  }
-  SkM44 matrix_4x4() const override {
-    return canvas_->GetTransformFullPerspective();
+    return tracker_.device_cull_rect();
   }
-  SkMatrix matrix_3x3() const override { return canvas_->GetTransform(); }
+  SkM44 matrix_4x4() const override { return tracker_.matrix_4x4(); }
+  SkMatrix matrix_3x3() const override { return tracker_.matrix_3x3(); }
   bool content_culled(const SkRect& content_bounds) const override {
-    return canvas_->QuickReject(content_bounds);
+    return tracker_.content_culled(content_bounds);
   }
 
-  void save() override { canvas_->Save(); }
+  void save() override {
+    tracker_.save();
+    pending_.emplace_back(PendingOp::kSave);
+  }
   void saveLayer(const SkRect& bounds,
                  LayerStateStack::RenderingAttributes& attributes,
                  DlBlendMode blend_mode,
                  const DlImageFilter* backdrop) override {
     TRACE_EVENT0("flutter", "Canvas::saveLayer");
+    flush();
+    tracker_.save();
     DlPaint paint;
     canvas_->SaveLayer(&bounds, attributes.fill(paint, blend_mode), backdrop);
   }
-  void restore() override { canvas_->Restore(); }
+  void restore() override {
+    tracker_.restore();
+    while (!pending_.empty()) {
+      bool is_save = pending_.back().type == PendingOp::kSave;
+      pending_.pop_back();
+      if (is_save) {
+        // The matching save never reached the canvas.
+        return;
+      }
+    }
+    canvas_->Restore();
+  }
 
   void translate(SkScalar tx, SkScalar ty) override {
-    canvas_->Translate(tx, ty);
+    tracker_.translate(tx, ty);
+    pending_.emplace_back(PendingOp::kTranslate).m44 =
+        SkM44::Translate(tx, ty);
+  }
+  void transform(const SkM44& m44) override {
+    tracker_.transform(m44);
+    pending_.emplace_back(PendingOp::kTransform4x4).m44 = m44;
   }
-  void transform(const SkM44& m44) override { canvas_->Transform(m44); }
   void transform(const SkMatrix& matrix) override {
-    canvas_->Transform(matrix);
+    tracker_.transform(matrix);
+    pending_.emplace_back(PendingOp::kTransform3x3).m44 = SkM44(matrix);
   }
   void integralTransform() override {
-    SkM44 matrix = RasterCacheUtil::GetIntegralTransCTM(matrix_4x4());
-    canvas_->SetTransform(matrix);
+    SkM44 matrix = RasterCacheUtil::GetIntegralTransCTM(tracker_.matrix_4x4());
+    tracker_.setTransform(matrix);
+    pending_.emplace_back(PendingOp::kSetTransform).m44 = matrix;
   }
 
   void clipRect(const SkRect& rect, ClipOp op, bool is_aa) override {
-    canvas_->ClipRect(rect, op, is_aa);
+    tracker_.clipRect(rect, op, is_aa);
+    pending_.emplace_back(PendingOp::kClipRect, op, is_aa).rect = rect;
   }
   void clipRRect(const SkRRect& rrect, ClipOp op, bool is_aa) override {
-    canvas_->ClipRRect(rrect, op, is_aa);
+    tracker_.clipRRect(rrect, op, is_aa);
+    pending_.emplace_back(PendingOp::kClipRRect, op, is_aa).rrect = rrect;
   }
   void clipPath(const SkPath& path, ClipOp op, bool is_aa) override {
-    canvas_->ClipPath(path, op, is_aa);
+    tracker_.clipPath(path, op, is_aa);
+    pending_.emplace_back(PendingOp::kClipPath, op, is_aa).path = path;
+  }
+
+  void flush() override {
+    for (const PendingOp& op : pending_) {
+      switch (op.type) {
+        case PendingOp::kSave:
+          canvas_->Save();
+          break;
+        case PendingOp::kTranslate:
+          canvas_->Translate(op.m44.rc(0, 3), op.m44.rc(1, 3));
+          break;
+        case PendingOp::kTransform3x3:
+          canvas_->Transform(op.m44.asM33());
+          break;
+        case PendingOp::kTransform4x4:
+          canvas_->Transform(op.m44);
+          break;
+        case PendingOp::kSetTransform:
+          canvas_->SetTransform(op.m44);
+          break;
+        case PendingOp::kClipRect:
+          canvas_->ClipRect(op.rect, op.clip_op, op.is_aa);
+          break;
+        case PendingOp::kClipRRect:
+          canvas_->ClipRRect(op.rrect, op.clip_op, op.is_aa);
+          break;
+        case PendingOp::kClipPath:
+          canvas_->ClipPath(op.path, op.clip_op, op.is_aa);
+          break;
+      }
+    }
+    pending_.clear();
   }
 
  private:
+  // A call that has been applied to |tracker_| but not yet to the canvas.
+  // Only the fields used by its type hold a value. Translations and 3x3
+  // matrices are widened to |m44| and narrowed back when they are flushed
+  // so that the canvas sees the same calls it would have without deferral.
+  struct PendingOp {
+    enum Type {
+      kSave,
+      kTranslate,
+      kTransform3x3,
+      kTransform4x4,
+      kSetTransform,
+      kClipRect,
+      kClipRRect,
+      kClipPath,
+    };
+
+    explicit PendingOp(Type type,
+                       ClipOp clip_op = ClipOp::kIntersect,
+                       bool is_aa = false)
+        : type(type), clip_op(clip_op), is_aa(is_aa) {}
+
+    Type type;
+    ClipOp clip_op;
+    bool is_aa;
+    SkM44 m44;
+    SkRect rect;
+    SkRRect rrect;
+    SkPath path;
+  };
+
   DlCanvas* canvas_;
   const int initial_save_level_;
+  DisplayListMatrixClipTracker tracker_;
+  fml::ArenaVector<PendingOp> pending_;
 };
 
 class PrerollDelegate : public LayerStateStack::Delegate {
@@ -224,12 +326,14 @@ class SaveLayerEntry : public LayerStateStack::StateEntry {
     if (stack->checkerboard_func_) {
       DlCanvas* canvas = stack->canvas_delegate();
       if (canvas != nullptr) {
+        stack->flush();
         (*stack->checkerboard_func_)(canvas, bounds_);
       }
     }
     stack->delegate_->restore();
     stack->outstanding_ = old_attributes_;
   }
+  bool is_save_layer() const override { return true; }
 
  protected:
   const SkRect bounds_;
@@ -614,7 +718,11 @@ void MutatorContext::clipPath(const SkPath& path, bool is_aa) {
 // LayerStateStack methods
 // ==============================================================
 
-LayerStateStack::LayerStateStack() : delegate_(DummyDelegate::kInstance) {}
+LayerStateStack::LayerStateStack(fml::Arena* arena)
+    : arena_(arena),
+      state_stack_(
+          fml::ArenaAllocator<fml::ArenaUniquePtr<StateEntry>>(arena)),
+      delegate_(DummyDelegate::kInstance) {}
 
 void LayerStateStack::clear_delegate() {
   delegate_->decommission();
@@ -629,7 +737,7 @@ void LayerStateStack::set_delegate(DlCanvas* canvas) {
     clear_delegate();
   }
   if (canvas) {
-    delegate_ = std::make_shared<DlCanvasDelegate>(canvas);
+    delegate_ = std::make_shared<DlCanvasDelegate>(canvas, arena_);
     reapply_all();
   }
 }
@@ -676,8 +784,8 @@ void LayerStateStack::restore_to_count(size_t restore_count) {
 
 void LayerStateStack::push_opacity(const SkRect& bounds, SkScalar opacity) {
   maybe_save_layer(opacity);
-  state_stack_.emplace_back(
-      std::make_unique<OpacityEntry>(bounds, opacity, outstanding_));
+  state_stack_.emplace_back(fml::MakeArenaUnique<OpacityEntry>(
+      arena_, bounds, opacity, outstanding_));
   apply_last_entry();
 }
 
@@ -685,8 +793,8 @@ void LayerStateStack::push_color_filter(
     const SkRect& bounds,
     const std::shared_ptr<const DlColorFilter>& filter) {
   maybe_save_layer(filter);
-  state_stack_.emplace_back(
-      std::make_unique<ColorFilterEntry>(bounds, filter, outstanding_));
+  state_stack_.emplace_back(fml::MakeArenaUnique<ColorFilterEntry>(
+      arena_, bounds, filter, outstanding_));
   apply_last_entry();
 }
 
@@ -694,8 +802,8 @@ void LayerStateStack::push_image_filter(
     const SkRect& bounds,
     const std::shared_ptr<const DlImageFilter>& filter) {
   maybe_save_layer(filter);
-  state_stack_.emplace_back(
-      std::make_unique<ImageFilterEntry>(bounds, filter, outstanding_));
+  state_stack_.emplace_back(fml::MakeArenaUnique<ImageFilterEntry>(
+      arena_, bounds, filter, outstanding_));
   apply_last_entry();
 }
 
@@ -703,46 +811,58 @@ void LayerStateStack::push_backdrop(
     const SkRect& bounds,
     const std::shared_ptr<const DlImageFilter>& filter,
     DlBlendMode blend_mode) {
-  state_stack_.emplace_back(std::make_unique<BackdropFilterEntry>(
-      bounds, filter, blend_mode, outstanding_));
+  state_stack_.emplace_back(fml::MakeArenaUnique<BackdropFilterEntry>(
+      arena_, bounds, filter, blend_mode, outstanding_));
   apply_last_entry();
 }
 
 void LayerStateStack::push_translate(SkScalar tx, SkScalar ty) {
-  state_stack_.emplace_back(std::make_unique<TranslateEntry>(tx, ty));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<TranslateEntry>(arena_, tx, ty));
   apply_last_entry();
 }
 
 void LayerStateStack::push_transform(const SkM44& m44) {
-  state_stack_.emplace_back(std::make_unique<TransformM44Entry>(m44));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<TransformM44Entry>(arena_, m44));
   apply_last_entry();
 }
 
 void LayerStateStack::push_transform(const SkMatrix& matrix) {
-  state_stack_.emplace_back(std::make_unique<TransformMatrixEntry>(matrix));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<TransformMatrixEntry>(arena_, matrix));
   apply_last_entry();
 }
 
 void LayerStateStack::push_integral_transform() {
-  state_stack_.emplace_back(std::make_unique<IntegralTransformEntry>());
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<IntegralTransformEntry>(arena_));
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_rect(const SkRect& rect, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipRectEntry>(rect, is_aa));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<ClipRectEntry>(arena_, rect, is_aa));
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_rrect(const SkRRect& rrect, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipRRectEntry>(rrect, is_aa));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<ClipRRectEntry>(arena_, rrect, is_aa));
   apply_last_entry();
 }
 
 void LayerStateStack::push_clip_path(const SkPath& path, bool is_aa) {
-  state_stack_.emplace_back(std::make_unique<ClipPathEntry>(path, is_aa));
+  state_stack_.emplace_back(
+      fml::MakeArenaUnique<ClipPathEntry>(arena_, path, is_aa));
   apply_last_entry();
 }
 
+bool LayerStateStack::has_save_layer() const {
+  return std::any_of(state_stack_.begin(), state_stack_.end(),
+                     [](const auto& entry) { return entry->is_save_layer(); });
+}
+
 bool LayerStateStack::needs_save_layer(int flags) const {
   if (outstanding_.opacity < SK_Scalar1 &&
       (flags & LayerStateStack::kCallerCanApplyOpacity) == 0) {
@@ -760,13 +880,13 @@ bool LayerStateStack::needs_save_layer(int flags) const {
 }
 
 void LayerStateStack::do_save() {
-  state_stack_.emplace_back(std::make_unique<SaveEntry>());
+  state_stack_.emplace_back(fml::MakeArenaUnique<SaveEntry>(arena_));
   apply_last_entry();
 }
 
 void LayerStateStack::save_layer(const SkRect& bounds) {
-  state_stack_.emplace_back(std::make_unique<SaveLayerEntry>(
-      bounds, DlBlendMode::kSrcOver, outstanding_));
+  state_stack_.emplace_back(fml::MakeArenaUnique<SaveLayerEntry>(
+      arena_, bounds, DlBlendMode::kSrcOver, outstanding_));
   apply_last_entry();
 }
 
@@ -8,6 +8,7 @@
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/arena.h"
 
 namespace flutter {
 
@@ -44,6 +45,11 @@ namespace flutter {
 /// delegates and when is the best time to convey that state (i.e. lazy
 /// saveLayer calls for example).
 ///
+/// A DlCanvas delegate holds back the save, transform and clip calls that
+/// it receives until content is about to be rendered, so that the state of
+/// subtrees which end up rendering nothing never reaches the canvas. Code
+/// that renders directly to the canvas must call |flush| first.
+///
 /// The rendering state attributes will be automatically applied to the
 /// nested content using a |saveLayer| call at the point at which we
 /// encounter rendered content (i.e. various nested layers that exist only
@@ -104,7 +110,9 @@ namespace flutter {
 /// }
 class LayerStateStack {
  public:
-  LayerStateStack();
+  // If |arena| is not null, the entries of the stack are allocated from it
+  // and the arena must outlive the stack.
+  explicit LayerStateStack(fml::Arena* arena = nullptr);
 
   // Clears out any old delegate to make room for a new one.
   void clear_delegate();
@@ -320,10 +328,19 @@ class LayerStateStack {
   // when the MutatorContext object goes out of scope.
   [[nodiscard]] inline MutatorContext save() { return MutatorContext(this); }
 
+  // Applies any save, transform and clip calls that the delegate has held
+  // back to its canvas. This must be called before rendering content
+  // directly to the canvas.
+  void flush() { delegate_->flush(); }
+
   // Returns true if the state stack is in, or has returned to,
   // its initial state.
   bool is_empty() const { return state_stack_.empty(); }
 
+  // Returns true if a saveLayer is in effect, so that what is drawn now is
+  // composited onto the canvas only when that layer is restored.
+  bool has_save_layer() const;
+
  private:
   size_t stack_count() const { return state_stack_.size(); }
   void restore_to_count(size_t restore_count);
@@ -406,6 +423,7 @@ class LayerStateStack {
     virtual void reapply(LayerStateStack* stack) const { apply(stack); }
     virtual void restore(LayerStateStack* stack) const {}
     virtual void update_mutators(MutatorsStack* mutators_stack) const {}
+    virtual bool is_save_layer() const { return false; }
 
    protected:
     StateEntry() = default;
@@ -466,12 +484,16 @@ class LayerStateStack {
     virtual void clipRect(const SkRect& rect, ClipOp op, bool is_aa) = 0;
     virtual void clipRRect(const SkRRect& rrect, ClipOp op, bool is_aa) = 0;
     virtual void clipPath(const SkPath& path, ClipOp op, bool is_aa) = 0;
+
+    // Applies any state that the delegate has held back to its canvas.
+    virtual void flush() {}
   };
   friend class DummyDelegate;
   friend class DlCanvasDelegate;
   friend class PrerollDelegate;
 
-  std::vector<std::unique_ptr<StateEntry>> state_stack_;
+  fml::Arena* arena_;
+  fml::ArenaVector<fml::ArenaUniquePtr<StateEntry>> state_stack_;
   friend class MutatorContext;
 
   std::shared_ptr<Delegate> delegate_;
@@ -58,6 +58,33 @@ TEST(LayerStateStack, Defaults) {
   ASSERT_EQ(dl_paint, DlPaint());
 }
 
+TEST(LayerStateStack, HasSaveLayer) {
+  DisplayListBuilder builder;
+  LayerStateStack state_stack;
+  state_stack.set_delegate(&builder);
+  ASSERT_FALSE(state_stack.has_save_layer());
+  {
+    auto mutator = state_stack.save();
+    mutator.clipRect(SkRect::MakeWH(10, 10), false);
+    // Opacity is only recorded until a saveLayer is needed.
+    mutator.applyOpacity(SkRect::MakeWH(10, 10), 0.5);
+    ASSERT_FALSE(state_stack.has_save_layer());
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.saveLayer(SkRect::MakeWH(10, 10));
+      ASSERT_TRUE(state_stack.has_save_layer());
+    }
+    ASSERT_FALSE(state_stack.has_save_layer());
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.applyBackdropFilter(SkRect::MakeWH(10, 10), nullptr,
+                                   DlBlendMode::kSrcOver);
+      ASSERT_TRUE(state_stack.has_save_layer());
+    }
+  }
+  ASSERT_FALSE(state_stack.has_save_layer());
+}
+
 TEST(LayerStateStack, SingularDelegate) {
   LayerStateStack state_stack;
   ASSERT_EQ(state_stack.canvas_delegate(), nullptr);
@@ -105,11 +132,13 @@ TEST(LayerStateStack, OldDelegateIsRolledBack) {
 
   auto mutator = state_stack.save();
   mutator.translate({10, 10});
+  state_stack.flush();
 
   ASSERT_EQ(builder.GetTransform(), SkMatrix::Translate(10, 10));
   ASSERT_TRUE(canvas.GetTransform().isIdentity());
 
   state_stack.set_delegate(&canvas);
+  state_stack.flush();
 
   ASSERT_TRUE(builder.GetTransform().isIdentity());
   ASSERT_EQ(canvas.GetTransform(), SkMatrix::Translate(10, 10));
@@ -132,6 +161,52 @@ TEST(LayerStateStack, OldDelegateIsRolledBack) {
   ASSERT_TRUE(canvas.GetTransform().isIdentity());
 }
 
+TEST(LayerStateStack, TransformAndClipAreDeferredUntilFlushed) {
+  SkRect clip = SkRect::MakeLTRB(10, 10, 20, 20);
+
+  LayerStateStack state_stack;
+  DisplayListBuilder builder;
+  state_stack.set_delegate(&builder);
+  {
+    auto mutator = state_stack.save();
+    mutator.translate(5, 5);
+    mutator.clipRect(clip, false);
+
+    // The state is tracked even though the builder has not seen it.
+    ASSERT_EQ(state_stack.transform_3x3(), SkMatrix::Translate(5, 5));
+    ASSERT_EQ(state_stack.device_cull_rect(), clip.makeOffset(5, 5));
+    ASSERT_TRUE(builder.GetTransform().isIdentity());
+    ASSERT_EQ(builder.GetSaveCount(), 1);
+  }
+  {
+    auto mutator = state_stack.save();
+    mutator.translate(5, 5);
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.clipRect(clip, false);
+      state_stack.flush();
+      builder.DrawRect(clip, DlPaint());
+    }
+    {
+      // A nested subtree that renders nothing does not reach the builder
+      // even though its parent state was flushed.
+      auto mutator2 = state_stack.save();
+      mutator2.translate(1, 1);
+    }
+  }
+  state_stack.clear_delegate();
+
+  DisplayListBuilder expected;
+  expected.Save();
+  expected.Translate(5, 5);
+  expected.Save();
+  expected.ClipRect(clip, DlCanvas::ClipOp::kIntersect, false);
+  expected.DrawRect(clip, DlPaint());
+  expected.Restore();
+  expected.Restore();
+  ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
+}
+
 TEST(LayerStateStack, Opacity) {
   SkRect rect = {10, 10, 20, 20};
 
@@ -549,5 +624,23 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, EntriesAreAllocatedFromArena) {
+  fml::Arena arena;
+  {
+    LayerStateStack state_stack(&arena);
+    state_stack.set_preroll_delegate(kGiantRect, SkMatrix::I());
+    {
+      auto mutator = state_stack.save();
+      mutator.translate(10, 10);
+      mutator.clipRect(SkRect::MakeLTRB(0, 0, 20, 20), false);
+      ASSERT_EQ(state_stack.device_cull_rect(),
+                SkRect::MakeLTRB(10, 10, 30, 30));
+    }
+    ASSERT_EQ(state_stack.device_cull_rect(), kGiantRect);
+  }
+  // The entries and the stack storage both live in the arena.
+  ASSERT_GE(arena.GetStats().allocation_count, 2u);
+}
+
 }  // namespace testing
 }  // namespace flutter
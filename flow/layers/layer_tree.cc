@@ -4,14 +4,21 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layer_snapshot_store.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_item.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 
@@ -29,6 +36,61 @@ inline SkColorSpace* GetColorSpace(DlCanvas* canvas) {
   return canvas ? canvas->GetImageInfo().colorSpace() : nullptr;
 }
 
+// The fewest display list items worth sharing with the worker pool.
+static constexpr size_t kMinConcurrentPrerollItems = 4;
+
+static void CollectComplexityScoreItems(
+    const Layer* layer,
+    std::vector<const DisplayListRasterCacheItem*>& items) {
+  if (const ContainerLayer* container = layer->as_container_layer()) {
+    for (const auto& child : container->layers()) {
+      CollectComplexityScoreItems(child.get(), items);
+    }
+  } else if (const DisplayListLayer* display_list_layer =
+                 layer->as_display_list_layer()) {
+    const DisplayListRasterCacheItem* item =
+        display_list_layer->raster_cache_item();
+    if (item && item->NeedsComplexityScore()) {
+      items.push_back(item);
+    }
+  }
+}
+
+// Computes the complexity scores of the display list items of |root_layer|
+// on the raster thread and |task_runner| together. Scoring walks every op
+// of every display list and dominates the preroll of wide trees, while the
+// rest of the preroll updates state shared by the whole tree and stays
+// serial, so the results are the same as those of a serial preroll.
+static void PrepareComplexityScoresConcurrently(
+    const Layer* root_layer,
+    GrDirectContext* gr_context,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  std::vector<const DisplayListRasterCacheItem*> items;
+  CollectComplexityScoreItems(root_layer, items);
+  if (items.size() < kMinConcurrentPrerollItems) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "LayerTree::PrepareComplexityScoresConcurrently");
+
+  std::atomic<size_t> next_item = 0;
+  auto score_items = [&items, &next_item, gr_context]() {
+    for (size_t i = next_item++; i < items.size(); i = next_item++) {
+      items[i]->PrepareComplexityScore(gr_context);
+    }
+  };
+  size_t worker_count = std::min<size_t>(
+      items.size() - 1, std::max(std::thread::hardware_concurrency(), 1u));
+  fml::CountDownLatch latch(worker_count);
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner->PostTask([&score_items, &latch]() {
+      score_items();
+      latch.CountDown();
+    });
+  }
+  score_items();
+  latch.Wait();
+}
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
@@ -42,13 +104,18 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
   frame.context().raster_cache().SetCheckboardCacheImages(
       checkerboard_raster_cache_images_);
-  LayerStateStack state_stack;
+  LayerStateStack state_stack(&frame.context().frame_arena());
   state_stack.set_preroll_delegate(cull_rect,
                                    frame.root_surface_transformation());
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
   raster_cache_items_.clear();
 
+  if (cache && frame.context().preroll_task_runner()) {
+    PrepareComplexityScoresConcurrently(root_layer_.get(), frame.gr_context(),
+                                        frame.context().preroll_task_runner());
+  }
+
   PrerollContext context = {
       // clang-format off
       .raster_cache                  = cache,
@@ -61,6 +128,8 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time                       = frame.context().ui_time(),
       .texture_registry              = frame.context().texture_registry(),
       .raster_cached_entries         = &raster_cache_items_,
+      .reuse_retained_prerolls       =
+          !cache && frame.context().reuse_retained_prerolls(),
       // clang-format on
   };
 
@@ -106,7 +175,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
-  LayerStateStack state_stack;
+  LayerStateStack state_stack(&frame.context().frame_arena());
 
   // DrawCheckerboard is not supported on Impeller.
   if (checkerboard_offscreen_layers_ && !frame.aiks_context()) {
@@ -121,11 +190,20 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   if (enable_leaf_layer_tracing_) {
     frame.context().snapshot_store().Clear();
     snapshot_store = &frame.context().snapshot_store();
+  } else if (frame.context().snapshot_store().IsSampling() &&
+             !frame.aiks_context()) {
+    // Sampled thumbnails are rendered with Skia, which can't draw the
+    // images of Impeller frames.
+    snapshot_store = &frame.context().snapshot_store();
   }
 
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
+  SkM44 root_transform =
+      canvas ? canvas->GetTransformFullPerspective() : SkM44();
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
+  OffscreenSurfacePool* surface_pool =
+      &frame.context().offscreen_surface_pool();
   PaintContext context = {
       // clang-format off
       .state_stack                   = state_stack,
@@ -139,8 +217,14 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .raster_cache                  = cache,
       .layer_snapshot_store          = snapshot_store,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
+      .offscreen_surface_pool        = surface_pool,
       .impeller_enabled              = !!frame.aiks_context(),
       .aiks_context                  = frame.aiks_context(),
+      .gpu_time                      = frame.context().has_gpu_time()
+                                           ? &frame.context().gpu_time()
+                                           : nullptr,
+      .root_layer                    = root_layer_.get(),
+      .root_transform                = root_transform,
       // clang-format on
   };
 
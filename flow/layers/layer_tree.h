@@ -57,8 +57,21 @@ class LayerTree {
   Layer* root_layer() const { return root_layer_.get(); }
   const SkISize& frame_size() const { return frame_size_; }
 
-  const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
-  PaintRegionMap& paint_region_map() { return paint_region_map_; }
+  const PaintRegionMap& paint_region_map() const { return *paint_region_map_; }
+  PaintRegionMap& paint_region_map() { return *paint_region_map_; }
+
+  std::shared_ptr<const PaintRegionMap> shared_paint_region_map() const {
+    return paint_region_map_;
+  }
+
+  // The maps of earlier frames that hold the paint regions of the retained
+  // subtrees that were not diffed incrementally, see |FrameDamage|.
+  const RetainedPaintRegionMaps& retained_paint_region_maps() const {
+    return retained_paint_region_maps_;
+  }
+  void set_retained_paint_region_maps(RetainedPaintRegionMaps maps) {
+    retained_paint_region_maps_ = std::move(maps);
+  }
 
   // The number of frame intervals missed after which the compositor must
   // trace the rasterized picture to a trace file. 0 stands for disabling all
@@ -87,7 +100,9 @@ class LayerTree {
   bool checkerboard_offscreen_layers_;
   bool enable_leaf_layer_tracing_ = false;
 
-  PaintRegionMap paint_region_map_;
+  std::shared_ptr<PaintRegionMap> paint_region_map_ =
+      std::make_shared<PaintRegionMap>();
+  RetainedPaintRegionMaps retained_paint_region_maps_;
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_state_stack.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/arena.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kTreeSize = 1000;
+constexpr int kBranchCount = 8;
+
+// Builds a tree with |kBranchCount| branches of alternating transform and
+// clip layers that are |depth| layers deep, each ending in a display list.
+std::shared_ptr<ContainerLayer> CreateDeepTree(int depth) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(50, 50), DlPaint());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  auto root = std::make_shared<ContainerLayer>();
+  for (int branch = 0; branch < kBranchCount; branch++) {
+    std::shared_ptr<ContainerLayer> parent = root;
+    for (int level = 0; level < depth; level++) {
+      std::shared_ptr<ContainerLayer> layer;
+      if (level % 2 == 0) {
+        layer = std::make_shared<TransformLayer>(
+            SkMatrix::Translate(branch % 2 ? 1 : 0, branch % 2 ? 0 : 1));
+      } else {
+        layer = std::make_shared<ClipRectLayer>(
+            SkRect::MakeWH(kTreeSize, kTreeSize), Clip::hardEdge);
+      }
+      parent->Add(layer);
+      parent = layer;
+    }
+    parent->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(branch * 60, 0), display_list, false, false));
+  }
+  return root;
+}
+
+void WalkUnpaintedSubtrees(LayerStateStack& state_stack,
+                           DlCanvas& canvas,
+                           const SkRect& clip,
+                           int depth) {
+  if (depth == 0) {
+    state_stack.flush();
+    canvas.DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+    return;
+  }
+  {
+    auto sibling = state_stack.save();
+    sibling.translate(1, 1);
+    sibling.clipRect(clip, false);
+  }
+  auto mutator = state_stack.save();
+  mutator.translate(1, 0);
+  mutator.clipRect(clip, false);
+  WalkUnpaintedSubtrees(state_stack, canvas, clip, depth - 1);
+}
+
+}  // namespace
+
+// Prerolls and paints deep layer trees in which every branch renders.
+static void BM_FlattenDeepLayerTree(benchmark::State& state) {
+  LayerTree tree({.root_layer = CreateDeepTree(state.range(0))},
+                 SkISize::Make(kTreeSize, kTreeSize));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        tree.Flatten(SkRect::MakeWH(kTreeSize, kTreeSize)));
+  }
+}
+BENCHMARK(BM_FlattenDeepLayerTree)->RangeMultiplier(4)->Range(4, 256);
+
+// Walks a deep stack of transforms and clips into a canvas where only the
+// innermost scope renders and every level also has a sibling subtree that
+// modifies the state but renders nothing.
+static void BM_LayerStateStackUnpaintedSubtrees(benchmark::State& state) {
+  const SkRect clip = SkRect::MakeWH(kTreeSize, kTreeSize);
+  fml::Arena arena;
+  for (auto _ : state) {
+    DisplayListBuilder builder(clip);
+    {
+      LayerStateStack state_stack(&arena);
+      state_stack.set_delegate(&builder);
+      WalkUnpaintedSubtrees(state_stack, builder, clip, state.range(0));
+    }
+    benchmark::DoNotOptimize(builder.Build());
+    arena.Reset();
+  }
+}
+BENCHMARK(BM_LayerStateStackUnpaintedSubtrees)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+
+}  // namespace flutter
@@ -5,10 +5,13 @@
 #include <stddef.h>
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
 #include "flutter/testing/mock_canvas.h"
@@ -30,6 +33,7 @@ class LayerTreeTest : public CanvasTest {
                                                        nullptr)) {}
 
   CompositorContext::ScopedFrame& frame() { return *scoped_frame_.get(); }
+  CompositorContext& compositor_context() { return compositor_context_; }
   const SkMatrix& root_transform() { return root_transform_; }
 
   std::unique_ptr<LayerTree> BuildLayerTree(const LayerTree::Config& config) {
@@ -278,5 +282,41 @@ TEST_F(LayerTreeTest, PaintContextInitialization) {
   expect_defaults(context);
 }
 
+TEST_F(LayerTreeTest, ConcurrentPrerollMatchesSerialPreroll) {
+  auto build_layer_tree = [this]() {
+    auto root = std::make_shared<ContainerLayer>();
+    for (int i = 0; i < 8; i++) {
+      DisplayListBuilder builder;
+      // The naive complexity calculator caches lists with more than 5 ops,
+      // so only every other layer is worth caching.
+      int op_count = i % 2 == 0 ? 2 : 10;
+      for (int j = 0; j < op_count; j++) {
+        builder.DrawRect(SkRect::MakeXYWH(i, j, 5, 5), DlPaint());
+      }
+      root->Add(std::make_shared<DisplayListLayer>(
+          SkPoint::Make(0, 0), builder.Build(), false, false));
+    }
+    return BuildLayerTree(LayerTree::Config{
+        .root_layer = root,
+    });
+  };
+
+  RasterCache& raster_cache = compositor_context().raster_cache();
+  raster_cache.BeginFrame();
+  build_layer_tree()->Preroll(frame());
+  size_t serial_entries = raster_cache.GetPictureCachedEntriesCount();
+  raster_cache.Clear();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  compositor_context().SetPrerollTaskRunner(loop->GetTaskRunner());
+  raster_cache.BeginFrame();
+  build_layer_tree()->Preroll(frame());
+  size_t concurrent_entries = raster_cache.GetPictureCachedEntriesCount();
+  compositor_context().SetPrerollTaskRunner(nullptr);
+
+  EXPECT_EQ(serial_entries, 4u);
+  EXPECT_EQ(concurrent_entries, serial_entries);
+}
+
 }  // namespace testing
 }  // namespace flutter
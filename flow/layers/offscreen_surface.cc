@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/offscreen_surface.h"
 
+#include <algorithm>
+
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -15,10 +17,14 @@
 
 namespace flutter {
 
-static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
-                                              const SkISize& size) {
-  const auto image_info = SkImageInfo::MakeN32Premul(
-      size.width(), size.height(), SkColorSpace::MakeSRGB());
+static SkImageInfo SnapshotImageInfo(const SkISize& size) {
+  return SkImageInfo::MakeN32Premul(size.width(), size.height(),
+                                    SkColorSpace::MakeSRGB());
+}
+
+static sk_sp<SkSurface> CreateSnapshotSurface(
+    GrDirectContext* surface_context,
+    const SkImageInfo& image_info) {
   if (surface_context) {
     // There is a rendering surface that may contain textures that are going to
     // be referenced in the layer tree about to be drawn.
@@ -66,14 +72,67 @@ static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
   return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
 }
 
+sk_sp<SkSurface> OffscreenSurfacePool::Acquire(
+    GrDirectContext* surface_context,
+    const SkImageInfo& image_info) {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->surface_context == surface_context &&
+        it->surface->imageInfo() == image_info) {
+      sk_sp<SkSurface> surface = std::move(it->surface);
+      entries_.erase(std::next(it).base());
+      return surface;
+    }
+  }
+  return nullptr;
+}
+
+void OffscreenSurfacePool::Recycle(GrDirectContext* surface_context,
+                                   sk_sp<SkSurface> surface) {
+  if (!surface || max_count_ == 0) {
+    return;
+  }
+  if (entries_.size() >= max_count_) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back({
+      .surface_context = surface_context,
+      .surface = std::move(surface),
+      .recycled_frame = frame_count_,
+  });
+}
+
+void OffscreenSurfacePool::EndFrame() {
+  frame_count_++;
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [this](const Entry& entry) {
+                                  return frame_count_ - entry.recycled_frame >
+                                         max_age_;
+                                }),
+                 entries_.end());
+}
+
 OffscreenSurface::OffscreenSurface(GrDirectContext* surface_context,
-                                   const SkISize& size) {
-  offscreen_surface_ = CreateSnapshotSurface(surface_context, size);
+                                   const SkISize& size,
+                                   OffscreenSurfacePool* pool)
+    : surface_context_(surface_context), pool_(pool) {
+  const SkImageInfo image_info = SnapshotImageInfo(size);
+  if (pool_) {
+    offscreen_surface_ = pool_->Acquire(surface_context, image_info);
+  }
+  if (!offscreen_surface_) {
+    offscreen_surface_ = CreateSnapshotSurface(surface_context, image_info);
+  }
   if (offscreen_surface_) {
     adapter_.set_canvas(offscreen_surface_->getCanvas());
   }
 }
 
+OffscreenSurface::~OffscreenSurface() {
+  if (pool_) {
+    pool_->Recycle(surface_context_, std::move(offscreen_surface_));
+  }
+}
+
 sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed) const {
   return flutter::GetRasterData(offscreen_surface_, compressed);
 }
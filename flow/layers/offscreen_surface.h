@@ -5,12 +5,15 @@
 #ifndef FLUTTER_FLOW_LAYERS_OFFSCREEN_SURFACE_H_
 #define FLUTTER_FLOW_LAYERS_OFFSCREEN_SURFACE_H_
 
+#include <vector>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -19,12 +22,57 @@ class GrDirectContext;
 
 namespace flutter {
 
+// Keeps the surfaces of destroyed |OffscreenSurface|s so that later ones of
+// the same size, format and color space can reuse them instead of allocating
+// new GPU memory. Surfaces that have not been reused for |max_age| frames are
+// released. The pool must only be used on the raster thread.
+class OffscreenSurfacePool {
+ public:
+  explicit OffscreenSurfacePool(size_t max_age = 3, size_t max_count = 8)
+      : max_age_(max_age), max_count_(max_count) {}
+
+  // Returns a surface for |image_info| that was created for |surface_context|,
+  // or nullptr if there is none. The contents of the surface are undefined,
+  // as they are for a new surface.
+  sk_sp<SkSurface> Acquire(GrDirectContext* surface_context,
+                           const SkImageInfo& image_info);
+
+  // Returns |surface|, created for |surface_context|, to the pool.
+  void Recycle(GrDirectContext* surface_context, sk_sp<SkSurface> surface);
+
+  // Releases the surfaces that have not been reused in the last |max_age|
+  // calls.
+  void EndFrame();
+
+  void Clear() { entries_.clear(); }
+
+  size_t pooled_count() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    GrDirectContext* surface_context;
+    sk_sp<SkSurface> surface;
+    size_t recycled_frame;
+  };
+
+  const size_t max_age_;
+  const size_t max_count_;
+  size_t frame_count_ = 0;
+  // Ordered from least to most recently recycled.
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(OffscreenSurfacePool);
+};
+
 class OffscreenSurface {
  public:
+  // If |pool| is not null the surface is taken from it if possible, and is
+  // returned to it when this object is destroyed.
   explicit OffscreenSurface(GrDirectContext* surface_context,
-                            const SkISize& size);
+                            const SkISize& size,
+                            OffscreenSurfacePool* pool = nullptr);
 
-  ~OffscreenSurface() = default;
+  ~OffscreenSurface();
 
   sk_sp<SkData> GetRasterData(bool compressed) const;
 
@@ -33,6 +81,8 @@ class OffscreenSurface {
   bool IsValid() const;
 
  private:
+  GrDirectContext* surface_context_;
+  OffscreenSurfacePool* pool_;
   sk_sp<SkSurface> offscreen_surface_;
   DlSkCanvasAdapter adapter_;
 
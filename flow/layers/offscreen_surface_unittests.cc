@@ -9,7 +9,9 @@
 #include "gtest/gtest.h"
 #include "include/core/SkColor.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter::testing {
 
@@ -41,4 +43,71 @@ TEST(OffscreenSurfaceTest, PaintSurfaceBlack) {
   ASSERT_EQ(actual[0], 0xFF000000u);
 }
 
+TEST(OffscreenSurfaceTest, PooledSurfaceIsReused) {
+  OffscreenSurfacePool pool;
+  {
+    OffscreenSurface surface(nullptr, SkISize::Make(4, 4), &pool);
+    ASSERT_TRUE(surface.IsValid());
+    EXPECT_EQ(pool.pooled_count(), 0u);
+  }
+  EXPECT_EQ(pool.pooled_count(), 1u);
+
+  // A surface of another size cannot reuse the pooled one.
+  {
+    OffscreenSurface surface(nullptr, SkISize::Make(8, 8), &pool);
+    ASSERT_TRUE(surface.IsValid());
+    EXPECT_EQ(pool.pooled_count(), 1u);
+  }
+  EXPECT_EQ(pool.pooled_count(), 2u);
+
+  {
+    OffscreenSurface surface(nullptr, SkISize::Make(4, 4), &pool);
+    ASSERT_TRUE(surface.IsValid());
+    EXPECT_EQ(pool.pooled_count(), 1u);
+  }
+  EXPECT_EQ(pool.pooled_count(), 2u);
+}
+
+TEST(OffscreenSurfaceTest, PoolMatchesSizeFormatAndColorSpace) {
+  OffscreenSurfacePool pool;
+  const SkImageInfo info =
+      SkImageInfo::MakeN32Premul(4, 4, SkColorSpace::MakeSRGB());
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(info);
+  SkSurface* pooled_surface = surface.get();
+  pool.Recycle(nullptr, std::move(surface));
+
+  EXPECT_EQ(pool.Acquire(nullptr, info.makeWH(5, 4)), nullptr);
+  EXPECT_EQ(pool.Acquire(nullptr, info.makeColorType(kAlpha_8_SkColorType)),
+            nullptr);
+  EXPECT_EQ(pool.Acquire(nullptr, info.makeColorSpace(
+                                      SkColorSpace::MakeSRGBLinear())),
+            nullptr);
+  EXPECT_EQ(pool.Acquire(nullptr, info).get(), pooled_surface);
+  EXPECT_EQ(pool.pooled_count(), 0u);
+}
+
+TEST(OffscreenSurfaceTest, PooledSurfacesAreTrimmedByAge) {
+  OffscreenSurfacePool pool(/*max_age=*/2);
+  {
+    OffscreenSurface surface(nullptr, SkISize::Make(4, 4), &pool);
+  }
+  EXPECT_EQ(pool.pooled_count(), 1u);
+
+  pool.EndFrame();
+  pool.EndFrame();
+  EXPECT_EQ(pool.pooled_count(), 1u);
+  pool.EndFrame();
+  EXPECT_EQ(pool.pooled_count(), 0u);
+}
+
+TEST(OffscreenSurfaceTest, PoolIsLimitedToMaxCount) {
+  OffscreenSurfacePool pool(/*max_age=*/3, /*max_count=*/2);
+  {
+    OffscreenSurface surface_1(nullptr, SkISize::Make(1, 1), &pool);
+    OffscreenSurface surface_2(nullptr, SkISize::Make(2, 2), &pool);
+    OffscreenSurface surface_3(nullptr, SkISize::Make(3, 3), &pool);
+  }
+  EXPECT_EQ(pool.pooled_count(), 2u);
+}
+
 }  // namespace flutter::testing
@@ -18,6 +18,12 @@ OpacityLayer::OpacityLayer(SkAlpha alpha, const SkPoint& offset)
       offset_(offset),
       children_can_accept_opacity_(false) {}
 
+bool OpacityLayer::IsEquivalentTo(const Layer* other) const {
+  auto other_layer = other->as_opacity_layer();
+  return other_layer != nullptr && alpha_ == other_layer->alpha_ &&
+         offset_ == other_layer->offset_;
+}
+
 void OpacityLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
   auto* prev = static_cast<const OpacityLayer*>(old_layer);
@@ -58,6 +64,9 @@ void OpacityLayer::Preroll(PrerollContext* context) {
   context->renderable_state_flags |= LayerStateStack::kCallerCanApplyOpacity;
 
   set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+  set_opaque_bounds(alpha_ == SK_AlphaOPAQUE
+                        ? opaque_bounds().makeOffset(offset_.fX, offset_.fY)
+                        : SkRect::MakeEmpty());
 
   if (children_can_accept_opacity()) {
     // For opacity layer, we can use raster_cache children only when the
@@ -31,6 +31,8 @@ class OpacityLayer : public CacheableContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool IsEquivalentTo(const Layer* other) const override;
+
   void Preroll(PrerollContext* context) override;
 
   void Paint(PaintContext& context) const override;
@@ -47,6 +49,12 @@ class OpacityLayer : public CacheableContainerLayer {
 
   SkScalar opacity() const { return alpha_ * 1.0f / SK_AlphaOPAQUE; }
 
+  SkAlpha alpha() const { return alpha_; }
+
+  const SkPoint& offset() const { return offset_; }
+
+  const OpacityLayer* as_opacity_layer() const override { return this; }
+
  private:
   SkAlpha alpha_;
   SkPoint offset_;
@@ -116,11 +116,14 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
     return;
   }
 
+  const bool show_gpu =
+      options_ & (kDisplayGpuStatistics | kVisualizeGpuStatistics);
   SkScalar x = paint_bounds().x() + padding;
   SkScalar y = paint_bounds().y() + padding;
   SkScalar width = paint_bounds().width() - (padding * 2);
-  SkScalar height = paint_bounds().height() / 2;
+  SkScalar height = paint_bounds().height() / (show_gpu ? 3 : 2);
   auto mutator = context.state_stack.save();
+  context.state_stack.flush();
 
   VisualizeStopWatch(
       context.canvas, context.impeller_enabled, context.raster_time, x, y,
@@ -131,6 +134,15 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
                      x, y + height, width, height - padding,
                      options_ & kVisualizeEngineStatistics,
                      options_ & kDisplayEngineStatistics, "UI", font_path_);
+
+  // The row stays empty until the backend reports the GPU time of a frame,
+  // which it never does if it can't measure it.
+  if (show_gpu && context.gpu_time) {
+    VisualizeStopWatch(context.canvas, context.impeller_enabled,
+                       *context.gpu_time, x, y + height * 2, width,
+                       height - padding, options_ & kVisualizeGpuStatistics,
+                       options_ & kDisplayGpuStatistics, "GPU", font_path_);
+  }
 }
 
 }  // namespace flutter
@@ -19,6 +19,8 @@ const int kDisplayRasterizerStatistics = 1 << 0;
 const int kVisualizeRasterizerStatistics = 1 << 1;
 const int kDisplayEngineStatistics = 1 << 2;
 const int kVisualizeEngineStatistics = 1 << 3;
+const int kDisplayGpuStatistics = 1 << 4;
+const int kVisualizeGpuStatistics = 1 << 5;
 
 class PerformanceOverlayLayer : public Layer {
  public:
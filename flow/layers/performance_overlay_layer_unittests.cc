@@ -196,6 +196,39 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, GpuStatisticsRequireAGpuTime) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 96.0f);
+  const uint64_t overlay_opts = kDisplayGpuStatistics;
+  auto layer = std::make_shared<PerformanceOverlayLayer>(overlay_opts);
+  layer->set_paint_bounds(layer_bounds);
+  layer->Preroll(preroll_context());
+
+  // Nothing is drawn until the backend has measured the GPU time.
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+
+  FixedRefreshRateStopwatch gpu_time;
+  gpu_time.SetLapTime(fml::TimeDelta::FromMilliseconds(4));
+  paint_context().gpu_time = &gpu_time;
+  layer->Paint(paint_context());
+  paint_context().gpu_time = nullptr;
+
+  auto overlay_text =
+      PerformanceOverlayLayer::MakeStatisticsText(gpu_time, "GPU", "");
+  auto overlay_text_data = overlay_text->serialize(SkSerialProcs{});
+  DlPaint text_paint(DlColor(0xFF888888));
+  // The GPU statistics are drawn in the last of three rows.
+  SkPoint text_position = SkPoint::Make(16.0f, 86.0f);
+
+#if defined(OS_FUCHSIA)
+  GTEST_SKIP() << "Expectation requires a valid default font manager";
+#endif  // OS_FUCHSIA
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawTextData{overlay_text_data, text_paint,
+                                            text_position}}}));
+}
+
 TEST_F(PerformanceOverlayLayerTest, MarkAsDirtyWhenResized) {
   // Regression test for https://github.com/flutter/flutter/issues/54188
 
@@ -17,8 +17,6 @@ namespace testing {
 
 using PlatformViewLayerTest = LayerTest;
 
-using ClipOp = DlCanvas::ClipOp;
-
 TEST_F(PlatformViewLayerTest, NullViewEmbedderDoesntPrerollCompositeOrPaint) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   const SkSize layer_size = SkSize::Make(8.0f, 8.0f);
@@ -71,19 +69,8 @@ TEST_F(PlatformViewLayerTest, ClippedPlatformViewPrerollsAndPaintsNothing) {
 
   parent_clip_layer->Paint(paint_context());
   EXPECT_EQ(paint_context().canvas, &mock_canvas());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{parent_clip, ClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{1, MockCanvas::SaveData{2}},
-           MockCanvas::DrawCall{
-               2, MockCanvas::ClipRectData{child_clip, ClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  // The clips are never flushed as nothing is rendered inside them.
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
 }
 
 TEST_F(PlatformViewLayerTest, OpacityInheritance) {
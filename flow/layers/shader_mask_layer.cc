@@ -41,6 +41,8 @@ void ShaderMaskLayer::Preroll(PrerollContext* context) {
                               context->state_stack.transform_3x3());
 
   ContainerLayer::Preroll(context);
+  // The mask may make the opaque pixels of our children translucent.
+  set_opaque_bounds(SkRect::MakeEmpty());
   // We always paint with a saveLayer (or a cached rendering),
   // so we can always apply opacity in any of those cases.
   context->renderable_state_flags = kSaveLayerRenderFlags;
@@ -71,6 +73,7 @@ void ShaderMaskLayer::Paint(PaintContext& context) const {
   if (color_source_) {
     dl_paint.setColorSource(color_source_.get());
   }
+  context.state_stack.flush();
   context.canvas->Translate(mask_rect_.left(), mask_rect_.top());
   context.canvas->DrawRect(shader_rect, dl_paint);
 }
@@ -24,9 +24,9 @@ void TextureLayer::Diff(DiffContext* context, const Layer* old_layer) {
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(old_layer);
     auto prev = old_layer->as_texture_layer();
-    // TODO(knopp) It would be nice to be able to determine that a texture is
-    // dirty
-    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    if (!PaintsSameFrame(context, prev)) {
+      context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    }
   }
 
   // Make sure DiffContext knows there is a TextureLayer in this subtree.
@@ -40,6 +40,22 @@ void TextureLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool TextureLayer::PaintsSameFrame(DiffContext* context,
+                                   const TextureLayer* prev) const {
+  if (offset_ != prev->offset_ || size_ != prev->size_ ||
+      texture_id_ != prev->texture_id_ || freeze_ != prev->freeze_ ||
+      sampling_ != prev->sampling_) {
+    return false;
+  }
+  TextureRegistry* registry = context->texture_registry();
+  std::shared_ptr<Texture> texture =
+      registry ? registry->GetTexture(texture_id_) : nullptr;
+  // Frame generations are never 0, so layers that didn't paint their texture
+  // are always dirty.
+  return texture &&
+         texture->frame_generation() == prev->painted_frame_generation_;
+}
+
 void TextureLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
@@ -58,6 +74,7 @@ void TextureLayer::Paint(PaintContext& context) const {
     TRACE_EVENT_INSTANT0("flutter", "null texture");
     return;
   }
+  context.state_stack.flush();
   DlPaint paint;
   Texture::PaintContext ctx{
       .canvas = context.canvas,
@@ -66,6 +83,7 @@ void TextureLayer::Paint(PaintContext& context) const {
       .paint = context.state_stack.fill(paint),
   };
   texture->Paint(ctx, paint_bounds(), freeze_, sampling_);
+  painted_frame_generation_ = texture->frame_generation();
 }
 
 }  // namespace flutter
@@ -31,11 +31,18 @@ class TextureLayer : public Layer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // Whether the layer paints the same frame at the same place as |prev| did
+  // in the last frame it was painted in.
+  bool PaintsSameFrame(DiffContext* context, const TextureLayer* prev) const;
+
   SkPoint offset_;
   SkSize size_;
   int64_t texture_id_;
   bool freeze_;
   DlImageSampling sampling_;
+  // The frame generation of the texture when the layer was last painted, or
+  // 0 if it hasn't painted the texture yet.
+  mutable uint64_t painted_frame_generation_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TextureLayer);
 };
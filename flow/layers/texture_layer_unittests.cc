@@ -117,6 +117,40 @@ TEST_F(TextureLayerDiffTest, TextureInRetainedLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
 }
 
+TEST_F(TextureLayerDiffTest, TextureWithoutNewFrameIsNotDamaged) {
+  const int64_t texture_id = 0;
+  texture_registry()->RegisterTexture(
+      std::make_shared<MockTexture>(texture_id));
+  auto make_layer = [&] {
+    return std::make_shared<TextureLayer>(SkPoint::Make(0, 0),
+                                          SkSize::Make(100, 100), texture_id,
+                                          false, DlImageSampling::kLinear);
+  };
+
+  MockLayerTree tree1;
+  auto layer1 = make_layer();
+  tree1.root()->Add(layer1);
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+  layer1->Preroll(preroll_context());
+  layer1->Paint(display_list_paint_context());
+
+  MockLayerTree tree2;
+  auto layer2 = make_layer();
+  tree2.root()->Add(layer2);
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+  layer2->Preroll(preroll_context());
+  layer2->Paint(display_list_paint_context());
+
+  texture_registry()->MarkTextureFrameAvailable(texture_id);
+
+  MockLayerTree tree3;
+  tree3.root()->Add(make_layer());
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+}
+
 TEST_F(TextureLayerTest, OpacityInheritance) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   const SkSize layer_size = SkSize::Make(8.0f, 8.0f);
@@ -25,6 +25,11 @@ TransformLayer::TransformLayer(const SkM44& transform) : transform_(transform) {
   }
 }
 
+bool TransformLayer::IsEquivalentTo(const Layer* other) const {
+  auto other_layer = other->as_transform_layer();
+  return other_layer != nullptr && transform_ == other_layer->transform_;
+}
+
 void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
   auto* prev = static_cast<const TransformLayer*>(old_layer);
@@ -61,8 +66,13 @@ void TransformLayer::Preroll(PrerollContext* context) {
   // is otherwise optimal for non-perspective matrices. If SkM44 ever exposes
   // a mapRect operation, or if SkMatrix ever optimizes its handling of
   // the perspective elements, this issue will become moot.
-  transform_.asM33().mapRect(&child_paint_bounds);
+  const SkMatrix transform = transform_.asM33();
+  transform.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+
+  if (transform.rectStaysRect()) {
+    set_opaque_bounds(transform.mapRect(child_opaque_bounds()));
+  }
 }
 
 void TransformLayer::Paint(PaintContext& context) const {
@@ -19,10 +19,16 @@ class TransformLayer : public ContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool IsEquivalentTo(const Layer* other) const override;
+
   void Preroll(PrerollContext* context) override;
 
   void Paint(PaintContext& context) const override;
 
+  const SkM44& transform() const { return transform_; }
+
+  const TransformLayer* as_transform_layer() const override { return this; }
+
  private:
   SkM44 transform_;
 
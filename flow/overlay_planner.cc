@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/overlay_planner.h"
+
+namespace flutter {
+
+void OverlayPlanner::AddPlatformView(const SkRect& view_rect,
+                                     const EmbedderViewSlice* slice) {
+  view_rects_.push_back(view_rect);
+  if (slice == nullptr) {
+    slice_overlay_rects_.push_back(SkRect::MakeEmpty());
+    return;
+  }
+
+  // Only the content that covers this platform view or one before it needs
+  // an overlay. The R-Tree of the slice tells which drawn rects do.
+  SkRect overlay_rect = SkRect::MakeEmpty();
+  for (const SkRect& platform_view_rect : view_rects_) {
+    for (SkRect rect :
+         slice->searchNonOverlappingDrawnRects(platform_view_rect)) {
+      if (rect.intersect(platform_view_rect)) {
+        overlay_rect.join(rect);
+      }
+    }
+  }
+  // Subpixels in the platform may not align with the canvas subpixels, so
+  // the rect is rounded out to whole pixels.
+  slice_overlay_rects_.push_back(SkRect::Make(overlay_rect.roundOut()));
+}
+
+std::vector<OverlayPlanner::Overlay> OverlayPlanner::Plan() const {
+  std::vector<Overlay> overlays;
+  Overlay pending = {0, SkRect::MakeEmpty(), {}};
+  for (size_t i = 0; i < view_rects_.size(); i++) {
+    // The pending slices can't be shown above this platform view if any of
+    // them would cover it, so their overlay goes right below it.
+    for (size_t slice : pending.slices) {
+      if (slice_overlay_rects_[slice].intersects(view_rects_[i])) {
+        pending.view_index = i - 1;
+        overlays.push_back(std::move(pending));
+        pending = {0, SkRect::MakeEmpty(), {}};
+        break;
+      }
+    }
+    if (!slice_overlay_rects_[i].isEmpty()) {
+      pending.rect.join(slice_overlay_rects_[i]);
+      pending.slices.push_back(i);
+    }
+  }
+  if (!pending.slices.empty()) {
+    pending.view_index = view_rects_.size() - 1;
+    overlays.push_back(std::move(pending));
+  }
+  return overlays;
+}
+
+}  // namespace flutter
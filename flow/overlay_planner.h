@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_OVERLAY_PLANNER_H_
+#define FLUTTER_FLOW_OVERLAY_PLANNER_H_
+
+#include <vector>
+
+#include "flutter/flow/embedded_views.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decides which overlay surfaces a frame with platform views
+///             needs to show the Flutter content painted above them.
+///
+///             The content painted after a platform view, its slice, only
+///             needs an overlay where it covers that platform view or one
+///             composited before it; the rest is drawn into the background.
+///             The overlay doesn't have to be shown right above the platform
+///             view either, only above it and below the next platform view
+///             that it overlaps. So the content of consecutive slices shares
+///             one overlay for as long as none of it overlaps the platform
+///             views in between, rather than taking one surface each.
+///
+class OverlayPlanner {
+ public:
+  struct Overlay {
+    /// The index of the platform view, in composition order, that the
+    /// overlay is shown right above.
+    size_t view_index;
+    /// The bounds of the overlay, in whole pixels.
+    SkRect rect;
+    /// The indices of the slices drawn into the overlay, in order. Each is
+    /// clipped to its |GetSliceOverlayRect|.
+    std::vector<size_t> slices;
+  };
+
+  OverlayPlanner() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the next platform view in composition order and the
+  ///             slice of Flutter content painted right after it, whose
+  ///             recording must have ended, or null if the slice isn't
+  ///             drawn.
+  ///
+  void AddPlatformView(const SkRect& view_rect, const EmbedderViewSlice* slice);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The part of the slice of the platform view at |index| that
+  ///             has to be drawn on an overlay, in whole pixels, or an empty
+  ///             rect if all of it can be drawn into the background.
+  ///
+  const SkRect& GetSliceOverlayRect(size_t index) const {
+    return slice_overlay_rects_[index];
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the overlays that show the slices of the platform
+  ///             views added so far, ordered by |Overlay::view_index|.
+  ///
+  std::vector<Overlay> Plan() const;
+
+ private:
+  std::vector<SkRect> view_rects_;
+  std::vector<SkRect> slice_overlay_rects_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(OverlayPlanner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_OVERLAY_PLANNER_H_
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/overlay_planner.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::unique_ptr<DisplayListEmbedderViewSlice> MakeSlice(
+    std::initializer_list<SkRect> rects) {
+  auto slice =
+      std::make_unique<DisplayListEmbedderViewSlice>(SkRect::MakeWH(500, 500));
+  for (const SkRect& rect : rects) {
+    slice->canvas()->DrawRect(rect, DlPaint());
+  }
+  slice->end_recording();
+  return slice;
+}
+
+}  // namespace
+
+TEST(OverlayPlannerTest, ContentBesidePlatformViewsNeedsNoOverlay) {
+  OverlayPlanner planner;
+  auto slice = MakeSlice({SkRect::MakeLTRB(200, 200, 220, 220)});
+  planner.AddPlatformView(SkRect::MakeLTRB(0, 0, 100, 100), slice.get());
+  planner.AddPlatformView(SkRect::MakeLTRB(300, 300, 400, 400), nullptr);
+
+  EXPECT_TRUE(planner.GetSliceOverlayRect(0).isEmpty());
+  EXPECT_TRUE(planner.GetSliceOverlayRect(1).isEmpty());
+  EXPECT_TRUE(planner.Plan().empty());
+}
+
+TEST(OverlayPlannerTest, OverlayRectsOnlyCoverPlatformViews) {
+  OverlayPlanner planner;
+  planner.AddPlatformView(SkRect::MakeLTRB(100, 100, 200, 200), nullptr);
+  auto slice = MakeSlice({SkRect::MakeLTRB(150.5, 50, 350, 250)});
+  planner.AddPlatformView(SkRect::MakeLTRB(300, 100, 400, 200), slice.get());
+
+  // The content over both platform views, rounded out to whole pixels.
+  EXPECT_EQ(planner.GetSliceOverlayRect(1),
+            SkRect::MakeLTRB(150, 100, 350, 200));
+  auto overlays = planner.Plan();
+  ASSERT_EQ(overlays.size(), 1u);
+  EXPECT_EQ(overlays[0].view_index, 1u);
+  EXPECT_EQ(overlays[0].rect, SkRect::MakeLTRB(150, 100, 350, 200));
+  EXPECT_EQ(overlays[0].slices, std::vector<size_t>({1}));
+}
+
+TEST(OverlayPlannerTest, DisjointSlicesShareOneOverlay) {
+  OverlayPlanner planner;
+  auto slice_0 = MakeSlice({SkRect::MakeLTRB(10, 10, 50, 50)});
+  planner.AddPlatformView(SkRect::MakeLTRB(0, 0, 100, 100), slice_0.get());
+  auto slice_1 = MakeSlice({SkRect::MakeLTRB(210, 10, 250, 50)});
+  planner.AddPlatformView(SkRect::MakeLTRB(200, 0, 300, 100), slice_1.get());
+  auto slice_2 = MakeSlice({SkRect::MakeLTRB(410, 10, 450, 50)});
+  planner.AddPlatformView(SkRect::MakeLTRB(400, 0, 500, 100), slice_2.get());
+
+  // The content over the first platform views doesn't cover the later ones,
+  // so it can be shown above all of them.
+  auto overlays = planner.Plan();
+  ASSERT_EQ(overlays.size(), 1u);
+  EXPECT_EQ(overlays[0].view_index, 2u);
+  EXPECT_EQ(overlays[0].rect, SkRect::MakeLTRB(10, 10, 450, 50));
+  EXPECT_EQ(overlays[0].slices, std::vector<size_t>({0, 1, 2}));
+}
+
+TEST(OverlayPlannerTest, OverlayStaysBelowPlatformViewsItCovers) {
+  OverlayPlanner planner;
+  auto slice_0 = MakeSlice({SkRect::MakeLTRB(50, 50, 150, 150)});
+  planner.AddPlatformView(SkRect::MakeLTRB(0, 0, 100, 100), slice_0.get());
+  auto slice_1 = MakeSlice({SkRect::MakeLTRB(150, 150, 160, 160)});
+  planner.AddPlatformView(SkRect::MakeLTRB(80, 80, 200, 200), slice_1.get());
+  auto slice_2 = MakeSlice({SkRect::MakeLTRB(310, 10, 350, 50)});
+  planner.AddPlatformView(SkRect::MakeLTRB(300, 0, 400, 100), slice_2.get());
+
+  EXPECT_EQ(planner.GetSliceOverlayRect(0), SkRect::MakeLTRB(50, 50, 100, 100));
+  auto overlays = planner.Plan();
+  ASSERT_EQ(overlays.size(), 2u);
+  EXPECT_EQ(overlays[0].view_index, 0u);
+  EXPECT_EQ(overlays[0].rect, SkRect::MakeLTRB(50, 50, 100, 100));
+  EXPECT_EQ(overlays[0].slices, std::vector<size_t>({0}));
+  EXPECT_EQ(overlays[1].view_index, 2u);
+  EXPECT_EQ(overlays[1].rect, SkRect::MakeLTRB(150, 10, 350, 160));
+  EXPECT_EQ(overlays[1].slices, std::vector<size_t>({1, 2}));
+}
+
+}  // namespace testing
+}  // namespace flutter
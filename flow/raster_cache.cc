@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -123,10 +125,14 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    if (!ReserveBytes(key.kind(), raster_cache_context)) {
+      return false;
+    }
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
+      cached_bytes_ += entry.image->image_bytes();
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -141,6 +147,91 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+bool RasterCache::UpdateCacheEntryAsync(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    std::function<void(DlCanvas*)> render_function,
+    sk_sp<const DlRTree> rtree) const {
+  if (!async_task_runner_) {
+    return UpdateCacheEntry(id, raster_cache_context, render_function,
+                            std::move(rtree));
+  }
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image || entry.rasterize_pending) {
+    return entry.image != nullptr;
+  }
+  if (!ReserveBytes(key.kind(), raster_cache_context)) {
+    return false;
+  }
+  entry.rasterize_pending = true;
+  if (id.type() == RasterCacheKeyType::kDisplayList) {
+    display_list_cached_this_frame_++;
+  }
+  async_task_runner_->PostTask(
+      [cache = this, token = std::weak_ptr<int>(async_token_), key,
+       gr_context = raster_cache_context.gr_context,
+       dst_color_space = sk_ref_sp(raster_cache_context.dst_color_space),
+       matrix = raster_cache_context.matrix,
+       logical_rect = raster_cache_context.logical_rect,
+       flow_type = raster_cache_context.flow_type,
+       render_function = std::move(render_function),
+       rtree = std::move(rtree)]() mutable {
+        if (token.expired()) {
+          return;
+        }
+        TRACE_EVENT0("flutter", "RasterCache::RasterizeAsync");
+        auto it = cache->cache_.find(key);
+        if (it == cache->cache_.end() || !it->second.rasterize_pending) {
+          return;
+        }
+        Entry& entry = it->second;
+        entry.rasterize_pending = false;
+        Context context = {
+            // clang-format off
+            .gr_context         = gr_context,
+            .dst_color_space    = dst_color_space.get(),
+            .matrix             = matrix,
+            .logical_rect       = logical_rect,
+            .flow_type          = flow_type,
+            // clang-format on
+        };
+        // Other entries may have been cached since the task was posted.
+        if (!cache->ReserveBytes(key.kind(), context)) {
+          return;
+        }
+        entry.image = cache->Rasterize(context, std::move(rtree),
+                                       render_function, DrawCheckerboard);
+        if (entry.image) {
+          cache->cached_bytes_ += entry.image->image_bytes();
+        }
+      });
+  return false;
+}
+
+bool RasterCache::ReserveBytes(RasterCacheKeyKind kind,
+                               const Context& context) const {
+  if (max_bytes_ == 0) {
+    return true;
+  }
+  SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      context.logical_rect,
+      RasterCacheUtil::GetIntegralTransCTM(context.matrix));
+  // The size of the N32 image that Rasterize will create.
+  size_t needed_bytes = static_cast<size_t>(dest_rect.width()) *
+                        static_cast<size_t>(dest_rect.height()) * 4;
+  if (cached_bytes_ + needed_bytes > max_bytes_) {
+    size_t low_watermark = max_bytes_ - max_bytes_ / 4;
+    EvictUnusedImagesToFit(
+        needed_bytes < low_watermark ? low_watermark - needed_bytes : 0);
+    if (cached_bytes_ + needed_bytes > max_bytes_) {
+      GetMetricsForKind(kind).budget_rejection_count++;
+      return false;
+    }
+  }
+  return true;
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -148,6 +239,7 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  entry.last_encountered_frame = frame_count_;
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
@@ -177,8 +269,12 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint,
                        bool preserve_rtree) const {
-  auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
+  RasterCacheKey key(id, canvas.GetTransform());
+  RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+  auto it = cache_.find(key);
   if (it == cache_.end()) {
+    metrics.miss_count++;
+    FML_PERFORMANCE_COUNTER_ADD("rasterCache.misses", 1);
     return false;
   }
 
@@ -186,13 +282,18 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    metrics.hit_count++;
+    FML_PERFORMANCE_COUNTER_ADD("rasterCache.hits", 1);
     return true;
   }
 
+  metrics.miss_count++;
+  FML_PERFORMANCE_COUNTER_ADD("rasterCache.misses", 1);
   return false;
 }
 
 void RasterCache::BeginFrame() {
+  frame_count_++;
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -201,11 +302,17 @@ void RasterCache::BeginFrame() {
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    // Only entries with images can outlive the frames that use them.
+    FML_DCHECK(entry.encountered_this_frame || entry.image);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
@@ -216,19 +323,53 @@ void RasterCache::EvictUnusedCacheEntries() {
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    // With a byte budget, unused images are kept until they no longer fit.
+    if (!entry.encountered_this_frame && (max_bytes_ == 0 || !entry.image)) {
       dead.push_back(it);
     }
   }
 
   for (auto it : dead) {
-    if (it->second.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.eviction_count++;
-      metrics.eviction_bytes += it->second.image->image_bytes();
+    EraseEntry(it);
+  }
+
+  if (max_bytes_ > 0 && cached_bytes_ > max_bytes_) {
+    EvictUnusedImagesToFit(max_bytes_ - max_bytes_ / 4);
+  }
+}
+
+void RasterCache::EvictUnusedImagesToFit(size_t target_bytes) const {
+  if (cached_bytes_ <= target_bytes) {
+    return;
+  }
+
+  std::vector<RasterCacheKey::Map<Entry>::iterator> unused;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (!it->second.encountered_this_frame && it->second.image) {
+      unused.push_back(it);
+    }
+  }
+  std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) {
+    return a->second.last_encountered_frame < b->second.last_encountered_frame;
+  });
+
+  for (auto it : unused) {
+    if (cached_bytes_ <= target_bytes) {
+      break;
     }
-    cache_.erase(it);
+    EraseEntry(it);
+  }
+}
+
+void RasterCache::EraseEntry(RasterCacheKey::Map<Entry>::iterator it) const {
+  if (it->second.image) {
+    size_t bytes = it->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += bytes;
+    cached_bytes_ -= std::min(bytes, cached_bytes_);
   }
+  cache_.erase(it);
 }
 
 void RasterCache::EndFrame() {
@@ -238,6 +379,8 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  cached_bytes_ = 0;
+  async_token_ = std::make_shared<int>(0);
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -287,6 +430,12 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
       "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+  FML_TRACE_COUNTER("flutter",                                       //
+                    "RasterCacheDraws", reinterpret_cast<int64_t>(this),  //
+                    "LayerHits", layer_metrics_.hit_count,                //
+                    "LayerMisses", layer_metrics_.miss_count,             //
+                    "PictureHits", picture_metrics_.hit_count,            //
+                    "PictureMisses", picture_metrics_.miss_count);
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -313,7 +462,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -13,6 +13,7 @@
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -78,15 +79,44 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were kept in this frame
+   * without being used because they fit in the byte budget of the cache.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images that were kept without being used in this
+   * frame.
+   */
+  size_t retained_bytes = 0;
+
+  /**
+   * The number of draws in this frame that were served from a cached image.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of draws in this frame of items that wanted to be drawn from
+   * the cache but had no cached image.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The number of images that were not cached in this frame because they
+   * did not fit in the byte budget of the cache.
+   */
+  size_t budget_rejection_count = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
 };
 
 /**
@@ -104,7 +134,8 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Evict cached images that are no longer used, or, with a byte budget,
+ *       that no longer fit in the budget.
  *   - LayerTree::TryToPrepareRasterCache
  *       Create cache image for each cache entry if it does not exist.
  *   - LayerTree::Paint - for each layer in the tree:
@@ -168,6 +199,37 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Limits the total size of the cached images to |max_bytes|, or
+   * removes the limit if |max_bytes| is 0, which is the default.
+   *
+   * Without a limit, the image of an entry is evicted as soon as a frame
+   * does not use it. With a limit, unused images are kept for as long as
+   * they fit in the budget so that content that scrolls out of view and
+   * back does not need to be rasterized again. When the budget is exceeded
+   * the least recently used images are evicted first, down to 3/4 of the
+   * budget so that a cache at its limit does not evict on every frame. New
+   * images that do not fit in the budget even after evicting all unused
+   * images are not cached.
+   */
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Makes |UpdateCacheEntryAsync| rasterize new entries in tasks
+   * posted to |task_runner| rather than during the frame, or restores
+   * synchronous rasterization if |task_runner| is null, which is the
+   * default.
+   *
+   * The tasks use the GrDirectContext of the frame that posted them, so
+   * |task_runner| must run on the thread that renders the frames. Tasks
+   * posted before the cache is cleared or destroyed do nothing.
+   */
+  void SetAsyncTaskRunner(fml::RefPtr<fml::TaskRunner> task_runner) {
+    async_task_runner_ = std::move(task_runner);
+  }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -246,23 +308,63 @@ class RasterCache {
                         const std::function<void(DlCanvas*)>& render_function,
                         sk_sp<const DlRTree> rtree = nullptr) const;
 
+  /**
+   * @brief Like |UpdateCacheEntry|, but if an async task runner has been
+   * set the image of a new entry is rasterized in a task posted to it, and
+   * this returns false until the image is ready. The caller draws its
+   * content directly in the meantime, so the frame that decides to cache
+   * an item does not pay for rasterizing it.
+   *
+   * |render_function| is called after the frame has ended, so it must not
+   * refer to state that only lives for the duration of the frame.
+   */
+  bool UpdateCacheEntryAsync(const RasterCacheKeyID& id,
+                             const Context& raster_cache_context,
+                             std::function<void(DlCanvas*)> render_function,
+                             sk_sp<const DlRTree> rtree = nullptr) const;
+
  private:
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
+    // Whether a task to rasterize the image has been posted.
+    bool rasterize_pending = false;
     size_t accesses_since_visible = 0;
+    // The frame in which the entry was last encountered.
+    size_t last_encountered_frame = 0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  // Returns whether an image for |context| fits in the byte budget, after
+  // evicting unused images if needed.
+  bool ReserveBytes(RasterCacheKeyKind kind, const Context& context) const;
+
+  // Evicts the images of the entries that were not encountered in this
+  // frame, least recently encountered first, until the cached images use
+  // no more than |target_bytes|.
+  void EvictUnusedImagesToFit(size_t target_bytes) const;
+
+  void EraseEntry(RasterCacheKey::Map<Entry>::iterator it) const;
+
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  size_t max_bytes_ = 0;
+  // The total size of the images in |cache_|.
+  mutable size_t cached_bytes_ = 0;
+  size_t frame_count_ = 0;
+  fml::RefPtr<fml::TaskRunner> async_task_runner_;
+  // Watched by the posted rasterization tasks and replaced by |Clear|, so
+  // that the tasks can tell whether their entries are still valid.
+  std::shared_ptr<int> async_token_ = std::make_shared<int>(0);
+  // The metrics are updated by the const methods that populate and draw the
+  // cache entries during the frame.
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_;
 
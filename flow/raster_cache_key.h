@@ -10,7 +10,7 @@
 #include <utility>
 #include <vector>
 
-#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 
@@ -18,7 +18,13 @@ namespace flutter {
 
 class Layer;
 
-enum class RasterCacheKeyType { kLayer, kDisplayList, kLayerChildren };
+enum class RasterCacheKeyType {
+  kLayer,
+  kDisplayList,
+  kLayerChildren,
+  // The filtered backdrop of a BackdropFilterLayer.
+  kBackdropFilter,
+};
 
 class RasterCacheKeyID {
  public:
@@ -46,14 +52,13 @@ class RasterCacheKeyID {
     if (cached_hash_) {
       return cached_hash_.value();
     }
-    std::size_t seed = fml::HashCombine();
-    fml::HashCombineSeed(seed, unique_id_);
-    fml::HashCombineSeed(seed, type_);
+    fml::FastHasher hasher;
+    hasher.Add(unique_id_, type_);
     for (auto& child_id : child_ids_) {
-      fml::HashCombineSeed(seed, child_id.GetHash());
+      hasher.Add(child_id.GetHash());
     }
-    cached_hash_ = seed;
-    return seed;
+    cached_hash_ = hasher.GetHash();
+    return cached_hash_.value();
   }
 
   bool operator==(const RasterCacheKeyID& other) const {
@@ -96,13 +101,22 @@ class RasterCacheKey {
         return RasterCacheKeyKind::kDisplayListMetrics;
       case RasterCacheKeyType::kLayer:
       case RasterCacheKeyType::kLayerChildren:
+      case RasterCacheKeyType::kBackdropFilter:
         return RasterCacheKeyKind::kLayerMetrics;
     }
   }
 
   struct Hash {
     std::size_t operator()(RasterCacheKey const& key) const {
-      return key.id_.GetHash();
+      // The same layer or display list is frequently cached at more than one
+      // transform, so the matrix has to be part of the hash to keep those
+      // entries from sharing a bucket.
+      fml::FastHasher hasher;
+      hasher.Add(key.id_.GetHash());
+      for (int i = 0; i < 9; i++) {
+        hasher.Add(key.matrix_[i]);
+      }
+      return hasher.GetHash();
     }
   };
 
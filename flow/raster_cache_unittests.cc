@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -266,7 +267,10 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   SkMatrix matrix = SkMatrix::I();
 
   auto display_list_1 = GetSampleDisplayList();
-  auto display_list_2 = GetSampleDisplayList();
+  // The second list draws different contents so that it gets its own entry.
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80), DlPaint(DlColor::kBlue()));
+  auto display_list_2 = builder.Build();
 
   MockCanvas dummy_canvas(1000, 1000);
   DlPaint paint;
@@ -359,6 +363,337 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, ByteBudgetRetainsAndEvictsLeastRecentlyUsed) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Room for two sample images, but not for three.
+  cache.SetMaxBytes(60000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  // The other lists draw different contents so that they get their own
+  // entries.
+  DisplayListBuilder builder_2(SkRect::MakeWH(150, 100));
+  builder_2.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                     DlPaint(DlColor::kBlue()));
+  auto display_list_2 = builder_2.Build();
+  DisplayListBuilder builder_3(SkRect::MakeWH(150, 100));
+  builder_3.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                     DlPaint(DlColor::kGreen()));
+  auto display_list_3 = builder_3.Build();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_3(display_list_3, SkPoint(),
+                                                 true, false);
+
+  // Reach the access threshold of the first two items, then cache them.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemTryToRasterCache(display_list_item_2, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  // The second item is not used but is kept while it fits.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_bytes, 25624u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 51248u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+
+  // The second item is ready again as soon as it comes back.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 2u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 0u);
+
+  // The third item only fits once the unused second item is evicted.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_3, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemTryToRasterCache(display_list_item_3, paint_context);
+    cache.EndFrame();
+  }
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 2u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  ASSERT_EQ(cache.picture_metrics().budget_rejection_count, 0u);
+}
+
+TEST(RasterCache, ByteBudgetRejectsImagesThatDoNotFit) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Room for one sample image.
+  cache.SetMaxBytes(30000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80), DlPaint(DlColor::kBlue()));
+  auto display_list_2 = builder.Build();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  // Both items are in use, so the second cannot make room for itself.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().budget_rejection_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().hit_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().miss_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+}
+
+TEST(RasterCache, AsyncRasterizationDefersImageToLaterFrame) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetAsyncTaskRunner(fml::MessageLoop::GetCurrent().GetTaskRunner());
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  cache.EndFrame();
+
+  // The frame that decides to cache the item draws it directly.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  // The image is drawn from the next frame on.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().hit_count, 1u);
+}
+
+TEST(RasterCache, AsyncRasterizationIsCancelledByClear) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetAsyncTaskRunner(fml::MessageLoop::GetCurrent().GetTaskRunner());
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    ASSERT_FALSE(
+        RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+    cache.EndFrame();
+  }
+
+  cache.Clear();
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EndFrame();
+
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, EqualDisplayListsShareCacheEntry) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  ASSERT_NE(display_list_1.get(), display_list_2.get());
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+  ASSERT_EQ(display_list_item_1.GetId(), display_list_item_2.GetId());
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -760,8 +1095,8 @@ TEST(RasterCache, RasterCacheKeyIDHashCode) {
   std::size_t first_hash = first.GetHash();
   std::size_t second_hash = second.GetHash();
 
-  ASSERT_EQ(first_hash, fml::HashCombine(foo, RasterCacheKeyType::kLayer));
-  ASSERT_EQ(second_hash, fml::HashCombine(bar, RasterCacheKeyType::kLayer));
+  ASSERT_EQ(first_hash, fml::FastHash(foo, RasterCacheKeyType::kLayer));
+  ASSERT_EQ(second_hash, fml::FastHash(bar, RasterCacheKeyType::kLayer));
 
   RasterCacheKeyID third =
       RasterCacheKeyID({first, second}, RasterCacheKeyType::kLayerChildren);
@@ -770,12 +1105,12 @@ TEST(RasterCache, RasterCacheKeyIDHashCode) {
   std::size_t third_hash = third.GetHash();
   std::size_t fourth_hash = fourth.GetHash();
 
-  ASSERT_EQ(third_hash, fml::HashCombine(RasterCacheKeyID::kDefaultUniqueID,
-                                         RasterCacheKeyType::kLayerChildren,
-                                         first.GetHash(), second.GetHash()));
-  ASSERT_EQ(fourth_hash, fml::HashCombine(RasterCacheKeyID::kDefaultUniqueID,
-                                          RasterCacheKeyType::kLayerChildren,
-                                          second.GetHash(), first.GetHash()));
+  ASSERT_EQ(third_hash, fml::FastHash(RasterCacheKeyID::kDefaultUniqueID,
+                                      RasterCacheKeyType::kLayerChildren,
+                                      first.GetHash(), second.GetHash()));
+  ASSERT_EQ(fourth_hash, fml::FastHash(RasterCacheKeyID::kDefaultUniqueID,
+                                       RasterCacheKeyType::kLayerChildren,
+                                       second.GetHash(), first.GetHash()));
 
   // Verify that the cached hash code is correct.
   ASSERT_EQ(first_hash, first.GetHash());
@@ -784,6 +1119,20 @@ TEST(RasterCache, RasterCacheKeyIDHashCode) {
   ASSERT_EQ(fourth_hash, fourth.GetHash());
 }
 
+TEST(RasterCache, RasterCacheKeyHashIncludesMatrix) {
+  RasterCacheKey::Hash hash;
+  RasterCacheKey identity(1, RasterCacheKeyType::kLayer, SkMatrix::I());
+  RasterCacheKey scaled(1, RasterCacheKeyType::kLayer,
+                        SkMatrix::Scale(2.0f, 2.0f));
+  // Integral translations are dropped from the key.
+  RasterCacheKey translated(1, RasterCacheKeyType::kLayer,
+                            SkMatrix::Translate(10.0f, 20.0f));
+
+  ASSERT_NE(hash(identity), hash(scaled));
+  ASSERT_EQ(hash(identity), hash(translated));
+  ASSERT_TRUE(RasterCacheKey::Equal()(identity, translated));
+}
+
 using RasterCacheTest = LayerTest;
 
 TEST_F(RasterCacheTest, RasterCacheKeyIDLayerChildrenIds) {
@@ -802,7 +1151,7 @@ TEST_F(RasterCacheTest, RasterCacheKeyIDLayerChildrenIds) {
   std::vector<RasterCacheKeyID> expected_ids;
   expected_ids.emplace_back(
       RasterCacheKeyID(mock_layer->unique_id(), RasterCacheKeyType::kLayer));
-  expected_ids.emplace_back(RasterCacheKeyID(display_list->unique_id(),
+  expected_ids.emplace_back(RasterCacheKeyID(display_list->content_hash(),
                                              RasterCacheKeyType::kDisplayList));
   ASSERT_EQ(expected_ids[0], mock_layer->caching_key_id());
   ASSERT_EQ(expected_ids[1], display_list_layer->caching_key_id());
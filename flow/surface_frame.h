@@ -12,6 +12,7 @@
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -82,6 +83,17 @@ class SurfaceFrame {
     std::optional<fml::TimePoint> presentation_time;
   };
 
+  // How far the GPU was behind when the frame was acquired. Only reported by
+  // surfaces that limit the number of frames in flight.
+  struct GpuQueueInfo {
+    // The number of frames submitted before this one that the GPU hadn't
+    // finished yet.
+    size_t frames_in_flight = 0;
+
+    // How long acquiring the frame waited for the GPU to catch up.
+    fml::TimeDelta throttle_duration;
+  };
+
   bool Submit();
 
   bool IsSubmitted() const;
@@ -97,6 +109,13 @@ class SurfaceFrame {
   }
   const SubmitInfo& submit_info() const { return submit_info_; }
 
+  void set_gpu_queue_info(const GpuQueueInfo& gpu_queue_info) {
+    gpu_queue_info_ = gpu_queue_info;
+  }
+  const std::optional<GpuQueueInfo>& gpu_queue_info() const {
+    return gpu_queue_info_;
+  }
+
   sk_sp<DisplayList> BuildDisplayList();
 
  private:
@@ -108,6 +127,7 @@ class SurfaceFrame {
   DlCanvas* canvas_ = nullptr;
   FramebufferInfo framebuffer_info_;
   SubmitInfo submit_info_;
+  std::optional<GpuQueueInfo> gpu_queue_info_;
   SubmitCallback submit_callback_;
   std::unique_ptr<GLContextResult> context_result_;
 
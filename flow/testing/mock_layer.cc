@@ -43,6 +43,7 @@ void MockLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(fake_paint_path_.getBounds());
   if (fake_reads_surface()) {
     context->surface_needs_readback = true;
+    context->reads_backdrop = true;
   }
   if (fake_opacity_compatible()) {
     context->renderable_state_flags = LayerStateStack::kCallerCanApplyOpacity;
@@ -51,6 +52,7 @@ void MockLayer::Preroll(PrerollContext* context) {
 
 void MockLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
+  context.state_stack.flush();
 
   if (expected_paint_matrix_.has_value()) {
     SkMatrix matrix = context.canvas->GetTransform();
@@ -72,7 +72,7 @@ void MockRasterCache::AddMockPicture(int width, int height) {
       .logical_rect       = display_list->bounds(),
       // clang-format on
   };
-  UpdateCacheEntry(RasterCacheKeyID(display_list->unique_id(),
+  UpdateCacheEntry(RasterCacheKeyID(display_list->content_hash(),
                                     RasterCacheKeyType::kDisplayList),
                    r_context, [&](DlCanvas* canvas) {
                      SkRect cache_rect = RasterCacheUtil::GetDeviceBounds(
@@ -138,5 +138,25 @@ TEST(TextureRegistryTest, CallsOnGrContextCreatedInInsertionOrder) {
   EXPECT_THAT(destroy_order, ::testing::ElementsAre(5, 4, 3));
 }
 
+TEST(TextureRegistryTest, MarkTextureFrameAvailableStartsNewGeneration) {
+  TextureRegistry registry;
+  auto mock_texture1 = std::make_shared<MockTexture>(0);
+  auto mock_texture2 = std::make_shared<MockTexture>(1);
+  registry.RegisterTexture(mock_texture1);
+  registry.RegisterTexture(mock_texture2);
+  EXPECT_NE(mock_texture1->frame_generation(),
+            mock_texture2->frame_generation());
+
+  const uint64_t generation1 = mock_texture1->frame_generation();
+  const uint64_t generation2 = mock_texture2->frame_generation();
+  registry.MarkTextureFrameAvailable(0);
+  EXPECT_NE(mock_texture1->frame_generation(), generation1);
+  EXPECT_NE(mock_texture1->frame_generation(), generation2);
+  EXPECT_EQ(mock_texture2->frame_generation(), generation2);
+
+  // Unknown textures are ignored.
+  registry.MarkTextureFrameAvailable(2);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+Arena::Arena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 1)) {}
+
+Arena::~Arena() = default;
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  size = std::max<size_t>(size, 1);
+
+  if (!blocks_.empty()) {
+    Block& block = blocks_.back();
+    const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+    const uintptr_t aligned =
+        (base + offset_ + alignment - 1) & ~(alignment - 1);
+    const size_t aligned_offset = aligned - base;
+    if (aligned_offset + size <= block.size) {
+      stats_.allocation_count++;
+      stats_.bytes_allocated += aligned_offset + size - offset_;
+      offset_ = aligned_offset + size;
+      return block.data.get() + aligned_offset;
+    }
+  }
+
+  // Blocks come from operator new[] and are aligned for any fundamental type.
+  // Over-aligned requests reserve enough slack to align within the block.
+  AddBlock(size + (alignment > alignof(std::max_align_t) ? alignment : 0));
+  return Allocate(size, alignment);
+}
+
+void Arena::Reset() {
+  if (blocks_.size() > 1) {
+    size_t total_size = 0;
+    for (const auto& block : blocks_) {
+      total_size += block.size;
+    }
+    blocks_.clear();
+    stats_.bytes_reserved = 0;
+    AddBlock(total_size);
+  }
+  offset_ = 0;
+  stats_.allocation_count = 0;
+  stats_.bytes_allocated = 0;
+}
+
+void Arena::AddBlock(size_t min_size) {
+  const size_t size = std::max(min_size, block_size_);
+  // Deliberately not value initialized.
+  blocks_.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+  offset_ = 0;
+  stats_.block_allocation_count++;
+  stats_.bytes_reserved += size;
+}
+
+}  // namespace fml
@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ARENA_H_
+#define FLUTTER_FML_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A bump allocator for short lived objects that all die at the
+///             same time, typically at the end of a frame.
+///
+///             Allocations are carved out of large blocks and are never freed
+///             individually. |Reset| releases all allocations at once. When
+///             the previous cycle needed more than one block, |Reset|
+///             replaces them with a single block large enough to hold all of
+///             them so that a steady state workload allocates no memory from
+///             the system at all.
+///
+///             The arena does not run destructors. Objects that own
+///             resources must be destroyed before the arena is reset, for
+///             example with |ArenaUniquePtr|.
+///
+///             Arenas are not thread safe.
+///
+class Arena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  struct Stats {
+    /// The number of allocations since the last reset.
+    size_t allocation_count = 0;
+    /// The number of bytes handed out since the last reset, including
+    /// alignment padding.
+    size_t bytes_allocated = 0;
+    /// The number of blocks requested from the system over the lifetime of
+    /// the arena.
+    size_t block_allocation_count = 0;
+    /// The number of bytes currently held in blocks.
+    size_t bytes_reserved = 0;
+  };
+
+  explicit Arena(size_t block_size = kDefaultBlockSize);
+
+  ~Arena();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates uninitialized memory that stays valid until the
+  ///             next call to |Reset| or the destruction of the arena.
+  ///
+  /// @param[in]  size       The size of the allocation in bytes.
+  /// @param[in]  alignment  The alignment of the allocation. Must be a power
+  ///                        of two.
+  ///
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases all allocations made since the last reset.
+  ///
+  void Reset();
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size = 0;
+  };
+
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  size_t offset_ = 0;
+  Stats stats_;
+
+  void AddBlock(size_t min_size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      An STL allocator backed by an |Arena|. Deallocation is a no-op
+///             as the memory is reclaimed with the arena.
+///
+///             A default constructed allocator has no arena and falls back to
+///             the global heap. This lets containers that only sometimes have
+///             an arena available share a single type.
+///
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  ArenaAllocator() = default;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t count) {
+    if (arena_ == nullptr) {
+      return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) {
+    if (arena_ == nullptr) {
+      ::operator delete(pointer);
+    }
+  }
+
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+ private:
+  Arena* arena_ = nullptr;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//------------------------------------------------------------------------------
+/// @brief      A deleter for objects created by |MakeArenaUnique|. Objects
+///             placed in an arena are only destroyed, objects allocated on
+///             the heap for lack of an arena are also freed.
+///
+///             The deleter is not templated on the type so that an
+///             |ArenaUniquePtr| to a derived class converts to one of its
+///             polymorphic base classes.
+///
+struct ArenaDeleter {
+  bool in_arena = false;
+
+  template <typename T>
+  void operator()(T* pointer) const {
+    if (in_arena) {
+      pointer->~T();
+    } else {
+      delete pointer;
+    }
+  }
+};
+
+template <typename T>
+using ArenaUniquePtr = std::unique_ptr<T, ArenaDeleter>;
+
+//------------------------------------------------------------------------------
+/// @brief      Constructs an object in |arena|, or on the heap if |arena| is
+///             null. The object must be destroyed before the arena is reset.
+///
+template <typename T, typename... Args>
+ArenaUniquePtr<T> MakeArenaUnique(Arena* arena, Args&&... args) {
+  if (arena == nullptr) {
+    return ArenaUniquePtr<T>(new T(std::forward<Args>(args)...),
+                             ArenaDeleter{false});
+  }
+  void* memory = arena->Allocate(sizeof(T), alignof(T));
+  return ArenaUniquePtr<T>(new (memory) T(std::forward<Args>(args)...),
+                           ArenaDeleter{true});
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ARENA_H_
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/arena.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(ArenaTest, AllocationsAreAlignedAndDisjoint) {
+  Arena arena(256);
+  auto* a = static_cast<char*>(arena.Allocate(3, 1));
+  auto* b = static_cast<char*>(arena.Allocate(8, 8));
+  auto* c = static_cast<char*>(arena.Allocate(64, 64));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 64, 0u);
+  EXPECT_GE(b, a + 3);
+  EXPECT_GE(c, b + 8);
+  EXPECT_EQ(arena.GetStats().allocation_count, 3u);
+}
+
+TEST(ArenaTest, LargeAllocationsGetTheirOwnBlock) {
+  Arena arena(64);
+  void* large = arena.Allocate(1024);
+  ASSERT_NE(large, nullptr);
+  EXPECT_GE(arena.GetStats().bytes_reserved, 1024u);
+  EXPECT_EQ(arena.GetStats().block_allocation_count, 1u);
+}
+
+TEST(ArenaTest, ResetCoalescesBlocksForTheNextCycle) {
+  Arena arena(128);
+  for (int i = 0; i < 32; i++) {
+    arena.Allocate(32);
+  }
+  const auto blocks_first_cycle = arena.GetStats().block_allocation_count;
+  EXPECT_GT(blocks_first_cycle, 1u);
+
+  arena.Reset();
+  EXPECT_EQ(arena.GetStats().allocation_count, 0u);
+  EXPECT_EQ(arena.GetStats().bytes_allocated, 0u);
+  // The coalesced block is the only new system allocation.
+  EXPECT_EQ(arena.GetStats().block_allocation_count, blocks_first_cycle + 1);
+
+  for (int i = 0; i < 32; i++) {
+    arena.Allocate(32);
+  }
+  EXPECT_EQ(arena.GetStats().block_allocation_count, blocks_first_cycle + 1);
+  EXPECT_EQ(arena.GetStats().allocation_count, 32u);
+}
+
+TEST(ArenaTest, VectorUsesArena) {
+  Arena arena;
+  ArenaVector<int> values{ArenaAllocator<int>(&arena)};
+  for (int i = 0; i < 100; i++) {
+    values.push_back(i);
+  }
+  EXPECT_GT(arena.GetStats().allocation_count, 0u);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+TEST(ArenaTest, DefaultAllocatorUsesHeap) {
+  ArenaVector<int> values;
+  values.assign(100, 7);
+  EXPECT_EQ(values.get_allocator().arena(), nullptr);
+  EXPECT_EQ(values[99], 7);
+}
+
+namespace {
+
+class Base {
+ public:
+  explicit Base(int* destroyed) : destroyed_(destroyed) {}
+  virtual ~Base() = default;
+
+ protected:
+  int* destroyed_;
+};
+
+class Derived : public Base {
+ public:
+  explicit Derived(int* destroyed) : Base(destroyed) {}
+  ~Derived() override { (*destroyed_)++; }
+};
+
+}  // namespace
+
+TEST(ArenaTest, UniquePtrRunsDestructors) {
+  Arena arena;
+  int destroyed = 0;
+  {
+    ArenaUniquePtr<Base> in_arena =
+        MakeArenaUnique<Derived>(&arena, &destroyed);
+    ArenaUniquePtr<Base> on_heap =
+        MakeArenaUnique<Derived>(nullptr, &destroyed);
+    EXPECT_EQ(arena.GetStats().allocation_count, 1u);
+  }
+  EXPECT_EQ(destroyed, 2);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -7,17 +7,42 @@
 #include <algorithm>
 
 #include "flutter/fml/thread.h"
+#include "flutter/fml/thread_local.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+namespace {
+
+// Identifies the work-stealing loop and the index of the worker the current
+// thread belongs to.
+struct WorkerIdentity {
+  const ConcurrentMessageLoop* loop;
+  size_t index;
+};
+
+}  // namespace
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<WorkerIdentity> tls_worker_identity;
+
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             SchedulingMode mode)
+    : worker_count_(std::max<size_t>(worker_count, 1ul)), mode_(mode) {
+  if (mode_ == SchedulingMode::kWorkStealing) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      if (mode_ == SchedulingMode::kWorkStealing) {
+        WorkStealingWorkerMain(i);
+      } else {
+        WorkerMain();
+      }
     });
   }
 
@@ -38,6 +63,11 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
+ConcurrentMessageLoop::SchedulingMode ConcurrentMessageLoop::GetSchedulingMode()
+    const {
+  return mode_;
+}
+
 std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
@@ -47,6 +77,18 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
+  if (mode_ == SchedulingMode::kWorkStealing) {
+    if (shutdown_) {
+      FML_DLOG(WARNING)
+          << "Tried to post a task to shutdown concurrent message "
+             "loop. The task will be executed on the callers thread.";
+      ExecuteTask(task);
+      return;
+    }
+    PushToWorkerQueue(next_worker_queue_.fetch_add(1) % worker_count_, task);
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -112,6 +154,110 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
+void ConcurrentMessageLoop::PostTaskToCurrentWorker(const fml::closure& task) {
+  if (!task) {
+    return;
+  }
+
+  const auto* identity = tls_worker_identity.get();
+  if (mode_ != SchedulingMode::kWorkStealing || shutdown_ || !identity ||
+      identity->loop != this) {
+    PostTask(task);
+    return;
+  }
+
+  PushToWorkerQueue(identity->index, task);
+}
+
+void ConcurrentMessageLoop::PushToWorkerQueue(size_t worker_index,
+                                              const fml::closure& task) {
+  FML_DCHECK(worker_index < worker_queues_.size());
+  {
+    auto& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  pending_worker_tasks_.fetch_add(1);
+
+  // Only touch the shared mutex if there is a worker that may be asleep. The
+  // sleeping worker increments |idle_workers_| before checking
+  // |pending_worker_tasks_| with the mutex held, so the wake-up cannot be
+  // missed.
+  if (idle_workers_.load() > 0) {
+    { std::scoped_lock lock(tasks_mutex_); }
+    tasks_condition_.notify_one();
+  }
+}
+
+fml::closure ConcurrentMessageLoop::TakeWorkerTask(size_t worker_index) {
+  {
+    auto& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      fml::closure task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      pending_worker_tasks_.fetch_sub(1);
+      return task;
+    }
+  }
+
+  for (size_t i = 1; i < worker_count_; ++i) {
+    auto& victim = *worker_queues_[(worker_index + i) % worker_count_];
+    std::unique_lock lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || victim.tasks.empty()) {
+      continue;
+    }
+    fml::closure task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    pending_worker_tasks_.fetch_sub(1);
+    return task;
+  }
+
+  return nullptr;
+}
+
+void ConcurrentMessageLoop::WorkStealingWorkerMain(size_t worker_index) {
+  tls_worker_identity.reset(new WorkerIdentity{this, worker_index});
+
+  while (true) {
+    if (fml::closure task = TakeWorkerTask(worker_index)) {
+      ExecuteTask(task);
+      if (shutdown_) {
+        break;
+      }
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    idle_workers_.fetch_add(1);
+    tasks_condition_.wait(lock, [&]() {
+      return pending_worker_tasks_.load() > 0 || shutdown_ ||
+             HasThreadTasksLocked();
+    });
+    idle_workers_.fetch_sub(1);
+
+    bool shutdown_now = shutdown_;
+    std::vector<fml::closure> thread_tasks;
+    if (HasThreadTasksLocked()) {
+      thread_tasks = GetThreadTasksLocked();
+      FML_DCHECK(!HasThreadTasksLocked());
+    }
+
+    lock.unlock();
+
+    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+    for (const auto& thread_task : thread_tasks) {
+      ExecuteTask(thread_task);
+    }
+
+    if (shutdown_now) {
+      break;
+    }
+  }
+
+  tls_worker_identity.reset(nullptr);
+}
+
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
   task();
 }
@@ -169,6 +315,22 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
+void ConcurrentTaskRunner::PostTaskToCurrentWorker(const fml::closure& task) {
+  if (!task) {
+    return;
+  }
+
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostTaskToCurrentWorker(task);
+    return;
+  }
+
+  FML_DLOG(WARNING)
+      << "Tried to post to a concurrent message loop that has already died. "
+         "Executing the task on the callers thread.";
+  task();
+}
+
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
   std::scoped_lock lock(tasks_mutex_);
   for (const auto& worker_thread_id : worker_thread_ids_) {
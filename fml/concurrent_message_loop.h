@@ -5,7 +5,9 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <queue>
 #include <thread>
@@ -21,8 +23,20 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  /// How tasks are distributed among the workers of the loop.
+  enum class SchedulingMode {
+    /// All workers pull from a single queue guarded by one mutex.
+    kSharedQueue,
+    /// Each worker owns a deque. Tasks posted from outside the loop are
+    /// distributed round-robin, tasks posted via |PostTaskToCurrentWorker|
+    /// stay on the posting worker, and idle workers steal from the other
+    /// workers' deques. Suited to bursts of many small tasks.
+    kWorkStealing,
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      SchedulingMode mode = SchedulingMode::kSharedQueue);
 
   virtual ~ConcurrentMessageLoop();
 
@@ -34,28 +48,59 @@ class ConcurrentMessageLoop
 
   void PostTaskToAllWorkers(const fml::closure& task);
 
+  /// Posts a task to the deque of the worker this is called on. This keeps
+  /// follow-up work on the same worker (and its caches) unless another worker
+  /// runs out of work and steals it. If the calling thread is not a worker of
+  /// this loop, or the loop does not use |SchedulingMode::kWorkStealing|, this
+  /// is equivalent to posting the task to the task runner.
+  void PostTaskToCurrentWorker(const fml::closure& task);
+
   bool RunsTasksOnCurrentThread();
 
+  SchedulingMode GetSchedulingMode() const;
+
  protected:
-  explicit ConcurrentMessageLoop(size_t worker_count);
+  explicit ConcurrentMessageLoop(
+      size_t worker_count,
+      SchedulingMode mode = SchedulingMode::kSharedQueue);
   virtual void ExecuteTask(const fml::closure& task);
 
  private:
   friend ConcurrentTaskRunner;
 
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+  };
+
   size_t worker_count_ = 0;
+  const SchedulingMode mode_;
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
   std::queue<fml::closure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_bool shutdown_ = false;
+
+  // Only used in |SchedulingMode::kWorkStealing|.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::atomic_size_t pending_worker_tasks_ = 0;
+  std::atomic_size_t idle_workers_ = 0;
+  std::atomic_size_t next_worker_queue_ = 0;
 
   void WorkerMain();
 
+  void WorkStealingWorkerMain(size_t worker_index);
+
   void PostTask(const fml::closure& task);
 
+  void PushToWorkerQueue(size_t worker_index, const fml::closure& task);
+
+  /// Pops from the back of the worker's own deque, then tries to steal from
+  /// the front of the deques of the other workers.
+  fml::closure TakeWorkerTask(size_t worker_index);
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
@@ -71,6 +116,9 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  /// \see ConcurrentMessageLoop::PostTaskToCurrentWorker
+  void PostTaskToCurrentWorker(const fml::closure& task);
+
  private:
   friend ConcurrentMessageLoop;
 
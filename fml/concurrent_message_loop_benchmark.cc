@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Posts a burst of |state.range(0)| small tasks from outside the loop, similar
+// to an image grid scheduling decodes.
+static void BM_ConcurrentLoopPostBurst(
+    benchmark::State& state,  // NOLINT
+    ConcurrentMessageLoop::SchedulingMode mode) {
+  auto loop = ConcurrentMessageLoop::Create(4u, mode);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t task_count = state.range(0);
+
+  while (state.KeepRunning()) {
+    CountDownLatch latch(task_count);
+    for (size_t i = 0; i < task_count; i++) {
+      task_runner->PostTask([&latch]() { latch.CountDown(); });
+    }
+    latch.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * task_count);
+}
+
+// Each task fans out into |state.range(0)| follow-up tasks posted from the
+// worker, similar to a decode scheduling its resize.
+static void BM_ConcurrentLoopFanOut(
+    benchmark::State& state,  // NOLINT
+    ConcurrentMessageLoop::SchedulingMode mode) {
+  auto loop = ConcurrentMessageLoop::Create(4u, mode);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t root_count = 16;
+  const size_t fanout = state.range(0);
+
+  while (state.KeepRunning()) {
+    CountDownLatch latch(root_count * fanout);
+    for (size_t i = 0; i < root_count; i++) {
+      task_runner->PostTask([&latch, &task_runner, fanout]() {
+        for (size_t j = 0; j < fanout; j++) {
+          task_runner->PostTaskToCurrentWorker(
+              [&latch]() { latch.CountDown(); });
+        }
+      });
+    }
+    latch.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * root_count * fanout);
+}
+
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostBurst,
+                  SharedQueue,
+                  ConcurrentMessageLoop::SchedulingMode::kSharedQueue)
+    ->Arg(64)
+    ->Arg(512)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopPostBurst,
+                  WorkStealing,
+                  ConcurrentMessageLoop::SchedulingMode::kWorkStealing)
+    ->Arg(64)
+    ->Arg(512)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopFanOut,
+                  SharedQueue,
+                  ConcurrentMessageLoop::SchedulingMode::kSharedQueue)
+    ->Arg(8)
+    ->Arg(64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentLoopFanOut,
+                  WorkStealing,
+                  ConcurrentMessageLoop::SchedulingMode::kWorkStealing)
+    ->Arg(8)
+    ->Arg(64)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -6,16 +6,21 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include "flutter/fml/logging.h"
+#include "flutter/fml/timer_wheel.h"
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
                          const fml::closure& task,
                          fml::TimePoint target_time,
-                         fml::TaskSourceGrade task_source_grade)
+                         fml::TaskSourceGrade task_source_grade,
+                         fml::TaskPriority priority)
     : order_(order),
       task_(task),
       target_time_(target_time),
-      task_source_grade_(task_source_grade) {}
+      task_source_grade_(task_source_grade),
+      priority_(priority) {}
 
 DelayedTask::~DelayedTask() = default;
 
@@ -33,6 +38,10 @@ fml::TaskSourceGrade DelayedTask::GetTaskSourceGrade() const {
   return task_source_grade_;
 }
 
+fml::TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
@@ -40,4 +49,64 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+// Lower ranks run first. Tasks that aren't due yet have the highest rank.
+static size_t GetRank(const DelayedTask& task, fml::TimePoint now) {
+  if (task.GetTargetTime() > now) {
+    return kTaskPriorityCount + 1;
+  }
+  if (now - task.GetTargetTime() > GetTaskStarvationLimit(task.GetPriority())) {
+    return 0;
+  }
+  return static_cast<size_t>(task.GetPriority()) + 1;
+}
+
+bool DelayedTask::RunsBefore(const DelayedTask& other,
+                             fml::TimePoint now) const {
+  const size_t rank = GetRank(*this, now);
+  const size_t other_rank = GetRank(other, now);
+  if (rank != other_rank) {
+    return rank < other_rank;
+  }
+  return other > *this;
+}
+
+std::unique_ptr<DelayedTaskQueue> DelayedTaskQueue::Create(
+    DelayedTaskQueueType type) {
+  switch (type) {
+    case DelayedTaskQueueType::kBinaryHeap:
+      return std::make_unique<BinaryHeapDelayedTaskQueue>();
+    case DelayedTaskQueueType::kTimerWheel:
+      return std::make_unique<TimerWheelDelayedTaskQueue>();
+  }
+  FML_UNREACHABLE();
+}
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+BinaryHeapDelayedTaskQueue::BinaryHeapDelayedTaskQueue() = default;
+
+BinaryHeapDelayedTaskQueue::~BinaryHeapDelayedTaskQueue() = default;
+
+void BinaryHeapDelayedTaskQueue::Push(const DelayedTask& task) {
+  heap_.push(task);
+}
+
+void BinaryHeapDelayedTaskQueue::Pop() {
+  FML_DCHECK(!heap_.empty());
+  heap_.pop();
+}
+
+const DelayedTask& BinaryHeapDelayedTaskQueue::Top() const {
+  FML_DCHECK(!heap_.empty());
+  return heap_.top();
+}
+
+size_t BinaryHeapDelayedTaskQueue::Size() const {
+  return heap_.size();
+}
+
+void BinaryHeapDelayedTaskQueue::Clear() {
+  heap_ = {};
+}
+
 }  // namespace fml
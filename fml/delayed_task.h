@@ -5,9 +5,11 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
+#include <memory>
 #include <queue>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -18,7 +20,8 @@ class DelayedTask {
   DelayedTask(size_t order,
               const fml::closure& task,
               fml::TimePoint target_time,
-              fml::TaskSourceGrade task_source_grade);
+              fml::TaskSourceGrade task_source_grade,
+              fml::TaskPriority priority = fml::TaskPriority::kNormal);
 
   DelayedTask(const DelayedTask& other);
 
@@ -30,18 +33,89 @@ class DelayedTask {
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
 
+  fml::TaskPriority GetPriority() const;
+
   bool operator>(const DelayedTask& other) const;
 
+  /// Whether this task should run before |other| at time |now|. Tasks that
+  /// are due run before the ones that aren't, starving tasks before the
+  /// others, and tasks of higher priorities first. Ties are broken by
+  /// |operator>|.
+  /// \see fml::TaskPriority
+  bool RunsBefore(const DelayedTask& other, fml::TimePoint now) const;
+
  private:
   size_t order_;
   fml::closure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+  fml::TaskPriority priority_;
+};
+
+/// The data structure used to order the pending tasks of a task queue.
+enum class DelayedTaskQueueType {
+  /// A binary heap. Inserting and popping tasks is O(log n).
+  kBinaryHeap,
+  /// A hierarchical timing wheel. Inserting is O(1) and tasks that expire in
+  /// the same millisecond are moved out of the wheel in bulk. Suited to
+  /// queues with thousands of pending delayed tasks.
+  /// \see TimerWheelDelayedTaskQueue
+  kTimerWheel,
+};
+
+/// A container of pending |DelayedTask|s that yields them in the order
+/// defined by |DelayedTask::operator>|, i.e. by target time and then by
+/// registration order.
+class DelayedTaskQueue {
+ public:
+  static std::unique_ptr<DelayedTaskQueue> Create(DelayedTaskQueueType type);
+
+  virtual ~DelayedTaskQueue();
+
+  virtual void Push(const DelayedTask& task) = 0;
+
+  /// Removes the task returned by |Top|. The queue must not be empty.
+  virtual void Pop() = 0;
+
+  /// The task with the earliest target time. The queue must not be empty.
+  virtual const DelayedTask& Top() const = 0;
+
+  virtual size_t Size() const = 0;
+
+  /// Drops all the pending tasks.
+  virtual void Clear() = 0;
+
+  bool Empty() const { return Size() == 0; }
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A |DelayedTaskQueue| backed by a binary heap.
+class BinaryHeapDelayedTaskQueue final : public DelayedTaskQueue {
+ public:
+  BinaryHeapDelayedTaskQueue();
+
+  ~BinaryHeapDelayedTaskQueue() override;
+
+  // |DelayedTaskQueue|
+  void Push(const DelayedTask& task) override;
+
+  // |DelayedTaskQueue|
+  void Pop() override;
+
+  // |DelayedTaskQueue|
+  const DelayedTask& Top() const override;
+
+  // |DelayedTaskQueue|
+  size_t Size() const override;
+
+  // |DelayedTaskQueue|
+  void Clear() override;
+
+ private:
+  std::priority_queue<DelayedTask,
+                      std::deque<DelayedTask>,
+                      std::greater<DelayedTask>>
+      heap_;
+};
 
 }  // namespace fml
 
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/fast_hash.h"
+
+#include <cstring>
+
+namespace fml {
+
+namespace {
+
+using internal::kWyP0;
+using internal::kWyP1;
+using internal::kWyP2;
+using internal::kWyP3;
+using internal::WyMix;
+using internal::WyMultiply;
+
+// Unaligned loads in native byte order. The hash only has to be consistent
+// within a process.
+inline uint64_t Read8(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint64_t Read4(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// Reads 1 to 3 bytes.
+inline uint64_t Read3(const uint8_t* p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 16) |
+         (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+}  // namespace
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  seed ^= WyMix(seed ^ kWyP0, kWyP1);
+  uint64_t a = 0;
+  uint64_t b = 0;
+  if (size <= 16) {
+    if (size >= 4) {
+      const size_t offset = (size >> 3) << 2;
+      a = (Read4(p) << 32) | Read4(p + offset);
+      b = (Read4(p + size - 4) << 32) | Read4(p + size - 4 - offset);
+    } else if (size > 0) {
+      a = Read3(p, size);
+    }
+  } else {
+    size_t remaining = size;
+    if (remaining > 48) {
+      // Three independent lanes keep the multipliers busy.
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = WyMix(Read8(p) ^ kWyP1, Read8(p + 8) ^ seed);
+        seed1 = WyMix(Read8(p + 16) ^ kWyP2, Read8(p + 24) ^ seed1);
+        seed2 = WyMix(Read8(p + 32) ^ kWyP3, Read8(p + 40) ^ seed2);
+        p += 48;
+        remaining -= 48;
+      } while (remaining > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (remaining > 16) {
+      seed = WyMix(Read8(p) ^ kWyP1, Read8(p + 8) ^ seed);
+      p += 16;
+      remaining -= 16;
+    }
+    // The last 16 bytes, which may overlap data that was already consumed.
+    a = Read8(p + remaining - 16);
+    b = Read8(p + remaining - 8);
+  }
+  a ^= kWyP1;
+  b ^= seed;
+  WyMultiply(a, b);
+  return WyMix(a ^ kWyP0 ^ size, b ^ kWyP1);
+}
+
+}  // namespace fml
@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FAST_HASH_H_
+#define FLUTTER_FML_FAST_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace fml {
+
+namespace internal {
+
+// The secret of wyhash (https://github.com/wangyi-fudan/wyhash, public
+// domain).
+constexpr uint64_t kWyP0 = 0xa0761d6478bd642full;
+constexpr uint64_t kWyP1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t kWyP2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t kWyP3 = 0x589965cc75374cc3ull;
+
+// Multiplies |a| and |b| into a 128 bit product and returns the low and high
+// halves in |a| and |b|.
+constexpr void WyMultiply(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<uint64_t>(product);
+  b = static_cast<uint64_t>(product >> 64);
+#else
+  const uint64_t ha = a >> 32, hb = b >> 32;
+  const uint64_t la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  uint64_t carry = t < rl;
+  const uint64_t lo = t + (rm1 << 32);
+  carry += lo < t;
+  const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+  a = lo;
+  b = hi;
+#endif
+}
+
+// Folds the 128 bit product of |a| and |b| into 64 bits.
+constexpr uint64_t WyMix(uint64_t a, uint64_t b) {
+  WyMultiply(a, b);
+  return a ^ b;
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @brief      Hashes |size| bytes starting at |data| with wyhash. This reads
+///             eight bytes at a time and is considerably faster than byte
+///             at a time hashes like std::hash<std::string> for the short
+///             labels and keys used in the engine's caches.
+///
+///             The result is only stable within a process. Do not persist it.
+///
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+inline uint64_t HashBytes(std::string_view string, uint64_t seed = 0) {
+  return HashBytes(string.data(), string.size(), seed);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Incrementally hashes a list of fields, mixing each one with a
+///             full 64x64 bit multiply. Unlike |HashCombine|, every bit of
+///             every field affects every bit of the result, so keys that only
+///             differ in a small integer do not collide in the low bits used
+///             to select hash buckets.
+///
+///             Integral and enum fields are hashed by value and the whole
+///             computation is constexpr for them. Other types are hashed with
+///             their std::hash specialization first, which keeps equal
+///             floating point values such as 0.0 and -0.0 hashing the same.
+///
+class FastHasher {
+ public:
+  static constexpr uint64_t kDefaultSeed = 0xdabbad00;
+
+  constexpr explicit FastHasher(uint64_t seed = kDefaultSeed)
+      : state_(seed ^ internal::WyMix(seed ^ internal::kWyP0,
+                                      internal::kWyP1)) {}
+
+  template <class Type>
+  constexpr FastHasher& Add(const Type& value) {
+    if constexpr (std::is_enum_v<Type>) {
+      return AddWord(static_cast<uint64_t>(
+          static_cast<std::underlying_type_t<Type>>(value)));
+    } else if constexpr (std::is_integral_v<Type>) {
+      return AddWord(static_cast<uint64_t>(value));
+    } else {
+      return AddWord(static_cast<uint64_t>(std::hash<Type>{}(value)));
+    }
+  }
+
+  template <class Type, class... Rest>
+  constexpr FastHasher& Add(const Type& value, const Rest&... rest) {
+    Add(value);
+    return Add(rest...);
+  }
+
+  /// Adds a run of bytes, such as the characters of a label.
+  FastHasher& AddBytes(const void* data, size_t size) {
+    return AddWord(HashBytes(data, size, state_));
+  }
+
+  FastHasher& AddBytes(std::string_view string) {
+    return AddBytes(string.data(), string.size());
+  }
+
+  [[nodiscard]] constexpr std::size_t GetHash() const {
+    return static_cast<std::size_t>(
+        internal::WyMix(state_ ^ internal::kWyP2, count_ ^ internal::kWyP3));
+  }
+
+ private:
+  uint64_t state_;
+  uint64_t count_ = 0;
+
+  constexpr FastHasher& AddWord(uint64_t word) {
+    state_ = internal::WyMix(state_ ^ internal::kWyP1, word ^ internal::kWyP0);
+    count_++;
+    return *this;
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A drop in replacement for |HashCombine| based on |FastHasher|.
+///
+template <class... Type>
+[[nodiscard]] constexpr std::size_t FastHash(const Type&... fields) {
+  FastHasher hasher;
+  if constexpr (sizeof...(fields) > 0) {
+    hasher.Add(fields...);
+  }
+  return hasher.GetHash();
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FAST_HASH_H_
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <string>
+
+#include "flutter/fml/fast_hash.h"
+#include "flutter/fml/hash_combine.h"
+
+namespace fml {
+
+static void BM_HashCombineFields(benchmark::State& state) {
+  uint64_t id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HashCombine(id++, 3, 1.5f, true));
+  }
+}
+BENCHMARK(BM_HashCombineFields);
+
+static void BM_FastHashFields(benchmark::State& state) {
+  uint64_t id = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FastHash(id++, 3, 1.5f, true));
+  }
+}
+BENCHMARK(BM_FastHashFields);
+
+static void BM_StdHashString(benchmark::State& state) {
+  std::string label(state.range(0), 'x');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::hash<std::string>{}(label));
+  }
+}
+BENCHMARK(BM_StdHashString)->Arg(8)->Arg(32)->Arg(128);
+
+static void BM_HashBytesString(benchmark::State& state) {
+  std::string label(state.range(0), 'x');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HashBytes(label));
+  }
+}
+BENCHMARK(BM_HashBytesString)->Arg(8)->Arg(32)->Arg(128);
+
+}  // namespace fml
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/fast_hash.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+enum class TestEnum : uint8_t { kA, kB };
+
+TEST(FastHashTest, FieldHashIsConstexpr) {
+  constexpr std::size_t hash = FastHash(1, 2u, TestEnum::kB, true);
+  static_assert(hash == FastHash(1, 2u, TestEnum::kB, true));
+  static_assert(FastHash(1, 2) != FastHash(2, 1));
+  static_assert(FastHash() != FastHash(0));
+  ASSERT_EQ(hash, FastHash(1, 2u, TestEnum::kB, true));
+}
+
+TEST(FastHashTest, FloatingPointZerosHashTheSame) {
+  ASSERT_EQ(FastHash(0.0f), FastHash(-0.0f));
+  ASSERT_NE(FastHash(1.0f), FastHash(2.0f));
+}
+
+TEST(FastHashTest, SmallIntegersDoNotCollideInLowBits) {
+  // Pipeline and cache keys are frequently small enums and indices. Make sure
+  // the bits that pick the bucket of a power of two table are well mixed.
+  std::unordered_set<std::size_t> low_bits;
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 64; j++) {
+      low_bits.insert(FastHash(i, j) & 0xffff);
+    }
+  }
+  // 4096 keys in 65536 buckets should see only a few dozen collisions.
+  ASSERT_GT(low_bits.size(), 3900u);
+}
+
+TEST(FastHashTest, HashBytesCoversAllLengths) {
+  std::string data;
+  std::unordered_set<uint64_t> hashes;
+  for (size_t i = 0; i < 200; i++) {
+    ASSERT_EQ(HashBytes(data), HashBytes(data.data(), data.size()));
+    ASSERT_NE(HashBytes(data), HashBytes(data, 1));
+    hashes.insert(HashBytes(data));
+    data.push_back(static_cast<char>('a' + i % 26));
+  }
+  ASSERT_EQ(hashes.size(), 200u);
+}
+
+TEST(FastHashTest, HashBytesSeesEveryByte) {
+  std::string data(100, 'x');
+  const auto base = HashBytes(data);
+  for (size_t i = 0; i < data.size(); i++) {
+    std::string changed = data;
+    changed[i] = 'y';
+    ASSERT_NE(HashBytes(changed), base) << i;
+  }
+}
+
+TEST(FastHashTest, HasherAddsBytes) {
+  FastHasher a;
+  a.Add(1).AddBytes("label");
+  FastHasher b;
+  b.Add(1).AddBytes("label");
+  FastHasher c;
+  c.Add(1).AddBytes("lab");
+  ASSERT_EQ(a.GetHash(), b.GetHash());
+  ASSERT_NE(a.GetHash(), c.GetHash());
+}
+
+}  // namespace testing
+}  // namespace fml
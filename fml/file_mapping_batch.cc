@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file_mapping_batch.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+// The maximum number of tasks posted to the task runner for a single batch.
+// Opening and mapping files is bound by IO latency rather than CPU, so a
+// handful of concurrent requests is enough to keep the IO queue busy.
+constexpr size_t kMaxConcurrentMappingTasks = 8;
+
+std::unique_ptr<FileMapping> MapFile(const fml::UniqueFD& base_directory,
+                                     const std::string& path) {
+  TRACE_EVENT0("flutter", "MapFile");
+  fml::UniqueFD fd =
+      fml::OpenFile(base_directory, path.c_str(), false, FilePermission::kRead);
+  if (!fd.is_valid() || fml::IsDirectory(fd)) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<FileMapping>(fd);
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+// State shared by the tasks mapping the files of a batch. Each file is
+// claimed by exactly one thread via |next_index| so the slots of |mappings|
+// are never written concurrently.
+class MappingBatch {
+ public:
+  MappingBatch(const fml::UniqueFD& base_directory,
+               std::vector<std::string> paths,
+               std::function<void(FileMappings)> on_done)
+      : base_directory_(base_directory),
+        paths_(std::move(paths)),
+        on_done_(std::move(on_done)) {
+    mappings_.resize(paths_.size());
+  }
+
+  /// Maps files until there are none left to claim.
+  void MapRemainingFiles() {
+    while (true) {
+      const size_t index = next_index_.fetch_add(1);
+      if (index >= paths_.size()) {
+        return;
+      }
+      mappings_[index] = MapFile(base_directory_, paths_[index]);
+      if (completed_.fetch_add(1) + 1 == paths_.size()) {
+        on_done_(std::move(mappings_));
+      }
+    }
+  }
+
+  size_t GetSize() const { return paths_.size(); }
+
+ private:
+  const fml::UniqueFD& base_directory_;
+  const std::vector<std::string> paths_;
+  const std::function<void(FileMappings)> on_done_;
+  FileMappings mappings_;
+  std::atomic_size_t next_index_ = 0;
+  std::atomic_size_t completed_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MappingBatch);
+};
+
+void PostMappingTasks(const std::shared_ptr<MappingBatch>& batch,
+                      const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                      size_t max_tasks) {
+  const size_t task_count = std::min(batch->GetSize(), max_tasks);
+  for (size_t i = 0; i < task_count; i++) {
+    task_runner->PostTask([batch]() { batch->MapRemainingFiles(); });
+  }
+}
+
+}  // namespace
+
+FileMappings MapFilesInParallel(
+    const fml::UniqueFD& base_directory,
+    const std::vector<std::string>& paths,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  TRACE_EVENT0("flutter", "MapFilesInParallel");
+  if (!task_runner || paths.size() < 2) {
+    FileMappings mappings;
+    for (const auto& path : paths) {
+      mappings.emplace_back(MapFile(base_directory, path));
+    }
+    return mappings;
+  }
+
+  // Tasks that only get to run after the batch is complete find nothing left
+  // to claim, so |base_directory| is never used after this call returns. The
+  // result is shared with the batch since the thread completing it may still
+  // be signaling the event when this call returns.
+  struct Result {
+    FileMappings mappings;
+    fml::ManualResetWaitableEvent done;
+  };
+  auto result = std::make_shared<Result>();
+  auto batch = std::make_shared<MappingBatch>(
+      base_directory, paths, [result](FileMappings mappings) {
+        result->mappings = std::move(mappings);
+        result->done.Signal();
+      });
+  // The calling thread is one of the mappers.
+  PostMappingTasks(batch, task_runner, kMaxConcurrentMappingTasks - 1);
+  batch->MapRemainingFiles();
+  result->done.Wait();
+  return std::move(result->mappings);
+}
+
+void MapFilesAsync(const fml::UniqueFD& base_directory,
+                   std::vector<std::string> paths,
+                   const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                   std::function<void(FileMappings)> callback) {
+  TRACE_EVENT0("flutter", "MapFilesAsync");
+  if (!task_runner || paths.empty()) {
+    callback(MapFilesInParallel(base_directory, paths, nullptr));
+    return;
+  }
+
+  // The duplicated descriptor is owned by the completion callback, which
+  // outlives all the file mapping work of the batch.
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::Duplicate(base_directory.get()));
+  auto batch = std::make_shared<MappingBatch>(
+      *directory, std::move(paths),
+      [directory, callback = std::move(callback)](FileMappings mappings) {
+        callback(std::move(mappings));
+      });
+  PostMappingTasks(batch, task_runner, kMaxConcurrentMappingTasks);
+}
+
+}  // namespace fml
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FILE_MAPPING_BATCH_H_
+#define FLUTTER_FML_FILE_MAPPING_BATCH_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+
+using FileMappings = std::vector<std::unique_ptr<FileMapping>>;
+
+//------------------------------------------------------------------------------
+/// @brief      Opens and maps a batch of read-only files relative to
+///             |base_directory|, overlapping the blocking open and map calls
+///             of the files on the threads of |task_runner|.
+///
+///             The calling thread also maps files while it waits so that the
+///             call makes progress even if all the workers of |task_runner|
+///             are busy. It is therefore safe to call this on a worker of
+///             |task_runner|.
+///
+/// @param[in]  base_directory  The directory the paths are relative to.
+/// @param[in]  paths           The paths of the files to map.
+/// @param[in]  task_runner     A concurrent task runner. If null, the files
+///                             are mapped serially on the calling thread.
+///
+/// @return     The mappings in the order of |paths|. Files that could not be
+///             mapped, including directories, yield a nullptr entry.
+///
+FileMappings MapFilesInParallel(
+    const fml::UniqueFD& base_directory,
+    const std::vector<std::string>& paths,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
+//------------------------------------------------------------------------------
+/// @brief      The asynchronous variant of |MapFilesInParallel|. The base
+///             directory is duplicated so the caller does not need to keep
+///             it alive. |callback| is invoked exactly once on one of the
+///             threads of |task_runner|, or on the calling thread if
+///             |task_runner| is null or |paths| is empty.
+///
+void MapFilesAsync(const fml::UniqueFD& base_directory,
+                   std::vector<std::string> paths,
+                   const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                   std::function<void(FileMappings)> callback);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FILE_MAPPING_BATCH_H_
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file_mapping_batch.h"
+
+#include <string>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+class FileMappingBatchTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (size_t i = 0; i < kFileCount; i++) {
+      const std::string contents = "file" + std::to_string(i);
+      ASSERT_TRUE(fml::WriteAtomically(
+          directory_.fd(), GetFileName(i).c_str(),
+          fml::DataMapping(std::vector<uint8_t>(contents.begin(),
+                                                contents.end()))));
+    }
+  }
+
+  static std::string GetFileName(size_t index) {
+    return "file_" + std::to_string(index) + ".bin";
+  }
+
+  std::vector<std::string> GetPaths() const {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < kFileCount; i++) {
+      paths.push_back(GetFileName(i));
+    }
+    paths.push_back("does_not_exist.bin");
+    return paths;
+  }
+
+  static void CheckMappings(const FileMappings& mappings) {
+    ASSERT_EQ(mappings.size(), kFileCount + 1);
+    for (size_t i = 0; i < kFileCount; i++) {
+      ASSERT_NE(mappings[i], nullptr);
+      const std::string contents(
+          reinterpret_cast<const char*>(mappings[i]->GetMapping()),
+          mappings[i]->GetSize());
+      ASSERT_EQ(contents, "file" + std::to_string(i));
+    }
+    ASSERT_EQ(mappings.back(), nullptr);
+  }
+
+ protected:
+  static constexpr size_t kFileCount = 32;
+  fml::ScopedTemporaryDirectory directory_;
+};
+
+TEST_F(FileMappingBatchTest, MapsFilesSeriallyWithoutTaskRunner) {
+  CheckMappings(MapFilesInParallel(directory_.fd(), GetPaths(), nullptr));
+}
+
+TEST_F(FileMappingBatchTest, MapsFilesInParallel) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  CheckMappings(
+      MapFilesInParallel(directory_.fd(), GetPaths(), loop->GetTaskRunner()));
+}
+
+TEST_F(FileMappingBatchTest, CanMapFilesInParallelFromWorker) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&]() {
+    CheckMappings(MapFilesInParallel(directory_.fd(), GetPaths(), task_runner));
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST_F(FileMappingBatchTest, MapsFilesAsynchronously) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  fml::AutoResetWaitableEvent latch;
+  MapFilesAsync(directory_.fd(), GetPaths(), loop->GetTaskRunner(),
+                [&latch](FileMappings mappings) {
+                  CheckMappings(mappings);
+                  latch.Signal();
+                });
+  latch.Wait();
+}
+
+TEST_F(FileMappingBatchTest, AsyncCallbackIsInvokedForEmptyBatch) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  bool called = false;
+  MapFilesAsync(directory_.fd(), {}, loop->GetTaskRunner(),
+                [&called](FileMappings mappings) {
+                  ASSERT_TRUE(mappings.empty());
+                  called = true;
+                });
+  ASSERT_TRUE(called);
+}
+
+}  // namespace testing
+}  // namespace fml
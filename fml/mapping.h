@@ -32,6 +32,19 @@ class Mapping {
   // Generally true for file-mapped memory and false for anonymous memory.
   virtual bool IsDontNeedSafe() const = 0;
 
+  enum class Advice {
+    // The pages of the mapping will be needed soon and may be read ahead.
+    kWillNeed,
+    // The pages of the mapping won't be needed for a while and may be
+    // dropped. Only given for mappings where |IsDontNeedSafe| is true.
+    kDontNeed,
+  };
+
+  // Tells the OS how the pages of the mapping will be used, like madvise.
+  // Returns false if the advice wasn't given, for example because the
+  // platform doesn't support it or the mapping is empty.
+  bool Advise(Advice advice) const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -3,6 +3,11 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+
+#include <string>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
@@ -67,4 +72,31 @@ TEST(MallocMapping, CopySizeZero) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(Mapping, AdviseKeepsFileMappingContents) {
+  fml::ScopedTemporaryDirectory dir;
+  const std::string contents(1 << 16, 'f');
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "advise",
+                                   fml::DataMapping(contents)));
+  auto mapping = FileMapping::CreateReadOnly(dir.fd(), "advise");
+  ASSERT_TRUE(mapping);
+  ASSERT_TRUE(mapping->IsDontNeedSafe());
+
+#if FML_OS_WIN
+  EXPECT_FALSE(mapping->Advise(Mapping::Advice::kWillNeed));
+#else
+  EXPECT_TRUE(mapping->Advise(Mapping::Advice::kWillNeed));
+  EXPECT_TRUE(mapping->Advise(Mapping::Advice::kDontNeed));
+#endif  // FML_OS_WIN
+
+  ASSERT_EQ(contents.size(), mapping->GetSize());
+  EXPECT_EQ(0, memcmp(contents.data(), mapping->GetMapping(), contents.size()));
+}
+
+TEST(Mapping, AdviseDontNeedRequiresDontNeedSafeMapping) {
+  DataMapping mapping(std::string(1 << 16, 'f'));
+  ASSERT_FALSE(mapping.IsDontNeedSafe());
+  EXPECT_FALSE(mapping.Advise(Mapping::Advice::kDontNeed));
+  EXPECT_EQ('f', mapping.GetMapping()[0]);
+}
+
 }  // namespace fml
@@ -57,8 +57,8 @@ namespace fml {
 //     ...
 //   };
 //
-// For now, we only have thread-safe reference counting, since that's all we
-// need. It's easy enough to add thread-unsafe versions if necessary.
+// Objects that never leave the thread they were created on can use the cheaper
+// |RefCounted| below instead.
 template <typename T>
 class RefCountedThreadSafe : public internal::RefCountedThreadSafeBase {
  public:
@@ -121,11 +121,61 @@ class RefCountedThreadSafe : public internal::RefCountedThreadSafeBase {
   FML_DISALLOW_COPY_AND_ASSIGN(RefCountedThreadSafe);
 };
 
+// A base class for reference-counted classes that are only ever referenced from
+// the thread that created them. Retains and releases are plain increments and
+// decrements rather than atomic read-modify-write operations, which matters
+// for objects that are passed around by |RefPtr| very frequently. Debug builds
+// check that every reference is taken and dropped on the creation thread.
+//
+// This is a drop-in replacement for |RefCountedThreadSafe| and is used exactly
+// the same way, with |FML_FRIEND_REF_COUNTED()| in place of
+// |FML_FRIEND_REF_COUNTED_THREAD_SAFE()|:
+//
+//   class Foo : public RefCounted<Foo> {
+//     ...
+//    private:
+//     FML_FRIEND_REF_COUNTED(Foo);
+//     FML_FRIEND_MAKE_REF_COUNTED(Foo);
+//     Foo();
+//     ~Foo();
+//   };
+template <typename T>
+class RefCounted : public internal::RefCountedBase {
+ public:
+  // Releases a reference to this object. This will destroy this object once the
+  // last reference is released.
+  void Release() const {
+    if (internal::RefCountedBase::Release()) {
+      delete static_cast<const T*>(this);
+    }
+  }
+
+  // |AddRef()|, |HasOneRef()| and |AssertHasOneRef()| are inherited from the
+  // internal superclass and behave as they do for |RefCountedThreadSafe|.
+
+ protected:
+  RefCounted() {}
+
+  ~RefCounted() {}
+
+ private:
+#ifndef NDEBUG
+  template <typename U>
+  friend RefPtr<U> AdoptRef(U*);
+  void Adopt() { internal::RefCountedBase::Adopt(); }
+#endif
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RefCounted);
+};
+
 // If you subclass |RefCountedThreadSafe| and want to keep your destructor
 // private, use this. (See the example above |RefCountedThreadSafe|.)
 #define FML_FRIEND_REF_COUNTED_THREAD_SAFE(T) \
   friend class ::fml::RefCountedThreadSafe<T>
 
+// The |RefCounted| counterpart of |FML_FRIEND_REF_COUNTED_THREAD_SAFE()|.
+#define FML_FRIEND_REF_COUNTED(T) friend class ::fml::RefCounted<T>
+
 // If you want to keep your constructor(s) private and still want to use
 // |MakeRefCounted<T>()|, use this. (See the example above
 // |RefCountedThreadSafe|.)
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <vector>
+
+#include "flutter/fml/memory/ref_counted.h"
+
+namespace fml {
+
+namespace {
+
+class ThreadSafeObject : public RefCountedThreadSafe<ThreadSafeObject> {};
+
+class SingleThreadedObject : public RefCounted<SingleThreadedObject> {};
+
+}  // namespace
+
+template <class T>
+static void BM_RefPtrCopy(benchmark::State& state) {
+  RefPtr<T> object = MakeRefCounted<T>();
+  for (auto _ : state) {
+    RefPtr<T> copy = object;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefPtrCopy, ThreadSafeObject);
+BENCHMARK_TEMPLATE(BM_RefPtrCopy, SingleThreadedObject);
+
+// Mimics a list of references being copied, as happens when a display list
+// is recorded or an attribute is shared between many ops.
+template <class T>
+static void BM_RefPtrVectorCopy(benchmark::State& state) {
+  std::vector<RefPtr<T>> objects;
+  for (int i = 0; i < state.range(0); i++) {
+    objects.push_back(MakeRefCounted<T>());
+  }
+  for (auto _ : state) {
+    std::vector<RefPtr<T>> copy = objects;
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_RefPtrVectorCopy, ThreadSafeObject)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_RefPtrVectorCopy, SingleThreadedObject)
+    ->Arg(64)
+    ->Arg(1024);
+
+}  // namespace fml
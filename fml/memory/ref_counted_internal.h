@@ -8,9 +8,11 @@
 #define FLUTTER_FML_MEMORY_REF_COUNTED_INTERNAL_H_
 
 #include <atomic>
+#include <cstdint>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/thread_checker.h"
 
 namespace fml {
 namespace internal {
@@ -101,6 +103,83 @@ inline RefCountedThreadSafeBase::~RefCountedThreadSafeBase() {
 #endif
 }
 
+// See ref_counted.h for comments on the public methods.
+class RefCountedBase {
+ public:
+  void AddRef() const {
+#ifndef NDEBUG
+    FML_DCHECK(!adoption_required_);
+    FML_DCHECK(!destruction_started_);
+#endif
+    FML_DCHECK_CREATION_THREAD_IS_CURRENT(thread_checker_);
+    ref_count_++;
+  }
+
+  bool HasOneRef() const {
+    FML_DCHECK_CREATION_THREAD_IS_CURRENT(thread_checker_);
+    return ref_count_ == 1u;
+  }
+
+  void AssertHasOneRef() const { FML_DCHECK(HasOneRef()); }
+
+ protected:
+  RefCountedBase();
+  ~RefCountedBase();
+
+  // Returns true if the object should self-delete.
+  bool Release() const {
+#ifndef NDEBUG
+    FML_DCHECK(!adoption_required_);
+    FML_DCHECK(!destruction_started_);
+#endif
+    FML_DCHECK_CREATION_THREAD_IS_CURRENT(thread_checker_);
+    FML_DCHECK(ref_count_ != 0u);
+    if (--ref_count_ == 0u) {
+#ifndef NDEBUG
+      destruction_started_ = true;
+#endif
+      return true;
+    }
+    return false;
+  }
+
+#ifndef NDEBUG
+  void Adopt() {
+    FML_DCHECK(adoption_required_);
+    adoption_required_ = false;
+  }
+#endif
+
+ private:
+  mutable uint_fast32_t ref_count_;
+  FML_DECLARE_THREAD_CHECKER(thread_checker_);
+
+#ifndef NDEBUG
+  mutable bool adoption_required_ = false;
+  mutable bool destruction_started_ = false;
+#endif
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RefCountedBase);
+};
+
+inline RefCountedBase::RefCountedBase()
+    : ref_count_(1u)
+#ifndef NDEBUG
+      ,
+      adoption_required_(true),
+      destruction_started_(false)
+#endif
+{
+}
+
+inline RefCountedBase::~RefCountedBase() {
+#ifndef NDEBUG
+  FML_DCHECK(!adoption_required_);
+  // Should only be destroyed as a result of |Release()|.
+  FML_DCHECK(destruction_started_);
+#endif
+}
+
 }  // namespace internal
 }  // namespace fml
 
@@ -635,6 +635,43 @@ TEST(RefCountedTest, DebugChecks) {
 }
 #endif
 
+class MySingleThreadedClass : public RefCounted<MySingleThreadedClass> {
+ public:
+  static RefPtr<MySingleThreadedClass> Create(bool* was_destroyed) {
+    return AdoptRef(new MySingleThreadedClass(was_destroyed));
+  }
+
+ private:
+  FML_FRIEND_REF_COUNTED(MySingleThreadedClass);
+
+  explicit MySingleThreadedClass(bool* was_destroyed)
+      : was_destroyed_(was_destroyed) {}
+  ~MySingleThreadedClass() { *was_destroyed_ = true; }
+
+  bool* was_destroyed_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MySingleThreadedClass);
+};
+
+TEST(RefCountedTest, SingleThreadedRefCounting) {
+  bool was_destroyed = false;
+  {
+    RefPtr<MySingleThreadedClass> r1 =
+        MySingleThreadedClass::Create(&was_destroyed);
+    r1->AssertHasOneRef();
+    {
+      RefPtr<MySingleThreadedClass> r2 = r1;
+      EXPECT_FALSE(r1->HasOneRef());
+      RefPtr<MySingleThreadedClass> r3 = std::move(r2);
+      EXPECT_FALSE(r2);
+      EXPECT_EQ(r1.get(), r3.get());
+    }
+    EXPECT_TRUE(r1->HasOneRef());
+    EXPECT_FALSE(was_destroyed);
+  }
+  EXPECT_TRUE(was_destroyed);
+}
+
 // TODO(vtl): Add (threaded) stress tests.
 
 }  // namespace
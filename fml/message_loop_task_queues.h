@@ -36,6 +36,15 @@ class TaskQueueEntry {
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
 
+  /// Guards |task_source|. Submissions to different TaskQueues only contend
+  /// on the shared (read) side of the queue table lock, which lets producers
+  /// targeting different loops proceed in parallel.
+  ///
+  /// When the task sources of multiple entries need to be locked together
+  /// (merged queues), the locks are always acquired in ascending TaskQueueId
+  /// order.
+  std::mutex task_source_mutex;
+
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
   /// empty, this TaskQueue does not own any other TaskQueues.
   std::set<TaskQueueId> owner_of;
@@ -46,7 +55,7 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
-  explicit TaskQueueEntry(TaskQueueId created_for);
+  TaskQueueEntry(TaskQueueId created_for, DelayedTaskQueueType queue_type);
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueEntry);
@@ -61,6 +70,13 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Locking is two-level. The table of queue entries is guarded by a
+/// reader/writer lock that is only acquired exclusively when the table or
+/// the merge topology changes (queue creation and disposal, merging,
+/// observers and wakeables). Task submission and retrieval take the table
+/// lock in shared mode and then only lock the task sources of the queues
+/// involved.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -69,7 +85,11 @@ class MessageLoopTaskQueues {
 
   static MessageLoopTaskQueues* GetInstance();
 
-  TaskQueueId CreateTaskQueue();
+  /// Creates a new task queue. |queue_type| selects the data structure that
+  /// orders its pending tasks. Queues expected to hold many delayed tasks
+  /// (e.g. many Dart timers) may prefer |DelayedTaskQueueType::kTimerWheel|.
+  TaskQueueId CreateTaskQueue(
+      DelayedTaskQueueType queue_type = DelayedTaskQueueType::kBinaryHeap);
 
   void Dispose(TaskQueueId queue_id);
 
@@ -77,11 +97,16 @@ class MessageLoopTaskQueues {
 
   // Tasks methods.
 
-  void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
-                    fml::TimePoint target_time,
-                    fml::TaskSourceGrade task_source_grade =
-                        fml::TaskSourceGrade::kUnspecified);
+  /// Registers a task to run at |target_time|. Of the tasks that are due,
+  /// the ones with the highest |priority| run first.
+  /// \see fml::TaskPriority
+  void RegisterTask(
+      TaskQueueId queue_id,
+      const fml::closure& task,
+      fml::TimePoint target_time,
+      fml::TaskSourceGrade task_source_grade =
+          fml::TaskSourceGrade::kUnspecified,
+      fml::TaskPriority priority = fml::TaskPriority::kNormal);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
@@ -144,15 +169,22 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  using TaskSourceLocks = std::vector<std::unique_lock<std::mutex>>;
+
+  /// Locks the task sources of |owner| and all the queues it subsumes. The
+  /// queue table lock must be held.
+  TaskSourceLocks LockTaskSourcesUnlocked(TaskQueueId owner) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner,
+                                           fml::TimePoint now) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  std::unique_ptr<fml::SharedMutex> queue_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
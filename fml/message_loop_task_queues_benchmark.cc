@@ -4,6 +4,7 @@
 
 #include "flutter/fml/message_loop_task_queues.h"
 
+#include <atomic>
 #include <cassert>
 #include <string>
 #include <thread>
@@ -66,5 +67,135 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Measures task submission throughput with |state.range(0)| producer threads.
+// Producers are spread over a small number of task queues, mirroring the
+// platform, UI, raster and IO task runners of an engine, while one consumer
+// thread per queue drains the tasks as they arrive.
+static void BM_RegisterTasksConcurrently(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  const size_t num_producers = state.range(0);
+  const size_t num_task_queues = 4;
+  const size_t num_tasks_per_producer = 1000;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  std::vector<TaskQueueId> queue_ids;
+  for (size_t i = 0; i < num_task_queues; i++) {
+    queue_ids.push_back(task_queues->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    std::atomic_size_t tasks_remaining(num_producers * num_tasks_per_producer);
+    std::vector<std::thread> threads;
+
+    CountDownLatch producers_ready(num_producers);
+    for (size_t i = 0; i < num_producers; i++) {
+      threads.emplace_back([&, producer_index = i]() {
+        const auto queue_id = queue_ids[producer_index % num_task_queues];
+        producers_ready.CountDown();
+        producers_ready.Wait();
+        for (size_t j = 0; j < num_tasks_per_producer; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+        }
+      });
+    }
+
+    for (const auto& queue_id : queue_ids) {
+      threads.emplace_back([&, queue_id]() {
+        while (tasks_remaining.load() > 0) {
+          fml::closure invocation =
+              task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+          if (invocation) {
+            tasks_remaining.fetch_sub(1);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto& queue_id : queue_ids) {
+    task_queues->Dispose(queue_id);
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+BENCHMARK(BM_RegisterTasksConcurrently)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+// Measures registering and draining a backlog of tasks spread over
+// |state.range(0)| priorities, which is the cost of picking the next task
+// among that many task heaps.
+static void BM_RegisterAndGetTasksWithPriorities(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queues->CreateTaskQueue();
+  const size_t num_priorities = state.range(0);
+  const size_t num_tasks = 1000;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_tasks; i++) {
+      task_queues->RegisterTask(
+          queue_id, [] {}, past, fml::TaskSourceGrade::kUnspecified,
+          static_cast<fml::TaskPriority>(i % num_priorities));
+    }
+    const auto now = fml::TimePoint::Now();
+    size_t num_invocations = 0;
+    while (task_queues->GetNextTaskToRun(queue_id, now)) {
+      num_invocations++;
+    }
+    assert(num_invocations == num_tasks);
+  }
+
+  task_queues->Dispose(queue_id);
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+
+BENCHMARK(BM_RegisterAndGetTasksWithPriorities)
+    ->Arg(1)
+    ->Arg(fml::kTaskPriorityCount);
+
+// Measures how long an input task waits behind a backlog of |state.range(0)|
+// platform messages that are already due, which is the number of tasks that
+// run before it.
+static void BM_InputTaskBehindDueTasks(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queues->CreateTaskQueue();
+  const size_t num_tasks = state.range(0);
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  size_t tasks_run_before_input = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_tasks; i++) {
+      task_queues->RegisterTask(
+          queue_id, [] {}, past);
+    }
+    bool input_ran = false;
+    task_queues->RegisterTask(
+        queue_id, [&input_ran] { input_ran = true; }, fml::TimePoint::Now(),
+        fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kInput);
+    const auto now = fml::TimePoint::Now();
+    while (auto invocation = task_queues->GetNextTaskToRun(queue_id, now)) {
+      invocation();
+      if (!input_ran) {
+        tasks_run_before_input++;
+      }
+    }
+  }
+
+  task_queues->Dispose(queue_id);
+  state.counters["TasksRunBeforeInput"] = benchmark::Counter(
+      tasks_run_before_input, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_InputTaskBehindDueTasks)->Arg(100)->Arg(1000);
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -7,9 +7,11 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -413,6 +415,49 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks posted concurrently to merged task queues are all
+/// delivered to the owner while it is being drained.
+///
+TEST(MessageLoopTaskQueue, ConcurrentRegisterAndDrainOnMergedQueues) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto owner = task_queues->CreateTaskQueue();
+  auto subsumed = task_queues->CreateTaskQueue();
+  ASSERT_TRUE(task_queues->Merge(owner, subsumed));
+
+  constexpr size_t kThreadCount = 8;
+  constexpr size_t kThreadTaskCount = 250;
+
+  std::atomic_size_t tasks_run = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&, queue_id = (i % 2 == 0) ? owner : subsumed]() {
+      for (size_t j = 0; j < kThreadTaskCount; j++) {
+        task_queues->RegisterTask(
+            queue_id, [&tasks_run]() { tasks_run++; }, ChronoTicksSinceEpoch());
+      }
+    });
+  }
+
+  while (tasks_run < kThreadCount * kThreadTaskCount) {
+    auto invocation =
+        task_queues->GetNextTaskToRun(owner, ChronoTicksSinceEpoch());
+    if (invocation) {
+      invocation();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(tasks_run, kThreadCount * kThreadTaskCount);
+  ASSERT_FALSE(task_queues->HasPendingTasks(owner));
+  ASSERT_TRUE(task_queues->Unmerge(owner, subsumed));
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -451,5 +496,30 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, InputTasksRunBeforeDueTasksOfMergedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto ui_queue = task_queue->CreateTaskQueue();
+  ASSERT_TRUE(task_queue->Merge(platform_queue, ui_queue));
+
+  const auto time = ChronoTicksSinceEpoch();
+  std::vector<int> order;
+  for (int i = 0; i < 3; i++) {
+    task_queue->RegisterTask(
+        platform_queue, [&order] { order.push_back(0); }, time);
+  }
+  task_queue->RegisterTask(
+      ui_queue, [&order] { order.push_back(1); },
+      time + fml::TimeDelta::FromMilliseconds(1),
+      fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kInput);
+
+  const auto now = time + fml::TimeDelta::FromMilliseconds(2);
+  while (auto invocation = task_queue->GetNextTaskToRun(platform_queue, now)) {
+    invocation();
+  }
+  EXPECT_EQ(order, std::vector<int>({1, 0, 0, 0}));
+  ASSERT_TRUE(task_queue->Unmerge(platform_queue, ui_queue));
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -345,3 +345,75 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsAllTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  ASSERT_EQ(loop->GetSchedulingMode(),
+            fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 1000;
+  fml::CountDownLatch latch(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() { latch.CountDown(); });
+  }
+  latch.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopPostsToCurrentWorker) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      1u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  fml::CountDownLatch latch(kCount);
+  std::thread::id worker_id;
+  task_runner->PostTask([&]() {
+    worker_id = std::this_thread::get_id();
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTaskToCurrentWorker([&]() {
+        ASSERT_EQ(std::this_thread::get_id(), worker_id);
+        latch.CountDown();
+      });
+    }
+  });
+  latch.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopStealsLocalTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 4;
+  fml::CountDownLatch started(kCount);
+  fml::CountDownLatch latch(kCount);
+  // All tasks are posted to the deque of a single worker. Each task blocks
+  // until all of them have started, so this only completes if the other
+  // workers steal work.
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTaskToCurrentWorker([&]() {
+        started.CountDown();
+        started.Wait();
+        latch.CountDown();
+      });
+    }
+  });
+  latch.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopPostTaskToAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), loop->GetWorkerCount());
+}
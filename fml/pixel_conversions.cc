@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/pixel_conversions.h"
+
+#include <array>
+
+namespace fml {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+constexpr uint32_t kOpaque = 0xFF;
+
+// `value / 255`, rounded to the nearest integer, for `value` up to 255 * 255
+// without a division.
+inline uint32_t DivideBy255(uint32_t value) {
+  value += 128;
+  return (value + (value >> 8)) >> 8;
+}
+
+// `255 / alpha` in 16.16 fixed point, so that unpremultiplying is a multiply
+// instead of a division per channel. Rounded up, so that halves round up.
+constexpr std::array<uint32_t, 256> MakeUnpremultiplyScales() {
+  std::array<uint32_t, 256> scales = {};
+  for (uint32_t alpha = 1; alpha < 256; alpha++) {
+    scales[alpha] = ((kOpaque << 16) + alpha - 1) / alpha;
+  }
+  return scales;
+}
+
+constexpr std::array<uint32_t, 256> kUnpremultiplyScales =
+    MakeUnpremultiplyScales();
+
+}  // namespace
+
+void PremultiplyPixels8888(const uint8_t* src,
+                           uint8_t* dst,
+                           size_t pixel_count) {
+  const size_t byte_count = pixel_count * kBytesPerPixel;
+  for (size_t i = 0; i < byte_count; i += kBytesPerPixel) {
+    const uint32_t alpha = src[i + 3];
+    dst[i + 0] = DivideBy255(src[i + 0] * alpha);
+    dst[i + 1] = DivideBy255(src[i + 1] * alpha);
+    dst[i + 2] = DivideBy255(src[i + 2] * alpha);
+    dst[i + 3] = alpha;
+  }
+}
+
+void UnpremultiplyPixels8888(const uint8_t* src,
+                             uint8_t* dst,
+                             size_t pixel_count) {
+  const size_t byte_count = pixel_count * kBytesPerPixel;
+  for (size_t i = 0; i < byte_count; i += kBytesPerPixel) {
+    const uint32_t alpha = src[i + 3];
+    // Zero for transparent pixels.
+    const uint32_t scale = kUnpremultiplyScales[alpha];
+    for (size_t channel = 0; channel < 3; channel++) {
+      const uint32_t value = (src[i + channel] * scale + (1 << 15)) >> 16;
+      // Premultiplied colors can't be brighter than their alpha, but
+      // malformed ones would overflow.
+      dst[i + channel] = value < kOpaque ? value : kOpaque;
+    }
+    dst[i + 3] = alpha;
+  }
+}
+
+void SwapRedAndBlue8888(const uint8_t* src, uint8_t* dst, size_t pixel_count) {
+  const size_t byte_count = pixel_count * kBytesPerPixel;
+  for (size_t i = 0; i < byte_count; i += kBytesPerPixel) {
+    const uint8_t red = src[i + 0];
+    const uint8_t blue = src[i + 2];
+    dst[i + 0] = blue;
+    dst[i + 1] = src[i + 1];
+    dst[i + 2] = red;
+    dst[i + 3] = src[i + 3];
+  }
+}
+
+void BlendSrcOverPremul8888(const uint8_t* src,
+                            uint8_t* dst,
+                            size_t pixel_count) {
+  const size_t byte_count = pixel_count * kBytesPerPixel;
+  for (size_t i = 0; i < byte_count; i += kBytesPerPixel) {
+    const uint32_t inverse_alpha = kOpaque - src[i + 3];
+    for (size_t channel = 0; channel < kBytesPerPixel; channel++) {
+      dst[i + channel] =
+          src[i + channel] + DivideBy255(dst[i + channel] * inverse_alpha);
+    }
+  }
+}
+
+void ConvertGreyToRGBA8888(const uint8_t* src,
+                           uint8_t* dst,
+                           size_t pixel_count) {
+  for (size_t i = 0; i < pixel_count; i++) {
+    const uint8_t grey = src[i];
+    dst[i * kBytesPerPixel + 0] = grey;
+    dst[i * kBytesPerPixel + 1] = grey;
+    dst[i * kBytesPerPixel + 2] = grey;
+    dst[i * kBytesPerPixel + 3] = kOpaque;
+  }
+}
+
+void ConvertAlphaToRGBA8888(const uint8_t* src,
+                            uint8_t* dst,
+                            size_t pixel_count) {
+  for (size_t i = 0; i < pixel_count; i++) {
+    dst[i * kBytesPerPixel + 0] = kOpaque;
+    dst[i * kBytesPerPixel + 1] = kOpaque;
+    dst[i * kBytesPerPixel + 2] = kOpaque;
+    dst[i * kBytesPerPixel + 3] = src[i];
+  }
+}
+
+void ConvertRGBToRGBA8888(const uint8_t* src,
+                          uint8_t* dst,
+                          size_t pixel_count) {
+  for (size_t i = 0; i < pixel_count; i++) {
+    dst[i * kBytesPerPixel + 0] = src[i * 3 + 0];
+    dst[i * kBytesPerPixel + 1] = src[i * 3 + 1];
+    dst[i * kBytesPerPixel + 2] = src[i * 3 + 2];
+    dst[i * kBytesPerPixel + 3] = kOpaque;
+  }
+}
+
+}  // namespace fml
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PIXEL_CONVERSIONS_H_
+#define FLUTTER_FML_PIXEL_CONVERSIONS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// Conversions between 8 bit per channel pixel layouts.
+///
+/// Each one processes a row, or a whole image with tightly packed rows, at a
+/// time. The loops are branch free and work on a fixed number of bytes per
+/// pixel, so that the compiler vectorizes them for the SIMD instructions of
+/// the target (NEON, SSE).
+///
+/// The "8888" conversions apply to both RGBA and BGRA pixels, since they only
+/// care that alpha is the last byte. Unless noted otherwise, `src` and `dst`
+/// may be the same buffer.
+///
+
+/// Multiplies the color channels of each pixel by its alpha, rounding to the
+/// nearest value.
+void PremultiplyPixels8888(const uint8_t* src,
+                           uint8_t* dst,
+                           size_t pixel_count);
+
+/// Divides the color channels of each pixel by its alpha, rounding to the
+/// nearest value. Pixels with an alpha of zero become transparent black.
+void UnpremultiplyPixels8888(const uint8_t* src,
+                             uint8_t* dst,
+                             size_t pixel_count);
+
+/// Converts between RGBA and BGRA.
+void SwapRedAndBlue8888(const uint8_t* src, uint8_t* dst, size_t pixel_count);
+
+/// Composites premultiplied `src` pixels over premultiplied `dst` pixels.
+void BlendSrcOverPremul8888(const uint8_t* src,
+                            uint8_t* dst,
+                            size_t pixel_count);
+
+/// Expands single channel grey pixels into opaque RGBA pixels. `src` and `dst`
+/// must not overlap.
+void ConvertGreyToRGBA8888(const uint8_t* src,
+                           uint8_t* dst,
+                           size_t pixel_count);
+
+/// Expands alpha-only pixels into white RGBA pixels of that alpha. `src` and
+/// `dst` must not overlap.
+void ConvertAlphaToRGBA8888(const uint8_t* src,
+                            uint8_t* dst,
+                            size_t pixel_count);
+
+/// Expands RGB pixels into opaque RGBA pixels. `src` and `dst` must not
+/// overlap.
+void ConvertRGBToRGBA8888(const uint8_t* src,
+                          uint8_t* dst,
+                          size_t pixel_count);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PIXEL_CONVERSIONS_H_
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <vector>
+
+#include "flutter/fml/pixel_conversions.h"
+
+namespace fml {
+
+namespace {
+
+std::vector<uint8_t> MakePixels(size_t pixel_count) {
+  std::vector<uint8_t> pixels(pixel_count * 4);
+  for (size_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = static_cast<uint8_t>(i * 31);
+  }
+  return pixels;
+}
+
+// The per-pixel loop the kernels replace, for comparison.
+void PremultiplyPixelsWithDivision(const uint8_t* src,
+                                   uint8_t* dst,
+                                   size_t pixel_count) {
+  for (size_t i = 0; i < pixel_count * 4; i += 4) {
+    for (size_t channel = 0; channel < 3; channel++) {
+      dst[i + channel] = src[i + channel] * src[i + 3] / 255;
+    }
+    dst[i + 3] = src[i + 3];
+  }
+}
+
+}  // namespace
+
+static void BM_PremultiplyWithDivision(benchmark::State& state) {
+  std::vector<uint8_t> src = MakePixels(state.range(0));
+  std::vector<uint8_t> dst(src.size());
+  for (auto _ : state) {
+    PremultiplyPixelsWithDivision(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_PremultiplyWithDivision)->Arg(256)->Arg(1024 * 1024);
+
+static void BM_PremultiplyPixels8888(benchmark::State& state) {
+  std::vector<uint8_t> src = MakePixels(state.range(0));
+  std::vector<uint8_t> dst(src.size());
+  for (auto _ : state) {
+    PremultiplyPixels8888(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_PremultiplyPixels8888)->Arg(256)->Arg(1024 * 1024);
+
+static void BM_UnpremultiplyPixels8888(benchmark::State& state) {
+  std::vector<uint8_t> src = MakePixels(state.range(0));
+  std::vector<uint8_t> dst(src.size());
+  for (auto _ : state) {
+    UnpremultiplyPixels8888(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_UnpremultiplyPixels8888)->Arg(256)->Arg(1024 * 1024);
+
+static void BM_SwapRedAndBlue8888(benchmark::State& state) {
+  std::vector<uint8_t> src = MakePixels(state.range(0));
+  std::vector<uint8_t> dst(src.size());
+  for (auto _ : state) {
+    SwapRedAndBlue8888(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_SwapRedAndBlue8888)->Arg(256)->Arg(1024 * 1024);
+
+static void BM_BlendSrcOverPremul8888(benchmark::State& state) {
+  std::vector<uint8_t> src = MakePixels(state.range(0));
+  std::vector<uint8_t> dst = MakePixels(state.range(0));
+  for (auto _ : state) {
+    BlendSrcOverPremul8888(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_BlendSrcOverPremul8888)->Arg(256)->Arg(1024 * 1024);
+
+static void BM_ConvertRGBToRGBA8888(benchmark::State& state) {
+  std::vector<uint8_t> src(state.range(0) * 3, 0x80);
+  std::vector<uint8_t> dst(state.range(0) * 4);
+  for (auto _ : state) {
+    ConvertRGBToRGBA8888(src.data(), dst.data(), state.range(0));
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * dst.size());
+}
+BENCHMARK(BM_ConvertRGBToRGBA8888)->Arg(256)->Arg(1024 * 1024);
+
+}  // namespace fml
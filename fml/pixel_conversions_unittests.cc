@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/pixel_conversions.h"
+
+#include <cmath>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+TEST(PixelConversionsTest, PremultiplyRoundsToNearest) {
+  for (int alpha = 0; alpha < 256; alpha++) {
+    for (int value = 0; value < 256; value++) {
+      const uint8_t src[4] = {static_cast<uint8_t>(value), 0, 255,
+                              static_cast<uint8_t>(alpha)};
+      uint8_t dst[4];
+      PremultiplyPixels8888(src, dst, 1);
+      ASSERT_EQ(dst[0], std::lround(value * alpha / 255.0))
+          << value << " " << alpha;
+      ASSERT_EQ(dst[1], 0);
+      ASSERT_EQ(dst[2], alpha);
+      ASSERT_EQ(dst[3], alpha);
+    }
+  }
+}
+
+TEST(PixelConversionsTest, UnpremultiplyRoundsToNearest) {
+  for (int alpha = 0; alpha < 256; alpha++) {
+    for (int value = 0; value <= alpha; value++) {
+      const uint8_t src[4] = {static_cast<uint8_t>(value), 0,
+                              static_cast<uint8_t>(alpha),
+                              static_cast<uint8_t>(alpha)};
+      uint8_t dst[4];
+      UnpremultiplyPixels8888(src, dst, 1);
+      const long expected = alpha == 0 ? 0 : std::lround(value * 255.0 / alpha);
+      ASSERT_EQ(dst[0], expected) << value << " " << alpha;
+      ASSERT_EQ(dst[1], 0);
+      ASSERT_EQ(dst[2], alpha == 0 ? 0 : 255);
+      ASSERT_EQ(dst[3], alpha);
+    }
+  }
+}
+
+TEST(PixelConversionsTest, UnpremultiplyClampsMalformedPixels) {
+  const uint8_t src[4] = {200, 100, 0, 100};
+  uint8_t dst[4];
+  UnpremultiplyPixels8888(src, dst, 1);
+  EXPECT_EQ(dst[0], 255);
+  EXPECT_EQ(dst[1], 255);
+  EXPECT_EQ(dst[2], 0);
+}
+
+TEST(PixelConversionsTest, ConvertsInPlace) {
+  std::vector<uint8_t> pixels = {10, 20, 30, 255, 40, 50, 60, 0};
+  SwapRedAndBlue8888(pixels.data(), pixels.data(), 2);
+  EXPECT_EQ(pixels, (std::vector<uint8_t>{30, 20, 10, 255, 60, 50, 40, 0}));
+  PremultiplyPixels8888(pixels.data(), pixels.data(), 2);
+  EXPECT_EQ(pixels, (std::vector<uint8_t>{30, 20, 10, 255, 0, 0, 0, 0}));
+}
+
+TEST(PixelConversionsTest, BlendSrcOver) {
+  const uint8_t src[8] = {0, 0, 128, 128, 255, 0, 0, 255};
+  uint8_t dst[8] = {255, 255, 255, 255, 0, 255, 0, 255};
+  BlendSrcOverPremul8888(src, dst, 2);
+  const uint8_t expected[8] = {127, 127, 255, 255, 255, 0, 0, 255};
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(dst[i], expected[i]) << i;
+  }
+}
+
+TEST(PixelConversionsTest, ExpandsToRGBA) {
+  const uint8_t src[6] = {1, 2, 3, 4, 5, 6};
+  std::vector<uint8_t> dst(8);
+
+  ConvertGreyToRGBA8888(src, dst.data(), 2);
+  EXPECT_EQ(dst, (std::vector<uint8_t>{1, 1, 1, 255, 2, 2, 2, 255}));
+
+  ConvertAlphaToRGBA8888(src, dst.data(), 2);
+  EXPECT_EQ(dst, (std::vector<uint8_t>{255, 255, 255, 1, 255, 255, 255, 2}));
+
+  ConvertRGBToRGBA8888(src, dst.data(), 2);
+  EXPECT_EQ(dst, (std::vector<uint8_t>{1, 2, 3, 255, 4, 5, 6, 255}));
+}
+
+}  // namespace testing
+}  // namespace fml
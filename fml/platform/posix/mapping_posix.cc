@@ -50,6 +50,38 @@ Mapping::Mapping() = default;
 
 Mapping::~Mapping() = default;
 
+bool Mapping::Advise(Advice advice) const {
+  const uint8_t* mapping = GetMapping();
+  const size_t size = GetSize();
+  if (mapping == nullptr || size == 0) {
+    return false;
+  }
+  if (advice == Advice::kDontNeed && !IsDontNeedSafe()) {
+    return false;
+  }
+
+  // madvise takes page aligned ranges. Read ahead every page the mapping
+  // touches, but only drop the pages that lie entirely within it, since the
+  // pages at its ends may be shared with other data.
+  const uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(mapping);
+  const uintptr_t end = begin + size;
+  uintptr_t advise_begin = begin & ~(page_size - 1);
+  uintptr_t advise_end = (end + page_size - 1) & ~(page_size - 1);
+  if (advice == Advice::kDontNeed) {
+    advise_begin = (begin + page_size - 1) & ~(page_size - 1);
+    advise_end = end & ~(page_size - 1);
+  }
+  if (advise_end <= advise_begin) {
+    return false;
+  }
+
+  return ::madvise(reinterpret_cast<void*>(advise_begin),
+                   advise_end - advise_begin,
+                   advice == Advice::kWillNeed ? MADV_WILLNEED
+                                               : MADV_DONTNEED) == 0;
+}
+
 FileMapping::FileMapping(const fml::UniqueFD& handle,
                          std::initializer_list<Protection> protection) {
   if (!handle.is_valid()) {
@@ -20,6 +20,11 @@ Mapping::Mapping() = default;
 
 Mapping::~Mapping() = default;
 
+bool Mapping::Advise(Advice advice) const {
+  // Not supported on Windows.
+  return false;
+}
+
 static bool IsWritable(
     std::initializer_list<FileMapping::Protection> protection_flags) {
   for (auto protection : protection_flags) {
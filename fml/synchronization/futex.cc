@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/futex.h"
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#define FML_FUTEX_LINUX 1
+#elif defined(FML_OS_WIN)
+#define FML_FUTEX_WIN 1
+#else
+// Darwin only has a public wait-on-address API on recent OS versions and
+// needs the fallback on older ones.
+#define FML_FUTEX_FALLBACK 1
+#if defined(FML_OS_MACOSX) && __has_include(<os/os_sync_wait_on_address.h>)
+#define FML_FUTEX_DARWIN 1
+#endif
+#endif
+
+#if FML_FUTEX_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#endif
+
+#if FML_FUTEX_WIN
+#include <windows.h>
+
+#include <algorithm>
+#endif
+
+#if FML_FUTEX_DARWIN
+#include <os/os_sync_wait_on_address.h>
+#endif
+
+#if FML_FUTEX_FALLBACK
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace fml {
+
+namespace {
+
+#if FML_FUTEX_FALLBACK
+
+// Waiters on the same bucket share a condition variable, so wakes always
+// notify every waiter of the bucket and let them re-check their own word.
+struct ParkingBucket {
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+constexpr size_t kParkingBucketCount = 64;
+
+ParkingBucket& GetParkingBucket(const void* address) {
+  // Intentionally leaked to avoid static destructors.
+  static ParkingBucket* buckets = new ParkingBucket[kParkingBucketCount];
+  const auto key = reinterpret_cast<uintptr_t>(address);
+  return buckets[(key >> 4) % kParkingBucketCount];
+}
+
+void FallbackWait(const std::atomic<uint32_t>* address,
+                  uint32_t expected,
+                  TimeDelta timeout) {
+  ParkingBucket& bucket = GetParkingBucket(address);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  if (address->load(std::memory_order_acquire) != expected) {
+    return;
+  }
+  if (timeout == TimeDelta::Max()) {
+    bucket.cv.wait(lock);
+  } else {
+    bucket.cv.wait_for(lock,
+                       std::chrono::nanoseconds(timeout.ToNanoseconds()));
+  }
+}
+
+void FallbackWake(std::atomic<uint32_t>* address) {
+  ParkingBucket& bucket = GetParkingBucket(address);
+  {
+    // Taking the lock orders this wake after any waiter that already saw the
+    // old value and is about to block.
+    std::scoped_lock lock(bucket.mutex);
+  }
+  bucket.cv.notify_all();
+}
+
+#endif  // FML_FUTEX_FALLBACK
+
+}  // namespace
+
+void FutexWait(const std::atomic<uint32_t>* address,
+               uint32_t expected,
+               TimeDelta timeout) {
+  if (timeout <= TimeDelta::Zero()) {
+    return;
+  }
+#if FML_FUTEX_LINUX
+  struct timespec timespec = {};
+  struct timespec* timespec_ptr = nullptr;
+  if (timeout != TimeDelta::Max()) {
+    timespec = timeout.ToTimespec();
+    timespec_ptr = &timespec;
+  }
+  // EAGAIN, EINTR and ETIMEDOUT are all handled by the caller re-checking.
+  syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, timespec_ptr,
+          nullptr, 0);
+#elif FML_FUTEX_WIN
+  DWORD milliseconds = INFINITE;
+  if (timeout != TimeDelta::Max()) {
+    // Round up so that short timeouts do not turn into busy loops.
+    const int64_t rounded = (timeout.ToMicroseconds() + 999) / 1000;
+    milliseconds = static_cast<DWORD>(
+        std::min<int64_t>(rounded, static_cast<int64_t>(INFINITE - 1)));
+  }
+  ::WaitOnAddress(const_cast<std::atomic<uint32_t>*>(address), &expected,
+                  sizeof(expected), milliseconds);
+#else
+#if FML_FUTEX_DARWIN
+  if (__builtin_available(macOS 14.4, iOS 17.4, *)) {
+    void* word = const_cast<std::atomic<uint32_t>*>(address);
+    if (timeout == TimeDelta::Max()) {
+      os_sync_wait_on_address(word, expected, sizeof(expected),
+                              OS_SYNC_WAIT_ON_ADDRESS_NONE);
+    } else {
+      os_sync_wait_on_address_with_timeout(
+          word, expected, sizeof(expected), OS_SYNC_WAIT_ON_ADDRESS_NONE,
+          OS_CLOCK_MACH_ABSOLUTE_TIME, timeout.ToNanoseconds());
+    }
+    return;
+  }
+#endif  // FML_FUTEX_DARWIN
+  FallbackWait(address, expected, timeout);
+#endif
+}
+
+void FutexWakeOne(std::atomic<uint32_t>* address) {
+#if FML_FUTEX_LINUX
+  syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif FML_FUTEX_WIN
+  ::WakeByAddressSingle(address);
+#else
+#if FML_FUTEX_DARWIN
+  if (__builtin_available(macOS 14.4, iOS 17.4, *)) {
+    os_sync_wake_by_address_any(address, sizeof(uint32_t),
+                                OS_SYNC_WAKE_BY_ADDRESS_NONE);
+    return;
+  }
+#endif  // FML_FUTEX_DARWIN
+  FallbackWake(address);
+#endif
+}
+
+void FutexWakeAll(std::atomic<uint32_t>* address) {
+#if FML_FUTEX_LINUX
+  syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr,
+          0);
+#elif FML_FUTEX_WIN
+  ::WakeByAddressAll(address);
+#else
+#if FML_FUTEX_DARWIN
+  if (__builtin_available(macOS 14.4, iOS 17.4, *)) {
+    os_sync_wake_by_address_all(address, sizeof(uint32_t),
+                                OS_SYNC_WAKE_BY_ADDRESS_NONE);
+    return;
+  }
+#endif  // FML_FUTEX_DARWIN
+  FallbackWake(address);
+#endif
+}
+
+}  // namespace fml
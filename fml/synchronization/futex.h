@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
+#define FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Futex words must be plain 32 bit integers.");
+
+//------------------------------------------------------------------------------
+/// @brief      Blocks the calling thread as long as |*address| holds
+///             |expected|, for at most |timeout|.
+///
+///             This uses the operating system's wait-on-address primitive
+///             where one is available: futex on Linux and Android,
+///             WaitOnAddress on Windows and os_sync_wait_on_address on recent
+///             versions of macOS and iOS. Elsewhere it falls back to a small
+///             table of condition variables keyed by address.
+///
+///             The comparison and the transition to the blocked state are
+///             atomic with respect to |FutexWakeOne| and |FutexWakeAll|, so a
+///             wake that follows a change of |*address| is never lost.
+///             Spurious wakeups are possible. Callers must re-check their
+///             condition, and their deadline, in a loop.
+///
+void FutexWait(const std::atomic<uint32_t>* address,
+               uint32_t expected,
+               TimeDelta timeout = TimeDelta::Max());
+
+//------------------------------------------------------------------------------
+/// @brief      Wakes at least one thread blocked in |FutexWait| on |address|.
+///
+void FutexWakeOne(std::atomic<uint32_t>* address);
+
+//------------------------------------------------------------------------------
+/// @brief      Wakes all threads blocked in |FutexWait| on |address|.
+///
+void FutexWakeAll(std::atomic<uint32_t>* address);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_FUTEX_H_
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/futex.h"
+
+#include <thread>
+
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+TEST(FutexTest, ReturnsImmediatelyOnValueMismatch) {
+  std::atomic<uint32_t> word = 1u;
+  // Would block forever if the value was not compared.
+  FutexWait(&word, 0u);
+  EXPECT_EQ(word.load(), 1u);
+}
+
+TEST(FutexTest, TimesOut) {
+  std::atomic<uint32_t> word = 0u;
+  const TimePoint start = TimePoint::Now();
+  FutexWait(&word, 0u, TimeDelta::FromMilliseconds(10));
+  // Spurious wakeups are allowed, so only check the upper bound.
+  EXPECT_LT(TimePoint::Now() - start, TimeDelta::FromSeconds(5));
+}
+
+TEST(FutexTest, WakeAllUnblocksWaiters) {
+  std::atomic<uint32_t> word = 0u;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&word]() {
+      while (word.load() == 0u) {
+        FutexWait(&word, 0u);
+      }
+    });
+  }
+  word.store(1u);
+  FutexWakeAll(&word);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(word.load(), 1u);
+}
+
+TEST(FutexTest, WakeOneUnblocksAWaiter) {
+  std::atomic<uint32_t> word = 0u;
+  std::thread thread([&word]() {
+    while (word.load() == 0u) {
+      FutexWait(&word, 0u);
+    }
+  });
+  word.store(1u);
+  FutexWakeOne(&word);
+  thread.join();
+  EXPECT_EQ(word.load(), 1u);
+}
+
+}  // namespace
+}  // namespace fml
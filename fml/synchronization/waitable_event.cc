@@ -4,173 +4,214 @@
 
 #include "flutter/fml/synchronization/waitable_event.h"
 
-#include <cerrno>
-#include <ctime>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#include <immintrin.h>
+#endif
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/futex.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
-namespace fml {
+// Both events keep all of their state in a single word. An event is commonly
+// destroyed by its waiter as soon as |Wait()| returns, so |Signal()| must not
+// touch the event after the atomic operation that signals it. The only thing
+// it does afterwards is wake the address, which at worst spuriously wakes an
+// unrelated waiter if the memory has been reused. Waiters tolerate spurious
+// wakeups.
 
-// Waits with a timeout on |condition()|. Returns true on timeout, or false if
-// |condition()| ever returns true. |condition()| should have no side effects
-// (and will always be called with |*mutex| held).
-template <typename ConditionFn>
-bool WaitWithTimeoutImpl(std::unique_lock<std::mutex>* locker,
-                         std::condition_variable* cv,
-                         ConditionFn condition,
-                         TimeDelta timeout) {
-  FML_DCHECK(locker->owns_lock());
-
-  if (condition()) {
-    return false;
-  }
-
-  // We may get spurious wakeups.
-  TimeDelta wait_remaining = timeout;
-  TimePoint start = TimePoint::Now();
-  while (true) {
-    if (std::cv_status::timeout ==
-        cv->wait_for(*locker, std::chrono::nanoseconds(
-                                  wait_remaining.ToNanoseconds()))) {
-      return true;  // Definitely timed out.
-    }
+namespace fml {
 
-    // We may have been awoken.
-    if (condition()) {
-      return false;
-    }
+namespace {
+
+// The number of times a waiter re-checks the event before blocking in the
+// kernel. Handoffs between the UI and raster threads frequently complete
+// within this window, which saves the waiter a context switch and the
+// signaling thread a wake system call.
+constexpr int kSpinCount = 128;
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
 
-    // Or the wakeup may have been spurious.
-    TimePoint now = TimePoint::Now();
-    FML_DCHECK(now >= start);
-    TimeDelta elapsed = now - start;
-    // It's possible that we may have timed out anyway.
-    if (elapsed >= timeout) {
-      return true;
+// Spins until |done()| returns true. Returns false if it never did. Spinning
+// only helps if the signaling thread can make progress at the same time.
+template <typename DoneFn>
+bool SpinUntil(DoneFn done) {
+  static const bool should_spin = std::thread::hardware_concurrency() > 1;
+  if (should_spin) {
+    for (int i = 0; i < kSpinCount; i++) {
+      CpuRelax();
+      if (done()) {
+        return true;
+      }
     }
+  }
+  return false;
+}
 
-    // Otherwise, recalculate the amount that we have left to wait.
-    wait_remaining = timeout - elapsed;
+// Returns the time left until |timeout| expires, measured from |start|, or
+// |TimeDelta::Zero()| if it has.
+TimeDelta GetRemaining(TimePoint start, TimeDelta timeout) {
+  if (timeout == TimeDelta::Max()) {
+    return timeout;
   }
+  // We may get spurious wakeups, and may have timed out anyway.
+  const TimeDelta elapsed = TimePoint::Now() - start;
+  FML_DCHECK(elapsed >= TimeDelta::Zero());
+  return elapsed >= timeout ? TimeDelta::Zero() : timeout - elapsed;
 }
 
+}  // namespace
+
 // AutoResetWaitableEvent ------------------------------------------------------
 
+namespace {
+
+constexpr uint32_t kAutoResetSignaled = 1u;
+constexpr uint32_t kAutoResetWaiter = 2u;
+
+}  // namespace
+
 void AutoResetWaitableEvent::Signal() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = true;
-  cv_.notify_one();
+  if (state_.fetch_or(kAutoResetSignaled) >= kAutoResetWaiter) {
+    FutexWakeOne(&state_);
+  }
 }
 
 void AutoResetWaitableEvent::Reset() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = false;
+  state_.fetch_and(~kAutoResetSignaled);
 }
 
 void AutoResetWaitableEvent::Wait() {
-  std::unique_lock<std::mutex> locker(mutex_);
-  while (!signaled_) {
-    cv_.wait(locker);
-  }
-  signaled_ = false;
+  WaitWithTimeout(TimeDelta::Max());
 }
 
 bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  if (signaled_) {
-    signaled_ = false;
+  // Consumes the signal so that each |Signal()| unblocks exactly one |Wait()|.
+  auto try_consume = [this]() {
+    uint32_t state = state_.load();
+    return (state & kAutoResetSignaled) &&
+           state_.compare_exchange_strong(state, state & ~kAutoResetSignaled);
+  };
+  if (try_consume()) {
+    return false;
+  }
+  if (timeout <= TimeDelta::Zero()) {
+    return true;
+  }
+  if (SpinUntil(try_consume)) {
     return false;
   }
 
-  // We may get spurious wakeups.
-  TimeDelta wait_remaining = timeout;
-  TimePoint start = TimePoint::Now();
+  const TimePoint start = TimePoint::Now();
+  uint32_t state = state_.fetch_add(kAutoResetWaiter) + kAutoResetWaiter;
   while (true) {
-    if (std::cv_status::timeout ==
-        cv_.wait_for(
-            locker, std::chrono::nanoseconds(wait_remaining.ToNanoseconds()))) {
-      return true;  // Definitely timed out.
-    }
-
-    // We may have been awoken.
-    if (signaled_) {
-      break;
+    if (state & kAutoResetSignaled) {
+      // Consume the signal and stop counting as a waiter in one go.
+      if (state_.compare_exchange_weak(
+              state, (state & ~kAutoResetSignaled) - kAutoResetWaiter)) {
+        return false;
+      }
+      continue;
     }
-
-    // Or the wakeup may have been spurious.
-    TimePoint now = TimePoint::Now();
-    FML_DCHECK(now >= start);
-    TimeDelta elapsed = now - start;
-    // It's possible that we may have timed out anyway.
-    if (elapsed >= timeout) {
+    const TimeDelta remaining = GetRemaining(start, timeout);
+    if (remaining <= TimeDelta::Zero()) {
+      state_.fetch_sub(kAutoResetWaiter);
       return true;
     }
-
-    // Otherwise, recalculate the amount that we have left to wait.
-    wait_remaining = timeout - elapsed;
+    FutexWait(&state_, state, remaining);
+    state = state_.load();
   }
-
-  signaled_ = false;
-  return false;
 }
 
 bool AutoResetWaitableEvent::IsSignaledForTest() {
-  std::scoped_lock locker(mutex_);
-  return signaled_;
+  return state_.load() & kAutoResetSignaled;
 }
 
 // ManualResetWaitableEvent ----------------------------------------------------
 
+namespace {
+
+constexpr uint32_t kManualResetSignaled = 1u;
+constexpr uint32_t kManualResetHasWaiters = 2u;
+constexpr uint32_t kManualResetSignalCountShift = 2u;
+
+}  // namespace
+
 void ManualResetWaitableEvent::Signal() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = true;
-  signal_id_++;
-  cv_.notify_all();
+  uint32_t state = state_.load();
+  uint32_t signaled;
+  do {
+    signaled = ((state >> kManualResetSignalCountShift) + 1u)
+                   << kManualResetSignalCountShift |
+               kManualResetSignaled;
+  } while (!state_.compare_exchange_weak(state, signaled));
+  if (state & kManualResetHasWaiters) {
+    FutexWakeAll(&state_);
+  }
 }
 
 void ManualResetWaitableEvent::Reset() {
-  std::scoped_lock locker(mutex_);
-  signaled_ = false;
+  state_.fetch_and(~kManualResetSignaled);
 }
 
 void ManualResetWaitableEvent::Wait() {
-  std::unique_lock<std::mutex> locker(mutex_);
+  WaitWithTimeout(TimeDelta::Max());
+}
 
-  if (signaled_) {
-    return;
+bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  uint32_t state = state_.load();
+  if (state & kManualResetSignaled) {
+    return false;
+  }
+  if (timeout <= TimeDelta::Zero()) {
+    return true;
   }
 
-  auto last_signal_id = signal_id_;
-  do {
-    cv_.wait(locker);
-  } while (signal_id_ == last_signal_id);
-}
+  const uint32_t last_signal_count = state >> kManualResetSignalCountShift;
+  auto was_signaled = [&state, last_signal_count]() {
+    return (state >> kManualResetSignalCountShift) != last_signal_count;
+  };
+  if (SpinUntil([this, &state, &was_signaled]() {
+        state = state_.load();
+        return was_signaled();
+      })) {
+    return false;
+  }
 
-bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
-  std::unique_lock<std::mutex> locker(mutex_);
-
-  auto last_signal_id = signal_id_;
-  // Disable thread-safety analysis for the lambda: We could annotate it with
-  // |FML_EXCLUSIVE_LOCKS_REQUIRED(mutex_)|, but then the analyzer currently
-  // isn't able to figure out that |WaitWithTimeoutImpl()| calls it while
-  // holding |mutex_|.
-  bool rv = WaitWithTimeoutImpl(
-      &locker, &cv_,
-      [this, last_signal_id]() {
-        // Also check |signaled_| in case we're already signaled.
-        return signaled_ || signal_id_ != last_signal_id;
-      },
-      timeout);
-  FML_DCHECK(rv || signaled_ || signal_id_ != last_signal_id);
-  return rv;
+  const TimePoint start = TimePoint::Now();
+  while (true) {
+    state = state_.load();
+    if (was_signaled()) {
+      return false;
+    }
+    if (!(state & kManualResetHasWaiters)) {
+      if (!state_.compare_exchange_weak(state,
+                                        state | kManualResetHasWaiters)) {
+        continue;
+      }
+      state |= kManualResetHasWaiters;
+    }
+    const TimeDelta remaining = GetRemaining(start, timeout);
+    if (remaining <= TimeDelta::Zero()) {
+      // Leaving the waiters bit set only costs the next |Signal()| a wake.
+      return true;
+    }
+    FutexWait(&state_, state, remaining);
+  }
 }
 
 bool ManualResetWaitableEvent::IsSignaledForTest() {
-  std::scoped_lock locker(mutex_);
-  return signaled_;
+  return state_.load() & kManualResetSignaled;
 }
 
 }  // namespace fml
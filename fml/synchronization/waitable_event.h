@@ -10,7 +10,9 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
 #include "flutter/fml/macros.h"
@@ -38,8 +40,8 @@ class AutoResetWaitableEvent final {
   //   call to |Signal()|.
   // * A |Signal()|, followed by a |Reset()|, may cause *no* waiting thread to
   //   be unblocked.
-  // * We rely on pthreads's queueing for picking which waiting thread to
-  //   unblock, rather than enforcing FIFO ordering.
+  // * We rely on the operating system's queueing for picking which waiting
+  //   thread to unblock, rather than enforcing FIFO ordering.
   void Signal();
 
   // Put the event into the unsignaled state. Generally, this is not recommended
@@ -62,11 +64,11 @@ class AutoResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
-  std::condition_variable cv_;
-  std::mutex mutex_;
-
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
+  // The lowest bit is set while this event is in the signaled state. The
+  // remaining bits count the threads that are blocked, or about to block, on
+  // this word with |FutexWait()|, so that |Signal()| can skip the wake system
+  // call when nobody is waiting.
+  std::atomic<uint32_t> state_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -104,20 +106,16 @@ class ManualResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
-  std::condition_variable cv_;
-  std::mutex mutex_;
-
-  // True if this event is in the signaled state.
-  bool signaled_ = false;
-
-  // While |std::condition_variable::notify_all()| (|pthread_cond_broadcast()|)
-  // will wake all waiting threads, one has to deal with spurious wake-ups.
-  // Checking |signaled_| isn't sufficient, since another thread may have been
-  // awoken and (manually) reset |signaled_|. This is a counter that is
-  // incremented in |Signal()| before calling
-  // |std::condition_variable::notify_all()|. A waiting thread knows it was
-  // awoken if |signal_id_| is different from when it started waiting.
-  unsigned signal_id_ = 0u;
+  // The lowest bit is set while this event is in the signaled state. The next
+  // bit is set by threads before they block on this word with |FutexWait()|
+  // and cleared by |Signal()| when it wakes them. The remaining bits count
+  // calls to |Signal()|.
+  //
+  // Checking the signaled bit isn't sufficient for a waiter, since another
+  // thread may have (manually) reset the event right after it was signaled. A
+  // waiting thread knows it was awoken if the signal count is different from
+  // when it started waiting.
+  std::atomic<uint32_t> state_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <atomic>
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
+namespace fml {
+
+// Bounces a signal between two threads, like the UI and raster threads
+// handing a frame back and forth. Each iteration is one round trip, so the
+// time per iteration is twice the wake latency.
+static void BM_AutoResetWaitableEventPingPong(benchmark::State& state) {
+  AutoResetWaitableEvent ping;
+  AutoResetWaitableEvent pong;
+  std::atomic<bool> done = false;
+  std::thread thread([&]() {
+    while (true) {
+      ping.Wait();
+      if (done) {
+        return;
+      }
+      pong.Signal();
+    }
+  });
+  for (auto _ : state) {
+    ping.Signal();
+    pong.Wait();
+  }
+  done = true;
+  ping.Signal();
+  thread.join();
+}
+BENCHMARK(BM_AutoResetWaitableEventPingPong)->UseRealTime();
+
+static void BM_ManualResetWaitableEventPingPong(benchmark::State& state) {
+  ManualResetWaitableEvent ping;
+  ManualResetWaitableEvent pong;
+  std::atomic<bool> done = false;
+  std::thread thread([&]() {
+    while (true) {
+      ping.Wait();
+      ping.Reset();
+      if (done) {
+        return;
+      }
+      pong.Signal();
+    }
+  });
+  for (auto _ : state) {
+    ping.Signal();
+    pong.Wait();
+    pong.Reset();
+  }
+  done = true;
+  ping.Signal();
+  thread.join();
+}
+BENCHMARK(BM_ManualResetWaitableEventPingPong)->UseRealTime();
+
+// A latch released by another thread, as in a synchronous post to a task
+// runner.
+static void BM_CountDownLatchHandoff(benchmark::State& state) {
+  for (auto _ : state) {
+    CountDownLatch latch(1);
+    std::thread thread([&latch]() { latch.CountDown(); });
+    latch.Wait();
+    thread.join();
+  }
+}
+BENCHMARK(BM_CountDownLatchHandoff)->UseRealTime();
+
+static void BM_SignalWithoutWaiters(benchmark::State& state) {
+  AutoResetWaitableEvent event;
+  for (auto _ : state) {
+    event.Signal();
+    event.Wait();
+  }
+}
+BENCHMARK(BM_SignalWithoutWaiters);
+
+}  // namespace fml
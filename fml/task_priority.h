@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+#include <cstddef>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+/**
+ * How urgently a task dispatched by `MessageLoopTaskQueues` should run once
+ * its target time has passed. Of the tasks that are due, the ones with the
+ * highest priority run first, and tasks of the same priority run in the order
+ * of their target times.
+ *
+ * To keep a steady stream of urgent tasks from starving the others, a task
+ * that has been due for longer than the starvation limit of its priority runs
+ * before the tasks of all priorities that aren't starving.
+ */
+enum class TaskPriority {
+  /// Delivering input events, such as pointer data packets.
+  kInput,
+  /// Work that the next frame waits for, such as the vsync callbacks.
+  kFrameCritical,
+  /// The priority of tasks that don't specify one.
+  kNormal,
+  /// Work that is only useful when nothing else is due, such as telling the
+  /// Dart VM that it is idle.
+  kIdle,
+  /// Housekeeping that can be deferred the longest, such as reporting frame
+  /// timings.
+  kBackground,
+};
+
+constexpr size_t kTaskPriorityCount =
+    static_cast<size_t>(TaskPriority::kBackground) + 1;
+
+/// How long a task of the given priority may be due before it runs ahead of
+/// the tasks of higher priorities.
+constexpr fml::TimeDelta GetTaskStarvationLimit(TaskPriority priority) {
+  switch (priority) {
+    case TaskPriority::kInput:
+      return fml::TimeDelta::Max();
+    case TaskPriority::kFrameCritical:
+      return fml::TimeDelta::FromMilliseconds(50);
+    case TaskPriority::kNormal:
+      return fml::TimeDelta::FromMilliseconds(100);
+    case TaskPriority::kIdle:
+      return fml::TimeDelta::FromMilliseconds(500);
+    case TaskPriority::kBackground:
+      return fml::TimeDelta::FromSeconds(1);
+  }
+  return fml::TimeDelta::Max();
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
@@ -35,6 +35,17 @@ void TaskRunner::PostDelayedTask(const fml::closure& task,
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostTaskForTimeWithPriority(const fml::closure& task,
+                                             fml::TimePoint target_time,
+                                             fml::TaskPriority priority) {
+  loop_->PostTask(task, target_time, priority);
+}
+
+void TaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                      fml::TaskPriority priority) {
+  PostTaskForTimeWithPriority(task, fml::TimePoint::Now(), priority);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
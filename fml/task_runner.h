@@ -10,6 +10,7 @@
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
@@ -49,6 +50,19 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// tens of milliseconds.
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  /// Schedules \p task to be executed at \p target_time with the given \p
+  /// priority. Of the tasks that are due, the ones with the highest priority
+  /// run first.
+  /// \see fml::TaskPriority
+  virtual void PostTaskForTimeWithPriority(const fml::closure& task,
+                                           fml::TimePoint target_time,
+                                           fml::TaskPriority priority);
+
+  /// Schedules \p task to be executed as soon as possible with the given \p
+  /// priority.
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TaskPriority priority);
+
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
   virtual bool RunsTasksOnCurrentThread();
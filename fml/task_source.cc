@@ -6,52 +6,71 @@
 
 #include "flutter/fml/task_source.h"
 
+#include "flutter/fml/logging.h"
+
 namespace fml {
 
-TaskSource::TaskSource(TaskQueueId task_queue_id)
-    : task_queue_id_(task_queue_id) {}
+TaskSource::TaskSource(TaskQueueId task_queue_id,
+                       DelayedTaskQueueType queue_type)
+    : task_queue_id_(task_queue_id), queue_type_(queue_type) {}
 
 TaskSource::~TaskSource() {
   ShutDown();
 }
 
 void TaskSource::ShutDown() {
-  primary_task_queue_ = {};
-  secondary_task_queue_ = {};
+  for (auto& queue : primary_task_queues_) {
+    if (queue) {
+      queue->Clear();
+    }
+  }
+  for (auto& queue : secondary_task_queues_) {
+    if (queue) {
+      queue->Clear();
+    }
+  }
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
-  switch (task.GetTaskSourceGrade()) {
+TaskSource::TaskQueues& TaskSource::GetTaskQueues(TaskSourceGrade grade) {
+  switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
-      break;
+      return primary_task_queues_;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
-      break;
+      return primary_task_queues_;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
-      break;
+      return secondary_task_queues_;
   }
+  FML_UNREACHABLE();
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
-  switch (grade) {
-    case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
-    case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
-      break;
-    case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.pop();
-      break;
+void TaskSource::RegisterTask(const DelayedTask& task) {
+  auto& queue = GetTaskQueues(
+      task.GetTaskSourceGrade())[static_cast<size_t>(task.GetPriority())];
+  if (!queue) {
+    queue = DelayedTaskQueue::Create(queue_type_);
   }
+  queue->Push(task);
+}
+
+void TaskSource::PopTask(TaskSourceGrade grade, TaskPriority priority) {
+  const auto& queue = GetTaskQueues(grade)[static_cast<size_t>(priority)];
+  FML_DCHECK(queue);
+  queue->Pop();
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = 0;
+  for (const auto& queue : primary_task_queues_) {
+    if (queue) {
+      size += queue->Size();
+    }
+  }
   if (secondary_pause_requests_ == 0) {
-    size += secondary_task_queue_.size();
+    for (const auto& queue : secondary_task_queues_) {
+      if (queue) {
+        size += queue->Size();
+      }
+    }
   }
   return size;
 }
@@ -60,35 +79,30 @@ bool TaskSource::IsEmpty() const {
   return GetNumPendingTasks() == 0;
 }
 
-TaskSource::TopTask TaskSource::Top() const {
+TaskSource::TopTask TaskSource::Top(fml::TimePoint now) const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+  const DelayedTask* top = nullptr;
+  auto update_top = [&top, now](const TaskQueues& queues) {
+    for (const auto& queue : queues) {
+      if (queue && !queue->Empty() &&
+          (!top || queue->Top().RunsBefore(*top, now))) {
+        top = &queue->Top();
+      }
     }
+  };
+  update_top(primary_task_queues_);
+  if (secondary_pause_requests_ == 0) {
+    update_top(secondary_task_queues_);
   }
+  FML_CHECK(top);
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top,
+  };
+}
+
+TaskSource::TopTask TaskSource::Top() const {
+  return Top(fml::TimePoint::Now());
 }
 
 void TaskSource::PauseSecondary() {
@@ -5,7 +5,11 @@
 #ifndef FLUTTER_FML_TASK_SOURCE_H_
 #define FLUTTER_FML_TASK_SOURCE_H_
 
+#include <array>
+#include <memory>
+
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
 
@@ -20,6 +24,9 @@ class MessageLoopTaskQueues;
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
  * to.
  *
+ * Each heap is split by `TaskPriority`, so that the tasks that are due can be
+ * run in the order of their priorities rather than just their target times.
+ *
  * Registering Tasks
  * -----------------
  * The task dispatcher associates a task source with each `TaskQueueID`. When
@@ -39,8 +46,11 @@ class TaskSource {
     const DelayedTask& task;
   };
 
-  /// Construts a TaskSource with the given `task_queue_id`.
-  explicit TaskSource(TaskQueueId task_queue_id);
+  /// Construts a TaskSource with the given `task_queue_id`. The task heaps are
+  /// implemented by the data structure specified by `queue_type`.
+  explicit TaskSource(
+      TaskQueueId task_queue_id,
+      DelayedTaskQueueType queue_type = DelayedTaskQueueType::kBinaryHeap);
 
   ~TaskSource();
 
@@ -51,8 +61,10 @@ class TaskSource {
   /// `TaskSourceGrade` of the `DelayedTask`.
   void RegisterTask(const DelayedTask& task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and the
+  /// `TaskPriority`.
+  void PopTask(TaskSourceGrade grade,
+               TaskPriority priority = TaskPriority::kNormal);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -61,8 +73,12 @@ class TaskSource {
   /// Returns true if `GetNumPendingTasks` is zero.
   bool IsEmpty() const;
 
-  /// Returns the top task based on scheduled time, taking into account whether
+  /// Returns the task to run next at time `now`, taking into account whether
   /// the secondary heap has been paused or not.
+  /// \see DelayedTask::RunsBefore
+  TopTask Top(fml::TimePoint now) const;
+
+  /// Returns the task to run next at the current time.
   TopTask Top() const;
 
   /// Pause providing tasks from secondary task heap.
@@ -72,11 +88,19 @@ class TaskSource {
   void ResumeSecondary();
 
  private:
+  /// One task heap per priority, created when the first task of that
+  /// priority is registered.
+  using TaskQueues =
+      std::array<std::unique_ptr<fml::DelayedTaskQueue>, kTaskPriorityCount>;
+
   const fml::TaskQueueId task_queue_id_;
-  fml::DelayedTaskQueue primary_task_queue_;
-  fml::DelayedTaskQueue secondary_task_queue_;
+  const DelayedTaskQueueType queue_type_;
+  TaskQueues primary_task_queues_;
+  TaskQueues secondary_task_queues_;
   int secondary_pause_requests_ = 0;
 
+  TaskQueues& GetTaskQueues(TaskSourceGrade grade);
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
 };
 
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_source.h"
@@ -50,6 +51,28 @@ TEST(TaskSourceTests, SimpleOrdering) {
   ASSERT_EQ(value, 7);
 }
 
+TEST(TaskSourceTests, SimpleOrderingWithTimerWheel) {
+  TaskSource task_source =
+      TaskSource(TaskQueueId(1), DelayedTaskQueueType::kTimerWheel);
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromSeconds(1),
+                            TaskSourceGrade::kUnspecified});
+  task_source.RegisterTask(
+      {2, [&] { value = 1; }, time_stamp, TaskSourceGrade::kDartMicroTasks});
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 2u);
+  auto top_task = task_source.Top();
+  top_task.task.GetTask()();
+  task_source.PopTask(top_task.task.GetTaskSourceGrade());
+  ASSERT_EQ(value, 1);
+  auto second_task = task_source.Top();
+  second_task.task.GetTask()();
+  task_source.PopTask(second_task.task.GetTaskSourceGrade());
+  ASSERT_EQ(value, 7);
+  ASSERT_TRUE(task_source.IsEmpty());
+}
+
 TEST(TaskSourceTests, SimpleOrderingMultiTaskHeaps) {
   TaskSource task_source = TaskSource(TaskQueueId(1));
   auto time_stamp = ChronoTicksSinceEpoch();
@@ -97,5 +120,102 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, DueTasksRunInPriorityOrder) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  std::vector<int> order;
+  task_source.RegisterTask({1, [&] { order.push_back(1); }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kBackground});
+  task_source.RegisterTask({2, [&] { order.push_back(2); }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  task_source.RegisterTask({3, [&] { order.push_back(3); },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(2),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kInput});
+  task_source.RegisterTask({4, [&] { order.push_back(4); },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kDartMicroTasks,
+                            TaskPriority::kFrameCritical});
+
+  const auto now = time_stamp + fml::TimeDelta::FromMilliseconds(5);
+  while (!task_source.IsEmpty()) {
+    auto top_task = task_source.Top(now);
+    top_task.task.GetTask()();
+    task_source.PopTask(top_task.task.GetTaskSourceGrade(),
+                        top_task.task.GetPriority());
+  }
+  EXPECT_EQ(order, std::vector<int>({3, 4, 2, 1}));
+}
+
+TEST(TaskSourceTests, TasksThatAreNotDueDoNotDelayLowerPriorities) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromSeconds(1),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kInput});
+  task_source.RegisterTask({2, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kBackground});
+
+  auto top_task = task_source.Top(time_stamp);
+  top_task.task.GetTask()();
+  task_source.PopTask(top_task.task.GetTaskSourceGrade(),
+                      top_task.task.GetPriority());
+  ASSERT_EQ(value, 1);
+  // The input task is the one to wake up for.
+  EXPECT_EQ(task_source.Top(time_stamp).task.GetTargetTime(),
+            time_stamp + fml::TimeDelta::FromSeconds(1));
+}
+
+TEST(TaskSourceTests, StarvingTasksRunBeforeHigherPriorities) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  const auto limit = GetTaskStarvationLimit(TaskPriority::kBackground);
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kBackground});
+  task_source.RegisterTask({2, [&] { value = 7; }, time_stamp + limit,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kInput});
+
+  // Not starving yet.
+  EXPECT_EQ(task_source.Top(time_stamp + limit).task.GetPriority(),
+            TaskPriority::kInput);
+
+  const auto now = time_stamp + limit + fml::TimeDelta::FromMilliseconds(1);
+  auto starving_task = task_source.Top(now);
+  starving_task.task.GetTask()();
+  task_source.PopTask(starving_task.task.GetTaskSourceGrade(),
+                      starving_task.task.GetPriority());
+  ASSERT_EQ(value, 1);
+  task_source.Top(now).task.GetTask()();
+  ASSERT_EQ(value, 7);
+}
+
+TEST(TaskSourceTests, PausedSecondaryTasksDoNotRunRegardlessOfPriority) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kDartMicroTasks,
+                            TaskPriority::kInput});
+  task_source.RegisterTask({2, [] {}, time_stamp, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kBackground});
+
+  task_source.PauseSecondary();
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 1u);
+  EXPECT_EQ(task_source.Top(time_stamp).task.GetPriority(),
+            TaskPriority::kBackground);
+
+  task_source.ResumeSecondary();
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 2u);
+  EXPECT_EQ(task_source.Top(time_stamp).task.GetPriority(),
+            TaskPriority::kInput);
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -71,13 +71,16 @@ Thread::Thread(const std::string& name)
     : Thread(Thread::SetCurrentThreadName, ThreadConfig(name)) {}
 
 Thread::Thread(const ThreadConfigSetter& setter, const ThreadConfig& config)
-    : joined_(false) {
+    : affinity_(config.affinity), joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fml::RefPtr<fml::TaskRunner> runner;
 
   thread_ = std::make_unique<std::thread>(
       [&latch, &runner, setter, config]() -> void {
         setter(config);
+        if (config.affinity.has_value()) {
+          RequestAffinity(config.affinity.value());
+        }
         fml::MessageLoop::EnsureInitializedForCurrentThread();
         auto& loop = MessageLoop::GetCurrent();
         runner = loop.GetTaskRunner();
@@ -96,6 +99,14 @@ fml::RefPtr<fml::TaskRunner> Thread::GetTaskRunner() const {
   return task_runner_;
 }
 
+void Thread::ReapplyAffinity() {
+  if (!affinity_.has_value() || joined_) {
+    return;
+  }
+  task_runner_->PostTask(
+      [affinity = affinity_.value()]() { RequestAffinity(affinity); });
+}
+
 void Thread::Join() {
   if (joined_) {
     return;
@@ -8,9 +8,11 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -30,10 +32,13 @@ class Thread {
     RASTER,
   };
 
-  /// The ThreadConfig is the thread info include thread name, thread priority.
+  /// The ThreadConfig is the thread info include thread name, thread priority
+  /// and the class of cores the thread should be pinned to.
   struct ThreadConfig {
-    ThreadConfig(const std::string& name, ThreadPriority priority)
-        : name(name), priority(priority) {}
+    ThreadConfig(const std::string& name,
+                 ThreadPriority priority,
+                 std::optional<CpuAffinity> affinity = std::nullopt)
+        : name(name), priority(priority), affinity(affinity) {}
 
     explicit ThreadConfig(const std::string& name)
         : ThreadConfig(name, ThreadPriority::NORMAL) {}
@@ -42,6 +47,9 @@ class Thread {
 
     std::string name;
     ThreadPriority priority;
+    /// If set, the affinity is requested for the thread after the config
+    /// setter has run.
+    std::optional<CpuAffinity> affinity;
   };
 
   using ThreadConfigSetter = std::function<void(const ThreadConfig&)>;
@@ -57,11 +65,25 @@ class Thread {
 
   void Join();
 
+  /// The affinity requested for this thread by its config, if any.
+  std::optional<CpuAffinity> GetAffinity() const { return affinity_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asynchronously requests the affinity of the config again on
+  ///             the thread. The operating system may reset thread affinity
+  ///             masks, for example when it takes cores offline under
+  ///             thermal pressure. Does nothing if the config had no
+  ///             affinity.
+  ///
+  void ReapplyAffinity();
+
   static void SetCurrentThreadName(const ThreadConfig& config);
 
  private:
   std::unique_ptr<std::thread> thread_;
 
+  const std::optional<CpuAffinity> affinity_;
+
   fml::RefPtr<fml::TaskRunner> task_runner_;
 
   std::atomic_bool joined_;
@@ -37,6 +37,27 @@ TEST(Thread, HasARunningMessageLoop) {
   ASSERT_TRUE(done);
 }
 
+TEST(Thread, AffinityCreatedWithConfig) {
+  fml::Thread thread(fml::Thread::SetCurrentThreadName,
+                     fml::Thread::ThreadConfig(
+                         "Thread1", fml::Thread::ThreadPriority::RASTER,
+                         fml::CpuAffinity::kPerformance));
+  ASSERT_EQ(thread.GetAffinity(), fml::CpuAffinity::kPerformance);
+
+  // Reapplying is queued behind this task on the thread itself.
+  bool done = false;
+  thread.ReapplyAffinity();
+  thread.GetTaskRunner()->PostTask([&done]() { done = true; });
+  thread.Join();
+  ASSERT_TRUE(done);
+
+  // Reapplying after the thread is gone is a no-op.
+  thread.ReapplyAffinity();
+
+  fml::Thread unpinned;
+  ASSERT_FALSE(unpinned.GetAffinity().has_value());
+}
+
 #if FLUTTER_PTHREAD_SUPPORTED
 TEST(Thread, ThreadNameCreatedWithConfig) {
   const std::string name = "Thread1";
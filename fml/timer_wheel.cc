@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/timer_wheel.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+constexpr uint64_t kSlotMask = TimerWheelDelayedTaskQueue::kSlotsPerLevel - 1;
+
+constexpr uint64_t kMaxTick =
+    (uint64_t{1} << (TimerWheelDelayedTaskQueue::kBitsPerLevel *
+                     TimerWheelDelayedTaskQueue::kLevels)) -
+    2;
+
+size_t SlotIndex(uint64_t tick, size_t level) {
+  return (tick >> (level * TimerWheelDelayedTaskQueue::kBitsPerLevel)) &
+         kSlotMask;
+}
+
+// Index of the most significant set bit. |value| must not be zero.
+size_t HighestBit(uint64_t value) {
+  size_t bit = 0;
+  while (value >>= 1) {
+    bit++;
+  }
+  return bit;
+}
+
+// Index of the least significant set bit. |value| must not be zero.
+size_t LowestBit(uint64_t value) {
+  size_t bit = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    bit++;
+  }
+  return bit;
+}
+
+}  // namespace
+
+TimerWheelDelayedTaskQueue::TimerWheelDelayedTaskQueue() = default;
+
+TimerWheelDelayedTaskQueue::~TimerWheelDelayedTaskQueue() = default;
+
+uint64_t TimerWheelDelayedTaskQueue::TickForTime(fml::TimePoint time) {
+  const int64_t ticks = time.ToEpochDelta().ToNanoseconds() /
+                        kTickResolution.ToNanoseconds();
+  return std::clamp<int64_t>(ticks, 0, kMaxTick);
+}
+
+void TimerWheelDelayedTaskQueue::Push(const DelayedTask& task) {
+  Insert(task);
+  if (expired_.empty()) {
+    Advance();
+  }
+}
+
+void TimerWheelDelayedTaskQueue::Pop() {
+  FML_DCHECK(!expired_.empty());
+  expired_.pop();
+  if (expired_.empty()) {
+    Advance();
+  }
+}
+
+const DelayedTask& TimerWheelDelayedTaskQueue::Top() const {
+  FML_DCHECK(!expired_.empty());
+  return expired_.top();
+}
+
+size_t TimerWheelDelayedTaskQueue::Size() const {
+  return expired_.size() + wheel_size_;
+}
+
+void TimerWheelDelayedTaskQueue::Clear() {
+  expired_ = {};
+  for (auto& level : levels_) {
+    for (auto& slot : level.slots) {
+      slot.clear();
+    }
+    level.occupied = 0;
+  }
+  wheel_size_ = 0;
+}
+
+void TimerWheelDelayedTaskQueue::Insert(const DelayedTask& task) {
+  const uint64_t tick = TickForTime(task.GetTargetTime());
+  if (tick < cursor_) {
+    expired_.push(task);
+    return;
+  }
+
+  const uint64_t difference = tick ^ cursor_;
+  const size_t level =
+      difference == 0 ? 0 : HighestBit(difference) / kBitsPerLevel;
+  FML_DCHECK(level < kLevels);
+  const size_t index = SlotIndex(tick, level);
+  levels_[level].slots[index].push_back(task);
+  levels_[level].occupied |= uint64_t{1} << index;
+  wheel_size_++;
+}
+
+void TimerWheelDelayedTaskQueue::Advance() {
+  while (expired_.empty() && wheel_size_ > 0) {
+    // Level 0 slots each hold exactly one tick, expire the next occupied one.
+    const uint64_t pending_ticks =
+        levels_[0].occupied & (~uint64_t{0} << SlotIndex(cursor_, 0));
+    if (pending_ticks != 0) {
+      const size_t index = LowestBit(pending_ticks);
+      auto& slot = levels_[0].slots[index];
+      for (const auto& task : slot) {
+        expired_.push(task);
+      }
+      wheel_size_ -= slot.size();
+      slot.clear();
+      levels_[0].occupied &= ~(uint64_t{1} << index);
+      cursor_ = ((cursor_ & ~kSlotMask) | index) + 1;
+      Cascade();
+      continue;
+    }
+
+    // Otherwise jump to the start of the next occupied slot of the lowest
+    // level that has one and redistribute it.
+    bool found = false;
+    for (size_t level = 1; level < kLevels; level++) {
+      const size_t current = SlotIndex(cursor_, level);
+      if (current == kSlotMask) {
+        continue;
+      }
+      const uint64_t pending_slots =
+          levels_[level].occupied & (~uint64_t{0} << (current + 1));
+      if (pending_slots == 0) {
+        continue;
+      }
+      const size_t index = LowestBit(pending_slots);
+      const size_t shift = level * kBitsPerLevel;
+      const size_t prefix_shift = shift + kBitsPerLevel;
+      cursor_ = ((cursor_ >> prefix_shift) << prefix_shift) |
+                (uint64_t{index} << shift);
+      Cascade();
+      found = true;
+      break;
+    }
+    FML_DCHECK(found);
+    if (!found) {
+      return;
+    }
+  }
+}
+
+void TimerWheelDelayedTaskQueue::Cascade() {
+  for (size_t level = kLevels - 1; level > 0; level--) {
+    const size_t index = SlotIndex(cursor_, level);
+    const uint64_t bit = uint64_t{1} << index;
+    if ((levels_[level].occupied & bit) == 0) {
+      continue;
+    }
+    Slot slot;
+    std::swap(slot, levels_[level].slots[index]);
+    levels_[level].occupied &= ~bit;
+    wheel_size_ -= slot.size();
+    for (const auto& task : slot) {
+      Insert(task);
+    }
+  }
+}
+
+}  // namespace fml
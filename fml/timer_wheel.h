@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TIMER_WHEEL_H_
+#define FLUTTER_FML_TIMER_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+#include "flutter/fml/delayed_task.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// A |DelayedTaskQueue| backed by a hierarchical timing wheel.
+///
+/// Target times are quantized to ticks of |kTickResolution|. The wheel has
+/// |kLevels| levels of |kSlotsPerLevel| slots each, a slot at level `l`
+/// spanning `kSlotsPerLevel^l` ticks. A task is placed at the level of the
+/// most significant slot index in which its tick differs from the current
+/// position of the wheel, which makes insertion O(1). Finding the next
+/// occupied slot uses a per-level occupancy bitmap.
+///
+/// Tasks whose tick the wheel has reached are moved in bulk into a small
+/// binary heap. This heap preserves the exact target time and registration
+/// order of tasks within a tick, so the ordering is identical to that of
+/// |BinaryHeapDelayedTaskQueue|.
+class TimerWheelDelayedTaskQueue final : public DelayedTaskQueue {
+ public:
+  static constexpr fml::TimeDelta kTickResolution =
+      fml::TimeDelta::FromMilliseconds(1);
+  static constexpr size_t kBitsPerLevel = 6;
+  static constexpr size_t kSlotsPerLevel = 1u << kBitsPerLevel;
+  // 8 levels of 64 slots cover 2^48 ticks which is enough for
+  // |fml::TimePoint::Max()| at millisecond resolution.
+  static constexpr size_t kLevels = 8;
+
+  TimerWheelDelayedTaskQueue();
+
+  ~TimerWheelDelayedTaskQueue() override;
+
+  // |DelayedTaskQueue|
+  void Push(const DelayedTask& task) override;
+
+  // |DelayedTaskQueue|
+  void Pop() override;
+
+  // |DelayedTaskQueue|
+  const DelayedTask& Top() const override;
+
+  // |DelayedTaskQueue|
+  size_t Size() const override;
+
+  // |DelayedTaskQueue|
+  void Clear() override;
+
+ private:
+  using Slot = std::vector<DelayedTask>;
+
+  struct Level {
+    std::array<Slot, kSlotsPerLevel> slots;
+    uint64_t occupied = 0;
+  };
+
+  // Tasks whose tick is before |cursor_|. Every task in here is ordered
+  // before every task still in the wheel.
+  std::priority_queue<DelayedTask,
+                      std::deque<DelayedTask>,
+                      std::greater<DelayedTask>>
+      expired_;
+  std::array<Level, kLevels> levels_;
+  uint64_t cursor_ = 0;
+  size_t wheel_size_ = 0;
+
+  static uint64_t TickForTime(fml::TimePoint time);
+
+  void Insert(const DelayedTask& task);
+
+  /// Moves the wheel forward until at least one task has expired, if there
+  /// are any tasks left in the wheel.
+  void Advance();
+
+  /// Redistributes the slots that |cursor_| has just moved into to the lower
+  /// levels of the wheel.
+  void Cascade();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TimerWheelDelayedTaskQueue);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TIMER_WHEEL_H_
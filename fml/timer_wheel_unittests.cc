@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/timer_wheel.h"
+
+#include <random>
+
+#include "flutter/fml/time/chrono_timestamp_provider.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+DelayedTask MakeTask(size_t order, fml::TimePoint target_time) {
+  return {order, [] {}, target_time, TaskSourceGrade::kUnspecified};
+}
+
+void ExpectSameTask(const DelayedTask& a, const DelayedTask& b) {
+  EXPECT_EQ(a.GetTargetTime(), b.GetTargetTime());
+  EXPECT_FALSE(a > b);
+  EXPECT_FALSE(b > a);
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, StartsEmpty) {
+  TimerWheelDelayedTaskQueue wheel;
+  ASSERT_TRUE(wheel.Empty());
+  ASSERT_EQ(wheel.Size(), 0u);
+}
+
+TEST(TimerWheelTest, OrdersByTargetTimeThenOrder) {
+  TimerWheelDelayedTaskQueue wheel;
+  const auto now = ChronoTicksSinceEpoch();
+  wheel.Push(MakeTask(1, now + fml::TimeDelta::FromSeconds(10)));
+  wheel.Push(MakeTask(2, now + fml::TimeDelta::FromMicroseconds(10)));
+  wheel.Push(MakeTask(3, now));
+  wheel.Push(MakeTask(4, now + fml::TimeDelta::FromMicroseconds(10)));
+  ASSERT_EQ(wheel.Size(), 4u);
+
+  ExpectSameTask(wheel.Top(), MakeTask(3, now));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(),
+                 MakeTask(2, now + fml::TimeDelta::FromMicroseconds(10)));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(),
+                 MakeTask(4, now + fml::TimeDelta::FromMicroseconds(10)));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(),
+                 MakeTask(1, now + fml::TimeDelta::FromSeconds(10)));
+  wheel.Pop();
+  ASSERT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, AcceptsTasksBeforeTheCurrentPosition) {
+  TimerWheelDelayedTaskQueue wheel;
+  const auto now = ChronoTicksSinceEpoch();
+  wheel.Push(MakeTask(1, now + fml::TimeDelta::FromSeconds(1)));
+  wheel.Push(MakeTask(2, now));
+  ExpectSameTask(wheel.Top(), MakeTask(2, now));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(),
+                 MakeTask(1, now + fml::TimeDelta::FromSeconds(1)));
+}
+
+TEST(TimerWheelTest, HandlesExtremeTargetTimes) {
+  TimerWheelDelayedTaskQueue wheel;
+  wheel.Push(MakeTask(1, fml::TimePoint::Max()));
+  wheel.Push(MakeTask(2, fml::TimePoint::Min()));
+  wheel.Push(MakeTask(3, fml::TimePoint()));
+  ExpectSameTask(wheel.Top(), MakeTask(2, fml::TimePoint::Min()));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(), MakeTask(3, fml::TimePoint()));
+  wheel.Pop();
+  ExpectSameTask(wheel.Top(), MakeTask(1, fml::TimePoint::Max()));
+  wheel.Pop();
+  ASSERT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, ClearDropsAllTasks) {
+  TimerWheelDelayedTaskQueue wheel;
+  const auto now = ChronoTicksSinceEpoch();
+  for (size_t i = 0; i < 100; i++) {
+    wheel.Push(MakeTask(i, now + fml::TimeDelta::FromMilliseconds(i * 7)));
+  }
+  wheel.Clear();
+  ASSERT_TRUE(wheel.Empty());
+  wheel.Push(MakeTask(100, now));
+  ExpectSameTask(wheel.Top(), MakeTask(100, now));
+}
+
+TEST(TimerWheelTest, MatchesBinaryHeapOrdering) {
+  TimerWheelDelayedTaskQueue wheel;
+  BinaryHeapDelayedTaskQueue heap;
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int64_t> delay_in_us(0, 20'000'000);
+  std::uniform_int_distribution<int> action(0, 2);
+
+  const auto now = ChronoTicksSinceEpoch();
+  size_t order = 0;
+  for (size_t i = 0; i < 20'000; i++) {
+    if (action(generator) == 0 && !heap.Empty()) {
+      ExpectSameTask(wheel.Top(), heap.Top());
+      wheel.Pop();
+      heap.Pop();
+    } else {
+      // Target times are relative to the most recently popped task so that
+      // new tasks land both before and after the position of the wheel.
+      auto base = heap.Empty() ? now : heap.Top().GetTargetTime();
+      auto task = MakeTask(
+          order++, base + fml::TimeDelta::FromMicroseconds(
+                              delay_in_us(generator) - 1'000'000));
+      wheel.Push(task);
+      heap.Push(task);
+    }
+    ASSERT_EQ(wheel.Size(), heap.Size());
+  }
+
+  while (!heap.Empty()) {
+    ExpectSameTask(wheel.Top(), heap.Top());
+    wheel.Pop();
+    heap.Pop();
+  }
+  ASSERT_TRUE(wheel.Empty());
+}
+
+}  // namespace testing
+}  // namespace fml
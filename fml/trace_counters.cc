@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_counters.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+struct CounterRegistry {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<PerformanceCounter>> counters;
+};
+
+// Leaked so that counters stay valid while the process exits.
+CounterRegistry& GetCounterRegistry() {
+  static CounterRegistry* registry = new CounterRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+PerformanceCounter::PerformanceCounter(std::string name)
+    : name_(std::move(name)) {}
+
+PerformanceCounter& PerformanceCounter::Get(const std::string& name) {
+  auto& registry = GetCounterRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto& counter = registry.counters[name];
+  if (!counter) {
+    counter.reset(new PerformanceCounter(name));
+  }
+  return *counter;
+}
+
+std::vector<PerformanceCounterValue> PerformanceCountersDump() {
+  auto& registry = GetCounterRegistry();
+  std::scoped_lock lock(registry.mutex);
+  std::vector<PerformanceCounterValue> values;
+  values.reserve(registry.counters.size());
+  for (const auto& [name, counter] : registry.counters) {
+    values.push_back({.name = name, .value = counter->GetValue()});
+  }
+  return values;
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_COUNTERS_H_
+#define FLUTTER_FML_TRACE_COUNTERS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// Process wide counters of engine work, such as draw calls or bytes uploaded
+/// to textures, that can be read at any time via |PerformanceCountersDump|.
+/// Like the flight recorder, they don't depend on a timeline recorder being
+/// attached and are available in release builds.
+///
+/// Counters are created on first use and never go away. Adding to a counter
+/// doesn't take any locks or allocate. Use |FML_PERFORMANCE_COUNTER_ADD| so
+/// that each call site only looks its counter up once.
+///
+class PerformanceCounter {
+ public:
+  /// Returns the counter with the given name, creating it if needed.
+  static PerformanceCounter& Get(const std::string& name);
+
+  void Add(uint64_t value) {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+  const std::string& GetName() const { return name_; }
+
+ private:
+  const std::string name_;
+  std::atomic<uint64_t> value_ = 0;
+
+  explicit PerformanceCounter(std::string name);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PerformanceCounter);
+};
+
+struct PerformanceCounterValue {
+  std::string name;
+  uint64_t value = 0;
+};
+
+/// The current values of all counters that have been used, sorted by name.
+std::vector<PerformanceCounterValue> PerformanceCountersDump();
+
+}  // namespace tracing
+}  // namespace fml
+
+#define FML_PERFORMANCE_COUNTER_ADD(name, value)                          \
+  do {                                                                    \
+    static ::fml::tracing::PerformanceCounter& fml_performance_counter =  \
+        ::fml::tracing::PerformanceCounter::Get(name);                    \
+    fml_performance_counter.Add(value);                                   \
+  } while (0)
+
+#endif  // FLUTTER_FML_TRACE_COUNTERS_H_
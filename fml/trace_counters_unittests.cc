@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_counters.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+static uint64_t GetDumpedValue(const std::string& name) {
+  for (const auto& counter : PerformanceCountersDump()) {
+    if (counter.name == name) {
+      return counter.value;
+    }
+  }
+  return 0;
+}
+
+TEST(PerformanceCountersTest, CountersWithTheSameNameAreShared) {
+  auto& counter = PerformanceCounter::Get("test.shared");
+  const uint64_t initial = counter.GetValue();
+  counter.Add(2);
+  PerformanceCounter::Get("test.shared").Add(3);
+  EXPECT_EQ(&counter, &PerformanceCounter::Get("test.shared"));
+  EXPECT_EQ(counter.GetValue(), initial + 5);
+  EXPECT_EQ(GetDumpedValue("test.shared"), initial + 5);
+}
+
+TEST(PerformanceCountersTest, CountsAddsFromAllThreads) {
+  const uint64_t initial = GetDumpedValue("test.threads");
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; j++) {
+        FML_PERFORMANCE_COUNTER_ADD("test.threads", 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(GetDumpedValue("test.threads"), initial + 4000);
+}
+
+TEST(PerformanceCountersTest, DumpIsSortedByName) {
+  FML_PERFORMANCE_COUNTER_ADD("test.b", 1);
+  FML_PERFORMANCE_COUNTER_ADD("test.a", 1);
+  auto dump = PerformanceCountersDump();
+  for (size_t i = 1; i < dump.size(); i++) {
+    EXPECT_LT(dump[i - 1].name, dump[i].name);
+  }
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
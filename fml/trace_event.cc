@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_flight_recorder.h"
 
 namespace fml {
 namespace tracing {
@@ -126,6 +127,7 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
+  FlightRecorderRecordBegin(name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -144,6 +146,7 @@ void TraceEvent1(TraceArg category_group,
                  const uint64_t* flow_ids,
                  TraceArg arg1_name,
                  TraceArg arg1_val) {
+  FlightRecorderRecordBegin(name);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -166,6 +169,7 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
                  TraceArg arg2_val) {
+  FlightRecorderRecordBegin(name);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -181,6 +185,7 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  FlightRecorderRecordEnd(name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                        // timestamp1_or_async_id
@@ -408,14 +413,18 @@ void TraceTimelineEvent(TraceArg category_group,
 void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
-                 const uint64_t* flow_ids) {}
+                 const uint64_t* flow_ids) {
+  FlightRecorderRecordBegin(name);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  FlightRecorderRecordBegin(name);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
@@ -424,9 +433,13 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  FlightRecorderRecordBegin(name);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  FlightRecorderRecordEnd(name);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
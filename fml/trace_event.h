@@ -61,6 +61,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_flight_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -327,6 +328,7 @@ void TraceEvent(TraceArg category,
                 size_t flow_id_count,
                 const uint64_t* flow_ids,
                 Args... args) {
+  FlightRecorderRecordBegin(name);
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
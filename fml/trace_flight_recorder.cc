@@ -0,0 +1,214 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+static_assert((kFlightRecorderCapacity & (kFlightRecorderCapacity - 1)) == 0,
+              "The capacity must be a power of two.");
+
+// The number of buffers of exited threads that are retained for dumps.
+constexpr size_t kMaxExitedThreadBuffers = 16;
+
+class ThreadBuffer {
+ public:
+  explicit ThreadBuffer(uint64_t thread_id) : thread_id_(thread_id) {}
+
+  void Record(FlightRecorderEventType type, const char* name) {
+    const size_t index = write_index_.load(std::memory_order_relaxed);
+    auto& event = events_[index & (kFlightRecorderCapacity - 1)];
+    event.timestamp_nanos =
+        fml::TimePoint::Now().ToEpochDelta().ToNanoseconds();
+    event.type = type;
+    size_t length = 0;
+    if (name) {
+      for (; length < FlightRecorderEvent::kMaxNameLength && name[length];
+           length++) {
+        event.name[length] = name[length];
+      }
+    }
+    event.name[length] = '\0';
+    write_index_.store(index + 1, std::memory_order_release);
+  }
+
+  FlightRecorderThreadEvents Dump() const {
+    FlightRecorderThreadEvents dump;
+    dump.thread_id = thread_id_;
+    dump.thread_exited = exited_.load(std::memory_order_relaxed);
+
+    const size_t end = write_index_.load(std::memory_order_acquire);
+    const size_t begin =
+        end > kFlightRecorderCapacity ? end - kFlightRecorderCapacity : 0;
+    std::vector<FlightRecorderEvent> events;
+    events.reserve(end - begin);
+    for (size_t i = begin; i < end; i++) {
+      events.push_back(events_[i & (kFlightRecorderCapacity - 1)]);
+    }
+
+    // While copying, the thread may have wrapped around and overwritten the
+    // oldest events, including the one it may be writing right now.
+    const size_t end_after_copy = write_index_.load(std::memory_order_acquire);
+    size_t valid_begin = begin;
+    if (end_after_copy + 1 > kFlightRecorderCapacity) {
+      valid_begin = std::max(valid_begin,
+                             end_after_copy + 1 - kFlightRecorderCapacity);
+    }
+    if (valid_begin >= end) {
+      return dump;
+    }
+    dump.events.assign(events.begin() + (valid_begin - begin), events.end());
+    return dump;
+  }
+
+  void MarkExited() { exited_.store(true, std::memory_order_relaxed); }
+
+  bool HasExited() const { return exited_.load(std::memory_order_relaxed); }
+
+ private:
+  const uint64_t thread_id_;
+  std::array<FlightRecorderEvent, kFlightRecorderCapacity> events_;
+  std::atomic_size_t write_index_ = 0;
+  std::atomic_bool exited_ = false;
+};
+
+// Keeps track of the buffers of all threads so that they can be dumped.
+// Only accessed when a thread records its first event and on dumps.
+class BufferRegistry {
+ public:
+  std::shared_ptr<ThreadBuffer> Register() {
+    std::scoped_lock lock(mutex_);
+    auto buffer = std::make_shared<ThreadBuffer>(++last_thread_id_);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  void Unregister(const std::shared_ptr<ThreadBuffer>& buffer) {
+    std::scoped_lock lock(mutex_);
+    buffer->MarkExited();
+    size_t exited_count = 0;
+    for (const auto& other : buffers_) {
+      exited_count += other->HasExited() ? 1 : 0;
+    }
+    // Evict the oldest exited buffers.
+    for (auto it = buffers_.begin();
+         it != buffers_.end() && exited_count > kMaxExitedThreadBuffers;) {
+      if ((*it)->HasExited()) {
+        it = buffers_.erase(it);
+        exited_count--;
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  std::vector<FlightRecorderThreadEvents> Dump() {
+    std::scoped_lock lock(mutex_);
+    std::vector<FlightRecorderThreadEvents> dump;
+    dump.reserve(buffers_.size());
+    for (const auto& buffer : buffers_) {
+      dump.emplace_back(buffer->Dump());
+    }
+    return dump;
+  }
+
+  void Reset() {
+    std::scoped_lock lock(mutex_);
+    generation_++;
+    buffers_.clear();
+  }
+
+  size_t GetGeneration() const { return generation_.load(); }
+
+ private:
+  std::mutex mutex_;
+  std::deque<std::shared_ptr<ThreadBuffer>> buffers_;
+  uint64_t last_thread_id_ = 0;
+  std::atomic_size_t generation_ = 0;
+};
+
+BufferRegistry& GetRegistry() {
+  // Intentionally leaked since threads may record events during shutdown.
+  static BufferRegistry* registry = new BufferRegistry();
+  return *registry;
+}
+
+// Owns the ring buffer of the current thread and retires it from the
+// registry when the thread exits.
+class ThreadBufferHolder {
+ public:
+  ThreadBufferHolder()
+      : buffer_(GetRegistry().Register()),
+        generation_(GetRegistry().GetGeneration()) {}
+
+  ~ThreadBufferHolder() { GetRegistry().Unregister(buffer_); }
+
+  ThreadBuffer& GetBuffer() { return *buffer_; }
+
+  bool IsCurrent() const {
+    return generation_ == GetRegistry().GetGeneration();
+  }
+
+ private:
+  std::shared_ptr<ThreadBuffer> buffer_;
+  const size_t generation_;
+};
+
+std::atomic_bool gFlightRecorderEnabled = false;
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadBufferHolder> tls_buffer;
+
+void Record(FlightRecorderEventType type, const char* name) {
+  if (!gFlightRecorderEnabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto* holder = tls_buffer.get();
+  if (!holder || !holder->IsCurrent()) {
+    holder = new ThreadBufferHolder();
+    tls_buffer.reset(holder);
+  }
+  holder->GetBuffer().Record(type, name);
+}
+
+}  // namespace
+
+void FlightRecorderSetEnabled(bool enabled) {
+  gFlightRecorderEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool FlightRecorderIsEnabled() {
+  return gFlightRecorderEnabled.load(std::memory_order_relaxed);
+}
+
+void FlightRecorderRecordBegin(const char* name) {
+  Record(FlightRecorderEventType::kBegin, name);
+}
+
+void FlightRecorderRecordEnd(const char* name) {
+  Record(FlightRecorderEventType::kEnd, name);
+}
+
+std::vector<FlightRecorderThreadEvents> FlightRecorderDump() {
+  return GetRegistry().Dump();
+}
+
+void FlightRecorderResetForTesting() {
+  GetRegistry().Reset();
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+#define FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// The flight recorder keeps the most recent duration trace events of every
+/// thread in a fixed size, per-thread ring buffer. Unlike the timeline, it
+/// does not depend on a recorder being attached and is available in release
+/// builds, so the events leading up to a jank can be inspected after the fact
+/// by dumping the buffers via |FlightRecorderDump|.
+///
+/// Recording an event does not take any locks or allocate. The producer of
+/// each ring buffer is its thread, and the dump discards the events that may
+/// have been overwritten while it was copying them.
+///
+
+enum class FlightRecorderEventType : uint8_t {
+  kBegin,
+  kEnd,
+};
+
+/// A fixed size binary record of a single duration event.
+struct FlightRecorderEvent {
+  static constexpr size_t kMaxNameLength = 22;
+
+  /// The |fml::TimePoint| of the event in nanoseconds.
+  int64_t timestamp_nanos;
+  FlightRecorderEventType type;
+  /// The name of the trace event, truncated to |kMaxNameLength| characters.
+  /// The name is copied because the trace macros do not guarantee that their
+  /// labels outlive the event.
+  char name[kMaxNameLength + 1];
+};
+
+static_assert(sizeof(FlightRecorderEvent) == 32,
+              "Flight recorder events must stay compact.");
+
+/// The events recorded on a single thread, oldest first.
+struct FlightRecorderThreadEvents {
+  /// A process unique identifier of the recording thread, assigned in the
+  /// order in which threads first record an event.
+  uint64_t thread_id = 0;
+  bool thread_exited = false;
+  std::vector<FlightRecorderEvent> events;
+};
+
+/// The number of events each thread retains.
+constexpr size_t kFlightRecorderCapacity = 1024;
+
+/// Enables or disables recording. Disabled by default. Events already in the
+/// ring buffers are kept when recording is disabled.
+void FlightRecorderSetEnabled(bool enabled);
+
+bool FlightRecorderIsEnabled();
+
+void FlightRecorderRecordBegin(const char* name);
+
+void FlightRecorderRecordEnd(const char* name);
+
+/// Copies the contents of the ring buffers of all threads that have
+/// recorded events, including a bounded number of threads that have since
+/// exited.
+std::vector<FlightRecorderThreadEvents> FlightRecorderDump();
+
+/// Drops all recorded events. Only meant to be used by tests.
+void FlightRecorderResetForTesting();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_FLIGHT_RECORDER_H_
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_flight_recorder.h"
+
+#include <cstring>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+class FlightRecorderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FlightRecorderResetForTesting();
+    FlightRecorderSetEnabled(true);
+  }
+
+  void TearDown() override {
+    FlightRecorderSetEnabled(false);
+    FlightRecorderResetForTesting();
+  }
+};
+
+static size_t CountEvents(const char* name) {
+  size_t count = 0;
+  for (const auto& thread : FlightRecorderDump()) {
+    for (const auto& event : thread.events) {
+      if (::strcmp(event.name, name) == 0) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+TEST_F(FlightRecorderTest, RecordsBeginAndEndPairs) {
+  { TRACE_EVENT0("flutter", "Scope"); }
+  auto dump = FlightRecorderDump();
+  ASSERT_EQ(dump.size(), 1u);
+  ASSERT_EQ(dump[0].events.size(), 2u);
+  EXPECT_EQ(dump[0].events[0].type, FlightRecorderEventType::kBegin);
+  EXPECT_EQ(dump[0].events[1].type, FlightRecorderEventType::kEnd);
+  EXPECT_STREQ(dump[0].events[0].name, "Scope");
+  EXPECT_LE(dump[0].events[0].timestamp_nanos,
+            dump[0].events[1].timestamp_nanos);
+}
+
+TEST_F(FlightRecorderTest, DoesNotRecordWhenDisabled) {
+  FlightRecorderSetEnabled(false);
+  { TRACE_EVENT0("flutter", "Scope"); }
+  ASSERT_EQ(CountEvents("Scope"), 0u);
+}
+
+TEST_F(FlightRecorderTest, TruncatesLongNames) {
+  FlightRecorderRecordBegin("AVeryLongTraceEventNameThatDoesNotFit");
+  auto dump = FlightRecorderDump();
+  ASSERT_EQ(dump.size(), 1u);
+  ASSERT_EQ(dump[0].events.size(), 1u);
+  EXPECT_EQ(::strlen(dump[0].events[0].name),
+            FlightRecorderEvent::kMaxNameLength);
+}
+
+TEST_F(FlightRecorderTest, KeepsOnlyTheMostRecentEvents) {
+  for (size_t i = 0; i < kFlightRecorderCapacity; i++) {
+    FlightRecorderRecordBegin("Old");
+  }
+  for (size_t i = 0; i < kFlightRecorderCapacity / 2; i++) {
+    FlightRecorderRecordBegin("New");
+  }
+  auto dump = FlightRecorderDump();
+  ASSERT_EQ(dump.size(), 1u);
+  // The oldest slot is conservatively dropped as the thread could be in the
+  // middle of overwriting it.
+  ASSERT_EQ(dump[0].events.size(), kFlightRecorderCapacity - 1);
+  EXPECT_STREQ(dump[0].events.front().name, "Old");
+  EXPECT_STREQ(dump[0].events.back().name, "New");
+  EXPECT_EQ(CountEvents("New"), kFlightRecorderCapacity / 2);
+}
+
+TEST_F(FlightRecorderTest, RecordsEachThreadSeparately) {
+  { TRACE_EVENT0("flutter", "Main"); }
+  std::thread thread([]() { TRACE_EVENT0("flutter", "Worker"); });
+  thread.join();
+
+  auto dump = FlightRecorderDump();
+  ASSERT_EQ(dump.size(), 2u);
+  EXPECT_NE(dump[0].thread_id, dump[1].thread_id);
+  EXPECT_FALSE(dump[0].thread_exited);
+  EXPECT_TRUE(dump[1].thread_exited);
+  EXPECT_EQ(CountEvents("Main"), 2u);
+  EXPECT_EQ(CountEvents("Worker"), 2u);
+}
+
+TEST_F(FlightRecorderTest, CanDumpWhileRecording) {
+  std::atomic_bool done = false;
+  std::thread thread([&done]() {
+    while (!done) {
+      TRACE_EVENT0("flutter", "Busy");
+    }
+  });
+  for (size_t i = 0; i < 100; i++) {
+    for (const auto& thread_events : FlightRecorderDump()) {
+      ASSERT_LE(thread_events.events.size(), kFlightRecorderCapacity);
+    }
+  }
+  done = true;
+  thread.join();
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -2402,6 +2402,34 @@ TEST_P(AiksTest, DrawRectAbsorbsClearsNegative) {
   ASSERT_EQ(render_pass->GetCommands().size(), 2llu);
 }
 
+TEST_P(AiksTest, ConsecutiveSolidRectsAreBatched) {
+  Canvas canvas;
+  canvas.DrawPaint({.color = Color::White()});
+  for (int i = 0; i < 10; i++) {
+    canvas.DrawRect(Rect::MakeXYWH(i * 20, i * 10, 50, 50),
+                    {.color = Color::Red().WithAlpha(0.5)});
+  }
+  // Doesn't overlap the batch, so it is drawn ahead of it.
+  canvas.DrawCircle({250, 250}, 10, {.color = Color::Blue()});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {.color = Color::Green()});
+  // Overlaps the batch, which ends it.
+  canvas.DrawCircle({10, 10}, 10, {.color = Color::Blue()});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {.color = Color::Green()});
+
+  std::shared_ptr<ContextSpy> spy = ContextSpy::Make();
+  Picture picture = canvas.EndRecordingAsPicture();
+  std::shared_ptr<Context> real_context = GetContext();
+  std::shared_ptr<ContextMock> mock_context = spy->MakeContext(real_context);
+  AiksContext renderer(mock_context, nullptr);
+  std::shared_ptr<Image> image = picture.ToImage(renderer, {300, 300});
+
+  ASSERT_EQ(spy->render_passes_.size(), 1llu);
+  std::shared_ptr<RenderPass> render_pass = spy->render_passes_[0];
+  // The circles, the batch of the first eleven rectangles, and the last
+  // rectangle.
+  ASSERT_EQ(render_pass->GetCommands().size(), 4llu);
+}
+
 TEST_P(AiksTest, ClipRectElidesNoOpClips) {
   Canvas canvas(Rect(0, 0, 100, 100));
   canvas.ClipRect(Rect(0, 0, 100, 100));
@@ -13,6 +13,7 @@
 #include "impeller/aiks/paint_pass_delegate.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/filters/yuv_to_rgb_filter_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -39,7 +40,7 @@ Canvas::~Canvas() = default;
 
 void Canvas::Initialize(std::optional<Rect> cull_rect) {
   initial_cull_rect_ = cull_rect;
-  base_pass_ = std::make_unique<EntityPass>();
+  base_pass_ = std::make_unique<EntityPass>(std::make_shared<fml::Arena>());
   current_pass_ = base_pass_.get();
   xformation_stack_.emplace_back(CanvasStackEntry{.cull_rect = cull_rect});
   FML_DCHECK(GetSaveCount() == 1u);
@@ -65,7 +66,7 @@ void Canvas::Save(bool create_subpass,
   entry.stencil_depth = xformation_stack_.back().stencil_depth;
   if (create_subpass) {
     entry.rendering_mode = Entity::RenderingMode::kSubpass;
-    auto subpass = std::make_unique<EntityPass>();
+    auto subpass = std::make_unique<EntityPass>(base_pass_->GetArena());
     subpass->SetEnableOffscreenCheckerboard(
         debug_options.offscreen_texture_checkerboard);
     if (backdrop_filter) {
@@ -175,7 +176,8 @@ void Canvas::DrawPath(const Path& path, const Paint& paint) {
   entity.SetTransformation(GetCurrentTransformation());
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(paint.WithFilters(paint.CreateContentsForEntity(path)));
+  entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
+      PrefetchGeometry(paint.CreateGeometry(path)))));
 
   GetCurrentPass().AddEntity(entity);
 }
@@ -259,8 +261,8 @@ void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
     entity.SetTransformation(GetCurrentTransformation());
     entity.SetStencilDepth(GetStencilDepth());
     entity.SetBlendMode(paint.blend_mode);
-    entity.SetContents(paint.WithFilters(
-        paint.CreateContentsForGeometry(Geometry::MakeFillPath(path))));
+    entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
+        PrefetchGeometry(Geometry::MakeFillPath(path)))));
 
     GetCurrentPass().AddEntity(entity);
     return;
@@ -510,6 +512,56 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
   GetCurrentPass().AddEntity(entity);
 }
 
+void Canvas::DrawYUVImageRect(const std::shared_ptr<Texture>& y_texture,
+                              const std::shared_ptr<Texture>& uv_texture,
+                              YUVColorSpace yuv_color_space,
+                              Rect source,
+                              Rect dest,
+                              const Paint& paint,
+                              SamplerDescriptor sampler) {
+  if (!y_texture || !uv_texture || source.size.IsEmpty() ||
+      dest.size.IsEmpty()) {
+    return;
+  }
+
+  auto size = y_texture->GetSize();
+
+  if (size.IsEmpty()) {
+    return;
+  }
+
+  auto contents = std::make_shared<YUVToRGBFilterContents>();
+  contents->SetInputs(
+      {FilterInput::Make(y_texture), FilterInput::Make(uv_texture)});
+  contents->SetYUVColorSpace(yuv_color_space);
+  contents->SetSamplerDescriptor(std::move(sampler));
+  contents->SetOpacity(paint.color.alpha);
+
+  // The filter covers the luma plane at the origin, so map the source rect of
+  // the plane onto the destination rect and clip off the rest.
+  const bool is_cropped = !(source == Rect::MakeSize(size));
+  if (is_cropped) {
+    Save();
+    ClipRect(dest);
+  }
+
+  Entity entity;
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetContents(paint.WithFilters(contents));
+  entity.SetTransformation(
+      GetCurrentTransformation() * Matrix::MakeTranslation(dest.origin) *
+      Matrix::MakeScale(Vector2(dest.size.width / source.size.width,
+                                dest.size.height / source.size.height)) *
+      Matrix::MakeTranslation(-source.origin));
+
+  GetCurrentPass().AddEntity(entity);
+
+  if (is_cropped) {
+    Restore();
+  }
+}
+
 Picture Canvas::EndRecordingAsPicture() {
   Picture picture;
   picture.pass = std::move(base_pass_);
@@ -520,6 +572,43 @@ Picture Canvas::EndRecordingAsPicture() {
   return picture;
 }
 
+EntityPass* Canvas::BeginDetachedRecording(Canvas& detached) {
+  FML_DCHECK(detached.GetSaveCount() == 1u);
+  const CanvasStackEntry& current = xformation_stack_.back();
+  detached.debug_options = debug_options;
+  detached.prefetch_task_runner_ = prefetch_task_runner_;
+  detached.xformation_stack_ = {CanvasStackEntry{
+      .xformation = current.xformation,
+      .cull_rect = current.cull_rect,
+      .stencil_depth = current.stencil_depth,
+  }};
+  return GetCurrentPass().AddSubpass(
+      std::make_unique<EntityPass>(base_pass_->GetArena()));
+}
+
+void Canvas::EndDetachedRecording(EntityPass* reservation, Canvas& detached) {
+  FML_DCHECK(detached.GetSaveCount() == 1u);
+  EntityPass* superpass = reservation->GetSuperpass();
+  FML_DCHECK(superpass);
+  superpass->ReplaceSubpassInline(reservation, std::move(detached.base_pass_));
+
+  detached.Reset();
+  detached.Initialize(detached.initial_cull_rect_);
+}
+
+void Canvas::SetGeometryPrefetchTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  prefetch_task_runner_ = std::move(task_runner);
+}
+
+std::unique_ptr<Geometry> Canvas::PrefetchGeometry(
+    std::unique_ptr<Geometry> geometry) const {
+  if (prefetch_task_runner_) {
+    geometry->Prefetch(GetCurrentTransformation(), *prefetch_task_runner_);
+  }
+  return geometry;
+}
+
 EntityPass& Canvas::GetCurrentPass() {
   FML_DCHECK(current_pass_ != nullptr);
   return *current_pass_;
@@ -125,6 +125,16 @@ class Canvas {
                      const Paint& paint,
                      SamplerDescriptor sampler = {});
 
+  /// Draws an image made up of a luma and a chroma plane, converting it to RGB
+  /// as it is sampled rather than in a separate pass.
+  void DrawYUVImageRect(const std::shared_ptr<Texture>& y_texture,
+                        const std::shared_ptr<Texture>& uv_texture,
+                        YUVColorSpace yuv_color_space,
+                        Rect source,
+                        Rect dest,
+                        const Paint& paint,
+                        SamplerDescriptor sampler = {});
+
   void ClipPath(
       const Path& path,
       Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
@@ -159,11 +169,46 @@ class Canvas {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief  Reserves the current position of this canvas for content
+  ///         recorded into |detached|, and starts |detached| from the current
+  ///         transformation, cull rect and stencil depth of this canvas.
+  ///
+  ///         |detached| shares no recording state with this canvas, so the
+  ///         two may be recorded into on different threads. Once |detached|
+  ///         is done, its content is moved into the reserved position with
+  ///         `EndDetachedRecording()`, and renders as if it had been recorded
+  ///         into this canvas directly.
+  ///
+  /// @return The reservation to pass to `EndDetachedRecording()`.
+  ///
+  EntityPass* BeginDetachedRecording(Canvas& detached);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Moves the content recorded into |detached| since the matching
+  ///         `BeginDetachedRecording()` into its reserved position.
+  ///
+  ///         Every save made on |detached| must have been restored.
+  ///
+  void EndDetachedRecording(EntityPass* reservation, Canvas& detached);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Starts generating the vertices of the paths drawn into this
+  ///         canvas on |task_runner| as soon as they are drawn, instead of
+  ///         when they are rendered. Detached recordings begun afterwards use
+  ///         the same task runner.
+  ///
+  /// @see    Geometry::Prefetch
+  ///
+  void SetGeometryPrefetchTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
  private:
   std::unique_ptr<EntityPass> base_pass_;
   EntityPass* current_pass_ = nullptr;
   std::deque<CanvasStackEntry> xformation_stack_;
   std::optional<Rect> initial_cull_rect_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> prefetch_task_runner_;
 
   void Initialize(std::optional<Rect> cull_rect);
 
@@ -173,6 +218,9 @@ class Canvas {
 
   size_t GetStencilDepth() const;
 
+  std::unique_ptr<Geometry> PrefetchGeometry(
+      std::unique_ptr<Geometry> geometry) const;
+
   void ClipGeometry(std::unique_ptr<Geometry> geometry,
                     Entity::ClipOperation clip_op);
 
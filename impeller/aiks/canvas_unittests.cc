@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <variant>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/geometry/path_builder.h"
@@ -336,6 +339,51 @@ TEST(AiksCanvasTest, PathClipDiffAgainstFullyCoveredCullRect) {
   ASSERT_EQ(canvas.GetCurrentLocalCullingBounds().value(), result_cull);
 }
 
+TEST(AiksCanvasTest, PassElementsAreAllocatedFromArena) {
+  Canvas canvas;
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {});
+  canvas.SaveLayer({});
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {});
+  canvas.Restore();
+
+  Picture picture = canvas.EndRecordingAsPicture();
+  ASSERT_NE(picture.pass->GetArena(), nullptr);
+  ASSERT_GE(picture.pass->GetArena()->GetStats().allocation_count, 2u);
+}
+
+TEST(AiksCanvasTest, DetachedRecordingKeepsItsPlace) {
+  Canvas canvas;
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {});
+  canvas.Translate(Vector3(5, 5, 0));
+
+  Canvas detached;
+  EntityPass* reservation = canvas.BeginDetachedRecording(detached);
+  canvas.DrawRect(Rect::MakeXYWH(20, 0, 10, 10), {});
+
+  detached.SaveLayer({});
+  detached.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), {});
+  detached.Restore();
+  canvas.EndDetachedRecording(reservation, detached);
+
+  Picture picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(picture.pass->GetElementCount(), 3u);
+  std::vector<EntityPass::Element*> elements;
+  picture.pass->IterateAllElements([&elements](EntityPass::Element& element) {
+    elements.push_back(&element);
+    return true;
+  });
+  ASSERT_EQ(elements.size(), 4u);
+  ASSERT_TRUE(std::holds_alternative<Entity>(*elements[0]));
+  auto subpass = std::get_if<std::unique_ptr<EntityPass>>(elements[1]);
+  ASSERT_NE(subpass, nullptr);
+  ASSERT_EQ(subpass->get()->GetSuperpass(), picture.pass.get());
+  auto layer_entity = std::get_if<Entity>(elements[2]);
+  ASSERT_NE(layer_entity, nullptr);
+  ASSERT_EQ(layer_entity->GetTransformation(),
+            Matrix::MakeTranslation({5, 5, 0}));
+  ASSERT_TRUE(std::holds_alternative<Entity>(*elements[3]));
+}
+
 }  // namespace testing
 }  // namespace impeller
 
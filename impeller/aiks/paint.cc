@@ -14,21 +14,22 @@
 
 namespace impeller {
 
-std::shared_ptr<Contents> Paint::CreateContentsForEntity(const Path& path,
-                                                         bool cover) const {
-  std::unique_ptr<Geometry> geometry;
+std::unique_ptr<Geometry> Paint::CreateGeometry(const Path& path,
+                                                bool cover) const {
   switch (style) {
     case Style::kFill:
-      geometry = cover ? Geometry::MakeCover() : Geometry::MakeFillPath(path);
-      break;
+      return cover ? Geometry::MakeCover() : Geometry::MakeFillPath(path);
     case Style::kStroke:
-      geometry =
-          cover ? Geometry::MakeCover()
-                : Geometry::MakeStrokePath(path, stroke_width, stroke_miter,
-                                           stroke_cap, stroke_join);
-      break;
+      return cover ? Geometry::MakeCover()
+                   : Geometry::MakeStrokePath(path, stroke_width, stroke_miter,
+                                              stroke_cap, stroke_join);
   }
-  return CreateContentsForGeometry(std::move(geometry));
+  FML_UNREACHABLE();
+}
+
+std::shared_ptr<Contents> Paint::CreateContentsForEntity(const Path& path,
+                                                         bool cover) const {
+  return CreateContentsForGeometry(CreateGeometry(path, cover));
 }
 
 std::shared_ptr<Contents> Paint::CreateContentsForGeometry(
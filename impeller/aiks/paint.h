@@ -86,6 +86,9 @@ struct Paint {
       std::shared_ptr<Contents> input,
       const Matrix& effect_transform = Matrix()) const;
 
+  std::unique_ptr<Geometry> CreateGeometry(const Path& path = {},
+                                           bool cover = false) const;
+
   std::shared_ptr<Contents> CreateContentsForEntity(const Path& path = {},
                                                     bool cover = false) const;
 
@@ -6,6 +6,7 @@
 
 #include <iterator>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "impeller/archivist/archive_class_registration.h"
 #include "impeller/archivist/archive_database.h"
@@ -42,7 +43,11 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  auto statement = registration->CreateInsertStatement();
+  auto statement_handle = registration->TakeInsertStatement();
+  fml::ScopedCleanupClosure recycle_statement([&]() {
+    registration->RecycleInsertStatement(std::move(statement_handle));
+  });
+  auto& statement = *statement_handle;
 
   if (!statement.IsValid() || !statement.Reset()) {
     /*
@@ -95,6 +100,30 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
   return lastInsert;
 }
 
+bool Archive::ArchiveInstances(
+    const ArchiveDef& definition,
+    size_t count,
+    const std::function<const Archivable&(size_t)>& archivable_at) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  /*
+   *  The writes of the individual instances are nested in this transaction, so
+   *  they are committed together, and only if all of them succeed.
+   */
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  for (size_t i = 0; i < count; i++) {
+    if (!ArchiveInstance(definition, archivable_at(i)).has_value()) {
+      return false;
+    }
+  }
+
+  transaction.MarkWritesAsReadyForCommit();
+  return true;
+}
+
 bool Archive::UnarchiveInstance(const ArchiveDef& definition,
                                 PrimaryKey name,
                                 Archivable& archivable) {
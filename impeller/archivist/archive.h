@@ -34,6 +34,22 @@ class Archive {
     return ArchiveInstance(def, archivable).has_value();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes all of the archivables in a single transaction. This is
+  ///             much faster than writing them one at a time. Either all of
+  ///             them are written, or none are.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  [[nodiscard]] bool Write(const std::vector<T>& archivables) {
+    const ArchiveDef& def = T::kArchiveDefinition;
+    return ArchiveInstances(
+        def, archivables.size(),
+        [&archivables](size_t index) -> const Archivable& {
+          return archivables[index];
+        });
+  }
+
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Read(PrimaryKey name, T& archivable) {
@@ -60,6 +76,11 @@ class Archive {
       const ArchiveDef& definition,
       const Archivable& archivable);
 
+  bool ArchiveInstances(
+      const ArchiveDef& definition,
+      size_t count,
+      const std::function<const Archivable&(size_t)>& archivable_at);
+
   bool UnarchiveInstance(const ArchiveDef& definition,
                          PrimaryKey name,
                          Archivable& archivable);
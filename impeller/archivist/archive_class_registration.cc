@@ -121,4 +121,23 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   return database_.CreateStatement(stream.str());
 }
 
+std::unique_ptr<ArchiveStatement>
+ArchiveClassRegistration::TakeInsertStatement() const {
+  if (insert_statements_.empty()) {
+    return std::unique_ptr<ArchiveStatement>(
+        new ArchiveStatement(CreateInsertStatement()));
+  }
+  auto statement = std::move(insert_statements_.back());
+  insert_statements_.pop_back();
+  return statement;
+}
+
+void ArchiveClassRegistration::RecycleInsertStatement(
+    std::unique_ptr<ArchiveStatement> statement) const {
+  // Statements that can't be reset are dropped and prepared again if needed.
+  if (statement && statement->Reset()) {
+    insert_statements_.push_back(std::move(statement));
+  }
+}
+
 }  // namespace impeller
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive.h"
@@ -29,6 +31,18 @@ class ArchiveClassRegistration {
 
   ArchiveStatement CreateQueryStatement(bool single) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes one of the insert statements cached for this class, or
+  ///             prepares a new one if all of them are in use by the writes
+  ///             being made. Preparing statements is expensive, so the
+  ///             statement must be handed back with `RecycleInsertStatement`
+  ///             once the write is done.
+  ///
+  std::unique_ptr<ArchiveStatement> TakeInsertStatement() const;
+
+  void RecycleInsertStatement(
+      std::unique_ptr<ArchiveStatement> statement) const;
+
  private:
   using MemberColumnMap = std::map<std::string, size_t>;
 
@@ -41,6 +55,9 @@ class ArchiveClassRegistration {
   ArchiveDatabase& database_;
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
+  // Writes of archivables nested in another of the same class need a statement
+  // of their own, so more than one may be cached.
+  mutable std::vector<std::unique_ptr<ArchiveStatement>> insert_statements_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveClassRegistration);
@@ -57,6 +57,21 @@ ArchiveDatabase::ArchiveDatabase(const std::string& filename)
     return;
   }
 
+  /*
+   *  With a write-ahead log, commits only append to the log instead of
+   *  rewriting the database file, and don't need to wait for a sync to disk.
+   *  Archives are diagnostic captures, so losing the last few transactions in
+   *  a power loss is fine.
+   */
+  for (const auto* pragma :
+       {"PRAGMA journal_mode = WAL;", "PRAGMA synchronous = NORMAL;"}) {
+    auto statement = CreateStatement(pragma);
+    if (!statement.IsValid() ||
+        statement.Execute() == ArchiveStatement::Result::kFailure) {
+      VALIDATION_LOG << "Could not configure the archive database.";
+    }
+  }
+
   begin_transaction_stmt_ = std::unique_ptr<ArchiveStatement>(
       new ArchiveStatement(handle_->Get(), "BEGIN TRANSACTION;"));
 
@@ -132,6 +132,23 @@ TEST_F(ArchiveTest, AddDataMultiple) {
   }
 }
 
+TEST_F(ArchiveTest, AddDataBatch) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  std::vector<Sample> samples;
+  for (size_t i = 0; i < 100; i++) {
+    samples.emplace_back(i + 1);
+  }
+  ASSERT_TRUE(archive.Write(samples));
+
+  for (const auto& sample : samples) {
+    Sample other;
+    ASSERT_TRUE(archive.Read(sample.GetPrimaryKey(), other));
+    ASSERT_EQ(other.GetSomeData(), sample.GetSomeData());
+  }
+}
+
 TEST_F(ArchiveTest, ReadData) {
   Archive archive(GetArchiveFileName().c_str());
   ASSERT_TRUE(archive.IsValid());
@@ -44,12 +44,31 @@ BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
 
   if (auto items = blob_library->items()) {
     for (auto i = items->begin(), end = items->end(); i != end; i++) {
+      if (!i->name()) {
+        VALIDATION_LOG << "Blob name was absent.";
+        return;
+      }
+      const uint8_t* data = nullptr;
+      size_t size = 0u;
+      if (i->mapping() && i->mapping()->size() > 0u) {
+        data = i->mapping()->Data();
+        size = i->mapping()->size();
+      } else {
+        // The blob is stored after the flatbuffer.
+        if (i->offset() > payload_->GetSize() ||
+            i->length() > payload_->GetSize() - i->offset()) {
+          VALIDATION_LOG << "Blob " << i->name()->str()
+                         << " was out of bounds of the library.";
+          return;
+        }
+        data = payload_->GetMapping() + i->offset();
+        size = i->length();
+      }
       BlobKey key;
       key.name = i->name()->str();
       key.type = ToShaderType(i->stage());
       blobs_[key] = std::make_shared<fml::NonOwnedMapping>(
-          i->mapping()->Data(), i->mapping()->size(),
-          [payload = payload_](auto, auto) {
+          data, size, [payload = payload_](auto, auto) {
             // The pointers are into the base payload. Instead of copying the
             // data, just hold onto the payload.
           });
@@ -4,8 +4,10 @@
 
 #include "impeller/blobcat/blob_writer.h"
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
+#include <fstream>
 #include <optional>
 
 #include "impeller/blobcat/blob_flatbuffers.h"
@@ -117,4 +119,93 @@ std::shared_ptr<fml::Mapping> BlobWriter::CreateMapping() const {
                                                 [builder](auto, auto) {});
 }
 
+static constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static void BuildLibraryHeader(flatbuffers::FlatBufferBuilder& builder,
+                               const std::vector<fb::BlobT>& items,
+                               uint64_t alignment) {
+  fb::BlobLibraryT blobs;
+  blobs.alignment = alignment;
+  for (const auto& item : items) {
+    blobs.items.emplace_back(std::make_unique<fb::BlobT>(item));
+  }
+  // Zero offsets must still be stored so that the size of the header doesn't
+  // depend on them.
+  builder.ForceDefaults(true);
+  builder.Finish(fb::BlobLibrary::Pack(builder, &blobs),
+                 fb::BlobLibraryIdentifier());
+}
+
+static bool WritePadding(std::ofstream& stream, uint64_t size) {
+  static const std::array<char, 256> kZeros = {};
+  while (size > 0u) {
+    const auto chunk = std::min<uint64_t>(size, kZeros.size());
+    stream.write(kZeros.data(), chunk);
+    size -= chunk;
+  }
+  return stream.good();
+}
+
+bool BlobWriter::WriteToFile(const std::string& path, size_t alignment) const {
+  if (alignment == 0u || (alignment & (alignment - 1)) != 0u) {
+    FML_LOG(ERROR) << "Blob alignment must be a power of two.";
+    return false;
+  }
+
+  std::vector<fb::BlobT> items;
+  items.reserve(blob_descriptions_.size());
+  for (const auto& blob_description : blob_descriptions_) {
+    fb::BlobT item;
+    item.name = blob_description.name;
+    item.stage = ToStage(blob_description.type);
+    item.length = blob_description.mapping->GetSize();
+    items.emplace_back(std::move(item));
+  }
+
+  // The header is built once to find out where the blobs can start, and again
+  // with their offsets. Only the values of the offsets change, so the size of
+  // the header stays the same.
+  flatbuffers::FlatBufferBuilder sizing_builder;
+  BuildLibraryHeader(sizing_builder, items, alignment);
+  uint64_t offset = sizing_builder.GetSize();
+  for (auto& item : items) {
+    offset = AlignUp(offset, alignment);
+    item.offset = offset;
+    offset += item.length;
+  }
+  flatbuffers::FlatBufferBuilder builder;
+  BuildLibraryHeader(builder, items, alignment);
+  if (builder.GetSize() != sizing_builder.GetSize()) {
+    FML_LOG(ERROR) << "Blob library header changed size.";
+    return false;
+  }
+
+  std::ofstream stream(std::filesystem::path(path),
+                       std::ios::binary | std::ios::trunc);
+  if (!stream.is_open()) {
+    FML_LOG(ERROR) << "Could not open blob library at path " << path;
+    return false;
+  }
+  stream.write(reinterpret_cast<const char*>(builder.GetBufferPointer()),
+               builder.GetSize());
+  uint64_t written = builder.GetSize();
+  for (size_t i = 0; i < items.size(); i++) {
+    if (!WritePadding(stream, items[i].offset - written)) {
+      break;
+    }
+    const auto& mapping = blob_descriptions_[i].mapping;
+    stream.write(reinterpret_cast<const char*>(mapping->GetMapping()),
+                 mapping->GetSize());
+    written = items[i].offset + items[i].length;
+  }
+  stream.flush();
+  if (!stream.good()) {
+    FML_LOG(ERROR) << "Could not write blob library to path " << path;
+    return false;
+  }
+  return true;
+}
+
 }  // namespace impeller
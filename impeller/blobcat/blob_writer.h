@@ -26,8 +26,31 @@ class BlobWriter {
                              std::string name,
                              std::shared_ptr<fml::Mapping> mapping);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a library with the contents of every blob copied
+  ///             into it.
+  ///
   std::shared_ptr<fml::Mapping> CreateMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes a library to a file, streaming the contents of each
+  ///             blob from its mapping instead of building the library in
+  ///             memory.
+  ///
+  ///             The blobs are stored after the library header at offsets
+  ///             that are a multiple of the alignment. When the library file
+  ///             is mapped with an alignment of the page size, every blob
+  ///             starts on a page of its own.
+  ///
+  /// @param[in]  path       The path of the library file to write.
+  /// @param[in]  alignment  The alignment of the blob offsets. Must be a
+  ///                        power of two.
+  ///
+  /// @return     If the library was written.
+  ///
+  [[nodiscard]] bool WriteToFile(const std::string& path,
+                                 size_t alignment) const;
+
  private:
   struct BlobDescription {
     BlobShaderType type;
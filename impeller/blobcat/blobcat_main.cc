@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 
@@ -10,6 +11,10 @@
 
 namespace impeller {
 
+// Keeps the blobs word aligned for SPIRV. Libraries that are mapped from
+// files can ask for the page size instead.
+static constexpr size_t kDefaultAlignment = 16u;
+
 bool Main(const fml::CommandLine& command_line) {
   BlobWriter writer;
 
@@ -26,19 +31,17 @@ bool Main(const fml::CommandLine& command_line) {
     }
   }
 
-  auto blob = writer.CreateMapping();
-  if (!blob) {
-    std::cerr << "Could not create combined shader blob." << std::endl;
-    return false;
+  size_t alignment = kDefaultAlignment;
+  std::string alignment_string;
+  if (command_line.GetOptionValue("alignment", &alignment_string)) {
+    alignment = std::strtoul(alignment_string.c_str(), nullptr, 10);
   }
 
-  auto current_directory =
-      fml::OpenDirectory(std::filesystem::current_path().string().c_str(),
-                         false, fml::FilePermission::kReadWrite);
+  // The blobs are streamed from their file mappings into the output instead
+  // of being combined in memory first.
   auto output_path =
       std::filesystem::absolute(std::filesystem::current_path() / output);
-  if (!fml::WriteAtomically(current_directory, output_path.string().c_str(),
-                            *blob)) {
+  if (!writer.WriteToFile(output_path.string(), alignment)) {
     std::cerr << "Could not write shader blob to path " << output << std::endl;
     return false;
   }
@@ -4,7 +4,9 @@
 
 #include <string>
 
+#include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "flutter/testing/testing.h"
 #include "impeller/blobcat/blob_library.h"
 #include "impeller/blobcat/blob_writer.h"
@@ -53,5 +55,34 @@ TEST(BlobTest, CanReadAndWriteBlobs) {
   ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "World");
 }
 
+TEST(BlobTest, CanWriteBlobsToFileAtAlignedOffsets) {
+  BlobWriter writer;
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, "Hello",
+                             CreateMappingFromString("World")));
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, "Foo",
+                             CreateMappingFromString("Bar")));
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  const auto path = fml::paths::JoinPaths({temp_dir.path(), "blobs"});
+  ASSERT_FALSE(writer.WriteToFile(path, 3u));
+  ASSERT_TRUE(writer.WriteToFile(path, 4096u));
+
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  ASSERT_NE(mapping, nullptr);
+  BlobLibrary library(std::move(mapping));
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), 2u);
+
+  auto hello_vtx = library.GetMapping(BlobShaderType::kVertex, "Hello");
+  ASSERT_NE(hello_vtx, nullptr);
+  ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "World");
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(hello_vtx->GetMapping()) % 4096u, 0u);
+
+  auto foo_frag = library.GetMapping(BlobShaderType::kFragment, "Foo");
+  ASSERT_NE(foo_frag, nullptr);
+  ASSERT_EQ(CreateStringFromMapping(*foo_frag), "Bar");
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(foo_frag->GetMapping()) % 4096u, 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -39,6 +39,16 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
   // The generator used to prepare these bindings. Metal generators may be used
   // by GLES backends but GLES generators are unsuitable for the metal backend.
   static constexpr std::string_view kGeneratorName = "{{get_generator_name()}}";
+{% if length(specialization_constants) > 0 %}
+
+  // ===========================================================================
+  // Specialization Constants ==================================================
+  // ===========================================================================
+  // Indices into PipelineDescriptor::SetSpecializationConstants.
+{% for constant in specialization_constants %}
+  static constexpr size_t kSpecializationConstant{{camel_case(constant.name)}} = {{constant.constant_id}}u; // {{constant.name}}
+{% endfor %}
+{% endif %}
 {% if length(struct_definitions) > 0 %}
   // ===========================================================================
   // Struct Definitions ========================================================
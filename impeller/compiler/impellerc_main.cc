@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <filesystem>
 #include <system_error>
 
@@ -36,6 +37,25 @@ static bool SetPermissiveAccess(const std::filesystem::path& p) {
   return true;
 }
 
+// Writes the file at 'file_name' unless it already has the given contents.
+//
+// Leaving unchanged outputs alone keeps their timestamps, so the build system
+// doesn't rebuild what depends on them. This matters most for the reflection
+// headers, which many translation units include, when a shader change doesn't
+// affect its interface.
+static bool WriteAtomicallyIfChanged(const fml::UniqueFD& base_directory,
+                                     const char* file_name,
+                                     const fml::Mapping& data) {
+  auto existing = fml::FileMapping::CreateReadOnly(base_directory, file_name);
+  if (existing && existing->GetSize() == data.GetSize() &&
+      (data.GetSize() == 0u ||
+       ::memcmp(existing->GetMapping(), data.GetMapping(), data.GetSize()) ==
+           0)) {
+    return true;
+  }
+  return fml::WriteAtomically(base_directory, file_name, data);
+}
+
 bool Main(const fml::CommandLine& command_line) {
   fml::InstallCrashHandler();
   if (command_line.HasOption("help")) {
@@ -113,9 +133,9 @@ bool Main(const fml::CommandLine& command_line) {
 
   auto spriv_file_name = std::filesystem::absolute(
       std::filesystem::current_path() / switches.spirv_file_name);
-  if (!fml::WriteAtomically(*switches.working_directory,
-                            Utf8FromPath(spriv_file_name).c_str(),
-                            *compiler.GetSPIRVAssembly())) {
+  if (!WriteAtomicallyIfChanged(*switches.working_directory,
+                                Utf8FromPath(spriv_file_name).c_str(),
+                                *compiler.GetSPIRVAssembly())) {
     std::cerr << "Could not write file to " << switches.spirv_file_name
               << std::endl;
     return false;
@@ -144,10 +164,10 @@ bool Main(const fml::CommandLine& command_line) {
       std::cerr << "Runtime stage data could not be created." << std::endl;
       return false;
     }
-    if (!fml::WriteAtomically(*switches.working_directory,         //
-                              Utf8FromPath(sl_file_name).c_str(),  //
-                              *stage_data_mapping                  //
-                              )) {
+    if (!WriteAtomicallyIfChanged(*switches.working_directory,         //
+                                  Utf8FromPath(sl_file_name).c_str(),  //
+                                  *stage_data_mapping                  //
+                                  )) {
       std::cerr << "Could not write file to " << switches.sl_file_name
                 << std::endl;
       return false;
@@ -158,9 +178,9 @@ bool Main(const fml::CommandLine& command_line) {
       return false;
     }
   } else {
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(sl_file_name).c_str(),
-                              *compiler.GetSLShaderSource())) {
+    if (!WriteAtomicallyIfChanged(*switches.working_directory,
+                                  Utf8FromPath(sl_file_name).c_str(),
+                                  *compiler.GetSLShaderSource())) {
       std::cerr << "Could not write file to " << switches.sl_file_name
                 << std::endl;
       return false;
@@ -171,7 +191,7 @@ bool Main(const fml::CommandLine& command_line) {
     if (!switches.reflection_json_name.empty()) {
       auto reflection_json_name = std::filesystem::absolute(
           std::filesystem::current_path() / switches.reflection_json_name);
-      if (!fml::WriteAtomically(
+      if (!WriteAtomicallyIfChanged(
               *switches.working_directory,
               Utf8FromPath(reflection_json_name).c_str(),
               *compiler.GetReflector()->GetReflectionJSON())) {
@@ -185,7 +205,7 @@ bool Main(const fml::CommandLine& command_line) {
       auto reflection_header_name =
           std::filesystem::absolute(std::filesystem::current_path() /
                                     switches.reflection_header_name.c_str());
-      if (!fml::WriteAtomically(
+      if (!WriteAtomicallyIfChanged(
               *switches.working_directory,
               Utf8FromPath(reflection_header_name).c_str(),
               *compiler.GetReflector()->GetReflectionHeader())) {
@@ -199,9 +219,10 @@ bool Main(const fml::CommandLine& command_line) {
       auto reflection_cc_name =
           std::filesystem::absolute(std::filesystem::current_path() /
                                     switches.reflection_cc_name.c_str());
-      if (!fml::WriteAtomically(*switches.working_directory,
-                                Utf8FromPath(reflection_cc_name).c_str(),
-                                *compiler.GetReflector()->GetReflectionCC())) {
+      if (!WriteAtomicallyIfChanged(
+              *switches.working_directory,
+              Utf8FromPath(reflection_cc_name).c_str(),
+              *compiler.GetReflector()->GetReflectionCC())) {
         std::cerr << "Could not write reflection CC to "
                   << switches.reflection_cc_name << std::endl;
         return false;
@@ -229,9 +250,9 @@ bool Main(const fml::CommandLine& command_line) {
     }
     auto depfile_path = std::filesystem::absolute(
         std::filesystem::current_path() / switches.depfile_path.c_str());
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(depfile_path).c_str(),
-                              *compiler.CreateDepfileContents({result_file}))) {
+    if (!WriteAtomicallyIfChanged(
+            *switches.working_directory, Utf8FromPath(depfile_path).c_str(),
+            *compiler.CreateDepfileContents({result_file}))) {
       std::cerr << "Could not write depfile to " << switches.depfile_path
                 << std::endl;
       return false;
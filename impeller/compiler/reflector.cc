@@ -261,6 +261,18 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     }
   }
 
+  // The workgroup sizes of compute shaders are specialized by the backends
+  // instead.
+  if (execution_model == spv::ExecutionModelGLCompute) {
+    root["specialization_constants"] = nlohmann::json::array_t{};
+  } else if (auto specialization_constants = ReflectSpecializationConstants();
+             specialization_constants.has_value()) {
+    root["specialization_constants"] =
+        std::move(specialization_constants.value());
+  } else {
+    return std::nullopt;
+  }
+
   if (auto stage_outputs = ReflectResources(shader_resources.stage_outputs);
       stage_outputs.has_value()) {
     root["stage_outputs"] = std::move(stage_outputs.value());
@@ -492,6 +504,27 @@ std::optional<nlohmann::json::object_t> Reflector::ReflectType(
   return result;
 }
 
+std::optional<nlohmann::json::array_t>
+Reflector::ReflectSpecializationConstants() const {
+  nlohmann::json::array_t result;
+  for (const auto& constant : compiler_->get_specialization_constants()) {
+    const auto& type =
+        compiler_->get_type(compiler_->get_constant(constant.id).constant_type);
+    const auto name = compiler_->get_name(constant.id);
+    // Pipelines specialize all constants with scalars.
+    if (type.basetype != spirv_cross::SPIRType::BaseType::Float ||
+        type.width != 32u || type.vecsize != 1u || type.columns != 1u) {
+      VALIDATION_LOG << "Specialization constant " << name
+                     << " must be a 32-bit float.";
+      return std::nullopt;
+    }
+    auto& item = result.emplace_back(nlohmann::json::object_t{});
+    item["name"] = name;
+    item["constant_id"] = constant.constant_id;
+  }
+  return result;
+}
+
 std::optional<nlohmann::json::array_t> Reflector::ReflectResources(
     const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
     bool compute_offsets) const {
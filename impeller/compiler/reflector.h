@@ -120,6 +120,9 @@ class Reflector {
       const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
       bool compute_offsets = false) const;
 
+  std::optional<nlohmann::json::array_t> ReflectSpecializationConstants()
+      const;
+
   std::vector<size_t> ComputeOffsets(
       const spirv_cross::SmallVector<spirv_cross::Resource>& resources) const;
 
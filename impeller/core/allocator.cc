@@ -60,6 +60,10 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
 
 void Allocator::DidAcquireSurfaceFrame() {}
 
+bool Allocator::IsUnderMemoryPressure() const {
+  return false;
+}
+
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
   return BytesPerPixelForPixelFormat(format);
 }
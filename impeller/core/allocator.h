@@ -51,6 +51,13 @@ class Allocator {
   /// allocation pools.
   virtual void DidAcquireSurfaceFrame();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the device is running low on memory. Caches that hold
+  ///             on to allocations between frames should then release what
+  ///             they can.
+  ///
+  virtual bool IsUnderMemoryPressure() const;
+
  protected:
   Allocator();
 
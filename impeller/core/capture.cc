@@ -6,6 +6,9 @@
 
 #include <initializer_list>
 #include <memory>
+#include <type_traits>
+
+#include "impeller/core/capture_stream.h"
 
 namespace impeller {
 
@@ -111,9 +114,38 @@ std::shared_ptr<CaptureElement> Capture::GetElement() const {
 }
 
 void Capture::Rewind() {
-  return GetElement()->Rewind();
+  if (auto element = GetElement()) {
+    element->Rewind();
+  }
+}
+
+#ifdef IMPELLER_ENABLE_CAPTURE
+Capture::Capture(std::shared_ptr<CaptureStream> stream, uint32_t element_id)
+    : active_(true), stream_(std::move(stream)), element_id_(element_id) {}
+
+Capture Capture::CreateStreamingChild(const std::string& label) const {
+  return Capture(stream_, stream_->AddElement(element_id_, label));
 }
 
+template <typename Type>
+static void StreamProperty(CaptureStream& stream,
+                           uint32_t element_id,
+                           CaptureProperty::Type type,
+                           const std::string& label,
+                           const Type& value) {
+  static_assert(std::is_trivially_copyable_v<Type>);
+  stream.AddProperty(element_id, type, label, &value, sizeof(Type));
+}
+
+static void StreamProperty(CaptureStream& stream,
+                           uint32_t element_id,
+                           CaptureProperty::Type type,
+                           const std::string& label,
+                           const std::string& value) {
+  stream.AddProperty(element_id, type, label, value.data(), value.size());
+}
+#endif
+
 #ifdef IMPELLER_ENABLE_CAPTURE
 #define _CAPTURE_PROPERTY_RECORDER_DEFINITION(type_name, pascal_name,          \
                                               lower_name)                      \
@@ -123,6 +155,11 @@ void Capture::Rewind() {
     if (!active_) {                                                            \
       return value;                                                            \
     }                                                                          \
+    if (stream_) {                                                             \
+      StreamProperty(*stream_, element_id_,                                    \
+                     CaptureProperty::Type::k##pascal_name, label, value);     \
+      return value;                                                            \
+    }                                                                          \
     FML_DCHECK(element_ != nullptr);                                           \
                                                                                \
     auto new_value = Capture##pascal_name##Property::Make(                     \
@@ -145,9 +182,12 @@ _FOR_EACH_CAPTURE_PROPERTY(_CAPTURE_PROPERTY_RECORDER_DEFINITION);
 CaptureContext::CaptureContext() : active_(true) {}
 CaptureContext::CaptureContext(std::initializer_list<std::string> allowlist)
     : active_(true), allowlist_(allowlist) {}
+CaptureContext::CaptureContext(std::shared_ptr<CaptureStream> stream)
+    : active_(stream != nullptr), stream_(std::move(stream)) {}
 #else
 CaptureContext::CaptureContext() {}
 CaptureContext::CaptureContext(std::initializer_list<std::string> allowlist) {}
+CaptureContext::CaptureContext(std::shared_ptr<CaptureStream> stream) {}
 #endif
 
 CaptureContext::CaptureContext(CaptureContext::InactiveFlag) {}
@@ -161,6 +201,19 @@ CaptureContext CaptureContext::MakeAllowlist(
   return CaptureContext(allowlist);
 }
 
+CaptureContext CaptureContext::MakeStreaming(
+    std::shared_ptr<CaptureStream> stream) {
+  return CaptureContext(std::move(stream));
+}
+
+std::shared_ptr<CaptureStream> CaptureContext::GetStream() const {
+#ifdef IMPELLER_ENABLE_CAPTURE
+  return stream_;
+#else
+  return nullptr;
+#endif
+}
+
 bool CaptureContext::IsActive() const {
 #ifdef IMPELLER_ENABLE_CAPTURE
   return active_;
@@ -191,6 +244,10 @@ Capture CaptureContext::GetDocument(const std::string& label) {
     }
   }
 
+  if (stream_) {
+    return Capture(stream_, stream_->BeginFrame(label));
+  }
+
   auto found = documents_.find(label);
   if (found != documents_.end()) {
     // Always rewind when fetching an existing document.
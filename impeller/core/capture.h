@@ -25,6 +25,7 @@
 namespace impeller {
 
 struct CaptureProcTable;
+class CaptureStream;
 
 #define _FOR_EACH_CAPTURE_PROPERTY(PROPERTY_V) \
   PROPERTY_V(bool, Boolean, boolean)           \
@@ -236,6 +237,9 @@ class Capture {
     if (!active_) {
       return Capture();
     }
+    if (stream_) {
+      return CreateStreamingChild(label);
+    }
 
     auto new_capture = Capture(label);
     new_capture.element_ =
@@ -257,7 +261,16 @@ class Capture {
 #ifdef IMPELLER_ENABLE_CAPTURE
   std::shared_ptr<CaptureElement> element_;
   bool active_ = false;
+  // Set instead of `element_` when recording into a stream.
+  std::shared_ptr<CaptureStream> stream_;
+  uint32_t element_id_ = 0u;
+
+  Capture(std::shared_ptr<CaptureStream> stream, uint32_t element_id);
+
+  Capture CreateStreamingChild(const std::string& label) const;
 #endif
+
+  friend class CaptureContext;
 };
 
 class CaptureContext {
@@ -269,6 +282,21 @@ class CaptureContext {
   static CaptureContext MakeAllowlist(
       std::initializer_list<std::string> allowlist);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context that records the documents into a stream
+  ///             instead of keeping them for an inspector. Each document
+  ///             fetched starts a new frame in the stream.
+  ///
+  ///             Without capture support in the build, the context is inactive.
+  ///
+  static CaptureContext MakeStreaming(std::shared_ptr<CaptureStream> stream);
+
+  //----------------------------------------------------------------------------
+  /// @return     The stream documents are recorded into, if this is a
+  ///             streaming context.
+  ///
+  std::shared_ptr<CaptureStream> GetStream() const;
+
   bool IsActive() const;
 
   void Rewind();
@@ -281,9 +309,11 @@ class CaptureContext {
   struct InactiveFlag {};
   explicit CaptureContext(InactiveFlag);
   CaptureContext(std::initializer_list<std::string> allowlist);
+  explicit CaptureContext(std::shared_ptr<CaptureStream> stream);
 
 #ifdef IMPELLER_ENABLE_CAPTURE
   bool active_ = false;
+  std::shared_ptr<CaptureStream> stream_;
   std::optional<std::unordered_set<std::string>> allowlist_;
   std::unordered_map<std::string, Capture> documents_;
 #endif
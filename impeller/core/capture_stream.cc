@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/capture_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+// The magic number, the size of the records and the truncation flag.
+static constexpr size_t kFrameHeaderSize =
+    sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint8_t);
+static constexpr size_t kFrameSizeOffset = sizeof(uint32_t);
+static constexpr size_t kFrameTruncatedOffset =
+    kFrameSizeOffset + sizeof(uint32_t);
+
+std::shared_ptr<CaptureStream> CaptureStream::Make(size_t max_frames,
+                                                   size_t max_frame_bytes) {
+  return std::shared_ptr<CaptureStream>(
+      new CaptureStream(max_frames, max_frame_bytes));
+}
+
+CaptureStream::CaptureStream(size_t max_frames, size_t max_frame_bytes)
+    : max_frames_(std::max<size_t>(max_frames, 1u)),
+      max_frame_bytes_(std::max(max_frame_bytes, kFrameHeaderSize)),
+      thread_("io.flutter.impeller.capture") {}
+
+CaptureStream::~CaptureStream() {
+  // Frames still queued for the background thread are dropped with it.
+  thread_.Join();
+}
+
+uint32_t CaptureStream::BeginFrame(const std::string& label) {
+  FinishFrame();
+
+  recording_ = true;
+  truncated_ = false;
+  frame_.clear();
+  frame_strings_.clear();
+  Append(kFrameMagic);
+  Append(uint32_t{0u});
+  Append(uint8_t{0u});
+
+  return AddElement(0u, label);
+}
+
+uint32_t CaptureStream::AddElement(uint32_t parent_id,
+                                   const std::string& label) {
+  const uint32_t id = next_element_id_++;
+  if (!recording_) {
+    return id;
+  }
+  auto label_id = InternString(label);
+  if (!label_id.has_value() ||
+      !Reserve(sizeof(RecordType) + sizeof(uint32_t) * 2 + sizeof(uint16_t))) {
+    return id;
+  }
+  Append(RecordType::kElement);
+  Append(id);
+  Append(parent_id);
+  Append(label_id.value());
+  return id;
+}
+
+void CaptureStream::AddProperty(uint32_t element_id,
+                                CaptureProperty::Type type,
+                                const std::string& label,
+                                const void* value,
+                                size_t value_size) {
+  if (!recording_) {
+    return;
+  }
+  auto label_id = InternString(label);
+  if (!label_id.has_value() ||
+      !Reserve(sizeof(RecordType) + sizeof(uint32_t) + sizeof(uint8_t) +
+               sizeof(uint16_t) + sizeof(uint32_t) + value_size)) {
+    return;
+  }
+  Append(RecordType::kProperty);
+  Append(element_id);
+  Append(static_cast<uint8_t>(type));
+  Append(label_id.value());
+  Append(static_cast<uint32_t>(value_size));
+  const auto* bytes = reinterpret_cast<const uint8_t*>(value);
+  frame_.insert(frame_.end(), bytes, bytes + value_size);
+}
+
+std::vector<uint8_t> CaptureStream::Dump() {
+  FinishFrame();
+
+  std::vector<uint8_t> result;
+  fml::AutoResetWaitableEvent latch;
+  thread_.GetTaskRunner()->PostTask([&]() {
+    for (const auto& frame : frames_) {
+      result.insert(result.end(), frame.begin(), frame.end());
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+  return result;
+}
+
+void CaptureStream::FinishFrame() {
+  if (!recording_) {
+    return;
+  }
+  recording_ = false;
+
+  const uint32_t size = frame_.size() - kFrameHeaderSize;
+  std::memcpy(frame_.data() + kFrameSizeOffset, &size, sizeof(size));
+  frame_[kFrameTruncatedOffset] = truncated_ ? 1u : 0u;
+
+  // Keeping the ring, and freeing the frames that fall out of it, happens off
+  // of the recording thread.
+  thread_.GetTaskRunner()->PostTask(
+      [this, frame = std::move(frame_)]() mutable {
+        TRACE_EVENT0("impeller", "CaptureStream::FinishFrame");
+        frames_.push_back(std::move(frame));
+        while (frames_.size() > max_frames_) {
+          frames_.pop_front();
+        }
+      });
+  frame_ = {};
+}
+
+std::optional<uint16_t> CaptureStream::InternString(const std::string& string) {
+  auto found = frame_strings_.find(string);
+  if (found != frame_strings_.end()) {
+    return found->second;
+  }
+  if (frame_strings_.size() > std::numeric_limits<uint16_t>::max() ||
+      string.size() > std::numeric_limits<uint16_t>::max()) {
+    truncated_ = true;
+    return std::nullopt;
+  }
+  if (!Reserve(sizeof(RecordType) + sizeof(uint16_t) * 2 + string.size())) {
+    return std::nullopt;
+  }
+  const uint16_t id = frame_strings_.size();
+  frame_strings_[string] = id;
+  Append(RecordType::kString);
+  Append(id);
+  Append(static_cast<uint16_t>(string.size()));
+  frame_.insert(frame_.end(), string.begin(), string.end());
+  return id;
+}
+
+bool CaptureStream::Reserve(size_t size) {
+  // Once a record is dropped, all later ones are too, so that the recorded
+  // part of the frame stays consistent.
+  if (truncated_ || frame_.size() + size > max_frame_bytes_) {
+    truncated_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
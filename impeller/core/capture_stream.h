@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/thread.h"
+#include "impeller/core/capture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Records captured elements and properties into a compact binary
+///             stream instead of the tree of `CaptureElement`s used by
+///             inspectors.
+///
+///             Every document fetched from a streaming `CaptureContext` starts
+///             a new frame. Completed frames are handed to a background thread
+///             that keeps the most recent ones, and older frames are dropped.
+///             Frames that grow past the size limit stop recording and are
+///             marked as truncated.
+///
+///             The stream returned by `Dump` is a sequence of frames. All
+///             values are in host byte order.
+///
+///             Frame:    u32 kFrameMagic, u32 size of the records,
+///                       u8 truncated, records...
+///             String:   u8 kString, u16 id, u16 length, bytes...
+///             Element:  u8 kElement, u32 id, u32 parent id, u16 label id
+///             Property: u8 kProperty, u32 element id,
+///                       u8 CaptureProperty::Type, u16 label id, u32 size,
+///                       value bytes...
+///
+///             Strings are interned per frame, so every frame can be decoded
+///             on its own. The root element of a frame has a parent id of
+///             zero. Properties are stored as the bytes of their value type,
+///             and strings as their characters.
+///
+///             All methods must be called on the thread that records.
+///
+class CaptureStream final {
+ public:
+  static constexpr uint32_t kFrameMagic = 0x49504346;  // IPCF
+
+  enum class RecordType : uint8_t {
+    kString,
+    kElement,
+    kProperty,
+  };
+
+  static std::shared_ptr<CaptureStream> Make(size_t max_frames,
+                                             size_t max_frame_bytes);
+
+  ~CaptureStream();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Completes the frame being recorded, if any, and starts a new
+  ///             one.
+  ///
+  /// @return     The ID of the root element of the new frame.
+  ///
+  uint32_t BeginFrame(const std::string& label);
+
+  //----------------------------------------------------------------------------
+  /// @return     The ID of the new element.
+  ///
+  uint32_t AddElement(uint32_t parent_id, const std::string& label);
+
+  void AddProperty(uint32_t element_id,
+                   CaptureProperty::Type type,
+                   const std::string& label,
+                   const void* value,
+                   size_t value_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Completes the frame being recorded and returns the frames
+  ///             that are kept, oldest first.
+  ///
+  std::vector<uint8_t> Dump();
+
+ private:
+  const size_t max_frames_;
+  const size_t max_frame_bytes_;
+
+  // Only accessed on the recording thread.
+  bool recording_ = false;
+  std::vector<uint8_t> frame_;
+  std::unordered_map<std::string, uint16_t> frame_strings_;
+  uint32_t next_element_id_ = 1u;
+  bool truncated_ = false;
+
+  // Only accessed on the background thread.
+  std::deque<std::vector<uint8_t>> frames_;
+
+  fml::Thread thread_;
+
+  CaptureStream(size_t max_frames, size_t max_frame_bytes);
+
+  void FinishFrame();
+
+  std::optional<uint16_t> InternString(const std::string& string);
+
+  bool Reserve(size_t size);
+
+  template <typename T>
+  void Append(T value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    frame_.insert(frame_.end(), bytes, bytes + sizeof(T));
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CaptureStream);
+};
+
+}  // namespace impeller
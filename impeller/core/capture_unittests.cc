@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/capture.h"
+#include "impeller/core/capture_stream.h"
+
+namespace impeller {
+namespace testing {
+
+#ifdef IMPELLER_ENABLE_CAPTURE
+
+namespace {
+
+struct StreamReader {
+  const std::vector<uint8_t>& data;
+  size_t offset = 0;
+
+  template <typename T>
+  T Read() {
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+
+  std::string ReadString(size_t size) {
+    std::string value(reinterpret_cast<const char*>(data.data() + offset),
+                      size);
+    offset += size;
+    return value;
+  }
+};
+
+struct StreamFrame {
+  bool truncated = false;
+  std::vector<std::string> elements;
+  std::vector<std::string> properties;
+};
+
+// Decodes every frame into the labels of its elements and properties.
+std::vector<StreamFrame> DecodeStream(const std::vector<uint8_t>& data) {
+  std::vector<StreamFrame> frames;
+  StreamReader reader{data};
+  while (reader.offset < data.size()) {
+    EXPECT_EQ(reader.Read<uint32_t>(), CaptureStream::kFrameMagic);
+    const size_t size = reader.Read<uint32_t>();
+    StreamFrame frame;
+    frame.truncated = reader.Read<uint8_t>() != 0;
+    const size_t end = reader.offset + size;
+    std::vector<std::string> strings;
+    while (reader.offset < end) {
+      switch (reader.Read<CaptureStream::RecordType>()) {
+        case CaptureStream::RecordType::kString: {
+          EXPECT_EQ(reader.Read<uint16_t>(), strings.size());
+          strings.push_back(reader.ReadString(reader.Read<uint16_t>()));
+          break;
+        }
+        case CaptureStream::RecordType::kElement: {
+          reader.Read<uint32_t>();  // ID.
+          reader.Read<uint32_t>();  // Parent ID.
+          frame.elements.push_back(strings[reader.Read<uint16_t>()]);
+          break;
+        }
+        case CaptureStream::RecordType::kProperty: {
+          reader.Read<uint32_t>();  // Element ID.
+          reader.Read<uint8_t>();   // Type.
+          frame.properties.push_back(strings[reader.Read<uint16_t>()]);
+          reader.offset += reader.Read<uint32_t>();
+          break;
+        }
+      }
+    }
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(CaptureTest, StreamingContextRecordsFrames) {
+  auto stream = CaptureStream::Make(/*max_frames=*/2u,
+                                    /*max_frame_bytes=*/1024u);
+  auto context = CaptureContext::MakeStreaming(stream);
+  ASSERT_TRUE(context.IsActive());
+
+  for (int frame = 0; frame < 3; frame++) {
+    auto document = context.GetDocument("Frame");
+    auto child = document.CreateChild("Entity");
+    ASSERT_EQ(child.AddInteger("Frame", frame), frame);
+    ASSERT_EQ(child.AddString("Name", "Hello"), "Hello");
+    ASSERT_EQ(child.GetElement(), nullptr);
+  }
+
+  // Only the last two frames are kept.
+  auto frames = DecodeStream(stream->Dump());
+  ASSERT_EQ(frames.size(), 2u);
+  for (const auto& frame : frames) {
+    ASSERT_FALSE(frame.truncated);
+    ASSERT_EQ(frame.elements, (std::vector<std::string>{"Frame", "Entity"}));
+    ASSERT_EQ(frame.properties, (std::vector<std::string>{"Frame", "Name"}));
+  }
+}
+
+TEST(CaptureTest, StreamingTruncatesLargeFrames) {
+  auto stream = CaptureStream::Make(/*max_frames=*/1u,
+                                    /*max_frame_bytes=*/64u);
+  auto context = CaptureContext::MakeStreaming(stream);
+
+  auto document = context.GetDocument("Frame");
+  for (int i = 0; i < 100; i++) {
+    document.AddMatrix("Transform", Matrix());
+  }
+
+  auto frames = DecodeStream(stream->Dump());
+  ASSERT_EQ(frames.size(), 1u);
+  ASSERT_TRUE(frames[0].truncated);
+  ASSERT_EQ(frames[0].elements, (std::vector<std::string>{"Frame"}));
+  ASSERT_TRUE(frames[0].properties.empty());
+}
+
+#endif  // IMPELLER_ENABLE_CAPTURE
+
+TEST(CaptureTest, StreamingContextWithoutStreamIsInactive) {
+  ASSERT_FALSE(CaptureContext::MakeStreaming(nullptr).IsActive());
+}
+
+}  // namespace testing
+}  // namespace impeller
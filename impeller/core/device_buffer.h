@@ -45,6 +45,13 @@ class DeviceBuffer : public Buffer,
 
   virtual uint8_t* OnGetContents() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes writes made through the contents of a host visible
+  ///             buffer within `range` visible to the device. Does nothing
+  ///             for host coherent memory.
+  ///
+  virtual void Flush(Range range) const;
+
  protected:
   const DeviceBufferDescriptor desc_;
 
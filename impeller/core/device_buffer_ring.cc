@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/device_buffer_ring.h"
+
+#include <algorithm>
+
+#include "impeller/core/device_buffer_descriptor.h"
+#include "impeller/core/formats.h"
+
+namespace impeller {
+
+std::shared_ptr<DeviceBufferRing> DeviceBufferRing::Create(
+    std::shared_ptr<Allocator> allocator,
+    size_t block_length) {
+  if (!allocator || block_length == 0u) {
+    return nullptr;
+  }
+  auto ring = std::shared_ptr<DeviceBufferRing>(
+      new DeviceBufferRing(std::move(allocator), block_length));
+  // Keep the block used to check that the buffers are mapped for the first
+  // host buffer.
+  auto block = ring->CreateBlock(block_length);
+  if (!block) {
+    return nullptr;
+  }
+  ring->ReleaseBlock(std::move(block));
+  return ring;
+}
+
+DeviceBufferRing::DeviceBufferRing(std::shared_ptr<Allocator> allocator,
+                                   size_t block_length)
+    : allocator_(std::move(allocator)), block_length_(block_length) {}
+
+DeviceBufferRing::~DeviceBufferRing() = default;
+
+size_t DeviceBufferRing::GetBlockLength() const {
+  return block_length_;
+}
+
+std::shared_ptr<DeviceBuffer> DeviceBufferRing::CreateBlock(
+    size_t length) const {
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = length;
+  auto block = allocator_->CreateBuffer(desc);
+  if (!block || block->OnGetContents() == nullptr) {
+    return nullptr;
+  }
+  block->SetLabel("DeviceBufferRing Block");
+  return block;
+}
+
+std::shared_ptr<DeviceBuffer> DeviceBufferRing::AcquireBlock(size_t length) {
+  {
+    Lock lock(mutex_);
+    // Blocks are released in the order their command buffers were submitted,
+    // so the oldest ones are the most likely to be done.
+    auto found = std::find_if(
+        released_blocks_.begin(), released_blocks_.end(),
+        [length](const std::shared_ptr<DeviceBuffer>& block) {
+          return block.use_count() == 1 &&
+                 block->GetDeviceBufferDescriptor().size >= length;
+        });
+    if (found != released_blocks_.end()) {
+      auto block = std::move(*found);
+      released_blocks_.erase(found);
+      return block;
+    }
+  }
+  return CreateBlock(std::max(length, block_length_));
+}
+
+void DeviceBufferRing::ReleaseBlock(std::shared_ptr<DeviceBuffer> block) {
+  if (!block) {
+    return;
+  }
+  Lock lock(mutex_);
+  released_blocks_.push_back(std::move(block));
+  if (released_blocks_.size() <= kMaxIdleBlocks) {
+    return;
+  }
+  // Drop the oldest block that is no longer in use. Blocks that are still in
+  // flight are kept, even past the limit, since they will be needed again as
+  // soon as the GPU catches up.
+  auto idle = std::find_if(
+      released_blocks_.begin(), released_blocks_.end(),
+      [](const std::shared_ptr<DeviceBuffer>& released_block) {
+        return released_block.use_count() == 1;
+      });
+  if (idle != released_blocks_.end()) {
+    released_blocks_.erase(idle);
+  }
+}
+
+size_t DeviceBufferRing::GetReleasedBlockCount() const {
+  Lock lock(mutex_);
+  return released_blocks_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A ring of persistently mapped, host visible device buffers that
+///             host buffers write into directly instead of being copied into
+///             a new device buffer every time they are encoded.
+///
+///             Blocks are handed back to the ring when the host buffer using
+///             them is reset, but are only reused once nothing else holds a
+///             reference to them. The backends keep a reference to every
+///             buffer bound by a command buffer until the GPU has finished
+///             executing it, so a block is never overwritten while it is
+///             being read. The ring grows to as many blocks as are in flight.
+///
+class DeviceBufferRing {
+ public:
+  static constexpr size_t kDefaultBlockLength = 256u * 1024u;
+  static constexpr size_t kMaxIdleBlocks = 32u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a ring that allocates its blocks from `allocator`.
+  ///
+  /// @return     The ring, or nullptr if the host visible buffers of the
+  ///             allocator can't be mapped, in which case host buffers have
+  ///             to be copied to the device.
+  ///
+  static std::shared_ptr<DeviceBufferRing> Create(
+      std::shared_ptr<Allocator> allocator,
+      size_t block_length = kDefaultBlockLength);
+
+  ~DeviceBufferRing();
+
+  size_t GetBlockLength() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a mapped block of at least `length` bytes, reusing
+  ///             the oldest released block that is no longer in use.
+  ///
+  std::shared_ptr<DeviceBuffer> AcquireBlock(size_t length);
+
+  void ReleaseBlock(std::shared_ptr<DeviceBuffer> block);
+
+  size_t GetReleasedBlockCount() const;
+
+ private:
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t block_length_;
+  mutable Mutex mutex_;
+  std::deque<std::shared_ptr<DeviceBuffer>> released_blocks_
+      IPLR_GUARDED_BY(mutex_);
+
+  DeviceBufferRing(std::shared_ptr<Allocator> allocator, size_t block_length);
+
+  std::shared_ptr<DeviceBuffer> CreateBlock(size_t length) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DeviceBufferRing);
+};
+
+}  // namespace impeller
@@ -10,7 +10,7 @@
 #include <string>
 #include <type_traits>
 
-#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/color.h"
@@ -109,6 +109,11 @@ enum class PixelFormat {
   kS8UInt,
   kD24UnormS8Uint,
   kD32FloatS8UInt,
+  // Block compressed formats. These can only be sampled from and their
+  // contents have to be set in whole blocks of 4x4 pixels.
+  kASTC4x4UNormInt,
+  kETC2R8G8B8A8UNormInt,
+  kBC7UNormInt,
 };
 
 constexpr const char* PixelFormatToString(PixelFormat format) {
@@ -145,6 +150,12 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "D24UnormS8Uint";
     case PixelFormat::kD32FloatS8UInt:
       return "D32FloatS8UInt";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kBC7UNormInt:
+      return "BC7UNormInt";
   }
   FML_UNREACHABLE();
 }
@@ -418,6 +429,25 @@ enum class ColorWriteMask : uint64_t {
   kAll = kRed | kGreen | kBlue | kAlpha,
 };
 
+constexpr bool PixelFormatIsBlockCompressed(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// The width and height of the blocks that the pixels of a block compressed
+/// format are stored in, which is 1 for every other format.
+constexpr int64_t BlockSizeForPixelFormat(PixelFormat format) {
+  return PixelFormatIsBlockCompressed(format) ? 4 : 1;
+}
+
+/// For block compressed formats, the average over a block. Each of their
+/// blocks of 4x4 pixels takes up 16 bytes.
 constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -425,6 +455,9 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
     case PixelFormat::kA8UNormInt:
     case PixelFormat::kR8UNormInt:
     case PixelFormat::kS8UInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return 1u;
     case PixelFormat::kR8G8UNormInt:
       return 2u;
@@ -498,10 +531,10 @@ struct ColorAttachmentDescriptor {
   }
 
   constexpr size_t Hash() const {
-    return fml::HashCombine(format, blending_enabled, src_color_blend_factor,
-                            color_blend_op, dst_color_blend_factor,
-                            src_alpha_blend_factor, alpha_blend_op,
-                            dst_alpha_blend_factor, write_mask);
+    return fml::FastHash(format, blending_enabled, src_color_blend_factor,
+                         color_blend_op, dst_color_blend_factor,
+                         src_alpha_blend_factor, alpha_blend_op,
+                         dst_alpha_blend_factor, write_mask);
   }
 };
 
@@ -559,7 +592,7 @@ struct DepthAttachmentDescriptor {
   }
 
   constexpr size_t GetHash() const {
-    return fml::HashCombine(depth_compare, depth_write_enabled);
+    return fml::FastHash(depth_compare, depth_write_enabled);
   }
 };
 
@@ -604,8 +637,8 @@ struct StencilAttachmentDescriptor {
   }
 
   constexpr size_t GetHash() const {
-    return fml::HashCombine(stencil_compare, stencil_failure, depth_failure,
-                            depth_stencil_pass, read_mask, write_mask);
+    return fml::FastHash(stencil_compare, stencil_failure, depth_failure,
+                         depth_stencil_pass, read_mask, write_mask);
   }
 };
 
@@ -21,15 +21,38 @@ std::shared_ptr<HostBuffer> HostBuffer::Create() {
 
 HostBuffer::HostBuffer() = default;
 
-HostBuffer::~HostBuffer() = default;
+HostBuffer::~HostBuffer() {
+  ReleaseDeviceBlocks();
+}
 
 void HostBuffer::SetLabel(std::string label) {
   label_ = std::move(label);
 }
 
+void HostBuffer::SetDeviceBufferRing(std::shared_ptr<DeviceBufferRing> ring) {
+  FML_DCHECK(GetLength() == 0u && device_blocks_.empty());
+  ring_ = std::move(ring);
+}
+
+const std::vector<std::shared_ptr<DeviceBuffer>>& HostBuffer::GetDeviceBlocks()
+    const {
+  return device_blocks_;
+}
+
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (ring_) {
+    auto view = EmplaceInDeviceBlock(length, align, [&](uint8_t* contents) {
+      if (buffer) {
+        ::memmove(contents, buffer, length);
+      }
+    });
+    if (view) {
+      return view;
+    }
+  }
+
   if (align == 0 || (GetLength() % align) == 0) {
     return Emplace(buffer, length);
   }
@@ -62,6 +85,18 @@ BufferView HostBuffer::Emplace(size_t length,
   if (!cb) {
     return {};
   }
+  if (ring_) {
+    auto view = EmplaceInDeviceBlock(length, align, cb);
+    if (view) {
+      return view;
+    }
+  }
+  if (align > 1u && (GetLength() % align) != 0u) {
+    auto pad = Emplace(nullptr, align - (GetLength() % align));
+    if (!pad) {
+      return {};
+    }
+  }
   auto old_length = GetLength();
   if (!Truncate(old_length + length)) {
     return {};
@@ -72,6 +107,33 @@ BufferView HostBuffer::Emplace(size_t length,
   return BufferView{shared_from_this(), GetBuffer(), Range{old_length, length}};
 }
 
+BufferView HostBuffer::EmplaceInDeviceBlock(size_t length,
+                                            size_t align,
+                                            const EmplaceProc& cb) {
+  size_t offset = device_block_offset_;
+  if (align > 1u && offset % align != 0u) {
+    offset += align - offset % align;
+  }
+  if (device_blocks_.empty() ||
+      offset + length >
+          device_blocks_.back()->GetDeviceBufferDescriptor().size) {
+    auto block = ring_->AcquireBlock(length);
+    if (!block) {
+      // Fall back to copying the data to the device from host memory.
+      return {};
+    }
+    device_blocks_.push_back(std::move(block));
+    offset = 0u;
+  }
+
+  const auto& block = device_blocks_.back();
+  uint8_t* contents = block->OnGetContents();
+  cb(contents + offset);
+  block->Flush(Range{offset, length});
+  device_block_offset_ = offset + length;
+  return BufferView{block, contents, Range{offset, length}};
+}
+
 std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
     Allocator& allocator) const {
   if (generation_ == device_buffer_generation_) {
@@ -90,10 +152,21 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
 void HostBuffer::Reset() {
   generation_ += 1;
   device_buffer_ = nullptr;
+  ReleaseDeviceBlocks();
   bool did_truncate = Truncate(0);
   FML_CHECK(did_truncate);
 }
 
+void HostBuffer::ReleaseDeviceBlocks() {
+  if (ring_) {
+    for (auto& block : device_blocks_) {
+      ring_->ReleaseBlock(std::move(block));
+    }
+  }
+  device_blocks_.clear();
+  device_block_offset_ = 0u;
+}
+
 size_t HostBuffer::GetSize() const {
   return GetReservedLength();
 }
@@ -8,11 +8,13 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/buffer.h"
 #include "impeller/core/buffer_view.h"
+#include "impeller/core/device_buffer_ring.h"
 #include "impeller/core/platform.h"
 
 namespace impeller {
@@ -28,6 +30,24 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   void SetLabel(std::string label);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the data emplaced from now on be written directly into
+  ///             the mapped blocks of `ring` instead of being copied to a new
+  ///             device buffer when the buffer is encoded. Passing nullptr
+  ///             goes back to accumulating the data in host memory.
+  ///
+  ///             The buffer must be empty.
+  ///
+  void SetDeviceBufferRing(std::shared_ptr<DeviceBufferRing> ring);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The device buffers the emplaced data was written into since
+  ///             the last reset. Backends that don't otherwise keep the
+  ///             buffers they bind alive until the GPU has finished with them
+  ///             must hold on to these.
+  ///
+  const std::vector<std::shared_ptr<DeviceBuffer>>& GetDeviceBlocks() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Emplace uniform data onto the host buffer. Ensure that backend
   ///             specific uniform alignment requirements are respected.
@@ -113,7 +133,7 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
-  ///        reused.
+  ///        reused. The device blocks are handed back to the ring.
   void Reset();
 
   //----------------------------------------------------------------------------
@@ -125,6 +145,9 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
   mutable size_t device_buffer_generation_ = 0u;
   size_t generation_ = 1u;
   std::string label_;
+  std::shared_ptr<DeviceBufferRing> ring_;
+  std::vector<std::shared_ptr<DeviceBuffer>> device_blocks_;
+  size_t device_block_offset_ = 0u;
 
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
@@ -132,6 +155,12 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
+  [[nodiscard]] BufferView EmplaceInDeviceBlock(size_t length,
+                                                size_t align,
+                                                const EmplaceProc& cb);
+
+  void ReleaseDeviceBlocks();
+
   HostBuffer();
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
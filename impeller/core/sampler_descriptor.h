@@ -35,9 +35,9 @@ struct SamplerDescriptor final : public Comparable<SamplerDescriptor> {
 
   // Comparable<SamplerDescriptor>
   std::size_t GetHash() const override {
-    return fml::HashCombine(min_filter, mag_filter, mip_filter,
-                            width_address_mode, height_address_mode,
-                            depth_address_mode);
+    return fml::FastHash(min_filter, mag_filter, mip_filter,
+                         width_address_mode, height_address_mode,
+                         depth_address_mode);
   }
 
   // Comparable<SamplerDescriptor>
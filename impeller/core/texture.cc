@@ -4,6 +4,7 @@
 
 #include "impeller/core/texture.h"
 
+#include "flutter/fml/trace_counters.h"
 #include "impeller/base/validation.h"
 
 namespace impeller {
@@ -23,6 +24,7 @@ bool Texture::SetContents(const uint8_t* contents,
   if (!OnSetContents(contents, length, slice)) {
     return false;
   }
+  FML_PERFORMANCE_COUNTER_ADD("textureUploadBytes", length);
   coordinate_system_ = TextureCoordinateSystem::kUploadFromHost;
   is_opaque_ = is_opaque;
   return true;
@@ -38,9 +40,11 @@ bool Texture::SetContents(std::shared_ptr<const fml::Mapping> mapping,
   if (!mapping) {
     return false;
   }
+  const size_t length = mapping->GetSize();
   if (!OnSetContents(std::move(mapping), slice)) {
     return false;
   }
+  FML_PERFORMANCE_COUNTER_ADD("textureUploadBytes", length);
   coordinate_system_ = TextureCoordinateSystem::kUploadFromHost;
   is_opaque_ = is_opaque;
   return true;
@@ -51,14 +51,19 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    const auto block_size = BlockSizeForPixelFormat(format);
+    return GetBytesPerRow() * ((size.height + block_size - 1) / block_size);
   }
 
+  /// For block compressed formats, the size of a row of blocks. Partial
+  /// blocks at the edges are stored as whole blocks.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    const auto block_size = BlockSizeForPixelFormat(format);
+    return ((size.width + block_size - 1) / block_size) * block_size *
+           block_size * BytesPerPixelForPixelFormat(format);
   }
 
   constexpr bool SamplingOptionsAreValid() const {
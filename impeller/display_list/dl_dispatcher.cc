@@ -12,7 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/aiks/color_filter.h"
 #include "impeller/core/formats.h"
@@ -30,6 +32,7 @@
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/vertices_geometry.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/scalar.h"
@@ -808,6 +811,36 @@ void DlDispatcher::drawRect(const SkRect& rect) {
   canvas_.DrawRect(skia_conversions::ToRect(rect), paint_);
 }
 
+// |flutter::DlOpReceiver|
+void DlDispatcher::drawRects(const SkRect rects[], uint32_t count) {
+  // Filled rects can be drawn as the triangles of a single vertices entity.
+  // The triangles are blended in order just like separate rect entities as
+  // long as no filter or advanced blend has to see the rects as a whole.
+  if (count == 0 || paint_.style != Paint::Style::kFill ||
+      paint_.mask_blur_descriptor.has_value() || paint_.image_filter ||
+      paint_.HasColorFilter() || paint_.invert_colors ||
+      paint_.blend_mode > Entity::kLastPipelineBlendMode) {
+    flutter::DlOpReceiver::drawRects(rects, count);
+    return;
+  }
+
+  std::vector<Point> positions;
+  positions.reserve(count * 6);
+  SkRect bounds = rects[0].makeSorted();
+  for (uint32_t i = 0; i < count; i++) {
+    const Rect rect = skia_conversions::ToRect(rects[i]);
+    const auto points = rect.GetPoints();
+    positions.insert(positions.end(), {points[0], points[1], points[3],
+                                       points[0], points[3], points[2]});
+    bounds.join(rects[i].makeSorted());
+  }
+  auto geometry = std::make_shared<VerticesGeometry>(
+      std::move(positions), std::vector<uint16_t>(), std::vector<Point>(),
+      std::vector<Color>(), skia_conversions::ToRect(bounds),
+      VerticesGeometry::VertexMode::kTriangles);
+  canvas_.DrawVertices(geometry, BlendMode::kSourceOver, paint_);
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawOval(const SkRect& bounds) {
   if (bounds.width() == bounds.height()) {
@@ -966,6 +999,19 @@ void DlDispatcher::drawImageRect(
     flutter::DlImageSampling sampling,
     bool render_with_attributes,
     SrcRectConstraint constraint = SrcRectConstraint::kFast) {
+  if (image->isImpellerYUV()) {
+    const auto* yuv_image = static_cast<const DlImageImpeller*>(image.get());
+    canvas_.DrawYUVImageRect(
+        yuv_image->y_texture(),                     // luma plane
+        yuv_image->uv_texture(),                    // chroma plane
+        yuv_image->yuv_color_space(),               // color space
+        skia_conversions::ToRect(src),              // source rect
+        skia_conversions::ToRect(dst),              // destination rect
+        render_with_attributes ? paint_ : Paint(),  // paint
+        ToSamplerDescriptor(sampling)               // sampling
+    );
+    return;
+  }
   canvas_.DrawImageRect(
       std::make_shared<Image>(image->impeller_texture()),  // image
       skia_conversions::ToRect(src),                       // source rect
@@ -1038,9 +1084,12 @@ void DlDispatcher::drawDisplayList(
     canvas_.SaveLayer(save_paint);
   }
 
-  // TODO(131445): Remove this restriction if we can correctly cull with
-  // perspective transforms.
-  if (display_list->has_rtree() && !initial_matrix_.HasPerspective()) {
+  if (DrawCachedDisplayList(display_list)) {
+    // The picture cache drew the list.
+  } else if (display_list->has_rtree() && !initial_matrix_.HasPerspective()) {
+    // TODO(131445): Remove this restriction if we can correctly cull with
+    // perspective transforms.
+    //
     // The canvas remembers the screen-space culling bounds clipped by
     // the surface and the history of clip calls. DisplayList can cull
     // the ops based on a rectangle expressed in its "destination bounds"
@@ -1066,6 +1115,34 @@ void DlDispatcher::drawDisplayList(
   paint_ = saved_paint;
 }
 
+bool DlDispatcher::DrawCachedDisplayList(
+    const sk_sp<flutter::DisplayList>& display_list) {
+  if (!picture_cache_) {
+    return false;
+  }
+  // Cached pictures hold every op of the list, as they are drawn again with
+  // other clips and cull rects.
+  auto cached = picture_cache_->GetPicture(
+      display_list, initial_matrix_, [&display_list](const Matrix& transform) {
+        DlDispatcher recorder;
+        recorder.canvas_.Transform(transform);
+        recorder.initial_matrix_ = transform;
+        display_list->Dispatch(recorder);
+        return recorder.EndRecordingAsPicture();
+      });
+  if (!cached.picture) {
+    return false;
+  }
+  // The entities of the picture already have the transform they were
+  // recorded with, which only differs from the current one in translation.
+  canvas_.ResetTransform();
+  const Matrix& recorded = cached.transform;
+  canvas_.Translate({initial_matrix_.m[12] - recorded.m[12],
+                     initial_matrix_.m[13] - recorded.m[13], 0.0f});
+  canvas_.DrawPicture(*cached.picture);
+  return true;
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                 SkScalar x,
@@ -1161,4 +1238,127 @@ Picture DlDispatcher::EndRecordingAsPicture() {
   return canvas_.EndRecordingAsPicture();
 }
 
+namespace {
+
+// Forwards only the attribute changes of the ops dispatched to it. This keeps
+// the paint of a dispatcher in step with ops that are converted elsewhere,
+// since attributes are not saved and restored with the layers that use them.
+class AttributeForwarder final : public flutter::IgnoreClipDispatchHelper,
+                                 public flutter::IgnoreTransformDispatchHelper,
+                                 public flutter::IgnoreDrawDispatchHelper {
+ public:
+  explicit AttributeForwarder(flutter::DlOpReceiver& receiver)
+      : receiver_(receiver) {}
+
+  void setAntiAlias(bool aa) override { receiver_.setAntiAlias(aa); }
+  void setDither(bool dither) override { receiver_.setDither(dither); }
+  void setDrawStyle(flutter::DlDrawStyle style) override {
+    receiver_.setDrawStyle(style);
+  }
+  void setColor(flutter::DlColor color) override { receiver_.setColor(color); }
+  void setStrokeWidth(float width) override {
+    receiver_.setStrokeWidth(width);
+  }
+  void setStrokeMiter(float limit) override {
+    receiver_.setStrokeMiter(limit);
+  }
+  void setStrokeCap(flutter::DlStrokeCap cap) override {
+    receiver_.setStrokeCap(cap);
+  }
+  void setStrokeJoin(flutter::DlStrokeJoin join) override {
+    receiver_.setStrokeJoin(join);
+  }
+  void setColorSource(const flutter::DlColorSource* source) override {
+    receiver_.setColorSource(source);
+  }
+  void setColorFilter(const flutter::DlColorFilter* filter) override {
+    receiver_.setColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    receiver_.setInvertColors(invert);
+  }
+  void setBlendMode(flutter::DlBlendMode mode) override {
+    receiver_.setBlendMode(mode);
+  }
+  void setPathEffect(const flutter::DlPathEffect* effect) override {
+    receiver_.setPathEffect(effect);
+  }
+  void setMaskFilter(const flutter::DlMaskFilter* filter) override {
+    receiver_.setMaskFilter(filter);
+  }
+  void setImageFilter(const flutter::DlImageFilter* filter) override {
+    receiver_.setImageFilter(filter);
+  }
+
+ private:
+  flutter::DlOpReceiver& receiver_;
+};
+
+}  // namespace
+
+void DlDispatcher::SetPictureCache(DlPictureCache* picture_cache) {
+  picture_cache_ = picture_cache;
+}
+
+void DlDispatcher::DispatchConcurrently(
+    const flutter::DisplayList& display_list,
+    const SkIRect& cull_rect,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  // Paths start generating their vertices on the workers as soon as they are
+  // dispatched, including the ones dispatched on this thread.
+  canvas_.SetGeometryPrefetchTaskRunner(worker_task_runner);
+  if (!worker_task_runner ||
+      !SkRect::Make(cull_rect).contains(display_list.bounds())) {
+    display_list.Dispatch(*this, cull_rect);
+    return;
+  }
+  std::vector<flutter::DisplayList::Partition> partitions =
+      display_list.PartitionAtTopLevelSaveLayers();
+  size_t layer_count = std::count_if(
+      partitions.begin(), partitions.end(),
+      [](const auto& partition) { return partition.is_save_layer; });
+  if (layer_count < 2u) {
+    display_list.Dispatch(*this);
+    return;
+  }
+  TRACE_EVENT0("impeller", "DisplayListDispatcher::DispatchConcurrently");
+
+  struct LayerRecording {
+    EntityPass* reservation;
+    std::unique_ptr<DlDispatcher> dispatcher;
+  };
+  std::vector<LayerRecording> recordings;
+  recordings.reserve(layer_count);
+  fml::CountDownLatch latch(layer_count);
+  AttributeForwarder attribute_forwarder(*this);
+  for (const auto& partition : partitions) {
+    if (!partition.is_save_layer) {
+      display_list.Dispatch(*this, partition);
+      continue;
+    }
+    auto dispatcher = std::make_unique<DlDispatcher>();
+    dispatcher->paint_ = paint_;
+    dispatcher->initial_matrix_ = initial_matrix_;
+    dispatcher->picture_cache_ = picture_cache_;
+    EntityPass* reservation =
+        canvas_.BeginDetachedRecording(dispatcher->canvas_);
+    worker_task_runner->PostTask(
+        [&display_list, &partition, &latch, dispatcher = dispatcher.get()]() {
+          TRACE_EVENT0("impeller", "DisplayListDispatcher::DispatchLayer");
+          display_list.Dispatch(*dispatcher, partition);
+          latch.CountDown();
+        });
+    recordings.push_back({reservation, std::move(dispatcher)});
+
+    // The layer may change attributes that the following partitions use.
+    display_list.Dispatch(attribute_forwarder, partition);
+  }
+  latch.Wait();
+
+  for (auto& recording : recordings) {
+    canvas_.EndDetachedRecording(recording.reservation,
+                                 recording.dispatcher->canvas_);
+  }
+}
+
 }  // namespace impeller
@@ -4,10 +4,15 @@
 
 #pragma once
 
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/paint.h"
+#include "impeller/display_list/dl_picture_cache.h"
 
 namespace impeller {
 
@@ -23,6 +28,35 @@ class DlDispatcher final : public flutter::DlOpReceiver {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief  Dispatches |display_list| into this dispatcher, converting its
+  ///         top level save layers into entities concurrently on
+  ///         |worker_task_runner|.
+  ///
+  ///         The result is the same as dispatching |display_list| with
+  ///         |cull_rect|. Lists that need to be culled or that have fewer
+  ///         than two top level save layers are dispatched on the calling
+  ///         thread alone.
+  ///
+  ///         Either way, the vertices of the paths are generated on
+  ///         |worker_task_runner| as the paths are dispatched, and collected
+  ///         in order when the picture is rendered.
+  ///
+  /// @see    flutter::DisplayList::PartitionAtTopLevelSaveLayers
+  /// @see    Canvas::SetGeometryPrefetchTaskRunner
+  ///
+  void DispatchConcurrently(
+      const flutter::DisplayList& display_list,
+      const SkIRect& cull_rect,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Draws the display lists drawn with `drawDisplayList` from the
+  ///         pictures in |picture_cache| when it has them, instead of
+  ///         converting them again. The cache must outlive this dispatcher.
+  ///
+  void SetPictureCache(DlPictureCache* picture_cache);
+
   // |flutter::DlOpReceiver|
   void setAntiAlias(bool aa) override;
 
@@ -141,6 +175,9 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   // |flutter::DlOpReceiver|
   void drawRect(const SkRect& rect) override;
 
+  // |flutter::DlOpReceiver|
+  void drawRects(const SkRect rects[], uint32_t count) override;
+
   // |flutter::DlOpReceiver|
   void drawOval(const SkRect& bounds) override;
 
@@ -228,6 +265,9 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  DlPictureCache* picture_cache_ = nullptr;
+
+  bool DrawCachedDisplayList(const sk_sp<flutter::DisplayList>& display_list);
 
   FML_DISALLOW_COPY_AND_ASSIGN(DlDispatcher);
 };
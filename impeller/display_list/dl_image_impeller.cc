@@ -18,14 +18,11 @@ sk_sp<DlImageImpeller> DlImageImpeller::Make(std::shared_ptr<Texture> texture,
       new DlImageImpeller(std::move(texture), owning_context));
 }
 
-sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
+static std::shared_ptr<Texture> ConvertYUVToRGB(
     AiksContext* aiks_context,
     std::shared_ptr<Texture> y_texture,
     std::shared_ptr<Texture> uv_texture,
     YUVColorSpace yuv_color_space) {
-  if (!aiks_context || !y_texture || !uv_texture) {
-    return nullptr;
-  }
   auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
       std::move(y_texture), std::move(uv_texture), yuv_color_space);
   impeller::Entity entity;
@@ -40,13 +37,49 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
   if (!snapshot.has_value()) {
     return nullptr;
   }
-  return impeller::DlImageImpeller::Make(snapshot->texture);
+  return snapshot->texture;
+}
+
+sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
+    AiksContext* aiks_context,
+    std::shared_ptr<Texture> y_texture,
+    std::shared_ptr<Texture> uv_texture,
+    YUVColorSpace yuv_color_space) {
+  if (!aiks_context || !y_texture || !uv_texture) {
+    return nullptr;
+  }
+  return impeller::DlImageImpeller::Make(
+      ConvertYUVToRGB(aiks_context, std::move(y_texture),
+                      std::move(uv_texture), yuv_color_space));
+}
+
+sk_sp<DlImageImpeller> DlImageImpeller::MakeYUV(
+    AiksContext* aiks_context,
+    std::shared_ptr<Texture> y_texture,
+    std::shared_ptr<Texture> uv_texture,
+    YUVColorSpace yuv_color_space) {
+  if (!aiks_context || !y_texture || !uv_texture) {
+    return nullptr;
+  }
+  return sk_sp<DlImageImpeller>(
+      new DlImageImpeller(aiks_context, std::move(y_texture),
+                          std::move(uv_texture), yuv_color_space));
 }
 
 DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
                                  OwningContext owning_context)
     : texture_(std::move(texture)), owning_context_(owning_context) {}
 
+DlImageImpeller::DlImageImpeller(AiksContext* aiks_context,
+                                 std::shared_ptr<Texture> y_texture,
+                                 std::shared_ptr<Texture> uv_texture,
+                                 YUVColorSpace yuv_color_space)
+    : owning_context_(OwningContext::kRaster),
+      aiks_context_(aiks_context),
+      y_texture_(std::move(y_texture)),
+      uv_texture_(std::move(uv_texture)),
+      yuv_color_space_(yuv_color_space) {}
+
 // |DlImage|
 DlImageImpeller::~DlImageImpeller() = default;
 
@@ -57,9 +90,18 @@ sk_sp<SkImage> DlImageImpeller::skia_image() const {
 
 // |DlImage|
 std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_texture() const {
+  if (!texture_ && isImpellerYUV()) {
+    texture_ = ConvertYUVToRGB(aiks_context_, y_texture_, uv_texture_,
+                               yuv_color_space_);
+  }
   return texture_;
 }
 
+// |DlImage|
+bool DlImageImpeller::isImpellerYUV() const {
+  return y_texture_ && uv_texture_;
+}
+
 // |DlImage|
 bool DlImageImpeller::isOpaque() const {
   // Impeller doesn't currently implement opaque alpha types.
@@ -80,15 +122,18 @@ bool DlImageImpeller::isUIThreadSafe() const {
 
 // |DlImage|
 SkISize DlImageImpeller::dimensions() const {
-  const auto size = texture_ ? texture_->GetSize() : ISize{};
+  const auto& texture = isImpellerYUV() ? y_texture_ : texture_;
+  const auto size = texture ? texture->GetSize() : ISize{};
   return SkISize::Make(size.width, size.height);
 }
 
 // |DlImage|
 size_t DlImageImpeller::GetApproximateByteSize() const {
   auto size = sizeof(*this);
-  if (texture_) {
-    size += texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  for (const auto& texture : {texture_, y_texture_, uv_texture_}) {
+    if (texture) {
+      size += texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
   }
   return size;
 }
@@ -24,6 +24,19 @@ class DlImageImpeller final : public flutter::DlImage {
       std::shared_ptr<Texture> uv_texture,
       YUVColorSpace yuv_color_space);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps the planes of a YUV image without converting them.
+  ///             Drawing the image samples both planes and converts them to
+  ///             RGB in the same pass. Anything that needs the image as a
+  ///             single RGB texture, see |impeller_texture|, converts it with
+  ///             the `aiks_context` on first use, which must still be alive
+  ///             then.
+  ///
+  static sk_sp<DlImageImpeller> MakeYUV(AiksContext* aiks_context,
+                                        std::shared_ptr<Texture> y_texture,
+                                        std::shared_ptr<Texture> uv_texture,
+                                        YUVColorSpace yuv_color_space);
+
   // |DlImage|
   ~DlImageImpeller() override;
 
@@ -33,6 +46,9 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   std::shared_ptr<impeller::Texture> impeller_texture() const override;
 
+  // |DlImage|
+  bool isImpellerYUV() const override;
+
   // |DlImage|
   bool isOpaque() const override;
 
@@ -51,13 +67,31 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   OwningContext owning_context() const override { return owning_context_; }
 
+  /// The luma plane of a YUV image. Null if |isImpellerYUV| is false.
+  const std::shared_ptr<Texture>& y_texture() const { return y_texture_; }
+
+  /// The chroma plane of a YUV image. Null if |isImpellerYUV| is false.
+  const std::shared_ptr<Texture>& uv_texture() const { return uv_texture_; }
+
+  YUVColorSpace yuv_color_space() const { return yuv_color_space_; }
+
  private:
-  std::shared_ptr<Texture> texture_;
+  // Converted lazily for YUV images.
+  mutable std::shared_ptr<Texture> texture_;
   OwningContext owning_context_;
+  AiksContext* aiks_context_ = nullptr;
+  std::shared_ptr<Texture> y_texture_;
+  std::shared_ptr<Texture> uv_texture_;
+  YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
 
   explicit DlImageImpeller(std::shared_ptr<Texture> texture,
                            OwningContext owning_context = OwningContext::kIO);
 
+  DlImageImpeller(AiksContext* aiks_context,
+                  std::shared_ptr<Texture> y_texture,
+                  std::shared_ptr<Texture> uv_texture,
+                  YUVColorSpace yuv_color_space);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DlImageImpeller);
 };
 
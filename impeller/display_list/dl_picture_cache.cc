@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/dl_picture_cache.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/entity.h"
+
+namespace impeller {
+
+DlPictureCache::DlPictureCache() = default;
+
+DlPictureCache::~DlPictureCache() = default;
+
+bool DlPictureCache::IsTranslationOf(const Matrix& transform,
+                                     const Matrix& recorded) {
+  if (transform.HasPerspective() || recorded.HasPerspective()) {
+    return false;
+  }
+  // Without perspective, |transform| is |recorded| preceded by a translation
+  // exactly when everything but the x and y translation is the same.
+  for (size_t i = 0; i < 16; i++) {
+    if (i != 12 && i != 13 && transform.m[i] != recorded.m[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Opacity peepholes set the inherited opacity of contents while the picture
+// is rendered, and the contents are shared by every copy of a cached
+// picture, so what the last frame set is undone before the picture is used
+// again.
+static void ResetInheritedOpacity(const Picture& picture) {
+  picture.pass->IterateAllEntities([](Entity& entity) {
+    entity.SetInheritedOpacity(1.0f);
+    return true;
+  });
+}
+
+DlPictureCache::CachedPicture DlPictureCache::GetPicture(
+    const sk_sp<flutter::DisplayList>& display_list,
+    const Matrix& transform,
+    const Recorder& recorder) {
+  if (!display_list || transform.HasPerspective()) {
+    return {};
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    Entry& entry = entries_[display_list.get()];
+    // Copies of a picture in the same frame would share their contents, so
+    // any further draws of the list in this frame are dispatched directly.
+    if (entry.used_this_frame) {
+      return {};
+    }
+    entry.display_list = display_list;
+    entry.used_this_frame = true;
+    entry.frame_count++;
+    if (entry.picture && IsTranslationOf(transform, entry.transform)) {
+      ResetInheritedOpacity(*entry.picture);
+      return {entry.picture, entry.transform};
+    }
+    if (!entry.cacheable || entry.frame_count < kAccessThreshold) {
+      return {};
+    }
+  }
+
+  // Recording may take a while, so it doesn't hold up the dispatchers of
+  // other threads.
+  TRACE_EVENT0("impeller", "DlPictureCache::RecordPicture");
+  auto picture = std::make_shared<const Picture>(recorder(transform));
+  // Cloning a pass doesn't preserve the transforms and bounds of its
+  // subpasses, so pictures with save layers can't be drawn again.
+  bool cacheable = picture->pass && picture->pass->GetSubpassesDepth() == 1u;
+
+  std::scoped_lock lock(mutex_);
+  Entry& entry = entries_[display_list.get()];
+  entry.cacheable = cacheable;
+  if (!cacheable) {
+    entry.picture = nullptr;
+    return {};
+  }
+  entry.picture = picture;
+  entry.transform = transform;
+  return {std::move(picture), transform};
+}
+
+void DlPictureCache::FinishFrame() {
+  std::scoped_lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!it->second.used_this_frame) {
+      it = entries_.erase(it);
+      continue;
+    }
+    it->second.used_this_frame = false;
+    ++it;
+  }
+}
+
+size_t DlPictureCache::GetPictureCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0u;
+  for (const auto& [display_list, entry] : entries_) {
+    count += entry.picture ? 1u : 0u;
+  }
+  return count;
+}
+
+}  // namespace impeller
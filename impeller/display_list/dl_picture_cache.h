@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/geometry/matrix.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the pictures that display lists drawn in consecutive
+///             frames were converted into, so that `DlDispatcher` can draw
+///             the same display list again without converting it again.
+///
+///             This is the CPU side analogue of the raster cache: the entities
+///             and the vertices their geometry already generated are reused,
+///             but nothing is rendered ahead of time and no textures are held.
+///
+///             A picture is reused for any transform that only differs in its
+///             translation from the transform it was recorded with, so lists
+///             that scroll stay cached. Lists not drawn in a frame are dropped
+///             by `FinishFrame()`. Lists with save layers are not cached, and
+///             a list drawn several times in one frame is only drawn from the
+///             cache the first time.
+///
+///             The cache may be used by several dispatchers of the same frame
+///             on different threads.
+///
+class DlPictureCache {
+ public:
+  /// The number of consecutive frames a display list must be drawn in before
+  /// it is converted into a cached picture.
+  static constexpr size_t kAccessThreshold = 2u;
+
+  struct CachedPicture {
+    /// The picture, or nullptr if the display list should be dispatched
+    /// directly.
+    std::shared_ptr<const Picture> picture;
+
+    /// The transform the entities of |picture| were recorded with.
+    Matrix transform;
+  };
+
+  /// Records the display list with the given transform as the initial
+  /// transformation, without culling.
+  using Recorder = std::function<Picture(const Matrix& transform)>;
+
+  DlPictureCache();
+
+  ~DlPictureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the picture to draw |display_list| with when the
+  ///             canvas has |transform|, recording it with |recorder| once
+  ///             the list has been drawn in enough frames.
+  ///
+  ///             Transforms with perspective are never cached.
+  ///
+  CachedPicture GetPicture(const sk_sp<flutter::DisplayList>& display_list,
+                           const Matrix& transform,
+                           const Recorder& recorder);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the pictures of the display lists that were not drawn
+  ///             since the last call.
+  ///
+  void FinishFrame();
+
+  /// The number of display lists that have a cached picture.
+  size_t GetPictureCount() const;
+
+  /// Whether pictures recorded with |recorded| can be drawn with |transform|,
+  /// because the two only differ in their translation.
+  static bool IsTranslationOf(const Matrix& transform, const Matrix& recorded);
+
+ private:
+  struct Entry {
+    sk_sp<flutter::DisplayList> display_list;
+    std::shared_ptr<const Picture> picture;
+    Matrix transform;
+    size_t frame_count = 0u;
+    bool used_this_frame = false;
+    bool cacheable = true;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<const flutter::DisplayList*, Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlPictureCache);
+};
+
+}  // namespace impeller
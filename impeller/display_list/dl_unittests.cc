@@ -20,7 +20,9 @@
 #include "gtest/gtest.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
+#include "impeller/display_list/dl_picture_cache.h"
 #include "impeller/display_list/dl_playground.h"
+#include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/geometry/constants.h"
@@ -738,6 +740,29 @@ TEST_P(DisplayListTest, CanDrawNinePatchImage) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(DisplayListTest, NinePatchImageIsDrawnWithASingleEntity) {
+  auto texture = CreateTextureForFixture("embarcadero.jpg");
+  auto size = texture->GetSize();
+  DlDispatcher dispatcher;
+  dispatcher.drawImageNine(
+      DlImageImpeller::Make(texture),
+      SkIRect::MakeLTRB(size.width / 4, size.height / 4, size.width * 3 / 4,
+                        size.height * 3 / 4),
+      SkRect::MakeLTRB(0, 0, size.width * 2, size.height * 2),
+      flutter::DlFilterMode::kNearest, false);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  std::vector<std::shared_ptr<Contents>> contents;
+  picture.pass->IterateAllEntities([&contents](Entity& entity) {
+    contents.push_back(entity.GetContents());
+    return true;
+  });
+  ASSERT_EQ(contents.size(), 1u);
+  auto atlas = std::static_pointer_cast<AtlasContents>(contents[0]);
+  ASSERT_EQ(atlas->GetTextureCoordinates().size(), 9u);
+  ASSERT_EQ(atlas->GetTransforms().size(), 9u);
+}
+
 TEST_P(DisplayListTest, CanDrawNinePatchImageCenterWidthBiggerThanDest) {
   // Edge case, the width of the corners does not leave any room for the
   // center slice. The center (across the vertical axis) is folded out of the
@@ -1708,5 +1733,96 @@ TEST_P(DisplayListTest, SceneColorSource) {
 }
 #endif
 
+static Picture DrawFrameWithPictureCache(
+    DlPictureCache& picture_cache,
+    const sk_sp<flutter::DisplayList>& display_list,
+    Scalar translate_x,
+    Scalar scale) {
+  DlDispatcher dispatcher;
+  dispatcher.SetPictureCache(&picture_cache);
+  dispatcher.translate(translate_x, 0);
+  dispatcher.scale(scale, scale);
+  dispatcher.drawDisplayList(display_list, 1.0f);
+  auto picture = dispatcher.EndRecordingAsPicture();
+  picture_cache.FinishFrame();
+  return picture;
+}
+
+static std::optional<Matrix> FindRedEntityTransform(const Picture& picture) {
+  std::optional<Matrix> transform;
+  picture.pass->IterateAllEntities([&transform](Entity& entity) {
+    auto contents = entity.GetContents()->AsSolidColor();
+    if (contents && contents->GetColor() == Color::Red()) {
+      transform = entity.GetTransformation();
+      return false;
+    }
+    return true;
+  });
+  return transform;
+}
+
+TEST_P(DisplayListTest, PictureCacheReusesListsDrawnInConsecutiveFrames) {
+  flutter::DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeXYWH(0, 0, 50, 50),
+                   flutter::DlPaint(flutter::DlColor::kRed()));
+  auto display_list = builder.Build();
+  DlPictureCache picture_cache;
+
+  auto picture = DrawFrameWithPictureCache(picture_cache, display_list, 0, 1);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 0u);
+  EXPECT_EQ(FindRedEntityTransform(picture), Matrix());
+
+  picture = DrawFrameWithPictureCache(picture_cache, display_list, 0, 1);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+  EXPECT_EQ(FindRedEntityTransform(picture), Matrix());
+
+  // Scrolling draws the cached picture at the new position.
+  picture = DrawFrameWithPictureCache(picture_cache, display_list, 30, 1);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+  EXPECT_EQ(FindRedEntityTransform(picture),
+            Matrix::MakeTranslation({30, 0, 0}));
+
+  // Scaling records the list again.
+  picture = DrawFrameWithPictureCache(picture_cache, display_list, 30, 2);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+  EXPECT_EQ(FindRedEntityTransform(picture),
+            Matrix::MakeTranslation({30, 0, 0}) * Matrix::MakeScale({2, 2, 1}));
+
+  // Lists that aren't drawn in a frame are dropped.
+  DrawFrameWithPictureCache(picture_cache, builder.Build(), 0, 1);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 0u);
+}
+
+TEST_P(DisplayListTest, PictureCacheDoesNotCacheSaveLayers) {
+  flutter::DisplayListBuilder builder;
+  builder.SaveLayer(nullptr, nullptr);
+  builder.DrawRect(SkRect::MakeXYWH(0, 0, 50, 50),
+                   flutter::DlPaint(flutter::DlColor::kRed()));
+  builder.Restore();
+  auto display_list = builder.Build();
+  DlPictureCache picture_cache;
+
+  for (int i = 0; i < 3; i++) {
+    auto picture = DrawFrameWithPictureCache(picture_cache, display_list, 0, 1);
+    EXPECT_EQ(picture_cache.GetPictureCount(), 0u);
+    EXPECT_TRUE(FindRedEntityTransform(picture).has_value());
+  }
+}
+
+TEST(DlPictureCacheTest, OnlyTranslatedTransformsMatch) {
+  Matrix recorded = Matrix::MakeTranslation({10, 20, 0}) *
+                    Matrix::MakeScale({2, 3, 1});
+  EXPECT_TRUE(DlPictureCache::IsTranslationOf(recorded, recorded));
+  EXPECT_TRUE(DlPictureCache::IsTranslationOf(
+      Matrix::MakeTranslation({-5, 7, 0}) * recorded, recorded));
+  EXPECT_FALSE(DlPictureCache::IsTranslationOf(
+      Matrix::MakeScale({2, 2, 1}) * recorded, recorded));
+  EXPECT_FALSE(DlPictureCache::IsTranslationOf(
+      Matrix::MakeTranslation({0, 0, 1}) * recorded, recorded));
+  Matrix perspective = recorded;
+  perspective.m[3] = 0.001f;
+  EXPECT_FALSE(DlPictureCache::IsTranslationOf(perspective, perspective));
+}
+
 }  // namespace testing
 }  // namespace impeller
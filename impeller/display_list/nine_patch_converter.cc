@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <utility>
 #include <vector>
 
 #include "impeller/display_list/nine_patch_converter.h"
@@ -72,6 +73,29 @@ void NinePatchConverter::DrawNinePatch(const std::shared_ptr<Image>& image,
   auto vSlices = InitSlices(0, center.GetTop(), center.GetBottom(),
                             image_size.height, dst.GetTop(), dst.GetBottom());
 
+  // Texture contents apply the paint opacity after the color filter, which
+  // atlas contents can't.
+  if (paint->HasColorFilter()) {
+    for (size_t yi = 0; yi < vSlices.size(); yi += 4) {
+      for (size_t xi = 0; xi < hSlices.size(); xi += 4) {
+        canvas->DrawImageRect(
+            image,
+            Rect::MakeLTRB(hSlices[xi], vSlices[yi], hSlices[xi + 2],
+                           vSlices[yi + 2]),
+            Rect::MakeLTRB(hSlices[xi + 1], vSlices[yi + 1], hSlices[xi + 3],
+                           vSlices[yi + 3]),
+            *paint, sampler);
+      }
+    }
+    return;
+  }
+
+  // Draw all of the slices as the sprites of a single atlas entity, which
+  // renders them from one vertex buffer.
+  std::vector<Matrix> transforms;
+  std::vector<Rect> texture_coordinates;
+  transforms.reserve(9);
+  texture_coordinates.reserve(9);
   for (size_t yi = 0; yi < vSlices.size(); yi += 4) {
     auto srcY0 = vSlices[yi];
     auto dstY0 = vSlices[yi + 1];
@@ -82,13 +106,28 @@ void NinePatchConverter::DrawNinePatch(const std::shared_ptr<Image>& image,
       auto dstX0 = hSlices[xi + 1];
       auto srcX1 = hSlices[xi + 2];
       auto dstX1 = hSlices[xi + 3];
-      // TODO(jonahwilliams): consider converting this into a single call to
-      // DrawImageAtlas.
-      canvas->DrawImageRect(image, Rect::MakeLTRB(srcX0, srcY0, srcX1, srcY1),
-                            Rect::MakeLTRB(dstX0, dstY0, dstX1, dstY1), *paint,
-                            sampler);
+      if (srcX1 <= srcX0 || srcY1 <= srcY0 || dstX1 <= dstX0 ||
+          dstY1 <= dstY0) {
+        continue;
+      }
+      texture_coordinates.push_back(
+          Rect::MakeLTRB(srcX0, srcY0, srcX1, srcY1));
+      transforms.push_back(
+          Matrix::MakeTranslation({static_cast<Scalar>(dstX0),
+                                   static_cast<Scalar>(dstY0), 0}) *
+          Matrix::MakeScale({static_cast<Scalar>((dstX1 - dstX0) /
+                                                 (srcX1 - srcX0)),
+                             static_cast<Scalar>((dstY1 - dstY0) /
+                                                 (srcY1 - srcY0)),
+                             1}));
     }
   }
+  if (transforms.empty()) {
+    return;
+  }
+  canvas->DrawAtlas(image, std::move(transforms),
+                    std::move(texture_coordinates), {}, BlendMode::kSource,
+                    sampler, dst, *paint);
 }
 
 }  // namespace impeller
@@ -15,7 +15,8 @@
 
 namespace impeller {
 
-// Converts a call to draw a nine patch image into a draw atlas call.
+// Converts a call to draw a nine patch image into a draw atlas call, which
+// draws all of the slices with a single entity.
 class NinePatchConverter {
  public:
   NinePatchConverter();
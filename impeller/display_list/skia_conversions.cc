@@ -3,12 +3,101 @@
 // found in the LICENSE file.
 
 #include "impeller/display_list/skia_conversions.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "display_list/dl_color.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace impeller {
 namespace skia_conversions {
 
+namespace {
+
+// Paths with fewer verbs than this are cheaper to convert than to look up.
+constexpr int kMinCachedVerbCount = 8;
+
+//------------------------------------------------------------------------------
+/// Converted paths, found by the generation ID of the SkPath they came from.
+///
+/// Display lists share the SkPathRef of a Dart path that doesn't change, so
+/// its generation ID stays the same across frames, and the converted path can
+/// be handed out again without copying its components. Since the content
+/// hash is kept with those components, the tessellation cache finds it again
+/// without walking the path either.
+///
+class PathConversionCache {
+ public:
+  static constexpr size_t kMaxEntryCount = 256u;
+
+  static PathConversionCache& GetInstance() {
+    static PathConversionCache* instance = new PathConversionCache();
+    return *instance;
+  }
+
+  std::optional<Path> Find(const SkPath& path) {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(path.getGenerationID());
+    if (found == index_.end() || !found->second->Matches(path)) {
+      return std::nullopt;
+    }
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->path;
+  }
+
+  void Insert(const SkPath& path, const Path& converted) {
+    std::scoped_lock lock(mutex_);
+    const uint32_t generation_id = path.getGenerationID();
+    auto found = index_.find(generation_id);
+    if (found != index_.end()) {
+      entries_.erase(found->second);
+      index_.erase(found);
+    }
+    while (entries_.size() >= kMaxEntryCount) {
+      index_.erase(entries_.back().generation_id);
+      entries_.pop_back();
+    }
+    entries_.push_front(Entry{
+        .generation_id = generation_id,
+        .fill_type = path.getFillType(),
+        .point_count = path.countPoints(),
+        .verb_count = path.countVerbs(),
+        .bounds = path.getBounds(),
+        .path = converted,
+    });
+    index_[generation_id] = entries_.begin();
+  }
+
+ private:
+  struct Entry {
+    uint32_t generation_id = 0u;
+    SkPathFillType fill_type = SkPathFillType::kWinding;
+    int point_count = 0;
+    int verb_count = 0;
+    SkRect bounds;
+    Path path;
+
+    // The generation ID doesn't cover the fill type, and the rest guards
+    // against IDs that have wrapped around.
+    bool Matches(const SkPath& other) const {
+      return fill_type == other.getFillType() &&
+             point_count == other.countPoints() &&
+             verb_count == other.countVerbs() && bounds == other.getBounds();
+    }
+  };
+
+  std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<uint32_t, std::list<Entry>::iterator> index_;
+};
+
+Path ConvertPath(const SkPath& path, Point shift);
+
+}  // namespace
+
 Rect ToRect(const SkRect& rect) {
   return Rect::MakeLTRB(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
 }
@@ -47,6 +136,23 @@ PathBuilder::RoundingRadii ToRoundingRadii(const SkRRect& rrect) {
 }
 
 Path ToPath(const SkPath& path, Point shift) {
+  // Volatile paths change every frame, so they are not worth keeping.
+  if (!shift.IsZero() || path.isVolatile() ||
+      path.countVerbs() < kMinCachedVerbCount) {
+    return ConvertPath(path, shift);
+  }
+  PathConversionCache& cache = PathConversionCache::GetInstance();
+  if (auto cached = cache.Find(path)) {
+    return cached.value();
+  }
+  Path converted = ConvertPath(path, shift);
+  cache.Insert(path, converted);
+  return converted;
+}
+
+namespace {
+
+Path ConvertPath(const SkPath& path, Point shift) {
   auto iterator = SkPath::Iter(path, false);
 
   struct PathData {
@@ -127,6 +233,8 @@ Path ToPath(const SkPath& path, Point shift) {
   return builder.TakePath(fill_type);
 }
 
+}  // namespace
+
 Path ToPath(const SkRRect& rrect) {
   return PathBuilder{}
       .AddRoundedRect(ToRect(rrect.getBounds()), ToRoundingRadii(rrect))
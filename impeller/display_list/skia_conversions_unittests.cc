@@ -23,5 +23,29 @@ TEST(SkiaConversionsTest, ToColor) {
   ASSERT_TRUE(ScalarNearlyEqual(converted_color.blue, 0x20 * (1.0f / 255)));
 }
 
+TEST(SkiaConversionsTest, ToPathReusesConversionsOfUnchangedPaths) {
+  SkPath sk_path;
+  sk_path.moveTo(0, 0);
+  for (int i = 1; i <= 10; i++) {
+    sk_path.cubicTo(i * 10, 0, i * 10, 10, i * 10 + 5, 5);
+  }
+  sk_path.close();
+
+  auto path = skia_conversions::ToPath(sk_path);
+  // Display lists hold copies of the SkPath, which share its generation ID.
+  SkPath recorded = sk_path;
+  auto same_path = skia_conversions::ToPath(recorded);
+  EXPECT_TRUE(same_path.HasSameContents(path));
+  EXPECT_EQ(same_path.GetContentHash(), path.GetContentHash());
+
+  sk_path.lineTo(200, 200);
+  auto changed_path = skia_conversions::ToPath(sk_path);
+  EXPECT_FALSE(changed_path.HasSameContents(path));
+
+  recorded.setFillType(SkPathFillType::kEvenOdd);
+  auto odd_path = skia_conversions::ToPath(recorded);
+  EXPECT_EQ(odd_path.GetFillType(), FillType::kOdd);
+}
+
 }  // namespace testing
 }  // namespace impeller
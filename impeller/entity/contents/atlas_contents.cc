@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <array>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -15,6 +17,7 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -27,6 +30,45 @@
 
 namespace impeller {
 
+namespace {
+
+// The corners of the unit quad that every instanced sprite is drawn from.
+constexpr std::array<Point, 6> kUnitPoints = {Point{0, 0}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 1}};
+
+template <class VertexShader>
+VertexBuffer CreateUnitQuadVertexBuffer(HostBuffer& host_buffer) {
+  std::array<typename VertexShader::PerVertexData, kUnitPoints.size()>
+      vertices;
+  for (size_t i = 0; i < kUnitPoints.size(); i++) {
+    vertices[i].unit_position = kUnitPoints[i];
+  }
+  return {
+      .vertex_buffer = host_buffer.Emplace(
+          vertices.data(), sizeof(vertices),
+          alignof(typename VertexShader::PerVertexData)),
+      .index_buffer = {},
+      .vertex_count = vertices.size(),
+      .index_type = IndexType::kNone,
+  };
+}
+
+BufferView EmplaceSpriteInstances(HostBuffer& host_buffer,
+                                  const std::vector<Rect>& texture_coords,
+                                  const std::vector<Matrix>& transforms,
+                                  const std::vector<Color>& colors) {
+  return host_buffer.Emplace(
+      texture_coords.size() * sizeof(AtlasSpriteInstanceData),
+      DefaultUniformAlignment(), [&](uint8_t* contents) {
+        AtlasContents::WriteSpriteInstances(
+            texture_coords, transforms, colors,
+            reinterpret_cast<AtlasSpriteInstanceData*>(contents));
+      });
+}
+
+}  // namespace
+
 AtlasContents::AtlasContents() = default;
 
 AtlasContents::~AtlasContents() = default;
@@ -51,6 +93,7 @@ void AtlasContents::SetTextureCoordinates(std::vector<Rect> texture_coords) {
 
 void AtlasContents::SetColors(std::vector<Color> colors) {
   colors_ = std::move(colors);
+  shared_color_computed_ = false;
 }
 
 void AtlasContents::SetAlpha(Scalar alpha) {
@@ -187,6 +230,45 @@ const std::vector<Color>& AtlasContents::GetColors() const {
   return colors_;
 }
 
+std::optional<Color> AtlasContents::GetSharedColor() const {
+  if (!shared_color_computed_) {
+    shared_color_computed_ = true;
+    shared_color_ = std::nullopt;
+    if (!colors_.empty() &&
+        std::all_of(colors_.begin(), colors_.end(),
+                    [&](const Color& color) { return color == colors_[0]; })) {
+      shared_color_ = colors_[0];
+    }
+  }
+  return shared_color_;
+}
+
+bool AtlasContents::CanDrawInstanced(const std::vector<Matrix>& transforms) {
+  return std::none_of(
+      transforms.begin(), transforms.end(),
+      [](const Matrix& transform) { return transform.HasPerspective(); });
+}
+
+void AtlasContents::WriteSpriteInstances(
+    const std::vector<Rect>& texture_coords,
+    const std::vector<Matrix>& transforms,
+    const std::vector<Color>& colors,
+    AtlasSpriteInstanceData* instances) {
+  for (size_t i = 0; i < texture_coords.size(); i++) {
+    const Rect& sample_rect = texture_coords[i];
+    const Matrix& transform = transforms[i];
+    AtlasSpriteInstanceData& instance = instances[i];
+    instance.texture_rect =
+        Vector4(sample_rect.origin.x, sample_rect.origin.y,
+                sample_rect.size.width, sample_rect.size.height);
+    instance.basis = Vector4(transform.m[0], transform.m[1], transform.m[4],
+                             transform.m[5]);
+    instance.translation = Vector4(transform.m[12], transform.m[13], 0, 0);
+    instance.color = colors.empty() ? Vector4(0, 0, 0, 0)
+                                    : Vector4(colors[i].Premultiply());
+  }
+}
+
 bool AtlasContents::Render(const ContentContext& renderer,
                            const Entity& entity,
                            RenderPass& pass) const {
@@ -217,9 +299,13 @@ bool AtlasContents::Render(const ContentContext& renderer,
   constexpr Scalar height[6] = {0, 0, 1, 0, 1, 1};
 
   if (blend_mode_ <= BlendMode::kModulate) {
+    if (renderer.GetDeviceCapabilities().SupportsSSBO() &&
+        CanDrawInstanced(transforms_)) {
+      return RenderPorterDuffBlendInstanced(renderer, entity, pass);
+    }
+
     // Simple Porter-Duff blends can be accomplished without a subpass.
     using VS = PorterDuffBlendPipeline::VertexShader;
-    using FS = PorterDuffBlendPipeline::FragmentShader;
 
     VertexBufferBuilder<VS::PerVertexData> vtx_builder;
     vtx_builder.Reserve(texture_coords_.size() * 6);
@@ -254,34 +340,10 @@ bool AtlasContents::Render(const ContentContext& renderer,
     auto options = OptionsFromPass(pass);
     cmd.pipeline = renderer.GetPorterDuffBlendPipeline(options);
 
-    FS::FragInfo frag_info;
-    VS::FrameInfo frame_info;
+    BindPorterDuffBlendFragmentStage(renderer, cmd, host_buffer);
 
-    auto dst_sampler_descriptor = sampler_descriptor_;
-    if (renderer.GetDeviceCapabilities().SupportsDecalSamplerAddressMode()) {
-      dst_sampler_descriptor.width_address_mode = SamplerAddressMode::kDecal;
-      dst_sampler_descriptor.height_address_mode = SamplerAddressMode::kDecal;
-    }
-    auto dst_sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-        dst_sampler_descriptor);
-    FS::BindTextureSamplerDst(cmd, texture_, dst_sampler);
+    VS::FrameInfo frame_info;
     frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
-
-    frag_info.output_alpha = alpha_;
-    frag_info.input_alpha = 1.0;
-
-    auto inverted_blend_mode =
-        InvertPorterDuffBlend(blend_mode_).value_or(BlendMode::kSource);
-    auto blend_coefficients =
-        kPorterDuffCoefficients[static_cast<int>(inverted_blend_mode)];
-    frag_info.src_coeff = blend_coefficients[0];
-    frag_info.src_coeff_dst_alpha = blend_coefficients[1];
-    frag_info.dst_coeff = blend_coefficients[2];
-    frag_info.dst_coeff_src_alpha = blend_coefficients[3];
-    frag_info.dst_coeff_src_color = blend_coefficients[4];
-
-    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
-
     frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                      entity.GetTransformation();
 
@@ -293,6 +355,11 @@ bool AtlasContents::Render(const ContentContext& renderer,
 
   // Advanced blends.
 
+  if (auto color = GetSharedColor(); color.has_value()) {
+    return RenderAdvancedBlendWithSharedColor(renderer, entity, pass,
+                                              color.value(), coverage);
+  }
+
   auto sub_atlas = GenerateSubAtlas();
   auto sub_coverage = Rect::MakeSize(sub_atlas->size);
 
@@ -328,6 +395,117 @@ bool AtlasContents::Render(const ContentContext& renderer,
   return child_contents.Render(renderer, entity, pass);
 }
 
+void AtlasContents::BindPorterDuffBlendFragmentStage(
+    const ContentContext& renderer,
+    Command& cmd,
+    HostBuffer& host_buffer) const {
+  using FS = PorterDuffBlendPipeline::FragmentShader;
+
+  auto dst_sampler_descriptor = sampler_descriptor_;
+  if (renderer.GetDeviceCapabilities().SupportsDecalSamplerAddressMode()) {
+    dst_sampler_descriptor.width_address_mode = SamplerAddressMode::kDecal;
+    dst_sampler_descriptor.height_address_mode = SamplerAddressMode::kDecal;
+  }
+  auto dst_sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+      dst_sampler_descriptor);
+  FS::BindTextureSamplerDst(cmd, texture_, dst_sampler);
+
+  FS::FragInfo frag_info;
+  frag_info.output_alpha = alpha_;
+  frag_info.input_alpha = 1.0;
+
+  auto inverted_blend_mode =
+      InvertPorterDuffBlend(blend_mode_).value_or(BlendMode::kSource);
+  auto blend_coefficients =
+      kPorterDuffCoefficients[static_cast<int>(inverted_blend_mode)];
+  frag_info.src_coeff = blend_coefficients[0];
+  frag_info.src_coeff_dst_alpha = blend_coefficients[1];
+  frag_info.dst_coeff = blend_coefficients[2];
+  frag_info.dst_coeff_src_alpha = blend_coefficients[3];
+  frag_info.dst_coeff_src_color = blend_coefficients[4];
+
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+}
+
+bool AtlasContents::RenderPorterDuffBlendInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  using VS = AtlasBlendInstancedPipeline::VertexShader;
+
+  if (texture_coords_.empty()) {
+    return true;
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, SPrintF("DrawAtlas Blend Instanced (%s)",
+                                  BlendModeToString(blend_mode_)));
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.pipeline = renderer.GetAtlasBlendInstancedPipeline(OptionsFromPass(pass));
+
+  BindPorterDuffBlendFragmentStage(renderer, cmd, host_buffer);
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  frame_info.texture_size = Point(texture_->GetSize());
+  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindSpriteInfo(cmd, EmplaceSpriteInstances(host_buffer, texture_coords_,
+                                                 transforms_, colors_));
+
+  // Every sprite is an instance of the same unit quad, so the per vertex data
+  // doesn't grow with the number of sprites.
+  cmd.BindVertices(CreateUnitQuadVertexBuffer<VS>(host_buffer));
+  cmd.instance_count = texture_coords_.size();
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+bool AtlasContents::RenderAdvancedBlendWithSharedColor(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    Color color,
+    Rect coverage) const {
+  // Every sprite is blended with the same color, so the whole atlas texture
+  // can be blended with it once and the sprites drawn from the result, instead
+  // of packing every distinct sprite into a sub-atlas first.
+  auto texture_rect = Rect::MakeSize(texture_->GetSize());
+
+  auto dst_contents = std::make_shared<SolidColorContents>();
+  dst_contents->SetGeometry(Geometry::MakeRect(texture_rect));
+  dst_contents->SetColor(color);
+
+  auto src_contents = TextureContents::MakeRect(texture_rect);
+  src_contents->SetTexture(texture_);
+  src_contents->SetSourceRect(texture_rect);
+  src_contents->SetSamplerDescriptor(sampler_descriptor_);
+
+  Entity untransformed_entity;
+  auto contents = ColorFilterContents::MakeBlend(
+      blend_mode_,
+      {FilterInput::Make(dst_contents), FilterInput::Make(src_contents)});
+  auto snapshot =
+      contents->RenderToSnapshot(renderer,              // renderer
+                                 untransformed_entity,  // entity
+                                 std::nullopt,          // coverage_limit
+                                 std::nullopt,          // sampler_descriptor
+                                 true,                  // msaa_enabled
+                                 "AtlasContents Snapshot");  // label
+  if (!snapshot.has_value()) {
+    return false;
+  }
+
+  auto child_contents = AtlasTextureContents(*this);
+  child_contents.SetAlpha(alpha_);
+  child_contents.SetCoverage(coverage);
+  child_contents.SetTexture(snapshot.value().texture);
+  return child_contents.Render(renderer, entity, pass);
+}
+
 // AtlasTextureContents
 // ---------------------------------------------------------
 
@@ -373,16 +551,24 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
+  const std::vector<Rect>* texture_coords_ptr;
+  const std::vector<Matrix>* transforms_ptr;
   if (subatlas_) {
-    texture_coords = use_destination_ ? subatlas_->result_texture_coords
-                                      : subatlas_->sub_texture_coords;
-    transforms = use_destination_ ? subatlas_->result_transforms
-                                  : subatlas_->sub_transforms;
+    texture_coords_ptr = use_destination_ ? &subatlas_->result_texture_coords
+                                          : &subatlas_->sub_texture_coords;
+    transforms_ptr = use_destination_ ? &subatlas_->result_transforms
+                                      : &subatlas_->sub_transforms;
   } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
+    texture_coords_ptr = &parent_.GetTextureCoordinates();
+    transforms_ptr = &parent_.GetTransforms();
+  }
+  const std::vector<Rect>& texture_coords = *texture_coords_ptr;
+  const std::vector<Matrix>& transforms = *transforms_ptr;
+
+  if (renderer.GetDeviceCapabilities().SupportsSSBO() &&
+      AtlasContents::CanDrawInstanced(transforms)) {
+    return RenderInstanced(renderer, entity, pass, texture, texture_coords,
+                           transforms);
   }
 
   const Size texture_size(texture->GetSize());
@@ -434,6 +620,46 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool AtlasTextureContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<Rect>& texture_coords,
+    const std::vector<Matrix>& transforms) const {
+  using VS = AtlasSpriteInstancedPipeline::VertexShader;
+  using FS = AtlasSpriteInstancedPipeline::FragmentShader;
+
+  if (texture_coords.empty()) {
+    return true;
+  }
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "AtlasTexture Instanced");
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  frame_info.texture_size = Point(texture->GetSize());
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+  frame_info.alpha = alpha_;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  cmd.pipeline = renderer.GetAtlasSpriteInstancedPipeline(options);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(CreateUnitQuadVertexBuffer<VS>(host_buffer));
+  cmd.instance_count = texture_coords.size();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindSpriteInfo(cmd, EmplaceSpriteInstances(host_buffer, texture_coords,
+                                                 transforms, {}));
+  FS::BindTextureSampler(cmd, texture,
+                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                             parent_.GetSamplerDescriptor()));
+  return pass.AddCommand(std::move(cmd));
+}
+
 // AtlasColorContents
 // ---------------------------------------------------------
 
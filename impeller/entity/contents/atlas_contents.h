@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -15,6 +16,28 @@
 
 namespace impeller {
 
+struct Command;
+class HostBuffer;
+
+//------------------------------------------------------------------------------
+/// @brief      The per sprite data of the instanced atlas shaders. Matches the
+///             `SpriteInstance` struct in `atlas_sprite_instanced.vert` and
+///             `atlas_blend_instanced.vert`.
+///
+struct AtlasSpriteInstanceData {
+  /// The XYWH rectangle the sprite samples from the atlas texture.
+  Vector4 texture_rect;
+  /// The x basis vector of the sprite transform in xy, followed by the y
+  /// basis vector in zw.
+  Vector4 basis;
+  /// The translation of the sprite transform. Only x and y are used.
+  Vector4 translation;
+  /// The premultiplied color the sprite is blended with.
+  Vector4 color;
+};
+
+static_assert(sizeof(AtlasSpriteInstanceData) == 16 * sizeof(Scalar));
+
 struct SubAtlasResult {
   // Sub atlas values.
   std::vector<Rect> sub_texture_coords;
@@ -61,6 +84,28 @@ class AtlasContents final : public Contents {
 
   const std::vector<Color>& GetColors() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The color all of the sprites are blended with, if they are
+  ///             all blended with the same one.
+  ///
+  std::optional<Color> GetSharedColor() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the sprites can be drawn as instances of a single
+  ///             quad, which is the case for transforms without perspective.
+  ///
+  static bool CanDrawInstanced(const std::vector<Matrix>& transforms);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the instance data of every sprite to `instances`,
+  ///             which must have room for `texture_coords.size()` sprites. The
+  ///             colors are left transparent when `colors` is empty.
+  ///
+  static void WriteSpriteInstances(const std::vector<Rect>& texture_coords,
+                                   const std::vector<Matrix>& transforms,
+                                   const std::vector<Color>& colors,
+                                   AtlasSpriteInstanceData* instances);
+
   /// @brief Compress a drawAtlas call with blending into a smaller sized atlas.
   ///        This atlas has no overlapping to ensure
   ///        blending behaves as if it were done in the fragment shader.
@@ -77,6 +122,20 @@ class AtlasContents final : public Contents {
  private:
   Rect ComputeBoundingBox() const;
 
+  void BindPorterDuffBlendFragmentStage(const ContentContext& renderer,
+                                        Command& cmd,
+                                        HostBuffer& host_buffer) const;
+
+  bool RenderPorterDuffBlendInstanced(const ContentContext& renderer,
+                                      const Entity& entity,
+                                      RenderPass& pass) const;
+
+  bool RenderAdvancedBlendWithSharedColor(const ContentContext& renderer,
+                                          const Entity& entity,
+                                          RenderPass& pass,
+                                          Color color,
+                                          Rect coverage) const;
+
   std::shared_ptr<Texture> texture_;
   std::vector<Rect> texture_coords_;
   std::vector<Color> colors_;
@@ -86,6 +145,8 @@ class AtlasContents final : public Contents {
   Scalar alpha_ = 1.0;
   SamplerDescriptor sampler_descriptor_ = {};
   mutable std::optional<Rect> bounding_box_cache_;
+  mutable bool shared_color_computed_ = false;
+  mutable std::optional<Color> shared_color_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AtlasContents);
 };
@@ -115,6 +176,13 @@ class AtlasTextureContents final : public Contents {
   void SetSubAtlas(const std::shared_ptr<SubAtlasResult>& subatlas);
 
  private:
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       const std::shared_ptr<Texture>& texture,
+                       const std::vector<Rect>& texture_coords,
+                       const std::vector<Matrix>& transforms) const;
+
   const AtlasContents& parent_;
   Scalar alpha_ = 1.0;
   Rect coverage_;
@@ -76,11 +76,89 @@ bool ClipContents::CanInheritOpacity(const Entity& entity) const {
 
 void ClipContents::SetInheritedOpacity(Scalar opacity) {}
 
+bool ClipContents::IsDepthClip(const Entity& entity,
+                               const RenderTarget& render_target) const {
+  if (!render_target.GetDepthAttachment().has_value() || !geometry_ ||
+      clip_op_ != Entity::ClipOperation::kIntersect) {
+    return false;
+  }
+  auto coverage = geometry_->GetCoverage(entity.GetTransformation());
+  return coverage.has_value() &&
+         geometry_->CoversArea(entity.GetTransformation(), coverage.value());
+}
+
+bool ClipContents::RenderDepthClip(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const {
+  using VS = ClipPipeline::VertexShader;
+
+  // Only the area that is still visible has to be clipped away. Everything
+  // else is already covered by the depth or stencil of the enclosing clips.
+  auto outer = GetCoverageHint().value_or(
+      Rect::MakeSize(pass.GetRenderTargetSize()));
+  auto inner = geometry_->GetCoverage(entity.GetTransformation())
+                   ->Intersection(outer);
+
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  auto add_rect = [&vtx_builder](Scalar left, Scalar top, Scalar right,
+                                 Scalar bottom) {
+    if (right <= left || bottom <= top) {
+      return;
+    }
+    vtx_builder.AddVertices({
+        {Point(left, top)},
+        {Point(right, top)},
+        {Point(left, bottom)},
+        {Point(left, bottom)},
+        {Point(right, top)},
+        {Point(right, bottom)},
+    });
+  };
+  auto [left, top, right, bottom] = outer.GetLTRB();
+  if (!inner.has_value()) {
+    add_rect(left, top, right, bottom);
+  } else {
+    // The parts of the outer rectangle above, below, left and right of the
+    // clip.
+    auto [clip_left, clip_top, clip_right, clip_bottom] = inner->GetLTRB();
+    add_rect(left, top, right, clip_top);
+    add_rect(left, clip_bottom, right, bottom);
+    add_rect(left, clip_top, clip_left, clip_bottom);
+    add_rect(clip_right, clip_top, right, clip_bottom);
+  }
+  if (!vtx_builder.HasVertices()) {
+    return true;
+  }
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Intersect Clip (Depth)");
+  auto options = OptionsFromPass(pass);
+  options.blend_mode = BlendMode::kDestination;
+  options.stencil_compare = CompareFunction::kAlways;
+  options.stencil_operation = StencilOperation::kKeep;
+  options.depth_write_enabled = true;
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetClipPipeline(options);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(pass.GetTransientsBuffer()));
+
+  VS::FrameInfo info;
+  info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(info));
+
+  pass.AddCommand(std::move(cmd));
+  return true;
+}
+
 bool ClipContents::Render(const ContentContext& renderer,
                           const Entity& entity,
                           RenderPass& pass) const {
   using VS = ClipPipeline::VertexShader;
 
+  if (IsDepthClip(entity, pass.GetRenderTarget())) {
+    return RenderDepthClip(renderer, entity, pass);
+  }
+
   VS::FrameInfo info;
 
   Command cmd;
@@ -12,6 +12,7 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
@@ -25,6 +26,19 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this clip is applied by writing to the depth
+  ///             attachment of `render_target` rather than to its stencil,
+  ///             which is the case for intersections with a rectangle when the
+  ///             target has a depth attachment.
+  ///
+  ///             Depth clips write the depth they are rendered at outside of
+  ///             the clip, so that nothing drawn at a smaller depth passes the
+  ///             depth test there. They don't change the stencil.
+  ///
+  bool IsDepthClip(const Entity& entity,
+                   const RenderTarget& render_target) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -51,6 +65,10 @@ class ClipContents final : public Contents {
   std::unique_ptr<Geometry> geometry_;
   Entity::ClipOperation clip_op_ = Entity::ClipOperation::kIntersect;
 
+  bool RenderDepthClip(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ClipContents);
 };
 
@@ -4,11 +4,14 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <charconv>
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/runtime_effect_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
@@ -140,6 +143,19 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
     desc.ClearStencilAttachments();
   }
 
+  if (depth_attachment_pixel_format != PixelFormat::kUnknown) {
+    desc.SetDepthStencilAttachmentDescriptor(DepthAttachmentDescriptor{
+        .depth_compare = CompareFunction::kGreater,
+        .depth_write_enabled = depth_write_enabled,
+    });
+    desc.SetDepthPixelFormat(depth_attachment_pixel_format);
+    // Entity passes attach a single texture as both the depth and the
+    // stencil.
+    if (has_stencil_attachment) {
+      desc.SetStencilPixelFormat(depth_attachment_pixel_format);
+    }
+  }
+
   auto maybe_stencil = desc.GetFrontStencilAttachmentDescriptor();
   if (maybe_stencil.has_value()) {
     StencilAttachmentDescriptor stencil = maybe_stencil.value();
@@ -169,6 +185,34 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
   return std::make_unique<PipelineT>(context, desc);
 }
 
+template <class TypedPipeline>
+void ContentContext::InitializeVariants(
+    Variants<TypedPipeline>& container,
+    std::unique_ptr<TypedPipeline> prototype) {
+  std::string label;
+  if (prototype) {
+    if (auto descriptor = prototype->GetDescriptor(); descriptor.has_value()) {
+      label = descriptor->GetLabel();
+    }
+  }
+  container[default_options_] = std::move(prototype);
+  variant_warmers_.push_back(VariantWarmer{
+      .pipeline_label = std::move(label),
+      .create_variant =
+          [this, &container](const ContentContextOptions& opts) {
+            if (container.find(opts) == container.end()) {
+              CreateVariant(container, opts);
+            }
+          },
+  });
+}
+
+template <class TypedPipeline>
+void ContentContext::InitializeVariants(Variants<TypedPipeline>& container) {
+  InitializeVariants(container,
+                     CreateDefaultPipeline<TypedPipeline>(*context_));
+}
+
 ContentContext::ContentContext(
     std::shared_ptr<Context> context,
     std::shared_ptr<TypographerContext> typographer_context,
@@ -176,14 +220,21 @@ ContentContext::ContentContext(
     : context_(std::move(context)),
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
+      glyph_instance_cache_(std::make_shared<GlyphInstanceCache>()),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(
+          std::make_shared<TessellationCache>(context_->GetResourceAllocator(),
+                                              tessellator_)),
+      gradient_texture_cache_(std::make_shared<GradientTextureCache>()),
+      runtime_effect_cache_(std::make_shared<RuntimeEffectCache>()),
 #if IMPELLER_ENABLE_3D
       scene_context_(std::make_shared<scene::SceneContext>(context_)),
 #endif  // IMPELLER_ENABLE_3D
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
-                               : std::move(render_target_allocator)) {
+                               : std::move(render_target_allocator)),
+      encoding_queue_(std::make_unique<RenderPassEncodingQueue>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -193,136 +244,85 @@ ContentContext::ContentContext(
           context_->GetCapabilities()->GetDefaultColorFormat()};
 
 #ifdef IMPELLER_DEBUG
-  checkerboard_pipelines_[default_options_] =
-      CreateDefaultPipeline<CheckerboardPipeline>(*context_);
+  InitializeVariants(checkerboard_pipelines_);
 #endif  // IMPELLER_DEBUG
 
-  solid_fill_pipelines_[default_options_] =
-      CreateDefaultPipeline<SolidFillPipeline>(*context_);
+  InitializeVariants(solid_fill_pipelines_);
 
   if (context_->GetCapabilities()->SupportsSSBO()) {
-    linear_gradient_ssbo_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<LinearGradientSSBOFillPipeline>(*context_);
-    radial_gradient_ssbo_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<RadialGradientSSBOFillPipeline>(*context_);
-    conical_gradient_ssbo_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<ConicalGradientSSBOFillPipeline>(*context_);
-    sweep_gradient_ssbo_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<SweepGradientSSBOFillPipeline>(*context_);
+    InitializeVariants(linear_gradient_ssbo_fill_pipelines_);
+    InitializeVariants(radial_gradient_ssbo_fill_pipelines_);
+    InitializeVariants(conical_gradient_ssbo_fill_pipelines_);
+    InitializeVariants(sweep_gradient_ssbo_fill_pipelines_);
   } else {
-    linear_gradient_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<LinearGradientFillPipeline>(*context_);
-    radial_gradient_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<RadialGradientFillPipeline>(*context_);
-    conical_gradient_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<ConicalGradientFillPipeline>(*context_);
-    sweep_gradient_fill_pipelines_[default_options_] =
-        CreateDefaultPipeline<SweepGradientFillPipeline>(*context_);
+    InitializeVariants(linear_gradient_fill_pipelines_);
+    InitializeVariants(radial_gradient_fill_pipelines_);
+    InitializeVariants(conical_gradient_fill_pipelines_);
+    InitializeVariants(sweep_gradient_fill_pipelines_);
   }
 
   if (context_->GetCapabilities()->SupportsFramebufferFetch()) {
-    framebuffer_blend_color_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendColorPipeline>(*context_);
-    framebuffer_blend_colorburn_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendColorBurnPipeline>(*context_);
-    framebuffer_blend_colordodge_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendColorDodgePipeline>(*context_);
-    framebuffer_blend_darken_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendDarkenPipeline>(*context_);
-    framebuffer_blend_difference_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendDifferencePipeline>(*context_);
-    framebuffer_blend_exclusion_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendExclusionPipeline>(*context_);
-    framebuffer_blend_hardlight_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendHardLightPipeline>(*context_);
-    framebuffer_blend_hue_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendHuePipeline>(*context_);
-    framebuffer_blend_lighten_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendLightenPipeline>(*context_);
-    framebuffer_blend_luminosity_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendLuminosityPipeline>(*context_);
-    framebuffer_blend_multiply_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendMultiplyPipeline>(*context_);
-    framebuffer_blend_overlay_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendOverlayPipeline>(*context_);
-    framebuffer_blend_saturation_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendSaturationPipeline>(*context_);
-    framebuffer_blend_screen_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendScreenPipeline>(*context_);
-    framebuffer_blend_softlight_pipelines_[default_options_] =
-        CreateDefaultPipeline<FramebufferBlendSoftLightPipeline>(*context_);
+    InitializeVariants(framebuffer_blend_color_pipelines_);
+    InitializeVariants(framebuffer_blend_colorburn_pipelines_);
+    InitializeVariants(framebuffer_blend_colordodge_pipelines_);
+    InitializeVariants(framebuffer_blend_darken_pipelines_);
+    InitializeVariants(framebuffer_blend_difference_pipelines_);
+    InitializeVariants(framebuffer_blend_exclusion_pipelines_);
+    InitializeVariants(framebuffer_blend_hardlight_pipelines_);
+    InitializeVariants(framebuffer_blend_hue_pipelines_);
+    InitializeVariants(framebuffer_blend_lighten_pipelines_);
+    InitializeVariants(framebuffer_blend_luminosity_pipelines_);
+    InitializeVariants(framebuffer_blend_multiply_pipelines_);
+    InitializeVariants(framebuffer_blend_overlay_pipelines_);
+    InitializeVariants(framebuffer_blend_saturation_pipelines_);
+    InitializeVariants(framebuffer_blend_screen_pipelines_);
+    InitializeVariants(framebuffer_blend_softlight_pipelines_);
   }
 
-  blend_color_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendColorPipeline>(*context_);
-  blend_colorburn_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendColorBurnPipeline>(*context_);
-  blend_colordodge_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendColorDodgePipeline>(*context_);
-  blend_darken_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendDarkenPipeline>(*context_);
-  blend_difference_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendDifferencePipeline>(*context_);
-  blend_exclusion_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendExclusionPipeline>(*context_);
-  blend_hardlight_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendHardLightPipeline>(*context_);
-  blend_hue_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendHuePipeline>(*context_);
-  blend_lighten_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendLightenPipeline>(*context_);
-  blend_luminosity_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendLuminosityPipeline>(*context_);
-  blend_multiply_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendMultiplyPipeline>(*context_);
-  blend_overlay_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendOverlayPipeline>(*context_);
-  blend_saturation_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendSaturationPipeline>(*context_);
-  blend_screen_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendScreenPipeline>(*context_);
-  blend_softlight_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendSoftLightPipeline>(*context_);
-
-  rrect_blur_pipelines_[default_options_] =
-      CreateDefaultPipeline<RRectBlurPipeline>(*context_);
-  texture_blend_pipelines_[default_options_] =
-      CreateDefaultPipeline<BlendPipeline>(*context_);
-  texture_pipelines_[default_options_] =
-      CreateDefaultPipeline<TexturePipeline>(*context_);
-  position_uv_pipelines_[default_options_] =
-      CreateDefaultPipeline<PositionUVPipeline>(*context_);
-  tiled_texture_pipelines_[default_options_] =
-      CreateDefaultPipeline<TiledTexturePipeline>(*context_);
-  gaussian_blur_noalpha_decal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurDecalPipeline>(*context_);
-  gaussian_blur_noalpha_nodecal_pipelines_[default_options_] =
-      CreateDefaultPipeline<GaussianBlurPipeline>(*context_);
-  border_mask_blur_pipelines_[default_options_] =
-      CreateDefaultPipeline<BorderMaskBlurPipeline>(*context_);
-  morphology_filter_pipelines_[default_options_] =
-      CreateDefaultPipeline<MorphologyFilterPipeline>(*context_);
-  color_matrix_color_filter_pipelines_[default_options_] =
-      CreateDefaultPipeline<ColorMatrixColorFilterPipeline>(*context_);
-  linear_to_srgb_filter_pipelines_[default_options_] =
-      CreateDefaultPipeline<LinearToSrgbFilterPipeline>(*context_);
-  srgb_to_linear_filter_pipelines_[default_options_] =
-      CreateDefaultPipeline<SrgbToLinearFilterPipeline>(*context_);
-  glyph_atlas_pipelines_[default_options_] =
-      CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
-  glyph_atlas_color_pipelines_[default_options_] =
-      CreateDefaultPipeline<GlyphAtlasColorPipeline>(*context_);
-  geometry_color_pipelines_[default_options_] =
-      CreateDefaultPipeline<GeometryColorPipeline>(*context_);
-  yuv_to_rgb_filter_pipelines_[default_options_] =
-      CreateDefaultPipeline<YUVToRGBFilterPipeline>(*context_);
-  porter_duff_blend_pipelines_[default_options_] =
-      CreateDefaultPipeline<PorterDuffBlendPipeline>(*context_);
+  InitializeVariants(blend_color_pipelines_);
+  InitializeVariants(blend_colorburn_pipelines_);
+  InitializeVariants(blend_colordodge_pipelines_);
+  InitializeVariants(blend_darken_pipelines_);
+  InitializeVariants(blend_difference_pipelines_);
+  InitializeVariants(blend_exclusion_pipelines_);
+  InitializeVariants(blend_hardlight_pipelines_);
+  InitializeVariants(blend_hue_pipelines_);
+  InitializeVariants(blend_lighten_pipelines_);
+  InitializeVariants(blend_luminosity_pipelines_);
+  InitializeVariants(blend_multiply_pipelines_);
+  InitializeVariants(blend_overlay_pipelines_);
+  InitializeVariants(blend_saturation_pipelines_);
+  InitializeVariants(blend_screen_pipelines_);
+  InitializeVariants(blend_softlight_pipelines_);
+
+  InitializeVariants(rrect_blur_pipelines_);
+  InitializeVariants(texture_blend_pipelines_);
+  InitializeVariants(texture_pipelines_);
+  InitializeVariants(position_uv_pipelines_);
+  InitializeVariants(tiled_texture_pipelines_);
+  InitializeVariants(gaussian_blur_noalpha_decal_pipelines_);
+  InitializeVariants(gaussian_blur_noalpha_nodecal_pipelines_);
+  InitializeVariants(border_mask_blur_pipelines_);
+  InitializeVariants(morphology_filter_pipelines_);
+  InitializeVariants(color_matrix_color_filter_pipelines_);
+  InitializeVariants(linear_to_srgb_filter_pipelines_);
+  InitializeVariants(srgb_to_linear_filter_pipelines_);
+  if (context_->GetCapabilities()->SupportsSSBO()) {
+    InitializeVariants(glyph_atlas_instanced_pipelines_);
+    InitializeVariants(glyph_atlas_color_instanced_pipelines_);
+    InitializeVariants(atlas_sprite_instanced_pipelines_);
+    InitializeVariants(atlas_blend_instanced_pipelines_);
+  } else {
+    InitializeVariants(glyph_atlas_pipelines_);
+    InitializeVariants(glyph_atlas_color_pipelines_);
+  }
+  InitializeVariants(geometry_color_pipelines_);
+  InitializeVariants(yuv_to_rgb_filter_pipelines_);
+  InitializeVariants(porter_duff_blend_pipelines_);
   // GLES only shader.
 #ifdef IMPELLER_ENABLE_OPENGLES
   if (GetContext()->GetBackendType() == Context::BackendType::kOpenGLES) {
-    texture_external_pipelines_[default_options_] =
-        CreateDefaultPipeline<TextureExternalPipeline>(*context_);
+    InitializeVariants(texture_external_pipelines_);
   }
 #endif  // IMPELLER_ENABLE_OPENGLES
   if (context_->GetCapabilities()->SupportsCompute()) {
@@ -358,8 +358,9 @@ ContentContext::ContentContext(
   }
   clip_pipeline_descriptor->SetColorAttachmentDescriptors(
       std::move(clip_color_attachments));
-  clip_pipelines_[default_options_] =
-      std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor);
+  InitializeVariants(clip_pipelines_,
+                     std::make_unique<ClipPipeline>(*context_,
+                                                    clip_pipeline_descriptor));
 
   is_valid_ = true;
 }
@@ -420,7 +421,7 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     return nullptr;
   }
 
-  if (!sub_command_buffer->SubmitCommandsAsync(std::move(sub_renderpass))) {
+  if (!SubmitRenderPass(sub_command_buffer, std::move(sub_renderpass))) {
     return nullptr;
   }
 
@@ -437,6 +438,21 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<GradientTextureCache> ContentContext::GetGradientTextureCache()
+    const {
+  return gradient_texture_cache_;
+}
+
+std::shared_ptr<RuntimeEffectCache> ContentContext::GetRuntimeEffectCache()
+    const {
+  return runtime_effect_cache_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -449,4 +465,154 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetUseDepthClips(bool use_depth_clips) {
+  use_depth_clips_ = use_depth_clips;
+}
+
+bool ContentContext::UsesDepthClips() const {
+  return use_depth_clips_;
+}
+
+void ContentContext::SetEncodingTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  encoding_queue_->SetTaskRunner(std::move(task_runner));
+}
+
+bool ContentContext::SubmitRenderPass(
+    std::shared_ptr<CommandBuffer> command_buffer,
+    std::shared_ptr<RenderPass> render_pass) const {
+  return encoding_queue_->Submit(std::move(command_buffer),
+                                 std::move(render_pass));
+}
+
+bool ContentContext::FlushRenderPasses() const {
+  return encoding_queue_->Flush();
+}
+
+void ContentContext::SetUsePipelineVariantFallbacks(bool use_fallbacks) {
+  use_variant_fallbacks_ = use_fallbacks;
+}
+
+std::vector<ContentContext::PipelineVariant>
+ContentContext::GetCreatedPipelineVariants() const {
+  return created_variants_;
+}
+
+void ContentContext::WarmUpPipelineVariants(
+    const std::vector<PipelineVariant>& variants) const {
+  if (!IsValid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::WarmUpPipelineVariants");
+  for (const auto& variant : variants) {
+    for (const auto& warmer : variant_warmers_) {
+      if (warmer.pipeline_label == variant.pipeline_label) {
+        warmer.create_variant(variant.options);
+      }
+    }
+  }
+}
+
+std::string ContentContext::SerializePipelineVariants(
+    const std::vector<PipelineVariant>& variants) {
+  std::stringstream stream;
+  for (const auto& variant : variants) {
+    const auto& options = variant.options;
+    stream << variant.pipeline_label << '\t'
+           << static_cast<int>(options.sample_count) << '\t'
+           << static_cast<int>(options.blend_mode) << '\t'
+           << static_cast<int>(options.stencil_compare) << '\t'
+           << static_cast<int>(options.stencil_operation) << '\t'
+           << static_cast<int>(options.primitive_type) << '\t'
+           << static_cast<int>(options.color_attachment_pixel_format) << '\t'
+           << options.has_stencil_attachment << '\t' << options.wireframe
+           << '\t' << options.is_for_rrect_blur_clear << '\n';
+  }
+  return stream.str();
+}
+
+namespace {
+
+// Parses the next tab separated field of `line` as an integer in
+// [min, max] and advances `line` past it.
+bool ParseVariantField(std::string_view& line, int min, int max, int& value) {
+  auto end = line.find('\t');
+  auto field = line.substr(0, end);
+  auto result =
+      std::from_chars(field.data(), field.data() + field.size(), value);
+  if (result.ec != std::errc() || result.ptr != field.data() + field.size() ||
+      value < min || value > max) {
+    return false;
+  }
+  line = end == std::string_view::npos ? std::string_view()
+                                       : line.substr(end + 1);
+  return true;
+}
+
+std::optional<ContentContext::PipelineVariant> DeserializePipelineVariant(
+    std::string_view line) {
+  auto label_end = line.find('\t');
+  if (label_end == 0 || label_end == std::string_view::npos) {
+    return std::nullopt;
+  }
+  ContentContext::PipelineVariant variant;
+  variant.pipeline_label = std::string(line.substr(0, label_end));
+  line = line.substr(label_end + 1);
+
+  int sample_count, blend_mode, stencil_compare, stencil_operation,
+      primitive_type, pixel_format, has_stencil_attachment, wireframe,
+      is_for_rrect_blur_clear;
+  if (!ParseVariantField(line, 1, 4, sample_count) ||
+      (sample_count != 1 && sample_count != 4) ||
+      !ParseVariantField(line, 0, static_cast<int>(BlendMode::kLast),
+                         blend_mode) ||
+      !ParseVariantField(line, 0,
+                         static_cast<int>(CompareFunction::kGreaterEqual),
+                         stencil_compare) ||
+      !ParseVariantField(line, 0,
+                         static_cast<int>(StencilOperation::kDecrementWrap),
+                         stencil_operation) ||
+      !ParseVariantField(line, 0, static_cast<int>(PrimitiveType::kPoint),
+                         primitive_type) ||
+      !ParseVariantField(line, static_cast<int>(PixelFormat::kA8UNormInt),
+                         static_cast<int>(PixelFormat::kB10G10R10A10XR),
+                         pixel_format) ||
+      !ParseVariantField(line, 0, 1, has_stencil_attachment) ||
+      !ParseVariantField(line, 0, 1, wireframe) ||
+      !ParseVariantField(line, 0, 1, is_for_rrect_blur_clear) ||
+      !line.empty()) {
+    return std::nullopt;
+  }
+  variant.options = ContentContextOptions{
+      .sample_count = static_cast<SampleCount>(sample_count),
+      .blend_mode = static_cast<BlendMode>(blend_mode),
+      .stencil_compare = static_cast<CompareFunction>(stencil_compare),
+      .stencil_operation = static_cast<StencilOperation>(stencil_operation),
+      .primitive_type = static_cast<PrimitiveType>(primitive_type),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(pixel_format),
+      .has_stencil_attachment = has_stencil_attachment == 1,
+      .wireframe = wireframe == 1,
+      .is_for_rrect_blur_clear = is_for_rrect_blur_clear == 1,
+  };
+  return variant;
+}
+
+}  // namespace
+
+std::vector<ContentContext::PipelineVariant>
+ContentContext::DeserializePipelineVariants(std::string_view manifest) {
+  std::vector<PipelineVariant> variants;
+  while (!manifest.empty()) {
+    auto line_end = manifest.find('\n');
+    auto line = manifest.substr(0, line_end);
+    manifest = line_end == std::string_view::npos
+                   ? std::string_view()
+                   : manifest.substr(line_end + 1);
+    if (auto variant = DeserializePipelineVariant(line); variant.has_value()) {
+      variants.push_back(std::move(variant.value()));
+    }
+  }
+  return variants;
+}
+
 }  // namespace impeller
@@ -6,7 +6,10 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/hash_combine.h"
@@ -14,7 +17,11 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/glyph_instance_cache.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
+#include "impeller/entity/render_pass_encoding_queue.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/render_target.h"
@@ -25,6 +32,8 @@
 #include "impeller/entity/checkerboard.vert.h"
 #endif  // IMPELLER_DEBUG
 
+#include "impeller/entity/atlas_blend_instanced.vert.h"
+#include "impeller/entity/atlas_sprite_instanced.vert.h"
 #include "impeller/entity/blend.frag.h"
 #include "impeller/entity/blend.vert.h"
 #include "impeller/entity/border_mask_blur.frag.h"
@@ -37,6 +46,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_instanced.vert.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -180,8 +190,19 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasInstancedPipeline =
+    RenderPipelineT<GlyphAtlasInstancedVertexShader, GlyphAtlasFragmentShader>;
+using GlyphAtlasColorInstancedPipeline =
+    RenderPipelineT<GlyphAtlasInstancedVertexShader,
+                    GlyphAtlasColorFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<PorterDuffBlendVertexShader, PorterDuffBlendFragmentShader>;
+using AtlasSpriteInstancedPipeline =
+    RenderPipelineT<AtlasSpriteInstancedVertexShader,
+                    TextureFillFragmentShader>;
+using AtlasBlendInstancedPipeline =
+    RenderPipelineT<AtlasBlendInstancedVertexShader,
+                    PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
 // to redirect writing to the stencil instead of color attachments.
 using ClipPipeline = RenderPipelineT<ClipVertexShader, ClipFragmentShader>;
@@ -307,6 +328,10 @@ struct ContentContextOptions {
   PrimitiveType primitive_type = PrimitiveType::kTriangle;
   PixelFormat color_attachment_pixel_format = PixelFormat::kUnknown;
   bool has_stencil_attachment = true;
+  /// When set, draws are depth tested against the depth attachment of this
+  /// format and only pass where they are deeper than what it holds.
+  PixelFormat depth_attachment_pixel_format = PixelFormat::kUnknown;
+  bool depth_write_enabled = false;
   bool wireframe = false;
   bool is_for_rrect_blur_clear = false;
 
@@ -315,7 +340,8 @@ struct ContentContextOptions {
       return fml::HashCombine(
           o.sample_count, o.blend_mode, o.stencil_compare, o.stencil_operation,
           o.primitive_type, o.color_attachment_pixel_format,
-          o.has_stencil_attachment, o.wireframe, o.is_for_rrect_blur_clear);
+          o.has_stencil_attachment, o.depth_attachment_pixel_format,
+          o.depth_write_enabled, o.wireframe, o.is_for_rrect_blur_clear);
     }
   };
 
@@ -330,6 +356,9 @@ struct ContentContextOptions {
              lhs.color_attachment_pixel_format ==
                  rhs.color_attachment_pixel_format &&
              lhs.has_stencil_attachment == rhs.has_stencil_attachment &&
+             lhs.depth_attachment_pixel_format ==
+                 rhs.depth_attachment_pixel_format &&
+             lhs.depth_write_enabled == rhs.depth_write_enabled &&
              lhs.wireframe == rhs.wireframe &&
              lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear;
     }
@@ -340,6 +369,7 @@ struct ContentContextOptions {
 
 class Tessellator;
 class RenderTargetCache;
+class RuntimeEffectCache;
 
 class ContentContext {
  public:
@@ -358,6 +388,12 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  std::shared_ptr<GradientTextureCache> GetGradientTextureCache() const;
+
+  std::shared_ptr<RuntimeEffectCache> GetRuntimeEffectCache() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -498,6 +534,18 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(glyph_atlas_instanced_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetGlyphAtlasColorInstancedPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(glyph_atlas_color_instanced_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -513,6 +561,18 @@ class ContentContext {
     return GetPipeline(porter_duff_blend_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetAtlasSpriteInstancedPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(atlas_sprite_instanced_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetAtlasBlendInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(atlas_blend_instanced_pipelines_, opts);
+  }
+
   // Advanced blends.
 
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBlendColorPipeline(
@@ -699,6 +759,75 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  /// @brief  When enabled, the textures of entity passes are given a depth
+  ///         attachment, and rectangular intersect clips are applied by
+  ///         writing the depth of the draw that restores them outside of the
+  ///         clipped area instead of by changing the stencil. Every draw in
+  ///         the pass is given an increasing depth and depth tested, so those
+  ///         clips don't have to be restored at all. Other clips still use
+  ///         the stencil. Disabled by default.
+  void SetUseDepthClips(bool use_depth_clips);
+
+  bool UsesDepthClips() const;
+
+  /// @brief  Sets the task runner on which the render passes of entity passes
+  ///         and subpasses are encoded. The backend must support encoding
+  ///         render passes that target different textures concurrently.
+  ///
+  ///         Passes are encoded as they are ended and submitted in order by
+  ///         `FlushRenderPasses`. When no task runner is set, which is the
+  ///         default, each pass is submitted as soon as it is ended.
+  void SetEncodingTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  /// @brief  Encodes `render_pass` and submits `command_buffer` after all of
+  ///         the previously submitted render passes.
+  bool SubmitRenderPass(std::shared_ptr<CommandBuffer> command_buffer,
+                        std::shared_ptr<RenderPass> render_pass) const;
+
+  /// @brief  Submits the render passes that are waiting to be encoded. Must be
+  ///         called before the submitted textures are used outside of this
+  ///         context.
+  bool FlushRenderPasses() const;
+
+  /// A pipeline variant, identified by the label of the pipeline it is a
+  /// variant of and the options it was created for.
+  struct PipelineVariant {
+    std::string pipeline_label;
+    ContentContextOptions options;
+  };
+
+  /// @brief  When enabled, a pipeline variant that is still being compiled is
+  ///         not waited for if a compiled variant of the same pipeline only
+  ///         differs from it in its blend mode. That variant is used instead
+  ///         until the exact one is ready, which approximates the draws for
+  ///         the frames it takes to compile. Disabled by default.
+  void SetUsePipelineVariantFallbacks(bool use_fallbacks);
+
+  /// @brief  The pipeline variants created after this context was, in the
+  ///         order they were created in, including the ones created by
+  ///         `WarmUpPipelineVariants`.
+  std::vector<PipelineVariant> GetCreatedPipelineVariants() const;
+
+  /// @brief  Starts compiling `variants` without waiting for them, so that
+  ///         they are ready by the time they are first used. Variants of
+  ///         pipelines this context doesn't have are ignored. Variants of
+  ///         pipelines that share a label are created for all of them.
+  ///
+  ///         Must be called on the thread this context renders on.
+  void WarmUpPipelineVariants(
+      const std::vector<PipelineVariant>& variants) const;
+
+  /// @brief  Encodes variants as a manifest with one variant per line, for
+  ///         example to ship the variants an app uses with it.
+  static std::string SerializePipelineVariants(
+      const std::vector<PipelineVariant>& variants);
+
+  /// @brief  Decodes a manifest written by `SerializePipelineVariants`.
+  ///         Malformed lines are skipped.
+  static std::vector<PipelineVariant> DeserializePipelineVariants(
+      std::string_view manifest);
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -713,6 +842,10 @@ class ContentContext {
     return lazy_glyph_atlas_;
   }
 
+  std::shared_ptr<GlyphInstanceCache> GetGlyphInstanceCache() const {
+    return glyph_instance_cache_;
+  }
+
   std::shared_ptr<RenderTargetAllocator> GetRenderTargetCache() const {
     return render_target_cache_;
   }
@@ -720,6 +853,7 @@ class ContentContext {
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
+  std::shared_ptr<GlyphInstanceCache> glyph_instance_cache_;
 
   template <class T>
   using Variants = std::unordered_map<ContentContextOptions,
@@ -770,9 +904,17 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasInstancedPipeline>
+      glyph_atlas_instanced_pipelines_;
+  mutable Variants<GlyphAtlasColorInstancedPipeline>
+      glyph_atlas_color_instanced_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
+  mutable Variants<AtlasSpriteInstancedPipeline>
+      atlas_sprite_instanced_pipelines_;
+  mutable Variants<AtlasBlendInstancedPipeline>
+      atlas_blend_instanced_pipelines_;
   // Advanced blends.
   mutable Variants<BlendColorPipeline> blend_color_pipelines_;
   mutable Variants<BlendColorBurnPipeline> blend_colorburn_pipelines_;
@@ -843,10 +985,25 @@ class ContentContext {
       opts.wireframe = true;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    auto found = container.find(opts);
+    if (found == container.end()) {
+      if (!CreateVariant(container, opts)) {
+        return nullptr;
+      }
+      found = container.find(opts);
+    }
+
+    if (use_variant_fallbacks_ && !found->second->IsReady()) {
+      if (auto fallback = GetReadyFallback(container, opts)) {
+        return fallback;
+      }
     }
+    return found->second->WaitAndGet();
+  }
 
+  template <class TypedPipeline>
+  TypedPipeline* CreateVariant(Variants<TypedPipeline>& container,
+                               const ContentContextOptions& opts) const {
     auto prototype = container.find(default_options_);
 
     // The prototype must always be initialized in the constructor.
@@ -864,18 +1021,62 @@ class ContentContext {
               SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
         });
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
+    auto result = variant.get();
     container[opts] = std::move(variant);
-    return variant_pipeline;
+    created_variants_.push_back(PipelineVariant{
+        .pipeline_label = pipeline->GetDescriptor().GetLabel(),
+        .options = opts,
+    });
+    return result;
   }
 
+  template <class TypedPipeline>
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetReadyFallback(
+      Variants<TypedPipeline>& container,
+      const ContentContextOptions& opts) const {
+    for (const auto& [options, variant] : container) {
+      auto compatible_options = options;
+      compatible_options.blend_mode = opts.blend_mode;
+      if (!variant ||
+          !ContentContextOptions::Equal{}(compatible_options, opts) ||
+          !variant->IsReady()) {
+        continue;
+      }
+      if (auto pipeline = variant->WaitAndGet()) {
+        return pipeline;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Sets up the prototype of `container` and registers it for warming up.
+  template <class TypedPipeline>
+  void InitializeVariants(Variants<TypedPipeline>& container,
+                          std::unique_ptr<TypedPipeline> prototype);
+
+  template <class TypedPipeline>
+  void InitializeVariants(Variants<TypedPipeline>& container);
+
+  struct VariantWarmer {
+    std::string pipeline_label;
+    std::function<void(const ContentContextOptions&)> create_variant;
+  };
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache_;
+  std::shared_ptr<RuntimeEffectCache> runtime_effect_cache_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   bool wireframe_ = false;
+  bool use_depth_clips_ = false;
+  bool use_variant_fallbacks_ = false;
+  std::vector<VariantWarmer> variant_warmers_;
+  mutable std::vector<PipelineVariant> created_variants_;
+  std::unique_ptr<RenderPassEncodingQueue> encoding_queue_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
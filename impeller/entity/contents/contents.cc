@@ -9,6 +9,7 @@
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/texture.h"
 #include "impeller/entity/contents/anonymous_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -24,6 +25,11 @@ ContentContextOptions OptionsFromPass(const RenderPass& pass) {
       pass.GetRenderTarget().GetRenderTargetPixelFormat();
   opts.has_stencil_attachment =
       pass.GetRenderTarget().GetStencilAttachment().has_value();
+  if (const auto& depth = pass.GetRenderTarget().GetDepthAttachment();
+      depth.has_value()) {
+    opts.depth_attachment_pixel_format =
+        depth->texture->GetTextureDescriptor().format;
+  }
   return opts;
 }
 
@@ -127,6 +133,10 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+const SolidColorContents* Contents::AsSolidColor() const {
+  return nullptr;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
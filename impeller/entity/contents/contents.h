@@ -24,6 +24,7 @@ class Entity;
 class Surface;
 class RenderPass;
 class FilterContents;
+class SolidColorContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -162,6 +163,12 @@ class Contents {
   ///
   virtual const FilterContents* AsFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Cast to a solid color. Returns `nullptr` if this Contents is not
+  ///        a solid color.
+  ///
+  virtual const SolidColorContents* AsSolidColor() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
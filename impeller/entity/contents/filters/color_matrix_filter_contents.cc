@@ -4,7 +4,9 @@
 
 #include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 
+#include <algorithm>
 #include <optional>
+#include <variant>
 
 #include "impeller/entity/contents/anonymous_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -17,6 +19,49 @@
 
 namespace impeller {
 
+namespace {
+
+/// Whether the alpha row of the matrix is the identity.
+bool PreservesAlpha(const ColorMatrix& matrix) {
+  const float* m = matrix.array;
+  return m[15] == 0 && m[16] == 0 && m[17] == 0 && m[18] == 1 && m[19] == 0;
+}
+
+/// Whether the matrix maps every unpremultiplied color into the unit range,
+/// in which case the filter never clamps its result.
+bool IsBounded(const ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    const float* m = matrix.array + row * 5;
+    Scalar min = m[4];
+    Scalar max = m[4];
+    for (size_t column = 0; column < 4; column++) {
+      min += std::min(m[column], 0.0f);
+      max += std::max(m[column], 0.0f);
+    }
+    if (min < 0 || max > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const ColorMatrixFilterContents* GetColorMatrixFilter(
+    const FilterInput& input) {
+  auto variant = input.GetInput();
+  const Contents* contents = nullptr;
+  if (auto filter = std::get_if<std::shared_ptr<FilterContents>>(&variant)) {
+    contents = filter->get();
+  } else if (auto c = std::get_if<std::shared_ptr<Contents>>(&variant)) {
+    contents = c->get();
+  }
+  if (!contents || !contents->AsFilter()) {
+    return nullptr;
+  }
+  return contents->AsFilter()->AsColorMatrixFilter();
+}
+
+}  // namespace
+
 ColorMatrixFilterContents::ColorMatrixFilterContents() = default;
 
 ColorMatrixFilterContents::~ColorMatrixFilterContents() = default;
@@ -25,6 +70,36 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+const ColorMatrix& ColorMatrixFilterContents::GetMatrix() const {
+  return matrix_;
+}
+
+std::optional<ColorMatrix> ColorMatrixFilterContents::Fold(
+    const ColorMatrix& outer,
+    const ColorMatrix& inner) {
+  if (!PreservesAlpha(outer) || !PreservesAlpha(inner) || !IsBounded(inner)) {
+    return std::nullopt;
+  }
+
+  ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    const float* o = outer.array + row * 5;
+    for (size_t column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? o[4] : 0;
+      for (size_t k = 0; k < 4; k++) {
+        value += o[k] * inner.array[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+const ColorMatrixFilterContents*
+ColorMatrixFilterContents::AsColorMatrixFilter() const {
+  return this;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -43,7 +118,27 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot("ColorMatrix", renderer, entity);
+  // Fold chained color matrix filters into this one, so that their input is
+  // filtered in a single pass instead of through an offscreen texture per
+  // filter. The opacity of the input then has to be absorbed the way the
+  // innermost folded filter would have.
+  FilterInput::Ref input = inputs[0];
+  ColorMatrix color_matrix = matrix_;
+  auto absorb_opacity = GetAbsorbOpacity();
+  while (auto inner = GetColorMatrixFilter(*input)) {
+    if (inner->GetInputs().size() != 1u) {
+      break;
+    }
+    auto folded = Fold(color_matrix, inner->GetMatrix());
+    if (!folded.has_value()) {
+      break;
+    }
+    color_matrix = folded.value();
+    absorb_opacity = inner->GetAbsorbOpacity();
+    input = inner->GetInputs()[0];
+  }
+
+  auto input_snapshot = input->GetSnapshot("ColorMatrix", renderer, entity);
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -51,8 +146,7 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
   //----------------------------------------------------------------------------
   /// Create AnonymousContents for rendering.
   ///
-  RenderProc render_proc = [input_snapshot, color_matrix = matrix_,
-                            absorb_opacity = GetAbsorbOpacity()](
+  RenderProc render_proc = [input_snapshot, color_matrix, absorb_opacity](
                                const ContentContext& renderer,
                                const Entity& entity, RenderPass& pass) -> bool {
     Command cmd;
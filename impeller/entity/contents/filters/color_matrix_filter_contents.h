@@ -22,6 +22,24 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  const ColorMatrix& GetMatrix() const;
+
+  /// @brief  Composes the color matrix `outer` with the color matrix `inner`
+  ///         that is applied before it.
+  ///
+  ///         Each filter clamps its result and writes it out premultiplied, so
+  ///         the composition only matches applying both filters when `inner`
+  ///         maps every color into the unit range, and neither of the matrices
+  ///         alters alpha.
+  ///
+  /// @return The composed matrix, or std::nullopt if the filters can't be
+  ///         folded into one.
+  static std::optional<ColorMatrix> Fold(const ColorMatrix& outer,
+                                         const ColorMatrix& inner);
+
+  // |FilterContents|
+  const ColorMatrixFilterContents* AsColorMatrixFilter() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
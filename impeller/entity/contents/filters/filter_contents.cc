@@ -37,7 +37,8 @@ std::shared_ptr<FilterContents> FilterContents::MakeDirectionalGaussianBlur(
     BlurStyle blur_style,
     Entity::TileMode tile_mode,
     bool is_second_pass,
-    Sigma secondary_sigma) {
+    Sigma secondary_sigma,
+    BlurQuality blur_quality) {
   auto blur = std::make_shared<DirectionalGaussianBlurFilterContents>();
   blur->SetInputs({std::move(input)});
   blur->SetSigma(sigma);
@@ -46,6 +47,7 @@ std::shared_ptr<FilterContents> FilterContents::MakeDirectionalGaussianBlur(
   blur->SetTileMode(tile_mode);
   blur->SetIsSecondPass(is_second_pass);
   blur->SetSecondarySigma(secondary_sigma);
+  blur->SetBlurQuality(blur_quality);
   return blur;
 }
 
@@ -54,12 +56,14 @@ std::shared_ptr<FilterContents> FilterContents::MakeGaussianBlur(
     Sigma sigma_x,
     Sigma sigma_y,
     BlurStyle blur_style,
-    Entity::TileMode tile_mode) {
-  auto x_blur = MakeDirectionalGaussianBlur(
-      input, sigma_x, Point(1, 0), BlurStyle::kNormal, tile_mode, false, {});
-  auto y_blur = MakeDirectionalGaussianBlur(FilterInput::Make(x_blur), sigma_y,
-                                            Point(0, 1), blur_style, tile_mode,
-                                            true, sigma_x);
+    Entity::TileMode tile_mode,
+    BlurQuality blur_quality) {
+  auto x_blur = MakeDirectionalGaussianBlur(input, sigma_x, Point(1, 0),
+                                            BlurStyle::kNormal, tile_mode,
+                                            false, {}, blur_quality);
+  auto y_blur = MakeDirectionalGaussianBlur(
+      FilterInput::Make(x_blur), sigma_y, Point(0, 1), blur_style, tile_mode,
+      true, sigma_x, blur_quality);
   return y_blur;
 }
 
@@ -139,6 +143,10 @@ void FilterContents::SetInputs(FilterInput::Vector inputs) {
   inputs_ = std::move(inputs);
 }
 
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 void FilterContents::SetEffectTransform(const Matrix& effect_transform) {
   effect_transform_ = effect_transform;
 
@@ -263,6 +271,10 @@ const FilterContents* FilterContents::AsFilter() const {
   return this;
 }
 
+const ColorMatrixFilterContents* FilterContents::AsColorMatrixFilter() const {
+  return nullptr;
+}
+
 Matrix FilterContents::GetLocalTransform(const Matrix& parent_transform) const {
   return Matrix();
 }
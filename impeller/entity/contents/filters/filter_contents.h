@@ -16,6 +16,8 @@
 
 namespace impeller {
 
+class ColorMatrixFilterContents;
+
 class FilterContents : public Contents {
  public:
   enum class BlurStyle {
@@ -29,6 +31,17 @@ class FilterContents : public Contents {
     kInner,
   };
 
+  enum class BlurQuality {
+    /// Blurred at the resolution of the input.
+    kFull,
+    /// Downsampled as long as the blur stays smooth. Large blurs take a
+    /// fraction of the samples.
+    kBalanced,
+    /// Downsampled further, which starts to show blocky artifacts for inputs
+    /// with sharp edges.
+    kFast,
+  };
+
   enum class MorphType { kDilate, kErode };
 
   static std::shared_ptr<FilterContents> MakeDirectionalGaussianBlur(
@@ -38,14 +51,16 @@ class FilterContents : public Contents {
       BlurStyle blur_style = BlurStyle::kNormal,
       Entity::TileMode tile_mode = Entity::TileMode::kDecal,
       bool is_second_pass = false,
-      Sigma secondary_sigma = {});
+      Sigma secondary_sigma = {},
+      BlurQuality blur_quality = BlurQuality::kBalanced);
 
   static std::shared_ptr<FilterContents> MakeGaussianBlur(
       const FilterInput::Ref& input,
       Sigma sigma_x,
       Sigma sigma_y,
       BlurStyle blur_style = BlurStyle::kNormal,
-      Entity::TileMode tile_mode = Entity::TileMode::kDecal);
+      Entity::TileMode tile_mode = Entity::TileMode::kDecal,
+      BlurQuality blur_quality = BlurQuality::kBalanced);
 
   static std::shared_ptr<FilterContents> MakeBorderMaskBlur(
       FilterInput::Ref input,
@@ -89,6 +104,8 @@ class FilterContents : public Contents {
   ///         particular filter's implementation.
   void SetInputs(FilterInput::Vector inputs);
 
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Sets the transform which gets appended to the effect of this
   ///         filter. Note that this is in addition to the entity's transform.
   ///
@@ -128,6 +145,11 @@ class FilterContents : public Contents {
   // |Contents|
   const FilterContents* AsFilter() const override;
 
+  /// @brief  Returns this filter if it is a color matrix filter, which lets a
+  ///         color matrix filter on top of it fold both matrices into a single
+  ///         pass.
+  virtual const ColorMatrixFilterContents* AsColorMatrixFilter() const;
+
   virtual Matrix GetLocalTransform(const Matrix& parent_transform) const;
 
   Matrix GetTransform(const Matrix& parent_transform) const;
@@ -23,6 +23,73 @@
 
 namespace impeller {
 
+namespace {
+
+constexpr int kMaxDownsampleLevels = 4;
+
+// Halves the size of `texture` `levels` times. Every level samples the one
+// before it with a linear filter, which averages 2x2 texels.
+std::shared_ptr<Texture> Downsample(const ContentContext& renderer,
+                                    std::shared_ptr<Texture> texture,
+                                    int levels) {
+  using VS = TexturePipeline::VertexShader;
+  using FS = TexturePipeline::FragmentShader;
+
+  SamplerDescriptor sampler_desc;
+  sampler_desc.min_filter = MinMagFilter::kLinear;
+  sampler_desc.mag_filter = MinMagFilter::kLinear;
+  sampler_desc.width_address_mode = SamplerAddressMode::kClampToEdge;
+  sampler_desc.height_address_mode = SamplerAddressMode::kClampToEdge;
+  auto sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  for (int level = 0; level < levels; level++) {
+    ContentContext::SubpassCallback subpass_callback =
+        [&texture, &sampler](const ContentContext& renderer,
+                             RenderPass& pass) {
+          auto& host_buffer = pass.GetTransientsBuffer();
+
+          VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+          vtx_builder.AddVertices({
+              {Point(0, 0), Point(0, 0)},
+              {Point(1, 0), Point(1, 0)},
+              {Point(0, 1), Point(0, 1)},
+              {Point(1, 1), Point(1, 1)},
+          });
+
+          VS::FrameInfo frame_info;
+          frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+          frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+          frame_info.alpha = 1.0;
+
+          auto options = OptionsFromPass(pass);
+          options.blend_mode = BlendMode::kSource;
+          options.primitive_type = PrimitiveType::kTriangleStrip;
+
+          Command cmd;
+          DEBUG_COMMAND_INFO(cmd, "Gaussian Blur Downsample");
+          cmd.pipeline = renderer.GetTexturePipeline(options);
+          cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+          VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+          FS::BindTextureSampler(cmd, texture, sampler);
+          return pass.AddCommand(std::move(cmd));
+        };
+
+    auto size = texture->GetSize();
+    auto downsampled_size = ISize(std::max<int64_t>(1, (size.width + 1) / 2),
+                                  std::max<int64_t>(1, (size.height + 1) / 2));
+    texture = renderer.MakeSubpass("Gaussian Blur Downsample",
+                                   downsampled_size, subpass_callback,
+                                   /*msaa_enabled=*/false);
+    if (!texture) {
+      return nullptr;
+    }
+  }
+  return texture;
+}
+
+}  // namespace
+
 DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
     default;
 
@@ -58,6 +125,34 @@ void DirectionalGaussianBlurFilterContents::SetIsSecondPass(
   is_second_pass_ = is_second_pass;
 }
 
+void DirectionalGaussianBlurFilterContents::SetBlurQuality(
+    BlurQuality blur_quality) {
+  blur_quality_ = blur_quality;
+}
+
+int DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+    Scalar texel_sigma,
+    BlurQuality blur_quality) {
+  // The smallest sigma, in downsampled texels, that the blur is allowed to
+  // have. Below it the linear filter that upsamples the result shows.
+  Scalar min_texel_sigma = 0;
+  switch (blur_quality) {
+    case BlurQuality::kFull:
+      return 0;
+    case BlurQuality::kBalanced:
+      min_texel_sigma = 16;
+      break;
+    case BlurQuality::kFast:
+      min_texel_sigma = 4;
+      break;
+  }
+  if (texel_sigma < min_texel_sigma * 2) {
+    return 0;
+  }
+  return std::min(kMaxDownsampleLevels,
+                  static_cast<int>(std::log2(texel_sigma / min_texel_sigma)));
+}
+
 std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -117,6 +212,34 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
         entity.GetStencilDepth());  // No blur to render.
   }
 
+  // Blurring a downsampled input takes a fraction of the samples for the same
+  // sigma. The output is already smaller than the input and is upsampled with
+  // a linear filter when it is drawn.
+  Scalar sample_step = 1;
+  {
+    auto texels_per_pixel =
+        input_snapshot->transform.Invert()
+            .TransformDirection(transformed_blur_radius.Normalize())
+            .GetLength();
+    auto downsample_levels = ComputeDownsampleLevels(
+        Sigma{Radius{transformed_blur_radius_length}}.sigma * texels_per_pixel,
+        blur_quality_);
+    if (downsample_levels > 0) {
+      auto input_size = input_snapshot->texture->GetSize();
+      auto downsampled =
+          Downsample(renderer, input_snapshot->texture, downsample_levels);
+      if (!downsampled) {
+        return std::nullopt;
+      }
+      input_snapshot->transform =
+          input_snapshot->transform *
+          Matrix::MakeScale(Vector2(input_size) /
+                            Vector2(downsampled->GetSize()));
+      input_snapshot->texture = downsampled;
+      sample_step = 1 << downsample_levels;
+    }
+  }
+
   // A matrix that rotates the snapshot space such that the blur direction is
   // +X.
   auto texture_rotate = Matrix::MakeRotationZ(
@@ -173,13 +296,13 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
 
     FS::BlurInfo frag_info;
     auto r = Radius{transformed_blur_radius_length};
-    frag_info.blur_sigma = Sigma{r}.sigma;
-    frag_info.blur_radius = std::round(r.radius);
+    frag_info.blur_sigma = Sigma{r}.sigma / sample_step;
+    frag_info.blur_radius = std::round(r.radius / sample_step);
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * sample_step;
 
     Command cmd;
     DEBUG_COMMAND_INFO(cmd, SPrintF("Gaussian Blur Filter (Radius=%.2f)",
@@ -29,6 +29,15 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
 
   void SetIsSecondPass(bool is_second_pass);
 
+  void SetBlurQuality(BlurQuality blur_quality);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of times the input is halved before it is blurred
+  ///             with a sigma of `texel_sigma` input texels.
+  ///
+  static int ComputeDownsampleLevels(Scalar texel_sigma,
+                                     BlurQuality blur_quality);
+
   // |FilterContents|
   std::optional<Rect> GetFilterCoverage(
       const FilterInput::Vector& inputs,
@@ -50,6 +59,7 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
   BlurStyle blur_style_ = BlurStyle::kNormal;
   Entity::TileMode tile_mode_ = Entity::TileMode::kDecal;
   bool is_second_pass_ = false;
+  BlurQuality blur_quality_ = BlurQuality::kBalanced;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DirectionalGaussianBlurFilterContents);
 };
@@ -37,6 +37,14 @@ void YUVToRGBFilterContents::SetYUVColorSpace(YUVColorSpace yuv_color_space) {
   yuv_color_space_ = yuv_color_space;
 }
 
+void YUVToRGBFilterContents::SetSamplerDescriptor(SamplerDescriptor desc) {
+  sampler_descriptor_ = std::move(desc);
+}
+
+void YUVToRGBFilterContents::SetOpacity(Scalar opacity) {
+  opacity_ = opacity;
+}
+
 std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -70,7 +78,9 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
   /// Create AnonymousContents for rendering.
   ///
   RenderProc render_proc = [y_input_snapshot, uv_input_snapshot,
-                            yuv_color_space = yuv_color_space_](
+                            yuv_color_space = yuv_color_space_,
+                            sampler_descriptor = sampler_descriptor_,
+                            opacity = opacity_](
                                const ContentContext& renderer,
                                const Entity& entity, RenderPass& pass) -> bool {
     Command cmd;
@@ -105,6 +115,7 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
 
     FS::FragInfo frag_info;
     frag_info.yuv_color_space = static_cast<Scalar>(yuv_color_space);
+    frag_info.alpha = opacity;
     switch (yuv_color_space) {
       case YUVColorSpace::kBT601LimitedRange:
         frag_info.matrix = kMatrixBT601LimitedRange;
@@ -114,7 +125,8 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
         break;
     }
 
-    auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
+    auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+        sampler_descriptor);
     FS::BindYTexture(cmd, y_input_snapshot->texture, sampler);
     FS::BindUvTexture(cmd, uv_input_snapshot->texture, sampler);
 
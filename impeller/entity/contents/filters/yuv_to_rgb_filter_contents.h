@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 
 namespace impeller {
@@ -16,6 +17,12 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  void SetSamplerDescriptor(SamplerDescriptor desc);
+
+  /// Multiplies the converted color, so that the planes can be drawn with
+  /// opacity without rendering them to an RGB texture first.
+  void SetOpacity(Scalar opacity);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -27,6 +34,8 @@ class YUVToRGBFilterContents final : public FilterContents {
       const std::optional<Rect>& coverage_hint) const override;
 
   YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
+  SamplerDescriptor sampler_descriptor_ = {};
+  Scalar opacity_ = 1.0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(YUVToRGBFilterContents);
 };
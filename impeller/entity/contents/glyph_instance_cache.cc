@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/glyph_instance_cache.h"
+
+#include <algorithm>
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+namespace {
+
+std::vector<GlyphInstanceData> BuildInstances(const TextFrame& frame,
+                                              const GlyphAtlas& atlas,
+                                              Scalar scale) {
+  std::vector<GlyphInstanceData> instances;
+  size_t glyph_count = 0;
+  for (const auto& run : frame.GetRuns()) {
+    glyph_count += run.GetGlyphPositions().size();
+  }
+  instances.reserve(glyph_count);
+
+  for (const TextRun& run : frame.GetRuns()) {
+    const Font& font = run.GetFont();
+    Scalar rounded_scale =
+        TextFrame::RoundScaledFontSize(scale, font.GetMetrics().point_size);
+    const FontGlyphAtlas* font_atlas =
+        atlas.GetFontGlyphAtlas(font, rounded_scale);
+    if (!font_atlas) {
+      VALIDATION_LOG << "Could not find font in the atlas.";
+      continue;
+    }
+
+    for (const TextRun::GlyphPosition& glyph_position :
+         run.GetGlyphPositions()) {
+      std::optional<Rect> maybe_atlas_glyph_bounds =
+          font_atlas->FindGlyphBounds(glyph_position.glyph);
+      if (!maybe_atlas_glyph_bounds.has_value()) {
+        VALIDATION_LOG << "Could not find glyph position in the atlas.";
+        continue;
+      }
+      const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
+      const Rect& glyph_bounds = glyph_position.glyph.bounds;
+      instances.push_back(GlyphInstanceData{
+          .atlas_glyph_bounds = Vector4(
+              atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
+              atlas_glyph_bounds.size.width, atlas_glyph_bounds.size.height),
+          .glyph_bounds =
+              Vector4(glyph_position.position.x + glyph_bounds.origin.x,
+                      glyph_position.position.y + glyph_bounds.origin.y,
+                      glyph_bounds.size.width, glyph_bounds.size.height),
+      });
+    }
+  }
+  return instances;
+}
+
+}  // namespace
+
+GlyphInstanceCache::GlyphInstanceCache() = default;
+
+GlyphInstanceCache::~GlyphInstanceCache() = default;
+
+const std::vector<GlyphInstanceData>& GlyphInstanceCache::GetInstances(
+    const std::shared_ptr<TextFrame>& frame,
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    Scalar scale) {
+  auto& entry = entries_[frame.get()];
+  if (entry.frame.lock() == frame && entry.atlas.lock() == atlas &&
+      entry.scale == scale) {
+    return entry.instances;
+  }
+
+  entry.frame = frame;
+  entry.atlas = atlas;
+  entry.scale = scale;
+  entry.instances = BuildInstances(*frame, *atlas, scale);
+
+  if (entries_.size() >= sweep_threshold_) {
+    RemoveExpiredEntries();
+    sweep_threshold_ = std::max(kMinSweepThreshold, entries_.size() * 2);
+  }
+  // Removing expired entries never removes the entry of `frame`, which is
+  // still alive, and erasing from an unordered map doesn't invalidate
+  // references to the other elements.
+  return entry.instances;
+}
+
+size_t GlyphInstanceCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+void GlyphInstanceCache::RemoveExpiredEntries() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.frame.expired() || it->second.atlas.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace impeller
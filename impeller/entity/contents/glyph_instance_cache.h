@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/typographer/glyph_atlas.h"
+#include "impeller/typographer/text_frame.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The per glyph data of the instanced glyph atlas shader. Matches
+///             the `GlyphInstance` struct in `glyph_atlas_instanced.vert`.
+///
+struct GlyphInstanceData {
+  /// The XYWH bounds of the glyph in the atlas.
+  Vector4 atlas_glyph_bounds;
+  /// The XYWH bounds of the glyph relative to the origin of the text frame.
+  Vector4 glyph_bounds;
+};
+
+static_assert(sizeof(GlyphInstanceData) == 8 * sizeof(Scalar));
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the glyph instance data of text frames across frames.
+///
+///             The instance data of a text frame only depends on the glyph
+///             atlas and the scale at which the frame was added to it. Glyph
+///             atlases are reused and appended to for as long as the glyphs
+///             they already contain keep their location, so the instance data
+///             of text frames that are drawn again unchanged is only looked up
+///             in the atlas once.
+///
+///             Text frames are immutable once they are shared, which is what
+///             allows them to be identified by their address. Entries are
+///             dropped once their text frame or atlas has been destroyed.
+///
+class GlyphInstanceCache {
+ public:
+  GlyphInstanceCache();
+
+  ~GlyphInstanceCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the instance data of every glyph of `frame` found in
+  ///             `atlas`, building it if it isn't cached for that atlas and
+  ///             scale yet.
+  ///
+  const std::vector<GlyphInstanceData>& GetInstances(
+      const std::shared_ptr<TextFrame>& frame,
+      const std::shared_ptr<GlyphAtlas>& atlas,
+      Scalar scale);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    std::weak_ptr<TextFrame> frame;
+    std::weak_ptr<GlyphAtlas> atlas;
+    Scalar scale = 0.0;
+    std::vector<GlyphInstanceData> instances;
+  };
+
+  static constexpr size_t kMinSweepThreshold = 64u;
+
+  std::unordered_map<const TextFrame*, Entry> entries_;
+  size_t sweep_threshold_ = kMinSweepThreshold;
+
+  void RemoveExpiredEntries();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphInstanceCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/runtime_effect_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+std::shared_ptr<const RuntimeEffectLayout> RuntimeEffectLayout::Make(
+    const RuntimeStage& runtime_stage) {
+  auto layout = std::make_shared<RuntimeEffectLayout>();
+  layout->metadata = std::make_shared<ShaderMetadata>();
+
+  // Sampler uniforms are ordered in the IPLR according to their declaration
+  // and the uniform location reflects the correct offset to be mapped to -
+  // except that it may include all proceeding float uniforms. For example, a
+  // float sampler that comes after 4 float uniforms may have a location of 4.
+  // To convert to the actual offset we need to find the largest location
+  // assigned to a float uniform and then subtract this from all uniform
+  // locations. This is more or less the same operation we previously
+  // performed in the shader compiler.
+  size_t minimum_sampler_index = 100000000;
+  size_t buffer_offset = 0;
+  for (const auto& uniform : runtime_stage.GetUniforms()) {
+    switch (uniform.type) {
+      case kSampledImage:
+        minimum_sampler_index =
+            std::min(minimum_sampler_index, uniform.location);
+        break;
+      case kFloat:
+        layout->float_uniforms.push_back(RuntimeEffectLayout::FloatUniform{
+            .name = uniform.name.c_str(),
+            .location = uniform.location,
+            .size = uniform.GetSize(),
+            .alignment =
+                std::max(uniform.bit_width / 8, DefaultUniformAlignment()),
+            .offset = buffer_offset,
+        });
+        buffer_offset += uniform.GetSize();
+        break;
+      case kBoolean:
+      case kSignedByte:
+      case kUnsignedByte:
+      case kSignedShort:
+      case kUnsignedShort:
+      case kSignedInt:
+      case kUnsignedInt:
+      case kSignedInt64:
+      case kUnsignedInt64:
+      case kHalfFloat:
+      case kDouble:
+        VALIDATION_LOG << "Unsupported uniform type for " << uniform.name
+                       << ".";
+        layout->is_valid = false;
+        return layout;
+    }
+  }
+
+  for (const auto& uniform : runtime_stage.GetUniforms()) {
+    if (uniform.type == kSampledImage) {
+      layout->samplers.push_back(RuntimeEffectLayout::Sampler{
+          .name = uniform.name.c_str(),
+          .index = uniform.location - minimum_sampler_index,
+      });
+    }
+  }
+  return layout;
+}
+
+RuntimeEffectCache::RuntimeEffectCache() = default;
+
+RuntimeEffectCache::~RuntimeEffectCache() = default;
+
+std::shared_ptr<const RuntimeEffectLayout> RuntimeEffectCache::GetLayout(
+    const std::shared_ptr<RuntimeStage>& runtime_stage) {
+  auto found = layouts_.find(runtime_stage.get());
+  if (found != layouts_.end() &&
+      found->second.runtime_stage.lock() == runtime_stage) {
+    return found->second.layout;
+  }
+
+  // Drop the layouts of stages that have been collected, some of which may
+  // have lived at the address of this one.
+  for (auto it = layouts_.begin(); it != layouts_.end();) {
+    if (it->second.runtime_stage.expired()) {
+      it = layouts_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto layout = RuntimeEffectLayout::Make(*runtime_stage);
+  layouts_[runtime_stage.get()] = LayoutEntry{
+      .runtime_stage = runtime_stage,
+      .layout = layout,
+  };
+  return layout;
+}
+
+std::shared_ptr<Pipeline<PipelineDescriptor>> RuntimeEffectCache::GetPipeline(
+    const std::string& entrypoint,
+    const ContentContextOptions& options) const {
+  auto pipelines = pipelines_.find(entrypoint);
+  if (pipelines == pipelines_.end()) {
+    return nullptr;
+  }
+  auto found = pipelines->second.find(options);
+  if (found == pipelines->second.end()) {
+    return nullptr;
+  }
+  return found->second;
+}
+
+void RuntimeEffectCache::SetPipeline(
+    const std::string& entrypoint,
+    const ContentContextOptions& options,
+    std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline) {
+  pipelines_[entrypoint][options] = std::move(pipeline);
+}
+
+void RuntimeEffectCache::InvalidatePipelines(const std::string& entrypoint) {
+  pipelines_.erase(entrypoint);
+}
+
+size_t RuntimeEffectCache::GetLayoutCount() const {
+  return layouts_.size();
+}
+
+size_t RuntimeEffectCache::GetPipelineCount() const {
+  size_t count = 0u;
+  for (const auto& [_, pipelines] : pipelines_) {
+    count += pipelines.size();
+  }
+  return count;
+}
+
+}  // namespace impeller
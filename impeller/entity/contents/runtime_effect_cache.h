@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/shader_types.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/renderer/pipeline.h"
+#include "impeller/runtime_stage/runtime_stage.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Where the uniforms of a runtime stage are bound, worked out
+///             once from its uniform descriptions.
+///
+struct RuntimeEffectLayout {
+  struct FloatUniform {
+    const char* name = nullptr;
+    size_t location = 0u;
+    size_t size = 0u;
+    size_t alignment = 0u;
+    /// The offset of the uniform in the uniform data of the effect.
+    size_t offset = 0u;
+  };
+
+  struct Sampler {
+    const char* name = nullptr;
+    size_t index = 0u;
+  };
+
+  std::vector<FloatUniform> float_uniforms;
+  std::vector<Sampler> samplers;
+  // TODO(113715): Populate this metadata once GLES is able to handle
+  //               non-struct uniform names.
+  std::shared_ptr<ShaderMetadata> metadata;
+  /// Whether every uniform has a type that can be bound.
+  bool is_valid = true;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the layout of a runtime stage. The names point into
+  ///             the uniform descriptions of the stage, which has to outlive
+  ///             the layout.
+  ///
+  static std::shared_ptr<const RuntimeEffectLayout> Make(
+      const RuntimeStage& runtime_stage);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the uniform layouts of runtime stages and the pipelines
+///             that draw them, so that runtime effects don't walk their
+///             uniform descriptions or build pipeline descriptors on every
+///             render.
+///
+///             Layouts are kept for as long as their runtime stage is alive.
+///             Pipelines are kept by entrypoint, and have to be invalidated
+///             when the shader of an entrypoint is replaced.
+///
+class RuntimeEffectCache {
+ public:
+  RuntimeEffectCache();
+
+  ~RuntimeEffectCache();
+
+  std::shared_ptr<const RuntimeEffectLayout> GetLayout(
+      const std::shared_ptr<RuntimeStage>& runtime_stage);
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
+      const std::string& entrypoint,
+      const ContentContextOptions& options) const;
+
+  void SetPipeline(const std::string& entrypoint,
+                   const ContentContextOptions& options,
+                   std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the pipelines of an entrypoint whose shader changed.
+  ///
+  void InvalidatePipelines(const std::string& entrypoint);
+
+  size_t GetLayoutCount() const;
+
+  size_t GetPipelineCount() const;
+
+ private:
+  struct LayoutEntry {
+    std::weak_ptr<RuntimeStage> runtime_stage;
+    std::shared_ptr<const RuntimeEffectLayout> layout;
+  };
+
+  using Pipelines =
+      std::unordered_map<ContentContextOptions,
+                         std::shared_ptr<Pipeline<PipelineDescriptor>>,
+                         ContentContextOptions::Hash,
+                         ContentContextOptions::Equal>;
+
+  std::unordered_map<const RuntimeStage*, LayoutEntry> layouts_;
+  std::unordered_map<std::string, Pipelines> pipelines_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RuntimeEffectCache);
+};
+
+}  // namespace impeller
@@ -9,11 +9,13 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/shader_types.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/runtime_effect_cache.h"
 #include "impeller/entity/runtime_effect.vert.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_pass.h"
@@ -22,6 +24,64 @@
 
 namespace impeller {
 
+// The helpers are only used where runtime effects are rendered.
+#ifndef FML_OS_ANDROID
+namespace {
+
+/// Returns the registered shader of the runtime stage, after removing the
+/// shader of an earlier runtime stage with the same entrypoint, such as one
+/// that has since been hot reloaded.
+std::shared_ptr<const ShaderFunction> GetCurrentFunction(
+    const Context& context,
+    const RuntimeStage& runtime_stage) {
+  auto library = context.GetShaderLibrary();
+  auto function = library->GetFunction(runtime_stage.GetEntrypoint(),
+                                       ShaderStage::kFragment);
+  if (function && runtime_stage.IsDirty()) {
+    context.GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
+    library->UnregisterFunction(runtime_stage.GetEntrypoint(),
+                                ShaderStage::kFragment);
+    return nullptr;
+  }
+  return function;
+}
+
+PipelineDescriptor CreatePipelineDescriptor(
+    const Context& context,
+    const RuntimeStage& runtime_stage,
+    const ContentContextOptions& options) {
+  using VS = RuntimeEffectVertexShader;
+
+  auto library = context.GetShaderLibrary();
+  const auto& caps = context.GetCapabilities();
+  const auto color_attachment_format = caps->GetDefaultColorFormat();
+  const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
+
+  PipelineDescriptor desc;
+  desc.SetLabel("Runtime Stage");
+  desc.AddStageEntrypoint(
+      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
+  desc.AddStageEntrypoint(library->GetFunction(runtime_stage.GetEntrypoint(),
+                                               ShaderStage::kFragment));
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
+                                    VS::kInterleavedBufferLayout);
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+  desc.SetColorAttachmentDescriptor(
+      0u, {.format = color_attachment_format, .blending_enabled = true});
+
+  StencilAttachmentDescriptor stencil0;
+  stencil0.stencil_compare = CompareFunction::kEqual;
+  desc.SetStencilAttachmentDescriptors(stencil0);
+  desc.SetStencilPixelFormat(stencil_attachment_format);
+
+  options.ApplyToPipelineDescriptor(desc);
+  return desc;
+}
+
+}  // namespace
+#endif  // FML_OS_ANDROID
+
 void RuntimeEffectContents::SetRuntimeStage(
     std::shared_ptr<RuntimeStage> runtime_stage) {
   runtime_stage_ = std::move(runtime_stage);
@@ -41,6 +101,58 @@ bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
   return false;
 }
 
+void RuntimeEffectContents::WarmUp(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<RuntimeStage>& runtime_stage) {
+#ifndef FML_OS_ANDROID
+  if (!context || !runtime_stage || !runtime_stage->IsValid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "RuntimeEffectContents::WarmUp");
+
+  // The pipelines of fills drawn to the default color format, which are what
+  // most runtime effects render, are requested but not waited for. Pipeline
+  // libraries return the same pipeline when draws ask for it later.
+  auto create_pipelines = [weak_context = std::weak_ptr<Context>(context),
+                           runtime_stage]() {
+    auto context = weak_context.lock();
+    if (!context) {
+      return;
+    }
+    const auto& caps = context->GetCapabilities();
+    ContentContextOptions options;
+    options.sample_count = caps->SupportsOffscreenMSAA() ? SampleCount::kCount4
+                                                         : SampleCount::kCount1;
+    options.color_attachment_pixel_format = caps->GetDefaultColorFormat();
+    for (auto primitive_type :
+         {PrimitiveType::kTriangle, PrimitiveType::kTriangleStrip}) {
+      options.primitive_type = primitive_type;
+      context->GetPipelineLibrary()->GetPipeline(
+          CreatePipelineDescriptor(*context, *runtime_stage, options));
+    }
+  };
+
+  if (GetCurrentFunction(*context, *runtime_stage)) {
+    runtime_stage->SetClean();
+    create_pipelines();
+    return;
+  }
+
+  // Draws that need the shader before it is registered register it again
+  // themselves rather than waiting for this.
+  runtime_stage->SetClean();
+  context->GetShaderLibrary()->RegisterFunction(
+      runtime_stage->GetEntrypoint(),
+      ToShaderStage(runtime_stage->GetShaderStage()),
+      runtime_stage->GetCodeMapping(),
+      [create_pipelines](bool result) {
+        if (result) {
+          create_pipelines();
+        }
+      });
+#endif  // FML_OS_ANDROID
+}
+
 bool RuntimeEffectContents::Render(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const {
@@ -53,23 +165,17 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
 
   auto context = renderer.GetContext();
   auto library = context->GetShaderLibrary();
+  auto runtime_effect_cache = renderer.GetRuntimeEffectCache();
 
   //--------------------------------------------------------------------------
   /// Get or register shader.
   ///
 
-  // TODO(113719): Register the shader function earlier.
-
-  std::shared_ptr<const ShaderFunction> function = library->GetFunction(
-      runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
-
-  if (function && runtime_stage_->IsDirty()) {
-    context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
-    library->UnregisterFunction(runtime_stage_->GetEntrypoint(),
-                                ShaderStage::kFragment);
-
-    function = nullptr;
+  if (runtime_stage_->IsDirty()) {
+    runtime_effect_cache->InvalidatePipelines(runtime_stage_->GetEntrypoint());
   }
+  std::shared_ptr<const ShaderFunction> function =
+      GetCurrentFunction(*context, *runtime_stage_);
 
   if (!function) {
     std::promise<bool> promise;
@@ -98,8 +204,12 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
           << runtime_stage_->GetEntrypoint() << ")";
       return false;
     }
+  }
+  runtime_stage_->SetClean();
 
-    runtime_stage_->SetClean();
+  auto layout = runtime_effect_cache->GetLayout(runtime_stage_);
+  if (!layout->is_valid) {
+    return true;
   }
 
   //--------------------------------------------------------------------------
@@ -113,43 +223,28 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Get or create runtime stage pipeline.
   ///
 
-  const auto& caps = context->GetCapabilities();
-  const auto color_attachment_format = caps->GetDefaultColorFormat();
-  const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
-
-  using VS = RuntimeEffectVertexShader;
-  PipelineDescriptor desc;
-  desc.SetLabel("Runtime Stage");
-  desc.AddStageEntrypoint(
-      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                               ShaderStage::kFragment));
-  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
-  vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
-                                    VS::kInterleavedBufferLayout);
-  desc.SetVertexDescriptor(std::move(vertex_descriptor));
-  desc.SetColorAttachmentDescriptor(
-      0u, {.format = color_attachment_format, .blending_enabled = true});
-
-  StencilAttachmentDescriptor stencil0;
-  stencil0.stencil_compare = CompareFunction::kEqual;
-  desc.SetStencilAttachmentDescriptors(stencil0);
-  desc.SetStencilPixelFormat(stencil_attachment_format);
-
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  auto pipeline = runtime_effect_cache->GetPipeline(
+      runtime_stage_->GetEntrypoint(), options);
   if (!pipeline) {
-    VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
-    return false;
+    auto desc = CreatePipelineDescriptor(*context, *runtime_stage_, options);
+    pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+    if (!pipeline) {
+      VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
+      return false;
+    }
+    runtime_effect_cache->SetPipeline(runtime_stage_->GetEntrypoint(),
+                                      options, pipeline);
   }
 
+  using VS = RuntimeEffectVertexShader;
+
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "RuntimeEffectContents");
   cmd.pipeline = pipeline;
@@ -168,89 +263,32 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Fragment stage uniforms.
   ///
 
-  size_t minimum_sampler_index = 100000000;
-  size_t buffer_index = 0;
-  size_t buffer_offset = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    std::shared_ptr<ShaderMetadata> metadata =
-        std::make_shared<ShaderMetadata>();
-
-    switch (uniform.type) {
-      case kSampledImage: {
-        // Sampler uniforms are ordered in the IPLR according to their
-        // declaration and the uniform location reflects the correct offset to
-        // be mapped to - except that it may include all proceeding float
-        // uniforms. For example, a float sampler that comes after 4 float
-        // uniforms may have a location of 4. To convert to the actual offset we
-        // need to find the largest location assigned to a float uniform and
-        // then subtract this from all uniform locations. This is more or less
-        // the same operation we previously performed in the shader compiler.
-        minimum_sampler_index =
-            std::min(minimum_sampler_index, uniform.location);
-        break;
-      }
-      case kFloat: {
-        size_t alignment =
-            std::max(uniform.bit_width / 8, DefaultUniformAlignment());
-        auto buffer_view = pass.GetTransientsBuffer().Emplace(
-            uniform_data_->data() + buffer_offset, uniform.GetSize(),
-            alignment);
-
-        ShaderUniformSlot uniform_slot;
-        uniform_slot.name = uniform.name.c_str();
-        uniform_slot.ext_res_0 = uniform.location;
-        cmd.BindResource(ShaderStage::kFragment, uniform_slot, metadata,
-                         buffer_view);
-        buffer_index++;
-        buffer_offset += uniform.GetSize();
-        break;
-      }
-      case kBoolean:
-      case kSignedByte:
-      case kUnsignedByte:
-      case kSignedShort:
-      case kUnsignedShort:
-      case kSignedInt:
-      case kUnsignedInt:
-      case kSignedInt64:
-      case kUnsignedInt64:
-      case kHalfFloat:
-      case kDouble:
-        VALIDATION_LOG << "Unsupported uniform type for " << uniform.name
-                       << ".";
-        return true;
-    }
+  for (const auto& uniform : layout->float_uniforms) {
+    auto buffer_view = pass.GetTransientsBuffer().Emplace(
+        uniform_data_->data() + uniform.offset, uniform.size,
+        uniform.alignment);
+
+    ShaderUniformSlot uniform_slot;
+    uniform_slot.name = uniform.name;
+    uniform_slot.ext_res_0 = uniform.location;
+    cmd.BindResource(ShaderStage::kFragment, uniform_slot, layout->metadata,
+                     buffer_view);
   }
 
-  size_t sampler_index = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    ShaderMetadata metadata;
-
-    switch (uniform.type) {
-      case kSampledImage: {
-        FML_DCHECK(sampler_index < texture_inputs_.size());
-        auto& input = texture_inputs_[sampler_index];
-
-        auto sampler =
-            context->GetSamplerLibrary()->GetSampler(input.sampler_descriptor);
-
-        SampledImageSlot image_slot;
-        image_slot.name = uniform.name.c_str();
-        image_slot.texture_index = uniform.location - minimum_sampler_index;
-        image_slot.sampler_index = uniform.location - minimum_sampler_index;
-        cmd.BindResource(ShaderStage::kFragment, image_slot, metadata,
-                         input.texture, sampler);
-
-        sampler_index++;
-        break;
-      }
-      default:
-        continue;
-    }
+  FML_DCHECK(layout->samplers.size() <= texture_inputs_.size());
+  for (size_t i = 0; i < layout->samplers.size(); i++) {
+    const auto& sampler_slot = layout->samplers[i];
+    const auto& input = texture_inputs_[i];
+
+    auto sampler =
+        context->GetSamplerLibrary()->GetSampler(input.sampler_descriptor);
+
+    SampledImageSlot image_slot;
+    image_slot.name = sampler_slot.name;
+    image_slot.texture_index = sampler_slot.index;
+    image_slot.sampler_index = sampler_slot.index;
+    cmd.BindResource(ShaderStage::kFragment, image_slot, *layout->metadata,
+                     input.texture, sampler);
   }
 
   pass.AddCommand(std::move(cmd));
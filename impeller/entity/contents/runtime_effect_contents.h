@@ -14,6 +14,8 @@
 
 namespace impeller {
 
+class Context;
+
 class RuntimeEffectContents final : public ColorSourceContents {
  public:
   struct TextureInput {
@@ -21,6 +23,17 @@ class RuntimeEffectContents final : public ColorSourceContents {
     std::shared_ptr<Texture> texture;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the shader of a runtime stage and starts building
+  ///             the pipelines of its common fills without waiting for either,
+  ///             so that the first frames drawing with it don't have to.
+  ///
+  ///             This must be called on the thread that renders with the
+  ///             runtime stage.
+  ///
+  static void WarmUp(const std::shared_ptr<Context>& context,
+                     const std::shared_ptr<RuntimeStage>& runtime_stage);
+
   void SetRuntimeStage(std::shared_ptr<RuntimeStage> runtime_stage);
 
   void SetUniformData(std::shared_ptr<std::vector<uint8_t>> uniform_data);
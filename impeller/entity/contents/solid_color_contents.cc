@@ -9,6 +9,7 @@
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -28,6 +29,10 @@ bool SolidColorContents::IsSolidColor() const {
   return true;
 }
 
+const SolidColorContents* SolidColorContents::AsSolidColor() const {
+  return this;
+}
+
 bool SolidColorContents::IsOpaque() const {
   return GetColor().IsOpaque();
 }
@@ -52,6 +57,18 @@ bool SolidColorContents::Render(const ContentContext& renderer,
 
   using VS = SolidFillPipeline::VertexShader;
 
+  // The stencil buffer can only count winding numbers where no clip has been
+  // written to it.
+  if (entity.GetStencilDepth() == 0 &&
+      pass.GetRenderTarget().GetStencilAttachment().has_value()) {
+    auto stencil_cover_result =
+        GetGeometry()->GetStencilCoverBuffer(renderer, entity, pass);
+    if (stencil_cover_result.has_value()) {
+      return RenderStencilCover(renderer, entity, pass,
+                                stencil_cover_result.value());
+    }
+  }
+
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "Solid Fill");
   cmd.stencil_reference = entity.GetStencilDepth();
@@ -86,6 +103,80 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::RenderStencilCover(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const StencilCoverGeometryResult& geometry) const {
+  auto coverage = GetCoverage(entity);
+  if (!coverage.has_value()) {
+    return true;
+  }
+
+  {
+    using VS = ClipPipeline::VertexShader;
+
+    const bool is_even_odd = geometry.fill_type == FillType::kOdd;
+    auto options = OptionsFromPass(pass);
+    options.blend_mode = BlendMode::kDestination;
+    options.stencil_compare = CompareFunction::kAlways;
+    options.primitive_type = PrimitiveType::kTriangle;
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = geometry.transform;
+    auto frame_info_view =
+        pass.GetTransientsBuffer().EmplaceUniform(frame_info);
+
+    Command cmd;
+    DEBUG_COMMAND_INFO(cmd, "Solid Fill (Count Front)");
+    cmd.stencil_reference = 0;
+    options.stencil_operation = is_even_odd ? StencilOperation::kInvert
+                                            : StencilOperation::kIncrementWrap;
+    cmd.pipeline = renderer.GetClipPipeline(options);
+    cmd.BindVertices(geometry.front_vertex_buffer);
+    VS::BindFrameInfo(cmd, frame_info_view);
+    if (!pass.AddCommand(Command(cmd))) {
+      return false;
+    }
+
+    DEBUG_COMMAND_INFO(cmd, "Solid Fill (Count Back)");
+    options.stencil_operation = is_even_odd ? StencilOperation::kInvert
+                                            : StencilOperation::kDecrementWrap;
+    cmd.pipeline = renderer.GetClipPipeline(options);
+    cmd.BindVertices(geometry.back_vertex_buffer);
+    if (!pass.AddCommand(std::move(cmd))) {
+      return false;
+    }
+  }
+
+  using VS = SolidFillPipeline::VertexShader;
+
+  // Covering the pixels with a non-zero count also resets the count, so the
+  // stencil buffer is left as it was found.
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid Fill (Cover)");
+  cmd.stencil_reference = 0;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.stencil_compare = CompareFunction::kNotEqual;
+  options.stencil_operation = StencilOperation::kZero;
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  cmd.pipeline = renderer.GetSolidFillPipeline(options);
+
+  auto points = coverage->GetPoints();
+  cmd.BindVertices(
+      VertexBufferBuilder<VS::PerVertexData>{}
+          .AddVertices({{points[0]}, {points[1]}, {points[2]}, {points[3]}})
+          .CreateVertexBuffer(pass.GetTransientsBuffer()));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  frame_info.color = GetColor().Premultiply();
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
                                                              Color color) {
   auto contents = std::make_unique<SolidColorContents>();
@@ -37,6 +37,9 @@ class SolidColorContents final : public ColorSourceContents {
   // |ColorSourceContents|
   bool IsSolidColor() const override;
 
+  // |Contents|
+  const SolidColorContents* AsSolidColor() const override;
+
   // |Contents|
   bool IsOpaque() const override;
 
@@ -58,6 +61,13 @@ class SolidColorContents final : public ColorSourceContents {
  private:
   Color color_;
 
+  /// Counts the winding numbers of the geometry in the stencil buffer and
+  /// then fills the pixels that are inside the geometry.
+  bool RenderStencilCover(const ContentContext& renderer,
+                          const Entity& entity,
+                          RenderPass& pass,
+                          const StencilCoverGeometryResult& geometry) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(SolidColorContents);
 };
 
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+SolidRectBatchContents::SolidRectBatchContents() = default;
+
+SolidRectBatchContents::~SolidRectBatchContents() = default;
+
+bool SolidRectBatchContents::CanBatch(const Entity& entity) {
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      entity.GetTransformation().HasPerspective()) {
+    return false;
+  }
+  auto contents = entity.GetContents().get();
+  if (contents == nullptr) {
+    return false;
+  }
+  auto solid_color = contents->AsSolidColor();
+  return solid_color != nullptr && solid_color->GetGeometry() != nullptr &&
+         solid_color->GetGeometry()->AsRect().has_value();
+}
+
+bool SolidRectBatchContents::CanAppend(const Entity& entity) const {
+  if (entities_.empty()) {
+    return true;
+  }
+  return entity.GetBlendMode() == entities_.front().GetBlendMode() &&
+         entity.GetStencilDepth() == entities_.front().GetStencilDepth();
+}
+
+void SolidRectBatchContents::Append(const Entity& entity) {
+  FML_DCHECK(CanBatch(entity) && CanAppend(entity));
+  auto solid_color = entity.GetContents()->AsSolidColor();
+  auto rect = solid_color->GetGeometry()->AsRect().value();
+
+  entities_.push_back(entity);
+  rects_.push_back(SolidRect{
+      .points = rect.GetTransformedPoints(entity.GetTransformation()),
+      .color = solid_color->GetColor().Premultiply(),
+  });
+
+  auto coverage = entity.GetCoverage();
+  if (coverage.has_value()) {
+    coverage_ = coverage_.has_value() ? coverage_->Union(coverage.value())
+                                      : coverage.value();
+  }
+}
+
+size_t SolidRectBatchContents::GetCount() const {
+  return entities_.size();
+}
+
+const std::vector<Entity>& SolidRectBatchContents::GetEntities() const {
+  return entities_;
+}
+
+std::optional<Rect> SolidRectBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    return std::nullopt;
+  }
+  return coverage_->TransformBounds(entity.GetTransformation());
+}
+
+bool SolidRectBatchContents::Render(const ContentContext& renderer,
+                                    const Entity& entity,
+                                    RenderPass& pass) const {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  if (rects_.empty()) {
+    return true;
+  }
+
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(rects_.size() * 6);
+  for (const auto& rect : rects_) {
+    for (size_t index : indices) {
+      vertex_builder.AppendVertex(VS::PerVertexData{
+          .position = rect.points[index],
+          .color = rect.color,
+      });
+    }
+  }
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid Rect Batch");
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+
+  cmd.pipeline =
+      renderer.GetGeometryColorPipeline(OptionsFromPassAndEntity(pass, entity));
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Draws the solid color rectangles of several entities with a
+///             single command, so that runs of rectangle fills that share a
+///             pipeline don't each bind it and upload their own uniforms.
+///
+///             The rectangles are transformed on the CPU and drawn in the
+///             order they were appended, with one vertex color per rectangle.
+///             The batch is drawn with the untransformed entity it is given,
+///             which must have the blend mode and stencil depth of the batched
+///             entities.
+///
+class SolidRectBatchContents final : public Contents {
+ public:
+  SolidRectBatchContents();
+
+  // |Contents|
+  ~SolidRectBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the entity fills a single rectangle with a solid
+  ///             color through a pipeline blend, and can be batched.
+  ///
+  static bool CanBatch(const Entity& entity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the entity can be drawn by the same command as the
+  ///             entities appended so far.
+  ///
+  bool CanAppend(const Entity& entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the rectangle of an entity for which `CanBatch` is true.
+  ///
+  void Append(const Entity& entity);
+
+  size_t GetCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The entities appended so far, in the order they are drawn.
+  ///
+  const std::vector<Entity>& GetEntities() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  struct SolidRect {
+    std::array<Point, 4> points;
+    Color color;
+  };
+
+  std::vector<Entity> entities_;
+  std::vector<SolidRect> rects_;
+  std::optional<Rect> coverage_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SolidRectBatchContents);
+};
+
+}  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include <type_traits>
@@ -12,6 +13,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/glyph_instance_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
@@ -67,10 +69,43 @@ std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
 void TextContents::PopulateGlyphAtlas(
     const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
     Scalar scale) {
-  lazy_glyph_atlas->AddTextFrame(*frame_, scale);
-  scale_ = scale;
+  scale_ = lazy_glyph_atlas->ResolveScale(scale);
+  lazy_glyph_atlas->AddTextFrame(*frame_, scale_);
 }
 
+namespace {
+
+template <class VS>
+typename VS::FrameInfo MakeFrameInfo(const RenderPass& pass,
+                                     const Entity& entity,
+                                     const GlyphAtlas& atlas,
+                                     Vector2 offset,
+                                     Color color) {
+  typename VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  frame_info.atlas_size =
+      Vector2{static_cast<Scalar>(atlas.GetTexture()->GetSize().width),
+              static_cast<Scalar>(atlas.GetTexture()->GetSize().height)};
+  frame_info.offset = offset;
+  frame_info.is_translation_scale =
+      entity.GetTransformation().IsTranslationScaleOnly();
+  frame_info.entity_transform = entity.GetTransformation();
+  frame_info.text_color = ToVector(color.Premultiply());
+  return frame_info;
+}
+
+// Common vertex information for all glyphs.
+// All glyphs are given the same vertex information in the form of a
+// unit-sized quad. The size of the glyph is specified in per instance data
+// and the vertex shader uses this to size the glyph correctly. The
+// interpolated vertex information is also used in the fragment shader to
+// sample from the glyph atlas.
+constexpr std::array<Point, 6> kUnitPoints = {Point{0, 0}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 1}};
+
+}  // namespace
+
 bool TextContents::Render(const ContentContext& renderer,
                           const Entity& entity,
                           RenderPass& pass) const {
@@ -91,34 +126,16 @@ bool TextContents::Render(const ContentContext& renderer,
   // Information shared by all glyph draw calls.
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "TextFrame");
-  auto opts = OptionsFromPassAndEntity(pass, entity);
-  opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
-  }
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  using VS = GlyphAtlasPipeline::VertexShader;
-  using FS = GlyphAtlasPipeline::FragmentShader;
-
-  // Common vertex uniforms for all glyphs.
-  VS::FrameInfo frame_info;
-  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
-  frame_info.atlas_size =
-      Vector2{static_cast<Scalar>(atlas->GetTexture()->GetSize().width),
-              static_cast<Scalar>(atlas->GetTexture()->GetSize().height)};
-  frame_info.offset = offset_;
-  frame_info.is_translation_scale =
-      entity.GetTransformation().IsTranslationScaleOnly();
-  frame_info.entity_transform = entity.GetTransformation();
-  frame_info.text_color = ToVector(color.Premultiply());
-
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  // The atlas may hold the glyphs at a larger scale than the text is drawn
+  // at while it animates, see |LazyGlyphAtlas::ResolveScale|.
+  bool glyphs_match_scale =
+      TextFrame::RoundScaledFontSize(entity.DeriveTextScale(), 0) == scale_;
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (entity.GetTransformation().IsTranslationScaleOnly() &&
+      glyphs_match_scale) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -127,11 +144,13 @@ bool TextContents::Render(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Glyphs rendered at a larger scale are sampled down the same way.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNearest;
 
+  using FS = GlyphAtlasPipeline::FragmentShader;
   FS::BindGlyphAtlasSampler(
       cmd,                  // command
       atlas->GetTexture(),  // texture
@@ -139,16 +158,25 @@ bool TextContents::Render(const ContentContext& renderer,
           sampler_desc)  // sampler
   );
 
-  // Common vertex information for all glyphs.
-  // All glyphs are given the same vertex information in the form of a
-  // unit-sized quad. The size of the glyph is specified in per instance data
-  // and the vertex shader uses this to size the glyph correctly. The
-  // interpolated vertex information is also used in the fragment shader to
-  // sample from the glyph atlas.
+  if (renderer.GetDeviceCapabilities().SupportsSSBO()) {
+    return RenderInstanced(renderer, entity, pass, std::move(cmd), atlas,
+                           color);
+  }
 
-  constexpr std::array<Point, 6> unit_points = {Point{0, 0}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 1}};
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  if (type == GlyphAtlas::Type::kAlphaBitmap) {
+    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+  } else {
+    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  }
+
+  using VS = GlyphAtlasPipeline::VertexShader;
+
+  // Common vertex uniforms for all glyphs.
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(
+                             MakeFrameInfo<VS>(pass, entity, *atlas, offset_,
+                                               color)));
 
   auto& host_buffer = pass.GetTransientsBuffer();
   size_t vertex_count = 0;
@@ -192,7 +220,7 @@ bool TextContents::Render(const ContentContext& renderer,
                                        glyph_position.glyph.bounds.size.height);
             vtx.glyph_position = glyph_position.position;
 
-            for (const Point& point : unit_points) {
+            for (const Point& point : kUnitPoints) {
               vtx.unit_position = point;
               std::memcpy(vtx_contents++, &vtx, sizeof(VS::PerVertexData));
             }
@@ -210,4 +238,52 @@ bool TextContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool TextContents::RenderInstanced(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass,
+                                   Command cmd,
+                                   const std::shared_ptr<GlyphAtlas>& atlas,
+                                   Color color) const {
+  using VS = GlyphAtlasInstancedPipeline::VertexShader;
+
+  const auto& instances =
+      renderer.GetGlyphInstanceCache()->GetInstances(frame_, atlas, scale_);
+  if (instances.empty()) {
+    return true;
+  }
+
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  if (atlas->GetType() == GlyphAtlas::Type::kAlphaBitmap) {
+    cmd.pipeline = renderer.GetGlyphAtlasInstancedPipeline(opts);
+  } else {
+    cmd.pipeline = renderer.GetGlyphAtlasColorInstancedPipeline(opts);
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(MakeFrameInfo<VS>(
+                             pass, entity, *atlas, offset_, color)));
+  VS::BindGlyphInfo(
+      cmd, host_buffer.Emplace(instances.data(),
+                               instances.size() * sizeof(GlyphInstanceData),
+                               DefaultUniformAlignment()));
+
+  // Every glyph is an instance of the same unit quad, so the per vertex data
+  // doesn't grow with the number of glyphs.
+  std::array<VS::PerVertexData, kUnitPoints.size()> vertices;
+  for (size_t i = 0; i < kUnitPoints.size(); i++) {
+    vertices[i].unit_position = kUnitPoints[i];
+  }
+  cmd.BindVertices({
+      .vertex_buffer = host_buffer.Emplace(
+          vertices.data(), sizeof(vertices), alignof(VS::PerVertexData)),
+      .index_buffer = {},
+      .vertex_count = vertices.size(),
+      .index_type = IndexType::kNone,
+  });
+  cmd.instance_count = instances.size();
+
+  return pass.AddCommand(std::move(cmd));
+}
+
 }  // namespace impeller
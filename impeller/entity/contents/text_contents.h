@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/geometry/color.h"
+#include "impeller/renderer/command.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_frame.h"
 
@@ -67,6 +68,18 @@ class TextContents final : public Contents {
       GlyphAtlas::Type type,
       const std::shared_ptr<LazyGlyphAtlas>& lazy_atlas) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draws every glyph as an instance of one unit quad, with the
+  ///             per glyph data read from a storage buffer that is cached
+  ///             across frames for text frames that don't change.
+  ///
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       Command cmd,
+                       const std::shared_ptr<GlyphAtlas>& atlas,
+                       Color color) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextContents);
 };
 
@@ -6,6 +6,7 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <variant>
@@ -24,6 +25,7 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
@@ -57,8 +59,16 @@ const std::string EntityPass::kCaptureDocumentName = "EntityPass";
 
 EntityPass::EntityPass() = default;
 
+EntityPass::EntityPass(std::shared_ptr<fml::Arena> arena)
+    : arena_(std::move(arena)),
+      elements_(fml::ArenaAllocator<Element>(arena_.get())) {}
+
 EntityPass::~EntityPass() = default;
 
+const std::shared_ptr<fml::Arena>& EntityPass::GetArena() const {
+  return arena_;
+}
+
 void EntityPass::SetDelegate(std::shared_ptr<EntityPassDelegate> delegate) {
   if (!delegate) {
     return;
@@ -87,7 +97,8 @@ void EntityPass::AddEntity(Entity entity) {
 }
 
 void EntityPass::SetElements(std::vector<Element> elements) {
-  elements_ = std::move(elements);
+  elements_.assign(std::make_move_iterator(elements.begin()),
+                   std::make_move_iterator(elements.end()));
 }
 
 size_t EntityPass::GetSubpassesDepth() const {
@@ -258,6 +269,37 @@ void EntityPass::AddSubpassInline(std::unique_ptr<EntityPass> pass) {
       pass->advanced_blend_reads_from_pass_texture_;
 }
 
+void EntityPass::ReplaceSubpassInline(EntityPass* placeholder,
+                                      std::unique_ptr<EntityPass> pass) {
+  auto found = std::find_if(
+      elements_.begin(), elements_.end(), [placeholder](const auto& element) {
+        auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element);
+        return subpass && subpass->get() == placeholder;
+      });
+  FML_DCHECK(found != elements_.end());
+  if (found == elements_.end()) {
+    return;
+  }
+  auto position = elements_.erase(found);
+  if (!pass) {
+    return;
+  }
+  FML_DCHECK(pass->superpass_ == nullptr);
+
+  for (auto& element : pass->elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = this;
+    }
+  }
+  elements_.insert(position, std::make_move_iterator(pass->elements_.begin()),
+                   std::make_move_iterator(pass->elements_.end()));
+
+  backdrop_filter_reads_from_pass_texture_ +=
+      pass->backdrop_filter_reads_from_pass_texture_;
+  advanced_blend_reads_from_pass_texture_ +=
+      pass->advanced_blend_reads_from_pass_texture_;
+}
+
 static RenderTarget::AttachmentConfig GetDefaultStencilConfig(bool readable) {
   return RenderTarget::AttachmentConfig{
       .storage_mode = readable ? StorageMode::kDevicePrivate
@@ -309,10 +351,62 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
     );
   }
 
+  if (renderer.UsesDepthClips()) {
+    target.SetupDepthStencilAttachments(
+        *context, *renderer.GetRenderTargetCache(), size,
+        context->GetCapabilities()->SupportsOffscreenMSAA(), "EntityPass",
+        GetDefaultStencilConfig(readable));
+  }
+
   return EntityPassTarget(
       target, renderer.GetDeviceCapabilities().SupportsReadFromResolve());
 }
 
+/// The depth at `index` of `element_count + 2` evenly spaced depths that
+/// start at `depth_range.z_near` and end before `depth_range.z_far`. The
+/// element at index `i` is drawn at the depth at `i + 1`, which leaves room
+/// before the first element and after the last one.
+static Scalar GetElementDepth(DepthRange depth_range,
+                              size_t element_count,
+                              size_t index) {
+  return depth_range.z_near + (depth_range.z_far - depth_range.z_near) *
+                                  static_cast<Scalar>(index) /
+                                  static_cast<Scalar>(element_count + 2);
+}
+
+std::vector<Scalar> EntityPass::GetElementDepths(
+    DepthRange depth_range) const {
+  std::vector<Scalar> depths(elements_.size());
+  // The indices and stencil depths of the clips that haven't been restored.
+  std::vector<std::pair<size_t, size_t>> pending_clips;
+  for (size_t i = 0; i < elements_.size(); i++) {
+    depths[i] = GetElementDepth(depth_range, elements_.size(), i + 1);
+    const auto* entity = std::get_if<Entity>(&elements_[i]);
+    if (!entity) {
+      continue;
+    }
+    switch (entity->GetStencilCoverage(std::nullopt).type) {
+      case Contents::StencilCoverage::Type::kNoChange:
+        break;
+      case Contents::StencilCoverage::Type::kAppend:
+        pending_clips.emplace_back(i, entity->GetStencilDepth());
+        break;
+      case Contents::StencilCoverage::Type::kRestore:
+        while (!pending_clips.empty() &&
+               pending_clips.back().second >= entity->GetStencilDepth()) {
+          depths[pending_clips.back().first] = depths[i];
+          pending_clips.pop_back();
+        }
+        break;
+    }
+  }
+  for (const auto& [index, _] : pending_clips) {
+    depths[index] =
+        GetElementDepth(depth_range, elements_.size(), elements_.size() + 1);
+  }
+  return depths;
+}
+
 uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
   return renderer.GetDeviceCapabilities().SupportsFramebufferFetch()
              ? backdrop_filter_reads_from_pass_texture_
@@ -340,6 +434,8 @@ bool EntityPass::Render(ContentContext& renderer,
                   {.readonly = true});
 
   fml::ScopedCleanupClosure reset_state([&renderer]() {
+    // Submit the passes queued by a render that failed part way through.
+    renderer.FlushRenderPasses();
     renderer.GetLazyGlyphAtlas()->ResetTextFrames();
     renderer.GetRenderTargetCache()->End();
   });
@@ -385,6 +481,11 @@ bool EntityPass::Render(ContentContext& renderer,
       return false;
     }
 
+    if (!renderer.FlushRenderPasses()) {
+      VALIDATION_LOG << "Failed to submit the offscreen root pass.";
+      return false;
+    }
+
     auto command_buffer = renderer.GetContext()->CreateCommandBuffer();
     command_buffer->SetLabel("EntityPass Root Command Buffer");
 
@@ -465,7 +566,14 @@ bool EntityPass::Render(ContentContext& renderer,
   }
   // Setup a new root stencil with an optimal configuration if one wasn't
   // provided by the caller.
-  else {
+  else if (renderer.UsesDepthClips()) {
+    root_render_target.SetupDepthStencilAttachments(
+        *renderer.GetContext(), *renderer.GetRenderTargetCache(),
+        color0.texture->GetSize(),
+        renderer.GetContext()->GetCapabilities()->SupportsOffscreenMSAA(),
+        "ImpellerOnscreen",
+        GetDefaultStencilConfig(reads_from_onscreen_backdrop));
+  } else {
     root_render_target.SetupStencilAttachment(
         *renderer.GetContext(), *renderer.GetRenderTargetCache(),
         color0.texture->GetSize(),
@@ -482,15 +590,19 @@ bool EntityPass::Render(ContentContext& renderer,
       root_render_target,
       renderer.GetDeviceCapabilities().SupportsReadFromResolve());
 
-  return OnRender(                               //
-      renderer,                                  // renderer
-      capture,                                   // capture
-      root_render_target.GetRenderTargetSize(),  // root_pass_size
-      pass_target,                               // pass_target
-      Point(),                                   // global_pass_position
-      Point(),                                   // local_pass_position
-      0,                                         // pass_depth
-      stencil_coverage_stack);                   // stencil_coverage_stack
+  if (!OnRender(                                 //
+          renderer,                                  // renderer
+          capture,                                   // capture
+          root_render_target.GetRenderTargetSize(),  // root_pass_size
+          pass_target,                               // pass_target
+          Point(),                                   // global_pass_position
+          Point(),                                   // local_pass_position
+          0,                                         // pass_depth
+          stencil_coverage_stack)) {                 // stencil_coverage_stack
+    return false;
+  }
+
+  return renderer.FlushRenderPasses();
 }
 
 EntityPass::EntityResult EntityPass::GetEntityForElement(
@@ -502,7 +614,8 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     Point global_pass_position,
     uint32_t pass_depth,
     StencilCoverageStack& stencil_coverage_stack,
-    size_t stencil_depth_floor) const {
+    size_t stencil_depth_floor,
+    DepthRange element_depth_range) const {
   Entity element_entity;
 
   //--------------------------------------------------------------------------
@@ -549,12 +662,15 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
               stencil_coverage_stack,        // stencil_coverage_stack
               stencil_depth_,                // stencil_depth_floor
               nullptr,                       // backdrop_filter_contents
-              pass_context.GetRenderPass(pass_depth)  // collapsed_parent_pass
+              pass_context.GetRenderPass(pass_depth),  // collapsed_parent_pass
+              element_depth_range                      // depth_range
               )) {
         // Validation error messages are triggered for all `OnRender()` failure
         // cases.
         return EntityPass::EntityResult::Failure();
       }
+      // The collapsed pass drew straight into the active pass.
+      pass_context.RecordDrawCoverage(std::nullopt);
       return EntityPass::EntityResult::Skip();
     }
 
@@ -710,12 +826,13 @@ bool EntityPass::OnRender(
     size_t stencil_depth_floor,
     std::shared_ptr<Contents> backdrop_filter_contents,
     const std::optional<InlinePassContext::RenderPassResult>&
-        collapsed_parent_pass) const {
+        collapsed_parent_pass,
+    DepthRange depth_range) const {
   TRACE_EVENT0("impeller", "EntityPass::OnRender");
 
-  auto context = renderer.GetContext();
-  InlinePassContext pass_context(
-      context, pass_target, GetTotalPassReads(renderer), collapsed_parent_pass);
+  InlinePassContext pass_context(renderer, pass_target,
+                                 GetTotalPassReads(renderer),
+                                 collapsed_parent_pass);
   if (!pass_context.IsValid()) {
     VALIDATION_LOG << SPrintF("Pass context invalid (Depth=%d)", pass_depth);
     return false;
@@ -728,9 +845,22 @@ bool EntityPass::OnRender(
     pass_context.GetRenderPass(pass_depth);
   }
 
+  // When the pass texture has a depth attachment, rectangle clips are written
+  // to it instead of the stencil. Elements are drawn at increasing depths and
+  // pass the depth test where they are deeper than the depth clips written so
+  // far, which are drawn at the depth of the restore that ends them.
+  bool has_depth_clips =
+      pass_target.GetRenderTarget().GetDepthAttachment().has_value();
+  std::vector<Scalar> element_depths;
+  if (has_depth_clips) {
+    element_depths = GetElementDepths(depth_range);
+  }
+
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
                          &renderer, &stencil_coverage_stack,
-                         &global_pass_position](Entity& element_entity) {
+                         &global_pass_position,
+                         has_depth_clips](Entity& element_entity,
+                                          Scalar element_depth) {
     auto result = pass_context.GetRenderPass(pass_depth);
 
     if (!result.pass) {
@@ -756,6 +886,11 @@ bool EntityPass::OnRender(
       Entity msaa_backdrop_entity;
       msaa_backdrop_entity.SetContents(std::move(msaa_backdrop_contents));
       msaa_backdrop_entity.SetBlendMode(BlendMode::kSource);
+      // Every element depth is smaller than 1, so the backdrop is drawn
+      // through all of the depth clips.
+      if (has_depth_clips) {
+        result.pass->SetCommandDepth(1.0f);
+      }
       if (!msaa_backdrop_entity.Render(renderer, *result.pass)) {
         VALIDATION_LOG << "Failed to render MSAA backdrop filter entity.";
         return false;
@@ -799,9 +934,15 @@ bool EntityPass::OnRender(
         break;
       case Contents::StencilCoverage::Type::kAppend: {
         auto op = stencil_coverage_stack.back().coverage;
+        bool is_depth_clip =
+            has_depth_clips &&
+            static_cast<ClipContents*>(element_entity.GetContents().get())
+                ->IsDepthClip(element_entity,
+                              result.pass->GetRenderTarget());
         stencil_coverage_stack.push_back(StencilCoverageLayer{
             .coverage = stencil_coverage.coverage,
-            .stencil_depth = element_entity.GetStencilDepth() + 1});
+            .stencil_depth = element_entity.GetStencilDepth() + 1,
+            .is_depth_clip = is_depth_clip});
         FML_DCHECK(stencil_coverage_stack.back().stencil_depth ==
                    stencil_coverage_stack.size() - 1);
 
@@ -831,9 +972,18 @@ bool EntityPass::OnRender(
           // Make the coverage rectangle relative to the current pass.
           restore_coverage->origin -= global_pass_position;
         }
+        // Depth clips end by themselves once something deeper than them is
+        // drawn, so only the clips that changed the stencil need restoring.
+        bool restores_stencil = std::any_of(
+            stencil_coverage_stack.begin() + restoration_depth + 1,
+            stencil_coverage_stack.end(),
+            [](const StencilCoverageLayer& layer) {
+              return !layer.is_depth_clip;
+            });
         stencil_coverage_stack.resize(restoration_depth + 1);
 
-        if (!stencil_coverage_stack.back().coverage.has_value()) {
+        if (!stencil_coverage_stack.back().coverage.has_value() ||
+            !restores_stencil) {
           // Running this restore op won't make anything renderable, so skip it.
           return true;
         }
@@ -856,8 +1006,19 @@ bool EntityPass::OnRender(
     }
 #endif
 
+    // Depth clips don't change the stencil, so the entities they enclose are
+    // drawn at the stencil depth of the enclosing stencil clips.
+    size_t depth_clip_count = 0;
+    for (size_t i = stencil_depth_floor + 1;
+         i <= element_entity.GetStencilDepth() &&
+         i < stencil_coverage_stack.size();
+         i++) {
+      depth_clip_count += stencil_coverage_stack[i].is_depth_clip ? 1 : 0;
+    }
     element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
-                                   stencil_depth_floor);
+                                   stencil_depth_floor - depth_clip_count);
+    result.pass->SetCommandDepth(
+        has_depth_clips ? std::optional<Scalar>(element_depth) : std::nullopt);
     if (!element_entity.Render(renderer, *result.pass)) {
       VALIDATION_LOG << "Failed to render entity.";
       return false;
@@ -881,14 +1042,61 @@ bool EntityPass::OnRender(
         Matrix::MakeTranslation(Vector3(-local_pass_position)));
     backdrop_entity.SetStencilDepth(stencil_depth_floor);
 
-    render_element(backdrop_entity);
+    // Nothing has been clipped yet, so any depth will do.
+    render_element(backdrop_entity, depth_range.z_far);
   }
 
+  // Consecutive solid color rectangles that share a pipeline are drawn by a
+  // single command. Draws that don't overlap the batch may be drawn ahead of
+  // it while it is open, as long as nothing added to the batch afterwards
+  // overlaps them either.
+  std::shared_ptr<SolidRectBatchContents> batch;
+  Scalar batch_depth = 0;
+  std::optional<Rect> drawn_ahead_coverage;
+  auto flush_batch = [&]() {
+    if (!batch) {
+      return true;
+    }
+    auto batch_contents = std::move(batch);
+    batch = nullptr;
+    drawn_ahead_coverage = std::nullopt;
+
+    const auto& first_entity = batch_contents->GetEntities().front();
+    Entity batch_entity;
+    if (batch_contents->GetCount() == 1) {
+      batch_entity = first_entity;
+    } else {
+      batch_entity.SetBlendMode(first_entity.GetBlendMode());
+      batch_entity.SetStencilDepth(first_entity.GetStencilDepth());
+      batch_entity.SetContents(std::move(batch_contents));
+    }
+    auto batch_coverage = batch_entity.GetCoverage();
+    if (!render_element(batch_entity, batch_depth)) {
+      return false;
+    }
+    pass_context.RecordDrawCoverage(batch_coverage);
+    return true;
+  };
+
   bool is_collapsing_clear_colors = !collapsed_parent_pass &&
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
-  for (const auto& element : elements_) {
+  for (size_t element_index = 0; element_index < elements_.size();
+       element_index++) {
+    const auto& element = elements_[element_index];
+    Scalar element_depth = 0;
+    DepthRange element_depth_range;
+    if (has_depth_clips) {
+      element_depth = element_depths[element_index];
+      element_depth_range = DepthRange{
+          .z_near = GetElementDepth(depth_range, elements_.size(),
+                                    element_index),
+          .z_far = GetElementDepth(depth_range, elements_.size(),
+                                   element_index + 1),
+      };
+    }
+
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
@@ -899,6 +1107,13 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Collapsed subpasses render straight into this pass, and subpasses with
+    // backdrop filters end it, so the batch has to be drawn before them.
+    if (std::holds_alternative<std::unique_ptr<EntityPass>>(element) &&
+        !flush_batch()) {
+      return false;
+    }
+
     EntityResult result =
         GetEntityForElement(element,                 // element
                             renderer,                // renderer
@@ -908,7 +1123,8 @@ bool EntityPass::OnRender(
                             global_pass_position,    // global_pass_position
                             pass_depth,              // pass_depth
                             stencil_coverage_stack,  // stencil_coverage_stack
-                            stencil_depth_floor);    // stencil_depth_floor
+                            stencil_depth_floor,     // stencil_depth_floor
+                            element_depth_range);    // element_depth_range
 
     switch (result.status) {
       case EntityResult::kSuccess:
@@ -921,6 +1137,50 @@ bool EntityPass::OnRender(
         continue;
     };
 
+    // Clips only write to the stencil attachment, so they don't change what
+    // the pass texture holds.
+    bool draws_color = result.entity.GetStencilCoverage(std::nullopt).type ==
+                       Contents::StencilCoverage::Type::kNoChange;
+    auto draw_coverage = result.entity.GetCoverage();
+
+    //--------------------------------------------------------------------------
+    /// Batch solid color rectangles.
+    ///
+
+    if (draws_color && draw_coverage.has_value() &&
+        SolidRectBatchContents::CanBatch(result.entity)) {
+      if (batch && batch->CanAppend(result.entity) &&
+          !(drawn_ahead_coverage.has_value() &&
+            drawn_ahead_coverage->IntersectsWithRect(draw_coverage.value()))) {
+        batch->Append(result.entity);
+        continue;
+      }
+      if (!flush_batch()) {
+        return false;
+      }
+      batch = std::make_shared<SolidRectBatchContents>();
+      batch->Append(result.entity);
+      batch_depth = element_depth;
+      continue;
+    }
+
+    if (batch) {
+      auto batch_coverage = batch->GetCoverage(Entity());
+      bool can_draw_ahead =
+          draws_color &&
+          result.entity.GetBlendMode() <= Entity::kLastPipelineBlendMode &&
+          draw_coverage.has_value() && batch_coverage.has_value() &&
+          !draw_coverage->IntersectsWithRect(batch_coverage.value());
+      if (can_draw_ahead) {
+        drawn_ahead_coverage =
+            drawn_ahead_coverage.has_value()
+                ? drawn_ahead_coverage->Union(draw_coverage.value())
+                : draw_coverage.value();
+      } else if (!flush_batch()) {
+        return false;
+      }
+    }
+
     //--------------------------------------------------------------------------
     /// Setup advanced blends.
     ///
@@ -943,17 +1203,28 @@ bool EntityPass::OnRender(
         // to the render target texture so far need to execute before it's bound
         // for blending (otherwise the blend pass will end up executing before
         // all the previous commands in the active pass).
-
-        if (!pass_context.EndPass()) {
-          VALIDATION_LOG
-              << "Failed to end the current render pass in order to read from "
-                 "the backdrop texture and apply an advanced blend.";
-          return false;
+        //
+        // If nothing drawn since the active pass began overlaps the blend
+        // though, the texture the pass began from already holds the right
+        // destination. This batches runs of non-overlapping advanced blends
+        // into a single pass.
+
+        std::shared_ptr<Texture> texture;
+        if (draw_coverage.has_value()) {
+          texture =
+              pass_context.GetUnmodifiedBackdropTexture(draw_coverage.value());
+        }
+        if (!texture) {
+          if (!pass_context.EndPass()) {
+            VALIDATION_LOG << "Failed to end the current render pass in order "
+                              "to read from the backdrop texture and apply an "
+                              "advanced blend.";
+            return false;
+          }
+          // Amend an advanced blend filter to the contents, attaching the pass
+          // texture.
+          texture = pass_context.GetTexture();
         }
-
-        // Amend an advanced blend filter to the contents, attaching the pass
-        // texture.
-        auto texture = pass_context.GetTexture();
         if (!texture) {
           VALIDATION_LOG << "Failed to fetch the color texture in order to "
                             "apply an advanced blend.";
@@ -976,10 +1247,17 @@ bool EntityPass::OnRender(
     /// Render the Element.
     ///
 
-    if (!render_element(result.entity)) {
+    if (!render_element(result.entity, element_depth)) {
       // Specific validation logs are handled in `render_element()`.
       return false;
     }
+    if (draws_color) {
+      pass_context.RecordDrawCoverage(draw_coverage);
+    }
+  }
+
+  if (!flush_batch()) {
+    return false;
   }
 
 #ifdef IMPELLER_DEBUG
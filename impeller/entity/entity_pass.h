@@ -9,6 +9,7 @@
 #include <optional>
 #include <vector>
 
+#include "flutter/fml/arena.h"
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
 #include "impeller/entity/contents/contents.h"
@@ -46,14 +47,27 @@ class EntityPass {
   struct StencilCoverageLayer {
     std::optional<Rect> coverage;
     size_t stencil_depth;
+    /// Whether the clip of this layer was written to the depth attachment
+    /// instead of the stencil, in which case it doesn't change the stencil
+    /// depth of the entities it clips.
+    bool is_depth_clip = false;
   };
 
   using StencilCoverageStack = std::vector<StencilCoverageLayer>;
 
   EntityPass();
 
+  /// @brief  Creates a pass whose element storage is allocated from |arena|.
+  ///         Every pass sharing the arena keeps it alive, so the storage of
+  ///         a whole pass tree is released at once when the last of them is
+  ///         destroyed.
+  explicit EntityPass(std::shared_ptr<fml::Arena> arena);
+
   ~EntityPass();
 
+  /// @brief  The arena backing the element storage of this pass, if any.
+  const std::shared_ptr<fml::Arena>& GetArena() const;
+
   void SetDelegate(std::shared_ptr<EntityPassDelegate> delgate);
 
   /// @brief  Set the bounds limit, which is provided by the user when creating
@@ -89,6 +103,15 @@ class EntityPass {
   ///
   void AddSubpassInline(std::unique_ptr<EntityPass> pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief  Replaces |placeholder|, a subpass previously appended with
+  ///         `AddSubpass()`, with the elements of a given pass. This lets
+  ///         content be recorded separately, for example on another thread,
+  ///         while keeping its place among the elements of this pass.
+  ///
+  void ReplaceSubpassInline(EntityPass* placeholder,
+                            std::unique_ptr<EntityPass> pass);
+
   EntityPass* GetSuperpass() const;
 
   bool Render(ContentContext& renderer,
@@ -183,7 +206,20 @@ class EntityPass {
                                    Point global_pass_position,
                                    uint32_t pass_depth,
                                    StencilCoverageStack& stencil_coverage_stack,
-                                   size_t stencil_depth_floor) const;
+                                   size_t stencil_depth_floor,
+                                   DepthRange element_depth_range) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The depth each element is drawn at when the pass texture has
+  ///             a depth attachment, spread over `depth_range`.
+  ///
+  ///             Elements are given increasing depths in the order they are
+  ///             drawn in, except for clips, which are given the depth of the
+  ///             restore that ends them. Clips that are never restored are
+  ///             given a depth that is larger than that of every element but
+  ///             still smaller than `depth_range.z_far`.
+  ///
+  std::vector<Scalar> GetElementDepths(DepthRange depth_range) const;
 
   //----------------------------------------------------------------------------
   /// @brief     OnRender is the internal command recording routine for
@@ -241,6 +277,12 @@ class EntityPass {
   ///                                      creating a new `RenderPass`. This
   ///                                      "collapses" the Elements into the
   ///                                      parent pass.
+  /// @param[in]  depth_range              The range of depths the elements are
+  ///                                      drawn at when the `pass_target` has
+  ///                                      a depth attachment. Collapsed passes
+  ///                                      are drawn within the range of the
+  ///                                      element they replace in the parent
+  ///                                      pass.
   ///
   bool OnRender(ContentContext& renderer,
                 Capture& capture,
@@ -253,11 +295,13 @@ class EntityPass {
                 size_t stencil_depth_floor = 0,
                 std::shared_ptr<Contents> backdrop_filter_contents = nullptr,
                 const std::optional<InlinePassContext::RenderPassResult>&
-                    collapsed_parent_pass = std::nullopt) const;
+                    collapsed_parent_pass = std::nullopt,
+                DepthRange depth_range = {}) const;
 
   /// The list of renderable items in the scene. Each of these items is
   /// evaluated and recorded to an `EntityPassTarget` by the `OnRender` method.
-  std::vector<Element> elements_;
+  std::shared_ptr<fml::Arena> arena_;
+  fml::ArenaVector<Element> elements_;
 
   EntityPass* superpass_ = nullptr;
   Matrix xformation_;
@@ -21,12 +21,18 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/filters/yuv_to_rgb_filter_contents.h"
+#include "impeller/entity/contents/glyph_instance_cache.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
+#include "impeller/entity/contents/runtime_effect_cache.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/sweep_gradient_contents.h"
 #include "impeller/entity/contents/text_contents.h"
@@ -37,9 +43,12 @@
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_pass_delegate.h"
 #include "impeller/entity/entity_playground.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/vertices_geometry.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -999,12 +1008,17 @@ TEST_P(EntityTest, GaussianBlurFilter) {
     const char* pass_variation_names[] = {"Two pass", "Directional"};
     const char* blur_style_names[] = {"Normal", "Solid", "Outer", "Inner"};
     const char* tile_mode_names[] = {"Clamp", "Repeat", "Mirror", "Decal"};
+    const char* blur_quality_names[] = {"Full", "Balanced", "Fast"};
     const FilterContents::BlurStyle blur_styles[] = {
         FilterContents::BlurStyle::kNormal, FilterContents::BlurStyle::kSolid,
         FilterContents::BlurStyle::kOuter, FilterContents::BlurStyle::kInner};
     const Entity::TileMode tile_modes[] = {
         Entity::TileMode::kClamp, Entity::TileMode::kRepeat,
         Entity::TileMode::kMirror, Entity::TileMode::kDecal};
+    const FilterContents::BlurQuality blur_qualities[] = {
+        FilterContents::BlurQuality::kFull,
+        FilterContents::BlurQuality::kBalanced,
+        FilterContents::BlurQuality::kFast};
 
     // UI state.
     static int selected_input_type = 0;
@@ -1015,6 +1029,7 @@ TEST_P(EntityTest, GaussianBlurFilter) {
     static float blur_amount_fine[2] = {10, 10};
     static int selected_blur_style = 0;
     static int selected_tile_mode = 3;
+    static int selected_blur_quality = 1;
     static Color cover_color(1, 0, 0, 0.2);
     static Color bounds_color(0, 1, 0, 0.1);
     static float offset[2] = {500, 400};
@@ -1048,6 +1063,8 @@ TEST_P(EntityTest, GaussianBlurFilter) {
                    sizeof(blur_style_names) / sizeof(char*));
       ImGui::Combo("Tile mode", &selected_tile_mode, tile_mode_names,
                    sizeof(tile_mode_names) / sizeof(char*));
+      ImGui::Combo("Blur quality", &selected_blur_quality, blur_quality_names,
+                   sizeof(blur_quality_names) / sizeof(char*));
       ImGui::ColorEdit4("Cover color", reinterpret_cast<float*>(&cover_color));
       ImGui::ColorEdit4("Bounds color",
                         reinterpret_cast<float*>(&bounds_color));
@@ -1091,12 +1108,15 @@ TEST_P(EntityTest, GaussianBlurFilter) {
     if (selected_pass_variation == 0) {
       blur = FilterContents::MakeGaussianBlur(
           FilterInput::Make(input), blur_sigma_x, blur_sigma_y,
-          blur_styles[selected_blur_style], tile_modes[selected_tile_mode]);
+          blur_styles[selected_blur_style], tile_modes[selected_tile_mode],
+          blur_qualities[selected_blur_quality]);
     } else {
       Vector2 blur_vector(blur_sigma_x.sigma, blur_sigma_y.sigma);
       blur = FilterContents::MakeDirectionalGaussianBlur(
           FilterInput::Make(input), Sigma{blur_vector.GetLength()},
-          blur_vector.Normalize());
+          blur_vector.Normalize(), FilterContents::BlurStyle::kNormal,
+          Entity::TileMode::kDecal, false, {},
+          blur_qualities[selected_blur_quality]);
     }
 
     auto mask_blur = FilterContents::MakeBorderMaskBlur(
@@ -1691,6 +1711,39 @@ TEST_P(EntityTest, ClipContentsGetStencilCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, OnlyRectangleIntersectClipsAreDepthClips) {
+  auto context = GetContext();
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  auto stencil_target =
+      RenderTarget::CreateOffscreen(*context, allocator, {100, 100});
+  auto depth_target =
+      RenderTarget::CreateOffscreen(*context, allocator, {100, 100});
+  depth_target.SetupDepthStencilAttachments(*context, allocator, {100, 100},
+                                            false);
+  ASSERT_TRUE(depth_target.GetDepthAttachment().has_value());
+
+  ClipContents clip;
+  clip.SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(10, 10, 50, 50)));
+  clip.SetClipOperation(Entity::ClipOperation::kIntersect);
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale({2, 2, 1}));
+  EXPECT_TRUE(clip.IsDepthClip(entity, depth_target));
+  EXPECT_FALSE(clip.IsDepthClip(entity, stencil_target));
+
+  entity.SetTransformation(Matrix::MakeRotationZ(Degrees(45)));
+  EXPECT_FALSE(clip.IsDepthClip(entity, depth_target));
+  entity.SetTransformation({});
+
+  clip.SetClipOperation(Entity::ClipOperation::kDifference);
+  EXPECT_FALSE(clip.IsDepthClip(entity, depth_target));
+  clip.SetClipOperation(Entity::ClipOperation::kIntersect);
+
+  clip.SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({50, 50}, 20).TakePath()));
+  EXPECT_FALSE(clip.IsDepthClip(entity, depth_target));
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -1770,6 +1823,69 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, ColorMatrixFiltersFoldWhenTheyDontClamp) {
+  // clang-format off
+  ColorMatrix swap_red_and_blue = {
+      0, 0, 1, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      1, 0, 0, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  ColorMatrix halve_red = {
+      0.5, 0, 0, 0, 0,  //
+      0,   1, 0, 0, 0,  //
+      0,   0, 1, 0, 0,  //
+      0,   0, 0, 1, 0,  //
+  };
+  ColorMatrix double_red = {
+      2, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  ColorMatrix half_alpha = {
+      1, 0, 0, 0,   0,  //
+      0, 1, 0, 0,   0,  //
+      0, 0, 1, 0,   0,  //
+      0, 0, 0, 0.5, 0,  //
+  };
+  // clang-format on
+
+  auto folded = ColorMatrixFilterContents::Fold(halve_red, swap_red_and_blue);
+  ASSERT_TRUE(folded.has_value());
+  auto color = Color(0.2, 0.4, 0.8, 1.0);
+  auto expected =
+      color.ApplyColorMatrix(swap_red_and_blue).ApplyColorMatrix(halve_red);
+  ASSERT_COLOR_NEAR(color.ApplyColorMatrix(folded.value()), expected);
+
+  // The inner filter would clamp red.
+  ASSERT_FALSE(
+      ColorMatrixFilterContents::Fold(halve_red, double_red).has_value());
+  // Both filters write out premultiplied colors, which interacts with alpha.
+  ASSERT_FALSE(
+      ColorMatrixFilterContents::Fold(half_alpha, halve_red).has_value());
+  ASSERT_FALSE(
+      ColorMatrixFilterContents::Fold(halve_red, half_alpha).has_value());
+
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)));
+  fill->SetColor(color);
+  auto inner =
+      ColorFilterContents::MakeColorMatrix(FilterInput::Make(fill), halve_red);
+  auto outer = ColorFilterContents::MakeColorMatrix(FilterInput::Make(inner),
+                                                    swap_red_and_blue);
+  ASSERT_NE(outer->AsColorMatrixFilter(), nullptr);
+  ASSERT_EQ(outer->GetInputs().size(), 1u);
+
+  // Folding happens when the chain renders, and leaves the filters as built.
+  Entity entity;
+  entity.SetContents(outer);
+  ASSERT_TRUE(entity.GetCoverage().has_value());
+  ASSERT_RECT_NEAR(entity.GetCoverage().value(),
+                   Rect::MakeXYWH(0, 0, 100, 100));
+  ASSERT_EQ(inner->AsColorMatrixFilter()->GetMatrix().array[0], 0.5);
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -1995,6 +2111,81 @@ TEST_P(EntityTest, AtlasContentsSubAtlas) {
   }
 }
 
+TEST_P(EntityTest, AtlasContentsSharedColor) {
+  auto contents = std::make_shared<AtlasContents>();
+  ASSERT_FALSE(contents->GetSharedColor().has_value());
+
+  contents->SetColors({Color::Red(), Color::Red(), Color::Red()});
+  ASSERT_EQ(contents->GetSharedColor(), Color::Red());
+
+  contents->SetColors({Color::Red(), Color::Green(), Color::Red()});
+  ASSERT_FALSE(contents->GetSharedColor().has_value());
+}
+
+TEST_P(EntityTest, AtlasContentsWritesSpriteInstances) {
+  std::vector<Rect> texture_coords = {Rect::MakeXYWH(1, 2, 3, 4)};
+  std::vector<Matrix> transforms = {Matrix::MakeTranslation({10, 20}) *
+                                    Matrix::MakeScale({2, 3, 1})};
+  std::vector<Color> colors = {Color::Red().WithAlpha(0.5)};
+
+  AtlasSpriteInstanceData instance;
+  AtlasContents::WriteSpriteInstances(texture_coords, transforms, colors,
+                                      &instance);
+  ASSERT_EQ(instance.texture_rect, Vector4(1, 2, 3, 4));
+  ASSERT_EQ(instance.basis, Vector4(2, 0, 0, 3));
+  ASSERT_EQ(instance.translation, Vector4(10, 20, 0, 0));
+  ASSERT_EQ(instance.color, Vector4(0.5, 0, 0, 0.5));
+
+  AtlasContents::WriteSpriteInstances(texture_coords, transforms, {},
+                                      &instance);
+  ASSERT_EQ(instance.color, Vector4(0, 0, 0, 0));
+
+  ASSERT_TRUE(AtlasContents::CanDrawInstanced(transforms));
+  Matrix perspective;
+  perspective.m[3] = 0.01;
+  ASSERT_FALSE(AtlasContents::CanDrawInstanced({perspective}));
+}
+
+TEST_P(EntityTest, SolidRectBatchContentsOnlyBatchesSolidRects) {
+  auto make_entity = [](std::unique_ptr<Geometry> geometry) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(std::move(geometry));
+    contents->SetColor(Color::Red());
+    Entity entity;
+    entity.SetContents(contents);
+    return entity;
+  };
+
+  auto rect = make_entity(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)));
+  ASSERT_TRUE(SolidRectBatchContents::CanBatch(rect));
+
+  auto path = make_entity(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({10, 10}, 10).TakePath()));
+  ASSERT_FALSE(SolidRectBatchContents::CanBatch(path));
+
+  auto advanced_blend = rect;
+  advanced_blend.SetBlendMode(BlendMode::kColorDodge);
+  ASSERT_FALSE(SolidRectBatchContents::CanBatch(advanced_blend));
+
+  SolidRectBatchContents batch;
+  batch.Append(rect);
+
+  auto moved_rect = rect;
+  moved_rect.SetTransformation(Matrix::MakeTranslation({20, 30}));
+  ASSERT_TRUE(batch.CanAppend(moved_rect));
+  batch.Append(moved_rect);
+  ASSERT_EQ(batch.GetCount(), 2u);
+  ASSERT_EQ(batch.GetCoverage(Entity()), Rect::MakeLTRB(0, 0, 30, 40));
+
+  auto clipped_rect = rect;
+  clipped_rect.SetStencilDepth(1);
+  ASSERT_FALSE(batch.CanAppend(clipped_rect));
+
+  auto blended_rect = rect;
+  blended_rect.SetBlendMode(BlendMode::kPlus);
+  ASSERT_FALSE(batch.CanAppend(blended_rect));
+}
+
 static Vector3 RGBToYUV(Vector3 rgb, YUVColorSpace yuv_color_space) {
   Vector3 yuv;
   switch (yuv_color_space) {
@@ -2096,6 +2287,35 @@ TEST_P(EntityTest, YUVToRGBFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, YUVToRGBFilterDrawsPlanesDirectly) {
+  if (GetParam() == PlaygroundBackend::kOpenGLES) {
+    // TODO(114588) : Support YUV to RGB filter on OpenGLES backend.
+    GTEST_SKIP_("YUV to RGB filter is not supported on OpenGLES backend yet.");
+  }
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    auto textures = CreateTestYUVTextures(GetContext().get(),
+                                          YUVColorSpace::kBT601FullRange);
+    // Scaled up, with linear sampling and half opacity, and without a
+    // snapshot in between.
+    auto contents = std::make_shared<YUVToRGBFilterContents>();
+    contents->SetInputs(
+        {FilterInput::Make(textures[0]), FilterInput::Make(textures[1])});
+    contents->SetYUVColorSpace(YUVColorSpace::kBT601FullRange);
+    contents->SetSamplerDescriptor(SamplerDescriptor(
+        "Linear", MinMagFilter::kLinear, MinMagFilter::kLinear,
+        MipFilter::kNearest));
+    contents->SetOpacity(0.5);
+
+    Entity entity;
+    entity.SetContents(contents);
+    entity.SetTransformation(Matrix::MakeTranslation({100, 300}) *
+                             Matrix::MakeScale(Vector2(32, 32)));
+    return entity.Render(context, pass);
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 TEST_P(EntityTest, RuntimeEffect) {
   if (GetParam() != PlaygroundBackend::kMetal) {
     GTEST_SKIP_("This backend doesn't support runtime effects.");
@@ -2137,6 +2357,43 @@ TEST_P(EntityTest, RuntimeEffect) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, RuntimeEffectCacheComputesLayoutsOnce) {
+  auto runtime_stage =
+      OpenAssetAsRuntimeStage("runtime_stage_example.frag.iplr");
+  ASSERT_TRUE(runtime_stage);
+  RuntimeEffectCache cache;
+
+  auto layout = cache.GetLayout(runtime_stage);
+  ASSERT_TRUE(layout->is_valid);
+  ASSERT_EQ(layout->float_uniforms.size(), 2u);
+  EXPECT_STREQ(layout->float_uniforms[0].name, "iResolution");
+  EXPECT_EQ(layout->float_uniforms[0].offset, 0u);
+  EXPECT_STREQ(layout->float_uniforms[1].name, "iTime");
+  EXPECT_EQ(layout->float_uniforms[1].offset, sizeof(Vector2));
+  EXPECT_TRUE(layout->samplers.empty());
+
+  EXPECT_EQ(cache.GetLayout(runtime_stage), layout);
+  EXPECT_EQ(cache.GetLayoutCount(), 1u);
+
+  runtime_stage.reset();
+  auto reloaded_stage =
+      OpenAssetAsRuntimeStage("runtime_stage_example.frag.iplr");
+  EXPECT_NE(cache.GetLayout(reloaded_stage), layout);
+  EXPECT_EQ(cache.GetLayoutCount(), 1u);
+}
+
+TEST_P(EntityTest, RuntimeEffectWarmUpRegistersTheShader) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("This backend doesn't support runtime effects.");
+  }
+
+  auto runtime_stage =
+      OpenAssetAsRuntimeStage("runtime_stage_example.frag.iplr");
+  ASSERT_TRUE(runtime_stage->IsDirty());
+  RuntimeEffectContents::WarmUp(GetContext(), runtime_stage);
+  ASSERT_FALSE(runtime_stage->IsDirty());
+}
+
 TEST_P(EntityTest, InheritOpacityTest) {
   Entity entity;
 
@@ -2208,6 +2465,154 @@ TEST_P(EntityTest, InheritOpacityTest) {
   ASSERT_FALSE(runtime_effect->CanInheritOpacity(entity));
 }
 
+TEST_P(EntityTest, GlyphInstancesAreCachedForUnchangedTextFrames) {
+  SkFont font;
+  font.setSize(30);
+  auto blob = SkTextBlob::MakeFromString("Hello", font);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  auto lazy_glyph_atlas =
+      std::make_shared<LazyGlyphAtlas>(TypographerContextSkia::Make());
+  lazy_glyph_atlas->AddTextFrame(*frame, 1.0f);
+  auto atlas = lazy_glyph_atlas->CreateOrGetGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(atlas && atlas->IsValid());
+
+  GlyphInstanceCache cache;
+  const auto& instances = cache.GetInstances(frame, atlas, 1.0f);
+  ASSERT_EQ(instances.size(), 5u);
+  const auto* instance_data = instances.data();
+
+  const auto& glyph_position = frame->GetRuns()[0].GetGlyphPositions()[1];
+  EXPECT_EQ(instances[1].glyph_bounds.x,
+            glyph_position.position.x + glyph_position.glyph.bounds.origin.x);
+  EXPECT_EQ(instances[1].glyph_bounds.z,
+            glyph_position.glyph.bounds.size.width);
+
+  // Drawing the same frame again with the same atlas reuses the instances.
+  EXPECT_EQ(cache.GetInstances(frame, atlas, 1.0f).data(), instance_data);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+}
+
+TEST_P(EntityTest, TessellationCacheReusesTrianglesOfEqualPaths) {
+  auto make_path = [](Point center) {
+    return PathBuilder{}.AddCircle(center, 50).TakePath(FillType::kOdd);
+  };
+  auto host_buffer = HostBuffer::Create();
+  TessellationCache cache(GetContext()->GetResourceAllocator(),
+                          std::make_shared<Tessellator>());
+
+  auto first = cache.GetOrTessellate(make_path({100, 100}), 1.1, *host_buffer);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(cache.GetStats().miss_count, 1u);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+
+  // An equal path built anew, drawn at a scale in the same bucket.
+  auto second =
+      cache.GetOrTessellate(make_path({100, 100}), 1.15, *host_buffer);
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(cache.GetStats().hit_count, 1u);
+  EXPECT_EQ(second->vertex_buffer.buffer, first->vertex_buffer.buffer);
+  EXPECT_EQ(second->vertex_count, first->vertex_count);
+
+  auto moved = cache.GetOrTessellate(make_path({101, 100}), 1.1, *host_buffer);
+  ASSERT_TRUE(moved.has_value());
+  EXPECT_NE(moved->vertex_buffer.buffer, first->vertex_buffer.buffer);
+  EXPECT_EQ(cache.GetStats().miss_count, 2u);
+  EXPECT_EQ(cache.GetStats().entry_count, 2u);
+}
+
+TEST_P(EntityTest, TessellationCacheEvictsLeastRecentlyUsedEntries) {
+  auto make_path = [](Point center) {
+    return PathBuilder{}.AddCircle(center, 50).TakePath(FillType::kOdd);
+  };
+  auto host_buffer = HostBuffer::Create();
+  TessellationCache probe(GetContext()->GetResourceAllocator(),
+                          std::make_shared<Tessellator>());
+  ASSERT_TRUE(probe.GetOrTessellate(make_path({0, 0}), 1.0, *host_buffer));
+  const size_t entry_bytes = probe.GetStats().cached_bytes;
+  ASSERT_GT(entry_bytes, 0u);
+
+  // Room for two entries.
+  TessellationCache cache(GetContext()->GetResourceAllocator(),
+                          std::make_shared<Tessellator>(), entry_bytes * 2);
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({0, 0}), 1.0, *host_buffer));
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({1, 0}), 1.0, *host_buffer));
+  // Touch the first path so that the second one is the oldest.
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({0, 0}), 1.0, *host_buffer));
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({2, 0}), 1.0, *host_buffer));
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.entry_count, 2u);
+  EXPECT_EQ(stats.eviction_count, 1u);
+  EXPECT_LE(stats.cached_bytes, entry_bytes * 2);
+
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({0, 0}), 1.0, *host_buffer));
+  EXPECT_EQ(cache.GetStats().hit_count, 2u);
+  ASSERT_TRUE(cache.GetOrTessellate(make_path({1, 0}), 1.0, *host_buffer));
+  EXPECT_EQ(cache.GetStats().miss_count, 4u);
+}
+
+TEST_P(EntityTest, GradientTextureCacheReusesTexturesOfEqualGradients) {
+  GradientTextureCache cache;
+  std::vector<Color> colors = {Color::Red(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 1.0};
+
+  auto first = cache.GetOrCreate(colors, stops, GetContext());
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(cache.GetStats().miss_count, 1u);
+
+  auto second = cache.GetOrCreate({Color::Red(), Color::Blue()}, {0.0, 1.0},
+                                  GetContext());
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(cache.GetStats().hit_count, 1u);
+
+  auto other_stops = cache.GetOrCreate(colors, {0.0, 0.5}, GetContext());
+  ASSERT_NE(other_stops, nullptr);
+  EXPECT_NE(other_stops, first);
+  auto other_colors =
+      cache.GetOrCreate({Color::Red(), Color::Green()}, stops, GetContext());
+  ASSERT_NE(other_colors, nullptr);
+  EXPECT_NE(other_colors, first);
+  EXPECT_EQ(cache.GetStats().entry_count, 3u);
+}
+
+TEST_P(EntityTest, GradientTextureCacheEvictsLeastRecentlyUsedEntries) {
+  std::vector<Scalar> stops = {0.0, 1.0};
+  GradientTextureCache probe;
+  ASSERT_NE(probe.GetOrCreate({Color::Red(), Color::Blue()}, stops,
+                              GetContext()),
+            nullptr);
+  const size_t entry_bytes = probe.GetStats().cached_bytes;
+  ASSERT_GT(entry_bytes, 0u);
+
+  // Room for two entries.
+  GradientTextureCache cache(entry_bytes * 2);
+  auto red = cache.GetOrCreate({Color::Red(), Color::Blue()}, stops,
+                               GetContext());
+  cache.GetOrCreate({Color::Green(), Color::Blue()}, stops, GetContext());
+  // Touch the first gradient so that the second one is the oldest.
+  cache.GetOrCreate({Color::Red(), Color::Blue()}, stops, GetContext());
+  cache.GetOrCreate({Color::White(), Color::Blue()}, stops, GetContext());
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.entry_count, 2u);
+  EXPECT_EQ(stats.eviction_count, 1u);
+  EXPECT_EQ(cache.GetOrCreate({Color::Red(), Color::Blue()}, stops,
+                              GetContext()),
+            red);
+  EXPECT_EQ(cache.GetStats().hit_count, 2u);
+}
+
+TEST_P(EntityTest, TessellationCacheQuantizesScaleUpToQuarterOctaves) {
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.0), 1.0);
+  EXPECT_EQ(TessellationCache::QuantizeScale(2.0), 2.0);
+  EXPECT_EQ(TessellationCache::QuantizeScale(1.1),
+            TessellationCache::QuantizeScale(1.15));
+  EXPECT_GE(TessellationCache::QuantizeScale(1.1), 1.1);
+  EXPECT_LT(TessellationCache::QuantizeScale(1.1), 1.2);
+  EXPECT_GE(TessellationCache::QuantizeScale(0.3), 0.3);
+}
+
 TEST_P(EntityTest, ColorFilterWithForegroundColorAdvancedBlend) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(
@@ -2363,42 +2768,84 @@ TEST_P(EntityTest, TiledTextureContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+namespace {
+
+template <class T>
+std::vector<T> ReadHostBuffer(const HostBuffer& host_buffer,
+                              const BufferView& view) {
+  const T* data =
+      reinterpret_cast<const T*>(host_buffer.GetBuffer() + view.range.offset);
+  return std::vector<T>(data, data + view.range.length / sizeof(T));
+}
+
+}  // namespace
+
 TEST_P(EntityTest, TessellateConvex) {
   {
     // Sanity check simple rectangle.
-    auto [pts, indices] =
+    auto host_buffer = HostBuffer::Create();
+    auto vertex_buffer =
         TessellateConvex(PathBuilder{}
                              .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
                              .TakePath()
-                             .CreatePolyline(1.0));
+                             .CreatePolyline(1.0),
+                         *host_buffer);
 
     std::vector<Point> expected = {
         {0, 0}, {10, 0}, {10, 10}, {0, 10},  //
     };
     std::vector<uint16_t> expected_indices = {0, 1, 2, 0, 2, 3};
-    ASSERT_EQ(pts, expected);
-    ASSERT_EQ(indices, expected_indices);
+    ASSERT_EQ(ReadHostBuffer<Point>(*host_buffer, vertex_buffer.vertex_buffer),
+              expected);
+    ASSERT_EQ(
+        ReadHostBuffer<uint16_t>(*host_buffer, vertex_buffer.index_buffer),
+        expected_indices);
+    ASSERT_EQ(vertex_buffer.vertex_count, expected_indices.size());
   }
 
   {
-    auto [pts, indices] =
+    // Each contour gets its own fan.
+    auto host_buffer = HostBuffer::Create();
+    auto vertex_buffer =
         TessellateConvex(PathBuilder{}
                              .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
                              .AddRect(Rect::MakeLTRB(20, 20, 30, 30))
                              .TakePath()
-                             .CreatePolyline(1.0));
+                             .CreatePolyline(1.0),
+                         *host_buffer);
 
     std::vector<Point> expected = {
         {0, 0},   {10, 0},  {10, 10}, {0, 10},  //
         {20, 20}, {30, 20}, {30, 30}, {20, 30}  //
     };
     std::vector<uint16_t> expected_indices = {0, 1, 2, 0, 2, 3,
-                                              0, 6, 7, 0, 7, 8};
-    ASSERT_EQ(pts, expected);
-    ASSERT_EQ(indices, expected_indices);
+                                              4, 5, 6, 4, 6, 7};
+    ASSERT_EQ(ReadHostBuffer<Point>(*host_buffer, vertex_buffer.vertex_buffer),
+              expected);
+    ASSERT_EQ(
+        ReadHostBuffer<uint16_t>(*host_buffer, vertex_buffer.index_buffer),
+        expected_indices);
   }
 }
 
+TEST_P(EntityTest, TessellateConvexWithUVs) {
+  auto host_buffer = HostBuffer::Create();
+  auto vertex_buffer =
+      TessellateConvexWithUVs(PathBuilder{}
+                                  .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                                  .TakePath()
+                                  .CreatePolyline(1.0),
+                              *host_buffer, Rect::MakeLTRB(0, 0, 20, 20), {});
+
+  using VS = TextureFillVertexShader;
+  auto vertices = ReadHostBuffer<VS::PerVertexData>(
+      *host_buffer, vertex_buffer.vertex_buffer);
+  ASSERT_EQ(vertices.size(), 4u);
+  EXPECT_EQ(vertices[2].position, Point(10, 10));
+  EXPECT_EQ(vertices[2].texture_coords, Point(0.5, 0.5));
+  EXPECT_EQ(vertex_buffer.vertex_count, 6u);
+}
+
 TEST_P(EntityTest, PointFieldGeometryDivisions) {
   // Square always gives 4 divisions.
   ASSERT_EQ(PointFieldGeometry::ComputeCircleDivisions(24.0, false), 4u);
@@ -2527,6 +2974,110 @@ TEST_P(EntityTest, AdvancedBlendCoverageHintIsNotResetByEntityPass) {
   }
 }
 
+TEST_P(EntityTest, VerticesGeometryReusesUploadedVertexData) {
+  VerticesGeometry geometry({Point(0, 0), Point(100, 0), Point(0, 100)},
+                            {0u, 1u, 2u}, {},
+                            {Color::Red(), Color::Green(), Color::Blue()},
+                            Rect::MakeLTRB(0, 0, 100, 100),
+                            VerticesGeometry::VertexMode::kTriangles);
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    Entity entity;
+    auto first = geometry.GetPositionColorBuffer(context, entity, pass);
+    auto second = geometry.GetPositionColorBuffer(context, entity, pass);
+    EXPECT_TRUE(first.vertex_buffer.vertex_buffer);
+    EXPECT_EQ(first.vertex_buffer.vertex_buffer.buffer,
+              second.vertex_buffer.vertex_buffer.buffer);
+    EXPECT_EQ(second.vertex_buffer.vertex_count, 3u);
+
+    auto coverage = Rect::MakeLTRB(0, 0, 100, 100);
+    auto uv = geometry.GetPositionUVBuffer(coverage, Matrix(), context,
+                                           entity, pass);
+    auto same_uv = geometry.GetPositionUVBuffer(coverage, Matrix(), context,
+                                                entity, pass);
+    auto other_uv = geometry.GetPositionUVBuffer(
+        Rect::MakeLTRB(0, 0, 50, 50), Matrix(), context, entity, pass);
+    EXPECT_EQ(uv.vertex_buffer.vertex_buffer.buffer,
+              same_uv.vertex_buffer.vertex_buffer.buffer);
+    EXPECT_NE(uv.vertex_buffer.vertex_buffer.buffer,
+              other_uv.vertex_buffer.vertex_buffer.buffer);
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, GaussianBlurDownsamplesLargeSigmas) {
+  using Quality = FilterContents::BlurQuality;
+  EXPECT_EQ(DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+                1000, Quality::kFull),
+            0);
+  EXPECT_EQ(DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+                20, Quality::kBalanced),
+            0);
+  EXPECT_EQ(DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+                64, Quality::kBalanced),
+            2);
+  EXPECT_EQ(DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+                64, Quality::kFast),
+            4);
+  EXPECT_EQ(DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+                10000, Quality::kBalanced),
+            4);
+}
+
+TEST_P(EntityTest, PipelineVariantManifestRoundTrips) {
+  ContentContext::PipelineVariant variant{
+      .pipeline_label = "Solid Fill Pipeline",
+      .options = {.sample_count = SampleCount::kCount4,
+                  .blend_mode = BlendMode::kMultiply,
+                  .stencil_compare = CompareFunction::kLessEqual,
+                  .stencil_operation = StencilOperation::kIncrementClamp,
+                  .primitive_type = PrimitiveType::kTriangleStrip,
+                  .color_attachment_pixel_format =
+                      PixelFormat::kB8G8R8A8UNormInt,
+                  .has_stencil_attachment = false,
+                  .wireframe = true}};
+  auto manifest = ContentContext::SerializePipelineVariants({variant});
+  auto variants = ContentContext::DeserializePipelineVariants(
+      manifest + "Malformed\t1\t2\n\nSolid Fill Pipeline\t2\t0\t0\t0\t0\t1"
+                 "\t1\t0\t0\n");
+
+  ASSERT_EQ(variants.size(), 1u);
+  EXPECT_EQ(variants[0].pipeline_label, variant.pipeline_label);
+  EXPECT_TRUE(
+      ContentContextOptions::Equal{}(variants[0].options, variant.options));
+}
+
+TEST_P(EntityTest, WarmedUpPipelineVariantsAreRecorded) {
+  auto content_context =
+      ContentContext(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+  auto options = ContentContextOptions{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+  auto prototype = content_context.GetSolidFillPipeline({
+      .sample_count = SampleCount::kCount4,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+  });
+  ASSERT_TRUE(prototype);
+  EXPECT_TRUE(content_context.GetCreatedPipelineVariants().empty());
+
+  content_context.WarmUpPipelineVariants(
+      {{.pipeline_label = prototype->GetDescriptor().GetLabel(),
+        .options = options},
+       {.pipeline_label = "Unknown Pipeline", .options = options}});
+  auto created = content_context.GetCreatedPipelineVariants();
+  ASSERT_EQ(created.size(), 1u);
+  EXPECT_EQ(created[0].pipeline_label, prototype->GetDescriptor().GetLabel());
+  EXPECT_TRUE(ContentContextOptions::Equal{}(created[0].options, options));
+
+  // Using a warmed up variant doesn't create it again.
+  EXPECT_TRUE(content_context.GetSolidFillPipeline(options));
+  EXPECT_EQ(content_context.GetCreatedPipelineVariants().size(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
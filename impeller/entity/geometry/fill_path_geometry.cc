@@ -4,6 +4,10 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_tessellator.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 FillPathGeometry::FillPathGeometry(const Path& path,
@@ -12,54 +16,64 @@ FillPathGeometry::FillPathGeometry(const Path& path,
 
 FillPathGeometry::~FillPathGeometry() = default;
 
+// |Geometry|
+void FillPathGeometry::Prefetch(const Matrix& transform,
+                                fml::ConcurrentTaskRunner& task_runner) {
+  // Only convex fills are flattened while they are rendered. The others go
+  // through the tessellation cache, which keeps them across frames.
+  if (path_.GetFillType() != FillType::kNonZero || !path_.IsConvex() ||
+      path_.GetComponentCount() < kMinPrefetchComponentCount) {
+    return;
+  }
+  const Scalar scale = transform.GetMaxBasisLength();
+  polyline_prefetch_ =
+      std::make_unique<GeometryPrefetch<Scalar, Path::Polyline>>(
+          scale, task_runner,
+          [this, scale]() { return path_.CreatePolyline(scale); });
+}
+
+const Path::Polyline& FillPathGeometry::GetPolyline(Scalar scale,
+                                                    Path::Polyline& storage) {
+  if (polyline_prefetch_) {
+    if (const auto* polyline = polyline_prefetch_->Get(scale)) {
+      return *polyline;
+    }
+  }
+  path_.CreatePolyline(scale, storage);
+  return storage;
+}
+
 GeometryResult FillPathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
   auto& host_buffer = pass.GetTransientsBuffer();
-  VertexBuffer vertex_buffer;
 
   if (path_.GetFillType() == FillType::kNonZero &&  //
       path_.IsConvex()) {
-    auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
-
-    vertex_buffer.vertex_buffer = host_buffer.Emplace(
-        points.data(), points.size() * sizeof(Point), alignof(Point));
-    vertex_buffer.index_buffer = host_buffer.Emplace(
-        indices.data(), indices.size() * sizeof(uint16_t), alignof(uint16_t));
-    vertex_buffer.vertex_count = indices.size();
-    vertex_buffer.index_type = IndexType::k16bit;
-
+    Path::Polyline storage;
     return GeometryResult{
         .type = PrimitiveType::kTriangle,
-        .vertex_buffer = vertex_buffer,
+        .vertex_buffer = TessellateConvex(
+            GetPolyline(entity.GetTransformation().GetMaxBasisLength(),
+                        storage),
+            host_buffer),
         .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                      entity.GetTransformation(),
         .prevent_overdraw = false,
     };
   }
 
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
-          const float* vertices, size_t vertices_count, const uint16_t* indices,
-          size_t indices_count) {
-        vertex_buffer.vertex_buffer = host_buffer.Emplace(
-            vertices, vertices_count * sizeof(float), alignof(float));
-        vertex_buffer.index_buffer = host_buffer.Emplace(
-            indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
-        vertex_buffer.vertex_count = indices_count;
-        vertex_buffer.index_type = IndexType::k16bit;
-        return true;
-      });
-  if (tesselation_result != Tessellator::Result::kSuccess) {
+  // Paths that need a real tessellation are often drawn again unchanged, so
+  // their triangles are kept in device buffers across frames.
+  auto cached_vertex_buffer = renderer.GetTessellationCache()->GetOrTessellate(
+      path_, entity.GetTransformation().GetMaxBasisLength(), host_buffer);
+  if (!cached_vertex_buffer.has_value()) {
     return {};
   }
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
-      .vertex_buffer = vertex_buffer,
+      .vertex_buffer = cached_vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
@@ -77,28 +91,13 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
 
   if (path_.GetFillType() == FillType::kNonZero &&  //
       path_.IsConvex()) {
-    auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
-
-    VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-    vertex_builder.Reserve(points.size());
-    vertex_builder.ReserveIndices(indices.size());
-    for (auto i = 0u; i < points.size(); i++) {
-      VS::PerVertexData data;
-      data.position = points[i];
-      data.texture_coords = effect_transform *
-                            (points[i] - texture_coverage.origin) /
-                            texture_coverage.size;
-      vertex_builder.AppendVertex(data);
-    }
-    for (auto i = 0u; i < indices.size(); i++) {
-      vertex_builder.AppendIndex(indices[i]);
-    }
-
+    Path::Polyline storage;
     return GeometryResult{
         .type = PrimitiveType::kTriangle,
-        .vertex_buffer =
-            vertex_builder.CreateVertexBuffer(pass.GetTransientsBuffer()),
+        .vertex_buffer = TessellateConvexWithUVs(
+            GetPolyline(entity.GetTransformation().GetMaxBasisLength(),
+                        storage),
+            pass.GetTransientsBuffer(), texture_coverage, effect_transform),
         .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                      entity.GetTransformation(),
         .prevent_overdraw = false,
@@ -140,6 +139,77 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   };
 }
 
+// |Geometry|
+std::optional<StencilCoverGeometryResult>
+FillPathGeometry::GetStencilCoverBuffer(const ContentContext& renderer,
+                                        const Entity& entity,
+                                        RenderPass& pass) {
+#ifdef IMPELLER_ENABLE_COMPUTE
+  // Only the fill types that test whether the winding number is zero or odd
+  // can be read from a wrapping stencil value.
+  auto fill_type = path_.GetFillType();
+  if (fill_type != FillType::kNonZero && fill_type != FillType::kOdd) {
+    return std::nullopt;
+  }
+  if (!renderer.GetDeviceCapabilities().SupportsComputeSubgroups() ||
+      path_.IsConvex() ||
+      path_.GetComponentCount() < kMinComputeFillComponentCount) {
+    return std::nullopt;
+  }
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  if (scale <= 0) {
+    return std::nullopt;
+  }
+
+  auto allocator = renderer.GetContext()->GetResourceAllocator();
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.size = ComputeTessellator::GetFillVertexBufferLength();
+  auto vertex_buffer = allocator->CreateBuffer(desc);
+  desc.size = sizeof(uint32_t);
+  auto vertex_count_buffer = allocator->CreateBuffer(desc);
+  if (!vertex_buffer || !vertex_count_buffer) {
+    return std::nullopt;
+  }
+
+  // The tessellator runs in local coordinates, so its tolerances are scaled
+  // down to flatten the curves as finely as `CreatePolyline` would.
+  auto status = ComputeTessellator{}
+                    .SetStyle(ComputeTessellator::Style::kFill)
+                    .SetCubicAccuracy(kDefaultCurveTolerance / scale)
+                    .SetQuadraticTolerance(.1f / scale)
+                    .Tessellate(path_, renderer.GetContext(),
+                                vertex_buffer->AsBufferView(),
+                                vertex_count_buffer->AsBufferView());
+  if (status != ComputeTessellator::Status::kOk) {
+    return std::nullopt;
+  }
+
+  constexpr size_t kHalfLength =
+      ComputeTessellator::GetFillVertexBufferLength() / 2;
+  constexpr size_t kHalfVertexCount =
+      ComputeTessellator::kMaxFillTriangleCount * 3;
+  auto front = vertex_buffer->AsBufferView();
+  front.range.length = kHalfLength;
+  auto back = vertex_buffer->AsBufferView();
+  back.range.offset += kHalfLength;
+  back.range.length = kHalfLength;
+  return StencilCoverGeometryResult{
+      .front_vertex_buffer = {.vertex_buffer = front,
+                              .vertex_count = kHalfVertexCount,
+                              .index_type = IndexType::kNone},
+      .back_vertex_buffer = {.vertex_buffer = back,
+                             .vertex_count = kHalfVertexCount,
+                             .index_type = IndexType::kNone},
+      .fill_type = fill_type,
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+  };
+#else
+  return std::nullopt;
+#endif  // IMPELLER_ENABLE_COMPUTE
+}
+
 GeometryVertexType FillPathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
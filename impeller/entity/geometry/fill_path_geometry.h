@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prefetch.h"
 #include "impeller/geometry/rect.h"
 
 namespace impeller {
@@ -14,6 +16,10 @@ namespace impeller {
 /// @brief A geometry that is created from a filled path object.
 class FillPathGeometry : public Geometry {
  public:
+  /// Paths with fewer components than this are cheaper to tessellate on the
+  /// CPU than to draw through the stencil buffer.
+  static constexpr size_t kMinComputeFillComponentCount = 64u;
+
   explicit FillPathGeometry(const Path& path,
                             std::optional<Rect> inner_rect = std::nullopt);
 
@@ -22,12 +28,22 @@ class FillPathGeometry : public Geometry {
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
+  // |Geometry|
+  void Prefetch(const Matrix& transform,
+                fml::ConcurrentTaskRunner& task_runner) override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  std::optional<StencilCoverGeometryResult> GetStencilCoverBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
@@ -41,8 +57,12 @@ class FillPathGeometry : public Geometry {
                                      const Entity& entity,
                                      RenderPass& pass) override;
 
+  const Path::Polyline& GetPolyline(Scalar scale, Path::Polyline& storage);
+
   Path path_;
   std::optional<Rect> inner_rect_;
+  // Reads `path_`, so it must be destroyed first.
+  std::unique_ptr<GeometryPrefetch<Scalar, Path::Polyline>> polyline_prefetch_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FillPathGeometry);
 };
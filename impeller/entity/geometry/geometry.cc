@@ -15,35 +15,92 @@
 
 namespace impeller {
 
-/// Given a convex polyline, create a triangle fan structure.
-std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
-    Path::Polyline polyline) {
-  std::vector<Point> output;
-  std::vector<uint16_t> indices;
+namespace {
+
+/// The points of a contour of a convex polyline that make up its triangle
+/// fan. Some polygons will not self close and an additional triangle must be
+/// inserted, others will self close and the closing point is dropped to avoid
+/// inserting an extra triangle.
+std::pair<size_t, size_t> GetConvexContourPointRange(
+    const Path::Polyline& polyline,
+    size_t contour_index) {
+  auto [start, end] = polyline.GetContourPointBounds(contour_index);
+  if (end - start > 1u && polyline.points[end - 1] == polyline.points[start]) {
+    end--;
+  }
+  return {start, end};
+}
 
+/// Writes a triangle fan for every contour straight into the host buffer,
+/// making each vertex from its point with `make_vertex`.
+template <class VertexType, class VertexProc>
+VertexBuffer TessellateConvexIntoHostBuffer(const Path::Polyline& polyline,
+                                            HostBuffer& host_buffer,
+                                            const VertexProc& make_vertex) {
+  size_t vertex_count = 0u;
+  size_t index_count = 0u;
   for (auto j = 0u; j < polyline.contours.size(); j++) {
-    auto [start, end] = polyline.GetContourPointBounds(j);
-    auto center = polyline.points[start];
-
-    // Some polygons will not self close and an additional triangle
-    // must be inserted, others will self close and we need to avoid
-    // inserting an extra triangle.
-    if (polyline.points[end - 1] == polyline.points[start]) {
-      end--;
+    auto [start, end] = GetConvexContourPointRange(polyline, j);
+    vertex_count += end - start;
+    if (end - start > 2u) {
+      index_count += (end - start - 2u) * 3u;
     }
-    output.emplace_back(center);
-    output.emplace_back(polyline.points[start + 1]);
+  }
 
-    for (auto i = start + 2; i < end; i++) {
-      const auto& point_b = polyline.points[i];
-      output.emplace_back(point_b);
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = host_buffer.Emplace(
+      vertex_count * sizeof(VertexType), alignof(VertexType),
+      [&](uint8_t* contents) {
+        auto* vertices = reinterpret_cast<VertexType*>(contents);
+        for (auto j = 0u; j < polyline.contours.size(); j++) {
+          auto [start, end] = GetConvexContourPointRange(polyline, j);
+          for (auto i = start; i < end; i++) {
+            *vertices++ = make_vertex(polyline.points[i]);
+          }
+        }
+      });
+  vertex_buffer.index_buffer = host_buffer.Emplace(
+      index_count * sizeof(uint16_t), alignof(uint16_t),
+      [&](uint8_t* contents) {
+        auto* indices = reinterpret_cast<uint16_t*>(contents);
+        size_t base = 0u;
+        for (auto j = 0u; j < polyline.contours.size(); j++) {
+          auto [start, end] = GetConvexContourPointRange(polyline, j);
+          for (auto i = 2u; i < end - start; i++) {
+            *indices++ = base;
+            *indices++ = base + i - 1;
+            *indices++ = base + i;
+          }
+          base += end - start;
+        }
+      });
+  vertex_buffer.vertex_count = index_count;
+  vertex_buffer.index_type = IndexType::k16bit;
+  return vertex_buffer;
+}
 
-      indices.emplace_back(0);
-      indices.emplace_back(i - 1);
-      indices.emplace_back(i);
-    }
-  }
-  return std::make_pair(output, indices);
+}  // namespace
+
+VertexBuffer TessellateConvex(const Path::Polyline& polyline,
+                              HostBuffer& host_buffer) {
+  return TessellateConvexIntoHostBuffer<Point>(
+      polyline, host_buffer, [](const Point& point) { return point; });
+}
+
+VertexBuffer TessellateConvexWithUVs(const Path::Polyline& polyline,
+                                     HostBuffer& host_buffer,
+                                     Rect texture_coverage,
+                                     Matrix effect_transform) {
+  using VS = TextureFillVertexShader;
+  return TessellateConvexIntoHostBuffer<VS::PerVertexData>(
+      polyline, host_buffer, [&](const Point& point) {
+        VS::PerVertexData data;
+        data.position = point;
+        data.texture_coords = effect_transform *
+                              (point - texture_coverage.origin) /
+                              texture_coverage.size;
+        return data;
+      });
 }
 
 VertexBufferBuilder<TextureFillVertexShader::PerVertexData>
@@ -143,6 +200,20 @@ std::unique_ptr<Geometry> Geometry::MakeRect(Rect rect) {
   return std::make_unique<RectGeometry>(rect);
 }
 
+std::optional<StencilCoverGeometryResult> Geometry::GetStencilCoverBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return std::nullopt;
+}
+
+std::optional<Rect> Geometry::AsRect() const {
+  return std::nullopt;
+}
+
+void Geometry::Prefetch(const Matrix& transform,
+                        fml::ConcurrentTaskRunner& task_runner) {}
+
 bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   return false;
 }
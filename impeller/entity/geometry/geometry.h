@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
@@ -22,6 +23,18 @@ struct GeometryResult {
   bool prevent_overdraw;
 };
 
+/// @brief The vertices of a geometry that are drawn into the stencil buffer
+///        to count the winding number of every pixel before the coverage of
+///        the geometry is covered. See `Geometry::GetStencilCoverBuffer`.
+struct StencilCoverGeometryResult {
+  /// Triangles that increment the winding number of the pixels they cover.
+  VertexBuffer front_vertex_buffer;
+  /// Triangles that decrement the winding number of the pixels they cover.
+  VertexBuffer back_vertex_buffer;
+  FillType fill_type;
+  Matrix transform;
+};
+
 enum GeometryVertexType {
   kPosition,
   kColor,
@@ -46,13 +59,25 @@ GeometryResult ComputeUVGeometryForRect(Rect source_rect,
                                         const Entity& entity,
                                         RenderPass& pass);
 
-/// @brief Given a polyline created from a convex filled path, perform a
-/// tessellation.
-std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
-    Path::Polyline polyline);
+/// @brief Given a polyline created from a convex filled path, triangulate
+///        each contour as a fan and write the vertices and indices straight
+///        into `host_buffer`, without going through libtess.
+VertexBuffer TessellateConvex(const Path::Polyline& polyline,
+                              HostBuffer& host_buffer);
+
+/// @brief Like `TessellateConvex`, but also computes the texture coordinates
+///        of every vertex for the `texture_coverage` and `effect_transform`.
+VertexBuffer TessellateConvexWithUVs(const Path::Polyline& polyline,
+                                     HostBuffer& host_buffer,
+                                     Rect texture_coverage,
+                                     Matrix effect_transform);
 
 class Geometry {
  public:
+  /// Paths with fewer components than this are flattened faster than a
+  /// prefetch can be posted.
+  static constexpr size_t kMinPrefetchComponentCount = 8u;
+
   Geometry();
 
   virtual ~Geometry();
@@ -86,10 +111,38 @@ class Geometry {
                                              const Entity& entity,
                                              RenderPass& pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief    Returns overlapping triangles whose winding numbers add up to
+  ///           the fill of this geometry, for geometry that is cheaper to
+  ///           draw through the stencil buffer than to tessellate.
+  ///
+  /// @returns  The triangles, or std::nullopt if the geometry must be drawn
+  ///           with `GetPositionBuffer`.
+  virtual std::optional<StencilCoverGeometryResult> GetStencilCoverBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief    Starts generating the vertices of this geometry for
+  ///           `transform` on `task_runner`, so that they are ready by the time
+  ///           the geometry is rendered with the same scale.
+  ///
+  ///           Geometries that are cheap to generate ignore this.
+  ///
+  virtual void Prefetch(const Matrix& transform,
+                        fml::ConcurrentTaskRunner& task_runner);
+
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief    The rectangle this geometry fills, if it fills exactly one
+  ///           rectangle.
+  ///
+  virtual std::optional<Rect> AsRect() const;
+
   /// @brief    Determines if this geometry, transformed by the given
   ///           `transform`, will completely cover all surface area of the given
   ///           `rect`.
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <utility>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A value that a geometry starts computing on a worker thread
+///             when it is drawn, such as the polyline or the stroke of a path,
+///             and that it collects when it is rendered.
+///
+///             The value is computed for a key made from the transformation
+///             the geometry was drawn with. Entities can be transformed again
+///             before they are rendered, so the value is only handed out for
+///             the same key.
+///
+///             The computation may still be running when the prefetch is
+///             destroyed, so its destructor waits for it. Geometries must
+///             declare their prefetch after the members it reads, so that it
+///             is destroyed first.
+///
+template <typename Key, typename Value>
+class GeometryPrefetch {
+ public:
+  GeometryPrefetch(Key key,
+                   fml::ConcurrentTaskRunner& task_runner,
+                   std::function<Value()> compute)
+      : key_(std::move(key)) {
+    task_runner.PostTask([this, compute = std::move(compute)]() {
+      TRACE_EVENT0("impeller", "GeometryPrefetch");
+      value_ = compute();
+      latch_.CountDown();
+    });
+  }
+
+  ~GeometryPrefetch() { latch_.Wait(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits for the value if it was computed for `key`.
+  ///
+  /// @return     The value, or null if it was computed for another key.
+  ///
+  const Value* Get(const Key& key) {
+    if (!(key == key_)) {
+      return nullptr;
+    }
+    latch_.Wait();
+    return &value_;
+  }
+
+ private:
+  const Key key_;
+  Value value_;
+  fml::CountDownLatch latch_{1};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GeometryPrefetch);
+};
+
+}  // namespace impeller
@@ -2,8 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prefetch.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -36,5 +39,66 @@ TEST(EntityGeometryTest, FillPathGeometryCoversAreaNoInnerRect) {
   ASSERT_FALSE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, StrokeOfALineWithButtCaps) {
+  auto path = PathBuilder{}.MoveTo({0, 0}).LineTo({10, 0}).TakePath();
+  auto vertices = StrokePathGeometry::GenerateSolidStrokeVertices(
+      path.CreatePolyline(1.0f), 2.0f, 4.0f, Join::kBevel, Cap::kButt, 1.0f);
+  std::vector<Point> expected = {
+      {0, -1}, {0, 1}, {0, 1}, {0, -1}, {10, 1}, {10, -1}, {10, 1}, {10, -1},
+  };
+  EXPECT_EQ(vertices, expected);
+}
+
+TEST(EntityGeometryTest, StrokeVertexCountEstimateIsAnUpperBound) {
+  auto path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .LineTo({100, 10})
+                  .LineTo({100, 100})
+                  .QuadraticCurveTo({50, 150}, {10, 100})
+                  .CubicCurveTo({0, 80}, {30, 20}, {60, 60})
+                  .MoveTo({200, 200})
+                  .LineTo({300, 210})
+                  .LineTo({220, 300})
+                  .Close()
+                  .AddCircle({400, 400}, 30)
+                  .MoveTo({500, 500})
+                  .LineTo({500, 500})
+                  .TakePath();
+  for (auto scale : {1.0f, 4.0f}) {
+    auto polyline = path.CreatePolyline(scale);
+    for (auto width : {1.0f, 40.0f}) {
+      for (auto join : {Join::kBevel, Join::kMiter, Join::kRound}) {
+        for (auto cap : {Cap::kButt, Cap::kRound, Cap::kSquare}) {
+          auto vertices = StrokePathGeometry::GenerateSolidStrokeVertices(
+              polyline, width, width * 2.0f, join, cap, scale);
+          EXPECT_FALSE(vertices.empty());
+          EXPECT_LE(vertices.size(),
+                    StrokePathGeometry::GetMaxSolidStrokeVertexCount(
+                        polyline, width, join, cap, scale));
+        }
+      }
+    }
+  }
+}
+
+TEST(EntityGeometryTest, GeometryPrefetchIsOnlyUsedForItsKey) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto path = PathBuilder{}
+                  .AddCircle({100, 100}, 50)
+                  .AddCircle({200, 200}, 80)
+                  .TakePath();
+
+  GeometryPrefetch<Scalar, Path::Polyline> prefetch(
+      2.0f, *loop->GetTaskRunner(),
+      [&path]() { return path.CreatePolyline(2.0f); });
+  ASSERT_EQ(prefetch.Get(1.0f), nullptr);
+
+  const auto* polyline = prefetch.Get(2.0f);
+  ASSERT_NE(polyline, nullptr);
+  auto expected = path.CreatePolyline(2.0f);
+  ASSERT_EQ(polyline->points, expected.points);
+  ASSERT_EQ(polyline->contours.size(), expected.contours.size());
+}
+
 }  // namespace testing
 }  // namespace impeller
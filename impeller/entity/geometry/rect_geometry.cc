@@ -47,6 +47,10 @@ std::optional<Rect> RectGeometry::GetCoverage(const Matrix& transform) const {
   return rect_.TransformBounds(transform);
 }
 
+std::optional<Rect> RectGeometry::AsRect() const {
+  return rect_;
+}
+
 bool RectGeometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   if (!transform.IsTranslationScaleOnly()) {
     return false;
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
+#include <algorithm>
+
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -37,207 +39,174 @@ Join StrokePathGeometry::GetStrokeJoin() const {
   return stroke_join_;
 }
 
-// static
-Scalar StrokePathGeometry::CreateBevelAndGetDirection(
-    VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
-    const Point& position,
-    const Point& start_offset,
-    const Point& end_offset) {
-  SolidFillVertexShader::PerVertexData vtx;
-  vtx.position = position;
-  vtx_builder.AppendVertex(vtx);
+namespace {
+
+/// Writes the vertices of a stroke into memory that was sized for the worst
+/// case up front. Vertices past the capacity are counted but dropped, so that
+/// a buffer that turned out to be too small can be detected.
+class StrokeVertexWriter {
+ public:
+  StrokeVertexWriter(Point* vertices, size_t capacity)
+      : vertices_(vertices), capacity_(capacity) {}
+
+  void AppendVertex(const Point& position) {
+    if (count_ < capacity_) {
+      vertices_[count_] = position;
+    }
+    count_++;
+  }
+
+  size_t GetVertexCount() const { return count_; }
+
+  bool HasOverflowed() const { return count_ > capacity_; }
+
+  /// Scratch space for flattening the arcs of round joins and caps.
+  std::vector<Point>& GetArcPoints() { return arc_points_; }
+
+ private:
+  Point* const vertices_;
+  const size_t capacity_;
+  size_t count_ = 0u;
+  std::vector<Point> arc_points_;
+};
+
+Scalar AppendBevelAndGetDirection(StrokeVertexWriter& writer,
+                                  const Point& position,
+                                  const Point& start_offset,
+                                  const Point& end_offset) {
+  writer.AppendVertex(position);
 
   Scalar dir = start_offset.Cross(end_offset) > 0 ? -1 : 1;
-  vtx.position = position + start_offset * dir;
-  vtx_builder.AppendVertex(vtx);
-  vtx.position = position + end_offset * dir;
-  vtx_builder.AppendVertex(vtx);
+  writer.AppendVertex(position + start_offset * dir);
+  writer.AppendVertex(position + end_offset * dir);
 
   return dir;
 }
 
-// static
-StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
-  using VS = SolidFillVertexShader;
-  StrokePathGeometry::JoinProc join_proc;
-  switch (stroke_join) {
-    case Join::kBevel:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        CreateBevelAndGetDirection(vtx_builder, position, start_offset,
-                                   end_offset);
-      };
-      break;
-    case Join::kMiter:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        Point start_normal = start_offset.Normalize();
-        Point end_normal = end_offset.Normalize();
-
-        // 1 for no joint (straight line), 0 for max joint (180 degrees).
-        Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
-        if (ScalarNearlyEqual(alignment, 1)) {
-          return;
-        }
+template <Join kJoin>
+void AppendJoin(StrokeVertexWriter& writer,
+                const Point& position,
+                const Point& start_offset,
+                const Point& end_offset,
+                Scalar miter_limit,
+                Scalar scale) {
+  if constexpr (kJoin == Join::kBevel) {
+    AppendBevelAndGetDirection(writer, position, start_offset, end_offset);
+  } else if constexpr (kJoin == Join::kMiter) {
+    Point start_normal = start_offset.Normalize();
+    Point end_normal = end_offset.Normalize();
+
+    // 1 for no joint (straight line), 0 for max joint (180 degrees).
+    Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
+    if (ScalarNearlyEqual(alignment, 1)) {
+      return;
+    }
 
-        Scalar dir = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
+    Scalar dir = AppendBevelAndGetDirection(writer, position, start_offset,
+                                            end_offset);
 
-        Point miter_point = (start_offset + end_offset) / 2 / alignment;
-        if (miter_point.GetDistanceSquared({0, 0}) >
-            miter_limit * miter_limit) {
-          return;  // Convert to bevel when we exceed the miter limit.
-        }
+    Point miter_point = (start_offset + end_offset) / 2 / alignment;
+    if (miter_point.GetDistanceSquared({0, 0}) > miter_limit * miter_limit) {
+      return;  // Convert to bevel when we exceed the miter limit.
+    }
 
-        // Outer miter point.
-        VS::PerVertexData vtx;
-        vtx.position = position + miter_point * dir;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
-    case Join::kRound:
-      join_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                     const Point& position, const Point& start_offset,
-                     const Point& end_offset, Scalar miter_limit,
-                     Scalar scale) {
-        Point start_normal = start_offset.Normalize();
-        Point end_normal = end_offset.Normalize();
-
-        // 0 for no joint (straight line), 1 for max joint (180 degrees).
-        Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
-        if (ScalarNearlyEqual(alignment, 0)) {
-          return;
-        }
+    // Outer miter point.
+    writer.AppendVertex(position + miter_point * dir);
+  } else {
+    static_assert(kJoin == Join::kRound);
+    Point start_normal = start_offset.Normalize();
+    Point end_normal = end_offset.Normalize();
+
+    // 0 for no joint (straight line), 1 for max joint (180 degrees).
+    Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
+    if (ScalarNearlyEqual(alignment, 0)) {
+      return;
+    }
 
-        Scalar dir = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
-
-        Point middle =
-            (start_offset + end_offset).Normalize() * start_offset.GetLength();
-        Point middle_normal = middle.Normalize();
-
-        Point middle_handle = middle + Point(-middle.y, middle.x) *
-                                           PathBuilder::kArcApproximationMagic *
-                                           alignment * dir;
-        Point start_handle =
-            start_offset + Point(start_offset.y, -start_offset.x) *
-                               PathBuilder::kArcApproximationMagic * alignment *
-                               dir;
-
-        auto arc_points = CubicPathComponent(start_offset, start_handle,
-                                             middle_handle, middle)
-                              .CreatePolyline(scale);
-
-        VS::PerVertexData vtx;
-        for (const auto& point : arc_points) {
-          vtx.position = position + point * dir;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point * dir).Reflect(middle_normal);
-          vtx_builder.AppendVertex(vtx);
-        }
-      };
-      break;
+    Scalar dir = AppendBevelAndGetDirection(writer, position, start_offset,
+                                            end_offset);
+
+    Point middle =
+        (start_offset + end_offset).Normalize() * start_offset.GetLength();
+    Point middle_normal = middle.Normalize();
+
+    Point middle_handle = middle + Point(-middle.y, middle.x) *
+                                       PathBuilder::kArcApproximationMagic *
+                                       alignment * dir;
+    Point start_handle =
+        start_offset + Point(start_offset.y, -start_offset.x) *
+                           PathBuilder::kArcApproximationMagic * alignment *
+                           dir;
+
+    auto& arc_points = writer.GetArcPoints();
+    arc_points.clear();
+    CubicPathComponent(start_offset, start_handle, middle_handle, middle)
+        .FillPointsForPolyline(arc_points, scale);
+
+    for (const auto& point : arc_points) {
+      writer.AppendVertex(position + point * dir);
+      writer.AppendVertex(position + (-point * dir).Reflect(middle_normal));
+    }
   }
-  return join_proc;
 }
 
-// static
-StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
-  using VS = SolidFillVertexShader;
-  StrokePathGeometry::CapProc cap_proc;
-  switch (stroke_cap) {
-    case Cap::kButt:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-        VS::PerVertexData vtx;
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
-    case Cap::kRound:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-
-        VS::PerVertexData vtx;
-
-        Point forward(offset.y, -offset.x);
-        Point forward_normal = forward.Normalize();
-
-        CubicPathComponent arc;
-        if (reverse) {
-          arc = CubicPathComponent(
-              forward,
-              forward + orientation * PathBuilder::kArcApproximationMagic,
-              orientation + forward * PathBuilder::kArcApproximationMagic,
-              orientation);
-        } else {
-          arc = CubicPathComponent(
-              orientation,
-              orientation + forward * PathBuilder::kArcApproximationMagic,
-              forward + orientation * PathBuilder::kArcApproximationMagic,
-              forward);
-        }
+template <Cap kCap>
+void AppendCap(StrokeVertexWriter& writer,
+               const Point& position,
+               const Point& offset,
+               Scalar scale,
+               bool reverse) {
+  Point orientation = offset * (reverse ? -1 : 1);
+  if constexpr (kCap == Cap::kButt) {
+    writer.AppendVertex(position + orientation);
+    writer.AppendVertex(position - orientation);
+  } else if constexpr (kCap == Cap::kRound) {
+    Point forward(offset.y, -offset.x);
+    Point forward_normal = forward.Normalize();
+
+    CubicPathComponent arc;
+    if (reverse) {
+      arc = CubicPathComponent(
+          forward, forward + orientation * PathBuilder::kArcApproximationMagic,
+          orientation + forward * PathBuilder::kArcApproximationMagic,
+          orientation);
+    } else {
+      arc = CubicPathComponent(
+          orientation,
+          orientation + forward * PathBuilder::kArcApproximationMagic,
+          forward + orientation * PathBuilder::kArcApproximationMagic, forward);
+    }
 
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-        for (const auto& point : arc.CreatePolyline(scale)) {
-          vtx.position = position + point;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point).Reflect(forward_normal);
-          vtx_builder.AppendVertex(vtx);
-        }
-      };
-      break;
-    case Cap::kSquare:
-      cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                    const Point& position, const Point& offset, Scalar scale,
-                    bool reverse) {
-        Point orientation = offset * (reverse ? -1 : 1);
-
-        VS::PerVertexData vtx;
-
-        Point forward(offset.y, -offset.x);
-
-        vtx.position = position + orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position + orientation + forward;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = position - orientation + forward;
-        vtx_builder.AppendVertex(vtx);
-      };
-      break;
+    writer.AppendVertex(position + orientation);
+    writer.AppendVertex(position - orientation);
+
+    auto& arc_points = writer.GetArcPoints();
+    arc_points.clear();
+    arc.FillPointsForPolyline(arc_points, scale);
+    for (const auto& point : arc_points) {
+      writer.AppendVertex(position + point);
+      writer.AppendVertex(position + (-point).Reflect(forward_normal));
+    }
+  } else {
+    static_assert(kCap == Cap::kSquare);
+    Point forward(offset.y, -offset.x);
+
+    writer.AppendVertex(position + orientation);
+    writer.AppendVertex(position - orientation);
+    writer.AppendVertex(position + orientation + forward);
+    writer.AppendVertex(position - orientation + forward);
   }
-  return cap_proc;
 }
 
-// static
-VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-StrokePathGeometry::CreateSolidStrokeVertices(
-    const Path& path,
-    Scalar stroke_width,
-    Scalar scaled_miter_limit,
-    const StrokePathGeometry::JoinProc& join_proc,
-    const StrokePathGeometry::CapProc& cap_proc,
-    Scalar scale) {
-  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto polyline = path.CreatePolyline(scale);
-
-  VS::PerVertexData vtx;
-
+/// Generates the triangle strip of a stroke. Every combination of join and
+/// cap is instantiated separately so that the per-point work has no indirect
+/// calls.
+template <Join kJoin, Cap kCap>
+void AppendStrokeVertices(StrokeVertexWriter& writer,
+                          const Path::Polyline& polyline,
+                          Scalar stroke_width,
+                          Scalar scaled_miter_limit,
+                          Scalar scale) {
   // Offset state.
   Point offset;
   Point previous_offset;  // Used for computing joins.
@@ -252,7 +221,7 @@ StrokePathGeometry::CreateSolidStrokeVertices(
 
   for (size_t contour_i = 0; contour_i < polyline.contours.size();
        contour_i++) {
-    auto contour = polyline.contours[contour_i];
+    const auto& contour = polyline.contours[contour_i];
     size_t contour_component_i = 0;
     size_t contour_start_point_i, contour_end_point_i;
     std::tie(contour_start_point_i, contour_end_point_i) =
@@ -261,8 +230,8 @@ StrokePathGeometry::CreateSolidStrokeVertices(
     switch (contour_end_point_i - contour_start_point_i) {
       case 1: {
         Point p = polyline.points[contour_start_point_i];
-        cap_proc(vtx_builder, p, {-stroke_width * 0.5f, 0}, scale, false);
-        cap_proc(vtx_builder, p, {stroke_width * 0.5f, 0}, scale, false);
+        AppendCap<kCap>(writer, p, {-stroke_width * 0.5f, 0}, scale, false);
+        AppendCap<kCap>(writer, p, {stroke_width * 0.5f, 0}, scale, false);
         continue;
       }
       case 0:
@@ -283,59 +252,53 @@ StrokePathGeometry::CreateSolidStrokeVertices(
       // vertices at the start of the new contour (thus connecting the two
       // contours with two zero volume triangles, which will be discarded by
       // the rasterizer).
-      vtx.position = polyline.points[contour_start_point_i - 1];
       // Append two vertices when "picking up" the pen so that the triangle
       // drawn when moving to the beginning of the new contour will have zero
       // volume.
-      vtx_builder.AppendVertex(vtx);
-      vtx_builder.AppendVertex(vtx);
+      writer.AppendVertex(polyline.points[contour_start_point_i - 1]);
+      writer.AppendVertex(polyline.points[contour_start_point_i - 1]);
 
-      vtx.position = polyline.points[contour_start_point_i];
       // Append two vertices at the beginning of the new contour, which
       // appends  two triangles of zero area.
-      vtx_builder.AppendVertex(vtx);
-      vtx_builder.AppendVertex(vtx);
+      writer.AppendVertex(polyline.points[contour_start_point_i]);
+      writer.AppendVertex(polyline.points[contour_start_point_i]);
     }
 
     // Generate start cap.
-    if (!polyline.contours[contour_i].is_closed) {
+    if (!contour.is_closed) {
       auto cap_offset =
           Vector2(-contour.start_direction.y, contour.start_direction.x) *
           stroke_width * 0.5;  // Counterclockwise normal
-      cap_proc(vtx_builder, polyline.points[contour_start_point_i], cap_offset,
-               scale, true);
+      AppendCap<kCap>(writer, polyline.points[contour_start_point_i],
+                      cap_offset, scale, true);
     }
 
     // Generate contour geometry.
     for (size_t point_i = contour_start_point_i + 1;
          point_i < contour_end_point_i; point_i++) {
-      if ((contour_component_i + 1 >= contour.components.size()) &&
+      if ((contour_component_i + 1 < contour.components.size()) &&
           contour.components[contour_component_i + 1].component_start_index <=
               point_i) {
         // The point_i has entered the next component in this contour.
         contour_component_i += 1;
       }
       // Generate line rect.
-      vtx.position = polyline.points[point_i - 1] + offset;
-      vtx_builder.AppendVertex(vtx);
-      vtx.position = polyline.points[point_i - 1] - offset;
-      vtx_builder.AppendVertex(vtx);
+      writer.AppendVertex(polyline.points[point_i - 1] + offset);
+      writer.AppendVertex(polyline.points[point_i - 1] - offset);
 
       auto is_end_of_contour = point_i == contour_end_point_i - 1;
 
       if (!contour.components[contour_component_i].is_curve) {
         // For line components, two additional points need to be appended prior
         // to appending a join connecting the next component.
-        vtx.position = polyline.points[point_i] + offset;
-        vtx_builder.AppendVertex(vtx);
-        vtx.position = polyline.points[point_i] - offset;
-        vtx_builder.AppendVertex(vtx);
+        writer.AppendVertex(polyline.points[point_i] + offset);
+        writer.AppendVertex(polyline.points[point_i] - offset);
 
         if (!is_end_of_contour) {
           compute_offset(point_i + 1);
           // Generate join from the current line to the next line.
-          join_proc(vtx_builder, polyline.points[point_i], previous_offset,
-                    offset, scaled_miter_limit, scale);
+          AppendJoin<kJoin>(writer, polyline.points[point_i], previous_offset,
+                            offset, scaled_miter_limit, scale);
         }
       } else {
         // For curve components, the polyline is detailed enough such that
@@ -348,10 +311,10 @@ StrokePathGeometry::CreateSolidStrokeVertices(
           auto end_offset =
               Vector2(-contour.end_direction.y, contour.end_direction.x) *
               stroke_width * 0.5;
-          vtx.position = polyline.points[contour_end_point_i - 1] + end_offset;
-          vtx_builder.AppendVertex(vtx);
-          vtx.position = polyline.points[contour_end_point_i - 1] - end_offset;
-          vtx_builder.AppendVertex(vtx);
+          writer.AppendVertex(polyline.points[contour_end_point_i - 1] +
+                              end_offset);
+          writer.AppendVertex(polyline.points[contour_end_point_i - 1] -
+                              end_offset);
         }
       }
     }
@@ -361,15 +324,248 @@ StrokePathGeometry::CreateSolidStrokeVertices(
       auto cap_offset =
           Vector2(-contour.end_direction.y, contour.end_direction.x) *
           stroke_width * 0.5;  // Clockwise normal
-      cap_proc(vtx_builder, polyline.points[contour_end_point_i - 1],
-               cap_offset, scale, false);
+      AppendCap<kCap>(writer, polyline.points[contour_end_point_i - 1],
+                      cap_offset, scale, false);
     } else {
-      join_proc(vtx_builder, polyline.points[contour_start_point_i], offset,
-                contour_first_offset, scaled_miter_limit, scale);
+      AppendJoin<kJoin>(writer, polyline.points[contour_start_point_i], offset,
+                        contour_first_offset, scaled_miter_limit, scale);
+    }
+  }
+}
+
+using StrokeVertexProc = void (*)(StrokeVertexWriter& writer,
+                                  const Path::Polyline& polyline,
+                                  Scalar stroke_width,
+                                  Scalar scaled_miter_limit,
+                                  Scalar scale);
+
+template <Join kJoin>
+StrokeVertexProc GetStrokeVertexProc(Cap stroke_cap) {
+  switch (stroke_cap) {
+    case Cap::kButt:
+      return &AppendStrokeVertices<kJoin, Cap::kButt>;
+    case Cap::kRound:
+      return &AppendStrokeVertices<kJoin, Cap::kRound>;
+    case Cap::kSquare:
+      return &AppendStrokeVertices<kJoin, Cap::kSquare>;
+  }
+  FML_UNREACHABLE();
+}
+
+StrokeVertexProc GetStrokeVertexProc(Join stroke_join, Cap stroke_cap) {
+  switch (stroke_join) {
+    case Join::kBevel:
+      return GetStrokeVertexProc<Join::kBevel>(stroke_cap);
+    case Join::kMiter:
+      return GetStrokeVertexProc<Join::kMiter>(stroke_cap);
+    case Join::kRound:
+      return GetStrokeVertexProc<Join::kRound>(stroke_cap);
+  }
+  FML_UNREACHABLE();
+}
+
+/// The number of points in the arc of a round join or cap, which is at most a
+/// quarter circle.
+size_t GetMaxArcPointCount(Scalar stroke_width, Scalar scale) {
+  Point orientation(stroke_width * 0.5f, 0);
+  Point forward(0, -stroke_width * 0.5f);
+  std::vector<Point> arc_points;
+  CubicPathComponent(
+      orientation, orientation + forward * PathBuilder::kArcApproximationMagic,
+      forward + orientation * PathBuilder::kArcApproximationMagic, forward)
+      .FillPointsForPolyline(arc_points, scale);
+  return arc_points.size();
+}
+
+/// Writes the stroke into `vertices`, which has room for `capacity` vertices.
+///
+/// @return The number of vertices of the stroke, which is larger than
+///         `capacity` if they didn't fit.
+size_t WriteStrokeVertices(Point* vertices,
+                           size_t capacity,
+                           const Path::Polyline& polyline,
+                           Scalar stroke_width,
+                           Scalar scaled_miter_limit,
+                           Join stroke_join,
+                           Cap stroke_cap,
+                           Scalar scale) {
+  StrokeVertexWriter writer(vertices, capacity);
+  GetStrokeVertexProc(stroke_join, stroke_cap)(
+      writer, polyline, stroke_width, scaled_miter_limit, scale);
+  return writer.GetVertexCount();
+}
+
+}  // namespace
+
+// static
+size_t StrokePathGeometry::GetMaxSolidStrokeVertexCount(
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    Join stroke_join,
+    Cap stroke_cap,
+    Scalar scale) {
+  size_t arc_point_count = 0u;
+  if (stroke_join == Join::kRound || stroke_cap == Cap::kRound) {
+    arc_point_count = GetMaxArcPointCount(stroke_width, scale);
+  }
+
+  size_t cap_count = 0u;
+  switch (stroke_cap) {
+    case Cap::kButt:
+      cap_count = 2u;
+      break;
+    case Cap::kRound:
+      cap_count = 2u + arc_point_count * 2u;
+      break;
+    case Cap::kSquare:
+      cap_count = 4u;
+      break;
+  }
+  size_t join_count = 0u;
+  switch (stroke_join) {
+    case Join::kBevel:
+      join_count = 3u;
+      break;
+    case Join::kMiter:
+      join_count = 4u;
+      break;
+    case Join::kRound:
+      join_count = 3u + arc_point_count * 2u;
+      break;
+  }
+  // Every point after the first one of a contour adds two corners of its
+  // segment. Points on lines add the other two corners and a join, points on
+  // curves add at most the two end points of the curve.
+  const size_t line_point_count = 4u + join_count;
+  const size_t curve_point_count = 4u;
+
+  size_t vertex_count = 0u;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    const auto& contour = polyline.contours[contour_i];
+    auto [start, end] = polyline.GetContourPointBounds(contour_i);
+    if (end == start) {
+      continue;
+    }
+    // The vertices that join the contour to the previous one, the caps at
+    // either end or around a single point, and the closing join.
+    vertex_count += 4u + cap_count * 2u + std::max(cap_count, join_count);
+
+    size_t component_i = 0;
+    for (size_t point_i = start + 1; point_i < end; point_i++) {
+      if (component_i + 1 < contour.components.size() &&
+          contour.components[component_i + 1].component_start_index <=
+              point_i) {
+        component_i++;
+      }
+      vertex_count += contour.components[component_i].is_curve
+                          ? curve_point_count
+                          : line_point_count;
+    }
+  }
+  return vertex_count;
+}
+
+// static
+std::vector<Point> StrokePathGeometry::GenerateSolidStrokeVertices(
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    Scalar scaled_miter_limit,
+    Join stroke_join,
+    Cap stroke_cap,
+    Scalar scale) {
+  std::vector<Point> vertices(GetMaxSolidStrokeVertexCount(
+      polyline, stroke_width, stroke_join, stroke_cap, scale));
+  auto vertex_count = WriteStrokeVertices(
+      vertices.data(), vertices.size(), polyline, stroke_width,
+      scaled_miter_limit, stroke_join, stroke_cap, scale);
+  if (vertex_count > vertices.size()) {
+    vertices.resize(vertex_count);
+    WriteStrokeVertices(vertices.data(), vertices.size(), polyline,
+                        stroke_width, scaled_miter_limit, stroke_join,
+                        stroke_cap, scale);
+  }
+  vertices.resize(vertex_count);
+  return vertices;
+}
+
+// |Geometry|
+void StrokePathGeometry::Prefetch(const Matrix& transform,
+                                  fml::ConcurrentTaskRunner& task_runner) {
+  if (stroke_width_ < 0.0 ||
+      path_.GetComponentCount() < kMinPrefetchComponentCount) {
+    return;
+  }
+  auto determinant = transform.GetDeterminant();
+  if (determinant == 0) {
+    return;
+  }
+  // The stroke only depends on the scale of the transformation and on the
+  // minimum width it implies, which translating the entity doesn't change.
+  Scalar min_size = 1.0f / sqrt(std::abs(determinant));
+  Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar scale = transform.GetMaxBasisLength();
+  stroke_prefetch_ =
+      std::make_unique<GeometryPrefetch<StrokeKey, std::vector<Point>>>(
+          StrokeKey{scale, stroke_width}, task_runner,
+          [this, scale, stroke_width]() {
+            return GenerateSolidStrokeVertices(
+                path_.CreatePolyline(scale), stroke_width,
+                miter_limit_ * stroke_width_ * 0.5f, stroke_join_,
+                stroke_cap_, scale);
+          });
+}
+
+VertexBuffer StrokePathGeometry::CreateSolidStrokeVertexBuffer(
+    HostBuffer& host_buffer,
+    Scalar stroke_width,
+    Scalar scale) {
+  if (stroke_prefetch_) {
+    if (const auto* vertices =
+            stroke_prefetch_->Get(StrokeKey{scale, stroke_width})) {
+      if (vertices->empty()) {
+        return {};
+      }
+      return VertexBuffer{
+          .vertex_buffer = host_buffer.Emplace(
+              vertices->data(), vertices->size() * sizeof(Point),
+              alignof(Point)),
+          .vertex_count = vertices->size(),
+          .index_type = IndexType::kNone,
+      };
     }
   }
 
-  return vtx_builder;
+  auto polyline = path_.CreatePolyline(scale);
+  auto scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f;
+  auto capacity = GetMaxSolidStrokeVertexCount(
+      polyline, stroke_width, stroke_join_, stroke_cap_, scale);
+  if (capacity == 0u) {
+    return {};
+  }
+
+  // The vertices are written straight into the host buffer. The capacity is a
+  // conservative estimate, so the slow path that measures the stroke first is
+  // only a safety net.
+  size_t vertex_count = 0u;
+  auto vertex_buffer_view = host_buffer.Emplace(
+      capacity * sizeof(Point), alignof(Point), [&](uint8_t* contents) {
+        vertex_count = WriteStrokeVertices(
+            reinterpret_cast<Point*>(contents), capacity, polyline,
+            stroke_width, scaled_miter_limit, stroke_join_, stroke_cap_, scale);
+      });
+  if (vertex_count > capacity) {
+    auto vertices =
+        GenerateSolidStrokeVertices(polyline, stroke_width, scaled_miter_limit,
+                                    stroke_join_, stroke_cap_, scale);
+    vertex_buffer_view = host_buffer.Emplace(
+        vertices.data(), vertices.size() * sizeof(Point), alignof(Point));
+  }
+  return VertexBuffer{
+      .vertex_buffer = vertex_buffer_view,
+      .vertex_count = vertex_count,
+      .index_type = IndexType::kNone,
+  };
 }
 
 GeometryResult StrokePathGeometry::GetPositionBuffer(
@@ -387,15 +583,11 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
-
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
+      .vertex_buffer = CreateSolidStrokeVertexBuffer(
+          pass.GetTransientsBuffer(), stroke_width,
+          entity.GetTransformation().GetMaxBasisLength()),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = true,
@@ -419,17 +611,49 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto stroke_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
-  auto vertex_builder = ComputeUVGeometryCPU(
-      stroke_builder, {0, 0}, texture_coverage.size, effect_transform);
+  using VS = TextureFillVertexShader;
+
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  std::vector<Point> generated;
+  const std::vector<Point>* prefetched =
+      stroke_prefetch_ ? stroke_prefetch_->Get(StrokeKey{scale, stroke_width})
+                       : nullptr;
+  if (!prefetched) {
+    generated = GenerateSolidStrokeVertices(
+        path_.CreatePolyline(scale), stroke_width,
+        miter_limit_ * stroke_width_ * 0.5f, stroke_join_, stroke_cap_, scale);
+  }
+  const auto& positions = prefetched ? *prefetched : generated;
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = pass.GetTransientsBuffer().Emplace(
+      positions.size() * sizeof(VS::PerVertexData),
+      alignof(VS::PerVertexData), [&](uint8_t* contents) {
+        auto* vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+        // Folding the division by the coverage size into the transform lets
+        // the texture coordinates be computed in batches.
+        const Matrix uv_transform =
+            Matrix::MakeScale(Vector2(1.0f / texture_coverage.size.width,
+                                      1.0f / texture_coverage.size.height)) *
+            effect_transform;
+        constexpr size_t kBatchSize = 64;
+        Point texture_coords[kBatchSize];
+        for (size_t i = 0; i < positions.size(); i += kBatchSize) {
+          const size_t count = std::min(kBatchSize, positions.size() - i);
+          uv_transform.TransformPoints(&positions[i], texture_coords, count);
+          for (size_t j = 0; j < count; j++) {
+            vertices->position = positions[i + j];
+            vertices->texture_coords = texture_coords[j];
+            vertices++;
+          }
+        }
+      });
+  vertex_buffer.vertex_count = positions.size();
+  vertex_buffer.index_type = IndexType::kNone;
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
+      .vertex_buffer = vertex_buffer,
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = true,
@@ -4,7 +4,12 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/geometry_prefetch.h"
 
 namespace impeller {
 
@@ -27,23 +32,33 @@ class StrokePathGeometry : public Geometry {
 
   Join GetStrokeJoin() const;
 
- private:
-  using VS = SolidFillVertexShader;
-
-  using CapProc =
-      std::function<void(VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                         const Point& position,
-                         const Point& offset,
-                         Scalar scale,
-                         bool reverse)>;
-  using JoinProc =
-      std::function<void(VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
-                         const Point& position,
-                         const Point& start_offset,
-                         const Point& end_offset,
-                         Scalar miter_limit,
-                         Scalar scale)>;
+  // |Geometry|
+  void Prefetch(const Matrix& transform,
+                fml::ConcurrentTaskRunner& task_runner) override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns an upper bound of the number of vertices in the
+  ///             triangle strip of a stroke of `polyline`, which is used to
+  ///             size the stroke's buffer before it is generated.
+  ///
+  static size_t GetMaxSolidStrokeVertexCount(const Path::Polyline& polyline,
+                                             Scalar stroke_width,
+                                             Join stroke_join,
+                                             Cap stroke_cap,
+                                             Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Generates the triangle strip of a stroke of `polyline`.
+  ///
+  static std::vector<Point> GenerateSolidStrokeVertices(
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      Scalar scaled_miter_limit,
+      Join stroke_join,
+      Cap stroke_cap,
+      Scalar scale);
 
+ private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
@@ -64,29 +79,21 @@ class StrokePathGeometry : public Geometry {
 
   bool SkipRendering() const;
 
-  static Scalar CreateBevelAndGetDirection(
-      VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
-      const Point& position,
-      const Point& start_offset,
-      const Point& end_offset);
-
-  static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-  CreateSolidStrokeVertices(const Path& path,
-                            Scalar stroke_width,
-                            Scalar scaled_miter_limit,
-                            const JoinProc& join_proc,
-                            const CapProc& cap_proc,
-                            Scalar scale);
-
-  static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
+  VertexBuffer CreateSolidStrokeVertexBuffer(HostBuffer& host_buffer,
+                                             Scalar stroke_width,
+                                             Scalar scale);
 
-  static StrokePathGeometry::CapProc GetCapProc(Cap stroke_cap);
+  // The scale and the stroke width the stroke was generated for.
+  using StrokeKey = std::pair<Scalar, Scalar>;
 
   Path path_;
   Scalar stroke_width_;
   Scalar miter_limit_;
   Cap stroke_cap_;
   Join stroke_join_;
+  // Reads the members above, so it must be destroyed first.
+  std::unique_ptr<GeometryPrefetch<StrokeKey, std::vector<Point>>>
+      stroke_prefetch_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(StrokePathGeometry);
 };
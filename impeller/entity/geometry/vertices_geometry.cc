@@ -4,6 +4,7 @@
 
 #include "impeller/entity/geometry/vertices_geometry.h"
 
+#include <algorithm>
 #include <utility>
 
 #include <utility>
@@ -110,44 +111,51 @@ std::optional<Rect> VerticesGeometry::GetTextureCoordinateCoverge() const {
                                texture_coordinates_.end());
 }
 
-GeometryResult VerticesGeometry::GetPositionBuffer(
+std::shared_ptr<DeviceBuffer> VerticesGeometry::Upload(
     const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) {
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
+    const uint8_t* vertex_data,
+    size_t vertex_bytes) const {
+  size_t index_bytes = indices_.size() * sizeof(uint16_t);
 
   DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
+  buffer_desc.size = vertex_bytes + index_bytes;
   buffer_desc.storage_mode = StorageMode::kHostVisible;
 
   auto buffer =
       renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return nullptr;
+  }
 
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<const uint8_t*>(vertices_.data()),
-          Range{0, total_vtx_bytes}, 0)) {
-    return {};
+  if (!buffer->CopyHostBuffer(vertex_data, Range{0, vertex_bytes}, 0)) {
+    return nullptr;
   }
-  if (index_count > 0 &&
+  if (index_bytes > 0 &&
       !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+          reinterpret_cast<const uint8_t*>(indices_.data()),
+          Range{0, index_bytes}, vertex_bytes)) {
+    return nullptr;
   }
+  return buffer;
+}
+
+GeometryResult VerticesGeometry::MakeResult(
+    std::shared_ptr<DeviceBuffer> buffer,
+    size_t vertex_bytes,
+    const Entity& entity,
+    const RenderPass& pass) const {
+  auto index_count = indices_.size();
+  auto vertex_count = vertices_.size();
+  size_t index_bytes = index_count * sizeof(uint16_t);
 
   return GeometryResult{
       .type = GetPrimitiveType(),
       .vertex_buffer =
           {
               .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
+                                .range = Range{0, vertex_bytes}},
               .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
+                               .range = Range{vertex_bytes, index_bytes}},
               .vertex_count = index_count > 0 ? index_count : vertex_count,
               .index_type =
                   index_count > 0 ? IndexType::k16bit : IndexType::kNone,
@@ -158,63 +166,50 @@ GeometryResult VerticesGeometry::GetPositionBuffer(
   };
 }
 
-GeometryResult VerticesGeometry::GetPositionColorBuffer(
+GeometryResult VerticesGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
-  using VS = GeometryColorPipeline::VertexShader;
+  size_t total_vtx_bytes = vertices_.size() * sizeof(float) * 2;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
-
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0u; i < vertex_count; i++) {
-      vertex_data[i] = {
-          .position = vertices_[i],
-          .color = colors_[i],
-      };
+  if (!position_buffer_) {
+    position_buffer_ =
+        Upload(renderer, reinterpret_cast<const uint8_t*>(vertices_.data()),
+               total_vtx_bytes);
+    if (!position_buffer_) {
+      return {};
     }
   }
+  return MakeResult(position_buffer_, total_vtx_bytes, entity, pass);
+}
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+GeometryResult VerticesGeometry::GetPositionColorBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  using VS = GeometryColorPipeline::VertexShader;
 
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+  auto vertex_count = vertices_.size();
+  size_t total_vtx_bytes = vertex_count * sizeof(VS::PerVertexData);
+
+  if (!position_color_buffer_) {
+    std::vector<VS::PerVertexData> vertex_data(vertex_count);
+    {
+      for (auto i = 0u; i < vertex_count; i++) {
+        vertex_data[i] = {
+            .position = vertices_[i],
+            .color = colors_[i],
+        };
+      }
+    }
+    position_color_buffer_ =
+        Upload(renderer, reinterpret_cast<const uint8_t*>(vertex_data.data()),
+               total_vtx_bytes);
+    if (!position_color_buffer_) {
+      return {};
+    }
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  return MakeResult(position_color_buffer_, total_vtx_bytes, entity, pass);
 }
 
 GeometryResult VerticesGeometry::GetPositionUVBuffer(
@@ -225,69 +220,55 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = indices_.size();
   auto vertex_count = vertices_.size();
+  size_t total_vtx_bytes = vertex_count * sizeof(VS::PerVertexData);
+
+  if (position_uv_buffer_ &&
+      position_uv_texture_coverage_ == texture_coverage &&
+      position_uv_effect_transform_ == effect_transform) {
+    return MakeResult(position_uv_buffer_, total_vtx_bytes, entity, pass);
+  }
+
   auto size = texture_coverage.size;
   auto origin = texture_coverage.origin;
   auto has_texture_coordinates = HasTextureCoordinates();
   std::vector<VS::PerVertexData> vertex_data(vertex_count);
   {
-    for (auto i = 0u; i < vertex_count; i++) {
-      auto vertex = vertices_[i];
-      auto texture_coord =
-          has_texture_coordinates ? texture_coordinates_[i] : vertices_[i];
-      auto uv =
-          effect_transform * Point((texture_coord.x - origin.x) / size.width,
-                                   (texture_coord.y - origin.y) / size.height);
-      // From experimentation we need to clamp these values to < 1.0 or else
-      // there can be flickering.
-      vertex_data[i] = {
-          .position = vertex,
-          .texture_coords =
-              Point(std::clamp(uv.x, 0.0f, 1.0f - kEhCloseEnough),
-                    std::clamp(uv.y, 0.0f, 1.0f - kEhCloseEnough)),
-      };
+    // Mapping the coordinates into the texture coverage is folded into the
+    // transform so that they can be transformed in batches.
+    const Matrix uv_transform =
+        effect_transform *
+        Matrix::MakeScale(Vector2(1.0f / size.width, 1.0f / size.height)) *
+        Matrix::MakeTranslation(Vector3(-origin.x, -origin.y, 0.0f));
+    const auto& texture_coords =
+        has_texture_coordinates ? texture_coordinates_ : vertices_;
+    constexpr size_t kBatchSize = 64;
+    Point uvs[kBatchSize];
+    for (size_t i = 0; i < vertex_count; i += kBatchSize) {
+      const size_t count = std::min(kBatchSize, vertex_count - i);
+      uv_transform.TransformPoints(&texture_coords[i], uvs, count);
+      for (size_t j = 0; j < count; j++) {
+        // From experimentation we need to clamp these values to < 1.0 or else
+        // there can be flickering.
+        vertex_data[i + j] = {
+            .position = vertices_[i + j],
+            .texture_coords =
+                Point(std::clamp(uvs[j].x, 0.0f, 1.0f - kEhCloseEnough),
+                      std::clamp(uvs[j].y, 0.0f, 1.0f - kEhCloseEnough)),
+        };
+      }
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0u &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
+  position_uv_buffer_ =
+      Upload(renderer, reinterpret_cast<const uint8_t*>(vertex_data.data()),
+             total_vtx_bytes);
+  if (!position_uv_buffer_) {
     return {};
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  position_uv_texture_coverage_ = texture_coverage;
+  position_uv_effect_transform_ = effect_transform;
+  return MakeResult(position_uv_buffer_, total_vtx_bytes, entity, pass);
 }
 
 GeometryVertexType VerticesGeometry::GetVertexType() const {
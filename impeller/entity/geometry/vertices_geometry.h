@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "impeller/core/device_buffer.h"
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -59,6 +60,16 @@ class VerticesGeometry : public Geometry {
 
   PrimitiveType GetPrimitiveType() const;
 
+  // Uploads the vertex data followed by the indices into a new buffer.
+  std::shared_ptr<DeviceBuffer> Upload(const ContentContext& renderer,
+                                       const uint8_t* vertex_data,
+                                       size_t vertex_bytes) const;
+
+  GeometryResult MakeResult(std::shared_ptr<DeviceBuffer> buffer,
+                            size_t vertex_bytes,
+                            const Entity& entity,
+                            const RenderPass& pass) const;
+
   std::vector<Point> vertices_;
   std::vector<Color> colors_;
   std::vector<Point> texture_coordinates_;
@@ -66,6 +77,18 @@ class VerticesGeometry : public Geometry {
   Rect bounds_;
   VerticesGeometry::VertexMode vertex_mode_ =
       VerticesGeometry::VertexMode::kTriangles;
+
+  // The vertex data is only uploaded on the first draw of each kind, and
+  // later draws of the geometry, such as those of a cached picture, bind
+  // the same buffers. The data is never written again, so the GPU may still
+  // be reading it from an earlier frame.
+  std::shared_ptr<DeviceBuffer> position_buffer_;
+  std::shared_ptr<DeviceBuffer> position_color_buffer_;
+  // The texture coordinates depend on the texture coverage and effect
+  // transform they were computed for.
+  std::shared_ptr<DeviceBuffer> position_uv_buffer_;
+  Rect position_uv_texture_coverage_;
+  Matrix position_uv_effect_transform_;
 };
 
 }  // namespace impeller
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_texture_cache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+GradientTextureCache::GradientTextureCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+GradientTextureCache::~GradientTextureCache() = default;
+
+size_t GradientTextureCache::Hash(const std::vector<Color>& colors,
+                                  const std::vector<Scalar>& stops) {
+  size_t hash = fml::HashCombine(colors.size(), stops.size());
+  for (const auto& color : colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (auto stop : stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+std::shared_ptr<Texture> GradientTextureCache::GetOrCreate(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  const size_t hash = Hash(colors, stops);
+
+  auto [begin, end] = index_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    auto entry = it->second;
+    if (entry->colors == colors && entry->stops == stops) {
+      entries_.splice(entries_.begin(), entries_, entry);
+      hit_count_++;
+      return entry->texture;
+    }
+  }
+  miss_count_++;
+
+  TRACE_EVENT0("impeller", "GradientTextureCache::CreateTexture");
+  auto gradient_data = CreateGradientBuffer(colors, stops);
+  auto texture = CreateGradientTexture(gradient_data, context);
+  if (!texture) {
+    return nullptr;
+  }
+
+  const size_t bytes = gradient_data.color_bytes.size();
+  if (bytes > max_bytes_) {
+    return texture;
+  }
+
+  Evict(max_bytes_ - bytes);
+  entries_.push_front(Entry{
+      .hash = hash,
+      .colors = colors,
+      .stops = stops,
+      .texture = texture,
+      .bytes = bytes,
+  });
+  index_.emplace(hash, entries_.begin());
+  cached_bytes_ += bytes;
+  return texture;
+}
+
+void GradientTextureCache::Evict(size_t max_bytes) {
+  while (cached_bytes_ > max_bytes && !entries_.empty()) {
+    auto entry = std::prev(entries_.end());
+    auto [begin, end] = index_.equal_range(entry->hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == entry) {
+        index_.erase(it);
+        break;
+      }
+    }
+    cached_bytes_ -= entry->bytes;
+    entries_.erase(entry);
+    eviction_count_++;
+  }
+}
+
+GradientTextureCache::Stats GradientTextureCache::GetStats() const {
+  return Stats{
+      .entry_count = entries_.size(),
+      .cached_bytes = cached_bytes_,
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .eviction_count = eviction_count_,
+  };
+}
+
+}  // namespace impeller
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+class Context;
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the color ramp textures of gradients across entities
+///             and frames.
+///
+///             Entries are found by a hash of the colors and stops of the
+///             gradient, so gradients that are recreated every frame with the
+///             same colors share one texture. The ramps are never written to
+///             once created, so a texture can be handed out while earlier
+///             frames are still reading from it.
+///
+///             The least recently used entries are discarded once the cached
+///             textures take up more than `max_bytes`.
+///
+class GradientTextureCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 1u * 1024u * 1024u;
+
+  struct Stats {
+    size_t entry_count = 0u;
+    size_t cached_bytes = 0u;
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+    size_t eviction_count = 0u;
+  };
+
+  explicit GradientTextureCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~GradientTextureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the ramp texture of the gradient with the given
+  ///             colors and stops, creating it if it isn't cached yet.
+  ///
+  /// @return     The texture, or nullptr if it could not be created.
+  ///
+  std::shared_ptr<Texture> GetOrCreate(const std::vector<Color>& colors,
+                                       const std::vector<Scalar>& stops,
+                                       const std::shared_ptr<Context>& context);
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    size_t hash = 0u;
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+    std::shared_ptr<Texture> texture;
+    size_t bytes = 0u;
+  };
+
+  const size_t max_bytes_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+  size_t cached_bytes_ = 0u;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t eviction_count_ = 0u;
+
+  static size_t Hash(const std::vector<Color>& colors,
+                     const std::vector<Scalar>& stops);
+
+  void Evict(size_t max_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientTextureCache);
+};
+
+}  // namespace impeller
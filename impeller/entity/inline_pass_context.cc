@@ -15,11 +15,12 @@
 namespace impeller {
 
 InlinePassContext::InlinePassContext(
-    std::shared_ptr<Context> context,
+    const ContentContext& renderer,
     EntityPassTarget& pass_target,
     uint32_t pass_texture_reads,
     std::optional<RenderPassResult> collapsed_parent_pass)
-    : context_(std::move(context)),
+    : renderer_(renderer),
+      context_(renderer.GetContext()),
       pass_target_(pass_target),
       total_pass_reads_(pass_texture_reads),
       is_collapsed_(collapsed_parent_pass.has_value()) {
@@ -55,7 +56,7 @@ bool InlinePassContext::EndPass() {
   }
 
   if (command_buffer_) {
-    if (!command_buffer_->SubmitCommandsAsync(std::move(pass_))) {
+    if (!renderer_.SubmitRenderPass(command_buffer_, std::move(pass_))) {
       VALIDATION_LOG
           << "Failed to encode and submit command buffer while ending "
              "render pass.";
@@ -65,6 +66,9 @@ bool InlinePassContext::EndPass() {
 
   pass_ = nullptr;
   command_buffer_ = nullptr;
+  pass_backdrop_texture_ = nullptr;
+  draw_coverages_.clear();
+  draws_unbounded_ = false;
 
   return true;
 }
@@ -151,6 +155,14 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
                               : StoreAction::kStore;
   pass_target_.target_.SetStencilAttachment(stencil.value());
 
+  // The depth shares its texture with the stencil when it is present.
+  if (auto depth = pass_target_.GetRenderTarget().GetDepthAttachment();
+      depth.has_value()) {
+    depth->load_action = stencil->load_action;
+    depth->store_action = stencil->store_action;
+    pass_target_.target_.SetDepthAttachment(depth.value());
+  }
+
   pass_target_.target_.SetColorAttachment(color0, 0);
 
   pass_ = command_buffer_->CreateRenderPass(pass_target_.GetRenderTarget());
@@ -165,6 +177,14 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
 
   result.pass = pass_;
 
+  // The first pass clears the target, so there are no contents to read until
+  // it has ended.
+  if (pass_count_ > 0) {
+    pass_backdrop_texture_ =
+        is_msaa ? result.backdrop_texture
+                : pass_target_.GetRenderTarget().GetRenderTargetTexture();
+  }
+
   if (!context_->GetCapabilities()->SupportsReadFromResolve() &&
       result.backdrop_texture ==
           result.pass->GetRenderTarget().GetRenderTargetTexture()) {
@@ -176,6 +196,34 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
   return result;
 }
 
+std::shared_ptr<Texture> InlinePassContext::GetUnmodifiedBackdropTexture(
+    const Rect& coverage) const {
+  if (!IsActive() || is_collapsed_ || draws_unbounded_) {
+    return nullptr;
+  }
+  for (const auto& draw_coverage : draw_coverages_) {
+    if (draw_coverage.IntersectsWithRect(coverage)) {
+      return nullptr;
+    }
+  }
+  return pass_backdrop_texture_;
+}
+
+void InlinePassContext::RecordDrawCoverage(std::optional<Rect> coverage) {
+  if (!coverage.has_value()) {
+    draws_unbounded_ = true;
+    return;
+  }
+  if (draw_coverages_.size() == kMaxDrawCoverages) {
+    auto bounds = draw_coverages_.front();
+    for (const auto& draw_coverage : draw_coverages_) {
+      bounds = bounds.Union(draw_coverage);
+    }
+    draw_coverages_ = {bounds};
+  }
+  draw_coverages_.push_back(coverage.value());
+}
+
 uint32_t InlinePassContext::GetPassCount() const {
   return pass_count_;
 }
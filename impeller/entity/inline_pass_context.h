@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
+#include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity_pass_target.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
@@ -19,7 +23,7 @@ class InlinePassContext {
   };
 
   InlinePassContext(
-      std::shared_ptr<Context> context,
+      const ContentContext& renderer,
       EntityPassTarget& pass_target,
       uint32_t pass_texture_reads,
       std::optional<RenderPassResult> collapsed_parent_pass = std::nullopt);
@@ -34,7 +38,28 @@ class InlinePassContext {
 
   RenderPassResult GetRenderPass(uint32_t pass_depth);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a texture with the contents that the active pass
+  ///             started from, if nothing drawn to the active pass so far
+  ///             intersects `coverage`. Within `coverage`, the texture then
+  ///             holds the same contents as it would after ending the pass,
+  ///             so it can be read from there without ending the pass.
+  ///
+  /// @return     The texture, or nullptr if the pass needs to be ended first.
+  ///
+  std::shared_ptr<Texture> GetUnmodifiedBackdropTexture(
+      const Rect& coverage) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the active pass draws to `coverage`, or to the
+  ///             whole pass target if it's std::nullopt.
+  ///
+  void RecordDrawCoverage(std::optional<Rect> coverage);
+
  private:
+  static constexpr size_t kMaxDrawCoverages = 32u;
+
+  const ContentContext& renderer_;
   std::shared_ptr<Context> context_;
   EntityPassTarget& pass_target_;
   std::shared_ptr<CommandBuffer> command_buffer_;
@@ -43,6 +68,11 @@ class InlinePassContext {
   uint32_t total_pass_reads_ = 0;
   // Whether this context is collapsed into a parent entity pass.
   bool is_collapsed_ = false;
+  // The texture that holds the contents the active pass started from, and
+  // the coverage of everything drawn to the active pass since.
+  std::shared_ptr<Texture> pass_backdrop_texture_;
+  std::vector<Rect> draw_coverages_;
+  bool draws_unbounded_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(InlinePassContext);
 };
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_pass_encoding_queue.h"
+
+#include <utility>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+struct RenderPassEncodingQueue::PendingSubmission {
+  std::shared_ptr<CommandBuffer> command_buffer;
+  std::shared_ptr<RenderPass> render_pass;
+  fml::CountDownLatch encoded_latch{1};
+  bool encoded = false;
+};
+
+RenderPassEncodingQueue::RenderPassEncodingQueue(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)) {}
+
+RenderPassEncodingQueue::~RenderPassEncodingQueue() {
+  Flush();
+}
+
+void RenderPassEncodingQueue::SetTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  Flush();
+  task_runner_ = std::move(task_runner);
+}
+
+bool RenderPassEncodingQueue::Submit(
+    std::shared_ptr<CommandBuffer> command_buffer,
+    std::shared_ptr<RenderPass> render_pass) {
+  if (!command_buffer || !render_pass || !render_pass->IsValid() ||
+      !command_buffer->IsValid()) {
+    return false;
+  }
+
+  if (!task_runner_) {
+    return command_buffer->SubmitCommandsAsync(std::move(render_pass));
+  }
+
+  auto submission = std::make_shared<PendingSubmission>();
+  submission->command_buffer = std::move(command_buffer);
+  submission->render_pass = std::move(render_pass);
+  pending_.push_back(submission);
+  task_runner_->PostTask([submission]() {
+    TRACE_EVENT0("impeller", "RenderPassEncodingQueue::Encode");
+    submission->encoded = submission->render_pass->EncodeCommands();
+    submission->encoded_latch.CountDown();
+  });
+  return true;
+}
+
+bool RenderPassEncodingQueue::Flush() {
+  if (pending_.empty()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", "RenderPassEncodingQueue::Flush");
+  bool result = true;
+  while (!pending_.empty()) {
+    auto submission = std::move(pending_.front());
+    pending_.pop_front();
+    submission->encoded_latch.Wait();
+    // The passes that follow may sample the texture of this one, but they
+    // are still submitted rather than being encoded and dropped.
+    if (!submission->encoded) {
+      VALIDATION_LOG << "Failed to encode a queued render pass.";
+      result = false;
+      continue;
+    }
+    if (!submission->command_buffer->SubmitCommands()) {
+      VALIDATION_LOG << "Failed to submit a queued render pass.";
+      result = false;
+    }
+  }
+  return result;
+}
+
+size_t RenderPassEncodingQueue::GetPendingCount() const {
+  return pending_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes render passes on a concurrent task runner while
+///             submitting their command buffers in the order in which the
+///             passes were handed to the queue.
+///
+///             Entity passes end the render passes of their subpasses before
+///             the passes that sample the subpass textures, so the order in
+///             which passes are ended is an order in which the passes can be
+///             submitted. Encoding a pass only translates its recorded
+///             commands into backend commands, so the passes ended from one
+///             frame can be encoded concurrently as long as they are
+///             submitted in that order. Submitting in order is deferred until
+///             `Flush` is called.
+///
+///             The backend must support encoding render passes that target
+///             different textures concurrently. Without a task runner, passes
+///             are submitted as they are handed to the queue.
+///
+class RenderPassEncodingQueue {
+ public:
+  explicit RenderPassEncodingQueue(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner = nullptr);
+
+  ~RenderPassEncodingQueue();
+
+  void SetTaskRunner(std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the render pass and submits the command buffer it was
+  ///             created from, after all of the passes submitted before it.
+  ///
+  /// @return     Whether the pass was valid. Failures to encode the pass are
+  ///             reported by the `Flush` that submits it.
+  ///
+  bool Submit(std::shared_ptr<CommandBuffer> command_buffer,
+              std::shared_ptr<RenderPass> render_pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits for the pending passes to be encoded and submits them
+  ///             in order.
+  ///
+  /// @return     Whether all of the pending passes were encoded and
+  ///             submitted.
+  ///
+  bool Flush();
+
+  size_t GetPendingCount() const;
+
+ private:
+  struct PendingSubmission;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner_;
+  std::deque<std::shared_ptr<PendingSubmission>> pending_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderPassEncodingQueue);
+};
+
+}  // namespace impeller
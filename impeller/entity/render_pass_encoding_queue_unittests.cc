@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"
+#include "impeller/entity/render_pass_encoding_queue.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace {
+
+struct EncodingLog {
+  std::mutex mutex;
+  std::vector<int> encoded;
+  std::vector<std::thread::id> encoding_threads;
+  std::vector<int> submitted;
+};
+
+class TestRenderPass : public RenderPass {
+ public:
+  TestRenderPass(const std::shared_ptr<Context>& context,
+                 int id,
+                 EncodingLog& log,
+                 bool encodes = true)
+      : RenderPass(context, RenderTarget()),
+        id_(id),
+        log_(log),
+        encodes_(encodes) {}
+
+  bool IsValid() const override { return true; }
+
+ private:
+  const int id_;
+  EncodingLog& log_;
+  const bool encodes_;
+
+  void OnSetLabel(std::string label) override {}
+
+  bool OnEncodeCommands(const Context& context) const override {
+    std::scoped_lock lock(log_.mutex);
+    log_.encoded.push_back(id_);
+    log_.encoding_threads.push_back(std::this_thread::get_id());
+    return encodes_;
+  }
+};
+
+std::shared_ptr<MockCommandBuffer> MakeCommandBuffer(
+    const std::shared_ptr<Context>& context,
+    int id,
+    EncodingLog& log) {
+  auto command_buffer = std::make_shared<MockCommandBuffer>(context);
+  ON_CALL(*command_buffer, IsValid).WillByDefault(Return(true));
+  ON_CALL(*command_buffer, OnSubmitCommands(_))
+      .WillByDefault([id, &log](CommandBuffer::CompletionCallback callback) {
+        log.submitted.push_back(id);
+        return true;
+      });
+  return command_buffer;
+}
+
+}  // namespace
+
+TEST(RenderPassEncodingQueueTest, SubmitsImmediatelyWithoutATaskRunner) {
+  auto context = std::make_shared<MockImpellerContext>();
+  EncodingLog log;
+  RenderPassEncodingQueue queue;
+
+  ASSERT_TRUE(queue.Submit(MakeCommandBuffer(context, 0, log),
+                           std::make_shared<TestRenderPass>(context, 0, log)));
+  EXPECT_EQ(queue.GetPendingCount(), 0u);
+  EXPECT_EQ(log.encoded, std::vector<int>{0});
+  EXPECT_EQ(log.submitted, std::vector<int>{0});
+  EXPECT_EQ(log.encoding_threads[0], std::this_thread::get_id());
+}
+
+TEST(RenderPassEncodingQueueTest, EncodesConcurrentlyAndSubmitsInOrder) {
+  auto context = std::make_shared<MockImpellerContext>();
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  EncodingLog log;
+  RenderPassEncodingQueue queue(loop->GetTaskRunner());
+
+  constexpr int kPassCount = 16;
+  for (int i = 0; i < kPassCount; i++) {
+    ASSERT_TRUE(
+        queue.Submit(MakeCommandBuffer(context, i, log),
+                     std::make_shared<TestRenderPass>(context, i, log)));
+  }
+  EXPECT_EQ(queue.GetPendingCount(), static_cast<size_t>(kPassCount));
+  EXPECT_TRUE(log.submitted.empty());
+
+  ASSERT_TRUE(queue.Flush());
+  EXPECT_EQ(queue.GetPendingCount(), 0u);
+  std::vector<int> expected;
+  for (int i = 0; i < kPassCount; i++) {
+    expected.push_back(i);
+  }
+  EXPECT_EQ(log.submitted, expected);
+  ASSERT_EQ(log.encoding_threads.size(), static_cast<size_t>(kPassCount));
+  for (const auto& thread : log.encoding_threads) {
+    EXPECT_NE(thread, std::this_thread::get_id());
+  }
+}
+
+TEST(RenderPassEncodingQueueTest, FailedPassesAreNotSubmitted) {
+  auto context = std::make_shared<MockImpellerContext>();
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  EncodingLog log;
+  RenderPassEncodingQueue queue(loop->GetTaskRunner());
+
+  ASSERT_TRUE(queue.Submit(MakeCommandBuffer(context, 0, log),
+                           std::make_shared<TestRenderPass>(context, 0, log)));
+  ASSERT_TRUE(queue.Submit(
+      MakeCommandBuffer(context, 1, log),
+      std::make_shared<TestRenderPass>(context, 1, log, /*encodes=*/false)));
+  ASSERT_TRUE(queue.Submit(MakeCommandBuffer(context, 2, log),
+                           std::make_shared<TestRenderPass>(context, 2, log)));
+
+  EXPECT_FALSE(queue.Flush());
+  EXPECT_EQ(log.submitted, (std::vector<int>{0, 2}));
+}
+
+TEST(RenderPassEncodingQueueTest, ChangingTheTaskRunnerFlushes) {
+  auto context = std::make_shared<MockImpellerContext>();
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  EncodingLog log;
+  RenderPassEncodingQueue queue(loop->GetTaskRunner());
+
+  ASSERT_TRUE(queue.Submit(MakeCommandBuffer(context, 0, log),
+                           std::make_shared<TestRenderPass>(context, 0, log)));
+  queue.SetTaskRunner(nullptr);
+  EXPECT_EQ(log.submitted, std::vector<int>{0});
+
+  ASSERT_TRUE(queue.Submit(MakeCommandBuffer(context, 1, log),
+                           std::make_shared<TestRenderPass>(context, 1, log)));
+  EXPECT_EQ(log.submitted, (std::vector<int>{0, 1}));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -3,12 +3,28 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_counters.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+namespace {
+size_t GetTextureBytes(const Texture& texture) {
+  const auto& desc = texture.GetTextureDescriptor();
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+}  // namespace
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_unused_bytes,
+                                     uint32_t max_unused_frames)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_unused_bytes_(max_unused_bytes),
+      max_unused_frames_(max_unused_frames) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : texture_data_) {
@@ -18,12 +34,51 @@ void RenderTargetCache::Start() {
 
 void RenderTargetCache::End() {
   std::vector<TextureData> retain;
+  size_t unused_bytes = 0u;
+  const bool under_memory_pressure = GetAllocator()->IsUnderMemoryPressure();
 
-  for (const auto& td : texture_data_) {
+  for (auto& td : texture_data_) {
     if (td.used_this_frame) {
+      td.unused_frames = 0u;
       retain.push_back(td);
+      continue;
+    }
+    td.unused_frames++;
+    if (td.unused_frames > max_unused_frames_ || under_memory_pressure) {
+      eviction_count_++;
+      continue;
     }
+    unused_bytes += GetTextureBytes(*td.texture);
+    retain.push_back(td);
   }
+
+  if (unused_bytes > max_unused_bytes_) {
+    // Discard the textures that went unused for the longest first. The sort is
+    // stable so that textures unused for as long are discarded oldest first.
+    std::vector<size_t> unused;
+    for (size_t i = 0; i < retain.size(); i++) {
+      if (!retain[i].used_this_frame) {
+        unused.push_back(i);
+      }
+    }
+    std::stable_sort(unused.begin(), unused.end(), [&retain](auto a, auto b) {
+      return retain[a].unused_frames > retain[b].unused_frames;
+    });
+    for (auto index : unused) {
+      if (unused_bytes <= max_unused_bytes_) {
+        break;
+      }
+      unused_bytes -= GetTextureBytes(*retain[index].texture);
+      retain[index].texture = nullptr;
+      eviction_count_++;
+    }
+    retain.erase(std::remove_if(retain.begin(), retain.end(),
+                                [](const TextureData& td) {
+                                  return td.texture == nullptr;
+                                }),
+                 retain.end());
+  }
+
   texture_data_.swap(retain);
 }
 
@@ -31,6 +86,22 @@ size_t RenderTargetCache::CachedTextureCount() const {
   return texture_data_.size();
 }
 
+RenderTargetCache::Stats RenderTargetCache::GetStats() const {
+  Stats stats;
+  stats.cached_texture_count = texture_data_.size();
+  for (const auto& td : texture_data_) {
+    const size_t bytes = GetTextureBytes(*td.texture);
+    stats.cached_bytes += bytes;
+    if (!td.used_this_frame) {
+      stats.unused_bytes += bytes;
+    }
+  }
+  stats.hit_count = hit_count_;
+  stats.miss_count = miss_count_;
+  stats.eviction_count = eviction_count_;
+  return stats;
+}
+
 std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
     const TextureDescriptor& desc) {
   FML_DCHECK(desc.storage_mode != StorageMode::kHostVisible);
@@ -42,6 +113,8 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
     FML_DCHECK(td.texture != nullptr);
     if (!td.used_this_frame && desc == other_desc) {
       td.used_this_frame = true;
+      hit_count_++;
+      FML_PERFORMANCE_COUNTER_ADD("renderTargetCache.hits", 1);
       return td.texture;
     }
   }
@@ -49,6 +122,8 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
   if (result == nullptr) {
     return result;
   }
+  miss_count_++;
+  FML_PERFORMANCE_COUNTER_ADD("renderTargetCache.misses", 1);
   texture_data_.push_back(
       TextureData{.used_this_frame = true, .texture = result});
   return result;
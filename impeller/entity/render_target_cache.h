@@ -9,12 +9,36 @@
 namespace impeller {
 
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
-///        allocated texture data for one frame.
+///        allocated texture data across frames.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures unused during a frame are kept for up to
+///        `max_unused_frames` frames, as long as the textures that went
+///        unused take up no more than `max_unused_bytes`. Past the budget, the
+///        textures that went unused for the longest are discarded first.
+///
+///        While the allocator reports memory pressure, textures that went
+///        unused during a frame are discarded at the end of it.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  static constexpr size_t kDefaultMaxUnusedBytes = 32u * 1024u * 1024u;
+  static constexpr uint32_t kDefaultMaxUnusedFrames = 3u;
+
+  struct Stats {
+    size_t cached_texture_count = 0u;
+    size_t cached_bytes = 0u;
+    size_t unused_bytes = 0u;
+    /// Textures handed out from the cache since the cache was created.
+    size_t hit_count = 0u;
+    /// Textures that had to be allocated since the cache was created.
+    size_t miss_count = 0u;
+    /// Unused textures discarded since the cache was created.
+    size_t eviction_count = 0u;
+  };
+
+  explicit RenderTargetCache(
+      std::shared_ptr<Allocator> allocator,
+      size_t max_unused_bytes = kDefaultMaxUnusedBytes,
+      uint32_t max_unused_frames = kDefaultMaxUnusedFrames);
 
   ~RenderTargetCache() = default;
 
@@ -28,16 +52,24 @@ class RenderTargetCache : public RenderTargetAllocator {
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
 
+  Stats GetStats() const;
+
   // visible for testing.
   size_t CachedTextureCount() const;
 
  private:
   struct TextureData {
     bool used_this_frame;
+    uint32_t unused_frames = 0u;
     std::shared_ptr<Texture> texture;
   };
 
+  const size_t max_unused_bytes_;
+  const uint32_t max_unused_frames_;
   std::vector<TextureData> texture_data_;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t eviction_count_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
 };
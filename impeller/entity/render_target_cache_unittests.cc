@@ -39,12 +39,19 @@ class TestAllocator : public Allocator {
     return std::make_shared<MockTexture>(desc);
   };
 
+  bool IsUnderMemoryPressure() const override {
+    return under_memory_pressure;
+  }
+
   bool should_fail = false;
+  bool under_memory_pressure = false;
 };
 
 TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   auto allocator = std::make_shared<TestAllocator>();
-  auto render_target_cache = RenderTargetCache(allocator);
+  auto render_target_cache =
+      RenderTargetCache(allocator, RenderTargetCache::kDefaultMaxUnusedBytes,
+                        /*max_unused_frames=*/0u);
   auto desc = TextureDescriptor{
       .format = PixelFormat::kR8G8B8A8UNormInt,
       .size = ISize(100, 100),
@@ -85,5 +92,103 @@ TEST(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
 }
 
+TEST(RenderTargetCacheTest, KeepsUnusedTexturesForAFewFrames) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, RenderTargetCache::kDefaultMaxUnusedBytes,
+                        /*max_unused_frames=*/2u);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+
+  // A frame that doesn't need the texture doesn't discard it...
+  render_target_cache.Start();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  // ...so it is still there when it is needed again.
+  render_target_cache.Start();
+  ASSERT_EQ(render_target_cache.CreateTexture(desc), texture);
+  render_target_cache.End();
+
+  for (int i = 0; i < 3; i++) {
+    render_target_cache.Start();
+    render_target_cache.End();
+  }
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+
+  auto stats = render_target_cache.GetStats();
+  EXPECT_EQ(stats.hit_count, 1u);
+  EXPECT_EQ(stats.miss_count, 1u);
+  EXPECT_EQ(stats.eviction_count, 1u);
+}
+
+TEST(RenderTargetCacheTest, DiscardsLongestUnusedTexturesPastTheBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto small = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(10, 10),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+  auto large = small;
+  large.size = ISize(20, 20);
+  // Room for one large texture or a few small ones.
+  auto render_target_cache =
+      RenderTargetCache(allocator, large.GetByteSizeOfBaseMipLevel(),
+                        /*max_unused_frames=*/10u);
+
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(large);
+  render_target_cache.End();
+
+  render_target_cache.Start();
+  auto small_texture = render_target_cache.CreateTexture(small);
+  render_target_cache.End();
+
+  auto stats = render_target_cache.GetStats();
+  EXPECT_EQ(stats.cached_texture_count, 2u);
+  EXPECT_EQ(stats.unused_bytes, large.GetByteSizeOfBaseMipLevel());
+
+  // Both textures are unused now. The large one went unused for longer.
+  render_target_cache.Start();
+  render_target_cache.End();
+  stats = render_target_cache.GetStats();
+  EXPECT_EQ(stats.cached_texture_count, 1u);
+  EXPECT_EQ(stats.cached_bytes, small.GetByteSizeOfBaseMipLevel());
+  EXPECT_EQ(stats.eviction_count, 1u);
+
+  render_target_cache.Start();
+  EXPECT_EQ(render_target_cache.CreateTexture(small), small_texture);
+  render_target_cache.End();
+}
+
+TEST(RenderTargetCacheTest, DiscardsUnusedTexturesUnderMemoryPressure) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, RenderTargetCache::kDefaultMaxUnusedBytes,
+                        /*max_unused_frames=*/10u);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+
+  // Used textures are kept, but unused ones no longer wait out their frames.
+  allocator->under_memory_pressure = true;
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  EXPECT_EQ(render_target_cache.GetStats().eviction_count, 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
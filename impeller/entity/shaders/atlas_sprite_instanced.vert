@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/conversions.glsl>
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  vec2 texture_size;
+  float texture_sampler_y_coord_scale;
+  float16_t alpha;
+}
+frame_info;
+
+struct SpriteInstance {
+  // XYWH.
+  vec4 texture_rect;
+  // The x and y basis vectors of the sprite transform.
+  vec4 basis;
+  // The translation of the sprite transform in xy.
+  vec4 translation;
+  // Premultiplied. Unused by this shader.
+  vec4 color;
+};
+
+layout(std140) readonly buffer SpriteInfo {
+  SpriteInstance sprites[];
+}
+sprite_info;
+
+// The corner of the unit quad shared by all sprite instances.
+in vec2 unit_position;
+
+out vec2 v_texture_coords;
+IMPELLER_MAYBE_FLAT out float16_t v_alpha;
+
+void main() {
+  SpriteInstance sprite = sprite_info.sprites[gl_InstanceIndex];
+
+  // Identical to texture_fill.vert, except that the sprite quad is built from
+  // the instance data instead of being transformed on the CPU.
+  vec2 local_position = unit_position * sprite.texture_rect.zw;
+  vec2 position = sprite.basis.xy * local_position.x +
+                  sprite.basis.zw * local_position.y + sprite.translation.xy;
+
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  v_alpha = frame_info.alpha;
+  v_texture_coords = IPRemapCoords(
+      (sprite.texture_rect.xy + local_position) / frame_info.texture_size,
+      frame_info.texture_sampler_y_coord_scale);
+}
@@ -19,6 +19,7 @@ const float16_t kBT601FullRange = 1.0hf;
 uniform FragInfo {
   mat4 matrix;
   float16_t yuv_color_space;
+  float16_t alpha;
 }
 frag_info;
 
@@ -35,5 +36,6 @@ void main() {
 
   yuv.x = texture(y_texture, v_texture_coords).r;
   yuv.yz = texture(uv_texture, v_texture_coords).rg;
-  frag_color = f16mat4(frag_info.matrix) * f16vec4(yuv - yuv_offset, 1.0hf);
+  frag_color = f16mat4(frag_info.matrix) * f16vec4(yuv - yuv_offset, 1.0hf) *
+               frag_info.alpha;
 }
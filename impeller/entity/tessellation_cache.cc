@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr Scalar kScaleStepsPerOctave = 4.0f;
+
+}  // namespace
+
+TessellationCache::TessellationCache(std::shared_ptr<Allocator> allocator,
+                                     std::shared_ptr<Tessellator> tessellator,
+                                     size_t max_bytes)
+    : allocator_(std::move(allocator)),
+      tessellator_(std::move(tessellator)),
+      max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+Scalar TessellationCache::QuantizeScale(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return scale;
+  }
+  return std::exp2(std::ceil(std::log2(scale) * kScaleStepsPerOctave) /
+                   kScaleStepsPerOctave);
+}
+
+std::optional<VertexBuffer> TessellationCache::GetOrTessellate(
+    const Path& path,
+    Scalar scale,
+    HostBuffer& host_buffer) {
+  scale = QuantizeScale(scale);
+  const size_t hash = fml::HashCombine(path.GetContentHash(), scale);
+
+  auto [begin, end] = index_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    auto entry = it->second;
+    if (entry->scale == scale && entry->path.HasSameContents(path)) {
+      entries_.splice(entries_.begin(), entries_, entry);
+      hit_count_++;
+      return entry->vertex_buffer;
+    }
+  }
+  miss_count_++;
+
+  TRACE_EVENT0("impeller", "TessellationCache::Tessellate");
+  VertexBuffer vertex_buffer;
+  std::shared_ptr<DeviceBuffer> device_buffer;
+  auto result = tessellator_->Tessellate(
+      path.GetFillType(), path.CreatePolyline(scale),
+      [&](const float* vertices, size_t vertices_count,
+          const uint16_t* indices, size_t indices_count) {
+        const size_t vertices_length = vertices_count * sizeof(float);
+        const size_t indices_length = indices_count * sizeof(uint16_t);
+        const size_t length = vertices_length + indices_length;
+        if (length > 0u && length <= max_bytes_) {
+          // The vertices are followed by the indices, which need no padding
+          // as floats are at least as aligned as 16 bit indices.
+          std::vector<uint8_t> data(length);
+          std::memcpy(data.data(), vertices, vertices_length);
+          std::memcpy(data.data() + vertices_length, indices, indices_length);
+          device_buffer =
+              allocator_->CreateBufferWithCopy(data.data(), data.size());
+        }
+        if (device_buffer) {
+          vertex_buffer.vertex_buffer = device_buffer->AsBufferView();
+          vertex_buffer.vertex_buffer.range = Range{0u, vertices_length};
+          vertex_buffer.index_buffer = device_buffer->AsBufferView();
+          vertex_buffer.index_buffer.range =
+              Range{vertices_length, indices_length};
+        } else {
+          vertex_buffer.vertex_buffer = host_buffer.Emplace(
+              vertices, vertices_length, alignof(float));
+          vertex_buffer.index_buffer = host_buffer.Emplace(
+              indices, indices_length, alignof(uint16_t));
+        }
+        vertex_buffer.vertex_count = indices_count;
+        vertex_buffer.index_type = IndexType::k16bit;
+        return true;
+      });
+  if (result != Tessellator::Result::kSuccess) {
+    return std::nullopt;
+  }
+  if (!device_buffer) {
+    return vertex_buffer;
+  }
+
+  const size_t bytes = device_buffer->GetDeviceBufferDescriptor().size;
+  Evict(max_bytes_ - bytes);
+  entries_.push_front(Entry{
+      .hash = hash,
+      .scale = scale,
+      .path = path,
+      .vertex_buffer = vertex_buffer,
+      .bytes = bytes,
+  });
+  index_.emplace(hash, entries_.begin());
+  cached_bytes_ += bytes;
+  return vertex_buffer;
+}
+
+void TessellationCache::Evict(size_t max_bytes) {
+  while (cached_bytes_ > max_bytes && !entries_.empty()) {
+    auto entry = std::prev(entries_.end());
+    auto [begin, end] = index_.equal_range(entry->hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == entry) {
+        index_.erase(it);
+        break;
+      }
+    }
+    cached_bytes_ -= entry->bytes;
+    entries_.erase(entry);
+    eviction_count_++;
+  }
+}
+
+TessellationCache::Stats TessellationCache::GetStats() const {
+  return Stats{
+      .entry_count = entries_.size(),
+      .cached_bytes = cached_bytes_,
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .eviction_count = eviction_count_,
+  };
+}
+
+}  // namespace impeller
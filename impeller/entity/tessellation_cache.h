@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the triangles of filled paths in device buffers across
+///             frames.
+///
+///             Paths are converted anew every frame, so entries are found by
+///             the content hash of the path, which includes its fill type,
+///             together with the tessellation scale. The scale is quantized
+///             up to a quarter of an octave so that small changes in scale
+///             still hit the cache, at the price of slightly finer polylines.
+///
+///             The least recently used entries are discarded once the cached
+///             buffers take up more than `max_bytes`.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  struct Stats {
+    size_t entry_count = 0u;
+    size_t cached_bytes = 0u;
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+    size_t eviction_count = 0u;
+  };
+
+  TessellationCache(std::shared_ptr<Allocator> allocator,
+                    std::shared_ptr<Tessellator> tessellator,
+                    size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale that paths drawn at `scale` are tessellated at.
+  ///
+  static Scalar QuantizeScale(Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the triangles that fill `path` when drawn at `scale`,
+  ///             tessellating the path if they aren't cached yet.
+  ///
+  ///             Results that can't be cached, such as those larger than the
+  ///             whole budget, are written to `host_buffer` instead.
+  ///
+  /// @return     The vertex buffer, or std::nullopt if the path could not be
+  ///             tessellated.
+  ///
+  std::optional<VertexBuffer> GetOrTessellate(const Path& path,
+                                              Scalar scale,
+                                              HostBuffer& host_buffer);
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    size_t hash = 0u;
+    Scalar scale = 0.0;
+    Path path;
+    VertexBuffer vertex_buffer;
+    size_t bytes = 0u;
+  };
+
+  const std::shared_ptr<Allocator> allocator_;
+  const std::shared_ptr<Tessellator> tessellator_;
+  const size_t max_bytes_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+  size_t cached_bytes_ = 0u;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t eviction_count_ = 0u;
+
+  void Evict(size_t max_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
@@ -16,6 +16,9 @@ namespace {
 Path CreateCubic();
 /// Similar to the path above, but with all cubics replaced by quadratics.
 Path CreateQuadratic();
+/// A grid of circles and rounded rectangles, which are made of nothing but
+/// cubics, like the icons of a typical UI.
+Path CreateCubicHeavy();
 }  // namespace
 
 static Tessellator tess;
@@ -43,10 +46,111 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+// Flattens the path into the same polyline on every iteration, so that the
+// flattening isn't measured together with the allocation of the points.
+static void BM_PolylineReused(benchmark::State& state,
+                              const Path& path,
+                              Scalar scale) {
+  Path::Polyline polyline;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    path.CreatePolyline(scale, polyline);
+    single_point_count = polyline.points.size();
+    benchmark::DoNotOptimize(polyline.points.data());
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+}
+
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
+BENCHMARK_CAPTURE(BM_Polyline, cubic_heavy_polyline, CreateCubicHeavy(), false);
+BENCHMARK_CAPTURE(BM_PolylineReused,
+                  cubic_heavy_polyline_reused,
+                  CreateCubicHeavy(),
+                  1.0f);
+BENCHMARK_CAPTURE(BM_PolylineReused,
+                  cubic_heavy_polyline_reused_scaled,
+                  CreateCubicHeavy(),
+                  4.0f);
+BENCHMARK_CAPTURE(BM_PolylineReused,
+                  cubic_polyline_reused,
+                  CreateCubic(),
+                  1.0f);
+
+// A rotation of a translated layer, and a 2D projection like the ones of a
+// page turn, which divide by a w that varies across the points.
+static const Matrix kAffineMatrix = Matrix::MakeTranslation({10, 20, 0}) *
+                                    Matrix::MakeRotationZ(Radians(0.5f));
+// clang-format off
+static const Matrix kPerspectiveMatrix = Matrix{
+    1.0f,  0.0f,  0.0f, 0.001f,
+    0.0f,  1.0f,  0.0f, 0.002f,
+    0.0f,  0.0f,  1.0f, 0.0f,
+    10.0f, 20.0f, 0.0f, 1.0f};
+// clang-format on
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  Matrix a = kAffineMatrix;
+  Matrix b = Matrix::MakePerspective(Radians(1.0f), 1.5f, 1, 100);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    benchmark::DoNotOptimize(a * b);
+  }
+}
+BENCHMARK(BM_MatrixMultiply);
+
+static void BM_MatrixInvert(benchmark::State& state, Matrix matrix) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    benchmark::DoNotOptimize(matrix.Invert());
+  }
+}
+BENCHMARK_CAPTURE(BM_MatrixInvert, affine, kAffineMatrix);
+BENCHMARK_CAPTURE(BM_MatrixInvert, perspective, kPerspectiveMatrix);
+
+// Transforms the points of a flattened path, as when computing the bounds or
+// the texture coordinates of its vertices.
+static void BM_TransformPoints(benchmark::State& state,
+                               Matrix matrix,
+                               bool batched) {
+  auto polyline = CreateCubicHeavy().CreatePolyline(1.0f);
+  const std::vector<Point>& points = polyline.points;
+  std::vector<Point> result(points.size());
+  for (auto _ : state) {
+    if (batched) {
+      matrix.TransformPoints(points.data(), result.data(), points.size());
+    } else {
+      for (size_t i = 0; i < points.size(); i++) {
+        result[i] = matrix * points[i];
+      }
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.counters["PointCount"] = points.size();
+}
+BENCHMARK_CAPTURE(BM_TransformPoints, affine_scalar, kAffineMatrix, false);
+BENCHMARK_CAPTURE(BM_TransformPoints, affine_batched, kAffineMatrix, true);
+BENCHMARK_CAPTURE(BM_TransformPoints,
+                  perspective_scalar,
+                  kPerspectiveMatrix,
+                  false);
+BENCHMARK_CAPTURE(BM_TransformPoints,
+                  perspective_batched,
+                  kPerspectiveMatrix,
+                  true);
+
+static void BM_TransformBounds(benchmark::State& state) {
+  Rect rect = Rect::MakeLTRB(10, 20, 300, 400);
+  Matrix matrix = kAffineMatrix;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rect);
+    benchmark::DoNotOptimize(rect.TransformBounds(matrix));
+  }
+}
+BENCHMARK(BM_TransformBounds);
 
 namespace {
 Path CreateCubic() {
@@ -312,5 +416,20 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateCubicHeavy() {
+  PathBuilder builder;
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 20; j++) {
+      Point origin(i * 50.0f, j * 50.0f);
+      if ((i + j) % 2 == 0) {
+        builder.AddCircle(origin + Point(20, 20), 18);
+      } else {
+        builder.AddRoundedRect(Rect::MakeXYWH(origin.x, origin.y, 40, 24), 8);
+      }
+    }
+  }
+  return builder.TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
@@ -136,6 +136,75 @@ TEST(GeometryTest, InvertMatrix) {
   ASSERT_MATRIX_NEAR(inverted, result);
 }
 
+TEST(GeometryTest, InvertAffineMatrix) {
+  auto matrix = Matrix::MakeTranslation({10, -20, 0}) *
+                Matrix::MakeRotationZ(Radians{0.3}) *
+                Matrix::MakeScale(Vector2(2, 0.5));
+  ASSERT_TRUE(matrix.IsAffine());
+  ASSERT_MATRIX_NEAR(matrix.Invert() * matrix, Matrix());
+  ASSERT_MATRIX_NEAR(matrix * matrix.Invert(), Matrix());
+
+  // Like other singular matrices, degenerate affine matrices invert to the
+  // identity.
+  ASSERT_TRUE(Matrix::MakeScale(Vector2(0, 1)).Invert().IsIdentity());
+}
+
+TEST(GeometryTest, MatrixMultiplyMatchesScalarProduct) {
+  // clang-format off
+  Matrix a{1,  2,  3,  4,
+           5,  6,  7,  8,
+           9,  10, 11, 12,
+           13, 14, 15, 16};
+  Matrix b{0.5, -1,  2,    0,
+           3,   0.25, -2,  1,
+           -1,  4,   0.75, 2,
+           7,   -3,  1,    -0.5};
+  // clang-format on
+  Matrix product = a * b;
+  for (int column = 0; column < 4; column++) {
+    for (int row = 0; row < 4; row++) {
+      Scalar expected = a.e[0][row] * b.e[column][0] +
+                        a.e[1][row] * b.e[column][1] +
+                        a.e[2][row] * b.e[column][2] +
+                        a.e[3][row] * b.e[column][3];
+      ASSERT_EQ(product.e[column][row], expected) << column << ", " << row;
+    }
+  }
+}
+
+TEST(GeometryTest, TransformPointsMatchesPointTransforms) {
+  // clang-format off
+  Matrix perspective{1,  0,  0, 0.0625,
+                     0,  1,  0, -0.02,
+                     0,  0,  1, 0,
+                     10, 20, 0, 1};
+  // clang-format on
+  Matrix matrices[] = {
+      Matrix(),
+      Matrix::MakeTranslation({10, 20, 0}) * Matrix::MakeRotationZ(Radians{1}),
+      perspective,
+  };
+  // Not a multiple of the batch size, and including a point that the
+  // perspective matrix maps to infinity.
+  std::vector<Point> points;
+  for (int i = 0; i < 11; i++) {
+    points.emplace_back(i * 3.5f - 10, 50 - i * 7.25f);
+  }
+  points.emplace_back(-16, 0);
+  for (const Matrix& matrix : matrices) {
+    std::vector<Point> result(points.size());
+    matrix.TransformPoints(points.data(), result.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      ASSERT_EQ(result[i], matrix * points[i]) << i;
+    }
+
+    // In place.
+    std::vector<Point> in_place = points;
+    matrix.TransformPoints(in_place.data(), in_place.data(), in_place.size());
+    ASSERT_EQ(in_place, result);
+  }
+}
+
 TEST(GeometryTest, TestDecomposition) {
   auto rotated = Matrix::MakeRotationZ(Radians{kPiOver4});
 
@@ -604,6 +673,49 @@ TEST(GeometryTest, EmptyPath) {
   ASSERT_TRUE(polyline.contours.empty());
 }
 
+TEST(GeometryTest, PathContentHash) {
+  auto make_path = [](Point control, FillType fill = FillType::kNonZero) {
+    return PathBuilder{}
+        .MoveTo({10, 10})
+        .QuadraticCurveTo(control, {30, 10})
+        .LineTo({10, 10})
+        .Close()
+        .TakePath(fill);
+  };
+  auto path = make_path({20, 30});
+  auto same_path = make_path({20, 30});
+  auto other_path = make_path({20, 31});
+
+  EXPECT_EQ(path.GetContentHash(), same_path.GetContentHash());
+  EXPECT_TRUE(path.HasSameContents(same_path));
+  EXPECT_NE(path.GetContentHash(), other_path.GetContentHash());
+  EXPECT_FALSE(path.HasSameContents(other_path));
+
+  auto odd_path = make_path({20, 30}, FillType::kOdd);
+  EXPECT_FALSE(path.HasSameContents(odd_path));
+}
+
+TEST(GeometryTest, PathCopiesAreNotChangedByTheirBuilder) {
+  PathBuilder builder;
+  builder.MoveTo({0, 0}).LineTo({10, 0}).LineTo({10, 10}).Close();
+  auto copy = builder.CopyPath();
+  auto hash = copy.GetContentHash();
+
+  builder.LineTo({20, 20});
+  auto taken = builder.TakePath(FillType::kOdd);
+
+  EXPECT_EQ(copy.GetComponentCount(), 4u);
+  EXPECT_EQ(copy.GetFillType(), FillType::kNonZero);
+  EXPECT_EQ(copy.GetContentHash(), hash);
+  EXPECT_EQ(taken.GetComponentCount(), 5u);
+  EXPECT_EQ(taken.GetFillType(), FillType::kOdd);
+  EXPECT_NE(taken.GetContentHash(), hash);
+
+  auto shared = copy;
+  EXPECT_TRUE(shared.HasSameContents(copy));
+  EXPECT_EQ(shared.GetContentHash(), hash);
+}
+
 TEST(GeometryTest, SimplePath) {
   PathBuilder builder;
 
@@ -2019,6 +2131,33 @@ TEST(GeometryTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(GeometryTest, PathCreatePolylineIntoExistingPolyline) {
+  auto circle = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  auto line = PathBuilder{}.MoveTo({0, 0}).LineTo({10, 10}).TakePath();
+
+  Path::Polyline polyline;
+  circle.CreatePolyline(2.0f, polyline);
+  auto expected = circle.CreatePolyline(2.0f);
+  ASSERT_EQ(polyline.points, expected.points);
+  ASSERT_EQ(polyline.contours.size(), expected.contours.size());
+
+  // The previous contents are replaced rather than appended to.
+  line.CreatePolyline(1.0f, polyline);
+  ASSERT_EQ(polyline.points, (std::vector<Point>{{0, 0}, {10, 10}}));
+  ASSERT_EQ(polyline.contours.size(), 1u);
+}
+
+TEST(GeometryTest, CubicPathComponentPolylineMatchesItsQuadratics) {
+  CubicPathComponent cubic({10, 10}, {20, 135}, {135, 20}, {140, 140});
+  std::vector<Point> expected;
+  for (const auto& quad : cubic.ToQuadraticPathComponents(.1f)) {
+    quad.FillPointsForPolyline(expected, 3.0f);
+  }
+  ASSERT_EQ(cubic.CreatePolyline(3.0f), expected);
+  // More points than one batch of flattened parameters.
+  ASSERT_GT(expected.size(), 8u);
+}
+
 TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   PathBuilder builder;
   builder.MoveTo({10, 10});
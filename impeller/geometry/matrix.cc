@@ -7,8 +7,20 @@
 #include <climits>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMPELLER_MATRIX_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMPELLER_MATRIX_USE_NEON
+#endif
+
 namespace impeller {
 
+static_assert(sizeof(Point) == 2 * sizeof(Scalar),
+              "TransformPoints reads points as pairs of scalars.");
+
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
   /*
    *  Apply perspective.
@@ -94,7 +106,141 @@ Matrix Matrix::operator+(const Matrix& o) const {
   );
 }
 
+Matrix Matrix::Multiply(const Matrix& o) const {
+  // Each column of the product is the sum of the columns of this matrix
+  // scaled by the entries of the same column of |o|. The sums are added in
+  // the same order as the scalar version so that the results match exactly.
+  Matrix result;
+#if defined(IMPELLER_MATRIX_USE_SSE2)
+  const __m128 c0 = _mm_loadu_ps(&m[0]);
+  const __m128 c1 = _mm_loadu_ps(&m[4]);
+  const __m128 c2 = _mm_loadu_ps(&m[8]);
+  const __m128 c3 = _mm_loadu_ps(&m[12]);
+  for (int i = 0; i < 16; i += 4) {
+    __m128 column = _mm_mul_ps(c0, _mm_set1_ps(o.m[i]));
+    column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_set1_ps(o.m[i + 1])));
+    column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_set1_ps(o.m[i + 2])));
+    column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_set1_ps(o.m[i + 3])));
+    _mm_storeu_ps(&result.m[i], column);
+  }
+#elif defined(IMPELLER_MATRIX_USE_NEON)
+  const float32x4_t c0 = vld1q_f32(&m[0]);
+  const float32x4_t c1 = vld1q_f32(&m[4]);
+  const float32x4_t c2 = vld1q_f32(&m[8]);
+  const float32x4_t c3 = vld1q_f32(&m[12]);
+  for (int i = 0; i < 16; i += 4) {
+    // Multiplies and adds are kept separate, as fused multiply adds would
+    // round differently.
+    float32x4_t column = vmulq_n_f32(c0, o.m[i]);
+    column = vaddq_f32(column, vmulq_n_f32(c1, o.m[i + 1]));
+    column = vaddq_f32(column, vmulq_n_f32(c2, o.m[i + 2]));
+    column = vaddq_f32(column, vmulq_n_f32(c3, o.m[i + 3]));
+    vst1q_f32(&result.m[i], column);
+  }
+#else
+  for (int i = 0; i < 16; i += 4) {
+    for (int row = 0; row < 4; row++) {
+      result.m[i + row] = m[row] * o.m[i] + m[row + 4] * o.m[i + 1] +
+                          m[row + 8] * o.m[i + 2] + m[row + 12] * o.m[i + 3];
+    }
+  }
+#endif
+  return result;
+}
+
+void Matrix::TransformPoints(const Point* src,
+                             Point* dst,
+                             size_t count) const {
+  size_t i = 0;
+  const bool perspective = m[3] != 0 || m[7] != 0 || m[15] != 1;
+#if defined(IMPELLER_MATRIX_USE_SSE2) || defined(IMPELLER_MATRIX_USE_NEON)
+  const Scalar* in = reinterpret_cast<const Scalar*>(src);
+  Scalar* out = reinterpret_cast<Scalar*>(dst);
+#endif
+#if defined(IMPELLER_MATRIX_USE_SSE2)
+  const __m128 m0 = _mm_set1_ps(m[0]);
+  const __m128 m1 = _mm_set1_ps(m[1]);
+  const __m128 m3 = _mm_set1_ps(m[3]);
+  const __m128 m4 = _mm_set1_ps(m[4]);
+  const __m128 m5 = _mm_set1_ps(m[5]);
+  const __m128 m7 = _mm_set1_ps(m[7]);
+  const __m128 m12 = _mm_set1_ps(m[12]);
+  const __m128 m13 = _mm_set1_ps(m[13]);
+  const __m128 m15 = _mm_set1_ps(m[15]);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 a = _mm_loadu_ps(in + i * 2);
+    const __m128 b = _mm_loadu_ps(in + i * 2 + 4);
+    const __m128 xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, m0), _mm_mul_ps(ys, m4)),
+                          m12);
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, m1), _mm_mul_ps(ys, m5)),
+                          m13);
+    if (perspective) {
+      const __m128 w = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(xs, m3), _mm_mul_ps(ys, m7)), m15);
+      // Like the scalar version, points at infinity collapse to the origin.
+      const __m128 inverse_w =
+          _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), w),
+                     _mm_cmpneq_ps(w, _mm_setzero_ps()));
+      x = _mm_mul_ps(x, inverse_w);
+      y = _mm_mul_ps(y, inverse_w);
+    }
+    _mm_storeu_ps(out + i * 2, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(x, y));
+  }
+#elif defined(IMPELLER_MATRIX_USE_NEON)
+  const float32x4_t m12 = vdupq_n_f32(m[12]);
+  const float32x4_t m13 = vdupq_n_f32(m[13]);
+  const float32x4_t m15 = vdupq_n_f32(m[15]);
+  for (; i + 4 <= count; i += 4) {
+    float32x4x2_t points = vld2q_f32(in + i * 2);
+    const float32x4_t xs = points.val[0];
+    const float32x4_t ys = points.val[1];
+    float32x4_t x =
+        vaddq_f32(vaddq_f32(vmulq_n_f32(xs, m[0]), vmulq_n_f32(ys, m[4])), m12);
+    float32x4_t y =
+        vaddq_f32(vaddq_f32(vmulq_n_f32(xs, m[1]), vmulq_n_f32(ys, m[5])), m13);
+    if (perspective) {
+      const float32x4_t w = vaddq_f32(
+          vaddq_f32(vmulq_n_f32(xs, m[3]), vmulq_n_f32(ys, m[7])), m15);
+      // Like the scalar version, points at infinity collapse to the origin.
+      const uint32x4_t nonzero = vmvnq_u32(vceqzq_f32(w));
+      const float32x4_t inverse_w = vreinterpretq_f32_u32(vandq_u32(
+          vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(1.0f), w)), nonzero));
+      x = vmulq_f32(x, inverse_w);
+      y = vmulq_f32(y, inverse_w);
+    }
+    points.val[0] = x;
+    points.val[1] = y;
+    vst2q_f32(out + i * 2, points);
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = *this * src[i];
+  }
+}
+
 Matrix Matrix::Invert() const {
+  if (IsAffine()) {
+    // Only the 2x3 part of a 2D affine matrix needs to be inverted.
+    const Scalar det = m[0] * m[5] - m[1] * m[4];
+    if (det == 0) {
+      return {};
+    }
+    const Scalar inverse_det = 1.0f / det;
+    const Scalar a = m[5] * inverse_det;
+    const Scalar b = -m[1] * inverse_det;
+    const Scalar c = -m[4] * inverse_det;
+    const Scalar d = m[0] * inverse_det;
+    // clang-format off
+    return {a,    b,    0.0f, 0.0f,
+            c,    d,    0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            -(a * m[12] + c * m[13]), -(b * m[12] + d * m[13]), 0.0f, 1.0f};
+    // clang-format on
+  }
+
   Matrix tmp{
       m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
           m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
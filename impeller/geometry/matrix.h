@@ -251,27 +251,9 @@ struct Matrix {
     // clang-format on
   }
 
-  constexpr Matrix Multiply(const Matrix& o) const {
-    // clang-format off
-    return Matrix(
-        m[0] * o.m[0]  + m[4] * o.m[1]  + m[8]  * o.m[2]  + m[12] * o.m[3],
-        m[1] * o.m[0]  + m[5] * o.m[1]  + m[9]  * o.m[2]  + m[13] * o.m[3],
-        m[2] * o.m[0]  + m[6] * o.m[1]  + m[10] * o.m[2]  + m[14] * o.m[3],
-        m[3] * o.m[0]  + m[7] * o.m[1]  + m[11] * o.m[2]  + m[15] * o.m[3],
-        m[0] * o.m[4]  + m[4] * o.m[5]  + m[8]  * o.m[6]  + m[12] * o.m[7],
-        m[1] * o.m[4]  + m[5] * o.m[5]  + m[9]  * o.m[6]  + m[13] * o.m[7],
-        m[2] * o.m[4]  + m[6] * o.m[5]  + m[10] * o.m[6]  + m[14] * o.m[7],
-        m[3] * o.m[4]  + m[7] * o.m[5]  + m[11] * o.m[6]  + m[15] * o.m[7],
-        m[0] * o.m[8]  + m[4] * o.m[9]  + m[8]  * o.m[10] + m[12] * o.m[11],
-        m[1] * o.m[8]  + m[5] * o.m[9]  + m[9]  * o.m[10] + m[13] * o.m[11],
-        m[2] * o.m[8]  + m[6] * o.m[9]  + m[10] * o.m[10] + m[14] * o.m[11],
-        m[3] * o.m[8]  + m[7] * o.m[9]  + m[11] * o.m[10] + m[15] * o.m[11],
-        m[0] * o.m[12] + m[4] * o.m[13] + m[8]  * o.m[14] + m[12] * o.m[15],
-        m[1] * o.m[12] + m[5] * o.m[13] + m[9]  * o.m[14] + m[13] * o.m[15],
-        m[2] * o.m[12] + m[6] * o.m[13] + m[10] * o.m[14] + m[14] * o.m[15],
-        m[3] * o.m[12] + m[7] * o.m[13] + m[11] * o.m[14] + m[15] * o.m[15]);
-    // clang-format on
-  }
+  /// @brief  Returns `this * o`. Uses SSE2 or NEON where available, with
+  ///         the same results as the scalar products.
+  Matrix Multiply(const Matrix& o) const;
 
   constexpr Matrix Transpose() const {
     // clang-format off
@@ -284,6 +266,9 @@ struct Matrix {
     // clang-format on
   }
 
+  /// @brief  Returns the inverse of this matrix, or the identity if it isn't
+  ///         invertible. 2D affine matrices take a much shorter path than
+  ///         general 4x4 matrices.
   Matrix Invert() const;
 
   Scalar GetDeterminant() const;
@@ -428,6 +413,14 @@ struct Matrix {
     return result * w;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms |count| points from |src| into |dst| with the same
+  ///             results as `*this * src[i]`, four at a time with SSE2 or
+  ///             NEON where available. |src| and |dst| may be the same
+  ///             array.
+  ///
+  void TransformPoints(const Point* src, Point* dst, size_t count) const;
+
   constexpr Vector4 TransformDirection(const Vector4& v) const {
     return Vector4(v.x * m[0] + v.y * m[4] + v.z * m[8],
                    v.x * m[1] + v.y * m[5] + v.z * m[9],
@@ -7,16 +7,39 @@
 #include <optional>
 #include <variant>
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/geometry/path_component.h"
 
 namespace impeller {
 
-Path::Path() {
+Path::Path() : data_(std::make_shared<Data>()) {
   AddContourComponent({});
 };
 
 Path::~Path() = default;
 
+Path::Path(const Path& other) = default;
+
+Path& Path::operator=(const Path& other) = default;
+
+Path::Data::Data(const Data& other)
+    : fill(other.fill),
+      convexity(other.convexity),
+      components(other.components),
+      linears(other.linears),
+      quads(other.quads),
+      cubics(other.cubics),
+      contours(other.contours),
+      computed_bounds(other.computed_bounds) {}
+
+void Path::EnsureUniqueData() {
+  if (data_.use_count() > 1) {
+    data_ = std::make_shared<Data>(*data_);
+  } else {
+    data_->content_hash.store(0u, std::memory_order_relaxed);
+  }
+}
+
 std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
     size_t contour_index) const {
   if (contour_index >= contours.size()) {
@@ -33,55 +56,64 @@ size_t Path::GetComponentCount(std::optional<ComponentType> type) const {
   if (type.has_value()) {
     switch (type.value()) {
       case ComponentType::kLinear:
-        return linears_.size();
+        return data_->linears.size();
       case ComponentType::kQuadratic:
-        return quads_.size();
+        return data_->quads.size();
       case ComponentType::kCubic:
-        return cubics_.size();
+        return data_->cubics.size();
       case ComponentType::kContour:
-        return contours_.size();
+        return data_->contours.size();
     }
   }
-  return components_.size();
+  return data_->components.size();
 }
 
 void Path::SetFillType(FillType fill) {
-  fill_ = fill;
+  if (data_->fill == fill) {
+    return;
+  }
+  EnsureUniqueData();
+  data_->fill = fill;
 }
 
 FillType Path::GetFillType() const {
-  return fill_;
+  return data_->fill;
 }
 
 bool Path::IsConvex() const {
-  return convexity_ == Convexity::kConvex;
+  return data_->convexity == Convexity::kConvex;
 }
 
 void Path::SetConvexity(Convexity value) {
-  convexity_ = value;
+  if (data_->convexity == value) {
+    return;
+  }
+  EnsureUniqueData();
+  data_->convexity = value;
 }
 
 void Path::Shift(Point shift) {
+  EnsureUniqueData();
   size_t currentIndex = 0;
-  for (const auto& component : components_) {
+  for (const auto& component : data_->components) {
     switch (component.type) {
       case ComponentType::kLinear:
-        linears_[component.index].p1 += shift;
-        linears_[component.index].p2 += shift;
+        data_->linears[component.index].p1 += shift;
+        data_->linears[component.index].p2 += shift;
         break;
       case ComponentType::kQuadratic:
-        quads_[component.index].cp += shift;
-        quads_[component.index].p1 += shift;
-        quads_[component.index].p2 += shift;
+        data_->quads[component.index].cp += shift;
+        data_->quads[component.index].p1 += shift;
+        data_->quads[component.index].p2 += shift;
         break;
       case ComponentType::kCubic:
-        cubics_[component.index].cp1 += shift;
-        cubics_[component.index].cp2 += shift;
-        cubics_[component.index].p1 += shift;
-        cubics_[component.index].p2 += shift;
+        data_->cubics[component.index].cp1 += shift;
+        data_->cubics[component.index].cp2 += shift;
+        data_->cubics[component.index].p1 += shift;
+        data_->cubics[component.index].p2 += shift;
         break;
       case ComponentType::kContour:
-        contours_[component.index].destination += shift;
+        data_->contours[component.index].destination += shift;
         break;
     }
     currentIndex++;
@@ -89,37 +121,42 @@ void Path::Shift(Point shift) {
 }
 
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  EnsureUniqueData();
+  data_->linears.emplace_back(p1, p2);
+  data_->components.emplace_back(ComponentType::kLinear, data_->linears.size() - 1);
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  EnsureUniqueData();
+  data_->quads.emplace_back(p1, cp, p2);
+  data_->components.emplace_back(ComponentType::kQuadratic, data_->quads.size() - 1);
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  EnsureUniqueData();
+  data_->cubics.emplace_back(p1, cp1, cp2, p2);
+  data_->components.emplace_back(ComponentType::kCubic, data_->cubics.size() - 1);
   return *this;
 }
 
 Path& Path::AddContourComponent(Point destination, bool is_closed) {
-  if (components_.size() > 0 &&
-      components_.back().type == ComponentType::kContour) {
+  EnsureUniqueData();
+  if (data_->components.size() > 0 &&
+      data_->components.back().type == ComponentType::kContour) {
     // Never insert contiguous contours.
-    contours_.back() = ContourComponent(destination, is_closed);
+    data_->contours.back() = ContourComponent(destination, is_closed);
   } else {
-    contours_.emplace_back(ContourComponent(destination, is_closed));
-    components_.emplace_back(ComponentType::kContour, contours_.size() - 1);
+    data_->contours.emplace_back(ContourComponent(destination, is_closed));
+    data_->components.emplace_back(ComponentType::kContour, data_->contours.size() - 1);
   }
   return *this;
 }
 
 void Path::SetContourClosed(bool is_closed) {
-  contours_.back().is_closed = is_closed;
+  EnsureUniqueData();
+  data_->contours.back().is_closed = is_closed;
 }
 
 void Path::EnumerateComponents(
@@ -128,26 +165,26 @@ void Path::EnumerateComponents(
     const Applier<CubicPathComponent>& cubic_applier,
     const Applier<ContourComponent>& contour_applier) const {
   size_t currentIndex = 0;
-  for (const auto& component : components_) {
+  for (const auto& component : data_->components) {
     switch (component.type) {
       case ComponentType::kLinear:
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(currentIndex, data_->linears[component.index]);
         }
         break;
       case ComponentType::kQuadratic:
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(currentIndex, data_->quads[component.index]);
         }
         break;
       case ComponentType::kCubic:
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(currentIndex, data_->cubics[component.index]);
         }
         break;
       case ComponentType::kContour:
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(currentIndex, data_->contours[component.index]);
         }
         break;
     }
@@ -157,151 +194,162 @@ void Path::EnumerateComponents(
 
 bool Path::GetLinearComponentAtIndex(size_t index,
                                      LinearPathComponent& linear) const {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kLinear) {
+  if (data_->components[index].type != ComponentType::kLinear) {
     return false;
   }
 
-  linear = linears_[components_[index].index];
+  linear = data_->linears[data_->components[index].index];
   return true;
 }
 
 bool Path::GetQuadraticComponentAtIndex(
     size_t index,
     QuadraticPathComponent& quadratic) const {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kQuadratic) {
+  if (data_->components[index].type != ComponentType::kQuadratic) {
     return false;
   }
 
-  quadratic = quads_[components_[index].index];
+  quadratic = data_->quads[data_->components[index].index];
   return true;
 }
 
 bool Path::GetCubicComponentAtIndex(size_t index,
                                     CubicPathComponent& cubic) const {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kCubic) {
+  if (data_->components[index].type != ComponentType::kCubic) {
     return false;
   }
 
-  cubic = cubics_[components_[index].index];
+  cubic = data_->cubics[data_->components[index].index];
   return true;
 }
 
 bool Path::GetContourComponentAtIndex(size_t index,
                                       ContourComponent& move) const {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kContour) {
+  if (data_->components[index].type != ComponentType::kContour) {
     return false;
   }
 
-  move = contours_[components_[index].index];
+  move = data_->contours[data_->components[index].index];
   return true;
 }
 
 bool Path::UpdateLinearComponentAtIndex(size_t index,
                                         const LinearPathComponent& linear) {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kLinear) {
+  if (data_->components[index].type != ComponentType::kLinear) {
     return false;
   }
 
-  linears_[components_[index].index] = linear;
+  EnsureUniqueData();
+  data_->linears[data_->components[index].index] = linear;
   return true;
 }
 
 bool Path::UpdateQuadraticComponentAtIndex(
     size_t index,
     const QuadraticPathComponent& quadratic) {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kQuadratic) {
+  if (data_->components[index].type != ComponentType::kQuadratic) {
     return false;
   }
 
-  quads_[components_[index].index] = quadratic;
+  EnsureUniqueData();
+  data_->quads[data_->components[index].index] = quadratic;
   return true;
 }
 
 bool Path::UpdateCubicComponentAtIndex(size_t index,
                                        CubicPathComponent& cubic) {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kCubic) {
+  if (data_->components[index].type != ComponentType::kCubic) {
     return false;
   }
 
-  cubics_[components_[index].index] = cubic;
+  EnsureUniqueData();
+  data_->cubics[data_->components[index].index] = cubic;
   return true;
 }
 
 bool Path::UpdateContourComponentAtIndex(size_t index,
                                          const ContourComponent& move) {
-  if (index >= components_.size()) {
+  if (index >= data_->components.size()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kContour) {
+  if (data_->components[index].type != ComponentType::kContour) {
     return false;
   }
 
-  contours_[components_[index].index] = move;
+  EnsureUniqueData();
+  data_->contours[data_->components[index].index] = move;
   return true;
 }
 
 Path::Polyline Path::CreatePolyline(Scalar scale) const {
   Polyline polyline;
+  CreatePolyline(scale, polyline);
+  return polyline;
+}
 
-  std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
-      return;
-    }
+void Path::CreatePolyline(Scalar scale, Polyline& polyline) const {
+  polyline.points.clear();
+  polyline.contours.clear();
 
-    for (const auto& point : collection) {
+  // Components append their points to the polyline directly, and the points
+  // appended from `start` on are compacted in place.
+  std::optional<Point> previous_contour_point;
+  auto collect_points = [&polyline, &previous_contour_point](size_t start) {
+    size_t end = start;
+    for (size_t i = start; i < polyline.points.size(); i++) {
+      const Point point = polyline.points[i];
       if (previous_contour_point.has_value() &&
           previous_contour_point.value() == point) {
         // Skip over duplicate points in the same contour.
         continue;
       }
       previous_contour_point = point;
-      polyline.points.push_back(point);
+      polyline.points[end++] = point;
     }
+    polyline.points.resize(end);
   };
 
   auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
-    if (component_i >= components_.size()) {
+    if (component_i >= data_->components.size()) {
       return std::monostate{};
     }
-    const auto& component = components_[component_i];
+    const auto& component = data_->components[component_i];
     switch (component.type) {
       case ComponentType::kLinear:
-        return &linears_[component.index];
+        return &data_->linears[component.index];
       case ComponentType::kQuadratic:
-        return &quads_[component.index];
+        return &data_->quads[component.index];
       case ComponentType::kCubic:
-        return &cubics_[component.index];
+        return &data_->cubics[component.index];
       case ComponentType::kContour:
         return std::monostate{};
     }
@@ -361,36 +409,41 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
     }
   };
 
-  for (size_t component_i = 0; component_i < components_.size();
+  for (size_t component_i = 0; component_i < data_->components.size();
        component_i++) {
-    const auto& component = components_[component_i];
+    const auto& component = data_->components[component_i];
+    const size_t start = polyline.points.size();
     switch (component.type) {
       case ComponentType::kLinear:
         components.push_back({
-            .component_start_index = polyline.points.size(),
+            .component_start_index = start,
             .is_curve = false,
         });
-        collect_points(linears_[component.index].CreatePolyline());
+        polyline.points.push_back(data_->linears[component.index].p2);
+        collect_points(start);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kQuadratic:
         components.push_back({
-            .component_start_index = polyline.points.size(),
+            .component_start_index = start,
             .is_curve = true,
         });
-        collect_points(quads_[component.index].CreatePolyline(scale));
+        data_->quads[component.index].FillPointsForPolyline(polyline.points, scale);
+        collect_points(start);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kCubic:
         components.push_back({
-            .component_start_index = polyline.points.size(),
+            .component_start_index = start,
             .is_curve = true,
         });
-        collect_points(cubics_[component.index].CreatePolyline(scale));
+        data_->cubics[component.index].FillPointsForPolyline(polyline.points,
+                                                       scale);
+        collect_points(start);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kContour:
-        if (component_i == components_.size() - 1) {
+        if (component_i == data_->components.size() - 1) {
           // If the last component is a contour, that means it's an empty
           // contour, so skip it.
           continue;
@@ -398,34 +451,38 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
         end_contour();
 
         Vector2 start_direction = compute_contour_start_direction(component_i);
-        const auto& contour = contours_[component.index];
+        const auto& contour = data_->contours[component.index];
         polyline.contours.push_back({.start_index = polyline.points.size(),
                                      .is_closed = contour.is_closed,
                                      .start_direction = start_direction,
                                      .components = components});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        polyline.points.push_back(contour.destination);
+        collect_points(start);
         break;
     }
   }
   end_contour();
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
-  return computed_bounds_;
+  return data_->computed_bounds;
 }
 
 void Path::ComputeBounds() {
+  std::optional<Rect> bounds;
   auto min_max = GetMinMaxCoveragePoints();
-  if (!min_max.has_value()) {
-    computed_bounds_ = std::nullopt;
+  if (min_max.has_value()) {
+    auto min = min_max->first;
+    auto max = min_max->second;
+    const auto difference = max - min;
+    bounds = Rect{min.x, min.y, difference.x, difference.y};
+  }
+  if (data_->computed_bounds == bounds) {
     return;
   }
-  auto min = min_max->first;
-  auto max = min_max->second;
-  const auto difference = max - min;
-  computed_bounds_ = Rect{min.x, min.y, difference.x, difference.y};
+  EnsureUniqueData();
+  data_->computed_bounds = bounds;
 }
 
 std::optional<Rect> Path::GetTransformedBoundingBox(
@@ -438,7 +495,7 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
+  if (data_->linears.empty() && data_->quads.empty() && data_->cubics.empty()) {
     return std::nullopt;
   }
 
@@ -458,18 +515,18 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
+  for (const auto& linear : data_->linears) {
     clamp(linear.p1);
     clamp(linear.p2);
   }
 
-  for (const auto& quad : quads_) {
+  for (const auto& quad : data_->quads) {
     for (const Point& point : quad.Extrema()) {
       clamp(point);
     }
   }
 
-  for (const auto& cubic : cubics_) {
+  for (const auto& cubic : data_->cubics) {
     for (const Point& point : cubic.Extrema()) {
       clamp(point);
     }
@@ -482,8 +539,63 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
   return std::make_pair(min.value(), max.value());
 }
 
+size_t Path::GetContentHash() const {
+  const size_t cached_hash =
+      data_->content_hash.load(std::memory_order_relaxed);
+  if (cached_hash != 0u) {
+    return cached_hash;
+  }
+  size_t hash = fml::HashCombine(data_->fill, data_->components.size());
+  auto hash_point = [&hash](const Point& point) {
+    fml::HashCombineSeed(hash, point.x, point.y);
+  };
+  for (const auto& component : data_->components) {
+    fml::HashCombineSeed(hash, component.type, component.index);
+  }
+  for (const auto& linear : data_->linears) {
+    hash_point(linear.p1);
+    hash_point(linear.p2);
+  }
+  for (const auto& quad : data_->quads) {
+    hash_point(quad.p1);
+    hash_point(quad.cp);
+    hash_point(quad.p2);
+  }
+  for (const auto& cubic : data_->cubics) {
+    hash_point(cubic.p1);
+    hash_point(cubic.cp1);
+    hash_point(cubic.cp2);
+    hash_point(cubic.p2);
+  }
+  for (const auto& contour : data_->contours) {
+    hash_point(contour.destination);
+    fml::HashCombineSeed(hash, contour.is_closed);
+  }
+  data_->content_hash.store(hash, std::memory_order_relaxed);
+  return hash;
+}
+
+bool Path::HasSameContents(const Path& other) const {
+  if (data_ == other.data_) {
+    return true;
+  }
+  if (data_->fill != other.data_->fill ||
+      data_->components.size() != other.data_->components.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < data_->components.size(); i++) {
+    if (data_->components[i].type != other.data_->components[i].type ||
+        data_->components[i].index != other.data_->components[i].index) {
+      return false;
+    }
+  }
+  return data_->linears == other.data_->linears && data_->quads == other.data_->quads &&
+         data_->cubics == other.data_->cubics && data_->contours == other.data_->contours;
+}
+
 void Path::SetBounds(Rect rect) {
-  computed_bounds_ = rect;
+  EnsureUniqueData();
+  data_->computed_bounds = rect;
 }
 
 }  // namespace impeller
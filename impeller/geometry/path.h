@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -108,6 +110,12 @@ class Path {
 
   ~Path();
 
+  // Copies share the components of the path, which are only copied once one
+  // of the paths is changed.
+  Path(const Path& other);
+
+  Path& operator=(const Path& other);
+
   size_t GetComponentCount(std::optional<ComponentType> type = {}) const;
 
   FillType GetFillType() const;
@@ -140,12 +148,31 @@ class Path {
   /// the path. If the provided scale is 0, curves will revert to lines.
   Polyline CreatePolyline(Scalar scale) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Like `CreatePolyline`, but replaces the contents of
+  ///             `polyline`, so that callers that flatten paths repeatedly
+  ///             can reuse the memory of the points.
+  ///
+  void CreatePolyline(Scalar scale, Polyline& polyline) const;
+
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
 
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of the fill type and components of the path. Paths
+  ///             built separately from the same components hash the same.
+  ///
+  size_t GetContentHash() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether both paths have the same fill type and the same
+  ///             components in the same order.
+  ///
+  bool HasSameContents(const Path& other) const;
+
  private:
   friend class PathBuilder;
 
@@ -194,15 +221,32 @@ class Path {
         : type(a_type), index(a_index) {}
   };
 
-  FillType fill_ = FillType::kNonZero;
-  Convexity convexity_ = Convexity::kUnknown;
-  std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
-  std::vector<ContourComponent> contours_;
+  struct Data {
+    Data() = default;
+
+    // Copies everything but the content hash.
+    Data(const Data& other);
+
+    FillType fill = FillType::kNonZero;
+    Convexity convexity = Convexity::kUnknown;
+    std::vector<ComponentIndexPair> components;
+    std::vector<LinearPathComponent> linears;
+    std::vector<QuadraticPathComponent> quads;
+    std::vector<CubicPathComponent> cubics;
+    std::vector<ContourComponent> contours;
+
+    std::optional<Rect> computed_bounds;
+
+    // The result of |GetContentHash|, or 0 if it hasn't been computed yet.
+    std::atomic<size_t> content_hash{0u};
+  };
+
+  // Shared between copies of the path, so that converted and cached paths can
+  // be handed out without copying their components.
+  std::shared_ptr<Data> data_;
 
-  std::optional<Rect> computed_bounds_;
+  // Gives this path its own copy of the data before it is changed.
+  void EnsureUniqueData();
 };
 
 }  // namespace impeller
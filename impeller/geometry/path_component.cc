@@ -4,6 +4,7 @@
 
 #include "path_component.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace impeller {
@@ -95,9 +96,19 @@ Point QuadraticPathComponent::SolveDerivative(Scalar time) const {
   };
 }
 
-static Scalar ApproximateParabolaIntegral(Scalar x) {
-  constexpr Scalar d = 0.67;
-  return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
+// The number of curve parameters that are flattened together. The loops over
+// the lanes have a fixed trip count and no dependencies between lanes, so
+// they are compiled to SSE or NEON instructions without needing intrinsics
+// for every target.
+static constexpr size_t kFlattenLaneCount = 4u;
+
+// The accuracy of the quadratics that cubics are approximated with.
+static constexpr Scalar kCubicToQuadraticAccuracy = .1f;
+
+static inline Scalar ApproximateParabolaIntegral(Scalar x) {
+  constexpr Scalar d = 0.67f;
+  constexpr Scalar d4 = d * d * d * d;
+  return x / (1.0f - d + std::sqrt(std::sqrt(d4 + 0.25f * x * x)));
 }
 
 std::vector<Point> QuadraticPathComponent::CreatePolyline(Scalar scale) const {
@@ -137,13 +148,30 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
   auto u2 = ApproximateParabolaIntegral(a2);
   auto uscale = 1 / (u2 - u0);
 
-  auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
-  auto step = 1 / line_count;
-  for (size_t i = 1; i < line_count; i += 1) {
-    auto u = i * step;
-    auto a = a0 + (a2 - a0) * u;
-    auto t = (ApproximateParabolaIntegral(a) - u0) * uscale;
-    points.emplace_back(Solve(t));
+  const size_t line_count =
+      static_cast<size_t>(std::max(1., ceil(0.5 * val / sqrt_tolerance)));
+  const Scalar step = 1.0f / line_count;
+  const Scalar da = a2 - a0;
+  // The curve in the power basis, p1 + t * (b + t * c), which takes fewer
+  // operations to evaluate than the Bernstein form.
+  const Point b = 2.0f * d01;
+  const Point c = -dd;
+
+  points.reserve(points.size() + line_count);
+  for (size_t i = 1; i < line_count; i += kFlattenLaneCount) {
+    Scalar xs[kFlattenLaneCount];
+    Scalar ys[kFlattenLaneCount];
+    for (size_t lane = 0; lane < kFlattenLaneCount; lane++) {
+      const Scalar u = (i + lane) * step;
+      const Scalar t = (ApproximateParabolaIntegral(a0 + da * u) - u0) * uscale;
+      xs[lane] = p1.x + t * (b.x + t * c.x);
+      ys[lane] = p1.y + t * (b.y + t * c.y);
+    }
+    // The lanes past the last point were computed for nothing.
+    const size_t count = std::min(kFlattenLaneCount, line_count - i);
+    for (size_t lane = 0; lane < count; lane++) {
+      points.emplace_back(xs[lane], ys[lane]);
+    }
   }
   points.emplace_back(p2);
 }
@@ -188,14 +216,21 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
-  for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
-  }
+  FillPointsForPolyline(points, scale);
   return points;
 }
 
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar scale_factor) const {
+  const size_t quad_count =
+      CountQuadraticPathComponents(kCubicToQuadraticAccuracy);
+  for (size_t i = 0; i < quad_count; i++) {
+    ToQuadraticPathComponent(i, quad_count)
+        .FillPointsForPolyline(points, scale_factor);
+  }
+}
+
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
   return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
                                 3.0 * (p2 - cp2));
@@ -211,9 +246,8 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
   return CubicPathComponent(p0, p1, p2, p3);
 }
 
-std::vector<QuadraticPathComponent>
-CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
-  std::vector<QuadraticPathComponent> quads;
+size_t CubicPathComponent::CountQuadraticPathComponents(
+    Scalar accuracy) const {
   // The maximum error, as a vector from the cubic to the best approximating
   // quadratic, is proportional to the third derivative, which is constant
   // across the segment. Thus, the error scales down as the third power of
@@ -230,16 +264,28 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   auto p2x2 = 3.0 * cp2 - p2;
   auto p = p2x2 - p1x2;
   auto err = p.Dot(p);
-  auto quad_count = std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0)));
+  return static_cast<size_t>(
+      std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0))));
+}
 
+QuadraticPathComponent CubicPathComponent::ToQuadraticPathComponent(
+    size_t index,
+    size_t count) const {
+  Scalar t0 = static_cast<Scalar>(index) / count;
+  Scalar t1 = static_cast<Scalar>(index + 1) / count;
+  auto seg = Subsegment(t0, t1);
+  auto p1x2 = 3.0 * seg.cp1 - seg.p1;
+  auto p2x2 = 3.0 * seg.cp2 - seg.p2;
+  return QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2);
+}
+
+std::vector<QuadraticPathComponent>
+CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
+  const size_t quad_count = CountQuadraticPathComponents(accuracy);
+  std::vector<QuadraticPathComponent> quads;
+  quads.reserve(quad_count);
   for (size_t i = 0; i < quad_count; i++) {
-    auto t0 = i / quad_count;
-    auto t1 = (i + 1) / quad_count;
-    auto seg = Subsegment(t0, t1);
-    auto p1x2 = 3.0 * seg.cp1 - seg.p1;
-    auto p2x2 = 3.0 * seg.cp2 - seg.p2;
-    quads.emplace_back(
-        QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
+    quads.push_back(ToQuadraticPathComponent(i, quad_count));
   }
   return quads;
 }
@@ -123,11 +123,25 @@ struct CubicPathComponent {
   // See the note on QuadraticPathComponent::CreatePolyline for references.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  // Appends the points of `CreatePolyline` to `points`, without allocating a
+  // vector for the quadratics.
+  void FillPointsForPolyline(std::vector<Point>& points,
+                             Scalar scale_factor) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
       Scalar accuracy) const;
 
+  // The number of quadratics `ToQuadraticPathComponents` approximates this
+  // cubic with.
+  size_t CountQuadraticPathComponents(Scalar accuracy) const;
+
+  // The quadratic at `index` of the `count` quadratics approximating this
+  // cubic.
+  QuadraticPathComponent ToQuadraticPathComponent(size_t index,
+                                                  size_t count) const;
+
   CubicPathComponent Subsegment(Scalar t0, Scalar t1) const;
 
   bool operator==(const CubicPathComponent& other) const {
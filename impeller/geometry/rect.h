@@ -7,6 +7,7 @@
 #include <array>
 #include <optional>
 #include <ostream>
+#include <type_traits>
 #include <vector>
 
 #include "impeller/geometry/matrix.h"
@@ -193,8 +194,13 @@ struct TRect {
   constexpr std::array<TPoint<T>, 4> GetTransformedPoints(
       const Matrix& transform) const {
     auto points = GetPoints();
-    for (size_t i = 0; i < points.size(); i++) {
-      points[i] = transform * points[i];
+    if constexpr (std::is_same_v<T, Scalar>) {
+      // The four corners are exactly one batch of the vectorized transform.
+      transform.TransformPoints(points.data(), points.data(), points.size());
+    } else {
+      for (size_t i = 0; i < points.size(); i++) {
+        points[i] = transform * points[i];
+      }
     }
     return points;
   }
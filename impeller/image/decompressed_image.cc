@@ -4,9 +4,8 @@
 
 #include "impeller/image/decompressed_image.h"
 
-#include <limits>
-
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/pixel_conversions.h"
 #include "impeller/base/allocation.h"
 
 namespace impeller {
@@ -82,33 +81,23 @@ DecompressedImage DecompressedImage::ConvertToRGBA() const {
   const uint8_t* source = allocation_->GetMapping();
   uint8_t* dest = rgba_allocation->GetBuffer();
 
-  for (size_t i = 0, j = 0; i < source_byte_size; i += bpp, j += 4u) {
-    switch (format_) {
-      case DecompressedImage::Format::kGrey:
-        dest[j + 0] = source[i];
-        dest[j + 1] = source[i];
-        dest[j + 2] = source[i];
-        dest[j + 3] = std::numeric_limits<uint8_t>::max();
-        break;
-      case DecompressedImage::Format::kGreyAlpha:
-        dest[j + 0] = std::numeric_limits<uint8_t>::max();
-        dest[j + 1] = std::numeric_limits<uint8_t>::max();
-        dest[j + 2] = std::numeric_limits<uint8_t>::max();
-        dest[j + 3] = source[i];
-        break;
-      case DecompressedImage::Format::kRGB:
-        dest[j + 0] = source[i + 0];
-        dest[j + 1] = source[i + 1];
-        dest[j + 2] = source[i + 2];
-        dest[j + 3] = std::numeric_limits<uint8_t>::max();
-        break;
-      case DecompressedImage::Format::kInvalid:
-      case DecompressedImage::Format::kRGBA:
-        // Should never happen. The necessary checks have already been
-        // performed.
-        FML_CHECK(false);
-        break;
-    }
+  const size_t pixel_count = size_.Area();
+  switch (format_) {
+    case DecompressedImage::Format::kGrey:
+      fml::ConvertGreyToRGBA8888(source, dest, pixel_count);
+      break;
+    case DecompressedImage::Format::kGreyAlpha:
+      fml::ConvertAlphaToRGBA8888(source, dest, pixel_count);
+      break;
+    case DecompressedImage::Format::kRGB:
+      fml::ConvertRGBToRGBA8888(source, dest, pixel_count);
+      break;
+    case DecompressedImage::Format::kInvalid:
+    case DecompressedImage::Format::kRGBA:
+      // Should never happen. The necessary checks have already been
+      // performed.
+      FML_CHECK(false);
+      break;
   }
 
   return DecompressedImage{
@@ -112,8 +112,8 @@ std::shared_ptr<Context> PlaygroundImplGLES::GetContext() const {
     return nullptr;
   }
 
-  auto context =
-      ContextGLES::Create(std::move(gl), ShaderLibraryMappingsForPlayground());
+  auto context = ContextGLES::Create(
+      std::move(gl), ShaderLibraryMappingsForPlayground(), fml::UniqueFD{});
   if (!context) {
     FML_LOG(ERROR) << "Could not create context.";
     return nullptr;
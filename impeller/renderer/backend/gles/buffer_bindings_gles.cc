@@ -17,6 +17,31 @@
 
 namespace impeller {
 
+TextureUnitStateGLES::TextureUnitStateGLES() = default;
+
+TextureUnitStateGLES::~TextureUnitStateGLES() = default;
+
+bool TextureUnitStateGLES::IsBound(size_t unit,
+                                   const TextureGLES& texture) const {
+  return unit < bound_textures_.size() && bound_textures_[unit] == &texture;
+}
+
+void TextureUnitStateGLES::SetActiveUnit(const ProcTableGLES& gl,
+                                         size_t unit) {
+  if (active_unit_ == unit) {
+    return;
+  }
+  gl.ActiveTexture(GL_TEXTURE0 + unit);
+  active_unit_ = unit;
+}
+
+void TextureUnitStateGLES::SetBound(size_t unit, const TextureGLES& texture) {
+  if (unit >= bound_textures_.size()) {
+    bound_textures_.resize(unit + 1, nullptr);
+  }
+  bound_textures_[unit] = &texture;
+}
+
 BufferBindingsGLES::BufferBindingsGLES() = default;
 
 BufferBindingsGLES::~BufferBindingsGLES() = default;
@@ -143,7 +168,8 @@ bool BufferBindingsGLES::BindUniformData(
     const ProcTableGLES& gl,
     Allocator& transients_allocator,
     const Bindings& vertex_bindings,
-    const Bindings& fragment_bindings) const {
+    const Bindings& fragment_bindings,
+    TextureUnitStateGLES& texture_units) const {
   for (const auto& buffer : vertex_bindings.buffers) {
     if (!BindUniformBuffer(gl, transients_allocator, buffer.second.view)) {
       return false;
@@ -155,11 +181,13 @@ bool BufferBindingsGLES::BindUniformData(
     }
   }
 
-  if (!BindTextures(gl, vertex_bindings, ShaderStage::kVertex)) {
+  if (!BindTextures(gl, vertex_bindings, ShaderStage::kVertex,
+                    texture_units)) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment)) {
+  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment,
+                    texture_units)) {
     return false;
   }
 
@@ -295,9 +323,11 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
-                                      const Bindings& bindings,
-                                      ShaderStage stage) const {
+bool BufferBindingsGLES::BindTextures(
+    const ProcTableGLES& gl,
+    const Bindings& bindings,
+    ShaderStage stage,
+    TextureUnitStateGLES& texture_units) const {
   size_t active_index = 0;
   for (const auto& data : bindings.sampled_images) {
     const auto& texture_gles = TextureGLES::Cast(*data.second.texture.resource);
@@ -314,30 +344,38 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
       return false;
     }
 
-    //--------------------------------------------------------------------------
-    /// Set the active texture unit.
-    ///
     if (active_index >= gl.GetCapabilities()->GetMaxTextureUnits(stage)) {
       VALIDATION_LOG << "Texture units specified exceed the capabilities for "
                         "this shader stage.";
       return false;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
-
-    //--------------------------------------------------------------------------
-    /// Bind the texture.
-    ///
-    if (!texture_gles.Bind()) {
-      return false;
-    }
 
     //--------------------------------------------------------------------------
-    /// If there is a sampler for the texture at the same index, configure the
-    /// bound texture using that sampler.
+    /// The texture unit only has to be made active when the texture isn't
+    /// bound to it yet or the sampler state of the texture has to change.
     ///
     const auto& sampler_gles = SamplerGLES::Cast(*data.second.sampler.resource);
-    if (!sampler_gles.ConfigureBoundTexture(texture_gles, gl)) {
-      return false;
+    const bool is_bound = texture_units.IsBound(active_index, texture_gles);
+    if (!is_bound || !sampler_gles.IsBoundTextureConfigured(texture_gles)) {
+      texture_units.SetActiveUnit(gl, active_index);
+
+      //------------------------------------------------------------------------
+      /// Bind the texture.
+      ///
+      if (!is_bound) {
+        if (!texture_gles.Bind()) {
+          return false;
+        }
+        texture_units.SetBound(active_index, texture_gles);
+      }
+
+      //------------------------------------------------------------------------
+      /// If there is a sampler for the texture at the same index, configure
+      /// the bound texture using that sampler.
+      ///
+      if (!sampler_gles.ConfigureBoundTexture(texture_gles, gl)) {
+        return false;
+      }
     }
 
     //--------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -15,6 +16,34 @@
 
 namespace impeller {
 
+class TextureGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      Tracks the textures bound to the texture units while the
+///             commands of a render pass are encoded, so that draws sampling
+///             from the same textures as the previous draw don't bind them
+///             again. Nothing else binds textures during a render pass, so
+///             the state is only valid for the duration of one.
+///
+class TextureUnitStateGLES {
+ public:
+  TextureUnitStateGLES();
+
+  ~TextureUnitStateGLES();
+
+  bool IsBound(size_t unit, const TextureGLES& texture) const;
+
+  void SetActiveUnit(const ProcTableGLES& gl, size_t unit);
+
+  void SetBound(size_t unit, const TextureGLES& texture);
+
+ private:
+  std::optional<size_t> active_unit_;
+  std::vector<const TextureGLES*> bound_textures_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureUnitStateGLES);
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Sets up stage bindings for single draw call in the OpenGLES
 ///             backend.
@@ -38,7 +67,8 @@ class BufferBindingsGLES {
   bool BindUniformData(const ProcTableGLES& gl,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
-                       const Bindings& fragment_bindings) const;
+                       const Bindings& fragment_bindings,
+                       TextureUnitStateGLES& texture_units) const;
 
   bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
 
@@ -63,7 +93,8 @@ class BufferBindingsGLES {
 
   bool BindTextures(const ProcTableGLES& gl,
                     const Bindings& bindings,
-                    ShaderStage stage) const;
+                    ShaderStage stage,
+                    TextureUnitStateGLES& texture_units) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BufferBindingsGLES);
 };
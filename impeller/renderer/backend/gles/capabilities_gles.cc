@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 
+#include "impeller/base/version.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -86,6 +87,26 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     gl.GetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &value);
     num_shader_binary_formats = value;
   }
+
+  if (gl.GetProgramBinary.IsAvailable() ||
+      gl.GetProgramBinaryOES.IsAvailable()) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &value);
+    num_program_binary_formats = value;
+  }
+
+  {
+    const auto description = gl.GetDescription();
+    // ETC2 is part of OpenGL ES 3.0.
+    supports_texture_compression_etc2 =
+        description->IsES() &&
+        description->GetGlVersion().IsAtLeast(Version(3, 0, 0));
+    supports_texture_compression_astc =
+        description->HasExtension("GL_KHR_texture_compression_astc_ldr");
+    supports_texture_compression_bc =
+        description->HasExtension("GL_EXT_texture_compression_bptc") ||
+        description->HasExtension("GL_ARB_texture_compression_bptc");
+  }
 }
 
 size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
@@ -56,6 +56,15 @@ struct CapabilitiesGLES {
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // May be 0.
+  size_t num_program_binary_formats = 0;
+
+  // Whether textures with the block compressed formats of each family can be
+  // sampled.
+  bool supports_texture_compression_astc = false;
+  bool supports_texture_compression_etc2 = false;
+  bool supports_texture_compression_bc = false;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 };
 
@@ -11,14 +11,16 @@ namespace impeller {
 
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries));
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+    fml::UniqueFD cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, std::move(cache_directory)));
 }
 
-ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
-                         const std::vector<std::shared_ptr<fml::Mapping>>&
-                             shader_libraries_mappings) {
+ContextGLES::ContextGLES(
+    std::unique_ptr<ProcTableGLES> gl,
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
+    fml::UniqueFD cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -38,8 +40,8 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(cache_directory)));
   }
 
   // Create allocators.
@@ -60,6 +62,7 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the device capabilities.
   {
+    const auto gl_capabilities = reactor_->GetProcTable().GetCapabilities();
     device_capabilities_ =
         CapabilitiesBuilder()
             .SetSupportsOffscreenMSAA(false)
@@ -77,9 +80,20 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
             .SetSupportsReadFromOnscreenTexture(false)
             .SetSupportsDecalSamplerAddressMode(false)
             .SetSupportsDeviceTransientTextures(false)
+            .SetSupportsBindlessTextures(false)
+            .SetSupportsTextureCompressionASTC(
+                gl_capabilities->supports_texture_compression_astc)
+            .SetSupportsTextureCompressionETC2(
+                gl_capabilities->supports_texture_compression_etc2)
+            .SetSupportsTextureCompressionBC(
+                gl_capabilities->supports_texture_compression_bc)
             .Build();
   }
 
+  // Create the GPU tracer. It is unavailable on drivers without timer
+  // queries.
+  gpu_tracer_ = GPUTracerGLES::Create(reactor_);
+
   is_valid_ = true;
 }
 
@@ -114,6 +128,11 @@ bool ContextGLES::IsValid() const {
 
 void ContextGLES::Shutdown() {}
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextGLES::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 // |Context|
 std::string ContextGLES::DescribeGpuModel() const {
   return reactor_->GetProcTable().GetDescription()->GetString();
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -21,7 +22,11 @@ DeviceBufferGLES::DeviceBufferGLES(DeviceBufferDescriptor desc,
       reactor_(std::move(reactor)),
       handle_(reactor_ ? reactor_->CreateHandle(HandleType::kBuffer)
                        : HandleGLES::DeadHandle()),
-      backing_store_(std::move(backing_store)) {}
+      backing_store_(std::move(backing_store)) {
+  if (backing_store_) {
+    MarkDirty(Range{0u, backing_store_->GetLength()});
+  }
+}
 
 // |DeviceBuffer|
 DeviceBufferGLES::~DeviceBufferGLES() {
@@ -38,6 +43,22 @@ uint8_t* DeviceBufferGLES::OnGetContents() const {
   return backing_store_->GetBuffer();
 }
 
+// |DeviceBuffer|
+void DeviceBufferGLES::Flush(Range range) const {
+  MarkDirty(range);
+}
+
+void DeviceBufferGLES::MarkDirty(Range range) const {
+  if (!dirty_range_.has_value()) {
+    dirty_range_ = range;
+    return;
+  }
+  const auto begin = std::min(dirty_range_->offset, range.offset);
+  const auto end = std::max(dirty_range_->offset + dirty_range_->length,
+                            range.offset + range.length);
+  dirty_range_ = Range{begin, end - begin};
+}
+
 // |DeviceBuffer|
 bool DeviceBufferGLES::OnCopyHostBuffer(const uint8_t* source,
                                         Range source_range,
@@ -52,7 +73,7 @@ bool DeviceBufferGLES::OnCopyHostBuffer(const uint8_t* source,
 
   std::memmove(backing_store_->GetBuffer() + offset,
                source + source_range.offset, source_range.length);
-  ++generation_;
+  MarkDirty(Range{offset, source_range.length});
 
   return true;
 }
@@ -82,14 +103,33 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
 
   gl.BindBuffer(target_type, buffer.value());
 
-  if (upload_generation_ != generation_) {
-    TRACE_EVENT1("impeller", "BufferData", "Bytes",
-                 std::to_string(backing_store_->GetLength()).c_str());
-    gl.BufferData(target_type, backing_store_->GetLength(),
-                  backing_store_->GetBuffer(), GL_STATIC_DRAW);
-    upload_generation_ = generation_;
+  if (!dirty_range_.has_value()) {
+    return true;
   }
 
+  const auto length = backing_store_->GetLength();
+  const auto dirty_range = dirty_range_.value();
+  dirty_range_ = std::nullopt;
+
+  // Only the part that changed is uploaded to existing storage. When most of
+  // the buffer changed, the storage is specified again instead, which lets
+  // the driver orphan the old storage rather than wait for draws still reading
+  // from it.
+  if (has_device_storage_ && dirty_range.length * 2u <= length) {
+    TRACE_EVENT1("impeller", "BufferSubData", "Bytes",
+                 std::to_string(dirty_range.length).c_str());
+    gl.BufferSubData(target_type, dirty_range.offset, dirty_range.length,
+                     backing_store_->GetBuffer() + dirty_range.offset);
+    return true;
+  }
+
+  TRACE_EVENT1("impeller", "BufferData", "Bytes",
+               std::to_string(length).c_str());
+  // Buffers that are updated after their first upload are hinted as dynamic.
+  gl.BufferData(target_type, length, backing_store_->GetBuffer(),
+                has_device_storage_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+  has_device_storage_ = true;
+
   return true;
 }
 
@@ -116,7 +156,7 @@ void DeviceBufferGLES::UpdateBufferData(
   if (update_buffer_data) {
     update_buffer_data(backing_store_->GetBuffer(),
                        backing_store_->GetLength());
-    ++generation_;
+    MarkDirty(Range{0u, backing_store_->GetLength()});
   }
 }
 
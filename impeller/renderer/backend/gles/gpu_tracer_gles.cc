@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
+
+namespace impeller {
+
+std::shared_ptr<GPUTracerGLES> GPUTracerGLES::Create(
+    const ReactorGLES::Ref& reactor) {
+  if (!reactor || !reactor->IsValid()) {
+    return nullptr;
+  }
+  const auto& gl = reactor->GetProcTable();
+  if (!gl.GenQueriesEXT.IsAvailable() || !gl.DeleteQueriesEXT.IsAvailable() ||
+      !gl.BeginQueryEXT.IsAvailable() || !gl.EndQueryEXT.IsAvailable() ||
+      !gl.GetQueryObjectuivEXT.IsAvailable() ||
+      !gl.GetQueryObjectui64vEXT.IsAvailable()) {
+    return nullptr;
+  }
+  return std::shared_ptr<GPUTracerGLES>(new GPUTracerGLES(reactor));
+}
+
+GPUTracerGLES::GPUTracerGLES(const ReactorGLES::Ref& reactor)
+    : reactor_(reactor) {}
+
+// The queries that are still outstanding are not deleted, as the reactor and
+// its GL context usually go away with the tracer.
+GPUTracerGLES::~GPUTracerGLES() = default;
+
+// |GPUTracer|
+void GPUTracerGLES::MarkFrameStart() {
+  GPUTracer::MarkFrameStart();
+  auto frame_id = AddCommandBuffer();
+  if (!frame_id.has_value()) {
+    return;
+  }
+  auto reactor = reactor_.lock();
+  auto weak_tracer = std::weak_ptr<GPUTracer>(shared_from_this());
+  if (!reactor || !reactor->AddOperation([weak_tracer, frame_id = *frame_id](
+                                             const ReactorGLES& reactor) {
+        if (auto tracer = weak_tracer.lock()) {
+          static_cast<GPUTracerGLES&>(*tracer).BeginQuery(
+              reactor.GetProcTable(), frame_id);
+        }
+      })) {
+    CompleteCommandBuffer(*frame_id, std::nullopt);
+  }
+}
+
+// |GPUTracer|
+void GPUTracerGLES::MarkFrameEnd() {
+  if (auto reactor = reactor_.lock()) {
+    auto weak_tracer = std::weak_ptr<GPUTracer>(shared_from_this());
+    [[maybe_unused]] bool added =
+        reactor->AddOperation([weak_tracer](const ReactorGLES& reactor) {
+          if (auto tracer = weak_tracer.lock()) {
+            static_cast<GPUTracerGLES&>(*tracer).EndQuery(
+                reactor.GetProcTable());
+          }
+        });
+  }
+  GPUTracer::MarkFrameEnd();
+}
+
+void GPUTracerGLES::BeginQuery(const ProcTableGLES& gl, uint64_t frame_id) {
+  ProcessQueries(gl);
+
+  std::scoped_lock lock(queries_mutex_);
+  if (active_query_.has_value()) {
+    // The end of the last frame never made it to the reactor. Queries of the
+    // same target can't be nested, so cut it short here.
+    gl.EndQueryEXT(GL_TIME_ELAPSED_EXT);
+    pending_queries_.push_back(*active_query_);
+    active_query_.reset();
+  }
+  Query query{.frame_id = frame_id};
+  gl.GenQueriesEXT(1, &query.name);
+  gl.BeginQueryEXT(GL_TIME_ELAPSED_EXT, query.name);
+  active_query_ = query;
+}
+
+void GPUTracerGLES::EndQuery(const ProcTableGLES& gl) {
+  std::scoped_lock lock(queries_mutex_);
+  if (!active_query_.has_value()) {
+    return;
+  }
+  gl.EndQueryEXT(GL_TIME_ELAPSED_EXT);
+  pending_queries_.push_back(*active_query_);
+  active_query_.reset();
+}
+
+void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
+  std::deque<std::pair<uint64_t, std::optional<TimeRange>>> results;
+  {
+    std::scoped_lock lock(queries_mutex_);
+    // A disjoint operation, such as a change of the GPU clock, invalidates
+    // the results of all queries that were in flight.
+    GLint disjoint = GL_FALSE;
+    gl.GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    while (!pending_queries_.empty()) {
+      const Query query = pending_queries_.front();
+      GLuint available = GL_FALSE;
+      gl.GetQueryObjectuivEXT(query.name, GL_QUERY_RESULT_AVAILABLE_EXT,
+                              &available);
+      if (!available) {
+        break;
+      }
+      GLuint64 elapsed_nanos = 0;
+      gl.GetQueryObjectui64vEXT(query.name, GL_QUERY_RESULT_EXT,
+                                &elapsed_nanos);
+      gl.DeleteQueriesEXT(1, &query.name);
+      pending_queries_.pop_front();
+
+      std::optional<TimeRange> range;
+      if (!disjoint) {
+        range = TimeRange{.start_nanos = 0,
+                          .end_nanos = static_cast<int64_t>(elapsed_nanos)};
+      }
+      results.emplace_back(query.frame_id, range);
+    }
+  }
+  for (const auto& [frame_id, range] : results) {
+    CompleteCommandBuffer(frame_id, range);
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Measures the GPU time of each frame with a
+///             `GL_TIME_ELAPSED_EXT` query that spans the frame.
+///
+///             The queries are issued and read back from reactor operations.
+///             Their results are polled at the start of later frames, so
+///             they are reported a few frames late.
+///
+class GPUTracerGLES final : public GPUTracer {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a tracer for the reactor.
+  ///
+  /// @return     The tracer, or nullptr if the driver does not support
+  ///             `GL_EXT_disjoint_timer_query`.
+  ///
+  static std::shared_ptr<GPUTracerGLES> Create(const ReactorGLES::Ref& reactor);
+
+  // |GPUTracer|
+  ~GPUTracerGLES() override;
+
+  // |GPUTracer|
+  void MarkFrameStart() override;
+
+  // |GPUTracer|
+  void MarkFrameEnd() override;
+
+ private:
+  struct Query {
+    uint64_t frame_id = 0;
+    GLuint name = GL_NONE;
+  };
+
+  std::weak_ptr<ReactorGLES> reactor_;
+  std::mutex queries_mutex_;
+  std::optional<Query> active_query_;
+  std::deque<Query> pending_queries_;
+
+  explicit GPUTracerGLES(const ReactorGLES::Ref& reactor);
+
+  void BeginQuery(const ProcTableGLES& gl, uint64_t frame_id);
+
+  void EndQuery(const ProcTableGLES& gl);
+
+  // Completes the frames of the pending queries whose results are available.
+  void ProcessQueries(const ProcTableGLES& gl);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerGLES);
+};
+
+}  // namespace impeller
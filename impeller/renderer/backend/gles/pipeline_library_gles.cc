@@ -4,19 +4,36 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <future>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
 #include "impeller/renderer/backend/gles/shader_function_gles.h"
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                                         fml::UniqueFD cache_directory)
+    : reactor_(std::move(reactor)) {
+  if (!reactor_) {
+    return;
+  }
+  auto cache = std::make_shared<ProgramBinaryCacheGLES>(
+      reactor_->GetProcTable(), std::move(cache_directory));
+  if (cache->IsValid()) {
+    program_binary_cache_ = std::move(cache);
+  }
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -69,103 +86,277 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
   VALIDATION_LOG << stream.str();
 }
 
-static bool LinkProgram(
+static std::size_t HashMapping(const fml::Mapping& mapping) {
+  return std::hash<std::string_view>{}(
+      std::string_view{reinterpret_cast<const char*>(mapping.GetMapping()),
+                       mapping.GetSize()});
+}
+
+// Everything that goes into linking a program: the sources of both stages,
+// the specialization constants defined in them, and the attribute locations
+// bound before linking.
+static uint64_t ComputeProgramKey(const PipelineDescriptor& descriptor,
+                                  const fml::Mapping& vert_mapping,
+                                  const fml::Mapping& frag_mapping) {
+  auto key = fml::HashCombine(HashMapping(vert_mapping),  //
+                              HashMapping(frag_mapping)   //
+  );
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    fml::HashCombineSeed(key, std::string_view{stage_input.name},
+                         stage_input.location);
+  }
+  for (const auto& value : descriptor.GetSpecializationConstants()) {
+    fml::HashCombineSeed(key, value);
+  }
+  return key;
+}
+
+// The shaders of a program whose link was started, and the key the linked
+// program is stored in the program binary cache under.
+struct ProgramLink {
+  std::string label;
+  GLuint vert_shader = 0;
+  GLuint frag_shader = 0;
+  std::shared_ptr<const fml::Mapping> vert_mapping;
+  std::shared_ptr<const fml::Mapping> frag_mapping;
+  std::optional<uint64_t> program_key;
+  bool loaded_from_cache = false;
+};
+
+// Issues the commands to compile the shaders and link the program without
+// querying their status, so that drivers that compile in the background don't
+// block. The link is completed by |FinishLinkProgram|.
+static std::optional<ProgramLink> StartLinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const ProgramBinaryCacheGLES* program_binary_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
 
-  auto vert_mapping =
+  ProgramLink link;
+  link.label = descriptor.GetLabel();
+  link.vert_mapping =
       ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping();
-  auto frag_mapping =
+  link.frag_mapping =
       ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping();
 
   const auto& gl = reactor.GetProcTable();
 
-  auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
-  auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return std::nullopt;
+  }
+
+  if (program_binary_cache) {
+    link.program_key = ComputeProgramKey(descriptor, *link.vert_mapping,
+                                         *link.frag_mapping);
+    if (program_binary_cache->LoadProgram(gl, *program, *link.program_key)) {
+      link.loaded_from_cache = true;
+      return link;
+    }
+    program_binary_cache->PrepareProgram(gl, *program);
+  }
 
-  if (vert_shader == 0 || frag_shader == 0) {
+  link.vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
+  link.frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
+
+  if (link.vert_shader == 0 || link.frag_shader == 0) {
     VALIDATION_LOG << "Could not create shader handles.";
-    return false;
+    gl.DeleteShader(link.vert_shader);
+    gl.DeleteShader(link.frag_shader);
+    return std::nullopt;
   }
 
-  gl.SetDebugLabel(DebugResourceType::kShader, vert_shader,
-                   SPrintF("%s Vertex Shader", descriptor.GetLabel().c_str()));
-  gl.SetDebugLabel(
-      DebugResourceType::kShader, frag_shader,
-      SPrintF("%s Fragment Shader", descriptor.GetLabel().c_str()));
+  gl.SetDebugLabel(DebugResourceType::kShader, link.vert_shader,
+                   SPrintF("%s Vertex Shader", link.label.c_str()));
+  gl.SetDebugLabel(DebugResourceType::kShader, link.frag_shader,
+                   SPrintF("%s Fragment Shader", link.label.c_str()));
+
+  gl.ShaderSourceMapping(link.vert_shader, *link.vert_mapping,
+                         descriptor.GetSpecializationConstants());
+  gl.ShaderSourceMapping(link.frag_shader, *link.frag_mapping,
+                         descriptor.GetSpecializationConstants());
+
+  gl.CompileShader(link.vert_shader);
+  gl.CompileShader(link.frag_shader);
+
+  gl.AttachShader(*program, link.vert_shader);
+  gl.AttachShader(*program, link.frag_shader);
+
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    gl.BindAttribLocation(*program,                                   //
+                          static_cast<GLuint>(stage_input.location),  //
+                          stage_input.name                            //
+    );
+  }
+
+  gl.LinkProgram(*program);
+  return link;
+}
+
+// Whether querying the status of the link would not block. Without
+// KHR_parallel_shader_compile links are only ever finished synchronously.
+static bool IsLinkComplete(const ProcTableGLES& gl,
+                           GLuint program,
+                           const ProgramLink& link) {
+  if (link.loaded_from_cache) {
+    return true;
+  }
+  GLint completed = GL_FALSE;
+  gl.GetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+static bool FinishLinkProgram(
+    const ReactorGLES& reactor,
+    GLuint program,
+    const ProgramLink& link,
+    const ProgramBinaryCacheGLES* program_binary_cache) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
 
-  fml::ScopedCleanupClosure delete_vert_shader(
-      [&gl, vert_shader]() { gl.DeleteShader(vert_shader); });
-  fml::ScopedCleanupClosure delete_frag_shader(
-      [&gl, frag_shader]() { gl.DeleteShader(frag_shader); });
+  if (link.loaded_from_cache) {
+    return true;
+  }
 
-  gl.ShaderSourceMapping(vert_shader, *vert_mapping);
-  gl.ShaderSourceMapping(frag_shader, *frag_mapping);
+  const auto& gl = reactor.GetProcTable();
 
-  gl.CompileShader(vert_shader);
-  gl.CompileShader(frag_shader);
+  fml::ScopedCleanupClosure delete_shaders([&gl, program, &link]() {
+    gl.DetachShader(program, link.vert_shader);
+    gl.DetachShader(program, link.frag_shader);
+    gl.DeleteShader(link.vert_shader);
+    gl.DeleteShader(link.frag_shader);
+  });
 
   GLint vert_status = GL_FALSE;
   GLint frag_status = GL_FALSE;
 
-  gl.GetShaderiv(vert_shader, GL_COMPILE_STATUS, &vert_status);
-  gl.GetShaderiv(frag_shader, GL_COMPILE_STATUS, &frag_status);
+  gl.GetShaderiv(link.vert_shader, GL_COMPILE_STATUS, &vert_status);
+  gl.GetShaderiv(link.frag_shader, GL_COMPILE_STATUS, &frag_status);
 
   if (vert_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, vert_shader, descriptor.GetLabel(),
-                                *vert_mapping, ShaderStage::kVertex);
+    LogShaderCompilationFailure(gl, link.vert_shader, link.label,
+                                *link.vert_mapping, ShaderStage::kVertex);
     return false;
   }
 
   if (frag_status != GL_TRUE) {
-    LogShaderCompilationFailure(gl, frag_shader, descriptor.GetLabel(),
-                                *frag_mapping, ShaderStage::kFragment);
+    LogShaderCompilationFailure(gl, link.frag_shader, link.label,
+                                *link.frag_mapping, ShaderStage::kFragment);
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+
+  if (link_status != GL_TRUE) {
+    VALIDATION_LOG << "Could not link shader program: "
+                   << gl.GetProgramInfoLogString(program);
     return false;
   }
 
-  gl.AttachShader(*program, vert_shader);
-  gl.AttachShader(*program, frag_shader);
+  if (link.program_key.has_value()) {
+    program_binary_cache->StoreProgram(gl, program, *link.program_key);
+  }
+  return true;
+}
 
-  fml::ScopedCleanupClosure detach_vert_shader(
-      [&gl, program = *program, vert_shader]() {
-        gl.DetachShader(program, vert_shader);
-      });
-  fml::ScopedCleanupClosure detach_frag_shader(
-      [&gl, program = *program, frag_shader]() {
-        gl.DetachShader(program, frag_shader);
-      });
+//------------------------------------------------------------------------------
+/// A pipeline whose program is being linked. It is finished by whichever
+/// comes first: the reactor polling the driver until the link completes in
+/// the background, or the pipeline being waited for.
+///
+class PendingPipelineGLES {
+ public:
+  using Promise = std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>;
+
+  explicit PendingPipelineGLES(
+      std::shared_ptr<const ProgramBinaryCacheGLES> program_binary_cache)
+      : program_binary_cache_(std::move(program_binary_cache)) {}
+
+  std::shared_future<std::shared_ptr<Pipeline<PipelineDescriptor>>>
+  GetFuture() {
+    Lock lock(mutex_);
+    return promise_.get_future();
+  }
 
-  for (const auto& stage_input :
-       descriptor.GetVertexDescriptor()->GetStageInputs()) {
-    gl.BindAttribLocation(*program,                                   //
-                          static_cast<GLuint>(stage_input.location),  //
-                          stage_input.name                            //
-    );
+  const ProgramBinaryCacheGLES* GetProgramBinaryCache() const {
+    return program_binary_cache_.get();
   }
 
-  gl.LinkProgram(*program);
+  void Fail() {
+    Lock lock(mutex_);
+    if (!is_finished_) {
+      is_finished_ = true;
+      promise_.set_value(nullptr);
+    }
+  }
 
-  GLint link_status = GL_FALSE;
-  gl.GetProgramiv(*program, GL_LINK_STATUS, &link_status);
+  void Start(std::shared_ptr<PipelineGLES> pipeline, ProgramLink link) {
+    Lock lock(mutex_);
+    pipeline_ = std::move(pipeline);
+    link_ = std::move(link);
+  }
 
-  if (link_status != GL_TRUE) {
-    VALIDATION_LOG << "Could not link shader program: "
-                   << gl.GetProgramInfoLogString(*program);
-    return false;
+  bool IsReadyToFinish(const ReactorGLES& reactor) const {
+    Lock lock(mutex_);
+    if (is_finished_ || !pipeline_) {
+      return true;
+    }
+    auto program = reactor.GetGLHandle(pipeline_->GetProgramHandle());
+    return !program.has_value() ||
+           IsLinkComplete(reactor.GetProcTable(), *program, link_);
   }
-  return true;
-}
+
+  void Finish(const ReactorGLES& reactor) {
+    Lock lock(mutex_);
+    if (is_finished_ || !pipeline_) {
+      return;
+    }
+    is_finished_ = true;
+    auto pipeline = std::move(pipeline_);
+    pipeline_ = nullptr;
+    auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+    if (!program.has_value()) {
+      promise_.set_value(nullptr);
+      VALIDATION_LOG << "Could not obtain program handle.";
+      return;
+    }
+    if (!FinishLinkProgram(reactor, *program, link_,
+                           program_binary_cache_.get())) {
+      promise_.set_value(nullptr);
+      VALIDATION_LOG << "Could not link pipeline program.";
+      return;
+    }
+    if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
+                                         program.value())) {
+      promise_.set_value(nullptr);
+      VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
+      return;
+    }
+    if (!pipeline->IsValid()) {
+      promise_.set_value(nullptr);
+      VALIDATION_LOG << "Pipeline validation checks failed.";
+      return;
+    }
+    promise_.set_value(std::move(pipeline));
+  }
+
+ private:
+  const std::shared_ptr<const ProgramBinaryCacheGLES> program_binary_cache_;
+  mutable Mutex mutex_;
+  Promise promise_ IPLR_GUARDED_BY(mutex_);
+  bool is_finished_ IPLR_GUARDED_BY(mutex_) = false;
+  std::shared_ptr<PipelineGLES> pipeline_ IPLR_GUARDED_BY(mutex_);
+  ProgramLink link_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PendingPipelineGLES);
+};
 
 // |PipelineLibrary|
 bool PipelineLibraryGLES::IsValid() const {
@@ -196,53 +387,59 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
         RealizedFuture<std::shared_ptr<Pipeline<PipelineDescriptor>>>(nullptr)};
   }
 
-  auto promise = std::make_shared<
-      std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>();
+  auto pending = std::make_shared<PendingPipelineGLES>(program_binary_cache_);
   auto pipeline_future =
-      PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
+      PipelineFuture<PipelineDescriptor>{descriptor, pending->GetFuture()};
+  // Links that complete in the background are finished as soon as anything
+  // waits for them.
+  pipeline_future.finish_now = [reactor_ptr = reactor_, pending]() {
+    [[maybe_unused]] auto result =
+        reactor_ptr->AddOperation([pending](const ReactorGLES& reactor) {
+          pending->Finish(reactor);
+        });
+  };
   pipelines_[descriptor] = pipeline_future;
+  FML_PERFORMANCE_COUNTER_ADD("pipelines.created", 1);
   auto weak_this = weak_from_this();
 
   auto result = reactor_->AddOperation(
-      [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
+      [pending, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
        frag_function](const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
-          promise->set_value(nullptr);
+          pending->Fail();
           VALIDATION_LOG << "Library was collected before a pending pipeline "
                             "creation could finish.";
           return;
         }
         auto pipeline = std::shared_ptr<PipelineGLES>(
             new PipelineGLES(reactor_ptr, strong_this, descriptor));
-        auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-        if (!program.has_value()) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not obtain program handle.";
-          return;
-        }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
+        auto link = StartLinkProgram(reactor,                          //
+                                     pipeline,                         //
+                                     vert_function,                    //
+                                     frag_function,                    //
+                                     pending->GetProgramBinaryCache()  //
         );
-        if (!link_result) {
-          promise->set_value(nullptr);
+        if (!link.has_value()) {
+          pending->Fail();
           VALIDATION_LOG << "Could not link pipeline program.";
           return;
         }
-        if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
-                                             program.value())) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
-          return;
-        }
-        if (!pipeline->IsValid()) {
-          promise->set_value(nullptr);
-          VALIDATION_LOG << "Pipeline validation checks failed.";
+        pending->Start(std::move(pipeline), std::move(link.value()));
+        // Without KHR_parallel_shader_compile, the status of the link can't
+        // be queried without blocking, so it is finished right away.
+        if (!reactor.GetProcTable().MaxShaderCompilerThreadsKHR.IsAvailable()) {
+          pending->Finish(reactor);
           return;
         }
-        promise->set_value(std::move(pipeline));
+        [[maybe_unused]] auto added = reactor_ptr->AddPollingOperation(
+            [pending](const ReactorGLES& polling_reactor) {
+              if (!pending->IsReadyToFinish(polling_reactor)) {
+                return false;
+              }
+              pending->Finish(polling_reactor);
+              return true;
+            });
       });
   FML_CHECK(result);
 
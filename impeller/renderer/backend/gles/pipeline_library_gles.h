@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -22,8 +26,9 @@ class PipelineLibraryGLES final : public PipelineLibrary {
 
   ReactorGLES::Ref reactor_;
   PipelineMap pipelines_;
+  std::shared_ptr<const ProgramBinaryCacheGLES> program_binary_cache_;
 
-  PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  PipelineLibraryGLES(ReactorGLES::Ref reactor, fml::UniqueFD cache_directory);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "impeller/base/allocation.h"
@@ -111,6 +112,38 @@ ProcTableGLES::ProcTableGLES(Resolver resolver) {
     DiscardFramebufferEXT.Reset();
   }
 
+  if (!description_->HasExtension("GL_EXT_disjoint_timer_query")) {
+    GenQueriesEXT.Reset();
+    DeleteQueriesEXT.Reset();
+    BeginQueryEXT.Reset();
+    EndQueryEXT.Reset();
+    GetQueryObjectuivEXT.Reset();
+    GetQueryObjectui64vEXT.Reset();
+  }
+
+  // Program binaries are core in OpenGL ES 3.0. Desktop GL only has them
+  // through extensions that aren't resolved here.
+  if (!description_->IsES() ||
+      !description_->GetGlVersion().IsAtLeast(Version(3, 0, 0))) {
+    GetProgramBinary.Reset();
+    ProgramBinary.Reset();
+    ProgramParameteri.Reset();
+  }
+
+  if (!description_->HasExtension("GL_OES_get_program_binary")) {
+    GetProgramBinaryOES.Reset();
+    ProgramBinaryOES.Reset();
+  }
+
+  if (!description_->HasExtension("GL_KHR_parallel_shader_compile")) {
+    MaxShaderCompilerThreadsKHR.Reset();
+  } else {
+    // Let the driver compile and link programs on as many threads as it
+    // likes. Whether a link is done is then queried with
+    // GL_COMPLETION_STATUS_KHR instead of blocking on its status.
+    MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+  }
+
   capabilities_ = std::make_unique<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
@@ -122,12 +155,37 @@ bool ProcTableGLES::IsValid() const {
   return is_valid_;
 }
 
-void ProcTableGLES::ShaderSourceMapping(GLuint shader,
-                                        const fml::Mapping& mapping) const {
-  const GLchar* sources[] = {
-      reinterpret_cast<const GLchar*>(mapping.GetMapping())};
-  const GLint lengths[] = {static_cast<GLint>(mapping.GetSize())};
-  ShaderSource(shader, 1u, sources, lengths);
+void ProcTableGLES::ShaderSourceMapping(
+    GLuint shader,
+    const fml::Mapping& mapping,
+    const std::vector<Scalar>& defines) const {
+  const auto* source = reinterpret_cast<const GLchar*>(mapping.GetMapping());
+  const auto size = mapping.GetSize();
+  // The version directive must come first, so the defines go right after it.
+  const GLchar* version_end = nullptr;
+  if (!defines.empty()) {
+    version_end = static_cast<const GLchar*>(::memchr(source, '\n', size));
+  }
+  if (version_end == nullptr) {
+    const GLchar* sources[] = {source};
+    const GLint lengths[] = {static_cast<GLint>(size)};
+    ShaderSource(shader, 1u, sources, lengths);
+    return;
+  }
+
+  std::stringstream stream;
+  for (size_t i = 0; i < defines.size(); i++) {
+    stream << "#define SPIRV_CROSS_CONSTANT_ID_" << i << " "
+           << std::to_string(defines[i]) << "\n";
+  }
+  const auto defines_source = stream.str();
+
+  const auto header_length = version_end - source + 1;
+  const GLchar* sources[] = {source, defines_source.data(), version_end + 1};
+  const GLint lengths[] = {static_cast<GLint>(header_length),
+                           static_cast<GLint>(defines_source.size()),
+                           static_cast<GLint>(size - header_length)};
+  ShaderSource(shader, 3u, sources, lengths);
 }
 
 const DescriptionGLES* ProcTableGLES::GetDescription() const {
@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 #include "impeller/renderer/backend/gles/description_gles.h"
 #include "impeller/renderer/backend/gles/gles.h"
@@ -94,6 +95,7 @@ struct GLProc {
   PROC(BlendEquationSeparate);               \
   PROC(BlendFuncSeparate);                   \
   PROC(BufferData);                          \
+  PROC(BufferSubData);                       \
   PROC(CheckFramebufferStatus);              \
   PROC(Clear);                               \
   PROC(ClearColor);                          \
@@ -101,6 +103,7 @@ struct GLProc {
   PROC(ClearStencil);                        \
   PROC(ColorMask);                           \
   PROC(CompileShader);                       \
+  PROC(CompressedTexImage2D);                \
   PROC(CreateProgram);                       \
   PROC(CreateShader);                        \
   PROC(CullFace);                            \
@@ -168,13 +171,26 @@ struct GLProc {
   PROC(Viewport);                            \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                   \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC) \
   PROC(DiscardFramebufferEXT);           \
   PROC(PushDebugGroupKHR);               \
   PROC(PopDebugGroupKHR);                \
-  PROC(ObjectLabelKHR);
+  PROC(ObjectLabelKHR);                  \
+  PROC(GenQueriesEXT);                   \
+  PROC(DeleteQueriesEXT);                \
+  PROC(BeginQueryEXT);                   \
+  PROC(EndQueryEXT);                     \
+  PROC(GetQueryObjectuivEXT);            \
+  PROC(GetQueryObjectui64vEXT);         \
+  PROC(GetProgramBinaryOES);             \
+  PROC(ProgramBinaryOES);                \
+  PROC(MaxShaderCompilerThreadsKHR);
 
 enum class DebugResourceType {
   kTexture,
@@ -203,7 +219,16 @@ class ProcTableGLES {
 
   bool IsValid() const;
 
-  void ShaderSourceMapping(GLuint shader, const fml::Mapping& mapping) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the source of the shader to the mapping, with the
+  ///             specialization constants defined after the version
+  ///             directive. The value at an index defines
+  ///             `SPIRV_CROSS_CONSTANT_ID_<index>`, which the cross compiled
+  ///             shader otherwise defaults.
+  ///
+  void ShaderSourceMapping(GLuint shader,
+                           const fml::Mapping& mapping,
+                           const std::vector<Scalar>& defines = {}) const;
 
   const DescriptionGLES* GetDescription() const;
 
@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+struct ProgramBinaryHeaderGLES {
+  // Bump the version if the layout of the header or the key changes.
+  uint32_t magic = 0x49504742;  // IPGB
+  uint32_t version = 1u;
+  uint64_t driver_hash = 0u;
+  uint64_t program_key = 0u;
+  uint32_t binary_format = 0u;
+  uint32_t reserved = 0u;
+  uint64_t data_size = 0u;
+};
+
+}  // namespace
+
+static std::string GetProgramFileName(uint64_t program_key) {
+  std::stringstream stream;
+  stream << "flutter.impeller.glprogram." << std::hex << std::setw(16)
+         << std::setfill('0') << program_key;
+  return stream.str();
+}
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(const ProcTableGLES& gl,
+                                               fml::UniqueFD cache_directory)
+    : cache_directory_(std::move(cache_directory)) {
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  if (gl.GetCapabilities()->num_program_binary_formats == 0u) {
+    return;
+  }
+  if (gl.GetProgramBinary.IsAvailable() && gl.ProgramBinary.IsAvailable()) {
+    use_oes_ = false;
+  } else if (gl.GetProgramBinaryOES.IsAvailable() &&
+             gl.ProgramBinaryOES.IsAvailable()) {
+    use_oes_ = true;
+  } else {
+    return;
+  }
+  // The description covers the vendor, renderer and driver version, any of
+  // which changing makes the stored binaries unusable.
+  driver_hash_ = std::hash<std::string>{}(gl.GetDescription()->GetString());
+  is_valid_ = true;
+}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsValid() const {
+  return is_valid_;
+}
+
+void ProgramBinaryCacheGLES::PrepareProgram(const ProcTableGLES& gl,
+                                            GLuint program) const {
+  if (!is_valid_ || !gl.ProgramParameteri.IsAvailable()) {
+    return;
+  }
+  gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         uint64_t program_key) const {
+  if (!is_valid_) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "LoadProgramBinary");
+
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      cache_directory_, GetProgramFileName(program_key));
+  if (!mapping || mapping->GetSize() < sizeof(ProgramBinaryHeaderGLES)) {
+    return false;
+  }
+
+  const ProgramBinaryHeaderGLES expected;
+  ProgramBinaryHeaderGLES header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  const auto data_size = mapping->GetSize() - sizeof(header);
+  if (header.magic != expected.magic ||      //
+      header.version != expected.version ||  //
+      header.driver_hash != driver_hash_ ||  //
+      header.program_key != program_key ||   //
+      header.data_size != data_size          //
+  ) {
+    return false;
+  }
+
+  const auto* data = mapping->GetMapping() + sizeof(header);
+  if (use_oes_) {
+    gl.ProgramBinaryOES(program, header.binary_format, data,
+                        static_cast<GLint>(data_size));
+  } else {
+    gl.ProgramBinary(program, header.binary_format, data,
+                     static_cast<GLsizei>(data_size));
+  }
+
+  // Drivers are allowed to reject binaries for any reason. The program then
+  // isn't linked and is compiled from source instead.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  return link_status == GL_TRUE;
+}
+
+void ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          uint64_t program_key) const {
+  if (!is_valid_) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "StoreProgramBinary");
+
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return;
+  }
+
+  ProgramBinaryHeaderGLES header;
+  header.driver_hash = driver_hash_;
+  header.program_key = program_key;
+
+  std::vector<uint8_t> data(sizeof(header) + binary_length);
+  GLsizei written_length = 0;
+  GLenum binary_format = 0;
+  if (use_oes_) {
+    gl.GetProgramBinaryOES(program, binary_length, &written_length,
+                           &binary_format, data.data() + sizeof(header));
+  } else {
+    gl.GetProgramBinary(program, binary_length, &written_length,
+                        &binary_format, data.data() + sizeof(header));
+  }
+  if (written_length <= 0 || written_length > binary_length) {
+    return;
+  }
+
+  header.binary_format = binary_format;
+  header.data_size = written_length;
+  data.resize(sizeof(header) + written_length);
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  fml::NonOwnedMapping mapping(data.data(), data.size());
+  if (!fml::WriteAtomically(cache_directory_,
+                            GetProgramFileName(program_key).c_str(),
+                            mapping)) {
+    FML_LOG(ERROR) << "Could not write program binary to the cache.";
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists linked program binaries in a cache directory so that
+///             programs don't have to be compiled from source again on the
+///             next launch.
+///
+///             Each program is stored in its own file, named by a key that
+///             covers everything that went into linking it. The file also
+///             records the driver that produced the binary. Binaries from
+///             another driver, truncated files and binaries the driver
+///             refuses are ignored, and the program is compiled from source
+///             and stored again.
+///
+///             All methods must be called on a thread with a current context.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  ProgramBinaryCacheGLES(const ProcTableGLES& gl,
+                         fml::UniqueFD cache_directory);
+
+  ~ProgramBinaryCacheGLES();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets up a program that hasn't been linked yet so that its
+  ///             binary can be stored once it is.
+  ///
+  void PrepareProgram(const ProcTableGLES& gl, GLuint program) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the stored binary of the program with the given key.
+  ///
+  /// @return     If the program is linked from the stored binary. If not, it
+  ///             has to be compiled and linked from source.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl,
+                   GLuint program,
+                   uint64_t program_key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores the binary of a linked program under the given key.
+  ///
+  void StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    uint64_t program_key) const;
+
+ private:
+  const fml::UniqueFD cache_directory_;
+  uint64_t driver_hash_ = 0u;
+  bool use_oes_ = false;
+  bool is_valid_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgramBinaryCacheGLES);
+};
+
+}  // namespace impeller
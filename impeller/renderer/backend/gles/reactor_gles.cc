@@ -5,12 +5,19 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 
 #include <algorithm>
+#include <iterator>
+#include <map>
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 
 namespace impeller {
 
+// The most names of collected buffers that are kept around to be handed out
+// again. Pooled buffers keep their storage until it is specified again, so
+// this is kept small.
+static constexpr size_t kMaxReusableBufferNames = 16u;
+
 ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
     : proc_table_(std::move(gl)) {
   if (!proc_table_ || !proc_table_->IsValid()) {
@@ -80,55 +87,84 @@ bool ReactorGLES::AddOperation(Operation operation) {
   return true;
 }
 
-static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
-                                            HandleType type) {
-  GLuint handle = GL_NONE;
+bool ReactorGLES::AddPollingOperation(PollingOperation operation) {
+  if (!operation) {
+    return false;
+  }
+  Lock ops_lock(ops_mutex_);
+  polling_ops_.emplace_back(std::move(operation));
+  return true;
+}
+
+static bool CreateGLHandles(const ProcTableGLES& gl,
+                            HandleType type,
+                            GLuint* handles,
+                            GLsizei count) {
   switch (type) {
     case HandleType::kUnknown:
-      return std::nullopt;
+      return false;
     case HandleType::kTexture:
-      gl.GenTextures(1u, &handle);
-      return handle;
+      gl.GenTextures(count, handles);
+      return true;
     case HandleType::kBuffer:
-      gl.GenBuffers(1u, &handle);
-      return handle;
+      gl.GenBuffers(count, handles);
+      return true;
     case HandleType::kProgram:
-      return gl.CreateProgram();
+      for (GLsizei i = 0; i < count; i++) {
+        handles[i] = gl.CreateProgram();
+      }
+      return true;
     case HandleType::kRenderBuffer:
-      gl.GenRenderbuffers(1u, &handle);
-      return handle;
+      gl.GenRenderbuffers(count, handles);
+      return true;
     case HandleType::kFrameBuffer:
-      gl.GenFramebuffers(1u, &handle);
-      return handle;
+      gl.GenFramebuffers(count, handles);
+      return true;
   }
-  return std::nullopt;
+  return false;
 }
 
-static bool CollectGLHandle(const ProcTableGLES& gl,
-                            HandleType type,
-                            GLuint handle) {
+static bool CollectGLHandles(const ProcTableGLES& gl,
+                             HandleType type,
+                             const GLuint* handles,
+                             GLsizei count) {
   switch (type) {
     case HandleType::kUnknown:
       return false;
     case HandleType::kTexture:
-      gl.DeleteTextures(1u, &handle);
+      gl.DeleteTextures(count, handles);
       return true;
     case HandleType::kBuffer:
-      gl.DeleteBuffers(1u, &handle);
+      gl.DeleteBuffers(count, handles);
       return true;
     case HandleType::kProgram:
-      gl.DeleteProgram(handle);
+      for (GLsizei i = 0; i < count; i++) {
+        gl.DeleteProgram(handles[i]);
+      }
       return true;
     case HandleType::kRenderBuffer:
-      gl.DeleteRenderbuffers(1u, &handle);
+      gl.DeleteRenderbuffers(count, handles);
       return true;
     case HandleType::kFrameBuffer:
-      gl.DeleteFramebuffers(1u, &handle);
+      gl.DeleteFramebuffers(count, handles);
       return true;
   }
   return false;
 }
 
+std::optional<GLuint> ReactorGLES::CreateGLHandle(HandleType type) {
+  if (type == HandleType::kBuffer && !reusable_buffer_names_.empty()) {
+    const auto name = reusable_buffer_names_.back();
+    reusable_buffer_names_.pop_back();
+    return name;
+  }
+  GLuint handle = GL_NONE;
+  if (!CreateGLHandles(GetProcTable(), type, &handle, 1)) {
+    return std::nullopt;
+  }
+  return handle;
+}
+
 HandleGLES ReactorGLES::CreateHandle(HandleType type) {
   if (type == HandleType::kUnknown) {
     return HandleGLES::DeadHandle();
@@ -138,9 +174,8 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
     return HandleGLES::DeadHandle();
   }
   WriterLock handles_lock(handles_mutex_);
-  auto gl_handle = CanReactOnCurrentThread()
-                       ? CreateGLHandle(GetProcTable(), type)
-                       : std::nullopt;
+  auto gl_handle =
+      CanReactOnCurrentThread() ? CreateGLHandle(type) : std::nullopt;
   handles_[new_handle] = LiveHandle{gl_handle};
   return new_handle;
 }
@@ -162,6 +197,7 @@ bool ReactorGLES::React() {
       return false;
     }
   }
+  PollOps();
   return true;
 }
 
@@ -196,28 +232,62 @@ bool ReactorGLES::ConsolidateHandles() {
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
   std::vector<HandleGLES> handles_to_delete;
+  // Names are created and collected in one call per handle type.
+  std::map<HandleType, std::vector<GLuint>> names_to_collect;
+  std::map<HandleType, std::vector<LiveHandle*>> handles_to_create;
   for (auto& handle : handles_) {
     // Collect dead handles.
     if (handle.second.pending_collection) {
       // This could be false if the handle was created and collected without
       // use. We still need to get rid of map entry.
       if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
+        const auto name = handle.second.name.value();
+        if (handle.first.type == HandleType::kBuffer &&
+            reusable_buffer_names_.size() < kMaxReusableBufferNames) {
+          reusable_buffer_names_.push_back(name);
+        } else {
+          names_to_collect[handle.first.type].push_back(name);
+        }
       }
       handles_to_delete.push_back(handle.first);
       continue;
     }
     // Create live handles.
     if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
-      if (!gl_handle) {
-        VALIDATION_LOG << "Could not create GL handle.";
-        return false;
-      }
-      handle.second.name = gl_handle;
+      handles_to_create[handle.first.type].push_back(&handle.second);
+    }
+  }
+
+  for (const auto& [type, names] : names_to_collect) {
+    CollectGLHandles(gl, type, names.data(),
+                     static_cast<GLsizei>(names.size()));
+  }
+
+  for (const auto& [type, live_handles] : handles_to_create) {
+    std::vector<GLuint> names;
+    names.reserve(live_handles.size());
+    while (type == HandleType::kBuffer && !reusable_buffer_names_.empty() &&
+           names.size() < live_handles.size()) {
+      names.push_back(reusable_buffer_names_.back());
+      reusable_buffer_names_.pop_back();
     }
+    const auto reused_count = names.size();
+    names.resize(live_handles.size());
+    if (names.size() > reused_count &&
+        !CreateGLHandles(gl, type, names.data() + reused_count,
+                         static_cast<GLsizei>(names.size() - reused_count))) {
+      VALIDATION_LOG << "Could not create GL handle.";
+      return false;
+    }
+    for (size_t i = 0; i < live_handles.size(); i++) {
+      live_handles[i]->name = names[i];
+    }
+  }
+
+  for (auto& handle : handles_) {
     // Set pending debug labels.
-    if (handle.second.pending_debug_label.has_value()) {
+    if (handle.second.pending_debug_label.has_value() &&
+        handle.second.name.has_value()) {
       if (gl.SetDebugLabel(ToDebugResourceType(handle.first.type),
                            handle.second.name.value(),
                            handle.second.pending_debug_label.value())) {
@@ -225,6 +295,7 @@ bool ReactorGLES::ConsolidateHandles() {
       }
     }
   }
+
   for (const auto& handle_to_delete : handles_to_delete) {
     handles_.erase(handle_to_delete);
   }
@@ -244,9 +315,41 @@ bool ReactorGLES::FlushOps() {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
     op(*this);
   }
+  // Hand the storage back so that queueing operations doesn't allocate again
+  // on the next frame.
+  ops.clear();
+  {
+    Lock ops_lock(ops_mutex_);
+    if (ops_.empty() && ops_.capacity() < ops.capacity()) {
+      std::swap(ops_, ops);
+    }
+  }
   return true;
 }
 
+void ReactorGLES::PollOps() {
+  std::vector<PollingOperation> polling_ops;
+  {
+    Lock ops_lock(ops_mutex_);
+    if (polling_ops_.empty()) {
+      return;
+    }
+    std::swap(polling_ops_, polling_ops);
+  }
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  polling_ops.erase(std::remove_if(polling_ops.begin(), polling_ops.end(),
+                                   [&](const PollingOperation& op) {
+                                     return op(*this);
+                                   }),
+                    polling_ops.end());
+  // Operations added while polling are kept after the ones that were polled.
+  Lock ops_lock(ops_mutex_);
+  polling_ops.insert(polling_ops.end(),
+                     std::make_move_iterator(polling_ops_.begin()),
+                     std::make_move_iterator(polling_ops_.end()));
+  std::swap(polling_ops_, polling_ops);
+}
+
 void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   if (!can_set_debug_labels_) {
     return;
@@ -53,6 +53,17 @@ class ReactorGLES {
   using Operation = std::function<void(const ReactorGLES& reactor)>;
   [[nodiscard]] bool AddOperation(Operation operation);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an operation that is performed once at the end of every
+  ///             reaction until it returns true. Used to wait on work the
+  ///             driver does in the background without blocking on it.
+  ///
+  ///             Unlike |AddOperation|, this does not attempt a reaction, so
+  ///             it may be called from within operations.
+  ///
+  using PollingOperation = std::function<bool(const ReactorGLES& reactor)>;
+  [[nodiscard]] bool AddPollingOperation(PollingOperation operation);
+
   [[nodiscard]] bool React();
 
  private:
@@ -73,6 +84,7 @@ class ReactorGLES {
 
   mutable Mutex ops_mutex_;
   std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  std::vector<PollingOperation> polling_ops_ IPLR_GUARDED_BY(ops_mutex_);
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -82,6 +94,9 @@ class ReactorGLES {
                                          HandleGLES::Equal>;
   mutable RWMutex handles_mutex_;
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // Names of collected buffers that are handed out to new buffer handles
+  // instead of generating new names.
+  std::vector<GLuint> reusable_buffer_names_ IPLR_GUARDED_BY(handles_mutex_);
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -98,8 +113,13 @@ class ReactorGLES {
 
   bool ConsolidateHandles();
 
+  std::optional<GLuint> CreateGLHandle(HandleType type)
+      IPLR_REQUIRES(handles_mutex_);
+
   bool FlushOps();
 
+  void PollOps();
+
   FML_DISALLOW_COPY_AND_ASSIGN(ReactorGLES);
 };
 
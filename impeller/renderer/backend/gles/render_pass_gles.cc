@@ -9,6 +9,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
@@ -233,6 +234,7 @@ struct RenderPassData {
 
   gl.Clear(clear_bits);
 
+  TextureUnitStateGLES texture_units;
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -396,10 +398,11 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Bind uniform data.
     ///
-    if (!vertex_desc_gles->BindUniformData(gl,                        //
-                                           *transients_allocator,     //
-                                           command.vertex_bindings,   //
-                                           command.fragment_bindings  //
+    if (!vertex_desc_gles->BindUniformData(gl,                         //
+                                           *transients_allocator,      //
+                                           command.vertex_bindings,    //
+                                           command.fragment_bindings,  //
+                                           texture_units               //
                                            )) {
       return false;
     }
@@ -67,6 +67,28 @@ static GLint ToAddressMode(SamplerAddressMode mode) {
   FML_UNREACHABLE();
 }
 
+TextureGLES::SamplerParameters SamplerGLES::GetSamplerParameters(
+    const TextureGLES& texture) const {
+  const auto& desc = GetDescriptor();
+
+  std::optional<MipFilter> mip_filter = std::nullopt;
+  if (texture.GetTextureDescriptor().mip_count > 1) {
+    mip_filter = desc.mip_filter;
+  }
+
+  TextureGLES::SamplerParameters parameters;
+  parameters.min_filter = ToParam(desc.min_filter, mip_filter);
+  parameters.mag_filter = ToParam(desc.mag_filter);
+  parameters.wrap_s = ToAddressMode(desc.width_address_mode);
+  parameters.wrap_t = ToAddressMode(desc.height_address_mode);
+  return parameters;
+}
+
+bool SamplerGLES::IsBoundTextureConfigured(const TextureGLES& texture) const {
+  return texture.sampler_parameters_.has_value() &&
+         texture.sampler_parameters_.value() == GetSamplerParameters(texture);
+}
+
 bool SamplerGLES::ConfigureBoundTexture(const TextureGLES& texture,
                                         const ProcTableGLES& gl) const {
   if (!IsValid()) {
@@ -85,21 +107,27 @@ bool SamplerGLES::ConfigureBoundTexture(const TextureGLES& texture,
   if (!target.has_value()) {
     return false;
   }
-  const auto& desc = GetDescriptor();
+  const auto parameters = GetSamplerParameters(texture);
+  const auto& last = texture.sampler_parameters_;
 
-  std::optional<MipFilter> mip_filter = std::nullopt;
-  if (texture.GetTextureDescriptor().mip_count > 1) {
-    mip_filter = desc.mip_filter;
+  if (!last.has_value() || last->min_filter != parameters.min_filter) {
+    gl.TexParameteri(target.value(), GL_TEXTURE_MIN_FILTER,
+                     parameters.min_filter);
+  }
+  if (!last.has_value() || last->mag_filter != parameters.mag_filter) {
+    gl.TexParameteri(target.value(), GL_TEXTURE_MAG_FILTER,
+                     parameters.mag_filter);
+  }
+  if (!last.has_value() || last->wrap_s != parameters.wrap_s) {
+    gl.TexParameteri(target.value(), GL_TEXTURE_WRAP_S, parameters.wrap_s);
+  }
+  if (!last.has_value() || last->wrap_t != parameters.wrap_t) {
+    gl.TexParameteri(target.value(), GL_TEXTURE_WRAP_T, parameters.wrap_t);
   }
 
-  gl.TexParameteri(target.value(), GL_TEXTURE_MIN_FILTER,
-                   ToParam(desc.min_filter, mip_filter));
-  gl.TexParameteri(target.value(), GL_TEXTURE_MAG_FILTER,
-                   ToParam(desc.mag_filter));
-  gl.TexParameteri(target.value(), GL_TEXTURE_WRAP_S,
-                   ToAddressMode(desc.width_address_mode));
-  gl.TexParameteri(target.value(), GL_TEXTURE_WRAP_T,
-                   ToAddressMode(desc.height_address_mode));
+  if (!texture.IsWrapped()) {
+    texture.sampler_parameters_ = parameters;
+  }
   return true;
 }
 
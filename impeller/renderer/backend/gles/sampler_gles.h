@@ -7,10 +7,10 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/sampler.h"
+#include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
 
-class TextureGLES;
 class SamplerLibraryGLES;
 class ProcTableGLES;
 
@@ -19,6 +19,18 @@ class SamplerGLES final : public Sampler,
  public:
   ~SamplerGLES();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the sampler state of the texture already matches
+  ///             this sampler, in which case it doesn't have to be configured
+  ///             again.
+  ///
+  bool IsBoundTextureConfigured(const TextureGLES& texture) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set the sampler state of the texture bound to the active
+  ///             texture unit. Parameters that already match this sampler
+  ///             are not set again.
+  ///
   bool ConfigureBoundTexture(const TextureGLES& texture,
                              const ProcTableGLES& gl) const;
 
@@ -30,6 +42,9 @@ class SamplerGLES final : public Sampler,
   // |Sampler|
   bool IsValid() const override;
 
+  TextureGLES::SamplerParameters GetSamplerParameters(
+      const TextureGLES& texture) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerGLES);
 };
 
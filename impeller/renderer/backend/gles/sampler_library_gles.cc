@@ -17,8 +17,8 @@ SamplerLibraryGLES::SamplerLibraryGLES() = default;
 SamplerLibraryGLES::~SamplerLibraryGLES() = default;
 
 // |SamplerLibrary|
-std::shared_ptr<const Sampler> SamplerLibraryGLES::GetSampler(
-    SamplerDescriptor descriptor) {
+std::shared_ptr<const Sampler> SamplerLibraryGLES::CreateSampler(
+    const SamplerDescriptor& descriptor) {
   // TODO(bdero): Change this validation once optional support for kDecal is
   //              added to the OpenGLES backend:
   //              https://github.com/flutter/flutter/issues/129358
@@ -30,12 +30,7 @@ std::shared_ptr<const Sampler> SamplerLibraryGLES::GetSampler(
     return nullptr;
   }
 
-  auto found = samplers_.find(descriptor);
-  if (found != samplers_.end()) {
-    return found->second;
-  }
-  return samplers_[descriptor] =
-             std::shared_ptr<SamplerGLES>(new SamplerGLES(descriptor));
+  return std::shared_ptr<SamplerGLES>(new SamplerGLES(descriptor));
 }
 
 }  // namespace impeller
@@ -18,13 +18,11 @@ class SamplerLibraryGLES final : public SamplerLibrary {
  private:
   friend class ContextGLES;
 
-  SamplerMap samplers_;
-
   SamplerLibraryGLES();
 
   // |SamplerLibrary|
-  std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) override;
+  std::shared_ptr<const Sampler> CreateSampler(
+      const SamplerDescriptor& descriptor) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibraryGLES);
 };
@@ -90,6 +90,7 @@ struct TexImage2DData {
   GLint internal_format = 0;
   GLenum external_format = GL_NONE;
   GLenum type = GL_NONE;
+  bool is_compressed = false;
   std::shared_ptr<const fml::Mapping> data;
 
   explicit TexImage2DData(PixelFormat pixel_format) {
@@ -126,6 +127,11 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      // The storage of compressed textures is allocated by the upload of
+      // their contents.
+      case PixelFormat::kASTC4x4UNormInt:
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+      case PixelFormat::kBC7UNormInt:
         return;
     }
     is_valid_ = true;
@@ -164,6 +170,24 @@ struct TexImage2DData {
         data = std::move(mapping);
         break;
       }
+      case PixelFormat::kASTC4x4UNormInt: {
+        internal_format = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
+      case PixelFormat::kETC2R8G8B8A8UNormInt: {
+        internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
+      case PixelFormat::kBC7UNormInt: {
+        internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM_EXT;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
       case PixelFormat::kR8G8B8A8UNormIntSRGB:
       case PixelFormat::kB8G8R8A8UNormInt:
       case PixelFormat::kB8G8R8A8UNormIntSRGB:
@@ -261,9 +285,11 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
 
+  const size_t byte_size = tex_descriptor.GetByteSizeOfBaseMipLevel();
   ReactorGLES::Operation texture_upload = [handle = handle_,            //
                                            data,                        //
                                            size = tex_descriptor.size,  //
+                                           byte_size,                   //
                                            texture_type,                //
                                            texture_target               //
   ](const auto& reactor) {
@@ -280,7 +306,19 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
       tex_data = data->data->GetMapping();
     }
 
-    {
+    if (data->is_compressed) {
+      TRACE_EVENT1("impeller", "CompressedTexImage2DUpload", "Bytes",
+                   std::to_string(byte_size).c_str());
+      gl.CompressedTexImage2D(texture_target,         // target
+                              0u,                     // LOD level
+                              data->internal_format,  // internal format
+                              size.width,             // width
+                              size.height,            // height
+                              0u,                     // border
+                              byte_size,              // image size
+                              tex_data                // data
+      );
+    } else {
       TRACE_EVENT1("impeller", "TexImage2DUpload", "Bytes",
                    std::to_string(data->data->GetSize()).c_str());
       gl.TexImage2D(texture_target,         // target
@@ -329,6 +367,9 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
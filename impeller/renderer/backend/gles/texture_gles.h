@@ -54,11 +54,30 @@ class TextureGLES final : public Texture,
 
  private:
   friend class AllocatorMTL;
+  friend class SamplerGLES;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The sampler state, which GLES stores with the texture object.
+  ///
+  struct SamplerParameters {
+    GLint min_filter = GL_NONE;
+    GLint mag_filter = GL_NONE;
+    GLint wrap_s = GL_NONE;
+    GLint wrap_t = GL_NONE;
+
+    constexpr bool operator==(const SamplerParameters& o) const {
+      return min_filter == o.min_filter && mag_filter == o.mag_filter &&
+             wrap_s == o.wrap_s && wrap_t == o.wrap_t;
+    }
+  };
 
   ReactorGLES::Ref reactor_;
   const Type type_;
   HandleGLES handle_;
   mutable bool contents_initialized_ = false;
+  // The sampler state last set by |SamplerGLES|. This is not tracked for
+  // wrapped textures, whose owner may change it.
+  mutable std::optional<SamplerParameters> sampler_parameters_;
   const bool is_wrapped_;
   bool is_valid_ = false;
 
@@ -6,7 +6,10 @@
 
 #include <Metal/Metal.h>
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/allocator.h"
 
 namespace impeller {
@@ -27,9 +30,14 @@ class AllocatorMTL final : public Allocator {
   bool supports_uma_ = false;
   bool is_valid_ = false;
   ISize max_texture_supported_;
+  Mutex heaps_mutex_;
+  // Heaps that render targets are sub-allocated from.
+  std::vector<id<MTLHeap>> render_target_heaps_ IPLR_GUARDED_BY(heaps_mutex_);
 
   AllocatorMTL(id<MTLDevice> device, std::string label);
 
+  id<MTLTexture> NewRenderTargetFromHeap(MTLTextureDescriptor* desc);
+
   // |Allocator|
   bool IsValid() const;
 
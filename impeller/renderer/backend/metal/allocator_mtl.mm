@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/metal/allocator_mtl.h"
 
+#include <algorithm>
+
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "impeller/base/validation.h"
@@ -14,6 +16,10 @@
 
 namespace impeller {
 
+// The smallest heap render targets are sub-allocated from. Larger targets get
+// a heap of their own size.
+static constexpr NSUInteger kRenderTargetHeapSize = 32u * 1024u * 1024u;
+
 static bool DeviceSupportsDeviceTransientTargets(id<MTLDevice> device) {
   // Refer to the "Memoryless render targets" feature in the table below:
   // https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
@@ -206,6 +212,17 @@ std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
   mtl_texture_desc.storageMode = ToMTLStorageMode(
       desc.storage_mode, supports_memoryless_targets_, supports_uma_);
 
+  // Memoryless textures can only be used as attachments. Like on Vulkan, fall
+  // back to private storage if the caller is going to read or write the
+  // texture in a shader. See:
+  // https://github.com/flutter/flutter/issues/121633
+  if (desc.storage_mode == StorageMode::kDeviceTransient &&
+      (desc.usage &
+       (static_cast<TextureUsageMask>(TextureUsage::kShaderRead) |
+        static_cast<TextureUsageMask>(TextureUsage::kShaderWrite)))) {
+    mtl_texture_desc.storageMode = MTLStorageModePrivate;
+  }
+
   if (@available(macOS 12.5, ios 15.0, *)) {
     if (desc.compression_type == CompressionType::kLossy &&
         SupportsLossyTextureCompression(device_)) {
@@ -213,13 +230,79 @@ std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
     }
   }
 
-  auto texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+  id<MTLTexture> texture = nil;
+  // Render targets are created and destroyed all the time as passes come and
+  // go. Sub-allocating them from a heap is much cheaper than allocating each
+  // one from the device.
+  if (mtl_texture_desc.storageMode == MTLStorageModePrivate &&
+      (desc.usage &
+       static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)) &&
+      desc.compression_type != CompressionType::kLossy) {
+    texture = NewRenderTargetFromHeap(mtl_texture_desc);
+  }
+  if (!texture) {
+    texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+  }
   if (!texture) {
     return nullptr;
   }
   return std::make_shared<TextureMTL>(desc, texture);
 }
 
+id<MTLTexture> AllocatorMTL::NewRenderTargetFromHeap(
+    MTLTextureDescriptor* desc) {
+  if (@available(macOS 10.15, iOS 13, tvOS 13, *)) {
+    const MTLSizeAndAlign size_and_align =
+        [device_ heapTextureSizeAndAlignWithDescriptor:desc];
+
+    Lock lock(heaps_mutex_);
+
+    // Keep at most one heap that nothing is allocated from.
+    bool kept_empty_heap = false;
+    render_target_heaps_.erase(
+        std::remove_if(render_target_heaps_.begin(),
+                       render_target_heaps_.end(),
+                       [&kept_empty_heap](id<MTLHeap> heap) {
+                         if (heap.usedSize > 0u) {
+                           return false;
+                         }
+                         if (!kept_empty_heap) {
+                           kept_empty_heap = true;
+                           return false;
+                         }
+                         return true;
+                       }),
+        render_target_heaps_.end());
+
+    for (id<MTLHeap> heap : render_target_heaps_) {
+      if ([heap maxAvailableSizeWithAlignment:size_and_align.align] <
+          size_and_align.size) {
+        continue;
+      }
+      if (id<MTLTexture> texture = [heap newTextureWithDescriptor:desc]) {
+        return texture;
+      }
+    }
+
+    MTLHeapDescriptor* heap_desc = [[MTLHeapDescriptor alloc] init];
+    heap_desc.storageMode = MTLStorageModePrivate;
+    // Like resources allocated from the device, let Metal track the hazards
+    // between the render targets of a heap. A texture's memory is only
+    // handed out again once the command buffers using it have completed and
+    // released it.
+    heap_desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    heap_desc.size = std::max(kRenderTargetHeapSize, size_and_align.size);
+    id<MTLHeap> heap = [device_ newHeapWithDescriptor:heap_desc];
+    if (!heap) {
+      return nil;
+    }
+    heap.label = @"Impeller Render Target Heap";
+    render_target_heaps_.push_back(heap);
+    return [heap newTextureWithDescriptor:desc];
+  }
+  return nil;
+}
+
 uint16_t AllocatorMTL::MinimumBytesPerRow(PixelFormat format) const {
   return static_cast<uint16_t>([device_
       minimumLinearTextureAlignmentForPixelFormat:ToMTLPixelFormat(format)]);
@@ -117,12 +117,15 @@ bool BlitCopyBufferToTextureCommandMTL::Encode(
       MTLOriginMake(destination_origin.x, destination_origin.y, 0);
 
   auto image_size = destination->GetTextureDescriptor().size;
-  auto source_size_mtl = MTLSizeMake(image_size.width, image_size.height, 1);
-
   auto destination_bytes_per_pixel =
       BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
   auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+      image_size.width * destination_bytes_per_pixel;
+
+  // The source holds whole rows, which may be fewer than the image has.
+  auto source_size_mtl =
+      MTLSizeMake(image_size.width,
+                  source.range.length / destination_bytes_per_row, 1);
   auto destination_bytes_per_image =
       source_size_mtl.height * destination_bytes_per_row;
 
@@ -159,6 +159,12 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
 }
 
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
+  if (auto context = context_.lock()) {
+    if (const auto& tracer = ContextMTL::Cast(*context).GetGPUTracerMTL()) {
+      tracer->RecordCmdBuffer(buffer_);
+    }
+  }
+
   if (callback) {
     [buffer_
         addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -186,6 +192,9 @@ bool CommandBufferMTL::SubmitCommandsAsync(
   if (!context) {
     return false;
   }
+  if (const auto& tracer = ContextMTL::Cast(*context).GetGPUTracerMTL()) {
+    tracer->RecordCmdBuffer(buffer_);
+  }
   [buffer_ enqueue];
   auto buffer = buffer_;
   buffer_ = nil;
@@ -16,6 +16,7 @@
 #include "impeller/core/sampler.h"
 #include "impeller/renderer/backend/metal/allocator_mtl.h"
 #include "impeller/renderer/backend/metal/command_buffer_mtl.h"
+#include "impeller/renderer/backend/metal/gpu_tracer_mtl.h"
 #include "impeller/renderer/backend/metal/pipeline_library_mtl.h"
 #include "impeller/renderer/backend/metal/shader_library_mtl.h"
 #include "impeller/renderer/capabilities.h"
@@ -87,6 +88,11 @@ class ContextMTL final : public Context,
   // |Context|
   void Shutdown() override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
+  const std::shared_ptr<GPUTracerMTL>& GetGPUTracerMTL() const;
+
   id<MTLCommandBuffer> CreateMTLCommandBuffer(const std::string& label) const;
 
   const std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner() const;
@@ -103,6 +109,7 @@ class ContextMTL final : public Context,
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  std::shared_ptr<GPUTracerMTL> gpu_tracer_;
   bool is_valid_ = false;
 
   ContextMTL(
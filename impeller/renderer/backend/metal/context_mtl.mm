@@ -11,6 +11,7 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/sync_switch.h"
+#include "impeller/core/device_buffer_ring.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/renderer/backend/metal/sampler_library_mtl.h"
 #include "impeller/renderer/capabilities.h"
@@ -48,6 +49,52 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static bool DeviceSupportsBindlessTextures(id<MTLDevice> device) {
+  // Tier 2 argument buffers can hold arrays of textures that shaders index
+  // dynamically.
+  // https://developer.apple.com/documentation/metal/buffers/about_argument_buffers
+  if (@available(macOS 10.13, iOS 11.0, tvOS 11.0, *)) {
+    return device.argumentBuffersSupport >= MTLArgumentBuffersTier2;
+  }
+  return false;
+}
+
+static bool DeviceSupportsTextureCompressionASTC(id<MTLDevice> device) {
+  // ASTC and ETC2 are supported by all Apple GPUs, including the ones in Macs
+  // with Apple silicon, but not by the GPUs of other Macs.
+  // https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
+  if (@available(macOS 11.0, iOS 13.0, tvOS 13.0, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple2];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif  // FML_OS_IOS
+}
+
+static bool DeviceSupportsTextureCompressionETC2(id<MTLDevice> device) {
+  if (@available(macOS 11.0, iOS 13.0, tvOS 13.0, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple1];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif  // FML_OS_IOS
+}
+
+static bool DeviceSupportsTextureCompressionBC(id<MTLDevice> device) {
+  if (@available(macOS 11.0, iOS 16.4, tvOS 16.4, *)) {
+    return device.supportsBCTextureCompression;
+  }
+#if FML_OS_IOS
+  return false;
+#else
+  return true;
+#endif  // FML_OS_IOS
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -66,9 +113,36 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsReadFromResolve(true)
       .SetSupportsReadFromOnscreenTexture(true)
       .SetSupportsDeviceTransientTextures(true)
+      .SetSupportsBindlessTextures(DeviceSupportsBindlessTextures(device))
+      .SetSupportsTextureCompressionASTC(
+          DeviceSupportsTextureCompressionASTC(device))
+      .SetSupportsTextureCompressionETC2(
+          DeviceSupportsTextureCompressionETC2(device))
+      .SetSupportsTextureCompressionBC(
+          DeviceSupportsTextureCompressionBC(device))
       .Build();
 }
 
+static std::shared_ptr<PipelineCacheMTL> CreatePipelineCache(
+    id<MTLDevice> device) {
+  NSURL* cache_url = nil;
+#if FML_OS_IOS
+  // The caches directory on macOS is shared by all applications that aren't
+  // sandboxed, so pipelines are only recorded on iOS.
+  NSURL* caches_directory =
+      [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                             inDomains:NSUserDomainMask]
+          .firstObject;
+  cache_url = [caches_directory
+      URLByAppendingPathComponent:@"flutter.impeller.mtlarchive"];
+#endif  // FML_OS_IOS
+  // An archive harvested ahead of time may be shipped with the application.
+  NSURL* bundled_url =
+      [[NSBundle mainBundle] URLForResource:@"flutter.impeller"
+                              withExtension:@"mtlarchive"];
+  return PipelineCacheMTL::Create(device, cache_url, bundled_url);
+}
+
 ContextMTL::ContextMTL(
     id<MTLDevice> device,
     id<MTLCommandQueue> command_queue,
@@ -120,8 +194,8 @@ ContextMTL::ContextMTL(
 
   // Setup the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryMTL>(new PipelineLibraryMTL(device_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryMTL>(
+        new PipelineLibraryMTL(device_, CreatePipelineCache(device_)));
   }
 
   // Setup the sampler library.
@@ -143,6 +217,13 @@ ContextMTL::ContextMTL(
   device_capabilities_ =
       InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
 
+  gpu_tracer_ = std::make_shared<GPUTracerMTL>();
+
+  // Where host visible buffers are shared with the GPU, the transients
+  // buffers of render passes are written in place. Render passes hold on to
+  // the blocks they used until their command buffers complete.
+  SetTransientsBufferRing(DeviceBufferRing::Create(resource_allocator_));
+
   is_valid_ = true;
 }
 
@@ -325,6 +406,15 @@ void ContextMTL::Shutdown() {
   raster_message_loop_.reset();
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextMTL::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
+const std::shared_ptr<GPUTracerMTL>& ContextMTL::GetGPUTracerMTL() const {
+  return gpu_tracer_;
+}
+
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextMTL::GetWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <Metal/Metal.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A |GPUTracer| that reads the GPU start and end times of each
+///             command buffer of a frame once it has completed.
+///
+class GPUTracerMTL final : public GPUTracer {
+ public:
+  GPUTracerMTL();
+
+  // |GPUTracer|
+  ~GPUTracerMTL() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds |buffer| to the current frame, if any. This must be
+  ///             called before the buffer is committed.
+  ///
+  void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerMTL);
+};
+
+}  // namespace impeller
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/metal/gpu_tracer_mtl.h"
+
+namespace impeller {
+
+GPUTracerMTL::GPUTracerMTL() = default;
+
+GPUTracerMTL::~GPUTracerMTL() = default;
+
+void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
+  if (@available(ios 10.3, macos 10.15, *)) {
+    auto frame_id = AddCommandBuffer();
+    if (!frame_id.has_value()) {
+      return;
+    }
+    std::weak_ptr<GPUTracer> weak_tracer = weak_from_this();
+    uint64_t frame = frame_id.value();
+    [buffer addCompletedHandler:^(id<MTLCommandBuffer> completed_buffer) {
+      auto tracer = weak_tracer.lock();
+      if (!tracer) {
+        return;
+      }
+      // The times are in seconds on the same clock as CACurrentMediaTime.
+      CFTimeInterval start = completed_buffer.GPUStartTime;
+      CFTimeInterval end = completed_buffer.GPUEndTime;
+      if (completed_buffer.status != MTLCommandBufferStatusCompleted ||
+          end <= 0) {
+        tracer->CompleteCommandBuffer(frame, std::nullopt);
+        return;
+      }
+      tracer->CompleteCommandBuffer(
+          frame, GPUTracer::TimeRange{
+                     .start_nanos = static_cast<int64_t>(start * 1e9),
+                     .end_nanos = static_cast<int64_t>(end * 1e9),
+                 });
+    }];
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <Metal/Metal.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Looks up pipelines in Metal binary archives so that they don't
+///             have to be compiled from their functions again.
+///
+///             Pipelines are looked up in a read-only archive shipped with
+///             the application, if any, and in an archive in the caches
+///             directory. Pipelines created by this session are added to the
+///             cached archive, which is written back to disk shortly after.
+///
+///             Binary archives need iOS 14 or macOS 11. Nothing is cached on
+///             older versions.
+///
+class PipelineCacheMTL final
+    : public std::enable_shared_from_this<PipelineCacheMTL> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pipeline cache.
+  ///
+  /// @param[in]  device           The device pipelines are created on.
+  /// @param[in]  cache_url        Where the archive of pipelines created on
+  ///                              this device is read from and written to.
+  ///                              May be nil to not record pipelines.
+  /// @param[in]  bundled_url      An archive harvested ahead of time and
+  ///                              shipped with the application. May be nil.
+  ///
+  static std::shared_ptr<PipelineCacheMTL> Create(id<MTLDevice> device,
+                                                  NSURL* cache_url,
+                                                  NSURL* bundled_url);
+
+  ~PipelineCacheMTL();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the pipeline be looked up in the archives before it is
+  ///             compiled.
+  ///
+  /// @return     If there are any archives to look the pipeline up in.
+  ///
+  bool ApplyToDescriptor(MTLRenderPipelineDescriptor* descriptor) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the pipeline be looked up in the archives before it is
+  ///             compiled.
+  ///
+  /// @return     If there are any archives to look the pipeline up in.
+  ///
+  bool ApplyToDescriptor(MTLComputePipelineDescriptor* descriptor) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a pipeline that wasn't found in the archives to the
+  ///             cached archive. The work is done on a background queue.
+  ///
+  void AddPipeline(MTLRenderPipelineDescriptor* descriptor);
+
+ private:
+  NSURL* cache_url_ = nil;
+  // An id<MTLBinaryArchive>, untyped so that this class can be used on OS
+  // versions without binary archives.
+  id cache_archive_ = nil;
+  // The archives pipelines are looked up in.
+  NSArray* archives_ = nil;
+  dispatch_queue_t queue_ = nil;
+  // Only accessed on the queue.
+  bool save_pending_ = false;
+
+  PipelineCacheMTL(id<MTLDevice> device, NSURL* cache_url, NSURL* bundled_url);
+
+  void ScheduleSave();
+
+  void Save();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineCacheMTL);
+};
+
+}  // namespace impeller
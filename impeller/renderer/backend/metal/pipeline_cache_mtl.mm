@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/metal/pipeline_cache_mtl.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+// Pipelines created close together, like the ones of a new screen, are saved
+// together.
+static constexpr int64_t kSaveDelayNanoseconds = 2 * NSEC_PER_SEC;
+
+static id<MTLBinaryArchive> LoadArchive(id<MTLDevice> device, NSURL* url)
+    API_AVAILABLE(ios(14.0), macos(11.0)) {
+  MTLBinaryArchiveDescriptor* descriptor =
+      [[MTLBinaryArchiveDescriptor alloc] init];
+  descriptor.url = url;
+  NSError* error = nil;
+  id<MTLBinaryArchive> archive =
+      [device newBinaryArchiveWithDescriptor:descriptor error:&error];
+  if (!archive && url != nil) {
+    FML_LOG(INFO) << "Could not load pipeline archive: "
+                  << error.localizedDescription.UTF8String;
+  }
+  return archive;
+}
+
+std::shared_ptr<PipelineCacheMTL> PipelineCacheMTL::Create(
+    id<MTLDevice> device,
+    NSURL* cache_url,
+    NSURL* bundled_url) {
+  return std::shared_ptr<PipelineCacheMTL>(
+      new PipelineCacheMTL(device, cache_url, bundled_url));
+}
+
+PipelineCacheMTL::PipelineCacheMTL(id<MTLDevice> device,
+                                   NSURL* cache_url,
+                                   NSURL* bundled_url) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    NSMutableArray* archives = [NSMutableArray array];
+    if (bundled_url != nil) {
+      if (id<MTLBinaryArchive> bundled = LoadArchive(device, bundled_url)) {
+        [archives addObject:bundled];
+      }
+    }
+    if (cache_url != nil) {
+      id<MTLBinaryArchive> cached = nil;
+      if ([[NSFileManager defaultManager] fileExistsAtPath:cache_url.path]) {
+        cached = LoadArchive(device, cache_url);
+      }
+      // Start over if there was no archive, or if it couldn't be used.
+      if (!cached) {
+        cached = LoadArchive(device, nil);
+      }
+      if (cached) {
+        cached.label = @"Impeller Pipeline Cache";
+        [archives addObject:cached];
+        cache_archive_ = cached;
+        cache_url_ = cache_url;
+        queue_ = dispatch_queue_create(
+            "io.flutter.impeller.pipeline_cache",
+            dispatch_queue_attr_make_with_qos_class(
+                DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0));
+      }
+    }
+    if (archives.count > 0) {
+      archives_ = archives;
+    }
+  }
+}
+
+PipelineCacheMTL::~PipelineCacheMTL() = default;
+
+bool PipelineCacheMTL::ApplyToDescriptor(
+    MTLRenderPipelineDescriptor* descriptor) const {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (archives_ != nil) {
+      descriptor.binaryArchives = archives_;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PipelineCacheMTL::ApplyToDescriptor(
+    MTLComputePipelineDescriptor* descriptor) const {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (archives_ != nil) {
+      descriptor.binaryArchives = archives_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void PipelineCacheMTL::AddPipeline(MTLRenderPipelineDescriptor* descriptor) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (cache_archive_ == nil) {
+      return;
+    }
+    std::weak_ptr<PipelineCacheMTL> weak_this = weak_from_this();
+    dispatch_async(queue_, ^{
+      auto strong_this = weak_this.lock();
+      if (!strong_this) {
+        return;
+      }
+      TRACE_EVENT0("impeller", "AddRenderPipelineToArchive");
+      NSError* error = nil;
+      if (![strong_this->cache_archive_
+              addRenderPipelineFunctionsWithDescriptor:descriptor
+                                                 error:&error]) {
+        FML_LOG(ERROR) << "Could not add a pipeline to the pipeline archive: "
+                       << error.localizedDescription.UTF8String;
+        return;
+      }
+      strong_this->ScheduleSave();
+    });
+  }
+}
+
+void PipelineCacheMTL::ScheduleSave() {
+  if (save_pending_) {
+    return;
+  }
+  save_pending_ = true;
+  std::weak_ptr<PipelineCacheMTL> weak_this = weak_from_this();
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, kSaveDelayNanoseconds),
+                 queue_, ^{
+                   if (auto strong_this = weak_this.lock()) {
+                     strong_this->save_pending_ = false;
+                     strong_this->Save();
+                   }
+                 });
+}
+
+void PipelineCacheMTL::Save() {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    TRACE_EVENT0("impeller", "SavePipelineArchive");
+    NSError* error = nil;
+    if (![cache_archive_ serializeToURL:cache_url_ error:&error]) {
+      FML_LOG(ERROR) << "Could not save the pipeline archive: "
+                     << error.localizedDescription.UTF8String;
+    }
+  }
+}
+
+}  // namespace impeller
@@ -6,7 +6,10 @@
 
 #include <Metal/Metal.h>
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/metal/pipeline_cache_mtl.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
@@ -24,10 +27,12 @@ class PipelineLibraryMTL final : public PipelineLibrary {
   friend ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
+  std::shared_ptr<PipelineCacheMTL> pipeline_cache_;
   PipelineMap pipelines_;
   ComputePipelineMap compute_pipelines_;
 
-  PipelineLibraryMTL(id<MTLDevice> device);
+  PipelineLibraryMTL(id<MTLDevice> device,
+                     std::shared_ptr<PipelineCacheMTL> pipeline_cache);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/container.h"
+#include "flutter/fml/trace_counters.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/metal/compute_pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
@@ -17,8 +18,10 @@
 
 namespace impeller {
 
-PipelineLibraryMTL::PipelineLibraryMTL(id<MTLDevice> device)
-    : device_(device) {}
+PipelineLibraryMTL::PipelineLibraryMTL(
+    id<MTLDevice> device,
+    std::shared_ptr<PipelineCacheMTL> pipeline_cache)
+    : device_(device), pipeline_cache_(std::move(pipeline_cache)) {}
 
 PipelineLibraryMTL::~PipelineLibraryMTL() = default;
 
@@ -28,14 +31,15 @@ static MTLRenderPipelineDescriptor* GetMTLRenderPipelineDescriptor(
   descriptor.label = @(desc.GetLabel().c_str());
   descriptor.rasterSampleCount = static_cast<NSUInteger>(desc.GetSampleCount());
 
+  const auto& constants = desc.GetSpecializationConstants();
   for (const auto& entry : desc.GetStageEntrypoints()) {
     if (entry.first == ShaderStage::kVertex) {
-      descriptor.vertexFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+      descriptor.vertexFunction = ShaderFunctionMTL::Cast(*entry.second)
+                                      .GetMTLFunctionSpecialized(constants);
     }
     if (entry.first == ShaderStage::kFragment) {
-      descriptor.fragmentFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+      descriptor.fragmentFunction = ShaderFunctionMTL::Cast(*entry.second)
+                                        .GetMTLFunctionSpecialized(constants);
     }
   }
 
@@ -83,6 +87,36 @@ static id<MTLDepthStencilState> CreateDepthStencilDescriptor(
   return [device newDepthStencilStateWithDescriptor:descriptor];
 }
 
+using RenderPipelineHandler =
+    void (^)(id<MTLRenderPipelineState> _Nullable render_pipeline_state,
+             NSError* _Nullable error);
+
+static void NewRenderPipelineState(id<MTLDevice> device,
+                                   MTLRenderPipelineDescriptor* descriptor,
+                                   MTLPipelineOption options,
+                                   RenderPipelineHandler handler) {
+#if FML_OS_IOS
+  [device newRenderPipelineStateWithDescriptor:descriptor
+                                       options:options
+                             completionHandler:^(
+                                 id<MTLRenderPipelineState> state,
+                                 MTLRenderPipelineReflection* reflection,
+                                 NSError* error) {
+                               handler(state, error);
+                             }];
+#else   // FML_OS_IOS
+  // TODO(116919): Investigate and revert speculative fix to make MTL pipeline
+  //               state creation use a worker.
+  NSError* error = nil;
+  auto render_pipeline_state =
+      [device newRenderPipelineStateWithDescriptor:descriptor
+                                           options:options
+                                        reflection:nil
+                                             error:&error];
+  handler(render_pipeline_state, error);
+#endif  // FML_OS_IOS
+}
+
 // |PipelineLibrary|
 bool PipelineLibraryMTL::IsValid() const {
   return device_ != nullptr;
@@ -106,6 +140,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  FML_PERFORMANCE_COUNTER_ADD("pipelines.created", 1);
   auto weak_this = weak_from_this();
 
   auto completion_handler =
@@ -134,18 +169,35 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
         promise->set_value(new_pipeline);
       };
   auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
-#if FML_OS_IOS
-  [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
-                              completionHandler:completion_handler];
-#else   // FML_OS_IOS
-  // TODO(116919): Investigate and revert speculative fix to make MTL pipeline
-  //               state creation use a worker.
-  NSError* error = nil;
-  auto render_pipeline_state =
-      [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
-                                              error:&error];
-  completion_handler(render_pipeline_state, error);
-#endif  // FML_OS_IOS
+  if (pipeline_cache_ && pipeline_cache_->ApplyToDescriptor(mtl_descriptor)) {
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+      // Look the pipeline up in the archives first. Only pipelines that are
+      // missing from them are compiled, and then recorded for next time.
+      id<MTLDevice> device = device_;
+      auto pipeline_cache = pipeline_cache_;
+      NewRenderPipelineState(
+          device, mtl_descriptor, MTLPipelineOptionFailOnBinaryArchiveMiss,
+          ^(id<MTLRenderPipelineState> _Nullable render_pipeline_state,
+            NSError* _Nullable error) {
+            if (render_pipeline_state != nil) {
+              completion_handler(render_pipeline_state, nil);
+              return;
+            }
+            NewRenderPipelineState(
+                device, mtl_descriptor, MTLPipelineOptionNone,
+                ^(id<MTLRenderPipelineState> _Nullable compiled_state,
+                  NSError* _Nullable compile_error) {
+                  if (compiled_state != nil) {
+                    pipeline_cache->AddPipeline(mtl_descriptor);
+                  }
+                  completion_handler(compiled_state, compile_error);
+                });
+          });
+      return pipeline_future;
+    }
+  }
+  NewRenderPipelineState(device_, mtl_descriptor, MTLPipelineOptionNone,
+                         completion_handler);
   return pipeline_future;
 }
 
@@ -196,11 +248,13 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
                                    ));
         promise->set_value(new_pipeline);
       };
-  [device_
-      newComputePipelineStateWithDescriptor:GetMTLComputePipelineDescriptor(
-                                                descriptor)
-                                    options:MTLPipelineOptionNone
-                          completionHandler:completion_handler];
+  auto mtl_descriptor = GetMTLComputePipelineDescriptor(descriptor);
+  if (pipeline_cache_) {
+    pipeline_cache_->ApplyToDescriptor(mtl_descriptor);
+  }
+  [device_ newComputePipelineStateWithDescriptor:mtl_descriptor
+                                         options:MTLPipelineOptionNone
+                               completionHandler:completion_handler];
   return pipeline_future;
 }
 
@@ -404,6 +404,15 @@ static bool Bind(PassBindingsCache& pass,
 
 bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
                                    id<MTLRenderCommandEncoder> encoder) const {
+  // The blocks the transients were written into are reused as soon as
+  // nothing references them, so keep them until the GPU is done reading.
+  if (!transients_buffer_->GetDeviceBlocks().empty()) {
+    auto blocks = transients_buffer_->GetDeviceBlocks();
+    [buffer_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+      (void)blocks;
+    }];
+  }
+
   PassBindingsCache pass_bindings(encoder);
   auto bind_stage_resources = [&allocator, &pass_bindings](
                                   const Bindings& bindings,
@@ -27,13 +27,12 @@ class SamplerLibraryMTL final
   friend class ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
-  SamplerMap samplers_;
 
   SamplerLibraryMTL(id<MTLDevice> device);
 
   // |SamplerLibrary|
-  std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) override;
+  std::shared_ptr<const Sampler> CreateSampler(
+      const SamplerDescriptor& descriptor) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibraryMTL);
 };
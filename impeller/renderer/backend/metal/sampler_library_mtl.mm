@@ -13,12 +13,9 @@ SamplerLibraryMTL::SamplerLibraryMTL(id<MTLDevice> device) : device_(device) {}
 
 SamplerLibraryMTL::~SamplerLibraryMTL() = default;
 
-std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
-    SamplerDescriptor descriptor) {
-  auto found = samplers_.find(descriptor);
-  if (found != samplers_.end()) {
-    return found->second;
-  }
+// |SamplerLibrary|
+std::shared_ptr<const Sampler> SamplerLibraryMTL::CreateSampler(
+    const SamplerDescriptor& descriptor) {
   if (!device_) {
     return nullptr;
   }
@@ -43,7 +40,6 @@ std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
   if (!sampler->IsValid()) {
     return nullptr;
   }
-  samplers_[descriptor] = sampler;
   return sampler;
 }
 
@@ -6,8 +6,11 @@
 
 #include <Metal/Metal.h>
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/shader_function.h"
 
 namespace impeller {
@@ -21,12 +24,25 @@ class ShaderFunctionMTL final
 
   id<MTLFunction> GetMTLFunction() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a variant of the function with its function constants
+  ///             set to the given values. The value at an index sets the
+  ///             constant with that index.
+  ///
+  /// @return     The specialized function, or the function itself if there are
+  ///             no values. nil if the function could not be specialized.
+  ///
+  id<MTLFunction> GetMTLFunctionSpecialized(
+      const std::vector<Scalar>& constants) const;
+
  private:
   friend class ShaderLibraryMTL;
 
+  id<MTLLibrary> library_ = nullptr;
   id<MTLFunction> function_ = nullptr;
 
   ShaderFunctionMTL(UniqueID parent_library_id,
+                    id<MTLLibrary> library,
                     id<MTLFunction> function,
                     std::string name,
                     ShaderStage stage);
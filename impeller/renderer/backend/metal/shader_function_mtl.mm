@@ -4,13 +4,17 @@
 
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 
+#include "impeller/base/validation.h"
+
 namespace impeller {
 
 ShaderFunctionMTL::ShaderFunctionMTL(UniqueID parent_library_id,
+                                     id<MTLLibrary> library,
                                      id<MTLFunction> function,
                                      std::string name,
                                      ShaderStage stage)
     : ShaderFunction(parent_library_id, std::move(name), stage),
+      library_(library),
       function_(function) {}
 
 ShaderFunctionMTL::~ShaderFunctionMTL() = default;
@@ -19,4 +23,28 @@ id<MTLFunction> ShaderFunctionMTL::GetMTLFunction() const {
   return function_;
 }
 
+id<MTLFunction> ShaderFunctionMTL::GetMTLFunctionSpecialized(
+    const std::vector<Scalar>& constants) const {
+  if (constants.empty()) {
+    return function_;
+  }
+  MTLFunctionConstantValues* constant_values =
+      [[MTLFunctionConstantValues alloc] init];
+  for (size_t i = 0; i < constants.size(); i++) {
+    [constant_values setConstantValue:&constants[i]
+                                 type:MTLDataTypeFloat
+                              atIndex:i];
+  }
+  NSError* error = nil;
+  id<MTLFunction> function = [library_ newFunctionWithName:function_.name
+                                            constantValues:constant_values
+                                                     error:&error];
+  if (function == nil) {
+    VALIDATION_LOG << "Could not specialize function "
+                   << function_.name.UTF8String << ": "
+                   << error.localizedDescription.UTF8String;
+  }
+  return function;
+}
+
 }  // namespace impeller
@@ -0,0 +1,453 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/ahb_swapchain_vk.h"
+
+#ifdef FML_OS_ANDROID
+
+#include <poll.h>
+
+#include <cerrno>
+#include <limits>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/surface_vk.h"
+
+namespace impeller {
+
+// One buffer on screen, one queued in the compositor and one being rendered.
+static constexpr size_t kBufferCount = 3u;
+
+// How long to wait for the compositor to give a buffer back, in milliseconds.
+static constexpr int kBufferReleaseTimeoutMs = 1000;
+
+// The number of past presentation timings kept for callers that don't take
+// them every frame.
+static constexpr size_t kMaxPresentationTimings = 64u;
+
+struct AHBSwapchainVK::Buffer {
+  AHardwareBuffer* hardware_buffer = nullptr;
+  std::shared_ptr<AndroidHardwareBufferTextureSourceVK> texture_source;
+  std::shared_ptr<Texture> msaa_texture;
+  // Signaled when the last submission rendering to the buffer completes.
+  vk::UniqueFence render_fence;
+  // Exported as the acquire fence given to the compositor.
+  vk::UniqueSemaphore render_ready;
+  std::shared_ptr<CommandBuffer> final_cmd_buffer;
+  // The following are guarded by |AHBSwapchainVK::mutex_|.
+  // Signals when the compositor stops reading from the buffer.
+  fml::UniqueFD release_fence;
+  // Whether the buffer was presented and not yet given back.
+  bool held_by_compositor = false;
+};
+
+static bool WaitForSyncFile(const fml::UniqueFD& fence) {
+  if (!fence.is_valid()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", "WaitForReleaseFence");
+  pollfd poll_fd = {};
+  poll_fd.fd = fence.get();
+  poll_fd.events = POLLIN;
+  int result;
+  do {
+    result = ::poll(&poll_fd, 1, kBufferReleaseTimeoutMs);
+  } while (result == -1 && (errno == EINTR || errno == EAGAIN));
+  return result > 0;
+}
+
+AHBSwapchainVK::Delegate::~Delegate() = default;
+
+std::shared_ptr<AHBSwapchainVK> AHBSwapchainVK::Create(
+    const std::shared_ptr<Context>& context,
+    std::unique_ptr<Delegate> delegate) {
+  if (!context || !delegate) {
+    return nullptr;
+  }
+  auto swapchain = std::shared_ptr<AHBSwapchainVK>(
+      new AHBSwapchainVK(context, std::move(delegate)));
+  if (!swapchain->IsValid()) {
+    return nullptr;
+  }
+  return swapchain;
+}
+
+AHBSwapchainVK::AHBSwapchainVK(const std::shared_ptr<Context>& context,
+                               std::unique_ptr<Delegate> delegate)
+    : context_(context), delegate_(std::move(delegate)) {
+  auto& vk_context = ContextVK::Cast(*context);
+  supports_sync_fd_export_ =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kKHRExternalSemaphoreFd);
+
+  // Rendering to the buffers happens in the same format as offscreen.
+  vk_context.SetOffscreenFormat(PixelFormat::kR8G8B8A8UNormInt);
+  is_valid_ = true;
+}
+
+AHBSwapchainVK::~AHBSwapchainVK() {
+  DestroyBuffers();
+}
+
+bool AHBSwapchainVK::IsValid() const {
+  return is_valid_;
+}
+
+bool AHBSwapchainVK::CreateBuffers(const ISize& size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  DestroyBuffers();
+
+  auto context_strong = context_.lock();
+  if (!context_strong) {
+    return false;
+  }
+  const auto& context = ContextVK::Cast(*context_strong);
+  const auto& device = context.GetDevice();
+
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  for (size_t i = 0u; i < kBufferCount; i++) {
+    auto buffer = std::make_unique<Buffer>();
+    AHardwareBuffer_Desc hardware_buffer_desc = {};
+    buffer->hardware_buffer =
+        delegate_->AllocateBuffer(size, &hardware_buffer_desc);
+    if (!buffer->hardware_buffer) {
+      VALIDATION_LOG << "Could not allocate hardware buffer.";
+      ReleaseBuffers(std::move(buffers));
+      return false;
+    }
+
+    TextureDescriptor desc;
+    desc.type = TextureType::kTexture2D;
+    desc.storage_mode = StorageMode::kDevicePrivate;
+    desc.format = PixelFormat::kR8G8B8A8UNormInt;
+    desc.size = size;
+    desc.mip_count = 1;
+    desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+    buffer->texture_source =
+        std::make_shared<AndroidHardwareBufferTextureSourceVK>(
+            desc, device, buffer->hardware_buffer, hardware_buffer_desc);
+
+    auto fence_res = device.createFenceUnique(
+        vk::FenceCreateInfo{vk::FenceCreateFlagBits::eSignaled});
+    vk::SemaphoreCreateInfo semaphore_info;
+    vk::ExportSemaphoreCreateInfo export_info;
+    export_info.handleTypes = vk::ExternalSemaphoreHandleTypeFlagBits::eSyncFd;
+    if (supports_sync_fd_export_) {
+      semaphore_info.pNext = &export_info;
+    }
+    auto semaphore_res = device.createSemaphoreUnique(semaphore_info);
+    // Keep the buffer so that it is released along with the others.
+    const bool is_valid = buffer->texture_source->IsValid() &&
+                          fence_res.result == vk::Result::eSuccess &&
+                          semaphore_res.result == vk::Result::eSuccess;
+    if (is_valid) {
+      buffer->render_fence = std::move(fence_res.value);
+      buffer->render_ready = std::move(semaphore_res.value);
+    }
+    buffers.emplace_back(std::move(buffer));
+    if (!is_valid) {
+      VALIDATION_LOG << "Could not import hardware buffer.";
+      ReleaseBuffers(std::move(buffers));
+      return false;
+    }
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    buffers_ = std::move(buffers);
+    last_presented_buffer_ = std::nullopt;
+  }
+  size_ = size;
+  next_buffer_ = 0u;
+  return true;
+}
+
+void AHBSwapchainVK::DestroyBuffers() {
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  {
+    std::scoped_lock lock(mutex_);
+    buffers = std::move(buffers_);
+    buffers_.clear();
+    // Callbacks of buffers presented before this point no longer apply.
+    generation_++;
+    last_presented_buffer_ = std::nullopt;
+  }
+  size_ = {};
+  ReleaseBuffers(std::move(buffers));
+}
+
+void AHBSwapchainVK::ReleaseBuffers(
+    std::vector<std::unique_ptr<Buffer>> buffers) {
+  auto context_strong = context_.lock();
+  for (auto& buffer : buffers) {
+    // The compositor holds its own reference to buffers it still shows, but
+    // the GPU must be done rendering before the image goes away.
+    if (context_strong && buffer->render_fence) {
+      [[maybe_unused]] auto result =
+          ContextVK::Cast(*context_strong)
+              .GetDevice()
+              .waitForFences(*buffer->render_fence,                  // fence
+                             true,                                   // wait all
+                             std::numeric_limits<uint64_t>::max());  // timeout
+    }
+    buffer->final_cmd_buffer.reset();
+    buffer->msaa_texture.reset();
+    buffer->texture_source.reset();
+    delegate_->ReleaseBuffer(buffer->hardware_buffer);
+  }
+}
+
+std::unique_ptr<Surface> AHBSwapchainVK::AcquireNextDrawable() {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("impeller", __FUNCTION__);
+
+  auto context_strong = context_.lock();
+  if (!context_strong) {
+    return nullptr;
+  }
+  const auto& context = ContextVK::Cast(*context_strong);
+
+  const auto size = delegate_->GetSize();
+  if (size.IsEmpty()) {
+    return nullptr;
+  }
+  if (size != size_ && !CreateBuffers(size)) {
+    return nullptr;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Wait for the compositor to give the oldest buffer back. Presentations
+  /// complete in order, so buffers are handed out round robin.
+  ///
+  const size_t index = next_buffer_;
+  fml::UniqueFD release_fence;
+  {
+    std::unique_lock lock(mutex_);
+    if (!buffer_released_cv_.wait_for(
+            lock, std::chrono::milliseconds(kBufferReleaseTimeoutMs),
+            [&]() { return !buffers_[index]->held_by_compositor; })) {
+      VALIDATION_LOG << "Timed out waiting for the compositor to release a "
+                        "buffer.";
+      return nullptr;
+    }
+    release_fence = std::move(buffers_[index]->release_fence);
+  }
+
+  if (!WaitForSyncFile(release_fence)) {
+    VALIDATION_LOG << "Could not wait for the buffer release fence.";
+    return nullptr;
+  }
+
+  auto& buffer = *buffers_[index];
+  if (auto result = context.GetDevice().waitForFences(
+          *buffer.render_fence,                 // fence
+          true,                                 // wait all
+          std::numeric_limits<uint64_t>::max()  // timeout (ns)
+      );
+      result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Fence wait failed: " << vk::to_string(result);
+    return nullptr;
+  }
+  buffer.final_cmd_buffer.reset();
+
+  // The compositor may have read the image in any layout, so its contents are
+  // not preserved.
+  buffer.texture_source->SetLayoutWithoutEncoding(vk::ImageLayout::eUndefined);
+
+  return SurfaceVK::WrapTextureSource(
+      context_strong,         // context
+      buffer.texture_source,  // texture source
+      buffer.msaa_texture,    // MSAA texture
+      [weak_swapchain = weak_from_this(), index]() -> bool {
+        auto swapchain = weak_swapchain.lock();
+        if (!swapchain) {
+          return false;
+        }
+        return swapchain->Present(index);
+      }  // swap callback
+  );
+}
+
+bool AHBSwapchainVK::Present(size_t index) {
+  auto context_strong = context_.lock();
+  if (!context_strong || index >= buffers_.size()) {
+    return false;
+  }
+
+  const auto& context = ContextVK::Cast(*context_strong);
+  const auto& device = context.GetDevice();
+  auto& buffer = *buffers_[index];
+
+  //----------------------------------------------------------------------------
+  /// Transition the image to a layout the compositor can read from.
+  ///
+  buffer.final_cmd_buffer = context.CreateCommandBuffer();
+  if (!buffer.final_cmd_buffer) {
+    return false;
+  }
+
+  auto vk_final_cmd_buffer = CommandBufferVK::Cast(*buffer.final_cmd_buffer)
+                                 .GetEncoder()
+                                 ->GetCommandBuffer();
+  {
+    BarrierVK barrier;
+    barrier.new_layout = vk::ImageLayout::eGeneral;
+    barrier.cmd_buffer = vk_final_cmd_buffer;
+    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
+    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    barrier.dst_access = {};
+    barrier.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
+
+    if (!buffer.texture_source->SetLayout(barrier).ok()) {
+      return false;
+    }
+
+    if (vk_final_cmd_buffer.end() != vk::Result::eSuccess) {
+      return false;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Submit and export a sync file that signals once rendering is done.
+  ///
+  if (auto result = device.resetFences(*buffer.render_fence);
+      result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not reset fence: " << vk::to_string(result);
+    return false;
+  }
+  {
+    vk::SubmitInfo submit_info;
+    submit_info.setCommandBuffers(vk_final_cmd_buffer);
+    if (supports_sync_fd_export_) {
+      submit_info.setSignalSemaphores(*buffer.render_ready);
+    }
+    auto result =
+        context.GetGraphicsQueue()->Submit(submit_info, *buffer.render_fence);
+    if (result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not submit the final command buffer: "
+                     << vk::to_string(result);
+      return false;
+    }
+  }
+
+  fml::UniqueFD acquire_fence;
+  bool has_acquire_fence = false;
+  if (supports_sync_fd_export_) {
+    vk::SemaphoreGetFdInfoKHR fd_info;
+    fd_info.semaphore = *buffer.render_ready;
+    fd_info.handleType = vk::ExternalSemaphoreHandleTypeFlagBits::eSyncFd;
+    auto [fd_result, fd] = device.getSemaphoreFdKHR(fd_info);
+    if (fd_result == vk::Result::eSuccess) {
+      // An fd of -1 means that rendering already completed.
+      acquire_fence.reset(fd);
+      has_acquire_fence = true;
+    } else {
+      VALIDATION_LOG << "Could not export the render fence: "
+                     << vk::to_string(fd_result);
+      // The semaphore is still signaled and may not be signaled again.
+      supports_sync_fd_export_ = false;
+    }
+  }
+  if (!has_acquire_fence) {
+    // Without a fence, the compositor could read the buffer before rendering
+    // completes.
+    TRACE_EVENT0("impeller", "WaitForRender");
+    if (auto result = device.waitForFences(
+            *buffer.render_fence,                 // fence
+            true,                                 // wait all
+            std::numeric_limits<uint64_t>::max()  // timeout (ns)
+        );
+        result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Fence wait failed: " << vk::to_string(result);
+      return false;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Hand the buffer to the compositor.
+  ///
+  std::optional<size_t> previous_buffer;
+  uint32_t generation;
+  {
+    std::scoped_lock lock(mutex_);
+    previous_buffer = last_presented_buffer_;
+    last_presented_buffer_ = index;
+    buffer.held_by_compositor = true;
+    generation = generation_;
+  }
+  const uint32_t present_id = next_present_id_++;
+  const bool presented = delegate_->PresentBuffer(
+      buffer.hardware_buffer, std::move(acquire_fence),
+      [weak_swapchain = weak_from_this(), generation, present_id,
+       previous_buffer](std::chrono::nanoseconds latch_time,
+                        fml::UniqueFD release_fence) {
+        auto swapchain = weak_swapchain.lock();
+        if (!swapchain) {
+          return;
+        }
+        swapchain->OnPresentComplete(generation, present_id, previous_buffer,
+                                     latch_time, std::move(release_fence));
+      });
+  if (!presented) {
+    VALIDATION_LOG << "Could not present the hardware buffer.";
+    std::scoped_lock lock(mutex_);
+    last_presented_buffer_ = previous_buffer;
+    buffer.held_by_compositor = false;
+    return false;
+  }
+  next_buffer_ = (index + 1u) % buffers_.size();
+  return true;
+}
+
+void AHBSwapchainVK::OnPresentComplete(uint32_t generation,
+                                       uint32_t present_id,
+                                       std::optional<size_t> previous_buffer,
+                                       std::chrono::nanoseconds latch_time,
+                                       fml::UniqueFD release_fence) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (generation != generation_) {
+      return;
+    }
+    // The buffer that was on screen has been replaced by this one.
+    if (previous_buffer.has_value() &&
+        previous_buffer.value() < buffers_.size()) {
+      auto& buffer = *buffers_[previous_buffer.value()];
+      buffer.release_fence = std::move(release_fence);
+      buffer.held_by_compositor = false;
+    }
+
+    vk::PastPresentationTimingGOOGLE timing;
+    timing.presentID = present_id;
+    timing.actualPresentTime = latch_time.count();
+    timing.earliestPresentTime = latch_time.count();
+    presentation_timings_.push_back(timing);
+    while (presentation_timings_.size() > kMaxPresentationTimings) {
+      presentation_timings_.pop_front();
+    }
+  }
+  buffer_released_cv_.notify_all();
+}
+
+std::vector<vk::PastPresentationTimingGOOGLE>
+AHBSwapchainVK::TakePastPresentationTimings() {
+  std::scoped_lock lock(mutex_);
+  std::vector<vk::PastPresentationTimingGOOGLE> timings(
+      presentation_timings_.begin(), presentation_timings_.end());
+  presentation_timings_.clear();
+  return timings;
+}
+
+}  // namespace impeller
+
+#endif  // FML_OS_ANDROID
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include "flutter/fml/build_config.h"
+
+#ifdef FML_OS_ANDROID
+
+#include <android/hardware_buffer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/geometry/size.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/surface.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A swapchain that renders into `AHardwareBuffer`s and hands them
+///             to the system compositor itself instead of going through
+///             `VkSwapchainKHR`.
+///
+///             Presenting a buffer exports a sync file that signals when
+///             rendering is done, so neither side blocks on the other, and the
+///             compositor reports back when each buffer was latched and when
+///             the previous one may be written to again. Only as many buffers
+///             as needed are queued, which keeps the latency to at most one
+///             frame behind the one on screen.
+///
+///             The NDK functions needed for this are only available from API
+///             29 and are resolved at runtime, so the platform provides them
+///             through a |Delegate|.
+///
+class AHBSwapchainVK final
+    : public std::enable_shared_from_this<AHBSwapchainVK> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Called once the compositor has applied a presented buffer.
+  ///
+  /// @param[in]  latch_time     When the compositor latched the buffer, on
+  ///                            the `CLOCK_MONOTONIC` time base.
+  /// @param[in]  release_fence  Signals when the buffer presented before this
+  ///                            one may be written to again. May be invalid if
+  ///                            it can be written to right away.
+  ///
+  using PresentCompleteCallback =
+      std::function<void(std::chrono::nanoseconds latch_time,
+                         fml::UniqueFD release_fence)>;
+
+  class Delegate {
+   public:
+    virtual ~Delegate();
+
+    //--------------------------------------------------------------------------
+    /// @brief      The size of the window the buffers are presented to.
+    ///
+    virtual ISize GetSize() const = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Allocates an `AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM` buffer
+    ///             of the given size that can be rendered to and composited,
+    ///             and describes it in `desc`. The caller owns the returned
+    ///             reference.
+    ///
+    virtual AHardwareBuffer* AllocateBuffer(const ISize& size,
+                                            AHardwareBuffer_Desc* desc) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Releases a buffer returned by |AllocateBuffer|.
+    ///
+    virtual void ReleaseBuffer(AHardwareBuffer* buffer) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Shows the buffer on the window once `acquire_fence`
+    ///             signals. `on_complete` may be called on any thread.
+    ///
+    virtual bool PresentBuffer(AHardwareBuffer* buffer,
+                               fml::UniqueFD acquire_fence,
+                               PresentCompleteCallback on_complete) = 0;
+  };
+
+  static std::shared_ptr<AHBSwapchainVK> Create(
+      const std::shared_ptr<Context>& context,
+      std::unique_ptr<Delegate> delegate);
+
+  ~AHBSwapchainVK();
+
+  bool IsValid() const;
+
+  std::unique_ptr<Surface> AcquireNextDrawable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns when the buffers presented since the last call were
+  ///             latched by the compositor, in the same form as the display
+  ///             timings of |SwapchainImplVK|. The actual present time is the
+  ///             latch time, which is at most one refresh cycle before the
+  ///             buffer shows up on the display.
+  ///
+  std::vector<vk::PastPresentationTimingGOOGLE> TakePastPresentationTimings();
+
+ private:
+  struct Buffer;
+
+  std::weak_ptr<Context> context_;
+  std::unique_ptr<Delegate> delegate_;
+  bool supports_sync_fd_export_ = false;
+  ISize size_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  size_t next_buffer_ = 0u;
+  uint32_t next_present_id_ = 1u;
+  bool is_valid_ = false;
+
+  // Guards the state updated by the present callbacks of the delegate.
+  std::mutex mutex_;
+  std::condition_variable buffer_released_cv_;
+  uint32_t generation_ = 0u;
+  std::optional<size_t> last_presented_buffer_;
+  std::deque<vk::PastPresentationTimingGOOGLE> presentation_timings_;
+
+  AHBSwapchainVK(const std::shared_ptr<Context>& context,
+                 std::unique_ptr<Delegate> delegate);
+
+  bool CreateBuffers(const ISize& size);
+
+  void DestroyBuffers();
+
+  void ReleaseBuffers(std::vector<std::unique_ptr<Buffer>> buffers);
+
+  bool Present(size_t index);
+
+  void OnPresentComplete(uint32_t generation,
+                         uint32_t present_id,
+                         std::optional<size_t> previous_buffer,
+                         std::chrono::nanoseconds latch_time,
+                         fml::UniqueFD release_fence);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AHBSwapchainVK);
+};
+
+}  // namespace impeller
+
+#endif  // FML_OS_ANDROID
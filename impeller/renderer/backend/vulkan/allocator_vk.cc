@@ -23,7 +23,8 @@ ToVKBufferMemoryPropertyFlags(StorageMode mode) {
     case StorageMode::kDevicePrivate:
       return vk::MemoryPropertyFlagBits::eDeviceLocal;
     case StorageMode::kDeviceTransient:
-      return vk::MemoryPropertyFlagBits::eLazilyAllocated;
+      // Only images can be backed by lazily allocated memory.
+      return vk::MemoryPropertyFlagBits::eDeviceLocal;
   }
   FML_UNREACHABLE();
 }
@@ -88,8 +89,11 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
                          const vk::PhysicalDevice& physical_device,
                          const std::shared_ptr<DeviceHolder>& device_holder,
                          const vk::Instance& instance,
-                         const CapabilitiesVK& capabilities)
-    : context_(std::move(context)), device_holder_(device_holder) {
+                         const CapabilitiesVK& capabilities,
+                         size_t dedicated_texture_min_bytes)
+    : context_(std::move(context)),
+      device_holder_(device_holder),
+      dedicated_texture_min_bytes_(dedicated_texture_min_bytes) {
   TRACE_EVENT0("impeller", "CreateAllocatorVK");
 
   auto limits = physical_device.getProperties().limits;
@@ -136,6 +140,10 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   allocator_info.device = device_holder->GetDevice();
   allocator_info.instance = instance;
   allocator_info.pVulkanFunctions = &proc_table;
+  if (capabilities.HasOptionalDeviceExtension(
+          OptionalDeviceExtensionVK::kEXTMemoryBudget)) {
+    allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+  }
 
   VmaAllocator allocator = {};
   auto result = vk::Result{::vmaCreateAllocator(&allocator_info, &allocator)};
@@ -225,6 +233,18 @@ static constexpr VmaMemoryUsage ToVMAMemoryUsage() {
   return VMA_MEMORY_USAGE_AUTO;
 }
 
+static constexpr VmaMemoryUsage ToVMAImageMemoryUsage(
+    vk::ImageUsageFlags usage) {
+  // Transient attachments are never read back once the render pass ends, so
+  // tilers don't need to back them with memory at all. Insist on a lazily
+  // allocated memory type instead of merely preferring one, which VMA would
+  // otherwise weigh against the other device local memory types.
+  if (usage & vk::ImageUsageFlagBits::eTransientAttachment) {
+    return VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+  }
+  return ToVMAMemoryUsage();
+}
+
 static constexpr vk::Flags<vk::MemoryPropertyFlagBits>
 ToVKTextureMemoryPropertyFlags(StorageMode mode,
                                bool supports_memoryless_textures) {
@@ -263,7 +283,9 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                            const TextureDescriptor& desc,
                            VmaAllocator allocator,
                            vk::Device device,
-                           bool supports_memoryless_textures)
+                           bool supports_memoryless_textures,
+                           size_t dedicated_min_bytes,
+                           std::shared_ptr<std::atomic<size_t>> counter)
       : TextureSourceVK(desc), resource_(std::move(resource_manager)) {
     TRACE_EVENT0("impeller", "CreateDeviceTexture");
     vk::ImageCreateInfo image_info;
@@ -287,11 +309,17 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
     VmaAllocationCreateInfo alloc_nfo = {};
 
-    alloc_nfo.usage = ToVMAMemoryUsage();
+    alloc_nfo.usage = ToVMAImageMemoryUsage(image_info.usage);
     alloc_nfo.preferredFlags =
         static_cast<VkMemoryPropertyFlags>(ToVKTextureMemoryPropertyFlags(
             desc.storage_mode, supports_memoryless_textures));
     alloc_nfo.flags = ToVmaAllocationCreateFlags(desc.storage_mode);
+    if (dedicated_min_bytes > 0u &&
+        desc.GetByteSizeOfBaseMipLevel() *
+                static_cast<size_t>(desc.sample_count) >=
+            dedicated_min_bytes) {
+      alloc_nfo.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    }
 
     auto create_info_native =
         static_cast<vk::ImageCreateInfo::NativeType>(image_info);
@@ -350,10 +378,19 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
     }
     resource_.Swap(ImageResource(ImageVMA{allocator, allocation, image},
                                  std::move(image_view)));
+    counter_ = std::move(counter);
+    bytes_ = allocation_info.size;
+    if (counter_) {
+      *counter_ += bytes_;
+    }
     is_valid_ = true;
   }
 
-  ~AllocatedTextureSourceVK() = default;
+  ~AllocatedTextureSourceVK() {
+    if (counter_) {
+      *counter_ -= bytes_;
+    }
+  }
 
   bool IsValid() const { return is_valid_; }
 
@@ -382,6 +419,9 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
   };
 
   UniqueResourceVKT<ImageResource> resource_;
+  // The allocation stat of the category of the texture.
+  std::shared_ptr<std::atomic<size_t>> counter_;
+  size_t bytes_ = 0u;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatedTextureSourceVK);
@@ -402,12 +442,21 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!context) {
     return nullptr;
   }
+  // Aliases the stats of the texture's category, so that they stay alive as
+  // long as the texture does.
+  std::shared_ptr<std::atomic<size_t>> counter(
+      texture_bytes_,
+      desc.usage & static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)
+          ? &texture_bytes_->render_target_bytes
+          : &texture_bytes_->texture_bytes);
   auto source = std::make_shared<AllocatedTextureSourceVK>(
       ContextVK::Cast(*context).GetResourceManager(),  //
       desc,                                            //
       allocator_.get(),                                //
       device_holder->GetDevice(),                      //
-      supports_memoryless_textures_                    //
+      supports_memoryless_textures_,                   //
+      dedicated_texture_min_bytes_,                    //
+      std::move(counter)                               //
   );
   if (!source->IsValid()) {
     return nullptr;
@@ -418,6 +467,62 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
 void AllocatorVK::DidAcquireSurfaceFrame() {
   frame_count_++;
   raster_thread_id_ = std::this_thread::get_id();
+  if (!IsValid()) {
+    return;
+  }
+
+  // Lets the allocator refresh the budgets reported by the driver.
+  ::vmaSetCurrentFrameIndex(allocator_.get(), frame_count_);
+  bool under_memory_pressure = false;
+  for (const auto& heap : GetHeapBudgets()) {
+    if (heap.budget_bytes > 0u &&
+        heap.usage_bytes >
+            static_cast<size_t>(heap.budget_bytes * kMemoryPressureThreshold)) {
+      under_memory_pressure = true;
+      break;
+    }
+  }
+  if (under_memory_pressure && !under_memory_pressure_) {
+    FML_LOG(INFO) << "Impeller is running low on device memory.";
+  }
+  under_memory_pressure_ = under_memory_pressure;
+}
+
+bool AllocatorVK::IsUnderMemoryPressure() const {
+  return under_memory_pressure_;
+}
+
+std::vector<AllocatorVK::HeapBudget> AllocatorVK::GetHeapBudgets() const {
+  if (!IsValid()) {
+    return {};
+  }
+  const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+  ::vmaGetMemoryProperties(allocator_.get(), &memory_properties);
+  std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+  ::vmaGetHeapBudgets(allocator_.get(), budgets.data());
+
+  std::vector<HeapBudget> result;
+  result.reserve(memory_properties->memoryHeapCount);
+  for (uint32_t i = 0; i < memory_properties->memoryHeapCount; i++) {
+    result.push_back(HeapBudget{
+        .budget_bytes = static_cast<size_t>(budgets[i].budget),
+        .usage_bytes = static_cast<size_t>(budgets[i].usage),
+    });
+  }
+  return result;
+}
+
+AllocatorVK::Stats AllocatorVK::GetStats() const {
+  Stats stats;
+  stats.render_target_bytes = texture_bytes_->render_target_bytes;
+  stats.texture_bytes = texture_bytes_->texture_bytes;
+  if (IsValid() && created_buffer_pool_) {
+    VmaStatistics pool_stats = {};
+    ::vmaGetPoolStatistics(allocator_.get(), staging_buffer_pool_.get().pool,
+                           &pool_stats);
+    stats.host_buffer_bytes = static_cast<size_t>(pool_stats.allocationBytes);
+  }
+  return stats;
 }
 
 // |Allocator|
@@ -13,18 +13,52 @@
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace impeller {
 
 class AllocatorVK final : public Allocator {
  public:
+  /// The fraction of the budget of a heap that may be in use before the
+  /// allocator reports memory pressure.
+  static constexpr Scalar kMemoryPressureThreshold = 0.9f;
+
+  struct HeapBudget {
+    /// How much memory the process can allocate from the heap. Without
+    /// `VK_EXT_memory_budget`, this is an estimate based on the heap size.
+    size_t budget_bytes = 0u;
+    /// How much memory the process has allocated from the heap.
+    size_t usage_bytes = 0u;
+  };
+
+  struct Stats {
+    size_t render_target_bytes = 0u;
+    size_t texture_bytes = 0u;
+    /// The memory allocated from the staging buffer pool, which host visible
+    /// buffers created on the raster thread come from.
+    size_t host_buffer_bytes = 0u;
+  };
+
   // |Allocator|
   ~AllocatorVK() override;
 
+  // |Allocator|
+  bool IsUnderMemoryPressure() const override;
+
+  std::vector<HeapBudget> GetHeapBudgets() const;
+
+  Stats GetStats() const;
+
  private:
   friend class ContextVK;
 
+  struct TextureBytes {
+    std::atomic<size_t> render_target_bytes = 0u;
+    std::atomic<size_t> texture_bytes = 0u;
+  };
+
   UniqueAllocatorVMA allocator_;
   UniquePoolVMA staging_buffer_pool_;
   std::weak_ptr<Context> context_;
@@ -36,13 +70,18 @@ class AllocatorVK final : public Allocator {
   bool created_buffer_pool_ = true;
   uint32_t frame_count_ = 0;
   std::thread::id raster_thread_id_;
+  const size_t dedicated_texture_min_bytes_;
+  std::shared_ptr<TextureBytes> texture_bytes_ =
+      std::make_shared<TextureBytes>();
+  std::atomic_bool under_memory_pressure_ = false;
 
   AllocatorVK(std::weak_ptr<Context> context,
               uint32_t vulkan_api_version,
               const vk::PhysicalDevice& physical_device,
               const std::shared_ptr<DeviceHolder>& device_holder,
               const vk::Instance& instance,
-              const CapabilitiesVK& capabilities);
+              const CapabilitiesVK& capabilities,
+              size_t dedicated_texture_min_bytes);
 
   // |Allocator|
   bool IsValid() const;
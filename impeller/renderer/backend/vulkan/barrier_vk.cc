@@ -4,4 +4,38 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+namespace impeller {
+
+BarrierBatchVK::BarrierBatchVK(vk::CommandBuffer cmd_buffer)
+    : cmd_buffer_(cmd_buffer) {}
+
+BarrierBatchVK::~BarrierBatchVK() = default;
+
+void BarrierBatchVK::AddImageBarrier(const BarrierVK& barrier,
+                                     vk::ImageMemoryBarrier image_barrier) {
+  src_stage_ |= barrier.src_stage;
+  dst_stage_ |= barrier.dst_stage;
+  image_barriers_.push_back(image_barrier);
+}
+
+void BarrierBatchVK::Flush() {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  cmd_buffer_.pipelineBarrier(src_stage_,       // src stage
+                              dst_stage_,       // dst stage
+                              {},               // dependency flags
+                              nullptr,          // memory barriers
+                              nullptr,          // buffer barriers
+                              image_barriers_   // image barriers
+  );
+  src_stage_ = {};
+  dst_stage_ = {};
+  image_barriers_.clear();
+}
+
+size_t BarrierBatchVK::GetPendingBarrierCount() const {
+  return image_barriers_.size();
+}
+
+}  // namespace impeller
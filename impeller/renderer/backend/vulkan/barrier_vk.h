@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
@@ -42,4 +44,45 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Collects the image layout transitions needed before a pass and
+///             encodes them with a single pipeline barrier.
+///
+///             The stages of the combined barrier are the union of the stages
+///             of every transition, so the batch is never less synchronized
+///             than encoding each transition on its own. Transitions are
+///             added by `TextureSourceVK::SetLayout`, which also keeps track
+///             of the layout each texture will be in once the batch is
+///             flushed.
+///
+class BarrierBatchVK {
+ public:
+  explicit BarrierBatchVK(vk::CommandBuffer cmd_buffer);
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an image transition to the batch. The stages and access
+  ///             masks are taken from `barrier`.
+  ///
+  void AddImageBarrier(const BarrierVK& barrier,
+                       vk::ImageMemoryBarrier image_barrier);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes all pending transitions to the command buffer, if
+  ///             there are any.
+  ///
+  void Flush();
+
+  size_t GetPendingBarrierCount() const;
+
+ private:
+  const vk::CommandBuffer cmd_buffer_;
+  vk::PipelineStageFlags src_stage_;
+  vk::PipelineStageFlags dst_stage_;
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BarrierBatchVK);
+};
+
 }  // namespace impeller
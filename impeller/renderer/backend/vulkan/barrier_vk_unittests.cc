@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class FakeTextureSourceVK final : public TextureSourceVK {
+ public:
+  explicit FakeTextureSourceVK(TextureDescriptor desc)
+      : TextureSourceVK(desc) {}
+
+  vk::Image GetImage() const override { return {}; }
+
+  vk::ImageView GetImageView() const override { return {}; }
+};
+
+}  // namespace
+
+TEST(BarrierBatchVKTest, EncodesOneBarrierForManyTransitions) {
+  auto context = MockVulkanContextBuilder().Build();
+  auto encoder = CommandEncoderFactoryVK(context).Create();
+  ASSERT_TRUE(encoder);
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {1, 1};
+  FakeTextureSourceVK first(desc);
+  FakeTextureSourceVK second(desc);
+
+  BarrierVK barrier;
+  barrier.src_stage = vk::PipelineStageFlagBits::eTransfer;
+  barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+  BarrierBatchVK barriers(encoder->GetCommandBuffer());
+  ASSERT_TRUE(first.SetLayout(barrier, barriers).ok());
+  ASSERT_TRUE(second.SetLayout(barrier, barriers).ok());
+  // Textures that are already in the requested layout aren't transitioned
+  // again.
+  ASSERT_TRUE(first.SetLayout(barrier, barriers).ok());
+  EXPECT_EQ(barriers.GetPendingBarrierCount(), 2u);
+  EXPECT_EQ(first.GetLayout(), vk::ImageLayout::eShaderReadOnlyOptimal);
+  EXPECT_EQ(second.GetLayout(), vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  barriers.Flush();
+  EXPECT_EQ(barriers.GetPendingBarrierCount(), 0u);
+  // Flushing an empty batch encodes nothing.
+  barriers.Flush();
+
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdPipelineBarrier"),
+            1);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -34,7 +34,6 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   }
 
   BarrierVK src_barrier;
-  src_barrier.cmd_buffer = cmd_buffer;
   src_barrier.new_layout = vk::ImageLayout::eTransferSrcOptimal;
   src_barrier.src_access = vk::AccessFlagBits::eTransferWrite |
                            vk::AccessFlagBits::eShaderWrite |
@@ -46,7 +45,6 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   src_barrier.dst_stage = vk::PipelineStageFlagBits::eTransfer;
 
   BarrierVK dst_barrier;
-  dst_barrier.cmd_buffer = cmd_buffer;
   dst_barrier.new_layout = vk::ImageLayout::eTransferDstOptimal;
   dst_barrier.src_access = {};
   dst_barrier.src_stage = vk::PipelineStageFlagBits::eTopOfPipe;
@@ -55,10 +53,13 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  BarrierBatchVK barriers(cmd_buffer);
+  if (!src.SetLayout(src_barrier, barriers) ||
+      !dst.SetLayout(dst_barrier, barriers)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  barriers.Flush();
 
   vk::ImageCopy image_copy;
 
@@ -185,8 +186,13 @@ bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
       vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
   image_copy.setImageOffset(
       vk::Offset3D(destination_origin.x, destination_origin.y, 0));
-  image_copy.setImageExtent(vk::Extent3D(destination->GetSize().width,
-                                         destination->GetSize().height, 1));
+  // The source holds whole rows, which may be fewer than the image has.
+  const auto bytes_per_row =
+      destination->GetSize().width *
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  image_copy.setImageExtent(
+      vk::Extent3D(destination->GetSize().width,
+                   source.range.length / bytes_per_row, 1));
 
   if (!dst.SetLayout(dst_barrier)) {
     VALIDATION_LOG << "Could not encode layout transition.";
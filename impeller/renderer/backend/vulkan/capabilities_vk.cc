@@ -156,6 +156,14 @@ static const char* GetDeviceExtensionName(OptionalDeviceExtensionVK ext) {
   switch (ext) {
     case OptionalDeviceExtensionVK::kEXTPipelineCreationFeedback:
       return VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kEXTMemoryBudget:
+      return VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kGOOGLEDisplayTiming:
+      return VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kEXTDescriptorIndexing:
+      return VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRExternalSemaphoreFd:
+      return VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -313,6 +321,47 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Images with block compressed formats can only be created when the
+  // feature for their family of formats is enabled.
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionBC = device_features.textureCompressionBC;
+
+  return required;
+}
+
+std::optional<vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>
+CapabilitiesVK::GetEnabledDescriptorIndexingFeatures(
+    const vk::PhysicalDevice& device) const {
+  auto exts = GetSupportedDeviceExtensions(device);
+  if (!exts.has_value() ||
+      exts->find(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == exts->end()) {
+    return std::nullopt;
+  }
+
+  const auto features =
+      device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                          vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>();
+  const auto& supported =
+      features.get<vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>();
+
+  // A partially bound, variable sized array of sampled images that can be
+  // updated while in use, indexed by a value that may differ per instance.
+  if (!supported.runtimeDescriptorArray ||
+      !supported.descriptorBindingPartiallyBound ||
+      !supported.descriptorBindingVariableDescriptorCount ||
+      !supported.descriptorBindingSampledImageUpdateAfterBind ||
+      !supported.shaderSampledImageArrayNonUniformIndexing) {
+    return std::nullopt;
+  }
+
+  vk::PhysicalDeviceDescriptorIndexingFeaturesEXT required;
+  required.runtimeDescriptorArray = true;
+  required.descriptorBindingPartiallyBound = true;
+  required.descriptorBindingVariableDescriptorCount = true;
+  required.descriptorBindingSampledImageUpdateAfterBind = true;
+  required.shaderSampledImageArrayNonUniformIndexing = true;
   return required;
 }
 
@@ -386,6 +435,16 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     }
   }
 
+  supports_bindless_textures_ =
+      GetEnabledDescriptorIndexingFeatures(device).has_value();
+
+  {
+    const auto features = device.getFeatures();
+    supports_texture_compression_astc_ = features.textureCompressionASTC_LDR;
+    supports_texture_compression_etc2_ = features.textureCompressionETC2;
+    supports_texture_compression_bc_ = features.textureCompressionBC;
+  }
+
   // Determine the optional device extensions this physical device supports.
   {
     optional_device_extensions_.clear();
@@ -460,6 +519,30 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsBindlessTextures() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_bindless_textures_;
+}
+
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionASTC() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_texture_compression_astc_;
+}
+
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionETC2() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_texture_compression_etc2_;
+}
+
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionBC() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_texture_compression_bc_;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
@@ -21,6 +21,14 @@ class ContextVK;
 enum class OptionalDeviceExtensionVK : uint32_t {
   // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_pipeline_creation_feedback.html
   kEXTPipelineCreationFeedback,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_memory_budget.html
+  kEXTMemoryBudget,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_GOOGLE_display_timing.html
+  kGOOGLEDisplayTiming,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_descriptor_indexing.html
+  kEXTDescriptorIndexing,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_external_semaphore_fd.html
+  kKHRExternalSemaphoreFd,
   kLast,
 };
 
@@ -50,6 +58,17 @@ class CapabilitiesVK final : public Capabilities,
   std::optional<vk::PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The descriptor indexing features to chain into the device
+  ///             create info.
+  ///
+  /// @return     The features, or `std::nullopt` if the device doesn't
+  ///             support all the ones bindless textures need.
+  ///
+  std::optional<vk::PhysicalDeviceDescriptorIndexingFeaturesEXT>
+  GetEnabledDescriptorIndexingFeatures(
+      const vk::PhysicalDevice& physical_device) const;
+
   [[nodiscard]] bool SetPhysicalDevice(
       const vk::PhysicalDevice& physical_device);
 
@@ -90,6 +109,18 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsBindlessTextures() const override;
+
+  // |Capabilities|
+  bool SupportsTextureCompressionASTC() const override;
+
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override;
+
+  // |Capabilities|
+  bool SupportsTextureCompressionBC() const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -109,6 +140,10 @@ class CapabilitiesVK final : public Capabilities,
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_bindless_textures_ = false;
+  bool supports_texture_compression_astc_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_bc_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
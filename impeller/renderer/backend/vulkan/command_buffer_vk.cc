@@ -52,6 +52,10 @@ const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() {
 }
 
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
+  // Uploads this command buffer may depend on have to be submitted first.
+  if (auto context = context_.lock()) {
+    context->FlushCommandBuffers();
+  }
   if (!callback) {
     return encoder_->Submit();
   }
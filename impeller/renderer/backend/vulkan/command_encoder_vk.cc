@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 
+#include <utility>
+
 #include "flutter/fml/closure.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
@@ -134,9 +136,15 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
                             label_.value());
   }
 
-  return std::make_shared<CommandEncoderVK>(context_vk.GetDeviceHolder(),
-                                            tracked_objects, queue,
-                                            context_vk.GetFenceWaiter());
+  auto encoder = std::make_shared<CommandEncoderVK>(
+      context_vk.GetDeviceHolder(), tracked_objects, queue,
+      context_vk.GetFenceWaiter());
+  if (auto gpu_tracer = context_vk.GetGPUTracerVK()) {
+    encoder->gpu_query_ =
+        gpu_tracer->RecordCmdBufferStart(tracked_objects->GetCommandBuffer());
+    encoder->gpu_tracer_ = std::move(gpu_tracer);
+  }
+  return encoder;
 }
 
 CommandEncoderVK::CommandEncoderVK(
@@ -149,66 +157,134 @@ CommandEncoderVK::CommandEncoderVK(
       queue_(queue),
       fence_waiter_(std::move(fence_waiter)) {}
 
-CommandEncoderVK::~CommandEncoderVK() = default;
+CommandEncoderVK::~CommandEncoderVK() {
+  if (gpu_query_.has_value()) {
+    gpu_tracer_->OnCmdBufferCompleted(gpu_query_.value(), false);
+  }
+}
 
 bool CommandEncoderVK::IsValid() const {
   return is_valid_;
 }
 
 bool CommandEncoderVK::Submit(SubmitCallback callback) {
-  // Make sure to call callback with `false` if anything returns early.
-  bool fail_callback = !!callback;
+  return SubmitEncoders({this}, std::move(callback));
+}
+
+bool CommandEncoderVK::SubmitBatch(
+    const std::vector<std::shared_ptr<CommandEncoderVK>>& encoders,
+    SubmitCallback callback) {
+  std::vector<CommandEncoderVK*> raw_encoders;
+  raw_encoders.reserve(encoders.size());
+  for (const auto& encoder : encoders) {
+    raw_encoders.push_back(encoder.get());
+  }
+  return SubmitEncoders(raw_encoders, std::move(callback));
+}
+
+bool CommandEncoderVK::EndRecording() {
   if (!IsValid()) {
-    VALIDATION_LOG << "Cannot submit invalid CommandEncoderVK.";
-    if (fail_callback) {
-      callback(false);
-    }
     return false;
   }
-
-  // Success or failure, you only get to submit once.
-  fml::ScopedCleanupClosure reset([&]() {
-    if (fail_callback) {
-      callback(false);
-    }
-    Reset();
-  });
+  if (recording_ended_) {
+    return true;
+  }
 
   InsertDebugMarker("QueueSubmit");
 
   auto command_buffer = GetCommandBuffer();
 
+  if (gpu_query_.has_value()) {
+    gpu_tracer_->RecordCmdBufferEnd(command_buffer, gpu_query_.value());
+  }
+
   auto status = command_buffer.end();
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to end command buffer: " << vk::to_string(status);
     return false;
   }
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  recording_ended_ = true;
+  return true;
+}
+
+bool CommandEncoderVK::SubmitEncoders(
+    const std::vector<CommandEncoderVK*>& encoders,
+    SubmitCallback callback) {
+  // Make sure to call callback with `false` if anything returns early.
+  bool fail_callback = !!callback;
+
+  // Success or failure, you only get to submit once.
+  fml::ScopedCleanupClosure reset([&]() {
+    if (fail_callback) {
+      callback(false);
+    }
+    for (auto* encoder : encoders) {
+      if (encoder) {
+        encoder->Reset();
+      }
+    }
+  });
+
+  if (encoders.empty()) {
+    return false;
+  }
+
+  std::vector<vk::CommandBuffer> buffers;
+  buffers.reserve(encoders.size());
+  for (auto* encoder : encoders) {
+    if (!encoder || !encoder->IsValid()) {
+      VALIDATION_LOG << "Cannot submit invalid CommandEncoderVK.";
+      return false;
+    }
+    if (!encoder->EndRecording()) {
+      return false;
+    }
+    buffers.push_back(encoder->GetCommandBuffer());
+  }
+
+  // All encoders come from the same context, and so share a queue and a fence
+  // waiter.
+  auto& first = *encoders.front();
+  std::shared_ptr<const DeviceHolder> strong_device =
+      first.device_holder_.lock();
   if (!strong_device) {
     VALIDATION_LOG << "Device lost.";
     return false;
   }
-  auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
+  auto fence = first.fence_waiter_->CreateFence();
+  if (!fence) {
     return false;
   }
 
   vk::SubmitInfo submit_info;
-  std::vector<vk::CommandBuffer> buffers = {command_buffer};
   submit_info.setCommandBuffers(buffers);
-  status = queue_->Submit(submit_info, *fence);
+  auto status = first.queue_->Submit(submit_info, *fence);
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
     return false;
   }
 
+  std::vector<std::shared_ptr<TrackedObjectsVK>> tracked_objects;
+  std::vector<std::pair<std::shared_ptr<GPUTracerVK>, GPUTracerVK::Query>>
+      gpu_queries;
+  for (auto* encoder : encoders) {
+    tracked_objects.push_back(std::move(encoder->tracked_objects_));
+    if (auto gpu_query = std::exchange(encoder->gpu_query_, {});
+        gpu_query.has_value()) {
+      gpu_queries.emplace_back(encoder->gpu_tracer_, gpu_query.value());
+    }
+  }
+
   // Submit will proceed, call callback with true when it is done and do not
   // call when `reset` is collected.
   fail_callback = false;
-  return fence_waiter_->AddFence(
+  return first.fence_waiter_->AddFence(
       std::move(fence),
-      [callback, tracked_objects = std::move(tracked_objects_)] {
+      [callback, tracked_objects = std::move(tracked_objects),
+       gpu_queries = std::move(gpu_queries)] {
+        for (const auto& [gpu_tracer, gpu_query] : gpu_queries) {
+          gpu_tracer->OnCmdBufferCompleted(gpu_query, true);
+        }
         if (callback) {
           callback(true);
         }
@@ -292,6 +368,18 @@ std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
       layout, command_count);
 }
 
+std::optional<vk::DescriptorSet> CommandEncoderVK::WriteDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes,
+    size_t command_count) {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+
+  return tracked_objects_->GetDescriptorPool().WriteDescriptorSet(
+      layout, writes, command_count);
+}
+
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
   if (!HasValidationLayers()) {
     return;
@@ -7,12 +7,14 @@
 #include <functional>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -58,6 +60,28 @@ class CommandEncoderVK {
 
   bool Submit(SubmitCallback callback = {});
 
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the command buffers of all `encoders` to the queue
+  ///             in a single submission, with a single fence. The callback
+  ///             is invoked once all of them have completed.
+  ///
+  ///             All encoders must have been created by the same context.
+  ///
+  static bool SubmitBatch(
+      const std::vector<std::shared_ptr<CommandEncoderVK>>& encoders,
+      SubmitCallback callback = {});
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends recording of the command buffer without submitting it.
+  ///
+  ///             Vulkan requires commands to be recorded on the thread that
+  ///             owns the command pool of the command buffer, but not to be
+  ///             submitted there. Ending recording ahead of time allows the
+  ///             command buffer to be submitted later from any thread. No more
+  ///             commands may be recorded afterwards.
+  ///
+  bool EndRecording();
+
   bool Track(std::shared_ptr<SharedObjectVK> object);
 
   bool Track(std::shared_ptr<const Buffer> buffer);
@@ -82,14 +106,26 @@ class CommandEncoderVK {
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  std::optional<vk::DescriptorSet> WriteDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes,
+      size_t command_count);
+
  private:
   friend class ContextVK;
+  friend class CommandEncoderFactoryVK;
 
   std::weak_ptr<const DeviceHolder> device_holder_;
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<GPUTracerVK> gpu_tracer_;
+  std::optional<GPUTracerVK::Query> gpu_query_;
   bool is_valid_ = true;
+  bool recording_ended_ = false;
+
+  static bool SubmitEncoders(const std::vector<CommandEncoderVK*>& encoders,
+                             SubmitCallback callback);
 
   void Reset();
 
@@ -68,6 +68,7 @@ CommandPoolVK::~CommandPoolVK() {
     return;
   }
 
+  Lock pool_lock(pool_mutex_);
   auto reset_pool_when_dropped = BackgroundCommandPoolVK(
       std::move(pool_), std::move(collected_buffers_), recycler);
 
@@ -78,17 +79,22 @@ CommandPoolVK::~CommandPoolVK() {
 }
 
 // TODO(matanlurey): Return a status_or<> instead of {} when we have one.
-vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   auto const context = context_.lock();
   if (!context) {
     return {};
   }
 
+  Lock pool_lock(pool_mutex_);
+  if (!pool_) {
+    return {};
+  }
   auto const device = context->GetDevice();
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
@@ -97,6 +103,7 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
 }
 
 void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
+  Lock pool_lock(pool_mutex_);
   if (!pool_) {
     // If the command pool has already been destroyed, just free the buffer.
     return;
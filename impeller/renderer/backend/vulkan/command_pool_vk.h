@@ -7,6 +7,8 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
+
 #include "fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -24,7 +26,12 @@ class CommandPoolRecyclerVK;
 /// the lifecycle of a single |vk::CommandPool| by returning to the origin
 /// (|CommandPoolRecyclerVK|) when it is destroyed to be reused.
 ///
-/// @warning    This class is not thread-safe.
+/// Command buffers are created on the thread the pool belongs to, but are
+/// collected on whichever thread finds out that the GPU is done with them
+/// (usually the fence waiter). Access to the underlying pool is synchronized
+/// so that both can happen at the same time.
+///
+/// @note       This class is thread-safe.
 ///
 /// @see        |CommandPoolRecyclerVK|
 class CommandPoolVK final {
@@ -42,10 +49,15 @@ class CommandPoolVK final {
 
   /// @brief      Creates and returns a new |vk::CommandBuffer|.
   ///
+  /// @param[in]  level  Whether to create a primary command buffer, or a
+  ///                    secondary one that is recorded separately and then
+  ///                    executed by a primary command buffer.
+  ///
   /// @return     Always returns a new |vk::CommandBuffer|, but if for any
   ///             reason a valid command buffer could not be created, it will be
   ///             a `{}` default instance (i.e. while being torn down).
-  vk::UniqueCommandBuffer CreateCommandBuffer();
+  vk::UniqueCommandBuffer CreateCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Collects the given |vk::CommandBuffer| to be retained.
   ///
@@ -57,11 +69,13 @@ class CommandPoolVK final {
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolVK);
 
-  vk::UniqueCommandPool pool_;
+  Mutex pool_mutex_;
+  vk::UniqueCommandPool pool_ IPLR_GUARDED_BY(pool_mutex_);
   std::weak_ptr<ContextVK>& context_;
 
   // Used to retain a reference on these until the pool is reset.
-  std::vector<vk::UniqueCommandBuffer> collected_buffers_;
+  std::vector<vk::UniqueCommandBuffer> collected_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
 };
 
 //------------------------------------------------------------------------------
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <thread>
+#include <vector>
+
 #include "flutter/testing/testing.h"  // IWYU pragma: keep.
 #include "fml/synchronization/waitable_event.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -52,6 +55,104 @@ TEST(CommandPoolRecyclerVKTest, GetsTheSameCommandPoolOnSameThread) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, CreatesSecondaryCommandBuffers) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const pool = context->GetCommandPoolRecycler()->Get();
+    auto buffer =
+        pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    EXPECT_TRUE(buffer);
+    pool->CollectCommandBuffer(std::move(buffer));
+  }
+
+  context->Shutdown();
+}
+
+TEST(CommandPoolRecyclerVKTest, CollectsCommandBuffersFromOtherThreads) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const pool = context->GetCommandPoolRecycler()->Get();
+
+    // Command buffers are created on the thread of the pool while the ones
+    // the GPU is done with are collected on another thread.
+    constexpr size_t kBufferCount = 1000u;
+    Mutex pending_mutex;
+    std::vector<vk::UniqueCommandBuffer> pending;
+    bool done = false;
+    std::thread collector([&]() {
+      while (true) {
+        std::vector<vk::UniqueCommandBuffer> buffers;
+        bool finished = false;
+        {
+          Lock lock(pending_mutex);
+          buffers.swap(pending);
+          finished = done;
+        }
+        if (finished && buffers.empty()) {
+          return;
+        }
+        for (auto& buffer : buffers) {
+          pool->CollectCommandBuffer(std::move(buffer));
+        }
+      }
+    });
+
+    for (size_t i = 0; i < kBufferCount; i++) {
+      auto buffer = pool->CreateCommandBuffer();
+      EXPECT_TRUE(buffer);
+      Lock lock(pending_mutex);
+      pending.push_back(std::move(buffer));
+    }
+    {
+      Lock lock(pending_mutex);
+      done = true;
+    }
+    collector.join();
+  }
+
+  context->Shutdown();
+}
+
+TEST(CommandPoolRecyclerVKTest, RecordsOnManyThreadsAtOnce) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    constexpr size_t kThreadCount = 8u;
+    constexpr size_t kBuffersPerThread = 100u;
+    std::vector<std::shared_ptr<CommandPoolVK>> pools(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; i++) {
+      threads.emplace_back([&context, &pools, i]() {
+        auto const pool = context->GetCommandPoolRecycler()->Get();
+        ASSERT_NE(pool, nullptr);
+        for (size_t j = 0; j < kBuffersPerThread; j++) {
+          auto buffer = pool->CreateCommandBuffer(
+              j % 2 == 0 ? vk::CommandBufferLevel::ePrimary
+                         : vk::CommandBufferLevel::eSecondary);
+          EXPECT_TRUE(buffer);
+          pool->CollectCommandBuffer(std::move(buffer));
+        }
+        pools[i] = pool;
+        context->GetCommandPoolRecycler()->Dispose();
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Every thread records into a pool of its own.
+    for (size_t i = 0; i < kThreadCount; i++) {
+      for (size_t j = i + 1; j < kThreadCount; j++) {
+        EXPECT_NE(pools[i], pools[j]);
+      }
+    }
+  }
+
+  context->Shutdown();
+}
+
 namespace {
 
 // Invokes the provided callback when the destructor is called.
@@ -33,9 +33,8 @@ void ComputePassVK::OnSetLabel(const std::string& label) {
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
   barrier.src_access = vk::AccessFlagBits::eTransferWrite;
   barrier.src_stage = vk::PipelineStageFlagBits::eTransfer;
   barrier.dst_access = vk::AccessFlagBits::eShaderRead;
@@ -44,7 +43,8 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
   barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    if (!TextureVK::Cast(*data.texture.resource)
+             .SetLayout(barrier, barriers)) {
       return false;
     }
   }
@@ -52,14 +52,14 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
 }
 
 static bool UpdateBindingLayouts(const ComputeCommand& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.bindings, barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<ComputeCommand>& commands,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
@@ -220,10 +220,12 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
   }
   auto cmd_buffer = encoder->GetCommandBuffer();
 
-  if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
+  BarrierBatchVK barriers(cmd_buffer);
+  if (!UpdateBindingLayouts(commands_, barriers)) {
     VALIDATION_LOG << "Could not update binding layouts for compute pass.";
     return false;
   }
+  barriers.Flush();
 
   {
     TRACE_EVENT0("impeller", "EncodeComputePassCommands");
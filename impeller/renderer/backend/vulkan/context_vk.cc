@@ -19,6 +19,7 @@
 #include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/core/device_buffer_ring.h"
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
@@ -26,6 +27,7 @@
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/capabilities.h"
@@ -37,6 +39,10 @@ namespace impeller {
 // TODO(csg): Fix this after caps are reworked.
 static bool gHasValidationLayers = false;
 
+// Uploads are usually flushed by the next frame, but bound how many can pile
+// up on threads that don't render.
+static constexpr size_t kMaxPendingCommandBuffers = 32u;
+
 bool HasValidationLayers() {
   return gHasValidationLayers;
 }
@@ -314,6 +320,12 @@ void ContextVK::Setup(Settings settings) {
   device_info.setQueueCreateInfos(queue_create_infos);
   device_info.setPEnabledExtensionNames(enabled_device_extensions_c);
   device_info.setPEnabledFeatures(&enabled_features.value());
+  auto descriptor_indexing_features =
+      caps->GetEnabledDescriptorIndexingFeatures(
+          device_holder->physical_device);
+  if (descriptor_indexing_features.has_value()) {
+    device_info.setPNext(&descriptor_indexing_features.value());
+  }
   // Device layers are deprecated and ignored.
 
   {
@@ -340,8 +352,8 @@ void ContextVK::Setup(Settings settings) {
       device_holder->physical_device,  //
       device_holder,                   //
       device_holder->instance.get(),   //
-      *caps                            //
-      ));
+      *caps,                           //
+      settings.dedicated_texture_min_bytes));
 
   if (!allocator->IsValid()) {
     VALIDATION_LOG << "Could not create memory allocator.";
@@ -415,6 +427,21 @@ void ContextVK::Setup(Settings settings) {
   dispatcher.vkGetPhysicalDeviceProperties(device_holder->physical_device,
                                            &physical_device_properties);
 
+  //----------------------------------------------------------------------------
+  /// Create the GPU tracer if the graphics queue supports timestamps.
+  ///
+  std::shared_ptr<GPUTracerVK> gpu_tracer;
+  {
+    auto queue_families =
+        device_holder->physical_device.getQueueFamilyProperties();
+    if (graphics_queue->family < queue_families.size()) {
+      gpu_tracer = GPUTracerVK::Create(
+          device_holder,
+          vk::PhysicalDeviceLimits(physical_device_properties.limits),
+          queue_families[graphics_queue->family].timestampValidBits);
+    }
+  }
+
   //----------------------------------------------------------------------------
   /// All done!
   ///
@@ -429,9 +456,18 @@ void ContextVK::Setup(Settings settings) {
   fence_waiter_ = std::move(fence_waiter);
   resource_manager_ = std::move(resource_manager);
   command_pool_recycler_ = std::move(command_pool_recycler);
+  gpu_tracer_ = std::move(gpu_tracer);
   device_name_ = std::string(physical_device_properties.deviceName);
+  present_mode_ = settings.present_mode;
+  swapchain_image_count_ = settings.swapchain_image_count;
+  max_frames_in_flight_ = std::max(settings.max_frames_in_flight, 1u);
   is_valid_ = true;
 
+  // Host visible buffers are persistently mapped and command buffers track
+  // the buffers they bind until their fences signal, so the transients
+  // buffers of render passes can be written in place.
+  SetTransientsBufferRing(DeviceBufferRing::Create(allocator_));
+
   //----------------------------------------------------------------------------
   /// Label all the relevant objects. This happens after setup so that the
   /// debug messengers have had a chance to be set up.
@@ -475,6 +511,40 @@ std::shared_ptr<CommandBuffer> ContextVK::CreateCommandBuffer() const {
   );
 }
 
+bool ContextVK::EnqueueCommandBuffer(
+    std::shared_ptr<CommandBuffer> command_buffer) const {
+  if (!command_buffer) {
+    return false;
+  }
+  auto encoder = CommandBufferVK::Cast(*command_buffer).GetEncoder();
+  // Recording has to end on the thread that owns the command pool, which is
+  // not necessarily the one that flushes.
+  if (!encoder || !encoder->EndRecording()) {
+    return false;
+  }
+  size_t pending_count = 0u;
+  {
+    Lock lock(pending_encoders_mutex_);
+    pending_encoders_.push_back(std::move(encoder));
+    pending_count = pending_encoders_.size();
+  }
+  if (pending_count >= kMaxPendingCommandBuffers) {
+    return FlushCommandBuffers();
+  }
+  return true;
+}
+
+bool ContextVK::FlushCommandBuffers() const {
+  Lock lock(pending_encoders_mutex_);
+  if (pending_encoders_.empty()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", "ContextVK::FlushCommandBuffers");
+  auto encoders = std::move(pending_encoders_);
+  pending_encoders_.clear();
+  return CommandEncoderVK::SubmitBatch(encoders);
+}
+
 vk::Instance ContextVK::GetInstance() const {
   return *device_holder_->instance;
 }
@@ -494,6 +564,10 @@ void ContextVK::Shutdown() {
   // pointers ensures that cleanup happens in a correct order.
   //
   // tl;dr: Without it, we get thread::join failures on shutdown.
+  {
+    Lock lock(pending_encoders_mutex_);
+    pending_encoders_.clear();
+  }
   fence_waiter_.reset();
   resource_manager_.reset();
 
@@ -529,6 +603,15 @@ std::shared_ptr<CommandPoolRecyclerVK> ContextVK::GetCommandPoolRecycler()
   return command_pool_recycler_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextVK::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
+const std::shared_ptr<GPUTracerVK>& ContextVK::GetGPUTracerVK() const {
+  return gpu_tracer_;
+}
+
 std::unique_ptr<CommandEncoderFactoryVK>
 ContextVK::CreateGraphicsCommandEncoderFactory() const {
   return std::make_unique<CommandEncoderFactoryVK>(weak_from_this());
@@ -5,12 +5,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
@@ -30,6 +32,7 @@ class CommandEncoderVK;
 class CommandPoolRecyclerVK;
 class DebugReportVK;
 class FenceWaiterVK;
+class GPUTracerVK;
 class ResourceManagerVK;
 class SurfaceContextVK;
 
@@ -42,6 +45,19 @@ class ContextVK final : public Context,
     std::vector<std::shared_ptr<fml::Mapping>> shader_libraries_data;
     fml::UniqueFD cache_directory;
     bool enable_validation = false;
+    /// Textures whose memory is at least this large get an allocation of
+    /// their own instead of being suballocated from a larger block. Zero
+    /// leaves the choice to the allocator.
+    size_t dedicated_texture_min_bytes = 0u;
+    /// The present mode of swapchains, if the surface supports it. FIFO,
+    /// which every surface supports, is used otherwise.
+    vk::PresentModeKHR present_mode = vk::PresentModeKHR::eFifo;
+    /// The number of images in swapchains, clamped to what the surface
+    /// supports. Zero picks one more than the minimum of the surface.
+    uint32_t swapchain_image_count = 0u;
+    /// The number of frames swapchains let the GPU work on at once. Acquiring
+    /// the next image waits for the oldest of them to finish. At least one.
+    uint32_t max_frames_in_flight = 3u;
 
     Settings() = default;
 
@@ -82,6 +98,13 @@ class ContextVK final : public Context,
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
+  // |Context|
+  bool EnqueueCommandBuffer(
+      std::shared_ptr<CommandBuffer> command_buffer) const override;
+
+  // |Context|
+  bool FlushCommandBuffers() const override;
+
   // |Context|
   void Shutdown() override;
 
@@ -90,6 +113,12 @@ class ContextVK final : public Context,
 
   bool GetSyncPresentation() const { return sync_presentation_; }
 
+  vk::PresentModeKHR GetPresentMode() const { return present_mode_; }
+
+  uint32_t GetSwapchainImageCount() const { return swapchain_image_count_; }
+
+  uint32_t GetMaxFramesInFlight() const { return max_frames_in_flight_; }
+
   void SetOffscreenFormat(PixelFormat pixel_format);
 
   template <typename T>
@@ -144,6 +173,11 @@ class ContextVK final : public Context,
 
   std::shared_ptr<CommandPoolRecyclerVK> GetCommandPoolRecycler() const;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
+  const std::shared_ptr<GPUTracerVK>& GetGPUTracerVK() const;
+
  private:
   struct DeviceHolderImpl : public DeviceHolder {
     // |DeviceHolder|
@@ -169,9 +203,18 @@ class ContextVK final : public Context,
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::shared_ptr<ResourceManagerVK> resource_manager_;
   std::shared_ptr<CommandPoolRecyclerVK> command_pool_recycler_;
+  std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
+  // Held while pending command buffers are submitted, so that a flush on one
+  // thread can't be overtaken by a submission that depends on it.
+  mutable Mutex pending_encoders_mutex_;
+  mutable std::vector<std::shared_ptr<CommandEncoderVK>> pending_encoders_
+      IPLR_GUARDED_BY(pending_encoders_mutex_);
   bool sync_presentation_ = false;
+  vk::PresentModeKHR present_mode_ = vk::PresentModeKHR::eFifo;
+  uint32_t swapchain_image_count_ = 0u;
+  uint32_t max_frames_in_flight_ = 3u;
   const uint64_t hash_;
 
   bool is_valid_ = false;
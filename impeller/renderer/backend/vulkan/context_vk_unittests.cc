@@ -2,10 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/blobcat/blob_writer.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 namespace testing {
@@ -66,6 +70,43 @@ TEST(ContextVKTest, DeleteShaderFunctionAfterContext) {
                         "vkDestroyDevice") != functions->end());
 }
 
+TEST(ContextVKTest, CreatesShaderModulesOnFirstUse) {
+  BlobWriter writer;
+  std::vector<uint8_t> data = {0x03, 0x02, 0x23, 0x07};
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, "foobar",
+                             std::make_shared<fml::DataMapping>(data)));
+  auto shader_library = writer.CreateMapping();
+  ASSERT_TRUE(shader_library);
+
+  std::shared_ptr<ContextVK> context =
+      MockVulkanContextBuilder()
+          .SetSettingsCallback([&](ContextVK::Settings& settings) {
+            settings.shader_libraries_data = {shader_library};
+          })
+          .Build();
+  ASSERT_TRUE(context);
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  ASSERT_TRUE(std::find(functions->begin(), functions->end(),
+                        "vkCreateShaderModule") == functions->end());
+
+  auto shader_function = context->GetShaderLibrary()->GetFunction(
+      "foobar_fragment_main", ShaderStage::kFragment);
+  ASSERT_TRUE(shader_function);
+  functions = GetMockVulkanFunctions(context->GetDevice());
+  ASSERT_EQ(std::count(functions->begin(), functions->end(),
+                       "vkCreateShaderModule"),
+            1);
+
+  // The module is only created once.
+  ASSERT_EQ(context->GetShaderLibrary()->GetFunction("foobar_fragment_main",
+                                                     ShaderStage::kFragment),
+            shader_function);
+  functions = GetMockVulkanFunctions(context->GetDevice());
+  ASSERT_EQ(std::count(functions->begin(), functions->end(),
+                       "vkCreateShaderModule"),
+            1);
+}
+
 TEST(ContextVKTest, DeletePipelineLibraryAfterContext) {
   std::shared_ptr<PipelineLibrary> pipeline_library;
   std::shared_ptr<std::vector<std::string>> functions;
@@ -111,5 +152,26 @@ TEST(ContextVKTest, CanCreateContextWithValidationLayers) {
   ASSERT_TRUE(capabilites_vk->AreValidationsEnabled());
 }
 
+TEST(ContextVKTest, BatchesEnqueuedCommandBuffers) {
+  auto context = MockVulkanContextBuilder().Build();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  auto submit_count = [&called_functions]() {
+    return std::count(called_functions->begin(), called_functions->end(),
+                      "vkQueueSubmit");
+  };
+
+  ASSERT_TRUE(context->EnqueueCommandBuffer(context->CreateCommandBuffer()));
+  ASSERT_TRUE(context->EnqueueCommandBuffer(context->CreateCommandBuffer()));
+  EXPECT_EQ(submit_count(), 0);
+
+  // Submitting a command buffer submits the pending ones first, all at once.
+  ASSERT_TRUE(context->CreateCommandBuffer()->SubmitCommands());
+  EXPECT_EQ(submit_count(), 2);
+
+  // Nothing is left to flush.
+  EXPECT_TRUE(context->FlushCommandBuffers());
+  EXPECT_EQ(submit_count(), 2);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,10 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <functional>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
@@ -72,6 +76,83 @@ std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
   return sets[0];
 }
 
+bool DescriptorPoolVK::DescriptorKey::operator==(
+    const DescriptorKey& other) const {
+  return binding == other.binding && type == other.type &&
+         buffer == other.buffer && offset == other.offset &&
+         range == other.range && image_view == other.image_view &&
+         sampler == other.sampler;
+}
+
+std::optional<vk::DescriptorSet> DescriptorPoolVK::WriteDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes,
+    size_t command_count) {
+  std::vector<DescriptorKey> descriptors;
+  descriptors.reserve(writes.size());
+  size_t hash = std::hash<vk::DescriptorSetLayout>{}(layout);
+  for (const auto& write : writes) {
+    FML_DCHECK(write.descriptorCount == 1u);
+    DescriptorKey key;
+    key.binding = write.dstBinding;
+    key.type = write.descriptorType;
+    if (write.pBufferInfo) {
+      key.buffer = write.pBufferInfo->buffer;
+      key.offset = write.pBufferInfo->offset;
+      key.range = write.pBufferInfo->range;
+    }
+    if (write.pImageInfo) {
+      key.image_view = write.pImageInfo->imageView;
+      key.sampler = write.pImageInfo->sampler;
+    }
+    fml::HashCombineSeed(hash, key.binding, key.offset, key.range,
+                         std::hash<vk::Buffer>{}(key.buffer),
+                         std::hash<vk::ImageView>{}(key.image_view),
+                         std::hash<vk::Sampler>{}(key.sampler));
+    descriptors.push_back(key);
+  }
+
+  auto [begin, end] = written_sets_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second.layout == layout &&
+        it->second.descriptors == descriptors) {
+      reused_set_count_++;
+      return it->second.set;
+    }
+  }
+
+  if (pools_.empty()) {
+    pool_size_ = command_count;
+  }
+  auto set = AllocateDescriptorSet(layout);
+  if (!set.has_value()) {
+    return std::nullopt;
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return std::nullopt;
+  }
+  for (auto& write : writes) {
+    write.dstSet = set.value();
+  }
+  strong_device->GetDevice().updateDescriptorSets(writes, {});
+
+  written_sets_.emplace(hash, WrittenSet{
+                                  .layout = layout,
+                                  .descriptors = std::move(descriptors),
+                                  .set = set.value(),
+                              });
+  return set;
+}
+
+size_t DescriptorPoolVK::GetWrittenSetCount() const {
+  return written_sets_.size();
+}
+
+size_t DescriptorPoolVK::GetReusedSetCount() const {
+  return reused_set_count_;
+}
+
 std::optional<vk::DescriptorPool> DescriptorPoolVK::GetDescriptorPool() {
   if (pools_.empty()) {
     return GrowPool() ? GetDescriptorPool() : std::nullopt;
@@ -91,6 +172,7 @@ bool DescriptorPoolVK::GrowPool() {
   }
   pool_size_ = new_pool_size;
   pools_.push(std::move(new_pool));
+  FML_PERFORMANCE_COUNTER_ADD("descriptorPools.grown", 1);
   return true;
 }
 
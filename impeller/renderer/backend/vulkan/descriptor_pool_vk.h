@@ -6,6 +6,8 @@
 
 #include <optional>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
@@ -25,6 +27,10 @@ namespace impeller {
 ///             Encoders create pools as necessary as they have the same
 ///             threading and lifecycle restrictions.
 ///
+///             Descriptor sets written through the pool are kept around for
+///             the lifetime of the pool, so that commands binding the same
+///             resources with the same layout share one set.
+///
 class DescriptorPoolVK {
  public:
   explicit DescriptorPoolVK(
@@ -36,13 +42,50 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a descriptor set of the layout that holds the
+  ///             descriptors of the writes, reusing a set written with the
+  ///             same descriptors earlier if there is one.
+  ///
+  /// @param[in]  writes  The writes of one descriptor each. Their destination
+  ///                     set is filled in if a new set is allocated.
+  ///
+  std::optional<vk::DescriptorSet> WriteDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes,
+      size_t command_count);
+
+  size_t GetWrittenSetCount() const;
+
+  size_t GetReusedSetCount() const;
+
  private:
+  struct DescriptorKey {
+    uint32_t binding = 0u;
+    vk::DescriptorType type = vk::DescriptorType::eUniformBuffer;
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0u;
+    vk::DeviceSize range = 0u;
+    vk::ImageView image_view;
+    vk::Sampler sampler;
+
+    bool operator==(const DescriptorKey& other) const;
+  };
+
+  struct WrittenSet {
+    vk::DescriptorSetLayout layout;
+    std::vector<DescriptorKey> descriptors;
+    vk::DescriptorSet set;
+  };
+
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
   std::weak_ptr<const DeviceHolder> device_holder_;
   uint32_t pool_size_ = 31u;
   std::queue<vk::UniqueDescriptorPool> pools_;
+  std::unordered_multimap<size_t, WrittenSet> written_sets_;
+  size_t reused_set_count_ = 0u;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep.
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(DescriptorPoolVKTest, ReusesSetsWrittenWithTheSameDescriptors) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder());
+    vk::DescriptorSetLayout layout(
+        reinterpret_cast<VkDescriptorSetLayout>(0x77777777));
+
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = vk::Buffer(reinterpret_cast<VkBuffer>(0xBA5E));
+    buffer_info.range = 64u;
+
+    vk::WriteDescriptorSet write;
+    write.dstBinding = 0u;
+    write.descriptorCount = 1u;
+    write.descriptorType = vk::DescriptorType::eUniformBuffer;
+    write.pBufferInfo = &buffer_info;
+    std::vector<vk::WriteDescriptorSet> writes = {write};
+
+    auto first = pool.WriteDescriptorSet(layout, writes, 1u);
+    auto second = pool.WriteDescriptorSet(layout, writes, 1u);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first.value(), second.value());
+
+    // A different range of the same buffer needs a set of its own.
+    buffer_info.offset = 256u;
+    auto third = pool.WriteDescriptorSet(layout, writes, 1u);
+    ASSERT_TRUE(third.has_value());
+    EXPECT_NE(first.value(), third.value());
+
+    EXPECT_EQ(pool.GetWrittenSetCount(), 2u);
+    EXPECT_EQ(pool.GetReusedSetCount(), 1u);
+
+    auto const called = GetMockVulkanFunctions(context->GetDevice());
+    EXPECT_EQ(std::count(called->begin(), called->end(),
+                         "vkUpdateDescriptorSets"),
+              2);
+  }
+
+  context->Shutdown();
+}
+
+}  // namespace testing
+}  // namespace impeller
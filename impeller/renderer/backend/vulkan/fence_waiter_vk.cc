@@ -32,9 +32,13 @@ class WaitSetEntry {
 
   const vk::Fence& GetFence() const { return fence_.get(); }
 
+  vk::UniqueFence TakeFence() { return std::move(fence_); }
+
   bool IsSignalled() const { return is_signalled_; }
 
  private:
+  // The callback is declared last so that it runs before the fence is
+  // destroyed.
   vk::UniqueFence fence_;
   fml::ScopedCleanupClosure callback_;
   bool is_signalled_ = false;
@@ -74,6 +78,68 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   return true;
 }
 
+// The largest number of reset fences kept around for later submissions.
+static constexpr size_t kMaxRecycledFences = 32u;
+
+vk::UniqueFence FenceWaiterVK::CreateFence() {
+  {
+    Lock lock(recycled_fences_mutex_);
+    if (!recycled_fences_.empty()) {
+      auto fence = std::move(recycled_fences_.back());
+      recycled_fences_.pop_back();
+      return fence;
+    }
+  }
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    return {};
+  }
+  auto [result, fence] = device_holder->GetDevice().createFenceUnique({});
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(result);
+    return {};
+  }
+  return std::move(fence);
+}
+
+size_t FenceWaiterVK::GetRecycledFenceCount() const {
+  Lock lock(recycled_fences_mutex_);
+  return recycled_fences_.size();
+}
+
+void FenceWaiterVK::RecycleFences(const vk::Device& device,
+                                  std::vector<vk::UniqueFence> fences) {
+  {
+    Lock lock(recycled_fences_mutex_);
+    if (recycled_fences_.size() >= kMaxRecycledFences) {
+      return;
+    }
+    fences.resize(std::min(fences.size(),
+                           kMaxRecycledFences - recycled_fences_.size()));
+  }
+  if (fences.empty()) {
+    return;
+  }
+
+  std::vector<vk::Fence> raw_fences;
+  raw_fences.reserve(fences.size());
+  for (const auto& fence : fences) {
+    raw_fences.push_back(fence.get());
+  }
+  TRACE_EVENT0("impeller", "ResetFences");
+  if (device.resetFences(raw_fences) != vk::Result::eSuccess) {
+    return;
+  }
+
+  Lock lock(recycled_fences_mutex_);
+  for (auto& fence : fences) {
+    if (recycled_fences_.size() >= kMaxRecycledFences) {
+      break;
+    }
+    recycled_fences_.push_back(std::move(fence));
+  }
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -192,8 +258,15 @@ bool FenceWaiterVK::Wait() {
 
   {
     TRACE_EVENT0("impeller", "ClearSignaledFences");
-    // Erase the erased entries which will invoke callbacks.
-    erased_entries.clear();  // Bit redundant because of scope but hey.
+    // Reset the signaled fences in one go so that later submissions can reuse
+    // them, then erase the entries which will invoke callbacks.
+    std::vector<vk::UniqueFence> signaled_fences;
+    signaled_fences.reserve(erased_entries.size());
+    for (auto& entry : erased_entries) {
+      signaled_fences.push_back(entry->TakeFence());
+    }
+    RecycleFences(device, std::move(signaled_fences));
+    erased_entries.clear();
   }
 
   return true;
@@ -33,6 +33,19 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns an unsignaled fence for a queue submission.
+  ///
+  ///             Fences added to the waiter are reset in batches once they
+  ///             signal and handed out here again, so submissions don't have
+  ///             to create and destroy a fence each.
+  ///
+  /// @return     The fence, or an empty handle if one could not be created.
+  ///
+  vk::UniqueFence CreateFence();
+
+  size_t GetRecycledFenceCount() const;
+
  private:
   friend class ContextVK;
 
@@ -42,6 +55,9 @@ class FenceWaiterVK {
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
   bool terminate_ = false;
+  mutable Mutex recycled_fences_mutex_;
+  std::vector<vk::UniqueFence> recycled_fences_
+      IPLR_GUARDED_BY(recycled_fences_mutex_);
 
   explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
 
@@ -50,6 +66,9 @@ class FenceWaiterVK {
   bool Wait();
   void WaitUntilEmpty();
 
+  void RecycleFences(const vk::Device& device,
+                     std::vector<vk::UniqueFence> fences);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
 };
 
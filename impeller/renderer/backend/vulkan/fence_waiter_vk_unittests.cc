@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"  // IWYU pragma: keep
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"  // IWYU pragma: keep
@@ -54,6 +56,29 @@ TEST(FenceWaiterVKTest, ExecutesFenceCallbackX2) {
   signal2.Wait();
 }
 
+TEST(FenceWaiterVKTest, RecyclesSignaledFences) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const device = context->GetDevice();
+  auto const waiter = context->GetFenceWaiter();
+
+  auto signal = fml::ManualResetWaitableEvent();
+  auto fence = device.createFenceUnique({}).value;
+  auto raw_fence = fence.get();
+  waiter->AddFence(std::move(fence), [&signal]() { signal.Signal(); });
+  signal.Wait();
+
+  // The signaled fence is reset before the callback runs, and is handed out
+  // for the next submission.
+  EXPECT_EQ(waiter->GetRecycledFenceCount(), 1u);
+  auto recycled = waiter->CreateFence();
+  EXPECT_EQ(recycled.get(), raw_fence);
+  EXPECT_EQ(MockFence::GetRawPointer(recycled)->GetStatus(), VK_NOT_READY);
+  EXPECT_EQ(waiter->GetRecycledFenceCount(), 0u);
+
+  auto const called = GetMockVulkanFunctions(device);
+  EXPECT_EQ(std::count(called->begin(), called->end(), "vkResetFences"), 1);
+}
+
 TEST(FenceWaiterVKTest, ExecutesNewFenceThenOldFence) {
   auto const context = MockVulkanContextBuilder().Build();
   auto const device = context->GetDevice();
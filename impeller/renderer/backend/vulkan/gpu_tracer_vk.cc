@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+std::shared_ptr<GPUTracerVK> GPUTracerVK::Create(
+    const std::shared_ptr<DeviceHolder>& device_holder,
+    const vk::PhysicalDeviceLimits& limits,
+    uint32_t timestamp_valid_bits) {
+  if (!device_holder || !limits.timestampComputeAndGraphics ||
+      limits.timestampPeriod <= 0 || timestamp_valid_bits == 0) {
+    return nullptr;
+  }
+
+  vk::QueryPoolCreateInfo info;
+  info.queryType = vk::QueryType::eTimestamp;
+  // A start and an end timestamp for each command buffer.
+  info.queryCount = kMaxQueries * 2;
+  auto [result, pool] = device_holder->GetDevice().createQueryPool(info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the GPU tracer query pool: "
+                   << vk::to_string(result);
+    return nullptr;
+  }
+
+  const uint64_t mask = timestamp_valid_bits >= 64
+                            ? ~uint64_t{0}
+                            : (uint64_t{1} << timestamp_valid_bits) - 1;
+  return std::shared_ptr<GPUTracerVK>(
+      new GPUTracerVK(device_holder, pool, limits.timestampPeriod, mask));
+}
+
+GPUTracerVK::GPUTracerVK(const std::shared_ptr<DeviceHolder>& device_holder,
+                         vk::QueryPool query_pool,
+                         double timestamp_period,
+                         uint64_t timestamp_mask)
+    : device_holder_(device_holder),
+      query_pool_(query_pool),
+      timestamp_period_(timestamp_period),
+      timestamp_mask_(timestamp_mask) {
+  free_indices_.reserve(kMaxQueries);
+  for (uint32_t i = kMaxQueries; i > 0; i--) {
+    free_indices_.push_back(i - 1);
+  }
+}
+
+GPUTracerVK::~GPUTracerVK() {
+  if (auto device_holder = device_holder_.lock()) {
+    device_holder->GetDevice().destroyQueryPool(query_pool_);
+  }
+}
+
+std::optional<uint32_t> GPUTracerVK::AcquireIndex() {
+  std::scoped_lock lock(free_indices_mutex_);
+  if (free_indices_.empty()) {
+    return std::nullopt;
+  }
+  uint32_t index = free_indices_.back();
+  free_indices_.pop_back();
+  return index;
+}
+
+void GPUTracerVK::ReleaseIndex(uint32_t index) {
+  std::scoped_lock lock(free_indices_mutex_);
+  free_indices_.push_back(index);
+}
+
+std::optional<GPUTracerVK::Query> GPUTracerVK::RecordCmdBufferStart(
+    const vk::CommandBuffer& buffer) {
+  auto frame_id = AddCommandBuffer();
+  if (!frame_id.has_value()) {
+    return std::nullopt;
+  }
+  auto index = AcquireIndex();
+  if (!index.has_value()) {
+    // Too many command buffers are in flight to measure this one.
+    CompleteCommandBuffer(frame_id.value(), std::nullopt);
+    return std::nullopt;
+  }
+
+  // Resetting the queries in the command buffer that writes them keeps them
+  // from ever being read before they are written.
+  buffer.resetQueryPool(query_pool_, index.value() * 2, 2);
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, query_pool_,
+                        index.value() * 2);
+  return Query{.frame_id = frame_id.value(), .index = index.value()};
+}
+
+void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
+                                     const Query& query) {
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, query_pool_,
+                        query.index * 2 + 1);
+}
+
+void GPUTracerVK::OnCmdBufferCompleted(const Query& query, bool submitted) {
+  std::optional<TimeRange> range;
+  auto device_holder = device_holder_.lock();
+  if (submitted && device_holder) {
+    uint64_t timestamps[2] = {};
+    auto result = device_holder->GetDevice().getQueryPoolResults(
+        query_pool_, query.index * 2, 2, sizeof(timestamps), timestamps,
+        sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+    if (result == vk::Result::eSuccess) {
+      const uint64_t start = timestamps[0] & timestamp_mask_;
+      // The difference is taken within the valid bits so that a counter that
+      // wraps around between the two timestamps is still measured.
+      const uint64_t ticks = (timestamps[1] - timestamps[0]) & timestamp_mask_;
+      const auto start_nanos = static_cast<int64_t>(start * timestamp_period_);
+      range = TimeRange{
+          .start_nanos = start_nanos,
+          .end_nanos =
+              start_nanos + static_cast<int64_t>(ticks * timestamp_period_),
+      };
+    }
+  }
+  ReleaseIndex(query.index);
+  CompleteCommandBuffer(query.frame_id, range);
+}
+
+}  // namespace impeller
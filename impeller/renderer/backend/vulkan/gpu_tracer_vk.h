@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A |GPUTracer| that writes a timestamp query at the start and
+///             at the end of each command buffer of a frame, and reads them
+///             back once the command buffer's fence has signaled.
+///
+class GPUTracerVK final : public GPUTracer {
+ public:
+  /// The pair of timestamp queries of one command buffer.
+  struct Query {
+    uint64_t frame_id = 0;
+    uint32_t index = 0;
+  };
+
+  /// The number of command buffers whose queries may be in flight at once.
+  static constexpr uint32_t kMaxQueries = 64;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a tracer for the graphics queue of |device_holder|.
+  ///
+  /// @return     The tracer, or nullptr if the device does not support
+  ///             timestamps on its graphics queue.
+  ///
+  static std::shared_ptr<GPUTracerVK> Create(
+      const std::shared_ptr<DeviceHolder>& device_holder,
+      const vk::PhysicalDeviceLimits& limits,
+      uint32_t timestamp_valid_bits);
+
+  // |GPUTracer|
+  ~GPUTracerVK() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a command buffer that has just begun to the current
+  ///             frame, if any, and writes its start timestamp.
+  ///
+  /// @return     The queries of the command buffer. If a query is returned,
+  ///             |OnCmdBufferCompleted| must be called for it exactly once.
+  ///
+  std::optional<Query> RecordCmdBufferStart(const vk::CommandBuffer& buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the end timestamp of a command buffer right before it
+  ///             ends.
+  ///
+  void RecordCmdBufferEnd(const vk::CommandBuffer& buffer, const Query& query);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the timestamps of a command buffer once its fence has
+  ///             signaled, or releases its queries if it was never submitted.
+  ///
+  void OnCmdBufferCompleted(const Query& query, bool submitted);
+
+ private:
+  std::weak_ptr<DeviceHolder> device_holder_;
+  vk::QueryPool query_pool_;
+  const double timestamp_period_;
+  const uint64_t timestamp_mask_;
+  std::mutex free_indices_mutex_;
+  std::vector<uint32_t> free_indices_;
+
+  GPUTracerVK(const std::shared_ptr<DeviceHolder>& device_holder,
+              vk::QueryPool query_pool,
+              double timestamp_period,
+              uint64_t timestamp_mask);
+
+  std::optional<uint32_t> AcquireIndex();
+
+  void ReleaseIndex(uint32_t index);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerVK);
+};
+
+}  // namespace impeller
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/vulkan/pass_bindings_cache.h"
 
 namespace impeller {
+
 void PassBindingsCache::BindPipeline(vk::CommandBuffer command_buffer,
                                      vk::PipelineBindPoint pipeline_bind_point,
                                      vk::Pipeline pipeline) {
@@ -12,6 +13,7 @@ void PassBindingsCache::BindPipeline(vk::CommandBuffer command_buffer,
     case vk::PipelineBindPoint::eGraphics:
       if (graphics_pipeline_.has_value() &&
           graphics_pipeline_.value() == pipeline) {
+        stats_.skipped_pipeline_binds++;
         return;
       }
       graphics_pipeline_ = pipeline;
@@ -19,6 +21,7 @@ void PassBindingsCache::BindPipeline(vk::CommandBuffer command_buffer,
     case vk::PipelineBindPoint::eCompute:
       if (compute_pipeline_.has_value() &&
           compute_pipeline_.value() == pipeline) {
+        stats_.skipped_pipeline_binds++;
         return;
       }
       compute_pipeline_ = pipeline;
@@ -29,12 +32,77 @@ void PassBindingsCache::BindPipeline(vk::CommandBuffer command_buffer,
   command_buffer.bindPipeline(pipeline_bind_point, pipeline);
 }
 
+void PassBindingsCache::BindDescriptorSet(
+    vk::CommandBuffer command_buffer,
+    vk::PipelineBindPoint pipeline_bind_point,
+    vk::PipelineLayout pipeline_layout,
+    vk::DescriptorSet descriptor_set) {
+  const DescriptorSetBinding binding{
+      .pipeline_layout = pipeline_layout,
+      .descriptor_set = descriptor_set,
+  };
+  std::optional<DescriptorSetBinding>* bound = nullptr;
+  switch (pipeline_bind_point) {
+    case vk::PipelineBindPoint::eGraphics:
+      bound = &graphics_descriptor_set_;
+      break;
+    case vk::PipelineBindPoint::eCompute:
+      bound = &compute_descriptor_set_;
+      break;
+    default:
+      break;
+  }
+  if (bound) {
+    if (bound->has_value() && bound->value() == binding) {
+      stats_.skipped_descriptor_set_binds++;
+      return;
+    }
+    *bound = binding;
+  }
+  command_buffer.bindDescriptorSets(pipeline_bind_point,  // bind point
+                                    pipeline_layout,      // layout
+                                    0u,                   // first set
+                                    {descriptor_set},     // sets
+                                    nullptr               // offsets
+  );
+}
+
+void PassBindingsCache::BindVertexBuffer(vk::CommandBuffer command_buffer,
+                                         vk::Buffer buffer,
+                                         vk::DeviceSize offset) {
+  const BufferBinding binding{.buffer = buffer, .offset = offset};
+  if (vertex_buffer_.has_value() && vertex_buffer_.value() == binding) {
+    stats_.skipped_vertex_buffer_binds++;
+    return;
+  }
+  vertex_buffer_ = binding;
+  command_buffer.bindVertexBuffers(0u, 1u, &buffer, &offset);
+}
+
+void PassBindingsCache::BindIndexBuffer(vk::CommandBuffer command_buffer,
+                                        vk::Buffer buffer,
+                                        vk::DeviceSize offset,
+                                        vk::IndexType index_type) {
+  const BufferBinding binding{
+      .buffer = buffer,
+      .offset = offset,
+      .index_type = index_type,
+  };
+  if (index_buffer_.has_value() && index_buffer_.value() == binding) {
+    stats_.skipped_index_buffer_binds++;
+    return;
+  }
+  index_buffer_ = binding;
+  command_buffer.bindIndexBuffer(buffer, offset, index_type);
+}
+
 void PassBindingsCache::SetStencilReference(vk::CommandBuffer command_buffer,
                                             vk::StencilFaceFlags face_mask,
                                             uint32_t reference) {
   if (stencil_face_flags_.has_value() &&
       face_mask == stencil_face_flags_.value() &&
       reference == stencil_reference_) {
+    stats_.skipped_stencil_reference_sets++;
     return;
   }
   stencil_face_flags_ = face_mask;
@@ -48,6 +116,7 @@ void PassBindingsCache::SetScissor(vk::CommandBuffer command_buffer,
                                    const vk::Rect2D* scissors) {
   if (first_scissor == 0 && scissor_count == 1) {
     if (scissors_.has_value() && scissors_.value() == scissors[0]) {
+      stats_.skipped_scissor_sets++;
       return;
     }
     scissors_ = scissors[0];
@@ -62,6 +131,7 @@ void PassBindingsCache::SetViewport(vk::CommandBuffer command_buffer,
   if (first_viewport == 0 && viewport_count == 1) {
     // Note that this is doing equality checks on floating point numbers.
     if (viewport_.has_value() && viewport_.value() == viewports[0]) {
+      stats_.skipped_viewport_sets++;
       return;
     }
     viewport_ = viewports[0];
@@ -69,4 +139,8 @@ void PassBindingsCache::SetViewport(vk::CommandBuffer command_buffer,
   command_buffer.setViewport(first_viewport, viewport_count, viewports);
 }
 
+const PassBindingsCache::Stats& PassBindingsCache::GetStats() const {
+  return stats_;
+}
+
 }  // namespace impeller
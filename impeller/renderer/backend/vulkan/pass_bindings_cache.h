@@ -10,12 +10,46 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Filters out state changes that would set what is already bound
+///             in a command buffer, so that consecutive draws with the same
+///             state only record their draw call.
+///
+///             A cache must only be used with a single command buffer.
+///
 class PassBindingsCache {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      The number of commands each filter kept from being recorded.
+  ///
+  struct Stats {
+    size_t skipped_pipeline_binds = 0u;
+    size_t skipped_descriptor_set_binds = 0u;
+    size_t skipped_vertex_buffer_binds = 0u;
+    size_t skipped_index_buffer_binds = 0u;
+    size_t skipped_stencil_reference_sets = 0u;
+    size_t skipped_scissor_sets = 0u;
+    size_t skipped_viewport_sets = 0u;
+  };
+
   void BindPipeline(vk::CommandBuffer command_buffer,
                     vk::PipelineBindPoint pipeline_bind_point,
                     vk::Pipeline pipeline);
 
+  void BindDescriptorSet(vk::CommandBuffer command_buffer,
+                         vk::PipelineBindPoint pipeline_bind_point,
+                         vk::PipelineLayout pipeline_layout,
+                         vk::DescriptorSet descriptor_set);
+
+  void BindVertexBuffer(vk::CommandBuffer command_buffer,
+                        vk::Buffer buffer,
+                        vk::DeviceSize offset);
+
+  void BindIndexBuffer(vk::CommandBuffer command_buffer,
+                       vk::Buffer buffer,
+                       vk::DeviceSize offset,
+                       vk::IndexType index_type);
+
   void SetStencilReference(vk::CommandBuffer command_buffer,
                            vk::StencilFaceFlags face_mask,
                            uint32_t reference);
@@ -30,10 +64,40 @@ class PassBindingsCache {
                    uint32_t viewport_count,
                    const vk::Viewport* viewports);
 
+  const Stats& GetStats() const;
+
  private:
+  struct DescriptorSetBinding {
+    vk::PipelineLayout pipeline_layout;
+    vk::DescriptorSet descriptor_set;
+
+    bool operator==(const DescriptorSetBinding& other) const {
+      return pipeline_layout == other.pipeline_layout &&
+             descriptor_set == other.descriptor_set;
+    }
+  };
+
+  struct BufferBinding {
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0u;
+    vk::IndexType index_type = vk::IndexType::eUint16;
+
+    bool operator==(const BufferBinding& other) const {
+      return buffer == other.buffer && offset == other.offset &&
+             index_type == other.index_type;
+    }
+  };
+
   // bindPipeline
   std::optional<vk::Pipeline> graphics_pipeline_;
   std::optional<vk::Pipeline> compute_pipeline_;
+  // bindDescriptorSets
+  std::optional<DescriptorSetBinding> graphics_descriptor_set_;
+  std::optional<DescriptorSetBinding> compute_descriptor_set_;
+  // bindVertexBuffers
+  std::optional<BufferBinding> vertex_buffer_;
+  // bindIndexBuffer
+  std::optional<BufferBinding> index_buffer_;
   // setStencilReference
   std::optional<vk::StencilFaceFlags> stencil_face_flags_;
   uint32_t stencil_reference_ = 0;
@@ -41,6 +105,7 @@ class PassBindingsCache {
   std::optional<vk::Rect2D> scissors_;
   // setViewport
   std::optional<vk::Viewport> viewport_;
+  Stats stats_;
 };
 
 }  // namespace impeller
@@ -35,6 +35,7 @@ TEST(PassBindingsCacheTest, bindPipeline) {
   std::shared_ptr<std::vector<std::string>> functions =
       GetMockVulkanFunctions(context->GetDevice());
   EXPECT_EQ(CountStringViewInstances(*functions, "vkCmdBindPipeline"), 1);
+  EXPECT_EQ(cache.GetStats().skipped_pipeline_binds, 1u);
 }
 
 TEST(PassBindingsCacheTest, setStencilReference) {
@@ -78,5 +79,56 @@ TEST(PassBindingsCacheTest, setViewport) {
   EXPECT_EQ(CountStringViewInstances(*functions, "vkCmdSetViewport"), 1);
 }
 
+TEST(PassBindingsCacheTest, bindDescriptorSet) {
+  auto context = MockVulkanContextBuilder().Build();
+  PassBindingsCache cache;
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  auto buffer = encoder->GetCommandBuffer();
+  vk::PipelineLayout layout(reinterpret_cast<VkPipelineLayout>(0xfeedface));
+  vk::DescriptorSet set_a(reinterpret_cast<VkDescriptorSet>(0xcafe));
+  vk::DescriptorSet set_b(reinterpret_cast<VkDescriptorSet>(0xbeef));
+  cache.BindDescriptorSet(buffer, vk::PipelineBindPoint::eGraphics, layout,
+                          set_a);
+  cache.BindDescriptorSet(buffer, vk::PipelineBindPoint::eGraphics, layout,
+                          set_a);
+  cache.BindDescriptorSet(buffer, vk::PipelineBindPoint::eGraphics, layout,
+                          set_b);
+  std::shared_ptr<std::vector<std::string>> functions =
+      GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(CountStringViewInstances(*functions, "vkCmdBindDescriptorSets"),
+            2);
+  EXPECT_EQ(cache.GetStats().skipped_descriptor_set_binds, 1u);
+}
+
+TEST(PassBindingsCacheTest, bindVertexBuffer) {
+  auto context = MockVulkanContextBuilder().Build();
+  PassBindingsCache cache;
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  auto buffer = encoder->GetCommandBuffer();
+  vk::Buffer vertex_buffer(reinterpret_cast<VkBuffer>(0xfeedface));
+  cache.BindVertexBuffer(buffer, vertex_buffer, 0u);
+  cache.BindVertexBuffer(buffer, vertex_buffer, 0u);
+  cache.BindVertexBuffer(buffer, vertex_buffer, 256u);
+  std::shared_ptr<std::vector<std::string>> functions =
+      GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(CountStringViewInstances(*functions, "vkCmdBindVertexBuffers"), 2);
+  EXPECT_EQ(cache.GetStats().skipped_vertex_buffer_binds, 1u);
+}
+
+TEST(PassBindingsCacheTest, bindIndexBuffer) {
+  auto context = MockVulkanContextBuilder().Build();
+  PassBindingsCache cache;
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  auto buffer = encoder->GetCommandBuffer();
+  vk::Buffer index_buffer(reinterpret_cast<VkBuffer>(0xfeedface));
+  cache.BindIndexBuffer(buffer, index_buffer, 0u, vk::IndexType::eUint16);
+  cache.BindIndexBuffer(buffer, index_buffer, 0u, vk::IndexType::eUint16);
+  cache.BindIndexBuffer(buffer, index_buffer, 0u, vk::IndexType::eUint32);
+  std::shared_ptr<std::vector<std::string>> functions =
+      GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(CountStringViewInstances(*functions, "vkCmdBindIndexBuffer"), 2);
+  EXPECT_EQ(cache.GetStats().skipped_index_buffer_binds, 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
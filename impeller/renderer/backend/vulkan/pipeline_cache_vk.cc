@@ -6,7 +6,9 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "impeller/base/validation.h"
@@ -16,19 +18,70 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK(
+    const vk::PhysicalDeviceProperties& props,
+    uint64_t p_data_size)
+    : vendor_id(props.vendorID),
+      device_id(props.deviceID),
+      driver_version(props.driverVersion),
+      api_version(props.apiVersion),
+      data_size(p_data_size) {
+  std::memcpy(pipeline_cache_uuid, props.pipelineCacheUUID.data(),
+              VK_UUID_SIZE);
+}
+
+bool PipelineCacheHeaderVK::IsCompatibleWith(
+    const PipelineCacheHeaderVK& other) const {
+  return magic == other.magic &&                    //
+         version == other.version &&                //
+         vendor_id == other.vendor_id &&            //
+         device_id == other.device_id &&            //
+         driver_version == other.driver_version &&  //
+         api_version == other.api_version &&        //
+         std::memcmp(pipeline_cache_uuid, other.pipeline_cache_uuid,
+                     VK_UUID_SIZE) == 0;
+}
+
 static bool VerifyExistingCache(const fml::Mapping& mapping,
                                 const CapabilitiesVK& caps) {
-  return true;
+  if (mapping.GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return false;
+  }
+  PipelineCacheHeaderVK header;
+  std::memcpy(&header, mapping.GetMapping(), sizeof(header));
+  const auto data_size = mapping.GetSize() - sizeof(header);
+  // A cache that was cut short is discarded too.
+  return header.data_size == data_size &&
+         header.IsCompatibleWith(PipelineCacheHeaderVK(
+             caps.GetPhysicalDeviceProperties(), data_size));
 }
 
 static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
+    const CapabilitiesVK& caps,
     std::shared_ptr<fml::Mapping> data) {
-  return data;
+  const PipelineCacheHeaderVK header(caps.GetPhysicalDeviceProperties(),
+                                     data->GetSize());
+  auto decorated = std::make_shared<std::vector<uint8_t>>(sizeof(header) +
+                                                          data->GetSize());
+  std::memcpy(decorated->data(), &header, sizeof(header));
+  std::memcpy(decorated->data() + sizeof(header), data->GetMapping(),
+              data->GetSize());
+  return std::make_shared<fml::NonOwnedMapping>(
+      decorated->data(), decorated->size(), [decorated](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
     std::unique_ptr<fml::Mapping> data) {
-  return data;
+  if (data->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  const auto* cache_data = data->GetMapping() + sizeof(PipelineCacheHeaderVK);
+  const auto cache_size = data->GetSize() - sizeof(PipelineCacheHeaderVK);
+  std::shared_ptr<fml::Mapping> file(std::move(data));
+  return std::make_unique<fml::NonOwnedMapping>(cache_data, cache_size,
+                                                [file](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> OpenCacheFile(
@@ -154,8 +207,30 @@ std::shared_ptr<fml::Mapping> PipelineCacheVK::CopyPipelineCacheData() const {
   if (!IsValid()) {
     return nullptr;
   }
+  const auto& device = strong_device->GetDevice();
+
+  // Other sessions may have persisted pipelines to the same directory since
+  // this cache was created from it. Merge them in so that pipelines compiled
+  // by either survive. The merge goes into a scratch cache because the
+  // destination of a merge must not be used concurrently, and this cache is
+  // used to create pipelines while it is persisted.
+  vk::UniquePipelineCache merged_cache;
+  if (auto on_disk = OpenCacheFile(cache_directory_, kPipelineCacheFileName,
+                                   *GetCapabilities())) {
+    vk::PipelineCacheCreateInfo cache_info;
+    cache_info.initialDataSize = on_disk->GetSize();
+    cache_info.pInitialData = on_disk->GetMapping();
+    auto [create_result, scratch_cache] =
+        device.createPipelineCacheUnique(cache_info);
+    if (create_result == vk::Result::eSuccess &&
+        device.mergePipelineCaches(*scratch_cache, {*cache_}) ==
+            vk::Result::eSuccess) {
+      merged_cache = std::move(scratch_cache);
+    }
+  }
+
   auto [result, data] =
-      strong_device->GetDevice().getPipelineCacheData(*cache_);
+      device.getPipelineCacheData(merged_cache ? *merged_cache : *cache_);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not get pipeline cache data to persist.";
     return nullptr;
@@ -175,7 +250,7 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
+  data = DecorateCacheWithMetadata(*GetCapabilities(), std::move(data));
   if (!data) {
     VALIDATION_LOG
         << "Could not decorate pipeline cache with additional metadata.";
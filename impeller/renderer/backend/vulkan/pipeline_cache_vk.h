@@ -11,6 +11,38 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The header written in front of the pipeline cache data on disk.
+///
+///             Caches written by a different device or driver, or in an older
+///             format, are discarded instead of being handed to the driver.
+///
+struct PipelineCacheHeaderVK {
+  static constexpr uint32_t kMagic = 0x49504C43;  // "IPLC"
+  // Bumped whenever the layout of the header changes.
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint32_t api_version = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE] = {};
+  uint64_t data_size = 0u;
+
+  PipelineCacheHeaderVK();
+
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        uint64_t data_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether pipeline cache data written with the other header can
+  ///             be used with the device and driver of this one.
+  ///
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& other) const;
+};
+
 class PipelineCacheVK {
  public:
   // The [device] is passed in directly so that it can be used in the
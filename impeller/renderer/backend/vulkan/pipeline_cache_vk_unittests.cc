@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep.
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineCacheVKTest, HeadersOfTheSameDeviceAndDriverAreCompatible) {
+  vk::PhysicalDeviceProperties props;
+  props.vendorID = 0x13B5;
+  props.deviceID = 0x92020010;
+  props.driverVersion = 42u;
+  props.apiVersion = VK_API_VERSION_1_1;
+  props.pipelineCacheUUID[0] = 7u;
+
+  const PipelineCacheHeaderVK header(props, 1024u);
+  EXPECT_TRUE(header.IsCompatibleWith(PipelineCacheHeaderVK(props, 2048u)));
+
+  {
+    auto other = props;
+    other.driverVersion = 43u;
+    EXPECT_FALSE(header.IsCompatibleWith(PipelineCacheHeaderVK(other, 1024u)));
+  }
+  {
+    auto other = props;
+    other.deviceID = 0x92020011;
+    EXPECT_FALSE(header.IsCompatibleWith(PipelineCacheHeaderVK(other, 1024u)));
+  }
+  {
+    auto other = props;
+    other.pipelineCacheUUID[15] = 1u;
+    EXPECT_FALSE(header.IsCompatibleWith(PipelineCacheHeaderVK(other, 1024u)));
+  }
+  {
+    PipelineCacheHeaderVK other(props, 1024u);
+    other.version = PipelineCacheHeaderVK::kVersion + 1u;
+    EXPECT_FALSE(header.IsCompatibleWith(other));
+  }
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -9,6 +9,7 @@
 #include <sstream>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
 #include "impeller/base/timing.h"
@@ -277,6 +278,22 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   //----------------------------------------------------------------------------
   /// Shader Stages
   ///
+  // Each specialization constant is a scalar. Its constant ID is its index.
+  const auto& specialization_constants = desc.GetSpecializationConstants();
+  std::vector<vk::SpecializationMapEntry> specialization_map_entries;
+  for (size_t i = 0; i < specialization_constants.size(); i++) {
+    vk::SpecializationMapEntry entry;
+    entry.constantID = i;
+    entry.offset = i * sizeof(Scalar);
+    entry.size = sizeof(Scalar);
+    specialization_map_entries.push_back(entry);
+  }
+  vk::SpecializationInfo specialization_info;
+  specialization_info.setMapEntries(specialization_map_entries);
+  specialization_info.setDataSize(specialization_constants.size() *
+                                  sizeof(Scalar));
+  specialization_info.setPData(specialization_constants.data());
+
   std::vector<vk::PipelineShaderStageCreateInfo> shader_stages;
   for (const auto& entrypoint : desc.GetStageEntrypoints()) {
     auto stage = ToVKShaderStageFlagBits(entrypoint.first);
@@ -290,6 +307,9 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
     info.setPName("main");
     info.setModule(
         ShaderFunctionVK::Cast(entrypoint.second.get())->GetModule());
+    if (!specialization_constants.empty()) {
+      info.setPSpecializationInfo(&specialization_info);
+    }
     shader_stages.push_back(info);
   }
   pipeline_info.setStages(shader_stages);
@@ -593,6 +613,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  FML_PERFORMANCE_COUNTER_ADD("pipelines.created", 1);
 
   auto weak_this = weak_from_this();
 
@@ -42,6 +42,14 @@ static vk::AttachmentDescription CreateAttachmentDescription(
   auto load_action = attachment.load_action;
   auto store_action = attachment.store_action;
 
+  if (desc.storage_mode == StorageMode::kDeviceTransient) {
+    // The contents of transient attachments never outlive a render pass.
+    // Discarding them up front keeps lazily allocated memory from being
+    // committed to preserve their contents, and skips the layout barrier
+    // below.
+    current_layout = vk::ImageLayout::eUndefined;
+  }
+
   if (current_layout == vk::ImageLayout::eUndefined) {
     load_action = LoadAction::kClear;
   }
@@ -69,7 +77,7 @@ static vk::AttachmentDescription CreateAttachmentDescription(
 static void SetTextureLayout(
     const Attachment& attachment,
     const vk::AttachmentDescription& attachment_desc,
-    const std::shared_ptr<CommandBufferVK>& command_buffer,
+    BarrierBatchVK& barriers,
     const std::shared_ptr<Texture> Attachment::*texture_ptr) {
   const auto& texture = attachment.*texture_ptr;
   if (!texture) {
@@ -80,7 +88,6 @@ static void SetTextureLayout(
   if (attachment_desc.initialLayout == vk::ImageLayout::eGeneral) {
     BarrierVK barrier;
     barrier.new_layout = vk::ImageLayout::eGeneral;
-    barrier.cmd_buffer = command_buffer->GetEncoder()->GetCommandBuffer();
     barrier.src_access = vk::AccessFlagBits::eShaderRead;
     barrier.src_stage = vk::PipelineStageFlagBits::eFragmentShader;
     barrier.dst_access = vk::AccessFlagBits::eColorAttachmentWrite |
@@ -88,7 +95,7 @@ static void SetTextureLayout(
     barrier.dst_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
                         vk::PipelineStageFlagBits::eTransfer;
 
-    texture_vk.SetLayout(barrier);
+    texture_vk.SetLayout(barrier, barriers);
   }
 
   // Instead of transitioning layouts manually using barriers, we are going to
@@ -98,7 +105,7 @@ static void SetTextureLayout(
 
 SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     const ContextVK& context,
-    const std::shared_ptr<CommandBufferVK>& command_buffer) const {
+    BarrierBatchVK& barriers) const {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -124,14 +131,14 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
                                 vk::ImageLayout::eColorAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(color, &Attachment::texture));
-    SetTextureLayout(color, attachments.back(), command_buffer,
+    SetTextureLayout(color, attachments.back(), barriers,
                      &Attachment::texture);
     if (color.resolve_texture) {
       resolve_refs[bind_point] = vk::AttachmentReference{
           static_cast<uint32_t>(attachments.size()), vk::ImageLayout::eGeneral};
       attachments.emplace_back(
           CreateAttachmentDescription(color, &Attachment::resolve_texture));
-      SetTextureLayout(color, attachments.back(), command_buffer,
+      SetTextureLayout(color, attachments.back(), barriers,
                        &Attachment::resolve_texture);
     }
   }
@@ -142,7 +149,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(depth.value(), &Attachment::texture));
-    SetTextureLayout(depth.value(), attachments.back(), command_buffer,
+    SetTextureLayout(depth.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -153,7 +160,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(stencil.value(), &Attachment::texture));
-    SetTextureLayout(stencil.value(), attachments.back(), command_buffer,
+    SetTextureLayout(stencil.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -285,11 +292,10 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   // All previous writes via a render or blit pass must be done before another
   // shader attempts to read the resource.
   BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
   barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
                        vk::AccessFlagBits::eTransferWrite;
   barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
@@ -300,7 +306,8 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
   barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    if (!TextureVK::Cast(*data.texture.resource)
+             .SetLayout(barrier, barriers)) {
       return false;
     }
   }
@@ -308,15 +315,15 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
 }
 
 static bool UpdateBindingLayouts(const Command& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.vertex_bindings, buffer) &&
-         UpdateBindingLayouts(command.fragment_bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.vertex_bindings, barriers) &&
+         UpdateBindingLayouts(command.fragment_bindings, barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<Command>& commands,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
@@ -326,15 +333,11 @@ static bool UpdateBindingLayouts(const std::vector<Command>& commands,
 static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           const Command& command,
                                           CommandEncoderVK& encoder,
+                                          PassBindingsCache& cmd_buffer_cache,
                                           const PipelineVK& pipeline,
                                           size_t command_count) {
   auto desc_set =
       pipeline.GetDescriptor().GetVertexDescriptor()->GetDescriptorSetLayouts();
-  auto vk_desc_set = encoder.AllocateDescriptorSet(
-      pipeline.GetDescriptorSetLayout(), command_count);
-  if (!vk_desc_set) {
-    return false;
-  }
 
   auto& allocator = *context.GetResourceAllocator();
 
@@ -348,10 +351,9 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   buffers.reserve(command.vertex_bindings.buffers.size() +
                   command.fragment_bindings.buffers.size());
 
-  auto bind_images = [&encoder,     //
-                      &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+  auto bind_images = [&encoder,  //
+                      &images,   //
+                      &writes    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, data] : bindings.sampled_images) {
       auto texture = data.texture.resource;
@@ -372,7 +374,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       images.push_back(image_info);
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -384,12 +385,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return true;
   };
 
-  auto bind_buffers = [&allocator,   //
-                       &encoder,     //
-                       &buffers,     //
-                       &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+  auto bind_buffers = [&allocator,  //
+                       &encoder,    //
+                       &buffers,    //
+                       &writes,     //
+                       &desc_set    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, data] : bindings.buffers) {
       const auto& buffer_view = data.view.resource.buffer;
@@ -430,7 +430,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -447,14 +446,18 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  // Commands that bind the same resources share a descriptor set, which is
+  // only written the first time.
+  auto vk_desc_set = encoder.WriteDescriptorSet(
+      pipeline.GetDescriptorSetLayout(), writes, command_count);
+  if (!vk_desc_set) {
+    return false;
+  }
 
-  encoder.GetCommandBuffer().bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,   // bind point
-      pipeline.GetPipelineLayout(),       // layout
-      0,                                  // first set
-      {vk::DescriptorSet{*vk_desc_set}},  // sets
-      nullptr                             // offsets
+  cmd_buffer_cache.BindDescriptorSet(encoder.GetCommandBuffer(),        //
+                                     vk::PipelineBindPoint::eGraphics,  //
+                                     pipeline.GetPipelineLayout(),      //
+                                     vk::DescriptorSet{*vk_desc_set}    //
   );
   return true;
 }
@@ -470,8 +473,8 @@ static void SetViewportAndScissor(const Command& command,
                               .setWidth(vp.rect.size.width)
                               .setHeight(-vp.rect.size.height)
                               .setY(vp.rect.size.height)
-                              .setMinDepth(0.0f)
-                              .setMaxDepth(1.0f);
+                              .setMinDepth(vp.depth_range.z_near)
+                              .setMaxDepth(vp.depth_range.z_far);
   cmd_buffer_cache.SetViewport(cmd_buffer, 0, 1, &viewport);
 
   // Set the scissor rect.
@@ -510,6 +513,7 @@ static bool EncodeCommand(const Context& context,
   if (!AllocateAndBindDescriptorSets(ContextVK::Cast(context),  //
                                      command,                   //
                                      encoder,                   //
+                                     command_buffer_cache,      //
                                      pipeline_vk,               //
                                      command_count              //
                                      )) {
@@ -550,9 +554,8 @@ static bool EncodeCommand(const Context& context,
 
   // Bind the vertex buffer.
   auto vertex_buffer_handle = DeviceBufferVK::Cast(*vertex_buffer).GetBuffer();
-  vk::Buffer vertex_buffers[] = {vertex_buffer_handle};
-  vk::DeviceSize vertex_buffer_offsets[] = {vertex_buffer_view.range.offset};
-  cmd_buffer.bindVertexBuffers(0u, 1u, vertex_buffers, vertex_buffer_offsets);
+  command_buffer_cache.BindVertexBuffer(cmd_buffer, vertex_buffer_handle,
+                                        vertex_buffer_view.range.offset);
 
   if (command.index_type != IndexType::kNone) {
     // Bind the index buffer.
@@ -573,9 +576,9 @@ static bool EncodeCommand(const Context& context,
     }
 
     auto index_buffer_handle = DeviceBufferVK::Cast(*index_buffer).GetBuffer();
-    cmd_buffer.bindIndexBuffer(index_buffer_handle,
-                               index_buffer_view.range.offset,
-                               ToVKIndexType(command.index_type));
+    command_buffer_cache.BindIndexBuffer(cmd_buffer, index_buffer_handle,
+                                         index_buffer_view.range.offset,
+                                         ToVKIndexType(command.index_type));
 
     // Engage!
     cmd_buffer.drawIndexed(command.vertex_count,    // index count
@@ -622,7 +625,11 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   auto cmd_buffer = encoder->GetCommandBuffer();
 
-  if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
+  // The layout transitions of every texture the pass samples from or renders
+  // to are encoded together, right before the render pass begins.
+  BarrierBatchVK barriers(cmd_buffer);
+
+  if (!UpdateBindingLayouts(commands_, barriers)) {
     return false;
   }
 
@@ -635,7 +642,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   const auto& target_size = render_target_.GetRenderTargetSize();
 
-  auto render_pass = CreateVKRenderPass(vk_context, command_buffer);
+  auto render_pass = CreateVKRenderPass(vk_context, barriers);
   if (!render_pass) {
     VALIDATION_LOG << "Could not create renderpass.";
     return false;
@@ -661,6 +668,8 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
+  barriers.Flush();
+
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
@@ -16,12 +16,9 @@ SamplerLibraryVK::SamplerLibraryVK(
 
 SamplerLibraryVK::~SamplerLibraryVK() = default;
 
-std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
-    SamplerDescriptor desc) {
-  auto found = samplers_.find(desc);
-  if (found != samplers_.end()) {
-    return found->second;
-  }
+// |SamplerLibrary|
+std::shared_ptr<const Sampler> SamplerLibraryVK::CreateSampler(
+    const SamplerDescriptor& desc) {
   auto device_holder = device_holder_.lock();
   if (!device_holder || !device_holder->GetDevice()) {
     return nullptr;
@@ -64,7 +61,6 @@ std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
                             desc.label.c_str());
   }
 
-  samplers_[desc] = sampler;
   return sampler;
 }
 
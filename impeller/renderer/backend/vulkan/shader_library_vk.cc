@@ -52,20 +52,38 @@ static std::string VKShaderNameToShaderKeyName(const std::string& name,
   return stream.str();
 }
 
+static bool IsMappingSPIRV(const fml::Mapping& mapping) {
+  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
+  const uint32_t kSPIRVMagic = 0x07230203;
+  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
+    return false;
+  }
+  uint32_t magic = 0u;
+  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
+  return magic == kSPIRVMagic;
+}
+
 ShaderLibraryVK::ShaderLibraryVK(
     std::weak_ptr<DeviceHolder> device_holder,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data)
     : device_holder_(std::move(device_holder)) {
   TRACE_EVENT0("impeller", "CreateShaderLibrary");
   bool success = true;
+  WriterLock lock(functions_mutex_);
   auto iterator = [&](auto type,         //
                       const auto& name,  //
                       const auto& code   //
                       ) -> bool {
-    if (!RegisterFunction(name, ToShaderStage(type), code)) {
+    if (!code || !IsMappingSPIRV(*code)) {
+      VALIDATION_LOG << "Shader " << name << " is not valid SPIRV.";
       success = false;
       return false;
     }
+    const auto stage = ToShaderStage(type);
+    // The modules are created when the functions are first requested. The
+    // blob mappings keep their library alive, so the SPIRV isn't copied.
+    pending_functions_[ShaderKey{VKShaderNameToShaderKeyName(name, stage),
+                                 stage}] = PendingFunction{name, code};
     return true;
   };
   for (const auto& library_data : shader_libraries_data) {
@@ -78,7 +96,7 @@ ShaderLibraryVK::ShaderLibraryVK(
   }
 
   if (!success) {
-    VALIDATION_LOG << "Could not create shader modules for all shader blobs.";
+    VALIDATION_LOG << "Could not register all shader blobs.";
     return;
   }
   is_valid_ = true;
@@ -94,14 +112,32 @@ bool ShaderLibraryVK::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryVK::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
-
   const auto key = ShaderKey{{name.data(), name.size()}, stage};
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
+  {
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    if (found != functions_.end()) {
+      return found->second;
+    }
+  }
+
+  WriterLock lock(functions_mutex_);
+  // Another thread may have created the module while the lock was released.
+  if (auto found = functions_.find(key); found != functions_.end()) {
     return found->second;
   }
-  return nullptr;
+  auto pending = pending_functions_.find(key);
+  if (pending == pending_functions_.end()) {
+    return nullptr;
+  }
+  auto function = CreateFunction(pending->second.name, key.name, stage,
+                                 *pending->second.code);
+  if (!function) {
+    return nullptr;
+  }
+  pending_functions_.erase(pending);
+  functions_[key] = function;
+  return function;
 }
 
 // |ShaderLibrary|
@@ -115,17 +151,6 @@ void ShaderLibraryVK::RegisterFunction(std::string name,
   }
 }
 
-static bool IsMappingSPIRV(const fml::Mapping& mapping) {
-  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
-  const uint32_t kSPIRVMagic = 0x07230203;
-  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
-    return false;
-  }
-  uint32_t magic = 0u;
-  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
-  return magic == kSPIRVMagic;
-}
-
 bool ShaderLibraryVK::RegisterFunction(
     const std::string& name,
     ShaderStage stage,
@@ -139,15 +164,35 @@ bool ShaderLibraryVK::RegisterFunction(
     return false;
   }
 
+  const auto key_name = VKShaderNameToShaderKeyName(name, stage);
+  auto function = CreateFunction(name, key_name, stage, *code);
+  if (!function) {
+    return false;
+  }
+
+  WriterLock lock(functions_mutex_);
+  const auto key = ShaderKey{key_name, stage};
+  pending_functions_.erase(key);
+  functions_[key] = std::move(function);
+
+  return true;
+}
+
+std::shared_ptr<ShaderFunctionVK> ShaderLibraryVK::CreateFunction(
+    const std::string& name,
+    const std::string& key_name,
+    ShaderStage stage,
+    const fml::Mapping& code) const {
+  TRACE_EVENT0("impeller", "CreateShaderModule");
   vk::ShaderModuleCreateInfo shader_module_info;
 
   shader_module_info.setPCode(
-      reinterpret_cast<const uint32_t*>(code->GetMapping()));
-  shader_module_info.setCodeSize(code->GetSize());
+      reinterpret_cast<const uint32_t*>(code.GetMapping()));
+  shader_module_info.setCodeSize(code.GetSize());
 
   auto device_holder = device_holder_.lock();
   if (!device_holder) {
-    return false;
+    return nullptr;
   }
   FML_DCHECK(device_holder->GetDevice());
   auto module =
@@ -156,25 +201,20 @@ bool ShaderLibraryVK::RegisterFunction(
   if (module.result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create shader module: "
                    << vk::to_string(module.result);
-    return false;
+    return nullptr;
   }
 
-  const auto key_name = VKShaderNameToShaderKeyName(name, stage);
-
   vk::UniqueShaderModule shader_module = std::move(module.value);
   ContextVK::SetDebugName(device_holder->GetDevice(), *shader_module,
                           "Shader " + name);
 
-  WriterLock lock(functions_mutex_);
-  functions_[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionVK>(
+  return std::shared_ptr<ShaderFunctionVK>(
       new ShaderFunctionVK(device_holder_,
                            library_id_,              //
                            key_name,                 //
                            stage,                    //
                            std::move(shader_module)  //
                            ));
-
-  return true;
 }
 
 // |ShaderLibrary|
@@ -182,6 +222,7 @@ void ShaderLibraryVK::UnregisterFunction(std::string name, ShaderStage stage) {
   WriterLock lock(functions_mutex_);
 
   const auto key = ShaderKey{name, stage};
+  pending_functions_.erase(key);
 
   auto found = functions_.find(key);
   if (found != functions_.end()) {
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/base/thread.h"
@@ -14,6 +16,16 @@
 
 namespace impeller {
 
+class ShaderFunctionVK;
+
+//------------------------------------------------------------------------------
+/// @brief      The shaders of a Vulkan context.
+///
+///             Shader modules for the functions in the blob libraries the
+///             context is created with are only created when a function is
+///             first requested. Until then, the library references the SPIRV
+///             in the blob libraries without copying it.
+///
 class ShaderLibraryVK final : public ShaderLibrary {
  public:
   // |ShaderLibrary|
@@ -26,8 +38,19 @@ class ShaderLibraryVK final : public ShaderLibrary {
   friend class ContextVK;
   std::weak_ptr<DeviceHolder> device_holder_;
   const UniqueID library_id_;
+  struct PendingFunction {
+    std::string name;
+    std::shared_ptr<fml::Mapping> code;
+  };
+  using PendingFunctionMap = std::unordered_map<ShaderKey,
+                                                PendingFunction,
+                                                ShaderKey::Hash,
+                                                ShaderKey::Equal>;
+
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Functions from the blob libraries whose modules haven't been created yet.
+  PendingFunctionMap pending_functions_ IPLR_GUARDED_BY(functions_mutex_);
   bool is_valid_ = false;
 
   ShaderLibraryVK(
@@ -48,6 +71,12 @@ class ShaderLibraryVK final : public ShaderLibrary {
                         ShaderStage stage,
                         const std::shared_ptr<fml::Mapping>& code);
 
+  std::shared_ptr<ShaderFunctionVK> CreateFunction(
+      const std::string& name,
+      const std::string& key_name,
+      ShaderStage stage,
+      const fml::Mapping& code) const;
+
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
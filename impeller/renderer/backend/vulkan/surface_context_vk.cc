@@ -48,6 +48,15 @@ std::shared_ptr<CommandBuffer> SurfaceContextVK::CreateCommandBuffer() const {
   return parent_->CreateCommandBuffer();
 }
 
+bool SurfaceContextVK::EnqueueCommandBuffer(
+    std::shared_ptr<CommandBuffer> command_buffer) const {
+  return parent_->EnqueueCommandBuffer(std::move(command_buffer));
+}
+
+bool SurfaceContextVK::FlushCommandBuffers() const {
+  return parent_->FlushCommandBuffers();
+}
+
 const std::shared_ptr<const Capabilities>& SurfaceContextVK::GetCapabilities()
     const {
   return parent_->GetCapabilities();
@@ -64,12 +73,24 @@ bool SurfaceContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface) {
     return false;
   }
   swapchain_ = std::move(swapchain);
+#ifdef FML_OS_ANDROID
+  ahb_swapchain_.reset();
+#endif  // FML_OS_ANDROID
   return true;
 }
 
 std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  auto surface = swapchain_ ? swapchain_->AcquireNextDrawable() : nullptr;
+  std::unique_ptr<Surface> surface;
+#ifdef FML_OS_ANDROID
+  if (ahb_swapchain_) {
+    surface = ahb_swapchain_->AcquireNextDrawable();
+  } else if (swapchain_) {
+    surface = swapchain_->AcquireNextDrawable();
+  }
+#else
+  surface = swapchain_ ? swapchain_->AcquireNextDrawable() : nullptr;
+#endif  // FML_OS_ANDROID
   if (!surface) {
     return nullptr;
   }
@@ -84,10 +105,38 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
   return surface;
 }
 
+std::optional<std::chrono::nanoseconds> SurfaceContextVK::GetRefreshDuration()
+    const {
+  return swapchain_ ? swapchain_->GetRefreshDuration() : std::nullopt;
+}
+
+std::optional<FramePacingVK> SurfaceContextVK::GetLastFramePacing() const {
+  // Hardware buffer swapchains are paced by the compositor releasing buffers.
+  return swapchain_ ? swapchain_->GetLastFramePacing() : std::nullopt;
+}
+
+std::vector<vk::PastPresentationTimingGOOGLE>
+SurfaceContextVK::TakePastPresentationTimings() {
+#ifdef FML_OS_ANDROID
+  if (ahb_swapchain_) {
+    return ahb_swapchain_->TakePastPresentationTimings();
+  }
+#endif  // FML_OS_ANDROID
+  if (!swapchain_) {
+    return {};
+  }
+  return swapchain_->TakePastPresentationTimings();
+}
+
 void SurfaceContextVK::SetSyncPresentation(bool value) {
   parent_->SetSyncPresentation(value);
 }
 
+const std::shared_ptr<fml::ConcurrentTaskRunner>
+SurfaceContextVK::GetConcurrentWorkerTaskRunner() const {
+  return parent_->GetConcurrentWorkerTaskRunner();
+}
+
 #ifdef FML_OS_ANDROID
 
 vk::UniqueSurfaceKHR SurfaceContextVK::CreateAndroidSurface(
@@ -109,6 +158,18 @@ vk::UniqueSurfaceKHR SurfaceContextVK::CreateAndroidSurface(
   return std::move(surface_res.value);
 }
 
+bool SurfaceContextVK::SetAHBSwapchain(
+    std::unique_ptr<AHBSwapchainVK::Delegate> delegate) {
+  auto swapchain = AHBSwapchainVK::Create(parent_, std::move(delegate));
+  if (!swapchain) {
+    VALIDATION_LOG << "Could not create hardware buffer swapchain.";
+    return false;
+  }
+  ahb_swapchain_ = std::move(swapchain);
+  swapchain_.reset();
+  return true;
+}
+
 #endif  // FML_OS_ANDROID
 
 }  // namespace impeller
@@ -4,9 +4,15 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/vulkan/ahb_swapchain_vk.h"
+#include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 
@@ -48,6 +54,13 @@ class SurfaceContextVK : public Context,
   // |Context|
   std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override;
 
+  // |Context|
+  bool EnqueueCommandBuffer(
+      std::shared_ptr<CommandBuffer> command_buffer) const override;
+
+  // |Context|
+  bool FlushCommandBuffers() const override;
+
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
@@ -61,13 +74,49 @@ class SurfaceContextVK : public Context,
 
   std::unique_ptr<Surface> AcquireNextSurface();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The refresh cycle duration of the display the window surface
+  ///             is presented to, if the device can report it.
+  ///
+  std::optional<std::chrono::nanoseconds> GetRefreshDuration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How far the GPU was behind when the last surface was
+  ///             acquired, if it was acquired from a Vulkan swapchain. The
+  ///             number of frames in flight is limited by the
+  ///             `max_frames_in_flight` setting of the context.
+  ///
+  std::optional<FramePacingVK> GetLastFramePacing() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      When the frames presented to the window surface since the
+  ///             last call were actually displayed, if the device can report
+  ///             it. This can be used to pace frames and to report frame
+  ///             timings.
+  ///
+  std::vector<vk::PastPresentationTimingGOOGLE> TakePastPresentationTimings();
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
 #ifdef FML_OS_ANDROID
   vk::UniqueSurfaceKHR CreateAndroidSurface(ANativeWindow* window) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents to the window through `AHardwareBuffer`s handed to
+  ///             the system compositor by `delegate` instead of a Vulkan
+  ///             swapchain. Replaces any window surface that was set.
+  ///
+  [[nodiscard]] bool SetAHBSwapchain(
+      std::unique_ptr<AHBSwapchainVK::Delegate> delegate);
 #endif  // FML_OS_ANDROID
 
  private:
   std::shared_ptr<ContextVK> parent_;
   std::shared_ptr<SwapchainVK> swapchain_;
+#ifdef FML_OS_ANDROID
+  std::shared_ptr<AHBSwapchainVK> ahb_swapchain_;
+#endif  // FML_OS_ANDROID
 };
 
 }  // namespace impeller
@@ -4,58 +4,45 @@
 
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 
+#include <optional>
+
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 #include "impeller/renderer/surface.h"
 
 namespace impeller {
 
-std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
+static std::optional<RenderTarget> CreateOnscreenRenderTarget(
     const std::shared_ptr<Context>& context,
-    std::shared_ptr<SwapchainImageVK>& swapchain_image,
-    SwapCallback swap_callback) {
-  if (!context || !swapchain_image || !swap_callback) {
-    return nullptr;
-  }
-
-  TextureDescriptor msaa_tex_desc;
-  msaa_tex_desc.storage_mode = StorageMode::kDeviceTransient;
-  msaa_tex_desc.type = TextureType::kTexture2DMultisample;
-  msaa_tex_desc.sample_count = SampleCount::kCount4;
-  msaa_tex_desc.format = swapchain_image->GetPixelFormat();
-  msaa_tex_desc.size = swapchain_image->GetSize();
-  msaa_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
+    const std::shared_ptr<TextureSourceVK>& source,
+    std::shared_ptr<Texture>& msaa_tex) {
+  const auto& source_desc = source->GetTextureDescriptor();
+
+  if (!msaa_tex) {
+    TextureDescriptor msaa_tex_desc;
+    msaa_tex_desc.storage_mode = StorageMode::kDeviceTransient;
+    msaa_tex_desc.type = TextureType::kTexture2DMultisample;
+    msaa_tex_desc.sample_count = SampleCount::kCount4;
+    msaa_tex_desc.format = source_desc.format;
+    msaa_tex_desc.size = source_desc.size;
+    msaa_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
 
-  std::shared_ptr<Texture> msaa_tex;
-  if (!swapchain_image->HasMSAATexture()) {
     msaa_tex = context->GetResourceAllocator()->CreateTexture(msaa_tex_desc);
-    msaa_tex->SetLabel("ImpellerOnscreenColorMSAA");
     if (!msaa_tex) {
       VALIDATION_LOG << "Could not allocate MSAA color texture.";
-      return nullptr;
+      return std::nullopt;
     }
-    swapchain_image->SetMSAATexture(msaa_tex);
-  } else {
-    msaa_tex = swapchain_image->GetMSAATexture();
+    msaa_tex->SetLabel("ImpellerOnscreenColorMSAA");
   }
 
-  TextureDescriptor resolve_tex_desc;
-  resolve_tex_desc.type = TextureType::kTexture2D;
-  resolve_tex_desc.format = swapchain_image->GetPixelFormat();
-  resolve_tex_desc.size = swapchain_image->GetSize();
-  resolve_tex_desc.usage =
-      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
-  resolve_tex_desc.sample_count = SampleCount::kCount1;
-  resolve_tex_desc.storage_mode = StorageMode::kDevicePrivate;
-
   std::shared_ptr<Texture> resolve_tex =
-      std::make_shared<TextureVK>(context,         //
-                                  swapchain_image  //
+      std::make_shared<TextureVK>(context,  //
+                                  source    //
       );
 
   if (!resolve_tex) {
     VALIDATION_LOG << "Could not wrap resolve texture.";
-    return nullptr;
+    return std::nullopt;
   }
   resolve_tex->SetLabel("ImpellerOnscreenResolve");
 
@@ -68,10 +55,50 @@ std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
 
   RenderTarget render_target_desc;
   render_target_desc.SetColorAttachment(color0, 0u);
+  return render_target_desc;
+}
+
+std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
+    const std::shared_ptr<Context>& context,
+    std::shared_ptr<SwapchainImageVK>& swapchain_image,
+    SwapCallback swap_callback) {
+  if (!context || !swapchain_image || !swap_callback) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Texture> msaa_tex = swapchain_image->GetMSAATexture();
+  auto render_target =
+      CreateOnscreenRenderTarget(context, swapchain_image, msaa_tex);
+  if (!render_target.has_value()) {
+    return nullptr;
+  }
+  if (!swapchain_image->HasMSAATexture()) {
+    swapchain_image->SetMSAATexture(msaa_tex);
+  }
+
+  // The constructor is private. So make_unique may not be used.
+  return std::unique_ptr<SurfaceVK>(
+      new SurfaceVK(render_target.value(), std::move(swap_callback)));
+}
+
+std::unique_ptr<SurfaceVK> SurfaceVK::WrapTextureSource(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<TextureSourceVK>& source,
+    std::shared_ptr<Texture>& msaa_texture,
+    SwapCallback swap_callback) {
+  if (!context || !source || !swap_callback) {
+    return nullptr;
+  }
+
+  auto render_target =
+      CreateOnscreenRenderTarget(context, source, msaa_texture);
+  if (!render_target.has_value()) {
+    return nullptr;
+  }
 
   // The constructor is private. So make_unique may not be used.
   return std::unique_ptr<SurfaceVK>(
-      new SurfaceVK(render_target_desc, std::move(swap_callback)));
+      new SurfaceVK(render_target.value(), std::move(swap_callback)));
 }
 
 SurfaceVK::SurfaceVK(const RenderTarget& target, SwapCallback swap_callback)
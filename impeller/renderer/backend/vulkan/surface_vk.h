@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
 #include "impeller/renderer/surface.h"
 
 namespace impeller {
@@ -22,6 +23,22 @@ class SurfaceVK final : public Surface {
       std::shared_ptr<SwapchainImageVK>& swapchain_image,
       SwapCallback swap_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps an image that is presented by other means than a
+  ///             swapchain, such as an Android hardware buffer handed to the
+  ///             system compositor.
+  ///
+  /// @param      msaa_texture  The multisample texture rendered to before it
+  ///                           is resolved into `source`. A texture is
+  ///                           allocated and stored here if it is empty so
+  ///                           that it can be reused for the next frame.
+  ///
+  static std::unique_ptr<SurfaceVK> WrapTextureSource(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<TextureSourceVK>& source,
+      std::shared_ptr<Texture>& msaa_texture,
+      SwapCallback swap_callback);
+
   // |Surface|
   ~SurfaceVK() override;
 
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -14,13 +16,15 @@
 
 namespace impeller {
 
-static constexpr size_t kMaxFramesInFlight = 3u;
-
 // Number of frames to poll for orientation changes. For example `1u` means
 // that the orientation will be polled every frame, while `2u` means that the
 // orientation will be polled every other frame.
 static constexpr size_t kPollFramesForOrientation = 1u;
 
+// The number of past presentation timings kept for callers that don't take
+// them every frame.
+static constexpr size_t kMaxPresentationTimings = 64u;
+
 struct FrameSynchronizer {
   vk::UniqueFence acquire;
   vk::UniqueSemaphore render_ready;
@@ -47,6 +51,10 @@ struct FrameSynchronizer {
 
   ~FrameSynchronizer() = default;
 
+  bool IsPending(const vk::Device& device) const {
+    return device.getFenceStatus(*acquire) == vk::Result::eNotReady;
+  }
+
   bool WaitForFence(const vk::Device& device) {
     if (auto result = device.waitForFences(
             *acquire,                             // fence
@@ -111,6 +119,16 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& modes,
+    vk::PresentModeKHR preference) {
+  if (std::find(modes.begin(), modes.end(), preference) != modes.end()) {
+    return preference;
+  }
+  // FIFO is the only present mode every surface has to support.
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -178,6 +196,14 @@ SwapchainImplVK::SwapchainImplVK(
     return;
   }
 
+  auto [present_modes_result, present_modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (present_modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(present_modes_result);
+    return;
+  }
+
   auto present_queue = ChoosePresentQueue(vk_context.GetPhysicalDevice(),  //
                                           vk_context.GetDevice(),          //
                                           *surface                         //
@@ -191,18 +217,24 @@ SwapchainImplVK::SwapchainImplVK(
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode =
+      ChoosePresentMode(present_modes, vk_context.GetPresentMode());
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
+  const uint32_t preferred_image_count =
+      vk_context.GetSwapchainImageCount() > 0u
+          ? vk_context.GetSwapchainImageCount()
+          : caps.minImageCount + 1u;
   swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u,  // preferred image count
-      caps.minImageCount,       // min count cannot be zero
-      caps.maxImageCount == 0u ? caps.minImageCount + 1u
-                               : caps.maxImageCount  // max zero means no limit
+      preferred_image_count,  // preferred image count
+      caps.minImageCount,     // min count cannot be zero
+      caps.maxImageCount == 0u
+          ? std::max(preferred_image_count, caps.minImageCount)
+          : caps.maxImageCount  // max zero means no limit
   );
   swapchain_info.imageArrayLayers = 1u;
   // Swapchain images are primarily used as color attachments (via resolve) or
@@ -266,7 +298,7 @@ SwapchainImplVK::SwapchainImplVK(
   }
 
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers;
-  for (size_t i = 0u; i < kMaxFramesInFlight; i++) {
+  for (size_t i = 0u; i < vk_context.GetMaxFramesInFlight(); i++) {
     auto sync = std::make_unique<FrameSynchronizer>(vk_context.GetDevice());
     if (!sync->is_valid) {
       VALIDATION_LOG << "Could not create frame synchronizers.";
@@ -276,9 +308,22 @@ SwapchainImplVK::SwapchainImplVK(
   }
   FML_DCHECK(!synchronizers.empty());
 
+  const bool supports_display_timing =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kGOOGLEDisplayTiming);
+  if (supports_display_timing) {
+    auto [refresh_result, refresh] =
+        vk_context.GetDevice().getRefreshCycleDurationGOOGLE(*swapchain);
+    if (refresh_result == vk::Result::eSuccess) {
+      refresh_duration_ = std::chrono::nanoseconds(refresh.refreshDuration);
+    }
+  }
+
   context_ = context;
   surface_ = std::move(surface);
   present_queue_ = present_queue.value();
+  supports_display_timing_ = supports_display_timing;
   surface_format_ = swapchain_info.imageFormat;
   swapchain_ = std::move(swapchain);
   images_ = std::move(swapchain_images);
@@ -325,6 +370,39 @@ std::shared_ptr<Context> SwapchainImplVK::GetContext() const {
   return context_.lock();
 }
 
+std::optional<std::chrono::nanoseconds> SwapchainImplVK::GetRefreshDuration()
+    const {
+  return refresh_duration_;
+}
+
+const FramePacingVK& SwapchainImplVK::GetLastFramePacing() const {
+  return last_frame_pacing_;
+}
+
+std::vector<vk::PastPresentationTimingGOOGLE>
+SwapchainImplVK::TakePastPresentationTimings() {
+  Lock lock(presentation_timings_mutex_);
+  std::vector<vk::PastPresentationTimingGOOGLE> timings(
+      presentation_timings_.begin(), presentation_timings_.end());
+  presentation_timings_.clear();
+  return timings;
+}
+
+void SwapchainImplVK::CollectPastPresentationTimings(
+    const vk::Device& device) {
+  auto [result, timings] = device.getPastPresentationTimingGOOGLE(*swapchain_);
+  if (result != vk::Result::eSuccess || timings.empty()) {
+    return;
+  }
+  Lock lock(presentation_timings_mutex_);
+  for (const auto& timing : timings) {
+    presentation_timings_.push_back(timing);
+  }
+  while (presentation_timings_.size() > kMaxPresentationTimings) {
+    presentation_timings_.pop_front();
+  }
+}
+
 SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   auto context_strong = context_.lock();
   if (!context_strong) {
@@ -338,12 +416,39 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   const auto& sync = synchronizers_[current_frame_];
 
   //----------------------------------------------------------------------------
-  /// Wait on the host for the synchronizer fence.
+  /// Wait on the host for the synchronizer fence. It is still pending if the
+  /// GPU hasn't finished as many frames as may be in flight, and waiting for it
+  /// throttles the raster thread to the pace of the GPU.
   ///
-  if (!sync->WaitForFence(context.GetDevice())) {
-    VALIDATION_LOG << "Could not wait for fence.";
-    return {};
+  size_t frames_in_flight = 0u;
+  for (const auto& pending_sync : synchronizers_) {
+    if (pending_sync->IsPending(context.GetDevice())) {
+      frames_in_flight++;
+    }
   }
+  const auto wait_start = std::chrono::steady_clock::now();
+  {
+    TRACE_EVENT0("impeller", "WaitForFramesInFlight");
+    if (!sync->WaitForFence(context.GetDevice())) {
+      VALIDATION_LOG << "Could not wait for fence.";
+      return {};
+    }
+  }
+  last_frame_pacing_.frames_in_flight = frames_in_flight;
+  last_frame_pacing_.throttle_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - wait_start);
+  const int64_t throttle_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          last_frame_pacing_.throttle_time)
+          .count();
+  static constexpr int64_t kFramePacingTraceID = 1989;
+  FML_TRACE_COUNTER("impeller",                          //
+                    "FramePacing",                       // series name
+                    kFramePacingTraceID,                 // series ID
+                    "FramesInFlight", frames_in_flight,  //
+                    "ThrottleTimeUs", throttle_time_us   //
+  );
 
   //----------------------------------------------------------------------------
   /// Poll to see if the orientation has changed.
@@ -470,7 +575,8 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
-  auto task = [&, index, current_frame = current_frame_] {
+  const uint32_t present_id = next_present_id_++;
+  auto task = [&, index, current_frame = current_frame_, present_id] {
     auto context_strong = context_.lock();
     if (!context_strong) {
       return;
@@ -488,7 +594,25 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     present_info.setImageIndices(indices);
     present_info.setWaitSemaphores(*sync->present_ready);
 
-    switch (auto result = present_queue_.presentKHR(present_info)) {
+    // Ask for the presentation to be timed so that when it actually showed up
+    // can be queried later. An unset desired present time means as soon as
+    // possible.
+    vk::PresentTimeGOOGLE present_time;
+    present_time.presentID = present_id;
+    vk::PresentTimesInfoGOOGLE present_times;
+    present_times.setTimes(present_time);
+    if (supports_display_timing_) {
+      present_info.pNext = &present_times;
+    }
+
+    const auto result = present_queue_.presentKHR(present_info);
+    if (supports_display_timing_ && (result == vk::Result::eSuccess ||
+                                     result == vk::Result::eSuboptimalKHR)) {
+      CollectPastPresentationTimings(
+          ContextVK::Cast(*context_strong).GetDevice());
+    }
+
+    switch (result) {
       case vk::Result::eErrorOutOfDateKHR:
         // Caller will recreate the impl on acquisition, not submission.
         [[fallthrough]];
@@ -4,10 +4,15 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <variant>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 
@@ -18,6 +23,17 @@ class SwapchainImageVK;
 class Surface;
 struct FrameSynchronizer;
 
+//------------------------------------------------------------------------------
+/// @brief      How far the GPU was behind when a drawable was acquired.
+///
+struct FramePacingVK {
+  /// The number of frames submitted to the GPU that it hadn't finished yet.
+  size_t frames_in_flight = 0u;
+  /// How long acquiring the drawable waited for the oldest of them to finish
+  /// because the limit of frames in flight was reached.
+  std::chrono::nanoseconds throttle_time = {};
+};
+
 //------------------------------------------------------------------------------
 /// @brief      An instance of a swapchain that does NOT adapt to going out of
 ///             date with the underlying surface. Errors will be indicated when
@@ -58,6 +74,33 @@ class SwapchainImplVK final
 
   std::shared_ptr<Context> GetContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The duration of a refresh cycle of the display, if the device
+  ///             supports `VK_GOOGLE_display_timing`.
+  ///
+  std::optional<std::chrono::nanoseconds> GetRefreshDuration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns when the images presented since the last call were
+  ///             actually shown, as reported by `VK_GOOGLE_display_timing`.
+  ///             The present IDs of the timings increase by one every time an
+  ///             image is presented.
+  ///
+  ///             Only the most recent timings are kept. Nothing is reported if
+  ///             the device doesn't support display timing.
+  ///
+  std::vector<vk::PastPresentationTimingGOOGLE> TakePastPresentationTimings();
+
+  //----------------------------------------------------------------------------
+  /// @brief      How far the GPU was behind when the last drawable was
+  ///             acquired.
+  ///
+  ///             Acquiring a drawable waits while as many frames as the
+  ///             context allows are in flight, so that the raster thread
+  ///             can't queue up more work than the GPU keeps up with.
+  ///
+  const FramePacingVK& GetLastFramePacing() const;
+
   std::pair<vk::UniqueSurfaceKHR, vk::UniqueSwapchainKHR> DestroySwapchain();
 
  private:
@@ -69,9 +112,16 @@ class SwapchainImplVK final
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
+  FramePacingVK last_frame_pacing_;
   bool is_valid_ = false;
   size_t current_transform_poll_count_ = 0u;
   vk::SurfaceTransformFlagBitsKHR transform_if_changed_discard_swapchain_;
+  bool supports_display_timing_ = false;
+  std::optional<std::chrono::nanoseconds> refresh_duration_;
+  uint32_t next_present_id_ = 1u;
+  Mutex presentation_timings_mutex_;
+  std::deque<vk::PastPresentationTimingGOOGLE> presentation_timings_
+      IPLR_GUARDED_BY(presentation_timings_mutex_);
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
@@ -82,6 +132,8 @@ class SwapchainImplVK final
 
   void WaitIdle() const;
 
+  void CollectPastPresentationTimings(const vk::Device& device);
+
   FML_DISALLOW_COPY_AND_ASSIGN(SwapchainImplVK);
 };
 
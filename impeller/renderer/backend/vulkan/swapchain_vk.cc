@@ -71,4 +71,24 @@ vk::Format SwapchainVK::GetSurfaceFormat() const {
   return IsValid() ? impl_->GetSurfaceFormat() : vk::Format::eUndefined;
 }
 
+std::optional<std::chrono::nanoseconds> SwapchainVK::GetRefreshDuration()
+    const {
+  return IsValid() ? impl_->GetRefreshDuration() : std::nullopt;
+}
+
+std::optional<FramePacingVK> SwapchainVK::GetLastFramePacing() const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  return impl_->GetLastFramePacing();
+}
+
+std::vector<vk::PastPresentationTimingGOOGLE>
+SwapchainVK::TakePastPresentationTimings() {
+  if (!IsValid()) {
+    return {};
+  }
+  return impl_->TakePastPresentationTimings();
+}
+
 }  // namespace impeller
@@ -4,17 +4,19 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/surface.h"
 
 namespace impeller {
 
-class SwapchainImplVK;
-
 //------------------------------------------------------------------------------
 /// @brief      A swapchain that adapts to the underlying surface going out of
 ///             date. If the caller cannot acquire the next drawable, it is due
@@ -35,6 +37,15 @@ class SwapchainVK {
 
   vk::Format GetSurfaceFormat() const;
 
+  /// @see |SwapchainImplVK::GetRefreshDuration|.
+  std::optional<std::chrono::nanoseconds> GetRefreshDuration() const;
+
+  /// @see |SwapchainImplVK::GetLastFramePacing|.
+  std::optional<FramePacingVK> GetLastFramePacing() const;
+
+  /// @see |SwapchainImplVK::TakePastPresentationTimings|.
+  std::vector<vk::PastPresentationTimingGOOGLE> TakePastPresentationTimings();
+
  private:
   std::shared_ptr<SwapchainImplVK> impl_;
 
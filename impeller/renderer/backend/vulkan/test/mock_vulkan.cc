@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include <atomic>
 #include <cstring>
 #include <utility>
 #include <vector>
@@ -331,6 +332,46 @@ VkResult vkCreateDescriptorSetLayout(
   return VK_SUCCESS;
 }
 
+VkResult vkCreateDescriptorPool(VkDevice device,
+                                const VkDescriptorPoolCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator,
+                                VkDescriptorPool* pDescriptorPool) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkCreateDescriptorPool");
+  *pDescriptorPool = reinterpret_cast<VkDescriptorPool>(0xDE5C0001);
+  return VK_SUCCESS;
+}
+
+void vkDestroyDescriptorPool(VkDevice device,
+                             VkDescriptorPool descriptorPool,
+                             const VkAllocationCallbacks* pAllocator) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkDestroyDescriptorPool");
+}
+
+VkResult vkAllocateDescriptorSets(
+    VkDevice device,
+    const VkDescriptorSetAllocateInfo* pAllocateInfo,
+    VkDescriptorSet* pDescriptorSets) {
+  static std::atomic<uint64_t> next_descriptor_set = 0xDE5C5E70;
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkAllocateDescriptorSets");
+  for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+    pDescriptorSets[i] =
+        reinterpret_cast<VkDescriptorSet>(next_descriptor_set++);
+  }
+  return VK_SUCCESS;
+}
+
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkUpdateDescriptorSets");
+}
+
 VkResult vkCreatePipelineLayout(VkDevice device,
                                 const VkPipelineLayoutCreateInfo* pCreateInfo,
                                 const VkAllocationCallbacks* pAllocator,
@@ -423,6 +464,53 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+void vkCmdBindDescriptorSets(VkCommandBuffer commandBuffer,
+                             VkPipelineBindPoint pipelineBindPoint,
+                             VkPipelineLayout layout,
+                             uint32_t firstSet,
+                             uint32_t descriptorSetCount,
+                             const VkDescriptorSet* pDescriptorSets,
+                             uint32_t dynamicOffsetCount,
+                             const uint32_t* pDynamicOffsets) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdBindDescriptorSets");
+}
+
+void vkCmdBindVertexBuffers(VkCommandBuffer commandBuffer,
+                            uint32_t firstBinding,
+                            uint32_t bindingCount,
+                            const VkBuffer* pBuffers,
+                            const VkDeviceSize* pOffsets) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdBindVertexBuffers");
+}
+
+void vkCmdBindIndexBuffer(VkCommandBuffer commandBuffer,
+                          VkBuffer buffer,
+                          VkDeviceSize offset,
+                          VkIndexType indexType) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdBindIndexBuffer");
+}
+
+void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                          VkPipelineStageFlags srcStageMask,
+                          VkPipelineStageFlags dstStageMask,
+                          VkDependencyFlags dependencyFlags,
+                          uint32_t memoryBarrierCount,
+                          const VkMemoryBarrier* pMemoryBarriers,
+                          uint32_t bufferMemoryBarrierCount,
+                          const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                          uint32_t imageMemoryBarrierCount,
+                          const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+}
+
 void vkFreeCommandBuffers(VkDevice device,
                           VkCommandPool commandPool,
                           uint32_t commandBufferCount,
@@ -460,10 +548,31 @@ VkResult vkDestroyFence(VkDevice device,
   return VK_SUCCESS;
 }
 
+VkResult vkResetFences(VkDevice device,
+                       uint32_t fenceCount,
+                       const VkFence* pFences) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkResetFences");
+  for (uint32_t i = 0; i < fenceCount; i++) {
+    reinterpret_cast<MockFence*>(pFences[i])->SetStatus(vk::Result::eNotReady);
+  }
+  return VK_SUCCESS;
+}
+
 VkResult vkQueueSubmit(VkQueue queue,
                        uint32_t submitCount,
                        const VkSubmitInfo* pSubmits,
                        VkFence fence) {
+  // Queues aren't tied to a mock device, so record the submission with the
+  // command buffers that were submitted.
+  if (submitCount > 0u && pSubmits[0].commandBufferCount > 0u) {
+    reinterpret_cast<MockCommandBuffer*>(pSubmits[0].pCommandBuffers[0])
+        ->called_functions_->push_back("vkQueueSubmit");
+  }
+  // The mock device finishes work as soon as it is submitted.
+  if (fence) {
+    reinterpret_cast<MockFence*>(fence)->SetStatus(vk::Result::eSuccess);
+  }
   return VK_SUCCESS;
 }
 
@@ -553,6 +662,14 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateRenderPass;
   } else if (strcmp("vkCreateDescriptorSetLayout", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDescriptorSetLayout;
+  } else if (strcmp("vkCreateDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateDescriptorPool;
+  } else if (strcmp("vkDestroyDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroyDescriptorPool;
+  } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkCreatePipelineLayout", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreatePipelineLayout;
   } else if (strcmp("vkCreateGraphicsPipelines", pName) == 0) {
@@ -577,6 +694,14 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCmdSetViewport;
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyCommandPool;
+  } else if (strcmp("vkCmdBindDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdBindDescriptorSets;
+  } else if (strcmp("vkCmdBindVertexBuffers", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdBindVertexBuffers;
+  } else if (strcmp("vkCmdBindIndexBuffer", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdBindIndexBuffer;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
     return (PFN_vkVoidFunction)vkFreeCommandBuffers;
   } else if (strcmp("vkEndCommandBuffer", pName) == 0) {
@@ -585,6 +710,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateFence;
   } else if (strcmp("vkDestroyFence", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyFence;
+  } else if (strcmp("vkResetFences", pName) == 0) {
+    return (PFN_vkVoidFunction)vkResetFences;
   } else if (strcmp("vkQueueSubmit", pName) == 0) {
     return (PFN_vkVoidFunction)vkQueueSubmit;
   } else if (strcmp("vkWaitForFences", pName) == 0) {
@@ -27,12 +27,9 @@ vk::ImageLayout TextureSourceVK::SetLayoutWithoutEncoding(
   return old_layout;
 }
 
-fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
-  const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
-  if (barrier.new_layout == old_layout) {
-    return {};
-  }
-
+vk::ImageMemoryBarrier TextureSourceVK::CreateImageBarrier(
+    const BarrierVK& barrier,
+    vk::ImageLayout old_layout) const {
   vk::ImageMemoryBarrier image_barrier;
   image_barrier.srcAccessMask = barrier.src_access;
   image_barrier.dstAccessMask = barrier.dst_access;
@@ -46,7 +43,16 @@ fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
   image_barrier.subresourceRange.levelCount = desc_.mip_count;
   image_barrier.subresourceRange.baseArrayLayer = 0u;
   image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc_.type);
+  return image_barrier;
+}
+
+fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
+  const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
+  if (barrier.new_layout == old_layout) {
+    return {};
+  }
 
+  const auto image_barrier = CreateImageBarrier(barrier, old_layout);
   barrier.cmd_buffer.pipelineBarrier(barrier.src_stage,  // src stage
                                      barrier.dst_stage,  // dst stage
                                      {},                 // dependency flags
@@ -58,4 +64,14 @@ fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
   return {};
 }
 
+fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier,
+                                       BarrierBatchVK& batch) const {
+  const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
+  if (barrier.new_layout == old_layout) {
+    return {};
+  }
+  batch.AddImageBarrier(barrier, CreateImageBarrier(barrier, old_layout));
+  return {};
+}
+
 }  // namespace impeller
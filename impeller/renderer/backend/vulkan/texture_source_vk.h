@@ -35,6 +35,13 @@ class TextureSourceVK {
   /// `barrier.new_layout`.
   fml::Status SetLayout(const BarrierVK& barrier) const;
 
+  /// Adds the layout transition `barrier` to `batch` instead of encoding it
+  /// right away. `barrier.cmd_buffer` is ignored.
+  ///
+  /// The stored layout is updated immediately, so the texture is assumed to
+  /// be in `barrier.new_layout` once the batch is flushed.
+  fml::Status SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   /// Store the layout of the image.
   ///
   /// This just is bookkeeping on the CPU, to actually set the layout use
@@ -56,6 +63,9 @@ class TextureSourceVK {
   explicit TextureSourceVK(TextureDescriptor desc);
 
  private:
+  vk::ImageMemoryBarrier CreateImageBarrier(const BarrierVK& barrier,
+                                            vk::ImageLayout old_layout) const;
+
   mutable RWMutex layout_mutex_;
   mutable vk::ImageLayout layout_ IPLR_GUARDED_BY(layout_mutex_) =
       vk::ImageLayout::eUndefined;
@@ -107,7 +107,7 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
       &copy                                               // regions
   );
 
-  return cmd_buffer->SubmitCommands();
+  return context->EnqueueCommandBuffer(std::move(cmd_buffer));
 }
 
 bool TextureVK::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
@@ -141,6 +141,11 @@ bool TextureVK::SetLayout(const BarrierVK& barrier) const {
   return source_ ? source_->SetLayout(barrier).ok() : false;
 }
 
+bool TextureVK::SetLayout(const BarrierVK& barrier,
+                          BarrierBatchVK& batch) const {
+  return source_ ? source_->SetLayout(barrier, batch).ok() : false;
+}
+
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
   return source_ ? source_->SetLayoutWithoutEncoding(layout)
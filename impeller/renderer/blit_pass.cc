@@ -6,6 +6,7 @@
 #include <memory>
 #include <utility>
 
+#include "flutter/fml/trace_counters.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/host_buffer.h"
@@ -125,17 +126,23 @@ bool BlitPass::AddCopy(BufferView source,
     return false;
   }
 
+  const auto& size = destination->GetTextureDescriptor().size;
   auto bytes_per_pixel =
       BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
-  auto bytes_per_image =
-      destination->GetTextureDescriptor().size.Area() * bytes_per_pixel;
-
-  if (source.range.length != bytes_per_image) {
+  auto bytes_per_row = size.width * bytes_per_pixel;
+
+  if (bytes_per_row == 0 || source.range.length == 0 ||
+      source.range.length % bytes_per_row != 0 || destination_origin.x != 0 ||
+      destination_origin.y < 0 ||
+      destination_origin.y + static_cast<int64_t>(source.range.length /
+                                                  bytes_per_row) >
+          size.height) {
     VALIDATION_LOG
         << "Attempted to add a texture blit with out of bounds access.";
     return false;
   }
 
+  FML_PERFORMANCE_COUNTER_ADD("textureUploadBytes", source.range.length);
   return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
                                       destination_origin, std::move(label));
 }
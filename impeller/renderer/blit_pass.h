@@ -89,11 +89,16 @@ class BlitPass {
   ///             the texture.
   ///             No work is encoded into the command buffer at this time.
   ///
+  ///             The buffer holds whole, tightly packed rows of the texture.
+  ///             It may hold fewer rows than the texture, in which case only
+  ///             those rows are overwritten.
+  ///
   /// @param[in]  source              The buffer view to read for copying.
   /// @param[in]  destination         The texture to overwrite using the source
   ///                                 contents.
-  /// @param[in]  destination_offset  The offset to start writing to in the
-  ///                                 destination buffer.
+  /// @param[in]  destination_origin  The origin to start writing to in the
+  ///                                 destination texture. Its x coordinate
+  ///                                 must be 0.
   /// @param[in]  label               The optional debug label to give the
   ///                                 command.
   ///
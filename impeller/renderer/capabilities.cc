@@ -80,6 +80,26 @@ class StandardCapabilities final : public Capabilities {
     return supports_device_transient_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsBindlessTextures() const override {
+    return supports_bindless_textures_;
+  }
+
+  // |Capabilities|
+  bool SupportsTextureCompressionASTC() const override {
+    return supports_texture_compression_astc_;
+  }
+
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override {
+    return supports_texture_compression_etc2_;
+  }
+
+  // |Capabilities|
+  bool SupportsTextureCompressionBC() const override {
+    return supports_texture_compression_bc_;
+  }
+
  private:
   StandardCapabilities(bool supports_offscreen_msaa,
                        bool supports_ssbo,
@@ -92,6 +112,10 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_sampler_address_mode,
                        bool supports_device_transient_textures,
+                       bool supports_bindless_textures,
+                       bool supports_texture_compression_astc,
+                       bool supports_texture_compression_etc2,
+                       bool supports_texture_compression_bc,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format,
                        PixelFormat default_depth_stencil_format)
@@ -108,6 +132,10 @@ class StandardCapabilities final : public Capabilities {
         supports_decal_sampler_address_mode_(
             supports_decal_sampler_address_mode),
         supports_device_transient_textures_(supports_device_transient_textures),
+        supports_bindless_textures_(supports_bindless_textures),
+        supports_texture_compression_astc_(supports_texture_compression_astc),
+        supports_texture_compression_etc2_(supports_texture_compression_etc2),
+        supports_texture_compression_bc_(supports_texture_compression_bc),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format),
         default_depth_stencil_format_(default_depth_stencil_format) {}
@@ -125,6 +153,10 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_bindless_textures_ = false;
+  bool supports_texture_compression_astc_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_bc_ = false;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
@@ -217,6 +249,30 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDeviceTransientTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsBindlessTextures(
+    bool value) {
+  supports_bindless_textures_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionASTC(
+    bool value) {
+  supports_texture_compression_astc_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionETC2(
+    bool value) {
+  supports_texture_compression_etc2_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionBC(
+    bool value) {
+  supports_texture_compression_bc_ = value;
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       supports_offscreen_msaa_,                                           //
@@ -230,6 +286,10 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_sampler_address_mode_,                               //
       supports_device_transient_textures_,                                //
+      supports_bindless_textures_,                                        //
+      supports_texture_compression_astc_,                                 //
+      supports_texture_compression_etc2_,                                 //
+      supports_texture_compression_bc_,                                   //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
       default_stencil_format_.value_or(PixelFormat::kUnknown),            //
       default_depth_stencil_format_.value_or(PixelFormat::kUnknown)       //
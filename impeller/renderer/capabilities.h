@@ -87,6 +87,29 @@ class Capabilities {
   ///         This feature is especially useful for MSAA and stencils.
   virtual bool SupportsDeviceTransientTextures() const = 0;
 
+  /// @brief  Whether the context backend supports binding an array of
+  ///         textures once and having shaders pick one by a dynamically
+  ///         uniform or non-uniform index, such as one read from an instance
+  ///         buffer.
+  ///
+  ///         This is backed by tier 2 argument buffers on Metal and by
+  ///         `VK_EXT_descriptor_indexing` on Vulkan. It allows batching draws
+  ///         that sample different textures, like glyph atlas pages and
+  ///         images, into a single draw call.
+  virtual bool SupportsBindlessTextures() const = 0;
+
+  /// @brief  Whether the context backend supports sampling textures with the
+  ///         `PixelFormat::kASTC4x4UNormInt` format.
+  virtual bool SupportsTextureCompressionASTC() const = 0;
+
+  /// @brief  Whether the context backend supports sampling textures with the
+  ///         `PixelFormat::kETC2R8G8B8A8UNormInt` format.
+  virtual bool SupportsTextureCompressionETC2() const = 0;
+
+  /// @brief  Whether the context backend supports sampling textures with the
+  ///         `PixelFormat::kBC7UNormInt` format.
+  virtual bool SupportsTextureCompressionBC() const = 0;
+
   /// @brief  Returns a supported `PixelFormat` for textures that store
   ///         4-channel colors (red/green/blue/alpha).
   virtual PixelFormat GetDefaultColorFormat() const = 0;
@@ -143,6 +166,14 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsDeviceTransientTextures(bool value);
 
+  CapabilitiesBuilder& SetSupportsBindlessTextures(bool value);
+
+  CapabilitiesBuilder& SetSupportsTextureCompressionASTC(bool value);
+
+  CapabilitiesBuilder& SetSupportsTextureCompressionETC2(bool value);
+
+  CapabilitiesBuilder& SetSupportsTextureCompressionBC(bool value);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -157,6 +188,10 @@ class CapabilitiesBuilder {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_bindless_textures_ = false;
+  bool supports_texture_compression_astc_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_bc_ = false;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
   std::optional<PixelFormat> default_depth_stencil_format_ = std::nullopt;
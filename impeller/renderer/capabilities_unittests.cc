@@ -29,6 +29,10 @@ CAPABILITY_TEST(SupportsReadFromOnscreenTexture, false);
 CAPABILITY_TEST(SupportsReadFromResolve, false);
 CAPABILITY_TEST(SupportsDecalSamplerAddressMode, false);
 CAPABILITY_TEST(SupportsDeviceTransientTextures, false);
+CAPABILITY_TEST(SupportsBindlessTextures, false);
+CAPABILITY_TEST(SupportsTextureCompressionASTC, false);
+CAPABILITY_TEST(SupportsTextureCompressionETC2, false);
+CAPABILITY_TEST(SupportsTextureCompressionBC, false);
 
 TEST(CapabilitiesTest, DefaultColorFormat) {
   auto defaults = CapabilitiesBuilder().Build();
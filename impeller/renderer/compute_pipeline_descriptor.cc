@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/compute_pipeline_descriptor.h"
 
+#include "flutter/fml/fast_hash.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/shader_function.h"
 #include "impeller/renderer/shader_library.h"
@@ -17,12 +18,12 @@ ComputePipelineDescriptor::~ComputePipelineDescriptor() = default;
 
 // Comparable<ComputePipelineDescriptor>
 std::size_t ComputePipelineDescriptor::GetHash() const {
-  auto seed = fml::HashCombine();
-  fml::HashCombineSeed(seed, label_);
+  fml::FastHasher hasher;
+  hasher.AddBytes(label_);
   if (entrypoint_) {
-    fml::HashCombineSeed(seed, entrypoint_->GetHash());
+    hasher.Add(entrypoint_->GetHash());
   }
-  return seed;
+  return hasher.GetHash();
 }
 
 // Comparable<ComputePipelineDescriptor>
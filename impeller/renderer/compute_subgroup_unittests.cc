@@ -486,5 +486,63 @@ TEST_P(ComputeSubgroupTest, QuadAndCubicInOnePath) {
   }
 }
 
+TEST_P(ComputeSubgroupTest, FillTrianglesAddUpToTheWindingOfThePath) {
+  using SS = StrokeComputeShader;
+
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsComputeSubgroups());
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = ComputeTessellator::GetFillVertexBufferLength();
+  auto vertex_buffer = context->GetResourceAllocator()->CreateBuffer(desc);
+  auto vertex_buffer_count =
+      CreateHostVisibleDeviceBuffer<SS::VertexBufferCount>(context,
+                                                           "VertexBufferCount");
+
+  // The second contour is left open and is drawn in the same direction as the
+  // first, so it is covered twice once it is implicitly closed.
+  auto path = PathBuilder{}
+                  .AddRect(Rect::MakeXYWH(0, 0, 100, 100))
+                  .MoveTo({25, 25})
+                  .LineTo({75, 25})
+                  .LineTo({75, 75})
+                  .LineTo({25, 75})
+                  .TakePath();
+
+  fml::AutoResetWaitableEvent latch;
+  auto status = ComputeTessellator{}
+                    .SetStyle(ComputeTessellator::Style::kFill)
+                    .Tessellate(path, context, vertex_buffer->AsBufferView(),
+                                vertex_buffer_count->AsBufferView(),
+                                [&latch](CommandBuffer::Status status) {
+                                  EXPECT_EQ(status,
+                                            CommandBuffer::Status::kCompleted);
+                                  latch.Signal();
+                                });
+  ASSERT_EQ(status, ComputeTessellator::Status::kOk);
+  latch.Wait();
+
+  auto vertices =
+      reinterpret_cast<const Point*>(vertex_buffer->AsBufferView().contents);
+  auto signed_area = [&vertices](size_t slot) {
+    auto p0 = vertices[slot * 3 + 0];
+    auto p1 = vertices[slot * 3 + 1];
+    auto p2 = vertices[slot * 3 + 2];
+    return (p1 - p0).Cross(p2 - p0) / 2;
+  };
+  constexpr size_t kCapacity = ComputeTessellator::kMaxFillTriangleCount;
+  Scalar front_area = 0;
+  Scalar back_area = 0;
+  for (size_t i = 0; i < kCapacity; i++) {
+    EXPECT_GE(signed_area(i), 0);
+    EXPECT_LE(signed_area(i + kCapacity), 0);
+    front_area += signed_area(i);
+    back_area += signed_area(i + kCapacity);
+  }
+  EXPECT_NEAR(std::abs(front_area + back_area), 100 * 100 + 50 * 50, 1e-2);
+}
+
 }  // namespace testing
 }  // namespace impeller
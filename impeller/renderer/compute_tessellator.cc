@@ -4,7 +4,10 @@
 
 #include "impeller/renderer/compute_tessellator.h"
 
+#include <optional>
+
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/fill.comp.h"
 #include "impeller/renderer/path_polyline.comp.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/stroke.comp.h"
@@ -64,15 +67,19 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
     BufferView vertex_buffer,
     BufferView vertex_buffer_count,
     const CommandBuffer::CompletionCallback& callback) const {
-  FML_DCHECK(style_ == Style::kStroke);
   using PS = PathPolylineComputeShader;
   using SS = StrokeComputeShader;
+  using FS = FillComputeShader;
 
   auto cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
   auto quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
                     (cubic_count * 6);
   auto line_count =
       path.GetComponentCount(Path::ComponentType::kLinear) + (quad_count * 6);
+  if (style_ == Style::kFill) {
+    // Closing a contour and joining it to the others takes up to three lines.
+    line_count += path.GetComponentCount(Path::ComponentType::kContour) * 3;
+  }
   if (cubic_count > kMaxCubicCount || quad_count > kMaxQuadCount ||
       line_count > kMaxLineCount) {
     return Status::kTooManyComponents;
@@ -84,26 +91,80 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
   PS::Config config{.cubic_accuracy = cubic_accuracy_,
                     .quad_tolerance = quad_tolerance_};
 
+  auto add_line = [&lines, &components](Point p1, Point p2) {
+    LinearPathComponent linear(p1, p2);
+    ::memcpy(&lines.data[lines.count], &linear, sizeof(LinearPathComponent));
+    components.data[components.count++] = {lines.count++, 2};
+  };
+
+  // The contours of a fill are closed and joined to each other through the
+  // first point of the path, which the fan is built around. The lines that
+  // join them only add degenerate triangles to the fan.
+  const bool is_fill = style_ == Style::kFill;
+  std::optional<Point> anchor;
+  Point contour_start;
+  Point last_point;
+  bool contour_open = false;
+  auto begin_segment = [&](Point p1) {
+    if (!is_fill || contour_open) {
+      return;
+    }
+    if (!anchor.has_value()) {
+      anchor = p1;
+    } else {
+      if (last_point != anchor.value()) {
+        add_line(last_point, anchor.value());
+      }
+      if (p1 != anchor.value()) {
+        add_line(anchor.value(), p1);
+      }
+    }
+    contour_start = p1;
+    contour_open = true;
+  };
+  auto close_contour = [&]() {
+    if (!contour_open) {
+      return;
+    }
+    if (last_point != contour_start) {
+      add_line(last_point, contour_start);
+    }
+    last_point = contour_start;
+    contour_open = false;
+  };
+
   path.EnumerateComponents(
-      [&lines, &components](size_t index, const LinearPathComponent& linear) {
-        ::memcpy(&lines.data[lines.count], &linear,
-                 sizeof(LinearPathComponent));
-        components.data[components.count++] = {lines.count++, 2};
+      [&](size_t index, const LinearPathComponent& linear) {
+        begin_segment(linear.p1);
+        add_line(linear.p1, linear.p2);
+        last_point = linear.p2;
       },
-      [&quads, &components](size_t index, const QuadraticPathComponent& quad) {
+      [&](size_t index, const QuadraticPathComponent& quad) {
+        begin_segment(quad.p1);
         ::memcpy(&quads.data[quads.count], &quad,
                  sizeof(QuadraticPathComponent));
         components.data[components.count++] = {quads.count++, 3};
+        last_point = quad.p2;
       },
-      [&cubics, &components](size_t index, const CubicPathComponent& cubic) {
+      [&](size_t index, const CubicPathComponent& cubic) {
+        begin_segment(cubic.p1);
         ::memcpy(&cubics.data[cubics.count], &cubic,
                  sizeof(CubicPathComponent));
         components.data[components.count++] = {cubics.count++, 4};
+        last_point = cubic.p2;
       },
-      [](size_t index, const ContourComponent& contour) {});
+      [&](size_t index, const ContourComponent& contour) {
+        if (is_fill) {
+          close_contour();
+        }
+      });
+  if (is_fill) {
+    close_contour();
+  }
 
   auto polyline_buffer =
-      CreateDeviceBuffer<PS::Polyline<2048>>(context, "Polyline");
+      CreateDeviceBuffer<PS::Polyline<kMaxPolylinePointCount>>(context,
+                                                               "Polyline");
 
   auto cmd_buffer = context->CreateCommandBuffer();
   auto pass = cmd_buffer->CreateComputePass();
@@ -139,7 +200,31 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
     }
   }
 
-  {
+  if (is_fill) {
+    FML_DCHECK(vertex_buffer.range.length >= GetFillVertexBufferLength());
+    using FillPipelineBuilder = ComputePipelineBuilder<FS>;
+    auto pipeline_desc =
+        FillPipelineBuilder::MakeDefaultPipelineDescriptor(*context);
+    FML_DCHECK(pipeline_desc.has_value());
+    auto compute_pipeline =
+        context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+    FML_DCHECK(compute_pipeline);
+
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "Compute Fill");
+    cmd.pipeline = compute_pipeline;
+
+    FS::Config config{.triangle_capacity = kMaxFillTriangleCount};
+    FS::BindConfig(cmd, pass->GetTransientsBuffer().EmplaceUniform(config));
+
+    FS::BindPolyline(cmd, polyline_buffer->AsBufferView());
+    FS::BindVertexBufferCount(cmd, std::move(vertex_buffer_count));
+    FS::BindVertexBuffer(cmd, std::move(vertex_buffer));
+
+    if (!pass->AddCommand(std::move(cmd))) {
+      return Status::kCommandInvalid;
+    }
+  } else {
     using StrokePipelineBuilder = ComputePipelineBuilder<SS>;
     auto pipeline_desc =
         StrokePipelineBuilder::MakeDefaultPipelineDescriptor(*context);
@@ -16,6 +16,13 @@ namespace impeller {
 /// @brief      A utility that generates triangles of the specified fill type
 ///             given a path.
 ///
+///             Strokes are generated as a triangle strip. Fills are generated
+///             as a fan of triangles around the first point of the path, with
+///             every contour implicitly closed. The fan overlaps itself, so
+///             it has to be drawn into the stencil buffer to count the winding
+///             number of every pixel before the path is covered. See
+///             `GetFillVertexBufferLength`.
+///
 class ComputeTessellator {
  public:
   ComputeTessellator();
@@ -27,6 +34,8 @@ class ComputeTessellator {
   static constexpr size_t kMaxLineCount = 4096;
   static constexpr size_t kMaxComponentCount =
       kMaxCubicCount + kMaxQuadCount + kMaxLineCount;
+  static constexpr size_t kMaxPolylinePointCount = 2048;
+  static constexpr size_t kMaxFillTriangleCount = kMaxPolylinePointCount - 1;
 
   enum class Status {
     kCommandInvalid,
@@ -36,9 +45,23 @@ class ComputeTessellator {
 
   enum class Style {
     kStroke,
-    // TODO(dnfield): Implement kFill.
+    kFill,
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the vertex buffer that fills are written to.
+  ///
+  ///             The first half of the buffer holds the counter-clockwise
+  ///             triangles of the fan and the second half the clockwise ones,
+  ///             `kMaxFillTriangleCount` triangles each. Slots that don't hold
+  ///             a triangle of their half's orientation are filled with
+  ///             degenerate triangles, so both halves can be drawn in full
+  ///             without reading back the vertex count.
+  ///
+  static constexpr size_t GetFillVertexBufferLength() {
+    return kMaxFillTriangleCount * 3 * 2 * sizeof(Point);
+  }
+
   ComputeTessellator& SetStyle(Style value);
   ComputeTessellator& SetStrokeWidth(Scalar value);
   ComputeTessellator& SetStrokeJoin(Join value);
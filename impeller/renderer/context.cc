@@ -5,6 +5,8 @@
 #include "impeller/renderer/context.h"
 
 #include "impeller/core/capture.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
@@ -16,4 +18,17 @@ bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+bool Context::EnqueueCommandBuffer(
+    std::shared_ptr<CommandBuffer> command_buffer) const {
+  return command_buffer && command_buffer->SubmitCommands();
+}
+
+bool Context::FlushCommandBuffers() const {
+  return true;
+}
+
+std::shared_ptr<GPUTracer> Context::GetGPUTracer() const {
+  return nullptr;
+}
+
 }  // namespace impeller
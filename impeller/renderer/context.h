@@ -21,6 +21,7 @@ class SamplerLibrary;
 class CommandBuffer;
 class PipelineLibrary;
 class Allocator;
+class GPUTracer;
 
 //------------------------------------------------------------------------------
 /// @brief      To do anything rendering related with Impeller, you need a
@@ -155,6 +156,32 @@ class Context {
   ///
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Submits a command buffer that uploads resources, such as
+  ///             decoded images or glyph atlas updates.
+  ///
+  ///             Backends may hold on to the command buffer and submit it
+  ///             together with other uploads in a single submission. Pending
+  ///             uploads are always submitted before any command buffer that
+  ///             is submitted later via `CommandBuffer::SubmitCommands`, so
+  ///             work that uses the uploaded resources is ordered after them.
+  ///
+  ///             The command buffer must not be submitted by the caller. By
+  ///             default, it is submitted right away.
+  ///
+  /// @return     If the command buffer was submitted or queued.
+  ///
+  [[nodiscard]] virtual bool EnqueueCommandBuffer(
+      std::shared_ptr<CommandBuffer> command_buffer) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the command buffers queued by `EnqueueCommandBuffer`
+  ///             that haven't been submitted yet.
+  ///
+  /// @return     If all pending command buffers were submitted.
+  ///
+  virtual bool FlushCommandBuffers() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -170,17 +197,47 @@ class Context {
   ///             backends.
   virtual void SetSyncPresentation(bool value) {}
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the tracer that measures the GPU time of each
+  ///             frame.
+  ///
+  /// @return     The tracer, or nullptr if the backend or the device cannot
+  ///             measure GPU time.
+  ///
+  virtual std::shared_ptr<GPUTracer> GetGPUTracer() const;
+
   //----------------------------------------------------------------------------
   /// @brief Accessor for a pool of HostBuffers.
   Pool<HostBuffer>& GetHostBufferPool() const { return host_buffer_pool_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the ring of mapped device buffers that the
+  ///             transients buffers of render passes write into.
+  ///
+  /// @return     The ring, or nullptr if transients buffers are copied to a
+  ///             device buffer when their render pass is encoded.
+  ///
+  const std::shared_ptr<DeviceBufferRing>& GetTransientsBufferRing() const {
+    return transients_buffer_ring_;
+  }
+
   CaptureContext capture;
 
  protected:
   Context();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends whose command buffers keep the device
+  ///             buffers they bind alive until the GPU has finished with them
+  ///             to stop copying the transients buffers of render passes.
+  ///
+  void SetTransientsBufferRing(std::shared_ptr<DeviceBufferRing> ring) {
+    transients_buffer_ring_ = std::move(ring);
+  }
+
  private:
   mutable Pool<HostBuffer> host_buffer_pool_ = Pool<HostBuffer>(1'000'000);
+  std::shared_ptr<DeviceBufferRing> transients_buffer_ring_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Context);
 };
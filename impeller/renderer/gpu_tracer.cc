@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/gpu_tracer.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+GPUTracer::GPUTracer() = default;
+
+GPUTracer::~GPUTracer() = default;
+
+void GPUTracer::MarkFrameStart() {
+  std::scoped_lock lock(mutex_);
+  if (frame_thread_.has_value()) {
+    // The last frame never ended, so its command buffers can't be told apart
+    // from those of this one.
+    frames_.pop_back();
+  }
+  frames_.push_back({.id = next_frame_id_++});
+  frame_thread_ = std::this_thread::get_id();
+  if (frames_.size() > kMaxPendingFrames) {
+    frames_.pop_front();
+  }
+}
+
+void GPUTracer::MarkFrameEnd() {
+  std::vector<fml::TimeDelta> gpu_times;
+  std::shared_ptr<FrameTimeCallback> callback;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!frame_thread_.has_value()) {
+      return;
+    }
+    frames_.back().ended = true;
+    frame_thread_.reset();
+    gpu_times = PopFinishedFrames();
+    callback = callback_;
+  }
+  Report(callback, gpu_times);
+}
+
+void GPUTracer::SetFrameTimeCallback(FrameTimeCallback callback) {
+  std::scoped_lock lock(mutex_);
+  callback_ = callback
+                  ? std::make_shared<FrameTimeCallback>(std::move(callback))
+                  : nullptr;
+}
+
+std::optional<uint64_t> GPUTracer::AddCommandBuffer() {
+  std::scoped_lock lock(mutex_);
+  if (frame_thread_ != std::this_thread::get_id()) {
+    return std::nullopt;
+  }
+  FrameState& frame = frames_.back();
+  frame.pending_count++;
+  return frame.id;
+}
+
+void GPUTracer::CompleteCommandBuffer(uint64_t frame_id,
+                                      std::optional<TimeRange> range) {
+  std::vector<fml::TimeDelta> gpu_times;
+  std::shared_ptr<FrameTimeCallback> callback;
+  {
+    std::scoped_lock lock(mutex_);
+    auto frame = std::find_if(
+        frames_.begin(), frames_.end(),
+        [frame_id](const FrameState& state) { return state.id == frame_id; });
+    if (frame == frames_.end()) {
+      // The frame was dropped.
+      return;
+    }
+    frame->pending_count--;
+    if (range.has_value()) {
+      if (frame->range.has_value()) {
+        frame->range->start_nanos =
+            std::min(frame->range->start_nanos, range->start_nanos);
+        frame->range->end_nanos =
+            std::max(frame->range->end_nanos, range->end_nanos);
+      } else {
+        frame->range = range;
+      }
+    }
+    gpu_times = PopFinishedFrames();
+    callback = callback_;
+  }
+  Report(callback, gpu_times);
+}
+
+std::vector<fml::TimeDelta> GPUTracer::PopFinishedFrames() {
+  std::vector<fml::TimeDelta> gpu_times;
+  while (!frames_.empty() && frames_.front().ended &&
+         frames_.front().pending_count == 0) {
+    const FrameState& frame = frames_.front();
+    if (frame.range.has_value()) {
+      gpu_times.push_back(fml::TimeDelta::FromNanoseconds(std::max<int64_t>(
+          frame.range->end_nanos - frame.range->start_nanos, 0)));
+    }
+    frames_.pop_front();
+  }
+  return gpu_times;
+}
+
+void GPUTracer::Report(const std::shared_ptr<FrameTimeCallback>& callback,
+                       const std::vector<fml::TimeDelta>& gpu_times) {
+  if (!callback) {
+    return;
+  }
+  for (const auto& gpu_time : gpu_times) {
+    (*callback)(gpu_time);
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Measures the time the GPU spends on the command buffers of each
+///             frame, from the start of the first to the end of the last.
+///
+///             The frame is delimited on the thread that renders it with
+///             |MarkFrameStart| and |MarkFrameEnd|. Only the command buffers
+///             that backends add on that thread in between count towards the
+///             frame. Their GPU times come back asynchronously, and once the
+///             frame has ended and all of them are known, the frame's GPU
+///             time is reported to the frame time callback. That callback
+///             may be invoked on any thread.
+///
+class GPUTracer : public std::enable_shared_from_this<GPUTracer> {
+ public:
+  using FrameTimeCallback = std::function<void(fml::TimeDelta gpu_time)>;
+
+  /// The span of time that the GPU spent on a command buffer, in
+  /// nanoseconds on a clock of the backend's choosing that is the same for
+  /// all of the command buffers.
+  struct TimeRange {
+    int64_t start_nanos = 0;
+    int64_t end_nanos = 0;
+  };
+
+  /// Frames that are still waiting for their command buffers when this many
+  /// more frames have started are dropped.
+  static constexpr size_t kMaxPendingFrames = 8;
+
+  GPUTracer();
+
+  virtual ~GPUTracer();
+
+  virtual void MarkFrameStart();
+
+  virtual void MarkFrameEnd();
+
+  void SetFrameTimeCallback(FrameTimeCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a command buffer to the current frame.
+  ///
+  /// @return     The frame that the command buffer was added to, or
+  ///             std::nullopt if there is no frame in progress on the thread.
+  ///             If a frame is returned, |CompleteCommandBuffer| must be
+  ///             called for it exactly once.
+  ///
+  std::optional<uint64_t> AddCommandBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the GPU time of a command buffer returned by
+  ///             |AddCommandBuffer|. This may be called on any thread.
+  ///
+  /// @param[in]  frame_id  The frame that the command buffer was added to.
+  /// @param[in]  range     The time the GPU spent on the command buffer, or
+  ///                       std::nullopt if it could not be measured or the
+  ///                       command buffer was never submitted.
+  ///
+  void CompleteCommandBuffer(uint64_t frame_id,
+                             std::optional<TimeRange> range);
+
+ private:
+  struct FrameState {
+    uint64_t id = 0;
+    size_t pending_count = 0;
+    bool ended = false;
+    std::optional<TimeRange> range;
+  };
+
+  // Removes the frames that are done from the front of |frames_|, and
+  // returns the GPU times of those that were measured.
+  std::vector<fml::TimeDelta> PopFinishedFrames();
+
+  // Reports |gpu_times| to the callback. Called without holding |mutex_|.
+  static void Report(const std::shared_ptr<FrameTimeCallback>& callback,
+                     const std::vector<fml::TimeDelta>& gpu_times);
+
+  std::mutex mutex_;
+  std::deque<FrameState> frames_;
+  uint64_t next_frame_id_ = 0;
+  std::optional<std::thread::id> frame_thread_;
+  std::shared_ptr<FrameTimeCallback> callback_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracer);
+};
+
+}  // namespace impeller
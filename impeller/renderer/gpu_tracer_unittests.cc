@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+class GPUTracerTest : public ::testing::Test {
+ protected:
+  GPUTracerTest() : tracer_(std::make_shared<GPUTracer>()) {
+    tracer_->SetFrameTimeCallback([this](fml::TimeDelta gpu_time) {
+      gpu_times_.push_back(gpu_time.ToMicroseconds());
+    });
+  }
+
+  std::shared_ptr<GPUTracer> tracer_;
+  std::vector<int64_t> gpu_times_;
+};
+
+GPUTracer::TimeRange MakeRange(int64_t start_micros, int64_t end_micros) {
+  return {.start_nanos = start_micros * 1000, .end_nanos = end_micros * 1000};
+}
+}  // namespace
+
+TEST_F(GPUTracerTest, ReportsTheSpanOfTheCommandBuffersOfAFrame) {
+  tracer_->MarkFrameStart();
+  auto first = tracer_->AddCommandBuffer();
+  auto second = tracer_->AddCommandBuffer();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first, second);
+  tracer_->CompleteCommandBuffer(*first, MakeRange(100, 300));
+  tracer_->MarkFrameEnd();
+  EXPECT_TRUE(gpu_times_.empty());
+
+  tracer_->CompleteCommandBuffer(*second, MakeRange(250, 1100));
+  EXPECT_EQ(gpu_times_, std::vector<int64_t>{1000});
+}
+
+TEST_F(GPUTracerTest, OnlyCountsCommandBuffersOfTheFrameThread) {
+  EXPECT_FALSE(tracer_->AddCommandBuffer().has_value());
+
+  tracer_->MarkFrameStart();
+  std::optional<uint64_t> other_thread_frame = 0;
+  std::thread([&]() {
+    other_thread_frame = tracer_->AddCommandBuffer();
+  }).join();
+  EXPECT_FALSE(other_thread_frame.has_value());
+
+  auto frame = tracer_->AddCommandBuffer();
+  ASSERT_TRUE(frame.has_value());
+  tracer_->CompleteCommandBuffer(*frame, MakeRange(0, 5));
+  tracer_->MarkFrameEnd();
+  EXPECT_EQ(gpu_times_, std::vector<int64_t>{5});
+
+  EXPECT_FALSE(tracer_->AddCommandBuffer().has_value());
+}
+
+TEST_F(GPUTracerTest, FramesAreReportedInOrder) {
+  tracer_->MarkFrameStart();
+  auto first = tracer_->AddCommandBuffer();
+  tracer_->MarkFrameEnd();
+  tracer_->MarkFrameStart();
+  auto second = tracer_->AddCommandBuffer();
+  tracer_->MarkFrameEnd();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_NE(first, second);
+
+  tracer_->CompleteCommandBuffer(*second, MakeRange(20, 40));
+  EXPECT_TRUE(gpu_times_.empty());
+  tracer_->CompleteCommandBuffer(*first, MakeRange(0, 10));
+  EXPECT_EQ(gpu_times_, (std::vector<int64_t>{10, 20}));
+}
+
+TEST_F(GPUTracerTest, UnmeasuredFramesAreNotReported) {
+  tracer_->MarkFrameStart();
+  tracer_->MarkFrameEnd();
+
+  tracer_->MarkFrameStart();
+  auto frame = tracer_->AddCommandBuffer();
+  ASSERT_TRUE(frame.has_value());
+  tracer_->MarkFrameEnd();
+  tracer_->CompleteCommandBuffer(*frame, std::nullopt);
+  EXPECT_TRUE(gpu_times_.empty());
+}
+
+TEST_F(GPUTracerTest, StalledFramesAreDropped) {
+  tracer_->MarkFrameStart();
+  auto stalled = tracer_->AddCommandBuffer();
+  tracer_->MarkFrameEnd();
+  ASSERT_TRUE(stalled.has_value());
+
+  for (size_t i = 0; i < GPUTracer::kMaxPendingFrames; i++) {
+    tracer_->MarkFrameStart();
+    auto frame = tracer_->AddCommandBuffer();
+    ASSERT_TRUE(frame.has_value());
+    tracer_->CompleteCommandBuffer(*frame, MakeRange(0, 1));
+    tracer_->MarkFrameEnd();
+  }
+  // The stalled frame was dropped once it held back too many frames.
+  EXPECT_EQ(gpu_times_.size(), GPUTracer::kMaxPendingFrames);
+
+  tracer_->CompleteCommandBuffer(*stalled, MakeRange(0, 1));
+  EXPECT_EQ(gpu_times_.size(), GPUTracer::kMaxPendingFrames);
+}
+
+}  // namespace testing
+}  // namespace impeller
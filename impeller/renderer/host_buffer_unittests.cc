@@ -2,12 +2,67 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_ring.h"
 #include "impeller/core/host_buffer.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+class MappedDeviceBuffer : public DeviceBuffer {
+ public:
+  explicit MappedDeviceBuffer(const DeviceBufferDescriptor& desc, bool mapped)
+      : DeviceBuffer(desc), contents_(mapped ? desc.size : 0u) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return contents_.empty() ? nullptr : contents_.data();
+  }
+
+ private:
+  mutable std::vector<uint8_t> contents_;
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    return false;
+  }
+};
+
+class MappedAllocator : public Allocator {
+ public:
+  explicit MappedAllocator(bool mapped = true) : mapped_(mapped) {}
+
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+  size_t created_buffers = 0u;
+
+ private:
+  const bool mapped_;
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    created_buffers++;
+    return std::make_shared<MappedDeviceBuffer>(desc, mapped_);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+}  // namespace
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +130,74 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, EmplacesIntoTheBlocksOfADeviceBufferRing) {
+  auto allocator = std::make_shared<MappedAllocator>();
+  auto ring = DeviceBufferRing::Create(allocator, 64u);
+  ASSERT_TRUE(ring);
+
+  auto buffer = HostBuffer::Create();
+  buffer->SetDeviceBufferRing(ring);
+
+  struct alignas(16) Align16 {
+    uint8_t pad[16];
+  };
+  auto first = buffer->Emplace(uint32_t{42});
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first.range, Range(0u, 4u));
+  EXPECT_EQ(*reinterpret_cast<uint32_t*>(first.contents), 42u);
+  // The data is not accumulated in host memory.
+  EXPECT_EQ(buffer->GetLength(), 0u);
+
+  auto second = buffer->Emplace(Align16{});
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second.range, Range(16u, 16u));
+  EXPECT_EQ(first.buffer, second.buffer);
+
+  auto device_buffer = second.buffer->GetDeviceBuffer(*allocator);
+  EXPECT_EQ(device_buffer, buffer->GetDeviceBlocks()[0]);
+
+  // Data that doesn't fit in the rest of the block starts a new one.
+  auto third = buffer->Emplace(nullptr, 48u, 16u);
+  ASSERT_TRUE(third);
+  EXPECT_EQ(third.range, Range(0u, 48u));
+  EXPECT_NE(third.buffer, second.buffer);
+  EXPECT_EQ(buffer->GetDeviceBlocks().size(), 2u);
+}
+
+TEST(HostBufferTest, DeviceBlocksAreReusedOnceNothingReferencesThem) {
+  auto allocator = std::make_shared<MappedAllocator>();
+  auto ring = DeviceBufferRing::Create(allocator, 64u);
+  ASSERT_TRUE(ring);
+  EXPECT_EQ(allocator->created_buffers, 1u);
+
+  auto buffer = HostBuffer::Create();
+  buffer->SetDeviceBufferRing(ring);
+  auto in_flight = buffer->Emplace(uint32_t{1});
+  ASSERT_TRUE(in_flight);
+  EXPECT_EQ(allocator->created_buffers, 1u);
+  buffer->Reset();
+  EXPECT_EQ(ring->GetReleasedBlockCount(), 1u);
+
+  // The view stands in for a command buffer the GPU hasn't finished.
+  auto next = buffer->Emplace(uint32_t{2});
+  ASSERT_TRUE(next);
+  EXPECT_EQ(allocator->created_buffers, 2u);
+  EXPECT_NE(next.buffer, in_flight.buffer);
+  buffer->Reset();
+
+  const Buffer* block = in_flight.buffer.get();
+  in_flight = {};
+  next = {};
+  auto reused = buffer->Emplace(uint32_t{3});
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(allocator->created_buffers, 2u);
+  EXPECT_EQ(reused.buffer.get(), block);
+}
+
+TEST(HostBufferTest, DeviceBufferRingRequiresMappedBuffers) {
+  EXPECT_FALSE(DeviceBufferRing::Create(
+      std::make_shared<MappedAllocator>(/*mapped=*/false)));
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <future>
 
 #include "compute_pipeline_descriptor.h"
@@ -24,8 +26,18 @@ template <typename T>
 struct PipelineFuture {
   std::optional<T> descriptor;
   std::shared_future<std::shared_ptr<Pipeline<T>>> future;
-
-  const std::shared_ptr<Pipeline<T>> Get() const { return future.get(); }
+  /// Completes the pipeline on the calling thread, for backends that finish
+  /// pipelines in the background but can also finish them on demand. Called
+  /// before blocking on |future|. May be null.
+  std::function<void()> finish_now;
+
+  const std::shared_ptr<Pipeline<T>> Get() const {
+    if (finish_now && future.wait_for(std::chrono::seconds(0)) !=
+                          std::future_status::ready) {
+      finish_now();
+    }
+    return future.get();
+  }
 
   bool IsValid() const { return future.valid(); }
 };
@@ -118,6 +130,15 @@ class RenderPipelineT {
     return pipeline_future_.descriptor;
   }
 
+  //----------------------------------------------------------------------------
+  /// @return     Whether `WaitAndGet` would return without blocking.
+  ///
+  bool IsReady() const {
+    return did_wait_ || !pipeline_future_.IsValid() ||
+           pipeline_future_.future.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+  }
+
  private:
   PipelineFuture<PipelineDescriptor> pipeline_future_;
   std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline_;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/pipeline_descriptor.h"
 
+#include "flutter/fml/fast_hash.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/shader_function.h"
 #include "impeller/renderer/shader_library.h"
@@ -17,32 +18,30 @@ PipelineDescriptor::~PipelineDescriptor() = default;
 
 // Comparable<PipelineDescriptor>
 std::size_t PipelineDescriptor::GetHash() const {
-  auto seed = fml::HashCombine();
-  fml::HashCombineSeed(seed, label_);
-  fml::HashCombineSeed(seed, sample_count_);
+  fml::FastHasher hasher;
+  hasher.AddBytes(label_);
+  hasher.Add(sample_count_);
   for (const auto& entry : entrypoints_) {
-    fml::HashCombineSeed(seed, entry.first);
+    hasher.Add(entry.first);
     if (auto second = entry.second) {
-      fml::HashCombineSeed(seed, second->GetHash());
+      hasher.Add(second->GetHash());
     }
   }
   for (const auto& des : color_attachment_descriptors_) {
-    fml::HashCombineSeed(seed, des.first);
-    fml::HashCombineSeed(seed, des.second.Hash());
+    hasher.Add(des.first, des.second.Hash());
   }
   if (vertex_descriptor_) {
-    fml::HashCombineSeed(seed, vertex_descriptor_->GetHash());
+    hasher.Add(vertex_descriptor_->GetHash());
   }
-  fml::HashCombineSeed(seed, depth_pixel_format_);
-  fml::HashCombineSeed(seed, stencil_pixel_format_);
-  fml::HashCombineSeed(seed, depth_attachment_descriptor_);
-  fml::HashCombineSeed(seed, front_stencil_attachment_descriptor_);
-  fml::HashCombineSeed(seed, back_stencil_attachment_descriptor_);
-  fml::HashCombineSeed(seed, winding_order_);
-  fml::HashCombineSeed(seed, cull_mode_);
-  fml::HashCombineSeed(seed, primitive_type_);
-  fml::HashCombineSeed(seed, polygon_mode_);
-  return seed;
+  hasher.Add(depth_pixel_format_, stencil_pixel_format_);
+  hasher.Add(depth_attachment_descriptor_);
+  hasher.Add(front_stencil_attachment_descriptor_);
+  hasher.Add(back_stencil_attachment_descriptor_);
+  hasher.Add(winding_order_, cull_mode_, primitive_type_, polygon_mode_);
+  for (const auto& value : specialization_constants_) {
+    hasher.Add(value);
+  }
+  return hasher.GetHash();
 }
 
 // Comparable<PipelineDescriptor>
@@ -61,7 +60,8 @@ bool PipelineDescriptor::IsEqual(const PipelineDescriptor& other) const {
          winding_order_ == other.winding_order_ &&
          cull_mode_ == other.cull_mode_ &&
          primitive_type_ == other.primitive_type_ &&
-         polygon_mode_ == other.polygon_mode_;
+         polygon_mode_ == other.polygon_mode_ &&
+         specialization_constants_ == other.specialization_constants_;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetLabel(std::string label) {
@@ -277,4 +277,14 @@ PolygonMode PipelineDescriptor::GetPolygonMode() const {
   return polygon_mode_;
 }
 
+void PipelineDescriptor::SetSpecializationConstants(
+    std::vector<Scalar> values) {
+  specialization_constants_ = std::move(values);
+}
+
+const std::vector<Scalar>& PipelineDescriptor::GetSpecializationConstants()
+    const {
+  return specialization_constants_;
+}
+
 }  // namespace impeller
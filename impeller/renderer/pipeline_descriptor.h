@@ -12,12 +12,14 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/shader_types.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -131,6 +133,18 @@ class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
 
   PolygonMode GetPolygonMode() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the values of the specialization constants of the
+  ///             pipeline's shaders. The value at an index specializes the
+  ///             constant with that `constant_id`. The reflected shader struct
+  ///             names these indices `kSpecializationConstant<Name>`.
+  ///
+  ///             Constants without a value keep the default from the shader.
+  ///
+  void SetSpecializationConstants(std::vector<Scalar> values);
+
+  const std::vector<Scalar>& GetSpecializationConstants() const;
+
  private:
   std::string label_;
   SampleCount sample_count_ = SampleCount::kCount1;
@@ -149,6 +163,7 @@ class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
       back_stencil_attachment_descriptor_;
   PrimitiveType primitive_type_ = PrimitiveType::kTriangle;
   PolygonMode polygon_mode_ = PolygonMode::kFill;
+  std::vector<Scalar> specialization_constants_;
 };
 
 }  // namespace impeller
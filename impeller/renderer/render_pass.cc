@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "flutter/fml/trace_counters.h"
+
 namespace impeller {
 
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
@@ -14,6 +16,8 @@ RenderPass::RenderPass(std::weak_ptr<const Context> context,
   auto strong_context = context_.lock();
   FML_DCHECK(strong_context);
   transients_buffer_ = strong_context->GetHostBufferPool().Grab();
+  transients_buffer_->SetDeviceBufferRing(
+      strong_context->GetTransientsBufferRing());
 }
 
 RenderPass::~RenderPass() {
@@ -70,16 +74,29 @@ bool RenderPass::AddCommand(Command&& command) {
     return true;
   }
 
+  if (command_depth_.has_value()) {
+    auto viewport = command.viewport.value_or(
+        Viewport{.rect = Rect::MakeSize(render_target_.GetRenderTargetSize())});
+    viewport.depth_range = DepthRange{.z_near = command_depth_.value(),
+                                      .z_far = command_depth_.value()};
+    command.viewport = viewport;
+  }
+
   commands_.emplace_back(std::move(command));
   return true;
 }
 
+void RenderPass::SetCommandDepth(std::optional<Scalar> depth) {
+  command_depth_ = depth;
+}
+
 bool RenderPass::EncodeCommands() const {
   auto context = context_.lock();
   // The context could have been collected in the meantime.
   if (!context) {
     return false;
   }
+  FML_PERFORMANCE_COUNTER_ADD("drawCalls", commands_.size());
   return OnEncodeCommands(*context);
 }
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "impeller/renderer/command.h"
@@ -49,6 +50,18 @@ class RenderPass {
   ///
   bool AddCommand(Command&& command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the depth that the commands recorded from now on are
+  ///             rasterized at, whatever the depth of their vertices is. This
+  ///             is done by collapsing the depth range of their viewport to
+  ///             `depth`, which lets 2D content be depth tested without
+  ///             changing any of its transforms. When unset, which is the
+  ///             default, the viewports of commands are left as they are.
+  ///
+  /// @param[in]  depth  The depth, between 0 and 1.
+  ///
+  void SetCommandDepth(std::optional<Scalar> depth);
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -69,6 +82,7 @@ class RenderPass {
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
   std::vector<Command> commands_;
+  std::optional<Scalar> command_depth_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
@@ -22,6 +22,10 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+const std::shared_ptr<Allocator>& RenderTargetAllocator::GetAllocator() const {
+  return allocator_;
+}
+
 std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
     const TextureDescriptor& desc) {
   return allocator_->CreateTexture(desc);
@@ -377,6 +381,46 @@ void RenderTarget::SetupStencilAttachment(
   SetStencilAttachment(std::move(stencil0));
 }
 
+void RenderTarget::SetupDepthStencilAttachments(
+    const Context& context,
+    RenderTargetAllocator& allocator,
+    ISize size,
+    bool msaa,
+    const std::string& label,
+    AttachmentConfig depth_stencil_config) {
+  TextureDescriptor depth_stencil_tex0;
+  depth_stencil_tex0.storage_mode = depth_stencil_config.storage_mode;
+  if (msaa) {
+    depth_stencil_tex0.type = TextureType::kTexture2DMultisample;
+    depth_stencil_tex0.sample_count = SampleCount::kCount4;
+  }
+  depth_stencil_tex0.format =
+      context.GetCapabilities()->GetDefaultDepthStencilFormat();
+  depth_stencil_tex0.size = size;
+  depth_stencil_tex0.usage =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+
+  auto texture = allocator.CreateTexture(depth_stencil_tex0);
+  if (!texture) {
+    return;  // Error messages are handled by `Allocator::CreateTexture`.
+  }
+  texture->SetLabel(SPrintF("%s Depth Stencil Texture", label.c_str()));
+
+  DepthAttachment depth0;
+  depth0.load_action = depth_stencil_config.load_action;
+  depth0.store_action = depth_stencil_config.store_action;
+  depth0.clear_depth = 0.0;
+  depth0.texture = texture;
+  SetDepthAttachment(std::move(depth0));
+
+  StencilAttachment stencil0;
+  stencil0.load_action = depth_stencil_config.load_action;
+  stencil0.store_action = depth_stencil_config.store_action;
+  stencil0.clear_stencil = 0u;
+  stencil0.texture = std::move(texture);
+  SetStencilAttachment(std::move(stencil0));
+}
+
 size_t RenderTarget::GetTotalAttachmentCount() const {
   size_t count = 0u;
   for (const auto& [_, color] : colors_) {
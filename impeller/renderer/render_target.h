@@ -41,6 +41,9 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+ protected:
+  const std::shared_ptr<Allocator>& GetAllocator() const;
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
@@ -114,6 +117,19 @@ class RenderTarget final {
                               AttachmentConfig stencil_attachment_config =
                                   kDefaultStencilAttachmentConfig);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Like `SetupStencilAttachment`, but creates a texture of the
+  ///             default depth stencil format and attaches it as both the depth
+  ///             and the stencil attachment. The depth is cleared to zero.
+  ///
+  void SetupDepthStencilAttachments(const Context& context,
+                                    RenderTargetAllocator& allocator,
+                                    ISize size,
+                                    bool msaa,
+                                    const std::string& label = "Offscreen",
+                                    AttachmentConfig depth_stencil_config =
+                                        kDefaultStencilAttachmentConfig);
+
   SampleCount GetSampleCount() const;
 
   bool HasColorAttachment(size_t index) const;
@@ -4,10 +4,32 @@
 
 #include "impeller/renderer/sampler_library.h"
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 SamplerLibrary::SamplerLibrary() = default;
 
 SamplerLibrary::~SamplerLibrary() = default;
 
+size_t SamplerLibrary::GetSamplerIndex(const SamplerDescriptor& descriptor) {
+  size_t index = static_cast<size_t>(descriptor.min_filter);
+  index = index * 2u + static_cast<size_t>(descriptor.mag_filter);
+  index = index * 2u + static_cast<size_t>(descriptor.mip_filter);
+  index = index * 4u + static_cast<size_t>(descriptor.width_address_mode);
+  index = index * 4u + static_cast<size_t>(descriptor.height_address_mode);
+  index = index * 4u + static_cast<size_t>(descriptor.depth_address_mode);
+  FML_DCHECK(index < kSamplerCount);
+  return index;
+}
+
+std::shared_ptr<const Sampler> SamplerLibrary::GetSampler(
+    const SamplerDescriptor& descriptor) {
+  auto& sampler = samplers_[GetSamplerIndex(descriptor)];
+  if (!sampler) {
+    sampler = CreateSampler(descriptor);
+  }
+  return sampler;
+}
+
 }  // namespace impeller
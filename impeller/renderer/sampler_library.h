@@ -4,7 +4,8 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <memory>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/sampler_descriptor.h"
@@ -15,13 +16,40 @@ class SamplerLibrary {
  public:
   virtual ~SamplerLibrary();
 
-  virtual std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) = 0;
+  //----------------------------------------------------------------------------
+  /// @brief      Get the sampler for the descriptor, creating it the first
+  ///             time it is asked for.
+  ///
+  ///             Samplers are kept in a table with a slot for every possible
+  ///             descriptor, so looking one up doesn't hash or copy the
+  ///             descriptor. The label of the descriptor is only used when the
+  ///             sampler is created.
+  ///
+  std::shared_ptr<const Sampler> GetSampler(
+      const SamplerDescriptor& descriptor);
 
  protected:
   SamplerLibrary();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create the backend sampler for the descriptor. This is only
+  ///             called for descriptors without a sampler yet.
+  ///
+  /// @return     The sampler, or null if it could not be created, in which
+  ///             case it is created again the next time it is asked for.
+  ///
+  virtual std::shared_ptr<const Sampler> CreateSampler(
+      const SamplerDescriptor& descriptor) = 0;
+
  private:
+  // 2 min and mag filters, 2 mip filters and 4 address modes in each of the
+  // three directions.
+  static constexpr size_t kSamplerCount = 2u * 2u * 2u * 4u * 4u * 4u;
+
+  std::array<std::shared_ptr<const Sampler>, kSamplerCount> samplers_;
+
+  static size_t GetSamplerIndex(const SamplerDescriptor& descriptor);
+
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibrary);
 };
 
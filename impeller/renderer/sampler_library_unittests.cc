@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include "impeller/core/sampler.h"
+#include "impeller/renderer/sampler_library.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+class TestSampler final : public Sampler {
+ public:
+  explicit TestSampler(const SamplerDescriptor& desc) : Sampler(desc) {}
+
+  bool IsValid() const override { return true; }
+};
+
+class TestSamplerLibrary final : public SamplerLibrary {
+ public:
+  size_t GetCreatedCount() const { return created_count_; }
+
+ private:
+  size_t created_count_ = 0;
+
+  std::shared_ptr<const Sampler> CreateSampler(
+      const SamplerDescriptor& descriptor) override {
+    created_count_++;
+    return std::make_shared<TestSampler>(descriptor);
+  }
+};
+}  // namespace
+
+TEST(SamplerLibraryTest, SamplersAreCreatedOncePerDescriptor) {
+  TestSamplerLibrary library;
+  SamplerDescriptor desc;
+  auto sampler = library.GetSampler(desc);
+  ASSERT_NE(sampler, nullptr);
+
+  desc.label = "Another Label";
+  EXPECT_EQ(library.GetSampler(desc), sampler);
+  EXPECT_EQ(library.GetCreatedCount(), 1u);
+
+  desc.mag_filter = MinMagFilter::kLinear;
+  EXPECT_NE(library.GetSampler(desc), sampler);
+  EXPECT_EQ(library.GetCreatedCount(), 2u);
+}
+
+TEST(SamplerLibraryTest, EveryDescriptorHasItsOwnSampler) {
+  TestSamplerLibrary library;
+  const MinMagFilter filters[] = {MinMagFilter::kNearest,
+                                  MinMagFilter::kLinear};
+  const MipFilter mip_filters[] = {MipFilter::kNearest, MipFilter::kLinear};
+  const SamplerAddressMode modes[] = {
+      SamplerAddressMode::kClampToEdge, SamplerAddressMode::kRepeat,
+      SamplerAddressMode::kMirror, SamplerAddressMode::kDecal};
+  std::vector<SamplerDescriptor> descriptors;
+  for (auto min_filter : filters) {
+    for (auto mag_filter : filters) {
+      for (auto mip_filter : mip_filters) {
+        for (auto width_mode : modes) {
+          for (auto height_mode : modes) {
+            for (auto depth_mode : modes) {
+              SamplerDescriptor desc;
+              desc.min_filter = min_filter;
+              desc.mag_filter = mag_filter;
+              desc.mip_filter = mip_filter;
+              desc.width_address_mode = width_mode;
+              desc.height_address_mode = height_mode;
+              desc.depth_address_mode = depth_mode;
+              descriptors.push_back(desc);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (const auto& desc : descriptors) {
+    auto sampler = library.GetSampler(desc);
+    ASSERT_NE(sampler, nullptr);
+    EXPECT_TRUE(sampler->GetDescriptor().IsEqual(desc));
+  }
+  EXPECT_EQ(library.GetCreatedCount(), descriptors.size());
+}
+
+}  // namespace testing
+}  // namespace impeller
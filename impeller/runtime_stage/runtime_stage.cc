@@ -72,11 +72,16 @@ RuntimeStage::RuntimeStage(std::shared_ptr<fml::Mapping> payload)
     return;
   }
 
+  if (!runtime_stage->entrypoint() || !runtime_stage->shader()) {
+    return;
+  }
+
   stage_ = ToShaderStage(runtime_stage->stage());
   entrypoint_ = runtime_stage->entrypoint()->str();
 
   auto* uniforms = runtime_stage->uniforms();
   if (uniforms) {
+    uniforms_.reserve(uniforms->size());
     for (auto i = uniforms->begin(), end = uniforms->end(); i != end; i++) {
       RuntimeUniformDescription desc;
       desc.name = i->name()->str();
@@ -90,17 +95,22 @@ RuntimeStage::RuntimeStage(std::shared_ptr<fml::Mapping> payload)
     }
   }
 
+  // The code is not copied out of the payload. The mappings keep the payload
+  // alive instead.
   code_mapping_ = std::make_shared<fml::NonOwnedMapping>(
       runtime_stage->shader()->data(),     //
       runtime_stage->shader()->size(),     //
       [payload = payload_](auto, auto) {}  //
   );
 
-  sksl_mapping_ = std::make_shared<fml::NonOwnedMapping>(
-      runtime_stage->sksl()->data(),       //
-      runtime_stage->sksl()->size(),       //
-      [payload = payload_](auto, auto) {}  //
-  );
+  // Only stages for targets that bundle SkSL have it.
+  if (runtime_stage->sksl()) {
+    sksl_mapping_ = std::make_shared<fml::NonOwnedMapping>(
+        runtime_stage->sksl()->data(),       //
+        runtime_stage->sksl()->size(),       //
+        [payload = payload_](auto, auto) {}  //
+    );
+  }
 
   is_valid_ = true;
 }
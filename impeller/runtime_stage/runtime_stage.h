@@ -34,6 +34,7 @@ class RuntimeStage {
 
   const std::shared_ptr<fml::Mapping>& GetCodeMapping() const;
 
+  /// @brief  The SkSL of the stage, or null if it wasn't compiled to SkSL.
   const std::shared_ptr<fml::Mapping>& GetSkSLMapping() const;
 
   bool IsDirty() const;
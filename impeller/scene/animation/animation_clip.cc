@@ -113,13 +113,19 @@ void AnimationClip::Advance(SecondsF delta_time) {
 void AnimationClip::ApplyToBindings(
     std::unordered_map<Node*, AnimationTransforms>& transform_decomps,
     Scalar weight_multiplier) const {
+  const Scalar weight = weight_ * weight_multiplier;
+  if (weight <= 0) {
+    // Clips without any weight leave the pose unchanged. Players commonly keep
+    // many of them around to blend in later.
+    return;
+  }
   for (auto& binding : bindings_) {
     auto transforms = transform_decomps.find(binding.node);
     if (transforms == transform_decomps.end()) {
       continue;
     }
     binding.channel.resolver->Apply(transforms->second, playback_time_,
-                                    weight_ * weight_multiplier);
+                                    weight);
   }
 }
 
@@ -71,6 +71,12 @@ class TimelineResolver : public PropertyResolver {
   TimelineKey GetTimelineKey(SecondsF time);
 
   std::vector<Scalar> times_;
+
+ private:
+  /// The keyframe index found by the last lookup. Playback usually moves
+  /// forward by a fraction of a keyframe per frame, so this is checked before
+  /// searching all of the keyframes.
+  size_t cursor_ = 0;
 };
 
 class TranslationTimelineResolver final : public TimelineResolver {
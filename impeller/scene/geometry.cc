@@ -16,6 +16,7 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
@@ -23,12 +24,43 @@
 namespace impeller {
 namespace scene {
 
+//------------------------------------------------------------------------------
+/// GeometryBounds
+///
+
+bool GeometryBounds::IsOutsideViewVolume(const Matrix& clip_transform) const {
+  // Clip space is -w <= x <= w, -w <= y <= w and 0 <= z <= w. The box is
+  // outside if all of its corners are on the outer side of the same plane.
+  size_t left = 0, right = 0, bottom = 0, top = 0, front = 0, back = 0;
+  for (size_t i = 0; i < 8; i++) {
+    const Vector3 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y,
+                         (i & 4) ? max.z : min.z);
+    const Vector4 clip = clip_transform * Vector4(corner);
+    left += clip.x < -clip.w;
+    right += clip.x > clip.w;
+    bottom += clip.y < -clip.w;
+    top += clip.y > clip.w;
+    front += clip.z < 0;
+    back += clip.z > clip.w;
+  }
+  return left == 8 || right == 8 || bottom == 8 || top == 8 || front == 8 ||
+         back == 8;
+}
+
 //------------------------------------------------------------------------------
 /// Geometry
 ///
 
 Geometry::~Geometry() = default;
 
+void Geometry::SetBounds(std::optional<GeometryBounds> bounds) {
+  bounds_ = bounds;
+}
+
+const std::optional<GeometryBounds>& Geometry::GetBounds() const {
+  return bounds_;
+}
+
 std::shared_ptr<CuboidGeometry> Geometry::MakeCuboid(Vector3 size) {
   auto result = std::make_shared<CuboidGeometry>();
   result->SetSize(size);
@@ -64,6 +96,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<GeometryBounds> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -72,6 +105,15 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      for (const auto* vertex : *vertices) {
+        const auto position = ToVector3(vertex->position());
+        if (!bounds.has_value()) {
+          bounds = GeometryBounds{position, position};
+          continue;
+        }
+        bounds->min = bounds->min.Min(position);
+        bounds->max = bounds->max.Max(position);
+      }
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -79,6 +121,8 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::SkinnedVertex);
       is_skinned = true;
+      // Joints move the vertices away from the bind pose, so skinned
+      // geometry has no bounds and is never culled.
       break;
     }
     case fb::VertexBuffer::NONE:
@@ -116,10 +160,13 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  auto geometry = MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  geometry->SetBounds(bounds);
+  return geometry;
 }
 
-void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
+void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                                size_t joints_offset) {}
 
 //------------------------------------------------------------------------------
 /// CuboidGeometry
@@ -261,13 +308,16 @@ void SkinnedVertexBufferGeometry::BindToCommand(
   info.enable_skinning = joints_texture_ ? 1 : 0;
   info.joint_texture_size =
       joints_texture_ ? joints_texture_->GetSize().width : 1;
+  info.joints_offset = static_cast<Scalar>(joints_offset_);
   SkinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
 // |Geometry|
 void SkinnedVertexBufferGeometry::SetJointsTexture(
-    const std::shared_ptr<Texture>& texture) {
+    const std::shared_ptr<Texture>& texture,
+    size_t joints_offset) {
   joints_texture_ = texture;
+  joints_offset_ = joints_offset;
 }
 }  // namespace scene
 }  // namespace impeller
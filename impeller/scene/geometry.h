@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -24,6 +25,20 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// @brief  An axis-aligned box around the vertices of a geometry, in the
+///         geometry's local space.
+struct GeometryBounds {
+  Vector3 min;
+  Vector3 max;
+
+  /// @brief  Whether the box is entirely outside of the view volume once
+  ///         transformed to clip space by `clip_transform`. This is
+  ///         conservative: boxes that can't cheaply be ruled out, such as
+  ///         ones that straddle a corner of the view volume, are reported as
+  ///         visible.
+  bool IsOutsideViewVolume(const Matrix& clip_transform) const;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -46,7 +61,20 @@ class Geometry {
                              const Matrix& transform,
                              Command& command) const = 0;
 
-  virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+  /// @brief  Sets the joint palette the geometry is skinned with and the index
+  ///         of its first joint in the palette. Skinning is disabled if the
+  ///         texture is null.
+  virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                                size_t joints_offset);
+
+  /// @brief  Sets the bounds of the geometry's vertices. Geometry without
+  ///         bounds is never culled.
+  void SetBounds(std::optional<GeometryBounds> bounds);
+
+  const std::optional<GeometryBounds>& GetBounds() const;
+
+ private:
+  std::optional<GeometryBounds> bounds_;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -122,11 +150,13 @@ class SkinnedVertexBufferGeometry final : public Geometry {
                      Command& command) const override;
 
   // |Geometry|
-  void SetJointsTexture(const std::shared_ptr<Texture>& texture) override;
+  void SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                        size_t joints_offset) override;
 
  private:
   VertexBuffer vertex_buffer_;
   std::shared_ptr<Texture> joints_texture_;
+  size_t joints_offset_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SkinnedVertexBufferGeometry);
 };
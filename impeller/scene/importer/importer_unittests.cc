@@ -2,11 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/importer.h"
+#include "impeller/scene/importer/mesh_optimizer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 
 namespace impeller {
@@ -121,6 +127,88 @@ TEST(ImporterTest, CanParseSkinnedGLTF) {
                       Vector4(0.700151, 0.0989373, -0.0989373, 0.700151));
 }
 
+TEST(ImporterTest, OptimizingMeshPrimitiveMergesVerticesAndNarrowsIndices) {
+  auto mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb");
+
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(*mapping, scene));
+  auto& mesh = *scene.nodes[scene.children[0]]->mesh_primitives[0];
+  auto& vertices = mesh.vertices.AsUnskinnedVertexBuffer()->vertices;
+
+  // Remember the triangles as their vertex positions so that they can be
+  // compared regardless of the vertex order.
+  auto get_triangles = [&]() {
+    std::vector<std::array<Scalar, 9>> triangles;
+    for (uint32_t i = 0; i < mesh.indices->count; i += 3) {
+      std::array<Scalar, 9> triangle;
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        uint32_t index;
+        if (mesh.indices->type == fb::IndexType::k16Bit) {
+          index = reinterpret_cast<const uint16_t*>(
+              mesh.indices->data.data())[i + corner];
+        } else {
+          index = reinterpret_cast<const uint32_t*>(
+              mesh.indices->data.data())[i + corner];
+        }
+        auto position = ToVector3(vertices[index].position());
+        triangle[corner * 3 + 0] = position.x;
+        triangle[corner * 3 + 1] = position.y;
+        triangle[corner * 3 + 2] = position.z;
+      }
+      triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  };
+  auto triangles = get_triangles();
+
+  // Duplicate every vertex and widen the indices.
+  const uint32_t vertex_count = vertices.size();
+  auto copies = vertices;
+  vertices.insert(vertices.end(), copies.begin(), copies.end());
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < mesh.indices->count; i++) {
+    uint16_t index =
+        reinterpret_cast<const uint16_t*>(mesh.indices->data.data())[i];
+    indices.push_back(i % 2 == 0 ? index : index + vertex_count);
+  }
+  mesh.indices->type = fb::IndexType::k32Bit;
+  mesh.indices->data.resize(indices.size() * sizeof(uint32_t));
+  std::memcpy(mesh.indices->data.data(), indices.data(),
+              mesh.indices->data.size());
+
+  ASSERT_TRUE(OptimizeMeshPrimitive(mesh));
+
+  ASSERT_LE(vertices.size(), vertex_count);
+  ASSERT_EQ(mesh.indices->type, fb::IndexType::k16Bit);
+  ASSERT_EQ(mesh.indices->count, 918u);
+  ASSERT_EQ(mesh.indices->data.size(), 918u * sizeof(uint16_t));
+  ASSERT_EQ(get_triangles(), triangles);
+}
+
+TEST(ImporterTest, VertexCacheOptimizationKeepsTriangles) {
+  std::vector<uint32_t> indices = {0, 1, 2, 5, 6, 7, 2, 1, 3,
+                                   6, 5, 4, 3, 1, 4, 4, 5, 3};
+  auto optimized = OptimizeVertexCache(indices, 8);
+  ASSERT_EQ(optimized.size(), indices.size());
+
+  // Triangles may be rotated, but keep their winding.
+  auto normalize = [](const std::vector<uint32_t>& list) {
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < list.size(); i += 3) {
+      std::array<uint32_t, 3> triangle = {list[i], list[i + 1], list[i + 2]};
+      std::rotate(triangle.begin(),
+                  std::min_element(triangle.begin(), triangle.end()),
+                  triangle.end());
+      triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  };
+  ASSERT_EQ(normalize(optimized), normalize(indices));
+}
+
 }  // namespace testing
 }  // namespace importer
 }  // namespace scene
@@ -0,0 +1,317 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/importer/mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// Vertex cache optimization.
+///
+
+// The size of the simulated post-transform cache. Real caches are usually
+// smaller, but the ordering isn't very sensitive to the exact size.
+static constexpr size_t kCacheSize = 32u;
+
+static float ScoreVertex(int cache_position, uint32_t remaining_triangles) {
+  if (remaining_triangles == 0u) {
+    // Nothing left to draw with this vertex.
+    return -1.0f;
+  }
+  float score = 0.0f;
+  if (cache_position >= 0) {
+    if (cache_position < 3) {
+      // The vertices of the last triangle are scored a little lower, so that
+      // the strip doesn't end up going back on itself.
+      score = 0.75f;
+    } else {
+      const float scale = 1.0f / (kCacheSize - 3);
+      score = std::pow(1.0f - (cache_position - 3) * scale, 1.5f);
+    }
+  }
+  // Vertices that are only used by a few more triangles are boosted, so that
+  // they get finished off instead of lingering.
+  score += 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+  return score;
+}
+
+std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices,
+                                          size_t vertex_count) {
+  const size_t triangle_count = indices.size() / 3;
+  if (triangle_count == 0u) {
+    return indices;
+  }
+
+  // The triangles that use each vertex and haven't been emitted yet are kept
+  // in `vertex_triangles[vertex_offsets[v], vertex_offsets[v] + remaining[v])`.
+  std::vector<uint32_t> remaining(vertex_count, 0u);
+  for (auto index : indices) {
+    remaining[index]++;
+  }
+  std::vector<uint32_t> vertex_offsets(vertex_count + 1, 0u);
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    vertex_offsets[vertex + 1] = vertex_offsets[vertex] + remaining[vertex];
+  }
+  std::vector<uint32_t> vertex_triangles(indices.size());
+  {
+    std::vector<uint32_t> fill(vertex_offsets.begin(),
+                               vertex_offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+      vertex_triangles[fill[indices[i]]++] = i / 3;
+    }
+  }
+
+  std::vector<int> cache_position(vertex_count, -1);
+  std::vector<float> vertex_score(vertex_count);
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    vertex_score[vertex] = ScoreVertex(-1, remaining[vertex]);
+  }
+
+  std::vector<float> triangle_score(triangle_count);
+  std::vector<bool> emitted(triangle_count, false);
+  std::optional<size_t> best_triangle;
+  float best_score = -1.0f;
+  for (size_t triangle = 0; triangle < triangle_count; triangle++) {
+    triangle_score[triangle] = vertex_score[indices[triangle * 3]] +
+                               vertex_score[indices[triangle * 3 + 1]] +
+                               vertex_score[indices[triangle * 3 + 2]];
+    if (triangle_score[triangle] > best_score) {
+      best_score = triangle_score[triangle];
+      best_triangle = triangle;
+    }
+  }
+
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+  std::vector<uint32_t> cache;
+  std::vector<uint32_t> next_cache;
+  size_t next_unemitted = 0u;
+  while (result.size() < indices.size()) {
+    if (!best_triangle.has_value()) {
+      // None of the triangles touching the cache are left. Start over with the
+      // next triangle that hasn't been emitted.
+      while (emitted[next_unemitted]) {
+        next_unemitted++;
+      }
+      best_triangle = next_unemitted;
+    }
+
+    const size_t triangle = best_triangle.value();
+    emitted[triangle] = true;
+    next_cache.clear();
+    for (size_t corner = 0; corner < 3; corner++) {
+      const uint32_t vertex = indices[triangle * 3 + corner];
+      result.push_back(vertex);
+
+      auto begin = vertex_triangles.begin() + vertex_offsets[vertex];
+      auto end = begin + remaining[vertex];
+      auto found = std::find(begin, end, triangle);
+      if (found != end) {
+        std::iter_swap(found, end - 1);
+        remaining[vertex]--;
+      }
+
+      if (std::find(next_cache.begin(), next_cache.end(), vertex) ==
+          next_cache.end()) {
+        next_cache.push_back(vertex);
+      }
+    }
+    for (auto vertex : cache) {
+      if (std::find(next_cache.begin(), next_cache.end(), vertex) ==
+          next_cache.end()) {
+        next_cache.push_back(vertex);
+      }
+    }
+
+    // The vertices pushed out of the cache are scored too, since they lost
+    // their cache bonus.
+    for (size_t i = 0; i < next_cache.size(); i++) {
+      const uint32_t vertex = next_cache[i];
+      cache_position[vertex] = i < kCacheSize ? static_cast<int>(i) : -1;
+      vertex_score[vertex] =
+          ScoreVertex(cache_position[vertex], remaining[vertex]);
+    }
+
+    best_triangle = std::nullopt;
+    best_score = -1.0f;
+    for (auto vertex : next_cache) {
+      auto begin = vertex_triangles.begin() + vertex_offsets[vertex];
+      auto end = begin + remaining[vertex];
+      for (auto it = begin; it != end; ++it) {
+        const uint32_t other = *it;
+        triangle_score[other] = vertex_score[indices[other * 3]] +
+                                vertex_score[indices[other * 3 + 1]] +
+                                vertex_score[indices[other * 3 + 2]];
+        if (triangle_score[other] > best_score) {
+          best_score = triangle_score[other];
+          best_triangle = other;
+        }
+      }
+    }
+
+    if (next_cache.size() > kCacheSize) {
+      next_cache.resize(kCacheSize);
+    }
+    std::swap(cache, next_cache);
+  }
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+/// Mesh primitives.
+///
+
+static std::optional<std::vector<uint32_t>> ReadIndices(
+    const fb::IndicesT& indices) {
+  const size_t index_size = indices.type == fb::IndexType::k16Bit
+                                ? sizeof(uint16_t)
+                                : sizeof(uint32_t);
+  if (indices.data.size() < indices.count * index_size) {
+    return std::nullopt;
+  }
+  std::vector<uint32_t> result(indices.count);
+  for (size_t i = 0; i < result.size(); i++) {
+    if (indices.type == fb::IndexType::k16Bit) {
+      uint16_t index;
+      std::memcpy(&index, indices.data.data() + i * index_size, index_size);
+      result[i] = index;
+    } else {
+      std::memcpy(&result[i], indices.data.data() + i * index_size,
+                  index_size);
+    }
+  }
+  return result;
+}
+
+static void WriteIndices(const std::vector<uint32_t>& indices,
+                         size_t vertex_count,
+                         fb::IndicesT& out_indices) {
+  out_indices.count = indices.size();
+  if (vertex_count <= std::numeric_limits<uint16_t>::max() + 1u) {
+    out_indices.type = fb::IndexType::k16Bit;
+    out_indices.data.resize(indices.size() * sizeof(uint16_t));
+    for (size_t i = 0; i < indices.size(); i++) {
+      const uint16_t index = static_cast<uint16_t>(indices[i]);
+      std::memcpy(out_indices.data.data() + i * sizeof(uint16_t), &index,
+                  sizeof(uint16_t));
+    }
+  } else {
+    out_indices.type = fb::IndexType::k32Bit;
+    out_indices.data.resize(indices.size() * sizeof(uint32_t));
+    std::memcpy(out_indices.data.data(), indices.data(),
+                out_indices.data.size());
+  }
+}
+
+// Vertices are plain structs of floats, so they are compared bit for bit.
+template <typename VertexType>
+struct VertexBitsHash {
+  size_t operator()(const VertexType& vertex) const {
+    return std::hash<std::string_view>{}(std::string_view(
+        reinterpret_cast<const char*>(&vertex), sizeof(VertexType)));
+  }
+};
+
+template <typename VertexType>
+struct VertexBitsEqual {
+  bool operator()(const VertexType& a, const VertexType& b) const {
+    return std::memcmp(&a, &b, sizeof(VertexType)) == 0;
+  }
+};
+
+template <typename VertexType>
+static bool OptimizeVertices(std::vector<VertexType>& vertices,
+                             fb::IndicesT& out_indices) {
+  auto indices = ReadIndices(out_indices);
+  if (!indices.has_value()) {
+    std::cerr << "Mesh primitive index buffer is too small. Skipping "
+                 "optimization."
+              << std::endl;
+    return false;
+  }
+  for (auto index : indices.value()) {
+    if (index >= vertices.size()) {
+      std::cerr << "Mesh primitive index is out of range. Skipping "
+                   "optimization."
+                << std::endl;
+      return false;
+    }
+  }
+
+  // Merge identical vertices.
+  std::unordered_map<VertexType, uint32_t, VertexBitsHash<VertexType>,
+                     VertexBitsEqual<VertexType>>
+      unique_indices;
+  unique_indices.reserve(vertices.size());
+  std::vector<uint32_t> remap(vertices.size());
+  std::vector<VertexType> unique_vertices;
+  unique_vertices.reserve(vertices.size());
+  for (size_t i = 0; i < vertices.size(); i++) {
+    auto [it, inserted] =
+        unique_indices.try_emplace(vertices[i], unique_vertices.size());
+    if (inserted) {
+      unique_vertices.push_back(vertices[i]);
+    }
+    remap[i] = it->second;
+  }
+  for (auto& index : indices.value()) {
+    index = remap[index];
+  }
+
+  // Order the triangles for the vertex cache. Only triangle lists can be
+  // reordered.
+  if (indices->size() % 3 == 0) {
+    indices = OptimizeVertexCache(indices.value(), unique_vertices.size());
+  }
+
+  // Store the vertices in the order they are first used so that they are
+  // fetched sequentially. This also drops unused vertices.
+  constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+  std::fill(remap.begin(), remap.end(), kUnused);
+  vertices.clear();
+  for (auto& index : indices.value()) {
+    if (remap[index] == kUnused) {
+      remap[index] = vertices.size();
+      vertices.push_back(unique_vertices[index]);
+    }
+    index = remap[index];
+  }
+
+  WriteIndices(indices.value(), vertices.size(), out_indices);
+  return true;
+}
+
+bool OptimizeMeshPrimitive(fb::MeshPrimitiveT& primitive) {
+  if (!primitive.indices) {
+    return false;
+  }
+  switch (primitive.vertices.type) {
+    case fb::VertexBuffer::UnskinnedVertexBuffer:
+      return OptimizeVertices(
+          primitive.vertices.AsUnskinnedVertexBuffer()->vertices,
+          *primitive.indices);
+    case fb::VertexBuffer::SkinnedVertexBuffer:
+      return OptimizeVertices(
+          primitive.vertices.AsSkinnedVertexBuffer()->vertices,
+          *primitive.indices);
+    default:
+      return false;
+  }
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
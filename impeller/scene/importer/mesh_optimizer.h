@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "impeller/scene/importer/scene_flatbuffers.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// @brief      Reorders the triangles of an indexed triangle list so that
+///             consecutive triangles reuse recently transformed vertices.
+///
+///             This is Tom Forsyth's "Linear-Speed Vertex Cache
+///             Optimisation". The triangles themselves, including their
+///             winding, are unchanged.
+///
+/// @param[in]  indices       The indices of the triangle list. Its size must
+///                           be a multiple of three.
+/// @param[in]  vertex_count  One more than the largest index.
+///
+/// @return     The indices in the new triangle order.
+///
+std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices,
+                                          size_t vertex_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Makes the vertices and indices of a mesh primitive cheaper to
+///             load and draw, without changing what is drawn.
+///
+///             Identical vertices are merged, the triangles are ordered for
+///             the post-transform vertex cache, the vertices are stored in the
+///             order they are first used and unused vertices are dropped.
+///             Indices are stored as 16-bit values whenever there are few
+///             enough vertices.
+///
+///             Primitives with invalid indices are left untouched.
+///
+/// @return     If the primitive was optimized.
+///
+bool OptimizeMeshPrimitive(fb::MeshPrimitiveT& primitive);
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
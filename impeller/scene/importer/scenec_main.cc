@@ -13,6 +13,7 @@
 #include "impeller/base/strings.h"
 #include "impeller/compiler/utilities.h"
 #include "impeller/scene/importer/importer.h"
+#include "impeller/scene/importer/mesh_optimizer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/importer/switches.h"
 #include "impeller/scene/importer/types.h"
@@ -74,6 +75,12 @@ bool Main(const fml::CommandLine& command_line) {
     return false;
   }
 
+  for (auto& node : scene.nodes) {
+    for (auto& mesh_primitive : node->mesh_primitives) {
+      OptimizeMeshPrimitive(*mesh_primitive);
+    }
+  }
+
   flatbuffers::FlatBufferBuilder builder;
   builder.Finish(fb::Scene::Pack(builder, &scene), fb::SceneIdentifier());
 
@@ -54,6 +54,8 @@ class Material {
 
   void SetTranslucent(bool is_translucent);
 
+  bool IsTranslucent() const;
+
   SceneContextOptions GetContextOptions(const RenderPass& pass) const;
 
   virtual MaterialType GetMaterialType() const = 0;
@@ -35,14 +35,14 @@ std::vector<Mesh::Primitive>& Mesh::GetPrimitives() {
 
 bool Mesh::Render(SceneEncoder& encoder,
                   const Matrix& transform,
-                  const std::shared_ptr<Texture>& joints) const {
+                  std::optional<size_t> joints_offset) const {
   for (const auto& mesh : primitives_) {
-    mesh.geometry->SetJointsTexture(joints);
     SceneCommand command = {
         .label = "Mesh Primitive",
         .transform = transform,
         .geometry = mesh.geometry.get(),
         .material = mesh.material.get(),
+        .joints_offset = joints_offset,
     };
     encoder.Add(command);
   }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "flutter/fml/macros.h"
@@ -35,7 +36,7 @@ class Mesh final {
 
   bool Render(SceneEncoder& encoder,
               const Matrix& transform,
-              const std::shared_ptr<Texture>& joints) const;
+              std::optional<size_t> joints_offset) const;
 
  private:
   std::vector<Primitive> primitives_;
@@ -408,7 +408,8 @@ bool Node::Render(SceneEncoder& encoder,
 
   Matrix transform = parent_transform * local_transform_;
   mesh_.Render(encoder, transform,
-               skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
+               skin_ ? std::make_optional(encoder.AddJoints(*skin_))
+                     : std::nullopt);
 
   for (auto& child : children_) {
     if (!child->Render(encoder, allocator, transform)) {
@@ -2,13 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
 #include "flutter/fml/macros.h"
 
 #include "flutter/fml/logging.h"
+#include "impeller/base/allocation.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
 #include "impeller/scene/scene_encoder.h"
+#include "impeller/scene/skin.h"
 
 namespace impeller {
 namespace scene {
@@ -20,9 +27,53 @@ void SceneEncoder::Add(const SceneCommand& command) {
   commands_.push_back(command);
 }
 
+size_t SceneEncoder::AddJoints(const Skin& skin) {
+  return skin.AppendJoints(joints_);
+}
+
+std::shared_ptr<Texture> SceneEncoder::CreateJointsTexture(
+    Allocator& allocator) const {
+  if (joints_.empty()) {
+    return nullptr;
+  }
+
+  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
+  // Therefore, each joint needs 4 pixels.
+  auto required_pixels = joints_.size() * 4;
+  auto dimension_size = std::max(
+      2u,
+      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+  texture_descriptor.size = {dimension_size, dimension_size};
+  texture_descriptor.mip_count = 1u;
+
+  auto result = allocator.CreateTexture(texture_descriptor);
+  if (!result) {
+    FML_LOG(ERROR) << "Could not create joint texture.";
+    return nullptr;
+  }
+  result->SetLabel("Joints Texture");
+
+  std::vector<Matrix> joints;
+  joints.reserve(result->GetSize().Area() / 4);
+  joints.insert(joints.end(), joints_.begin(), joints_.end());
+  joints.resize(result->GetSize().Area() / 4, Matrix());
+  if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
+                           joints.size() * sizeof(Matrix))) {
+    FML_LOG(ERROR) << "Could not set contents of joint texture.";
+    return nullptr;
+  }
+
+  return result;
+}
+
 static void EncodeCommand(const SceneContext& scene_context,
                           const Matrix& view_transform,
                           RenderPass& render_pass,
+                          const std::shared_ptr<Texture>& joints_texture,
                           const SceneCommand& scene_command) {
   auto& host_buffer = render_pass.GetTransientsBuffer();
 
@@ -36,6 +87,12 @@ static void EncodeCommand(const SceneContext& scene_context,
                   scene_command.material->GetMaterialType()},
       scene_command.material->GetContextOptions(render_pass));
 
+  if (scene_command.joints_offset.has_value()) {
+    scene_command.geometry->SetJointsTexture(
+        joints_texture, scene_command.joints_offset.value());
+  } else {
+    scene_command.geometry->SetJointsTexture(nullptr, 0);
+  }
   scene_command.geometry->BindToCommand(
       scene_context, host_buffer, view_transform * scene_command.transform,
       cmd);
@@ -44,6 +101,24 @@ static void EncodeCommand(const SceneContext& scene_context,
   render_pass.AddCommand(std::move(cmd));
 }
 
+// Orders opaque commands so that the ones sharing a pipeline and a material
+// are encoded next to each other. Translucent commands come after all opaque
+// ones, in the order they were added.
+static bool CompareCommands(const SceneCommand* a, const SceneCommand* b) {
+  const bool a_translucent = a->material->IsTranslucent();
+  const bool b_translucent = b->material->IsTranslucent();
+  if (a_translucent || b_translucent) {
+    return !a_translucent && b_translucent;
+  }
+  auto key = [](const SceneCommand* command) {
+    return std::make_tuple(command->geometry->GetGeometryType(),
+                           command->material->GetMaterialType(),
+                           reinterpret_cast<uintptr_t>(command->material),
+                           reinterpret_cast<uintptr_t>(command->geometry));
+  };
+  return key(a) < key(b);
+}
+
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     const SceneContext& scene_context,
     const Matrix& camera_transform,
@@ -90,8 +165,26 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  // Skip the geometry that is entirely outside of the view volume.
+  std::vector<const SceneCommand*> commands;
+  commands.reserve(commands_.size());
+  for (const auto& command : commands_) {
+    const auto& bounds = command.geometry->GetBounds();
+    if (bounds.has_value() &&
+        bounds->IsOutsideViewVolume(camera_transform * command.transform)) {
+      continue;
+    }
+    commands.push_back(&command);
+  }
+  std::stable_sort(commands.begin(), commands.end(), CompareCommands);
+
+  // The joints of every skin are uploaded to a single texture per frame.
+  auto joints_texture = CreateJointsTexture(
+      *scene_context.GetContext()->GetResourceAllocator());
+
+  for (const auto* command : commands) {
+    EncodeCommand(scene_context, camera_transform, *render_pass,
+                  joints_texture, *command);
   }
 
   if (!render_pass->EncodeCommands()) {
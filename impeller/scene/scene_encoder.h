@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -18,18 +19,28 @@ namespace impeller {
 namespace scene {
 
 class Scene;
+class Skin;
 
 struct SceneCommand {
   std::string label;
   Matrix transform;
   Geometry* geometry;
   Material* material;
+  /// The index of the first joint of the skinned geometry in the joint
+  /// palette, if it is skinned.
+  std::optional<size_t> joints_offset;
 };
 
 class SceneEncoder {
  public:
   void Add(const SceneCommand& command);
 
+  /// @brief  Adds the current joints of a skin to the joint palette, which is
+  ///         uploaded once for all of the skins in the scene.
+  ///
+  /// @return The index of the first joint of the skin in the palette.
+  size_t AddJoints(const Skin& skin);
+
  private:
   SceneEncoder();
 
@@ -38,7 +49,10 @@ class SceneEncoder {
       const Matrix& camera_transform,
       RenderTarget render_target) const;
 
+  std::shared_ptr<Texture> CreateJointsTexture(Allocator& allocator) const;
+
   std::vector<SceneCommand> commands_;
+  std::vector<Matrix> joints_;
 
   friend Scene;
 
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <vector>
@@ -11,6 +12,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
+#include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/quaternion.h"
 #include "impeller/geometry/vector.h"
@@ -18,6 +20,7 @@
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_test.h"
 #include "impeller/scene/animation/animation_clip.h"
+#include "impeller/scene/animation/property_resolver.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/geometry.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
@@ -34,6 +37,54 @@ namespace testing {
 using SceneTest = PlaygroundTest;
 INSTANTIATE_PLAYGROUND_SUITE(SceneTest);
 
+TEST(SceneGeometryTest, BoundsOutsideViewVolumeAreCulled) {
+  auto camera = Camera::MakePerspective(Degrees(60), {0, 0, -5})
+                    .LookAt({0, 0, 0}, {0, -1, 0});
+  auto clip_transform = camera.GetTransform(ISize(400, 400));
+  GeometryBounds bounds{Vector3(-1, -1, -1), Vector3(1, 1, 1)};
+
+  // In front of the camera.
+  ASSERT_FALSE(bounds.IsOutsideViewVolume(clip_transform));
+  // Straddling the camera.
+  ASSERT_FALSE(bounds.IsOutsideViewVolume(
+      clip_transform * Matrix::MakeTranslation({0, 0, -5})));
+  // Off to the side.
+  ASSERT_TRUE(bounds.IsOutsideViewVolume(
+      clip_transform * Matrix::MakeTranslation({100, 0, 0})));
+  // Behind the camera.
+  ASSERT_TRUE(bounds.IsOutsideViewVolume(
+      clip_transform * Matrix::MakeTranslation({0, 0, -20})));
+  // Beyond the far plane.
+  ASSERT_TRUE(bounds.IsOutsideViewVolume(
+      clip_transform * Matrix::MakeTranslation({0, 0, 2000})));
+}
+
+TEST(SceneAnimationTest, TimelineSamplesDoNotDependOnSampleOrder) {
+  auto resolver = PropertyResolver::MakeTranslationTimeline(
+      {0, 1, 2, 4}, {Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 2, 0),
+                     Vector3(1, 2, 4)});
+
+  auto sample = [&](Scalar time) {
+    AnimationTransforms transforms;
+    resolver->Apply(transforms, SecondsF(time), 1);
+    return transforms.animated_pose.translation;
+  };
+
+  // Forward, small steps, backward and jumping around.
+  for (Scalar time : {0.0f, 0.5f, 1.0f, 1.25f, 1.5f, 3.0f, 4.0f, 5.0f, 3.0f,
+                      0.5f, 2.0f, 0.25f, -1.0f}) {
+    Vector3 expected;
+    if (time <= 1) {
+      expected = Vector3(std::clamp(time, 0.0f, 1.0f), 0, 0);
+    } else if (time <= 2) {
+      expected = Vector3(1, (time - 1) * 2, 0);
+    } else {
+      expected = Vector3(1, 2, (std::min(time, 4.0f) - 2) * 2);
+    }
+    ASSERT_VECTOR3_NEAR(sample(time), expected);
+  }
+}
+
 TEST_P(SceneTest, CuboidUnlit) {
   auto scene_context = std::make_shared<SceneContext>(GetContext());
 
@@ -6,6 +6,7 @@ uniform FrameInfo {
   mat4 mvp;
   float enable_skinning;
   float joint_texture_size;
+  float joints_offset;
 }
 frame_info;
 
@@ -35,7 +36,10 @@ mat4 GetJoint(float joint_index) {
 
   // Each joint matrix takes up 4 pixels (16 floats), so we jump 4 pixels per
   // joint matrix.
-  float matrix_start = joint_index * kMatrixTexelStride;
+  // The joints of all skins in the scene share one texture, so the joints of
+  // this mesh start at `joints_offset`.
+  float matrix_start =
+      (frame_info.joints_offset + joint_index) * kMatrixTexelStride;
 
   // The texture space coordinates at the start of the matrix.
   float x = mod(matrix_start, frame_info.joint_texture_size);
@@ -4,13 +4,12 @@
 
 #include "impeller/scene/skin.h"
 
-#include <cmath>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
-#include "impeller/core/allocator.h"
 #include "impeller/scene/importer/conversions.h"
 
 namespace impeller {
@@ -62,30 +61,31 @@ Skin::Skin(Skin&&) = default;
 
 Skin& Skin::operator=(Skin&&) = default;
 
-std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
-  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
-  // Therefore, each joint needs 4 pixels.
-  auto required_pixels = joints_.size() * 4;
-  auto dimension_size = std::max(
-      2u,
-      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
-
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
-  texture_descriptor.size = {dimension_size, dimension_size};
-  texture_descriptor.mip_count = 1u;
-
-  auto result = allocator.CreateTexture(texture_descriptor);
-  result->SetLabel("Joints Texture");
-  if (!result) {
-    FML_LOG(ERROR) << "Could not create joint texture.";
-    return nullptr;
+// Computes a model space matrix for the joint by walking up the bones to the
+// skeleton root. The matrices of the joints on the way are memoized, so bones
+// shared by many joints are only multiplied once per frame.
+static Matrix GetJointModelTransform(
+    const Node* joint,
+    std::unordered_map<const Node*, Matrix>& model_transforms) {
+  if (!joint || !joint->IsJoint()) {
+    return Matrix();
+  }
+  if (auto found = model_transforms.find(joint);
+      found != model_transforms.end()) {
+    return found->second;
   }
+  const auto transform =
+      GetJointModelTransform(joint->GetParent(), model_transforms) *
+      joint->GetLocalTransform();
+  model_transforms[joint] = transform;
+  return transform;
+}
 
-  std::vector<Matrix> joints;
-  joints.resize(result->GetSize().Area() / 4, Matrix());
-  FML_DCHECK(joints.size() >= joints_.size());
+size_t Skin::AppendJoints(std::vector<Matrix>& palette) const {
+  const size_t offset = palette.size();
+  palette.resize(offset + joints_.size(), Matrix());
+  std::unordered_map<const Node*, Matrix> model_transforms;
+  model_transforms.reserve(joints_.size());
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -93,12 +93,8 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
+    Matrix& joint_matrix = palette[offset + joint_i];
+    joint_matrix = GetJointModelTransform(joint, model_transforms);
 
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
@@ -107,16 +103,9 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     // the joint's default pose and the joint's current pose in the scene. This
     // is necessary because the skinned model's vertex positions (which _define_
     // the default pose) are all in model space.
-    joints[joint_i] = joints[joint_i] * inverse_bind_matrices_[joint_i];
+    joint_matrix = joint_matrix * inverse_bind_matrices_[joint_i];
   }
-
-  if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
-                           joints.size() * sizeof(Matrix))) {
-    FML_LOG(ERROR) << "Could not set contents of joint texture.";
-    return nullptr;
-  }
-
-  return result;
+  return offset;
 }
 
 }  // namespace scene
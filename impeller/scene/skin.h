@@ -6,11 +6,11 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
-#include "impeller/core/allocator.h"
-#include "impeller/core/texture.h"
+#include "impeller/geometry/matrix.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/node.h"
 
@@ -27,7 +27,11 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
-  std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
+  /// @brief  Appends the current joint matrices of this skin to a joint
+  ///         palette shared by all skins in the scene.
+  ///
+  /// @return The index of the first joint of this skin in the palette.
+  size_t AppendJoints(std::vector<Matrix>& palette) const;
 
  private:
   Skin();
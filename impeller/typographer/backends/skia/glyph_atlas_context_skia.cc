@@ -20,4 +20,33 @@ void GlyphAtlasContextSkia::UpdateBitmap(std::shared_ptr<SkBitmap> bitmap) {
   bitmap_ = std::move(bitmap);
 }
 
+bool GlyphAtlasContextSkia::HasLoadedStoredAtlas() const {
+  return loaded_stored_atlas_;
+}
+
+void GlyphAtlasContextSkia::MarkStoredAtlasLoaded() {
+  loaded_stored_atlas_ = true;
+}
+
+std::vector<GlyphAtlasStoreSkia::StoredFont>&
+GlyphAtlasContextSkia::GetStoredFonts() {
+  return stored_fonts_;
+}
+
+fml::TimePoint GlyphAtlasContextSkia::GetLastStoreTime() const {
+  return last_store_time_;
+}
+
+void GlyphAtlasContextSkia::UpdateLastStoreTime(fml::TimePoint time) {
+  last_store_time_ = time;
+}
+
+bool GlyphAtlasContextSkia::HasPendingStore() const {
+  return pending_store_;
+}
+
+void GlyphAtlasContextSkia::SetPendingStore(bool pending) {
+  pending_store_ = pending;
+}
+
 }  // namespace impeller
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_store_skia.h"
 #include "impeller/typographer/glyph_atlas.h"
 
 class SkBitmap;
@@ -28,8 +32,37 @@ class GlyphAtlasContextSkia
 
   void UpdateBitmap(std::shared_ptr<SkBitmap> bitmap);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the atlas stored by a previous launch was loaded
+  ///             into this context yet, which is only tried once.
+  bool HasLoadedStoredAtlas() const;
+
+  void MarkStoredAtlasLoaded();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The glyphs of the loaded atlas that haven't been drawn yet.
+  ///             They are in the bitmap, but not in the glyph atlas.
+  std::vector<GlyphAtlasStoreSkia::StoredFont>& GetStoredFonts();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The time the atlas was last stored, if ever.
+  fml::TimePoint GetLastStoreTime() const;
+
+  void UpdateLastStoreTime(fml::TimePoint time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether glyphs were added to the atlas since it was last
+  ///             stored.
+  bool HasPendingStore() const;
+
+  void SetPendingStore(bool pending);
+
  private:
   std::shared_ptr<SkBitmap> bitmap_;
+  bool loaded_stored_atlas_ = false;
+  std::vector<GlyphAtlasStoreSkia::StoredFont> stored_fonts_;
+  fml::TimePoint last_store_time_;
+  bool pending_store_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContextSkia);
 };
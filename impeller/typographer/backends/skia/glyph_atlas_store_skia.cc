@@ -0,0 +1,276 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/backends/skia/glyph_atlas_store_skia.h"
+
+#include <cstring>
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/typographer/backends/skia/typeface_skia.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkFontArguments.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkString.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+namespace {
+
+struct GlyphAtlasHeaderSkia {
+  // Bump the version if the layout of the file or the typeface key changes.
+  uint32_t magic = 0x49504741;  // IPGA
+  uint32_t version = 1u;
+  uint32_t type = 0u;
+  uint32_t width = 0u;
+  uint32_t height = 0u;
+  uint32_t row_bytes = 0u;
+  uint64_t glyph_count = 0u;
+};
+
+struct GlyphEntrySkia {
+  uint64_t typeface_key = 0u;
+  float point_size = 0.0f;
+  float skew_x = 0.0f;
+  float scale_x = 0.0f;
+  float scale = 0.0f;
+  uint32_t embolden = 0u;
+  uint16_t glyph_index = 0u;
+  uint8_t glyph_type = 0u;
+  uint8_t reserved = 0u;
+  float bounds[4] = {};
+  float location[4] = {};
+};
+
+}  // namespace
+
+static const char* GetAtlasFileName(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return "flutter.impeller.glyphatlas.alpha";
+    case GlyphAtlas::Type::kColorBitmap:
+      return "flutter.impeller.glyphatlas.color";
+  }
+  FML_UNREACHABLE();
+}
+
+static SkImageInfo GetAtlasImageInfo(GlyphAtlas::Type type,
+                                     int width,
+                                     int height) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return SkImageInfo::MakeA8(width, height);
+    case GlyphAtlas::Type::kColorBitmap:
+      return SkImageInfo::MakeN32Premul(width, height);
+  }
+  FML_UNREACHABLE();
+}
+
+static GlyphEntrySkia MakeGlyphEntry(size_t typeface_key,
+                                     const Font::Metrics& metrics,
+                                     Scalar scale,
+                                     const Glyph& glyph,
+                                     const Rect& location) {
+  GlyphEntrySkia entry;
+  entry.typeface_key = typeface_key;
+  entry.point_size = metrics.point_size;
+  entry.skew_x = metrics.skewX;
+  entry.scale_x = metrics.scaleX;
+  entry.scale = scale;
+  entry.embolden = metrics.embolden ? 1u : 0u;
+  entry.glyph_index = glyph.index;
+  entry.glyph_type = static_cast<uint8_t>(glyph.type);
+  entry.bounds[0] = glyph.bounds.origin.x;
+  entry.bounds[1] = glyph.bounds.origin.y;
+  entry.bounds[2] = glyph.bounds.size.width;
+  entry.bounds[3] = glyph.bounds.size.height;
+  entry.location[0] = location.origin.x;
+  entry.location[1] = location.origin.y;
+  entry.location[2] = location.size.width;
+  entry.location[3] = location.size.height;
+  return entry;
+}
+
+GlyphAtlasStoreSkia::GlyphAtlasStoreSkia(fml::UniqueFD cache_directory)
+    : cache_directory_(std::move(cache_directory)) {}
+
+GlyphAtlasStoreSkia::~GlyphAtlasStoreSkia() = default;
+
+bool GlyphAtlasStoreSkia::IsValid() const {
+  return cache_directory_.is_valid();
+}
+
+size_t GlyphAtlasStoreSkia::GetTypefaceKey(const SkTypeface& typeface) {
+  // The checksum adjustment in the 'head' table is chosen so that the whole
+  // font file sums up to a constant, which makes it a hash of the file.
+  uint8_t checksum_adjustment[4] = {};
+  typeface.getTableData(SkSetFourByteTag('h', 'e', 'a', 'd'), 8u,
+                        sizeof(checksum_adjustment), checksum_adjustment);
+  uint32_t checksum = 0u;
+  std::memcpy(&checksum, checksum_adjustment, sizeof(checksum));
+
+  SkString family_name;
+  typeface.getFamilyName(&family_name);
+  const SkFontStyle style = typeface.fontStyle();
+  size_t key = fml::HashCombine(
+      checksum, typeface.countGlyphs(), typeface.getUnitsPerEm(),
+      std::hash<std::string>{}(family_name.c_str()), style.weight(),
+      style.width(), static_cast<int>(style.slant()));
+
+  // Instances of a variable font share the file but not the glyphs.
+  const int axis_count = typeface.getVariationDesignPosition(nullptr, 0);
+  if (axis_count > 0) {
+    std::vector<SkFontArguments::VariationPosition::Coordinate> coordinates(
+        axis_count);
+    if (typeface.getVariationDesignPosition(coordinates.data(), axis_count) ==
+        axis_count) {
+      for (const auto& coordinate : coordinates) {
+        fml::HashCombineSeed(key, coordinate.axis, coordinate.value);
+      }
+    }
+  }
+  return key;
+}
+
+std::optional<GlyphAtlasStoreSkia::StoredAtlas> GlyphAtlasStoreSkia::Load(
+    GlyphAtlas::Type type) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  TRACE_EVENT0("impeller", "LoadGlyphAtlas");
+
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_directory_,
+                                                  GetAtlasFileName(type));
+  if (!mapping || mapping->GetSize() < sizeof(GlyphAtlasHeaderSkia)) {
+    return std::nullopt;
+  }
+
+  const GlyphAtlasHeaderSkia expected;
+  GlyphAtlasHeaderSkia header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.magic != expected.magic ||                                   //
+      header.version != expected.version ||                               //
+      header.type != static_cast<uint32_t>(type) ||                       //
+      header.width == 0u || header.height == 0u ||                        //
+      header.glyph_count > mapping->GetSize() / sizeof(GlyphEntrySkia)  //
+  ) {
+    return std::nullopt;
+  }
+
+  auto bitmap = std::make_shared<SkBitmap>();
+  if (!bitmap->tryAllocPixels(
+          GetAtlasImageInfo(type, header.width, header.height)) ||
+      bitmap->rowBytes() != header.row_bytes) {
+    return std::nullopt;
+  }
+  const size_t entries_size = header.glyph_count * sizeof(GlyphEntrySkia);
+  const size_t pixels_size = bitmap->computeByteSize();
+  // A file that was cut short is discarded too.
+  if (mapping->GetSize() != sizeof(header) + entries_size + pixels_size) {
+    return std::nullopt;
+  }
+
+  const uint8_t* entries = mapping->GetMapping() + sizeof(header);
+  const Rect atlas_rect = Rect::MakeSize(ISize(header.width, header.height));
+  StoredAtlas atlas;
+  for (size_t i = 0; i < header.glyph_count; i++) {
+    GlyphEntrySkia entry;
+    std::memcpy(&entry, entries + i * sizeof(entry), sizeof(entry));
+    if (entry.glyph_type > static_cast<uint8_t>(Glyph::Type::kBitmap)) {
+      return std::nullopt;
+    }
+    const Rect location = Rect::MakeXYWH(entry.location[0], entry.location[1],
+                                         entry.location[2], entry.location[3]);
+    if (!atlas_rect.Contains(location)) {
+      return std::nullopt;
+    }
+    Font::Metrics metrics;
+    metrics.point_size = entry.point_size;
+    metrics.embolden = entry.embolden != 0u;
+    metrics.skewX = entry.skew_x;
+    metrics.scaleX = entry.scale_x;
+    // The glyphs of a font are stored next to each other.
+    if (atlas.fonts.empty() ||
+        atlas.fonts.back().typeface_key != entry.typeface_key ||
+        !(atlas.fonts.back().metrics == metrics) ||
+        atlas.fonts.back().scale != entry.scale) {
+      atlas.fonts.push_back({entry.typeface_key, metrics, entry.scale, {}});
+    }
+    const Glyph glyph(entry.glyph_index,
+                      static_cast<Glyph::Type>(entry.glyph_type),
+                      Rect::MakeXYWH(entry.bounds[0], entry.bounds[1],
+                                     entry.bounds[2], entry.bounds[3]));
+    atlas.fonts.back().glyphs.emplace_back(glyph, location);
+  }
+
+  std::memcpy(bitmap->getAddr(0, 0), entries + entries_size, pixels_size);
+  atlas.bitmap = std::move(bitmap);
+  return atlas;
+}
+
+std::shared_ptr<fml::Mapping> GlyphAtlasStoreSkia::Serialize(
+    const GlyphAtlas& atlas,
+    const SkBitmap& bitmap,
+    const std::vector<StoredFont>& stored_fonts) {
+  TRACE_EVENT0("impeller", "SerializeGlyphAtlas");
+  std::vector<GlyphEntrySkia> entries;
+  entries.reserve(atlas.GetGlyphCount());
+  const ScaledFont* last_font = nullptr;
+  size_t typeface_key = 0u;
+  atlas.IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                          const Rect& location) -> bool {
+    // The glyphs of a font are iterated next to each other.
+    if (&scaled_font != last_font) {
+      last_font = &scaled_font;
+      typeface_key = GetTypefaceKey(
+          *TypefaceSkia::Cast(*scaled_font.font.GetTypeface())
+               .GetSkiaTypeface());
+    }
+    entries.push_back(MakeGlyphEntry(typeface_key,
+                                     scaled_font.font.GetMetrics(),
+                                     scaled_font.scale, glyph, location));
+    return true;
+  });
+  for (const StoredFont& font : stored_fonts) {
+    for (const auto& [glyph, location] : font.glyphs) {
+      entries.push_back(MakeGlyphEntry(font.typeface_key, font.metrics,
+                                       font.scale, glyph, location));
+    }
+  }
+
+  GlyphAtlasHeaderSkia header;
+  header.type = static_cast<uint32_t>(atlas.GetType());
+  header.width = bitmap.width();
+  header.height = bitmap.height();
+  header.row_bytes = bitmap.rowBytes();
+  header.glyph_count = entries.size();
+
+  const size_t entries_size = entries.size() * sizeof(GlyphEntrySkia);
+  const size_t pixels_size = bitmap.computeByteSize();
+  auto data = std::make_shared<std::vector<uint8_t>>(
+      sizeof(header) + entries_size + pixels_size);
+  std::memcpy(data->data(), &header, sizeof(header));
+  std::memcpy(data->data() + sizeof(header), entries.data(), entries_size);
+  std::memcpy(data->data() + sizeof(header) + entries_size,
+              bitmap.getAddr(0, 0), pixels_size);
+  return std::make_shared<fml::NonOwnedMapping>(
+      data->data(), data->size(), [data](auto, auto) {});
+}
+
+void GlyphAtlasStoreSkia::Store(GlyphAtlas::Type type,
+                                const fml::Mapping& data) const {
+  if (!IsValid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "StoreGlyphAtlas");
+  if (!fml::WriteAtomically(cache_directory_, GetAtlasFileName(type), data)) {
+    FML_LOG(ERROR) << "Could not write the glyph atlas to the cache.";
+  }
+}
+
+}  // namespace impeller
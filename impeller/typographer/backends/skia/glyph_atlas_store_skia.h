@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/typographer/font.h"
+#include "impeller/typographer/glyph.h"
+#include "impeller/typographer/glyph_atlas.h"
+
+class SkBitmap;
+class SkTypeface;
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists the bitmap of a glyph atlas along with the locations
+///             of its glyphs in a cache directory, so that the glyphs drawn
+///             by the previous launch don't have to be rasterized again.
+///
+///             Each type of atlas is stored in its own file. Fonts are
+///             identified by a key derived from the typeface, which covers
+///             the checksum of the font file, so glyphs of a font that
+///             changed are not reused. Files written by another version of
+///             the format and truncated files are ignored.
+///
+class GlyphAtlasStoreSkia {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      The stored glyphs of a font at a particular scale.
+  ///
+  struct StoredFont {
+    size_t typeface_key = 0u;
+    Font::Metrics metrics;
+    Scalar scale = 1.0f;
+    std::vector<std::pair<Glyph, Rect>> glyphs;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      A stored atlas as loaded from the cache directory.
+  ///
+  struct StoredAtlas {
+    std::shared_ptr<SkBitmap> bitmap;
+    std::vector<StoredFont> fonts;
+  };
+
+  explicit GlyphAtlasStoreSkia(fml::UniqueFD cache_directory);
+
+  ~GlyphAtlasStoreSkia();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A key for the typeface that stays the same across launches
+  ///             as long as the font file doesn't change.
+  ///
+  static size_t GetTypefaceKey(const SkTypeface& typeface);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps the stored atlas of the given type and copies its
+  ///             bitmap out of the file.
+  ///
+  /// @return     The stored atlas, or std::nullopt if there is none or it
+  ///             can't be used.
+  ///
+  std::optional<StoredAtlas> Load(GlyphAtlas::Type type) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the bitmap and the glyph locations of an atlas into
+  ///             a mapping that |Store| writes to the cache directory. This
+  ///             is cheap enough to call on the raster thread.
+  ///
+  /// @param[in]  atlas          The atlas whose glyphs are stored.
+  /// @param[in]  bitmap         The bitmap of the atlas.
+  /// @param[in]  stored_fonts   Glyphs that are in the bitmap but haven't
+  ///                            been restored into |atlas| yet.
+  ///
+  static std::shared_ptr<fml::Mapping> Serialize(
+      const GlyphAtlas& atlas,
+      const SkBitmap& bitmap,
+      const std::vector<StoredFont>& stored_fonts);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes an atlas serialized by |Serialize|. This blocks on
+  ///             file IO.
+  ///
+  void Store(GlyphAtlas::Type type, const fml::Mapping& data) const;
+
+ private:
+  const fml::UniqueFD cache_directory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasStoreSkia);
+};
+
+}  // namespace impeller
@@ -4,14 +4,23 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <numeric>
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_store_skia.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
 #include "impeller/typographer/typographer_context.h"
@@ -27,11 +36,32 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
-std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
-  return std::make_shared<TypographerContextSkia>();
+// Glyphs are drawn by as many as kMaxBandCount workers, as long as each of
+// them gets about kMinGlyphsPerBand glyphs to draw. kBandOverlap is how far
+// outside of its location a glyph is assumed to touch pixels.
+constexpr size_t kMaxBandCount = 8u;
+constexpr size_t kMinGlyphsPerBand = 32u;
+constexpr int kBandOverlap = 8;
+
+// Each store writes the whole bitmap, so atlases that keep changing are
+// stored at most this often.
+constexpr fml::TimeDelta kMinStoreInterval = fml::TimeDelta::FromSeconds(5);
+
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    fml::UniqueFD cache_directory) {
+  return std::make_shared<TypographerContextSkia>(
+      std::move(worker_task_runner), std::move(cache_directory));
 }
 
-TypographerContextSkia::TypographerContextSkia() = default;
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    fml::UniqueFD cache_directory)
+    : worker_task_runner_(std::move(worker_task_runner)) {
+  if (cache_directory.is_valid()) {
+    store_ = std::make_shared<GlyphAtlasStoreSkia>(std::move(cache_directory));
+  }
+}
 
 TypographerContextSkia::~TypographerContextSkia() = default;
 
@@ -75,12 +105,16 @@ static size_t PairsFitInAtlasOfSize(
   return 0;
 }
 
+// Adds the extra pairs to the rect packer of the existing atlas. If they
+// don't fit, the atlas grows taller as long as the texture can, since that
+// keeps the existing glyphs where they are.
 static bool CanAppendToExistingAtlas(
     const std::shared_ptr<GlyphAtlas>& atlas,
     const std::vector<FontGlyphPair>& extra_pairs,
     std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    ISize& atlas_size,
+    const std::shared_ptr<RectanglePacker>& rect_packer,
+    const ISize& max_texture_size) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!rect_packer || atlas_size.IsEmpty()) {
     return false;
@@ -97,11 +131,16 @@ static bool CanAppendToExistingAtlas(
     const auto glyph_size =
         ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
     IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
+    while (!rect_packer->addRect(glyph_size.width + kPadding,   //
+                                 glyph_size.height + kPadding,  //
+                                 &location_in_atlas             //
+                                 )) {
+      auto grown_height = atlas_size.height * 2;
+      if (grown_height > max_texture_size.height ||
+          !rect_packer->growHeight(grown_height)) {
+        return false;
+      }
+      atlas_size.height = grown_height;
     }
     glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
                                                 location_in_atlas.y(),  //
@@ -185,13 +224,18 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const std::vector<FontGlyphPair>& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
-
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
+struct GlyphToDraw {
+  const ScaledFont* scaled_font;
+  const Glyph* glyph;
+  Rect location;
+};
+
+static bool DrawGlyphsInBand(const SkBitmap& bitmap,
+                             const std::vector<GlyphToDraw>& glyphs,
+                             bool has_color,
+                             int band_top,
+                             int band_bottom) {
+  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
   if (!surface) {
     return false;
   }
@@ -199,22 +243,84 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   if (!canvas) {
     return false;
   }
+  // The clip is pixel aligned, so a glyph that straddles two bands gets the
+  // same pixels from the two draws as it would from one.
+  canvas->clipIRect(
+      SkIRect::MakeLTRB(0, band_top, bitmap.width(), band_bottom));
+  for (const auto& glyph : glyphs) {
+    if (glyph.location.GetTop() - kBandOverlap >= band_bottom ||
+        glyph.location.GetBottom() + kBandOverlap <= band_top) {
+      continue;
+    }
+    DrawGlyph(canvas, *glyph.scaled_font, *glyph.glyph, glyph.location,
+              has_color);
+  }
+  return true;
+}
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+// Draws the glyphs into the bitmap. Large batches of glyphs are split into
+// horizontal bands of the bitmap that are drawn concurrently. The bands don't
+// overlap, so the workers write to disjoint pixels.
+static bool DrawGlyphs(
+    const SkBitmap& bitmap,
+    const std::vector<GlyphToDraw>& glyphs,
+    bool has_color,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT1("impeller", __FUNCTION__, "glyphs",
+               std::to_string(glyphs.size()).c_str());
+  size_t band_count =
+      std::min(kMaxBandCount, glyphs.size() / kMinGlyphsPerBand);
+  band_count = std::min<size_t>(band_count, bitmap.height());
+  if (!worker_task_runner || band_count < 2) {
+    return DrawGlyphsInBand(bitmap, glyphs, has_color, 0, bitmap.height());
+  }
+
+  const int band_height = (bitmap.height() + band_count - 1) / band_count;
+  std::atomic_bool success = true;
+  fml::CountDownLatch latch(band_count - 1);
+  for (size_t band = 1; band < band_count; band++) {
+    worker_task_runner->PostTask([&, band]() {
+      TRACE_EVENT0("impeller", "DrawGlyphsInBand");
+      int band_top = band * band_height;
+      if (!DrawGlyphsInBand(bitmap, glyphs, has_color, band_top,
+                            std::min(band_top + band_height,
+                                     bitmap.height()))) {
+        success = false;
+      }
+      latch.CountDown();
+    });
+  }
+  if (!DrawGlyphsInBand(bitmap, glyphs, has_color, 0, band_height)) {
+    success = false;
+  }
+  latch.Wait();
+  return success;
+}
+
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
 
+  std::vector<GlyphToDraw> glyphs;
+  glyphs.reserve(new_pairs.size());
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    glyphs.push_back({&pair.scaled_font, &pair.glyph, pos.value()});
   }
-  return true;
+
+  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  return DrawGlyphs(*bitmap, glyphs, has_color, worker_task_runner);
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
+static std::shared_ptr<SkBitmap> AllocateAtlasBitmap(const GlyphAtlas& atlas,
+                                                     const ISize& atlas_size) {
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
 
@@ -231,25 +337,48 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
   if (!bitmap->tryAllocPixels(image_info)) {
     return nullptr;
   }
+  return bitmap;
+}
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
+// Copies the contents of a bitmap into the top of a taller one, so that only
+// the glyphs that don't fit into it have to be drawn.
+static std::shared_ptr<SkBitmap> GrowAtlasBitmap(const GlyphAtlas& atlas,
+                                                 const SkBitmap& old_bitmap,
+                                                 const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = AllocateAtlasBitmap(atlas, atlas_size);
+  if (!bitmap || bitmap->rowBytes() != old_bitmap.rowBytes() ||
+      bitmap->height() < old_bitmap.height()) {
     return nullptr;
   }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
+  std::memcpy(bitmap->getAddr(0, 0), old_bitmap.getAddr(0, 0),
+              old_bitmap.computeByteSize());
+  return bitmap;
+}
+
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = AllocateAtlasBitmap(atlas, atlas_size);
+  if (!bitmap) {
     return nullptr;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+  std::vector<GlyphToDraw> glyphs;
+  glyphs.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs([&glyphs](const ScaledFont& scaled_font,
+                                const Glyph& glyph,
+                                const Rect& location) -> bool {
+    glyphs.push_back({&scaled_font, &glyph, location});
     return true;
   });
 
+  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  if (!DrawGlyphs(*bitmap, glyphs, has_color, worker_task_runner)) {
+    return nullptr;
+  }
   return bitmap;
 }
 
@@ -269,6 +398,48 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
   return texture->SetContents(mapping);
 }
 
+// Uploads only the rows of the bitmap that new glyphs were drawn into, if the
+// backend can copy buffers into textures.
+static bool UpdateGlyphTextureAtlasRows(
+    Context& context,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::shared_ptr<Texture>& texture,
+    int first_row,
+    int row_count) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+
+  FML_DCHECK(bitmap != nullptr);
+  auto texture_descriptor = texture->GetTextureDescriptor();
+  auto bytes_per_row =
+      texture_descriptor.size.width *
+      BytesPerPixelForPixelFormat(texture_descriptor.format);
+  if (!context.GetCapabilities()->SupportsBufferToTextureBlits() ||
+      bitmap->rowBytes() != bytes_per_row || first_row < 0 || row_count <= 0 ||
+      first_row + row_count > texture_descriptor.size.height) {
+    return UpdateGlyphTextureAtlas(bitmap, texture);
+  }
+
+  auto buffer = context.GetResourceAllocator()->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(bitmap->getAddr(0, first_row)),
+      bytes_per_row * row_count);
+  if (!buffer) {
+    return false;
+  }
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("GlyphAtlas Update");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass ||
+      !blit_pass->AddCopy(buffer->AsBufferView(), texture, IPoint(0, first_row),
+                          "GlyphAtlas Rows") ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator())) {
+    return false;
+  }
+  return context.EnqueueCommandBuffer(std::move(command_buffer));
+}
+
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     const std::shared_ptr<Allocator>& allocator,
     std::shared_ptr<SkBitmap> bitmap,
@@ -310,6 +481,123 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   return texture;
 }
 
+static PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+// Loads the atlas stored by a previous launch into an empty atlas context.
+// The stored glyphs are only added to the atlas once they are drawn, since
+// that requires the fonts of this launch, but the rows of the bitmap they
+// occupy are left out of the rect packer right away.
+static void LoadStoredGlyphAtlas(Context& context,
+                                 GlyphAtlas::Type type,
+                                 const GlyphAtlasStoreSkia& store,
+                                 GlyphAtlasContextSkia& atlas_context) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto stored_atlas = store.Load(type);
+  if (!stored_atlas.has_value()) {
+    return;
+  }
+  const auto& bitmap = stored_atlas->bitmap;
+  const ISize atlas_size(bitmap->width(), bitmap->height());
+  auto max_texture_size =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported();
+  if (atlas_size.width > max_texture_size.width ||
+      atlas_size.height > max_texture_size.height) {
+    return;
+  }
+
+  int used_height = 0;
+  for (const auto& font : stored_atlas->fonts) {
+    for (const auto& [glyph, location] : font.glyphs) {
+      used_height = std::max<int>(used_height,
+                                  std::ceil(location.GetBottom()) + kPadding);
+    }
+  }
+  used_height = std::min<int>(used_height, atlas_size.height);
+  auto rect_packer = std::shared_ptr<RectanglePacker>(
+      RectanglePacker::Factory(atlas_size.width, atlas_size.height));
+  IPoint16 used_location;
+  if (used_height > 0 &&
+      !rect_packer->addRect(atlas_size.width, used_height, &used_location)) {
+    return;
+  }
+
+  auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
+                                         atlas_size, GetAtlasPixelFormat(type));
+  if (!texture) {
+    return;
+  }
+  auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
+  glyph_atlas->SetTexture(std::move(texture));
+  atlas_context.UpdateBitmap(bitmap);
+  atlas_context.UpdateGlyphAtlas(std::move(glyph_atlas), atlas_size);
+  atlas_context.UpdateRectPacker(std::move(rect_packer));
+  atlas_context.GetStoredFonts() = std::move(stored_atlas->fonts);
+}
+
+// Adds the glyphs of the scaled font that are in the loaded atlas to the
+// atlas, if there are any.
+static void RestoreStoredGlyphs(GlyphAtlasContextSkia& atlas_context,
+                                GlyphAtlas& atlas,
+                                const ScaledFont& scaled_font) {
+  auto& stored_fonts = atlas_context.GetStoredFonts();
+  if (stored_fonts.empty()) {
+    return;
+  }
+  const size_t typeface_key = GlyphAtlasStoreSkia::GetTypefaceKey(
+      *TypefaceSkia::Cast(*scaled_font.font.GetTypeface()).GetSkiaTypeface());
+  auto stored_font = std::find_if(
+      stored_fonts.begin(), stored_fonts.end(), [&](const auto& font) {
+        return font.typeface_key == typeface_key &&
+               font.metrics == scaled_font.font.GetMetrics() &&
+               font.scale == scaled_font.scale;
+      });
+  if (stored_font == stored_fonts.end()) {
+    return;
+  }
+  for (const auto& [glyph, location] : stored_font->glyphs) {
+    atlas.AddTypefaceGlyphPosition(FontGlyphPair(scaled_font, glyph),
+                                   location);
+  }
+  stored_fonts.erase(stored_font);
+}
+
+// Writes the atlas to the store on the worker task runner, unless it was
+// stored too recently, in which case it is stored by a later call.
+static void StoreGlyphAtlas(
+    const std::shared_ptr<GlyphAtlasStoreSkia>& store,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    GlyphAtlasContextSkia& atlas_context,
+    const GlyphAtlas& atlas) {
+  if (!store || !atlas.IsValid() || !atlas_context.GetBitmap()) {
+    return;
+  }
+  auto now = fml::TimePoint::Now();
+  if (now - atlas_context.GetLastStoreTime() < kMinStoreInterval) {
+    atlas_context.SetPendingStore(true);
+    return;
+  }
+  atlas_context.UpdateLastStoreTime(now);
+  atlas_context.SetPendingStore(false);
+
+  auto data = GlyphAtlasStoreSkia::Serialize(atlas, *atlas_context.GetBitmap(),
+                                             atlas_context.GetStoredFonts());
+  auto type = atlas.GetType();
+  if (!worker_task_runner) {
+    store->Store(type, *data);
+    return;
+  }
+  worker_task_runner->PostTask(
+      [store, type, data]() { store->Store(type, *data); });
+}
+
 std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type,
@@ -320,11 +608,21 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     return nullptr;
   }
   auto& atlas_context_skia = GlyphAtlasContextSkia::Cast(*atlas_context);
+  if (store_ && !atlas_context_skia.HasLoadedStoredAtlas()) {
+    atlas_context_skia.MarkStoredAtlasLoaded();
+    if (atlas_context->GetAtlasSize().IsEmpty()) {
+      LoadStoredGlyphAtlas(context, type, *store_, atlas_context_skia);
+    }
+  }
   std::shared_ptr<GlyphAtlas> last_atlas = atlas_context->GetGlyphAtlas();
 
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  if (atlas_context_skia.HasPendingStore()) {
+    StoreGlyphAtlas(store_, worker_task_runner_, atlas_context_skia,
+                    *last_atlas);
+  }
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -335,6 +633,11 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     const ScaledFont& scaled_font = font_value.first;
     const FontGlyphAtlas* font_glyph_atlas =
         last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
+    if (!font_glyph_atlas && last_atlas->GetType() == type) {
+      RestoreStoredGlyphs(atlas_context_skia, *last_atlas, scaled_font);
+      font_glyph_atlas =
+          last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
+    }
     if (font_glyph_atlas) {
       for (const Glyph& glyph : font_value.second) {
         if (!font_glyph_atlas->FindGlyphBounds(glyph)) {
@@ -357,10 +660,14 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   //         the type is identical.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
+  auto max_texture_size =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported();
+  ISize appended_atlas_size = atlas_context->GetAtlasSize();
   if (last_atlas->GetType() == type &&
       CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
+                               appended_atlas_size,
+                               atlas_context->GetRectPacker(),
+                               max_texture_size)) {
     // The old bitmap will be reused and only the additional glyphs will be
     // added.
 
@@ -368,24 +675,69 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // Step 3a: Record the positions in the glyph atlas of the newly added
     //          glyphs.
     // ---------------------------------------------------------------------------
+    int first_dirty_row = appended_atlas_size.height;
+    int last_dirty_row = 0;
     for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
       last_atlas->AddTypefaceGlyphPosition(new_glyphs[i], glyph_positions[i]);
+      first_dirty_row =
+          std::min<int>(first_dirty_row, glyph_positions[i].GetTop());
+      last_dirty_row = std::max<int>(
+          last_dirty_row, glyph_positions[i].GetBottom() + kPadding);
+    }
+    last_dirty_row = std::min<int>(last_dirty_row, appended_atlas_size.height);
+
+    if (appended_atlas_size == atlas_context->GetAtlasSize()) {
+      // -----------------------------------------------------------------------
+      // Step 4a: Draw new font-glyph pairs into the existing bitmap.
+      // -----------------------------------------------------------------------
+      auto bitmap = atlas_context_skia.GetBitmap();
+      if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                             worker_task_runner_)) {
+        return nullptr;
+      }
+
+      // -----------------------------------------------------------------------
+      // Step 5a: Upload the rows of the bitmap that the new glyphs were drawn
+      //          into to the existing texture.
+      // -----------------------------------------------------------------------
+      if (!UpdateGlyphTextureAtlasRows(context, bitmap,
+                                       last_atlas->GetTexture(),
+                                       first_dirty_row,
+                                       last_dirty_row - first_dirty_row)) {
+        return nullptr;
+      }
+      StoreGlyphAtlas(store_, worker_task_runner_, atlas_context_skia,
+                      *last_atlas);
+      FML_PERFORMANCE_COUNTER_ADD("glyphAtlas.updates", 1);
+      return last_atlas;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 4a: Draw new font-glyph pairs into the existing bitmap.
+    // Step 4c: The atlas grew taller. Copy the existing bitmap into a taller
+    //          one and only draw the new font-glyph pairs.
     // ---------------------------------------------------------------------------
-    auto bitmap = atlas_context_skia.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    auto bitmap = GrowAtlasBitmap(*last_atlas, *atlas_context_skia.GetBitmap(),
+                                  appended_atlas_size);
+    if (!bitmap || !UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                                      worker_task_runner_)) {
       return nullptr;
     }
+    atlas_context_skia.UpdateBitmap(bitmap);
+    atlas_context->UpdateGlyphAtlas(last_atlas, appended_atlas_size);
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5c: Upload the taller bitmap as a texture.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    auto texture = UploadGlyphTextureAtlas(
+        context.GetResourceAllocator(), bitmap, appended_atlas_size,
+        last_atlas->GetTexture()->GetTextureDescriptor().format);
+    if (!texture) {
       return nullptr;
     }
+    last_atlas->SetTexture(std::move(texture));
+    StoreGlyphAtlas(store_, worker_task_runner_, atlas_context_skia,
+                    *last_atlas);
+    FML_PERFORMANCE_COUNTER_ADD("glyphAtlas.updates", 1);
     return last_atlas;
   }
   // A new glyph atlas must be created.
@@ -409,10 +761,12 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
       glyph_positions,                                              //
       atlas_context,                                                //
       type,                                                         //
-      context.GetResourceAllocator()->GetMaxTextureSizeSupported()  //
+      max_texture_size                                              //
   );
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
+  // The glyphs of the loaded atlas are not in the new bitmap.
+  atlas_context_skia.GetStoredFonts().clear();
   if (atlas_size.IsEmpty()) {
     return nullptr;
   }
@@ -440,7 +794,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap =
+      CreateAtlasBitmap(*glyph_atlas, atlas_size, worker_task_runner_);
   if (!bitmap) {
     return nullptr;
   }
@@ -449,17 +804,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 7b: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
   auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
-                                         atlas_size, format);
+                                         atlas_size, GetAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
@@ -468,7 +814,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // Step 8b: Record the texture in the glyph atlas.
   // ---------------------------------------------------------------------------
   glyph_atlas->SetTexture(std::move(texture));
+  StoreGlyphAtlas(store_, worker_task_runner_, atlas_context_skia,
+                  *glyph_atlas);
 
+  FML_PERFORMANCE_COUNTER_ADD("glyphAtlas.creations", 1);
   return glyph_atlas;
 }
 
@@ -4,16 +4,36 @@
 
 #pragma once
 
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
+class GlyphAtlasStoreSkia;
+
 class TypographerContextSkia : public TypographerContext {
  public:
-  static std::shared_ptr<TypographerContext> Make();
-
-  TypographerContextSkia();
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a typographer context that rasterizes large batches
+  ///             of new glyphs concurrently on `worker_task_runner`, or on
+  ///             the calling thread if it is nullptr.
+  ///
+  ///             If `cache_directory` is valid, the glyph atlases are stored
+  ///             in it and the ones stored by the previous launch are loaded
+  ///             the first time an atlas of their type is needed, so that
+  ///             glyphs drawn before don't have to be rasterized again.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr,
+      fml::UniqueFD cache_directory = {});
+
+  explicit TypographerContextSkia(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr,
+      fml::UniqueFD cache_directory = {});
 
   ~TypographerContextSkia() override;
 
@@ -28,6 +48,9 @@ class TypographerContextSkia : public TypographerContext {
       const FontGlyphMap& font_glyph_map) const override;
 
  private:
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::shared_ptr<GlyphAtlasStoreSkia> store_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TypographerContextSkia);
 };
 
@@ -25,8 +25,8 @@ const std::shared_ptr<Typeface>& Font::GetTypeface() const {
 }
 
 std::size_t Font::GetHash() const {
-  return fml::HashCombine(is_valid_, typeface_ ? typeface_->GetHash() : 0u,
-                          metrics_);
+  return fml::FastHash(is_valid_, typeface_ ? typeface_->GetHash() : 0u,
+                       metrics_);
 }
 
 bool Font::IsEqual(const Font& other) const {
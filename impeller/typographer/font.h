@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/typographer/glyph.h"
@@ -74,6 +75,6 @@ class Font : public Comparable<Font> {
 template <>
 struct std::hash<impeller::Font::Metrics> {
   constexpr std::size_t operator()(const impeller::Font::Metrics& m) const {
-    return fml::HashCombine(m.point_size, m.skewX, m.scaleX);
+    return fml::FastHash(m.point_size, m.skewX, m.scaleX);
   }
 };
@@ -9,6 +9,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "flutter/fml/fast_hash.h"
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/size.h"
 #include "impeller/typographer/font.h"
@@ -43,7 +44,7 @@ struct FontGlyphPair {
 template <>
 struct std::hash<impeller::ScaledFont> {
   constexpr std::size_t operator()(const impeller::ScaledFont& sf) const {
-    return fml::HashCombine(sf.font.GetHash(), sf.scale);
+    return fml::FastHash(sf.font.GetHash(), sf.scale);
   }
 };
 
@@ -4,13 +4,33 @@
 
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
+#include "flutter/fml/logging.h"
 #include "impeller/base/validation.h"
 #include "impeller/typographer/typographer_context.h"
 
+#include <cmath>
 #include <utility>
 
 namespace impeller {
 
+// Scales are bucketed in steps of a quarter octave, so glyphs are sampled
+// down by at most 19%.
+static constexpr Scalar kScaleBucketsPerOctave = 4;
+
+// Scales that change in this many frames in a row are considered animating,
+// and ones that stay the same for this many frames in a row settled.
+static constexpr size_t kAnimatingFrameCount = 2;
+static constexpr size_t kSettledFrameCount = 8;
+
+static Scalar BucketScale(Scalar scale) {
+  if (scale <= 0) {
+    return scale;
+  }
+  // Rounding up means glyphs are never magnified, which would blur them.
+  return std::exp2(std::ceil(std::log2(scale) * kScaleBucketsPerOctave) /
+                   kScaleBucketsPerOctave);
+}
+
 LazyGlyphAtlas::LazyGlyphAtlas(
     std::shared_ptr<TypographerContext> typographer_context)
     : typographer_context_(std::move(typographer_context)),
@@ -23,6 +43,24 @@ LazyGlyphAtlas::LazyGlyphAtlas(
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
+void LazyGlyphAtlas::SetScalePolicy(ScalePolicy policy) {
+  scale_policy_ = policy;
+}
+
+Scalar LazyGlyphAtlas::ResolveScale(Scalar scale) {
+  Scalar rounded_scale = TextFrame::RoundScaledFontSize(scale, 0);
+  switch (scale_policy_) {
+    case ScalePolicy::kExact:
+      return rounded_scale;
+    case ScalePolicy::kBucketed:
+      return BucketScale(rounded_scale);
+    case ScalePolicy::kBucketedWhileAnimating:
+      frame_scales_.insert(rounded_scale);
+      return bucket_scales_ ? BucketScale(rounded_scale) : rounded_scale;
+  }
+  FML_UNREACHABLE();
+}
+
 void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
   FML_DCHECK(atlas_map_.empty());
   if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
@@ -36,6 +74,25 @@ void LazyGlyphAtlas::ResetTextFrames() {
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
   atlas_map_.clear();
+
+  // Frames without text neither start nor end an animation.
+  if (frame_scales_.empty()) {
+    return;
+  }
+  if (frame_scales_ == last_frame_scales_) {
+    changed_frames_ = 0;
+    unchanged_frames_++;
+  } else {
+    changed_frames_++;
+    unchanged_frames_ = 0;
+  }
+  if (changed_frames_ >= kAnimatingFrameCount) {
+    bucket_scales_ = true;
+  } else if (unchanged_frames_ >= kSettledFrameCount) {
+    bucket_scales_ = false;
+  }
+  last_frame_scales_ = std::move(frame_scales_);
+  frame_scales_.clear();
 }
 
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <set>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -16,11 +17,42 @@ namespace impeller {
 
 class LazyGlyphAtlas {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief  How the scale text is drawn at maps to the scale its glyphs are
+  ///         rendered into the atlas at.
+  ///
+  enum class ScalePolicy {
+    /// Glyphs are rendered at the scale they are drawn at, rounded to
+    /// 1/100th.
+    kExact,
+    /// Glyphs are rendered at the next larger of the scales a quarter octave
+    /// apart and sampled down from there, so that scales changing from frame
+    /// to frame reuse the glyphs of a few buckets.
+    kBucketed,
+    /// Like |kBucketed| while the scales drawn at change from frame to frame,
+    /// such as during zoom animations, and like |kExact| once they settle.
+    kBucketedWhileAnimating,
+  };
+
   explicit LazyGlyphAtlas(
       std::shared_ptr<TypographerContext> typographer_context);
 
   ~LazyGlyphAtlas();
 
+  void SetScalePolicy(ScalePolicy policy);
+
+  //----------------------------------------------------------------------------
+  /// @brief  Returns the scale to render the glyphs of text drawn at |scale|
+  ///         at, and to pass to |AddTextFrame| and to look the glyphs up in
+  ///         the atlas with. It may be larger than |scale|, in which case the
+  ///         glyphs must be sampled with linear filtering.
+  ///
+  ///         The scales are tracked across frames for
+  ///         |ScalePolicy::kBucketedWhileAnimating|, and the result only
+  ///         changes in |ResetTextFrames|.
+  ///
+  Scalar ResolveScale(Scalar scale);
+
   void AddTextFrame(const TextFrame& frame, Scalar scale);
 
   void ResetTextFrames();
@@ -39,6 +71,16 @@ class LazyGlyphAtlas {
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
 
+  ScalePolicy scale_policy_ = ScalePolicy::kBucketedWhileAnimating;
+  // The rounded scales text was drawn at in this frame and the last frame
+  // with text.
+  std::set<Scalar> frame_scales_;
+  std::set<Scalar> last_frame_scales_;
+  // The number of frames in a row in which the scales changed, or didn't.
+  size_t changed_frames_ = 0;
+  size_t unchanged_frames_ = 0;
+  bool bucket_scales_ = false;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LazyGlyphAtlas);
 };
 
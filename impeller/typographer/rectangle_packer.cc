@@ -29,6 +29,16 @@ class SkylineRectanglePacker final : public RectanglePacker {
 
   bool addRect(int w, int h, IPoint16* loc) final;
 
+  bool growHeight(int height) final {
+    if (height < this->height()) {
+      return false;
+    }
+    // Growing only adds free space below the skyline, so the rectangles that
+    // have already been added stay where they are.
+    this->setHeight(height);
+    return true;
+  }
+
   float percentFull() const final {
     return area_so_far_ / ((float)this->width() * this->height());
   }
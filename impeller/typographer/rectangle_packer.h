@@ -54,6 +54,16 @@ class RectanglePacker {
   ///
   virtual void reset() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Extend the area to the given height without moving any of the
+  ///            rectangles that have already been added.
+  ///
+  /// @param[in]   height  The new height of the area.
+  ///
+  /// @return    Return true on success; false if the new height is smaller.
+  ///
+  virtual bool growHeight(int height) = 0;
+
  protected:
   RectanglePacker(int width, int height) : width_(width), height_(height) {
     FML_DCHECK(width >= 0);
@@ -63,9 +73,11 @@ class RectanglePacker {
   int width() const { return width_; }
   int height() const { return height_; }
 
+  void setHeight(int height) { height_ = height; }
+
  private:
   const int width_;
-  const int height_;
+  int height_;
 };
 
 }  // namespace impeller
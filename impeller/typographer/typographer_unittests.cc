@@ -2,8 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
@@ -255,6 +262,147 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   ASSERT_EQ(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasGrowsWithoutMovingExistingGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky 1", sk_font);
+  ASSERT_TRUE(blob);
+
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+      font_glyph_map, 1.0f);
+  auto atlas =
+      context->CreateGlyphAtlas(*GetContext(), GlyphAtlas::Type::kAlphaBitmap,
+                                atlas_context, font_glyph_map);
+  ASSERT_NE(atlas, nullptr);
+  auto first_size = atlas->GetTexture()->GetSize();
+  std::vector<std::tuple<ScaledFont, Glyph, Rect>> first_glyphs;
+  atlas->IterateGlyphs(
+      [&](const ScaledFont& scaled_font, const Glyph& glyph, const Rect& rect) {
+        first_glyphs.push_back({scaled_font, glyph, rect});
+        return true;
+      });
+
+  // Add more glyphs than fit into the first atlas.
+  auto big_blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm,.<>[]{};':"
+      "2134567890-=!@#$%^&*()_+",
+      sk_font);
+  for (int scale = 6; scale <= 9; scale++) {
+    MakeTextFrameFromTextBlobSkia(big_blob)->CollectUniqueFontGlyphPairs(
+        font_glyph_map, scale);
+  }
+  auto next_atlas =
+      context->CreateGlyphAtlas(*GetContext(), GlyphAtlas::Type::kAlphaBitmap,
+                                atlas_context, font_glyph_map);
+  ASSERT_EQ(next_atlas, atlas);
+
+  auto next_size = next_atlas->GetTexture()->GetSize();
+  EXPECT_EQ(next_size.width, first_size.width);
+  EXPECT_GT(next_size.height, first_size.height);
+  EXPECT_EQ(atlas_context->GetAtlasSize(), next_size);
+  for (const auto& [scaled_font, glyph, rect] : first_glyphs) {
+    auto bounds =
+        next_atlas->FindFontGlyphBounds(FontGlyphPair(scaled_font, glyph));
+    EXPECT_EQ(bounds, rect);
+  }
+}
+
+TEST_P(TypographerTest, GlyphAtlasIsTheSameWhenRasterizedConcurrently) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto serial_context = TypographerContextSkia::Make();
+  auto concurrent_context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  ASSERT_TRUE(serial_context->IsValid() && concurrent_context->IsValid());
+
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm,.<>[]{};':"
+      "2134567890-=!@#$%^&*()_+",
+      sk_font);
+  ASSERT_TRUE(blob);
+  FontGlyphMap font_glyph_map;
+  for (int scale = 1; scale <= 4; scale++) {
+    MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+        font_glyph_map, scale);
+  }
+
+  auto serial_atlas_context = serial_context->CreateGlyphAtlasContext();
+  auto serial_atlas = serial_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, serial_atlas_context,
+      font_glyph_map);
+  auto concurrent_atlas_context = concurrent_context->CreateGlyphAtlasContext();
+  auto concurrent_atlas = concurrent_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, concurrent_atlas_context,
+      font_glyph_map);
+  ASSERT_TRUE(serial_atlas && concurrent_atlas);
+
+  auto serial_bitmap =
+      GlyphAtlasContextSkia::Cast(*serial_atlas_context).GetBitmap();
+  auto concurrent_bitmap =
+      GlyphAtlasContextSkia::Cast(*concurrent_atlas_context).GetBitmap();
+  ASSERT_EQ(serial_bitmap->computeByteSize(),
+            concurrent_bitmap->computeByteSize());
+  EXPECT_EQ(std::memcmp(serial_bitmap->getAddr(0, 0),
+                        concurrent_bitmap->getAddr(0, 0),
+                        serial_bitmap->computeByteSize()),
+            0);
+}
+
+TEST_P(TypographerTest, GlyphAtlasIsLoadedFromCacheDirectory) {
+  fml::ScopedTemporaryDirectory cache_directory;
+  auto open_cache_directory = [&cache_directory]() {
+    return fml::OpenDirectory(cache_directory.path().c_str(), false,
+                              fml::FilePermission::kReadWrite);
+  };
+
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky skellingtons", sk_font);
+  ASSERT_TRUE(blob);
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+      font_glyph_map, 1.0f);
+
+  // Without a worker task runner, the atlas is stored synchronously.
+  auto first_context =
+      TypographerContextSkia::Make(nullptr, open_cache_directory());
+  auto first_atlas_context = first_context->CreateGlyphAtlasContext();
+  auto first_atlas = first_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, first_atlas_context,
+      font_glyph_map);
+  ASSERT_TRUE(first_atlas);
+
+  auto second_context =
+      TypographerContextSkia::Make(nullptr, open_cache_directory());
+  auto second_atlas_context = second_context->CreateGlyphAtlasContext();
+  auto second_atlas = second_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, second_atlas_context,
+      font_glyph_map);
+  ASSERT_TRUE(second_atlas);
+
+  // The glyphs are where the first launch put them, in a copy of its bitmap.
+  ASSERT_EQ(second_atlas->GetGlyphCount(), first_atlas->GetGlyphCount());
+  first_atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                                 const Glyph& glyph,
+                                 const Rect& rect) -> bool {
+    EXPECT_EQ(second_atlas->FindFontGlyphBounds({scaled_font, glyph}), rect);
+    return true;
+  });
+  auto first_bitmap =
+      GlyphAtlasContextSkia::Cast(*first_atlas_context).GetBitmap();
+  auto& second_atlas_context_skia =
+      GlyphAtlasContextSkia::Cast(*second_atlas_context);
+  auto second_bitmap = second_atlas_context_skia.GetBitmap();
+  ASSERT_EQ(first_bitmap->computeByteSize(),
+            second_bitmap->computeByteSize());
+  EXPECT_EQ(std::memcmp(first_bitmap->getAddr(0, 0),
+                        second_bitmap->getAddr(0, 0),
+                        first_bitmap->computeByteSize()),
+            0);
+  EXPECT_TRUE(second_atlas_context_skia.GetStoredFonts().empty());
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -349,6 +497,60 @@ TEST_P(TypographerTest, RectanglePackerAddsNonoverlapingRectangles) {
   ASSERT_EQ(packer->percentFull(), 0);
 }
 
+TEST_P(TypographerTest, RectanglePackerCanGrowHeight) {
+  auto packer =
+      std::unique_ptr<RectanglePacker>(RectanglePacker::Factory(100, 100));
+  IPoint16 location = {-1, -1};
+  ASSERT_TRUE(packer->addRect(100, 100, &location));
+  ASSERT_FALSE(packer->addRect(50, 50, &location));
+
+  ASSERT_TRUE(packer->growHeight(200));
+  ASSERT_TRUE(packer->addRect(50, 50, &location));
+  EXPECT_EQ(location.x(), 0);
+  EXPECT_EQ(location.y(), 100);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.625));
+
+  EXPECT_FALSE(packer->growHeight(150));
+}
+
+TEST_P(TypographerTest, LazyAtlasBucketsScalesByPolicy) {
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+
+  lazy_atlas.SetScalePolicy(LazyGlyphAtlas::ScalePolicy::kExact);
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.1), 1.1);
+
+  lazy_atlas.SetScalePolicy(LazyGlyphAtlas::ScalePolicy::kBucketed);
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.0), 1.0);
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.1), std::exp2(0.25));
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(2.0), 2.0);
+}
+
+TEST_P(TypographerTest, LazyAtlasBucketsScalesWhileAnimating) {
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  lazy_atlas.SetScalePolicy(
+      LazyGlyphAtlas::ScalePolicy::kBucketedWhileAnimating);
+
+  // The first scale change is not an animation yet.
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.0), 1.0);
+  lazy_atlas.ResetTextFrames();
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.1), 1.1);
+  lazy_atlas.ResetTextFrames();
+
+  // Frames without text don't end the animation.
+  lazy_atlas.ResetTextFrames();
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.2), std::exp2(0.5));
+  lazy_atlas.ResetTextFrames();
+
+  // Once the scale stops changing the glyphs are rendered at it again.
+  for (int i = 0; i < 7; i++) {
+    EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.2), std::exp2(0.5));
+    lazy_atlas.ResetTextFrames();
+  }
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.2), std::exp2(0.5));
+  lazy_atlas.ResetTextFrames();
+  EXPECT_FLOAT_EQ(lazy_atlas.ResolveScale(1.2), 1.2);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -444,7 +444,12 @@ abstract class SceneBuilder {
   ///  - 0x02: visualizeRasterizerStatistics - graph raster thread frame times
   ///  - 0x04: displayEngineStatistics - show UI thread frame time
   ///  - 0x08: visualizeEngineStatistics - graph UI thread frame times
-  /// Set enabledOptions to 0x0F to enable all the currently defined features.
+  ///  - 0x10: displayGpuStatistics - show GPU frame time
+  ///  - 0x20: visualizeGpuStatistics - graph GPU frame times
+  /// Set enabledOptions to 0x3F to enable all the currently defined features.
+  ///
+  /// The GPU frame time is measured with GPU timestamps, and is only available
+  /// when rendering with Impeller on drivers that support them.
   ///
   /// The "UI thread" is the thread that includes all the execution of the main
   /// Dart isolate (the isolate that can call [FlutterView.render]). The UI
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/compositing/scene_builder.h"
 
+#include <algorithm>
+
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_path_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
@@ -49,11 +51,9 @@ void SceneBuilder::pushTransform(Dart_Handle layer_handle,
   PushLayer(layer);
   // matrix4 has to be released before we can return another Dart object
   matrix4.Release();
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushOffset(Dart_Handle layer_handle,
@@ -63,11 +63,9 @@ void SceneBuilder::pushOffset(Dart_Handle layer_handle,
   SkMatrix sk_matrix = SkMatrix::Translate(SafeNarrow(dx), SafeNarrow(dy));
   auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
@@ -83,11 +81,9 @@ void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ClipRectLayer>(clipRect, clip_behavior);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
@@ -98,11 +94,9 @@ void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ClipRRectLayer>(rrect.sk_rrect, clip_behavior);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
@@ -114,11 +108,9 @@ void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ClipPathLayer>(path->path(), clip_behavior);
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
@@ -129,11 +121,9 @@ void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
   auto layer = std::make_shared<flutter::OpacityLayer>(
       alpha, SkPoint::Make(SafeNarrow(dx), SafeNarrow(dy)));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
@@ -142,11 +132,9 @@ void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
   auto layer =
       std::make_shared<flutter::ColorFilterLayer>(color_filter->filter());
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
@@ -157,11 +145,9 @@ void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
   auto layer = std::make_shared<flutter::ImageFilterLayer>(
       image_filter->filter(), SkPoint::Make(SafeNarrow(dx), SafeNarrow(dy)));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushBackdropFilter(
@@ -172,11 +158,9 @@ void SceneBuilder::pushBackdropFilter(
   auto layer = std::make_shared<flutter::BackdropFilterLayer>(
       filter->filter(), static_cast<DlBlendMode>(blendMode));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
@@ -195,11 +179,9 @@ void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
   auto layer = std::make_shared<flutter::ShaderMaskLayer>(
       shader->shader(sampling), rect, static_cast<DlBlendMode>(blendMode));
   PushLayer(layer);
-  EngineLayer::MakeRetained(layer_handle, layer);
+  auto engine_layer = EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(engine_layer, oldLayer);
 }
 
 void SceneBuilder::addRetained(const fml::RefPtr<EngineLayer>& retainedLayer) {
@@ -287,6 +269,7 @@ void SceneBuilder::build(Dart_Handle scene_handle) {
       scene_handle, std::move(layer_stack_[0]), rasterizer_tracing_threshold_,
       checkerboard_raster_cache_images_, checkerboard_offscreen_layers_);
   layer_stack_.clear();
+  pushed_layers_.clear();
   ClearDartWrapper();  // may delete this object.
 }
 
@@ -301,13 +284,59 @@ void SceneBuilder::AddLayer(std::shared_ptr<Layer> layer) {
 void SceneBuilder::PushLayer(std::shared_ptr<ContainerLayer> layer) {
   AddLayer(layer);
   layer_stack_.push_back(std::move(layer));
+  pushed_layers_.emplace_back();
 }
 
 void SceneBuilder::PopLayer() {
   // We never pop the root layer, so that AddLayer operations are always valid.
   if (layer_stack_.size() > 1) {
+    if (ShareUnchangedLayers()) {
+      // The pushed layer is the last child of its parent until it is popped.
+      // Using the layer of the last frame instead lets the diff and preroll
+      // recognize the subtree as retained.
+      const PushedLayer& pushed = pushed_layers_.back();
+      const auto& parent = layer_stack_[layer_stack_.size() - 2];
+      parent->ReplaceLayer(parent->layers().size() - 1, pushed.old_layer);
+      pushed.engine_layer->SetLayer(pushed.old_layer);
+    }
     layer_stack_.pop_back();
+    pushed_layers_.pop_back();
+  }
+}
+
+void SceneBuilder::AssignOldLayer(const fml::RefPtr<EngineLayer>& engine_layer,
+                                  const fml::RefPtr<EngineLayer>& old_layer) {
+  if (!old_layer || !old_layer->Layer()) {
+    return;
+  }
+  FML_DCHECK(engine_layer->Layer() == layer_stack_.back());
+  engine_layer->Layer()->AssignOldLayer(old_layer->Layer().get());
+  pushed_layers_.back() = {engine_layer, old_layer->Layer()};
+}
+
+bool SceneBuilder::ShareUnchangedLayers() {
+  const auto& old_layer = pushed_layers_.back().old_layer;
+  if (!old_layer) {
+    return false;
+  }
+  const auto& layer = layer_stack_.back();
+  const auto& children = layer->layers();
+  const auto& old_children = old_layer->layers();
+  bool unchanged = children.size() == old_children.size();
+  for (size_t i = 0; i < std::min(children.size(), old_children.size()); i++) {
+    if (children[i] == old_children[i]) {
+      continue;
+    }
+    // Containers only compare their own properties, and the unchanged ones
+    // were already replaced when they were popped.
+    if (!children[i]->as_container_layer() &&
+        children[i]->IsEquivalentTo(old_children[i].get())) {
+      layer->ReplaceLayer(i, old_children[i]);
+      continue;
+    }
+    unchanged = false;
   }
+  return unchanged && layer->IsEquivalentTo(old_layer.get());
 }
 
 }  // namespace flutter
@@ -130,11 +130,29 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
  private:
   SceneBuilder();
 
+  // The engine layer of a layer on the stack and the layer of the last frame
+  // that it replaces, if any.
+  struct PushedLayer {
+    fml::RefPtr<EngineLayer> engine_layer;
+    std::shared_ptr<ContainerLayer> old_layer;
+  };
+
   void AddLayer(std::shared_ptr<Layer> layer);
   void PushLayer(std::shared_ptr<ContainerLayer> layer);
   void PopLayer();
 
+  // Links the layer pushed last to |old_layer|, the layer it replaces.
+  void AssignOldLayer(const fml::RefPtr<EngineLayer>& engine_layer,
+                      const fml::RefPtr<EngineLayer>& old_layer);
+
+  // Replaces the children of the layer on top of the stack that didn't
+  // change since the last frame by the corresponding children of the layer
+  // it replaces. Returns true if all children and the layer itself didn't
+  // change, in which case the whole layer can be replaced.
+  bool ShareUnchangedLayers();
+
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
+  std::vector<PushedLayer> pushed_layers_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
   bool checkerboard_offscreen_layers_ = false;
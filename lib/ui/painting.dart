@@ -3123,7 +3123,7 @@ base class _NativePath extends NativeFieldWrapperClass1 implements Path {
   @Native<Handle Function(Pointer<Void>)>(symbol: 'Path::getBounds')
   external Float32List _getBounds();
 
-  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32)>(symbol: 'Path::op')
+  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32)>(symbol: 'Path::op', isLeaf: true)
   external bool _op(_NativePath path1, _NativePath path2, int operation);
 
   @override
@@ -6228,6 +6228,166 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Uint32, Double, Bool)>(symbol: 'Canvas::drawShadow')
   external void _drawShadow(_NativePath path, int color, double elevation, bool transparentOccluder);
+
+  void _drawCommandBatch(DrawCommandBatch batch, Paint paint) {
+    _drawCommands(paint._objects, paint._data, batch._commandView);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Canvas::drawCommands')
+  external void _drawCommands(List<Object?>? paintObjects, ByteData paintData, Float32List commands);
+}
+
+/// A list of lines, rectangles, ovals and circles that are drawn together.
+///
+/// Every [Canvas] draw call crosses from Dart into the engine, so custom
+/// painters that draw thousands of small shapes spend much of their time in
+/// those calls. A [DrawCommandBatch] instead encodes the shapes into a single
+/// buffer, which [draw] records in one call.
+///
+/// Shapes are drawn with the [Paint] given to [draw], in the order in which
+/// they were added. [setColor] changes the color of the shapes added after it.
+///
+/// The batch can be drawn any number of times, and reused for other shapes
+/// after calling [clear].
+class DrawCommandBatch {
+  /// Creates an empty batch.
+  DrawCommandBatch() {
+    _allocate(_kInitialCapacity);
+  }
+
+  static const int _kInitialCapacity = 256;
+
+  // Opcodes, which are followed by their arguments in the buffer. They must
+  // match the ones decoded by Canvas::drawCommands in canvas.cc.
+  static const int _kSetColor = 0;
+  static const int _kLine = 1;
+  static const int _kRect = 2;
+  static const int _kOval = 3;
+  static const int _kCircle = 4;
+
+  late Float32List _floats;
+  late Uint32List _words;
+  int _length = 0;
+
+  void _allocate(int capacity) {
+    final ByteBuffer buffer = Uint32List(capacity).buffer;
+    final Float32List floats = buffer.asFloat32List();
+    if (_length > 0) {
+      floats.setRange(0, _length, _floats);
+    }
+    _floats = floats;
+    _words = buffer.asUint32List();
+  }
+
+  int _reserve(int count) {
+    final int start = _length;
+    if (start + count > _floats.length) {
+      _allocate(math.max(_floats.length * 2, start + count));
+    }
+    _length = start + count;
+    return start;
+  }
+
+  Float32List get _commandView => Float32List.sublistView(_floats, 0, _length);
+
+  /// Whether no commands have been added since the batch was created or
+  /// last cleared.
+  bool get isEmpty => _length == 0;
+
+  /// Removes all commands, keeping the buffer for reuse.
+  void clear() {
+    _length = 0;
+  }
+
+  /// Draws the shapes added after this call with the given color, instead of
+  /// the color of the paint.
+  void setColor(Color color) {
+    final int i = _reserve(2);
+    _words[i] = _kSetColor;
+    _words[i + 1] = color.value;
+  }
+
+  /// Adds a line between the given points. See [Canvas.drawLine].
+  void addLine(Offset p1, Offset p2) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    final int i = _reserve(5);
+    _words[i] = _kLine;
+    _floats[i + 1] = p1.dx;
+    _floats[i + 2] = p1.dy;
+    _floats[i + 3] = p2.dx;
+    _floats[i + 4] = p2.dy;
+  }
+
+  /// Adds a rectangle. See [Canvas.drawRect].
+  void addRect(Rect rect) {
+    _addRectCommand(_kRect, rect);
+  }
+
+  /// Adds an axis-aligned oval that fills the given rectangle. See
+  /// [Canvas.drawOval].
+  void addOval(Rect rect) {
+    _addRectCommand(_kOval, rect);
+  }
+
+  void _addRectCommand(int opcode, Rect rect) {
+    assert(_rectIsValid(rect));
+    final int i = _reserve(5);
+    _words[i] = opcode;
+    _floats[i + 1] = rect.left;
+    _floats[i + 2] = rect.top;
+    _floats[i + 3] = rect.right;
+    _floats[i + 4] = rect.bottom;
+  }
+
+  /// Adds a circle. See [Canvas.drawCircle].
+  void addCircle(Offset center, double radius) {
+    assert(_offsetIsValid(center));
+    final int i = _reserve(4);
+    _words[i] = _kCircle;
+    _floats[i + 1] = center.dx;
+    _floats[i + 2] = center.dy;
+    _floats[i + 3] = radius;
+  }
+
+  /// Draws the commands of this batch onto the canvas with the given paint.
+  ///
+  /// Canvases created by the engine record the whole batch at once. Other
+  /// [Canvas] implementations receive one call for each shape.
+  void draw(Canvas canvas, Paint paint) {
+    if (_length == 0) {
+      return;
+    }
+    if (canvas is _NativeCanvas) {
+      canvas._drawCommandBatch(this, paint);
+      return;
+    }
+    final Color paintColor = paint.color;
+    int i = 0;
+    while (i < _length) {
+      switch (_words[i]) {
+        case _kSetColor:
+          paint.color = Color(_words[i + 1]);
+          i += 2;
+        case _kLine:
+          canvas.drawLine(Offset(_floats[i + 1], _floats[i + 2]), Offset(_floats[i + 3], _floats[i + 4]), paint);
+          i += 5;
+        case _kRect:
+          canvas.drawRect(Rect.fromLTRB(_floats[i + 1], _floats[i + 2], _floats[i + 3], _floats[i + 4]), paint);
+          i += 5;
+        case _kOval:
+          canvas.drawOval(Rect.fromLTRB(_floats[i + 1], _floats[i + 2], _floats[i + 3], _floats[i + 4]), paint);
+          i += 5;
+        case _kCircle:
+          canvas.drawCircle(Offset(_floats[i + 1], _floats[i + 2]), _floats[i + 3], paint);
+          i += 4;
+        default:
+          assert(false, 'Unknown draw command ${_words[i]}');
+          i = _length;
+      }
+    }
+    paint.color = paintColor;
+  }
 }
 
 /// Signature for [Picture] lifecycle events.
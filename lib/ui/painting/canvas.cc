@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/canvas.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/lib/ui/floating_point.h"
@@ -540,6 +541,94 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
   }
 }
 
+namespace {
+
+// The opcodes of a DrawCommandBatch, see painting.dart.
+enum class DrawCommand : uint32_t {
+  kSetColor = 0,
+  kLine = 1,
+  kRect = 2,
+  kOval = 3,
+  kCircle = 4,
+};
+
+}  // namespace
+
+void Canvas::drawCommands(Dart_Handle paint_objects,
+                          Dart_Handle paint_data,
+                          const tonic::Float32List& commands) {
+  Paint paint(paint_objects, paint_data);
+
+  FML_DCHECK(paint.isNotNull());
+  if (!display_list_builder_) {
+    return;
+  }
+
+  // Lines ignore the style of the paint, so they get a paint of their own.
+  DlPaint line_paint;
+  paint.paint(line_paint, kDrawLineFlags);
+  DlPaint shape_paint;
+  paint.paint(shape_paint, kDrawRectFlags);
+
+  const float* data = commands.data();
+  const size_t length = commands.num_elements();
+  size_t i = 0;
+  while (i < length) {
+    uint32_t opcode;
+    memcpy(&opcode, &data[i], sizeof(opcode));
+    switch (static_cast<DrawCommand>(opcode)) {
+      case DrawCommand::kSetColor: {
+        if (i + 2 > length) {
+          break;
+        }
+        uint32_t argb;
+        memcpy(&argb, &data[i + 1], sizeof(argb));
+        line_paint.setColor(DlColor(argb));
+        shape_paint.setColor(DlColor(argb));
+        i += 2;
+        continue;
+      }
+      case DrawCommand::kLine:
+        if (i + 5 > length) {
+          break;
+        }
+        builder()->DrawLine(SkPoint::Make(data[i + 1], data[i + 2]),
+                            SkPoint::Make(data[i + 3], data[i + 4]),
+                            line_paint);
+        i += 5;
+        continue;
+      case DrawCommand::kRect:
+        if (i + 5 > length) {
+          break;
+        }
+        builder()->DrawRect(SkRect::MakeLTRB(data[i + 1], data[i + 2],
+                                             data[i + 3], data[i + 4]),
+                            shape_paint);
+        i += 5;
+        continue;
+      case DrawCommand::kOval:
+        if (i + 5 > length) {
+          break;
+        }
+        builder()->DrawOval(SkRect::MakeLTRB(data[i + 1], data[i + 2],
+                                             data[i + 3], data[i + 4]),
+                            shape_paint);
+        i += 5;
+        continue;
+      case DrawCommand::kCircle:
+        if (i + 4 > length) {
+          break;
+        }
+        builder()->DrawCircle(SkPoint::Make(data[i + 1], data[i + 2]),
+                              data[i + 3], shape_paint);
+        i += 4;
+        continue;
+    }
+    FML_DLOG(ERROR) << "Malformed draw command " << opcode << " at " << i;
+    return;
+  }
+}
+
 void Canvas::drawVertices(const Vertices* vertices,
                           DlBlendMode blend_mode,
                           Dart_Handle paint_objects,
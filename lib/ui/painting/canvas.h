@@ -164,6 +164,11 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   DlCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  // Draws the commands encoded by a DrawCommandBatch in painting.dart.
+  void drawCommands(Dart_Handle paint_objects,
+                    Dart_Handle paint_data,
+                    const tonic::Float32List& commands);
+
   void drawVertices(const Vertices* vertices,
                     DlBlendMode blend_mode,
                     Dart_Handle paint_objects,
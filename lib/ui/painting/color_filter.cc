@@ -25,6 +25,7 @@ void ColorFilter::Create(Dart_Handle wrapper) {
 void ColorFilter::initMode(int color, int blend_mode) {
   filter_ = DlBlendColorFilter::Make(static_cast<DlColor>(color),
                                      static_cast<DlBlendMode>(blend_mode));
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ColorFilter::initMatrix(const tonic::Float32List& color_matrix) {
@@ -40,6 +41,7 @@ void ColorFilter::initMatrix(const tonic::Float32List& color_matrix) {
   matrix[14] *= 1.0f / 255;
   matrix[19] *= 1.0f / 255;
   filter_ = DlMatrixColorFilter::Make(matrix);
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ColorFilter::initLinearToSrgbGamma() {
@@ -18,16 +18,24 @@ class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
  public:
   ~EngineLayer() override;
 
-  static void MakeRetained(Dart_Handle dart_handle,
-                           std::shared_ptr<flutter::ContainerLayer> layer) {
+  static fml::RefPtr<EngineLayer> MakeRetained(
+      Dart_Handle dart_handle,
+      std::shared_ptr<flutter::ContainerLayer> layer) {
     auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
     engine_layer->AssociateWithDartWrapper(dart_handle);
+    return engine_layer;
   }
 
   void dispose();
 
   std::shared_ptr<flutter::ContainerLayer> Layer() const { return layer_; }
 
+  // Makes this engine layer refer to the equivalent layer of the last frame
+  // that the scene uses in place of the one it was created with.
+  void SetLayer(std::shared_ptr<flutter::ContainerLayer> layer) {
+    layer_ = std::move(layer);
+  }
+
  private:
   explicit EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer);
   std::shared_ptr<flutter::ContainerLayer> layer_;
@@ -15,6 +15,10 @@
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/entity/contents/runtime_effect_contents.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
@@ -58,8 +62,32 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   if (UIDartState::Current()->IsImpellerEnabled()) {
     runtime_effect_ = DlRuntimeEffect::MakeImpeller(
         std::make_unique<impeller::RuntimeStage>(std::move(runtime_stage)));
+#if IMPELLER_SUPPORTS_RENDERING
+    // Compile the shader ahead of the first frame that draws with it. The
+    // Impeller context is only available on the IO thread, and the runtime
+    // stage has to be warmed up on the raster thread that renders with it.
+    auto dart_state = UIDartState::Current();
+    const auto& task_runners = dart_state->GetTaskRunners();
+    task_runners.GetIOTaskRunner()->PostTask(
+        [io_manager = dart_state->GetIOManager(),
+         raster_task_runner = task_runners.GetRasterTaskRunner(),
+         runtime_stage = runtime_effect_->runtime_stage()]() {
+          auto context = io_manager ? io_manager->GetImpellerContext()
+                                    : nullptr;
+          if (!context) {
+            return;
+          }
+          raster_task_runner->PostTask([context, runtime_stage]() {
+            impeller::RuntimeEffectContents::WarmUp(context, runtime_stage);
+          });
+        });
+#endif  // IMPELLER_SUPPORTS_RENDERING
   } else {
     auto code_mapping = runtime_stage.GetSkSLMapping();
+    if (!code_mapping) {
+      return std::string("Asset '") + asset_name +
+             std::string("' does not contain SkSL.");
+    }
     auto code_size = code_mapping->GetSize();
     const char* sksl =
         reinterpret_cast<const char*>(code_mapping->GetMapping());
@@ -50,6 +50,7 @@ void CanvasGradient::initLinear(const tonic::Float32List& end_points,
   dl_shader_ = DlColorSource::MakeLinear(
       p0, p1, colors.num_elements(), colors_array, color_stops.data(),
       tile_mode, has_matrix ? &sk_matrix : nullptr);
+  dl_shader_ = UIDartState::Current()->InternAttribute(dl_shader_);
   // Just a sanity check, all gradient shaders should be thread-safe
   FML_DCHECK(dl_shader_->isUIThreadSafe());
 }
@@ -79,6 +80,7 @@ void CanvasGradient::initRadial(double center_x,
       SkPoint::Make(SafeNarrow(center_x), SafeNarrow(center_y)),
       SafeNarrow(radius), colors.num_elements(), colors_array,
       color_stops.data(), tile_mode, has_matrix ? &sk_matrix : nullptr);
+  dl_shader_ = UIDartState::Current()->InternAttribute(dl_shader_);
   // Just a sanity check, all gradient shaders should be thread-safe
   FML_DCHECK(dl_shader_->isUIThreadSafe());
 }
@@ -111,6 +113,7 @@ void CanvasGradient::initSweep(double center_x,
       SafeNarrow(end_angle) * 180.0f / static_cast<float>(M_PI),
       colors.num_elements(), colors_array, color_stops.data(), tile_mode,
       has_matrix ? &sk_matrix : nullptr);
+  dl_shader_ = UIDartState::Current()->InternAttribute(dl_shader_);
   // Just a sanity check, all gradient shaders should be thread-safe
   FML_DCHECK(dl_shader_->isUIThreadSafe());
 }
@@ -145,6 +148,7 @@ void CanvasGradient::initTwoPointConical(double start_x,
       SkPoint::Make(SafeNarrow(end_x), SafeNarrow(end_y)),
       SafeNarrow(end_radius), colors.num_elements(), colors_array,
       color_stops.data(), tile_mode, has_matrix ? &sk_matrix : nullptr);
+  dl_shader_ = UIDartState::Current()->InternAttribute(dl_shader_);
   // Just a sanity check, all gradient shaders should be thread-safe
   FML_DCHECK(dl_shader_->isUIThreadSafe());
 }
@@ -208,12 +208,18 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     return DecompressResult{.decode_error = decode_error};
   }
 
+  // Only the bitmap that is uploaded needs to live in a device buffer. When
+  // the decoded image still has to be resized, it is decoded into the heap
+  // instead, and raw pixels are resized straight from the descriptor.
+  const bool needs_resize = decode_size != target_size;
+
   auto bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
 
   if (descriptor->is_compressed()) {
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    if (!(needs_resize ? bitmap->tryAllocPixels()
+                       : bitmap->tryAllocPixels(bitmap_allocator.get()))) {
       std::string decode_error(
           "Could not allocate intermediate for image decompression.");
       FML_DLOG(ERROR) << decode_error;
@@ -232,17 +238,22 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
         base_image_info, descriptor->row_bytes(), descriptor->data());
     temp_bitmap->setPixelRef(pixel_ref, 0, 0);
 
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
-      std::string decode_error(
-          "Could not allocate intermediate for pixel conversion.");
-      FML_DLOG(ERROR) << decode_error;
-      return DecompressResult{.decode_error = decode_error};
+    if (needs_resize) {
+      // Scaling converts the pixels too.
+      bitmap = std::move(temp_bitmap);
+    } else {
+      if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+        std::string decode_error(
+            "Could not allocate intermediate for pixel conversion.");
+        FML_DLOG(ERROR) << decode_error;
+        return DecompressResult{.decode_error = decode_error};
+      }
+      temp_bitmap->readPixels(bitmap->pixmap());
     }
-    temp_bitmap->readPixels(bitmap->pixmap());
     bitmap->setImmutable();
   }
 
-  if (bitmap->dimensions() == target_size) {
+  if (!needs_resize) {
     auto buffer = bitmap_allocator->GetDeviceBuffer();
     if (!buffer) {
       return DecompressResult{.decode_error = "Unable to get device buffer"};
@@ -339,7 +350,7 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   }
 
   blit_pass->EncodeCommands(context->GetResourceAllocator());
-  if (!command_buffer->SubmitCommands()) {
+  if (!context->EnqueueCommandBuffer(std::move(command_buffer))) {
     std::string decode_error("Failed to submit blit pass command buffer.");
     FML_DLOG(ERROR) << decode_error;
     return std::make_pair(nullptr, decode_error);
@@ -510,6 +521,18 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
+        // Images decoded by the platform into GPU memory and block compressed
+        // textures are sampled from directly unless they have to be resized.
+        if (!raw_descriptor->should_resize(target_size.width(),
+                                           target_size.height()) &&
+            target_size.width() <= max_size_supported.width &&
+            target_size.height() <= max_size_supported.height) {
+          if (auto image = raw_descriptor->get_hardware_image(context)) {
+            result(image, {});
+            return;
+          }
+        }
+
         // Always decompress on the concurrent runner.
         auto bitmap_result = DecompressTexture(
             raw_descriptor, target_size, max_size_supported,
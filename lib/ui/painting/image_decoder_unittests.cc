@@ -397,6 +397,34 @@ TEST_F(ImageDecoderFixtureTest, ImpellerPixelConversion32F) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerResizesPixelsIntoTheDeviceBuffer) {
+  auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_8888_SkColorType,
+                                SkAlphaType::kPremul_SkAlphaType);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info, 10 * 4);
+  bitmap.eraseColor(SK_ColorRED);
+  auto data = SkData::MakeWithCopy(bitmap.getPixels(), 10 * 10 * 4);
+
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(std::move(data), info, 10 * 4);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  std::optional<DecompressResult> decompressed =
+      ImageDecoderImpeller::DecompressTexture(
+          descriptor.get(), SkISize::Make(5, 5), {100, 100},
+          /*supports_wide_gamut=*/false, allocator);
+
+  ASSERT_TRUE(decompressed.has_value());
+  ASSERT_TRUE(decompressed->device_buffer);
+  ASSERT_EQ(decompressed->image_info.dimensions(), SkISize::Make(5, 5));
+  ASSERT_EQ(decompressed->sk_bitmap->getAddr(0, 0),
+            decompressed->device_buffer->OnGetContents());
+  ASSERT_EQ(decompressed->sk_bitmap->getColor(2, 2), SK_ColorRED);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ImpellerWideGamutDisplayP3Opaque) {
   auto data = OpenFixtureAsSkData("DisplayP3Logo.jpg");
   auto image = SkImages::DeferredFromEncodedData(data);
@@ -732,6 +760,45 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderTest, KTX2BlockCompressedTexturesAreNotDecoded) {
+#if !IMPELLER_SUPPORTS_RENDERING
+  GTEST_SKIP() << "Impeller only test.";
+#else
+  // A 6x5 ASTC 4x4 texture takes 2x2 blocks of 16 bytes.
+  constexpr uint32_t kHeaderSize = 80;
+  constexpr uint32_t kLevelSize = 2 * 2 * 16;
+  std::vector<uint8_t> bytes(kHeaderSize + 24 + kLevelSize);
+  const uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                  0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  const uint32_t fields[9] = {/*vkFormat=*/157, /*typeSize=*/1,
+                              /*pixelWidth=*/6, /*pixelHeight=*/5,
+                              /*pixelDepth=*/0, /*layerCount=*/0,
+                              /*faceCount=*/1,  /*levelCount=*/1,
+                              /*supercompressionScheme=*/0};
+  const uint64_t level_index[3] = {kHeaderSize + 24, kLevelSize, kLevelSize};
+  memcpy(bytes.data(), identifier, sizeof(identifier));
+  memcpy(bytes.data() + 12, fields, sizeof(fields));
+  memcpy(bytes.data() + kHeaderSize, level_index, sizeof(level_index));
+
+  ImageGeneratorRegistry registry;
+  auto generator = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(bytes.data(), bytes.size()));
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().width(), 6);
+  EXPECT_EQ(generator->GetInfo().height(), 5);
+  EXPECT_FALSE(generator->GetPixels(generator->GetInfo(), nullptr, 0));
+
+  // The test context doesn't support any texture compression.
+  std::shared_ptr<impeller::Context> context =
+      std::make_shared<impeller::TestImpellerContext>();
+  EXPECT_EQ(generator->GetHardwareImage(context), nullptr);
+
+  // A base level that doesn't cover the whole texture is rejected.
+  auto truncated = SkData::MakeWithCopy(bytes.data(), bytes.size() - 1);
+  EXPECT_EQ(registry.CreateCompatibleGenerator(truncated), nullptr);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   auto data = OpenFixtureAsSkData("heart_end.png");
   ASSERT_TRUE(data);
@@ -110,6 +110,17 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets this image as a texture that wraps the memory it was decoded
+  ///         into, if backed by an `ImageGenerator` that decodes on the GPU.
+  /// @see    `ImageGenerator::GetHardwareImage`
+  sk_sp<DlImage> get_hardware_image(
+      const std::shared_ptr<impeller::Context>& context) const {
+    if (generator_) {
+      return generator_->GetHardwareImage(context);
+    }
+    return nullptr;
+  }
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -56,32 +56,38 @@ void ImageFilter::initBlur(double sigma_x,
                            DlTileMode tile_mode) {
   filter_ = DlBlurImageFilter::Make(SafeNarrow(sigma_x), SafeNarrow(sigma_y),
                                     tile_mode);
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ImageFilter::initDilate(double radius_x, double radius_y) {
   filter_ =
       DlDilateImageFilter::Make(SafeNarrow(radius_x), SafeNarrow(radius_y));
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ImageFilter::initErode(double radius_x, double radius_y) {
   filter_ =
       DlErodeImageFilter::Make(SafeNarrow(radius_x), SafeNarrow(radius_y));
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ImageFilter::initMatrix(const tonic::Float64List& matrix4,
                              int filterQualityIndex) {
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
   filter_ = DlMatrixImageFilter::Make(ToSkMatrix(matrix4), sampling);
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ImageFilter::initColorFilter(ColorFilter* colorFilter) {
   FML_DCHECK(colorFilter);
   filter_ = DlColorFilterImageFilter::Make(colorFilter->filter());
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 void ImageFilter::initComposeFilter(ImageFilter* outer, ImageFilter* inner) {
   FML_DCHECK(outer && inner);
   filter_ = DlComposeImageFilter::Make(outer->filter(), inner->filter());
+  filter_ = UIDartState::Current()->InternAttribute(filter_);
 }
 
 }  // namespace flutter
@@ -16,6 +16,11 @@ namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+sk_sp<DlImage> ImageGenerator::GetHardwareImage(
+    const std::shared_ptr<impeller::Context>& context) {
+  return nullptr;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <memory>
 #include <optional>
+
+#include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
@@ -15,6 +18,10 @@
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkSize.h"
 
+namespace impeller {
+class Context;
+}  // namespace impeller
+
 namespace flutter {
 
 /// @brief  The minimal interface necessary for defining a decoder that can be
@@ -135,6 +142,17 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Wrap the decoded image in an Impeller texture without copying
+  ///             it, for decoders that decode straight into memory the GPU can
+  ///             sample from, such as a hardware buffer.
+  /// @param[in]  context  The Impeller context to create the texture with.
+  /// @return     The full-sized image, or null if the decoder decoded into CPU
+  ///             memory, in which case `GetPixels` should be used instead.
+  /// @note       This method is executed on the concurrent worker threads, and
+  ///             is only attempted when the image doesn't need to be resized.
+  virtual sk_sp<DlImage> GetHardwareImage(
+      const std::shared_ptr<impeller::Context>& context);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -7,6 +7,7 @@
 #include <cstring>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/pixel_conversions.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
@@ -132,29 +133,7 @@ bool APNGImageGenerator::GetPixels(const SkImageInfo& info,
 
   // Regardless of the byte order (RGBA vs BGRA), the blending operations are
   // the same.
-  struct Pixel {
-    uint8_t channel[4];
-
-    uint8_t GetAlpha() { return channel[3]; }
-
-    void Premultiply() {
-      for (int i = 0; i < 3; i++) {
-        channel[i] = channel[i] * GetAlpha() / 0xFF;
-      }
-    }
-
-    void Unpremultiply() {
-      if (GetAlpha() == 0) {
-        channel[0] = channel[1] = channel[2] = 0;
-        return;
-      }
-      for (int i = 0; i < 3; i++) {
-        channel[i] = channel[i] * 0xFF / GetAlpha();
-      }
-    }
-  };
-
-  FML_DCHECK(frame_info.bytesPerPixel() == sizeof(Pixel));
+  FML_DCHECK(frame_info.bytesPerPixel() == 4);
 
   bool result = true;
 
@@ -170,39 +149,34 @@ bool APNGImageGenerator::GetPixels(const SkImageInfo& info,
     }
   } else if (frame.frame_info->blend_mode ==
              SkCodecAnimation::Blend::kSrcOver) {
+    const size_t width = frame_info.width();
+    // The decoded frame is kept for later, premultiply a copy of each row.
+    std::vector<uint8_t> premultiplied_src_row;
+    if (frame_info.alphaType() == kUnpremul_SkAlphaType) {
+      premultiplied_src_row.resize(frame_row_bytes);
+    }
     for (int y = 0; y < frame_info.height(); y++) {
-      auto src_row = frame.pixels.data() + y * frame_row_bytes;
-      auto dst_row = static_cast<uint8_t*>(pixels) +
-                     (y + frame.y_offset) * row_bytes +
-                     frame.x_offset * frame_info.bytesPerPixel();
-
-      for (int x = 0; x < frame_info.width(); x++) {
-        auto x_offset_bytes = x * frame_info.bytesPerPixel();
-
-        Pixel src = *reinterpret_cast<Pixel*>(src_row + x_offset_bytes);
-        Pixel* dst_p = reinterpret_cast<Pixel*>(dst_row + x_offset_bytes);
-        Pixel dst = *dst_p;
-
-        // Ensure both colors are premultiplied for the blending operation.
-        if (info.alphaType() == kUnpremul_SkAlphaType) {
-          dst.Premultiply();
-        }
-        if (frame_info.alphaType() == kUnpremul_SkAlphaType) {
-          src.Premultiply();
-        }
-
-        for (int i = 0; i < 4; i++) {
-          dst.channel[i] =
-              src.channel[i] + dst.channel[i] * (0xFF - src.GetAlpha()) / 0xFF;
-        }
-
-        // The final color is premultiplied. Unpremultiply to match the
-        // backdrop surface if necessary.
-        if (info.alphaType() == kUnpremul_SkAlphaType) {
-          dst.Unpremultiply();
-        }
-
-        *dst_p = dst;
+      const uint8_t* src_row = frame.pixels.data() + y * frame_row_bytes;
+      uint8_t* dst_row = static_cast<uint8_t*>(pixels) +
+                         (y + frame.y_offset) * row_bytes +
+                         frame.x_offset * frame_info.bytesPerPixel();
+
+      // Ensure both colors are premultiplied for the blending operation.
+      if (!premultiplied_src_row.empty()) {
+        fml::PremultiplyPixels8888(src_row, premultiplied_src_row.data(),
+                                   width);
+        src_row = premultiplied_src_row.data();
+      }
+      if (info.alphaType() == kUnpremul_SkAlphaType) {
+        fml::PremultiplyPixels8888(dst_row, dst_row, width);
+      }
+
+      fml::BlendSrcOverPremul8888(src_row, dst_row, width);
+
+      // The final color is premultiplied. Unpremultiply to match the
+      // backdrop surface if necessary.
+      if (info.alphaType() == kUnpremul_SkAlphaType) {
+        fml::UnpremultiplyPixels8888(dst_row, dst_row, width);
       }
     }
   }
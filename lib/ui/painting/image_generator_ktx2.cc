@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/impeller/base/strings.h"
+#include "flutter/impeller/core/allocator.h"
+#include "flutter/impeller/core/texture.h"
+#include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/renderer/capabilities.h"
+#include "flutter/impeller/renderer/context.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+namespace flutter {
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(sk_sp<SkData> data,
+                                       const SkImageInfo& image_info,
+                                       impeller::PixelFormat format,
+                                       size_t base_level_offset,
+                                       size_t base_level_length)
+    : data_(std::move(data)),
+      image_info_(image_info),
+      format_(format),
+      base_level_offset_(base_level_offset),
+      base_level_length_(base_level_length) {}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  // The blocks are only ever decoded by the GPU.
+  return false;
+}
+
+sk_sp<DlImage> KTX2ImageGenerator::GetHardwareImage(
+    const std::shared_ptr<impeller::Context>& context) {
+  if (!context || !context->GetCapabilities()) {
+    return nullptr;
+  }
+  const auto& capabilities = context->GetCapabilities();
+  bool supported = false;
+  switch (format_) {
+    case impeller::PixelFormat::kASTC4x4UNormInt:
+      supported = capabilities->SupportsTextureCompressionASTC();
+      break;
+    case impeller::PixelFormat::kETC2R8G8B8A8UNormInt:
+      supported = capabilities->SupportsTextureCompressionETC2();
+      break;
+    case impeller::PixelFormat::kBC7UNormInt:
+      supported = capabilities->SupportsTextureCompressionBC();
+      break;
+    default:
+      break;
+  }
+  if (!supported) {
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor desc;
+  // Metal can only replace the contents of textures the CPU can access.
+  desc.storage_mode =
+      context->GetBackendType() == impeller::Context::BackendType::kMetal
+          ? impeller::StorageMode::kHostVisible
+          : impeller::StorageMode::kDevicePrivate;
+  desc.size = {image_info_.width(), image_info_.height()};
+  desc.format = format_;
+  desc.mip_count = 1;
+
+  auto texture = context->GetResourceAllocator()->CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+
+  const uint8_t* base_level = data_->bytes() + base_level_offset_;
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      base_level, base_level_length_, [data = data_](auto, auto) {});
+  if (!texture->SetContents(std::move(mapping))) {
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
+std::optional<impeller::PixelFormat> KTX2ImageGenerator::ToPixelFormat(
+    uint32_t vk_format) {
+  // The transfer function isn't applied when sampling, like it isn't for the
+  // decoded images either.
+  switch (vk_format) {
+    case kASTC4x4UnormBlock:
+    case kASTC4x4SrgbBlock:
+      return impeller::PixelFormat::kASTC4x4UNormInt;
+    case kETC2R8G8B8A8UnormBlock:
+    case kETC2R8G8B8A8SrgbBlock:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormInt;
+    case kBC7UnormBlock:
+    case kBC7SrgbBlock:
+      return impeller::PixelFormat::kBC7UNormInt;
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < sizeof(Header) + sizeof(LevelIndex)) {
+    return nullptr;
+  }
+  Header header;
+  std::memcpy(&header, data->bytes(), sizeof(header));
+  if (std::memcmp(header.identifier, kKTX2Identifier,
+                  sizeof(kKTX2Identifier)) != 0) {
+    return nullptr;
+  }
+
+  const uint32_t width = fml::LittleEndianToArch(header.pixel_width);
+  const uint32_t height = fml::LittleEndianToArch(header.pixel_height);
+  // Arrays, cube maps, 3D textures and supercompressed levels aren't
+  // supported. Only the base level is uploaded, whatever the level count.
+  if (width == 0u || height == 0u ||
+      width > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()) ||
+      height > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()) ||
+      fml::LittleEndianToArch(header.pixel_depth) > 1u ||
+      fml::LittleEndianToArch(header.layer_count) > 1u ||
+      fml::LittleEndianToArch(header.face_count) != 1u ||
+      fml::LittleEndianToArch(header.supercompression_scheme) != 0u) {
+    return nullptr;
+  }
+  auto format = ToPixelFormat(fml::LittleEndianToArch(header.vk_format));
+  if (!format.has_value()) {
+    return nullptr;
+  }
+
+  // The first entry of the level index describes the base level.
+  LevelIndex base_level;
+  std::memcpy(&base_level, data->bytes() + sizeof(Header), sizeof(base_level));
+  const uint64_t offset = fml::LittleEndianToArch(base_level.byte_offset);
+  const uint64_t length = fml::LittleEndianToArch(base_level.byte_length);
+  impeller::TextureDescriptor desc;
+  desc.size = {static_cast<int64_t>(width), static_cast<int64_t>(height)};
+  desc.format = format.value();
+  if (length != desc.GetByteSizeOfBaseMipLevel() || offset > data->size() ||
+      length > data->size() - offset) {
+    return nullptr;
+  }
+
+  const SkImageInfo image_info =
+      SkImageInfo::Make(width, height, kRGBA_8888_SkColorType,
+                        kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+  return std::unique_ptr<KTX2ImageGenerator>(new KTX2ImageGenerator(
+      std::move(data), image_info, format.value(), offset, length));
+}
+
+}  // namespace flutter
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include "flutter/impeller/core/formats.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Reads KTX2 containers that hold a texture in a block compressed
+///             format the GPU can sample from directly, so that the blocks
+///             are uploaded as they are instead of being decoded to RGBA.
+///
+///             Only the base level of non-supercompressed 2D textures in the
+///             ASTC 4x4, ETC2 RGBA8 and BC7 formats is supported. Whether the
+///             format can be used depends on the device, and these images
+///             can't be decoded into CPU memory, so decoding them fails on
+///             devices without support for the format and when they have to
+///             be resized.
+///
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  sk_sp<DlImage> GetHardwareImage(
+      const std::shared_ptr<impeller::Context>& context) override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  static constexpr uint8_t kKTX2Identifier[12] = {
+      0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+  // The values of VkFormat used by the supported formats.
+  enum VulkanFormat : uint32_t {
+    kBC7UnormBlock = 145,
+    kBC7SrgbBlock = 146,
+    kETC2R8G8B8A8UnormBlock = 151,
+    kETC2R8G8B8A8SrgbBlock = 152,
+    kASTC4x4UnormBlock = 157,
+    kASTC4x4SrgbBlock = 158,
+  };
+
+  struct __attribute__((packed, aligned(1))) Header {
+    uint8_t identifier[12];
+    uint32_t vk_format;
+    uint32_t type_size;
+    uint32_t pixel_width;
+    uint32_t pixel_height;
+    uint32_t pixel_depth;
+    uint32_t layer_count;
+    uint32_t face_count;
+    uint32_t level_count;
+    uint32_t supercompression_scheme;
+    uint32_t dfd_byte_offset;
+    uint32_t dfd_byte_length;
+    uint32_t kvd_byte_offset;
+    uint32_t kvd_byte_length;
+    uint64_t sgd_byte_offset;
+    uint64_t sgd_byte_length;
+  };
+
+  struct __attribute__((packed, aligned(1))) LevelIndex {
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+  };
+
+  const sk_sp<SkData> data_;
+  const SkImageInfo image_info_;
+  const impeller::PixelFormat format_;
+  const size_t base_level_offset_;
+  const size_t base_level_length_;
+
+  KTX2ImageGenerator(sk_sp<SkData> data,
+                     const SkImageInfo& image_info,
+                     impeller::PixelFormat format,
+                     size_t base_level_offset,
+                     size_t base_level_length);
+
+  static std::optional<impeller::PixelFormat> ToPixelFormat(
+      uint32_t vk_format);
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
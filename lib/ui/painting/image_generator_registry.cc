@@ -15,6 +15,9 @@
 #endif
 
 #include "image_generator_apng.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "image_generator_ktx2.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 namespace flutter {
 
@@ -25,6 +28,14 @@ ImageGeneratorRegistry::ImageGeneratorRegistry() : weak_factory_(this) {
       },
       0);
 
+#if IMPELLER_SUPPORTS_RENDERING
+  AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return KTX2ImageGenerator::MakeFromData(std::move(buffer));
+      },
+      0);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   AddFactory(
       [](sk_sp<SkData> buffer) {
         return BuiltinSkiaCodecImageGenerator::MakeFromData(std::move(buffer));
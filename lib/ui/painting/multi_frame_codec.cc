@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -54,61 +55,92 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
+bool MultiFrameCodec::State::AllocateFrame(const SkImageInfo& info,
+                                           SkBitmap& bitmap) {
+  while (!framePool_.empty()) {
+    bitmap = std::move(framePool_.back());
+    framePool_.pop_back();
+    if (bitmap.info() == info) {
+      return true;
+    }
+  }
+  bitmap = SkBitmap();
+  return bitmap.tryAllocPixels(info);
+}
+
+void MultiFrameCodec::State::RecycleFrame(const SkBitmap& bitmap) {
+  // Only buffers that no image or stored frame still reads from can be
+  // decoded into again.
+  if (bitmap.pixelRef() == nullptr || !bitmap.pixelRef()->unique() ||
+      framePool_.size() >= kMaxPooledFrameCount) {
+    return;
+  }
+  framePool_.push_back(bitmap);
+}
+
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  const int frameIndex = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  DecodedFrame frame;
+  SkBitmap& bitmap = frame.bitmap;
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
     SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
     info = updated;
   }
-  if (!bitmap.tryAllocPixels(info)) {
+  const bool reused = !framePool_.empty();
+  if (!AllocateFrame(info, bitmap)) {
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
 
-  if (requiredFrameIndex != SkCodec::kNoFrame) {
+  if (requiredFrameIndex != SkCodec::kNoFrame &&
+      lastRequiredFrame_.has_value()) {
     // We are here when the frame said |disposal_method| is
     // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
-    if (!lastRequiredFrame_.has_value()) {
+    // Copy the previous frame's output buffer into the current frame as the
+    // starting point.
+    bitmap.writePixels(lastRequiredFrame_->pixmap());
+    if (restoreBGColorRect_.has_value()) {
+      bitmap.erase(SK_ColorTRANSPARENT, restoreBGColorRect_.value());
+    }
+  } else {
+    if (requiredFrameIndex != SkCodec::kNoFrame) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
-    } else {
-      // Copy the previous frame's output buffer into the current frame as the
-      // starting point.
-      bitmap.writePixels(lastRequiredFrame_->pixmap());
-      if (restoreBGColorRect_.has_value()) {
-        bitmap.erase(SK_ColorTRANSPARENT, restoreBGColorRect_.value());
-      }
+    }
+    if (reused) {
+      // Clear what a previous frame left in the reused buffer.
+      bitmap.eraseColor(SK_ColorTRANSPARENT);
     }
   }
 
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frameIndex;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    RecycleFrame(bitmap);
+    bitmap.reset();
+    return frame;
   }
 
   const bool keep_current_frame =
@@ -127,13 +159,20 @@ MultiFrameCodec::State::GetNextFrameImage(
   //   again. If there isn't already a stored frame, that means we haven't
   //   rendered any frames yet! When this happens, we just fall back to "Keep"
   //   behavior and store the current frame as the backdrop of the next frame.
+  //
+  // The stored frame stays on the CPU. It is only ever copied into the next
+  // frame's buffer, and the frames are uploaded as they are requested.
 
   if (keep_current_frame ||
       (previous_frame_available && !restore_previous_frame)) {
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
+    std::optional<SkBitmap> replaced = std::move(lastRequiredFrame_);
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
+    if (replaced.has_value()) {
+      RecycleFrame(replaced.value());
+    }
   }
 
   if (frameInfo.disposal_method ==
@@ -143,6 +182,16 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  frame.duration = frameInfo.duration;
+  return frame;
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -190,21 +239,32 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id,
     const std::shared_ptr<impeller::Context>& impeller_context) {
+  DecodedFrame frame;
+  if (decodedFrames_.empty()) {
+    frame = DecodeNextFrame();
+  } else {
+    frame = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+  }
+
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
-  if (dlImage) {
-    image = CanvasImage::Create();
-    image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+  std::string decode_error = std::move(frame.decode_error);
+  if (decode_error.empty()) {
+    sk_sp<DlImage> dlImage;
+    std::tie(dlImage, decode_error) =
+        UploadFrame(frame.bitmap, std::move(resourceContext),
+                    gpu_disable_sync_switch, impeller_context,
+                    std::move(unref_queue));
+    if (dlImage) {
+      image = CanvasImage::Create();
+      image->set_image(dlImage);
+      duration = frame.duration;
+    }
+    // The upload copied the pixels, unless it still holds on to them.
+    RecycleFrame(frame.bitmap);
+    frame.bitmap.reset();
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -214,6 +274,12 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
         InvokeNextFrameCallback(image, duration, decode_error,
                                 std::move(callback), trace_id);
       }));
+
+  // Decode the following frames while this one is being displayed, so that
+  // the next request only has to upload them.
+  while (frameCount_ > 1 && decodedFrames_.size() < kDecodeAheadFrameCount) {
+    decodedFrames_.push_back(DecodeNextFrame());
+  }
 }
 
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
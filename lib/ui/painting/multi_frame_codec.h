@@ -9,7 +9,11 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 using tonic::DartPersistentValue;
 
@@ -48,9 +52,26 @@ class MultiFrameCodec : public Codec {
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
 
+    // The number of frames that are decoded ahead of the one requested by
+    // `getNextFrame`, once the requested frame has been handed to the UI task
+    // runner.
+    static constexpr size_t kDecodeAheadFrameCount = 1;
+
+    // The number of frame buffers that are kept around to decode subsequent
+    // frames into.
+    static constexpr size_t kMaxPooledFrameCount = 2;
+
+    // A frame decoded on the IO task runner that hasn't been uploaded yet.
+    struct DecodedFrame {
+      SkBitmap bitmap;
+      int duration = 0;
+      std::string decode_error;
+    };
+
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
+    // The index of the next frame to decode.
     int nextFrameIndex_;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
@@ -61,7 +82,20 @@ class MultiFrameCodec : public Codec {
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // The frames that have been decoded ahead, in order.
+    std::deque<DecodedFrame> decodedFrames_;
+
+    // Frame buffers whose pixels are no longer referenced by any image.
+    std::vector<SkBitmap> framePool_;
+
+    DecodedFrame DecodeNextFrame();
+
+    bool AllocateFrame(const SkImageInfo& info, SkBitmap& bitmap);
+
+    void RecycleFrame(const SkBitmap& bitmap);
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -778,6 +778,19 @@ class PlatformDispatcher {
   @Native<Void Function()>(symbol: 'PlatformConfigurationNativeApi::ScheduleFrame')
   external static void _scheduleFrame();
 
+  /// Requests that frames be produced at about `frameRate` frames per second,
+  /// for example because the animations on screen only change that often, or
+  /// withdraws the request if `frameRate` is 0.
+  ///
+  /// This is a hint for platforms whose displays can vary their refresh rate,
+  /// such as iPhones with ProMotion displays. The engine combines it with the
+  /// rate of external textures, such as videos, and the display may still run
+  /// at a different rate. Other platforms ignore it.
+  void requestFrameRate(double frameRate) => _requestFrameRate(frameRate);
+
+  @Native<Void Function(Double)>(symbol: 'PlatformConfigurationNativeApi::RequestFrameRate')
+  external static void _requestFrameRate(double frameRate);
+
   /// Additional accessibility features that may be enabled by the platform.
   AccessibilityFeatures get accessibilityFeatures => _configuration.accessibilityFeatures;
 
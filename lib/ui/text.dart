@@ -3141,7 +3141,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   // Redirecting the paint function in this way solves some dependency problems
   // in the C++ code. If we straighten out the C++ dependencies, we can remove
   // this indirection.
-  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Paragraph::paint')
+  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Paragraph::paint', isLeaf: true)
   external void _paint(_NativeCanvas canvas, double x, double y);
 
   @override
@@ -3506,7 +3506,7 @@ base class _NativeParagraphBuilder extends NativeFieldWrapperClass1 implements P
     _placeholderScales.add(scale);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder')
+  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder', isLeaf: true)
   external void _addPlaceholder(double width, double height, int alignment, double baselineOffset, int baseline);
 
   @override
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkString.h"
@@ -65,6 +66,13 @@ void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
   family_it->second->registerAsset(asset);
 }
 
+void AssetManagerFontProvider::PreloadTypefaces(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  for (const auto& family : registered_families_) {
+    family.second->preloadTypefaces(task_runner);
+  }
+}
+
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
     std::shared_ptr<AssetManager> asset_manager,
     std::string family_name)
@@ -74,10 +82,23 @@ AssetManagerFontStyleSet::AssetManagerFontStyleSet(
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
 void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
+  std::scoped_lock lock(mutex_);
   assets_.emplace_back(asset);
 }
 
+void AssetManagerFontStyleSet::preloadTypefaces(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  const int asset_count = count();
+  for (int index = 0; index < asset_count; index++) {
+    task_runner->PostTask([style_set = sk_ref_sp(this), index]() {
+      TRACE_EVENT0("flutter", "AssetManagerFontStyleSet::PreloadTypeface");
+      style_set->createTypeface(index);
+    });
+  }
+}
+
 int AssetManagerFontStyleSet::count() {
+  std::scoped_lock lock(mutex_);
   return assets_.size();
 }
 
@@ -98,34 +119,55 @@ void AssetManagerFontStyleSet::getStyle(int index,
 
 auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
   size_t index = i;
-  if (index >= assets_.size()) {
+  std::string asset_name;
+  {
+    std::scoped_lock lock(mutex_);
+    if (index >= assets_.size()) {
+      return nullptr;
+    }
+    if (assets_[index].typeface) {
+      return CreateTypefaceRet(SkRef(assets_[index].typeface.get()));
+    }
+    asset_name = assets_[index].asset;
+  }
+
+  // Parsing the font takes a while, so it is done without holding the lock.
+  // If the typeface is being preloaded at the same time, the first one to
+  // finish is kept.
+  sk_sp<SkTypeface> typeface = LoadTypeface(asset_name);
+  if (!typeface) {
     return nullptr;
   }
 
+  std::scoped_lock lock(mutex_);
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
-    if (asset_mapping == nullptr) {
-      return nullptr;
-    }
+    asset.typeface = std::move(typeface);
+  }
+  return CreateTypefaceRet(SkRef(asset.typeface.get()));
+}
 
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    // Ownership of the stream is transferred.
-    asset.typeface = SkTypeface::MakeFromStream(std::move(stream));
-    if (!asset.typeface) {
-      FML_DLOG(ERROR) << "Unable to load font asset for family: "
-                      << family_name_;
-      return nullptr;
-    }
+sk_sp<SkTypeface> AssetManagerFontStyleSet::LoadTypeface(
+    const std::string& asset) const {
+  std::unique_ptr<fml::Mapping> asset_mapping =
+      asset_manager_->GetAsMapping(asset);
+  if (asset_mapping == nullptr) {
+    return nullptr;
   }
 
-  return CreateTypefaceRet(SkRef(asset.typeface.get()));
+  fml::Mapping* asset_mapping_ptr = asset_mapping.release();
+  sk_sp<SkData> asset_data = SkData::MakeWithProc(
+      asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
+      MappingReleaseProc, asset_mapping_ptr);
+  std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
+
+  // Ownership of the stream is transferred.
+  sk_sp<SkTypeface> typeface = SkTypeface::MakeFromStream(std::move(stream));
+  if (!typeface) {
+    FML_DLOG(ERROR) << "Unable to load font asset for family: "
+                    << family_name_;
+  }
+  return typeface;
 }
 
 auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
@@ -6,11 +6,13 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkTypeface.h"
@@ -27,6 +29,11 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   void registerAsset(const std::string& asset);
 
+  // Loads the typefaces of the family that haven't been loaded yet on
+  // `task_runner`.
+  void preloadTypefaces(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner);
+
   // |SkFontStyleSet|
   int count() override;
 
@@ -57,8 +64,12 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
     std::string asset;
     sk_sp<SkTypeface> typeface;
   };
+  // Guards the typefaces, which may be loaded on worker threads.
+  std::mutex mutex_;
   std::vector<TypefaceAsset> assets_;
 
+  sk_sp<SkTypeface> LoadTypeface(const std::string& asset) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
@@ -71,6 +82,11 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   void RegisterAsset(const std::string& family_name, const std::string& asset);
 
+  // Starts loading every registered typeface on `task_runner`, so that the
+  // first frames that use them don't wait for the font files to be parsed.
+  void PreloadTypefaces(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner);
+
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
 
@@ -62,7 +62,8 @@ void FontCollection::SetupDefaultFontManager(
 //
 // Structure described in https://docs.flutter.dev/cookbook/design/fonts
 void FontCollection::RegisterFonts(
-    const std::shared_ptr<AssetManager>& asset_manager) {
+    const std::shared_ptr<AssetManager>& asset_manager,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& preload_task_runner) {
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
@@ -116,6 +117,10 @@ void FontCollection::RegisterFonts(
     }
   }
 
+  if (preload_task_runner) {
+    font_provider->PreloadTypefaces(preload_task_runner);
+  }
+
   collection_->SetAssetFontManager(
       sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
 }
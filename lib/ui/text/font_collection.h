@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -26,7 +27,13 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
-  void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager);
+  // Registers the fonts listed in the font manifest of the assets. If a
+  // `preload_task_runner` is given, the typefaces are loaded on it right away
+  // instead of when text first uses them.
+  void RegisterFonts(
+      const std::shared_ptr<AssetManager>& asset_manager,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& preload_task_runner =
+          nullptr);
 
   void RegisterTestFonts();
 
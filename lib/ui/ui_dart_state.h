@@ -12,6 +12,7 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/display_list/utils/dl_attribute_interner.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/io_manager.h"
@@ -99,6 +100,11 @@ class UIDartState : public tonic::DartState {
 
     /// Whether Impeller is enabled or not.
     bool enable_impeller = false;
+
+    /// Gives the equal shaders and filters created by the framework one
+    /// shared instance, so caches keyed on them hit across frames. May be
+    /// null, in which case attributes are not interned.
+    std::shared_ptr<DlAttributeInterner> attribute_interner;
   };
 
   Dart_Port main_port() const { return main_port_; }
@@ -132,6 +138,16 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<VolatilePathTracker> GetVolatilePathTracker() const;
 
+  /// Returns the canonical instance of |attribute| if the engine interns
+  /// DisplayList attributes, or |attribute| itself otherwise.
+  template <class T>
+  std::shared_ptr<T> InternAttribute(std::shared_ptr<T> attribute) const {
+    if (!context_.attribute_interner) {
+      return attribute;
+    }
+    return context_.attribute_interner->Intern(std::move(attribute));
+  }
+
   std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const;
 
   fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
@@ -65,6 +65,18 @@ class PlatformConfigurationClient {
   ///
   virtual void ScheduleFrame() = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Requests that frames be produced at about the given rate,
+  ///             for example because the animations on screen only change
+  ///             that often. A rate of 0 withdraws the request.
+  ///
+  ///             The request is a hint that platforms with variable refresh
+  ///             rate displays use to pick their refresh rate.
+  ///
+  /// @param[in]  frame_rate  The preferred frame rate in frames per second.
+  ///
+  virtual void RequestFrameRate(double frame_rate) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      Updates the client's rendering on the GPU with the newly
   ///             provided Scene.
@@ -557,6 +569,8 @@ class PlatformConfigurationNativeApi {
 
   static void ScheduleFrame();
 
+  static void RequestFrameRate(double frame_rate);
+
   static void Render(Scene* scene);
 
   static void UpdateSemantics(SemanticsUpdate* update);
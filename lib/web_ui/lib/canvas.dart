@@ -125,6 +125,42 @@ abstract class Canvas {
   );
 }
 
+// The web renderers have no per-call boundary to amortize, so the batch simply
+// replays its shapes onto the canvas.
+class DrawCommandBatch {
+  DrawCommandBatch();
+
+  final List<void Function(Canvas canvas, Paint paint)> _commands =
+      <void Function(Canvas canvas, Paint paint)>[];
+
+  bool get isEmpty => _commands.isEmpty;
+
+  void clear() => _commands.clear();
+
+  void setColor(Color color) =>
+      _commands.add((Canvas canvas, Paint paint) => paint.color = color);
+
+  void addLine(Offset p1, Offset p2) => _commands
+      .add((Canvas canvas, Paint paint) => canvas.drawLine(p1, p2, paint));
+
+  void addRect(Rect rect) =>
+      _commands.add((Canvas canvas, Paint paint) => canvas.drawRect(rect, paint));
+
+  void addOval(Rect rect) =>
+      _commands.add((Canvas canvas, Paint paint) => canvas.drawOval(rect, paint));
+
+  void addCircle(Offset center, double radius) => _commands.add(
+      (Canvas canvas, Paint paint) => canvas.drawCircle(center, radius, paint));
+
+  void draw(Canvas canvas, Paint paint) {
+    final Color paintColor = paint.color;
+    for (final void Function(Canvas canvas, Paint paint) command in _commands) {
+      command(canvas, paint);
+    }
+    paint.color = paintColor;
+  }
+}
+
 typedef PictureEventCallback = void Function(Picture picture);
 
 abstract class Picture {
@@ -76,6 +76,8 @@ abstract class PlatformDispatcher {
 
   void requestDartPerformanceMode(DartPerformanceMode mode) {}
 
+  void requestFrameRate(double frameRate) {}
+
   ByteData? getPersistentIsolateData() => null;
 
   void scheduleFrame();
@@ -11,6 +11,7 @@ import 'dart:ffi';
 
 export 'skwasm_impl/canvas.dart';
 export 'skwasm_impl/codecs.dart';
+export 'skwasm_impl/command_buffer.dart';
 export 'skwasm_impl/filters.dart';
 export 'skwasm_impl/font_collection.dart';
 export 'skwasm_impl/image.dart';
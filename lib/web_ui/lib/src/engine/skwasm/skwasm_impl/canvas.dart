@@ -13,10 +13,26 @@ class SkwasmCanvas implements SceneCanvas {
   factory SkwasmCanvas(SkwasmPictureRecorder recorder, ui.Rect cullRect) =>
       SkwasmCanvas.fromHandle(withStackScope((StackScope s) =>
           pictureRecorderBeginRecording(
-              recorder.handle, s.convertRectToNative(cullRect))));
+              recorder.handle, s.convertRectToNative(cullRect))), recorder);
 
-  SkwasmCanvas.fromHandle(this._handle);
-  CanvasHandle _handle;
+  SkwasmCanvas.fromHandle(this.rawHandle, [this._recorder]);
+
+  /// The native canvas, without playing back the pending commands.
+  final CanvasHandle rawHandle;
+
+  // Owns the native canvas, which must outlive the pending commands.
+  // ignore: unused_field
+  final SkwasmPictureRecorder? _recorder;
+
+  // The common operations are batched in the command buffer. Any other call
+  // into the canvas plays them back first, so that the operations stay in
+  // order.
+  final SkwasmCommandBuffer _commands = SkwasmCommandBuffer.instance;
+
+  CanvasHandle get _handle {
+    _commands.flush();
+    return rawHandle;
+  }
 
   // Note that we do not need to deal with the finalizer registry here, because
   // the underlying native skia object is tied directly to the lifetime of the
@@ -24,7 +40,7 @@ class SkwasmCanvas implements SceneCanvas {
 
   @override
   void save() {
-    canvasSave(_handle);
+    _commands.save(this);
   }
 
   @override
@@ -54,7 +70,7 @@ class SkwasmCanvas implements SceneCanvas {
 
   @override
   void restore() {
-    canvasRestore(_handle);
+    _commands.restore(this);
   }
 
   @override
@@ -66,10 +82,10 @@ class SkwasmCanvas implements SceneCanvas {
   int getSaveCount() => canvasGetSaveCount(_handle);
 
   @override
-  void translate(double dx, double dy) => canvasTranslate(_handle, dx, dy);
+  void translate(double dx, double dy) => _commands.translate(this, dx, dy);
 
   @override
-  void scale(double sx, [double? sy]) => canvasScale(_handle, sx, sy ?? sx);
+  void scale(double sx, [double? sy]) => _commands.scale(this, sx, sy ?? sx);
 
   @override
   void rotate(double radians) => canvasRotate(_handle, ui.toDegrees(radians));
@@ -87,9 +103,7 @@ class SkwasmCanvas implements SceneCanvas {
   @override
   void clipRect(ui.Rect rect,
       {ui.ClipOp clipOp = ui.ClipOp.intersect, bool doAntiAlias = true}) {
-    withStackScope((StackScope s) {
-      canvasClipRect(_handle, s.convertRectToNative(rect), clipOp.index, doAntiAlias);
-    });
+    _commands.clipRect(this, rect, clipOp, doAntiAlias);
   }
 
   @override
@@ -112,7 +126,7 @@ class SkwasmCanvas implements SceneCanvas {
   @override
   void drawLine(ui.Offset p1, ui.Offset p2, ui.Paint paint) {
     paint as SkwasmPaint;
-    canvasDrawLine(_handle, p1.dx, p1.dy, p2.dx, p2.dy, paint.handle);
+    _commands.drawLine(this, p1, p2, paint);
   }
 
   @override
@@ -124,25 +138,13 @@ class SkwasmCanvas implements SceneCanvas {
   @override
   void drawRect(ui.Rect rect, ui.Paint paint) {
     paint as SkwasmPaint;
-    withStackScope((StackScope s) {
-      canvasDrawRect(
-        _handle,
-        s.convertRectToNative(rect),
-        paint.handle
-      );
-    });
+    _commands.drawRect(this, rect, paint);
   }
 
   @override
   void drawRRect(ui.RRect rrect, ui.Paint paint) {
     paint as SkwasmPaint;
-    withStackScope((StackScope s) {
-      canvasDrawRRect(
-        _handle,
-        s.convertRRectToNative(rrect),
-        paint.handle
-      );
-    });
+    _commands.drawRRect(this, rrect, paint);
   }
 
   @override
@@ -161,15 +163,13 @@ class SkwasmCanvas implements SceneCanvas {
   @override
   void drawOval(ui.Rect rect, ui.Paint paint) {
     paint as SkwasmPaint;
-    withStackScope((StackScope s) {
-      canvasDrawOval(_handle, s.convertRectToNative(rect), paint.handle);
-    });
+    _commands.drawOval(this, rect, paint);
   }
 
   @override
   void drawCircle(ui.Offset center, double radius, ui.Paint paint) {
     paint as SkwasmPaint;
-    canvasDrawCircle(_handle, center.dx, center.dy, radius, paint.handle);
+    _commands.drawCircle(this, center, radius, paint);
   }
 
   @override
@@ -192,7 +192,7 @@ class SkwasmCanvas implements SceneCanvas {
   void drawPath(ui.Path path, ui.Paint paint) {
     paint as SkwasmPaint;
     path as SkwasmPath;
-    canvasDrawPath(_handle, path.handle, paint.handle);
+    _commands.drawPath(this, path, paint);
   }
 
   @override
@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:ffi';
+
+import 'package:ui/src/engine/skwasm/skwasm_impl.dart';
+import 'package:ui/ui.dart' as ui;
+
+// Must be kept in sync with `Command` in skwasm/command_buffer.cpp.
+enum SkwasmCommand {
+  save,
+  restore,
+  translate,
+  scale,
+  clipRect,
+  drawLine,
+  drawRect,
+  drawRRect,
+  drawOval,
+  drawCircle,
+  drawPath,
+}
+
+/// Batches the common canvas operations into a buffer in wasm memory, which
+/// is played back into the canvas with a single call instead of one call per
+/// operation.
+///
+/// Paints and paths are referred to by handle, so the commands referring to
+/// them have to be played back before they change or are disposed. They are
+/// marked with [SkwasmObjectWrapper.isReferencedByPendingCommands], and flush
+/// the buffer first. Any canvas operation that isn't batched flushes the
+/// buffer too, to keep the operations in order.
+class SkwasmCommandBuffer {
+  SkwasmCommandBuffer._() : _words = commandBufferCreate(_capacity);
+
+  static final SkwasmCommandBuffer instance = SkwasmCommandBuffer._();
+
+  // In words. The largest command, drawRRect, takes 14.
+  static const int _capacity = 4096;
+  static const int _maxCommandLength = 14;
+
+  final Pointer<Uint32> _words;
+  int _length = 0;
+  SkwasmCanvas? _canvas;
+  final List<SkwasmObjectWrapper<NativeType>> _referencedObjects =
+    <SkwasmObjectWrapper<NativeType>>[];
+
+  /// Plays back the pending commands into their canvas.
+  void flush() {
+    if (_length == 0) {
+      return;
+    }
+    canvasPlayCommands(_canvas!.rawHandle, _words, _length);
+    _length = 0;
+    _canvas = null;
+    for (final SkwasmObjectWrapper<NativeType> object in _referencedObjects) {
+      object.isReferencedByPendingCommands = false;
+    }
+    _referencedObjects.clear();
+  }
+
+  void _begin(SkwasmCanvas canvas, SkwasmCommand command) {
+    if (canvas != _canvas || _length + _maxCommandLength > _capacity) {
+      flush();
+      _canvas = canvas;
+    }
+    _words[_length++] = command.index;
+  }
+
+  void _writeScalar(double value) {
+    _words.cast<Float>()[_length++] = value;
+  }
+
+  void _writeRect(ui.Rect rect) {
+    _writeScalar(rect.left);
+    _writeScalar(rect.top);
+    _writeScalar(rect.right);
+    _writeScalar(rect.bottom);
+  }
+
+  void _writeObject(SkwasmObjectWrapper<NativeType> object) {
+    _words[_length++] = object.handle.address;
+    if (!object.isReferencedByPendingCommands) {
+      object.isReferencedByPendingCommands = true;
+      _referencedObjects.add(object);
+    }
+  }
+
+  void save(SkwasmCanvas canvas) {
+    _begin(canvas, SkwasmCommand.save);
+  }
+
+  void restore(SkwasmCanvas canvas) {
+    _begin(canvas, SkwasmCommand.restore);
+  }
+
+  void translate(SkwasmCanvas canvas, double dx, double dy) {
+    _begin(canvas, SkwasmCommand.translate);
+    _writeScalar(dx);
+    _writeScalar(dy);
+  }
+
+  void scale(SkwasmCanvas canvas, double sx, double sy) {
+    _begin(canvas, SkwasmCommand.scale);
+    _writeScalar(sx);
+    _writeScalar(sy);
+  }
+
+  void clipRect(
+    SkwasmCanvas canvas,
+    ui.Rect rect,
+    ui.ClipOp clipOp,
+    bool doAntiAlias,
+  ) {
+    _begin(canvas, SkwasmCommand.clipRect);
+    _writeRect(rect);
+    _words[_length++] = clipOp.index;
+    _words[_length++] = doAntiAlias ? 1 : 0;
+  }
+
+  void drawLine(
+    SkwasmCanvas canvas,
+    ui.Offset p1,
+    ui.Offset p2,
+    SkwasmPaint paint,
+  ) {
+    _begin(canvas, SkwasmCommand.drawLine);
+    _writeScalar(p1.dx);
+    _writeScalar(p1.dy);
+    _writeScalar(p2.dx);
+    _writeScalar(p2.dy);
+    _writeObject(paint);
+  }
+
+  void drawRect(SkwasmCanvas canvas, ui.Rect rect, SkwasmPaint paint) {
+    _begin(canvas, SkwasmCommand.drawRect);
+    _writeRect(rect);
+    _writeObject(paint);
+  }
+
+  void drawRRect(SkwasmCanvas canvas, ui.RRect rrect, SkwasmPaint paint) {
+    _begin(canvas, SkwasmCommand.drawRRect);
+    _writeRect(rrect.outerRect);
+    _writeScalar(rrect.tlRadiusX);
+    _writeScalar(rrect.tlRadiusY);
+    _writeScalar(rrect.trRadiusX);
+    _writeScalar(rrect.trRadiusY);
+    _writeScalar(rrect.brRadiusX);
+    _writeScalar(rrect.brRadiusY);
+    _writeScalar(rrect.blRadiusX);
+    _writeScalar(rrect.blRadiusY);
+    _writeObject(paint);
+  }
+
+  void drawOval(SkwasmCanvas canvas, ui.Rect rect, SkwasmPaint paint) {
+    _begin(canvas, SkwasmCommand.drawOval);
+    _writeRect(rect);
+    _writeObject(paint);
+  }
+
+  void drawCircle(
+    SkwasmCanvas canvas,
+    ui.Offset center,
+    double radius,
+    SkwasmPaint paint,
+  ) {
+    _begin(canvas, SkwasmCommand.drawCircle);
+    _writeScalar(center.dx);
+    _writeScalar(center.dy);
+    _writeScalar(radius);
+    _writeObject(paint);
+  }
+
+  void drawPath(SkwasmCanvas canvas, SkwasmPath path, SkwasmPaint paint) {
+    _begin(canvas, SkwasmCommand.drawPath);
+    _writeObject(path);
+    _writeObject(paint);
+  }
+}
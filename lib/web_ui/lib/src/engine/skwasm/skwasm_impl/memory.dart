@@ -6,6 +6,7 @@ import 'dart:ffi';
 import 'dart:js_interop';
 
 import 'package:ui/src/engine.dart';
+import 'package:ui/src/engine/skwasm/skwasm_impl.dart';
 
 class SkwasmObjectWrapper<T extends NativeType> {
   SkwasmObjectWrapper(this.handle, this.registry) {
@@ -15,8 +16,26 @@ class SkwasmObjectWrapper<T extends NativeType> {
   final Pointer<T> handle;
   bool _isDisposed = false;
 
+  /// Whether commands waiting in the [SkwasmCommandBuffer] refer to this
+  /// object.
+  bool isReferencedByPendingCommands = false;
+
+  /// The handle, for calls that change the object.
+  ///
+  /// Plays back the pending commands that refer to the object first, so that
+  /// they see it as it was when they were recorded.
+  Pointer<T> get mutableHandle {
+    if (isReferencedByPendingCommands) {
+      SkwasmCommandBuffer.instance.flush();
+    }
+    return handle;
+  }
+
   void dispose() {
     assert(!_isDisposed);
+    if (isReferencedByPendingCommands) {
+      SkwasmCommandBuffer.instance.flush();
+    }
     registry.evict(this);
     _isDisposed = true;
   }
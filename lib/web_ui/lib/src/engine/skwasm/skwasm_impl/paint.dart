@@ -43,7 +43,7 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
   set blendMode(ui.BlendMode blendMode) {
     if (_cachedBlendMode != blendMode) {
       _cachedBlendMode = blendMode;
-      paintSetBlendMode(handle, blendMode.index);
+      paintSetBlendMode(mutableHandle, blendMode.index);
     }
   }
 
@@ -51,43 +51,43 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
   ui.PaintingStyle get style => ui.PaintingStyle.values[paintGetStyle(handle)];
 
   @override
-  set style(ui.PaintingStyle style) => paintSetStyle(handle, style.index);
+  set style(ui.PaintingStyle style) => paintSetStyle(mutableHandle, style.index);
 
   @override
   double get strokeWidth => paintGetStrokeWidth(handle);
 
   @override
-  set strokeWidth(double width) => paintSetStrokeWidth(handle, width);
+  set strokeWidth(double width) => paintSetStrokeWidth(mutableHandle, width);
 
   @override
   ui.StrokeCap get strokeCap => ui.StrokeCap.values[paintGetStrokeCap(handle)];
 
   @override
-  set strokeCap(ui.StrokeCap cap) => paintSetStrokeCap(handle, cap.index);
+  set strokeCap(ui.StrokeCap cap) => paintSetStrokeCap(mutableHandle, cap.index);
 
   @override
   ui.StrokeJoin get strokeJoin => ui.StrokeJoin.values[paintGetStrokeJoin(handle)];
 
   @override
-  set strokeJoin(ui.StrokeJoin join) => paintSetStrokeJoin(handle, join.index);
+  set strokeJoin(ui.StrokeJoin join) => paintSetStrokeJoin(mutableHandle, join.index);
 
   @override
   bool get isAntiAlias => paintGetAntiAlias(handle);
 
   @override
-  set isAntiAlias(bool value) => paintSetAntiAlias(handle, value);
+  set isAntiAlias(bool value) => paintSetAntiAlias(mutableHandle, value);
 
   @override
   ui.Color get color => ui.Color(paintGetColorInt(handle));
 
   @override
-  set color(ui.Color color) => paintSetColorInt(handle, color.value);
+  set color(ui.Color color) => paintSetColorInt(mutableHandle, color.value);
 
   @override
   double get strokeMiterLimit => paintGetMiterLimit(handle);
 
   @override
-  set strokeMiterLimit(double limit) => paintSetMiterLimit(handle, limit);
+  set strokeMiterLimit(double limit) => paintSetMiterLimit(mutableHandle, limit);
 
   @override
   ui.Shader? get shader => _shader;
@@ -98,7 +98,7 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
     _shader = skwasmShader;
     final ShaderHandle shaderHandle =
       skwasmShader != null ? skwasmShader.handle : nullptr;
-    paintSetShader(handle, shaderHandle);
+    paintSetShader(mutableHandle, shaderHandle);
   }
 
   @override
@@ -114,7 +114,7 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
     final SkwasmImageFilter? nativeImageFilter = filter != null
       ? SkwasmImageFilter.fromUiFilter(filter)
       : null;
-    paintSetImageFilter(handle, nativeImageFilter != null ? nativeImageFilter.handle : nullptr);
+    paintSetImageFilter(mutableHandle, nativeImageFilter != null ? nativeImageFilter.handle : nullptr);
   }
 
   @override
@@ -127,16 +127,16 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
       if (nativeFilter != null) {
         final SkwasmColorFilter composedFilter = SkwasmColorFilter.composed(_invertColorFilter, nativeFilter);
         nativeFilter.dispose();
-        paintSetColorFilter(handle, composedFilter.handle);
+        paintSetColorFilter(mutableHandle, composedFilter.handle);
         composedFilter.dispose();
       } else {
-        paintSetColorFilter(handle, _invertColorFilter.handle);
+        paintSetColorFilter(mutableHandle, _invertColorFilter.handle);
       }
     } else if (nativeFilter != null) {
-      paintSetColorFilter(handle, nativeFilter.handle);
+      paintSetColorFilter(mutableHandle, nativeFilter.handle);
       nativeFilter.dispose();
     } else {
-      paintSetColorFilter(handle, nullptr);
+      paintSetColorFilter(mutableHandle, nullptr);
     }
   }
 
@@ -153,10 +153,10 @@ class SkwasmPaint extends SkwasmObjectWrapper<RawPaint> implements ui.Paint {
   set maskFilter(ui.MaskFilter? filter) {
     _maskFilter = filter;
     if (filter == null) {
-      paintSetMaskFilter(handle, nullptr);
+      paintSetMaskFilter(mutableHandle, nullptr);
     } else {
       final SkwasmMaskFilter nativeFilter = SkwasmMaskFilter.fromUiMaskFilter(filter);
-      paintSetMaskFilter(handle, nativeFilter.handle);
+      paintSetMaskFilter(mutableHandle, nativeFilter.handle);
       nativeFilter.dispose();
     }
   }
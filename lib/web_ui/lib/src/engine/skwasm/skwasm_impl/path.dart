@@ -37,27 +37,27 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
   ui.PathFillType get fillType => ui.PathFillType.values[pathGetFillType(handle)];
 
   @override
-  set fillType(ui.PathFillType fillType) => pathSetFillType(handle, fillType.index);
+  set fillType(ui.PathFillType fillType) => pathSetFillType(mutableHandle, fillType.index);
 
   @override
-  void moveTo(double x, double y) => pathMoveTo(handle, x, y);
+  void moveTo(double x, double y) => pathMoveTo(mutableHandle, x, y);
 
   @override
-  void relativeMoveTo(double x, double y) => pathRelativeMoveTo(handle, x, y);
+  void relativeMoveTo(double x, double y) => pathRelativeMoveTo(mutableHandle, x, y);
 
   @override
-  void lineTo(double x, double y) => pathLineTo(handle, x, y);
+  void lineTo(double x, double y) => pathLineTo(mutableHandle, x, y);
 
   @override
-  void relativeLineTo(double x, double y) => pathRelativeMoveTo(handle, x, y);
+  void relativeLineTo(double x, double y) => pathRelativeMoveTo(mutableHandle, x, y);
 
   @override
   void quadraticBezierTo(double x1, double y1, double x2, double y2) =>
-    pathQuadraticBezierTo(handle, x1, y1, x2, y2);
+    pathQuadraticBezierTo(mutableHandle, x1, y1, x2, y2);
 
   @override
   void relativeQuadraticBezierTo(double x1, double y1, double x2, double y2) =>
-    pathRelativeQuadraticBezierTo(handle, x1, y1, x2, y2);
+    pathRelativeQuadraticBezierTo(mutableHandle, x1, y1, x2, y2);
 
   @override
   void cubicTo(
@@ -67,7 +67,7 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
     double y2,
     double x3,
     double y3) =>
-    pathCubicTo(handle, x1, y1, x2, y2, x3, y3);
+    pathCubicTo(mutableHandle, x1, y1, x2, y2, x3, y3);
 
   @override
   void relativeCubicTo(
@@ -77,22 +77,22 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
       double y2,
       double x3,
       double y3) =>
-    pathRelativeCubicTo(handle, x1, y1, x2, y2, x3, y3);
+    pathRelativeCubicTo(mutableHandle, x1, y1, x2, y2, x3, y3);
 
   @override
   void conicTo(double x1, double y1, double x2, double y2, double w) =>
-    pathConicTo(handle, x1, y1, x2, y2, w);
+    pathConicTo(mutableHandle, x1, y1, x2, y2, w);
 
   @override
   void relativeConicTo(double x1, double y1, double x2, double y2, double w) =>
-    pathRelativeConicTo(handle, x1, y1, x2, y2, w);
+    pathRelativeConicTo(mutableHandle, x1, y1, x2, y2, w);
 
   @override
   void arcTo(
       ui.Rect rect, double startAngle, double sweepAngle, bool forceMoveTo) {
     withStackScope((StackScope s) {
       pathArcToOval(
-          handle,
+          mutableHandle,
           s.convertRectToNative(rect),
           ui.toDegrees(startAngle),
           ui.toDegrees(sweepAngle),
@@ -114,7 +114,7 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
     final PathDirection pathDirection =
         clockwise ? PathDirection.clockwise : PathDirection.counterClockwise;
     pathArcToRotated(
-        handle,
+        mutableHandle,
         radius.x,
         radius.y,
         ui.toDegrees(rotation),
@@ -138,7 +138,7 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
     final PathDirection pathDirection =
         clockwise ? PathDirection.clockwise : PathDirection.counterClockwise;
     pathRelativeArcToRotated(
-        handle,
+        mutableHandle,
         radius.x,
         radius.y,
         ui.toDegrees(rotation),
@@ -152,14 +152,14 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
   @override
   void addRect(ui.Rect rect) {
     withStackScope((StackScope s) {
-      pathAddRect(handle, s.convertRectToNative(rect));
+      pathAddRect(mutableHandle, s.convertRectToNative(rect));
     });
   }
 
   @override
   void addOval(ui.Rect rect) {
     withStackScope((StackScope s) {
-      pathAddOval(handle, s.convertRectToNative(rect));
+      pathAddOval(mutableHandle, s.convertRectToNative(rect));
     });
   }
 
@@ -167,7 +167,7 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
   void addArc(ui.Rect rect, double startAngle, double sweepAngle) {
     withStackScope((StackScope s) {
       pathAddArc(
-        handle,
+        mutableHandle,
         s.convertRectToNative(rect),
         ui.toDegrees(startAngle),
         ui.toDegrees(sweepAngle)
@@ -178,14 +178,14 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
   @override
   void addPolygon(List<ui.Offset> points, bool close) {
     withStackScope((StackScope s) {
-      pathAddPolygon(handle, s.convertPointArrayToNative(points), points.length, close);
+      pathAddPolygon(mutableHandle, s.convertPointArrayToNative(points), points.length, close);
     });
   }
 
   @override
   void addRRect(ui.RRect rrect) {
     withStackScope((StackScope s) {
-      pathAddRRect(handle, s.convertRRectToNative(rrect));
+      pathAddRRect(mutableHandle, s.convertRRectToNative(rrect));
     });
   }
 
@@ -206,15 +206,15 @@ class SkwasmPath extends SkwasmObjectWrapper<RawPath> implements ui.Path {
           s.convertMatrix4toSkMatrix(matrix4 ?? Matrix4.identity().toFloat64());
       convertedMatrix[2] += offset.dx;
       convertedMatrix[5] += offset.dy;
-      pathAddPath(handle, (path as SkwasmPath).handle, convertedMatrix, extend);
+      pathAddPath(mutableHandle, (path as SkwasmPath).handle, convertedMatrix, extend);
     });
   }
 
   @override
-  void close() => pathClose(handle);
+  void close() => pathClose(mutableHandle);
 
   @override
-  void reset() => pathReset(handle);
+  void reset() => pathReset(mutableHandle);
 
   @override
   bool contains(ui.Offset point) => pathContains(handle, point.dx, point.dy);
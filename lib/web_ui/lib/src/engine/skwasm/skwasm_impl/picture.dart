@@ -47,6 +47,7 @@ class SkwasmPictureRecorder extends SkwasmObjectWrapper<RawPictureRecorder> impl
   @override
   SkwasmPicture endRecording() {
     isRecording = false;
+    SkwasmCommandBuffer.instance.flush();
 
     final SkwasmPicture picture = SkwasmPicture.fromHandle(
       pictureRecorderEndRecording(handle)
@@ -57,4 +58,11 @@ class SkwasmPictureRecorder extends SkwasmObjectWrapper<RawPictureRecorder> impl
 
   @override
   bool isRecording = true;
+
+  @override
+  void dispose() {
+    // Commands may still be pending for the canvas of this recorder.
+    SkwasmCommandBuffer.instance.flush();
+    super.dispose();
+  }
 }
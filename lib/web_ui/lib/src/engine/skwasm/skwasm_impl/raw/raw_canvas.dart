@@ -268,3 +268,19 @@ external void canvasGetLocalClipBounds(CanvasHandle canvas, RawRect outRect);
 @Native<Void Function(CanvasHandle, RawIRect)>(
     symbol: 'canvas_getDeviceClipBounds', isLeaf: true)
 external void canvasGetDeviceClipBounds(CanvasHandle canvas, RawIRect outRect);
+
+@Native<Pointer<Uint32> Function(Int)>(
+    symbol: 'commandBuffer_create', isLeaf: true)
+external Pointer<Uint32> commandBufferCreate(int length);
+
+@Native<Void Function(Pointer<Uint32>)>(
+    symbol: 'commandBuffer_dispose', isLeaf: true)
+external void commandBufferDispose(Pointer<Uint32> buffer);
+
+@Native<Void Function(CanvasHandle, Pointer<Uint32>, Int)>(
+    symbol: 'canvas_playCommands', isLeaf: true)
+external void canvasPlayCommands(
+  CanvasHandle canvas,
+  Pointer<Uint32> commands,
+  int length,
+);
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "export.h"
+#include "helpers.h"
+
+#include <cstring>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+using namespace Skwasm;
+
+namespace {
+
+// Must be kept in sync with `SkwasmCommand` in
+// lib/src/engine/skwasm/skwasm_impl/command_buffer.dart.
+enum class Command : uint32_t {
+  save,
+  restore,
+  translate,
+  scale,
+  clipRect,
+  drawLine,
+  drawRect,
+  drawRRect,
+  drawOval,
+  drawCircle,
+  drawPath,
+};
+
+// Reads the operands of the commands. Scalars are stored as the bits of a
+// float, objects as their address.
+class CommandReader {
+ public:
+  CommandReader(const uint32_t* words, uint32_t length)
+      : _words(words), _end(words + length) {}
+
+  bool hasMore() const { return _words < _end; }
+
+  uint32_t readWord() { return *_words++; }
+
+  SkScalar readScalar() {
+    SkScalar value;
+    std::memcpy(&value, _words++, sizeof(value));
+    return value;
+  }
+
+  SkRect readRect() {
+    const SkScalar left = readScalar();
+    const SkScalar top = readScalar();
+    const SkScalar right = readScalar();
+    const SkScalar bottom = readScalar();
+    return SkRect::MakeLTRB(left, top, right, bottom);
+  }
+
+  template <typename T>
+  const T& readObject() {
+    return *reinterpret_cast<const T*>(readWord());
+  }
+
+ private:
+  const uint32_t* _words;
+  const uint32_t* _end;
+};
+
+}  // namespace
+
+SKWASM_EXPORT uint32_t* commandBuffer_create(uint32_t length) {
+  return new uint32_t[length];
+}
+
+SKWASM_EXPORT void commandBuffer_dispose(uint32_t* buffer) {
+  delete[] buffer;
+}
+
+// Plays back the commands recorded by the main thread in one call, rather
+// than one call per draw.
+SKWASM_EXPORT void canvas_playCommands(SkCanvas* canvas,
+                                       const uint32_t* commands,
+                                       uint32_t length) {
+  CommandReader reader(commands, length);
+  while (reader.hasMore()) {
+    switch (static_cast<Command>(reader.readWord())) {
+      case Command::save:
+        canvas->save();
+        break;
+      case Command::restore:
+        canvas->restore();
+        break;
+      case Command::translate: {
+        const SkScalar dx = reader.readScalar();
+        const SkScalar dy = reader.readScalar();
+        canvas->translate(dx, dy);
+        break;
+      }
+      case Command::scale: {
+        const SkScalar sx = reader.readScalar();
+        const SkScalar sy = reader.readScalar();
+        canvas->scale(sx, sy);
+        break;
+      }
+      case Command::clipRect: {
+        const SkRect rect = reader.readRect();
+        const SkClipOp op = static_cast<SkClipOp>(reader.readWord());
+        const bool antialias = reader.readWord() != 0;
+        canvas->clipRect(rect, op, antialias);
+        break;
+      }
+      case Command::drawLine: {
+        const SkScalar x1 = reader.readScalar();
+        const SkScalar y1 = reader.readScalar();
+        const SkScalar x2 = reader.readScalar();
+        const SkScalar y2 = reader.readScalar();
+        canvas->drawLine(x1, y1, x2, y2, reader.readObject<SkPaint>());
+        break;
+      }
+      case Command::drawRect: {
+        const SkRect rect = reader.readRect();
+        canvas->drawRect(rect, reader.readObject<SkPaint>());
+        break;
+      }
+      case Command::drawRRect: {
+        SkScalar rrectValues[12];
+        for (SkScalar& value : rrectValues) {
+          value = reader.readScalar();
+        }
+        canvas->drawRRect(createRRect(rrectValues),
+                          reader.readObject<SkPaint>());
+        break;
+      }
+      case Command::drawOval: {
+        const SkRect rect = reader.readRect();
+        canvas->drawOval(rect, reader.readObject<SkPaint>());
+        break;
+      }
+      case Command::drawCircle: {
+        const SkScalar x = reader.readScalar();
+        const SkScalar y = reader.readScalar();
+        const SkScalar radius = reader.readScalar();
+        canvas->drawCircle(x, y, radius, reader.readObject<SkPaint>());
+        break;
+      }
+      case Command::drawPath: {
+        const SkPath& path = reader.readObject<SkPath>();
+        canvas->drawPath(path, reader.readObject<SkPaint>());
+        break;
+      }
+    }
+  }
+}
@@ -76,7 +76,11 @@ mergeInto(LibraryManager.library, {
     };
     _skwasm_captureImageBitmap = async function(surfaceHandle, contextHandle, callbackId, width, height) {
       const canvas = handleToCanvasMap.get(contextHandle);
-      const imageBitmap = await createImageBitmap(canvas, 0, 0, width, height);
+      // When the picture fills the whole canvas, its contents can be handed
+      // over as they are instead of being copied into a new bitmap.
+      const imageBitmap = (canvas.width === width && canvas.height === height)
+          ? canvas.transferToImageBitmap()
+          : await createImageBitmap(canvas, 0, 0, width, height);
       postMessage({
         skwasmMessage: 'onRenderComplete',
         surface: surfaceHandle,
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "picture_cache.h"
+
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+
+using namespace Skwasm;
+
+// Plays pictures back into the target canvas, drawing the pictures they
+// contain through the cache.
+class PictureCache::CachingCanvas : public SkNWayCanvas {
+ public:
+  CachingCanvas(PictureCache* cache, SkCanvas* target)
+      : SkNWayCanvas(target->imageInfo().width(),
+                     target->imageInfo().height()),
+        _cache(cache) {
+    addCanvas(target);
+  }
+
+ protected:
+  void onDrawPicture(const SkPicture* picture,
+                     const SkMatrix* matrix,
+                     const SkPaint* paint) override {
+    if (!paint) {
+      SkRect bounds = picture->cullRect();
+      if (matrix) {
+        matrix->mapRect(&bounds);
+      }
+      if (quickReject(bounds)) {
+        return;
+      }
+    }
+    SkMatrix totalMatrix = getTotalMatrix();
+    if (matrix) {
+      totalMatrix.preConcat(*matrix);
+    }
+    if (!_cache->drawCached(this, picture, totalMatrix, paint)) {
+      // Play the picture back into this canvas rather than the target, so
+      // that the pictures nested in it are drawn through the cache too.
+      SkCanvas::onDrawPicture(picture, matrix, paint);
+    }
+  }
+
+ private:
+  PictureCache* _cache;
+};
+
+PictureCache::PictureCache(GrDirectContext* grContext)
+    : _grContext(grContext) {}
+
+void PictureCache::renderPicture(SkCanvas* canvas,
+                                 const SkPicture* picture,
+                                 const SkMatrix& matrix) {
+  _frame++;
+  CachingCanvas cachingCanvas(this, canvas);
+  cachingCanvas.concat(matrix);
+  picture->playback(&cachingCanvas);
+  evictUnused();
+}
+
+bool PictureCache::drawCached(SkCanvas* canvas,
+                              const SkPicture* picture,
+                              const SkMatrix& totalMatrix,
+                              const SkPaint* paint) {
+  // Rotated and skewed pictures would need to be rasterized in every
+  // orientation they are drawn at.
+  if (!totalMatrix.isScaleTranslate() ||
+      picture->approximateOpCount() < kMinOpCount) {
+    return false;
+  }
+  const SkVector scale = {totalMatrix.getScaleX(), totalMatrix.getScaleY()};
+  auto [it, inserted] = _entries.try_emplace(picture->uniqueID());
+  Entry& entry = it->second;
+  // Only pictures drawn at the same scale as the last time they were drawn
+  // are worth rasterizing. Pictures seen for the first time, or being
+  // zoomed, are likely to be gone or different in the next frame.
+  const bool stable = !inserted && entry.lastScale == scale;
+  entry.lastScale = scale;
+  entry.lastUsedFrame = _frame;
+  if (!entry.image || entry.imageScale != scale) {
+    if (!stable || !rasterize(entry, picture, scale)) {
+      return false;
+    }
+  }
+
+  // The image is drawn at whole device pixels, like the rasterization.
+  SkAutoCanvasRestore autoRestore(canvas, true);
+  canvas->setMatrix(SkMatrix::Translate(
+      SkScalarRoundToScalar(totalMatrix.getTranslateX()) + entry.offset.fX,
+      SkScalarRoundToScalar(totalMatrix.getTranslateY()) + entry.offset.fY));
+  canvas->drawImage(entry.image, 0, 0, SkSamplingOptions(), paint);
+  return true;
+}
+
+bool PictureCache::rasterize(Entry& entry,
+                             const SkPicture* picture,
+                             SkVector scale) {
+  const SkMatrix scaleMatrix = SkMatrix::Scale(scale.fX, scale.fY);
+  const SkIRect bounds = scaleMatrix.mapRect(picture->cullRect()).roundOut();
+  const int maxSize = _grContext->maxRenderTargetSize();
+  if (bounds.isEmpty() || bounds.width() > maxSize ||
+      bounds.height() > maxSize) {
+    return false;
+  }
+
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(
+      bounds.width(), bounds.height(), SkColorSpace::MakeSRGB());
+  const size_t oldBytes =
+      entry.image ? entry.image->imageInfo().computeMinByteSize() : 0;
+  const size_t newBytes = info.computeMinByteSize();
+  if (_bytes - oldBytes + newBytes > kMaxBytes) {
+    return false;
+  }
+
+  sk_sp<SkSurface> surface =
+      SkSurfaces::RenderTarget(_grContext, skgpu::Budgeted::kYes, info);
+  if (!surface) {
+    return false;
+  }
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(-bounds.fLeft, -bounds.fTop);
+  canvas->concat(scaleMatrix);
+  picture->playback(canvas);
+
+  entry.image = surface->makeImageSnapshot();
+  entry.imageScale = scale;
+  entry.offset = {bounds.fLeft, bounds.fTop};
+  _bytes = _bytes - oldBytes + newBytes;
+  return true;
+}
+
+void PictureCache::evictUnused() {
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    if (_frame - it->second.lastUsedFrame > kMaxUnusedFrames) {
+      if (it->second.image) {
+        _bytes -= it->second.image->imageInfo().computeMinByteSize();
+      }
+      it = _entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
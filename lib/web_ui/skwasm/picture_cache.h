@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace Skwasm {
+
+// Retains rasterized copies of the pictures nested in the pictures a surface
+// renders, keyed by picture identity.
+//
+// The framework flattens the layer tree of each frame into one picture per
+// canvas, which draws the pictures of the layers. Layers that didn't change
+// keep their pictures, so a picture drawn again in the next frame is
+// rasterized once and then blitted instead of being replayed every frame.
+//
+// Worker thread only.
+class PictureCache {
+ public:
+  // The most memory the rasterized pictures may hold.
+  static constexpr size_t kMaxBytes = 64 * 1024 * 1024;
+  // Pictures not drawn for this many frames are dropped.
+  static constexpr uint32_t kMaxUnusedFrames = 3;
+  // Pictures with fewer operations are cheaper to replay than to blit.
+  static constexpr int kMinOpCount = 8;
+
+  explicit PictureCache(GrDirectContext* grContext);
+
+  // Draws `picture` into `canvas`, drawing the pictures it contains from the
+  // cache. Each call is a new frame.
+  void renderPicture(SkCanvas* canvas,
+                     const SkPicture* picture,
+                     const SkMatrix& matrix);
+
+ private:
+  class CachingCanvas;
+
+  struct Entry {
+    sk_sp<SkImage> image;
+    // The scale the image was rasterized at.
+    SkVector imageScale = {0, 0};
+    // The scale the picture was last drawn at.
+    SkVector lastScale = {0, 0};
+    // Where the image goes relative to the translation of the picture.
+    SkIPoint offset = {0, 0};
+    uint32_t lastUsedFrame = 0;
+  };
+
+  // Returns whether the picture was drawn from the cache.
+  bool drawCached(SkCanvas* canvas,
+                  const SkPicture* picture,
+                  const SkMatrix& totalMatrix,
+                  const SkPaint* paint);
+  bool rasterize(Entry& entry, const SkPicture* picture, SkVector scale);
+  void evictUnused();
+
+  GrDirectContext* _grContext;
+  std::unordered_map<uint32_t, Entry> _entries;
+  size_t _bytes = 0;
+  uint32_t _frame = 0;
+};
+
+}  // namespace Skwasm
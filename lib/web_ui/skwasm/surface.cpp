@@ -93,6 +93,7 @@ void Surface::_init() {
   emscripten_webgl_enable_extension(_glContext, "WEBGL_debug_renderer_info");
 
   _grContext = GrDirectContexts::MakeGL(GrGLMakeNativeInterface());
+  _pictureCache = std::make_unique<PictureCache>(_grContext.get());
 
   // WebGL should already be clearing the color and stencil buffers, but do it
   // again here to ensure Skia receives them in the expected state.
@@ -148,7 +149,7 @@ void Surface::_renderPicture(const SkPicture* picture, uint32_t callbackId) {
   makeCurrent(_glContext);
   auto canvas = _surface->getCanvas();
   canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
-  canvas->drawPicture(sk_ref_sp<SkPicture>(picture), &matrix, nullptr);
+  _pictureCache->renderPicture(canvas, picture, matrix);
   _grContext->flush(_surface.get());
   skwasm_captureImageBitmap(this, _glContext, callbackId,
                             roundedOutRect.width(), roundedOutRect.height());
@@ -11,7 +11,9 @@
 #include <emscripten/threading.h>
 #include <webgl/webgl1.h>
 #include <cassert>
+#include <memory>
 #include "export.h"
+#include "picture_cache.h"
 #include "skwasm_support.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -92,6 +94,7 @@ class Surface {
   EMSCRIPTEN_WEBGL_CONTEXT_HANDLE _glContext = 0;
   sk_sp<GrDirectContext> _grContext = nullptr;
   sk_sp<SkSurface> _surface = nullptr;
+  std::unique_ptr<PictureCache> _pictureCache;
   GrGLFramebufferInfo _fbInfo;
   GrGLint _sampleCount;
   GrGLint _stencil;
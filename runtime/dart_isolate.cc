@@ -268,6 +268,14 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
   std::shared_ptr<DartIsolate>* root_isolate_data =
       static_cast<std::shared_ptr<DartIsolate>*>(Dart_IsolateData(vm_isolate));
 
+  // Isolates spawned from another root isolate join its group, which already
+  // has a pool.
+  if (!spawning_isolate) {
+    RefillChildIsolatePool(
+        *static_cast<std::shared_ptr<DartIsolateGroupData>*>(
+            Dart_IsolateGroupData(vm_isolate)));
+  }
+
   (*root_isolate_data)
       ->SetPlatformConfiguration(std::move(platform_configuration));
 
@@ -943,21 +951,16 @@ bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
       static_cast<std::shared_ptr<DartIsolateGroupData>*>(
           Dart_CurrentIsolateGroupData());
 
-  TaskRunners null_task_runners((*isolate_group_data)->GetAdvisoryScriptURI(),
-                                /* platform= */ nullptr,
-                                /* raster= */ nullptr,
-                                /* ui= */ nullptr,
-                                /* io= */ nullptr);
-
-  UIDartState::Context context(null_task_runners);
-  context.advisory_script_uri = (*isolate_group_data)->GetAdvisoryScriptURI();
-  context.advisory_script_entrypoint =
-      (*isolate_group_data)->GetAdvisoryScriptEntrypoint();
-  auto embedder_isolate = std::make_unique<std::shared_ptr<DartIsolate>>(
-      std::shared_ptr<DartIsolate>(
-          new DartIsolate((*isolate_group_data)->GetSettings(),  // settings
-                          false,       // is_root_isolate
-                          context)));  // context
+  // Use an embedder object made ahead of time if there is one, and make the
+  // next one in the background.
+  std::shared_ptr<DartIsolate> child_isolate =
+      (*isolate_group_data)->TakePooledChildIsolate();
+  if (!child_isolate) {
+    child_isolate = CreateChildIsolate(**isolate_group_data);
+  }
+  RefillChildIsolatePool(*isolate_group_data);
+  auto embedder_isolate =
+      std::make_unique<std::shared_ptr<DartIsolate>>(std::move(child_isolate));
 
   // root isolate should have been created via CreateRootIsolate
   if (!InitializeIsolate(*embedder_isolate, isolate, error)) {
@@ -971,6 +974,47 @@ bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
   return true;
 }
 
+std::shared_ptr<DartIsolate> DartIsolate::CreateChildIsolate(
+    const DartIsolateGroupData& isolate_group_data) {
+  TaskRunners null_task_runners(isolate_group_data.GetAdvisoryScriptURI(),
+                                /* platform= */ nullptr,
+                                /* raster= */ nullptr,
+                                /* ui= */ nullptr,
+                                /* io= */ nullptr);
+
+  UIDartState::Context context(null_task_runners);
+  context.advisory_script_uri = isolate_group_data.GetAdvisoryScriptURI();
+  context.advisory_script_entrypoint =
+      isolate_group_data.GetAdvisoryScriptEntrypoint();
+  return std::shared_ptr<DartIsolate>(
+      new DartIsolate(isolate_group_data.GetSettings(),  // settings
+                      false,                             // is_root_isolate
+                      context));                         // context
+}
+
+void DartIsolate::RefillChildIsolatePool(
+    const std::shared_ptr<DartIsolateGroupData>& isolate_group_data) {
+  if (isolate_group_data->IsChildIsolatePoolFull()) {
+    return;
+  }
+  DartVM* vm = DartVMRef::GetRunningVM();
+  if (!vm) {
+    return;
+  }
+  vm->GetConcurrentWorkerTaskRunner()->PostTask(
+      [weak_isolate_group_data =
+           std::weak_ptr<DartIsolateGroupData>(isolate_group_data)]() {
+        TRACE_EVENT0("flutter", "DartIsolate::RefillChildIsolatePool");
+        while (auto isolate_group_data = weak_isolate_group_data.lock()) {
+          if (isolate_group_data->IsChildIsolatePoolFull() ||
+              !isolate_group_data->AddPooledChildIsolate(
+                  CreateChildIsolate(*isolate_group_data))) {
+            return;
+          }
+        }
+      });
+}
+
 Dart_Isolate DartIsolate::CreateDartIsolateGroup(
     std::unique_ptr<std::shared_ptr<DartIsolateGroupData>> isolate_group_data,
     std::unique_ptr<std::shared_ptr<DartIsolate>> isolate_data,
@@ -463,6 +463,16 @@ class DartIsolate : public UIDartState {
   static bool DartIsolateInitializeCallback(void** child_callback_data,
                                             char** error);
 
+  // Makes the embedder object for a child isolate of the given group, which
+  // the VM spawns with |DartIsolateInitializeCallback|.
+  static std::shared_ptr<DartIsolate> CreateChildIsolate(
+      const DartIsolateGroupData& isolate_group_data);
+
+  // Makes embedder objects for child isolates of the group on a concurrent
+  // worker until its pool is full, so that spawning isolates doesn't have to.
+  static void RefillChildIsolatePool(
+      const std::shared_ptr<DartIsolateGroupData>& isolate_group_data);
+
   static Dart_Isolate DartCreateAndStartServiceIsolate(
       const char* package_root,
       const char* package_config,
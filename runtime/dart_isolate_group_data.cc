@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/runtime/dart_isolate.h"
 #include "flutter/runtime/dart_snapshot.h"
 
 namespace flutter {
@@ -66,6 +67,31 @@ void DartIsolateGroupData::SetChildIsolatePreparer(
   child_isolate_preparer_ = value;
 }
 
+std::shared_ptr<DartIsolate> DartIsolateGroupData::TakePooledChildIsolate() {
+  std::scoped_lock lock(child_isolate_pool_mutex_);
+  if (child_isolate_pool_.empty()) {
+    return nullptr;
+  }
+  auto isolate = std::move(child_isolate_pool_.back());
+  child_isolate_pool_.pop_back();
+  return isolate;
+}
+
+bool DartIsolateGroupData::AddPooledChildIsolate(
+    std::shared_ptr<DartIsolate> isolate) {
+  std::scoped_lock lock(child_isolate_pool_mutex_);
+  if (child_isolate_pool_.size() >= settings_.child_isolate_pool_size) {
+    return false;
+  }
+  child_isolate_pool_.push_back(std::move(isolate));
+  return true;
+}
+
+bool DartIsolateGroupData::IsChildIsolatePoolFull() const {
+  std::scoped_lock lock(child_isolate_pool_mutex_);
+  return child_isolate_pool_.size() >= settings_.child_isolate_pool_size;
+}
+
 void DartIsolateGroupData::SetPlatformMessageHandler(
     int64_t root_isolate_token,
     std::weak_ptr<PlatformMessageHandler> handler) {
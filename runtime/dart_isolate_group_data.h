@@ -8,6 +8,7 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/fml/closure.h"
@@ -56,6 +57,31 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
 
   void SetChildIsolatePreparer(const ChildIsolatePreparer& value);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes an embedder object for a child isolate of this group
+  ///             from the pool that `AddPooledChildIsolate` fills.
+  ///
+  /// @return     The embedder object, or nullptr if the pool is empty.
+  ///
+  std::shared_ptr<DartIsolate> TakePooledChildIsolate();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an embedder object for a child isolate of this group,
+  ///             which hasn't been initialized with a Dart isolate yet, to the
+  ///             pool, unless it already holds
+  ///             `Settings::child_isolate_pool_size` objects.
+  ///
+  /// @return     Whether the pool wasn't full.
+  ///
+  bool AddPooledChildIsolate(std::shared_ptr<DartIsolate> isolate);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the pool already holds
+  ///             `Settings::child_isolate_pool_size` embedder objects for
+  ///             child isolates.
+  ///
+  bool IsChildIsolatePoolFull() const;
+
   // |PlatformMessageHandlerStorage|
   void SetPlatformMessageHandler(
       int64_t root_isolate_token,
@@ -77,6 +103,8 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
   std::map<int64_t, std::weak_ptr<PlatformMessageHandler>>
       platform_message_handlers_;
   mutable std::mutex platform_message_handlers_mutex_;
+  mutable std::mutex child_isolate_pool_mutex_;
+  std::vector<std::shared_ptr<DartIsolate>> child_isolate_pool_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DartIsolateGroupData);
 };
@@ -332,6 +332,38 @@ TEST_F(DartSecondaryIsolateTest, CanLaunchSecondaryIsolates) {
   // root isolate will be auto-shutdown
 }
 
+TEST_F(DartSecondaryIsolateTest, CanLaunchSecondaryIsolatesFromPool) {
+  AddNativeCallback("NotifyNative",
+                    CREATE_NATIVE_ENTRY(([this](Dart_NativeArguments args) {
+                      LatchCountDown();
+                    })));
+  AddNativeCallback(
+      "PassMessage", CREATE_NATIVE_ENTRY(([this](Dart_NativeArguments args) {
+        auto message = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        ASSERT_EQ("Hello from code is secondary isolate.", message);
+        LatchCountDown();
+      })));
+  auto settings = CreateSettingsForFixture();
+  settings.child_isolate_pool_size = 2;
+  settings.isolate_shutdown_callback = [this]() { ChildShutdownSignal(); };
+  auto vm_ref = DartVMRef::Create(settings);
+  auto thread = CreateNewThread();
+  TaskRunners task_runners(GetCurrentTestName(),  //
+                           thread,                //
+                           thread,                //
+                           thread,                //
+                           thread                 //
+  );
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, task_runners,
+                                      "testCanLaunchSecondaryIsolate", {},
+                                      GetDefaultKernelFilePath());
+  ASSERT_TRUE(isolate);
+  ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+  ChildShutdownWait();
+  LatchWait();
+}
+
 /// Tests error handling path of `Isolate.spawn()` in the engine.
 class IsolateStartupFailureTest : public FixtureTest {
  public:
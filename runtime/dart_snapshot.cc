@@ -264,6 +264,31 @@ bool DartSnapshot::IsDontNeedSafe() const {
   return true;
 }
 
+void DartSnapshot::Prefetch() const {
+  TRACE_EVENT0("flutter", "DartSnapshot::Prefetch");
+  if (data_) {
+    data_->Advise(fml::Mapping::Advice::kWillNeed);
+  }
+  if (instructions_) {
+    instructions_->Advise(fml::Mapping::Advice::kWillNeed);
+  }
+}
+
+bool DartSnapshot::ReleaseResidentPages() const {
+  TRACE_EVENT0("flutter", "DartSnapshot::ReleaseResidentPages");
+  if (!IsDontNeedSafe()) {
+    return false;
+  }
+  bool released = false;
+  if (data_) {
+    released |= data_->Advise(fml::Mapping::Advice::kDontNeed);
+  }
+  if (instructions_) {
+    released |= instructions_->Advise(fml::Mapping::Advice::kDontNeed);
+  }
+  return released;
+}
+
 bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   return ::Dart_DetectNullSafety(
       nullptr,           // script_uri (unsupported by Flutter)
@@ -165,6 +165,24 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///             safe to use with madvise(DONTNEED).
   bool IsDontNeedSafe() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to read the pages of the data and instructions
+  ///             mappings ahead, so that running the snapshot for the first
+  ///             time doesn't fault them in one at a time. The read ahead
+  ///             happens in the background.
+  ///
+  void Prefetch() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the OS drop the resident pages of the data and
+  ///             instructions mappings. They are read from the file again
+  ///             when they are next used. Does nothing unless
+  ///             `IsDontNeedSafe` is true.
+  ///
+  /// @return     Whether the pages could be dropped.
+  ///
+  bool ReleaseResidentPages() const;
+
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
@@ -303,6 +303,8 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   // this call is thread-safe.
   SkExecutor::SetDefault(&skia_concurrent_executor_);
 
+  ReapplyWorkerAffinity();
+
   FML_DCHECK(vm_data_);
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
@@ -552,4 +554,12 @@ std::shared_ptr<fml::ConcurrentMessageLoop> DartVM::GetConcurrentMessageLoop() {
   return concurrent_message_loop_;
 }
 
+void DartVM::ReapplyWorkerAffinity() {
+  if (!settings_.pin_threads_to_core_classes) {
+    return;
+  }
+  concurrent_message_loop_->PostTaskToAllWorkers(
+      []() { fml::RequestAffinity(fml::CpuAffinity::kEfficiency); });
+}
+
 }  // namespace flutter
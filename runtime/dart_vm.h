@@ -160,6 +160,14 @@ class DartVM {
   ///
   std::shared_ptr<fml::ConcurrentMessageLoop> GetConcurrentMessageLoop();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Requests the efficiency cores for the workers of the
+  ///             concurrent message loop if the settings ask for the threads
+  ///             to be pinned to core classes. This is done once when the VM
+  ///             is created and may be repeated after a thermal state change.
+  ///
+  void ReapplyWorkerAffinity();
+
  private:
   const Settings settings_;
   std::shared_ptr<fml::ConcurrentMessageLoop> concurrent_message_loop_;
@@ -64,6 +64,7 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
       std::move(advisory_script_uri), std::move(advisory_script_entrypoint),
       context_.volatile_path_tracker, context_.concurrent_task_runner,
       context_.enable_impeller};
+  spawned_context.attribute_interner = context_.attribute_interner;
   auto result =
       std::make_unique<RuntimeController>(p_client,                      //
                                           vm_,                           //
@@ -340,6 +341,11 @@ void RuntimeController::ScheduleFrame() {
   client_.ScheduleFrame();
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::RequestFrameRate(double frame_rate) {
+  client_.RequestFrameRate(frame_rate);
+}
+
 // |PlatformConfigurationClient|
 void RuntimeController::Render(Scene* scene) {
   // TODO(dkwingsmt): Currently only supports a single window.
@@ -657,6 +657,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void ScheduleFrame() override;
 
+  // |PlatformConfigurationClient|
+  void RequestFrameRate(double frame_rate) override;
+
   // |PlatformConfigurationClient|
   void Render(Scene* scene) override;
 
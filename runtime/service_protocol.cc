@@ -24,6 +24,8 @@ const std::string_view ServiceProtocol::kScreenshotExtensionName =
     "_flutter.screenshot";
 const std::string_view ServiceProtocol::kScreenshotSkpExtensionName =
     "_flutter.screenshotSkp";
+const std::string_view ServiceProtocol::kScreenshotLayerTreeExtensionName =
+    "_flutter.screenshotLayerTree";
 const std::string_view ServiceProtocol::kRunInViewExtensionName =
     "_flutter.runInView";
 const std::string_view ServiceProtocol::kFlushUIThreadTasksExtensionName =
@@ -42,6 +44,18 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view
+    ServiceProtocol::kGetFlightRecorderEventsExtensionName =
+        "_flutter.getFlightRecorderEvents";
+const std::string_view ServiceProtocol::kGetFrameTimingStatsExtensionName =
+    "_flutter.getFrameTimingStats";
+const std::string_view ServiceProtocol::kGetEngineCountersExtensionName =
+    "_flutter.getEngineCounters";
+const std::string_view
+    ServiceProtocol::kSetImpellerCaptureEnabledExtensionName =
+        "_flutter.setImpellerCaptureEnabled";
+const std::string_view ServiceProtocol::kGetImpellerCaptureExtensionName =
+    "_flutter.getImpellerCapture";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -55,6 +69,7 @@ ServiceProtocol::ServiceProtocol()
           // Public
           kScreenshotExtensionName,
           kScreenshotSkpExtensionName,
+          kScreenshotLayerTreeExtensionName,
           kRunInViewExtensionName,
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
@@ -63,6 +78,11 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kGetFlightRecorderEventsExtensionName,
+          kGetFrameTimingStatsExtensionName,
+          kGetEngineCountersExtensionName,
+          kSetImpellerCaptureEnabledExtensionName,
+          kGetImpellerCaptureExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
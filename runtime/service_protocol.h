@@ -23,6 +23,7 @@ class ServiceProtocol {
  public:
   static const std::string_view kScreenshotExtensionName;
   static const std::string_view kScreenshotSkpExtensionName;
+  static const std::string_view kScreenshotLayerTreeExtensionName;
   static const std::string_view kRunInViewExtensionName;
   static const std::string_view kFlushUIThreadTasksExtensionName;
   static const std::string_view kSetAssetBundlePathExtensionName;
@@ -31,6 +32,11 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetFlightRecorderEventsExtensionName;
+  static const std::string_view kGetFrameTimingStatsExtensionName;
+  static const std::string_view kGetEngineCountersExtensionName;
+  static const std::string_view kSetImpellerCaptureEnabledExtensionName;
+  static const std::string_view kGetImpellerCaptureExtensionName;
 
   class Handler {
    public:
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+#include <string>
+
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
@@ -19,6 +22,11 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// Gaps between external texture frames longer than this are pauses rather
+// than frame intervals, and end the frame rate request of the textures.
+constexpr fml::TimeDelta kMaxTextureFrameInterval =
+    fml::TimeDelta::FromMilliseconds(250);
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -88,6 +96,14 @@ void Animator::BeginFrame(
   pending_frame_semaphore_.Signal();
 
   if (!producer_continuation_) {
+    if (!CanProduceFrame()) {
+      // The previous frame is still in flight and the depth policy wants to
+      // wait for it. Try again at the next frame interval.
+      TRACE_EVENT0("flutter", "PipelineDepthLimited");
+      RequestFrame();
+      return;
+    }
+
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
     // instead of asking the pipeline for a fresh continuation.
@@ -118,7 +134,7 @@ void Animator::BeginFrame(
     // VM when we are about to schedule a frame in the next vsync, the idea
     // being that if there have been three vsyncs with no frames it's a good
     // time to start doing GC work.
-    task_runners_.GetUITaskRunner()->PostDelayedTask(
+    task_runners_.GetUITaskRunner()->PostTaskForTimeWithPriority(
         [self = weak_factory_.GetWeakPtr()]() {
           if (!self) {
             return;
@@ -136,7 +152,8 @@ void Animator::BeginFrame(
             }
           }
         },
-        kNotifyIdleTaskWaitTime);
+        fml::TimePoint::Now() + kNotifyIdleTaskWaitTime,
+        fml::TaskPriority::kIdle);
   }
 }
 
@@ -157,6 +174,7 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
                                 "Animator::Render", /*flow_id_count=*/0,
                                 /*flow_ids=*/nullptr);
   frame_timings_recorder_->RecordBuildEnd(fml::TimePoint::Now());
+  waiter_->RecordBuildDuration(frame_timings_recorder_->GetBuildDuration());
 
   delegate_.OnAnimatorUpdateLatestFrameTargetTime(
       frame_timings_recorder_->GetVsyncTargetTime());
@@ -183,6 +201,79 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
   delegate_.OnAnimatorDraw(layer_tree_pipeline_);
 }
 
+void Animator::SetAdaptivePipelineDepth(bool enabled) {
+  if (!enabled) {
+    pipeline_depth_policy_.reset();
+    return;
+  }
+  if (!pipeline_depth_policy_) {
+    pipeline_depth_policy_ =
+        std::make_unique<PipelineDepthPolicy>(layer_tree_pipeline_->GetDepth());
+    pipeline_depth_policy_->SetLatencySensitive(latency_sensitive_);
+  }
+}
+
+void Animator::SetLatencySensitive(bool latency_sensitive) {
+  latency_sensitive_ = latency_sensitive;
+  if (pipeline_depth_policy_) {
+    pipeline_depth_policy_->SetLatencySensitive(latency_sensitive);
+  }
+}
+
+void Animator::RequestFrameRate(FrameRateSource source, double frame_rate) {
+  requested_frame_rates_[static_cast<size_t>(source)] =
+      frame_rate > 0 ? frame_rate : 0;
+  UpdatePreferredFrameRate();
+}
+
+void Animator::OnExternalTextureFrameAvailable() {
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const fml::TimeDelta interval = now - last_texture_frame_time_;
+  last_texture_frame_time_ = now;
+  if (interval > kMaxTextureFrameInterval) {
+    texture_frame_interval_ = fml::TimeDelta::Zero();
+    return;
+  }
+  // Smooth over the jitter of the texture's frames, so that the requested
+  // rate only follows sustained changes.
+  texture_frame_interval_ =
+      texture_frame_interval_ == fml::TimeDelta::Zero()
+          ? interval
+          : (texture_frame_interval_ * 3 + interval) / 4;
+  if (texture_frame_interval_ > fml::TimeDelta::Zero()) {
+    RequestFrameRate(FrameRateSource::kExternalTexture,
+                     1.0 / texture_frame_interval_.ToSecondsF());
+  }
+}
+
+void Animator::UpdatePreferredFrameRate() {
+  if (texture_frame_interval_ > fml::TimeDelta::Zero() &&
+      fml::TimePoint::Now() - last_texture_frame_time_ >
+          kMaxTextureFrameInterval) {
+    texture_frame_interval_ = fml::TimeDelta::Zero();
+    requested_frame_rates_[static_cast<size_t>(
+        FrameRateSource::kExternalTexture)] = 0;
+  }
+  const double frame_rate = *std::max_element(requested_frame_rates_.begin(),
+                                              requested_frame_rates_.end());
+  if (frame_rate == preferred_frame_rate_) {
+    return;
+  }
+  preferred_frame_rate_ = frame_rate;
+  TRACE_EVENT1("flutter", "Animator::UpdatePreferredFrameRate", "frame_rate",
+               std::to_string(frame_rate).c_str());
+  waiter_->SetPreferredFrameRate(frame_rate);
+}
+
+bool Animator::CanProduceFrame() {
+  if (!pipeline_depth_policy_) {
+    return true;
+  }
+  const size_t frames_in_flight = layer_tree_pipeline_->GetInflightCount();
+  return frames_in_flight <
+         pipeline_depth_policy_->BeginFrame(frames_in_flight);
+}
+
 const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   std::weak_ptr<VsyncWaiter> weak = waiter_;
   return weak;
@@ -244,6 +335,7 @@ void Animator::RequestFrame(bool regenerate_layer_tree) {
 }
 
 void Animator::AwaitVSync() {
+  UpdatePreferredFrameRate();
   waiter_->AsyncWaitForVsync(
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
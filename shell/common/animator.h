@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_ANIMATOR_H_
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
+#include <array>
 #include <deque>
 
 #include "flutter/common/task_runners.h"
@@ -77,6 +78,42 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Lets the number of frames in flight follow the workload instead
+  ///           of always allowing as many as the layer tree pipeline holds.
+  ///
+  /// @see      `PipelineDepthPolicy`
+  void SetAdaptivePipelineDepth(bool enabled);
+
+  //--------------------------------------------------------------------------
+  /// @brief    Marks periods, such as while a pointer is down, during which
+  ///           frames are produced one at a time to keep the input latency
+  ///           low. Only used with an adaptive pipeline depth.
+  void SetLatencySensitive(bool latency_sensitive);
+
+  /// What is asking for frames to be produced at a particular rate.
+  enum class FrameRateSource {
+    /// The framework, on behalf of its animations and scrolls.
+    kFramework,
+    /// External textures, such as video, that produce frames of their own.
+    kExternalTexture,
+  };
+
+  //--------------------------------------------------------------------------
+  /// @brief    Records the frame rate `source` would like frames produced at,
+  ///           or withdraws its request if `frame_rate` is 0. The vsync
+  ///           waiter is asked for the highest rate currently requested, or
+  ///           for the display's default rate if there are none.
+  ///
+  /// @see      `VsyncWaiter::SetPreferredFrameRate`
+  void RequestFrameRate(FrameRateSource source, double frame_rate);
+
+  //--------------------------------------------------------------------------
+  /// @brief    Estimates the rate at which external textures produce frames
+  ///           and requests it on their behalf. The request is withdrawn
+  ///           once they stop producing frames.
+  void OnExternalTextureFrameAvailable();
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -92,6 +129,13 @@ class Animator final {
 
   void AwaitVSync();
 
+  // Whether the pipeline depth policy allows producing another frame now.
+  bool CanProduceFrame();
+
+  // Passes the highest requested frame rate on to the vsync waiter if it
+  // changed, after dropping the request of external textures that went quiet.
+  void UpdatePreferredFrameRate();
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
@@ -103,6 +147,14 @@ class Animator final {
   uint64_t frame_request_number_ = 1;
   fml::TimeDelta dart_frame_deadline_;
   std::shared_ptr<LayerTreePipeline> layer_tree_pipeline_;
+  // Null unless the pipeline depth is adaptive.
+  std::unique_ptr<PipelineDepthPolicy> pipeline_depth_policy_;
+  bool latency_sensitive_ = false;
+  // Indexed by |FrameRateSource|, 0 where there is no request.
+  std::array<double, 2> requested_frame_rates_ = {};
+  double preferred_frame_rate_ = 0;
+  fml::TimePoint last_texture_frame_time_;
+  fml::TimeDelta texture_frame_interval_;
   fml::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   bool regenerate_layer_tree_ = false;
@@ -254,6 +254,43 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+class FrameRateRecordingVsyncWaiter : public ShellTestVsyncWaiter {
+ public:
+  using ShellTestVsyncWaiter::ShellTestVsyncWaiter;
+
+  void SetPreferredFrameRate(double frame_rate) override {
+    frame_rates_.push_back(frame_rate);
+  }
+
+  std::vector<double> frame_rates_;
+};
+
+TEST_F(ShellTest, AnimatorRequestsHighestFrameRate) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = std::make_unique<FrameRateRecordingVsyncWaiter>(
+        task_runners, std::make_shared<ShellTestVsyncClock>());
+    FrameRateRecordingVsyncWaiter* waiter = vsync_waiter.get();
+    Animator animator(delegate, task_runners, std::move(vsync_waiter));
+
+    animator.RequestFrameRate(Animator::FrameRateSource::kFramework, 60);
+    animator.RequestFrameRate(Animator::FrameRateSource::kExternalTexture,
+                              30);
+    animator.RequestFrameRate(Animator::FrameRateSource::kFramework, 0);
+    animator.RequestFrameRate(Animator::FrameRateSource::kExternalTexture, 0);
+
+    EXPECT_THAT(waiter->frame_rates_, ::testing::ElementsAre(60, 30, 0));
+  });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
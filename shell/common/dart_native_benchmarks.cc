@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <vector>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_fixture.h"
@@ -11,6 +13,7 @@
 #include "flutter/testing/testing.h"
 #include "fml/synchronization/count_down_latch.h"
 #include "runtime/dart_vm_lifecycle.h"
+#include "third_party/tonic/dart_args.h"
 
 // CREATE_NATIVE_ENTRY is leaky by design
 // NOLINTBEGIN(clang-analyzer-core.StackAddressEscape)
@@ -103,6 +106,97 @@ BENCHMARK_F(DartNativeBenchmarks, MultipleDartToNativeMessages)
   }
 }
 
+namespace {
+
+double g_doubles_sum = 0.0;
+
+void TakeDoubles(double a, double b, double c, double d) {
+  g_doubles_sum += a + b + c + d;
+}
+
+// Runs `entrypoint`, which calls `TakeDoubles` 1000 times between two calls to
+// `NotifyNative`, and reports the time between those calls. Natives declared
+// with `@pragma('vm:external-name')` convert their arguments with
+// `DartArgIterator`, which calls `Dart_GetNativeArgument` for each of them, and
+// `@Native` FFI calls pass them directly.
+void RunThousandCallsWithArguments(DartFixture& fixture,
+                                   benchmark::State& st,
+                                   const std::string& entrypoint) {
+  while (st.KeepRunning()) {
+    fml::CountDownLatch latch(2);
+    std::vector<fml::TimePoint> notifications;
+    ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+    fixture.AddNativeCallback(
+        "NotifyNative", CREATE_NATIVE_ENTRY(([&latch, &notifications](
+                                                 Dart_NativeArguments args) {
+          notifications.push_back(fml::TimePoint::Now());
+          latch.CountDown();
+        })));
+    fixture.AddNativeCallback(
+        "TakeDoubles", CREATE_NATIVE_ENTRY(([](Dart_NativeArguments args) {
+          tonic::DartCallStatic(&TakeDoubles, args);
+        })));
+    fixture.AddFfiNativeCallback(
+        "TakeDoubles",
+        reinterpret_cast<void*>(
+            tonic::FfiDispatcher<void, decltype(&TakeDoubles),
+                                 &TakeDoubles>::Call));
+
+    const auto settings = fixture.CreateSettingsForFixture();
+    DartVMRef vm_ref = DartVMRef::Create(settings);
+
+    ThreadHost thread_host("io.flutter.test.DartNativeBenchmarks.",
+                           ThreadHost::Type::Platform | ThreadHost::Type::IO |
+                               ThreadHost::Type::UI);
+    TaskRunners task_runners(
+        "test",
+        thread_host.platform_thread->GetTaskRunner(),  // platform
+        thread_host.platform_thread->GetTaskRunner(),  // raster
+        thread_host.ui_thread->GetTaskRunner(),        // ui
+        thread_host.io_thread->GetTaskRunner()         // io
+    );
+
+    {
+      auto isolate =
+          RunDartCodeInIsolate(vm_ref, settings, task_runners, entrypoint, {},
+                               GetDefaultKernelFilePath());
+      ASSERT_TRUE(isolate);
+      ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+      latch.Wait();
+    }
+    st.SetIterationTime((notifications[1] - notifications[0]).ToSecondsF());
+  }
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(DartNativeBenchmarks, ThousandCallsWithArgumentsToNative)
+(benchmark::State& st) {
+  RunThousandCallsWithArguments(*this, st,
+                                "thousandCallsWithArgumentsToNative");
+}
+BENCHMARK_REGISTER_F(DartNativeBenchmarks, ThousandCallsWithArgumentsToNative)
+    ->UseManualTime();
+
+BENCHMARK_DEFINE_F(DartNativeBenchmarks, ThousandCallsWithArgumentsToFfiNative)
+(benchmark::State& st) {
+  RunThousandCallsWithArguments(*this, st,
+                                "thousandCallsWithArgumentsToFfiNative");
+}
+BENCHMARK_REGISTER_F(DartNativeBenchmarks,
+                     ThousandCallsWithArgumentsToFfiNative)
+    ->UseManualTime();
+
+BENCHMARK_DEFINE_F(DartNativeBenchmarks,
+                   ThousandCallsWithArgumentsToFfiLeafNative)
+(benchmark::State& st) {
+  RunThousandCallsWithArguments(*this, st,
+                                "thousandCallsWithArgumentsToFfiLeafNative");
+}
+BENCHMARK_REGISTER_F(DartNativeBenchmarks,
+                     ThousandCallsWithArgumentsToFfiLeafNative)
+    ->UseManualTime();
+
 }  // namespace flutter::testing
 
 // NOLINTEND(clang-analyzer-core.StackAddressEscape)
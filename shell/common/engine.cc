@@ -60,6 +60,14 @@ Engine::Engine(
       task_runners_(task_runners),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  if (animator_) {
+    animator_->SetAdaptivePipelineDepth(
+        settings_.enable_adaptive_pipeline_depth);
+    if (auto vsync_waiter = animator_->GetVsyncWaiter().lock()) {
+      vsync_waiter->SetDelayBeginFrameByBuildTime(
+          settings_.enable_vsync_phase_offset);
+    }
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -85,6 +93,20 @@ Engine::Engine(Delegate& delegate,
              std::make_shared<FontCollection>(),
              nullptr,
              gpu_disabled_switch) {
+  UIDartState::Context context{
+      task_runners_,                           // task runners
+      std::move(snapshot_delegate),            // snapshot delegate
+      std::move(io_manager),                   // io manager
+      std::move(unref_queue),                  // Skia unref queue
+      image_decoder_->GetWeakPtr(),            // image decoder
+      image_generator_registry_.GetWeakPtr(),  // image generator registry
+      settings_.advisory_script_uri,           // advisory script uri
+      settings_.advisory_script_entrypoint,    // advisory script entrypoint
+      std::move(volatile_path_tracker),        // volatile path tracker
+      vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
+      settings_.enable_impeller,               // enable impeller
+  };
+  context.attribute_interner = std::make_shared<DlAttributeInterner>();
   runtime_controller_ = std::make_unique<RuntimeController>(
       *this,                                 // runtime delegate
       &vm,                                   // VM
@@ -94,19 +116,7 @@ Engine::Engine(Delegate& delegate,
       settings_.isolate_create_callback,     // isolate create callback
       settings_.isolate_shutdown_callback,   // isolate shutdown callback
       settings_.persistent_isolate_data,     // persistent isolate data
-      UIDartState::Context{
-          task_runners_,                           // task runners
-          std::move(snapshot_delegate),            // snapshot delegate
-          std::move(io_manager),                   // io manager
-          std::move(unref_queue),                  // Skia unref queue
-          image_decoder_->GetWeakPtr(),            // image decoder
-          image_generator_registry_.GetWeakPtr(),  // image generator registry
-          settings_.advisory_script_uri,           // advisory script uri
-          settings_.advisory_script_entrypoint,    // advisory script entrypoint
-          std::move(volatile_path_tracker),        // volatile path tracker
-          vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
-          settings_.enable_impeller,               // enable impeller
-      });
+      context);                              // context
 }
 
 std::unique_ptr<Engine> Engine::Spawn(
@@ -130,6 +140,9 @@ std::unique_ptr<Engine> Engine::Spawn(
       /*font_collection=*/font_collection_,
       /*runtime_controller=*/nullptr,
       /*gpu_disabled_switch=*/gpu_disabled_switch);
+  if (settings.share_resources_with_spawned_engines) {
+    result->image_decoder_ = image_decoder_;
+  }
   result->runtime_controller_ = runtime_controller_->Spawn(
       /*p_client=*/*result,
       /*advisory_script_uri=*/settings.advisory_script_uri,
@@ -183,7 +196,12 @@ bool Engine::UpdateAssetManager(
 
   // Using libTXT as the text engine.
   if (settings_.use_asset_fonts) {
-    font_collection_->RegisterFonts(asset_manager_);
+    std::shared_ptr<fml::ConcurrentTaskRunner> font_preload_task_runner;
+    if (runtime_controller_ && runtime_controller_->GetDartVM()) {
+      font_preload_task_runner =
+          runtime_controller_->GetDartVM()->GetConcurrentWorkerTaskRunner();
+    }
+    font_collection_->RegisterFonts(asset_manager_, font_preload_task_runner);
   }
 
   if (settings_.use_test_fonts) {
@@ -346,6 +364,15 @@ bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
       state == "AppLifecycleState.inactive") {
     ScheduleFrame();
   }
+  if (settings_.release_snapshot_pages_in_background) {
+    if (const auto& snapshot = runtime_controller_->GetIsolateSnapshot()) {
+      if (state == "AppLifecycleState.paused") {
+        snapshot->ReleaseResidentPages();
+      } else if (state == "AppLifecycleState.resumed") {
+        snapshot->Prefetch();
+      }
+    }
+  }
   runtime_controller_->SetInitialLifecycleState(state);
   // Always forward these messages to the framework by returning false.
   return false;
@@ -459,6 +486,15 @@ void Engine::ScheduleFrame(bool regenerate_layer_tree) {
   animator_->RequestFrame(regenerate_layer_tree);
 }
 
+void Engine::RequestFrameRate(double frame_rate) {
+  animator_->RequestFrameRate(Animator::FrameRateSource::kFramework,
+                              frame_rate);
+}
+
+void Engine::OnExternalTextureFrameAvailable() {
+  animator_->OnExternalTextureFrameAvailable();
+}
+
 void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
                     float device_pixel_ratio) {
   if (!layer_tree) {
@@ -516,11 +552,33 @@ FontCollection& Engine::GetFontCollection() {
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
+  if (settings_.enable_adaptive_pipeline_depth) {
+    UpdateActivePointerCount(*packet);
+  }
   if (runtime_controller_) {
     runtime_controller_->DispatchPointerDataPacket(*packet);
   }
 }
 
+void Engine::UpdateActivePointerCount(const PointerDataPacket& packet) {
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    switch (packet.GetPointerData(i).change) {
+      case PointerData::Change::kDown:
+        active_pointer_count_++;
+        break;
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel:
+        if (active_pointer_count_ > 0) {
+          active_pointer_count_--;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  animator_->SetLatencySensitive(active_pointer_count_ > 0);
+}
+
 void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                             const fml::closure& callback) {
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
@@ -834,6 +834,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   /// tree.
   void ScheduleFrame() { ScheduleFrame(true); }
 
+  // |RuntimeDelegate|
+  void RequestFrameRate(double frame_rate) override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that an external texture has a new frame,
+  ///             so that the frame rate follows the rate of the texture's
+  ///             content, such as a video, while it keeps producing frames.
+  ///
+  void OnExternalTextureFrameAvailable();
+
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
@@ -995,6 +1005,10 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   double GetScaledFontSize(double unscaled_font_size,
                            int configuration_id) const override;
 
+  // Tells the animator whether a pointer is down, which keeps frames from
+  // being built ahead of the raster thread.
+  void UpdateActivePointerCount(const PointerDataPacket& packet);
+
   void SetNeedsReportTimings(bool value) override;
 
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
@@ -1021,6 +1035,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // So it should be defined after them to ensure that pointer_data_dispatcher_
   // is destructed first.
   std::unique_ptr<PointerDataDispatcher> pointer_data_dispatcher_;
+  // The number of pointers that are down, tracked for the adaptive pipeline
+  // depth.
+  size_t active_pointer_count_ = 0;
 
   std::string last_entry_point_;
   std::string last_entry_point_library_;
@@ -1028,7 +1045,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
-  const std::unique_ptr<ImageDecoder> image_decoder_;
+  // Shared with spawned engines when
+  // `Settings::share_resources_with_spawned_engines` is set.
+  std::shared_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
   fml::WeakPtrFactory<Engine> weak_factory_;  // Must be the last member.
@@ -63,6 +63,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
  public:
   MOCK_METHOD(std::string, DefaultRouteName, (), (override));
   MOCK_METHOD(void, ScheduleFrame, (bool), (override));
+  MOCK_METHOD(void, RequestFrameRate, (double), (override));
   MOCK_METHOD(void,
               Render,
               (std::unique_ptr<flutter::LayerTree>, float),
@@ -325,6 +326,42 @@ TEST_F(EngineTest, SpawnSharesFontLibrary) {
   });
 }
 
+TEST_F(EngineTest, SpawnSharesImageDecoderWhenAskedTo) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    auto vm_ref = DartVMRef::Create(settings_);
+    EXPECT_CALL(*mock_runtime_controller, GetDartVM())
+        .WillRepeatedly(::testing::Return(vm_ref.get()));
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller),
+        /*gpu_disabled_switch=*/std::make_shared<fml::SyncSwitch>());
+
+    auto unshared_spawn =
+        engine->Spawn(delegate_, dispatcher_maker_, settings_, nullptr,
+                      std::string(), io_manager_, snapshot_delegate_, nullptr);
+    EXPECT_NE(engine->GetImageDecoderWeakPtr().get(),
+              unshared_spawn->GetImageDecoderWeakPtr().get());
+
+    Settings sharing_settings = settings_;
+    sharing_settings.share_resources_with_spawned_engines = true;
+    auto shared_spawn = engine->Spawn(
+        delegate_, dispatcher_maker_, sharing_settings, nullptr, std::string(),
+        io_manager_, snapshot_delegate_, nullptr);
+    EXPECT_EQ(engine->GetImageDecoderWeakPtr().get(),
+              shared_spawn->GetImageDecoderWeakPtr().get());
+  });
+}
+
 TEST_F(EngineTest, SpawnWithCustomInitialRoute) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
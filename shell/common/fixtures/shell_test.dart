@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:convert' show utf8, json;
+import 'dart:ffi' show Double, Native, Void;
 import 'dart:isolate';
 import 'dart:typed_data';
 import 'dart:ui';
@@ -137,6 +138,42 @@ void thousandCallsToNative() {
   }
 }
 
+@pragma('vm:external-name', 'TakeDoubles')
+external void takeDoubles(double a, double b, double c, double d);
+
+@Native<Void Function(Double, Double, Double, Double)>(symbol: 'TakeDoubles')
+external void takeDoublesFfi(double a, double b, double c, double d);
+
+@Native<Void Function(Double, Double, Double, Double)>(symbol: 'TakeDoubles', isLeaf: true)
+external void takeDoublesFfiLeaf(double a, double b, double c, double d);
+
+@pragma('vm:entry-point')
+void thousandCallsWithArgumentsToNative() {
+  notifyNative();
+  for (int i = 0; i < 1000; i++) {
+    takeDoubles(i + 0.0, i + 1.0, i + 2.0, i + 3.0);
+  }
+  notifyNative();
+}
+
+@pragma('vm:entry-point')
+void thousandCallsWithArgumentsToFfiNative() {
+  notifyNative();
+  for (int i = 0; i < 1000; i++) {
+    takeDoublesFfi(i + 0.0, i + 1.0, i + 2.0, i + 3.0);
+  }
+  notifyNative();
+}
+
+@pragma('vm:entry-point')
+void thousandCallsWithArgumentsToFfiLeafNative() {
+  notifyNative();
+  for (int i = 0; i < 1000; i++) {
+    takeDoublesFfiLeaf(i + 0.0, i + 1.0, i + 2.0, i + 3.0);
+  }
+  notifyNative();
+}
+
 void secondaryIsolateMain(String message) {
   print('Secondary isolate got message: ' + message);
   notifyNative();
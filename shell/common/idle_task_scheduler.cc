@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace flutter {
+
+IdleTaskScheduler::IdleTaskScheduler() = default;
+
+IdleTaskScheduler::~IdleTaskScheduler() = default;
+
+IdleTaskScheduler::TaskId IdleTaskScheduler::AddTask(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    fml::TimeDelta budget,
+    Task task) {
+  FML_DCHECK(task_runner);
+  FML_DCHECK(task);
+  std::scoped_lock lock(mutex_);
+  const TaskId id = next_id_++;
+  entries_[id] = std::make_shared<Entry>(Entry{
+      .task_runner = std::move(task_runner),
+      .budget = budget,
+      .task = std::move(task),
+  });
+  return id;
+}
+
+void IdleTaskScheduler::RemoveTask(TaskId id) {
+  std::scoped_lock lock(mutex_);
+  entries_.erase(id);
+}
+
+void IdleTaskScheduler::NotifyIdle(fml::TimeDelta deadline) {
+  if (deadline - Now() < kMinimumIdleTime) {
+    return;
+  }
+  std::vector<fml::RefPtr<fml::TaskRunner>> task_runners;
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& [id, entry] : entries_) {
+      if (pending_task_runners_.insert(entry->task_runner.get()).second) {
+        task_runners.push_back(entry->task_runner);
+      }
+    }
+  }
+  for (const auto& task_runner : task_runners) {
+    task_runner->PostTask(
+        [weak = weak_from_this(), task_runner, deadline]() {
+          if (auto scheduler = weak.lock()) {
+            scheduler->RunTasks(task_runner, deadline);
+          }
+        });
+  }
+}
+
+fml::TimeDelta IdleTaskScheduler::Now() {
+  return fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+}
+
+void IdleTaskScheduler::RunTasks(
+    const fml::RefPtr<fml::TaskRunner>& task_runner,
+    fml::TimeDelta deadline) {
+  TRACE_EVENT0("flutter", "IdleTaskScheduler::RunTasks");
+  std::unordered_set<TaskId> ran;
+  while (true) {
+    std::shared_ptr<Entry> next;
+    {
+      std::scoped_lock lock(mutex_);
+      const fml::TimeDelta now = Now();
+      TaskId next_id = 0u;
+      for (const auto& [id, entry] : entries_) {
+        if (entry->task_runner.get() != task_runner.get() ||
+            ran.count(id) > 0 || now + entry->budget > deadline) {
+          continue;
+        }
+        if (!next || entry->last_run < next->last_run) {
+          next = entry;
+          next_id = id;
+        }
+      }
+      if (!next) {
+        pending_task_runners_.erase(task_runner.get());
+        return;
+      }
+      ran.insert(next_id);
+      next->last_run = ++run_count_;
+    }
+    next->task(deadline);
+  }
+}
+
+}  // namespace flutter
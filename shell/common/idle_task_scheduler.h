@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs deferred engine work, such as cache cleanup, in the idle
+///             periods that the animator reports between frames instead of
+///             in the frames themselves.
+///
+///             Each task runs on the task runner it was added with. In every
+///             idle period, the tasks of a task runner run one after another,
+///             those that have waited the longest first, for as long as their
+///             budget fits before the deadline. Tasks are given the deadline
+///             and should split long work into slices that return before it.
+///             Tasks that don't fit wait for a later idle period.
+///
+class IdleTaskScheduler
+    : public std::enable_shared_from_this<IdleTaskScheduler> {
+ public:
+  using TaskId = size_t;
+
+  /// Does a slice of deferred work. The deadline uses the clock of
+  /// `Dart_TimelineGetMicros`, like the deadline of `NotifyIdle`.
+  using Task = std::function<void(fml::TimeDelta deadline)>;
+
+  // Idle periods shorter than this are ignored.
+  static constexpr fml::TimeDelta kMinimumIdleTime =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  IdleTaskScheduler();
+
+  ~IdleTaskScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a task that runs on `task_runner` in every idle period
+  ///             with at least `budget` left, until it is removed.
+  ///
+  /// @return     The id to remove the task with.
+  ///
+  TaskId AddTask(fml::RefPtr<fml::TaskRunner> task_runner,
+                 fml::TimeDelta budget,
+                 Task task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a task. A task that is running when it is removed
+  ///             finishes its current slice.
+  ///
+  void RemoveTask(TaskId id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the tasks that fit in the idle period that ends at
+  ///             `deadline`. Can be called on any thread.
+  ///
+  void NotifyIdle(fml::TimeDelta deadline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The current time on the clock used for deadlines.
+  ///
+  static fml::TimeDelta Now();
+
+ private:
+  struct Entry {
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    fml::TimeDelta budget;
+    Task task;
+    // The value of |run_count_| when the task last ran.
+    uint64_t last_run = 0u;
+  };
+
+  std::mutex mutex_;
+  TaskId next_id_ = 1u;
+  uint64_t run_count_ = 0u;
+  std::map<TaskId, std::shared_ptr<Entry>> entries_;
+  // The task runners that already have their tasks scheduled for an idle
+  // period.
+  std::set<fml::TaskRunner*> pending_task_runners_;
+
+  void RunTasks(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                fml::TimeDelta deadline);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
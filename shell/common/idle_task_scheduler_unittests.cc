@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <vector>
+
+#include "flutter/fml/message_loop.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(IdleTaskSchedulerTest, RunsTasksThatFitInIdlePeriods) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  auto scheduler = std::make_shared<IdleTaskScheduler>();
+
+  std::vector<int> runs;
+  scheduler->AddTask(task_runner, fml::TimeDelta::FromMilliseconds(1),
+                     [&runs](fml::TimeDelta deadline) { runs.push_back(1); });
+  auto removed_task = scheduler->AddTask(
+      task_runner, fml::TimeDelta::FromMilliseconds(1),
+      [&runs](fml::TimeDelta deadline) { runs.push_back(2); });
+  scheduler->AddTask(task_runner, fml::TimeDelta::FromSeconds(60),
+                     [&runs](fml::TimeDelta deadline) { runs.push_back(3); });
+  scheduler->RemoveTask(removed_task);
+
+  // Too short to run anything.
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromMicroseconds(100));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  EXPECT_TRUE(runs.empty());
+
+  // Tasks run once per idle period, unless their budget doesn't fit.
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromSeconds(10));
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromSeconds(10));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  EXPECT_EQ(runs, std::vector<int>({1}));
+
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromSeconds(10));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  EXPECT_EQ(runs, std::vector<int>({1, 1}));
+}
+
+TEST(IdleTaskSchedulerTest, RunsEveryTaskOfATaskRunnerInOrder) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  auto scheduler = std::make_shared<IdleTaskScheduler>();
+
+  std::vector<int> runs;
+  scheduler->AddTask(task_runner, fml::TimeDelta::FromMilliseconds(1),
+                     [&runs](fml::TimeDelta deadline) { runs.push_back(1); });
+  scheduler->AddTask(task_runner, fml::TimeDelta::FromMilliseconds(1),
+                     [&runs](fml::TimeDelta deadline) { runs.push_back(2); });
+
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromSeconds(10));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  scheduler->NotifyIdle(IdleTaskScheduler::Now() +
+                        fml::TimeDelta::FromSeconds(10));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+  EXPECT_EQ(runs, std::vector<int>({1, 2, 1, 2}));
+}
+
+}  // namespace testing
+}  // namespace flutter
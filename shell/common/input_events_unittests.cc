@@ -432,6 +432,68 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+class RecordingPointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatched_packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> dispatched_packets;
+  fml::closure vsync_callback;
+};
+
+TEST(CoalescingPointerDataDispatcherTest, MergesPacketsReceivedWithinAFrame) {
+  RecordingPointerDataDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  auto make_packet = [](double x) {
+    auto packet = std::make_unique<PointerDataPacket>(1);
+    PointerData data;
+    CreateSimulatedPointerData(data, PointerData::Change::kMove, x, 0.0);
+    packet->SetPointerData(0, data);
+    return packet;
+  };
+
+  // The first packet is dispatched right away.
+  dispatcher.DispatchPacket(make_packet(1.0), 1);
+  ASSERT_EQ(delegate.dispatched_packets.size(), 1u);
+
+  // Packets that arrive before the next vsync are merged in order.
+  dispatcher.DispatchPacket(make_packet(2.0), 2);
+  dispatcher.DispatchPacket(make_packet(3.0), 3);
+  dispatcher.DispatchPacket(make_packet(4.0), 4);
+  ASSERT_EQ(delegate.dispatched_packets.size(), 1u);
+
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.dispatched_packets.size(), 2u);
+  const auto& merged = delegate.dispatched_packets[1];
+  ASSERT_EQ(merged->GetLength(), 3u);
+  EXPECT_EQ(merged->GetPointerData(0).physical_x, 2.0);
+  EXPECT_EQ(merged->GetPointerData(1).physical_x, 3.0);
+  EXPECT_EQ(merged->GetPointerData(2).physical_x, 4.0);
+
+  // After a frame without input, packets are dispatched right away again.
+  delegate.FireVsync();
+  dispatcher.DispatchPacket(make_packet(5.0), 5);
+  ASSERT_EQ(delegate.dispatched_packets.size(), 3u);
+  EXPECT_EQ(delegate.dispatched_packets[2]->GetPointerData(0).physical_x, 5.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -12,6 +12,7 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
@@ -199,5 +200,41 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, CountsSkSLUsageAcrossRuns) {
+  sk_sp<SkData> used_key = SkData::MakeWithCString("used");
+  sk_sp<SkData> unused_key = SkData::MakeWithCString("unused");
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+  PersistentCache::SetAssetManager(nullptr);
+
+  auto worker = CreateNewThread("worker");
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  persistent_cache->AddWorkerTaskRunner(worker);
+  persistent_cache->load(*used_key);
+  persistent_cache->load(*used_key);
+  EXPECT_EQ(persistent_cache->GetSkSLUsageCount(*used_key), 2u);
+  EXPECT_EQ(persistent_cache->GetSkSLUsageCount(*unused_key), 0u);
+
+  fml::AutoResetWaitableEvent latch;
+  worker->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();  // Wait for the worker to write the counts.
+  persistent_cache->RemoveWorkerTaskRunner(worker);
+
+  // The counts are read back by the next run, and the file holding them is
+  // not mistaken for an SkSL.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  EXPECT_EQ(persistent_cache->GetSkSLUsageCount(*used_key), 2u);
+  EXPECT_EQ(persistent_cache->LoadSkSLs().size(), 0u);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pipeline.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 size_t GetNextPipelineTraceID() {
@@ -11,4 +13,27 @@ size_t GetNextPipelineTraceID() {
   return ++PipelineLastTraceID;
 }
 
+PipelineDepthPolicy::PipelineDepthPolicy(size_t max_depth)
+    : max_depth_(std::max<size_t>(max_depth, 1u)) {}
+
+void PipelineDepthPolicy::SetLatencySensitive(bool latency_sensitive) {
+  latency_sensitive_ = latency_sensitive;
+}
+
+size_t PipelineDepthPolicy::BeginFrame(size_t frames_in_flight) {
+  if (frames_in_flight > 0u) {
+    raster_bound_frame_count_++;
+    raster_idle_frame_count_ = 0u;
+  } else {
+    raster_idle_frame_count_++;
+    raster_bound_frame_count_ = 0u;
+  }
+  if (raster_bound_frame_count_ >= kFramesBeforeDepthChange) {
+    depth_ = max_depth_;
+  } else if (raster_idle_frame_count_ >= kFramesBeforeDepthChange) {
+    depth_ = 1u;
+  }
+  return latency_sensitive_ ? 1u : depth_;
+}
+
 }  // namespace flutter
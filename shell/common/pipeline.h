@@ -34,6 +34,48 @@ enum class PipelineConsumeResult {
 
 size_t GetNextPipelineTraceID();
 
+//------------------------------------------------------------------------------
+/// @brief      Decides how many frames a producer may keep in a pipeline at
+///             once.
+///
+///             A deeper pipeline lets the UI thread build the next frame while
+///             the raster thread is still busy with the last one, at the cost
+///             of one more frame of latency. The depth is raised to the
+///             maximum after a few consecutive frames find the previous frame
+///             still in flight, and lowered to one after a few frames find the
+///             pipeline empty, so that it doesn't switch back and forth (see
+///             `Engine::BeginFrame` for the jitter caused by changing the
+///             depth). While latency sensitive, for example while a pointer is
+///             down, the depth is always one.
+///
+class PipelineDepthPolicy {
+ public:
+  // The number of consecutive frames that must agree before the depth changes.
+  static constexpr size_t kFramesBeforeDepthChange = 3u;
+
+  explicit PipelineDepthPolicy(size_t max_depth);
+
+  void SetLatencySensitive(bool latency_sensitive);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called when a new frame is about to be produced, with the
+  ///             number of frames that are still in the pipeline.
+  ///
+  /// @return     The number of frames that may be in the pipeline, including
+  ///             the new one.
+  ///
+  size_t BeginFrame(size_t frames_in_flight);
+
+ private:
+  const size_t max_depth_;
+  size_t depth_ = 1u;
+  bool latency_sensitive_ = false;
+  size_t raster_bound_frame_count_ = 0u;
+  size_t raster_idle_frame_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthPolicy);
+};
+
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer, with a maximum queue depth.
 ///
@@ -127,12 +169,19 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The maximum number of resources in the pipeline.
+  uint32_t GetDepth() const { return depth_; }
+
+  /// The number of resources that have been reserved by the producer and not
+  /// yet consumed.
+  size_t GetInflightCount() const { return inflight_.load(); }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
@@ -211,6 +260,7 @@ class Pipeline {
   }
 
  private:
+  const uint32_t depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
@@ -144,5 +144,35 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DepthPolicyFollowsRasterLoadWithHysteresis) {
+  PipelineDepthPolicy policy(2);
+  constexpr size_t kFrames = PipelineDepthPolicy::kFramesBeforeDepthChange;
+
+  // Starts at one frame in flight.
+  ASSERT_EQ(policy.BeginFrame(0), 1u);
+
+  // Raised only once the raster thread has been behind for a few frames.
+  for (size_t i = 1; i < kFrames; i++) {
+    ASSERT_EQ(policy.BeginFrame(1), 1u);
+  }
+  ASSERT_EQ(policy.BeginFrame(1), 2u);
+
+  // A single idle frame doesn't lower it again.
+  ASSERT_EQ(policy.BeginFrame(0), 2u);
+  ASSERT_EQ(policy.BeginFrame(1), 2u);
+
+  // Latency sensitive periods always use one frame.
+  policy.SetLatencySensitive(true);
+  ASSERT_EQ(policy.BeginFrame(1), 1u);
+  policy.SetLatencySensitive(false);
+  ASSERT_EQ(policy.BeginFrame(1), 2u);
+
+  // Lowered after a few idle frames.
+  for (size_t i = 1; i < kFrames; i++) {
+    ASSERT_EQ(policy.BeginFrame(0), 2u);
+  }
+  ASSERT_EQ(policy.BeginFrame(0), 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
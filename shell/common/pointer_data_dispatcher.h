@@ -163,6 +163,43 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that merges all the packets received while a previous dispatch
+/// is in progress into a single packet, which is dispatched at the next VSYNC.
+///
+/// Like `SmoothPointerDataDispatcher`, a packet that arrives while no dispatch
+/// is in progress is forwarded right away. Unlike it, any number of later
+/// packets are kept until the next VSYNC instead of just one, so input devices
+/// that deliver events several times per frame (such as 240Hz touch
+/// digitizers) cost one dispatch to the framework per frame rather than one
+/// per event.
+///
+/// Every pointer data is kept, in the order it was received, so that the
+/// framework still sees all the samples it needs for velocity tracking.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit CoalescingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void DispatchPendingPackets();
+  void ScheduleSecondaryVsyncCallback();
+
+  // The pointer data of every packet received since the last dispatch.
+  std::vector<uint8_t> pending_data_;
+  uint64_t pending_trace_flow_id_ = 0;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
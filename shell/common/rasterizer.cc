@@ -11,6 +11,7 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layer_tree_serialization.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
@@ -34,12 +35,24 @@
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/renderer/gpu_tracer.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 // The rasterizer will tell Skia to purge cached resources that have not been
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+#if IMPELLER_SUPPORTS_RENDERING
+static std::shared_ptr<impeller::GPUTracer> GetGPUTracer(
+    const std::weak_ptr<impeller::Context>& impeller_context) {
+  auto context = impeller_context.lock();
+  return context ? context->GetGPUTracer() : nullptr;
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -50,6 +63,12 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  compositor_context_->raster_cache().SetMaxBytes(
+      delegate.GetSettings().raster_cache_max_bytes);
+  if (delegate.GetSettings().enable_async_raster_cache) {
+    compositor_context_->raster_cache().SetAsyncTaskRunner(
+        delegate.GetTaskRunners().GetRasterTaskRunner());
+  }
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -68,8 +87,36 @@ void Rasterizer::SetImpellerContext(
   impeller_context_ = std::move(impeller_context);
 }
 
+std::shared_ptr<impeller::Context> Rasterizer::GetImpellerContext() const {
+  return impeller_context_.lock();
+}
+
+void Rasterizer::ShareResourcesWith(const Rasterizer& other) {
+  snapshot_aiks_context_ = other.GetSnapshotAiksContext();
+}
+
+std::shared_ptr<impeller::AiksContext> Rasterizer::GetSnapshotAiksContext()
+    const {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto context = impeller_context_.lock();
+  if (!context) {
+    snapshot_aiks_context_.reset();
+    return nullptr;
+  }
+  if (!snapshot_aiks_context_ ||
+      snapshot_aiks_context_->GetContext() != context) {
+    snapshot_aiks_context_ = std::make_shared<impeller::AiksContext>(
+        context, impeller::TypographerContextSkia::Make());
+  }
+  return snapshot_aiks_context_;
+#else
+  return nullptr;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
+  last_layer_tree_is_on_screen_ = false;
 
   if (max_cache_bytes_.has_value()) {
     SetResourceCacheMaxBytes(max_cache_bytes_.value(),
@@ -99,6 +146,21 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
       }
     });
   }
+
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto gpu_tracer = GetGPUTracer(impeller_context_)) {
+    gpu_tracer->SetFrameTimeCallback(
+        [weak_this = weak_factory_.GetWeakPtr(),
+         raster_task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner()](
+            fml::TimeDelta gpu_time) {
+          raster_task_runner->PostTask([weak_this, gpu_time]() {
+            if (weak_this) {
+              weak_this->OnFrameGpuTimeMeasured(gpu_time);
+            }
+          });
+        });
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 void Rasterizer::TeardownExternalViewEmbedder() {
@@ -108,6 +170,12 @@ void Rasterizer::TeardownExternalViewEmbedder() {
 }
 
 void Rasterizer::Teardown() {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto gpu_tracer = GetGPUTracer(impeller_context_)) {
+    gpu_tracer->SetFrameTimeCallback(nullptr);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   if (surface_) {
     auto context_switch = surface_->MakeRenderContextCurrent();
     if (context_switch->GetResult()) {
@@ -120,6 +188,10 @@ void Rasterizer::Teardown() {
   }
 
   last_layer_tree_.reset();
+  last_layer_tree_is_on_screen_ = false;
+  // Don't keep the Impeller context alive once the platform view may be done
+  // with it.
+  snapshot_aiks_context_.reset();
 
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
@@ -141,6 +213,14 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
   }
 }
 
+void Rasterizer::PerformDeferredCleanup() {
+  last_deferred_cleanup_time_ = fml::TimePoint::Now();
+  if (surface_ && surface_->GetContext()) {
+    TRACE_EVENT0("flutter", "Rasterizer::PerformDeferredCleanup");
+    surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+  }
+}
+
 void Rasterizer::NotifyLowMemoryWarning() const {
   if (!surface_) {
     FML_DLOG(INFO)
@@ -157,6 +237,8 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   if (!context_switch->GetResult()) {
     return;
   }
+  // Cached layers are rebuilt if they are still needed.
+  compositor_context_->raster_cache().Clear();
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
@@ -278,6 +360,34 @@ bool Rasterizer::ShouldResubmitFrame(const RasterStatus& raster_status) {
          raster_status == RasterStatus::kSkipAndRetry;
 }
 
+bool Rasterizer::IsUnchangedSinceLastFrame(flutter::LayerTree& layer_tree,
+                                           float device_pixel_ratio) {
+  // Redraws of the last layer tree are always done, and frames with platform
+  // views are composited by the external view embedder.
+  const Settings& settings = delegate_.GetSettings();
+  if (!settings.enable_unchanged_frame_skipping || external_view_embedder_ ||
+      layer_tree.is_leaf_layer_tracing_enabled() ||
+      last_layer_tree_.get() == &layer_tree) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::IsUnchangedSinceLastFrame");
+  // The last layer tree has no paint regions if it wasn't diffed, such as
+  // when leaf layer tracing was enabled for it.
+  const bool can_skip = last_layer_tree_is_on_screen_ && last_layer_tree_ &&
+                        last_device_pixel_ratio_ == device_pixel_ratio &&
+                        !last_layer_tree_->paint_region_map().empty();
+  // Frames that can't be skipped are diffed too, for the paint regions that
+  // the next frame is diffed against.
+  FrameDamage damage;
+  damage.SetPreviousLayerTree(can_skip ? last_layer_tree_.get() : nullptr);
+  damage.SetIncrementalDiff(settings.enable_incremental_diff);
+  damage.SetTextureRegistry(compositor_context_->texture_registry().get());
+  damage.ComputeClipRect(layer_tree, surface_->EnableRasterCache(),
+                         surface_->GetContext() == nullptr);
+  std::optional<SkIRect> frame_damage = damage.GetFrameDamage();
+  return can_skip && frame_damage.has_value() && frame_damage->isEmpty();
+}
+
 namespace {
 std::unique_ptr<SnapshotDelegate::GpuImageResult> MakeBitmapImage(
     const sk_sp<DisplayList>& display_list,
@@ -543,6 +653,15 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   compositor_context_->ui_time().SetLapTime(
       frame_timings_recorder.GetBuildDuration());
 
+  if (IsUnchangedSinceLastFrame(layer_tree, device_pixel_ratio)) {
+    TRACE_EVENT0("flutter", "SkippedUnchangedFrame");
+    frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+    frame_timings_recorder.RecordRasterEnd(
+        &compositor_context_->raster_cache());
+    FireNextFrameCallbackIfPresent();
+    return RasterStatus::kSuccess;
+  }
+
   DlCanvas* embedder_root_canvas = nullptr;
   if (external_view_embedder_) {
     FML_DCHECK(!external_view_embedder_->GetUsedThisFrame());
@@ -565,6 +684,20 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
         &compositor_context_->raster_cache());
     return RasterStatus::kFailed;
   }
+  if (const auto& gpu_queue_info = frame->gpu_queue_info()) {
+    frame_timings_recorder.RecordGpuQueue(gpu_queue_info->frames_in_flight,
+                                          gpu_queue_info->throttle_duration);
+  }
+
+  // The command buffers that the backend submits until the end of this
+  // function make up the GPU time of the frame.
+  fml::ScopedCleanupClosure end_gpu_frame;
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto gpu_tracer = GetGPUTracer(impeller_context_)) {
+    gpu_tracer->MarkFrameStart();
+    end_gpu_frame.SetClosure([gpu_tracer]() { gpu_tracer->MarkFrameEnd(); });
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
   // If the external view embedder has specified an optional root surface, the
   // root surface transformation is set by the embedder instead of
@@ -605,6 +738,8 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       auto existing_damage = frame->framebuffer_info().existing_damage;
       if (existing_damage.has_value() && !force_full_repaint) {
         damage->SetPreviousLayerTree(last_layer_tree_.get());
+        damage->SetIncrementalDiff(
+            delegate_.GetSettings().enable_incremental_diff);
         damage->AddAdditionalDamage(existing_damage.value());
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
@@ -649,8 +784,10 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFrame(
           surface_->GetContext(), surface_->GetAiksContext(), std::move(frame));
+      last_layer_tree_is_on_screen_ = false;
     } else {
-      frame->Submit();
+      last_layer_tree_is_on_screen_ =
+          frame->Submit() && raster_status == RasterStatus::kSuccess;
     }
 
     // Do not update raster cache metrics for kResubmit because that status
@@ -663,8 +800,16 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
         &compositor_context_->raster_cache());
     FireNextFrameCallbackIfPresent();
 
-    if (surface_->GetContext()) {
-      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+    // The layers sampled while painting are captured after the frame has
+    // been timed so that they don't count towards it.
+    compositor_context_->snapshot_store().CaptureSamples(
+        surface_->GetContext());
+
+    // Cleanup usually happens in idle time. Frames only clean up when there
+    // hasn't been any for a while, such as during long animations.
+    if (fml::TimePoint::Now() - last_deferred_cleanup_time_ >
+        kDeferredCleanupInterval) {
+      PerformDeferredCleanup();
     }
 
     return raster_status;
@@ -793,6 +938,18 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
       data = surface_data.data;
       break;
     }
+    case ScreenshotType::LayerTree: {
+      format = "ScreenshotType::LayerTree";
+      std::string error;
+      auto serialized = SerializeLayerTree(*layer_tree, &error);
+      if (!serialized) {
+        FML_LOG(ERROR) << "Could not serialize the layer tree: " << error;
+        break;
+      }
+      data = SkData::MakeWithCopy(serialized->GetMapping(),
+                                  serialized->GetSize());
+      break;
+    }
   }
 
   if (data == nullptr) {
@@ -828,6 +985,11 @@ fml::RefPtr<fml::RasterThreadMerger> Rasterizer::GetRasterThreadMerger() {
   return raster_thread_merger_;
 }
 
+void Rasterizer::OnFrameGpuTimeMeasured(fml::TimeDelta gpu_time) {
+  compositor_context_->SetGpuTime(gpu_time);
+  delegate_.OnFrameGpuTimeMeasured(gpu_time);
+}
+
 void Rasterizer::FireNextFrameCallbackIfPresent() {
   if (!next_frame_callback_) {
     return;
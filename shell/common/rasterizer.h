@@ -94,6 +94,16 @@ class Rasterizer final : public SnapshotDelegate,
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate of the time the GPU spent on a frame,
+    ///             for the backends that can measure it. This is called on
+    ///             the raster thread, usually a few frames after the frame
+    ///             was rasterized.
+    ///
+    /// @param[in]  gpu_time  The time the GPU spent on the frame.
+    ///
+    virtual void OnFrameGpuTimeMeasured(fml::TimeDelta gpu_time) {}
+
     /// Time limit for a smooth frame.
     ///
     /// See: `DisplayManager::GetMainDisplayRefreshRate`.
@@ -158,6 +168,21 @@ class Rasterizer final : public SnapshotDelegate,
 
   void SetImpellerContext(std::weak_ptr<impeller::Context> impeller_context);
 
+  //----------------------------------------------------------------------------
+  /// @return     The Impeller context set with `SetImpellerContext`, or null if
+  ///             there is none or it has been collected.
+  ///
+  std::shared_ptr<impeller::Context> GetImpellerContext() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes this rasterizer use the resources of `other` that don't
+  ///             depend on a surface, such as the Impeller pipelines used to
+  ///             render snapshots while there is no surface. Used by shells
+  ///             spawned with `Settings::share_resources_with_spawned_engines`.
+  ///             Both rasterizers must run on the same raster thread.
+  ///
+  void ShareResourcesWith(const Rasterizer& other);
+
   //----------------------------------------------------------------------------
   /// @brief      Rasterizers may be created well before an on-screen surface is
   ///             available for rendering. Shells usually create a rasterizer in
@@ -198,6 +223,18 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Tells the Skia context associated with onscreen rendering to
+  ///             free the resources that haven't been used recently. Called
+  ///             from the idle time between frames where possible, and
+  ///             otherwise at most once per `kDeferredCleanupInterval` after a
+  ///             frame.
+  ///
+  void PerformDeferredCleanup();
+
+  static constexpr fml::TimeDelta kDeferredCleanupInterval =
+      fml::TimeDelta::FromSeconds(1);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
   ///             be accessed on the raster task runner.
@@ -322,6 +359,13 @@ class Rasterizer final : public SnapshotDelegate,
     /// is determined from the surface. This is the only way to read wide gamut
     /// color data, but isn't supported everywhere.
     SurfaceData,
+
+    //--------------------------------------------------------------------------
+    /// The layer tree itself, serialized with `SerializeLayerTree`. It can be
+    /// replayed by `flow_frame_replay_benchmarks` to measure the cost of
+    /// rasterizing the frame outside of the application.
+    ///
+    LayerTree,
   };
 
   //----------------------------------------------------------------------------
@@ -554,12 +598,8 @@ class Rasterizer final : public SnapshotDelegate,
     if (surface_) {
       return surface_->GetAiksContext();
     }
-    if (auto context = impeller_context_.lock()) {
-      return std::make_shared<impeller::AiksContext>(
-          context, impeller::TypographerContextSkia::Make());
-    }
 #endif
-    return nullptr;
+    return GetSnapshotAiksContext();
   }
 
   // |SnapshotController::Delegate|
@@ -595,18 +635,36 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Whether drawing `layer_tree` would not change any pixel of the frame that
+  // is already on screen, so that acquiring and submitting a frame can be
+  // skipped. This works with any surface, as it doesn't depend on partial
+  // repaint. Always false unless
+  // `Settings::enable_unchanged_frame_skipping` is set.
+  bool IsUnchangedSinceLastFrame(flutter::LayerTree& layer_tree,
+                                 float device_pixel_ratio);
+
+  void OnFrameGpuTimeMeasured(fml::TimeDelta gpu_time);
+
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
+  // The context used to render snapshots while there is no surface. It is
+  // created once and kept, since creating its pipelines is expensive.
+  std::shared_ptr<impeller::AiksContext> GetSnapshotAiksContext() const;
+
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::weak_ptr<impeller::Context> impeller_context_;
+  mutable std::shared_ptr<impeller::AiksContext> snapshot_aiks_context_;
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   // This is the last successfully rasterized layer tree.
   std::unique_ptr<flutter::LayerTree> last_layer_tree_;
+  // Whether |last_layer_tree_| is what the current surface shows.
+  bool last_layer_tree_is_on_screen_ = false;
   float last_device_pixel_ratio_;
   fml::closure next_frame_callback_;
+  fml::TimePoint last_deferred_cleanup_time_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -967,6 +968,86 @@ TEST(RasterizerTest,
   latch.Wait();
 }
 
+TEST(RasterizerTest, skipsFramesThatDontChangeTheScreen) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.enable_unchanged_frame_skipping = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<Rasterizer> rasterizer;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer = std::make_unique<Rasterizer>(delegate);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  int frames_acquired = 0;
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, AcquireFrame(_))
+      .WillByDefault(::testing::Invoke([&](const SkISize& size) {
+        frames_acquired++;
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame& frame, DlCanvas*) { return true; },
+            /*frame_size=*/size);
+      }));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+
+  // All frames are reported, whether they were skipped or not.
+  fml::CountDownLatch count_down_latch(3);
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .Times(3)
+      .WillRepeatedly(
+          [&](const FrameTiming& frame_timing) { count_down_latch.CountDown(); });
+
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::move(surface));
+    auto root_layer = std::make_shared<ContainerLayer>();
+    const std::vector<SkISize> frame_sizes = {
+        SkISize::Make(800, 600), SkISize::Make(800, 600),
+        SkISize::Make(400, 300)};
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    for (const SkISize& frame_size : frame_sizes) {
+      auto layer_tree = std::make_unique<LayerTree>(
+          LayerTree::Config{.root_layer = root_layer}, frame_size);
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree),
+          CreateFinishedBuildRecorder(fml::TimePoint::Now()),
+          kDevicePixelRatio);
+      EXPECT_TRUE(
+          pipeline->Produce().Complete(std::move(layer_tree_item)).success);
+    }
+    rasterizer->Draw(pipeline);
+  });
+  count_down_latch.Wait();
+
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    // The second frame is the same as the first one.
+    EXPECT_EQ(frames_acquired, 2);
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(RasterizerTest, TeardownFreesResourceCache) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
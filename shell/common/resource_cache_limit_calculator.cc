@@ -7,6 +7,11 @@
 namespace flutter {
 
 size_t ResourceCacheLimitCalculator::GetResourceCacheMaxBytes() {
+  return GetResourceCacheMaxBytes(fml::TimePoint::Now());
+}
+
+size_t ResourceCacheLimitCalculator::GetResourceCacheMaxBytes(
+    fml::TimePoint now) {
   size_t max_bytes = 0;
   size_t max_bytes_threshold = max_bytes_threshold_ > 0
                                    ? max_bytes_threshold_
@@ -19,7 +24,37 @@ size_t ResourceCacheLimitCalculator::GetResourceCacheMaxBytes() {
     }
   }
   items_ = std::move(live_items);
-  return std::min(max_bytes, max_bytes_threshold);
+  return std::min(max_bytes, max_bytes_threshold) / GetLimitDivisor(now);
+}
+
+void ResourceCacheLimitCalculator::NotifyLowMemoryWarning(fml::TimePoint now) {
+  last_low_memory_warning_ = now;
+}
+
+std::optional<fml::TimePoint> ResourceCacheLimitCalculator::GetNextRecoveryTime(
+    fml::TimePoint now) const {
+  if (GetLimitDivisor(now) == 1) {
+    return std::nullopt;
+  }
+  return last_low_memory_warning_.value() +
+         kLowMemoryRecoveryStep * (GetRecoverySteps(now) + 1);
+}
+
+int64_t ResourceCacheLimitCalculator::GetRecoverySteps(
+    fml::TimePoint now) const {
+  return (now - last_low_memory_warning_.value()).ToMicroseconds() /
+         kLowMemoryRecoveryStep.ToMicroseconds();
+}
+
+size_t ResourceCacheLimitCalculator::GetLimitDivisor(fml::TimePoint now) const {
+  if (!last_low_memory_warning_) {
+    return 1;
+  }
+  size_t divisor = kLowMemoryLimitDivisor;
+  for (int64_t step = 0; step < GetRecoverySteps(now) && divisor > 1; step++) {
+    divisor /= 2;
+  }
+  return std::max<size_t>(divisor, 1);
 }
 
 }  // namespace flutter
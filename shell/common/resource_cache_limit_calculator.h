@@ -6,10 +6,12 @@
 #define FLUTTER_SHELL_COMMON_RESOURCE_CACHE_LIMIT_CALCULATOR_H_
 
 #include <cstdint>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace flutter {
 class ResourceCacheLimitItem {
@@ -24,6 +26,13 @@ class ResourceCacheLimitItem {
 
 class ResourceCacheLimitCalculator {
  public:
+  // After a low memory warning, the limit is divided by this, and then halved
+  // less every |kLowMemoryRecoveryStep| without another warning until it is
+  // back to what the items ask for.
+  static constexpr size_t kLowMemoryLimitDivisor = 4;
+  static constexpr fml::TimeDelta kLowMemoryRecoveryStep =
+      fml::TimeDelta::FromSeconds(10);
+
   ResourceCacheLimitCalculator(size_t max_bytes_threshold)
       : max_bytes_threshold_(max_bytes_threshold) {}
 
@@ -35,12 +44,28 @@ class ResourceCacheLimitCalculator {
   }
 
   // The maximum GPU resource cache limit in bytes calculated by
-  // 'ResourceCacheLimitItem's. This will be called on the platform thread.
+  // 'ResourceCacheLimitItem's, lowered after low memory warnings. This will be
+  // called on the platform thread.
   size_t GetResourceCacheMaxBytes();
+  size_t GetResourceCacheMaxBytes(fml::TimePoint now);
+
+  // Lowers the limit after the OS reported that memory is low. This will be
+  // called on the platform thread.
+  void NotifyLowMemoryWarning(fml::TimePoint now);
+
+  // When the limit lowered by a low memory warning goes up next, if it is
+  // lowered. This will be called on the platform thread.
+  std::optional<fml::TimePoint> GetNextRecoveryTime(fml::TimePoint now) const;
 
  private:
   std::vector<fml::WeakPtr<ResourceCacheLimitItem>> items_;
   size_t max_bytes_threshold_;
+  std::optional<fml::TimePoint> last_low_memory_warning_;
+
+  // The number of recovery steps since the last low memory warning.
+  int64_t GetRecoverySteps(fml::TimePoint now) const;
+  size_t GetLimitDivisor(fml::TimePoint now) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ResourceCacheLimitCalculator);
 };
 }  // namespace flutter
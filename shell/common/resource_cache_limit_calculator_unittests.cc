@@ -50,5 +50,29 @@ TEST(ResourceCacheLimitCalculatorTest, GetResourceCacheMaxBytes) {
   EXPECT_EQ(calculator.GetResourceCacheMaxBytes(), static_cast<size_t>(500U));
 }
 
+TEST(ResourceCacheLimitCalculatorTest, LowersLimitAfterLowMemoryWarning) {
+  ResourceCacheLimitCalculator calculator(0U);
+  auto item = std::make_unique<TestResourceCacheLimitItem>(800.0);
+  calculator.AddResourceCacheLimitItem(item->GetWeakPtr());
+
+  const fml::TimePoint start = fml::TimePoint::Now();
+  const fml::TimeDelta step =
+      ResourceCacheLimitCalculator::kLowMemoryRecoveryStep;
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(start), 800U);
+  EXPECT_FALSE(calculator.GetNextRecoveryTime(start).has_value());
+
+  calculator.NotifyLowMemoryWarning(start);
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(start), 200U);
+  EXPECT_EQ(calculator.GetNextRecoveryTime(start), start + step);
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(start + step), 400U);
+  EXPECT_EQ(calculator.GetNextRecoveryTime(start + step), start + step * 2);
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(start + step * 2), 800U);
+  EXPECT_FALSE(calculator.GetNextRecoveryTime(start + step * 2).has_value());
+
+  // Another warning starts over.
+  calculator.NotifyLowMemoryWarning(start + step * 3);
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(start + step * 3), 200U);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <cstdlib>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -21,12 +22,14 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/third_party/txt/src/txt/platform.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -42,6 +45,10 @@
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/core/capture_stream.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 constexpr char kSkiaChannel[] = "flutter/skia";
@@ -49,6 +56,10 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+// The idle time needed to clean up the rasterizer's unused GPU resources.
+constexpr fml::TimeDelta kRasterizerCleanupBudget =
+    fml::TimeDelta::FromMilliseconds(1);
+
 namespace {
 
 std::unique_ptr<Engine> CreateEngine(
@@ -121,6 +132,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_flight_recorder) {
+      fml::tracing::FlightRecorderSetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -209,6 +224,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  const fml::TimePoint startup_begin = fml::TimePoint::Now();
+
   auto shell = std::unique_ptr<Shell>(
       new Shell(std::move(vm), task_runners, std::move(parent_merger),
                 resource_cache_limit_calculator, settings,
@@ -217,11 +234,39 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
+  // Startup is a graph of steps on different threads. Steps that nothing else
+  // waits for start first, so that they overlap with the rest:
+  //
+  // * The default font manager, which the engine sets up once it exists, is
+  //   warmed up on a concurrent worker.
+  // * The pages of the isolate snapshot, which the root isolate starts from,
+  //   are read ahead on a concurrent worker instead of being faulted in one at
+  //   a time once the isolate runs.
+  // * The rasterizer (raster thread), the IO manager (IO thread), which also
+  //   opens the persistent cache, and the vsync waiter (this thread) only
+  //   depend on the platform view.
+  // * The engine (UI thread) waits for the IO manager and the rasterizer.
+  // * `Shell::Setup` waits for everything.
+  if (!settings.prefetched_default_font_manager) {
+    shell->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_initialization_data = settings.font_initialization_data]() {
+          TRACE_EVENT0("flutter", "ShellPrefetchDefaultFontManager");
+          txt::GetDefaultFontManager(font_initialization_data);
+        });
+  }
+  if (isolate_snapshot) {
+    shell->GetConcurrentWorkerTaskRunner()->PostTask(
+        [isolate_snapshot]() { isolate_snapshot->Prefetch(); });
+  }
+
   // Create the platform view on the platform thread (this thread).
+  fml::TimePoint phase_begin = fml::TimePoint::Now();
   auto platform_view = on_create_platform_view(*shell.get());
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
+  shell->startup_phase_durations_.platform_view =
+      fml::TimePoint::Now() - phase_begin;
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -238,18 +283,30 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        impeller_context = platform_view->GetImpellerContext()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const fml::TimePoint begin = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        if (shell->GetSettings().enable_concurrent_preroll) {
+          rasterizer->compositor_context()->SetPrerollTaskRunner(
+              shell->GetConcurrentWorkerTaskRunner());
+        }
+        rasterizer->compositor_context()->SetReuseRetainedPrerolls(
+            shell->GetSettings().enable_incremental_diff);
+        shell->startup_phase_durations_.rasterizer =
+            fml::TimePoint::Now() - begin;
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Ask the platform view for the vsync waiter. This will be used by the engine
   // to create the animator.
+  phase_begin = fml::TimePoint::Now();
   auto vsync_waiter = platform_view->CreateVSyncWaiter();
   if (!vsync_waiter) {
     return nullptr;
   }
+  shell->startup_phase_durations_.vsync_waiter =
+      fml::TimePoint::Now() - phase_begin;
 
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
@@ -274,9 +331,14 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &unref_queue_promise,                                              //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
+       shell = shell.get(),                                               //
        is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        const fml::TimePoint begin = fml::TimePoint::Now();
+        // Opening the persistent cache touches the file system, which is
+        // better done here than on the platform thread in `Shell::Setup`.
+        PersistentCache::GetCacheForProcess();
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -288,6 +350,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
               platform_view_ptr->GetImpellerContext()  // impeller context
           );
         }
+        shell->startup_phase_durations_.io_manager =
+            fml::TimePoint::Now() - begin;
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
         io_manager_promise.set_value(io_manager);
@@ -313,6 +377,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &unref_queue_future,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        const fml::TimePoint begin = fml::TimePoint::Now();
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
@@ -320,7 +385,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
 
-        engine_promise.set_value(
+        std::unique_ptr<Engine> engine =
             on_create_engine(*shell,                          //
                              dispatcher_maker,                //
                              *shell->GetDartVM(),             //
@@ -333,16 +398,31 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              unref_queue_future.get(),        //
                              snapshot_delegate_future.get(),  //
                              shell->volatile_path_tracker_,
-                             shell->is_gpu_disabled_sync_switch_));
+                             shell->is_gpu_disabled_sync_switch_);
+        shell->startup_phase_durations_.engine = fml::TimePoint::Now() - begin;
+        engine_promise.set_value(std::move(engine));
       }));
 
+  std::unique_ptr<Engine> engine;
+  std::unique_ptr<Rasterizer> rasterizer;
+  std::shared_ptr<ShellIOManager> io_manager;
+  {
+    TRACE_EVENT0("flutter", "ShellWaitForSubsystems");
+    engine = engine_future.get();
+    rasterizer = rasterizer_future.get();
+    io_manager = io_manager_future.get();
+  }
+
+  phase_begin = fml::TimePoint::Now();
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    std::move(io_manager))     //
   ) {
     return nullptr;
   }
+  shell->startup_phase_durations_.setup = fml::TimePoint::Now() - phase_begin;
+  shell->startup_phase_durations_.total = fml::TimePoint::Now() - startup_begin;
 
   return shell;
 }
@@ -423,6 +503,7 @@ Shell::Shell(DartVMRef vm,
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      idle_task_scheduler_(std::make_shared<IdleTaskScheduler>()),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(!settings.enable_software_rendering || !settings.enable_impeller)
@@ -454,6 +535,11 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetRasterTaskRunner(),
       std::bind(&Shell::OnServiceProtocolScreenshotSKP, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kScreenshotLayerTreeExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolScreenshotLayerTree, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kRunInViewExtensionName] = {
       task_runners_.GetUITaskRunner(),
       std::bind(&Shell::OnServiceProtocolRunInView, this, std::placeholders::_1,
@@ -491,9 +577,36 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFlightRecorderEventsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFlightRecorderEvents, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetEngineCountersExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetEngineCounters, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kSetImpellerCaptureEnabledExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolSetImpellerCaptureEnabled, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetImpellerCaptureExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetImpellerCapture, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
+  idle_task_scheduler_->RemoveTask(rasterizer_cleanup_task_);
+
   PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
@@ -562,7 +675,15 @@ std::unique_ptr<Shell> Shell::Spawn(
       PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
       io_manager_, resource_cache_limit_calculator_, GetSettings(), vm_,
       vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
-      on_create_rasterizer,
+      [on_create_rasterizer, parent_rasterizer = rasterizer_->GetWeakPtr(),
+       share_resources = settings_.share_resources_with_spawned_engines](
+          Shell& shell) {
+        std::unique_ptr<Rasterizer> rasterizer = on_create_rasterizer(shell);
+        if (share_resources && rasterizer && parent_rasterizer) {
+          rasterizer->ShareResourcesWith(*parent_rasterizer);
+        }
+        return rasterizer;
+      },
       [engine = this->engine_.get(), initial_route](
           Engine::Delegate& delegate,
           const PointerDataDispatcherMaker& dispatcher_maker, DartVM& vm,
@@ -599,6 +720,18 @@ void Shell::NotifyLowMemoryWarning() const {
   // running.
   ::Dart_NotifyLowMemory();
 
+  // The cache limit is lowered for a while, on the platform thread that owns
+  // the calculator.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      [shell = weak_factory_.GetWeakPtr()]() {
+        if (shell) {
+          shell->resource_cache_limit_calculator_->NotifyLowMemoryWarning(
+              fml::TimePoint::Now());
+          shell->UpdateResourceCacheMaxBytes();
+        }
+      });
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
         if (rasterizer) {
@@ -611,6 +744,34 @@ void Shell::NotifyLowMemoryWarning() const {
   // to purge them.
 }
 
+void Shell::UpdateResourceCacheMaxBytes() const {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  const fml::TimePoint now = fml::TimePoint::Now();
+  size_t resource_cache_max_bytes =
+      resource_cache_limit_calculator_->GetResourceCacheMaxBytes(now);
+  FML_TRACE_COUNTER("flutter", "Shell::ResourceCacheMaxBytes",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "MaxBytes", resource_cache_max_bytes);
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes] {
+        if (rasterizer) {
+          rasterizer->SetResourceCacheMaxBytes(resource_cache_max_bytes, false);
+        }
+      });
+
+  // Raise the limit again once it has recovered from a low memory warning.
+  if (auto recovery_time =
+          resource_cache_limit_calculator_->GetNextRecoveryTime(now)) {
+    task_runners_.GetPlatformTaskRunner()->PostTaskForTime(
+        [shell = weak_factory_.GetWeakPtr()]() {
+          if (shell) {
+            shell->UpdateResourceCacheMaxBytes();
+          }
+        },
+        recovery_time.value());
+  }
+}
+
 void Shell::RunEngine(RunConfiguration run_configuration) {
   RunEngine(std::move(run_configuration), nullptr);
 }
@@ -721,6 +882,14 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
+  rasterizer_cleanup_task_ = idle_task_scheduler_->AddTask(
+      task_runners_.GetRasterTaskRunner(), kRasterizerCleanupBudget,
+      [rasterizer = weak_rasterizer_](fml::TimeDelta deadline) {
+        if (rasterizer) {
+          rasterizer->PerformDeferredCleanup();
+        }
+      });
+
   engine_->AddView(kFlutterImplicitViewId, ViewportMetrics{});
   // Setup the time-consuming default font manager right after engine created.
   if (!settings_.prefetched_default_font_manager) {
@@ -979,14 +1148,7 @@ void Shell::OnPlatformViewSetViewportMetrics(int64_t view_id,
   // https://android.googlesource.com/platform/frameworks/base/+/39ae5bac216757bc201490f4c7b8c0f63006c6cd/libs/hwui/renderthread/CacheManager.cpp#45
   resource_cache_limit_ =
       metrics.physical_width * metrics.physical_height * 12 * 4;
-  size_t resource_cache_max_bytes =
-      resource_cache_limit_calculator_->GetResourceCacheMaxBytes();
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes] {
-        if (rasterizer) {
-          rasterizer->SetResourceCacheMaxBytes(resource_cache_max_bytes, false);
-        }
-      });
+  UpdateResourceCacheMaxBytes();
 
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), view_id, metrics]() {
@@ -1045,13 +1207,16 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
+  // Pointer events run ahead of platform messages that are due, so that the
+  // frames they drive don't wait for bulk platform channel traffic.
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      }),
+      fml::TaskPriority::kInput);
   next_pointer_flow_id_++;
 }
 
@@ -1142,18 +1307,14 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
           return;
         }
 
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
-          return;
-        }
-
-        texture->MarkNewFrameAvailable();
+        registry->MarkTextureFrameAvailable(texture_id);
       });
 
-  // Schedule a new frame without having to rebuild the layer tree.
+  // Schedule a new frame without having to rebuild the layer tree, at the
+  // rate the texture produces frames.
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
+      engine->OnExternalTextureFrameAvailable();
       engine->ScheduleFrame(false);
     }
   });
@@ -1202,6 +1363,7 @@ void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
   }
+  idle_task_scheduler_->NotifyIdle(deadline);
 }
 
 void Shell::OnAnimatorUpdateLatestFrameTargetTime(
@@ -1513,6 +1675,11 @@ size_t Shell::UnreportedFramesCount() const {
   return unreported_timings_.size() / (FrameTiming::kStatisticsCount);
 }
 
+void Shell::OnFrameGpuTimeMeasured(fml::TimeDelta gpu_time) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  frame_timing_stats_.RecordGpuTime(fml::TimePoint::Now(), gpu_time);
+}
+
 void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1523,6 +1690,8 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  frame_timing_stats_.RecordFrame(timing);
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1567,7 +1736,7 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     // second. Otherwise, the timings of last few frames of an animation may
     // never be reported until the next animation starts.
     frame_timings_report_scheduled_ = true;
-    task_runners_.GetRasterTaskRunner()->PostDelayedTask(
+    task_runners_.GetRasterTaskRunner()->PostTaskForTimeWithPriority(
         [self = weak_factory_gpu_->GetWeakPtr()]() {
           if (!self) {
             return;
@@ -1577,7 +1746,9 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
             self->ReportTimings();
           }
         },
-        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds));
+        fml::TimePoint::Now() +
+            fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds),
+        fml::TaskPriority::kBackground);
   }
 }
 
@@ -1711,6 +1882,30 @@ bool Shell::OnServiceProtocolScreenshotSKP(
   return false;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolScreenshotLayerTree(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto screenshot = rasterizer_->ScreenshotLastLayerTree(
+      Rasterizer::ScreenshotType::LayerTree, true);
+  if (screenshot.data) {
+    response->SetObject();
+    auto& allocator = response->GetAllocator();
+    response->AddMember("type", "ScreenshotLayerTree", allocator);
+    rapidjson::Value layer_tree;
+    layer_tree.SetString(static_cast<const char*>(screenshot.data->data()),
+                         screenshot.data->size(), allocator);
+    response->AddMember("layerTree", layer_tree, allocator);
+    return true;
+  }
+  ServiceProtocolFailureError(
+      response,
+      "Could not capture the layer tree. Frames with filter, shader mask, "
+      "texture or platform view layers can't be serialized.");
+  return false;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolRunInView(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1750,7 +1945,7 @@ bool Shell::OnServiceProtocolRunInView(
   configuration.AddAssetResolver(std::make_unique<DirectoryAssetBundle>(
       fml::OpenDirectory(asset_directory_path.c_str(), false,
                          fml::FilePermission::kRead),
-      false));
+      false, vm_->GetConcurrentWorkerTaskRunner()));
 
   // Preserve any original asset resolvers to avoid syncing unchanged assets
   // over the DevFS connection.
@@ -1897,7 +2092,7 @@ bool Shell::OnServiceProtocolSetAssetBundlePath(
   if (!asset_manager->PushFront(std::make_unique<DirectoryAssetBundle>(
           fml::OpenDirectory(params.at("assetDirectory").data(), false,
                              fml::FilePermission::kRead),
-          false))) {
+          false, vm_->GetConcurrentWorkerTaskRunner()))) {
     // The new asset directory path was invalid.
     FML_DLOG(ERROR) << "Could not update asset directory.";
     ServiceProtocolFailureError(response, "Could not update asset directory.");
@@ -2058,6 +2253,179 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFlightRecorderEvents(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FlightRecorderEvents", allocator);
+  response->AddMember("enabled", fml::tracing::FlightRecorderIsEnabled(),
+                      allocator);
+
+  rapidjson::Value threads(rapidjson::kArrayType);
+  for (const auto& thread : fml::tracing::FlightRecorderDump()) {
+    rapidjson::Value events(rapidjson::kArrayType);
+    for (const auto& event : thread.events) {
+      rapidjson::Value json_event(rapidjson::kObjectType);
+      json_event.AddMember("name", rapidjson::Value(event.name, allocator),
+                           allocator);
+      json_event.AddMember(
+          "ph",
+          event.type == fml::tracing::FlightRecorderEventType::kBegin ? "B"
+                                                                      : "E",
+          allocator);
+      json_event.AddMember<int64_t>("ts", event.timestamp_nanos / 1000,
+                                    allocator);
+      events.PushBack(json_event, allocator);
+    }
+    rapidjson::Value json_thread(rapidjson::kObjectType);
+    json_thread.AddMember<uint64_t>("id", thread.thread_id, allocator);
+    json_thread.AddMember("exited", thread.thread_exited, allocator);
+    json_thread.AddMember("events", events, allocator);
+    threads.PushBack(json_thread, allocator);
+  }
+  response->AddMember("threads", threads, allocator);
+  return true;
+}
+
+static void AddFrameTimingPercentiles(
+    const char* name,
+    const FrameTimingPercentiles& percentiles,
+    rapidjson::Document* response) {
+  auto& allocator = response->GetAllocator();
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember<uint64_t>("count", percentiles.count, allocator);
+  value.AddMember<int64_t>("p50", percentiles.p50.ToMicroseconds(), allocator);
+  value.AddMember<int64_t>("p90", percentiles.p90.ToMicroseconds(), allocator);
+  value.AddMember<int64_t>("p99", percentiles.p99.ToMicroseconds(), allocator);
+  value.AddMember<int64_t>("max", percentiles.max.ToMicroseconds(), allocator);
+  response->AddMember(rapidjson::StringRef(name), value, allocator);
+}
+
+bool Shell::OnServiceProtocolGetFrameTimingStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FrameTimingStats stats = GetFrameTimingStats();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingStats", response->GetAllocator());
+  response->AddMember<int64_t>("windowMicros", stats.window.ToMicroseconds(),
+                               response->GetAllocator());
+  AddFrameTimingPercentiles("vsyncOverhead", stats.vsync_overhead, response);
+  AddFrameTimingPercentiles("build", stats.build, response);
+  AddFrameTimingPercentiles("raster", stats.raster, response);
+  AddFrameTimingPercentiles("total", stats.total, response);
+  AddFrameTimingPercentiles("gpu", stats.gpu, response);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetEngineCounters(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  const fml::TimePoint now = fml::TimePoint::Now();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "EngineCounters", allocator);
+  response->AddMember<int64_t>(
+      "intervalMicros", (now - last_engine_counters_time_).ToMicroseconds(),
+      allocator);
+
+  rapidjson::Value counters(rapidjson::kObjectType);
+  rapidjson::Value deltas(rapidjson::kObjectType);
+  for (const auto& counter : fml::tracing::PerformanceCountersDump()) {
+    uint64_t& last_value = last_engine_counters_[counter.name];
+    counters.AddMember(rapidjson::Value(counter.name.c_str(), allocator),
+                       counter.value, allocator);
+    deltas.AddMember(rapidjson::Value(counter.name.c_str(), allocator),
+                     counter.value - last_value, allocator);
+    last_value = counter.value;
+  }
+  response->AddMember("counters", counters, allocator);
+  response->AddMember("deltas", deltas, allocator);
+  last_engine_counters_time_ = now;
+  return true;
+}
+
+static size_t GetServiceProtocolSize(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    std::string_view name,
+    size_t default_value) {
+  auto found = params.find(name);
+  if (found == params.end()) {
+    return default_value;
+  }
+  const std::string value(found->second);
+  char* end = nullptr;
+  const unsigned long long result = std::strtoull(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || result == 0u) {
+    return default_value;
+  }
+  return static_cast<size_t>(result);
+}
+
+bool Shell::OnServiceProtocolSetImpellerCaptureEnabled(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+#if IMPELLER_SUPPORTS_RENDERING
+  auto context = rasterizer_ ? rasterizer_->GetImpellerContext() : nullptr;
+  if (!context) {
+    ServiceProtocolFailureError(response, "Impeller is not enabled.");
+    return false;
+  }
+  auto found = params.find("enabled");
+  const bool enabled = found == params.end() || found->second != "false";
+  if (!enabled) {
+    context->capture = impeller::CaptureContext::MakeInactive();
+  } else {
+    auto capture = impeller::CaptureContext::MakeStreaming(
+        impeller::CaptureStream::Make(
+            GetServiceProtocolSize(params, "maxFrames", 4u),
+            GetServiceProtocolSize(params, "maxFrameBytes", 1u << 20)));
+    if (!capture.IsActive()) {
+      ServiceProtocolFailureError(
+          response, "Impeller capture is not supported in this build.");
+      return false;
+    }
+    context->capture = std::move(capture);
+  }
+  response->SetObject();
+  response->AddMember("type", "Success", response->GetAllocator());
+  return true;
+#else
+  ServiceProtocolFailureError(response, "Impeller is not supported.");
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+bool Shell::OnServiceProtocolGetImpellerCapture(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+#if IMPELLER_SUPPORTS_RENDERING
+  auto context = rasterizer_ ? rasterizer_->GetImpellerContext() : nullptr;
+  auto stream = context ? context->capture.GetStream() : nullptr;
+  if (!stream) {
+    ServiceProtocolFailureError(response,
+                                "Impeller capture streaming is not enabled.");
+    return false;
+  }
+  const std::vector<uint8_t> data = stream->Dump();
+  const size_t b64_size = SkBase64::Encode(data.data(), data.size(), nullptr);
+  std::string b64(b64_size, '\0');
+  SkBase64::Encode(data.data(), data.size(), b64.data());
+  response->SetObject();
+  response->AddMember("type", "ImpellerCapture", response->GetAllocator());
+  response->AddMember("data", b64, response->GetAllocator());
+  return true;
+#else
+  ServiceProtocolFailureError(response, "Impeller is not supported.");
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 void Shell::AddView(int64_t view_id, const ViewportMetrics& viewport_metrics) {
   TRACE_EVENT0("flutter", "Shell::AddView");
   FML_DCHECK(is_set_up_);
@@ -2177,6 +2545,10 @@ std::shared_ptr<const fml::SyncSwitch> Shell::GetIsGpuDisabledSyncSwitch()
   return is_gpu_disabled_sync_switch_;
 }
 
+FrameTimingStats Shell::GetFrameTimingStats() const {
+  return frame_timing_stats_.GetStats();
+}
+
 void Shell::SetGpuAvailability(GpuAvailability availability) {
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
   switch (availability) {
@@ -2225,6 +2597,15 @@ fml::TimePoint Shell::GetCurrentTimePoint() {
   return fml::TimePoint::Now();
 }
 
+const std::shared_ptr<IdleTaskScheduler>& Shell::GetIdleTaskScheduler()
+    const {
+  return idle_task_scheduler_;
+}
+
+const Shell::StartupPhaseDurations& Shell::GetStartupPhaseDurations() const {
+  return startup_phase_durations_;
+}
+
 const std::shared_ptr<PlatformMessageHandler>&
 Shell::GetPlatformMessageHandler() const {
   return platform_message_handler_;
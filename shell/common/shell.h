@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <map>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -14,6 +15,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_timing_histogram.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -36,6 +38,7 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/idle_task_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
@@ -130,6 +133,21 @@ class Shell final : public PlatformView::Delegate,
       const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)>
       EngineCreateCallback;
 
+  //----------------------------------------------------------------------------
+  /// @brief      How long each step of creating a shell took. The rasterizer,
+  ///             IO manager, vsync waiter and engine are created on different
+  ///             threads, so their durations overlap.
+  ///
+  struct StartupPhaseDurations {
+    fml::TimeDelta platform_view;  // platform thread
+    fml::TimeDelta rasterizer;     // raster thread
+    fml::TimeDelta vsync_waiter;   // platform thread
+    fml::TimeDelta io_manager;     // IO thread
+    fml::TimeDelta engine;         // UI thread
+    fml::TimeDelta setup;          // platform thread, after all of the above
+    fml::TimeDelta total;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Creates a shell instance using the provided settings. The
   ///             callbacks to create the various shell subcomponents will be
@@ -283,7 +301,9 @@ class Shell final : public PlatformView::Delegate,
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
   ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             the rasterizer cache is purged. The GPU resource cache limit
+  ///             is also lowered, and recovers over the following seconds if
+  ///             there are no more warnings. May be called on any thread.
   void NotifyLowMemoryWarning() const;
 
   //----------------------------------------------------------------------------
@@ -396,6 +416,14 @@ class Shell final : public PlatformView::Delegate,
   /// @brief     Marks the GPU as available or unavailable.
   void SetGpuAvailability(GpuAvailability availability);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the percentiles of the phases of the frames rasterized
+  ///             within the last minute. This may be called on any thread.
+  ///
+  /// @return     The frame timing stats.
+  ///
+  FrameTimingStats GetFrameTimingStats() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get a pointer to the Dart VM used by this running shell
   ///             instance.
@@ -433,6 +461,17 @@ class Shell final : public PlatformView::Delegate,
   const std::shared_ptr<PlatformMessageHandler>& GetPlatformMessageHandler()
       const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scheduler that runs deferred work in the idle periods
+  ///             between frames.
+  ///
+  const std::shared_ptr<IdleTaskScheduler>& GetIdleTaskScheduler() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How long the steps of creating this shell took.
+  ///
+  const StartupPhaseDurations& GetStartupPhaseDurations() const;
+
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
   const std::shared_ptr<fml::ConcurrentTaskRunner>
@@ -474,6 +513,9 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
+  std::shared_ptr<IdleTaskScheduler> idle_task_scheduler_;
+  IdleTaskScheduler::TaskId rasterizer_cleanup_task_ = 0;
+  StartupPhaseDurations startup_phase_durations_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
@@ -511,6 +553,16 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The percentiles of the frame timings over a rolling window. Recorded on
+  // the raster thread and read on any thread.
+  FrameTimingStatsRecorder frame_timing_stats_;
+
+  // The engine counters and the time of the previous call of
+  // |OnServiceProtocolGetEngineCounters|, or the creation of the shell. Only
+  // used on the platform thread.
+  std::map<std::string, uint64_t> last_engine_counters_;
+  fml::TimePoint last_engine_counters_time_ = fml::TimePoint::Now();
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -700,6 +752,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnFrameGpuTimeMeasured(fml::TimeDelta gpu_time) override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
@@ -734,6 +789,11 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  bool OnServiceProtocolScreenshotLayerTree(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   bool OnServiceProtocolRunInView(
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -783,12 +843,60 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Dumps the trace events recorded by the flight recorder of every thread.
+  // Timestamps are in microseconds on the same clock as the timeline.
+  bool OnServiceProtocolGetFlightRecorderEvents(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the p50, p90, p99 and maximum of the vsync overhead, build,
+  // raster and total times of the recent frames, in microseconds.
+  bool OnServiceProtocolGetFrameTimingStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the process wide engine performance counters, such as raster
+  // cache hits or draw calls, and how much each of them changed since the
+  // previous call of this handler, over "intervalMicros". Polling it at a
+  // fixed rate yields the counters per interval. The first call reports all
+  // counts so far as deltas.
+  bool OnServiceProtocolGetEngineCounters(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Starts streaming Impeller captures into a ring of the last "maxFrames"
+  // frames of at most "maxFrameBytes" each, or stops when "enabled" is
+  // "false". Requires a build with Impeller capture support.
+  bool OnServiceProtocolSetImpellerCaptureEnabled(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the streamed Impeller capture frames, base64 encoded.
+  bool OnServiceProtocolGetImpellerCapture(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
   // |ResourceCacheLimitItem|
   size_t GetResourceCacheLimit() override { return resource_cache_limit_; };
 
+  // Applies the limit of the resource cache limit calculator to the
+  // rasterizer, and schedules doing it again when the limit recovers from a
+  // low memory warning.
+  void UpdateResourceCacheMaxBytes() const;
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
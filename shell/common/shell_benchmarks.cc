@@ -13,6 +13,16 @@
 
 namespace flutter {
 
+// Adds the duration of a startup phase, in microseconds, to a counter that
+// reports its average over the iterations.
+static void AddStartupPhaseCounter(benchmark::State& state,
+                                   const std::string& name,
+                                   fml::TimeDelta duration) {
+  benchmark::Counter& counter = state.counters[name];
+  counter.flags = benchmark::Counter::kAvgIterations;
+  counter.value += duration.ToMicrosecondsF();
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -64,6 +74,18 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   FML_CHECK(shell);
 
+  if (measure_startup) {
+    const Shell::StartupPhaseDurations& phases =
+        shell->GetStartupPhaseDurations();
+    AddStartupPhaseCounter(state, "PlatformViewUs", phases.platform_view);
+    AddStartupPhaseCounter(state, "RasterizerUs", phases.rasterizer);
+    AddStartupPhaseCounter(state, "VsyncWaiterUs", phases.vsync_waiter);
+    AddStartupPhaseCounter(state, "IOManagerUs", phases.io_manager);
+    AddStartupPhaseCounter(state, "EngineUs", phases.engine);
+    AddStartupPhaseCounter(state, "SetupUs", phases.setup);
+    AddStartupPhaseCounter(state, "TotalUs", phases.total);
+  }
+
   {
     // The ui thread could be busy processing tasks after shell created, e.g.,
     // default font manager setup. The measurement of shell shutdown should be
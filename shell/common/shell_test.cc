@@ -283,6 +283,15 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetFlightRecorderEvents:
+        shell->OnServiceProtocolGetFlightRecorderEvents(params, response);
+        break;
+      case ServiceProtocolEnum::kGetFrameTimingStats:
+        shell->OnServiceProtocolGetFrameTimingStats(params, response);
+        break;
+      case ServiceProtocolEnum::kGetEngineCounters:
+        shell->OnServiceProtocolGetEngineCounters(params, response);
+        break;
     }
     finished.set_value(true);
   });
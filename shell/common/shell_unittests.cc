@@ -19,6 +19,7 @@
 #endif  // SHELL_ENABLE_GL
 
 #include "assets/directory_asset_bundle.h"
+#include "assets/packed_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
@@ -33,6 +34,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_counters.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -286,6 +288,39 @@ class ThreadCheckingAssetResolver : public AssetResolver {
   std::shared_ptr<fml::ConcurrentMessageLoop> concurrent_loop_;
 };
 
+// Provides a single asset and counts the lookups.
+class CountingAssetResolver : public AssetResolver {
+ public:
+  explicit CountingAssetResolver(std::string asset_name)
+      : asset_name_(std::move(asset_name)) {}
+
+  // |AssetResolver|
+  bool IsValid() const override { return true; }
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  // |AssetResolver|
+  AssetResolverType GetType() const override {
+    return AssetResolverType::kApkAssetProvider;
+  }
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookups++;
+    if (asset_name != asset_name_) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(asset_name);
+  }
+
+  mutable int lookups = 0;
+
+ private:
+  std::string asset_name_;
+};
+
 static bool ValidateShell(Shell* shell) {
   if (!shell) {
     return false;
@@ -2608,6 +2643,104 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetFlightRecorderEventsWorks) {
+  fml::tracing::FlightRecorderResetForTesting();
+  fml::tracing::FlightRecorderSetEnabled(true);
+
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  fml::AutoResetWaitableEvent latch;
+  shell->GetTaskRunners().GetRasterTaskRunner()->PostTask([&latch]() {
+    { TRACE_EVENT0("flutter", "FlightRecorderTest"); }
+    latch.Signal();
+  });
+  latch.Wait();
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetFlightRecorderEvents,
+      shell->GetTaskRunners().GetPlatformTaskRunner(), empty_params, &document);
+  DestroyShell(std::move(shell));
+  fml::tracing::FlightRecorderSetEnabled(false);
+
+  ASSERT_STREQ(document["type"].GetString(), "FlightRecorderEvents");
+  ASSERT_TRUE(document["enabled"].GetBool());
+  size_t matching_events = 0;
+  for (const auto& thread : document["threads"].GetArray()) {
+    for (const auto& event : thread["events"].GetArray()) {
+      if (std::string{event["name"].GetString()} == "FlightRecorderTest") {
+        matching_events++;
+      }
+    }
+  }
+  // One begin and one end event.
+  ASSERT_EQ(matching_events, 2u);
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingStatsWorks) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent timing_latch;
+  settings.frame_rasterized_callback =
+      [&timing_latch](const FrameTiming& timing) { timing_latch.Signal(); };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  timing_latch.Wait();
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetFrameTimingStats,
+      shell->GetTaskRunners().GetPlatformTaskRunner(), empty_params, &document);
+  DestroyShell(std::move(shell));
+
+  ASSERT_STREQ(document["type"].GetString(), "FrameTimingStats");
+  ASSERT_EQ(document["windowMicros"].GetInt64(), 60 * 1000 * 1000);
+  for (const char* phase : {"vsyncOverhead", "build", "raster", "total"}) {
+    const auto& percentiles = document[phase];
+    ASSERT_EQ(percentiles["count"].GetUint64(), 1u) << phase;
+    ASSERT_LE(percentiles["p50"].GetInt64(), percentiles["max"].GetInt64());
+    ASSERT_LE(percentiles["p99"].GetInt64(), percentiles["max"].GetInt64());
+  }
+  // The test shell's backend doesn't measure GPU time.
+  ASSERT_EQ(document["gpu"]["count"].GetUint64(), 0u);
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetEngineCountersReportsDeltas) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto get_engine_counters = [&shell](rapidjson::Document* document) {
+    ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+    OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetEngineCounters,
+                      shell->GetTaskRunners().GetPlatformTaskRunner(),
+                      empty_params, document);
+  };
+
+  FML_PERFORMANCE_COUNTER_ADD("test.shellCounter", 2);
+  rapidjson::Document first;
+  get_engine_counters(&first);
+  FML_PERFORMANCE_COUNTER_ADD("test.shellCounter", 3);
+  rapidjson::Document second;
+  get_engine_counters(&second);
+  DestroyShell(std::move(shell));
+
+  ASSERT_STREQ(first["type"].GetString(), "EngineCounters");
+  const uint64_t first_value =
+      first["counters"]["test.shellCounter"].GetUint64();
+  ASSERT_GE(first_value, 2u);
+  ASSERT_EQ(second["counters"]["test.shellCounter"].GetUint64(),
+            first_value + 3);
+  ASSERT_EQ(second["deltas"]["test.shellCounter"].GetUint64(), 3u);
+  ASSERT_GE(second["intervalMicros"].GetInt64(), 0);
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -3631,6 +3764,78 @@ TEST_F(ShellTest, UpdateAssetResolverByTypeAppends) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST(AssetManagerTest, RemembersTheResolverOfEachAsset) {
+  AssetManager asset_manager;
+  auto first = std::make_unique<CountingAssetResolver>("first");
+  auto second = std::make_unique<CountingAssetResolver>("second");
+  auto* first_resolver = first.get();
+  auto* second_resolver = second.get();
+  asset_manager.PushBack(std::move(first));
+  asset_manager.PushBack(std::move(second));
+
+  ASSERT_NE(asset_manager.GetAsMapping("second"), nullptr);
+  ASSERT_NE(asset_manager.GetAsMapping("second"), nullptr);
+  EXPECT_EQ(first_resolver->lookups, 1);
+  EXPECT_EQ(second_resolver->lookups, 2);
+
+  // Assets that no resolver provides are not looked up again.
+  ASSERT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  ASSERT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(first_resolver->lookups, 2);
+  EXPECT_EQ(second_resolver->lookups, 3);
+
+  // Until the resolvers change.
+  auto third = std::make_unique<CountingAssetResolver>("missing");
+  auto* third_resolver = third.get();
+  asset_manager.PushFront(std::move(third));
+  ASSERT_NE(asset_manager.GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(third_resolver->lookups, 1);
+}
+
+TEST(PackedAssetBundleTest, FindsEveryPackedAsset) {
+  std::vector<PackedAssetBundle::Asset> assets;
+  for (int i = 0; i < 1000; i++) {
+    std::string name = "assets/image_" + std::to_string(i) + ".png";
+    std::vector<uint8_t> data(i * 7, static_cast<uint8_t>(i));
+    assets.push_back({std::move(name), std::move(data), i % 2 == 0});
+  }
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::DataMapping packed(PackedAssetBundle::Pack(assets));
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(),
+                                   PackedAssetBundle::kFileName, packed));
+
+  auto bundle = PackedAssetBundle::Create(
+      asset_dir.fd(), PackedAssetBundle::kFileName, true);
+  ASSERT_NE(bundle, nullptr);
+  for (const auto& asset : assets) {
+    auto mapping = bundle->GetAsMapping(asset.name);
+    ASSERT_NE(mapping, nullptr) << asset.name;
+    ASSERT_EQ(std::vector<uint8_t>(
+                  mapping->GetMapping(),
+                  mapping->GetMapping() + mapping->GetSize()),
+              asset.data)
+        << asset.name;
+  }
+  EXPECT_EQ(bundle->GetAsMapping("assets/missing.png"), nullptr);
+  EXPECT_EQ(bundle->GetAsMapping(""), nullptr);
+}
+
+TEST(PackedAssetBundleTest, RejectsInvalidBundles) {
+  EXPECT_EQ(PackedAssetBundle::Create(
+                std::make_shared<fml::DataMapping>("not a bundle"), true),
+            nullptr);
+
+  std::vector<uint8_t> truncated =
+      PackedAssetBundle::Pack({{"asset", std::vector<uint8_t>(100, 1)}});
+  truncated.resize(truncated.size() - 1);
+  EXPECT_EQ(PackedAssetBundle::Create(
+                std::make_shared<fml::DataMapping>(std::move(truncated)),
+                true),
+            nullptr);
+
+  EXPECT_TRUE(PackedAssetBundle::Pack({{"asset", {}}, {"asset", {}}}).empty());
+}
+
 TEST_F(ShellTest, UpdateAssetResolverByTypeNull) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
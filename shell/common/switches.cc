@@ -319,6 +319,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.pin_threads_to_core_classes =
+      command_line.HasOption(FlagForSwitch(Switch::PinThreadsToCoreClasses));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -354,6 +357,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.trace_flight_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::TraceFlightRecorder));
+
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
@@ -468,6 +474,13 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
 
+  if (command_line.HasOption(FlagForSwitch(Switch::MaxFramesInFlight))) {
+    std::string max_frames_in_flight;
+    command_line.GetOptionValue(FlagForSwitch(Switch::MaxFramesInFlight),
+                                &max_frames_in_flight);
+    settings.max_frames_in_flight = std::stoi(max_frames_in_flight);
+  }
+
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
@@ -517,6 +530,44 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_concurrent_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentPreroll));
+
+  settings.enable_incremental_diff =
+      command_line.HasOption(FlagForSwitch(Switch::EnableIncrementalDiff));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  settings.enable_vsync_phase_offset =
+      command_line.HasOption(FlagForSwitch(Switch::EnableVsyncPhaseOffset));
+
+  settings.share_resources_with_spawned_engines = command_line.HasOption(
+      FlagForSwitch(Switch::ShareResourcesWithSpawnedEngines));
+
+  settings.enable_unchanged_frame_skipping = command_line.HasOption(
+      FlagForSwitch(Switch::EnableUnchangedFrameSkipping));
+
+  settings.release_snapshot_pages_in_background = command_line.HasOption(
+      FlagForSwitch(Switch::ReleaseSnapshotPagesInBackground));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ChildIsolatePoolSize))) {
+    std::string child_isolate_pool_size;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ChildIsolatePoolSize),
+                                &child_isolate_pool_size);
+    settings.child_isolate_pool_size = std::stoi(child_isolate_pool_size);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
@@ -133,6 +133,11 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(PinThreadsToCoreClasses,
+           "pin-threads-to-core-classes",
+           "Pin the UI and raster threads to the performance cores, and the IO "
+           "and worker threads to the efficiency cores, on devices with "
+           "heterogeneous cores.")
 DEF_SWITCH(Route,
            "route",
            "Start app with an specific route defined on the framework")
@@ -197,6 +202,12 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(TraceFlightRecorder,
+           "trace-flight-recorder",
+           "Record the most recent trace events of each thread in a small "
+           "in-memory ring buffer. The buffers can be dumped on demand via the "
+           "_flutter.getFlightRecorderEvents service protocol extension. The "
+           "overhead is low enough to leave this enabled in release builds.")
 DEF_SWITCH(TraceToFile,
            "trace-to-file",
            "Write the timeline trace to a file at the specified path. The file "
@@ -262,6 +273,47 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The max bytes of images held by the raster cache, or 0 for "
+           "unlimited.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize new raster cache entries for display lists after the "
+           "frame that first caches them instead of during it.")
+DEF_SWITCH(EnableConcurrentPreroll,
+           "enable-concurrent-preroll",
+           "Share the preroll of layer trees with many display list layers "
+           "with the concurrent worker pool.")
+DEF_SWITCH(EnableIncrementalDiff,
+           "enable-incremental-diff",
+           "Reuse the paint regions of retained layers from earlier frames "
+           "when computing the damage for partial repaint, and the preroll "
+           "of retained layers when the raster cache is off.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Only build a frame ahead of the raster thread while it stays "
+           "behind, and never while a pointer is down.")
+DEF_SWITCH(EnableVsyncPhaseOffset,
+           "enable-vsync-phase-offset",
+           "Begin each frame after vsync at the latest time recent frame "
+           "builds allow, to lower the latency of input.")
+DEF_SWITCH(ShareResourcesWithSpawnedEngines,
+           "share-resources-with-spawned-engines",
+           "Let engines spawned from another engine share its image decoder "
+           "and offscreen rendering resources.")
+DEF_SWITCH(EnableUnchangedFrameSkipping,
+           "enable-unchanged-frame-skipping",
+           "Skip rendering and presenting frames that don't change what is on "
+           "screen.")
+DEF_SWITCH(ReleaseSnapshotPagesInBackground,
+           "release-snapshot-pages-in-background",
+           "Let the OS reclaim the memory of the Dart snapshot while the app "
+           "is in the background.")
+DEF_SWITCH(ChildIsolatePoolSize,
+           "child-isolate-pool-size",
+           "The number of isolates spawned from Dart code to prepare ahead of "
+           "time, or 0 to prepare them when they are spawned.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -275,6 +327,11 @@ DEF_SWITCH(EnableVulkanValidation,
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(MaxFramesInFlight,
+           "max-frames-in-flight",
+           "The number of frames that may be queued on the GPU before the "
+           "raster thread waits for the oldest of them. Only honored by the "
+           "Vulkan backend of Impeller.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
@@ -29,6 +29,20 @@ std::string ThreadHost::ThreadHostConfig::MakeThreadName(
   }
 }
 
+std::optional<fml::CpuAffinity> ThreadHost::ThreadHostConfig::GetCoreClass(
+    Type type) {
+  switch (type) {
+    case Type::UI:
+    case Type::RASTER:
+      return fml::CpuAffinity::kPerformance;
+    case Type::IO:
+      return fml::CpuAffinity::kEfficiency;
+    case Type::Platform:
+    case Type::Profiler:
+      return std::nullopt;
+  }
+}
+
 void ThreadHost::ThreadHostConfig::SetIOConfig(const ThreadConfig& config) {
   type_mask |= ThreadHost::Type::IO;
   io_config = config;
@@ -65,6 +79,9 @@ std::unique_ptr<fml::Thread> ThreadHost::CreateThread(
     thread_config = ThreadConfig(
         ThreadHostConfig::MakeThreadName(type, host_config.name_prefix));
   }
+  if (host_config.pin_to_core_classes && !thread_config->affinity) {
+    thread_config->affinity = ThreadHostConfig::GetCoreClass(type);
+  }
   return std::make_unique<fml::Thread>(host_config.config_setter,
                                        thread_config.value());
 }
@@ -104,4 +121,13 @@ ThreadHost::ThreadHost(const ThreadHostConfig& host_config)
 
 ThreadHost::~ThreadHost() = default;
 
+void ThreadHost::ReapplyCpuAffinity() const {
+  for (const auto& thread : {&platform_thread, &ui_thread, &raster_thread,
+                             &io_thread, &profiler_thread}) {
+    if (*thread) {
+      (*thread)->ReapplyAffinity();
+    }
+  }
+}
+
 }  // namespace flutter
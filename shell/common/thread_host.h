@@ -51,6 +51,11 @@ struct ThreadHost {
     /// Use the prefix and thread type to generator a thread name.
     static std::string MakeThreadName(Type type, const std::string& prefix);
 
+    /// The class of cores a thread of the given type is pinned to when
+    /// |pin_to_core_classes| is set. The UI and raster threads go to the
+    /// performance cores and the IO thread to the efficiency cores.
+    static std::optional<fml::CpuAffinity> GetCoreClass(Type type);
+
     /// Specified the UI Thread Config, meanwhile set the mask.
     void SetUIConfig(const ThreadConfig&);
 
@@ -70,6 +75,10 @@ struct ThreadHost {
 
     std::string name_prefix = "";
 
+    /// Whether threads whose config does not specify an affinity are pinned
+    /// to the class of cores returned by |GetCoreClass|.
+    bool pin_to_core_classes = false;
+
     const ThreadConfigSetter config_setter;
 
     std::optional<ThreadConfig> platform_config;
@@ -98,6 +107,11 @@ struct ThreadHost {
 
   ~ThreadHost();
 
+  /// Requests the affinity of every pinned thread again. Embedders call this
+  /// when the device reports a thermal state change, as the operating system
+  /// may have reset the affinity masks while cores were taken offline.
+  void ReapplyCpuAffinity() const;
+
  private:
   std::unique_ptr<fml::Thread> CreateThread(
       Type type,
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/vsync_waiter.h"
 
+#include <algorithm>
+
 #include "flow/frame_timings.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
@@ -84,9 +86,11 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   AwaitVSyncForSecondaryCallback();
 }
 
-void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
-                               fml::TimePoint frame_target_time,
-                               bool pause_secondary_tasks) {
+void VsyncWaiter::FireCallback(
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time,
+    bool pause_secondary_tasks,
+    std::optional<fml::TimePoint> expected_present_time) {
   FML_DCHECK(fml::TimePoint::Now() >= frame_start_time);
 
   Callback callback;
@@ -111,6 +115,13 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
   if (callback) {
     const uint64_t flow_identifier = fml::tracing::TraceNonce();
+    const fml::TimePoint begin_frame_time =
+        GetBeginFrameTime(frame_start_time, frame_target_time);
+    const bool delay_begin_frame = begin_frame_time > fml::TimePoint::Now();
+    if (delay_begin_frame) {
+      // Microtasks may keep running until the frame begins.
+      pause_secondary_tasks = false;
+    }
     if (pause_secondary_tasks) {
       PauseDartMicroTasks();
     }
@@ -128,23 +139,33 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
     fml::TaskQueueId ui_task_queue_id =
         task_runners_.GetUITaskRunner()->GetTaskQueueId();
 
-    task_runners_.GetUITaskRunner()->PostTask(
-        [ui_task_queue_id, callback, flow_identifier, frame_start_time,
-         frame_target_time, pause_secondary_tasks]() {
-          FML_TRACE_EVENT_WITH_FLOW_IDS(
-              "flutter", kVsyncTraceName, /*flow_id_count=*/1,
-              /*flow_ids=*/&flow_identifier, "StartTime", frame_start_time,
-              "TargetTime", frame_target_time);
-          std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
-              std::make_unique<FrameTimingsRecorder>();
-          frame_timings_recorder->RecordVsync(frame_start_time,
-                                              frame_target_time);
-          callback(std::move(frame_timings_recorder));
-          TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
-          if (pause_secondary_tasks) {
-            ResumeDartMicroTasks(ui_task_queue_id);
-          }
-        });
+    auto begin_frame = [ui_task_queue_id, callback, flow_identifier,
+                        frame_start_time, frame_target_time,
+                        expected_present_time, pause_secondary_tasks]() {
+      FML_TRACE_EVENT_WITH_FLOW_IDS(
+          "flutter", kVsyncTraceName, /*flow_id_count=*/1,
+          /*flow_ids=*/&flow_identifier, "StartTime", frame_start_time,
+          "TargetTime", frame_target_time);
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
+          std::make_unique<FrameTimingsRecorder>();
+      frame_timings_recorder->RecordVsync(frame_start_time, frame_target_time);
+      if (expected_present_time.has_value()) {
+        frame_timings_recorder->RecordExpectedPresentTime(
+            expected_present_time.value());
+      }
+      callback(std::move(frame_timings_recorder));
+      TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
+      if (pause_secondary_tasks) {
+        ResumeDartMicroTasks(ui_task_queue_id);
+      }
+    };
+    if (delay_begin_frame) {
+      task_runners_.GetUITaskRunner()->PostTaskForTimeWithPriority(
+          begin_frame, begin_frame_time, fml::TaskPriority::kFrameCritical);
+    } else {
+      task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+          begin_frame, fml::TaskPriority::kFrameCritical);
+    }
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
@@ -152,6 +173,48 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
   }
 }
 
+void VsyncWaiter::SetDelayBeginFrameByBuildTime(bool enabled) {
+  delay_begin_frame_by_build_time_ = enabled;
+  if (!enabled) {
+    std::scoped_lock lock(build_durations_mutex_);
+    build_durations_.clear();
+  }
+}
+
+void VsyncWaiter::RecordBuildDuration(fml::TimeDelta duration) {
+  if (!delay_begin_frame_by_build_time_) {
+    return;
+  }
+  std::scoped_lock lock(build_durations_mutex_);
+  build_durations_.push_back(duration);
+  if (build_durations_.size() > kBuildDurationHistorySize) {
+    build_durations_.pop_front();
+  }
+}
+
+fml::TimePoint VsyncWaiter::GetBeginFrameTime(
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time) const {
+  if (!delay_begin_frame_by_build_time_) {
+    return frame_start_time;
+  }
+  fml::TimeDelta predicted_build_duration;
+  {
+    std::scoped_lock lock(build_durations_mutex_);
+    if (build_durations_.size() < kBuildDurationHistorySize) {
+      return frame_start_time;
+    }
+    // Plan for the slowest recent build, so that a single slow frame doesn't
+    // miss its target.
+    for (const fml::TimeDelta& duration : build_durations_) {
+      predicted_build_duration = std::max(predicted_build_duration, duration);
+    }
+  }
+  const fml::TimePoint begin_frame_time =
+      frame_target_time - predicted_build_duration - kBeginFrameSafetyMargin;
+  return std::max(frame_start_time, begin_frame_time);
+}
+
 void VsyncWaiter::PauseDartMicroTasks() {
   auto ui_task_queue_id = task_runners_.GetUITaskRunner()->GetTaskQueueId();
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
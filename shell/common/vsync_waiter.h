@@ -5,9 +5,12 @@
 #ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_H_
 #define FLUTTER_SHELL_COMMON_VSYNC_WAITER_H_
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/common/task_runners.h"
@@ -35,6 +38,55 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  // The number of recent frame builds used to predict the next one.
+  static constexpr size_t kBuildDurationHistorySize = 16;
+
+  // The time left between the predicted end of a build and the frame target
+  // time.
+  static constexpr fml::TimeDelta kBeginFrameSafetyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Delays the start of the UI work for each frame from the vsync
+  ///             to the latest time at which recent builds would still have
+  ///             finished before the frame target time, so that the frame
+  ///             samples the freshest input.
+  ///
+  ///             Secondary callbacks, which dispatch pointer events, still run
+  ///             at vsync.
+  ///
+  void SetDelayBeginFrameByBuildTime(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records how long the UI thread took to build a frame. Only
+  ///             kept while the begin frame is delayed by the build time.
+  ///
+  void RecordBuildDuration(fml::TimeDelta duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The time at which the UI work for the frame between
+  ///             `frame_start_time` and `frame_target_time` should begin.
+  ///
+  ///             This is the frame start time unless the begin frame is
+  ///             delayed by the build time and there are enough recorded
+  ///             builds. The delay never exceeds the frame interval, which
+  ///             follows the current refresh rate of variable refresh rate
+  ///             displays.
+  ///
+  fml::TimePoint GetBeginFrameTime(fml::TimePoint frame_start_time,
+                                   fml::TimePoint frame_target_time) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks for vsync signals at about `frame_rate`, or at the
+  ///             display's default rate if it is 0. Platforms whose displays
+  ///             can't change their refresh rate ignore this.
+  ///
+  ///             Called on the UI thread by the |Animator|, which combines
+  ///             the frame rates requested by the framework and by external
+  ///             textures.
+  ///
+  virtual void SetPreferredFrameRate(double frame_rate) {}
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -70,15 +122,24 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
 
   // Schedules the callback on the UI task runner. Needs to be invoked as close
   // to the `frame_start_time` as possible.
-  void FireCallback(fml::TimePoint frame_start_time,
-                    fml::TimePoint frame_target_time,
-                    bool pause_secondary_tasks = true);
+  //
+  // Platforms that know when the frame will be shown, which may be later than
+  // the `frame_target_time` deadline, can pass it as `expected_present_time`.
+  void FireCallback(
+      fml::TimePoint frame_start_time,
+      fml::TimePoint frame_target_time,
+      bool pause_secondary_tasks = true,
+      std::optional<fml::TimePoint> expected_present_time = std::nullopt);
 
  private:
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
 
+  std::atomic<bool> delay_begin_frame_by_build_time_ = false;
+  mutable std::mutex build_durations_mutex_;
+  std::deque<fml::TimeDelta> build_durations_;
+
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
 
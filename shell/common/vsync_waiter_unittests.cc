@@ -43,5 +43,42 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, DelaysBeginFrameByRecentBuildTimes) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+  TestVsyncWaiter vsync_waiter(task_runners);
+
+  const fml::TimePoint start =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(100));
+  const fml::TimePoint target = start + fml::TimeDelta::FromMilliseconds(16);
+
+  // Frames begin at vsync until enabled and enough builds were recorded.
+  for (size_t i = 0; i < VsyncWaiter::kBuildDurationHistorySize; i++) {
+    vsync_waiter.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(4));
+  }
+  EXPECT_EQ(vsync_waiter.GetBeginFrameTime(start, target), start);
+
+  vsync_waiter.SetDelayBeginFrameByBuildTime(true);
+  for (size_t i = 1; i < VsyncWaiter::kBuildDurationHistorySize; i++) {
+    vsync_waiter.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(3));
+  }
+  EXPECT_EQ(vsync_waiter.GetBeginFrameTime(start, target), start);
+
+  // The slowest recent build decides the begin frame time.
+  vsync_waiter.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(5));
+  EXPECT_EQ(vsync_waiter.GetBeginFrameTime(start, target),
+            target - fml::TimeDelta::FromMilliseconds(5) -
+                VsyncWaiter::kBeginFrameSafetyMargin);
+
+  // Builds longer than the frame interval begin at vsync.
+  for (size_t i = 0; i < VsyncWaiter::kBuildDurationHistorySize; i++) {
+    vsync_waiter.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(20));
+  }
+  EXPECT_EQ(vsync_waiter.GetBeginFrameTime(start, target), start);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -96,6 +96,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
+                         picture_cache = picture_cache_, //
                          surface = std::move(surface)    //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
@@ -112,10 +113,12 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
+        impeller_dispatcher.SetPictureCache(picture_cache.get());
         display_list->Dispatch(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
         return renderer->Render(
             std::move(surface),
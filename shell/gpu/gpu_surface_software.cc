@@ -4,18 +4,62 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+// Tiles shorter than this are not worth the cost of dispatching the display
+// list once more.
+static constexpr int kMinimumTileHeight = 64;
+
+namespace {
+
+// Finds whether a display list has backdrop filters. They read the pixels
+// around them, which a tile doesn't have at its edges.
+class BackdropFilterFinder final : public virtual DlOpReceiver,
+                                   public IgnoreAttributeDispatchHelper,
+                                   public IgnoreClipDispatchHelper,
+                                   public IgnoreTransformDispatchHelper,
+                                   public IgnoreDrawDispatchHelper {
+ public:
+  bool found() const { return found_; }
+
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    found_ = found_ || backdrop != nullptr;
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    if (!found_) {
+      display_list->Dispatch(*this);
+    }
+  }
+
+ private:
+  bool found_ = false;
+};
+
+}  // namespace
+
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tile_loop_(std::move(tile_loop)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -58,12 +102,39 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  framebuffer_info = delegate_->GetBackingStoreFramebufferInfo();
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  if (tile_loop_) {
+    // Record the frame so that it can be rasterized in parallel on submit.
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), backing_store](
+            SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+
+      if (!self->RasterizeTiles(surface_frame.BuildDisplayList(),
+                                backing_store,
+                                surface_frame.submit_info().buffer_damage)) {
+        return false;
+      }
+
+      return self->delegate_->PresentBackingStoreWithDamage(
+          backing_store, surface_frame.submit_info().frame_damage);
+    };
+
+    return std::make_unique<SurfaceFrame>(
+        nullptr, framebuffer_info, on_submit, logical_size,
+        /*context_result=*/nullptr, /*display_list_fallback=*/true);
+  }
+
   SurfaceFrame::SubmitCallback on_submit =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           DlCanvas* canvas) -> bool {
@@ -74,13 +145,83 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->Flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    return self->delegate_->PresentBackingStoreWithDamage(
+        surface_frame.SkiaSurface(), surface_frame.submit_info().frame_damage);
   };
 
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
                                         on_submit, logical_size);
 }
 
+bool GPUSurfaceSoftware::RasterizeTiles(
+    const sk_sp<DisplayList>& display_list,
+    const sk_sp<SkSurface>& backing_store,
+    const std::optional<SkIRect>& damage) const {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+  if (!display_list) {
+    return false;
+  }
+
+  SkPixmap pixmap;
+  if (!backing_store->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
+    return false;
+  }
+
+  SkIRect area = pixmap.bounds();
+  if (damage.has_value() && !area.intersect(damage.value())) {
+    return true;
+  }
+
+  BackdropFilterFinder backdrop_filter_finder;
+  display_list->Dispatch(backdrop_filter_finder);
+
+  // The raster thread rasterizes a tile too while it waits for the workers.
+  const int max_tiles =
+      backdrop_filter_finder.found()
+          ? 1
+          : static_cast<int>(tile_loop_->GetWorkerCount()) + 1;
+  const int tile_count =
+      std::clamp(area.height() / kMinimumTileHeight, 1, max_tiles);
+  const int tile_height = (area.height() + tile_count - 1) / tile_count;
+
+  auto rasterize_tile = [&display_list, &pixmap](const SkIRect& tile) {
+    TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTile");
+    SkPixmap tile_pixmap;
+    if (!pixmap.extractSubset(&tile_pixmap, tile)) {
+      return;
+    }
+    auto tile_canvas = SkCanvas::MakeRasterDirect(
+        tile_pixmap.info(), tile_pixmap.writable_addr(),
+        tile_pixmap.rowBytes());
+    if (!tile_canvas) {
+      return;
+    }
+    tile_canvas->translate(-tile.x(), -tile.y());
+    tile_canvas->clipRect(SkRect::Make(tile));
+    // Dispatching with the clip bounds of the tile culls the operations that
+    // the R-Tree of the display list places outside of it.
+    DlSkCanvasAdapter(tile_canvas.get()).DrawDisplayList(display_list);
+  };
+
+  fml::CountDownLatch latch(tile_count - 1);
+  auto task_runner = tile_loop_->GetTaskRunner();
+  for (int i = 1; i < tile_count; i++) {
+    const SkIRect tile = SkIRect::MakeLTRB(
+        area.left(), area.top() + i * tile_height, area.right(),
+        std::min(area.top() + (i + 1) * tile_height, area.bottom()));
+    task_runner->PostTask([&rasterize_tile, &latch, tile]() {
+      rasterize_tile(tile);
+      latch.CountDown();
+    });
+  }
+  rasterize_tile(SkIRect::MakeLTRB(area.left(), area.top(), area.right(),
+                                   area.top() + tile_height));
+  latch.Wait();
+
+  return true;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -5,7 +5,11 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
@@ -14,8 +18,21 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a software surface.
+  ///
+  /// @param[in]  delegate           The platform surface.
+  /// @param[in]  render_to_surface  Whether to render into the backing stores
+  ///                                of the delegate.
+  /// @param[in]  tile_loop          If not null, frames are recorded into a
+  ///                                display list that is then rasterized in
+  ///                                horizontal tiles on the workers of this
+  ///                                loop, in parallel.
+  ///
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +55,15 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  // Rasterizes the area of the display list that is within |damage| into
+  // the backing store, one tile per worker of |tile_loop_|.
+  bool RasterizeTiles(const sk_sp<DisplayList>& display_list,
+                      const sk_sp<SkSurface>& backing_store,
+                      const std::optional<SkIRect>& damage) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
@@ -4,8 +4,23 @@
 
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
+#include <utility>
+
 namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+SurfaceFrame::FramebufferInfo
+GPUSurfaceSoftwareDelegate::GetBackingStoreFramebufferInfo() const {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  return framebuffer_info;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<SkIRect>& frame_damage) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
 }  // namespace flutter
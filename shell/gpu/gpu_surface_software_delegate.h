@@ -5,7 +5,10 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -48,6 +51,34 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Describes the backing store last returned by
+  ///             |AcquireBackingStore|. Platforms whose backing stores keep
+  ///             the contents of earlier frames can enable partial repaint
+  ///             and report the out of date area of the backing store as its
+  ///             existing damage, so that only the parts of the frame that
+  ///             changed are rasterized.
+  ///
+  /// @return     By default, a backing store that supports readback but not
+  ///             partial repaint.
+  ///
+  virtual SurfaceFrame::FramebufferInfo GetBackingStoreFramebufferInfo() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called instead of |PresentBackingStore| to also tell the
+  ///             platform which area of the frame changed.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  frame_damage   The area that changed since the previous
+  ///                            frame, or std::nullopt if the whole frame was
+  ///                            rasterized.
+  ///
+  /// @return     By default, the result of |PresentBackingStore|.
+  ///
+  virtual bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<SkIRect>& frame_damage);
 };
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/paths.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/renderer.h"
@@ -24,8 +25,11 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  auto& context_vk = impeller::SurfaceContextVK::Cast(*context);
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context, impeller::TypographerContextSkia::Make(
+                   context_vk.GetConcurrentWorkerTaskRunner(),
+                   fml::paths::GetCachesDirectory()));
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -60,10 +64,14 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
   auto& context_vk = impeller::SurfaceContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
 
+  auto worker_task_runner = context_vk.GetConcurrentWorkerTaskRunner();
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+                         picture_cache = picture_cache_, //
+                         surface = std::move(surface),   //
+                         worker_task_runner              //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -79,10 +87,12 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
-        display_list->Dispatch(
-            impeller_dispatcher,
-            SkIRect::MakeWH(cull_rect.width, cull_rect.height));
+        impeller_dispatcher.SetPictureCache(picture_cache.get());
+        impeller_dispatcher.DispatchConcurrently(
+            *display_list, SkIRect::MakeWH(cull_rect.width, cull_rect.height),
+            worker_task_runner);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
         return renderer->Render(
             std::move(surface),
@@ -93,7 +103,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
                 }));
       });
 
-  return std::make_unique<SurfaceFrame>(
+  auto frame = std::make_unique<SurfaceFrame>(
       nullptr,                          // surface
       SurfaceFrame::FramebufferInfo{},  // framebuffer info
       submit_callback,                  // submit callback
@@ -101,6 +111,13 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
       nullptr,                          // context result
       true                              // display list fallback
   );
+  if (auto pacing = context_vk.GetLastFramePacing()) {
+    frame->set_gpu_queue_info(
+        {.frames_in_flight = pacing->frames_in_flight,
+         .throttle_duration =
+             fml::TimeDelta::FromNanoseconds(pacing->throttle_time.count())});
+  }
+  return frame;
 }
 
 // |Surface|
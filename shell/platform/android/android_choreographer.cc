@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/android/android_choreographer.h"
 
+#include <memory>
+#include <optional>
+
 #include "flutter/fml/native_library.h"
 
 // Only avialalbe on API 24+
@@ -20,6 +23,42 @@ typedef void (*AChoreographer_postFrameCallback_FPN)(
 static AChoreographer_getInstance_FPN AChoreographer_getInstance;
 static AChoreographer_postFrameCallback_FPN AChoreographer_postFrameCallback;
 
+// Only available on API 33+
+typedef void AChoreographerFrameCallbackData;
+typedef void (*AChoreographer_vsyncCallback)(
+    const AChoreographerFrameCallbackData* callback_data,
+    void* data);
+typedef int (*AChoreographer_postVsyncCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_vsyncCallback callback,
+    void* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (*AChoreographerFrameCallbackData_getFrameTimelinesLength_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (
+    *AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN)(
+    const AChoreographerFrameCallbackData* data);
+// AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos
+typedef int64_t (*AChoreographerFrameCallbackData_getExpectedPresent_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
+typedef int64_t (
+    *AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
+static AChoreographer_postVsyncCallback_FPN AChoreographer_postVsyncCallback;
+static AChoreographerFrameCallbackData_getFrameTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimeNanos;
+static AChoreographerFrameCallbackData_getFrameTimelinesLength_FPN
+    AChoreographerFrameCallbackData_getFrameTimelinesLength;
+static AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex;
+static AChoreographerFrameCallbackData_getExpectedPresent_FPN
+    AChoreographerFrameCallbackData_getExpectedPresent;
+static AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos;
+
 namespace flutter {
 
 bool AndroidChoreographer::ShouldUseNDKChoreographer() {
@@ -58,4 +97,94 @@ void AndroidChoreographer::PostFrameCallback(OnFrameCallback callback,
   AChoreographer_postFrameCallback(choreographer, callback, data);
 }
 
+bool AndroidChoreographer::ShouldUseVsyncCallback() {
+  static std::optional<bool> use_vsync_callback;
+  if (use_vsync_callback) {
+    return use_vsync_callback.value();
+  }
+  use_vsync_callback = false;
+  if (!ShouldUseNDKChoreographer()) {
+    return false;
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  auto post_vsync_callback_fn =
+      libandroid->ResolveFunction<AChoreographer_postVsyncCallback_FPN>(
+          "AChoreographer_postVsyncCallback");
+  auto get_frame_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimeNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimeNanos");
+  auto get_timelines_length_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimelinesLength_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimelinesLength");
+  auto get_preferred_index_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN>(
+      "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex");
+  auto get_expected_present_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getExpectedPresent_FPN>(
+      "AChoreographerFrameCallbackData_"
+      "getFrameTimelineExpectedPresentationTimeNanos");
+  auto get_deadline_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos");
+  if (post_vsync_callback_fn && get_frame_time_fn && get_timelines_length_fn &&
+      get_preferred_index_fn && get_expected_present_fn && get_deadline_fn) {
+    AChoreographer_postVsyncCallback = post_vsync_callback_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimeNanos =
+        get_frame_time_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimelinesLength =
+        get_timelines_length_fn.value();
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex =
+        get_preferred_index_fn.value();
+    AChoreographerFrameCallbackData_getExpectedPresent =
+        get_expected_present_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos =
+        get_deadline_fn.value();
+    use_vsync_callback = true;
+  }
+  return use_vsync_callback.value();
+}
+
+namespace {
+
+struct PendingVsyncCallback {
+  AndroidChoreographer::OnVsyncCallback callback;
+  void* data;
+};
+
+void OnVsync(const AChoreographerFrameCallbackData* callback_data,
+             void* data) {
+  std::unique_ptr<PendingVsyncCallback> pending(
+      reinterpret_cast<PendingVsyncCallback*>(data));
+  // The callback data is only valid during this call.
+  AndroidChoreographer::VsyncData vsync_data;
+  vsync_data.frame_time_nanos =
+      AChoreographerFrameCallbackData_getFrameTimeNanos(callback_data);
+  const size_t length =
+      AChoreographerFrameCallbackData_getFrameTimelinesLength(callback_data);
+  vsync_data.timelines.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    AndroidChoreographer::FrameTimeline timeline;
+    timeline.expected_present_time_nanos =
+        AChoreographerFrameCallbackData_getExpectedPresent(callback_data, i);
+    timeline.deadline_nanos =
+        AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+            callback_data, i);
+    vsync_data.timelines.push_back(timeline);
+  }
+  vsync_data.preferred_timeline_index =
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+          callback_data);
+  pending->callback(vsync_data, pending->data);
+}
+
+}  // namespace
+
+void AndroidChoreographer::PostVsyncCallback(OnVsyncCallback callback,
+                                             void* data) {
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_postVsyncCallback(choreographer, &OnVsync,
+                                   new PendingVsyncCallback{callback, data});
+}
+
 }  // namespace flutter
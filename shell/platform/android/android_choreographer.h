@@ -7,7 +7,9 @@
 
 #include "flutter/fml/macros.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace flutter {
 
@@ -22,6 +24,27 @@ class AndroidChoreographer {
   static bool ShouldUseNDKChoreographer();
   static void PostFrameCallback(OnFrameCallback callback, void* data);
 
+  /// A point in time the frame may be presented at, and by when it must be
+  /// submitted for that.
+  struct FrameTimeline {
+    int64_t expected_present_time_nanos = 0;
+    int64_t deadline_nanos = 0;
+  };
+
+  /// The frame timelines offered for a vsync, ordered from the earliest.
+  struct VsyncData {
+    int64_t frame_time_nanos = 0;
+    std::vector<FrameTimeline> timelines;
+    size_t preferred_timeline_index = 0;
+  };
+
+  typedef void (*OnVsyncCallback)(const VsyncData& vsync_data, void* data);
+
+  /// Whether vsync callbacks with frame timelines are available, which is
+  /// the case on API 33+. Implies `ShouldUseNDKChoreographer`.
+  static bool ShouldUseVsyncCallback();
+  static void PostVsyncCallback(OnVsyncCallback callback, void* data);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidChoreographer);
 };
 
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 
+#include "flutter/fml/paths.h"
 #include "flutter/impeller/renderer/backend/gles/context_gles.h"
 #include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
@@ -66,8 +67,8 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 #endif  // IMPELLER_ENABLE_3D
   };
 
-  auto context =
-      impeller::ContextGLES::Create(std::move(proc_table), shader_mappings);
+  auto context = impeller::ContextGLES::Create(
+      std::move(proc_table), shader_mappings, fml::paths::GetCachesDirectory());
   if (!context) {
     FML_LOG(ERROR) << "Could not create OpenGLES Impeller Context.";
     return nullptr;
@@ -17,7 +17,8 @@ namespace flutter {
 
 static std::shared_ptr<impeller::Context> CreateImpellerContext(
     const fml::RefPtr<vulkan::VulkanProcTable>& proc_table,
-    bool enable_vulkan_validation) {
+    bool enable_vulkan_validation,
+    uint32_t max_frames_in_flight) {
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
     std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
                                            impeller_entity_shaders_vk_length),
@@ -37,6 +38,9 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   settings.shader_libraries_data = std::move(shader_mappings);
   settings.cache_directory = fml::paths::GetCachesDirectory();
   settings.enable_validation = enable_vulkan_validation;
+  if (max_frames_in_flight > 0u) {
+    settings.max_frames_in_flight = max_frames_in_flight;
+  }
 
   auto context = impeller::ContextVK::Create(std::move(settings));
 
@@ -52,10 +56,12 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 }
 
 AndroidContextVulkanImpeller::AndroidContextVulkanImpeller(
-    bool enable_validation)
+    bool enable_validation,
+    uint32_t max_frames_in_flight)
     : AndroidContext(AndroidRenderingAPI::kVulkan),
       proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {
-  auto impeller_context = CreateImpellerContext(proc_table_, enable_validation);
+  auto impeller_context = CreateImpellerContext(
+      proc_table_, enable_validation, max_frames_in_flight);
   SetImpellerContext(impeller_context);
   is_valid_ =
       proc_table_->HasAcquiredMandatoryProcAddresses() && impeller_context;
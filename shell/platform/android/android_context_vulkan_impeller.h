@@ -14,7 +14,8 @@ namespace flutter {
 
 class AndroidContextVulkanImpeller : public AndroidContext {
  public:
-  AndroidContextVulkanImpeller(bool enable_validation);
+  AndroidContextVulkanImpeller(bool enable_validation,
+                               uint32_t max_frames_in_flight = 0u);
 
   ~AndroidContextVulkanImpeller();
 
@@ -11,6 +11,12 @@
 #include <android/hardware_buffer.h>
 
 #include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/impeller/base/strings.h"
+#include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
+#include "flutter/shell/platform/android/ndk_helpers.h"
 
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
 
@@ -19,10 +25,23 @@ namespace flutter {
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_flutter_jni_class = nullptr;
 static jmethodID g_decode_image_method = nullptr;
 
-AndroidImageGenerator::~AndroidImageGenerator() = default;
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_bitmap_class = nullptr;
+static jmethodID g_bitmap_copy_method = nullptr;
+static jmethodID g_bitmap_get_hardware_buffer_method = nullptr;
+static fml::jni::ScopedJavaGlobalRef<jobject>* g_bitmap_config_argb_8888 =
+    nullptr;
 
-AndroidImageGenerator::AndroidImageGenerator(sk_sp<SkData> data)
-    : data_(std::move(data)), image_info_(SkImageInfo::MakeUnknown(-1, -1)) {}
+AndroidImageGenerator::~AndroidImageGenerator() {
+  if (hardware_buffer_) {
+    NDKHelpers::AHardwareBuffer_release(hardware_buffer_);
+  }
+}
+
+AndroidImageGenerator::AndroidImageGenerator(sk_sp<SkData> data,
+                                             bool decode_to_hardware_buffer)
+    : data_(std::move(data)),
+      decode_to_hardware_buffer_(decode_to_hardware_buffer),
+      image_info_(SkImageInfo::MakeUnknown(-1, -1)) {}
 
 const SkImageInfo& AndroidImageGenerator::GetInfo() {
   header_decoded_latch_.Wait();
@@ -55,6 +74,20 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
                                       std::optional<unsigned int> prior_frame) {
   fully_decoded_latch_.Wait();
 
+  if (!software_decoded_data_ && hardware_bitmap_) {
+    // The image is resized or drawn by Skia, so read the hardware bitmap back.
+    JNIEnv* env = fml::jni::AttachCurrentThread();
+    fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
+    auto bitmap = std::make_unique<fml::jni::ScopedJavaGlobalRef<jobject>>(
+        env, env->CallObjectMethod(hardware_bitmap_->obj(),
+                                   g_bitmap_copy_method,
+                                   g_bitmap_config_argb_8888->obj(), false));
+    FML_CHECK(fml::jni::CheckException(env));
+    if (!bitmap->is_null()) {
+      LockSoftwareBitmap(env, std::move(bitmap));
+    }
+  }
+
   if (!software_decoded_data_) {
     return false;
   }
@@ -75,15 +108,48 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
       return false;
   }
 
-  // TODO(bdero): Override `GetImage()` to use `SkImage::FromAHardwareBuffer` on
-  // API level 30+ once it's updated to do symbol lookups and not get
-  // preprocessed out in Skia. This will allow for avoiding this copy in
-  // cases where the result image doesn't need to be resized.
   memcpy(pixels, software_decoded_data_->data(),
          software_decoded_data_->size());
   return true;
 }
 
+sk_sp<DlImage> AndroidImageGenerator::GetHardwareImage(
+    const std::shared_ptr<impeller::Context>& context) {
+  fully_decoded_latch_.Wait();
+
+  if (!hardware_buffer_ || !context ||
+      context->GetBackendType() != impeller::Context::BackendType::kVulkan) {
+    return nullptr;
+  }
+
+  AHardwareBuffer_Desc hb_desc = {};
+  NDKHelpers::AHardwareBuffer_describe(hardware_buffer_, &hb_desc);
+  if (hb_desc.format != AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM) {
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor desc;
+  desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  desc.size = {static_cast<int>(hb_desc.width),
+               static_cast<int>(hb_desc.height)};
+  desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+  desc.mip_count = 1;
+
+  auto context_vk = std::static_pointer_cast<impeller::ContextVK>(context);
+  auto texture_source =
+      std::make_shared<impeller::AndroidHardwareBufferTextureSourceVK>(
+          desc, context_vk->GetDevice(), hardware_buffer_, hb_desc);
+  if (!texture_source->IsValid()) {
+    return nullptr;
+  }
+
+  auto texture =
+      std::make_shared<impeller::TextureVK>(context_vk, texture_source);
+  texture->SetLabel(
+      impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
 void AndroidImageGenerator::DecodeImage() {
   DoDecodeImage();
 
@@ -107,9 +173,11 @@ void AndroidImageGenerator::DoDecodeImage() {
       env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
 
   auto bitmap = std::make_unique<fml::jni::ScopedJavaGlobalRef<jobject>>(
-      env, env->CallStaticObjectMethod(g_flutter_jni_class->obj(),
-                                       g_decode_image_method, direct_buffer,
-                                       reinterpret_cast<jlong>(this)));
+      env, env->CallStaticObjectMethod(
+               g_flutter_jni_class->obj(), g_decode_image_method,
+               direct_buffer, reinterpret_cast<jlong>(this),
+               decode_to_hardware_buffer_ &&
+                   NDKHelpers::HardwareBufferSupported()));
   FML_CHECK(fml::jni::CheckException(env));
 
   if (bitmap->is_null()) {
@@ -124,6 +192,34 @@ void AndroidImageGenerator::DoDecodeImage() {
   }
   FML_DCHECK(info.format == ANDROID_BITMAP_FORMAT_RGBA_8888);
 
+  if (info.flags & ANDROID_BITMAP_FLAGS_IS_HARDWARE) {
+    // Keep the hardware buffer the image was decoded into, so that it can be
+    // sampled directly.
+    jobject hardware_buffer = env->CallObjectMethod(
+        bitmap->obj(), g_bitmap_get_hardware_buffer_method);
+    FML_CHECK(fml::jni::CheckException(env));
+    if (hardware_buffer) {
+      hardware_buffer_ =
+          NDKHelpers::AHardwareBuffer_fromHardwareBuffer(env, hardware_buffer);
+      NDKHelpers::AHardwareBuffer_acquire(hardware_buffer_);
+    }
+    hardware_bitmap_ = std::move(bitmap);
+    return;
+  }
+
+  LockSoftwareBitmap(env, std::move(bitmap));
+}
+
+void AndroidImageGenerator::LockSoftwareBitmap(
+    JNIEnv* env,
+    std::unique_ptr<fml::jni::ScopedJavaGlobalRef<jobject>> bitmap) {
+  AndroidBitmapInfo info;
+  [[maybe_unused]] int status;
+  if ((status = AndroidBitmap_getInfo(env, bitmap->obj(), &info)) < 0) {
+    FML_DLOG(ERROR) << "Failed to get bitmap info, status=" << status;
+    return;
+  }
+
   // Lock the android buffer in a shared pointer
 
   void* pixel_lock;
@@ -153,9 +249,37 @@ bool AndroidImageGenerator::Register(JNIEnv* env) {
 
   g_decode_image_method = env->GetStaticMethodID(
       g_flutter_jni_class->obj(), "decodeImage",
-      "(Ljava/nio/ByteBuffer;J)Landroid/graphics/Bitmap;");
+      "(Ljava/nio/ByteBuffer;JZ)Landroid/graphics/Bitmap;");
   FML_DCHECK(g_decode_image_method);
 
+  g_bitmap_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("android/graphics/Bitmap"));
+  FML_DCHECK(!g_bitmap_class->is_null());
+
+  g_bitmap_copy_method = env->GetMethodID(
+      g_bitmap_class->obj(), "copy",
+      "(Landroid/graphics/Bitmap$Config;Z)Landroid/graphics/Bitmap;");
+  FML_DCHECK(g_bitmap_copy_method);
+
+  // Only available on API 31+. Without it, images are never decoded into
+  // hardware buffers.
+  g_bitmap_get_hardware_buffer_method =
+      env->GetMethodID(g_bitmap_class->obj(), "getHardwareBuffer",
+                       "()Landroid/hardware/HardwareBuffer;");
+  if (g_bitmap_get_hardware_buffer_method == nullptr) {
+    env->ExceptionClear();
+  }
+
+  fml::jni::ScopedJavaLocalRef<jclass> config_class(
+      env, env->FindClass("android/graphics/Bitmap$Config"));
+  FML_DCHECK(!config_class.is_null());
+  jfieldID argb_8888_field =
+      env->GetStaticFieldID(config_class.obj(), "ARGB_8888",
+                            "Landroid/graphics/Bitmap$Config;");
+  FML_DCHECK(argb_8888_field);
+  g_bitmap_config_argb_8888 = new fml::jni::ScopedJavaGlobalRef<jobject>(
+      env, env->GetStaticObjectField(config_class.obj(), argb_8888_field));
+
   static const JNINativeMethod header_decoded_method = {
       .name = "nativeImageHeaderCallback",
       .signature = "(JII)V",
@@ -174,9 +298,11 @@ bool AndroidImageGenerator::Register(JNIEnv* env) {
 
 std::shared_ptr<ImageGenerator> AndroidImageGenerator::MakeFromData(
     sk_sp<SkData> data,
-    const fml::RefPtr<fml::TaskRunner>& task_runner) {
-  std::shared_ptr<AndroidImageGenerator> generator(
-      new AndroidImageGenerator(std::move(data)));
+    const fml::RefPtr<fml::TaskRunner>& task_runner,
+    bool decode_to_hardware_buffer) {
+  std::shared_ptr<AndroidImageGenerator> generator(new AndroidImageGenerator(
+      std::move(data),
+      decode_to_hardware_buffer && g_bitmap_get_hardware_buffer_method));
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runner, [generator]() { generator->DecodeImage(); });
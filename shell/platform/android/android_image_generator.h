@@ -5,9 +5,13 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_GENERATOR_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_GENERATOR_H_
 
+#include <android/hardware_buffer.h>
 #include <jni.h>
 
+#include <memory>
+
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/painting/image_generator.h"
@@ -16,7 +20,7 @@ namespace flutter {
 
 class AndroidImageGenerator : public ImageGenerator {
  private:
-  explicit AndroidImageGenerator(sk_sp<SkData> buffer);
+  AndroidImageGenerator(sk_sp<SkData> buffer, bool decode_to_hardware_buffer);
 
  public:
   ~AndroidImageGenerator();
@@ -44,13 +48,22 @@ class AndroidImageGenerator : public ImageGenerator {
                  unsigned int frame_index,
                  std::optional<unsigned int> prior_frame) override;
 
+  // |ImageGenerator|
+  sk_sp<DlImage> GetHardwareImage(
+      const std::shared_ptr<impeller::Context>& context) override;
+
   void DecodeImage();
 
   static bool Register(JNIEnv* env);
 
+  /// @param[in]  decode_to_hardware_buffer  Whether to decode into a hardware
+  ///                                        buffer that is sampled directly
+  ///                                        by Impeller's Vulkan backend,
+  ///                                        when the device supports it.
   static std::shared_ptr<ImageGenerator> MakeFromData(
       sk_sp<SkData> data,
-      const fml::RefPtr<fml::TaskRunner>& task_runner);
+      const fml::RefPtr<fml::TaskRunner>& task_runner,
+      bool decode_to_hardware_buffer = false);
 
   static void NativeImageHeaderCallback(JNIEnv* env,
                                         jclass jcaller,
@@ -60,8 +73,14 @@ class AndroidImageGenerator : public ImageGenerator {
 
  private:
   sk_sp<SkData> data_;
+  const bool decode_to_hardware_buffer_;
   sk_sp<SkData> software_decoded_data_;
 
+  /// The buffer a hardware bitmap was decoded into, and the bitmap itself,
+  /// which is copied into `software_decoded_data_` if its pixels are needed.
+  AHardwareBuffer* hardware_buffer_ = nullptr;
+  std::unique_ptr<fml::jni::ScopedJavaGlobalRef<jobject>> hardware_bitmap_;
+
   SkImageInfo image_info_;
 
   /// Blocks until the header of the image has been decoded and the image
@@ -73,6 +92,11 @@ class AndroidImageGenerator : public ImageGenerator {
 
   void DoDecodeImage();
 
+  /// Locks the pixels of a software bitmap into `software_decoded_data_`.
+  void LockSoftwareBitmap(
+      JNIEnv* env,
+      std::unique_ptr<fml::jni::ScopedJavaGlobalRef<jobject>> bitmap);
+
   bool IsValidImageData();
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AndroidImageGenerator);
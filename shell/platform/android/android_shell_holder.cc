@@ -22,6 +22,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
@@ -30,6 +31,7 @@
 #include "flutter/shell/platform/android/android_image_generator.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
+#include "rapidjson/document.h"
 
 namespace flutter {
 
@@ -106,6 +108,7 @@ AndroidShellHolder::AndroidShellHolder(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::IO, thread_label),
       fml::Thread::ThreadPriority::NORMAL);
+  host_config.pin_to_core_classes = settings_.pin_threads_to_core_classes;
 
   thread_host_ = std::make_shared<ThreadHost>(host_config);
 
@@ -163,9 +166,17 @@ AndroidShellHolder::AndroidShellHolder(
       }
     });
 
+    // Impeller's Vulkan backend samples images decoded into hardware buffers
+    // without copying them.
+    const bool decode_to_hardware_buffer =
+        weak_platform_view &&
+        weak_platform_view->GetAndroidContext()->RenderingApi() ==
+            AndroidRenderingAPI::kVulkan;
     shell_->RegisterImageDecoder(
-        [runner = task_runners.GetIOTaskRunner()](sk_sp<SkData> buffer) {
-          return AndroidImageGenerator::MakeFromData(std::move(buffer), runner);
+        [runner = task_runners.GetIOTaskRunner(),
+         decode_to_hardware_buffer](sk_sp<SkData> buffer) {
+          return AndroidImageGenerator::MakeFromData(std::move(buffer), runner,
+                                                     decode_to_hardware_buffer);
         },
         -1);
     FML_DLOG(INFO) << "Registered Android SDK image decoder (API level 28+)";
@@ -284,6 +295,7 @@ void AndroidShellHolder::Launch(
   }
 
   apk_asset_provider_ = std::move(apk_asset_provider);
+  PreloadAssets();
   auto config = BuildRunConfiguration(entrypoint, libraryUrl, entrypoint_args);
   if (!config) {
     return;
@@ -292,6 +304,38 @@ void AndroidShellHolder::Launch(
   shell_->RunEngine(std::move(config.value()));
 }
 
+// The assets the app needs for its first frame, as a JSON list of asset names
+// in the order they are needed.
+static constexpr char kAssetPreloadManifest[] = "AssetPreloadManifest.json";
+
+void AndroidShellHolder::PreloadAssets() {
+  TRACE_EVENT0("flutter", "AndroidShellHolder::PreloadAssets");
+  const AssetResolver& resolver = *apk_asset_provider_;
+  auto manifest = resolver.GetAsMapping(kAssetPreloadManifest);
+  if (!manifest) {
+    return;
+  }
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(manifest->GetMapping()),
+                 manifest->GetSize());
+  if (document.HasParseError() || !document.IsArray()) {
+    FML_LOG(ERROR) << "Could not parse " << kAssetPreloadManifest
+                   << ", expected a list of asset names.";
+    return;
+  }
+  std::vector<std::string> asset_names;
+  asset_names.reserve(document.Size());
+  for (const auto& asset_name : document.GetArray()) {
+    if (asset_name.IsString()) {
+      asset_names.emplace_back(asset_name.GetString(),
+                               asset_name.GetStringLength());
+    }
+  }
+  apk_asset_provider_->Preload(
+      std::move(asset_names), shell_->GetConcurrentWorkerTaskRunner(),
+      shell_->GetDartVM()->GetConcurrentMessageLoop()->GetWorkerCount());
+}
+
 Rasterizer::Screenshot AndroidShellHolder::Screenshot(
     Rasterizer::ScreenshotType type,
     bool base64_encode) {
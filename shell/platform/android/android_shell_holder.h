@@ -140,6 +140,8 @@ class AndroidShellHolder {
       const std::string& libraryUrl,
       const std::vector<std::string>& entrypoint_args) const;
 
+  void PreloadAssets();
+
   bool IsNDKImageDecoderAvailable();
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidShellHolder);
@@ -12,6 +12,7 @@
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
+#include "flutter/shell/platform/android/surface_control_swapchain_delegate.h"
 #include "flutter/vulkan/vulkan_native_surface_android.h"
 
 namespace flutter {
@@ -72,6 +73,17 @@ bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
   native_window_ = std::move(window);
   bool success = native_window_ && native_window_->IsValid();
   if (success) {
+    // Hand buffers to the compositor directly where possible, which gives
+    // explicit fences and latch time feedback for every frame.
+    if (auto delegate =
+            SurfaceControlSwapchainDelegate::Create(native_window_)) {
+      if (surface_context_vk_->SetAHBSwapchain(std::move(delegate))) {
+        return true;
+      }
+      FML_LOG(ERROR) << "Could not present through a surface control, "
+                        "falling back to a Vulkan swapchain.";
+    }
+
     auto surface =
         surface_context_vk_->CreateAndroidSurface(native_window_->handle());
 
@@ -4,13 +4,20 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
@@ -34,6 +41,56 @@ class APKAssetMapping : public fml::Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetMapping);
 };
 
+// Maps an asset that is stored uncompressed in the APK directly from the APK
+// file, so that it is neither copied nor inflated onto the heap.
+class APKAssetFileMapping : public fml::Mapping {
+ public:
+  static std::unique_ptr<APKAssetFileMapping> Create(AAsset* asset) {
+    off64_t start = 0;
+    off64_t length = 0;
+    // Fails for compressed assets.
+    fml::UniqueFD fd(AAsset_openFileDescriptor64(asset, &start, &length));
+    if (!fd.is_valid() || length <= 0) {
+      return nullptr;
+    }
+    // The offset passed to mmap must be page aligned, while entries in the APK
+    // are only guaranteed to be 4 byte aligned.
+    static const off64_t page_size = sysconf(_SC_PAGESIZE);
+    const off64_t aligned_start = start - (start % page_size);
+    const size_t map_size = length + (start - aligned_start);
+    void* base = mmap64(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd.get(),
+                        aligned_start);
+    if (base == MAP_FAILED) {
+      FML_DLOG(ERROR) << "Could not map an uncompressed asset from the APK.";
+      return nullptr;
+    }
+    return std::unique_ptr<APKAssetFileMapping>(new APKAssetFileMapping(
+        base, map_size, static_cast<size_t>(start - aligned_start),
+        static_cast<size_t>(length)));
+  }
+
+  ~APKAssetFileMapping() override { munmap(base_, map_size_); }
+
+  size_t GetSize() const override { return size_; }
+
+  const uint8_t* GetMapping() const override {
+    return reinterpret_cast<const uint8_t*>(base_) + offset_;
+  }
+
+  bool IsDontNeedSafe() const override { return true; }
+
+ private:
+  void* const base_;
+  const size_t map_size_;
+  const size_t offset_;
+  const size_t size_;
+
+  APKAssetFileMapping(void* base, size_t map_size, size_t offset, size_t size)
+      : base_(base), map_size_(map_size), offset_(offset), size_(size) {}
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKAssetFileMapping);
+};
+
 class APKAssetProviderImpl : public APKAssetProviderInternal {
  public:
   explicit APKAssetProviderImpl(JNIEnv* env,
@@ -56,6 +113,11 @@ class APKAssetProviderImpl : public APKAssetProviderInternal {
       return nullptr;
     }
 
+    if (auto file_mapping = APKAssetFileMapping::Create(asset)) {
+      AAsset_close(asset);
+      return file_mapping;
+    }
+
     return std::make_unique<APKAssetMapping>(asset);
   };
 
@@ -67,16 +129,107 @@ class APKAssetProviderImpl : public APKAssetProviderInternal {
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetProviderImpl);
 };
 
+// The assets loaded by |APKAssetProvider::Preload|, shared by a provider and
+// its clones.
+class APKAssetPreloadCache {
+ public:
+  APKAssetPreloadCache() = default;
+
+  // Adds the assets to the end of the queue and returns how many are queued.
+  size_t Enqueue(std::vector<std::string> asset_names) {
+    std::scoped_lock lock(mutex_);
+    for (auto& asset_name : asset_names) {
+      if (loaded_.count(asset_name) == 0 && loading_.count(asset_name) == 0 &&
+          queued_.insert(asset_name).second) {
+        queue_.push_back(std::move(asset_name));
+      }
+    }
+    return queue_.size() - next_;
+  }
+
+  // Loads queued assets in order until none are left.
+  void LoadQueued(const APKAssetProviderInternal& impl) {
+    while (true) {
+      std::string asset_name;
+      {
+        std::scoped_lock lock(mutex_);
+        if (next_ >= queue_.size()) {
+          queue_.clear();
+          next_ = 0;
+          return;
+        }
+        asset_name = std::move(queue_[next_++]);
+        // Skip assets that were requested before their turn came.
+        if (queued_.erase(asset_name) == 0) {
+          continue;
+        }
+        loading_.insert(asset_name);
+      }
+
+      TRACE_EVENT1("flutter", "APKAssetProvider::Preload", "asset",
+                   asset_name.c_str());
+      auto mapping = impl.GetAsMapping(asset_name);
+      if (mapping) {
+        // Compressed assets are only inflated on first access.
+        mapping->GetMapping();
+      }
+
+      {
+        std::scoped_lock lock(mutex_);
+        loading_.erase(asset_name);
+        if (mapping) {
+          loaded_[asset_name] = std::move(mapping);
+        }
+      }
+      loaded_cv_.notify_all();
+    }
+  }
+
+  // Returns the preloaded asset, waiting for it if it is being loaded. Returns
+  // nullptr if it was not preloaded, in which case it is taken off the queue
+  // as the caller loads it itself.
+  std::unique_ptr<fml::Mapping> Take(const std::string& asset_name) {
+    std::unique_lock lock(mutex_);
+    queued_.erase(asset_name);
+    loaded_cv_.wait(lock, [&]() { return loading_.count(asset_name) == 0; });
+    auto found = loaded_.find(asset_name);
+    if (found == loaded_.end()) {
+      return nullptr;
+    }
+    auto mapping = std::move(found->second);
+    loaded_.erase(found);
+    return mapping;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable loaded_cv_;
+  std::vector<std::string> queue_;
+  size_t next_ = 0;
+  std::unordered_set<std::string> queued_;
+  std::unordered_set<std::string> loading_;
+  std::unordered_map<std::string, std::unique_ptr<fml::Mapping>> loaded_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKAssetPreloadCache);
+};
+
 APKAssetProvider::APKAssetProvider(JNIEnv* env,
                                    jobject assetManager,
                                    std::string directory)
     : impl_(std::make_shared<APKAssetProviderImpl>(env,
                                                    assetManager,
-                                                   std::move(directory))) {}
+                                                   std::move(directory))),
+      preload_cache_(std::make_shared<APKAssetPreloadCache>()) {}
 
 APKAssetProvider::APKAssetProvider(
     std::shared_ptr<APKAssetProviderInternal> impl)
-    : impl_(std::move(impl)) {}
+    : impl_(std::move(impl)),
+      preload_cache_(std::make_shared<APKAssetPreloadCache>()) {}
+
+APKAssetProvider::APKAssetProvider(
+    std::shared_ptr<APKAssetProviderInternal> impl,
+    std::shared_ptr<APKAssetPreloadCache> preload_cache)
+    : impl_(std::move(impl)), preload_cache_(std::move(preload_cache)) {}
 
 // |AssetResolver|
 bool APKAssetProvider::IsValid() const {
@@ -96,11 +249,31 @@ AssetResolver::AssetResolverType APKAssetProvider::GetType() const {
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> APKAssetProvider::GetAsMapping(
     const std::string& asset_name) const {
+  if (auto preloaded = preload_cache_->Take(asset_name)) {
+    return preloaded;
+  }
   return impl_->GetAsMapping(asset_name);
 }
 
 std::unique_ptr<APKAssetProvider> APKAssetProvider::Clone() const {
-  return std::make_unique<APKAssetProvider>(impl_);
+  return std::unique_ptr<APKAssetProvider>(
+      new APKAssetProvider(impl_, preload_cache_));
+}
+
+void APKAssetProvider::Preload(
+    std::vector<std::string> asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+    size_t concurrency) {
+  if (!task_runner) {
+    return;
+  }
+  const size_t queued = preload_cache_->Enqueue(std::move(asset_names));
+  const size_t tasks = std::min(std::max<size_t>(concurrency, 1u), queued);
+  for (size_t i = 0; i < tasks; i++) {
+    task_runner->PostTask([impl = impl_, preload_cache = preload_cache_]() {
+      preload_cache->LoadQueued(*impl);
+    });
+  }
 }
 
 }  // namespace flutter
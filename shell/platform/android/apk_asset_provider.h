@@ -8,8 +8,13 @@
 #include <android/asset_manager_jni.h>
 #include <jni.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 
 namespace flutter {
@@ -23,6 +28,8 @@ class APKAssetProviderInternal {
   virtual ~APKAssetProviderInternal() = default;
 };
 
+class APKAssetPreloadCache;
+
 class APKAssetProvider final : public AssetResolver {
  public:
   explicit APKAssetProvider(JNIEnv* env,
@@ -37,6 +44,14 @@ class APKAssetProvider final : public AssetResolver {
   // this provider.
   std::unique_ptr<APKAssetProvider> Clone() const;
 
+  // Loads the given assets in the background using up to `concurrency` tasks
+  // on `task_runner`. Assets earlier in the list are picked up first. Each
+  // preloaded asset is held until it is first requested from this provider or
+  // one of its clones, which then doesn't have to load it again.
+  void Preload(std::vector<std::string> asset_names,
+               const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+               size_t concurrency);
+
   // Obtain a raw pointer to the APKAssetProviderInternal.
   //
   // This method is intended for use in tests. Callers must not
@@ -45,6 +60,10 @@ class APKAssetProvider final : public AssetResolver {
 
  private:
   std::shared_ptr<APKAssetProviderInternal> impl_;
+  std::shared_ptr<APKAssetPreloadCache> preload_cache_;
+
+  APKAssetProvider(std::shared_ptr<APKAssetProviderInternal> impl,
+                   std::shared_ptr<APKAssetPreloadCache> preload_cache);
 
   // |flutter::AssetResolver|
   bool IsValid() const override;
@@ -22,5 +22,39 @@ TEST(APKAssetProvider, Clone) {
   ASSERT_NE(first_provider->GetImpl(), second_provider->GetImpl());
   ASSERT_EQ(first_provider->GetImpl(), third_provider->GetImpl());
 }
+
+class ImmediateTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { task(); }
+};
+
+TEST(APKAssetProvider, PreloadedAssetsAreLoadedOnce) {
+  auto impl = std::make_shared<MockAPKAssetProviderImpl>();
+  EXPECT_CALL(*impl, GetAsMapping("a"))
+      .WillOnce([](const std::string&) {
+        return std::make_unique<fml::DataMapping>(std::vector<uint8_t>{1});
+      })
+      .WillOnce([](const std::string&) {
+        return std::make_unique<fml::DataMapping>(std::vector<uint8_t>{2});
+      });
+  EXPECT_CALL(*impl, GetAsMapping("missing")).WillOnce([](const std::string&) {
+    return nullptr;
+  });
+
+  auto provider = std::make_unique<APKAssetProvider>(impl);
+  provider->Preload({"a", "missing", "a"},
+                    std::make_shared<ImmediateTaskRunner>(), 2);
+
+  // The clone shares the preloaded assets.
+  std::unique_ptr<AssetResolver> clone = provider->Clone();
+  auto preloaded = clone->GetAsMapping("a");
+  ASSERT_TRUE(preloaded);
+  ASSERT_EQ(preloaded->GetMapping()[0], 1u);
+
+  // Preloaded assets are only held until first requested.
+  auto reloaded = clone->GetAsMapping("a");
+  ASSERT_TRUE(reloaded);
+  ASSERT_EQ(reloaded->GetMapping()[0], 2u);
+}
 }  // namespace testing
 }  // namespace flutter
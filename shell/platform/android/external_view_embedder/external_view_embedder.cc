@@ -73,66 +73,44 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     return;
   }
 
-  std::unordered_map<int64_t, SkRect> overlay_layers;
   DlCanvas* background_canvas = frame->Canvas();
   auto current_frame_view_count = composition_order_.size();
 
-  // Restore the clip context after exiting this method since it's changed
-  // below.
-  DlAutoCanvasRestore save(background_canvas, /*doSave=*/true);
-
+  // Determine where the Flutter UI painted after each platform view
+  // intersects with that platform view or the ones before it, and which
+  // overlays can show that content.
+  //
+  // This is done by querying the r-tree that holds the records for the
+  // picture recorder corresponding to the flow layers added after a platform
+  // view layer.
+  OverlayPlanner overlay_planner;
+  std::vector<EmbedderViewSlice*> recorded_slices;
   for (size_t i = 0; i < current_frame_view_count; i++) {
     int64_t view_id = composition_order_[i];
     EmbedderViewSlice* slice = slices_.at(view_id).get();
     if (slice->canvas() == nullptr) {
-      continue;
+      slice = nullptr;
+    } else {
+      slice->end_recording();
     }
+    recorded_slices.push_back(slice);
+    overlay_planner.AddPlatformView(GetViewRect(view_id), slice);
+  }
 
-    slice->end_recording();
-
-    SkRect full_joined_rect = SkRect::MakeEmpty();
+  // Restore the clip context after exiting this method since it's changed
+  // below.
+  DlAutoCanvasRestore save(background_canvas, /*doSave=*/true);
 
-    // Determinate if Flutter UI intersects with any of the previous
-    // platform views stacked by z position.
-    //
-    // This is done by querying the r-tree that holds the records for the
-    // picture recorder corresponding to the flow layers added after a platform
-    // view layer.
-    for (ssize_t j = i; j >= 0; j--) {
-      int64_t current_view_id = composition_order_[j];
-      SkRect current_view_rect = GetViewRect(current_view_id);
-      // The rect above the `current_view_rect`
-      SkRect partial_joined_rect = SkRect::MakeEmpty();
-      // Each rect corresponds to a native view that renders Flutter UI.
-      std::list<SkRect> intersection_rects =
-          slice->searchNonOverlappingDrawnRects(current_view_rect);
-
-      // Limit the number of native views, so it doesn't grow forever.
-      //
-      // In this case, the rects are merged into a single one that is the union
-      // of all the rects.
-      for (const SkRect& rect : intersection_rects) {
-        partial_joined_rect.join(rect);
-      }
-      // Get the intersection rect with the `current_view_rect`,
-      partial_joined_rect.intersect(current_view_rect);
-      // Join the `partial_joined_rect` into `full_joined_rect` to get the rect
-      // above the current `slice`
-      full_joined_rect.join(partial_joined_rect);
+  for (size_t i = 0; i < current_frame_view_count; i++) {
+    EmbedderViewSlice* slice = recorded_slices[i];
+    if (slice == nullptr) {
+      continue;
     }
-    if (!full_joined_rect.isEmpty()) {
-      // Subpixels in the platform may not align with the canvas subpixels.
-      //
-      // To workaround it, round the floating point bounds and make the rect
-      // slightly larger.
-      //
-      // For example, {0.3, 0.5, 3.1, 4.7} becomes {0, 0, 4, 5}.
-      full_joined_rect.set(full_joined_rect.roundOut());
-      overlay_layers.insert({view_id, full_joined_rect});
+    const SkRect& overlay_rect = overlay_planner.GetSliceOverlayRect(i);
+    if (!overlay_rect.isEmpty()) {
       // Clip the background canvas, so it doesn't contain any of the pixels
       // drawn on the overlay layer.
-      background_canvas->ClipRect(full_joined_rect,
-                                  DlCanvas::ClipOp::kDifference);
+      background_canvas->ClipRect(overlay_rect, DlCanvas::ClipOp::kDifference);
     }
     slice->render_into(background_canvas);
   }
@@ -150,7 +128,10 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     frame->Submit();
   }
 
-  for (int64_t view_id : composition_order_) {
+  std::vector<OverlayPlanner::Overlay> overlays = overlay_planner.Plan();
+  auto overlay = overlays.begin();
+  for (size_t i = 0; i < current_frame_view_count; i++) {
+    int64_t view_id = composition_order_[i];
     SkRect view_rect = GetViewRect(view_id);
     const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
@@ -165,34 +146,30 @@ void AndroidExternalViewEmbedder::SubmitFrame(
         params.sizePoints().height() * device_pixel_ratio_,
         params.mutatorsStack()  //
     );
-    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
-        overlay_layers.find(view_id);
-    if (overlay == overlay_layers.end()) {
+    if (overlay == overlays.end() || overlay->view_index != i) {
       continue;
     }
     std::unique_ptr<SurfaceFrame> frame =
-        CreateSurfaceIfNeeded(context,                    //
-                              view_id,                    //
-                              slices_.at(view_id).get(),  //
-                              overlay->second             //
-        );
+        CreateSurfaceIfNeeded(context, *overlay, overlay_planner);
     if (should_submit_current_frame) {
       frame->Submit();
     }
+    ++overlay;
   }
 }
 
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
-AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                   int64_t view_id,
-                                                   EmbedderViewSlice* slice,
-                                                   const SkRect& rect) {
+AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(
+    GrDirectContext* context,
+    const OverlayPlanner::Overlay& overlay,
+    const OverlayPlanner& overlay_planner) {
   std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
       context, android_context_, jni_facade_, surface_factory_);
 
   std::unique_ptr<SurfaceFrame> frame =
       layer->surface->AcquireFrame(frame_size_);
+  const SkRect& rect = overlay.rect;
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
   jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
@@ -206,7 +183,13 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
   overlay_canvas->Translate(-rect.x(), -rect.y());
-  slice->render_into(overlay_canvas);
+  // The overlay may show several slices, each of which only belongs on the
+  // overlay within its own rect.
+  for (size_t slice_index : overlay.slices) {
+    DlAutoCanvasRestore save(overlay_canvas, /*doSave=*/true);
+    overlay_canvas->ClipRect(overlay_planner.GetSliceOverlayRect(slice_index));
+    slices_.at(composition_order_[slice_index])->render_into(overlay_canvas);
+  }
   return frame;
 }
 
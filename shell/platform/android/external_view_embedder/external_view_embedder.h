@@ -135,11 +135,11 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   bool FrameHasPlatformLayers();
 
   // Creates a Surface when needed or recycles an existing one.
-  // Finally, draws the picture on the frame's canvas.
-  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                      int64_t view_id,
-                                                      EmbedderViewSlice* slice,
-                                                      const SkRect& rect);
+  // Finally, draws the slices of the overlay on the frame's canvas.
+  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(
+      GrDirectContext* context,
+      const OverlayPlanner::Overlay& overlay,
+      const OverlayPlanner& overlay_planner);
 };
 
 }  // namespace flutter
@@ -40,6 +40,7 @@ import io.flutter.view.TextureRegistry;
 import java.io.IOException;
 import java.lang.ref.WeakReference;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.Locale;
@@ -103,6 +104,16 @@ import java.util.concurrent.locks.ReentrantReadWriteLock;
 @Keep
 public class FlutterJNI {
   private static final String TAG = "FlutterJNI";
+
+  // The commands of a frame passed to onPlatformViewCommands. Must match the constants in
+  // platform_view_android_jni_impl.cc.
+  private static final int PLATFORM_VIEW_COMMAND_BEGIN_FRAME = 0;
+  private static final int PLATFORM_VIEW_COMMAND_DISPLAY_PLATFORM_VIEW = 1;
+  private static final int PLATFORM_VIEW_COMMAND_DISPLAY_OVERLAY_SURFACE = 2;
+  private static final int PLATFORM_VIEW_COMMAND_END_FRAME = 3;
+  private static final int PLATFORM_VIEW_MUTATOR_TRANSFORM = 0;
+  private static final int PLATFORM_VIEW_MUTATOR_CLIP_RECT = 1;
+  private static final int PLATFORM_VIEW_MUTATOR_CLIP_RRECT = 2;
   // This serializes the invocation of platform message responses and the
   // attachment and detachment of the shell holder.  This ensures that we don't
   // detach FlutterJNI on the platform thread while a background thread invokes
@@ -551,7 +562,8 @@ public class FlutterJNI {
   @SuppressWarnings("unused")
   @VisibleForTesting
   @Nullable
-  public static Bitmap decodeImage(@NonNull ByteBuffer buffer, long imageGeneratorAddress) {
+  public static Bitmap decodeImage(
+      @NonNull ByteBuffer buffer, long imageGeneratorAddress, boolean decodeToHardwareBuffer) {
     if (Build.VERSION.SDK_INT >= 28) {
       ImageDecoder.Source source = ImageDecoder.createSource(buffer);
       try {
@@ -560,11 +572,12 @@ public class FlutterJNI {
             (decoder, info, src) -> {
               // i.e. ARGB_8888
               decoder.setTargetColorSpace(ColorSpace.get(ColorSpace.Named.SRGB));
-              // TODO(bdero): Switch to ALLOCATOR_HARDWARE for devices that have
-              // `AndroidBitmap_getHardwareBuffer` (API 30+) available once Skia supports
-              // `SkImage::MakeFromAHardwareBuffer` via dynamic lookups:
-              // https://skia-review.googlesource.com/c/skia/+/428960
-              decoder.setAllocator(ImageDecoder.ALLOCATOR_SOFTWARE);
+              // Hardware bitmaps are handed to the engine as HardwareBuffers, which
+              // needs Bitmap.getHardwareBuffer (API 31).
+              decoder.setAllocator(
+                  decodeToHardwareBuffer && Build.VERSION.SDK_INT >= 31
+                      ? ImageDecoder.ALLOCATOR_HARDWARE
+                      : ImageDecoder.ALLOCATOR_SOFTWARE);
 
               Size size = info.getSize();
               nativeImageHeaderCallback(imageGeneratorAddress, size.getWidth(), size.getHeight());
@@ -1234,6 +1247,95 @@ public class FlutterJNI {
     platformViewsController.onEndFrame();
   }
 
+  /**
+   * Applies the platform view and overlay surface commands of a whole frame, which the engine
+   * records instead of calling {@link #onBeginFrame}, {@link #onDisplayPlatformView}, {@link
+   * #onDisplayOverlaySurface} and {@link #onEndFrame} one at a time.
+   *
+   * <p>The commands are 32 bit values in native byte order. {@code commands} is only valid for the
+   * duration of this call.
+   */
+  @SuppressWarnings("unused")
+  @UiThread
+  @VisibleForTesting
+  public void onPlatformViewCommands(@NonNull ByteBuffer commands) {
+    commands.order(ByteOrder.nativeOrder());
+    while (commands.hasRemaining()) {
+      final int command = commands.getInt();
+      switch (command) {
+        case PLATFORM_VIEW_COMMAND_BEGIN_FRAME:
+          onBeginFrame();
+          break;
+        case PLATFORM_VIEW_COMMAND_DISPLAY_PLATFORM_VIEW:
+          {
+            final int viewId = commands.getInt();
+            final int x = commands.getInt();
+            final int y = commands.getInt();
+            final int width = commands.getInt();
+            final int height = commands.getInt();
+            final int viewWidth = commands.getInt();
+            final int viewHeight = commands.getInt();
+            final FlutterMutatorsStack mutatorsStack = readMutatorsStack(commands);
+            onDisplayPlatformView(viewId, x, y, width, height, viewWidth, viewHeight, mutatorsStack);
+            break;
+          }
+        case PLATFORM_VIEW_COMMAND_DISPLAY_OVERLAY_SURFACE:
+          {
+            final int id = commands.getInt();
+            final int x = commands.getInt();
+            final int y = commands.getInt();
+            final int width = commands.getInt();
+            final int height = commands.getInt();
+            onDisplayOverlaySurface(id, x, y, width, height);
+            break;
+          }
+        case PLATFORM_VIEW_COMMAND_END_FRAME:
+          onEndFrame();
+          break;
+        default:
+          throw new IllegalStateException("Unknown platform view command: " + command);
+      }
+    }
+  }
+
+  @NonNull
+  private static FlutterMutatorsStack readMutatorsStack(@NonNull ByteBuffer commands) {
+    final FlutterMutatorsStack mutatorsStack = new FlutterMutatorsStack();
+    final int count = commands.getInt();
+    for (int i = 0; i < count; i++) {
+      final int mutator = commands.getInt();
+      switch (mutator) {
+        case PLATFORM_VIEW_MUTATOR_TRANSFORM:
+          {
+            final float[] values = new float[9];
+            commands.asFloatBuffer().get(values);
+            commands.position(commands.position() + values.length * 4);
+            mutatorsStack.pushTransform(values);
+            break;
+          }
+        case PLATFORM_VIEW_MUTATOR_CLIP_RECT:
+          mutatorsStack.pushClipRect(
+              commands.getInt(), commands.getInt(), commands.getInt(), commands.getInt());
+          break;
+        case PLATFORM_VIEW_MUTATOR_CLIP_RRECT:
+          {
+            final int left = commands.getInt();
+            final int top = commands.getInt();
+            final int right = commands.getInt();
+            final int bottom = commands.getInt();
+            final float[] radiis = new float[8];
+            commands.asFloatBuffer().get(radiis);
+            commands.position(commands.position() + radiis.length * 4);
+            mutatorsStack.pushClipRRect(left, top, right, bottom, radiis);
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown platform view mutator: " + mutator);
+      }
+    }
+    return mutatorsStack;
+  }
+
   @SuppressWarnings("unused")
   @UiThread
   public FlutterOverlaySurface createOverlaySurface() {
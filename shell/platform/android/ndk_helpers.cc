@@ -18,22 +18,74 @@ namespace {
 typedef AHardwareBuffer* (*fp_AHardwareBuffer_fromHardwareBuffer)(
     JNIEnv* env,
     jobject hardwareBufferObj);
+typedef int (*fp_AHardwareBuffer_allocate)(const AHardwareBuffer_Desc* desc,
+                                           AHardwareBuffer** out_buffer);
 typedef void (*fp_AHardwareBuffer_acquire)(AHardwareBuffer* buffer);
 typedef void (*fp_AHardwareBuffer_release)(AHardwareBuffer* buffer);
 typedef void (*fp_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                             AHardwareBuffer_Desc* desc);
 typedef EGLClientBuffer (*fp_eglGetNativeClientBufferANDROID)(
     AHardwareBuffer* buffer);
+typedef ASurfaceControl* (*fp_ASurfaceControl_createFromWindow)(
+    ANativeWindow* parent,
+    const char* debug_name);
+typedef void (*fp_ASurfaceControl_release)(ASurfaceControl* surface_control);
+typedef ASurfaceTransaction* (*fp_ASurfaceTransaction_create)();
+typedef void (*fp_ASurfaceTransaction_delete)(ASurfaceTransaction* transaction);
+typedef void (*fp_ASurfaceTransaction_apply)(ASurfaceTransaction* transaction);
+typedef void (*fp_ASurfaceTransaction_reparent)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    ASurfaceControl* new_parent);
+typedef void (*fp_ASurfaceTransaction_setBuffer)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd);
+typedef void (*fp_ASurfaceTransaction_setOnComplete)(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete func);
+typedef int64_t (*fp_ASurfaceTransactionStats_getLatchTime)(
+    ASurfaceTransactionStats* stats);
+typedef int (*fp_ASurfaceTransactionStats_getPreviousReleaseFenceFd)(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control);
 
 AHardwareBuffer* (*_AHardwareBuffer_fromHardwareBuffer)(
     JNIEnv* env,
     jobject hardwareBufferObj) = nullptr;
+int (*_AHardwareBuffer_allocate)(const AHardwareBuffer_Desc* desc,
+                                 AHardwareBuffer** out_buffer) = nullptr;
 void (*_AHardwareBuffer_acquire)(AHardwareBuffer* buffer) = nullptr;
 void (*_AHardwareBuffer_release)(AHardwareBuffer* buffer) = nullptr;
 void (*_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                   AHardwareBuffer_Desc* desc) = nullptr;
 EGLClientBuffer (*_eglGetNativeClientBufferANDROID)(AHardwareBuffer* buffer) =
     nullptr;
+ASurfaceControl* (*_ASurfaceControl_createFromWindow)(
+    ANativeWindow* parent,
+    const char* debug_name) = nullptr;
+void (*_ASurfaceControl_release)(ASurfaceControl* surface_control) = nullptr;
+ASurfaceTransaction* (*_ASurfaceTransaction_create)() = nullptr;
+void (*_ASurfaceTransaction_delete)(ASurfaceTransaction* transaction) = nullptr;
+void (*_ASurfaceTransaction_apply)(ASurfaceTransaction* transaction) = nullptr;
+void (*_ASurfaceTransaction_reparent)(ASurfaceTransaction* transaction,
+                                      ASurfaceControl* surface_control,
+                                      ASurfaceControl* new_parent) = nullptr;
+void (*_ASurfaceTransaction_setBuffer)(ASurfaceTransaction* transaction,
+                                       ASurfaceControl* surface_control,
+                                       AHardwareBuffer* buffer,
+                                       int acquire_fence_fd) = nullptr;
+void (*_ASurfaceTransaction_setOnComplete)(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete func) = nullptr;
+int64_t (*_ASurfaceTransactionStats_getLatchTime)(
+    ASurfaceTransactionStats* stats) = nullptr;
+int (*_ASurfaceTransactionStats_getPreviousReleaseFenceFd)(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control) = nullptr;
 
 std::once_flag init_once;
 
@@ -53,6 +105,11 @@ void InitOnceCallback() {
           ->ResolveFunction<fp_AHardwareBuffer_fromHardwareBuffer>(
               "AHardwareBuffer_fromHardwareBuffer")
           .value_or(nullptr);
+  _AHardwareBuffer_allocate =
+      android
+          ->ResolveFunction<fp_AHardwareBuffer_allocate>(
+              "AHardwareBuffer_allocate")
+          .value_or(nullptr);
   _AHardwareBuffer_acquire = android
                                  ->ResolveFunction<fp_AHardwareBuffer_acquire>(
                                      "AHardwareBuffer_acquire")
@@ -66,6 +123,57 @@ void InitOnceCallback() {
           ->ResolveFunction<fp_AHardwareBuffer_describe>(
               "AHardwareBuffer_describe")
           .value_or(nullptr);
+  _ASurfaceControl_createFromWindow =
+      android
+          ->ResolveFunction<fp_ASurfaceControl_createFromWindow>(
+              "ASurfaceControl_createFromWindow")
+          .value_or(nullptr);
+  _ASurfaceControl_release =
+      android
+          ->ResolveFunction<fp_ASurfaceControl_release>(
+              "ASurfaceControl_release")
+          .value_or(nullptr);
+  _ASurfaceTransaction_create =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_create>(
+              "ASurfaceTransaction_create")
+          .value_or(nullptr);
+  _ASurfaceTransaction_delete =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_delete>(
+              "ASurfaceTransaction_delete")
+          .value_or(nullptr);
+  _ASurfaceTransaction_apply =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_apply>(
+              "ASurfaceTransaction_apply")
+          .value_or(nullptr);
+  _ASurfaceTransaction_reparent =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_reparent>(
+              "ASurfaceTransaction_reparent")
+          .value_or(nullptr);
+  _ASurfaceTransaction_setBuffer =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_setBuffer>(
+              "ASurfaceTransaction_setBuffer")
+          .value_or(nullptr);
+  _ASurfaceTransaction_setOnComplete =
+      android
+          ->ResolveFunction<fp_ASurfaceTransaction_setOnComplete>(
+              "ASurfaceTransaction_setOnComplete")
+          .value_or(nullptr);
+  _ASurfaceTransactionStats_getLatchTime =
+      android
+          ->ResolveFunction<fp_ASurfaceTransactionStats_getLatchTime>(
+              "ASurfaceTransactionStats_getLatchTime")
+          .value_or(nullptr);
+  _ASurfaceTransactionStats_getPreviousReleaseFenceFd =
+      android
+          ->ResolveFunction<
+              fp_ASurfaceTransactionStats_getPreviousReleaseFenceFd>(
+              "ASurfaceTransactionStats_getPreviousReleaseFenceFd")
+          .value_or(nullptr);
 }
 
 }  // namespace
@@ -88,6 +196,13 @@ AHardwareBuffer* NDKHelpers::AHardwareBuffer_fromHardwareBuffer(
   return _AHardwareBuffer_fromHardwareBuffer(env, hardwareBufferObj);
 }
 
+int NDKHelpers::AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc,
+                                         AHardwareBuffer** out_buffer) {
+  NDKHelpers::Init();
+  FML_CHECK(_AHardwareBuffer_allocate != nullptr);
+  return _AHardwareBuffer_allocate(desc, out_buffer);
+}
+
 void NDKHelpers::AHardwareBuffer_acquire(AHardwareBuffer* buffer) {
   NDKHelpers::Init();
   FML_CHECK(_AHardwareBuffer_acquire != nullptr);
@@ -114,4 +229,96 @@ EGLClientBuffer NDKHelpers::eglGetNativeClientBufferANDROID(
   return _eglGetNativeClientBufferANDROID(buffer);
 }
 
+bool NDKHelpers::SurfaceControlAndTransactionSupported() {
+  NDKHelpers::Init();
+  return _AHardwareBuffer_allocate != nullptr &&
+         _ASurfaceControl_createFromWindow != nullptr &&
+         _ASurfaceControl_release != nullptr &&
+         _ASurfaceTransaction_create != nullptr &&
+         _ASurfaceTransaction_delete != nullptr &&
+         _ASurfaceTransaction_apply != nullptr &&
+         _ASurfaceTransaction_reparent != nullptr &&
+         _ASurfaceTransaction_setBuffer != nullptr &&
+         _ASurfaceTransaction_setOnComplete != nullptr &&
+         _ASurfaceTransactionStats_getLatchTime != nullptr &&
+         _ASurfaceTransactionStats_getPreviousReleaseFenceFd != nullptr;
+}
+
+ASurfaceControl* NDKHelpers::ASurfaceControl_createFromWindow(
+    ANativeWindow* parent,
+    const char* debug_name) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceControl_createFromWindow != nullptr);
+  return _ASurfaceControl_createFromWindow(parent, debug_name);
+}
+
+void NDKHelpers::ASurfaceControl_release(ASurfaceControl* surface_control) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceControl_release != nullptr);
+  _ASurfaceControl_release(surface_control);
+}
+
+ASurfaceTransaction* NDKHelpers::ASurfaceTransaction_create() {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_create != nullptr);
+  return _ASurfaceTransaction_create();
+}
+
+void NDKHelpers::ASurfaceTransaction_delete(ASurfaceTransaction* transaction) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_delete != nullptr);
+  _ASurfaceTransaction_delete(transaction);
+}
+
+void NDKHelpers::ASurfaceTransaction_apply(ASurfaceTransaction* transaction) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_apply != nullptr);
+  _ASurfaceTransaction_apply(transaction);
+}
+
+void NDKHelpers::ASurfaceTransaction_reparent(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    ASurfaceControl* new_parent) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_reparent != nullptr);
+  _ASurfaceTransaction_reparent(transaction, surface_control, new_parent);
+}
+
+void NDKHelpers::ASurfaceTransaction_setBuffer(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_setBuffer != nullptr);
+  _ASurfaceTransaction_setBuffer(transaction, surface_control, buffer,
+                                 acquire_fence_fd);
+}
+
+void NDKHelpers::ASurfaceTransaction_setOnComplete(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete func) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransaction_setOnComplete != nullptr);
+  _ASurfaceTransaction_setOnComplete(transaction, context, func);
+}
+
+int64_t NDKHelpers::ASurfaceTransactionStats_getLatchTime(
+    ASurfaceTransactionStats* stats) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransactionStats_getLatchTime != nullptr);
+  return _ASurfaceTransactionStats_getLatchTime(stats);
+}
+
+int NDKHelpers::ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control) {
+  NDKHelpers::Init();
+  FML_CHECK(_ASurfaceTransactionStats_getPreviousReleaseFenceFd != nullptr);
+  return _ASurfaceTransactionStats_getPreviousReleaseFenceFd(stats,
+                                                             surface_control);
+}
+
 }  // namespace flutter
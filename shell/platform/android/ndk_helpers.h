@@ -11,6 +11,8 @@
 #include "flutter/impeller/toolkit/egl/egl.h"
 
 #include <android/hardware_buffer.h>
+#include <android/native_window.h>
+#include <android/surface_control.h>
 
 namespace flutter {
 
@@ -23,6 +25,8 @@ class NDKHelpers {
   static AHardwareBuffer* AHardwareBuffer_fromHardwareBuffer(
       JNIEnv* env,
       jobject hardwareBufferObj);
+  static int AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc,
+                                      AHardwareBuffer** out_buffer);
   static void AHardwareBuffer_acquire(AHardwareBuffer* buffer);
   static void AHardwareBuffer_release(AHardwareBuffer* buffer);
   static void AHardwareBuffer_describe(AHardwareBuffer* buffer,
@@ -30,6 +34,32 @@ class NDKHelpers {
   static EGLClientBuffer eglGetNativeClientBufferANDROID(
       AHardwareBuffer* buffer);
 
+  // API Version 29
+  static bool SurfaceControlAndTransactionSupported();
+  static ASurfaceControl* ASurfaceControl_createFromWindow(
+      ANativeWindow* parent,
+      const char* debug_name);
+  static void ASurfaceControl_release(ASurfaceControl* surface_control);
+  static ASurfaceTransaction* ASurfaceTransaction_create();
+  static void ASurfaceTransaction_delete(ASurfaceTransaction* transaction);
+  static void ASurfaceTransaction_apply(ASurfaceTransaction* transaction);
+  static void ASurfaceTransaction_reparent(ASurfaceTransaction* transaction,
+                                          ASurfaceControl* surface_control,
+                                          ASurfaceControl* new_parent);
+  static void ASurfaceTransaction_setBuffer(ASurfaceTransaction* transaction,
+                                            ASurfaceControl* surface_control,
+                                            AHardwareBuffer* buffer,
+                                            int acquire_fence_fd);
+  static void ASurfaceTransaction_setOnComplete(
+      ASurfaceTransaction* transaction,
+      void* context,
+      ASurfaceTransaction_OnComplete func);
+  static int64_t ASurfaceTransactionStats_getLatchTime(
+      ASurfaceTransactionStats* stats);
+  static int ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+      ASurfaceTransactionStats* stats,
+      ASurfaceControl* surface_control);
+
  private:
   static void Init();
 };
@@ -8,6 +8,7 @@
 #include <android/native_window_jni.h>
 #include <dlfcn.h>
 #include <jni.h>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -103,9 +104,7 @@ static jmethodID g_create_overlay_surface_method = nullptr;
 
 static jmethodID g_destroy_overlay_surfaces_method = nullptr;
 
-static jmethodID g_on_begin_frame_method = nullptr;
-
-static jmethodID g_on_end_frame_method = nullptr;
+static jmethodID g_on_platform_view_commands_method = nullptr;
 
 static jmethodID g_java_weak_reference_get_method = nullptr;
 
@@ -1105,19 +1104,12 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
-  g_on_begin_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onBeginFrame", "()V");
+  g_on_platform_view_commands_method =
+      env->GetMethodID(g_flutter_jni_class->obj(), "onPlatformViewCommands",
+                       "(Ljava/nio/ByteBuffer;)V");
 
-  if (g_on_begin_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onBeginFrame method";
-    return false;
-  }
-
-  g_on_end_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onEndFrame", "()V");
-
-  if (g_on_end_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onEndFrame method";
+  if (g_on_platform_view_commands_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate onPlatformViewCommands method";
     return false;
   }
 
@@ -1268,6 +1260,90 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
   return RegisterApi(env);
 }
 
+namespace {
+
+// The commands of a frame passed to FlutterJNI.onPlatformViewCommands.
+// Must match the constants in FlutterJNI.java.
+enum PlatformViewCommand : int32_t {
+  kBeginFrameCommand = 0,
+  kDisplayPlatformViewCommand = 1,
+  kDisplayOverlaySurfaceCommand = 2,
+  kEndFrameCommand = 3,
+};
+
+enum PlatformViewMutatorCommand : int32_t {
+  kTransformMutatorCommand = 0,
+  kClipRectMutatorCommand = 1,
+  kClipRRectMutatorCommand = 2,
+};
+
+// Appends a value in native byte order.
+template <typename T>
+void AppendCommandValue(std::vector<uint8_t>& commands, T value) {
+  static_assert(sizeof(T) == 4, "Commands are made of 32 bit values");
+  const size_t offset = commands.size();
+  commands.resize(offset + sizeof(T));
+  std::memcpy(commands.data() + offset, &value, sizeof(T));
+}
+
+void AppendRect(std::vector<uint8_t>& commands, const SkRect& rect) {
+  for (SkScalar value :
+       {rect.left(), rect.top(), rect.right(), rect.bottom()}) {
+    AppendCommandValue<int32_t>(commands, static_cast<int32_t>(value));
+  }
+}
+
+void AppendMutators(std::vector<uint8_t>& commands,
+                    const MutatorsStack& mutators_stack) {
+  const size_t count_offset = commands.size();
+  int32_t count = 0;
+  AppendCommandValue<int32_t>(commands, count);
+  for (auto iter = mutators_stack.Begin(); iter != mutators_stack.End();
+       ++iter) {
+    switch ((*iter)->GetType()) {
+      case kTransform: {
+        SkScalar matrix_array[9];
+        (*iter)->GetMatrix().get9(matrix_array);
+        AppendCommandValue<int32_t>(commands, kTransformMutatorCommand);
+        for (SkScalar value : matrix_array) {
+          AppendCommandValue<float>(commands, value);
+        }
+        count++;
+        break;
+      }
+      case kClipRect: {
+        AppendCommandValue<int32_t>(commands, kClipRectMutatorCommand);
+        AppendRect(commands, (*iter)->GetRect());
+        count++;
+        break;
+      }
+      case kClipRRect: {
+        const SkRRect& rrect = (*iter)->GetRRect();
+        AppendCommandValue<int32_t>(commands, kClipRRectMutatorCommand);
+        AppendRect(commands, rrect.rect());
+        for (auto corner :
+             {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+              SkRRect::kLowerRight_Corner, SkRRect::kLowerLeft_Corner}) {
+          const SkVector& radii = rrect.radii(corner);
+          AppendCommandValue<float>(commands, radii.x());
+          AppendCommandValue<float>(commands, radii.y());
+        }
+        count++;
+        break;
+      }
+      // TODO(cyanglaz): Implement other mutators.
+      // https://github.com/flutter/flutter/issues/58426
+      case kClipPath:
+      case kOpacity:
+      case kBackdropFilter:
+        break;
+    }
+  }
+  std::memcpy(commands.data() + count_offset, &count, sizeof(count));
+}
+
+}  // namespace
+
 PlatformViewAndroidJNIImpl::PlatformViewAndroidJNIImpl(
     const fml::jni::JavaObjectWeakGlobalRef& java_object)
     : java_object_(java_object) {}
@@ -1622,6 +1698,16 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int viewWidth,
     int viewHeight,
     MutatorsStack mutators_stack) {
+  if (is_recording_frame_) {
+    AppendCommandValue<int32_t>(frame_commands_, kDisplayPlatformViewCommand);
+    for (int32_t value :
+         {view_id, x, y, width, height, viewWidth, viewHeight}) {
+      AppendCommandValue<int32_t>(frame_commands_, value);
+    }
+    AppendMutators(frame_commands_, mutators_stack);
+    return;
+  }
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
   auto java_object = java_object_.get(env);
   if (java_object.is_null()) {
@@ -1700,6 +1786,15 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
     int y,
     int width,
     int height) {
+  if (is_recording_frame_) {
+    AppendCommandValue<int32_t>(frame_commands_,
+                                kDisplayOverlaySurfaceCommand);
+    for (int32_t value : {surface_id, x, y, width, height}) {
+      AppendCommandValue<int32_t>(frame_commands_, value);
+    }
+    return;
+  }
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
   auto java_object = java_object_.get(env);
@@ -1714,19 +1809,21 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewBeginFrame() {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
+  // The platform views and overlay surfaces displayed in the frame are only
+  // laid out by Java when the frame ends, so record the whole frame and hand
+  // it over in a single call instead of one call per command.
+  frame_commands_.clear();
+  AppendCommandValue<int32_t>(frame_commands_, kBeginFrameCommand);
+  is_recording_frame_ = true;
+}
 
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
+void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
+  if (!is_recording_frame_) {
     return;
   }
+  is_recording_frame_ = false;
+  AppendCommandValue<int32_t>(frame_commands_, kEndFrameCommand);
 
-  env->CallVoidMethod(java_object.obj(), g_on_begin_frame_method);
-
-  FML_CHECK(fml::jni::CheckException(env));
-}
-
-void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
   auto java_object = java_object_.get(env);
@@ -1734,7 +1831,12 @@ void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
     return;
   }
 
-  env->CallVoidMethod(java_object.obj(), g_on_end_frame_method);
+  // The buffer is only valid during the call.
+  fml::jni::ScopedJavaLocalRef<jobject> commands(
+      env, env->NewDirectByteBuffer(frame_commands_.data(),
+                                    frame_commands_.size()));
+  env->CallVoidMethod(java_object.obj(), g_on_platform_view_commands_method,
+                      commands.obj());
 
   FML_CHECK(fml::jni::CheckException(env));
 }
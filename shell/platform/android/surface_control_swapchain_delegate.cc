@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/surface_control_swapchain_delegate.h"
+
+#include <chrono>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+struct PresentCompleteContext {
+  std::shared_ptr<ASurfaceControl> surface_control;
+  impeller::AHBSwapchainVK::PresentCompleteCallback on_complete;
+};
+
+void OnTransactionComplete(void* context, ASurfaceTransactionStats* stats) {
+  std::unique_ptr<PresentCompleteContext> complete(
+      reinterpret_cast<PresentCompleteContext*>(context));
+  fml::UniqueFD release_fence(
+      NDKHelpers::ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+          stats, complete->surface_control.get()));
+  const auto latch_time = std::chrono::nanoseconds(
+      NDKHelpers::ASurfaceTransactionStats_getLatchTime(stats));
+  complete->on_complete(latch_time, std::move(release_fence));
+}
+
+}  // namespace
+
+std::unique_ptr<SurfaceControlSwapchainDelegate>
+SurfaceControlSwapchainDelegate::Create(
+    fml::RefPtr<AndroidNativeWindow> window) {
+  if (!window || !window->IsValid() ||
+      !NDKHelpers::SurfaceControlAndTransactionSupported()) {
+    return nullptr;
+  }
+  ASurfaceControl* surface_control =
+      NDKHelpers::ASurfaceControl_createFromWindow(window->handle(),
+                                                   "FlutterSurface");
+  if (!surface_control) {
+    FML_LOG(ERROR) << "Could not create a surface control for the window.";
+    return nullptr;
+  }
+  return std::unique_ptr<SurfaceControlSwapchainDelegate>(
+      new SurfaceControlSwapchainDelegate(
+          std::move(window),
+          std::shared_ptr<ASurfaceControl>(
+              surface_control, NDKHelpers::ASurfaceControl_release)));
+}
+
+SurfaceControlSwapchainDelegate::SurfaceControlSwapchainDelegate(
+    fml::RefPtr<AndroidNativeWindow> window,
+    std::shared_ptr<ASurfaceControl> surface_control)
+    : window_(std::move(window)),
+      surface_control_(std::move(surface_control)) {}
+
+SurfaceControlSwapchainDelegate::~SurfaceControlSwapchainDelegate() {
+  // Releasing the surface control doesn't take it off screen, detach it from
+  // the window first.
+  ASurfaceTransaction* transaction = NDKHelpers::ASurfaceTransaction_create();
+  NDKHelpers::ASurfaceTransaction_reparent(transaction, surface_control_.get(),
+                                           nullptr);
+  NDKHelpers::ASurfaceTransaction_apply(transaction);
+  NDKHelpers::ASurfaceTransaction_delete(transaction);
+}
+
+impeller::ISize SurfaceControlSwapchainDelegate::GetSize() const {
+  const SkISize size = window_->GetSize();
+  return impeller::ISize(size.width(), size.height());
+}
+
+AHardwareBuffer* SurfaceControlSwapchainDelegate::AllocateBuffer(
+    const impeller::ISize& size,
+    AHardwareBuffer_Desc* desc) {
+  *desc = {};
+  desc->width = size.width;
+  desc->height = size.height;
+  desc->layers = 1;
+  desc->format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  desc->usage = AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT |
+                AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+                AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+  AHardwareBuffer* buffer = nullptr;
+  if (NDKHelpers::AHardwareBuffer_allocate(desc, &buffer) != 0) {
+    FML_LOG(ERROR) << "Could not allocate a " << size.width << "x"
+                   << size.height << " hardware buffer.";
+    return nullptr;
+  }
+  return buffer;
+}
+
+void SurfaceControlSwapchainDelegate::ReleaseBuffer(AHardwareBuffer* buffer) {
+  if (buffer) {
+    NDKHelpers::AHardwareBuffer_release(buffer);
+  }
+}
+
+bool SurfaceControlSwapchainDelegate::PresentBuffer(
+    AHardwareBuffer* buffer,
+    fml::UniqueFD acquire_fence,
+    impeller::AHBSwapchainVK::PresentCompleteCallback on_complete) {
+  TRACE_EVENT0("flutter", "SurfaceControlSwapchainDelegate::PresentBuffer");
+  ASurfaceTransaction* transaction = NDKHelpers::ASurfaceTransaction_create();
+  if (!transaction) {
+    return false;
+  }
+  // The transaction takes ownership of the fence.
+  NDKHelpers::ASurfaceTransaction_setBuffer(transaction,
+                                            surface_control_.get(), buffer,
+                                            acquire_fence.release());
+  NDKHelpers::ASurfaceTransaction_setOnComplete(
+      transaction,
+      new PresentCompleteContext{surface_control_, std::move(on_complete)},
+      OnTransactionComplete);
+  NDKHelpers::ASurfaceTransaction_apply(transaction);
+  NDKHelpers::ASurfaceTransaction_delete(transaction);
+  return true;
+}
+
+}  // namespace flutter
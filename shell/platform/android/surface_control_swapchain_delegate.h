@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_SWAPCHAIN_DELEGATE_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_SWAPCHAIN_DELEGATE_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/impeller/renderer/backend/vulkan/ahb_swapchain_vk.h"
+#include "flutter/shell/platform/android/ndk_helpers.h"
+#include "flutter/shell/platform/android/surface/android_native_window.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Presents the buffers of an |impeller::AHBSwapchainVK| to a
+///             child surface of the window, one `ASurfaceTransaction` per
+///             frame.
+///
+///             Only available from API 29, see
+///             |NDKHelpers::SurfaceControlAndTransactionSupported|.
+///
+class SurfaceControlSwapchainDelegate final
+    : public impeller::AHBSwapchainVK::Delegate {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface control for the window. Returns nullptr if
+  ///             surface controls are not supported or the window is invalid.
+  ///
+  static std::unique_ptr<SurfaceControlSwapchainDelegate> Create(
+      fml::RefPtr<AndroidNativeWindow> window);
+
+  ~SurfaceControlSwapchainDelegate() override;
+
+  // |AHBSwapchainVK::Delegate|
+  impeller::ISize GetSize() const override;
+
+  // |AHBSwapchainVK::Delegate|
+  AHardwareBuffer* AllocateBuffer(const impeller::ISize& size,
+                                  AHardwareBuffer_Desc* desc) override;
+
+  // |AHBSwapchainVK::Delegate|
+  void ReleaseBuffer(AHardwareBuffer* buffer) override;
+
+  // |AHBSwapchainVK::Delegate|
+  bool PresentBuffer(
+      AHardwareBuffer* buffer,
+      fml::UniqueFD acquire_fence,
+      impeller::AHBSwapchainVK::PresentCompleteCallback on_complete) override;
+
+ private:
+  fml::RefPtr<AndroidNativeWindow> window_;
+  // Shared with the transactions in flight, which query it once applied.
+  std::shared_ptr<ASurfaceControl> surface_control_;
+
+  SurfaceControlSwapchainDelegate(
+      fml::RefPtr<AndroidNativeWindow> window,
+      std::shared_ptr<ASurfaceControl> surface_control);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceControlSwapchainDelegate);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_SWAPCHAIN_DELEGATE_H_
@@ -1,6 +1,8 @@
 package io.flutter.embedding.engine;
 
 import static org.junit.Assert.assertEquals;
+import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.spy;
 import static org.mockito.Mockito.times;
@@ -20,10 +22,13 @@ import io.flutter.embedding.engine.systemchannels.LocalizationChannel;
 import io.flutter.plugin.localization.LocalizationPlugin;
 import io.flutter.plugin.platform.PlatformViewsController;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Locale;
 import java.util.concurrent.atomic.AtomicInteger;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.ArgumentCaptor;
+import org.mockito.InOrder;
 import org.robolectric.annotation.Config;
 
 @Config(manifest = Config.NONE)
@@ -226,6 +231,54 @@ public class FlutterJNITest {
     verify(platformViewsController, times(1)).onEndFrame();
   }
 
+  @Test
+  public void onPlatformViewCommands_callsPlatformViewsControllerInOrder() {
+    PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
+
+    // --- Test Setup ---
+    FlutterJNI flutterJNI = new FlutterJNI();
+    flutterJNI.setPlatformViewsController(platformViewsController);
+    ByteBuffer commands = ByteBuffer.allocateDirect(256).order(ByteOrder.nativeOrder());
+    commands.putInt(0); // Begin frame.
+    commands.putInt(1); // Display platform view.
+    commands.putInt(1).putInt(10).putInt(20).putInt(100).putInt(200).putInt(100).putInt(200);
+    commands.putInt(2); // Two mutators.
+    commands.putInt(0); // Transform.
+    for (float value : new float[] {1, 0, 5, 0, 1, 6, 0, 0, 1}) {
+      commands.putFloat(value);
+    }
+    commands.putInt(1); // Clip rect.
+    commands.putInt(0).putInt(0).putInt(50).putInt(60);
+    commands.putInt(2); // Display overlay surface.
+    commands.putInt(3).putInt(10).putInt(20).putInt(30).putInt(40);
+    commands.putInt(3); // End frame.
+    commands.flip();
+
+    // --- Execute Test ---
+    flutterJNI.onPlatformViewCommands(commands);
+
+    // --- Verify Results ---
+    ArgumentCaptor<FlutterMutatorsStack> stack =
+        ArgumentCaptor.forClass(FlutterMutatorsStack.class);
+    InOrder inOrder = inOrder(platformViewsController);
+    inOrder.verify(platformViewsController).onBeginFrame();
+    inOrder
+        .verify(platformViewsController)
+        .onDisplayPlatformView(
+            eq(1), eq(10), eq(20), eq(100), eq(200), eq(100), eq(200), stack.capture());
+    inOrder
+        .verify(platformViewsController)
+        .onDisplayOverlaySurface(/*id=*/ 3, /*x=*/ 10, /*y=*/ 20, /*width=*/ 30, /*height=*/ 40);
+    inOrder.verify(platformViewsController).onEndFrame();
+    assertEquals(2, stack.getValue().getMutators().size());
+    assertEquals(
+        FlutterMutatorsStack.FlutterMutatorType.TRANSFORM,
+        stack.getValue().getMutators().get(0).getType());
+    assertEquals(
+        FlutterMutatorsStack.FlutterMutatorType.CLIP_RECT,
+        stack.getValue().getMutators().get(1).getType());
+  }
+
   @Test
   public void createOverlaySurface_callsPlatformViewsController() {
     PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
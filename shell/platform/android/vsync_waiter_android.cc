@@ -24,13 +24,21 @@ static std::atomic_uint g_refresh_rate_ = 60;
 VsyncWaiterAndroid::VsyncWaiterAndroid(const flutter::TaskRunners& task_runners)
     : VsyncWaiter(task_runners),
       use_ndk_choreographer_(
-          AndroidChoreographer::ShouldUseNDKChoreographer()) {}
+          AndroidChoreographer::ShouldUseNDKChoreographer()),
+      use_vsync_callback_(AndroidChoreographer::ShouldUseVsyncCallback()) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
-  if (use_ndk_choreographer_) {
+  if (use_vsync_callback_) {
+    auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [weak_this]() {
+          AndroidChoreographer::PostVsyncCallback(&OnVsyncCallbackFromNDK,
+                                                  weak_this);
+        });
+  } else if (use_ndk_choreographer_) {
     auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
     fml::TaskRunner::RunNowOrPostTask(
         task_runners_.GetUITaskRunner(), [weak_this]() {
@@ -70,6 +78,55 @@ void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   ConsumePendingCallback(weak_this, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnVsyncCallbackFromNDK(
+    const AndroidChoreographer::VsyncData& vsync_data,
+    void* data) {
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(vsync_data.frame_time_nanos));
+  auto now = fml::TimePoint::Now();
+  if (frame_time > now) {
+    frame_time = now;
+  }
+  const auto& timelines = vsync_data.timelines;
+  if (timelines.empty() ||
+      vsync_data.preferred_timeline_index >= timelines.size()) {
+    auto target_time = frame_time + fml::TimeDelta::FromNanoseconds(
+                                        1000000000.0 / g_refresh_rate_);
+    ConsumePendingCallback(weak_this, frame_time, target_time);
+    return;
+  }
+
+  // The preferred timeline assumes the frame takes as long as the last ones.
+  // If its deadline leaves less than a refresh period from now, the frame is
+  // unlikely to make it, so pick the first later timeline that leaves a full
+  // period instead of missing the deadline and dropping a frame.
+  const auto refresh_period =
+      fml::TimeDelta::FromNanoseconds(1000000000.0 / g_refresh_rate_);
+  auto deadline = [&timelines](size_t index) {
+    return fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromNanoseconds(timelines[index].deadline_nanos));
+  };
+  size_t index = vsync_data.preferred_timeline_index;
+  while (index + 1 < timelines.size() &&
+         deadline(index) - now < refresh_period) {
+    index++;
+  }
+  auto target_time = deadline(index);
+  auto expected_present_time =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
+          timelines[index].expected_present_time_nanos));
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   target_time.ToEpochDelta().ToMicroseconds());
+
+  ConsumePendingCallback(weak_this, frame_time, target_time,
+                         expected_present_time);
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
                                          jclass jcaller,
@@ -94,12 +151,15 @@ void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
 void VsyncWaiterAndroid::ConsumePendingCallback(
     std::weak_ptr<VsyncWaiter>* weak_this,
     fml::TimePoint frame_start_time,
-    fml::TimePoint frame_target_time) {
+    fml::TimePoint frame_target_time,
+    std::optional<fml::TimePoint> expected_present_time) {
   auto shared_this = weak_this->lock();
   delete weak_this;
 
   if (shared_this) {
-    shared_this->FireCallback(frame_start_time, frame_target_time);
+    shared_this->FireCallback(frame_start_time, frame_target_time,
+                              /*pause_secondary_tasks=*/true,
+                              expected_present_time);
   }
 }
 
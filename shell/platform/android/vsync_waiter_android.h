@@ -8,14 +8,14 @@
 #include <jni.h>
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/platform/android/android_choreographer.h"
 
 namespace flutter {
 
-class AndroidChoreographer;
-
 class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
@@ -30,21 +30,28 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
 
   static void OnVsyncFromNDK(int64_t frame_nanos, void* data);
 
+  static void OnVsyncCallbackFromNDK(
+      const AndroidChoreographer::VsyncData& vsync_data,
+      void* data);
+
   static void OnVsyncFromJava(JNIEnv* env,
                               jclass jcaller,
                               jlong frameDelayNanos,
                               jlong refreshPeriodNanos,
                               jlong java_baton);
 
-  static void ConsumePendingCallback(std::weak_ptr<VsyncWaiter>* weak_this,
-                                     fml::TimePoint frame_start_time,
-                                     fml::TimePoint frame_target_time);
+  static void ConsumePendingCallback(
+      std::weak_ptr<VsyncWaiter>* weak_this,
+      fml::TimePoint frame_start_time,
+      fml::TimePoint frame_target_time,
+      std::optional<fml::TimePoint> expected_present_time = std::nullopt);
 
   static void OnUpdateRefreshRate(JNIEnv* env,
                                   jclass jcaller,
                                   jfloat refresh_rate);
 
   const bool use_ndk_choreographer_;
+  const bool use_vsync_callback_;
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterAndroid);
 };
 
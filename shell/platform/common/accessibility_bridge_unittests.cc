@@ -14,6 +14,7 @@ namespace flutter {
 namespace testing {
 
 using ::testing::Contains;
+using ::testing::Not;
 
 FlutterSemanticsNode2 CreateSemanticsNode(
     int32_t id,
@@ -205,6 +206,61 @@ TEST(AccessibilityBridgeTest, CanFireChildrenChangedCorrectly) {
               Contains(ui::AXEventGenerator::Event::SUBTREE_CREATED));
 }
 
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodesAndReaddsRemovedOnes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  // Sending the same nodes again, with one of them changed, only updates the
+  // changed node.
+  FlutterSemanticsNode2 new_child2 = CreateSemanticsNode(2, "new child 2");
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(new_child2);
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(root_node->GetChildCount(), 2);
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+  EXPECT_EQ(child2_node->GetName(), "new child 2");
+  std::set<ui::AXEventGenerator::Event> actual_event{
+      bridge->accessibility_events.begin(), bridge->accessibility_events.end()};
+  EXPECT_THAT(actual_event,
+              Contains(ui::AXEventGenerator::Event::NAME_CHANGED));
+  EXPECT_THAT(actual_event,
+              Not(Contains(ui::AXEventGenerator::Event::CHILDREN_CHANGED)));
+
+  // Remove the first child, then add it back unchanged.
+  std::vector<int32_t> remaining_children{2};
+  FlutterSemanticsNode2 root_without_child1 =
+      CreateSemanticsNode(0, "root", &remaining_children);
+  bridge->AddFlutterSemanticsNodeUpdate(root_without_child1);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(1).expired());
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  ASSERT_TRUE(child1_node);
+  EXPECT_EQ(root_node->GetChildCount(), 2);
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+}
+
 TEST(AccessibilityBridgeTest, CanHandleSelectionChangeCorrectly) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
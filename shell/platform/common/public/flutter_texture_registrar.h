@@ -83,6 +83,16 @@ typedef struct {
   // |FlutterDesktopGpuSurfaceTextureCallback| and registering a
   // |release_callback| for decrementing the reference count once it has been
   // opened.
+  //
+  // Flutter keeps recently used surfaces opened, so a pool of surfaces can be
+  // cycled through without opening them again. A handle must therefore not be
+  // reused for a different resource while the texture is registered.
+  //
+  // If the resource has a keyed mutex, Flutter acquires it with key 0 before
+  // sampling the surface and releases it with key 0 once it samples a
+  // different surface. A producer using keyed mutexes should therefore cycle
+  // through at least two surfaces. NV12 and P010 resources are converted to
+  // RGB on the GPU, and their keyed mutex is released right away.
   void* handle;
   // The physical width.
   size_t width;
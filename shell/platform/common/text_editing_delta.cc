@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/common/text_editing_delta.h"
 
+#include <utility>
+
 #include "flutter/fml/string_conversion.h"
 
 namespace flutter {
@@ -11,25 +13,28 @@ namespace flutter {
 TextEditingDelta::TextEditingDelta(const std::u16string& text_before_change,
                                    const TextRange& range,
                                    const std::u16string& text)
-    : old_text_(text_before_change),
-      delta_text_(text),
+    : old_text_(fml::Utf16ToUtf8(text_before_change)),
+      delta_text_(fml::Utf16ToUtf8(text)),
       delta_start_(range.start()),
       delta_end_(range.start() + range.length()) {}
 
-TextEditingDelta::TextEditingDelta(const std::string& text_before_change,
+TextEditingDelta::TextEditingDelta(std::string text_before_change,
                                    const TextRange& range,
-                                   const std::string& text)
-    : old_text_(fml::Utf8ToUtf16(text_before_change)),
-      delta_text_(fml::Utf8ToUtf16(text)),
+                                   std::string text)
+    : old_text_(std::move(text_before_change)),
+      delta_text_(std::move(text)),
       delta_start_(range.start()),
       delta_end_(range.start() + range.length()) {}
 
 TextEditingDelta::TextEditingDelta(const std::u16string& text)
-    : old_text_(text), delta_text_(u""), delta_start_(-1), delta_end_(-1) {}
+    : old_text_(fml::Utf16ToUtf8(text)),
+      delta_text_(""),
+      delta_start_(-1),
+      delta_end_(-1) {}
 
-TextEditingDelta::TextEditingDelta(const std::string& text)
-    : old_text_(fml::Utf8ToUtf16(text)),
-      delta_text_(u""),
+TextEditingDelta::TextEditingDelta(std::string text)
+    : old_text_(std::move(text)),
+      delta_text_(""),
       delta_start_(-1),
       delta_end_(-1) {}
 
@@ -18,25 +18,25 @@ struct TextEditingDelta {
                    const TextRange& range,
                    const std::u16string& text);
 
-  TextEditingDelta(const std::string& text_before_change,
+  TextEditingDelta(std::string text_before_change,
                    const TextRange& range,
-                   const std::string& text);
+                   std::string text);
 
   explicit TextEditingDelta(const std::u16string& text);
 
-  explicit TextEditingDelta(const std::string& text);
+  explicit TextEditingDelta(std::string text);
 
   virtual ~TextEditingDelta() = default;
 
   /// Get the old_text_ value.
   ///
-  /// All strings are stored as UTF16 but converted to UTF8 when accessed.
-  std::string old_text() const { return fml::Utf16ToUtf8(old_text_); }
+  /// All strings are stored as UTF8, the encoding they are sent to the
+  /// framework in, so that the whole old text isn't converted for every
+  /// keystroke. UTF16 arguments are converted once on construction.
+  std::string old_text() const { return old_text_; }
 
   /// Get the delta_text value.
-  ///
-  /// All strings are stored as UTF16 but converted to UTF8 when accessed.
-  std::string delta_text() const { return fml::Utf16ToUtf8(delta_text_); }
+  std::string delta_text() const { return delta_text_; }
 
   /// Get the delta_start_ value.
   int delta_start() const { return delta_start_; }
@@ -56,14 +56,14 @@ struct TextEditingDelta {
   TextEditingDelta& operator=(const TextEditingDelta& other) = default;
 
  private:
-  std::u16string old_text_;
-  std::u16string delta_text_;
+  std::string old_text_;
+  std::string delta_text_;
   int delta_start_;
   int delta_end_;
 
-  void set_old_text(const std::u16string& old_text) { old_text_ = old_text; }
+  void set_old_text(const std::string& old_text) { old_text_ = old_text; }
 
-  void set_delta_text(const std::u16string& delta_text) {
+  void set_delta_text(const std::string& delta_text) {
     delta_text_ = delta_text;
   }
 
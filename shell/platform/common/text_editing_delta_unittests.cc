@@ -34,4 +34,15 @@ TEST(TextEditingDeltaTest, TestTextEditingDeltaNonTextConstructor) {
   EXPECT_EQ(delta.delta_end(), -1);
 }
 
+TEST(TextEditingDeltaTest, TestTextEditingDeltaUtf16Constructor) {
+  // Here we are simulating inserting a "ö" at the end of "héll".
+  TextEditingDelta delta =
+      TextEditingDelta(u"h\u00e9ll", TextRange(4), u"\u00f6");
+
+  EXPECT_EQ(delta.old_text(), "h\u00e9ll");
+  EXPECT_EQ(delta.delta_text(), "\u00f6");
+  EXPECT_EQ(delta.delta_start(), 4);
+  EXPECT_EQ(delta.delta_end(), 4);
+}
+
 }  // namespace flutter
@@ -15,10 +15,15 @@ namespace flutter {
 
 fml::MallocMapping CopyNSDataToMapping(NSData* data);
 
+// Wraps the buffer without copying it. The returned NSData frees it.
 NSData* ConvertMappingToNSData(fml::MallocMapping buffer);
 
+// Wraps the data without copying it. The returned mapping retains it.
 std::unique_ptr<fml::Mapping> ConvertNSDataToMappingPtr(NSData* data);
 
+// Wraps the mapping without copying it. The returned NSData owns it.
+NSData* ConvertMappingPtrToNSData(std::unique_ptr<fml::Mapping> mapping);
+
 NSData* CopyMappingPtrToNSData(std::unique_ptr<fml::Mapping> mapping);
 
 }  // namespace flutter
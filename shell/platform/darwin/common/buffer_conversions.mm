@@ -41,6 +41,20 @@ std::unique_ptr<fml::Mapping> ConvertNSDataToMappingPtr(NSData* data) {
   return std::make_unique<NSDataMapping>(data);
 }
 
+NSData* ConvertMappingPtrToNSData(std::unique_ptr<fml::Mapping> mapping) {
+  if (!mapping || mapping->GetSize() == 0) {
+    return [NSData data];
+  }
+  void* bytes = const_cast<uint8_t*>(mapping->GetMapping());
+  size_t size = mapping->GetSize();
+  fml::Mapping* owned_mapping = mapping.release();
+  return [[[NSData alloc] initWithBytesNoCopy:bytes
+                                       length:size
+                                  deallocator:^(void* bytes, NSUInteger length) {
+                                    delete owned_mapping;
+                                  }] autorelease];
+}
+
 NSData* CopyMappingPtrToNSData(std::unique_ptr<fml::Mapping> mapping) {
   return [NSData dataWithBytes:mapping->GetMapping() length:mapping->GetSize()];
 }
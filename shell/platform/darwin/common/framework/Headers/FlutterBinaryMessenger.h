@@ -50,6 +50,13 @@ FLUTTER_DARWIN_EXPORT
 @optional
 - (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue;
 
+/**
+ * Like `makeBackgroundTaskQueue`, but handlers on the returned queue may run
+ * concurrently with each other, so messages on its channels are not
+ * necessarily handled in the order they were sent.
+ */
+- (NSObject<FlutterTaskQueue>*)makeConcurrentBackgroundTaskQueue;
+
 - (FlutterBinaryMessengerConnection)
     setMessageHandlerOnChannel:(NSString*)channel
           binaryMessageHandler:(FlutterBinaryMessageHandler _Nullable)handler
@@ -45,6 +45,14 @@ FLUTTER_ASSERT_ARC
   };
 }
 
+- (NSObject<FlutterTaskQueue>*)makeConcurrentBackgroundTaskQueue {
+  if ([self.parent respondsToSelector:@selector(makeConcurrentBackgroundTaskQueue)]) {
+    return [self.parent makeConcurrentBackgroundTaskQueue];
+  } else {
+    return nil;
+  };
+}
+
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
                                           binaryMessageHandler:
                                               (FlutterBinaryMessageHandler)handler {
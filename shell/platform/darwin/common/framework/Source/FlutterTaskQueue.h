@@ -0,0 +1,26 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_PLATFORM_DARWIN_COMMON_FRAMEWORK_SOURCE_FLUTTERTASKQUEUE_H_
+#define SHELL_PLATFORM_DARWIN_COMMON_FRAMEWORK_SOURCE_FLUTTERTASKQUEUE_H_
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol FlutterTaskQueue
+- (void)dispatch:(dispatch_block_t)block;
+@end
+
+// Runs the dispatched blocks one at a time, in order, off the main thread.
+@interface FLTSerialTaskQueue : NSObject <FlutterTaskQueue>
+@end
+
+// Runs the dispatched blocks off the main thread, several at a time.
+@interface FLTConcurrentTaskQueue : NSObject <FlutterTaskQueue>
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif  // SHELL_PLATFORM_DARWIN_COMMON_FRAMEWORK_SOURCE_FLUTTERTASKQUEUE_H_
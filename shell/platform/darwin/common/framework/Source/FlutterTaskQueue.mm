@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/common/framework/Source/FlutterTaskQueue.h"
+
+#import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
+
+FLUTTER_ASSERT_ARC
+
+@implementation FLTSerialTaskQueue {
+  dispatch_queue_t _queue;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _queue = dispatch_queue_create("FLTSerialTaskQueue", DISPATCH_QUEUE_SERIAL);
+  }
+  return self;
+}
+
+- (void)dispatch:(dispatch_block_t)block {
+  dispatch_async(_queue, block);
+}
+@end
+
+@implementation FLTConcurrentTaskQueue {
+  dispatch_queue_t _queue;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _queue = dispatch_queue_create("FLTConcurrentTaskQueue", DISPATCH_QUEUE_CONCURRENT);
+  }
+  return self;
+}
+
+- (void)dispatch:(dispatch_block_t)block {
+  dispatch_async(_queue, block);
+}
+@end
@@ -212,8 +212,9 @@ FLUTTER_ASSERT_ARC
             ? impeller::YUVColorSpace::kBT601LimitedRange
             : impeller::YUVColorSpace::kBT601FullRange;
 
-    return impeller::DlImageImpeller::MakeFromYUVTextures(context.aiks_context, yTexture, uvTexture,
-                                                          yuvColorSpace);
+    // The planes are converted to RGB as they are drawn, saving a full size render pass per frame.
+    return impeller::DlImageImpeller::MakeYUV(context.aiks_context, yTexture, uvTexture,
+                                              yuvColorSpace);
   }
 
   SkYUVColorSpace colorSpace = _pixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange
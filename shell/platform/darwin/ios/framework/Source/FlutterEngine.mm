@@ -1260,6 +1260,10 @@ static void SetEntryPoint(flutter::Settings* settings, NSString* entrypoint, NSS
   return flutter::PlatformMessageHandlerIos::MakeBackgroundTaskQueue();
 }
 
+- (NSObject<FlutterTaskQueue>*)makeConcurrentBackgroundTaskQueue {
+  return flutter::PlatformMessageHandlerIos::MakeConcurrentBackgroundTaskQueue();
+}
+
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
                                           binaryMessageHandler:
                                               (FlutterBinaryMessageHandler)handler {
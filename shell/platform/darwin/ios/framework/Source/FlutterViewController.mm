@@ -2287,6 +2287,10 @@ static flutter::PointerData::DeviceKind DeviceKindFromTouchType(UITouch* touch)
   return [_engine.get().binaryMessenger makeBackgroundTaskQueue];
 }
 
+- (NSObject<FlutterTaskQueue>*)makeConcurrentBackgroundTaskQueue {
+  return [_engine.get().binaryMessenger makeConcurrentBackgroundTaskQueue];
+}
+
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(NSString*)channel
                                           binaryMessageHandler:
                                               (FlutterBinaryMessageHandler)handler {
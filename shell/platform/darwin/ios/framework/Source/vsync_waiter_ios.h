@@ -60,6 +60,12 @@
 
 - (void)setMaxRefreshRate:(double)refreshRate;
 
+//------------------------------------------------------------------------------
+/// @brief      The frame rate the display link should preferably run at, within the range allowed
+///             by the max refresh rate. 0 prefers the max refresh rate.
+///
+- (void)setPreferredFrameRate:(double)frameRate;
+
 @end
 
 namespace flutter {
@@ -80,6 +86,9 @@ class VsyncWaiterIOS final : public VsyncWaiter, public VariableRefreshRateRepor
   // Made public for testing.
   void AwaitVSync() override;
 
+  // |VsyncWaiter|
+  void SetPreferredFrameRate(double frame_rate) override;
+
  private:
   fml::scoped_nsobject<VSyncClient> client_;
   double max_refresh_rate_;
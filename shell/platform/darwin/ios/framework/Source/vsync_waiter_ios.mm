@@ -62,6 +62,10 @@ void VsyncWaiterIOS::AwaitVSync() {
   [client_.get() await];
 }
 
+void VsyncWaiterIOS::SetPreferredFrameRate(double frame_rate) {
+  [client_.get() setPreferredFrameRate:frame_rate];
+}
+
 // |VariableRefreshRateReporter|
 double VsyncWaiterIOS::GetRefreshRate() const {
   return [client_.get() getRefreshRate];
@@ -77,6 +81,8 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   flutter::VsyncWaiter::Callback callback_;
   fml::scoped_nsobject<CADisplayLink> display_link_;
   double current_refresh_rate_;
+  double max_refresh_rate_;
+  double preferred_frame_rate_;
 }
 
 - (instancetype)initWithTaskRunner:(fml::RefPtr<fml::TaskRunner>)task_runner
@@ -105,16 +111,33 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
 }
 
 - (void)setMaxRefreshRate:(double)refreshRate {
+  max_refresh_rate_ = refreshRate;
+  [self updateFrameRateRange];
+}
+
+- (void)setPreferredFrameRate:(double)frameRate {
+  preferred_frame_rate_ = frameRate;
+  [self updateFrameRateRange];
+}
+
+- (void)updateFrameRateRange {
   if (!DisplayLinkManager.maxRefreshRateEnabledOnIPhone) {
     return;
   }
-  double maxFrameRate = fmax(refreshRate, 60);
+  double maxFrameRate = fmax(max_refresh_rate_, 60);
   double minFrameRate = fmax(maxFrameRate / 2, 60);
+  double preferredFrameRate = maxFrameRate;
+  if (preferred_frame_rate_ > 0) {
+    // Content that changes less often, such as a 30fps video, lets the display slow down below
+    // the usual minimum.
+    preferredFrameRate = fmin(preferred_frame_rate_, maxFrameRate);
+    minFrameRate = fmin(minFrameRate, preferredFrameRate);
+  }
   if (@available(iOS 15.0, *)) {
     display_link_.get().preferredFrameRateRange =
-        CAFrameRateRangeMake(minFrameRate, maxFrameRate, maxFrameRate);
+        CAFrameRateRangeMake(minFrameRate, maxFrameRate, preferredFrameRate);
   } else {
-    display_link_.get().preferredFramesPerSecond = maxFrameRate;
+    display_link_.get().preferredFramesPerSecond = round(preferredFrameRate);
   }
 }
 
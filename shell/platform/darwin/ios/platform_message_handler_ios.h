@@ -12,10 +12,7 @@
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #include "flutter/shell/common/platform_message_handler.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterBinaryMessenger.h"
-
-@protocol FlutterTaskQueue
-- (void)dispatch:(dispatch_block_t)block;
-@end
+#import "flutter/shell/platform/darwin/common/framework/Source/FlutterTaskQueue.h"
 
 namespace flutter {
 
@@ -23,6 +20,8 @@ class PlatformMessageHandlerIos : public PlatformMessageHandler {
  public:
   static NSObject<FlutterTaskQueue>* MakeBackgroundTaskQueue();
 
+  static NSObject<FlutterTaskQueue>* MakeConcurrentBackgroundTaskQueue();
+
   PlatformMessageHandlerIos(fml::RefPtr<fml::TaskRunner> platform_task_runner);
 
   void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) override;
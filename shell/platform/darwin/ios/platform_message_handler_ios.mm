@@ -11,35 +11,16 @@
 
 static uint64_t platform_message_counter = 1;
 
-@interface FLTSerialTaskQueue : NSObject <FlutterTaskQueue>
-@property(nonatomic, strong) dispatch_queue_t queue;
-@end
-
-@implementation FLTSerialTaskQueue
-- (instancetype)init {
-  self = [super init];
-  if (self) {
-    _queue = dispatch_queue_create("FLTSerialTaskQueue", DISPATCH_QUEUE_SERIAL);
-  }
-  return self;
-}
-
-- (void)dealloc {
-  dispatch_release(_queue);
-  [super dealloc];
-}
-
-- (void)dispatch:(dispatch_block_t)block {
-  dispatch_async(self.queue, block);
-}
-@end
-
 namespace flutter {
 
 NSObject<FlutterTaskQueue>* PlatformMessageHandlerIos::MakeBackgroundTaskQueue() {
   return [[[FLTSerialTaskQueue alloc] init] autorelease];
 }
 
+NSObject<FlutterTaskQueue>* PlatformMessageHandlerIos::MakeConcurrentBackgroundTaskQueue() {
+  return [[[FLTConcurrentTaskQueue alloc] init] autorelease];
+}
+
 PlatformMessageHandlerIos::PlatformMessageHandlerIos(
     fml::RefPtr<fml::TaskRunner> platform_task_runner)
     : platform_task_runner_(std::move(platform_task_runner)) {}
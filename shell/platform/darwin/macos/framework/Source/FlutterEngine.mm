@@ -14,6 +14,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 
 #import "flutter/shell/platform/darwin/common/framework/Source/FlutterBinaryMessengerRelay.h"
+#import "flutter/shell/platform/darwin/common/framework/Source/FlutterTaskQueue.h"
 #import "flutter/shell/platform/darwin/macos/framework/Headers/FlutterAppDelegate.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterAppDelegate_Internal.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterCompositor.h"
@@ -60,20 +61,25 @@ constexpr char kTextPlainFormat[] = "text/plain";
 @interface FlutterEngineHandlerInfo : NSObject
 
 - (instancetype)initWithConnection:(NSNumber*)connection
-                           handler:(FlutterBinaryMessageHandler)handler;
+                           handler:(FlutterBinaryMessageHandler)handler
+                         taskQueue:(nullable NSObject<FlutterTaskQueue>*)taskQueue;
 
 @property(nonatomic, readonly) FlutterBinaryMessageHandler handler;
 @property(nonatomic, readonly) NSNumber* connection;
+// Runs the handler instead of the main thread if set.
+@property(nonatomic, readonly, nullable) NSObject<FlutterTaskQueue>* taskQueue;
 
 @end
 
 @implementation FlutterEngineHandlerInfo
 - (instancetype)initWithConnection:(NSNumber*)connection
-                           handler:(FlutterBinaryMessageHandler)handler {
+                           handler:(FlutterBinaryMessageHandler)handler
+                         taskQueue:(nullable NSObject<FlutterTaskQueue>*)taskQueue {
   self = [super init];
   NSAssert(self, @"Super init cannot be nil");
   _connection = connection;
   _handler = handler;
+  _taskQueue = taskQueue;
   return self;
 }
 @end
@@ -964,13 +970,19 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 }
 
 - (void)engineCallbackOnPlatformMessage:(const FlutterPlatformMessage*)message {
+  NSString* channel = @(message->channel);
+  FlutterEngineHandlerInfo* handlerInfo = _messengerHandlers[channel];
   NSData* messageData = nil;
   if (message->message_size > 0) {
-    messageData = [NSData dataWithBytesNoCopy:(void*)message->message
-                                       length:message->message_size
-                                 freeWhenDone:NO];
+    if (handlerInfo.taskQueue) {
+      // The message is only valid during this call.
+      messageData = [NSData dataWithBytes:message->message length:message->message_size];
+    } else {
+      messageData = [NSData dataWithBytesNoCopy:(void*)message->message
+                                         length:message->message_size
+                                   freeWhenDone:NO];
+    }
   }
-  NSString* channel = @(message->channel);
   __block const FlutterPlatformMessageResponseHandle* responseHandle = message->response_handle;
   __block FlutterEngine* weakSelf = self;
   NSMutableArray* isResponseValid = self.isResponseValid;
@@ -994,8 +1006,12 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     }
   };
 
-  FlutterEngineHandlerInfo* handlerInfo = _messengerHandlers[channel];
-  if (handlerInfo) {
+  if (handlerInfo.taskQueue) {
+    FlutterBinaryMessageHandler handler = handlerInfo.handler;
+    [handlerInfo.taskQueue dispatch:^{
+      handler(messageData, binaryResponseHandler);
+    }];
+  } else if (handlerInfo) {
     handlerInfo.handler(messageData, binaryResponseHandler);
   } else {
     binaryResponseHandler(nil);
@@ -1331,13 +1347,29 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   }
 }
 
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue {
+  return [[FLTSerialTaskQueue alloc] init];
+}
+
+- (NSObject<FlutterTaskQueue>*)makeConcurrentBackgroundTaskQueue {
+  return [[FLTConcurrentTaskQueue alloc] init];
+}
+
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(nonnull NSString*)channel
                                           binaryMessageHandler:
                                               (nullable FlutterBinaryMessageHandler)handler {
+  return [self setMessageHandlerOnChannel:channel binaryMessageHandler:handler taskQueue:nil];
+}
+
+- (FlutterBinaryMessengerConnection)
+    setMessageHandlerOnChannel:(nonnull NSString*)channel
+          binaryMessageHandler:(nullable FlutterBinaryMessageHandler)handler
+                     taskQueue:(nullable NSObject<FlutterTaskQueue>*)taskQueue {
   _currentMessengerConnection += 1;
   _messengerHandlers[channel] =
       [[FlutterEngineHandlerInfo alloc] initWithConnection:@(_currentMessengerConnection)
-                                                   handler:[handler copy]];
+                                                   handler:[handler copy]
+                                                 taskQueue:taskQueue];
   return _currentMessengerConnection;
 }
 
@@ -17,6 +17,7 @@
 #include "flutter/shell/platform/common/accessibility_bridge.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
 #import "flutter/shell/platform/darwin/common/framework/Source/FlutterBinaryMessengerRelay.h"
+#import "flutter/shell/platform/darwin/common/framework/Source/FlutterTaskQueue.h"
 #import "flutter/shell/platform/darwin/macos/framework/Headers/FlutterAppDelegate.h"
 #import "flutter/shell/platform/darwin/macos/framework/Headers/FlutterAppLifecycleDelegate.h"
 #import "flutter/shell/platform/darwin/macos/framework/Headers/FlutterPluginMacOS.h"
@@ -799,6 +800,53 @@ TEST_F(FlutterEngineTest, ResponseFromBackgroundThread) {
   }
 }
 
+TEST_F(FlutterEngineTest, HandlesMessagesOnBackgroundTaskQueue) {
+  FlutterEngine* engine = GetFlutterEngine();
+  EXPECT_TRUE([engine runWithEntrypoint:@"main"]);
+
+  // Act as if the framework has sent the message back on the channel named by
+  // the message.
+  engine.embedderAPI.SendPlatformMessage = MOCK_ENGINE_PROC(
+      SendPlatformMessage, ([](auto engine_, auto message_) {
+        if (strcmp(message_->channel, "test/send_message") == 0) {
+          std::string message = R"|({"method": "a"})|";
+          std::string channel(reinterpret_cast<const char*>(message_->message),
+                              message_->message_size);
+          reinterpret_cast<EmbedderEngine*>(engine_)
+              ->GetShell()
+              .GetPlatformView()
+              ->HandlePlatformMessage(std::make_unique<PlatformMessage>(
+                  channel.c_str(), fml::MallocMapping::Copy(message.c_str(), message.length()),
+                  fml::RefPtr<PlatformMessageResponse>()));
+        }
+        return kSuccess;
+      }));
+
+  NSObject<FlutterTaskQueue>* taskQueue = [engine.binaryMessenger makeBackgroundTaskQueue];
+  ASSERT_NE(taskQueue, nil);
+  FlutterMethodChannel* channel =
+      [FlutterMethodChannel methodChannelWithName:@"_test_"
+                                  binaryMessenger:engine.binaryMessenger
+                                            codec:[FlutterJSONMethodCodec sharedInstance]
+                                        taskQueue:taskQueue];
+  __block BOOL didCallHandler = NO;
+  __block BOOL calledOnMainThread = YES;
+  [channel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+    calledOnMainThread = [NSThread isMainThread];
+    EXPECT_TRUE([call.method isEqualToString:@"a"]);
+    dispatch_async(dispatch_get_main_queue(), ^{
+      didCallHandler = YES;
+    });
+  }];
+
+  [engine.binaryMessenger sendOnChannel:@"test/send_message"
+                                message:[@"_test_" dataUsingEncoding:NSUTF8StringEncoding]];
+  while (!didCallHandler) {
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+  }
+  EXPECT_FALSE(calledOnMainThread);
+}
+
 TEST_F(FlutterEngineTest, ThreadSynchronizerNotBlockingRasterThreadAfterShutdown) {
   FlutterThreadSynchronizer* threadSynchronizer = [[FlutterThreadSynchronizer alloc] init];
   [threadSynchronizer shutdown];
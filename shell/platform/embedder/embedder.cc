@@ -5,6 +5,7 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -175,8 +176,15 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  const bool has_present =
+      SAFE_ACCESS(software_config, surface_present_callback, nullptr) !=
+      nullptr;
+  const bool has_present_with_damage =
+      SAFE_ACCESS(software_config, surface_present_with_damage_callback,
+                  nullptr) != nullptr;
+
+  // Only one of these callbacks must exist.
+  if (has_present == has_present_with_damage) {
     return false;
   }
 
@@ -255,7 +263,6 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // FML_OS_LINUX || FML_OS_WIN
 
-#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type SkIRect to
 // FlutterRect.
 static FlutterRect SkIRectToFlutterRect(const SkIRect sk_rect) {
@@ -266,6 +273,7 @@ static FlutterRect SkIRectToFlutterRect(const SkIRect sk_rect) {
   return flutter_rect;
 }
 
+#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type FlutterRect to
 // SkIRect.
 static const SkIRect FlutterRectToSkIRect(FlutterRect flutter_rect) {
@@ -679,21 +687,54 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store;
+  if (auto ptr = SAFE_ACCESS(software_config, surface_present_callback,
+                             nullptr)) {
+    software_present_backing_store =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const void*, size_t, size_t, const SkIRect&)>
+      software_present_backing_store_with_damage;
+  if (auto ptr = SAFE_ACCESS(software_config,
+                             surface_present_with_damage_callback, nullptr)) {
+    software_present_backing_store_with_damage =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height, const SkIRect& damage) -> bool {
+      FlutterRect damage_rect = SkIRectToFlutterRect(damage);
+      FlutterDamage flutter_damage = {
+          .struct_size = sizeof(FlutterDamage),
+          .num_rects = 1,
+          .damage = &damage_rect,
+      };
+      return ptr(user_data, allocation, row_bytes, height, &flutter_damage);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,              // required
+          software_present_backing_store_with_damage,  // optional
+          SAFE_ACCESS(software_config, double_buffered, false),  // optional
       };
 
+  const bool tiled_rasterization =
+      SAFE_ACCESS(software_config, tiled_rasterization, false);
+
   return fml::MakeCopyable(
-      [software_dispatch_table, platform_dispatch_table,
+      [software_dispatch_table, platform_dispatch_table, tiled_rasterization,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        if (tiled_rasterization) {
+          software_dispatch_table.tile_loop =
+              shell.GetDartVM()->GetConcurrentMessageLoop();
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
             shell,                             // delegate
             shell.GetTaskRunners(),            // task runners
@@ -1282,6 +1323,12 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  size_t backing_store_retention_frames =
+      SAFE_ACCESS(compositor, backing_store_retention_frames, 0);
+  size_t backing_store_cache_max_bytes =
+      SAFE_ACCESS(compositor, backing_store_cache_max_bytes, 0);
+  uint32_t backing_store_size_granularity =
+      SAFE_ACCESS(compositor, backing_store_size_granularity, 0);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -1313,7 +1360,9 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
               avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              present_callback, backing_store_retention_frames,
+              backing_store_cache_max_bytes,
+              static_cast<int>(backing_store_size_granularity)),
           false};
 }
 
@@ -1736,6 +1785,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  settings.pin_threads_to_core_classes =
+      SAFE_ACCESS(args, pin_threads_to_core_classes, false);
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -1901,6 +1952,12 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
                               "Compositor arguments were invalid.");
   }
+  std::shared_ptr<const flutter::EmbedderRenderTargetCache::Stats>
+      render_target_cache_stats;
+  if (external_view_embedder_result.first) {
+    render_target_cache_stats =
+        external_view_embedder_result.first->GetRenderTargetCacheStats();
+  }
 
   flutter::PlatformViewEmbedder::PlatformDispatchTable platform_dispatch_table =
       {
@@ -1976,6 +2033,29 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           external_texture_metal_callback);
     }
   }
+#endif
+#ifdef SHELL_ENABLE_VULKAN
+  flutter::EmbedderExternalTextureVulkan::ExternalTextureCallback
+      external_texture_vulkan_callback;
+  if (config->type == kVulkan) {
+    const FlutterVulkanRendererConfig* vulkan_config = &config->vulkan;
+    if (SAFE_ACCESS(vulkan_config, external_texture_frame_callback, nullptr)) {
+      external_texture_vulkan_callback =
+          [ptr = vulkan_config->external_texture_frame_callback, user_data](
+              int64_t texture_identifier, size_t width,
+              size_t height) -> std::unique_ptr<FlutterVulkanExternalTexture> {
+        std::unique_ptr<FlutterVulkanExternalTexture> texture =
+            std::make_unique<FlutterVulkanExternalTexture>();
+        texture->struct_size = sizeof(FlutterVulkanExternalTexture);
+        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
+          return nullptr;
+        }
+        return texture;
+      };
+      external_texture_resolver = std::make_unique<ExternalTextureResolver>(
+          external_texture_vulkan_callback);
+    }
+  }
 #endif
   auto custom_task_runners = SAFE_ACCESS(args, custom_task_runners, nullptr);
   auto thread_config_callback = [&custom_task_runners](
@@ -2003,7 +2083,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   };
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          custom_task_runners, thread_config_callback);
+          custom_task_runners, thread_config_callback,
+          settings.pin_threads_to_core_classes);
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -2058,6 +2139,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
       on_create_rasterizer,                 //
       std::move(external_texture_resolver)  //
   );
+  embedder_engine->SetRenderTargetCacheStats(
+      std::move(render_target_cache_stats));
 
   // Release the ownership of the embedder engine to the caller.
   *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
@@ -2267,6 +2350,60 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
+static flutter::PointerData ToPointerData(const FlutterPointerEvent* event) {
+  flutter::PointerData pointer_data;
+  pointer_data.Clear();
+  // this is currely in use only on android embedding.
+  pointer_data.embedder_id = 0;
+  pointer_data.time_stamp = SAFE_ACCESS(event, timestamp, 0);
+  pointer_data.change = ToPointerDataChange(
+      SAFE_ACCESS(event, phase, FlutterPointerPhase::kCancel));
+  pointer_data.physical_x = SAFE_ACCESS(event, x, 0.0);
+  pointer_data.physical_y = SAFE_ACCESS(event, y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.physical_delta_x = 0.0;
+  pointer_data.physical_delta_y = 0.0;
+  pointer_data.device = SAFE_ACCESS(event, device, 0);
+  // Pointer identifier will be generated in
+  // pointer_data_packet_converter.cc.
+  pointer_data.pointer_identifier = 0;
+  pointer_data.signal_kind = ToPointerDataSignalKind(
+      SAFE_ACCESS(event, signal_kind, kFlutterPointerSignalKindNone));
+  pointer_data.scroll_delta_x = SAFE_ACCESS(event, scroll_delta_x, 0.0);
+  pointer_data.scroll_delta_y = SAFE_ACCESS(event, scroll_delta_y, 0.0);
+  FlutterPointerDeviceKind device_kind = SAFE_ACCESS(event, device_kind, 0);
+  // For backwards compatibility with embedders written before the device
+  // kind and buttons were exposed, if the device kind is not set treat it
+  // as a mouse, with a synthesized primary button state based on the phase.
+  if (device_kind == 0) {
+    pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
+    pointer_data.buttons =
+        PointerDataButtonsForLegacyEvent(pointer_data.change);
+
+  } else {
+    pointer_data.kind = ToPointerDataKind(device_kind);
+    if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
+      // For touch events, set the button internally rather than requiring
+      // it at the API level, since it's a confusing construction to expose.
+      if (pointer_data.change == flutter::PointerData::Change::kDown ||
+          pointer_data.change == flutter::PointerData::Change::kMove) {
+        pointer_data.buttons = flutter::kPointerButtonTouchContact;
+      }
+    } else {
+      // Buttons use the same mask values, so pass them through directly.
+      pointer_data.buttons = SAFE_ACCESS(event, buttons, 0);
+    }
+  }
+  pointer_data.pan_x = SAFE_ACCESS(event, pan_x, 0.0);
+  pointer_data.pan_y = SAFE_ACCESS(event, pan_y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.pan_delta_x = 0.0;
+  pointer_data.pan_delta_y = 0.0;
+  pointer_data.scale = SAFE_ACCESS(event, scale, 0.0);
+  pointer_data.rotation = SAFE_ACCESS(event, rotation, 0.0);
+  return pointer_data;
+}
+
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPointerEvent* pointers,
@@ -2284,57 +2421,7 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
   const FlutterPointerEvent* current = pointers;
 
   for (size_t i = 0; i < events_count; ++i) {
-    flutter::PointerData pointer_data;
-    pointer_data.Clear();
-    // this is currely in use only on android embedding.
-    pointer_data.embedder_id = 0;
-    pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
-    pointer_data.change = ToPointerDataChange(
-        SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
-    pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
-    pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.physical_delta_x = 0.0;
-    pointer_data.physical_delta_y = 0.0;
-    pointer_data.device = SAFE_ACCESS(current, device, 0);
-    // Pointer identifier will be generated in
-    // pointer_data_packet_converter.cc.
-    pointer_data.pointer_identifier = 0;
-    pointer_data.signal_kind = ToPointerDataSignalKind(
-        SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
-    pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
-    pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
-    FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
-    // For backwards compatibility with embedders written before the device
-    // kind and buttons were exposed, if the device kind is not set treat it
-    // as a mouse, with a synthesized primary button state based on the phase.
-    if (device_kind == 0) {
-      pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
-      pointer_data.buttons =
-          PointerDataButtonsForLegacyEvent(pointer_data.change);
-
-    } else {
-      pointer_data.kind = ToPointerDataKind(device_kind);
-      if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
-        // For touch events, set the button internally rather than requiring
-        // it at the API level, since it's a confusing construction to expose.
-        if (pointer_data.change == flutter::PointerData::Change::kDown ||
-            pointer_data.change == flutter::PointerData::Change::kMove) {
-          pointer_data.buttons = flutter::kPointerButtonTouchContact;
-        }
-      } else {
-        // Buttons use the same mask values, so pass them through directly.
-        pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
-      }
-    }
-    pointer_data.pan_x = SAFE_ACCESS(current, pan_x, 0.0);
-    pointer_data.pan_y = SAFE_ACCESS(current, pan_y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.pan_delta_x = 0.0;
-    pointer_data.pan_delta_y = 0.0;
-    pointer_data.scale = SAFE_ACCESS(current, scale, 0.0);
-    pointer_data.rotation = SAFE_ACCESS(current, rotation, 0.0);
-    packet->SetPointerData(i, pointer_data);
+    packet->SetPointerData(i, ToPointerData(current));
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
@@ -2360,6 +2447,22 @@ static inline flutter::KeyEventType MapKeyEventType(
   return flutter::KeyEventType::kUp;
 }
 
+static std::unique_ptr<flutter::KeyDataPacket> ToKeyDataPacket(
+    const FlutterKeyEvent* event) {
+  const char* character = SAFE_ACCESS(event, character, nullptr);
+
+  flutter::KeyData key_data;
+  key_data.Clear();
+  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
+  key_data.type = MapKeyEventType(
+      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
+  key_data.physical = SAFE_ACCESS(event, physical, 0);
+  key_data.logical = SAFE_ACCESS(event, logical, 0);
+  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
+
+  return std::make_unique<flutter::KeyDataPacket>(key_data, character);
+}
+
 // Send a platform message to the framework.
 //
 // The `data_callback` will be invoked with `user_data`, and must not be empty.
@@ -2412,18 +2515,7 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
   }
 
-  const char* character = SAFE_ACCESS(event, character, nullptr);
-
-  flutter::KeyData key_data;
-  key_data.Clear();
-  key_data.timestamp = static_cast<uint64_t>(SAFE_ACCESS(event, timestamp, 0));
-  key_data.type = MapKeyEventType(
-      SAFE_ACCESS(event, type, FlutterKeyEventType::kFlutterKeyEventTypeUp));
-  key_data.physical = SAFE_ACCESS(event, physical, 0);
-  key_data.logical = SAFE_ACCESS(event, logical, 0);
-  key_data.synthesized = SAFE_ACCESS(event, synthesized, false);
-
-  auto packet = std::make_unique<flutter::KeyDataPacket>(key_data, character);
+  auto packet = ToKeyDataPacket(event);
 
   struct MessageData {
     FlutterKeyEventCallback callback;
@@ -2451,6 +2543,127 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
       message_data);
 }
 
+FlutterEngineResult FlutterEngineSendInputEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterInputEvent** events,
+    size_t events_count,
+    FlutterKeyEventsCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (events == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid input events.");
+  }
+
+  // Validate the whole batch before dispatching any of it.
+  std::vector<const FlutterPointerEvent*> pointer_events;
+  std::vector<const FlutterKeyEvent*> key_events;
+  for (size_t i = 0; i < events_count; ++i) {
+    const FlutterInputEvent* event = events[i];
+    if (event == nullptr) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid input event.");
+    }
+    switch (SAFE_ACCESS(event, type, kFlutterInputEventTypePointer)) {
+      case kFlutterInputEventTypePointer:
+        if (SAFE_ACCESS(event, pointer, nullptr) == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Invalid pointer event in input events.");
+        }
+        pointer_events.push_back(event->pointer);
+        break;
+      case kFlutterInputEventTypeKey:
+        if (SAFE_ACCESS(event, key, nullptr) == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Invalid key event in input events.");
+        }
+        key_events.push_back(event->key);
+        break;
+      default:
+        return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "Unknown input event type.");
+    }
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+
+  if (!pointer_events.empty()) {
+    auto packet =
+        std::make_unique<flutter::PointerDataPacket>(pointer_events.size());
+    for (size_t i = 0; i < pointer_events.size(); ++i) {
+      packet->SetPointerData(i, ToPointerData(pointer_events[i]));
+    }
+    if (!embedder_engine->DispatchPointerDataPacket(std::move(packet))) {
+      return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                "Could not dispatch pointer events to the "
+                                "running Flutter application.");
+    }
+  }
+
+  if (key_events.empty()) {
+    return kSuccess;
+  }
+
+  // The responses of the key events are collected here and reported together
+  // once the last one has arrived. Responses are delivered on the platform
+  // task runner, but a response for an event that could not be sent is
+  // recorded on the calling thread.
+  struct KeyEventsResponses {
+    FlutterKeyEventsCallback callback;
+    void* user_data;
+    std::unique_ptr<bool[]> handled;
+    size_t count;
+    std::atomic<size_t> pending;
+
+    void Record(size_t index, bool is_handled) {
+      handled[index] = is_handled;
+      if (--pending == 0 && callback != nullptr) {
+        callback(handled.get(), count, user_data);
+      }
+    }
+  };
+
+  struct MessageData {
+    std::shared_ptr<KeyEventsResponses> responses;
+    size_t index;
+  };
+
+  auto responses = std::make_shared<KeyEventsResponses>();
+  responses->callback = callback;
+  responses->user_data = user_data;
+  responses->handled = std::make_unique<bool[]>(key_events.size());
+  responses->count = key_events.size();
+  responses->pending = key_events.size();
+
+  FlutterEngineResult result = kSuccess;
+  for (size_t i = 0; i < key_events.size(); ++i) {
+    auto packet = ToKeyDataPacket(key_events[i]);
+    auto message_data =
+        std::make_unique<MessageData>(MessageData{responses, i});
+    FlutterEngineResult send_result = InternalSendPlatformMessage(
+        engine, kFlutterKeyDataChannel, packet->data().data(),
+        packet->data().size(),
+        [](const uint8_t* data, size_t size, void* user_data) {
+          auto message_data = std::unique_ptr<MessageData>(
+              reinterpret_cast<MessageData*>(user_data));
+          message_data->responses->Record(message_data->index,
+                                          size == 1 && *data != 0);
+        },
+        message_data.get());
+    if (send_result == kSuccess) {
+      // Owned by the response callback now.
+      message_data.release();
+    } else {
+      // Events that could not be sent are reported as not handled so that
+      // the callback is still invoked exactly once.
+      responses->Record(i, false);
+      result = send_result;
+    }
+  }
+  return result;
+}
+
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* flutter_message) {
@@ -3028,6 +3241,83 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    "Could not dispatch the low memory notification message.");
 }
 
+FlutterEngineResult FlutterEngineNotifyThermalStateChange(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine) {
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (embedder_engine == nullptr || !embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  return embedder_engine->ReapplyThreadAffinity()
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not reapply the thread affinity.");
+}
+
+static void ConvertFrameTimingPercentiles(
+    const flutter::FrameTimingPercentiles& percentiles,
+    FlutterFrameTimingPercentiles* out) {
+  out->frame_count = percentiles.count;
+  out->p50_us = percentiles.p50.ToMicroseconds();
+  out->p90_us = percentiles.p90.ToMicroseconds();
+  out->p99_us = percentiles.p99.ToMicroseconds();
+  out->max_us = percentiles.max.ToMicroseconds();
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStats* stats) {
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (embedder_engine == nullptr || !embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (stats == nullptr ||
+      stats->struct_size < sizeof(FlutterFrameTimingStats)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame timing stats struct.");
+  }
+
+  flutter::FrameTimingStats engine_stats =
+      embedder_engine->GetShell().GetFrameTimingStats();
+  stats->window_us = engine_stats.window.ToMicroseconds();
+  ConvertFrameTimingPercentiles(engine_stats.vsync_overhead,
+                                &stats->vsync_overhead);
+  ConvertFrameTimingPercentiles(engine_stats.build, &stats->build);
+  ConvertFrameTimingPercentiles(engine_stats.raster, &stats->raster);
+  ConvertFrameTimingPercentiles(engine_stats.total, &stats->total);
+  ConvertFrameTimingPercentiles(engine_stats.gpu, &stats->gpu);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetBackingStoreCacheStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterBackingStoreCacheStats* stats) {
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (embedder_engine == nullptr || !embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (stats == nullptr ||
+      stats->struct_size < sizeof(FlutterBackingStoreCacheStats)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid backing store cache stats struct.");
+  }
+
+  const auto& cache_stats = embedder_engine->GetRenderTargetCacheStats();
+  if (!cache_stats) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The engine was launched without a compositor.");
+  }
+
+  stats->created_count = cache_stats->created_count;
+  stats->reused_count = cache_stats->reused_count;
+  stats->collected_count = cache_stats->collected_count;
+  stats->cached_count = cache_stats->cached_count;
+  stats->cached_bytes = cache_stats->cached_bytes;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -3202,6 +3492,10 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(NotifyThermalStateChange, FlutterEngineNotifyThermalStateChange);
+  SET_PROC(GetFrameTimingStats, FlutterEngineGetFrameTimingStats);
+  SET_PROC(SendInputEvents, FlutterEngineSendInputEvents);
+  SET_PROC(GetBackingStoreCacheStats, FlutterEngineGetBackingStoreCacheStats);
 #undef SET_PROC
 
   return kSuccess;
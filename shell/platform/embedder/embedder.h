@@ -739,6 +739,50 @@ typedef bool (*FlutterVulkanPresentCallback)(
     void* /* user data */,
     const FlutterVulkanImage* /* image */);
 
+/// Alias for VkSemaphore.
+typedef uint64_t FlutterVulkanSemaphoreHandle;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterVulkanExternalTexture).
+  size_t struct_size;
+  /// Width of the texture. If 0, the size of the texture on screen is used.
+  size_t width;
+  /// Height of the texture. If 0, the size of the texture on screen is used.
+  size_t height;
+  /// The VkImage to sample the frame from. To avoid copies, the embedder can
+  /// bind memory imported from the buffer of the producer (for example a
+  /// dma-buf through VK_EXT_external_memory_dma_buf, or an AHardwareBuffer
+  /// through VK_ANDROID_external_memory_android_hardware_buffer) to this
+  /// image. The image must be usable with VK_IMAGE_USAGE_SAMPLED_BIT and
+  /// owned by the queue family of the engine.
+  const FlutterVulkanImage* image;
+  /// The VkImageLayout of the image when the engine first uses it.
+  uint32_t image_layout;
+  /// An optional VkSemaphore that the producer signals once the frame is
+  /// written, for example one imported from a sync file with
+  /// vkImportSemaphoreFdKHR. The engine waits on it on the GPU before
+  /// sampling the image, instead of the embedder waiting on the CPU. It stays
+  /// owned by the embedder and must not be destroyed before the destruction
+  /// callback is invoked.
+  FlutterVulkanSemaphoreHandle acquire_semaphore;
+  /// A baton that is not interpreted by the engine in any way. It will be given
+  /// back to the embedder in the destruction callback below.
+  void* user_data;
+  /// The callback invoked by the engine once the GPU work that samples the
+  /// image has completed. This acts as the release fence of the frame: the
+  /// producer may write to the buffer again after it is invoked.
+  VoidCallback destruction_callback;
+} FlutterVulkanExternalTexture;
+
+/// Callback to provide an external texture for a given texture_id.
+/// See: external_texture_frame_callback.
+typedef bool (*FlutterVulkanTextureFrameCallback)(
+    void* /* user data */,
+    int64_t /* texture identifier */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterVulkanExternalTexture* /* texture out */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterVulkanRendererConfig).
   size_t struct_size;
@@ -802,17 +846,54 @@ typedef struct {
   /// without any additional synchronization.
   /// Not used if a FlutterCompositor is supplied in FlutterProjectArgs.
   FlutterVulkanPresentCallback present_image_callback;
-
+  /// When the embedder specifies that a texture has a frame available, the
+  /// engine will call this method (on an internal engine managed thread) so
+  /// that external texture details can be supplied to the engine for subsequent
+  /// composition.
+  FlutterVulkanTextureFrameCallback external_texture_frame_callback;
 } FlutterVulkanRendererConfig;
 
+/// Callback for when a software surface is presented, with the area of the
+/// buffer that changed since the previous frame.
+///
+/// See: surface_present_with_damage_callback.
+typedef bool (*SoftwareSurfacePresentWithDamageCallback)(
+    void* /* user data */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */,
+    const FlutterDamage* /* damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
+  /// Specifying one (and only one) of `surface_present_callback` or
+  /// `surface_present_with_damage_callback` is required. Specifying both is an
+  /// error and engine initialization will be terminated.
+  ///
   /// The callback presented to the embedder to present a fully populated buffer
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Like `surface_present_callback`, but also given the area of the buffer
+  /// that changed since the previous frame, so that embedders only need to
+  /// copy or transmit that area. The engine only rasterizes the parts of a
+  /// frame that changed, and the rest of the buffer keeps the pixels of the
+  /// previous frame.
+  SoftwareSurfacePresentWithDamageCallback surface_present_with_damage_callback;
+  /// By default, every frame is rendered into the same buffer, so the buffer
+  /// must not be read after the present callback returns. If this is true,
+  /// the engine renders into two buffers in turn instead, and the buffer of a
+  /// frame stays unchanged until the present callback of the next frame
+  /// returns. This lets embedders read a frame, for example to encode it,
+  /// while the engine renders the next one.
+  bool double_buffered;
+  /// If true, frames are recorded first and then rasterized in horizontal
+  /// tiles, in parallel, on the worker threads of the engine. This makes
+  /// rendering faster on machines with many cores, at the cost of recording
+  /// the frame. Frames with backdrop filters are rasterized in one piece.
+  bool tiled_rasterization;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1037,6 +1118,32 @@ typedef struct {
 typedef void (*FlutterKeyEventCallback)(bool /* handled */,
                                         void* /* user_data */);
 
+typedef enum {
+  kFlutterInputEventTypePointer,
+  kFlutterInputEventTypeKey,
+} FlutterInputEventType;
+
+/// A pointer or key event in a batch sent with `FlutterEngineSendInputEvents`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterInputEvent).
+  size_t struct_size;
+  /// The type of the event described by the subsequent union.
+  FlutterInputEventType type;
+  union {
+    /// The pointer event, if `type` is `kFlutterInputEventTypePointer`.
+    const FlutterPointerEvent* pointer;
+    /// The key event, if `type` is `kFlutterInputEventTypeKey`.
+    const FlutterKeyEvent* key;
+  };
+} FlutterInputEvent;
+
+/// Invoked once the Flutter application has decided whether it handles each of
+/// the key events of a batch. `handled` has one entry per key event, in the
+/// order of the batch, and is only valid for the duration of the call.
+typedef void (*FlutterKeyEventsCallback)(const bool* /* handled */,
+                                         size_t /* key_events_count */,
+                                         void* /* user_data */);
+
 struct _FlutterPlatformMessageResponseHandle;
 typedef struct _FlutterPlatformMessageResponseHandle
     FlutterPlatformMessageResponseHandle;
@@ -1693,6 +1800,14 @@ typedef struct {
   /// outside of this area are transparent and the embedder may choose not
   /// to render them. Coordinates are in physical pixels.
   FlutterRegion* paint_region;
+
+  /// The area of the backing store that changed since the backing store was
+  /// last presented. The embedder may limit its composition to this area, for
+  /// example by passing it on as a damage hint to the system compositor. The
+  /// region is empty if the backing store did not change (its `did_update` is
+  /// false), and covers the whole layer if the backing store was not presented
+  /// with the previous frame. Coordinates are in physical pixels.
+  FlutterRegion* damage_region;
 } FlutterBackingStorePresentInfo;
 
 typedef struct {
@@ -1757,6 +1872,21 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// The number of frames that a backing store is kept for after the last
+  /// frame that used it, so that a later frame can reuse it instead of asking
+  /// for a new one. With 0, backing stores are only kept for the next frame.
+  /// Ignored if `avoid_backing_store_cache` is set.
+  size_t backing_store_retention_frames;
+  /// The maximum estimated size in bytes, at four bytes per pixel, of the
+  /// unused backing stores that are kept for later frames, or 0 for no limit.
+  size_t backing_store_cache_max_bytes;
+  /// If greater than 1, the width and height of the backing stores that the
+  /// engine asks for are rounded up to a multiple of this value, so that
+  /// backing stores can be reused while a window is resized. A backing store
+  /// may then be larger than its layer. The contents of the layer are in the
+  /// top left `FlutterLayer.size` pixels of the backing store, and embedders
+  /// that set this must only present those.
+  uint32_t backing_store_size_granularity;
 } FlutterCompositor;
 
 typedef struct {
@@ -2249,8 +2379,60 @@ typedef struct {
   /// being registered on the framework side. The callback is invoked from
   /// a task posted to the platform thread.
   FlutterChannelUpdateCallback channel_update_callback;
+
+  /// Pin the engine managed UI and raster threads to the performance cores,
+  /// and the IO and concurrent worker threads to the efficiency cores, on
+  /// devices with heterogeneous cores. Embedders that set this should call
+  /// `FlutterEngineNotifyThermalStateChange` whenever the device reports a
+  /// thermal state change so the pinning can be restored.
+  bool pin_threads_to_core_classes;
 } FlutterProjectArgs;
 
+/// The percentiles of the durations of one phase of the frames that were
+/// rasterized within a window. Durations are in microseconds.
+typedef struct {
+  /// The number of frames in the window.
+  uint64_t frame_count;
+  uint64_t p50_us;
+  uint64_t p90_us;
+  uint64_t p99_us;
+  uint64_t max_us;
+} FlutterFrameTimingPercentiles;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStats).
+  size_t struct_size;
+  /// The span of time before the call that the stats cover.
+  uint64_t window_us;
+  /// From the vsync signal to the start of the frame's build.
+  FlutterFrameTimingPercentiles vsync_overhead;
+  /// From the start to the end of the build on the UI thread.
+  FlutterFrameTimingPercentiles build;
+  /// From the start to the end of rasterization on the raster thread.
+  FlutterFrameTimingPercentiles raster;
+  /// From the vsync signal to the end of rasterization.
+  FlutterFrameTimingPercentiles total;
+  /// The time the GPU spent on each frame. Only the Impeller backends that
+  /// support GPU timestamps measure it, and its frame count is 0 otherwise.
+  FlutterFrameTimingPercentiles gpu;
+} FlutterFrameTimingStats;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterBackingStoreCacheStats).
+  size_t struct_size;
+  /// The backing stores that the engine asked the compositor to create.
+  size_t created_count;
+  /// The times a frame reused a backing store of an earlier frame.
+  size_t reused_count;
+  /// The backing stores that the engine asked the compositor to collect.
+  size_t collected_count;
+  /// The unused backing stores currently kept for later frames.
+  size_t cached_count;
+  /// The estimated size in bytes of the unused backing stores currently kept
+  /// for later frames, at four bytes per pixel.
+  size_t cached_bytes;
+} FlutterBackingStoreCacheStats;
+
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
 
 //------------------------------------------------------------------------------
@@ -2431,6 +2613,43 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
                                               FlutterKeyEventCallback callback,
                                               void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of pointer and key events to the engine in one
+///             call. This is cheaper than sending each event on its own for
+///             embedders with high-frequency input devices.
+///
+///             All the pointer events of the batch are dispatched to the
+///             framework as a single pointer data packet, as if they were
+///             sent with one call to `FlutterEngineSendPointerEvent`. The key
+///             events are then dispatched in the order of the batch, and the
+///             responses for all of them are reported with a single
+///             invocation of `callback`.
+///
+///             Nothing is dispatched if any of the events is invalid.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  events         The events to be sent. This function will no
+///                            longer access `events` after returning.
+/// @param[in]  events_count   The number of events in `events`.
+/// @param[in]  callback       The callback invoked by the engine when the
+///                            Flutter application has decided whether it
+///                            handles each of the key events. It is guaranteed
+///                            to be called exactly once if the batch contains
+///                            key events, and never otherwise. Accepts nullptr.
+/// @param[in]  user_data      The context associated with the callback. The
+///                            exact same value will used to invoke `callback`.
+///                            Accepts nullptr.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendInputEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterInputEvent** events,
+    size_t events_count,
+    FlutterKeyEventsCallback callback,
+    void* user_data);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2855,6 +3074,58 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Notifies the engine that the thermal state of the device has
+///             changed. Operating systems may take cores offline under
+///             thermal pressure and reset the affinity of the threads that
+///             ran on them. If the engine was launched with
+///             `FlutterProjectArgs::pin_threads_to_core_classes`, the engine
+///             managed threads request their core class again. Otherwise,
+///             this call has no effect.
+///
+/// @param[in]  engine     A running engine instance.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineNotifyThermalStateChange(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the p50, p90, p99 and maximum durations of the phases of
+///             the frames that the engine rasterized within the last minute.
+///             The engine aggregates the timings of every frame as it is
+///             rasterized, so this is cheap enough to poll from any thread
+///             to monitor frame latency in production.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[out] stats      The stats of the recent frames. Its struct_size
+///                        must be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStats* stats);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the counters of the backing stores that the engine
+///             requested from the compositor and keeps for reuse across
+///             frames. Can be called from any thread.
+///
+/// @param[in]  engine     A running engine instance that was launched with a
+///                        `FlutterCompositor`.
+/// @param[out] stats      The counters. Its struct_size must be set by the
+///                        caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetBackingStoreCacheStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterBackingStoreCacheStats* stats);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -3049,6 +3320,20 @@ typedef FlutterEngineResult (*FlutterEnginePostDartObjectFnPtr)(
     const FlutterEngineDartObject* object);
 typedef FlutterEngineResult (*FlutterEngineNotifyLowMemoryWarningFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (*FlutterEngineNotifyThermalStateChangeFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStats* stats);
+typedef FlutterEngineResult (*FlutterEngineSendInputEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterInputEvent** events,
+    size_t events_count,
+    FlutterKeyEventsCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetBackingStoreCacheStatsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterBackingStoreCacheStats* stats);
 typedef FlutterEngineResult (*FlutterEnginePostCallbackOnAllNativeThreadsFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -3110,6 +3395,10 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineNotifyThermalStateChangeFnPtr NotifyThermalStateChange;
+  FlutterEngineGetFrameTimingStatsFnPtr GetFrameTimingStats;
+  FlutterEngineSendInputEventsFnPtr SendInputEvents;
+  FlutterEngineGetBackingStoreCacheStatsFnPtr GetBackingStoreCacheStats;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -289,9 +289,31 @@ bool EmbedderEngine::ScheduleFrame() {
   return true;
 }
 
+bool EmbedderEngine::ReapplyThreadAffinity() {
+  if (!IsValid()) {
+    return false;
+  }
+
+  thread_host_->ReapplyCpuAffinity();
+  if (auto* vm = shell_->GetDartVM()) {
+    vm->ReapplyWorkerAffinity();
+  }
+  return true;
+}
+
 Shell& EmbedderEngine::GetShell() {
   FML_DCHECK(shell_);
   return *shell_.get();
 }
 
+void EmbedderEngine::SetRenderTargetCacheStats(
+    std::shared_ptr<const EmbedderRenderTargetCache::Stats> stats) {
+  render_target_cache_stats_ = std::move(stats);
+}
+
+const std::shared_ptr<const EmbedderRenderTargetCache::Stats>&
+EmbedderEngine::GetRenderTargetCacheStats() const {
+  return render_target_cache_stats_;
+}
+
 }  // namespace flutter
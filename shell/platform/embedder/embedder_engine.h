@@ -13,6 +13,7 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 namespace flutter {
 
@@ -85,8 +86,20 @@ class EmbedderEngine {
 
   bool ScheduleFrame();
 
+  // Requests the core class of the engine managed threads and of the
+  // concurrent workers again. See |ThreadHost::ReapplyCpuAffinity|.
+  bool ReapplyThreadAffinity();
+
   Shell& GetShell();
 
+  // The counters of the render target cache of the compositor. Null if the
+  // embedder did not specify a compositor.
+  void SetRenderTargetCacheStats(
+      std::shared_ptr<const EmbedderRenderTargetCache::Stats> stats);
+
+  const std::shared_ptr<const EmbedderRenderTargetCache::Stats>&
+  GetRenderTargetCacheStats() const;
+
  private:
   const std::unique_ptr<EmbedderThreadHost> thread_host_;
   TaskRunners task_runners_;
@@ -94,6 +107,8 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  std::shared_ptr<const EmbedderRenderTargetCache::Stats>
+      render_target_cache_stats_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_external_texture_vulkan.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan.h"
+#include "flutter/vulkan/procs/vulkan_interface.h"
+#include "third_party/skia/include/core/SkAlphaType.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
+#include "third_party/skia/include/gpu/ganesh/vk/GrVkBackendSurface.h"
+#include "third_party/skia/include/gpu/vk/GrVkTypes.h"
+
+namespace flutter {
+
+EmbedderExternalTextureVulkan::EmbedderExternalTextureVulkan(
+    int64_t texture_identifier,
+    const ExternalTextureCallback& callback)
+    : Texture(texture_identifier), external_texture_callback_(callback) {
+  FML_DCHECK(external_texture_callback_);
+}
+
+EmbedderExternalTextureVulkan::~EmbedderExternalTextureVulkan() = default;
+
+// |flutter::Texture|
+void EmbedderExternalTextureVulkan::Paint(PaintContext& context,
+                                          const SkRect& bounds,
+                                          bool freeze,
+                                          const DlImageSampling sampling) {
+  if (last_image_ == nullptr) {
+    last_image_ =
+        ResolveTexture(Id(),                                           //
+                       context.gr_context,                             //
+                       SkISize::Make(bounds.width(), bounds.height())  //
+        );
+  }
+
+  DlCanvas* canvas = context.canvas;
+  const DlPaint* paint = context.paint;
+
+  if (last_image_) {
+    SkRect image_bounds = SkRect::Make(last_image_->bounds());
+    if (bounds != image_bounds) {
+      canvas->DrawImageRect(last_image_, image_bounds, bounds, sampling, paint);
+    } else {
+      canvas->DrawImage(last_image_, {bounds.x(), bounds.y()}, sampling, paint);
+    }
+  }
+}
+
+sk_sp<DlImage> EmbedderExternalTextureVulkan::ResolveTexture(
+    int64_t texture_id,
+    GrDirectContext* context,
+    const SkISize& size) {
+  std::unique_ptr<FlutterVulkanExternalTexture> texture =
+      external_texture_callback_(texture_id, size.width(), size.height());
+
+  if (!texture) {
+    return nullptr;
+  }
+
+  SkImages::TextureReleaseProc release_proc = texture->destruction_callback;
+
+  if (texture->image == nullptr || !texture->image->image) {
+    if (release_proc) {
+      release_proc(texture->user_data);
+    }
+    FML_LOG(ERROR) << "Embedder supplied null Vulkan image for texture: "
+                   << texture_id;
+    return nullptr;
+  }
+
+  // The producer may still be writing to the image. Make the GPU wait for the
+  // acquire semaphore before it samples the image, so that neither the
+  // embedder nor the raster thread block on the producer.
+  if (texture->acquire_semaphore) {
+    GrBackendSemaphore semaphore;
+    semaphore.initVulkan(
+        reinterpret_cast<VkSemaphore>(texture->acquire_semaphore));
+    if (!context->wait(1, &semaphore, /*deleteSemaphoresAfterWait=*/false)) {
+      FML_LOG(ERROR) << "Could not wait on the acquire semaphore of external "
+                        "texture: "
+                     << texture_id;
+    }
+  }
+
+  size_t width = size.width();
+  size_t height = size.height();
+
+  if (texture->width != 0 && texture->height != 0) {
+    width = texture->width;
+    height = texture->height;
+  }
+
+  const auto format = static_cast<VkFormat>(texture->image->format);
+  GrVkImageInfo image_info = {
+      .fImage = reinterpret_cast<VkImage>(texture->image->image),
+      .fImageTiling = VK_IMAGE_TILING_OPTIMAL,
+      .fImageLayout = static_cast<VkImageLayout>(texture->image_layout),
+      .fFormat = format,
+      .fImageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+      .fSampleCount = 1,
+      .fLevelCount = 1,
+  };
+  auto gr_backend_texture =
+      GrBackendTextures::MakeVk(width, height, image_info);
+  // Borrowing the texture keeps it alive until the command buffers that sample
+  // it have finished, so the release proc doubles as the release fence.
+  auto image = SkImages::BorrowTextureFrom(
+      context,                                        // context
+      gr_backend_texture,                             // texture handle
+      kTopLeft_GrSurfaceOrigin,                       // origin
+      GPUSurfaceVulkan::ColorTypeFromFormat(format),  // color type
+      kPremul_SkAlphaType,                            // alpha type
+      nullptr,                                        // colorspace
+      release_proc,                                   // texture release proc
+      texture->user_data  // texture release context
+  );
+
+  if (!image) {
+    // In case Skia rejects the image, call the release proc so that
+    // embedders can perform collection of intermediates.
+    if (release_proc) {
+      release_proc(texture->user_data);
+    }
+    FML_LOG(ERROR) << "Could not create external texture: " << texture_id;
+    return nullptr;
+  }
+
+  // This image should not escape local use by EmbedderExternalTextureVulkan
+  return DlImage::Make(std::move(image));
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureVulkan::OnGrContextCreated() {}
+
+// |flutter::Texture|
+void EmbedderExternalTextureVulkan::OnGrContextDestroyed() {}
+
+// |flutter::Texture|
+void EmbedderExternalTextureVulkan::MarkNewFrameAvailable() {
+  last_image_ = nullptr;
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureVulkan::OnTextureUnregistered() {}
+
+}  // namespace flutter
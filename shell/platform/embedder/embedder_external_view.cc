@@ -67,6 +67,15 @@ std::list<SkRect> EmbedderExternalView::GetEngineRenderedContentsRegion(
   return slice_->searchNonOverlappingDrawnRects(query);
 }
 
+const SkMatrix& EmbedderExternalView::GetSurfaceTransformation() const {
+  return surface_transformation_;
+}
+
+sk_sp<DisplayList> EmbedderExternalView::GetDisplayList() {
+  TryEndRecording();
+  return slice_->display_list();
+}
+
 bool EmbedderExternalView::HasEngineRenderedContents() {
   if (has_engine_rendered_contents_.has_value()) {
     return has_engine_rendered_contents_.value();
@@ -115,7 +124,12 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
     return false;
   }
 
-  FML_DCHECK(render_target.GetRenderTargetSize() == render_surface_size_);
+  // Render targets may be larger than the surface when their sizes are
+  // rounded up. The contents are then rendered into their top left corner.
+  FML_DCHECK(render_target.GetRenderTargetSize().width() >=
+                 render_surface_size_.width() &&
+             render_target.GetRenderTargetSize().height() >=
+                 render_surface_size_.height());
 
   auto canvas = skia_surface->getCanvas();
   if (!canvas) {
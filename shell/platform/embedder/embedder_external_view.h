@@ -111,6 +111,10 @@ class EmbedderExternalView {
 
   std::list<SkRect> GetEngineRenderedContentsRegion(const SkRect& query) const;
 
+  const SkMatrix& GetSurfaceTransformation() const;
+
+  sk_sp<DisplayList> GetDisplayList();
+
  private:
   // End the recording of the slice.
   // Noop if the slice's recording has already ended.
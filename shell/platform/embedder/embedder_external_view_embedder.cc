@@ -9,6 +9,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "third_party/skia/include/core/SkRegion.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -16,10 +17,16 @@ namespace flutter {
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
     const CreateRenderTargetCallback& create_render_target_callback,
-    const PresentCallback& present_callback)
+    const PresentCallback& present_callback,
+    size_t retention_frames,
+    size_t cache_max_bytes,
+    int size_granularity)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(retention_frames,
+                           cache_max_bytes,
+                           size_granularity) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
 }
@@ -31,6 +38,11 @@ void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
   surface_transformation_callback_ = std::move(surface_transformation_callback);
 }
 
+std::shared_ptr<const EmbedderRenderTargetCache::Stats>
+EmbedderExternalViewEmbedder::GetRenderTargetCacheStats() const {
+  return render_target_cache_.GetStats();
+}
+
 SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   if (!surface_transformation_callback_) {
     return SkMatrix{};
@@ -143,7 +155,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectUnusedRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -158,11 +170,12 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
 
     // This is the size of render surface we want the embedder to create for
     // us. As or right now, this is going to always be equal to the frame size
-    // post transformation. But, in case optimizations are applied that make
-    // it so that embedder rendered into surfaces that aren't full screen,
-    // this assumption will break. So it's just best to ask view for its size
-    // directly.
-    const auto render_surface_size = external_view->GetRenderSurfaceSize();
+    // post transformation, rounded up if the cache uses coarser sizes. But,
+    // in case optimizations are applied that make it so that embedder
+    // rendered into surfaces that aren't full screen, this assumption will
+    // break. So it's just best to ask view for its size directly.
+    const auto render_surface_size = render_target_cache_.GetRenderTargetSize(
+        external_view->GetRenderSurfaceSize());
 
     const auto backing_store_config =
         MakeBackingStoreConfig(render_surface_size);
@@ -180,6 +193,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       FML_LOG(ERROR) << "Embedder did not return a valid render target.";
       return;
     }
+    render_target_cache_.GetStats()->created_count++;
     matched_render_targets[pending_key] = std::move(render_target);
   }
 
@@ -192,13 +206,57 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
 
   // Scribble embedder provide render targets. The order in which we scribble
   // into the buffers is irrelevant to the presentation order.
-  for (const auto& render_target : matched_render_targets) {
-    if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
+  const auto frame_rect = SkIRect::MakeSize(pending_frame_size_);
+  for (const auto& [view_id, render_target] : matched_render_targets) {
+    const auto& external_view = pending_views_.at(view_id);
+    EmbedderRenderTarget::Contents contents{
+        .display_list = external_view->GetDisplayList(),
+        .transformation = external_view->GetSurfaceTransformation(),
+    };
+
+    // Render targets reused from the previous frame may already hold the
+    // contents of their view. Leave them as they are.
+    const auto& previous = render_target->GetContents();
+    const bool same_transformation =
+        previous.has_value() &&
+        previous->transformation == contents.transformation;
+    if (same_transformation &&
+        previous->display_list->Equals(contents.display_list)) {
+      render_target->MarkContentsUnchanged();
+      continue;
+    }
+
+    if (!external_view->Render(*render_target)) {
       FML_LOG(ERROR)
           << "Could not render into the embedder supplied render target.";
       return;
     }
+
+    auto rect_list = external_view->GetEngineRenderedContentsRegion(
+        SkRect::Make(frame_rect));
+    contents.paint_region.reserve(rect_list.size());
+    for (const auto& rect : rect_list) {
+      contents.paint_region.push_back(rect.roundOut());
+    }
+
+    // Pixels outside of both the previous and the current paint region are
+    // transparent in both frames, so only those regions can have changed.
+    std::vector<SkIRect> damage_region;
+    if (same_transformation) {
+      SkRegion damage;
+      for (const auto& rect : previous->paint_region) {
+        damage.op(rect, SkRegion::kUnion_Op);
+      }
+      for (const auto& rect : contents.paint_region) {
+        damage.op(rect, SkRegion::kUnion_Op);
+      }
+      for (SkRegion::Iterator it(damage); !it.done(); it.next()) {
+        damage_region.push_back(it.rect());
+      }
+    } else {
+      damage_region.push_back(frame_rect);
+    }
+    render_target->SetContents(std::move(contents), std::move(damage_region));
   }
 
   // We are going to be transferring control back over to the embedder there the
@@ -238,17 +296,15 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // platform view.
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
-        const auto& external_view = pending_views_.at(view_id);
-        auto rect_list =
-            external_view->GetEngineRenderedContentsRegion(SkRect::MakeIWH(
-                pending_frame_size_.width(), pending_frame_size_.height()));
-        std::vector<SkIRect> rects;
-        rects.reserve(rect_list.size());
-        for (const auto& rect : rect_list) {
-          rects.push_back(rect.roundOut());
-        }
+        // Covered by the render loop above, which sets the contents of every
+        // matched render target.
+        // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        const auto& contents = exteral_render_target->GetContents().value();
         presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore(), rects);
+            exteral_render_target->GetBackingStore(),  // backing store
+            contents.paint_region,                     // paint region
+            exteral_render_target->GetDamageRegion()   // damage region
+        );
       }
     }
 
@@ -263,10 +319,13 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
-  for (auto& render_target : matched_render_targets) {
-    if (!avoid_backing_store_cache_) {
+  // Hold all rendered layers in the render target cache to see if they may be
+  // reused by the next frames.
+  if (avoid_backing_store_cache_) {
+    render_target_cache_.GetStats()->collected_count +=
+        matched_render_targets.size();
+  } else {
+    for (auto& render_target : matched_render_targets) {
       render_target_cache_.CacheRenderTarget(render_target.first,
                                              std::move(render_target.second));
     }
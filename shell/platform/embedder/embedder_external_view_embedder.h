@@ -54,11 +54,22 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                     collection of layers (backed by
   ///                                     fulfilled render targets) to the
   ///                                     embedder for presentation.
+  /// @param[in]  retention_frames        The number of frames unused render
+  ///                                     targets are kept for reuse.
+  /// @param[in]  cache_max_bytes         The maximum estimated size of the
+  ///                                     unused render targets that are kept,
+  ///                                     or 0 for no limit.
+  /// @param[in]  size_granularity        The multiple that render target sizes
+  ///                                     are rounded up to, or 0 for exact
+  ///                                     sizes.
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
       const CreateRenderTargetCallback& create_render_target_callback,
-      const PresentCallback& present_callback);
+      const PresentCallback& present_callback,
+      size_t retention_frames = 0,
+      size_t cache_max_bytes = 0,
+      int size_granularity = 0);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the external view embedder.
@@ -76,6 +87,14 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   void SetSurfaceTransformationCallback(
       SurfaceTransformationCallback surface_transformation_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The counters of the render targets that the external view
+  ///             embedder requested and keeps for reuse. They can be read on
+  ///             any thread.
+  ///
+  std::shared_ptr<const EmbedderRenderTargetCache::Stats>
+  GetRenderTargetCacheStats() const;
+
  private:
   // |ExternalViewEmbedder|
   void CancelFrame() override;
@@ -25,7 +25,8 @@ class EmbedderLayers {
   ~EmbedderLayers();
 
   void PushBackingStoreLayer(const FlutterBackingStore* store,
-                             const std::vector<SkIRect>& drawn_region);
+                             const std::vector<SkIRect>& drawn_region,
+                             const std::vector<SkIRect>& damage_region);
 
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
                              const EmbeddedViewParams& params);
@@ -49,6 +50,8 @@ class EmbedderLayers {
   std::vector<std::unique_ptr<std::vector<FlutterRect>>> rects_referenced_;
   std::vector<FlutterLayer> presented_layers_;
 
+  FlutterRegion* MakeRegion(const std::vector<SkIRect>& rects);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderLayers);
 };
 
@@ -12,8 +12,6 @@ namespace flutter {
 EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
                                            fml::closure on_release)
     : backing_store_(backing_store), on_release_(std::move(on_release)) {
-  // TODO(38468): The optimization to elide backing store updates between frames
-  // has not been implemented yet.
   backing_store_.did_update = true;
 }
 
@@ -27,4 +25,25 @@ const FlutterBackingStore* EmbedderRenderTarget::GetBackingStore() const {
   return &backing_store_;
 }
 
+const std::optional<EmbedderRenderTarget::Contents>&
+EmbedderRenderTarget::GetContents() const {
+  return contents_;
+}
+
+void EmbedderRenderTarget::SetContents(Contents contents,
+                                       std::vector<SkIRect> damage_region) {
+  contents_ = std::move(contents);
+  damage_region_ = std::move(damage_region);
+  backing_store_.did_update = true;
+}
+
+void EmbedderRenderTarget::MarkContentsUnchanged() {
+  damage_region_.clear();
+  backing_store_.did_update = false;
+}
+
+const std::vector<SkIRect>& EmbedderRenderTarget::GetDamageRegion() const {
+  return damage_region_;
+}
+
 }  // namespace flutter
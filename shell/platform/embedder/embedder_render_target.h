@@ -6,9 +6,15 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -27,6 +33,14 @@ namespace flutter {
 ///
 class EmbedderRenderTarget {
  public:
+  /// What was last rendered into a render target.
+  struct Contents {
+    sk_sp<DisplayList> display_list;
+    SkMatrix transformation;
+    /// The area that the display list drew into, in frame coordinates.
+    std::vector<SkIRect> paint_region;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys this instance of the render target and invokes the
   ///             callback for the embedder to release its resource associated
@@ -77,6 +91,42 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The contents last rendered into this render target, if any.
+  ///             Render targets are reused across frames, so this lets the
+  ///             engine tell whether the render target has to be rendered
+  ///             into again.
+  ///
+  /// @return     The contents of the render target.
+  ///
+  const std::optional<Contents>& GetContents() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that new contents were rendered into this render
+  ///             target, and marks the backing store as updated.
+  ///
+  /// @param[in]  contents       The contents that were rendered.
+  /// @param[in]  damage_region  The area that changed since the render target
+  ///                            was last presented, in frame coordinates.
+  ///
+  void SetContents(Contents contents, std::vector<SkIRect> damage_region);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that this render target already holds the contents
+  ///             for the current frame, and marks the backing store as not
+  ///             updated.
+  ///
+  void MarkContentsUnchanged();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The area that changed since the render target was last
+  ///             presented, in frame coordinates. Empty if the contents did not
+  ///             change.
+  ///
+  /// @return     The damage region.
+  ///
+  const std::vector<SkIRect>& GetDamageRegion() const;
+
  protected:
   //----------------------------------------------------------------------------
   /// @brief      Creates a render target whose backing store is managed by the
@@ -98,6 +148,10 @@ class EmbedderRenderTarget {
 
   fml::closure on_release_;
 
+  std::optional<Contents> contents_;
+
+  std::vector<SkIRect> damage_region_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTarget);
 };
 
@@ -4,9 +4,16 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t retention_frames,
+                                                     size_t max_bytes,
+                                                     int size_granularity)
+    : retention_frames_(retention_frames),
+      max_bytes_(max_bytes),
+      size_granularity_(size_granularity) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -14,59 +21,125 @@ std::pair<EmbedderRenderTargetCache::RenderTargets,
           EmbedderExternalView::ViewIdentifierSet>
 EmbedderRenderTargetCache::GetExistingTargetsInCache(
     const EmbedderExternalView::PendingViews& pending_views) {
+  frame_count_++;
+
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
-  for (const auto& view : pending_views) {
-    const auto& external_view = view.second;
-    if (!external_view->HasEngineRenderedContents()) {
-      continue;
-    }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.empty()) {
-      unmatched_identifiers.insert(view.first);
-    } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+  // Views first get back the render target they used before, which may still
+  // hold their contents. The remaining views take any render target of the
+  // right size.
+  for (bool same_view_only : {true, false}) {
+    for (const auto& view : pending_views) {
+      const auto& external_view = view.second;
+      if (resolved_render_targets.count(view.first) > 0 ||
+          !external_view->HasEngineRenderedContents()) {
+        continue;
+      }
+      const auto size =
+          GetRenderTargetSize(external_view->GetRenderSurfaceSize());
+      auto found = std::find_if(
+          cached_render_targets_.begin(), cached_render_targets_.end(),
+          [&](const CachedRenderTarget& cached) {
+            return cached.target->GetRenderTargetSize() == size &&
+                   (!same_view_only ||
+                    EmbedderExternalView::ViewIdentifier::Equal{}(
+                        cached.view_identifier, view.first));
+          });
+      if (found != cached_render_targets_.end()) {
+        resolved_render_targets[view.first] =
+            TakeRenderTarget(found - cached_render_targets_.begin());
+      } else if (!same_view_only) {
+        unmatched_identifiers.insert(view.first);
+      }
     }
   }
+  stats_->reused_count += resolved_render_targets.size();
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
-    }
+  while (!cached_render_targets_.empty()) {
+    cleared_targets.emplace(
+        TakeRenderTarget(cached_render_targets_.size() - 1));
   }
-  cached_render_targets_.clear();
+  stats_->collected_count += cleared_targets.size();
   return cleared_targets;
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::CollectUnusedRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  for (size_t i = cached_render_targets_.size(); i > 0; --i) {
+    if (frame_count_ - cached_render_targets_[i - 1].last_used_frame >
+        retention_frames_) {
+      collected_targets.emplace(TakeRenderTarget(i - 1));
+    }
+  }
+  while (max_bytes_ > 0 && stats_->cached_bytes > max_bytes_) {
+    auto oldest = std::min_element(
+        cached_render_targets_.begin(), cached_render_targets_.end(),
+        [](const CachedRenderTarget& a, const CachedRenderTarget& b) {
+          return a.last_used_frame < b.last_used_frame;
+        });
+    collected_targets.emplace(
+        TakeRenderTarget(oldest - cached_render_targets_.begin()));
+  }
+  stats_->collected_count += collected_targets.size();
+  return collected_targets;
+}
+
 void EmbedderRenderTargetCache::CacheRenderTarget(
     EmbedderExternalView::ViewIdentifier view_identifier,
     std::unique_ptr<EmbedderRenderTarget> target) {
   if (target == nullptr) {
     return;
   }
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, target->GetRenderTargetSize()};
-  cached_render_targets_[desc].push(std::move(target));
+  stats_->cached_count++;
+  stats_->cached_bytes += GetByteSize(*target);
+  cached_render_targets_.push_back({
+      .view_identifier = view_identifier,
+      .target = std::move(target),
+      .last_used_frame = frame_count_,
+  });
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
-  size_t count = 0;
-  for (const auto& targets : cached_render_targets_) {
-    count += targets.second.size();
+  return cached_render_targets_.size();
+}
+
+SkISize EmbedderRenderTargetCache::GetRenderTargetSize(
+    const SkISize& surface_size) const {
+  if (size_granularity_ <= 1) {
+    return surface_size;
   }
-  return count;
+  auto round_up = [granularity = size_granularity_](int32_t value) {
+    return (value + granularity - 1) / granularity * granularity;
+  };
+  return SkISize::Make(round_up(surface_size.width()),
+                       round_up(surface_size.height()));
+}
+
+const std::shared_ptr<EmbedderRenderTargetCache::Stats>&
+EmbedderRenderTargetCache::GetStats() const {
+  return stats_;
+}
+
+size_t EmbedderRenderTargetCache::GetByteSize(
+    const EmbedderRenderTarget& target) {
+  const auto size = target.GetRenderTargetSize();
+  return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::TakeRenderTarget(size_t index) {
+  auto target = std::move(cached_render_targets_[index].target);
+  cached_render_targets_.erase(cached_render_targets_.begin() + index);
+  stats_->cached_count--;
+  stats_->cached_bytes -= GetByteSize(*target);
+  return target;
 }
 
 }  // namespace flutter
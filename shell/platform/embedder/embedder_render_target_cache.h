@@ -5,10 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <atomic>
+#include <memory>
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
@@ -19,9 +21,46 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets that a frame did not use stay in the cache for
+///             a configurable number of frames, so that views that disappear
+///             and reappear, or sizes that come back while a window is
+///             resized, don't make the embedder create new backing stores.
+///             Sizes can also be rounded up so that small size changes
+///             reuse the same render targets.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// Counters of the render targets of the cache. They can be read on any
+  /// thread.
+  struct Stats {
+    /// The render targets that the embedder created.
+    std::atomic<size_t> created_count = 0;
+    /// The times a frame reused a render target of an earlier frame.
+    std::atomic<size_t> reused_count = 0;
+    /// The render targets that were given back to the embedder.
+    std::atomic<size_t> collected_count = 0;
+    /// The render targets currently kept for later frames.
+    std::atomic<size_t> cached_count = 0;
+    /// The estimated size of the render targets currently kept for later
+    /// frames, at four bytes per pixel.
+    std::atomic<size_t> cached_bytes = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target cache.
+  ///
+  /// @param[in]  retention_frames  The number of frames an unused render
+  ///                               target is kept for. With 0, render targets
+  ///                               are only reused by the next frame.
+  /// @param[in]  max_bytes         The maximum estimated size of the unused
+  ///                               render targets that are kept, or 0 for no
+  ///                               limit.
+  /// @param[in]  size_granularity  The multiple that render target sizes are
+  ///                               rounded up to, or 0 for exact sizes.
+  ///
+  explicit EmbedderRenderTargetCache(size_t retention_frames = 0,
+                                     size_t max_bytes = 0,
+                                     int size_granularity = 0);
 
   ~EmbedderRenderTargetCache();
 
@@ -31,6 +70,15 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::ViewIdentifier::Hash,
                          EmbedderExternalView::ViewIdentifier::Equal>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the cached render targets that the views of a new frame
+  ///             can render into. A view gets the render target it used
+  ///             before if there is one, and any render target of the right
+  ///             size otherwise.
+  ///
+  /// @return     The render targets found for the views, and the views that
+  ///             still need one.
+  ///
   std::pair<RenderTargets, EmbedderExternalView::ViewIdentifierSet>
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
@@ -38,19 +86,52 @@ class EmbedderRenderTargetCache {
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the cached render targets that have been unused for
+  ///             longer than the retention, and the ones unused for the
+  ///             longest while the cache is over its byte limit.
+  ///
+  /// @return     The removed render targets, to be given back to the
+  ///             embedder.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectUnusedRenderTargets();
+
   void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
                          std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
- private:
-  using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the render target to create for a view whose
+  ///             render surface has the given size.
+  ///
+  SkISize GetRenderTargetSize(const SkISize& surface_size) const;
 
-  CachedRenderTargets cached_render_targets_;
+  //----------------------------------------------------------------------------
+  /// @brief      The counters of the cache. The owner of the cache counts the
+  ///             render targets that it creates and that it collects without
+  ///             caching them.
+  ///
+  const std::shared_ptr<Stats>& GetStats() const;
+
+ private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderRenderTarget> target;
+    // The frame that last used the render target.
+    size_t last_used_frame = 0;
+  };
+
+  const size_t retention_frames_;
+  const size_t max_bytes_;
+  const int size_granularity_;
+  std::shared_ptr<Stats> stats_ = std::make_shared<Stats>();
+  size_t frame_count_ = 0;
+  std::vector<CachedRenderTarget> cached_render_targets_;
+
+  static size_t GetByteSize(const EmbedderRenderTarget& target);
+
+  std::unique_ptr<EmbedderRenderTarget> TakeRenderTarget(size_t index);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
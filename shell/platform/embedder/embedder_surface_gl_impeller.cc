@@ -78,8 +78,8 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
     return;
   }
 
-  impeller_context_ =
-      impeller::ContextGLES::Create(std::move(gl), shader_mappings);
+  impeller_context_ = impeller::ContextGLES::Create(
+      std::move(gl), shader_mappings, fml::UniqueFD{});
 
   if (!impeller_context_) {
     FML_LOG(ERROR) << "Could not create Impeller context.";
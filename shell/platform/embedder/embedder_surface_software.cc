@@ -20,7 +20,8 @@ EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(std::move(software_dispatch_table)),
       external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !software_dispatch_table_.software_present_backing_store_with_damage) {
     return;
   }
   valid_ = true;
@@ -39,7 +40,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(
+      this, render_to_surface, software_dispatch_table_.tile_loop);
 
   if (!surface->IsValid()) {
     return nullptr;
@@ -63,27 +65,49 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
-  if (sk_surface_ != nullptr &&
-      SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
+  sk_sp<SkSurface>& sk_surface = sk_surfaces_[current_surface_];
+  if (sk_surface != nullptr &&
+      SkISize::Make(sk_surface->width(), sk_surface->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
-    return sk_surface_;
+    return sk_surface;
   }
 
   SkImageInfo info = SkImageInfo::MakeN32(
       size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
-  sk_surface_ = SkSurfaces::Raster(info, nullptr);
+  sk_surface = SkSurfaces::Raster(info, nullptr);
+  existing_damage_[current_surface_] = std::nullopt;
 
-  if (sk_surface_ == nullptr) {
+  if (sk_surface == nullptr) {
     FML_LOG(ERROR) << "Could not create backing store for software rendering.";
     return nullptr;
   }
 
-  return sk_surface_;
+  return sk_surface;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+SurfaceFrame::FramebufferInfo
+EmbedderSurfaceSoftware::GetBackingStoreFramebufferInfo() const {
+  // The backing stores are owned by the engine and keep their contents
+  // between frames, so only the parts of a frame that changed since the
+  // backing store was last rendered into need to be rasterized.
+  SurfaceFrame::FramebufferInfo info;
+  info.supports_readback = true;
+  info.supports_partial_repaint = true;
+  info.existing_damage = existing_damage_[current_surface_];
+  return info;
 }
 
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  return PresentBackingStoreWithDamage(std::move(backing_store), std::nullopt);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<SkIRect>& frame_damage) {
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
@@ -105,11 +129,51 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  SkIRect damage = pixmap.bounds();
+  if (frame_damage.has_value() && !damage.intersect(frame_damage.value())) {
+    damage.setEmpty();
+  }
+
+  bool presented = false;
+  if (software_dispatch_table_.software_present_backing_store_with_damage) {
+    presented =
+        software_dispatch_table_.software_present_backing_store_with_damage(
+            pixmap.addr(),      //
+            pixmap.rowBytes(),  //
+            pixmap.height(),    //
+            damage              //
+        );
+  } else {
+    presented = software_dispatch_table_.software_present_backing_store(
+        pixmap.addr(),      //
+        pixmap.rowBytes(),  //
+        pixmap.height()     //
+    );
+  }
+
+  if (!presented) {
+    // The embedder may not be showing this frame, so the next frames are
+    // rasterized in full.
+    existing_damage_.fill(std::nullopt);
+    return false;
+  }
+
+  // The backing store that was presented is now up to date. Any other one
+  // also misses the changes of this frame.
+  for (size_t i = 0; i < existing_damage_.size(); i++) {
+    auto& existing_damage = existing_damage_[i];
+    if (i == current_surface_) {
+      existing_damage = SkIRect::MakeEmpty();
+    } else if (existing_damage.has_value()) {
+      existing_damage->join(damage);
+    }
+  }
+
+  if (software_dispatch_table_.double_buffered) {
+    current_surface_ = (current_surface_ + 1) % sk_surfaces_.size();
+  }
+
+  return true;
 }
 
 }  // namespace flutter
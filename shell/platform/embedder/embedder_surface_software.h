@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <array>
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -19,7 +22,17 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless the next is set
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       const SkIRect& damage)>
+        software_present_backing_store_with_damage;  // optional
+    // Render into two backing stores in turn, so that the pixels of a frame
+    // stay unchanged until the next frame has been presented.
+    bool double_buffered = false;  // optional
+    // Rasterize frames in tiles on the workers of this loop, in parallel.
+    std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -31,7 +44,12 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  private:
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
-  sk_sp<SkSurface> sk_surface_;
+  std::array<sk_sp<SkSurface>, 2> sk_surfaces_;
+  // The area of each backing store that is out of date with the last
+  // presented frame, or std::nullopt if all of it may be.
+  std::array<std::optional<SkIRect>, 2> existing_damage_;
+  // The backing store that the next frame is rendered into.
+  size_t current_surface_ = 0;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
   // |EmbedderSurface|
@@ -49,6 +67,14 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  SurfaceFrame::FramebufferInfo GetBackingStoreFramebufferInfo() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<SkIRect>& frame_damage) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
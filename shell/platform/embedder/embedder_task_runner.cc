@@ -53,6 +53,14 @@ void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
   PostTaskForTime(task, fml::TimePoint::Now() + delay);
 }
 
+void EmbedderTaskRunner::PostTaskForTimeWithPriority(
+    const fml::closure& task,
+    fml::TimePoint target_time,
+    fml::TaskPriority priority) {
+  // The embedder runs the tasks in the order of their target times.
+  PostTaskForTime(task, target_time);
+}
+
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
   return dispatch_table_.runs_task_on_current_thread_callback();
 }
@@ -82,10 +82,11 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
     const FlutterCustomTaskRunners* custom_task_runners,
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    bool pin_to_core_classes) {
   {
-    auto host =
-        CreateEmbedderManagedThreadHost(custom_task_runners, config_setter);
+    auto host = CreateEmbedderManagedThreadHost(
+        custom_task_runners, config_setter, pin_to_core_classes);
     if (host && host->IsValid()) {
       return host;
     }
@@ -96,7 +97,8 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   // configuration if the embedder attempted to specify a configuration but
   // messed up with an incorrect configuration.
   if (custom_task_runners == nullptr) {
-    auto host = CreateEngineManagedThreadHost(config_setter);
+    auto host =
+        CreateEngineManagedThreadHost(config_setter, pin_to_core_classes);
     if (host && host->IsValid()) {
       return host;
     }
@@ -125,12 +127,14 @@ fml::Thread::ThreadConfig MakeThreadConfig(
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
     const FlutterCustomTaskRunners* custom_task_runners,
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    bool pin_to_core_classes) {
   if (custom_task_runners == nullptr) {
     return nullptr;
   }
 
   auto thread_host_config = ThreadHost::ThreadHostConfig(config_setter);
+  thread_host_config.pin_to_core_classes = pin_to_core_classes;
 
   // The UI and IO threads are always created by the engine and the embedder has
   // no opportunity to specify task runners for the same.
@@ -223,9 +227,11 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEngineManagedThreadHost(
-    const flutter::ThreadConfigSetter& config_setter) {
+    const flutter::ThreadConfigSetter& config_setter,
+    bool pin_to_core_classes) {
   // Crate a thraed host config, and specified the thread name and priority.
   auto thread_host_config = ThreadHost::ThreadHostConfig(config_setter);
+  thread_host_config.pin_to_core_classes = pin_to_core_classes;
   thread_host_config.SetUIConfig(MakeThreadConfig(
       flutter::ThreadHost::UI, fml::Thread::ThreadPriority::DISPLAY));
   thread_host_config.SetRasterConfig(MakeThreadConfig(
@@ -295,4 +301,8 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+void EmbedderThreadHost::ReapplyCpuAffinity() const {
+  host_.ReapplyCpuAffinity();
+}
+
 }  // namespace flutter
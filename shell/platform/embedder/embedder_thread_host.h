@@ -23,7 +23,8 @@ class EmbedderThreadHost {
   CreateEmbedderOrEngineManagedThreadHost(
       const FlutterCustomTaskRunners* custom_task_runners,
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      bool pin_to_core_classes = false);
 
   EmbedderThreadHost(
       ThreadHost host,
@@ -38,6 +39,8 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  void ReapplyCpuAffinity() const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
@@ -46,11 +49,13 @@ class EmbedderThreadHost {
   static std::unique_ptr<EmbedderThreadHost> CreateEmbedderManagedThreadHost(
       const FlutterCustomTaskRunners* custom_task_runners,
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      bool pin_to_core_classes = false);
 
   static std::unique_ptr<EmbedderThreadHost> CreateEngineManagedThreadHost(
       const flutter::ThreadConfigSetter& config_setter =
-          fml::Thread::SetCurrentThreadName);
+          fml::Thread::SetCurrentThreadName,
+      bool pin_to_core_classes = false);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderThreadHost);
 };
@@ -3406,6 +3406,55 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycled) {
   ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
 }
 
+TEST_F(EmbedderTest, CompositorReportsBackingStoreCacheStats) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.GetCompositor().backing_store_retention_frames = 4;
+  builder.SetDartEntrypoint("render_targets_are_recycled");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(2);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 20u);
+        latch.CountDown();
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+
+  FlutterBackingStoreCacheStats stats = {};
+  stats.struct_size = sizeof(stats);
+  ASSERT_EQ(FlutterEngineGetBackingStoreCacheStats(engine.get(), &stats),
+            kSuccess);
+  // Every frame after the first reuses the backing stores of the first.
+  ASSERT_EQ(stats.created_count, 10u);
+  ASSERT_GT(stats.reused_count, 0u);
+  ASSERT_EQ(stats.collected_count, 0u);
+  ASSERT_EQ(stats.cached_count, 10u);
+  ASSERT_EQ(stats.cached_bytes, 10u * 300u * 200u * 4u);
+}
+
 TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
@@ -3475,6 +3524,70 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, CompositorDoesNotUpdateUnchangedBackingStores) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("render_targets_are_in_stable_order");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(2);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  // Every frame renders the same scene, so only the backing stores of the
+  // first frame are updated.
+  size_t frame_count = 0;
+  context.GetCompositor().SetPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 20u);
+
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type != kFlutterLayerContentTypeBackingStore) {
+            continue;
+          }
+          const FlutterRegion* damage_region =
+              layers[i]->backing_store_present_info->damage_region;
+          ASSERT_NE(damage_region, nullptr);
+          if (frame_count == 0) {
+            ASSERT_TRUE(layers[i]->backing_store->did_update);
+            ASSERT_EQ(damage_region->rects_count, 1u);
+            ASSERT_EQ(damage_region->rects[0],
+                      FlutterRectMakeLTRB(0, 0, 300, 200));
+          } else {
+            ASSERT_FALSE(layers[i]->backing_store->did_update);
+            ASSERT_EQ(damage_region->rects_count, 0u);
+          }
+        }
+
+        frame_count++;
+        if (frame_count == 20) {
+          latch.CountDown();
+        }
+      },
+      false  // one shot
+  );
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, FrameInfoContainsValidWidthAndHeight) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
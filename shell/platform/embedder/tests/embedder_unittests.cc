@@ -29,6 +29,8 @@
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -1451,6 +1453,169 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanSendThermalStateChangeNotification) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetProjectArgs().pin_threads_to_core_classes = true;
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEngineNotifyThermalStateChange(engine.get()), kSuccess);
+  ASSERT_EQ(FlutterEngineNotifyThermalStateChange(nullptr), kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanGetFrameTimingStats) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameTimingStats stats = {};
+  stats.struct_size = sizeof(FlutterFrameTimingStats);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), &stats), kSuccess);
+  ASSERT_EQ(stats.window_us, 60u * 1000u * 1000u);
+  ASSERT_LE(stats.total.p99_us, stats.total.max_us);
+  // The software renderer doesn't measure GPU time.
+  ASSERT_EQ(stats.gpu.frame_count, 0u);
+
+  stats.struct_size = 0;
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), &stats),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(nullptr, &stats),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, BackingStoreCacheStatsRequireACompositor) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterBackingStoreCacheStats stats = {};
+  stats.struct_size = sizeof(FlutterBackingStoreCacheStats);
+  ASSERT_EQ(FlutterEngineGetBackingStoreCacheStats(engine.get(), &stats),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetBackingStoreCacheStats(engine.get(), nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetBackingStoreCacheStats(nullptr, &stats),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, MustNotRunWithBothSoftwarePresentCallbacksSet) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetRendererConfig().software.surface_present_with_damage_callback =
+      [](void* context, const void* allocation, size_t row_bytes,
+         size_t height, const FlutterDamage* damage) { return true; };
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, SoftwarePresentWithDamageOnlyReceivesChangedArea) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetDartEntrypoint("render_gradient");
+  builder.GetRendererConfig().software.surface_present_callback = nullptr;
+  static fml::AutoResetWaitableEvent latch;
+  static FlutterRect last_damage;
+  builder.GetRendererConfig().software.surface_present_with_damage_callback =
+      [](void* context, const void* allocation, size_t row_bytes,
+         size_t height, const FlutterDamage* damage) {
+        EXPECT_EQ(damage->num_rects, 1u);
+        last_damage = damage->damage[0];
+        latch.Signal();
+        return true;
+      };
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  // The first frame is entirely rendered.
+  latch.Wait();
+  ASSERT_EQ(last_damage.left, 0);
+  ASSERT_EQ(last_damage.top, 0);
+  ASSERT_EQ(last_damage.right, 800);
+  ASSERT_EQ(last_damage.bottom, 600);
+
+  // The second frame is the same as the first one, so nothing changed.
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+  ASSERT_EQ(last_damage.right - last_damage.left, 0);
+  ASSERT_EQ(last_damage.bottom - last_damage.top, 0);
+}
+
+TEST_F(EmbedderTest, TiledSoftwareRasterizationMatchesUntiled) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  auto render = [&context](bool tiled_rasterization) -> sk_sp<SkImage> {
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+    builder.SetDartEntrypoint("render_gradient");
+    builder.GetRendererConfig().software.tiled_rasterization =
+        tiled_rasterization;
+
+    auto rendered_scene = context.GetNextSceneImage();
+    auto engine = builder.LaunchEngine();
+    if (!engine.is_valid()) {
+      return nullptr;
+    }
+
+    // Send a window metrics events so frames may be scheduled.
+    FlutterWindowMetricsEvent event = {};
+    event.struct_size = sizeof(event);
+    event.width = 800;
+    event.height = 600;
+    event.pixel_ratio = 1.0;
+    if (FlutterEngineSendWindowMetricsEvent(engine.get(), &event) !=
+        kSuccess) {
+      return nullptr;
+    }
+
+    // The presented image shares its pixels with the engine, so copy them
+    // before the engine goes away.
+    auto image = rendered_scene.get();
+    SkBitmap bitmap;
+    bitmap.allocPixels(image->imageInfo());
+    if (!image->readPixels(bitmap.pixmap(), 0, 0)) {
+      return nullptr;
+    }
+    bitmap.setImmutable();
+    return SkImages::RasterFromBitmap(bitmap);
+  };
+
+  auto untiled_image = render(false);
+  auto tiled_image = render(true);
+  ASSERT_NE(untiled_image, nullptr);
+  ASSERT_NE(tiled_image, nullptr);
+  ASSERT_TRUE(RasterImagesAreSame(untiled_image, tiled_image));
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
@@ -2442,6 +2607,121 @@ TEST_F(EmbedderTest, BackToBackKeyEventResponsesCorrectlyInvoked) {
   shutdown_latch.Wait();
 }
 
+TEST_F(EmbedderTest, InputEventBatchKeyResponsesAreCoalesced) {
+  UniqueEngine engine;
+  fml::AutoResetWaitableEvent sync_latch;
+  fml::AutoResetWaitableEvent ready;
+
+  // One of the threads that the callback will be posted to is the platform
+  // thread. So we cannot wait for assertions to complete on the platform
+  // thread. Create a new thread to manage the engine instance and wait for
+  // assertions on the test thread.
+  auto platform_task_runner = CreateNewThread("platform_thread");
+
+  platform_task_runner->PostTask([&]() {
+    auto& context =
+        GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig();
+    builder.SetDartEntrypoint("key_data_echo");
+    context.AddNativeCallback(
+        "SignalNativeTest",
+        CREATE_NATIVE_ENTRY(
+            [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+    context.AddNativeCallback(
+        "EchoKeyEvent", CREATE_NATIVE_ENTRY([](Dart_NativeArguments args) {}));
+
+    engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    sync_latch.Signal();
+  });
+  sync_latch.Wait();
+  ready.Wait();
+
+  // Entrypoint `key_data_echo` returns `event.synthesized` as `handled`.
+  FlutterKeyEvent synthesized_event{
+      .struct_size = sizeof(FlutterKeyEvent),
+      .timestamp = 1000,
+      .type = kFlutterKeyEventTypeDown,
+      .physical = 0x00070005,
+      .logical = 0x00000000062,
+      .character = nullptr,
+      .synthesized = true,
+  };
+  FlutterKeyEvent key_event = synthesized_event;
+  key_event.type = kFlutterKeyEventTypeUp;
+  key_event.synthesized = false;
+  FlutterPointerEvent pointer_event{
+      .struct_size = sizeof(FlutterPointerEvent),
+      .phase = kHover,
+      .timestamp = 1000,
+      .x = 10.0,
+      .y = 20.0,
+      .device_kind = kFlutterPointerDeviceKindMouse,
+  };
+
+  FlutterInputEvent first{
+      .struct_size = sizeof(FlutterInputEvent),
+      .type = kFlutterInputEventTypeKey,
+      .key = &synthesized_event,
+  };
+  FlutterInputEvent second{
+      .struct_size = sizeof(FlutterInputEvent),
+      .type = kFlutterInputEventTypePointer,
+      .pointer = &pointer_event,
+  };
+  FlutterInputEvent third{
+      .struct_size = sizeof(FlutterInputEvent),
+      .type = kFlutterInputEventTypeKey,
+      .key = &key_event,
+  };
+  const FlutterInputEvent* events[] = {&first, &second, &third};
+
+  struct BatchUserData {
+    fml::AutoResetWaitableEvent latch;
+    std::vector<bool> handled;
+    int calls = 0;
+  } user_data;
+  platform_task_runner->PostTask([&]() {
+    ASSERT_EQ(FlutterEngineSendInputEvents(
+                  engine.get(), events, 3,
+                  [](const bool* handled, size_t count, void* untyped) {
+                    auto user_data = reinterpret_cast<BatchUserData*>(untyped);
+                    user_data->handled.assign(handled, handled + count);
+                    user_data->calls++;
+                    user_data->latch.Signal();
+                  },
+                  &user_data),
+              kSuccess);
+  });
+  user_data.latch.Wait();
+
+  EXPECT_EQ(user_data.calls, 1);
+  EXPECT_EQ(user_data.handled, std::vector<bool>({true, false}));
+
+  fml::AutoResetWaitableEvent shutdown_latch;
+  platform_task_runner->PostTask([&]() {
+    // Invalid batches are rejected as a whole.
+    FlutterInputEvent invalid{
+        .struct_size = sizeof(FlutterInputEvent),
+        .type = kFlutterInputEventTypeKey,
+        .key = nullptr,
+    };
+    const FlutterInputEvent* invalid_events[] = {&first, &invalid};
+    EXPECT_EQ(FlutterEngineSendInputEvents(engine.get(), invalid_events, 2,
+                                           nullptr, nullptr),
+              kInvalidArguments);
+
+    engine.reset();
+    shutdown_latch.Signal();
+  });
+  shutdown_latch.Wait();
+  EXPECT_EQ(user_data.calls, 1);
+}
+
 //------------------------------------------------------------------------------
 // Vsync waiter
 //------------------------------------------------------------------------------
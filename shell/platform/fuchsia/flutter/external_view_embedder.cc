@@ -33,6 +33,15 @@ void DetachClipTransformChildren(
   clip_transform->children.clear();
 }
 
+bool SameTransforms(
+    const std::vector<fuchsia::ui::composition::TransformId>& a,
+    const std::vector<fuchsia::ui::composition::TransformId>& b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const auto& lhs, const auto& rhs) {
+                      return lhs.value == rhs.value;
+                    });
+}
+
 }  // namespace
 
 ExternalViewEmbedder::ExternalViewEmbedder(
@@ -44,7 +53,9 @@ ExternalViewEmbedder::ExternalViewEmbedder(
     std::shared_ptr<FlatlandConnection> flatland,
     std::shared_ptr<SurfaceProducer> surface_producer,
     bool intercept_all_input)
-    : flatland_(flatland), surface_producer_(surface_producer) {
+    : flatland_(flatland),
+      surface_producer_(surface_producer),
+      image_blend_modes_(std::make_shared<ImageBlendModes>()) {
   flatland_->flatland()->CreateView2(
       std::move(view_creation_token), std::move(view_identity),
       std::move(view_protocols), std::move(parent_viewport_watcher_request));
@@ -173,11 +184,19 @@ void ExternalViewEmbedder::SubmitFrame(
         flatland_->flatland()->CreateImage(
             {image_id}, surface->GetBufferCollectionImportToken(), 0,
             std::move(image_properties));
+        // The size of a surface never changes, so neither does the size the
+        // image is drawn at.
+        flatland_->flatland()->SetImageDestinationSize(
+            {image_id}, {static_cast<uint32_t>(size.width()),
+                         static_cast<uint32_t>(size.height())});
 
         surface->SetImageId(image_id);
-        surface->SetReleaseImageCallback([flatland = flatland_, image_id]() {
-          flatland->flatland()->ReleaseImage({image_id});
-        });
+        surface->SetReleaseImageCallback(
+            [flatland = flatland_, blend_modes = image_blend_modes_,
+             image_id]() {
+              flatland->flatland()->ReleaseImage({image_id});
+              blend_modes->erase(image_id);
+            });
       }
 
       // Enqueue fences for the next present.
@@ -209,7 +228,14 @@ void ExternalViewEmbedder::SubmitFrame(
 
     // First re-scale everything according to the DPR.
     const float inv_dpr = 1.0f / frame_dpr_;
-    flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
+    if (inv_dpr != root_scale_) {
+      flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
+      root_scale_ = inv_dpr;
+    }
+
+    // The children of the root transform, in order. They are only replaced
+    // when they differ from those of the previous frame.
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms;
 
     size_t layer_index = 0;
     for (const auto& layer_id : frame_composition_order_) {
@@ -360,9 +386,7 @@ void ExternalViewEmbedder::SubmitFrame(
             viewport.mutators.clips.empty()
                 ? viewport.transform_id
                 : viewport.clip_transforms[0].transform_id;
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        main_child_transform);
-        child_transforms_.emplace_back(main_child_transform);
+        child_transforms.emplace_back(main_child_transform);
       }
 
       // Acquire the surface associated with the layer.
@@ -393,20 +417,27 @@ void ExternalViewEmbedder::SubmitFrame(
           layers_.emplace_back(std::move(new_layer));
         }
 
-        // Update the image content and set size.
-        flatland_->flatland()->SetContent(layers_[layer_index].transform_id,
-                                          {surface_for_layer->GetImageId()});
-        flatland_->flatland()->SetImageDestinationSize(
-            {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
+        // Update the image content.
+        Layer& flatland_layer = layers_[layer_index];
+        const uint32_t image_id = surface_for_layer->GetImageId();
+        if (flatland_layer.image_id != image_id) {
+          flatland_->flatland()->SetContent(flatland_layer.transform_id,
+                                            {image_id});
+          flatland_layer.image_id = image_id;
+        }
 
         // Flutter Embedder lacks an API to detect if a layer has alpha or not.
         // For now, we assume any layer beyond the first has alpha.
-        flatland_->flatland()->SetImageBlendingFunction(
-            {surface_for_layer->GetImageId()},
+        const auto blend_mode =
             layer_index == 0 ? fuchsia::ui::composition::BlendMode::SRC
-                             : fuchsia::ui::composition::BlendMode::SRC_OVER);
+                             : fuchsia::ui::composition::BlendMode::SRC_OVER;
+        auto [blend_mode_it, inserted] =
+            image_blend_modes_->try_emplace(image_id, blend_mode);
+        if (inserted || blend_mode_it->second != blend_mode) {
+          flatland_->flatland()->SetImageBlendingFunction({image_id},
+                                                          blend_mode);
+          blend_mode_it->second = blend_mode;
+        }
 
         // Set hit regions for this layer; these hit regions correspond to the
         // portions of the layer on which skia drew content.
@@ -415,27 +446,27 @@ void ExternalViewEmbedder::SubmitFrame(
           std::list<SkRect> intersection_rects =
               layer->second.rtree->searchNonOverlappingDrawnRects(
                   SkRect::Make(layer->second.surface_size));
-
-          std::vector<fuchsia::ui::composition::HitRegion> hit_regions;
-          for (const SkRect& rect : intersection_rects) {
-            hit_regions.emplace_back();
-            auto& new_hit_region = hit_regions.back();
-            new_hit_region.region.x = rect.x();
-            new_hit_region.region.y = rect.y();
-            new_hit_region.region.width = rect.width();
-            new_hit_region.region.height = rect.height();
-            new_hit_region.hit_test =
-                fuchsia::ui::composition::HitTestInteraction::DEFAULT;
+          if (intersection_rects != flatland_layer.hit_rects) {
+            std::vector<fuchsia::ui::composition::HitRegion> hit_regions;
+            for (const SkRect& rect : intersection_rects) {
+              hit_regions.emplace_back();
+              auto& new_hit_region = hit_regions.back();
+              new_hit_region.region.x = rect.x();
+              new_hit_region.region.y = rect.y();
+              new_hit_region.region.width = rect.width();
+              new_hit_region.region.height = rect.height();
+              new_hit_region.hit_test =
+                  fuchsia::ui::composition::HitTestInteraction::DEFAULT;
+            }
+
+            flatland_->flatland()->SetHitRegions(flatland_layer.transform_id,
+                                                 std::move(hit_regions));
+            flatland_layer.hit_rects = std::move(intersection_rects);
           }
-
-          flatland_->flatland()->SetHitRegions(
-              layers_[layer_index].transform_id, std::move(hit_regions));
         }
 
         // Attach the Layer to the main scene graph.
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        layers_[layer_index].transform_id);
-        child_transforms_.emplace_back(layers_[layer_index].transform_id);
+        child_transforms.emplace_back(flatland_layer.transform_id);
       }
 
       // Reset for the next pass:
@@ -446,9 +477,31 @@ void ExternalViewEmbedder::SubmitFrame(
     // will capture all input, and any unwanted input will be reinjected into
     // embedded views.
     if (input_interceptor_transform_.has_value()) {
-      flatland_->flatland()->AddChild(root_transform_id_,
-                                      *input_interceptor_transform_);
-      child_transforms_.emplace_back(*input_interceptor_transform_);
+      child_transforms.emplace_back(*input_interceptor_transform_);
+    }
+
+    if (!SameTransforms(child_transforms, child_transforms_)) {
+      for (const auto& transform : child_transforms_) {
+        flatland_->flatland()->RemoveChild(root_transform_id_, transform);
+      }
+      for (const auto& transform : child_transforms) {
+        flatland_->flatland()->AddChild(root_transform_id_, transform);
+      }
+      child_transforms_ = std::move(child_transforms);
+    }
+
+    // Clear the images of layers that are not shown so they aren't cached
+    // unnecessarily.
+    for (auto& flatland_layer : layers_) {
+      if (flatland_layer.image_id != 0 &&
+          std::none_of(child_transforms_.begin(), child_transforms_.end(),
+                       [&flatland_layer](const auto& transform) {
+                         return transform.value ==
+                                flatland_layer.transform_id.value;
+                       })) {
+        flatland_->flatland()->SetContent(flatland_layer.transform_id, {0});
+        flatland_layer.image_id = 0;
+      }
     }
   }
 
@@ -587,17 +640,6 @@ void ExternalViewEmbedder::Reset() {
   frame_composition_order_.clear();
   frame_size_ = SkISize::Make(0, 0);
   frame_dpr_ = 1.f;
-
-  // Clear all children from root.
-  for (const auto& transform : child_transforms_) {
-    flatland_->flatland()->RemoveChild(root_transform_id_, transform);
-  }
-  child_transforms_.clear();
-
-  // Clear images on all layers so they aren't cached unnecessarily.
-  for (const auto& layer : layers_) {
-    flatland_->flatland()->SetContent(layer.transform_id, {0});
-  }
 }
 
 ExternalViewEmbedder::ViewMutators ExternalViewEmbedder::ParseMutatorStack(
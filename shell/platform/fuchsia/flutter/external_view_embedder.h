@@ -10,7 +10,9 @@
 #include <lib/fit/function.h>
 
 #include <cstdint>  // For uint32_t & uint64_t
+#include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -186,17 +188,28 @@ class ExternalViewEmbedder final : public flutter::ExternalViewEmbedder {
   struct Layer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+    // The image currently set on the transform, 0 if none.
+    uint32_t image_id = 0;
+    // The drawn rects last set as the hit regions of the transform, if any.
+    std::optional<std::list<SkRect>> hit_rects;
   };
 
+  // The blending function last set on each image, erased when the image is
+  // released.
+  using ImageBlendModes =
+      std::unordered_map<uint32_t, fuchsia::ui::composition::BlendMode>;
+
   std::shared_ptr<FlatlandConnection> flatland_;
   std::shared_ptr<SurfaceProducer> surface_producer_;
 
   fuchsia::ui::composition::ParentViewportWatcherPtr parent_viewport_watcher_;
 
   fuchsia::ui::composition::TransformId root_transform_id_;
+  float root_scale_ = 1.f;
 
   std::unordered_map<int64_t, View> views_;
   std::vector<Layer> layers_;
+  std::shared_ptr<ImageBlendModes> image_blend_modes_;
 
   std::unordered_map<EmbedderLayerId, EmbedderLayer> frame_layers_;
   std::vector<EmbedderLayerId> frame_composition_order_;
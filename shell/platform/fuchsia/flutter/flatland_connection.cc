@@ -6,6 +6,9 @@
 
 #include <zircon/status.h>
 
+#include <algorithm>
+#include <iterator>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 
@@ -48,6 +51,17 @@ FlatlandConnection::~FlatlandConnection() = default;
 void FlatlandConnection::Present() {
   TRACE_DURATION("flutter", "FlatlandConnection::Present");
   std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  if (present_waiting_for_credit_) {
+    // The frame still waiting for a credit is batched with this one into a
+    // single present, so its images never reach the screen. They can be
+    // reused as soon as the content of the last present is released.
+    TRACE_EVENT_INSTANT0("flutter", "FlatlandConnection::BatchPresent");
+    std::move(pending_present_release_fences_.begin(),
+              pending_present_release_fences_.end(),
+              std::back_inserter(previous_present_release_fences_));
+  }
+  pending_present_release_fences_ = std::move(current_present_release_fences_);
+  current_present_release_fences_.clear();
   if (threadsafe_state_.present_credits_ > 0) {
     DoPresent();
   } else {
@@ -76,7 +90,7 @@ void FlatlandConnection::DoPresent() {
   // Keeping track of the old frame's release fences and swapping ensure we set
   // the correct ones for VulkanSurface's interpretation.
   previous_present_release_fences_.clear();
-  previous_present_release_fences_.swap(current_present_release_fences_);
+  previous_present_release_fences_.swap(pending_present_release_fences_);
   acquire_fences_.clear();
 }
 
@@ -103,7 +103,10 @@ class FlatlandConnection final {
   } threadsafe_state_;
 
   std::vector<zx::event> acquire_fences_;
+  // The release fences of the frame being built, of the last frame passed to
+  // |Present|, and of the content of the last present sent to Flatland.
   std::vector<zx::event> current_present_release_fences_;
+  std::vector<zx::event> pending_present_release_fences_;
   std::vector<zx::event> previous_present_release_fences_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FlatlandConnection);
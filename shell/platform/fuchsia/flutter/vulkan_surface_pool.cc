@@ -51,6 +51,7 @@ VulkanSurfacePool::~VulkanSurfacePool() {}
 
 std::unique_ptr<VulkanSurface> VulkanSurfacePool::AcquireSurface(
     const SkISize& size) {
+  last_acquired_size_ = size;
   auto surface = GetCachedOrCreateSurface(size);
 
   if (surface == nullptr) {
@@ -81,6 +82,7 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     if (exact_match_it != available_surfaces_.end()) {
       auto acquired_surface = std::move(*exact_match_it);
       available_surfaces_.erase(exact_match_it);
+      trace_surfaces_reused_++;
       TRACE_EVENT_INSTANT0("flutter", "Exact match found");
       return acquired_surface;
     }
@@ -170,8 +172,14 @@ void VulkanSurfacePool::AgeAndCollectOldBuffers() {
   available_surfaces_.erase(
       std::remove_if(available_surfaces_.begin(), available_surfaces_.end(),
                      [&](auto& surface) {
-                       return !surface->IsValid() ||
-                              surface->AdvanceAndGetAge() >= kMaxSurfaceAge;
+                       if (!surface->IsValid()) {
+                         return true;
+                       }
+                       const size_t max_age =
+                           surface->GetSize() == last_acquired_size_
+                               ? kMaxFrameSizedSurfaceAge
+                               : kMaxSurfaceAge;
+                       return surface->AdvanceAndGetAge() >= max_age;
                      }),
       available_surfaces_.end());
   TRACE_EVENT1("flutter", "AgeAndCollect", "aged surfaces",
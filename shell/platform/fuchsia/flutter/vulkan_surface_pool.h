@@ -21,6 +21,10 @@ class VulkanSurfacePool final {
   static constexpr int kMaxSurfaces = 12;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
+  // Surfaces of the size of the last frame are kept for about a second
+  // instead, so that overlays that come and go reuse their surfaces and
+  // Flatland images instead of allocating new ones every time.
+  static constexpr int kMaxFrameSizedSurfaceAge = 60;
 
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context);
@@ -46,6 +50,7 @@ class VulkanSurfacePool final {
   std::vector<std::unique_ptr<VulkanSurface>> available_surfaces_;
   std::unordered_map<uintptr_t, std::unique_ptr<VulkanSurface>>
       pending_surfaces_;
+  SkISize last_acquired_size_ = SkISize::MakeEmpty();
 
   size_t trace_surfaces_created_ = 0;
   size_t trace_surfaces_reused_ = 0;
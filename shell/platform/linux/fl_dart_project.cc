@@ -13,6 +13,7 @@ struct _FlDartProject {
   gchar* assets_path;
   gchar* icu_data_path;
   gchar** dart_entrypoint_args;
+  gboolean enable_impeller;
 };
 
 G_DEFINE_TYPE(FlDartProject, fl_dart_project, G_TYPE_OBJECT)
@@ -114,3 +115,16 @@ G_MODULE_EXPORT void fl_dart_project_set_dart_entrypoint_arguments(
   g_clear_pointer(&self->dart_entrypoint_args, g_strfreev);
   self->dart_entrypoint_args = g_strdupv(argv);
 }
+
+G_MODULE_EXPORT void fl_dart_project_set_enable_impeller(
+    FlDartProject* self,
+    gboolean enable_impeller) {
+  g_return_if_fail(FL_IS_DART_PROJECT(self));
+  self->enable_impeller = enable_impeller;
+}
+
+G_MODULE_EXPORT gboolean fl_dart_project_get_enable_impeller(
+    FlDartProject* self) {
+  g_return_val_if_fail(FL_IS_DART_PROJECT(self), FALSE);
+  return self->enable_impeller;
+}
@@ -76,3 +76,10 @@ TEST(FlDartProjectTest, DartEntrypointArgs) {
 
   EXPECT_EQ(g_strv_length(retrieved_args), 3U);
 }
+
+TEST(FlDartProjectTest, EnableImpeller) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  EXPECT_FALSE(fl_dart_project_get_enable_impeller(project));
+  fl_dart_project_set_enable_impeller(project, TRUE);
+  EXPECT_TRUE(fl_dart_project_get_enable_impeller(project));
+}
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_renderer.h"
+
+// DRM_FORMAT_MOD_INVALID from drm_fourcc.h.
+static constexpr uint64_t kInvalidModifier = (1ull << 56) - 1;
+
+typedef struct {
+  int64_t id;
+  GLuint texture_id;
+} FlDmabufTexturePrivate;
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(FlDmabufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmabufTexture))
+
+// Implements FlTexture::set_id
+static void fl_dmabuf_texture_set_id(FlTexture* texture, int64_t id) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  priv->id = id;
+}
+
+// Implements FlTexture::get_id
+static int64_t fl_dmabuf_texture_get_id(FlTexture* texture) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  return priv->id;
+}
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {
+  iface->set_id = fl_dmabuf_texture_set_id;
+  iface->get_id = fl_dmabuf_texture_get_id;
+}
+
+static void fl_dmabuf_texture_dispose(GObject* object) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(object);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  if (priv->texture_id) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->dispose(object);
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dmabuf_texture_dispose;
+}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {}
+
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  int fd = -1;
+  uint32_t fourcc = 0, offset = 0, stride = 0;
+  uint64_t modifier = kInvalidModifier;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->get_dmabuf(
+          self, &fd, &fourcc, &modifier, &offset, &stride, &width, &height,
+          error)) {
+    return FALSE;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY ||
+      !epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "DMA-buf import is not supported by the EGL display");
+    return FALSE;
+  }
+
+  EGLint attributes[17];
+  int n_attributes = 0;
+  auto add_attribute = [&](EGLint name, EGLint value) {
+    attributes[n_attributes++] = name;
+    attributes[n_attributes++] = value;
+  };
+  add_attribute(EGL_WIDTH, width);
+  add_attribute(EGL_HEIGHT, height);
+  add_attribute(EGL_LINUX_DRM_FOURCC_EXT, fourcc);
+  add_attribute(EGL_DMA_BUF_PLANE0_FD_EXT, fd);
+  add_attribute(EGL_DMA_BUF_PLANE0_OFFSET_EXT, offset);
+  add_attribute(EGL_DMA_BUF_PLANE0_PITCH_EXT, stride);
+  if (modifier != kInvalidModifier &&
+      epoxy_has_egl_extension(display,
+                              "EGL_EXT_image_dma_buf_import_modifiers")) {
+    add_attribute(EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT, modifier & 0xffffffff);
+    add_attribute(EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT, modifier >> 32);
+  }
+  attributes[n_attributes] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to import DMA-buf: EGL error %x", eglGetError());
+    return FALSE;
+  }
+
+  if (priv->texture_id == 0) {
+    glGenTextures(1, &priv->texture_id);
+    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  } else {
+    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+  }
+  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
+
+  // The texture keeps the buffer alive, the image is no longer needed.
+  eglDestroyImageKHR(display, image);
+
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = priv->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = width;
+  opengl_texture->height = height;
+
+  return TRUE;
+}
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/egl.h>
+
+static constexpr uint32_t kBufferWidth = 4u;
+static constexpr uint32_t kBufferHeight = 4u;
+static constexpr uint32_t kRealBufferWidth = 2u;
+static constexpr uint32_t kRealBufferHeight = 2u;
+
+G_DECLARE_FINAL_TYPE(FlTestDmabufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmabufTexture)
+
+/// A texture with a fixed buffer.
+struct _FlTestDmabufTexture {
+  FlDmabufTexture parent_instance;
+
+  int fd;
+};
+
+G_DEFINE_TYPE(FlTestDmabufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_get_dmabuf(FlDmabufTexture* texture,
+                                                  int* fd,
+                                                  uint32_t* fourcc,
+                                                  uint64_t* modifier,
+                                                  uint32_t* offset,
+                                                  uint32_t* stride,
+                                                  uint32_t* width,
+                                                  uint32_t* height,
+                                                  GError** error) {
+  EXPECT_TRUE(FL_IS_TEST_DMABUF_TEXTURE(texture));
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+
+  EXPECT_EQ(*width, kBufferWidth);
+  EXPECT_EQ(*height, kBufferHeight);
+  *fd = self->fd;
+  *fourcc = 0x34325241;  // DRM_FORMAT_ARGB8888
+  *offset = 0;
+  *stride = kRealBufferWidth * 4;
+  *width = kRealBufferWidth;
+  *height = kRealBufferHeight;
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmabufTextureClass* klass) {
+  FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf =
+      fl_test_dmabuf_texture_get_dmabuf;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmabufTexture* self) {}
+
+static FlTestDmabufTexture* fl_test_dmabuf_texture_new(int fd) {
+  FlTestDmabufTexture* texture = FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+  texture->fd = fd;
+  return texture;
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmabufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dmabuf_texture_new(3));
+  fl_texture_set_id(texture, 42);
+  EXPECT_EQ(fl_texture_get_id(texture), static_cast<int64_t>(42));
+}
+
+// Test that importing a buffer into an OpenGL texture works.
+TEST(FlDmabufTextureTest, PopulateTexture) {
+  eglInitialize(eglGetDisplay(EGL_DEFAULT_DISPLAY), nullptr, nullptr);
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(3));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+}
+
+// Test that a buffer that can't be imported is reported.
+TEST(FlDmabufTextureTest, PopulateInvalidBuffer) {
+  eglInitialize(eglGetDisplay(EGL_DEFAULT_DISPLAY), nullptr, nullptr);
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(-1));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_NE(error, nullptr);
+}
@@ -425,6 +425,19 @@ TEST(FlEngineTest, SwitchesEmpty) {
   EXPECT_EQ(switches->len, 0U);
 }
 
+TEST(FlEngineTest, SwitchesEnableImpeller) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  fl_dart_project_set_enable_impeller(project, TRUE);
+  g_autoptr(FlEngine) engine = make_mock_engine_with_project(project);
+
+  unsetenv("FLUTTER_ENGINE_SWITCHES");
+
+  g_autoptr(GPtrArray) switches = fl_engine_get_switches(engine);
+  ASSERT_EQ(switches->len, 1U);
+  EXPECT_STREQ(static_cast<const char*>(g_ptr_array_index(switches, 0)),
+               "--enable-impeller");
+}
+
 TEST(FlEngineTest, SendWindowStateEvent) {
   g_autoptr(FlEngine) engine = make_mock_engine();
   FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
@@ -126,11 +126,42 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context) {
   return GTK_WIDGET(area);
 }
 
-void fl_gl_area_queue_render(FlGLArea* self, GPtrArray* textures) {
+void fl_gl_area_queue_render(FlGLArea* self,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_GL_AREA(self));
 
+  // The damage is only known relative to the last frame when both frames show
+  // the same single layer. Otherwise layers may have moved or disappeared.
+  gboolean same_layer = self->textures != nullptr && self->textures->len == 1 &&
+                        textures->len == 1 &&
+                        g_ptr_array_index(self->textures, 0) ==
+                            g_ptr_array_index(textures, 0);
+
   g_clear_pointer(&self->textures, g_ptr_array_unref);
   self->textures = g_ptr_array_ref(textures);
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  if (damage == nullptr || !same_layer) {
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+    return;
+  }
+
+  // Convert to widget coordinates, covering every partially damaged point.
+  gint scale = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  cairo_region_t* region = cairo_region_create();
+  int n_rectangles = cairo_region_num_rectangles(damage);
+  for (int i = 0; i < n_rectangles; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+    int x1 = rect.x / scale;
+    int y1 = rect.y / scale;
+    int x2 = (rect.x + rect.width + scale - 1) / scale;
+    int y2 = (rect.y + rect.height + scale - 1) / scale;
+    cairo_rectangle_int_t widget_rect = {x1, y1, x2 - x1, y2 - y1};
+    cairo_region_union_rectangle(region, &widget_rect);
+  }
+  if (!cairo_region_is_empty(region)) {
+    gtk_widget_queue_draw_region(GTK_WIDGET(self), region);
+  }
+  cairo_region_destroy(region);
 }
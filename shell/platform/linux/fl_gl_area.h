@@ -34,10 +34,15 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context);
  * @area: an #FlGLArea.
  * @textures: (transfer none) (element-type FlBackingStoreProvider): a list of
  * #FlBackingStoreProvider.
+ * @damage: (allow-none): the area that changed since the last textures were
+ * queued, in physical pixels, or %NULL to redraw everything.
  *
- * Queues textures to be drawn later.
+ * Queues textures to be drawn later. If the same single texture is drawn
+ * again only @damage is redrawn, so an unchanged frame costs no copy at all.
  */
-void fl_gl_area_queue_render(FlGLArea* area, GPtrArray* textures);
+void fl_gl_area_queue_render(FlGLArea* area,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage);
 
 G_END_DECLS
 
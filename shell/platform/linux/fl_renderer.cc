@@ -27,6 +27,9 @@ typedef struct {
   // was rendered
   bool had_first_frame;
 
+  // true if the GL contexts are created for OpenGL ES
+  bool use_gles;
+
   GdkGLContext* main_context;
   GdkGLContext* resource_context;
 } FlRendererPrivate;
@@ -65,6 +68,11 @@ gboolean fl_renderer_start(FlRenderer* self, FlView* view, GError** error) {
       self, GTK_WIDGET(view), &priv->main_context, &priv->resource_context,
       error);
 
+  if (result && priv->use_gles) {
+    gdk_gl_context_set_use_es(priv->main_context, TRUE);
+    gdk_gl_context_set_use_es(priv->resource_context, TRUE);
+  }
+
   if (result) {
     gdk_gl_context_realize(priv->main_context, error);
     gdk_gl_context_realize(priv->resource_context, error);
@@ -76,6 +84,13 @@ gboolean fl_renderer_start(FlRenderer* self, FlView* view, GError** error) {
   return TRUE;
 }
 
+void fl_renderer_set_use_gles(FlRenderer* self, gboolean use_gles) {
+  g_return_if_fail(FL_IS_RENDERER(self));
+  FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
+      fl_renderer_get_instance_private(self));
+  priv->use_gles = use_gles;
+}
+
 FlView* fl_renderer_get_view(FlRenderer* self) {
   FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
       fl_renderer_get_instance_private(self));
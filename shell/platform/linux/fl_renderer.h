@@ -112,6 +112,16 @@ struct _FlRendererClass {
  */
 gboolean fl_renderer_start(FlRenderer* renderer, FlView* view, GError** error);
 
+/**
+ * fl_renderer_set_use_gles:
+ * @renderer: an #FlRenderer.
+ * @use_gles: %TRUE to create OpenGL ES contexts.
+ *
+ * Sets whether the GL contexts are created for OpenGL ES instead of desktop
+ * OpenGL, as required by Impeller. Must be called before fl_renderer_start().
+ */
+void fl_renderer_set_use_gles(FlRenderer* renderer, gboolean use_gles);
+
 /**
  * fl_renderer_get_view:
  * @renderer: an #FlRenderer.
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/linux/fl_renderer_gl.h"
 
+#include <cmath>
+
 #include "flutter/shell/platform/linux/fl_backing_store_provider.h"
 #include "flutter/shell/platform/linux/fl_view_private.h"
 
@@ -99,6 +101,27 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     return FALSE;
   }
 
+  // A single layer is drawn straight from its backing store, so only the part
+  // of it that Flutter changed needs to be copied into the window.
+  cairo_region_t* damage = nullptr;
+  if (layers_count == 1 &&
+      layers[0]->type == kFlutterLayerContentTypeBackingStore &&
+      layers[0]->backing_store_present_info != nullptr &&
+      layers[0]->backing_store_present_info->damage_region != nullptr) {
+    const FlutterRegion* region =
+        layers[0]->backing_store_present_info->damage_region;
+    damage = cairo_region_create();
+    for (size_t i = 0; i < region->rects_count; i++) {
+      const FlutterRect& rect = region->rects[i];
+      cairo_rectangle_int_t damage_rect = {
+          static_cast<int>(floor(rect.left)),
+          static_cast<int>(floor(rect.top)),
+          static_cast<int>(ceil(rect.right) - floor(rect.left)),
+          static_cast<int>(ceil(rect.bottom) - floor(rect.top))};
+      cairo_region_union_rectangle(damage, &damage_rect);
+    }
+  }
+
   g_autoptr(GPtrArray) textures = g_ptr_array_new();
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
@@ -115,7 +138,8 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     }
   }
 
-  fl_view_set_textures(view, context, textures);
+  fl_view_set_textures(view, context, textures, damage);
+  g_clear_pointer(&damage, cairo_region_destroy);
 
   return TRUE;
 }
@@ -243,7 +243,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value = fl_value_new_typed_list_from_bytes(FL_VALUE_TYPE_UINT8_LIST,
+                                                      buffer, *offset, length);
   *offset += length;
   return value;
 }
@@ -266,8 +267,8 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_INT32_LIST, buffer, *offset, length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -290,8 +291,8 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_INT64_LIST, buffer, *offset, length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -314,8 +315,8 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_FLOAT32_LIST, buffer, *offset, length);
   *offset += sizeof(float) * length;
   return value;
 }
@@ -338,8 +339,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_FLOAT_LIST, buffer, *offset, length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -409,7 +410,7 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
   g_autoptr(GByteArray) buffer = g_byte_array_new();
-  if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
+  if (!fl_standard_message_codec_write_message(self, buffer, message, error)) {
     return nullptr;
   }
   return g_byte_array_free_to_bytes(
@@ -460,6 +461,16 @@ G_MODULE_EXPORT FlStandardMessageCodec* fl_standard_message_codec_new() {
       g_object_new(fl_standard_message_codec_get_type(), nullptr));
 }
 
+G_MODULE_EXPORT gboolean fl_standard_message_codec_write_message(
+    FlStandardMessageCodec* self,
+    GByteArray* buffer,
+    FlValue* message,
+    GError** error) {
+  g_return_val_if_fail(FL_IS_STANDARD_CODEC(self), FALSE);
+  g_return_val_if_fail(buffer != nullptr, FALSE);
+  return fl_standard_message_codec_write_value(self, buffer, message, error);
+}
+
 void fl_standard_message_codec_write_size(FlStandardMessageCodec* codec,
                                           GByteArray* buffer,
                                           uint32_t size) {
@@ -460,6 +460,19 @@ TEST(FlStandardMessageCodecTest, DecodeInt32List) {
   EXPECT_EQ(data[4], 4);
 }
 
+TEST(FlStandardMessageCodecTest, DecodeInt32ListReferencesMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GBytes) data =
+      hex_string_to_bytes("0905000000000000ffffffff02000000fdffffff04000000");
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), data, &error);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT32_LIST);
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(fl_value_get_int32_list(value)),
+            static_cast<const uint8_t*>(g_bytes_get_data(data, nullptr)) + 4);
+}
+
 TEST(FlStandardMessageCodecTest, DecodeInt32ListNoData) {
   decode_error_value("09", FL_MESSAGE_CODEC_ERROR,
                      FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
@@ -1102,3 +1115,28 @@ TEST(FlStandardMessageCodecTest, EncodeDecode) {
 
   ASSERT_TRUE(fl_value_equal(input, output));
 }
+
+TEST(FlStandardMessageCodecTest, WriteMessageReusesBuffer) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_new();
+
+  g_autoptr(FlValue) value1 = fl_value_new_string("hello");
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(
+      fl_standard_message_codec_write_message(codec, buffer, value1, &error));
+  EXPECT_EQ(error, nullptr);
+  g_autoptr(GBytes) message1 = g_bytes_new(buffer->data, buffer->len);
+  g_autofree gchar* hex1 = bytes_to_hex_string(message1);
+  EXPECT_STREQ(hex1, "070568656c6c6f");
+
+  g_byte_array_set_size(buffer, 0);
+  int32_t data[] = {1, 2};
+  g_autoptr(FlValue) value2 = fl_value_new_int32_list(data, 2);
+  EXPECT_TRUE(
+      fl_standard_message_codec_write_message(codec, buffer, value2, &error));
+  EXPECT_EQ(error, nullptr);
+  g_autoptr(GBytes) message2 = g_bytes_new(buffer->data, buffer->len);
+  g_autofree gchar* hex2 = bytes_to_hex_string(message2);
+  g_autofree gchar* expected = encode_message(value2);
+  EXPECT_STREQ(hex2, expected);
+}
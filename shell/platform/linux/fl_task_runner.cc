@@ -17,7 +17,11 @@ struct _FlTaskRunner {
   GCond cond;
 
   guint timeout_source_id;
-  GList /*<FlTaskRunnerTask>*/* pending_tasks;
+  // absolute time the timeout source was scheduled for
+  gint64 timeout_time_micros;
+  // tasks sorted by time, tasks with the same time in the order they were
+  // posted
+  GQueue /*<FlTaskRunnerTask>*/ pending_tasks;
   gboolean blocking_main_thread;
 };
 
@@ -29,36 +33,44 @@ typedef struct _FlTaskRunnerTask {
 
 G_DEFINE_TYPE(FlTaskRunner, fl_task_runner, G_TYPE_OBJECT)
 
+// Orders tasks by time. Tasks with the same time stay in the order they were
+// posted.
+static gint compare_task_time(gconstpointer a,
+                              gconstpointer b,
+                              gpointer user_data) {
+  const FlTaskRunnerTask* queued_task =
+      static_cast<const FlTaskRunnerTask*>(a);
+  const FlTaskRunnerTask* new_task = static_cast<const FlTaskRunnerTask*>(b);
+  return queued_task->task_time_micros <= new_task->task_time_micros ? -1 : 1;
+}
+
 // Removes expired tasks from the task queue and executes them.
 // The execution is performed with mutex unlocked.
 static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
-  GList* expired_tasks = nullptr;
+  GQueue expired_tasks = G_QUEUE_INIT;
 
   gint64 current_time = g_get_monotonic_time();
 
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    if (task->task_time_micros <= current_time) {
-      GList* link = l;
-      l = l->next;
-      self->pending_tasks = g_list_remove_link(self->pending_tasks, link);
-      expired_tasks = g_list_concat(expired_tasks, link);
-    } else {
-      l = l->next;
+  // The queue is sorted, so the expired tasks are at its head.
+  while (!g_queue_is_empty(&self->pending_tasks)) {
+    FlTaskRunnerTask* task =
+        static_cast<FlTaskRunnerTask*>(g_queue_peek_head(&self->pending_tasks));
+    if (task->task_time_micros > current_time) {
+      break;
     }
+    g_queue_push_tail(&expired_tasks, g_queue_pop_head(&self->pending_tasks));
   }
 
   g_mutex_unlock(&self->mutex);
 
-  l = expired_tasks;
-  while (l != nullptr && self->engine) {
+  for (GList* l = expired_tasks.head; l != nullptr && self->engine;
+       l = l->next) {
     FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
     fl_engine_execute_task(self->engine, &task->task);
-    l = l->next;
   }
 
-  g_list_free_full(expired_tasks, g_free);
+  g_queue_foreach(&expired_tasks, reinterpret_cast<GFunc>(g_free), nullptr);
+  g_queue_clear(&expired_tasks);
 
   g_mutex_lock(&self->mutex);
 }
@@ -90,14 +102,9 @@ static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
 // g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
 static gint64 fl_task_runner_next_task_expiration_time_locked(
     FlTaskRunner* self) {
-  gint64 min_time = G_MAXINT64;
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    min_time = MIN(min_time, task->task_time_micros);
-    l = l->next;
-  }
-  return min_time;
+  FlTaskRunnerTask* task =
+      static_cast<FlTaskRunnerTask*>(g_queue_peek_head(&self->pending_tasks));
+  return task != nullptr ? task->task_time_micros : G_MAXINT64;
 }
 
 static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
@@ -105,17 +112,22 @@ static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
     // Wake up blocked thread
     g_cond_signal(&self->cond);
   } else {
-    // Reschedule timeout
+    // Reschedule timeout, unless it is already scheduled for the next task.
+    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
+    if (self->timeout_source_id != 0 &&
+        self->timeout_time_micros == min_time) {
+      return;
+    }
     if (self->timeout_source_id != 0) {
       g_source_remove(self->timeout_source_id);
       self->timeout_source_id = 0;
     }
-    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
     if (min_time != G_MAXINT64) {
       gint64 remaining = MAX(min_time - g_get_monotonic_time(), 0);
       self->timeout_source_id =
           g_timeout_add(remaining / kMillisecondsPerMicrosecond + 1,
                         fl_task_runner_on_expired_timeout, self);
+      self->timeout_time_micros = min_time;
     }
   }
 }
@@ -141,7 +153,9 @@ void fl_task_runner_dispose(GObject* object) {
   g_mutex_clear(&self->mutex);
   g_cond_clear(&self->cond);
 
-  g_list_free_full(self->pending_tasks, g_free);
+  g_queue_foreach(&self->pending_tasks, reinterpret_cast<GFunc>(g_free),
+                  nullptr);
+  g_queue_clear(&self->pending_tasks);
   if (self->timeout_source_id != 0) {
     g_source_remove(self->timeout_source_id);
   }
@@ -156,6 +170,7 @@ static void fl_task_runner_class_init(FlTaskRunnerClass* klass) {
 static void fl_task_runner_init(FlTaskRunner* self) {
   g_mutex_init(&self->mutex);
   g_cond_init(&self->cond);
+  g_queue_init(&self->pending_tasks);
 }
 
 FlTaskRunner* fl_task_runner_new(FlEngine* engine) {
@@ -177,7 +192,17 @@ void fl_task_runner_post_task(FlTaskRunner* self,
   runner_task->task_time_micros =
       target_time_nanos / kMicrosecondsPerNanosecond;
 
-  self->pending_tasks = g_list_append(self->pending_tasks, runner_task);
+  // Most tasks are posted to run as soon as possible, after the tasks already
+  // queued, so check the tail before searching the queue.
+  FlTaskRunnerTask* last_task =
+      static_cast<FlTaskRunnerTask*>(g_queue_peek_tail(&self->pending_tasks));
+  if (last_task == nullptr ||
+      last_task->task_time_micros <= runner_task->task_time_micros) {
+    g_queue_push_tail(&self->pending_tasks, runner_task);
+  } else {
+    g_queue_insert_sorted(&self->pending_tasks, runner_task, compare_task_time,
+                          nullptr);
+  }
   fl_task_runner_tasks_did_change_locked(self);
 }
 
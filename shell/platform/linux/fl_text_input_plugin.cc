@@ -6,6 +6,8 @@
 
 #include <gtk/gtk.h>
 
+#include <utility>
+
 #include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/common/text_input_model.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_json_method_codec.h"
@@ -262,7 +264,9 @@ static void im_preedit_start_cb(FlTextInputPlugin* self) {
 static void im_preedit_changed_cb(FlTextInputPlugin* self) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
+  // Only deltas carry the text before the change.
+  std::string text_before_change =
+      priv->enable_delta_model ? priv->text_model->GetText() : std::string();
   flutter::TextRange composing_before_change =
       priv->text_model->composing_range();
   g_autofree gchar* buf = nullptr;
@@ -278,9 +282,8 @@ static void im_preedit_changed_cb(FlTextInputPlugin* self) {
   priv->text_model->SetSelection(flutter::TextRange(cursor_offset));
 
   if (priv->enable_delta_model) {
-    std::string text(buf);
     flutter::TextEditingDelta delta = flutter::TextEditingDelta(
-        text_before_change, composing_before_change, text);
+        std::move(text_before_change), composing_before_change, buf);
     update_editing_state_with_delta(self, &delta);
   } else {
     update_editing_state(self);
@@ -291,7 +294,8 @@ static void im_preedit_changed_cb(FlTextInputPlugin* self) {
 static void im_commit_cb(FlTextInputPlugin* self, const gchar* text) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
+  std::string text_before_change =
+      priv->enable_delta_model ? priv->text_model->GetText() : std::string();
   flutter::TextRange composing_before_change =
       priv->text_model->composing_range();
   flutter::TextRange selection_before_change = priv->text_model->selection();
@@ -306,8 +310,8 @@ static void im_commit_cb(FlTextInputPlugin* self, const gchar* text) {
     flutter::TextRange replace_range =
         was_composing ? composing_before_change : selection_before_change;
     std::unique_ptr<flutter::TextEditingDelta> delta =
-        std::make_unique<flutter::TextEditingDelta>(text_before_change,
-                                                    replace_range, text);
+        std::make_unique<flutter::TextEditingDelta>(
+            std::move(text_before_change), replace_range, text);
     update_editing_state_with_delta(self, delta.get());
   } else {
     update_editing_state(self);
@@ -7,6 +7,7 @@
 #include <gmodule.h>
 
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_texture_gl_private.h"
@@ -93,7 +94,8 @@ static gboolean register_texture(FlTextureRegistrar* registrar,
                                  FlTexture* texture) {
   FlTextureRegistrarImpl* self = FL_TEXTURE_REGISTRAR_IMPL(registrar);
 
-  if (FL_IS_TEXTURE_GL(texture) || FL_IS_PIXEL_BUFFER_TEXTURE(texture)) {
+  if (FL_IS_TEXTURE_GL(texture) || FL_IS_PIXEL_BUFFER_TEXTURE(texture) ||
+      FL_IS_DMABUF_TEXTURE(texture)) {
     if (self->engine == nullptr) {
       return FALSE;
     }
@@ -115,7 +117,8 @@ static gboolean register_texture(FlTextureRegistrar* registrar,
       return FALSE;
     }
   } else {
-    // We currently only support #FlTextureGL and #FlPixelBufferTexture.
+    // We currently only support #FlTextureGL, #FlPixelBufferTexture and
+    // #FlDmabufTexture.
     return FALSE;
   }
 }
@@ -37,30 +37,40 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // The buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // The buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // The buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  // The buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // The buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -289,10 +299,8 @@ G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  return fl_value_new_typed_list_from_bytes(FL_VALUE_TYPE_UINT8_LIST, data, 0,
+                                            g_bytes_get_size(data));
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
@@ -335,6 +343,100 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_typed_list_from_bytes(FlValueType type,
+                                                            GBytes* data,
+                                                            size_t offset,
+                                                            size_t length) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+
+  size_t element_size;
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      element_size = sizeof(uint8_t);
+      break;
+    case FL_VALUE_TYPE_INT32_LIST:
+      element_size = sizeof(int32_t);
+      break;
+    case FL_VALUE_TYPE_INT64_LIST:
+      element_size = sizeof(int64_t);
+      break;
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      element_size = sizeof(float);
+      break;
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      element_size = sizeof(double);
+      break;
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+  g_return_val_if_fail(offset + length * element_size <= g_bytes_get_size(data),
+                       nullptr);
+
+  const uint8_t* d =
+      static_cast<const uint8_t*>(g_bytes_get_data(data, nullptr)) + offset;
+
+  // Elements that are not aligned in @data can't be referenced, so copy them.
+  if (reinterpret_cast<uintptr_t>(d) % element_size != 0) {
+    switch (type) {
+      case FL_VALUE_TYPE_INT32_LIST:
+        return fl_value_new_int32_list(reinterpret_cast<const int32_t*>(d),
+                                       length);
+      case FL_VALUE_TYPE_INT64_LIST:
+        return fl_value_new_int64_list(reinterpret_cast<const int64_t*>(d),
+                                       length);
+      case FL_VALUE_TYPE_FLOAT32_LIST:
+        return fl_value_new_float32_list(reinterpret_cast<const float*>(d),
+                                         length);
+      default:
+        return fl_value_new_float_list(reinterpret_cast<const double*>(d),
+                                       length);
+    }
+  }
+
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+          fl_value_new(type, sizeof(FlValueUint8List)));
+      self->values = const_cast<uint8_t*>(d);
+      self->values_length = length;
+      self->bytes = g_bytes_ref(data);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
+          fl_value_new(type, sizeof(FlValueInt32List)));
+      self->values = reinterpret_cast<int32_t*>(const_cast<uint8_t*>(d));
+      self->values_length = length;
+      self->bytes = g_bytes_ref(data);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
+          fl_value_new(type, sizeof(FlValueInt64List)));
+      self->values = reinterpret_cast<int64_t*>(const_cast<uint8_t*>(d));
+      self->values_length = length;
+      self->bytes = g_bytes_ref(data);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_FLOAT32_LIST: {
+      FlValueFloat32List* self = reinterpret_cast<FlValueFloat32List*>(
+          fl_value_new(type, sizeof(FlValueFloat32List)));
+      self->values = reinterpret_cast<float*>(const_cast<uint8_t*>(d));
+      self->values_length = length;
+      self->bytes = g_bytes_ref(data);
+      return reinterpret_cast<FlValue*>(self);
+    }
+    default: {
+      FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+          fl_value_new(type, sizeof(FlValueFloatList)));
+      self->values = reinterpret_cast<double*>(const_cast<uint8_t*>(d));
+      self->values_length = length;
+      self->bytes = g_bytes_ref(data);
+      return reinterpret_cast<FlValue*>(self);
+    }
+  }
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
@@ -366,6 +468,15 @@ G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
   return self;
 }
 
+// Frees the elements of a typed list, or releases the buffer they are in.
+static void free_list_values(void* values, GBytes* bytes) {
+  if (bytes != nullptr) {
+    g_bytes_unref(bytes);
+  } else {
+    g_free(values);
+  }
+}
+
 G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
   g_return_if_fail(self != nullptr);
   g_return_if_fail(self->ref_count > 0);
@@ -382,27 +493,27 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      free_list_values(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -260,6 +260,49 @@ TEST(FlValueTest, Uint8ListToString) {
   EXPECT_STREQ(text, "[0, 1, 254, 255]");
 }
 
+TEST(FlValueTest, Uint8ListFromBytes) {
+  uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  EXPECT_EQ(fl_value_get_uint8_list(value),
+            g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(fl_value_get_uint8_list(value)[2], 0xFE);
+}
+
+TEST(FlValueTest, TypedListFromBytesKeepsBytes) {
+  int32_t data[] = {7, 0, -1, G_MAXINT32};
+  GBytes* bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(FlValue) value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_INT32_LIST, bytes, sizeof(int32_t), 3);
+  g_bytes_unref(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT32_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  EXPECT_EQ(fl_value_get_int32_list(value)[0], 0);
+  EXPECT_EQ(fl_value_get_int32_list(value)[1], -1);
+  EXPECT_EQ(fl_value_get_int32_list(value)[2], G_MAXINT32);
+}
+
+TEST(FlValueTest, TypedListFromBytesUnaligned) {
+  uint8_t data[] = {0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, 9);
+  g_autoptr(FlValue) value = fl_value_new_typed_list_from_bytes(
+      FL_VALUE_TYPE_INT64_LIST, bytes, 1, 1);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT64_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(1));
+  EXPECT_EQ(fl_value_get_int64_list(value)[0], 1);
+}
+
+TEST(FlValueTest, TypedListFromBytesEqual) {
+  double data[] = {1.0, -0.5};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(FlValue) value1 =
+      fl_value_new_typed_list_from_bytes(FL_VALUE_TYPE_FLOAT_LIST, bytes, 0, 2);
+  g_autoptr(FlValue) value2 = fl_value_new_float_list(data, 2);
+  EXPECT_TRUE(fl_value_equal(value1, value2));
+}
+
 TEST(FlValueTest, Int32List) {
   int32_t data[] = {0, -1, G_MAXINT32, G_MININT32};
   g_autoptr(FlValue) value = fl_value_new_int32_list(data, 4);
@@ -556,6 +556,8 @@ static void fl_view_constructed(GObject* object) {
   FlView* self = FL_VIEW(object);
 
   self->renderer = FL_RENDERER(fl_renderer_gl_new());
+  fl_renderer_set_use_gles(self->renderer,
+                           fl_dart_project_get_enable_impeller(self->project));
   self->engine = fl_engine_new(self->project, self->renderer);
   fl_engine_set_update_semantics_node_handler(
       self->engine, update_semantics_node_cb, self, nullptr);
@@ -748,7 +750,8 @@ G_MODULE_EXPORT FlEngine* fl_view_get_engine(FlView* self) {
 
 void fl_view_set_textures(FlView* self,
                           GdkGLContext* context,
-                          GPtrArray* textures) {
+                          GPtrArray* textures,
+                          const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_VIEW(self));
 
   if (self->gl_area == nullptr) {
@@ -758,7 +761,7 @@ void fl_view_set_textures(FlView* self,
                       GTK_WIDGET(self->gl_area));
   }
 
-  fl_gl_area_queue_render(self->gl_area, textures);
+  fl_gl_area_queue_render(self->gl_area, textures, damage);
 }
 
 GHashTable* fl_view_get_keyboard_state(FlView* self) {
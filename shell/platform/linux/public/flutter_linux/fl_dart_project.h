@@ -128,6 +128,30 @@ void fl_dart_project_set_dart_entrypoint_arguments(FlDartProject* project,
  */
 gchar** fl_dart_project_get_dart_entrypoint_arguments(FlDartProject* project);
 
+/**
+ * fl_dart_project_set_enable_impeller:
+ * @project: an #FlDartProject.
+ * @enable_impeller: %TRUE to render with Impeller.
+ *
+ * Sets whether Flutter renders with Impeller instead of Skia. Impeller
+ * compiles its shaders ahead of time, so animations don't stutter the first
+ * time they run. Impeller renders with OpenGL ES, so the GL contexts of
+ * #FlView are created for OpenGL ES. This must be set before the project is
+ * used to create an #FlView or #FlEngine. By default this is %FALSE.
+ */
+void fl_dart_project_set_enable_impeller(FlDartProject* project,
+                                         gboolean enable_impeller);
+
+/**
+ * fl_dart_project_get_enable_impeller:
+ * @project: an #FlDartProject.
+ *
+ * Gets whether Flutter renders with Impeller instead of Skia.
+ *
+ * Returns: %TRUE if Impeller is enabled.
+ */
+gboolean fl_dart_project_get_enable_impeller(FlDartProject* project);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DART_PROJECT_H_
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <gmodule.h>
+#include <stdint.h>
+
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+G_MODULE_EXPORT
+G_DECLARE_DERIVABLE_TYPE(FlDmabufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture represents an OpenGL texture imported from a Linux DMA-buf,
+ * such as a decoded video frame or a camera capture. The buffer is imported
+ * through an EGLImage and sampled in place, so no pixels are copied.
+ *
+ * Importing requires an EGL display that supports the
+ * EGL_EXT_image_dma_buf_import extension. The buffer must contain a single
+ * plane in an RGB DRM format such as DRM_FORMAT_ARGB8888 or
+ * DRM_FORMAT_XBGR8888.
+ *
+ * The following example shows how to implement an #FlDmabufTexture.
+ * ![<!-- language="C" -->
+ *   struct _MyTexture {
+ *     FlDmabufTexture parent_instance;
+ *
+ *     MyFrame *frame;  // your current frame.
+ *   }
+ *
+ *   G_DEFINE_TYPE(MyTexture,
+ *                 my_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   my_texture_get_dmabuf (FlDmabufTexture* texture,
+ *                          int* fd,
+ *                          uint32_t* fourcc,
+ *                          uint64_t* modifier,
+ *                          uint32_t* offset,
+ *                          uint32_t* stride,
+ *                          uint32_t* width,
+ *                          uint32_t* height,
+ *                          GError** error) {
+ *     // This method is called on Render Thread. Be careful with your
+ *     // cross-thread operation.
+ *     MyTexture *self = MY_TEXTURE (texture);
+ *
+ *     *fd = self->frame->fd;
+ *     *fourcc = DRM_FORMAT_ARGB8888;
+ *     *modifier = self->frame->modifier;
+ *     *offset = 0;
+ *     *stride = self->frame->stride;
+ *     *width = self->frame->width;
+ *     *height = self->frame->height;
+ *     return TRUE;
+ *   }
+ *
+ *   static void my_texture_class_init(MyTextureClass* klass) {
+ *     FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf = my_texture_get_dmabuf;
+ *   }
+ *
+ *   static void my_texture_init(MyTexture* self) {}
+ * ]|
+ */
+
+struct _FlDmabufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmabufTexture::get_dmabuf:
+   * @texture: an #FlDmabufTexture.
+   * @fd: (out): file descriptor of the DMA-buf.
+   * @fourcc: (out): DRM format of the buffer.
+   * @modifier: (out): DRM format modifier of the buffer, or
+   * DRM_FORMAT_MOD_INVALID if the buffer has an implicit modifier.
+   * @offset: (out): offset in bytes of the pixels in the buffer.
+   * @stride: (out): number of bytes between two rows of pixels.
+   * @width: (inout): width of the texture in pixels.
+   * @height: (inout): height of the texture in pixels.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Retrieves the DMA-buf that holds the current frame of the texture.
+   *
+   * As this method is usually invoked from the render thread, you must
+   * take care of proper synchronization. The texture keeps referencing the
+   * buffer after @fd is imported, so the producer must not write to the buffer
+   * again until this method has returned a different one. The file descriptor
+   * is not closed by Flutter.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*get_dmabuf)(FlDmabufTexture* texture,
+                         int* fd,
+                         uint32_t* fourcc,
+                         uint64_t* modifier,
+                         uint32_t* offset,
+                         uint32_t* stride,
+                         uint32_t* width,
+                         uint32_t* height,
+                         GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
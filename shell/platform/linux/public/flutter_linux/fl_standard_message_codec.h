@@ -45,6 +45,26 @@ G_DECLARE_FINAL_TYPE(FlStandardMessageCodec,
  */
 FlStandardMessageCodec* fl_standard_message_codec_new();
 
+/**
+ * fl_standard_message_codec_write_message:
+ * @codec: an #FlStandardMessageCodec.
+ * @buffer: buffer to write into.
+ * @message: message to encode or %NULL to encode the null value.
+ * @error: (allow-none): #GError location to store the error occurring, or
+ * %NULL.
+ *
+ * Encodes a message and appends it to @buffer. Unlike
+ * fl_message_codec_encode_message() this doesn't allocate a new buffer for
+ * each message, so @buffer can be reused for many messages by clearing it with
+ * g_byte_array_set_size().
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_standard_message_codec_write_message(FlStandardMessageCodec* codec,
+                                                 GByteArray* buffer,
+                                                 FlValue* message,
+                                                 GError** error);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_STANDARD_MESSAGE_CODEC_H_
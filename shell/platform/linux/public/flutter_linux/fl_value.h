@@ -153,13 +153,34 @@ FlValue* fl_value_new_uint8_list(const uint8_t* value, size_t value_length);
  * fl_value_new_uint8_list_from_bytes:
  * @value: a #GBytes.
  *
- * Creates an ordered list containing 8 bit unsigned integers. The data is
- * copied. The equivalent Dart type is a Uint8List.
+ * Creates an ordered list containing 8 bit unsigned integers. The data is not
+ * copied, the #FlValue keeps a reference to @value instead. The equivalent
+ * Dart type is a Uint8List.
  *
  * Returns: a new #FlValue.
  */
 FlValue* fl_value_new_uint8_list_from_bytes(GBytes* value);
 
+/**
+ * fl_value_new_typed_list_from_bytes:
+ * @type: the type of list to create, one of #FL_VALUE_TYPE_UINT8_LIST,
+ * #FL_VALUE_TYPE_INT32_LIST, #FL_VALUE_TYPE_INT64_LIST,
+ * #FL_VALUE_TYPE_FLOAT32_LIST or #FL_VALUE_TYPE_FLOAT_LIST.
+ * @value: a #GBytes.
+ * @offset: the offset in bytes of the first element in @value.
+ * @value_length: number of elements to use from @value.
+ *
+ * Creates an ordered list of numbers stored in a part of @value. The data is
+ * not copied, the #FlValue keeps a reference to @value instead. If the
+ * elements are not aligned in memory the data is copied.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_typed_list_from_bytes(FlValueType type,
+                                            GBytes* value,
+                                            size_t offset,
+                                            size_t value_length);
+
 /**
  * fl_value_new_int32_list:
  * @value: an array of signed 32 bit integers.
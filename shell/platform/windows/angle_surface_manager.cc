@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <dxgi.h>
+
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -16,6 +19,26 @@ static void LogEglError(std::string message) {
   FML_LOG(ERROR) << "EGL: eglGetError returned " << error;
 }
 
+// Returns true if |display| supports the EGL extension |name|.
+static bool HasDisplayExtension(EGLDisplay display, const char* name) {
+  const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions == nullptr) {
+    return false;
+  }
+
+  // Extension names are separated by spaces and may be prefixes of others.
+  size_t length = strlen(name);
+  for (const char* match = strstr(extensions, name); match != nullptr;
+       match = strstr(match + length, name)) {
+    bool starts = match == extensions || match[-1] == ' ';
+    bool ends = match[length] == ' ' || match[length] == '\0';
+    if (starts && ends) {
+      return true;
+    }
+  }
+  return false;
+}
+
 namespace flutter {
 
 int AngleSurfaceManager::instance_count_ = 0;
@@ -191,9 +214,34 @@ bool AngleSurfaceManager::Initialize(bool enable_impeller) {
     return false;
   }
 
+  direct_composition_supported_ =
+      HasDisplayExtension(egl_display_, "EGL_ANGLE_direct_composition");
+  fixed_size_resize_supported_ =
+      HasDisplayExtension(egl_display_, "EGL_ANGLE_window_fixed_size");
+  if (HasDisplayExtension(egl_display_, "EGL_NV_post_sub_buffer")) {
+    egl_post_sub_buffer_NV_ = reinterpret_cast<PFNEGLPOSTSUBBUFFERNVPROC>(
+        eglGetProcAddress("eglPostSubBufferNV"));
+  }
+
+  LimitFrameLatency();
+
   return true;
 }
 
+void AngleSurfaceManager::LimitFrameLatency() {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  Microsoft::WRL::ComPtr<IDXGIDevice1> dxgi_device;
+  if (!GetDevice(device.GetAddressOf()) || FAILED(device.As(&dxgi_device))) {
+    return;
+  }
+
+  // The default of three queued frames adds up to two frames of latency
+  // between rendering and presentation.
+  if (FAILED(dxgi_device->SetMaximumFrameLatency(1))) {
+    FML_LOG(ERROR) << "Failed to set the maximum frame latency";
+  }
+}
+
 void AngleSurfaceManager::CleanUp() {
   EGLBoolean result = EGL_FALSE;
 
@@ -238,15 +286,36 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   }
 
   EGLSurface surface = EGL_NO_SURFACE;
+  EGLNativeWindowType window =
+      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target));
+
+  std::vector<EGLint> surface_attributes = {
+      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width, EGL_HEIGHT, height};
+  if (egl_post_sub_buffer_NV_) {
+    surface_attributes.push_back(EGL_POST_SUB_BUFFER_SUPPORTED_NV);
+    surface_attributes.push_back(EGL_TRUE);
+  }
 
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  // Prefer presenting through a DirectComposition visual. Its flip model
+  // swapchain hands buffers to the compositor instead of copying them, and
+  // supports presenting only the damaged part of a frame.
+  if (direct_composition_supported_) {
+    std::vector<EGLint> direct_composition_attributes = surface_attributes;
+    direct_composition_attributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    direct_composition_attributes.push_back(EGL_TRUE);
+    direct_composition_attributes.push_back(EGL_NONE);
+    surface = eglCreateWindowSurface(egl_display_, egl_config_, window,
+                                     direct_composition_attributes.data());
+    if (surface == EGL_NO_SURFACE) {
+      LogEglError("DirectComposition surface creation failed.");
+    }
+  }
 
-  surface = eglCreateWindowSurface(
-      egl_display_, egl_config_,
-      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+  if (surface == EGL_NO_SURFACE) {
+    surface_attributes.push_back(EGL_NONE);
+    surface = eglCreateWindowSurface(egl_display_, egl_config_, window,
+                                     surface_attributes.data());
+  }
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
     return false;
@@ -270,6 +339,21 @@ void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
     surface_width_ = width;
     surface_height_ = height;
 
+    // Resize the swapchain buffers in place if possible. This spares the
+    // raster thread from releasing the context and recreating the surface.
+    // ANGLE applies the new size of a fixed size surface on its next swap,
+    // so swap an empty rectangle to apply it without presenting anything.
+    if (render_surface_ != EGL_NO_SURFACE && fixed_size_resize_supported_ &&
+        egl_post_sub_buffer_NV_ &&
+        eglSurfaceAttrib(egl_display_, render_surface_, EGL_WIDTH, width) ==
+            EGL_TRUE &&
+        eglSurfaceAttrib(egl_display_, render_surface_, EGL_HEIGHT, height) ==
+            EGL_TRUE &&
+        egl_post_sub_buffer_NV_(egl_display_, render_surface_, 0, 0, 0, 0) ==
+            EGL_TRUE) {
+      return;
+    }
+
     ClearContext();
     DestroySurface();
     if (!CreateSurface(render_target, width, height, vsync_enabled)) {
@@ -319,6 +403,28 @@ EGLBoolean AngleSurfaceManager::SwapBuffers() {
   return (eglSwapBuffers(egl_display_, render_surface_));
 }
 
+EGLBoolean AngleSurfaceManager::SwapBuffersWithDamage(const RECT& damage) {
+  bool full_damage = damage.left <= 0 && damage.top <= 0 &&
+                     damage.right >= surface_width_ &&
+                     damage.bottom >= surface_height_;
+  if (!egl_post_sub_buffer_NV_ || full_damage) {
+    return SwapBuffers();
+  }
+
+  // Nothing changed, so the last presented frame is still current.
+  if (damage.right <= damage.left || damage.bottom <= damage.top) {
+    return EGL_TRUE;
+  }
+
+  // ANGLE passes the rectangle to IDXGISwapChain1::Present1 as a dirty
+  // rectangle, which lets the compositor only update that part of the window.
+  // The rectangle is specified relative to the bottom left corner.
+  return egl_post_sub_buffer_NV_(egl_display_, render_surface_, damage.left,
+                                 surface_height_ - damage.bottom,
+                                 damage.right - damage.left,
+                                 damage.bottom - damage.top);
+}
+
 EGLSurface AngleSurfaceManager::CreateSurfaceFromHandle(
     EGLenum handle_type,
     EGLClientBuffer handle,
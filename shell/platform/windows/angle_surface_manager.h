@@ -71,6 +71,12 @@ class AngleSurfaceManager {
   // not null.
   EGLBoolean SwapBuffers();
 
+  // Presents only the |damage| rectangle, in physical pixels relative to the
+  // top left corner of the surface. The rest of the back buffer must not have
+  // changed since the last present. Falls back to a full swap if partial
+  // presentation is not supported.
+  virtual EGLBoolean SwapBuffersWithDamage(const RECT& damage);
+
   // Creates a |EGLSurface| from the provided handle.
   EGLSurface CreateSurfaceFromHandle(EGLenum handle_type,
                                      EGLClientBuffer handle,
@@ -101,6 +107,10 @@ class AngleSurfaceManager {
       const EGLint* config,
       bool should_log);
 
+  // Limits the number of frames queued on the D3D device to one, so that the
+  // presented frame is at most one v-blank behind the rendered one.
+  void LimitFrameLatency();
+
   // EGL representation of native display.
   EGLDisplay egl_display_;
 
@@ -125,6 +135,17 @@ class AngleSurfaceManager {
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
 
+  // Whether ANGLE can present surfaces through a DirectComposition visual,
+  // which uses a flip model swapchain instead of a blt model one.
+  bool direct_composition_supported_ = false;
+
+  // Whether fixed size surfaces can be resized in place.
+  bool fixed_size_resize_supported_ = false;
+
+  // Presents part of a surface, or null if EGL_NV_post_sub_buffer is not
+  // supported.
+  PFNEGLPOSTSUBBUFFERNVPROC egl_post_sub_buffer_NV_ = nullptr;
+
   // The current D3D device.
   Microsoft::WRL::ComPtr<ID3D11Device> resolved_device_;
 
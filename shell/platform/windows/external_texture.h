@@ -33,6 +33,7 @@ struct GlProcs {
   glBindTextureProc glBindTexture;
   glTexParameteriProc glTexParameteri;
   glTexImage2DProc glTexImage2D;
+  glTexSubImage2DProc glTexSubImage2D;
   bool valid;
 };
 
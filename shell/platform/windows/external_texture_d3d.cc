@@ -4,16 +4,30 @@
 
 #include "flutter/shell/platform/windows/external_texture_d3d.h"
 
+#include <iterator>
+
 #include "flutter/fml/logging.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 
 namespace flutter {
 
+namespace {
+
+// The number of surfaces that stay opened. Video decoders usually cycle
+// through a small pool of surfaces, which can then be sampled without being
+// opened again for every frame.
+constexpr size_t kMaxCachedSurfaces = 8;
+
+// The key used to acquire and release the keyed mutex of a surface.
+constexpr UINT64 kKeyedMutexKey = 0;
+
+}  // namespace
+
 ExternalTextureD3d::ExternalTextureD3d(
     FlutterDesktopGpuSurfaceType type,
     const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
     void* user_data,
-    const AngleSurfaceManager* surface_manager,
+    AngleSurfaceManager* surface_manager,
     const GlProcs& gl_procs)
     : type_(type),
       texture_callback_(texture_callback),
@@ -22,11 +36,11 @@ ExternalTextureD3d::ExternalTextureD3d(
       gl_(gl_procs) {}
 
 ExternalTextureD3d::~ExternalTextureD3d() {
-  ReleaseImage();
-
-  if (gl_texture_ != 0) {
-    gl_.glDeleteTextures(1, &gl_texture_);
+  ReleaseSampledSurface();
+  for (Surface& surface : surfaces_) {
+    ReleaseSurface(&surface);
   }
+  ReleaseVideoProcessor();
 }
 
 bool ExternalTextureD3d::PopulateTexture(size_t width,
@@ -34,86 +48,330 @@ bool ExternalTextureD3d::PopulateTexture(size_t width,
                                          FlutterOpenGLTexture* opengl_texture) {
   const FlutterDesktopGpuSurfaceDescriptor* descriptor =
       texture_callback_(width, height, user_data_);
+  if (descriptor == nullptr ||
+      SAFE_ACCESS(descriptor, handle, nullptr) == nullptr) {
+    return false;
+  }
 
-  if (!CreateOrUpdateTexture(descriptor)) {
+  Surface* surface = GetSurface(descriptor);
+
+  auto release_callback = SAFE_ACCESS(descriptor, release_callback, nullptr);
+  if (release_callback) {
+    release_callback(SAFE_ACCESS(descriptor, release_context, nullptr));
+  }
+
+  if (surface == nullptr) {
     return false;
   }
 
+  bool acquired = false;
+  if (surface != sampled_surface_ && surface->keyed_mutex) {
+    // Don't stall the raster thread while the producer is still writing to
+    // the surface. Keep showing the last frame instead.
+    if (surface->keyed_mutex->AcquireSync(kKeyedMutexKey, 0) != S_OK) {
+      *opengl_texture = last_texture_;
+      return last_texture_.name != 0;
+    }
+    acquired = true;
+  }
+
+  GLuint name;
+  if (surface->is_yuv) {
+    // The conversion copies the surface, so it can be released right away.
+    bool converted = ConvertYuvSurface(surface);
+    if (acquired) {
+      surface->keyed_mutex->ReleaseSync(kKeyedMutexKey);
+    }
+    if (!converted) {
+      return false;
+    }
+    ReleaseSampledSurface();
+    name = output_gl_texture_;
+  } else {
+    if (surface != sampled_surface_) {
+      ReleaseSampledSurface();
+      sampled_surface_ = surface;
+    }
+    name = surface->gl_texture;
+  }
+
   // Populate the texture object used by the engine.
   opengl_texture->target = GL_TEXTURE_2D;
-  opengl_texture->name = gl_texture_;
+  opengl_texture->name = name;
   opengl_texture->format = GL_RGBA8_OES;
   opengl_texture->destruction_callback = nullptr;
   opengl_texture->user_data = nullptr;
   opengl_texture->width = SAFE_ACCESS(descriptor, visible_width, 0);
   opengl_texture->height = SAFE_ACCESS(descriptor, visible_height, 0);
+  last_texture_ = *opengl_texture;
 
   return true;
 }
 
-void ExternalTextureD3d::ReleaseImage() {
-  if (egl_surface_ != EGL_NO_SURFACE) {
-    eglReleaseTexImage(surface_manager_->egl_display(), egl_surface_,
-                       EGL_BACK_BUFFER);
-    eglDestroySurface(surface_manager_->egl_display(), egl_surface_);
-    egl_surface_ = EGL_NO_SURFACE;
+ExternalTextureD3d::Surface* ExternalTextureD3d::GetSurface(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  void* handle = SAFE_ACCESS(descriptor, handle, nullptr);
+  for (auto it = surfaces_.begin(); it != surfaces_.end(); ++it) {
+    if (it->handle == handle) {
+      surfaces_.splice(surfaces_.begin(), surfaces_, it);
+      return &surfaces_.front();
+    }
+  }
+
+  Surface surface;
+  surface.handle = handle;
+  if (OpenTexture(&surface)) {
+    D3D11_TEXTURE2D_DESC description;
+    surface.d3d_texture->GetDesc(&description);
+    surface.is_yuv = description.Format == DXGI_FORMAT_NV12 ||
+                     description.Format == DXGI_FORMAT_P010;
+
+    // Synchronize with the producer if it shares the surface through a keyed
+    // mutex.
+    surface.d3d_texture.As(&surface.keyed_mutex);
+  }
+
+  EGLint width = static_cast<EGLint>(SAFE_ACCESS(descriptor, width, 0));
+  EGLint height = static_cast<EGLint>(SAFE_ACCESS(descriptor, height, 0));
+  if (!surface.is_yuv) {
+    bool bound =
+        surface.d3d_texture
+            ? BindTexture(EGL_D3D_TEXTURE_ANGLE, surface.d3d_texture.Get(),
+                          width, height, &surface.egl_surface,
+                          &surface.gl_texture)
+            : BindTexture(EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE, handle, width,
+                          height, &surface.egl_surface, &surface.gl_texture);
+    if (!bound) {
+      ReleaseSurface(&surface);
+      return nullptr;
+    }
+  }
+
+  surfaces_.push_front(std::move(surface));
+
+  // Close the least recently used surface that isn't being sampled.
+  if (surfaces_.size() > kMaxCachedSurfaces) {
+    auto evicted = std::prev(surfaces_.end());
+    if (&*evicted == sampled_surface_) {
+      evicted = std::prev(evicted);
+    }
+    ReleaseSurface(&*evicted);
+    surfaces_.erase(evicted);
   }
+
+  return &surfaces_.front();
 }
 
-bool ExternalTextureD3d::CreateOrUpdateTexture(
-    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
-  if (descriptor == nullptr ||
-      SAFE_ACCESS(descriptor, handle, nullptr) == nullptr) {
-    ReleaseImage();
+bool ExternalTextureD3d::OpenTexture(Surface* surface) {
+  if (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D) {
+    surface->d3d_texture = static_cast<ID3D11Texture2D*>(surface->handle);
+    return true;
+  }
+
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!surface_manager_->GetDevice(device.GetAddressOf())) {
     return false;
   }
+  return SUCCEEDED(device->OpenSharedResource(
+      static_cast<HANDLE>(surface->handle),
+      IID_PPV_ARGS(surface->d3d_texture.GetAddressOf())));
+}
 
-  if (gl_texture_ == 0) {
-    gl_.glGenTextures(1, &gl_texture_);
+bool ExternalTextureD3d::BindTexture(EGLenum handle_type,
+                                     EGLClientBuffer buffer,
+                                     EGLint width,
+                                     EGLint height,
+                                     EGLSurface* egl_surface,
+                                     GLuint* gl_texture) {
+  EGLint attributes[] = {EGL_WIDTH,
+                         width,
+                         EGL_HEIGHT,
+                         height,
+                         EGL_TEXTURE_TARGET,
+                         EGL_TEXTURE_2D,
+                         EGL_TEXTURE_FORMAT,
+                         EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
+                         EGL_NONE};
 
-    gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
-    gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  } else {
-    gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
-  }
-
-  auto handle = SAFE_ACCESS(descriptor, handle, nullptr);
-  if (handle != last_surface_handle_) {
-    ReleaseImage();
-
-    EGLint attributes[] = {
-        EGL_WIDTH,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, width, 0)),
-        EGL_HEIGHT,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, height, 0)),
-        EGL_TEXTURE_TARGET,
-        EGL_TEXTURE_2D,
-        EGL_TEXTURE_FORMAT,
-        EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
-        EGL_NONE};
-
-    egl_surface_ = surface_manager_->CreateSurfaceFromHandle(
-        (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D)
-            ? EGL_D3D_TEXTURE_ANGLE
-            : EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE,
-        handle, attributes);
-
-    if (egl_surface_ == EGL_NO_SURFACE ||
-        eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
-                        EGL_BACK_BUFFER) == EGL_FALSE) {
-      FML_LOG(ERROR) << "Binding D3D surface failed.";
+  *egl_surface = surface_manager_->CreateSurfaceFromHandle(handle_type, buffer,
+                                                           attributes);
+  if (*egl_surface == EGL_NO_SURFACE) {
+    FML_LOG(ERROR) << "Creating D3D surface failed.";
+    return false;
+  }
+
+  gl_.glGenTextures(1, gl_texture);
+  gl_.glBindTexture(GL_TEXTURE_2D, *gl_texture);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  if (eglBindTexImage(surface_manager_->egl_display(), *egl_surface,
+                      EGL_BACK_BUFFER) == EGL_FALSE) {
+    FML_LOG(ERROR) << "Binding D3D surface failed.";
+    return false;
+  }
+  return true;
+}
+
+bool ExternalTextureD3d::ConvertYuvSurface(Surface* surface) {
+  if (!video_device_) {
+    Microsoft::WRL::ComPtr<ID3D11Device> device;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+    if (!surface_manager_->GetDevice(device.GetAddressOf()) ||
+        FAILED(device.As(&video_device_))) {
+      FML_LOG(ERROR) << "The D3D device does not support video processing.";
+      return false;
+    }
+    device->GetImmediateContext(context.GetAddressOf());
+    if (FAILED(context.As(&video_context_))) {
+      FML_LOG(ERROR) << "The D3D device does not support video processing.";
+      video_device_.Reset();
+      return false;
     }
-    last_surface_handle_ = handle;
   }
 
-  auto release_callback = SAFE_ACCESS(descriptor, release_callback, nullptr);
-  if (release_callback) {
-    release_callback(SAFE_ACCESS(descriptor, release_context, nullptr));
+  D3D11_TEXTURE2D_DESC description;
+  surface->d3d_texture->GetDesc(&description);
+  if (!video_processor_ || description.Width != output_width_ ||
+      description.Height != output_height_) {
+    if (!CreateVideoProcessor(description.Width, description.Height)) {
+      return false;
+    }
+  }
+
+  if (!surface->input_view) {
+    D3D11_VIDEO_PROCESSOR_INPUT_VIEW_DESC input_view_description = {};
+    input_view_description.ViewDimension = D3D11_VPIV_DIMENSION_TEXTURE2D;
+    if (FAILED(video_device_->CreateVideoProcessorInputView(
+            surface->d3d_texture.Get(), video_enumerator_.Get(),
+            &input_view_description, surface->input_view.GetAddressOf()))) {
+      FML_LOG(ERROR) << "Creating the video processor input failed.";
+      return false;
+    }
+  }
+
+  D3D11_VIDEO_PROCESSOR_STREAM stream = {};
+  stream.Enable = TRUE;
+  stream.pInputSurface = surface->input_view.Get();
+  if (FAILED(video_context_->VideoProcessorBlt(
+          video_processor_.Get(), output_view_.Get(), 0, 1, &stream))) {
+    FML_LOG(ERROR) << "Converting the YUV surface failed.";
+    return false;
+  }
+  return true;
+}
+
+bool ExternalTextureD3d::CreateVideoProcessor(UINT width, UINT height) {
+  ReleaseVideoProcessor();
+
+  D3D11_VIDEO_PROCESSOR_CONTENT_DESC content_description = {};
+  content_description.InputFrameFormat = D3D11_VIDEO_FRAME_FORMAT_PROGRESSIVE;
+  content_description.InputWidth = width;
+  content_description.InputHeight = height;
+  content_description.OutputWidth = width;
+  content_description.OutputHeight = height;
+  content_description.Usage = D3D11_VIDEO_USAGE_PLAYBACK_NORMAL;
+  if (FAILED(video_device_->CreateVideoProcessorEnumerator(
+          &content_description, video_enumerator_.GetAddressOf())) ||
+      FAILED(video_device_->CreateVideoProcessor(
+          video_enumerator_.Get(), 0, video_processor_.GetAddressOf()))) {
+    FML_LOG(ERROR) << "Creating the video processor failed.";
+    ReleaseVideoProcessor();
+    return false;
+  }
+
+  // Decoded video is usually limited range BT.709.
+  D3D11_VIDEO_PROCESSOR_COLOR_SPACE input_color_space = {};
+  input_color_space.YCbCr_Matrix = 1;
+  input_color_space.Nominal_Range = D3D11_VIDEO_PROCESSOR_NOMINAL_RANGE_16_235;
+  video_context_->VideoProcessorSetStreamColorSpace(video_processor_.Get(), 0,
+                                                    &input_color_space);
+  D3D11_VIDEO_PROCESSOR_COLOR_SPACE output_color_space = {};
+  video_context_->VideoProcessorSetOutputColorSpace(video_processor_.Get(),
+                                                    &output_color_space);
+
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  surface_manager_->GetDevice(device.GetAddressOf());
+  D3D11_TEXTURE2D_DESC output_description = {};
+  output_description.Width = width;
+  output_description.Height = height;
+  output_description.MipLevels = 1;
+  output_description.ArraySize = 1;
+  output_description.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+  output_description.SampleDesc.Count = 1;
+  output_description.Usage = D3D11_USAGE_DEFAULT;
+  output_description.BindFlags =
+      D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+  D3D11_VIDEO_PROCESSOR_OUTPUT_VIEW_DESC output_view_description = {};
+  output_view_description.ViewDimension = D3D11_VPOV_DIMENSION_TEXTURE2D;
+  if (FAILED(device->CreateTexture2D(&output_description, nullptr,
+                                     output_texture_.GetAddressOf())) ||
+      FAILED(video_device_->CreateVideoProcessorOutputView(
+          output_texture_.Get(), video_enumerator_.Get(),
+          &output_view_description, output_view_.GetAddressOf()))) {
+    FML_LOG(ERROR) << "Creating the video processor output failed.";
+    ReleaseVideoProcessor();
+    return false;
+  }
+
+  if (!BindTexture(EGL_D3D_TEXTURE_ANGLE, output_texture_.Get(), width, height,
+                   &output_egl_surface_, &output_gl_texture_)) {
+    ReleaseVideoProcessor();
+    return false;
+  }
+
+  output_width_ = width;
+  output_height_ = height;
+  return true;
+}
+
+void ExternalTextureD3d::ReleaseVideoProcessor() {
+  if (output_egl_surface_ != EGL_NO_SURFACE) {
+    eglReleaseTexImage(surface_manager_->egl_display(), output_egl_surface_,
+                       EGL_BACK_BUFFER);
+    eglDestroySurface(surface_manager_->egl_display(), output_egl_surface_);
+    output_egl_surface_ = EGL_NO_SURFACE;
+  }
+  if (output_gl_texture_ != 0) {
+    gl_.glDeleteTextures(1, &output_gl_texture_);
+    output_gl_texture_ = 0;
+  }
+
+  // Input views are tied to the enumerator of the processor.
+  for (Surface& surface : surfaces_) {
+    surface.input_view.Reset();
+  }
+  output_view_.Reset();
+  output_texture_.Reset();
+  video_processor_.Reset();
+  video_enumerator_.Reset();
+  output_width_ = 0;
+  output_height_ = 0;
+}
+
+void ExternalTextureD3d::ReleaseSurface(Surface* surface) {
+  if (surface == sampled_surface_) {
+    ReleaseSampledSurface();
+  }
+  if (surface->egl_surface != EGL_NO_SURFACE) {
+    eglReleaseTexImage(surface_manager_->egl_display(), surface->egl_surface,
+                       EGL_BACK_BUFFER);
+    eglDestroySurface(surface_manager_->egl_display(), surface->egl_surface);
+    surface->egl_surface = EGL_NO_SURFACE;
+  }
+  if (surface->gl_texture != 0) {
+    gl_.glDeleteTextures(1, &surface->gl_texture);
+    surface->gl_texture = 0;
+  }
+}
+
+void ExternalTextureD3d::ReleaseSampledSurface() {
+  if (sampled_surface_ && sampled_surface_->keyed_mutex) {
+    sampled_surface_->keyed_mutex->ReleaseSync(kKeyedMutexKey);
   }
-  return egl_surface_ != EGL_NO_SURFACE;
+  sampled_surface_ = nullptr;
 }
 
 }  // namespace flutter
@@ -5,6 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 
+#include <d3d11.h>
+#include <dxgi.h>
+#include <wrl/client.h>
+
+#include <list>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 #include "flutter/shell/platform/windows/external_texture.h"
@@ -18,7 +24,7 @@ class ExternalTextureD3d : public ExternalTexture {
       FlutterDesktopGpuSurfaceType type,
       const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
       void* user_data,
-      const AngleSurfaceManager* surface_manager,
+      AngleSurfaceManager* surface_manager,
       const GlProcs& gl_procs);
   virtual ~ExternalTextureD3d();
 
@@ -28,21 +34,88 @@ class ExternalTextureD3d : public ExternalTexture {
                        FlutterOpenGLTexture* opengl_texture) override;
 
  private:
-  // Creates or updates the backing texture and associates it with the provided
-  // surface.
-  bool CreateOrUpdateTexture(
-      const FlutterDesktopGpuSurfaceDescriptor* descriptor);
-  // Detaches the previously attached surface, if any.
-  void ReleaseImage();
+  // A D3D surface provided by the texture callback that has been bound to an
+  // OpenGL texture.
+  struct Surface {
+    // The handle of the surface in the descriptor.
+    void* handle = nullptr;
+
+    // The surface opened on ANGLE's device.
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> d3d_texture;
+
+    // The keyed mutex of the surface, if it was created with one.
+    Microsoft::WRL::ComPtr<IDXGIKeyedMutex> keyed_mutex;
+
+    // Whether the surface is in the NV12 or P010 format.
+    bool is_yuv = false;
+
+    // The video processor input of YUV surfaces.
+    Microsoft::WRL::ComPtr<ID3D11VideoProcessorInputView> input_view;
+
+    // The pbuffer wrapping the surface and the OpenGL texture it is bound to.
+    // Unused for NV12 and P010 surfaces, which are converted to RGB first.
+    EGLSurface egl_surface = EGL_NO_SURFACE;
+    GLuint gl_texture = 0;
+  };
+
+  // Returns the cached surface for the descriptor's handle, opening it if it
+  // hasn't been seen before. Returns nullptr if the surface can't be opened.
+  Surface* GetSurface(const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+
+  // Opens the D3D texture of |surface| on ANGLE's device.
+  bool OpenTexture(Surface* surface);
+
+  // Wraps |buffer| in an EGL pbuffer bound to a new OpenGL texture.
+  bool BindTexture(EGLenum handle_type,
+                   EGLClientBuffer buffer,
+                   EGLint width,
+                   EGLint height,
+                   EGLSurface* egl_surface,
+                   GLuint* gl_texture);
+
+  // Converts the YUV |surface| to the RGB output texture on the GPU.
+  bool ConvertYuvSurface(Surface* surface);
+
+  // Creates the video processor and output texture for YUV surfaces of the
+  // given size.
+  bool CreateVideoProcessor(UINT width, UINT height);
+
+  // Releases the video processor, its output and input views.
+  void ReleaseVideoProcessor();
+
+  // Releases the pbuffer, OpenGL texture and keyed mutex of |surface|.
+  void ReleaseSurface(Surface* surface);
+
+  // Releases the keyed mutex of the surface sampled by the engine, if any.
+  void ReleaseSampledSurface();
 
   FlutterDesktopGpuSurfaceType type_;
   const FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
   void* const user_data_;
-  const AngleSurfaceManager* surface_manager_;
+  AngleSurfaceManager* surface_manager_;
   const GlProcs& gl_;
-  GLuint gl_texture_ = 0;
-  EGLSurface egl_surface_ = EGL_NO_SURFACE;
-  void* last_surface_handle_ = nullptr;
+
+  // Surfaces opened for recent handles, the most recently used first.
+  std::list<Surface> surfaces_;
+
+  // The RGB surface last given to the engine. Its keyed mutex, if any, stays
+  // acquired until the engine samples a different surface.
+  Surface* sampled_surface_ = nullptr;
+
+  // The texture last given to the engine.
+  FlutterOpenGLTexture last_texture_ = {};
+
+  // The video processor and its RGB output for NV12 and P010 surfaces.
+  Microsoft::WRL::ComPtr<ID3D11VideoDevice> video_device_;
+  Microsoft::WRL::ComPtr<ID3D11VideoContext> video_context_;
+  Microsoft::WRL::ComPtr<ID3D11VideoProcessorEnumerator> video_enumerator_;
+  Microsoft::WRL::ComPtr<ID3D11VideoProcessor> video_processor_;
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> output_texture_;
+  Microsoft::WRL::ComPtr<ID3D11VideoProcessorOutputView> output_view_;
+  EGLSurface output_egl_surface_ = EGL_NO_SURFACE;
+  GLuint output_gl_texture_ = 0;
+  UINT output_width_ = 0;
+  UINT output_height_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTextureD3d);
 };
@@ -62,9 +62,17 @@ bool ExternalTexturePixelBuffer::CopyPixelBuffer(size_t& width,
   } else {
     gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
   }
-  gl_.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixel_buffer->width,
-                   pixel_buffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                   pixel_buffer->buffer);
+  // Reallocating the texture storage for every frame is expensive for large
+  // video frames, so only replace the pixels if the size didn't change.
+  if (width == texture_width_ && height == texture_height_) {
+    gl_.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                        GL_UNSIGNED_BYTE, pixel_buffer->buffer);
+  } else {
+    gl_.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, pixel_buffer->buffer);
+    texture_width_ = width;
+    texture_height_ = height;
+  }
   if (pixel_buffer->release_callback) {
     pixel_buffer->release_callback(pixel_buffer->release_context);
   }
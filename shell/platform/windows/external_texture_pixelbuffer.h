@@ -40,6 +40,10 @@ class ExternalTexturePixelBuffer : public ExternalTexture {
   const GlProcs& gl_;
   GLuint gl_texture_ = 0;
 
+  // The size of the storage allocated for |gl_texture_|.
+  size_t texture_width_ = 0;
+  size_t texture_height_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTexturePixelBuffer);
 };
 
@@ -34,9 +34,11 @@ std::unique_ptr<FlutterWindowsEngine> GetTestEngine() {
 }
 
 // Creates a ID3D11Texture2D with the specified size.
-ComPtr<ID3D11Texture2D> CreateD3dTexture(FlutterWindowsEngine* engine,
-                                         UINT width,
-                                         UINT height) {
+ComPtr<ID3D11Texture2D> CreateD3dTexture(
+    FlutterWindowsEngine* engine,
+    UINT width,
+    UINT height,
+    UINT misc_flags = D3D11_RESOURCE_MISC_SHARED) {
   ComPtr<ID3D11Device> d3d_device;
   ComPtr<ID3D11Texture2D> d3d_texture;
   if (engine->surface_manager()->GetDevice(d3d_device.GetAddressOf())) {
@@ -50,7 +52,7 @@ ComPtr<ID3D11Texture2D> CreateD3dTexture(FlutterWindowsEngine* engine,
     texture_description.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
     texture_description.Height = width;
     texture_description.Width = height;
-    texture_description.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+    texture_description.MiscFlags = misc_flags;
 
     d3d_device->CreateTexture2D(&texture_description, nullptr,
                                 d3d_texture.GetAddressOf());
@@ -293,6 +295,59 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, PopulateKeyedMutexTexture) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl->gl_procs());
+
+  UINT width = 100;
+  UINT height = 100;
+  auto d3d_texture = CreateD3dTexture(engine.get(), width, height,
+                                      D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX);
+  EXPECT_TRUE(d3d_texture);
+
+  ComPtr<IDXGIKeyedMutex> keyed_mutex;
+  EXPECT_TRUE(SUCCEEDED(d3d_texture.As(&keyed_mutex)));
+
+  FlutterDesktopGpuSurfaceDescriptor surface_descriptor = {};
+  surface_descriptor.struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor);
+  surface_descriptor.handle = d3d_texture.Get();
+  surface_descriptor.width = surface_descriptor.visible_width = width;
+  surface_descriptor.height = surface_descriptor.visible_height = height;
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeD3d11Texture2D;
+  texture_info.gpu_surface_config.user_data = &surface_descriptor;
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return reinterpret_cast<const FlutterDesktopGpuSurfaceDescriptor*>(
+        user_data);
+  };
+
+  FlutterOpenGLTexture flutter_texture = {};
+  auto texture_id = registrar.RegisterTexture(&texture_info);
+  EXPECT_NE(texture_id, -1);
+
+  // The surface can't be sampled while the producer holds its keyed mutex.
+  EXPECT_EQ(keyed_mutex->AcquireSync(0, INFINITE), S_OK);
+  EXPECT_FALSE(
+      registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+
+  EXPECT_EQ(keyed_mutex->ReleaseSync(0), S_OK);
+  EXPECT_TRUE(
+      registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+  EXPECT_EQ(flutter_texture.width, width);
+  EXPECT_EQ(flutter_texture.height, height);
+
+  // The keyed mutex stays acquired while the surface is being sampled.
+  EXPECT_NE(keyed_mutex->AcquireSync(0, 0), S_OK);
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateInvalidTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
@@ -4,7 +4,10 @@
 
 #include "flutter/shell/platform/windows/flutter_windows_view.h"
 
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <cmath>
 
 #include "flutter/fml/platform/win/wstring_conversion.h"
 #include "flutter/shell/platform/common/accessibility_bridge.h"
@@ -36,6 +39,26 @@ bool SurfaceWillUpdate(size_t cur_width,
       (cur_height != target_height) || (cur_width != target_width);
   return non_zero_target_dims && not_same_size;
 }
+
+// Returns the bounding box of |damage| in physical pixels. Returns false if
+// the damage is unknown.
+bool GetDamageBounds(const FlutterDamage& damage, RECT* bounds) {
+  if (damage.num_rects == 0 || damage.damage == nullptr) {
+    return false;
+  }
+
+  *bounds = {LONG_MAX, LONG_MAX, LONG_MIN, LONG_MIN};
+  for (size_t i = 0; i < damage.num_rects; i++) {
+    const FlutterRect& rect = damage.damage[i];
+    bounds->left = std::min(bounds->left, static_cast<LONG>(rect.left));
+    bounds->top = std::min(bounds->top, static_cast<LONG>(rect.top));
+    bounds->right =
+        std::max(bounds->right, static_cast<LONG>(std::ceil(rect.right)));
+    bounds->bottom =
+        std::max(bounds->bottom, static_cast<LONG>(std::ceil(rect.bottom)));
+  }
+  return true;
+}
 }  // namespace
 
 FlutterWindowsView::FlutterWindowsView(
@@ -545,7 +568,7 @@ bool FlutterWindowsView::ClearContext() {
   return engine_->surface_manager()->ClearContext();
 }
 
-bool FlutterWindowsView::SwapBuffers() {
+bool FlutterWindowsView::SwapBuffers(const FlutterPresentInfo& info) {
   // Called on an engine-controlled (non-platform) thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
 
@@ -575,11 +598,29 @@ bool FlutterWindowsView::SwapBuffers() {
       return swap_buffers_result;
     }
     case ResizeState::kDone:
-    default:
-      return engine_->surface_manager()->SwapBuffers();
+    default: {
+      RECT damage;
+      if (!GetDamageBounds(info.frame_damage, &damage)) {
+        return engine_->surface_manager()->SwapBuffers();
+      }
+      return engine_->surface_manager()->SwapBuffersWithDamage(damage);
+    }
   }
 }
 
+void FlutterWindowsView::PopulateExistingDamage(
+    FlutterDamage* existing_damage) {
+  // Called on an engine-controlled (non-platform) thread.
+  // The age of the buffers in the swapchain is unknown, so the whole frame is
+  // redrawn. The frame damage still limits what is presented.
+  PhysicalWindowBounds bounds = binding_handler_->GetPhysicalWindowBounds();
+  existing_damage_rect_ = {0, 0, static_cast<double>(bounds.width),
+                           static_cast<double>(bounds.height)};
+  existing_damage->struct_size = sizeof(FlutterDamage);
+  existing_damage->num_rects = 1;
+  existing_damage->damage = &existing_damage_rect_;
+}
+
 bool FlutterWindowsView::PresentSoftwareBitmap(const void* allocation,
                                                size_t row_bytes,
                                                size_t height) {
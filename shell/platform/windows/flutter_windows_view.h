@@ -72,7 +72,11 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   bool ClearContext();
   bool MakeCurrent();
   bool MakeResourceCurrent();
-  bool SwapBuffers();
+  bool SwapBuffers(const FlutterPresentInfo& info);
+
+  // Callback for the damage of the window frame buffer that must be redrawn
+  // before the frame buffer is presented again.
+  void PopulateExistingDamage(FlutterDamage* existing_damage);
 
   // Callback for presenting a software bitmap.
   bool PresentSoftwareBitmap(const void* allocation,
@@ -389,6 +393,9 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   // resize_mutex_.
   size_t resize_target_height_ = 0;
 
+  // Storage for the rectangle returned by PopulateExistingDamage.
+  FlutterRect existing_damage_rect_ = {};
+
   // True when flutter's semantics tree is enabled.
   bool semantics_enabled_ = false;
 
@@ -130,6 +130,7 @@ class MockAngleSurfaceManager : public AngleSurfaceManager {
               (WindowsRenderTarget*, EGLint, EGLint, bool),
               (override));
   MOCK_METHOD(void, DestroySurface, (), (override));
+  MOCK_METHOD(EGLBoolean, SwapBuffersWithDamage, (const RECT&), (override));
 
   MOCK_METHOD(void, SetVSyncEnabled, (bool), (override));
 
@@ -872,6 +873,39 @@ TEST(FlutterWindowsViewTest, WindowResizeTests) {
   resized_latch.Wait();
 }
 
+// Tests that only the bounds of the frame damage are presented.
+TEST(FlutterWindowsViewTest, SwapBuffersPresentsFrameDamage) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  EngineModifier modifier(engine.get());
+
+  auto window_binding_handler =
+      std::make_unique<NiceMock<MockWindowBindingHandler>>();
+  std::unique_ptr<MockAngleSurfaceManager> surface_manager =
+      std::make_unique<MockAngleSurfaceManager>();
+
+  EXPECT_CALL(*surface_manager.get(), SwapBuffersWithDamage)
+      .WillOnce([](const RECT& damage) {
+        EXPECT_EQ(damage.left, 10);
+        EXPECT_EQ(damage.top, 20);
+        EXPECT_EQ(damage.right, 51);
+        EXPECT_EQ(damage.bottom, 80);
+        return EGL_TRUE;
+      });
+  EXPECT_CALL(*surface_manager.get(), DestroySurface).Times(1);
+
+  FlutterWindowsView view(std::move(window_binding_handler));
+  modifier.SetSurfaceManager(surface_manager.release());
+  view.SetEngine(std::move(engine));
+
+  FlutterRect rects[] = {{10, 30, 50.5, 40}, {20, 20, 30, 80}};
+  FlutterPresentInfo info = {};
+  info.struct_size = sizeof(FlutterPresentInfo);
+  info.frame_damage.struct_size = sizeof(FlutterDamage);
+  info.frame_damage.num_rects = 2;
+  info.frame_damage.damage = rects;
+  EXPECT_TRUE(view.SwapBuffers(info));
+}
+
 TEST(FlutterWindowsViewTest, WindowRepaintTests) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   EngineModifier modifier(engine.get());
@@ -96,8 +96,13 @@ void TaskRunner::EnqueueTask(Task task) {
   static std::atomic_uint64_t sGlobalTaskOrder(0);
 
   task.order = ++sGlobalTaskOrder;
+  bool is_next_task;
   {
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
+    // A wake up is already scheduled for the task at the top of the queue,
+    // which also serves the tasks behind it.
+    is_next_task =
+        task_queue_.empty() || Task::Comparer{}(task_queue_.top(), task);
     task_queue_.push(task);
 
     // Make sure the queue mutex is unlocked before waking up the loop. In case
@@ -106,7 +111,9 @@ void TaskRunner::EnqueueTask(Task task) {
     // the lock here momentarily till the end of the scope is a pessimization.
   }
 
-  WakeUp();
+  if (is_next_task) {
+    WakeUp();
+  }
 }
 
 bool TaskRunner::RunsTasksOnCurrentThread() const {
@@ -77,7 +77,8 @@ class TaskRunner : public TaskRunnerWindow::Delegate {
     };
   };
 
-  // Enqueues the given task.
+  // Enqueues the given task. The loop is only woken up if the task is due
+  // before all the tasks already in the queue.
   void EnqueueTask(Task task);
 
   // Schedules timers to call `ProcessTasks()` at the runner's thread.
@@ -21,10 +21,13 @@ class MockTaskRunner : public TaskRunner {
 
   void SimulateTimerAwake() { ProcessTasks(); }
 
+  int wake_up_count() const { return wake_up_count_; }
+
  protected:
   virtual void WakeUp() override {
     // Do nothing to avoid processing tasks immediately after the tasks is
     // posted.
+    wake_up_count_++;
   }
 
   virtual TaskTimePoint GetCurrentTimeForTask() const override {
@@ -34,6 +37,8 @@ class MockTaskRunner : public TaskRunner {
   }
 
  private:
+  int wake_up_count_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(MockTaskRunner);
 };
 
@@ -88,5 +93,23 @@ TEST(TaskRunnerTest, MaybeExecuteTaskOnlyExpired) {
   EXPECT_EQ(executed_task, only_task_expired_before_now);
 }
 
+TEST(TaskRunnerTest, WakesUpOnlyForTasksDueFirst) {
+  auto runner =
+      MockTaskRunner(MockGetCurrentTime, [](const FlutterTask* expired_task) {});
+
+  uint64_t time_now = MockGetCurrentTime();
+
+  runner.PostFlutterTask(FlutterTask{nullptr, 1}, time_now + 2000);
+  EXPECT_EQ(runner.wake_up_count(), 1);
+
+  // Due after the queued task, which already has a wake up scheduled.
+  runner.PostFlutterTask(FlutterTask{nullptr, 2}, time_now + 3000);
+  runner.PostFlutterTask(FlutterTask{nullptr, 3}, time_now + 2000);
+  EXPECT_EQ(runner.wake_up_count(), 1);
+
+  runner.PostFlutterTask(FlutterTask{nullptr, 4}, time_now + 1000);
+  EXPECT_EQ(runner.wake_up_count(), 2);
+}
+
 }  // namespace testing
 }  // namespace flutter
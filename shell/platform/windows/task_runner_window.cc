@@ -52,7 +52,11 @@ std::shared_ptr<TaskRunnerWindow> TaskRunnerWindow::GetSharedInstance() {
 }
 
 void TaskRunnerWindow::WakeUp() {
+  if (wake_up_pending_.exchange(true)) {
+    return;
+  }
   if (!PostMessage(window_handle_, WM_NULL, 0, 0)) {
+    wake_up_pending_ = false;
     FML_LOG(ERROR) << "Failed to post message to main thread.";
   }
 }
@@ -70,6 +74,9 @@ void TaskRunnerWindow::RemoveDelegate(Delegate* delegate) {
 }
 
 void TaskRunnerWindow::ProcessTasks() {
+  // Tasks posted from now on need a new wake up.
+  wake_up_pending_ = false;
+
   auto next = std::chrono::nanoseconds::max();
   auto delegates_copy(delegates_);
   for (auto delegate : delegates_copy) {
@@ -7,6 +7,7 @@
 
 #include <windows.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -30,7 +31,8 @@ class TaskRunnerWindow {
 
   static std::shared_ptr<TaskRunnerWindow> GetSharedInstance();
 
-  // Triggers processing delegate tasks on main thread
+  // Triggers processing delegate tasks on main thread. Wake ups requested
+  // before the main thread gets to process the tasks are coalesced.
   void WakeUp();
 
   void AddDelegate(Delegate* delegate);
@@ -60,6 +62,7 @@ class TaskRunnerWindow {
   HWND window_handle_;
   std::wstring window_class_name_;
   std::vector<Delegate*> delegates_;
+  std::atomic_bool wake_up_pending_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TaskRunnerWindow);
 };
@@ -10,6 +10,7 @@
 #include <windows.h>
 
 #include <cstdint>
+#include <utility>
 
 #include "flutter/shell/platform/common/json_method_codec.h"
 
@@ -67,14 +68,16 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
-  std::u16string text_before_change =
-      fml::Utf8ToUtf16(active_model_->GetText());
+  // Only deltas carry the text before the change.
+  std::string text_before_change =
+      enable_delta_model ? active_model_->GetText() : std::string();
   TextRange selection_before_change = active_model_->selection();
   active_model_->AddText(text);
 
   if (enable_delta_model) {
     TextEditingDelta delta =
-        TextEditingDelta(text_before_change, selection_before_change, text);
+        TextEditingDelta(std::move(text_before_change), selection_before_change,
+                         fml::Utf16ToUtf8(text));
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -127,9 +130,7 @@ void TextInputPlugin::ComposeBeginHook() {
   }
   active_model_->BeginComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextRange selection = active_model_->selection();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->GetText());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -180,8 +181,7 @@ void TextInputPlugin::ComposeEndHook() {
   active_model_->CommitComposing();
   active_model_->EndComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->GetText());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -193,16 +193,17 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
+  std::string text_before_change =
+      enable_delta_model ? active_model_->GetText() : std::string();
   TextRange composing_before_change = active_model_->composing_range();
   active_model_->AddText(text);
   cursor_pos += active_model_->composing_range().start();
   active_model_->UpdateComposingText(text);
   active_model_->SetSelection(TextRange(cursor_pos, cursor_pos));
-  std::string text_after_change = active_model_->GetText();
   if (enable_delta_model) {
-    TextEditingDelta delta = TextEditingDelta(
-        fml::Utf8ToUtf16(text_before_change), composing_before_change, text);
+    TextEditingDelta delta =
+        TextEditingDelta(std::move(text_before_change), composing_before_change,
+                         fml::Utf16ToUtf8(text));
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -450,12 +451,13 @@ void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType &&
       input_action_ == kInputActionNewline) {
-    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
+    std::string text_before_change =
+        enable_delta_model ? model->GetText() : std::string();
     TextRange selection_before_change = model->selection();
     model->AddText(u"\n");
     if (enable_delta_model) {
-      TextEditingDelta delta(text_before_change, selection_before_change,
-                             u"\n");
+      TextEditingDelta delta(std::move(text_before_change),
+                             selection_before_change, "\n");
       SendStateUpdateWithDelta(*model, &delta);
     } else {
       SendStateUpdate(*model);
@@ -557,6 +557,40 @@ void main() {
     expect(data, listEquals(dataSync));
   });
 
+  test('DrawCommandBatch draws the same as individual calls', () async {
+    final Paint paint = Paint()
+      ..color = const Color(0xFF2196F3)
+      ..strokeWidth = 3;
+
+    final Image individualImage = await toImage((Canvas canvas) {
+      canvas.drawLine(const Offset(5, 5), const Offset(90, 40), paint);
+      canvas.drawRect(const Rect.fromLTRB(10, 50, 40, 90), paint);
+      paint.color = const Color(0x80FF5722);
+      canvas.drawOval(const Rect.fromLTRB(50, 50, 95, 80), paint);
+      canvas.drawCircle(const Offset(70, 20), 12, paint);
+      paint.color = const Color(0xFF2196F3);
+    }, 100, 100);
+
+    final DrawCommandBatch batch = DrawCommandBatch()
+      ..addLine(const Offset(5, 5), const Offset(90, 40))
+      ..addRect(const Rect.fromLTRB(10, 50, 40, 90))
+      ..setColor(const Color(0x80FF5722))
+      ..addOval(const Rect.fromLTRB(50, 50, 95, 80))
+      ..addCircle(const Offset(70, 20), 12);
+    expect(batch.isEmpty, false);
+    final Image batchImage = await toImage((Canvas canvas) {
+      batch.draw(canvas, paint);
+    }, 100, 100);
+    expect(paint.color, const Color(0xFF2196F3));
+
+    final ByteData individualData = (await individualImage.toByteData())!;
+    final ByteData batchData = (await batchImage.toByteData())!;
+    expect(batchData.buffer.asUint8List(), listEquals(individualData.buffer.asUint8List()));
+
+    batch.clear();
+    expect(batch.isEmpty, true);
+  });
+
   test('Canvas.drawParagraph throws when Paragraph.layout was not called', () async {
     // Regression test for https://github.com/flutter/flutter/issues/97172
     bool assertsEnabled = false;
@@ -744,6 +744,12 @@ void DisplayListStreamDispatcher::drawLine(const SkPoint& p0,
 void DisplayListStreamDispatcher::drawRect(const SkRect& rect) {
   startl() << "drawRect(" << rect << ");" << std::endl;
 }
+void DisplayListStreamDispatcher::drawRects(const SkRect rects[],
+                                            uint32_t count) {
+  startl() << "drawRects(";
+                         out_array("rects", count, rects)
+           << ");" << std::endl;
+}
 void DisplayListStreamDispatcher::drawOval(const SkRect& bounds) {
   startl() << "drawOval(" << bounds << ");" << std::endl;
 }
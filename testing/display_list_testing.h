@@ -102,6 +102,7 @@ class DisplayListStreamDispatcher final : public DlOpReceiver {
   void drawPaint() override;
   void drawLine(const SkPoint& p0, const SkPoint& p1) override;
   void drawRect(const SkRect& rect) override;
+  void drawRects(const SkRect rects[], uint32_t count) override;
   void drawOval(const SkRect& bounds) override;
   void drawCircle(const SkPoint& center, SkScalar radius) override;
   void drawRRect(const SkRRect& rrect) override;
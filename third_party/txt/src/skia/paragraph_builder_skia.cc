@@ -17,6 +17,8 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "txt/paragraph_style.h"
@@ -42,6 +44,135 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
                                            : SkFontStyle::Slant::kItalic_Slant);
 }
 
+// Appends the bytes of a value to a paragraph layout cache key.
+template <typename T>
+void AppendToKey(std::string& key, const T& value) {
+  static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendToKey(std::string& key, const std::string& value) {
+  AppendToKey(key, value.size());
+  key.append(value);
+}
+
+void AppendToKey(std::string& key, const std::u16string& value) {
+  AppendToKey(key, value.size());
+  key.append(reinterpret_cast<const char*>(value.data()),
+             value.size() * sizeof(char16_t));
+}
+
+void AppendToKey(std::string& key, const std::vector<std::string>& values) {
+  AppendToKey(key, values.size());
+  for (const std::string& value : values) {
+    AppendToKey(key, value);
+  }
+}
+
+void AppendToKey(std::string& key, const ParagraphStyle& style) {
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendToKey(key, style.font_family);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendToKey(key, style.text_height_behavior);
+  AppendToKey(key, style.strut_enabled);
+  AppendToKey(key, style.strut_font_weight);
+  AppendToKey(key, style.strut_font_style);
+  AppendToKey(key, style.strut_font_families);
+  AppendToKey(key, style.strut_font_size);
+  AppendToKey(key, style.strut_height);
+  AppendToKey(key, style.strut_has_height_override);
+  AppendToKey(key, style.strut_half_leading);
+  AppendToKey(key, style.strut_leading);
+  AppendToKey(key, style.force_strut_height);
+  AppendToKey(key, style.text_align);
+  AppendToKey(key, style.text_direction);
+  AppendToKey(key, style.max_lines);
+  AppendToKey(key, style.ellipsis);
+  AppendToKey(key, style.locale);
+  AppendToKey(key, style.apply_rounding_hack);
+}
+
+// The paints of the style are added as they are converted to paint IDs.
+void AppendToKey(std::string& key, const TextStyle& style) {
+  AppendToKey(key, style.color);
+  AppendToKey(key, style.decoration);
+  AppendToKey(key, style.decoration_color);
+  AppendToKey(key, style.decoration_style);
+  AppendToKey(key, style.decoration_thickness_multiplier);
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendToKey(key, style.text_baseline);
+  AppendToKey(key, style.half_leading);
+  AppendToKey(key, style.font_families);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.letter_spacing);
+  AppendToKey(key, style.word_spacing);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendToKey(key, style.locale);
+  AppendToKey(key, style.background.has_value());
+  AppendToKey(key, style.foreground.has_value());
+  AppendToKey(key, style.text_shadows.size());
+  for (const TextShadow& shadow : style.text_shadows) {
+    AppendToKey(key, shadow.color);
+    AppendToKey(key, shadow.offset.x());
+    AppendToKey(key, shadow.offset.y());
+    AppendToKey(key, shadow.blur_sigma);
+  }
+  AppendToKey(key, style.font_features.GetFontFeatures().size());
+  for (const auto& [feature, value] : style.font_features.GetFontFeatures()) {
+    AppendToKey(key, feature);
+    AppendToKey(key, value);
+  }
+  AppendToKey(key, style.font_variations.GetAxisValues().size());
+  for (const auto& [axis, value] : style.font_variations.GetAxisValues()) {
+    AppendToKey(key, axis);
+    AppendToKey(key, value);
+  }
+}
+
+void AppendToKey(std::string& key, const PlaceholderRun& span) {
+  AppendToKey(key, span.width);
+  AppendToKey(key, span.height);
+  AppendToKey(key, span.alignment);
+  AppendToKey(key, span.baseline);
+  AppendToKey(key, span.baseline_offset);
+}
+
+// Paints with effects are compared by identity elsewhere, so they are left
+// out of the cache instead of being described by the key.
+bool AppendToKey(std::string& key, const flutter::DlPaint& paint) {
+  if (paint.getColorSourcePtr() || paint.getColorFilterPtr() ||
+      paint.getImageFilterPtr() || paint.getMaskFilterPtr() ||
+      paint.getPathEffectPtr()) {
+    return false;
+  }
+  AppendToKey(key, paint.getColor().argb());
+  AppendToKey(key, paint.getBlendMode());
+  AppendToKey(key, paint.getDrawStyle());
+  AppendToKey(key, paint.getStrokeCap());
+  AppendToKey(key, paint.getStrokeJoin());
+  AppendToKey(key, paint.getStrokeWidth());
+  AppendToKey(key, paint.getStrokeMiter());
+  AppendToKey(key, paint.isAntiAlias());
+  AppendToKey(key, paint.isDither());
+  AppendToKey(key, paint.isInvertColors());
+  return true;
+}
+
+// Tags that keep the calls made to the builder apart in a cache key.
+enum class KeyTag : char {
+  kParagraphStyle,
+  kPushStyle,
+  kPop,
+  kText,
+  kPlaceholder,
+  kPaint,
+};
+
 }  // anonymous namespace
 
 ParagraphBuilderSkia::ParagraphBuilderSkia(
@@ -49,19 +180,45 @@ ParagraphBuilderSkia::ParagraphBuilderSkia(
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
     : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
-  builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+  const std::shared_ptr<ParagraphLayoutCache>& cache =
+      font_collection->GetParagraphLayoutCache();
+  if (cache) {
+    cacheable_ = std::make_unique<ParagraphSkia::CacheableContents>();
+    cacheable_->cache = cache;
+    cacheable_->generation = cache->GetGeneration();
+    AppendToKey(cacheable_->key, KeyTag::kParagraphStyle);
+    AppendToKey(cacheable_->key, style);
+  }
+
+  skt::ParagraphStyle skia_style = TxtToSkia(style);
+  sk_sp<skt::FontCollection> skt_collection =
+      font_collection->CreateSktFontCollection();
+  builder_ = skt::ParagraphBuilder::make(skia_style, skt_collection);
+  if (cacheable_) {
+    cacheable_->recipe.font_collection = std::move(skt_collection);
+    cacheable_->recipe.style = std::move(skia_style);
+  }
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  if (cacheable_) {
+    AppendToKey(cacheable_->key, KeyTag::kPushStyle);
+    AppendToKey(cacheable_->key, style);
+  }
+  skt::TextStyle skia_style = TxtToSkia(style);
+  builder_->pushStyle(skia_style);
+  Record(std::move(skia_style));
   txt_style_stack_.push(style);
 }
 
 void ParagraphBuilderSkia::Pop() {
+  if (cacheable_) {
+    AppendToKey(cacheable_->key, KeyTag::kPop);
+  }
   builder_->pop();
+  Record(std::monostate());
   txt_style_stack_.pop();
 }
 
@@ -70,10 +227,19 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 }
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
+  if (cacheable_) {
+    AppendToKey(cacheable_->key, KeyTag::kText);
+    AppendToKey(cacheable_->key, text);
+  }
   builder_->addText(text);
+  Record(text);
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
+  if (cacheable_) {
+    AppendToKey(cacheable_->key, KeyTag::kPlaceholder);
+    AppendToKey(cacheable_->key, span);
+  }
   skt::PlaceholderStyle placeholder_style;
   placeholder_style.fHeight = span.height;
   placeholder_style.fWidth = span.width;
@@ -83,15 +249,30 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  Record(placeholder_style);
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
-  return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+  return std::make_unique<ParagraphSkia>(builder_->Build(),
+                                         std::move(dl_paints_),
+                                         impeller_enabled_,
+                                         std::move(cacheable_));
+}
+
+void ParagraphBuilderSkia::Record(ParagraphSkia::Recipe::Op op) {
+  if (cacheable_) {
+    cacheable_->recipe.ops.push_back(std::move(op));
+  }
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
     const flutter::DlPaint& dl_paint) {
+  if (cacheable_) {
+    AppendToKey(cacheable_->key, KeyTag::kPaint);
+    if (!AppendToKey(cacheable_->key, dl_paint)) {
+      cacheable_.reset();
+    }
+  }
   dl_paints_.push_back(dl_paint);
   return dl_paints_.size() - 1;
 }
@@ -20,6 +20,7 @@
 #include "txt/paragraph_builder.h"
 
 #include "flutter/display_list/dl_paint.h"
+#include "skia/paragraph_skia.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -50,6 +51,9 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
   skia::textlayout::TextStyle TxtToSkia(const TextStyle& txt);
 
+  // Records a call for rebuilding the paragraph, unless it can't be cached.
+  void Record(ParagraphSkia::Recipe::Op op);
+
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
   TextStyle base_style_;
 
@@ -62,6 +66,10 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  // Reset once the paragraph uses something that its layout cache key can't
+  // describe, such as a paint with a shader.
+  std::unique_ptr<ParagraphSkia::CacheableContents> cacheable_;
 };
 
 }  // namespace txt
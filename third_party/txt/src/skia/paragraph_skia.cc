@@ -22,11 +22,14 @@
 #include "fml/logging.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "include/core/SkMatrix.h"
+#include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
 
 namespace skt = skia::textlayout;
 using PaintID = skt::ParagraphPainter::PaintID;
+using TextFrames =
+    std::unordered_map<uint32_t, std::shared_ptr<impeller::TextFrame>>;
 
 using namespace flutter;
 
@@ -66,12 +69,23 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   ///             See https://github.com/flutter/flutter/issues/126673. It
   ///             probably makes sense to eventually make this a compile-time
   ///             decision (i.e. with `#ifdef`) instead of a runtime option.
+  /// @param      text_frames  The text frames made by the previous painter of
+  ///                          the paragraph, by text blob ID. Replaced with
+  ///                          the text frames this painter uses when it is
+  ///                          destroyed.
   DisplayListParagraphPainter(DisplayListBuilder* builder,
                               const std::vector<DlPaint>& dl_paints,
-                              bool impeller_enabled)
+                              bool impeller_enabled,
+                              TextFrames& text_frames)
       : builder_(builder),
         dl_paints_(dl_paints),
-        impeller_enabled_(impeller_enabled) {}
+        impeller_enabled_(impeller_enabled),
+        previous_text_frames_(text_frames) {}
+
+  ~DisplayListParagraphPainter() {
+    // Frames of blobs that are no longer painted are dropped.
+    previous_text_frames_.swap(text_frames_);
+  }
 
   void drawTextBlob(const sk_sp<SkTextBlob>& blob,
                     SkScalar x,
@@ -93,8 +107,7 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
         return;
       }
 
-      builder_->DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob), x,
-                              y, dl_paints_[paint_id]);
+      builder_->DrawTextFrame(GetTextFrame(blob), x, y, dl_paints_[paint_id]);
       return;
     }
 #endif  // IMPELLER_SUPPORTS_RENDERING
@@ -116,8 +129,7 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
       paint.setMaskFilter(&filter);
     }
     if (impeller_enabled_) {
-      builder_->DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob), x,
-                              y, paint);
+      builder_->DrawTextFrame(GetTextFrame(blob), x, y, paint);
       return;
     }
     builder_->DrawTextBlob(blob, x, y, paint);
@@ -181,6 +193,18 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   void restore() override { builder_->Restore(); }
 
  private:
+  const std::shared_ptr<impeller::TextFrame>& GetTextFrame(
+      const sk_sp<SkTextBlob>& blob) {
+    auto& frame = text_frames_[blob->uniqueID()];
+    if (!frame) {
+      auto previous = previous_text_frames_.find(blob->uniqueID());
+      frame = previous != previous_text_frames_.end()
+                  ? std::move(previous->second)
+                  : impeller::MakeTextFrameFromTextBlobSkia(blob);
+    }
+    return frame;
+  }
+
   SkPath dashedLine(SkScalar x0,
                     SkScalar x1,
                     SkScalar y0,
@@ -239,15 +263,35 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   DisplayListBuilder* builder_;
   const std::vector<DlPaint>& dl_paints_;
   const bool impeller_enabled_;
+  TextFrames& previous_text_frames_;
+  TextFrames text_frames_;
 };
 
 }  // anonymous namespace
 
+std::unique_ptr<skt::Paragraph> ParagraphSkia::Recipe::Build() const {
+  auto builder = skt::ParagraphBuilder::make(style, font_collection);
+  for (const Op& op : ops) {
+    if (auto text_style = std::get_if<skt::TextStyle>(&op)) {
+      builder->pushStyle(*text_style);
+    } else if (std::holds_alternative<std::monostate>(op)) {
+      builder->pop();
+    } else if (auto text = std::get_if<std::u16string>(&op)) {
+      builder->addText(*text);
+    } else {
+      builder->addPlaceholder(std::get<skt::PlaceholderStyle>(op));
+    }
+  }
+  return builder->Build();
+}
+
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
                              std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+                             bool impeller_enabled,
+                             std::unique_ptr<CacheableContents> cacheable)
     : paragraph_(std::move(paragraph)),
       dl_paints_(dl_paints),
+      cacheable_(std::move(cacheable)),
       impeller_enabled_(impeller_enabled) {}
 
 double ParagraphSkia::GetMaxWidth() {
@@ -324,11 +368,30 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  text_frames_.clear();
+  if (!cacheable_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  ParagraphLayoutCache& cache = *cacheable_->cache;
+  if (auto cached =
+          cache.Find(cacheable_->key, width, cacheable_->generation)) {
+    paragraph_ = std::move(cached);
+    return;
+  }
+  if (paragraph_.use_count() > 1) {
+    // Others rely on the current layout of the shared paragraph, so lay out
+    // a fresh copy instead.
+    paragraph_ = cacheable_->recipe.Build();
+  }
   paragraph_->layout(width);
+  cache.Insert(cacheable_->key, width, cacheable_->generation, paragraph_);
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
-  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_);
+  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_,
+                                      text_frames_);
   paragraph_->paint(&painter, x, y);
   return true;
 }
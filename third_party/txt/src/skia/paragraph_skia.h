@@ -17,20 +17,55 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
 
+#include "impeller/typographer/text_frame.h"
 #include "txt/paragraph.h"
+#include "txt/paragraph_layout_cache.h"
 
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+#include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
+#include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 
 namespace txt {
 
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // The calls that built a paragraph, so that it can be built again.
+  struct Recipe {
+    // A pushed style, a pop, a run of text or a placeholder.
+    using Op = std::variant<skia::textlayout::TextStyle,
+                            std::monostate,
+                            std::u16string,
+                            skia::textlayout::PlaceholderStyle>;
+
+    sk_sp<skia::textlayout::FontCollection> font_collection;
+    skia::textlayout::ParagraphStyle style;
+    std::vector<Op> ops;
+
+    std::unique_ptr<skia::textlayout::Paragraph> Build() const;
+  };
+
+  // What a paragraph needs to share its layouts through a
+  // |ParagraphLayoutCache|. The key describes everything that the paragraph
+  // was built from, so paragraphs with equal keys lay out identically.
+  struct CacheableContents {
+    std::shared_ptr<ParagraphLayoutCache> cache;
+    uint64_t generation = 0u;
+    std::string key;
+    Recipe recipe;
+  };
+
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
                 std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+                bool impeller_enabled,
+                std::unique_ptr<CacheableContents> cacheable = nullptr);
 
   virtual ~ParagraphSkia() = default;
 
@@ -72,10 +107,17 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  // Shared with the layout cache, and with other paragraphs built from the
+  // same contents, once it has been laid out.
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
+  std::unique_ptr<CacheableContents> cacheable_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
+  // The text frames made from the text blobs of the last paint, by blob ID.
+  // Once laid out, the paragraph paints the same blobs every time.
+  std::unordered_map<uint32_t, std::shared_ptr<impeller::TextFrame>>
+      text_frames_;
   const bool impeller_enabled_;
 };
 
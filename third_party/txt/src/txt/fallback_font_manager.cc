@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_font_manager.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+namespace {
+
+// Describes everything but the character itself that a fallback lookup
+// depends on.
+std::string MakeFallbackKey(const char family_name[],
+                            const SkFontStyle& style,
+                            const char* bcp47[],
+                            int bcp47_count,
+                            SkUnichar character) {
+  std::string key = std::to_string(character /
+                                   FallbackFontManager::kCodePointBlockSize);
+  key += '/';
+  key += std::to_string(style.weight());
+  key += '/';
+  key += std::to_string(style.width());
+  key += '/';
+  key += std::to_string(style.slant());
+  key += '/';
+  if (family_name) {
+    key += family_name;
+  }
+  for (int i = 0; i < bcp47_count; i++) {
+    key += '/';
+    key += bcp47[i];
+  }
+  return key;
+}
+
+}  // namespace
+
+FallbackFontManager::FallbackFontManager(sk_sp<SkFontMgr> font_manager)
+    : font_manager_(std::move(font_manager)) {
+  FML_DCHECK(font_manager_ != nullptr);
+}
+
+FallbackFontManager::~FallbackFontManager() = default;
+
+FallbackFontManager::Stats FallbackFontManager::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return Stats{
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+  };
+}
+
+int FallbackFontManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FallbackFontManager::onGetFamilyName(int index,
+                                          SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+sk_sp<SkFontStyleSet> FallbackFontManager::onCreateStyleSet(int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+sk_sp<SkFontStyleSet> FallbackFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  const std::string key =
+      MakeFallbackKey(familyName, style, bcp47, bcp47Count, character);
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = fallbacks_.find(key);
+    if (found != fallbacks_.end()) {
+      if (found->second.unmatched.count(character) > 0) {
+        hit_count_++;
+        return nullptr;
+      }
+      for (const sk_sp<SkTypeface>& typeface : found->second.typefaces) {
+        if (typeface->unicharToGlyph(character) != 0) {
+          hit_count_++;
+          return typeface;
+        }
+      }
+    }
+    miss_count_++;
+  }
+
+  // The platform lookup can be slow, so it is not made while holding the lock.
+  TRACE_EVENT0("flutter", "FallbackFontManager::MatchCharacter");
+  sk_sp<SkTypeface> typeface = font_manager_->matchFamilyStyleCharacter(
+      familyName, style, bcp47, bcp47Count, character);
+
+  std::scoped_lock lock(mutex_);
+  Fallbacks& fallbacks = fallbacks_[key];
+  if (!typeface) {
+    fallbacks.unmatched.insert(character);
+    return nullptr;
+  }
+  for (const sk_sp<SkTypeface>& cached : fallbacks.typefaces) {
+    if (cached->uniqueID() == typeface->uniqueID()) {
+      return typeface;
+    }
+  }
+  fallbacks.typefaces.push_back(typeface);
+  return typeface;
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMakeFromData(sk_sp<SkData> data,
+                                                      int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onMakeFromFile(const char path[],
+                                                      int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
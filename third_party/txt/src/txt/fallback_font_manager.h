@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TXT_FALLBACK_FONT_MANAGER_H_
+#define TXT_FALLBACK_FONT_MANAGER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A font manager that forwards to another one and remembers which
+///             typefaces it chose to render characters that the requested
+///             fonts lack.
+///
+///             Platform font managers search every installed font for a
+///             fallback, which can take milliseconds for each emoji or CJK
+///             character. Results are kept for each block of code points,
+///             locale and style, so later characters of the same script are
+///             usually matched by a typeface that was found before. A cached
+///             typeface is only returned if it has a glyph for the character.
+///
+class FallbackFontManager : public SkFontMgr {
+ public:
+  // The number of consecutive code points that share their fallback typefaces.
+  static constexpr SkUnichar kCodePointBlockSize = 128;
+
+  struct Stats {
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+  };
+
+  explicit FallbackFontManager(sk_sp<SkFontMgr> font_manager);
+
+  ~FallbackFontManager() override;
+
+  Stats GetStats() const;
+
+ private:
+  struct Fallbacks {
+    std::vector<sk_sp<SkTypeface>> typefaces;
+    // Characters that no typeface could render.
+    std::unordered_set<SkUnichar> unmatched;
+  };
+
+  const sk_sp<SkFontMgr> font_manager_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, Fallbacks> fallbacks_;
+  mutable size_t hit_count_ = 0u;
+  mutable size_t miss_count_ = 0u;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyle(const char familyName[],
+                                       const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackFontManager);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FALLBACK_FONT_MANAGER_H_
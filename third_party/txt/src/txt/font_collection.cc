@@ -26,12 +26,28 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "txt/fallback_font_manager.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+namespace {
+
+// Fallback fonts are mostly found by searching the platform fonts, so the
+// results of the default font manager are the ones worth keeping.
+sk_sp<SkFontMgr> WrapFallbackFontManager(sk_sp<SkFontMgr> font_manager) {
+  if (!font_manager) {
+    return nullptr;
+  }
+  return sk_make_sp<FallbackFontManager>(std::move(font_manager));
+}
+
+}  // namespace
+
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_layout_cache_(std::make_shared<ParagraphLayoutCache>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -45,28 +61,29 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
-  default_font_manager_ = GetDefaultFontManager(font_initialization_data);
-  skt_collection_.reset();
+  default_font_manager_ =
+      WrapFallbackFontManager(GetDefaultFontManager(font_initialization_data));
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
-  default_font_manager_ = font_manager;
-  skt_collection_.reset();
+  default_font_manager_ = WrapFallbackFontManager(std::move(font_manager));
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -83,8 +100,14 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
   return order;
 }
 
+void FontCollection::ResetSktFontCollection() {
+  skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
+}
+
 void FontCollection::DisableFontFallback() {
   enable_font_fallback_ = false;
+  paragraph_layout_cache_->Clear();
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
@@ -94,6 +117,7 @@ void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  paragraph_layout_cache_->Clear();
 }
 
 sk_sp<skia::textlayout::FontCollection>
@@ -118,4 +142,9 @@ FontCollection::CreateSktFontCollection() {
   return skt_collection_;
 }
 
+const std::shared_ptr<ParagraphLayoutCache>&
+FontCollection::GetParagraphLayoutCache() const {
+  return paragraph_layout_cache_;
+}
+
 }  // namespace txt
@@ -28,6 +28,7 @@
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "txt/asset_font_manager.h"
+#include "txt/paragraph_layout_cache.h"
 #include "txt/text_style.h"
 
 namespace txt {
@@ -56,6 +57,10 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Laid out paragraphs that can be reused by paragraphs built with the same
+  // contents. Cleared whenever the fonts of this collection change.
+  const std::shared_ptr<ParagraphLayoutCache>& GetParagraphLayoutCache() const;
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
@@ -65,6 +70,9 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
 
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
+  std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_;
+
+  void ResetSktFontCollection();
 
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
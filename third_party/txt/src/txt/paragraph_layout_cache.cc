@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/paragraph_layout_cache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "flutter/fml/fast_hash.h"
+
+namespace txt {
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t max_entries)
+    : max_entries_(max_entries) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+uint64_t ParagraphLayoutCache::GetGeneration() const {
+  std::scoped_lock lock(mutex_);
+  return generation_;
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  generation_++;
+  index_.clear();
+  entries_.clear();
+}
+
+std::shared_ptr<skia::textlayout::Paragraph> ParagraphLayoutCache::Find(
+    const std::string& key,
+    double width,
+    uint64_t generation) {
+  const size_t hash = Hash(key, width);
+  std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    return nullptr;
+  }
+  auto entry = Lookup(hash, key, width);
+  if (entry == entries_.end()) {
+    miss_count_++;
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  hit_count_++;
+  return entry->paragraph;
+}
+
+void ParagraphLayoutCache::Insert(
+    const std::string& key,
+    double width,
+    uint64_t generation,
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph) {
+  if (!paragraph || max_entries_ == 0u) {
+    return;
+  }
+  const size_t hash = Hash(key, width);
+  std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  auto entry = Lookup(hash, key, width);
+  if (entry != entries_.end()) {
+    entry->paragraph = std::move(paragraph);
+    entries_.splice(entries_.begin(), entries_, entry);
+    return;
+  }
+  Evict(max_entries_ - 1u);
+  entries_.push_front(Entry{
+      .hash = hash,
+      .key = key,
+      .width = width,
+      .thread_id = std::this_thread::get_id(),
+      .paragraph = std::move(paragraph),
+  });
+  index_.emplace(hash, entries_.begin());
+}
+
+ParagraphLayoutCache::Stats ParagraphLayoutCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return Stats{
+      .entry_count = entries_.size(),
+      .hit_count = hit_count_,
+      .miss_count = miss_count_,
+      .eviction_count = eviction_count_,
+  };
+}
+
+size_t ParagraphLayoutCache::Hash(const std::string& key, double width) {
+  return fml::FastHasher().AddBytes(key).Add(width).GetHash();
+}
+
+std::list<ParagraphLayoutCache::Entry>::iterator ParagraphLayoutCache::Lookup(
+    size_t hash,
+    const std::string& key,
+    double width) {
+  const std::thread::id thread_id = std::this_thread::get_id();
+  auto [begin, end] = index_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    auto entry = it->second;
+    if (entry->width == width && entry->thread_id == thread_id &&
+        entry->key == key) {
+      return entry;
+    }
+  }
+  return entries_.end();
+}
+
+void ParagraphLayoutCache::Evict(size_t max_entries) {
+  while (entries_.size() > max_entries) {
+    auto entry = std::prev(entries_.end());
+    auto [begin, end] = index_.equal_range(entry->hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == entry) {
+        index_.erase(it);
+        break;
+      }
+    }
+    entries_.erase(entry);
+    eviction_count_++;
+  }
+}
+
+}  // namespace txt
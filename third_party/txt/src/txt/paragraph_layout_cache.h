@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"  // nogncheck
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps laid out paragraphs across frames so that a paragraph
+///             built again with the same text and styles skips line breaking
+///             and layout.
+///
+///             Entries are found by a key that describes the text, styles and
+///             placeholders of the paragraph, together with the width it was
+///             laid out at. Every entry belongs to a generation of the font
+///             collection, and changing the fonts starts a new generation so
+///             that stale layouts are never returned.
+///
+///             A cached paragraph is only handed out on the thread that laid
+///             it out, because painting a paragraph fills in caches of its
+///             own. The least recently used entries are discarded once there
+///             are more than `max_entries`.
+///
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 256u;
+
+  struct Stats {
+    size_t entry_count = 0u;
+    size_t hit_count = 0u;
+    size_t miss_count = 0u;
+    size_t eviction_count = 0u;
+  };
+
+  explicit ParagraphLayoutCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~ParagraphLayoutCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The generation that paragraphs built now belong to.
+  ///
+  uint64_t GetGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discards every entry and starts a new generation.
+  ///
+  void Clear();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the paragraph with the given content key that was
+  ///             laid out at `width`, or nullptr if there is none.
+  ///
+  std::shared_ptr<skia::textlayout::Paragraph> Find(const std::string& key,
+                                                    double width,
+                                                    uint64_t generation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remembers `paragraph`, which has just been laid out at
+  ///             `width`. Paragraphs built in an older generation are ignored.
+  ///
+  void Insert(const std::string& key,
+              double width,
+              uint64_t generation,
+              std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    size_t hash = 0u;
+    std::string key;
+    double width = 0.0;
+    std::thread::id thread_id;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+  };
+
+  const size_t max_entries_;
+  mutable std::mutex mutex_;
+  uint64_t generation_ = 0u;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+  size_t eviction_count_ = 0u;
+
+  static size_t Hash(const std::string& key, double width);
+
+  std::list<Entry>::iterator Lookup(size_t hash,
+                                    const std::string& key,
+                                    double width);
+
+  void Evict(size_t max_entries);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
@@ -18,7 +18,11 @@
 
 #include <sstream>
 
+#include "flutter/runtime/test_font_data.h"
+#include "txt/asset_font_manager.h"
+#include "txt/fallback_font_manager.h"
 #include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
 
 namespace txt {
 namespace testing {
@@ -30,6 +34,34 @@ class FontCollectionTests : public ::testing::Test {
   void SetUp() override {}
 };
 
+// Matches every character that the first test font can render with it, and
+// counts how often it is asked to.
+class CharacterMatchingFontManager : public AssetFontManager {
+ public:
+  explicit CharacterMatchingFontManager(sk_sp<SkTypeface> typeface)
+      : AssetFontManager(std::make_unique<TypefaceFontAssetProvider>()),
+        typeface_(std::move(typeface)) {}
+
+  int match_count() const { return match_count_; }
+
+ private:
+  sk_sp<SkTypeface> typeface_;
+  mutable int match_count_ = 0;
+
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override {
+    match_count_++;
+    if (typeface_->unicharToGlyph(character) == 0) {
+      return nullptr;
+    }
+    return typeface_;
+  }
+};
+
 TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   FontCollection font_collection;
   sk_sp<skia::textlayout::FontCollection> sk_font_collection =
@@ -39,5 +71,36 @@ TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   sk_font_collection = font_collection.CreateSktFontCollection();
   ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
 }
+
+TEST_F(FontCollectionTests, FallbackFontManagerReusesTypefacesWithinABlock) {
+  sk_sp<SkTypeface> typeface = flutter::GetTestFontData().front();
+  ASSERT_NE(typeface, nullptr);
+  auto matching_manager = sk_make_sp<CharacterMatchingFontManager>(typeface);
+  FallbackFontManager fallback_manager(matching_manager);
+  const char* locales[] = {"en-US"};
+
+  auto match = [&](SkUnichar character) {
+    return fallback_manager.matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                      locales, 1, character);
+  };
+
+  ASSERT_EQ(match('A'), typeface);
+  ASSERT_EQ(matching_manager->match_count(), 1);
+
+  // Characters of the same block are matched by the cached typeface.
+  ASSERT_EQ(match('B'), typeface);
+  ASSERT_EQ(matching_manager->match_count(), 1);
+
+  // A character that no typeface renders is only looked up once.
+  const SkUnichar missing = 0x10FFFD;
+  ASSERT_EQ(match(missing), nullptr);
+  ASSERT_EQ(match(missing), nullptr);
+  ASSERT_EQ(matching_manager->match_count(), 2);
+
+  FallbackFontManager::Stats stats = fallback_manager.GetStats();
+  ASSERT_EQ(stats.hit_count, 2u);
+  ASSERT_EQ(stats.miss_count, 2u);
+}
+
 }  // namespace testing
 }  // namespace txt
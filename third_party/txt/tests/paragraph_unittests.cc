@@ -29,6 +29,9 @@ class DlOpRecorder final : public virtual DlOpReceiver,
   int rectCount() const { return rects_.size(); }
   int pathCount() const { return paths_.size(); }
   int textFrameCount() const { return text_frames_.size(); }
+  const std::vector<std::shared_ptr<impeller::TextFrame>>& textFrames() const {
+    return text_frames_;
+  }
   int blobCount() const { return blobs_.size(); }
   bool hasPathEffect() const { return path_effect_ != nullptr; }
 
@@ -108,7 +111,6 @@ class PainterTestBase : public CanvasTestBase<T> {
     return builder.Build();
   }
 
- private:
   std::shared_ptr<txt::FontCollection> makeFontCollection() const {
     auto f_collection = std::make_shared<txt::FontCollection>();
     auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
@@ -121,16 +123,60 @@ class PainterTestBase : public CanvasTestBase<T> {
   }
 
   txt::ParagraphBuilderSkia makeParagraphBuilder() const {
+    return makeParagraphBuilder(makeFontCollection());
+  }
+
+  txt::ParagraphBuilderSkia makeParagraphBuilder(
+      std::shared_ptr<txt::FontCollection> f_collection) const {
     auto p_style = txt::ParagraphStyle();
-    auto f_collection = makeFontCollection();
     return txt::ParagraphBuilderSkia(p_style, f_collection, impeller_);
   }
 
+ private:
   bool impeller_ = false;
 };
 
 using PainterTest = PainterTestBase<::testing::Test>;
 
+TEST_F(PainterTest, ReusesLayoutOfParagraphWithSameContents) {
+  auto f_collection = makeFontCollection();
+  auto build = [&](txt::TextStyle style) {
+    auto pb_skia = makeParagraphBuilder(f_collection);
+    pb_skia.PushStyle(style);
+    pb_skia.AddText(u"Hello World!");
+    pb_skia.Pop();
+    return pb_skia.Build();
+  };
+  const auto& cache = f_collection->GetParagraphLayoutCache();
+
+  auto first = build(makeStyle());
+  first->Layout(100);
+  EXPECT_EQ(cache->GetStats().miss_count, 1u);
+  EXPECT_EQ(cache->GetStats().entry_count, 1u);
+
+  auto second = build(makeStyle());
+  second->Layout(100);
+  EXPECT_EQ(cache->GetStats().hit_count, 1u);
+  EXPECT_EQ(second->GetHeight(), first->GetHeight());
+  EXPECT_EQ(second->GetLongestLine(), first->GetLongestLine());
+
+  // Laying out at another width must not change the shared layout.
+  second->Layout(20);
+  EXPECT_EQ(cache->GetStats().entry_count, 2u);
+  EXPECT_GT(second->GetHeight(), first->GetHeight());
+
+  auto style = makeStyle();
+  style.font_size = 28;
+  auto third = build(style);
+  third->Layout(100);
+  EXPECT_EQ(cache->GetStats().hit_count, 1u);
+  EXPECT_GT(third->GetHeight(), first->GetHeight());
+
+  // Changing the fonts discards the cached layouts.
+  f_collection->ClearFontFamilyCache();
+  EXPECT_EQ(cache->GetStats().entry_count, 0u);
+}
+
 TEST_F(PainterTest, DrawsSolidLineSkia) {
   PretendImpellerIsEnabled(false);
 
@@ -192,6 +238,36 @@ TEST_F(PainterTest, DrawTextFrameImpeller) {
   EXPECT_EQ(recorder.blobCount(), 0);
 }
 
+TEST_F(PainterTest, ReusesTextFramesWhenRepainting) {
+  PretendImpellerIsEnabled(true);
+
+  auto pb_skia = makeParagraphBuilder();
+  pb_skia.PushStyle(makeStyle());
+  pb_skia.AddText(u"Hello World!");
+  pb_skia.Pop();
+  auto paragraph = pb_skia.Build();
+  paragraph->Layout(10000);
+
+  auto paint = [&]() {
+    auto builder = DisplayListBuilder();
+    paragraph->Paint(&builder, 0, 0);
+    auto recorder = DlOpRecorder();
+    builder.Build()->Dispatch(recorder);
+    return recorder.textFrames();
+  };
+  auto first = paint();
+  auto second = paint();
+  ASSERT_EQ(first.size(), 1u);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(first[0], second[0]);
+
+  // Laying the paragraph out again makes new text frames.
+  paragraph->Layout(20);
+  auto third = paint();
+  ASSERT_FALSE(third.empty());
+  EXPECT_NE(third[0], first[0]);
+}
+
 TEST_F(PainterTest, DrawStrokedTextImpeller) {
   PretendImpellerIsEnabled(true);
 